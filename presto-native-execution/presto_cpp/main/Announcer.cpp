@@ -17,11 +17,13 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include "presto_cpp/external/json/nlohmann/json.hpp"
+#include "presto_cpp/main/common/Configs.h"
 
 namespace facebook::presto {
 namespace {
 
 std::string announcementBody(
+    const std::string& announcementId,
     const std::string& address,
     bool useHttps,
     int port,
@@ -30,10 +32,8 @@ std::string announcementBody(
     const std::string& nodeLocation,
     const std::string& nodePoolType,
     const bool sidecar,
-    const std::vector<std::string>& connectorIds) {
-  std::string id =
-      boost::lexical_cast<std::string>(boost::uuids::random_generator()());
-
+    const std::vector<std::string>& connectorIds,
+    const std::vector<std::string>& capabilities) {
   const auto uriScheme = useHttps ? "https" : "http";
 
   nlohmann::json body = {
@@ -41,7 +41,7 @@ std::string announcementBody(
       {"pool", "general"},
       {"location", nodeLocation},
       {"services",
-       {{{"id", id},
+       {{{"id", announcementId},
          {"type", "presto"},
          {"properties",
           {{"node_version", nodeVersion},
@@ -49,11 +49,37 @@ std::string announcementBody(
            {"sidecar", sidecar},
            {"connectorIds", folly::join(',', connectorIds)},
            {"pool_type", nodePoolType},
+           // Advertises that this worker keeps split affinity history, so a
+           // coordinator doing soft-affinity scheduling can route repeat
+           // splits back to it.
+           {"split_affinity_tracking",
+            SystemConfig::instance()->taskSplitAffinityTrackingMaxSplits() >
+                0},
+           // Names the worker subsystems that are ready, so a coordinator
+           // can route queries that don't need a still-initializing
+           // subsystem before startup fully completes.
+           {"capabilities", folly::join(',', capabilities)},
            {uriScheme,
             fmt::format("{}://{}:{}", uriScheme, address, port)}}}}}}};
   return body.dump();
 }
 
+// A delta announcement refreshes an announcement the discovery service has
+// already seen in full. It carries only the announcement identity, so
+// steady-state heartbeats stay small regardless of how many connector
+// properties the full descriptor has.
+std::string deltaAnnouncementBody(
+    const std::string& announcementId,
+    const std::string& environment,
+    const std::string& nodeLocation) {
+  nlohmann::json body = {
+      {"environment", environment},
+      {"pool", "general"},
+      {"location", nodeLocation},
+      {"services", {{{"id", announcementId}, {"type", "presto"}}}}};
+  return body.dump();
+}
+
 proxygen::HTTPMessage announcementRequest(
     const std::string& address,
     int port,
@@ -84,6 +110,7 @@ Announcer::Announcer(
     const std::string& nodePoolType,
     const bool sidecar,
     const std::vector<std::string>& connectorIds,
+    const bool deltaAnnouncementEnabled,
     const uint64_t maxFrequencyMs,
     folly::SSLContextPtr sslContext)
     : PeriodicServiceInventoryManager(
@@ -93,21 +120,69 @@ Announcer::Announcer(
           std::move(sslContext),
           "Announcement",
           maxFrequencyMs),
-      announcementBody_(announcementBody(
-          address,
-          useHttps,
-          port,
-          nodeVersion,
-          environment,
-          nodeLocation,
-          nodePoolType,
-          sidecar,
-          connectorIds)),
-      announcementRequest_(
-          announcementRequest(address, port, nodeId, announcementBody_)) {}
+      announcementId_(
+          boost::lexical_cast<std::string>(boost::uuids::random_generator()())),
+      deltaAnnouncementEnabled_(deltaAnnouncementEnabled),
+      makeAnnouncementBody_(
+          [announcementId = announcementId_,
+           address,
+           useHttps,
+           port,
+           nodeVersion,
+           environment,
+           nodeLocation,
+           nodePoolType,
+           sidecar,
+           connectorIds](const std::vector<std::string>& capabilities) {
+            return announcementBody(
+                announcementId,
+                address,
+                useHttps,
+                port,
+                nodeVersion,
+                environment,
+                nodeLocation,
+                nodePoolType,
+                sidecar,
+                connectorIds,
+                capabilities);
+          }),
+      makeAnnouncementRequest_(
+          [address, port, nodeId](const std::string& body) {
+            return announcementRequest(address, port, nodeId, body);
+          }),
+      deltaAnnouncementBody_(
+          deltaAnnouncementBody(announcementId_, environment, nodeLocation)),
+      deltaAnnouncementRequest_(
+          announcementRequest(address, port, nodeId, deltaAnnouncementBody_)) {
+  setCapabilities({});
+}
+
+void Announcer::setCapabilities(const std::vector<std::string>& capabilities) {
+  auto body = makeAnnouncementBody_(capabilities);
+  auto request = makeAnnouncementRequest_(body);
+  fullAnnouncement_.withWLock([&](auto& full) {
+    full.body = std::move(body);
+    full.request = std::move(request);
+  });
+  resendFullAnnouncement_ = true;
+}
 
 std::tuple<proxygen::HTTPMessage, std::string> Announcer::httpRequest() {
-  return {announcementRequest_, announcementBody_};
+  // Once the first announcement succeeded the discovery service knows the full
+  // service descriptor, so only the small refresh payload is needed. Resend
+  // the full body after any failure so a restarted discovery service can
+  // rebuild its view of this node, and after a capability change so the
+  // discovery service sees the new descriptor.
+  if (deltaAnnouncementEnabled_ && attempts_ > 1 && failedAttempts_ == 0 &&
+      !resendFullAnnouncement_.load()) {
+    return {deltaAnnouncementRequest_, deltaAnnouncementBody_};
+  }
+  // The full descriptor goes out below; a capability change set after this
+  // point simply forces one more full announcement.
+  resendFullAnnouncement_ = false;
+  auto full = fullAnnouncement_.rlock();
+  return {full->request, full->body};
 }
 
 } // namespace facebook::presto
@@ -34,17 +34,50 @@ class Announcer : public PeriodicServiceInventoryManager {
       const std::string& nodePoolType,
       const bool sidecar,
       const std::vector<std::string>& connectorIds,
+      const bool deltaAnnouncementEnabled,
       const uint64_t maxFrequencyMs_,
       folly::SSLContextPtr sslContext);
 
   ~Announcer() = default;
 
+  /// Replaces the advertised capability list. Capabilities name the worker
+  /// subsystems that are ready (e.g. remote function registration), so the
+  /// coordinator can route queries that don't need a still-initializing
+  /// subsystem before startup fully completes. The next announcement resends
+  /// the full service descriptor so the discovery service picks the change up
+  /// even when delta announcements are enabled.
+  void setCapabilities(const std::vector<std::string>& capabilities);
+
  protected:
+  /// Returns the full announcement on the first attempt and after any failed
+  /// attempt. When delta announcements are enabled, steady-state heartbeats
+  /// use a pre-serialized refresh payload that carries only the announcement
+  /// identity.
   std::tuple<proxygen::HTTPMessage, std::string> httpRequest() override;
 
  private:
-  const std::string announcementBody_;
-  const proxygen::HTTPMessage announcementRequest_;
+  // The full announcement payload and its pre-built request. Replaced as a
+  // unit when the advertised capabilities change.
+  struct FullAnnouncement {
+    std::string body;
+    proxygen::HTTPMessage request;
+  };
+
+  const std::string announcementId_;
+  const bool deltaAnnouncementEnabled_;
+  // Rebuilds the full announcement body for a capability list.
+  const std::function<std::string(const std::vector<std::string>&)>
+      makeAnnouncementBody_;
+  // Builds the announcement request for a body.
+  const std::function<proxygen::HTTPMessage(const std::string&)>
+      makeAnnouncementRequest_;
+  folly::Synchronized<FullAnnouncement> fullAnnouncement_;
+  const std::string deltaAnnouncementBody_;
+  const proxygen::HTTPMessage deltaAnnouncementRequest_;
+
+  // Set when the capabilities change so that the next announcement resends
+  // the full service descriptor even in delta mode.
+  std::atomic_bool resendFullAnnouncement_{false};
 };
 
 } // namespace facebook::presto
@@ -0,0 +1,107 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/AutoTraceRegistry.h"
+
+#include <algorithm>
+
+namespace facebook::presto {
+namespace {
+
+// Value at or above which a sample sits in the top (100 - percentile)% of
+// 'values'. The input is copied since nth_element reorders it.
+uint64_t percentileValue(std::vector<uint64_t> values, int32_t percentile) {
+  const auto rank = std::min(
+      values.size() - 1, values.size() * std::max(percentile, 0) / 100);
+  std::nth_element(values.begin(), values.begin() + rank, values.end());
+  return values[rank];
+}
+
+} // namespace
+
+// static
+AutoTraceRegistry* AutoTraceRegistry::instance() {
+  static auto* registry = new AutoTraceRegistry();
+  return registry;
+}
+
+void AutoTraceRegistry::addCompletedTask(
+    uint64_t runtimeMs,
+    uint64_t peakBytes) {
+  auto samples = samples_.wlock();
+  if (samples->runtimeMs.size() < kMaxSamples) {
+    samples->runtimeMs.push_back(runtimeMs);
+    samples->peakBytes.push_back(peakBytes);
+    return;
+  }
+  samples->runtimeMs[samples->next] = runtimeMs;
+  samples->peakBytes[samples->next] = peakBytes;
+  samples->next = (samples->next + 1) % kMaxSamples;
+}
+
+bool AutoTraceRegistry::isOutlier(
+    uint64_t runtimeMs,
+    uint64_t peakBytes,
+    int32_t percentile) const {
+  std::vector<uint64_t> runtimeSamples;
+  std::vector<uint64_t> peakSamples;
+  {
+    auto samples = samples_.rlock();
+    if (samples->runtimeMs.size() < kMinSamples) {
+      return false;
+    }
+    runtimeSamples = samples->runtimeMs;
+    peakSamples = samples->peakBytes;
+  }
+  return runtimeMs >= percentileValue(std::move(runtimeSamples), percentile) ||
+      peakBytes >= percentileValue(std::move(peakSamples), percentile);
+}
+
+bool AutoTraceRegistry::tryPromote(
+    const std::string& source,
+    size_t maxPromoted,
+    uint64_t ttlMs,
+    uint64_t nowMs) {
+  auto promotions = promotions_.wlock();
+  for (auto it = promotions->begin(); it != promotions->end();) {
+    if (it->second <= nowMs) {
+      it = promotions->erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (promotions->contains(source) || promotions->size() >= maxPromoted) {
+    return false;
+  }
+  promotions->emplace(source, nowMs + ttlMs);
+  return true;
+}
+
+bool AutoTraceRegistry::isPromoted(const std::string& source, uint64_t nowMs)
+    const {
+  auto promotions = promotions_.rlock();
+  auto it = promotions->find(source);
+  return it != promotions->end() && it->second > nowMs;
+}
+
+void AutoTraceRegistry::testingClear() {
+  {
+    auto samples = samples_.wlock();
+    samples->runtimeMs.clear();
+    samples->peakBytes.clear();
+    samples->next = 0;
+  }
+  promotions_.wlock()->clear();
+}
+
+} // namespace facebook::presto
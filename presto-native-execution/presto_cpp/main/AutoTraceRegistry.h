@@ -0,0 +1,89 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook::presto {
+
+/// Process-wide state of the automatic trace capture feature, gated by
+/// 'task.auto-trace-enabled'.
+///
+/// Performance incidents are retrospective: by the time tracing is enabled by
+/// hand, the anomaly is gone. The periodic slow-task sweep feeds every
+/// completed task's runtime and peak memory into a sliding sample window
+/// here, flags running tasks that sit at or above the configured percentile
+/// of that window, and promotes the flagged task's session source. Query
+/// context creation consults the promotion set: queries arriving with a
+/// promoted source run with velox operator input tracing enabled, so the next
+/// occurrence of the incident leaves replayable artifacts without operator
+/// intervention. Promotions expire after a TTL and their number is capped,
+/// which together with the per-query trace byte budget bounds the disk the
+/// feature can consume.
+class AutoTraceRegistry {
+ public:
+  static AutoTraceRegistry* instance();
+
+  /// Feeds one completed task's runtime and peak memory into the sliding
+  /// sample window the outlier thresholds are computed from.
+  void addCompletedTask(uint64_t runtimeMs, uint64_t peakBytes);
+
+  /// Returns true when 'runtimeMs' or 'peakBytes' is at or above the given
+  /// percentile of the completed-task samples. Always false until the window
+  /// holds kMinSamples entries, so a freshly started worker does not flag
+  /// everything it runs.
+  bool isOutlier(uint64_t runtimeMs, uint64_t peakBytes, int32_t percentile)
+      const;
+
+  /// Promotes 'source' for tracing until 'nowMs' + 'ttlMs'. Returns false
+  /// when the source is already promoted or the cap on concurrently promoted
+  /// sources is reached; expired promotions are pruned first and do not count
+  /// against the cap.
+  bool tryPromote(
+      const std::string& source,
+      size_t maxPromoted,
+      uint64_t ttlMs,
+      uint64_t nowMs);
+
+  /// Returns true when queries arriving with 'source' should run with
+  /// tracing enabled.
+  bool isPromoted(const std::string& source, uint64_t nowMs) const;
+
+  /// Testing only.
+  void testingClear();
+
+ private:
+  // No outlier decisions before the window holds this many completed tasks.
+  static constexpr size_t kMinSamples = 100;
+
+  // The sample window is a ring over the most recent completed tasks, so the
+  // thresholds track the current workload rather than the process lifetime.
+  static constexpr size_t kMaxSamples = 4096;
+
+  struct Samples {
+    std::vector<uint64_t> runtimeMs;
+    std::vector<uint64_t> peakBytes;
+    size_t next{0};
+  };
+
+  folly::Synchronized<Samples> samples_;
+
+  // Promoted session source -> promotion expiry, in ms since epoch.
+  folly::Synchronized<std::unordered_map<std::string, uint64_t>> promotions_;
+};
+
+} // namespace facebook::presto
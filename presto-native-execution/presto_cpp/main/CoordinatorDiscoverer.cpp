@@ -15,8 +15,28 @@
 #include "presto_cpp/main/CoordinatorDiscoverer.h"
 #include <folly/Uri.h>
 #include "presto_cpp/main/common/Configs.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::presto {
+namespace {
+
+// Backoff applied after a failed resolution, doubling up to the cap so a
+// flapping resolver is not hammered every announcement cycle.
+constexpr uint64_t kInitialResolveBackoffMs = 1'000;
+constexpr uint64_t kMaxResolveBackoffMs = 30'000;
+
+folly::SocketAddress resolveDiscoveryUri(const std::string& discoveryUri) {
+  auto uri = folly::Uri(discoveryUri);
+  return folly::SocketAddress(uri.hostname(), uri.port(), true);
+}
+
+} // namespace
+
+CoordinatorDiscoverer::~CoordinatorDiscoverer() {
+  if (resolverThread_.joinable()) {
+    resolverThread_.join();
+  }
+}
 
 folly::SocketAddress CoordinatorDiscoverer::updateAddress() {
   // Check if discovery URI is specified. Presto-on-Spark doesn't specify it.
@@ -24,12 +44,40 @@ folly::SocketAddress CoordinatorDiscoverer::updateAddress() {
   if (!discoveryUri.has_value()) {
     // Returns the previous cached address or empty address if fetch never
     // succeeded.
-    return coordinatorAddress_;
+    return getAddress();
   }
 
-  auto uri = folly::Uri(discoveryUri.value());
-  updateAddressSafe(folly::SocketAddress(uri.hostname(), uri.port(), true));
-  return coordinatorAddress_;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!coordinatorAddress_.empty()) {
+      // There is a last-known-good address to announce with; refresh it in
+      // the background and return immediately.
+      maybeScheduleResolveLocked(discoveryUri.value());
+      return coordinatorAddress_;
+    }
+    if (velox::getCurrentTimeMs() < nextResolveAllowedMs_) {
+      return coordinatorAddress_;
+    }
+  }
+
+  // Bootstrap: no address has ever resolved, so there is nothing to fall back
+  // on; resolve on the caller and let a failure propagate to its retry logic.
+  try {
+    updateAddressSafe(resolveDiscoveryUri(discoveryUri.value()));
+  } catch (const std::exception&) {
+    std::lock_guard<std::mutex> l(mutex_);
+    backoffMs_ = backoffMs_ == 0
+        ? kInitialResolveBackoffMs
+        : std::min(backoffMs_ * 2, kMaxResolveBackoffMs);
+    nextResolveAllowedMs_ = velox::getCurrentTimeMs() + backoffMs_;
+    throw;
+  }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    backoffMs_ = 0;
+    nextResolveAllowedMs_ = 0;
+  }
+  return getAddress();
 }
 
 folly::SocketAddress CoordinatorDiscoverer::getAddress() {
@@ -46,4 +94,46 @@ void CoordinatorDiscoverer::updateAddressSafe(
   coordinatorAddress_ = address;
 }
 
+void CoordinatorDiscoverer::maybeScheduleResolveLocked(
+    const std::string& discoveryUri) {
+  if (resolveInFlight_ || velox::getCurrentTimeMs() < nextResolveAllowedMs_) {
+    return;
+  }
+  resolveInFlight_ = true;
+  if (resolverThread_.joinable()) {
+    // The previous resolution has finished; reclaim its thread.
+    resolverThread_.join();
+  }
+  resolverThread_ =
+      std::thread([this, discoveryUri]() { resolve(discoveryUri); });
+}
+
+void CoordinatorDiscoverer::resolve(const std::string& discoveryUri) {
+  folly::SocketAddress address;
+  bool resolved = false;
+  try {
+    address = resolveDiscoveryUri(discoveryUri);
+    resolved = true;
+  } catch (const std::exception& ex) {
+    LOG(WARNING) << "Coordinator address resolution failed, keeping the "
+                 << "last-known-good address: " << ex.what();
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  resolveInFlight_ = false;
+  if (!resolved) {
+    backoffMs_ = backoffMs_ == 0
+        ? kInitialResolveBackoffMs
+        : std::min(backoffMs_ * 2, kMaxResolveBackoffMs);
+    nextResolveAllowedMs_ = velox::getCurrentTimeMs() + backoffMs_;
+    return;
+  }
+  backoffMs_ = 0;
+  nextResolveAllowedMs_ = 0;
+  if (coordinatorAddress_ != address) {
+    LOG(INFO) << "Coordinator address changed to " << address;
+  }
+  coordinatorAddress_ = address;
+}
+
 } // namespace facebook::presto
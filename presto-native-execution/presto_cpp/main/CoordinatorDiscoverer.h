@@ -15,6 +15,7 @@
 
 #include <folly/SocketAddress.h>
 #include <mutex>
+#include <thread>
 
 namespace facebook::presto {
 
@@ -22,12 +23,16 @@ namespace facebook::presto {
 // Coordinator or Resource Manager.
 class CoordinatorDiscoverer {
  public:
-  virtual ~CoordinatorDiscoverer() = default;
+  virtual ~CoordinatorDiscoverer();
 
-  /// Fetches the coordinator address and update the cached address. The
-  /// function returns the refreshed one on fetch success or the previously
-  /// cached address. It will return an empty address if the fetches have never
-  /// succeeded.
+  /// Returns the coordinator address without blocking the caller on DNS. The
+  /// first successful resolution runs on the caller since there is no address
+  /// to fall back on; once a last-known-good address exists, refreshes run on
+  /// a background thread and this returns the cached address immediately, so
+  /// the announcement path stays independent of resolver health. Failed
+  /// refreshes keep the last-known-good address and back off exponentially
+  /// before the next attempt. Returns an empty address if resolution has
+  /// never succeeded.
   virtual folly::SocketAddress updateAddress();
 
   /// Returns the cached coordinator address.
@@ -38,9 +43,24 @@ class CoordinatorDiscoverer {
   void updateAddressSafe(const folly::SocketAddress& address);
 
  private:
-  /// Mutex to protect 'coordinatorAddress_'.
+  /// Resolves 'discoveryUri' on the background thread and updates the cached
+  /// address on success; on failure keeps the cached address and extends the
+  /// resolution backoff.
+  void resolve(const std::string& discoveryUri);
+
+  /// Starts a background resolution unless one is in flight or the failure
+  /// backoff has not expired. Must be called with 'mutex_' held.
+  void maybeScheduleResolveLocked(const std::string& discoveryUri);
+
+  /// Mutex to protect the address and resolution state below.
   std::mutex mutex_;
   folly::SocketAddress coordinatorAddress_;
+  std::thread resolverThread_;
+  bool resolveInFlight_{false};
+  /// Time point (in ms) before which failed resolutions are not retried, and
+  /// the current backoff that produced it. Zero after a success.
+  uint64_t nextResolveAllowedMs_{0};
+  uint64_t backoffMs_{0};
 };
 
 } // namespace facebook::presto
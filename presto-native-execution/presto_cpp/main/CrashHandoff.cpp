@@ -0,0 +1,181 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/CrashHandoff.h"
+
+#include <fcntl.h>
+#include <folly/SocketAddress.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include "presto_cpp/main/common/Utils.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::presto {
+namespace {
+
+// The fatal signals worth a handoff: anything that kills the process with
+// task state still live. SIGINT/SIGTERM go through the graceful shutdown in
+// SignalHandler instead.
+constexpr int kFatalSignals[] = {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT};
+
+// Previously installed actions, restored before re-raising so the stack
+// trace handler installed at process start still runs.
+struct sigaction oldActions[NSIG];
+
+// Async-signal-safe unsigned decimal formatting. Returns the number of
+// characters written.
+size_t formatUnsigned(uint64_t value, char* out, size_t capacity) {
+  char digits[20];
+  size_t numDigits = 0;
+  do {
+    digits[numDigits++] = '0' + value % 10;
+    value /= 10;
+  } while (value > 0);
+  const auto size = std::min(numDigits, capacity);
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = digits[numDigits - 1 - i];
+  }
+  return size;
+}
+
+// write() until done; short writes are legal for regular files on some
+// filesystems and EINTR cannot be ruled out in a signal handler.
+void writeFully(int fd, const char* data, size_t size) {
+  size_t written = 0;
+  while (written < size) {
+    const auto rc = ::write(fd, data + written, size - written);
+    if (rc <= 0) {
+      if (rc < 0 && errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    written += rc;
+  }
+}
+
+void crashSignalHandler(int signum) {
+  CrashHandoff::instance()->onFatalSignal(signum);
+  // Hand the signal to the previously installed handler for the stack
+  // trace, then let it terminate the process.
+  ::sigaction(signum, &oldActions[signum], nullptr);
+  ::raise(signum);
+}
+} // namespace
+
+// static
+CrashHandoff* CrashHandoff::instance() {
+  static auto* handoff = new CrashHandoff();
+  return handoff;
+}
+
+void CrashHandoff::start(
+    const std::string& dumpFilePath,
+    const std::string& notifyAddress,
+    const std::string& nodeId) {
+  dumpFilePath_ = dumpFilePath;
+  header_ = "presto_worker_crash\nnode ";
+  header_ += nodeId;
+  header_ += "\n";
+
+  if (!notifyAddress.empty()) {
+    folly::SocketAddress address;
+    address.setFromHostPort(notifyAddress);
+    notifyAddrLen_ = address.getAddress(&notifyAddr_);
+    notifySocket_ = ::socket(notifyAddr_.ss_family, SOCK_DGRAM, 0);
+    VELOX_CHECK_GE(
+        notifySocket_,
+        0,
+        "Failed to create crash handoff notice socket for '{}'",
+        notifyAddress);
+  }
+
+  for (const auto signum : kFatalSignals) {
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = crashSignalHandler;
+    ::sigemptyset(&action.sa_mask);
+    ::sigaction(signum, &action, &oldActions[signum]);
+  }
+  PRESTO_STARTUP_LOG(INFO)
+      << "Crash handoff armed: dump file '" << dumpFilePath_
+      << "', notice address '" << notifyAddress << "'";
+}
+
+void CrashHandoff::updateSnapshot(const std::string& snapshot) {
+  const auto current = published_.load(std::memory_order_acquire);
+  auto& next = snapshots_[current == 0 ? 1 : 0];
+  next.size = std::min(snapshot.size(), kSnapshotCapacity);
+  std::memcpy(next.data, snapshot.data(), next.size);
+  published_.store(current == 0 ? 1 : 0, std::memory_order_release);
+}
+
+void CrashHandoff::onFatalSignal(int signum) noexcept {
+  if (fired_.exchange(true)) {
+    return;
+  }
+  char signalLine[32];
+  size_t signalLineSize = 0;
+  std::memcpy(signalLine, "signal ", 7);
+  signalLineSize = 7 +
+      formatUnsigned(
+          static_cast<uint64_t>(signum),
+          signalLine + 7,
+          sizeof(signalLine) - 8);
+  signalLine[signalLineSize++] = '\n';
+
+  const auto current = published_.load(std::memory_order_acquire);
+  const Snapshot* snapshot = current >= 0 ? &snapshots_[current] : nullptr;
+
+  if (!dumpFilePath_.empty()) {
+    const int fd =
+        ::open(dumpFilePath_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+      writeFully(fd, header_.data(), header_.size());
+      writeFully(fd, signalLine, signalLineSize);
+      if (snapshot != nullptr) {
+        writeFully(fd, snapshot->data, snapshot->size);
+      }
+      ::close(fd);
+    }
+  }
+
+  if (notifySocket_ >= 0) {
+    // One datagram: the header, the signal and as much of the snapshot as
+    // fits. A truncated notice still identifies the dead worker.
+    char notice[kNoticeCapacity];
+    size_t size = std::min(header_.size(), sizeof(notice));
+    std::memcpy(notice, header_.data(), size);
+    const auto lineSize = std::min(signalLineSize, sizeof(notice) - size);
+    std::memcpy(notice + size, signalLine, lineSize);
+    size += lineSize;
+    if (snapshot != nullptr) {
+      const auto snapshotSize =
+          std::min(snapshot->size, sizeof(notice) - size);
+      std::memcpy(notice + size, snapshot->data, snapshotSize);
+      size += snapshotSize;
+    }
+    ::sendto(
+        notifySocket_,
+        notice,
+        size,
+        0,
+        reinterpret_cast<const sockaddr*>(&notifyAddr_),
+        notifyAddrLen_);
+  }
+}
+
+} // namespace facebook::presto
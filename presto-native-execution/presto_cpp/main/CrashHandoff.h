@@ -0,0 +1,92 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <netinet/in.h>
+#include <atomic>
+#include <string>
+
+namespace facebook::presto {
+
+/// Crash-time telemetry for fatal signals. When the worker dies from a
+/// segfault or an abort, the coordinator otherwise rediscovers the failure
+/// through polling timeouts and the in-flight task state dies with the
+/// process; this component dumps the live task ids and output buffer tokens
+/// to a local file for the replacement worker and fires one best-effort UDP
+/// death notice at the coordinator so failure detection takes milliseconds
+/// instead of a timeout.
+///
+/// A fatal signal handler may only use async-signal-safe functions, so
+/// everything the handler needs is prepared ahead of time: the task snapshot
+/// is preformatted by a periodic sweep into one of two fixed buffers
+/// published through an atomic index, the notice socket and destination
+/// address are created at start(), and the handler itself only calls open,
+/// write, close and sendto. The hook chains to the previously installed
+/// fatal signal handler, so the stack trace logging still runs; start() must
+/// therefore be called after util::installSignalHandler().
+class CrashHandoff {
+ public:
+  static CrashHandoff* instance();
+
+  /// Prepares the crash-time resources and installs the fatal signal hook.
+  /// 'dumpFilePath' is where the handler writes the snapshot; empty skips
+  /// the dump. 'notifyAddress' is the "host:port" UDP destination of the
+  /// death notice; empty skips the notice. 'nodeId' identifies this worker
+  /// in both.
+  void start(
+      const std::string& dumpFilePath,
+      const std::string& notifyAddress,
+      const std::string& nodeId);
+
+  /// Publishes 'snapshot' as the state the crash handler dumps, replacing
+  /// the previous one. Called by the periodic sweep; truncated to the fixed
+  /// buffer capacity.
+  void updateSnapshot(const std::string& snapshot);
+
+  /// Writes the dump file and sends the death notice. Async-signal-safe;
+  /// called from the fatal signal hook and runs at most once.
+  void onFatalSignal(int signum) noexcept;
+
+  /// Testing only. Resets the one-shot latch so onFatalSignal() can fire
+  /// again.
+  void testingReset() {
+    fired_.store(false);
+  }
+
+ private:
+  // Large enough for a few thousand task lines; a crash dump that drops the
+  // tail is still useful.
+  static constexpr size_t kSnapshotCapacity = 256 * 1024;
+  // A death notice must fit in one unfragmented datagram.
+  static constexpr size_t kNoticeCapacity = 1400;
+
+  struct Snapshot {
+    char data[kSnapshotCapacity];
+    size_t size{0};
+  };
+
+  std::string dumpFilePath_;
+  std::string header_;
+  int notifySocket_{-1};
+  sockaddr_storage notifyAddr_;
+  socklen_t notifyAddrLen_{0};
+
+  // Double buffer: the sweep writes the buffer not published and then
+  // publishes its index, so the handler always reads a complete snapshot.
+  Snapshot snapshots_[2];
+  std::atomic<int32_t> published_{-1};
+  std::atomic<bool> fired_{false};
+};
+
+} // namespace facebook::presto
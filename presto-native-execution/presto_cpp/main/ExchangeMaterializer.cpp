@@ -0,0 +1,219 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/ExchangeMaterializer.h"
+
+#include <glog/logging.h>
+
+#include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
+#include "presto_cpp/main/thrift/ThriftIO.h"
+#include "presto_cpp/main/thrift/gen-cpp2/presto_native_types.h"
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::presto {
+
+namespace {
+// Cap on pages parked waiting for an out-of-order gap to fill. Pages are
+// clones sharing the output buffer memory, so the cap bounds how long that
+// memory is pinned past acknowledgement.
+constexpr uint64_t kMaxPendingBytes = uint64_t{256} << 20;
+} // namespace
+
+// static
+ExchangeMaterializer* ExchangeMaterializer::instance() {
+  static auto* materializer = new ExchangeMaterializer();
+  return materializer;
+}
+
+// static
+std::string ExchangeMaterializer::filePath(
+    const std::string& basePath,
+    const std::string& taskId,
+    long bufferId) {
+  return fmt::format("{}/{}_{}.bin", basePath, taskId, bufferId);
+}
+
+std::shared_ptr<ExchangeMaterializer::Stream>
+ExchangeMaterializer::getOrCreateStream(
+    const std::string& taskId,
+    long bufferId) {
+  const auto key = fmt::format("{}/{}", taskId, bufferId);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = streams_.find(key);
+  if (it != streams_.end()) {
+    return it->second;
+  }
+  auto stream = std::make_shared<Stream>();
+  stream->finalPath = filePath(
+      SystemConfig::instance()->exchangeMaterializationBasePath(),
+      taskId,
+      bufferId);
+  stream->tmpPath = stream->finalPath + ".tmp";
+  streams_.emplace(key, stream);
+  return stream;
+}
+
+void ExchangeMaterializer::append(
+    const std::string& taskId,
+    long bufferId,
+    int64_t sequence,
+    const std::vector<std::unique_ptr<folly::IOBuf>>& pages) {
+  auto stream = getOrCreateStream(taskId, bufferId);
+  bool done = false;
+  {
+    std::lock_guard<std::mutex> l(stream->mutex);
+    if (stream->abandoned) {
+      return;
+    }
+    auto pageSequence = sequence;
+    for (const auto& page : pages) {
+      if (page == nullptr) {
+        stream->endSequence = pageSequence;
+        break;
+      }
+      if (pageSequence >= stream->nextSequence &&
+          stream->pending.count(pageSequence) == 0) {
+        stream->pendingBytes += page->computeChainDataLength();
+        stream->pending.emplace(pageSequence, page->clone());
+      }
+      ++pageSequence;
+    }
+    done = drainLocked(*stream);
+  }
+  if (done) {
+    const auto key = fmt::format("{}/{}", taskId, bufferId);
+    std::lock_guard<std::mutex> l(mutex_);
+    streams_.erase(key);
+  }
+}
+
+bool ExchangeMaterializer::drainLocked(Stream& stream) {
+  try {
+    while (!stream.pending.empty() &&
+           stream.pending.begin()->first == stream.nextSequence) {
+      auto it = stream.pending.begin();
+      const auto pageBytes = it->second->computeChainDataLength();
+      if (stream.file == nullptr) {
+        auto fileSystem =
+            velox::filesystems::getFileSystem(stream.tmpPath, nullptr);
+        if (fileSystem->exists(stream.tmpPath)) {
+          // Leftover of an earlier attempt of the same task id.
+          fileSystem->remove(stream.tmpPath);
+        }
+        stream.file = fileSystem->openFileForWrite(stream.tmpPath);
+      }
+      for (const auto range : *it->second) {
+        stream.file->append(std::string_view(
+            reinterpret_cast<const char*>(range.data()), range.size()));
+      }
+      stream.pageSizes.push_back(pageBytes);
+      stream.pendingBytes -= pageBytes;
+      stream.pending.erase(it);
+      ++stream.nextSequence;
+      RECORD_METRIC_VALUE(kCounterExchangeMaterializedBytes, pageBytes);
+    }
+
+    if (stream.endSequence >= 0 &&
+        stream.nextSequence == stream.endSequence) {
+      finalizeLocked(stream);
+      return true;
+    }
+
+    if (stream.pendingBytes > kMaxPendingBytes) {
+      // A gap is not filling while fetched-ahead pages accumulate; stop
+      // pinning output buffer memory and give up on this buffer.
+      LOG(WARNING) << "Abandoning exchange materialization of "
+                   << stream.finalPath << ": " << stream.pendingBytes
+                   << " bytes pending behind sequence "
+                   << stream.nextSequence;
+      abandonLocked(stream);
+      return true;
+    }
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Abandoning exchange materialization of "
+                 << stream.finalPath << ": " << e.what();
+    abandonLocked(stream);
+    return true;
+  }
+  return false;
+}
+
+void ExchangeMaterializer::finalizeLocked(Stream& stream) {
+  if (stream.pageSizes.empty()) {
+    // A buffer that produced no pages leaves no file; the reader requires
+    // at least one page and an empty buffer has nothing to fail over to.
+    abandonLocked(stream);
+    return;
+  }
+
+  facebook::presto::thrift::BroadcastFileFooter footer;
+  footer.pageSizes_ref() = stream.pageSizes;
+  auto footerBuf = thriftWriteIOBuf(footer);
+  const int64_t footerSize =
+      static_cast<int64_t>(footerBuf->computeChainDataLength());
+  for (const auto range : *footerBuf) {
+    stream.file->append(std::string_view(
+        reinterpret_cast<const char*>(range.data()), range.size()));
+  }
+  stream.file->append(std::string_view(
+      reinterpret_cast<const char*>(&footerSize), sizeof(footerSize)));
+  stream.file->close();
+  stream.file = nullptr;
+
+  // The complete file becomes visible atomically; consumers never see a
+  // file without its footer.
+  auto fileSystem =
+      velox::filesystems::getFileSystem(stream.finalPath, nullptr);
+  fileSystem->rename(stream.tmpPath, stream.finalPath, /*overwrite=*/true);
+  RECORD_METRIC_VALUE(kCounterExchangeMaterializedBuffers);
+}
+
+void ExchangeMaterializer::abandonLocked(Stream& stream) {
+  stream.abandoned = true;
+  stream.pending.clear();
+  stream.pendingBytes = 0;
+  if (stream.file != nullptr) {
+    try {
+      stream.file->close();
+      velox::filesystems::getFileSystem(stream.tmpPath, nullptr)
+          ->remove(stream.tmpPath);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to remove partial materialized exchange file "
+                   << stream.tmpPath << ": " << e.what();
+    }
+    stream.file = nullptr;
+  }
+}
+
+void ExchangeMaterializer::abortTask(const std::string& taskId) {
+  std::vector<std::shared_ptr<Stream>> aborted;
+  {
+    const auto prefix = taskId + "/";
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto it = streams_.begin(); it != streams_.end();) {
+      if (it->first.compare(0, prefix.size(), prefix) == 0) {
+        aborted.push_back(std::move(it->second));
+        it = streams_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (auto& stream : aborted) {
+    std::lock_guard<std::mutex> l(stream->mutex);
+    abandonLocked(*stream);
+  }
+}
+
+} // namespace facebook::presto
@@ -0,0 +1,116 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <folly/io/IOBuf.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/common/file/File.h"
+#include "velox/common/file/FileSystems.h"
+
+namespace facebook::presto {
+
+/// Tees task output pages to durable storage so an exchange consumer can
+/// fail over to the materialized copy when the producing worker is gone,
+/// turning a worker loss into a stage retry instead of a query retry.
+///
+/// Pages are appended as the output buffer serves them to consumers, in
+/// sequence order, to one file per (task, output buffer) under the
+/// configured base path; out-of-order fetches are parked until the gap
+/// fills. When the end-of-data marker has been served and every sequence
+/// has been written, the file gets the broadcast-file footer and is
+/// renamed into place, so a file is only visible once it holds the
+/// complete buffer output and can be read back with BroadcastFileReader.
+///
+/// A producer that dies before serving its last page leaves no visible
+/// file and the failure surfaces exactly as it does today; materialization
+/// covers the common long-ETL failure where an upstream stage finished
+/// long before its worker was lost, and downstream stage retries that
+/// re-fetch results the producer has already dropped.
+class ExchangeMaterializer {
+ public:
+  static ExchangeMaterializer* instance();
+
+  /// Records the pages the output buffer returned for 'sequence' of
+  /// 'taskId'/'bufferId', in callback order. A null page marks the end of
+  /// data. Repeated fetches of the same sequence are deduplicated.
+  /// Thread-safe; errors writing the file abandon materialization of that
+  /// buffer without failing the fetch.
+  void append(
+      const std::string& taskId,
+      long bufferId,
+      int64_t sequence,
+      const std::vector<std::unique_ptr<folly::IOBuf>>& pages);
+
+  /// Drops the in-progress state of all buffers of 'taskId' and removes
+  /// their partially written files. Completed files are left in place for
+  /// consumers still failing over to them. Called when the task is cleaned
+  /// up.
+  void abortTask(const std::string& taskId);
+
+  /// Path of the materialized file of 'taskId'/'bufferId' under 'basePath'.
+  /// Producers write it and PrestoExchangeSource reads it, so both sides
+  /// derive the path with this.
+  static std::string filePath(
+      const std::string& basePath,
+      const std::string& taskId,
+      long bufferId);
+
+ private:
+  // In-progress materialization of one output buffer.
+  struct Stream {
+    std::mutex mutex;
+    std::unique_ptr<velox::WriteFile> file;
+    // Path the finished file is renamed to; the write happens to the '.tmp'
+    // sibling.
+    std::string finalPath;
+    std::string tmpPath;
+    // Next sequence to write to the file.
+    int64_t nextSequence{0};
+    // Pages fetched ahead of 'nextSequence', keyed by sequence.
+    std::map<int64_t, std::unique_ptr<folly::IOBuf>> pending;
+    uint64_t pendingBytes{0};
+    // Sequence of the end-of-data marker, or -1 if not seen yet.
+    int64_t endSequence{-1};
+    std::vector<int64_t> pageSizes;
+    bool abandoned{false};
+  };
+
+  // Writes the contiguous run at 'nextSequence' from 'pending' to the file,
+  // and finalizes the file once the end marker is reached. Returns true when
+  // the stream is done (finalized or abandoned) and can be dropped.
+  bool drainLocked(Stream& stream);
+
+  // Writes the broadcast-file footer and renames the file into place.
+  void finalizeLocked(Stream& stream);
+
+  // Marks the stream abandoned and removes its partially written file.
+  void abandonLocked(Stream& stream);
+
+  std::shared_ptr<Stream> getOrCreateStream(
+      const std::string& taskId,
+      long bufferId);
+
+  std::mutex mutex_;
+  // In-progress streams keyed by "taskId/bufferId". Protected by 'mutex_';
+  // each stream has its own lock for the write path.
+  folly::F14FastMap<std::string, std::shared_ptr<Stream>> streams_;
+};
+
+} // namespace facebook::presto
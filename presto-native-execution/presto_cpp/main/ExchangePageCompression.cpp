@@ -0,0 +1,213 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/ExchangePageCompression.h"
+
+#include <folly/hash/Hash.h>
+#include <glog/logging.h>
+#include <zdict.h>
+#include <zstd.h>
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::presto {
+namespace {
+
+// Exchange is latency sensitive; the lowest zstd level gives most of the
+// dictionary win at a fraction of the CPU cost of the default level.
+constexpr int kCompressionLevel = 1;
+
+// Upper bound on the trained dictionary. 64KB is the size the zstd authors
+// recommend for small repetitive records and keeps the one-time header
+// shipment cheap.
+constexpr size_t kMaxDictionaryBytes = 64 << 10;
+
+// Only the leading bytes of each body are kept as a training sample, to
+// bound the memory held while a destination is still in training. The
+// column dictionaries that make exchange pages repetitive sit at the front
+// of the serialized page, so the truncation loses little signal.
+constexpr size_t kMaxSampleBytes = 64 << 10;
+
+// Non-negative dictionary identifier so -1 stays free as the 'no
+// dictionary' sentinel on the wire.
+int64_t makeDictionaryId(const std::string& dictionary) {
+  return static_cast<int64_t>(
+      folly::hash::fnv64(dictionary) & ((1ULL << 63) - 1));
+}
+} // namespace
+
+ExchangePageCompressor::ExchangePageCompressor(uint32_t trainingPages)
+    : trainingPages_(trainingPages) {
+  samples_.reserve(trainingPages_);
+}
+
+ExchangePageCompressor::~ExchangePageCompressor() {
+  if (cctx_ != nullptr) {
+    ZSTD_freeCCtx(cctx_);
+  }
+}
+
+std::unique_ptr<folly::IOBuf> ExchangePageCompressor::compress(
+    std::unique_ptr<folly::IOBuf> body,
+    bool& compressed) {
+  compressed = false;
+  std::lock_guard<std::mutex> l(mutex_);
+  if (dictionary_.empty()) {
+    if (trainingFailed_) {
+      return body;
+    }
+    std::string sample;
+    sample.reserve(
+        std::min<size_t>(body->computeChainDataLength(), kMaxSampleBytes));
+    for (const auto range : *body) {
+      const auto copyBytes =
+          std::min<size_t>(range.size(), kMaxSampleBytes - sample.size());
+      sample.append(reinterpret_cast<const char*>(range.data()), copyBytes);
+      if (sample.size() == kMaxSampleBytes) {
+        break;
+      }
+    }
+    samples_.push_back(std::move(sample));
+    if (samples_.size() >= trainingPages_) {
+      trainLocked();
+    }
+    return body;
+  }
+
+  // The body arrives as an iobuf chain; zstd needs contiguous input.
+  body->coalesce();
+  const auto uncompressedBytes = body->length();
+  const auto bound = ZSTD_compressBound(uncompressedBytes);
+  auto out = folly::IOBuf::create(bound);
+  const auto ret = ZSTD_compress_usingDict(
+      cctx_,
+      out->writableData(),
+      bound,
+      body->data(),
+      uncompressedBytes,
+      dictionary_.data(),
+      dictionary_.size(),
+      kCompressionLevel);
+  if (ZSTD_isError(ret) || ret >= uncompressedBytes) {
+    // Incompressible body (or a compression error): send it as is.
+    return body;
+  }
+  out->append(ret);
+  compressed = true;
+  return out;
+}
+
+int64_t ExchangePageCompressor::dictionaryId() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return dictionaryId_;
+}
+
+std::string ExchangePageCompressor::dictionary() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return dictionary_;
+}
+
+void ExchangePageCompressor::trainLocked() {
+  std::string flatSamples;
+  std::vector<size_t> sampleSizes;
+  sampleSizes.reserve(samples_.size());
+  for (const auto& sample : samples_) {
+    flatSamples += sample;
+    sampleSizes.push_back(sample.size());
+  }
+  samples_.clear();
+  samples_.shrink_to_fit();
+
+  std::string dictionary(kMaxDictionaryBytes, '\0');
+  const auto dictionaryBytes = ZDICT_trainFromBuffer(
+      dictionary.data(),
+      dictionary.size(),
+      flatSamples.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  if (ZDICT_isError(dictionaryBytes)) {
+    LOG(WARNING) << "Exchange zstd dictionary training failed ("
+                 << ZDICT_getErrorName(dictionaryBytes)
+                 << "); sending this destination uncompressed";
+    trainingFailed_ = true;
+    return;
+  }
+  dictionary.resize(dictionaryBytes);
+  dictionary_ = std::move(dictionary);
+  dictionaryId_ = makeDictionaryId(dictionary_);
+  cctx_ = ZSTD_createCCtx();
+}
+
+ExchangePageDecompressor::~ExchangePageDecompressor() {
+  if (dctx_ != nullptr) {
+    ZSTD_freeDCtx(dctx_);
+  }
+}
+
+void ExchangePageDecompressor::setDictionary(std::string dictionary) {
+  std::lock_guard<std::mutex> l(mutex_);
+  dictionary_ = std::move(dictionary);
+  dictionaryId_ = makeDictionaryId(dictionary_);
+  if (dctx_ == nullptr) {
+    dctx_ = ZSTD_createDCtx();
+  }
+}
+
+int64_t ExchangePageDecompressor::dictionaryId() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return dictionaryId_;
+}
+
+std::unique_ptr<folly::IOBuf> ExchangePageDecompressor::decompress(
+    const folly::IOBuf& body,
+    int64_t dictionaryId) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK_EQ(
+      dictionaryId,
+      dictionaryId_,
+      "Exchange response compressed against an unknown zstd dictionary");
+
+  // Coalesce a clone rather than the body itself: the caller still owns the
+  // chained buffers and frees them through their original pointers.
+  const uint8_t* data = body.data();
+  auto compressedBytes = body.length();
+  std::unique_ptr<folly::IOBuf> coalesced;
+  if (body.isChained()) {
+    coalesced = body.cloneCoalesced();
+    data = coalesced->data();
+    compressedBytes = coalesced->length();
+  }
+
+  const auto uncompressedBytes =
+      ZSTD_getFrameContentSize(data, compressedBytes);
+  VELOX_CHECK(
+      uncompressedBytes != ZSTD_CONTENTSIZE_UNKNOWN &&
+          uncompressedBytes != ZSTD_CONTENTSIZE_ERROR,
+      "Invalid zstd frame in exchange response");
+  auto out = folly::IOBuf::create(uncompressedBytes);
+  const auto ret = ZSTD_decompress_usingDict(
+      dctx_,
+      out->writableData(),
+      uncompressedBytes,
+      data,
+      compressedBytes,
+      dictionary_.data(),
+      dictionary_.size());
+  VELOX_CHECK(
+      !ZSTD_isError(ret) && ret == uncompressedBytes,
+      "Failed to decompress exchange response: {}",
+      ZSTD_isError(ret) ? ZSTD_getErrorName(ret) : "size mismatch");
+  out->append(ret);
+  return out;
+}
+
+} // namespace facebook::presto
@@ -0,0 +1,106 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/io/IOBuf.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+namespace facebook::presto {
+
+/// Dictionary-trained zstd compression for the exchange result stream.
+/// Exchange payloads of one output buffer tend to repeat the same
+/// dictionary-encoded columns page after page, which per-page compression
+/// cannot exploit. The producing side collects the first
+/// 'exchange.zstd-dictionary-training-pages' result bodies of each output
+/// buffer as training samples, trains a zstd dictionary on them and
+/// compresses every later body against it. The consumer receives the
+/// dictionary once through the X-Presto-Page-Zstd-Dictionary response header
+/// and advertises the dictionary id it holds on subsequent requests so the
+/// blob is not re-shipped; compressed bodies are tagged with the
+/// X-Presto-Page-Zstd-Dictionary-Id header.
+class ExchangePageCompressor {
+ public:
+  explicit ExchangePageCompressor(uint32_t trainingPages);
+
+  ~ExchangePageCompressor();
+
+  /// Returns 'body' compressed against the trained dictionary, or 'body'
+  /// unchanged while the dictionary is still in training, when training
+  /// failed, or when compression would not shrink the payload. Sets
+  /// 'compressed' accordingly. Bodies seen before the dictionary is ready
+  /// double as training samples.
+  std::unique_ptr<folly::IOBuf> compress(
+      std::unique_ptr<folly::IOBuf> body,
+      bool& compressed);
+
+  /// Identifier of the trained dictionary, or -1 while no dictionary is
+  /// available.
+  int64_t dictionaryId() const;
+
+  /// The trained dictionary blob; empty while no dictionary is available.
+  std::string dictionary() const;
+
+ private:
+  // Trains the dictionary from the collected samples and frees them. A
+  // training failure (typically too few or too uniform samples) permanently
+  // disables compression for this destination.
+  void trainLocked();
+
+  const uint32_t trainingPages_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::string> samples_;
+  std::string dictionary_;
+  int64_t dictionaryId_{-1};
+  bool trainingFailed_{false};
+  ZSTD_CCtx_s* cctx_{nullptr};
+};
+
+/// Consumer-side peer of ExchangePageCompressor: remembers the dictionary
+/// shipped by the producer and decompresses response bodies tagged with its
+/// id.
+class ExchangePageDecompressor {
+ public:
+  ~ExchangePageDecompressor();
+
+  /// Remembers 'dictionary' as the dictionary to decompress against,
+  /// replacing any previously held one.
+  void setDictionary(std::string dictionary);
+
+  /// Identifier of the held dictionary, or -1 when none has been received
+  /// yet.
+  int64_t dictionaryId() const;
+
+  /// Returns the decompressed copy of 'body', which must have been
+  /// compressed against the dictionary identified by 'dictionaryId'. 'body'
+  /// is left untouched. Throws when the id does not match the held
+  /// dictionary or the payload is corrupt.
+  std::unique_ptr<folly::IOBuf> decompress(
+      const folly::IOBuf& body,
+      int64_t dictionaryId);
+
+ private:
+  mutable std::mutex mutex_;
+  std::string dictionary_;
+  int64_t dictionaryId_{-1};
+  ZSTD_DCtx_s* dctx_{nullptr};
+};
+
+} // namespace facebook::presto
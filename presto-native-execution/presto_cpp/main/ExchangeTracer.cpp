@@ -0,0 +1,80 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/ExchangeTracer.h"
+
+#include <folly/hash/Hash.h>
+#include <folly/json.h>
+
+namespace facebook::presto {
+
+ExchangeTracer* ExchangeTracer::instance() {
+  static ExchangeTracer tracer;
+  return &tracer;
+}
+
+bool ExchangeTracer::shouldSample(
+    const std::string& path,
+    uint64_t sampleEveryN) const {
+  if (sampleEveryN == 0) {
+    return false;
+  }
+  if (sampleEveryN == 1) {
+    return true;
+  }
+  return folly::hash::fnv64(path) % sampleEveryN == 0;
+}
+
+void ExchangeTracer::record(Entry entry) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (entries_.size() < kCapacity) {
+    entries_.push_back(std::move(entry));
+    return;
+  }
+  entries_[nextIndex_] = std::move(entry);
+  nextIndex_ = (nextIndex_ + 1) % kCapacity;
+}
+
+std::string ExchangeTracer::toJsonString() const {
+  folly::dynamic arrayObj = folly::dynamic::array;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    // Once the ring wrapped, the oldest entry is at 'nextIndex_'.
+    const auto numEntries = entries_.size();
+    for (size_t i = 0; i < numEntries; ++i) {
+      const auto& entry = entries_
+          [numEntries < kCapacity ? i : (nextIndex_ + i) % kCapacity];
+      folly::dynamic obj = folly::dynamic::object;
+      obj["path"] = entry.path;
+      obj["side"] = entry.producer ? "producer" : "consumer";
+      obj["startMs"] = entry.startMs;
+      obj["endMs"] = entry.endMs;
+      obj["bytes"] = entry.bytes;
+      if (entry.producer) {
+        obj["bufferWaitMs"] = entry.bufferWaitMs;
+      }
+      arrayObj.push_back(std::move(obj));
+    }
+  }
+  folly::json::serialization_opts opts;
+  opts.pretty_formatting = true;
+  return folly::json::serialize(arrayObj, opts);
+}
+
+void ExchangeTracer::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  nextIndex_ = 0;
+}
+
+} // namespace facebook::presto
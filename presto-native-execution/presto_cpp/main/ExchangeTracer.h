@@ -0,0 +1,77 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::presto {
+
+/// Bounded in-memory trace of exchange request timing, used to attribute slow
+/// exchanges to producer buffer wait, network transfer or consumer
+/// processing. The producing side (TaskResource) and the consuming side
+/// (PrestoExchangeSource) each record an entry per sampled request; both
+/// sides key the sampling decision on the hash of the request path
+/// '/v1/task/{taskId}/results/{bufferId}/{token}', so a sampled page is
+/// stamped on every worker it passes through and the records can be joined
+/// by path offline. Sampling is controlled by 'exchange.trace-sample-every-n'
+/// (0 disables tracing) and the trace is exposed through the
+/// server/getExchangeTrace operation.
+class ExchangeTracer {
+ public:
+  struct Entry {
+    /// Request path including the page token.
+    std::string path;
+    /// True when recorded by the side serving the page, false when recorded
+    /// by the side fetching it.
+    bool producer;
+    /// Request issued (consumer) or received (producer) time.
+    int64_t startMs;
+    /// Response processed (consumer) or reply started (producer) time.
+    int64_t endMs;
+    /// Page bytes, or -1 when not known on this side.
+    int64_t bytes;
+    /// Producer only: time the request waited for data in the output buffer.
+    int64_t bufferWaitMs;
+  };
+
+  static ExchangeTracer* instance();
+
+  /// Returns true if the request at 'path' should be traced: 1 in every
+  /// 'sampleEveryN' paths by hash, so both sides of an exchange make the same
+  /// decision. 'sampleEveryN' of 0 disables tracing.
+  bool shouldSample(const std::string& path, uint64_t sampleEveryN) const;
+
+  /// Appends 'entry', overwriting the oldest entry when the trace is full.
+  void record(Entry entry);
+
+  /// Returns the recorded entries as a pretty-printed json array, oldest
+  /// first.
+  std::string toJsonString() const;
+
+  /// Drops all recorded entries.
+  void clear();
+
+ private:
+  static constexpr size_t kCapacity = 4096;
+
+  mutable std::mutex mutex_;
+  // Ring buffer: 'nextIndex_' is the slot the next entry overwrites.
+  std::vector<Entry> entries_;
+  size_t nextIndex_{0};
+};
+
+} // namespace facebook::presto
@@ -0,0 +1,489 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/FragmentResultCache.h"
+
+#include <folly/hash/Hash.h>
+
+#include "presto_cpp/main/types/DirectVeloxSplit.h"
+
+#include "velox/common/file/File.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::presto {
+namespace {
+
+constexpr std::string_view kEntryFileSuffix{".bin"};
+
+// On-disk entry layout: this header followed by 'numPages' pages, each a
+// little-endian uint64_t byte count followed by the page bytes.
+struct EntryFileHeader {
+  uint32_t magic{0};
+  uint32_t version{0};
+  uint64_t createTimeMs{0};
+  uint64_t numPages{0};
+};
+
+constexpr uint32_t kEntryFileMagic = 0x50465243; // 'PFRC'
+constexpr uint32_t kEntryFileVersion = 1;
+
+uint64_t hashString(const std::string& value) {
+  return folly::hash::fnv64(value);
+}
+
+uint64_t mix(uint64_t a, uint64_t b) {
+  return folly::hash::hash_128_to_64(a, b);
+}
+
+// Hashes a string-to-string map in its (sorted) key order.
+uint64_t hashStringMap(
+    uint64_t seed,
+    const protocol::Map<protocol::String, protocol::String>& map) {
+  for (const auto& [key, value] : map) {
+    seed = mix(seed, mix(hashString(key), hashString(value)));
+  }
+  return seed;
+}
+
+void appendRaw(velox::WriteFile& file, const void* data, size_t size) {
+  file.append(std::string_view(static_cast<const char*>(data), size));
+}
+
+} // namespace
+
+FragmentResultCapture::FragmentResultCapture(
+    FragmentResultCache* cache,
+    std::string key,
+    uint64_t maxEntryBytes)
+    : cache_(cache), key_(std::move(key)), maxEntryBytes_(maxEntryBytes) {}
+
+FragmentResultCapture::~FragmentResultCapture() {
+  // A capture destroyed unpublished (its task failed or was deleted) frees
+  // any remaining subscribers to run the fragment themselves.
+  std::vector<Subscriber> subscribers;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    subscribers = std::move(subscribers_);
+  }
+  for (auto& subscriber : subscribers) {
+    subscriber(nullptr);
+  }
+}
+
+void FragmentResultCapture::append(
+    int64_t sequence,
+    const std::vector<std::unique_ptr<folly::IOBuf>>& pages) {
+  std::vector<Subscriber> subscribers;
+  std::shared_ptr<const FragmentResultCacheEntry> publishedEntry;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (abandoned_ || published_) {
+      return;
+    }
+    int64_t token = sequence;
+    for (const auto& page : pages) {
+      if (page == nullptr) {
+        endSequence_ = token;
+        break;
+      }
+      auto [it, inserted] = pages_.try_emplace(token, nullptr);
+      if (inserted) {
+        it->second = page->clone();
+        capturedBytes_ += page->computeChainDataLength();
+        if (capturedBytes_ > maxEntryBytes_) {
+          abandoned_ = true;
+          pages_.clear();
+          break;
+        }
+      }
+      ++token;
+    }
+    if (!abandoned_) {
+      maybePublishLocked();
+    }
+    if (published_ || abandoned_) {
+      subscribers = std::move(subscribers_);
+      publishedEntry = publishedEntry_;
+    }
+  }
+  // Notify without the lock held: subscribers call back into the task
+  // manager, which takes its own locks.
+  for (auto& subscriber : subscribers) {
+    subscriber(publishedEntry);
+  }
+}
+
+bool FragmentResultCapture::subscribe(Subscriber subscriber) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (published_ || abandoned_) {
+    return false;
+  }
+  subscribers_.push_back(std::move(subscriber));
+  return true;
+}
+
+void FragmentResultCapture::maybePublishLocked() {
+  if (published_ || abandoned_ || endSequence_ < 0) {
+    return;
+  }
+  // Publish only once every token in [0, endSequence_) has been captured.
+  if (static_cast<int64_t>(pages_.size()) != endSequence_ ||
+      (!pages_.empty() && pages_.begin()->first != 0)) {
+    return;
+  }
+  auto entry = std::make_shared<FragmentResultCacheEntry>();
+  entry->pages.reserve(pages_.size());
+  for (auto& [token, page] : pages_) {
+    // Deep-copy the page so the cached entry does not pin the memory of the
+    // task's output buffers past the task's lifetime.
+    auto copy = folly::IOBuf::copyBuffer(page->coalesce());
+    entry->totalBytes += copy->length();
+    entry->pages.push_back(std::move(copy));
+  }
+  entry->createTimeMs = velox::getCurrentTimeMs();
+  cache_->put(key_, entry);
+  publishedEntry_ = std::move(entry);
+  published_ = true;
+  pages_.clear();
+}
+
+FragmentResultCache::FragmentResultCache(
+    uint64_t maxBytes,
+    uint64_t maxEntryBytes,
+    uint64_t ttlMs,
+    const std::string& baseDirectory,
+    uint64_t maxDiskBytes)
+    : maxBytes_(maxBytes),
+      maxEntryBytes_(maxEntryBytes),
+      ttlMs_(ttlMs),
+      baseDirectory_(baseDirectory),
+      maxDiskBytes_(maxDiskBytes) {
+  loadDiskIndex();
+}
+
+// static
+std::optional<std::string> FragmentResultCache::makeKey(
+    const protocol::TaskUpdateRequest& updateRequest) {
+  if (updateRequest.fragment == nullptr) {
+    return std::nullopt;
+  }
+  const uint64_t fragmentHash = hashString(*updateRequest.fragment);
+
+  // Combine per-split hashes commutatively, so refreshes that enumerate the
+  // same splits in a different order produce the same key. The transaction
+  // handle and split sequence ids vary per execution and are left out.
+  uint64_t splitsHash = 0;
+  for (const auto& source : updateRequest.sources) {
+    for (const auto& scheduledSplit : source.splits) {
+      uint64_t splitHash;
+      if (auto directSplit =
+              std::dynamic_pointer_cast<const DirectVeloxSplit>(
+                  scheduledSplit.split.connectorSplit)) {
+        // Directly converted splits carry no protocol struct to render as
+        // JSON; hash the raw payload instead. Keys therefore differ between
+        // the Thrift and JSON transports for the same fragment.
+        splitHash = directSplit->payloadHash;
+      } else {
+        nlohmann::json splitJson = scheduledSplit.split.connectorSplit;
+        splitHash = hashString(splitJson.dump());
+      }
+      splitsHash += mix(hashString(source.planNodeId), splitHash);
+    }
+  }
+
+  const auto& session = updateRequest.session;
+  uint64_t sessionHash = hashString(session.user);
+  sessionHash = mix(sessionHash, session.timeZoneKey);
+  sessionHash = mix(sessionHash, hashString(session.locale));
+  if (session.catalog != nullptr) {
+    sessionHash = mix(sessionHash, hashString(*session.catalog));
+  }
+  if (session.schema != nullptr) {
+    sessionHash = mix(sessionHash, hashString(*session.schema));
+  }
+  sessionHash = hashStringMap(sessionHash, session.systemProperties);
+  for (const auto& [catalog, properties] : session.catalogProperties) {
+    sessionHash =
+        hashStringMap(mix(sessionHash, hashString(catalog)), properties);
+  }
+  for (const auto& [name, role] : session.roles) {
+    nlohmann::json roleJson = role;
+    sessionHash =
+        mix(sessionHash, mix(hashString(name), hashString(roleJson.dump())));
+  }
+
+  return fmt::format(
+      "{:016x}.{:016x}.{:016x}", fragmentHash, splitsHash, sessionHash);
+}
+
+std::shared_ptr<const FragmentResultCacheEntry> FragmentResultCache::get(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    if (expired(it->second.entry->createTimeMs)) {
+      usedBytes_ -= it->second.entry->totalBytes;
+      lru_.erase(it->second.lruPosition);
+      entries_.erase(it);
+      return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+    return it->second.entry;
+  }
+
+  auto diskIt = diskEntries_.find(key);
+  if (diskIt == diskEntries_.end()) {
+    return nullptr;
+  }
+  if (expired(diskIt->second.createTimeMs)) {
+    removeDiskEntryLocked(key);
+    return nullptr;
+  }
+  auto entry = loadFromDiskLocked(key);
+  removeDiskEntryLocked(key);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  putLocked(key, entry);
+  return entry;
+}
+
+void FragmentResultCache::put(
+    const std::string& key,
+    std::shared_ptr<const FragmentResultCacheEntry> entry) {
+  std::lock_guard<std::mutex> l(mutex_);
+  putLocked(key, std::move(entry));
+}
+
+void FragmentResultCache::putLocked(
+    const std::string& key,
+    std::shared_ptr<const FragmentResultCacheEntry> entry) {
+  if (entry == nullptr || entry->totalBytes > maxEntryBytes_ ||
+      entry->totalBytes > maxBytes_) {
+    return;
+  }
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    usedBytes_ -= it->second.entry->totalBytes;
+    lru_.erase(it->second.lruPosition);
+    entries_.erase(it);
+  }
+  lru_.push_front(key);
+  usedBytes_ += entry->totalBytes;
+  entries_[key] = MemoryEntry{std::move(entry), lru_.begin()};
+  evictLocked();
+}
+
+std::shared_ptr<FragmentResultCapture> FragmentResultCache::startCapture(
+    const std::string& key) {
+  auto capture =
+      std::make_shared<FragmentResultCapture>(this, key, maxEntryBytes_);
+  std::lock_guard<std::mutex> l(mutex_);
+  // Drop registrations whose captures are gone before adding the new one.
+  for (auto it = captures_.begin(); it != captures_.end();) {
+    it = it->second.expired() ? captures_.erase(it) : std::next(it);
+  }
+  captures_[key] = capture;
+  return capture;
+}
+
+std::shared_ptr<FragmentResultCapture> FragmentResultCache::findCapture(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = captures_.find(key);
+  if (it == captures_.end()) {
+    return nullptr;
+  }
+  auto capture = it->second.lock();
+  if (capture == nullptr) {
+    captures_.erase(it);
+  }
+  return capture;
+}
+
+size_t FragmentResultCache::numMemoryEntries() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return entries_.size();
+}
+
+size_t FragmentResultCache::numDiskEntries() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return diskEntries_.size();
+}
+
+bool FragmentResultCache::expired(uint64_t createTimeMs) const {
+  return ttlMs_ != 0 && velox::getCurrentTimeMs() > createTimeMs + ttlMs_;
+}
+
+std::string FragmentResultCache::entryFilePath(const std::string& key) const {
+  return fmt::format("{}/{}{}", baseDirectory_, key, kEntryFileSuffix);
+}
+
+void FragmentResultCache::loadDiskIndex() {
+  if (baseDirectory_.empty()) {
+    return;
+  }
+  try {
+    auto fs = velox::filesystems::getFileSystem(baseDirectory_, nullptr);
+    if (!fs->exists(baseDirectory_)) {
+      fs->mkdir(baseDirectory_);
+      return;
+    }
+    for (const auto& path : fs->list(baseDirectory_)) {
+      if (path.size() <= kEntryFileSuffix.size() ||
+          path.compare(
+              path.size() - kEntryFileSuffix.size(),
+              kEntryFileSuffix.size(),
+              kEntryFileSuffix) != 0) {
+        continue;
+      }
+      auto file = fs->openFileForRead(path);
+      EntryFileHeader header;
+      if (file->size() < sizeof(header)) {
+        continue;
+      }
+      file->pread(0, sizeof(header), &header);
+      if (header.magic != kEntryFileMagic ||
+          header.version != kEntryFileVersion) {
+        continue;
+      }
+      if (expired(header.createTimeMs)) {
+        fs->remove(path);
+        continue;
+      }
+      const auto fileName = path.substr(path.find_last_of('/') + 1);
+      const auto key =
+          fileName.substr(0, fileName.size() - kEntryFileSuffix.size());
+      diskEntries_[key] = DiskEntry{file->size(), header.createTimeMs};
+      diskUsedBytes_ += file->size();
+    }
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to load fragment result cache disk index from "
+                 << baseDirectory_ << ": " << e.what();
+  }
+}
+
+void FragmentResultCache::evictLocked() {
+  while (usedBytes_ > maxBytes_ && !lru_.empty()) {
+    const auto key = lru_.back();
+    auto it = entries_.find(key);
+    if (!expired(it->second.entry->createTimeMs)) {
+      spillToDiskLocked(key, *it->second.entry);
+    }
+    usedBytes_ -= it->second.entry->totalBytes;
+    lru_.pop_back();
+    entries_.erase(it);
+  }
+}
+
+void FragmentResultCache::spillToDiskLocked(
+    const std::string& key,
+    const FragmentResultCacheEntry& entry) {
+  if (baseDirectory_.empty() || entry.totalBytes > maxDiskBytes_) {
+    return;
+  }
+  removeDiskEntryLocked(key);
+  // Make room, dropping the oldest disk entries first.
+  while (!diskEntries_.empty() &&
+         diskUsedBytes_ + entry.totalBytes > maxDiskBytes_) {
+    auto oldest = diskEntries_.begin();
+    for (auto it = diskEntries_.begin(); it != diskEntries_.end(); ++it) {
+      if (it->second.createTimeMs < oldest->second.createTimeMs) {
+        oldest = it;
+      }
+    }
+    removeDiskEntryLocked(oldest->first);
+  }
+  try {
+    auto fs = velox::filesystems::getFileSystem(baseDirectory_, nullptr);
+    const auto path = entryFilePath(key);
+    auto file = fs->openFileForWrite(path);
+    EntryFileHeader header{
+        kEntryFileMagic,
+        kEntryFileVersion,
+        entry.createTimeMs,
+        entry.pages.size()};
+    appendRaw(*file, &header, sizeof(header));
+    for (const auto& page : entry.pages) {
+      const uint64_t pageBytes = page->computeChainDataLength();
+      appendRaw(*file, &pageBytes, sizeof(pageBytes));
+      const folly::IOBuf* current = page.get();
+      do {
+        appendRaw(*file, current->data(), current->length());
+        current = current->next();
+      } while (current != page.get());
+    }
+    file->close();
+    diskEntries_[key] = DiskEntry{entry.totalBytes, entry.createTimeMs};
+    diskUsedBytes_ += entry.totalBytes;
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to spill fragment result cache entry " << key
+                 << " to disk: " << e.what();
+  }
+}
+
+std::shared_ptr<const FragmentResultCacheEntry>
+FragmentResultCache::loadFromDiskLocked(const std::string& key) {
+  try {
+    auto fs = velox::filesystems::getFileSystem(baseDirectory_, nullptr);
+    auto file = fs->openFileForRead(entryFilePath(key));
+    EntryFileHeader header;
+    if (file->size() < sizeof(header)) {
+      return nullptr;
+    }
+    file->pread(0, sizeof(header), &header);
+    if (header.magic != kEntryFileMagic ||
+        header.version != kEntryFileVersion) {
+      return nullptr;
+    }
+    auto entry = std::make_shared<FragmentResultCacheEntry>();
+    entry->createTimeMs = header.createTimeMs;
+    entry->pages.reserve(header.numPages);
+    uint64_t offset = sizeof(header);
+    for (uint64_t i = 0; i < header.numPages; ++i) {
+      uint64_t pageBytes;
+      file->pread(offset, sizeof(pageBytes), &pageBytes);
+      offset += sizeof(pageBytes);
+      auto page = folly::IOBuf::create(pageBytes);
+      file->pread(offset, pageBytes, page->writableData());
+      page->append(pageBytes);
+      offset += pageBytes;
+      entry->totalBytes += pageBytes;
+      entry->pages.push_back(std::move(page));
+    }
+    return entry;
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to load fragment result cache entry " << key
+                 << " from disk: " << e.what();
+    return nullptr;
+  }
+}
+
+void FragmentResultCache::removeDiskEntryLocked(const std::string& key) {
+  auto it = diskEntries_.find(key);
+  if (it == diskEntries_.end()) {
+    return;
+  }
+  diskUsedBytes_ -= it->second.bytes;
+  diskEntries_.erase(it);
+  try {
+    auto fs = velox::filesystems::getFileSystem(baseDirectory_, nullptr);
+    fs->remove(entryFilePath(key));
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to remove fragment result cache entry file for "
+                 << key << ": " << e.what();
+  }
+}
+
+} // namespace facebook::presto
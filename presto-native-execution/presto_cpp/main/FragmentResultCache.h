@@ -0,0 +1,211 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/io/IOBuf.h>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
+
+namespace facebook::presto {
+
+class FragmentResultCache;
+
+/// Final output pages of one cached plan fragment execution.
+struct FragmentResultCacheEntry {
+  /// Wire-format (SerializedPage) pages exactly as they were handed to the
+  /// coordinator, one per output sequence token. Serving a hit clones these,
+  /// so no re-serialization happens.
+  std::vector<std::unique_ptr<folly::IOBuf>> pages;
+
+  /// Total page bytes, used for cache budget accounting.
+  uint64_t totalBytes{0};
+
+  /// Wall time the entry was published at, in milliseconds since epoch.
+  /// Entries older than the configured TTL are dropped on lookup.
+  uint64_t createTimeMs{0};
+};
+
+/// Collects the final output pages of a running task whose fragment result
+/// cache probe missed. Pages are recorded as the coordinator fetches them
+/// and the entry is published to the cache once the end-of-data marker has
+/// been seen and every sequence token from zero on has been captured.
+/// Capture abandons itself when the output exceeds the per-entry byte limit.
+class FragmentResultCapture {
+ public:
+  /// Invoked exactly once per subscriber, with the published entry on
+  /// publish or nullptr if the capture gave up (abandoned, or destroyed
+  /// unpublished because its task failed or was deleted). Called without
+  /// the capture's lock held.
+  using Subscriber =
+      std::function<void(std::shared_ptr<const FragmentResultCacheEntry>)>;
+
+  FragmentResultCapture(
+      FragmentResultCache* cache,
+      std::string key,
+      uint64_t maxEntryBytes);
+
+  ~FragmentResultCapture();
+
+  /// Records the pages returned for 'sequence' by the output buffer, in the
+  /// order the callback delivers them. A null page marks the end of data.
+  /// Repeated fetches of the same sequence are deduplicated. Thread-safe.
+  void append(
+      int64_t sequence,
+      const std::vector<std::unique_ptr<folly::IOBuf>>& pages);
+
+  /// Registers 'subscriber' to be notified when this capture publishes or
+  /// gives up. Returns false without registering if the outcome is already
+  /// known; the caller should consult the cache directly instead.
+  bool subscribe(Subscriber subscriber);
+
+ private:
+  // Publishes the captured pages to the cache if the end marker has been
+  // seen and tokens [0, endSequence_) have all been captured.
+  void maybePublishLocked();
+
+  FragmentResultCache* const cache_;
+  const std::string key_;
+  const uint64_t maxEntryBytes_;
+
+  std::mutex mutex_;
+  // Captured pages keyed by sequence token.
+  std::map<int64_t, std::unique_ptr<folly::IOBuf>> pages_;
+  uint64_t capturedBytes_{0};
+  // Token of the end-of-data marker, or -1 if not seen yet.
+  int64_t endSequence_{-1};
+  bool abandoned_{false};
+  bool published_{false};
+  // The entry handed to the cache on publish, kept to notify subscribers.
+  std::shared_ptr<const FragmentResultCacheEntry> publishedEntry_;
+  std::vector<Subscriber> subscribers_;
+};
+
+/// Worker-local cache of final task output for deterministic plan fragments
+/// that dashboard tiers re-execute verbatim on every refresh. Keyed on the
+/// serialized plan fragment, the split set and the result-relevant part of
+/// the session, a hit serves the previously produced output pages without
+/// creating a velox task. Entries live in a bounded in-memory LRU tier and,
+/// when a base directory is configured, overflow to a bounded disk tier that
+/// survives restarts. Opt-in via fragment-result-cache.enabled: the cache
+/// cannot tell deterministic fragments from nondeterministic ones, so it
+/// should only be enabled for workloads whose fragments are deterministic
+/// and whose inputs are immutable within the TTL.
+class FragmentResultCache {
+ public:
+  FragmentResultCache(
+      uint64_t maxBytes,
+      uint64_t maxEntryBytes,
+      uint64_t ttlMs,
+      const std::string& baseDirectory,
+      uint64_t maxDiskBytes);
+
+  /// Builds the cache key for 'updateRequest' by combining the hash of the
+  /// serialized plan fragment, an order-independent hash of the split set
+  /// and a hash of the result-relevant session fields (user, catalog,
+  /// schema, time zone, locale, roles and the system and catalog
+  /// properties). Per-execution fields such as the query id or trace token
+  /// are deliberately left out so identical refreshes produce identical
+  /// keys. Returns std::nullopt if the update carries no plan fragment.
+  static std::optional<std::string> makeKey(
+      const protocol::TaskUpdateRequest& updateRequest);
+
+  /// Returns the entry cached under 'key', or nullptr. Expired entries are
+  /// dropped and disk-tier hits are promoted back into the memory tier.
+  std::shared_ptr<const FragmentResultCacheEntry> get(const std::string& key);
+
+  /// Caches 'entry' under 'key'. Least recently used entries over the memory
+  /// budget are evicted, to the disk tier when a base directory is
+  /// configured. Entries over the per-entry byte limit are ignored.
+  void put(
+      const std::string& key,
+      std::shared_ptr<const FragmentResultCacheEntry> entry);
+
+  /// Returns a capture that publishes the output of a task that missed
+  /// under 'key' back into this cache.
+  std::shared_ptr<FragmentResultCapture> startCapture(const std::string& key);
+
+  /// Returns the live capture started under 'key' by a task that is still
+  /// running, or nullptr. Lets concurrent identical fragments subscribe to
+  /// one execution instead of starting their own.
+  std::shared_ptr<FragmentResultCapture> findCapture(const std::string& key);
+
+  size_t numMemoryEntries() const;
+
+  size_t numDiskEntries() const;
+
+ private:
+  struct DiskEntry {
+    uint64_t bytes{0};
+    uint64_t createTimeMs{0};
+  };
+
+  bool expired(uint64_t createTimeMs) const;
+
+  void putLocked(
+      const std::string& key,
+      std::shared_ptr<const FragmentResultCacheEntry> entry);
+
+  std::string entryFilePath(const std::string& key) const;
+
+  // Scans the base directory and rebuilds the disk-tier index from the entry
+  // files left by a previous run.
+  void loadDiskIndex();
+
+  // Drops least recently used memory entries until the memory tier fits the
+  // budget, spilling each dropped entry to the disk tier when configured.
+  void evictLocked();
+
+  void spillToDiskLocked(
+      const std::string& key,
+      const FragmentResultCacheEntry& entry);
+
+  std::shared_ptr<const FragmentResultCacheEntry> loadFromDiskLocked(
+      const std::string& key);
+
+  void removeDiskEntryLocked(const std::string& key);
+
+  const uint64_t maxBytes_;
+  const uint64_t maxEntryBytes_;
+  const uint64_t ttlMs_;
+  const std::string baseDirectory_;
+  const uint64_t maxDiskBytes_;
+
+  mutable std::mutex mutex_;
+  // Memory tier: keys in LRU order, most recently used first.
+  std::list<std::string> lru_;
+  struct MemoryEntry {
+    std::shared_ptr<const FragmentResultCacheEntry> entry;
+    std::list<std::string>::iterator lruPosition;
+  };
+  std::unordered_map<std::string, MemoryEntry> entries_;
+  uint64_t usedBytes_{0};
+  // Disk tier index; eviction drops the oldest entry by creation time.
+  std::unordered_map<std::string, DiskEntry> diskEntries_;
+  uint64_t diskUsedBytes_{0};
+  // Captures of fragments currently running, keyed like the cache. Weak so
+  // a registration never outlives its task; dead ones are pruned lazily.
+  std::unordered_map<std::string, std::weak_ptr<FragmentResultCapture>>
+      captures_;
+};
+
+} // namespace facebook::presto
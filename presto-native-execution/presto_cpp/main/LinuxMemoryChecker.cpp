@@ -13,6 +13,8 @@
  */
 
 #include <boost/regex.hpp>
+#include <folly/File.h>
+#include <folly/FileUtil.h>
 #include <folly/Singleton.h>
 #include <folly/gen/File.h>
 #include <sys/stat.h>
@@ -68,6 +70,7 @@ class LinuxMemoryChecker : public PeriodicMemoryChecker {
 
   void setStatFile(std::string statFile) {
     memStatFile_ = statFile;
+    memStatFd_ = folly::File();
     LOG(INFO) << fmt::format(
         "Changed to using memory stat file {}", memStatFile_);
   }
@@ -80,6 +83,7 @@ class LinuxMemoryChecker : public PeriodicMemoryChecker {
   // This function is used for testing.
   void setMemInfoFile(const std::string& memInfoFile) {
     memInfoFile_ = memInfoFile;
+    memInfoFd_ = folly::File();
   }
 
   void start() override {
@@ -181,56 +185,27 @@ class LinuxMemoryChecker : public PeriodicMemoryChecker {
   // consistency we will match cgroup V1 and change if
   // necessary.
   void loadSystemMemoryUsage() override {
-    size_t memAvailable = 0;
-    size_t memTotal = 0;
-    size_t inactiveAnon = 0;
-    size_t activeAnon = 0;
-
-    if (!memStatFile_.empty()) {
-      folly::gen::byLine(memStatFile_.c_str()) |
-          [&](const folly::StringPiece& line) -> void {
-        if (inactiveAnon == 0) {
-          inactiveAnon =
-              extractNumericConfigValueWithRegex(line, kInactiveAnonRegex);
-        }
-
-        if (activeAnon == 0) {
-          activeAnon =
-              extractNumericConfigValueWithRegex(line, kActiveAnonRegex);
-        }
-
-        if (activeAnon != 0 && inactiveAnon != 0) {
-          return;
-        }
-      };
-
+    if (!memStatFile_.empty() &&
+        readProcFile(memStatFile_, memStatFd_, readBuffer_)) {
       // Unit is in bytes.
-      const auto memBytes = inactiveAnon + activeAnon;
-      cachedSystemUsedMemoryBytes_ = memBytes;
+      cachedSystemUsedMemoryBytes_ =
+          statValue(readBuffer_, "inactive_anon ") +
+          statValue(readBuffer_, "active_anon ");
       return;
     }
 
     // Last resort use host machine info.
-    folly::gen::byLine(memInfoFile_.c_str()) |
-        [&](const folly::StringPiece& line) -> void {
-      if (memAvailable == 0) {
-        memAvailable =
-            extractNumericConfigValueWithRegex(line, kMemAvailableRegex) * 1024;
-      }
-
-      if (memTotal == 0) {
-        memTotal =
-            extractNumericConfigValueWithRegex(line, kMemTotalRegex) * 1024;
-      }
-
-      if (memAvailable != 0 && memTotal != 0) {
-        return;
-      }
-    };
+    if (!readProcFile(memInfoFile_, memInfoFd_, readBuffer_)) {
+      cachedSystemUsedMemoryBytes_ = 0;
+      return;
+    }
+    // meminfo's unit is in kB.
+    const size_t memAvailable =
+        statValue(readBuffer_, "MemAvailable:") * 1024;
+    const size_t memTotal = statValue(readBuffer_, "MemTotal:") * 1024;
     // Unit is in bytes.
-    const auto memBytes =
+    cachedSystemUsedMemoryBytes_ =
         (memAvailable && memTotal) ? memTotal - memAvailable : 0;
-    cachedSystemUsedMemoryBytes_ = memBytes;
   }
 
   int64_t mallocBytes() const override {
@@ -250,9 +225,69 @@ class LinuxMemoryChecker : public PeriodicMemoryChecker {
   }
 
  private:
-  const boost::regex kInactiveAnonRegex{R"!(inactive_anon\s*(\d+)\s*)!"};
-  const boost::regex kActiveAnonRegex{R"!(active_anon\s*(\d+)\s*)!"};
-  const boost::regex kMemAvailableRegex{R"!(MemAvailable:\s*(\d+)\s*kB)!"};
+  // Reads the whole proc/cgroup pseudo file at 'path' into 'out' with
+  // pread(), opening and caching the descriptor in 'fd' on first use so the
+  // periodic check does not reopen and buffer the file every interval.
+  // Returns false and drops the descriptor on error so the next check
+  // reopens it.
+  static bool
+  readProcFile(const std::string& path, folly::File& fd, std::string& out) {
+    if (fd.fd() < 0) {
+      auto file = folly::File::makeFile(path);
+      if (file.hasError()) {
+        return false;
+      }
+      fd = std::move(file.value());
+    }
+    out.clear();
+    char buf[8192];
+    off_t offset = 0;
+    while (true) {
+      const auto bytesRead =
+          folly::preadNoInt(fd.fd(), buf, sizeof(buf), offset);
+      if (bytesRead < 0) {
+        fd = folly::File();
+        return false;
+      }
+      if (bytesRead == 0) {
+        return true;
+      }
+      out.append(buf, bytesRead);
+      offset += bytesRead;
+    }
+  }
+
+  // Returns the integer following the first line of 'contents' that starts
+  // with 'prefix', or 0 if there is no such line. 'prefix' includes the
+  // key/value separator so 'active_anon ' does not match the 'active_anon_*'
+  // keys of newer kernels.
+  static size_t statValue(
+      const std::string& contents,
+      const folly::StringPiece prefix) {
+    size_t lineStart = 0;
+    while (lineStart < contents.size()) {
+      auto lineEnd = contents.find('\n', lineStart);
+      if (lineEnd == std::string::npos) {
+        lineEnd = contents.size();
+      }
+      if (contents.compare(
+              lineStart, prefix.size(), prefix.data(), prefix.size()) == 0) {
+        auto pos = lineStart + prefix.size();
+        while (pos < lineEnd && contents[pos] == ' ') {
+          ++pos;
+        }
+        size_t value = 0;
+        while (pos < lineEnd && contents[pos] >= '0' && contents[pos] <= '9') {
+          value = value * 10 + (contents[pos] - '0');
+          ++pos;
+        }
+        return value;
+      }
+      lineStart = lineEnd + 1;
+    }
+    return 0;
+  }
+
   const boost::regex kMemTotalRegex{R"!(MemTotal:\s*(\d+)\s+kB)!"};
   const char* kCgroupV1Path = "/sys/fs/cgroup/memory";
   const char* kCgroupV1MemStatFile = "/sys/fs/cgroup/memory/memory.stat";
@@ -263,6 +298,10 @@ class LinuxMemoryChecker : public PeriodicMemoryChecker {
   std::string memInfoFile_ = "/proc/meminfo";
   std::string memStatFile_;
   std::string memMaxFile_;
+  // Cached descriptors and reusable read buffer for the periodic check.
+  folly::File memStatFd_;
+  folly::File memInfoFd_;
+  std::string readBuffer_;
 
   size_t extractNumericConfigValueWithRegex(
       const folly::StringPiece& line,
@@ -287,6 +326,8 @@ std::unique_ptr<PeriodicMemoryChecker> createMemoryChecker() {
         static_cast<uint64_t>(systemConfig->systemMemLimitGb()) << 30;
     config.systemMemShrinkBytes =
         static_cast<uint64_t>(systemConfig->systemMemShrinkGb()) << 30;
+    config.systemMemPushbackArbitrationRatio =
+        systemConfig->systemMemPushbackArbitrationRatio();
     return std::make_unique<LinuxMemoryChecker>(config);
   }
   return nullptr;
@@ -12,14 +12,29 @@
  * limitations under the License.
  */
 #include "presto_cpp/main/PeriodicHeartbeatManager.h"
+#include <cmath>
+#include "velox/common/time/Timer.h"
 
 namespace facebook::presto {
+namespace {
+
+// A heartbeat carries fresh stats when cpu load moved by at least this many
+// percentage points, or heap usage by at least this fraction of the heap,
+// since the last serialized status; smaller moves just re-send the cached
+// body as a liveness signal.
+constexpr double kCpuLoadDeltaPct = 5.0;
+constexpr double kHeapUsedDeltaRatio = 0.05;
+
+} // namespace
+
 PeriodicHeartbeatManager::PeriodicHeartbeatManager(
     const std::string& address,
     int port,
     const std::shared_ptr<CoordinatorDiscoverer>& coordinatorDiscoverer,
     folly::SSLContextPtr sslContext,
     std::function<protocol::NodeStatus()> nodeStatusFetcher,
+    bool statsDeltaEnabled,
+    uint64_t statsMaxAgeMs,
     uint64_t frequencyMs)
     : PeriodicServiceInventoryManager(
           address,
@@ -28,13 +43,58 @@ PeriodicHeartbeatManager::PeriodicHeartbeatManager(
           std::move(sslContext),
           "Heartbeat",
           frequencyMs),
-      nodeStatusFetcher_(std::move(nodeStatusFetcher)) {}
+      nodeStatusFetcher_(std::move(nodeStatusFetcher)),
+      statsDeltaEnabled_(statsDeltaEnabled),
+      statsMaxAgeMs_(statsMaxAgeMs) {}
+
+bool PeriodicHeartbeatManager::statsChangedSignificantly(
+    const protocol::NodeStatus& current) const {
+  if (std::abs(current.processCpuLoad - lastSentStatus_.processCpuLoad) >=
+      kCpuLoadDeltaPct) {
+    return true;
+  }
+  if (std::abs(current.heapUsed - lastSentStatus_.heapUsed) >=
+      kHeapUsedDeltaRatio * std::max<int64_t>(current.heapAvailable, 1)) {
+    return true;
+  }
+  // Memory pool membership changes (queries arriving or finishing) must reach
+  // the coordinator promptly; byte-level churn within a pool is already
+  // covered by the heap threshold above.
+  if (current.memoryInfo.pools.size() !=
+      lastSentStatus_.memoryInfo.pools.size()) {
+    return true;
+  }
+  for (const auto& [poolId, poolInfo] : current.memoryInfo.pools) {
+    auto it = lastSentStatus_.memoryInfo.pools.find(poolId);
+    if (it == lastSentStatus_.memoryInfo.pools.end() ||
+        it->second.queryMemoryReservations.size() !=
+            poolInfo.queryMemoryReservations.size()) {
+      return true;
+    }
+  }
+  return false;
+}
 
 std::tuple<proxygen::HTTPMessage, std::string>
 PeriodicHeartbeatManager::httpRequest() {
-  nlohmann::json j;
-  to_json(j, nodeStatusFetcher_());
-  std::string body = j.dump();
+  auto nodeStatus = nodeStatusFetcher_();
+  std::string body;
+  if (statsDeltaEnabled_ && !lastSentBody_.empty() && failedAttempts_ == 0 &&
+      velox::getCurrentTimeMs() < lastSentTimeMs_ + statsMaxAgeMs_ &&
+      !statsChangedSignificantly(nodeStatus)) {
+    // Stats stayed within the significance thresholds; re-send the cached
+    // serialized status so steady-state heartbeats skip the JSON
+    // serialization of the full memory pool tree. A failed heartbeat falls
+    // back to a fresh payload since the coordinator may have lost our state.
+    body = lastSentBody_;
+  } else {
+    nlohmann::json j;
+    to_json(j, nodeStatus);
+    body = j.dump();
+    lastSentStatus_ = std::move(nodeStatus);
+    lastSentBody_ = body;
+    lastSentTimeMs_ = velox::getCurrentTimeMs();
+  }
   proxygen::HTTPMessage request;
   request.setMethod(proxygen::HTTPMethod::PUT);
   request.setURL("/v1/heartbeat");
@@ -26,6 +26,8 @@ class PeriodicHeartbeatManager : public PeriodicServiceInventoryManager {
       const std::shared_ptr<CoordinatorDiscoverer>& coordinatorDiscoverer,
       folly::SSLContextPtr sslContext,
       std::function<protocol::NodeStatus()> nodeStatusFetcher,
+      bool statsDeltaEnabled,
+      uint64_t statsMaxAgeMs,
       uint64_t frequencyMs);
 
  protected:
@@ -40,6 +42,20 @@ class PeriodicHeartbeatManager : public PeriodicServiceInventoryManager {
   std::tuple<proxygen::HTTPMessage, std::string> httpRequest() override;
 
  private:
+  /// Returns true if 'current' moved beyond the significance thresholds
+  /// relative to the last status that was serialized and sent, meaning the
+  /// cached heartbeat body is too stale to re-send.
+  bool statsChangedSignificantly(const protocol::NodeStatus& current) const;
+
   std::function<protocol::NodeStatus()> nodeStatusFetcher_;
+  const bool statsDeltaEnabled_;
+  const uint64_t statsMaxAgeMs_;
+
+  /// Last node status that was serialized, its serialized body and the time
+  /// it was produced. Only accessed from the event base thread running
+  /// httpRequest().
+  protocol::NodeStatus lastSentStatus_;
+  std::string lastSentBody_;
+  uint64_t lastSentTimeMs_{0};
 };
 } // namespace facebook::presto
@@ -15,6 +15,7 @@
 #include "presto_cpp/main/PeriodicMemoryChecker.h"
 #include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/common/Counters.h"
+#include "presto_cpp/main/common/MemoryPressureBus.h"
 #include "presto_cpp/main/common/Utils.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/caching/AsyncDataCache.h"
@@ -76,9 +77,16 @@ void PeriodicMemoryChecker::start() {
         if (config_.mallocMemHeapDumpEnabled) {
           maybeDumpHeap();
         }
-        if (config_.systemMemPushbackEnabled &&
-            systemUsedMemoryBytes() > config_.systemMemLimitBytes) {
-          pushbackMemory();
+        if (config_.systemMemPushbackEnabled) {
+          const auto usedBytes = systemUsedMemoryBytes();
+          if (usedBytes > config_.systemMemLimitBytes) {
+            pushbackMemory();
+          } else if (
+              config_.systemMemPushbackArbitrationRatio > 0 &&
+              usedBytes > config_.systemMemLimitBytes *
+                      config_.systemMemPushbackArbitrationRatio) {
+            triggerMemoryArbitration();
+          }
         }
       },
       std::chrono::milliseconds(config_.memoryCheckerIntervalMs),
@@ -164,6 +172,41 @@ void PeriodicMemoryChecker::maybeDumpHeap() {
   }
 }
 
+void PeriodicMemoryChecker::triggerMemoryArbitration() {
+  VELOX_CHECK(config_.systemMemPushbackEnabled);
+  RECORD_METRIC_VALUE(kCounterMemoryPushbackArbitrationCount);
+  const uint64_t currentMemBytes = systemUsedMemoryBytes();
+  const uint64_t watermarkBytes = config_.systemMemLimitBytes *
+      config_.systemMemPushbackArbitrationRatio;
+  VELOX_CHECK_GT(currentMemBytes, watermarkBytes);
+  const uint64_t bytesToShrink = currentMemBytes - watermarkBytes;
+  LOG(WARNING) << "System used memory "
+               << velox::succinctBytes(currentMemBytes)
+               << " exceeded the arbitration watermark: "
+               << velox::succinctBytes(watermarkBytes)
+               << ", triggering memory arbitration to shrink "
+               << velox::succinctBytes(bytesToShrink);
+  // Let subscribed caches shed memory first; arbitration only has to cover
+  // what they could not release.
+  const uint64_t reclaimedBytes = MemoryPressureBus::instance()->publish(
+      MemoryPressureBus::Level::kWarn, bytesToShrink);
+  if (reclaimedBytes >= bytesToShrink) {
+    return;
+  }
+  try {
+    // Shrink with spilling enabled but aborts disabled: this is the graduated
+    // step that trades some query slowdown for headroom, leaving the
+    // disruptive cache-shrink/abort path to pushbackMemory() at the hard
+    // limit.
+    velox::memory::memoryManager()->shrinkPools(
+        bytesToShrink - reclaimedBytes,
+        /*allowSpill=*/true,
+        /*allowAbort=*/false);
+  } catch (const velox::VeloxException& ex) {
+    LOG(ERROR) << ex.what();
+  }
+}
+
 void PeriodicMemoryChecker::pushbackMemory() {
   RECORD_METRIC_VALUE(kCounterMemoryPushbackCount);
   const uint64_t currentMemBytes = systemUsedMemoryBytes();
@@ -183,7 +226,13 @@ void PeriodicMemoryChecker::pushbackMemory() {
     velox::MicrosecondTimer timer(&latencyUs);
     auto* cache = velox::cache::AsyncDataCache::getInstance();
     auto systemConfig = SystemConfig::instance();
-    freedBytes = cache != nullptr ? cache->shrink(bytesToShrink) : 0;
+    // Subscribed caches shed memory first so the disruptive steps below only
+    // cover what cheap eviction could not release.
+    freedBytes = MemoryPressureBus::instance()->publish(
+        MemoryPressureBus::Level::kCritical, bytesToShrink);
+    if (freedBytes < bytesToShrink && cache != nullptr) {
+      freedBytes += cache->shrink(bytesToShrink - freedBytes);
+    }
     if (freedBytes < bytesToShrink) {
       try {
         auto* memoryManager = velox::memory::memoryManager();
@@ -191,6 +240,12 @@ void PeriodicMemoryChecker::pushbackMemory() {
             memoryManager->allocator()->unmap(
                 velox::memory::AllocationTraits::numPages(
                     bytesToShrink - freedBytes)));
+        if (freedBytes < bytesToShrink &&
+            systemConfig->systemMemPushBackAbortEnabled()) {
+          // Last call before queries are aborted.
+          freedBytes += MemoryPressureBus::instance()->publish(
+              MemoryPressureBus::Level::kEmergency, bytesToShrink - freedBytes);
+        }
         if (freedBytes < bytesToShrink &&
             systemConfig->systemMemPushBackAbortEnabled()) {
           memoryManager->shrinkPools(
@@ -63,6 +63,13 @@ class PeriodicMemoryChecker {
     /// Only applies if 'mallocMemHeapDumpEnabled' is true. Memory (in bytes)
     /// allocated via malloc() that triggers the heap dump. Default is 20GB.
     size_t mallocBytesUsageDumpThreshold{20UL * 1024 * 1024 * 1024};
+
+    /// Fraction of 'systemMemLimitBytes' above which the checker triggers
+    /// velox memory arbitration (spill enabled, aborts disabled) to bring
+    /// usage down gradually before the hard limit pushback kicks in. 0
+    /// disables the early arbitration step. This only applies if
+    /// 'systemMemPushbackEnabled' is true.
+    double systemMemPushbackArbitrationRatio{0};
   };
 
   explicit PeriodicMemoryChecker(const Config& config);
@@ -104,8 +111,18 @@ class PeriodicMemoryChecker {
 
   /// Invoked by the periodic checker when 'Config::systemMemPushbackEnabled'
   /// is true and system memory usage is above 'Config::systemMemLimitBytes'.
+  /// Publishes a critical event on the MemoryPressureBus so subscribed
+  /// caches shed memory first, then falls back to data cache shrink, unmap
+  /// and, when enabled, query aborts preceded by an emergency event.
   virtual void pushbackMemory();
 
+  /// Invoked by the periodic checker when system memory usage is above
+  /// 'Config::systemMemPushbackArbitrationRatio' of the limit but still below
+  /// the limit itself. Publishes a warn event on the MemoryPressureBus, then
+  /// runs velox memory arbitration with spilling enabled and aborts disabled
+  /// as a graduated step before pushbackMemory().
+  virtual void triggerMemoryArbitration();
+
   const Config config_;
   std::atomic<int64_t> cachedSystemUsedMemoryBytes_{0};
 
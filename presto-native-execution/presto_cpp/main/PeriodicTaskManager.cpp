@@ -15,9 +15,16 @@
 #include "presto_cpp/main/PeriodicTaskManager.h"
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/stop_watch.h>
+#include <folly/system/HardwareConcurrency.h>
+#include "presto_cpp/main/AutoTraceRegistry.h"
+#include "presto_cpp/main/CrashHandoff.h"
 #include "presto_cpp/main/PrestoExchangeSource.h"
 #include "presto_cpp/main/PrestoServer.h"
+#include "presto_cpp/main/common/AllocationTracker.h"
 #include "presto_cpp/main/common/Counters.h"
+#include "presto_cpp/main/common/HugePageArena.h"
+#include "presto_cpp/main/common/LocalDiskIoScheduler.h"
+#include "presto_cpp/main/TaskManager.h"
 #include "presto_cpp/main/http/filters/HttpEndpointLatencyFilter.h"
 #include "velox/common/base/PeriodicStatsReporter.h"
 #include "velox/common/base/StatsReporter.h"
@@ -25,6 +32,7 @@
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/CacheTTLController.h"
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/common/time/Timer.h"
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/exec/Driver.h"
@@ -229,6 +237,18 @@ static constexpr size_t kHttpServerPeriodGlobalCounters{
     60'000'000}; // 60 seconds.
 static constexpr size_t kHttpClientPeriodGlobalCounters{
     60'000'000}; // 60 seconds.
+// Every two seconds we sample driver executor queue latency and decide
+// whether to resize the executor.
+static constexpr size_t kDriverScalingPeriod{2'000'000}; // 2 seconds.
+// Every ten seconds the auto-trace sweep samples completed tasks and checks
+// running ones against the outlier thresholds.
+static constexpr size_t kAutoTracePeriod{10'000'000}; // 10 seconds.
+// Consecutive out-of-band latency samples required before resizing the driver
+// executor, so a single burst does not cause thread count churn.
+static constexpr int kDriverScalingHysteresisSamples{3};
+// Number of exchange peers, worst p99 latency first, exported as per-peer
+// metric series; the rest only show up in the log and the operations dump.
+static constexpr size_t kTopExchangePeersToExport{8};
 
 PeriodicTaskManager::PeriodicTaskManager(
     folly::CPUThreadPoolExecutor* driverCPUExecutor,
@@ -271,9 +291,18 @@ void PeriodicTaskManager::start() {
     addExecutorStatsTask();
   }
 
+  if ((driverCPUExecutor_ != nullptr) &&
+      SystemConfig::instance()->driverElasticScalingEnabled()) {
+    addDriverScalingTask();
+  }
+
   VELOX_CHECK_NOT_NULL(taskManager_);
   addTaskStatsTask();
 
+  if (SystemConfig::instance()->taskListSnapshotRefreshMs() > 0) {
+    addTaskListSnapshotTask();
+  }
+
   if (SystemConfig::instance()->enableOldTaskCleanUp()) {
     addOldTaskCleanupTask();
   }
@@ -290,6 +319,29 @@ void PeriodicTaskManager::start() {
 
   addHttpClientStatsTask();
 
+#ifdef PRESTO_ENABLE_ALLOCATION_TRACKING
+  addTask(
+      []() { AllocationTracker::recordMetrics(); },
+      kTaskPeriodGlobalCounters,
+      "allocation_tracker");
+#endif
+
+  if (SystemConfig::instance()->crashHandoffEnabled()) {
+    // Keep the crash handler's task snapshot fresh; the handler itself may
+    // only do async-signal-safe work and cannot walk the task map.
+    addTask(
+        [this]() {
+          CrashHandoff::instance()->updateSnapshot(
+              taskManager_->buildCrashHandoffSnapshot());
+        },
+        kTaskPeriodGlobalCounters,
+        "crash_handoff_snapshot");
+  }
+
+  if (SystemConfig::instance()->taskAutoTraceEnabled()) {
+    addAutoTraceTask();
+  }
+
   if (server_ && server_->hasCoordinatorDiscoverer()) {
     numDriverThreads_ = server_->numDriverThreads();
     addWatchdogTask();
@@ -332,6 +384,89 @@ void PeriodicTaskManager::addExecutorStatsTask() {
       "executor_counters");
 }
 
+void PeriodicTaskManager::addDriverScalingTask() {
+  const auto* systemConfig = SystemConfig::instance();
+  minDriverThreads_ = driverCPUExecutor_->numThreads();
+  maxDriverThreads_ = std::max<size_t>(
+      minDriverThreads_,
+      systemConfig->driverElasticScalingMaxThreadsHwMultiplier() *
+          folly::hardware_concurrency());
+  const int64_t scaleUpLatencyUs =
+      systemConfig->driverElasticScalingLatencyThresholdMs() * 1'000;
+  // Scale down only well below the scale-up threshold so the two decisions do
+  // not flip-flop around a single boundary.
+  const int64_t scaleDownLatencyUs = scaleUpLatencyUs / 4;
+  LOG(INFO) << "Driver executor elastic scaling enabled: "
+            << minDriverThreads_ << " to " << maxDriverThreads_
+            << " threads, queue latency threshold "
+            << velox::succinctMicros(scaleUpLatencyUs);
+  addTask(
+      [this, scaleUpLatencyUs, scaleDownLatencyUs]() {
+        // A probe still queued from the previous sweep means the executor is
+        // backed up beyond the sampling period; count it as a high latency
+        // sample instead of waiting for it to run.
+        const int64_t latencyUs = driverProbeInFlight_
+            ? scaleUpLatencyUs + 1
+            : driverProbeLatencyUs_.load();
+        if (latencyUs >= 0) {
+          RECORD_METRIC_VALUE(
+              kCounterDriverCPUExecutorLatencyMs, latencyUs / 1'000);
+          updateDriverThreadCount(
+              latencyUs, scaleUpLatencyUs, scaleDownLatencyUs);
+        }
+        if (!driverProbeInFlight_.exchange(true)) {
+          driverCPUExecutor_->add(
+              [this, enqueueTimeUs = velox::getCurrentTimeMicro()]() {
+                driverProbeLatencyUs_ =
+                    velox::getCurrentTimeMicro() - enqueueTimeUs;
+                driverProbeInFlight_ = false;
+              });
+        }
+      },
+      kDriverScalingPeriod,
+      "driver_executor_scaling");
+}
+
+void PeriodicTaskManager::updateDriverThreadCount(
+    int64_t latencyUs,
+    int64_t scaleUpLatencyUs,
+    int64_t scaleDownLatencyUs) {
+  if (latencyUs > scaleUpLatencyUs) {
+    ++numHighLatencySamples_;
+    numLowLatencySamples_ = 0;
+  } else if (latencyUs < scaleDownLatencyUs) {
+    ++numLowLatencySamples_;
+    numHighLatencySamples_ = 0;
+  } else {
+    // In the hysteresis band: the current thread count is fine.
+    numHighLatencySamples_ = 0;
+    numLowLatencySamples_ = 0;
+    return;
+  }
+  const size_t numThreads = driverCPUExecutor_->numThreads();
+  // Resize in steps of 1/8 of the lower bound so the executor converges in a
+  // few sweeps without overshooting.
+  const size_t step = std::max<size_t>(1, minDriverThreads_ / 8);
+  if ((numHighLatencySamples_ >= kDriverScalingHysteresisSamples) &&
+      (numThreads < maxDriverThreads_)) {
+    const auto newNumThreads = std::min(maxDriverThreads_, numThreads + step);
+    LOG(INFO) << "Driver executor queue latency "
+              << velox::succinctMicros(latencyUs) << "; growing from "
+              << numThreads << " to " << newNumThreads << " threads";
+    driverCPUExecutor_->setNumThreads(newNumThreads);
+    numHighLatencySamples_ = 0;
+  } else if (
+      (numLowLatencySamples_ >= kDriverScalingHysteresisSamples) &&
+      (numThreads > minDriverThreads_)) {
+    const auto newNumThreads = std::max(minDriverThreads_, numThreads - step);
+    LOG(INFO) << "Driver executor queue latency "
+              << velox::succinctMicros(latencyUs) << "; shrinking from "
+              << numThreads << " to " << newNumThreads << " threads";
+    driverCPUExecutor_->setNumThreads(newNumThreads);
+    numLowLatencySamples_ = 0;
+  }
+}
+
 void PeriodicTaskManager::updateTaskStats() {
   // Report the number of tasks and drivers in the system.
   size_t numTasks{0};
@@ -374,6 +509,30 @@ void PeriodicTaskManager::updateTaskStats() {
   RECORD_METRIC_VALUE(
       kCounterTotalPartitionedOutputBuffer,
       velox::exec::OutputBufferManager::getInstanceRef()->numBuffers());
+
+  // Roll task CPU up to query level for the task.getQueryCpu operation and
+  // the per-query CPU share throttle.
+  taskManager_->updateQueryCpuUsage();
+
+  // Sample per-query driver executor queue occupancy for the
+  // task.getQueryQueueTime operation.
+  taskManager_->updateQueryQueuedDriverTime();
+
+  // Close one time-sliced stats window on every live task when the
+  // per-operator stats history is enabled.
+  taskManager_->updateTimeSlicedStats();
+
+  // Feed the spill traffic observed since the last sweep into the local disk
+  // I/O scheduler, so shuffle and broadcast I/O yield bandwidth while spilling
+  // is active. Cleaned-up tasks drop out of the total, so it can go
+  // backwards; only forward progress is charged.
+  const auto spilledBytes = taskManager_->getTotalSpilledBytes();
+  if (spilledBytes > lastSpilledBytes_) {
+    LocalDiskIoScheduler::instance()->recordExternal(
+        LocalDiskIoScheduler::IoClass::kSpill,
+        spilledBytes - lastSpilledBytes_);
+  }
+  lastSpilledBytes_ = spilledBytes;
 }
 
 void PeriodicTaskManager::addTaskStatsTask() {
@@ -383,6 +542,13 @@ void PeriodicTaskManager::addTaskStatsTask() {
       "task_counters");
 }
 
+void PeriodicTaskManager::addTaskListSnapshotTask() {
+  addTask(
+      [this]() { taskManager_->rebuildTaskListSnapshot(); },
+      SystemConfig::instance()->taskListSnapshotRefreshMs() * 1000UL,
+      "task_list_snapshot");
+}
+
 void PeriodicTaskManager::cleanupOldTask() {
   // Report the number of tasks and drivers in the system.
   if (taskManager_ != nullptr) {
@@ -405,6 +571,18 @@ void PeriodicTaskManager::updatePrestoExchangeSourceMemoryStats() {
   PrestoExchangeSource::resetPeakMemoryUsage();
   RECORD_HISTOGRAM_METRIC_VALUE(
       kCounterExchangeSourcePeakQueuedBytes, peakQueuedMemoryBytes);
+
+  if (auto* arena = HugePageArena::instance(); arena != nullptr) {
+    const auto arenaStats = arena->stats();
+    RECORD_METRIC_VALUE(
+        kCounterExchangeHugePageArenaUsedBytes, arenaStats.usedBytes);
+    const uint64_t freeBytes = arenaStats.capacityBytes - arenaStats.usedBytes;
+    if (freeBytes > 0) {
+      RECORD_METRIC_VALUE(
+          kCounterExchangeHugePageArenaFragmentationPct,
+          100 - arenaStats.largestFreeRunBytes * 100 / freeBytes);
+    }
+  }
 }
 
 void PeriodicTaskManager::addPrestoExchangeSourceMemoryStatsTask() {
@@ -480,6 +658,44 @@ void PeriodicTaskManager::printHttpServerStats() {
   }
   oss << "]";
   LOG(INFO) << oss.str();
+  reportExchangePeerStats();
+}
+
+void PeriodicTaskManager::reportExchangePeerStats() {
+  const auto peerMetrics =
+      http::filters::HttpEndpointLatencyFilter::retrievePeerMetrics();
+  if (peerMetrics.empty()) {
+    return;
+  }
+  std::ostringstream oss;
+  oss << "Http exchange peer latency \n[\n";
+  const size_t numToExport =
+      std::min<size_t>(peerMetrics.size(), kTopExchangePeersToExport);
+  for (size_t i = 0; i < peerMetrics.size(); ++i) {
+    const auto& metrics = peerMetrics[i];
+    oss << metrics.toString() << ",\n";
+    if (i >= numToExport) {
+      continue;
+    }
+    // Peer addresses are embedded in the metric names; dots and colons are
+    // replaced so the address survives the reporters' name sanitization
+    // intact.
+    std::string token = metrics.peer;
+    std::replace(token.begin(), token.end(), '.', '_');
+    std::replace(token.begin(), token.end(), ':', '_');
+    const auto latencyMetricName =
+        fmt::format(kCounterHttpExchangePeerLatencyP99UsFormat, token);
+    const auto errorsMetricName =
+        fmt::format(kCounterHttpExchangePeerNumRequestErrorsFormat, token);
+    DEFINE_METRIC(latencyMetricName, facebook::velox::StatType::AVG);
+    DEFINE_METRIC(errorsMetricName, facebook::velox::StatType::AVG);
+    RECORD_METRIC_VALUE(
+        latencyMetricName,
+        static_cast<int64_t>(metrics.latencyUs.estimateQuantile(0.99)));
+    RECORD_METRIC_VALUE(errorsMetricName, metrics.errorCount);
+  }
+  oss << "]";
+  LOG(INFO) << oss.str();
 }
 
 void PeriodicTaskManager::addHttpServerStatsTask() {
@@ -572,6 +788,67 @@ void PeriodicTaskManager::addWatchdogTask() {
       "Watchdog");
 }
 
+void PeriodicTaskManager::addAutoTraceTask() {
+  addTask(
+      [this]() { detectSlowTasksForTracing(); },
+      kAutoTracePeriod,
+      "auto_trace_detection");
+}
+
+void PeriodicTaskManager::detectSlowTasksForTracing() {
+  const auto* systemConfig = SystemConfig::instance();
+  if (systemConfig->taskAutoTraceDir().empty()) {
+    return;
+  }
+  const auto percentile = systemConfig->taskAutoTracePercentile();
+  const auto maxPromoted = systemConfig->taskAutoTraceMaxPromotedSources();
+  const auto ttlMs = systemConfig->taskAutoTracePromotionTtlMs();
+  auto* registry = AutoTraceRegistry::instance();
+  const uint64_t nowMs = velox::getCurrentTimeMs();
+
+  for (const auto& [taskId, prestoTask] : taskManager_->tasks()) {
+    std::shared_ptr<velox::exec::Task> execTask;
+    {
+      std::lock_guard<std::mutex> lock(prestoTask->mutex);
+      execTask = prestoTask->task;
+    }
+    if (execTask == nullptr) {
+      continue;
+    }
+    const uint64_t runtimeMs = nowMs > prestoTask->createTimeMs
+        ? nowMs - prestoTask->createTimeMs
+        : 0;
+    const uint64_t peakBytes = execTask->pool()->peakBytes();
+    if (!execTask->isRunning()) {
+      // Completed tasks feed the sample window once. The runtime includes up
+      // to one sweep period past the finish, which is noise at the
+      // percentiles this operates at.
+      if (!prestoTask->autoTraceSampled.exchange(true)) {
+        registry->addCompletedTask(runtimeMs, peakBytes);
+      }
+      continue;
+    }
+    if (prestoTask->autoTraceFlagged.load() ||
+        !registry->isOutlier(runtimeMs, peakBytes, percentile)) {
+      continue;
+    }
+    prestoTask->autoTraceFlagged = true;
+    const auto source =
+        execTask->queryCtx()->queryConfig().get<std::string>(
+            velox::core::QueryConfig::kSource, "");
+    if (source.empty()) {
+      continue;
+    }
+    if (registry->tryPromote(source, maxPromoted, ttlMs, nowMs)) {
+      LOG(INFO) << "Auto-trace promoted source '" << source
+                << "' after outlier task " << taskId << " (runtime "
+                << runtimeMs << " ms, peak memory " << peakBytes
+                << " bytes).";
+      RECORD_METRIC_VALUE(kCounterAutoTracePromotedSources);
+    }
+  }
+}
+
 void PeriodicTaskManager::detachWorker(const char* reason) {
   LOG(WARNING) << "TraceContext::status:\n"
                << velox::process::TraceContext::statusLine();
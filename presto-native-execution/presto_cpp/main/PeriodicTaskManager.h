@@ -102,6 +102,8 @@ class PeriodicTaskManager {
   void addTaskStatsTask();
   void updateTaskStats();
 
+  void addTaskListSnapshotTask();
+
   void addOldTaskCleanupTask();
   void cleanupOldTask();
 
@@ -115,12 +117,22 @@ class PeriodicTaskManager {
 
   void addHttpServerStatsTask();
   void printHttpServerStats();
+  void reportExchangePeerStats();
 
   void addHttpClientStatsTask();
   void updateHttpClientStats();
 
   void addWatchdogTask();
 
+  void addAutoTraceTask();
+  void detectSlowTasksForTracing();
+
+  void addDriverScalingTask();
+  void updateDriverThreadCount(
+      int64_t latencyUs,
+      int64_t scaleUpLatencyUs,
+      int64_t scaleDownLatencyUs);
+
   void detachWorker(const char* reason);
   void maybeAttachWorker();
 
@@ -144,6 +156,20 @@ class PeriodicTaskManager {
 
   int64_t lastHttpClientNumConnectionsCreated_{0};
 
+  // Total spilled bytes observed by the last task stats sweep, used to feed
+  // the spill traffic delta into the local disk I/O scheduler.
+  int64_t lastSpilledBytes_{0};
+
+  // State of the driver executor elastic scaling task. The bounds are fixed
+  // at startup; the probe latency is written by a no-op task queued on the
+  // driver executor and read by the next scaling sweep.
+  size_t minDriverThreads_{0};
+  size_t maxDriverThreads_{0};
+  std::atomic_int64_t driverProbeLatencyUs_{-1};
+  std::atomic_bool driverProbeInFlight_{false};
+  int numHighLatencySamples_{0};
+  int numLowLatencySamples_{0};
+
   // NOTE: declare last since the threads access other members of `this`.
   folly::FunctionScheduler oneTimeRunner_;
   folly::ThreadedRepeatingFunctionRunner repeatedRunner_;
@@ -15,19 +15,164 @@
 
 #include <fmt/core.h>
 #include <folly/SocketAddress.h>
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <folly/futures/Future.h>
+#include <folly/hash/Checksum.h>
 #include <re2/re2.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <numeric>
 #include <sstream>
 
+#include "presto_cpp/main/ExchangeMaterializer.h"
+#include "presto_cpp/main/ExchangeTracer.h"
+#include "presto_cpp/main/common/AllocationTracker.h"
+#include "presto_cpp/main/operators/BroadcastFile.h"
 #include "presto_cpp/main/common/Counters.h"
+#include "presto_cpp/main/common/ExchangeProjection.h"
+#include "presto_cpp/main/common/HugePageArena.h"
 #include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 
 using namespace facebook::velox;
 
 namespace facebook::presto {
 namespace {
 
+// Bounds and step of the adaptive getData byte budget (AIMD).
+constexpr uint32_t kMinAdaptiveRequestBytes = 1 << 20; // 1MB.
+constexpr uint32_t kAdaptiveRequestStepBytes = 1 << 20; // 1MB.
+// A response is considered to have filled the budget when it used at least
+// this fraction of the requested bytes.
+constexpr double kAdaptiveFullResponseRatio = 0.9;
+// A data response slower than this indicates the budget overshoots what the
+// link (or the upstream worker) can deliver in one round trip.
+constexpr int64_t kAdaptiveSlowResponseMs = 1'000;
+
+// How often a parked getData request re-attempts its memory reservation when
+// no release wakes it first.
+constexpr int64_t kAdmissionRetryDelayMs = 100;
+
+// Bounds of the adaptive page-coalescing target: responses are held back
+// until about kCoalesceTargetResponses times the source's observed typical
+// response size has accumulated, clamped to this range so tiny pages still
+// flush in small batches and large responses are never withheld.
+constexpr int64_t kCoalesceTargetResponses = 4;
+constexpr int64_t kMinCoalesceTargetBytes = 64 << 10; // 64KB.
+constexpr int64_t kMaxCoalesceTargetBytes = 4 << 20; // 4MB.
+
+// Sources whose getData request is parked waiting for a memory reservation,
+// in arrival order.
+folly::Synchronized<std::deque<std::weak_ptr<PrestoExchangeSource>>>&
+deferredSources() {
+  static folly::Synchronized<std::deque<std::weak_ptr<PrestoExchangeSource>>>
+      sources;
+  return sources;
+}
+
+// Tracks recent data response durations per upstream worker so that hedged
+// requests fire when a response is slow relative to that peer's own recent
+// distribution rather than a fixed global threshold.
+class HedgeLatencyTracker {
+ public:
+  static HedgeLatencyTracker* instance() {
+    static HedgeLatencyTracker tracker;
+    return &tracker;
+  }
+
+  void record(const std::string& peer, int64_t durationMs) {
+    auto durations = durations_.wlock();
+    auto& ring = (*durations)[peer];
+    ring.samples[ring.pos] = durationMs;
+    ring.pos = (ring.pos + 1) % kWindowSize;
+    ring.count = std::min(ring.count + 1, kWindowSize);
+  }
+
+  // Returns the delay in millis before hedging a request to 'peer': the p99
+  // of the peer's recent response durations, or 'defaultMs' until enough
+  // samples have been collected.
+  int64_t delayMs(const std::string& peer, int64_t defaultMs) const {
+    std::array<int64_t, kWindowSize> samples;
+    size_t count;
+    {
+      auto durations = durations_.rlock();
+      auto it = durations->find(peer);
+      if (it == durations->end() || it->second.count < kMinSamples) {
+        return defaultMs;
+      }
+      count = it->second.count;
+      std::copy_n(it->second.samples.begin(), count, samples.begin());
+    }
+    const size_t rank = (count * 99) / 100;
+    std::nth_element(
+        samples.begin(), samples.begin() + rank, samples.begin() + count);
+    return std::max<int64_t>(samples[rank], 1);
+  }
+
+ private:
+  static constexpr size_t kWindowSize = 128;
+  static constexpr size_t kMinSamples = 32;
+
+  struct DurationRing {
+    std::array<int64_t, kWindowSize> samples;
+    size_t count{0};
+    size_t pos{0};
+  };
+
+  folly::Synchronized<folly::F14FastMap<std::string, DurationRing>> durations_;
+};
+
+// Returns true if 'remoteHost' is outside this worker's rack. Rack
+// membership is inferred by comparing the leading 'prefixBits' bits of the
+// two IPv4 addresses; a source whose distance cannot be determined (local
+// address unset, either address non-numeric or not IPv4) is treated as
+// rack-local so it is never penalized.
+bool isRemoteRack(const std::string& remoteHost, uint32_t prefixBits) {
+  const auto localHost =
+      NodeConfig::instance()->nodeInternalAddress([]() { return ""; });
+  if (localHost.empty() || remoteHost == localHost) {
+    return false;
+  }
+  if (prefixBits > 32 || !folly::IPAddress::validate(remoteHost) ||
+      !folly::IPAddress::validate(localHost)) {
+    return false;
+  }
+  const folly::IPAddress remoteIp(remoteHost);
+  const folly::IPAddress localIp(localHost);
+  if (!remoteIp.isV4() || !localIp.isV4()) {
+    return false;
+  }
+  return remoteIp.mask(prefixBits) != localIp.mask(prefixBits);
+}
+
+// Returns the path of this worker's unix domain socket listener when 'host'
+// refers to the local host, empty otherwise. A same-host producer is then
+// fetched over the socket, skipping TCP and per-request authentication on
+// loopback exchange traffic.
+std::string sameHostUdsPath(const std::string& host) {
+  const auto path = SystemConfig::instance()->httpServerUnixDomainSocketPath();
+  if (path.empty()) {
+    return {};
+  }
+  if (host == "localhost" ||
+      host == NodeConfig::instance()->nodeInternalAddress([]() {
+        return "";
+      })) {
+    return path;
+  }
+  if (folly::IPAddress::validate(host) &&
+      folly::IPAddress(host).isLoopback()) {
+    return path;
+  }
+  return {};
+}
+
 std::string extractTaskId(const std::string& path) {
   static const RE2 kPattern("/v1/task/([^/]*)/.*");
   std::string taskId;
@@ -61,7 +206,7 @@ std::string bodyAsString(
     oss << std::string(
         reinterpret_cast<const char*>(body->data()), body->length());
     if (pool != nullptr) {
-      pool->free(body->writableData(), body->capacity());
+      HugePageArena::freeTo(pool, body->writableData(), body->capacity());
     }
   }
   return oss.str();
@@ -87,9 +232,40 @@ PrestoExchangeSource::PrestoExchangeSource(
       immediateBufferTransfer_(
           enableBufferCopy_ &&
           SystemConfig::instance()->exchangeImmediateBufferTransfer()),
-      driverExecutor_(driverExecutor) {
+      driverExecutor_(driverExecutor),
+      pipelinedFetchWindow_(
+          SystemConfig::instance()->exchangeHttpClientPipelinedFetchWindow()),
+      adaptiveRequestSizeEnabled_(
+          SystemConfig::instance()->exchangeAdaptiveRequestSizeEnabled()),
+      pageCoalescingEnabled_(
+          SystemConfig::instance()->exchangePageCoalescingEnabled()),
+      hedgedRequestEnabled_(
+          SystemConfig::instance()->exchangeHedgedRequestEnabled()),
+      hedgedRequestDelayMs_(
+          SystemConfig::instance()->exchangeHedgedRequestDelayMs()),
+      memoryAdmissionEnabled_(
+          SystemConfig::instance()->exchangeMemoryAdmissionEnabled()),
+      remoteRackDispatchDelayMs_(
+          SystemConfig::instance()->exchangeRackLocalPrioritizationEnabled() &&
+                  isRemoteRack(
+                      baseUri.host(),
+                      SystemConfig::instance()->exchangeRackIpv4PrefixBits())
+              ? SystemConfig::instance()->exchangeRemoteRackDispatchDelayMs()
+              : 0),
+      partialPageResumeEnabled_(
+          SystemConfig::instance()->exchangePartialPageResumeEnabled()) {
+  if (SystemConfig::instance()->exchangeSelectiveColumnsEnabled()) {
+    columnMask_ = ExchangeProjectionRegistry::instance()->maskFor(taskId_);
+  }
   folly::SocketAddress address;
-  if (folly::IPAddress::validate(host_)) {
+  const auto udsPath =
+      sslContext_ == nullptr ? sameHostUdsPath(host_) : std::string();
+  if (!udsPath.empty()) {
+    // Same-host producer with the unix domain socket listener configured:
+    // fetch over it instead of loopback TCP. The listener is plain HTTP, so
+    // TLS deployments stay on the TCP path.
+    address.setFromPath(udsPath);
+  } else if (folly::IPAddress::validate(host_)) {
     address = folly::SocketAddress(folly::IPAddress(host_), port_);
   } else {
     address = folly::SocketAddress(host_, port_, true);
@@ -117,6 +293,19 @@ PrestoExchangeSource::PrestoExchangeSource(
 void PrestoExchangeSource::close() {
   closed_.store(true);
   checkSetRequestPromise();
+  {
+    // Data held back for coalescing is dropped rather than enqueued; its
+    // release closures settle the memory accounting.
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    dropCoalescedLocked();
+    dropResumePrefixLocked();
+    if (spliceChain_ != nullptr) {
+      spliceChain_.reset();
+      PrestoExchangeSource::updateMemoryUsage(-spliceBytes_);
+      spliceBytes_ = 0;
+    }
+  }
+  releaseRequestMemory();
   abortResults();
 }
 
@@ -142,6 +331,7 @@ folly::SemiFuture<PrestoExchangeSource::Response> PrestoExchangeSource::request(
   // 'shouldRequestLocked' and received 'true' response. Hence, we expect
   // requestPending_ == true, atEnd_ == false.
   VELOX_CHECK(requestPending_);
+  maxBytes = adjustRequestSize(maxBytes);
   // This call cannot be made concurrently from multiple threads, but other
   // calls that mutate promise_ can be called concurrently.
   VeloxPromise<Response> promise{"PrestoExchangeSource::request"};
@@ -156,6 +346,12 @@ folly::SemiFuture<PrestoExchangeSource::Response> PrestoExchangeSource::request(
       return future;
     }
     promise_ = std::move(promise);
+    lastMaxBytes_ = maxBytes;
+    lastMaxWait_ = maxWait;
+    numPipelinedFetches_ = 0;
+    ++fetchEpoch_;
+    fetchResponseHandled_ = false;
+    hedgedRequestIssued_ = false;
   }
 
   failedAttempts_ = 0;
@@ -163,21 +359,148 @@ folly::SemiFuture<PrestoExchangeSource::Response> PrestoExchangeSource::request(
       std::chrono::duration_cast<std::chrono::milliseconds>(
           SystemConfig::instance()->exchangeMaxErrorDuration())
           .count());
-  doRequest(dataRequestRetryState_.nextDelayMs(), maxBytes, maxWait);
+  if (memoryAdmissionEnabled_ && maxBytes > 0 &&
+      !tryAdmitRequestMemory(maxBytes)) {
+    // No headroom in the query pool for the response: park the request
+    // instead of letting the data arrive and overshoot the limit. The
+    // promise is fulfilled once the parked request has been admitted and
+    // served.
+    RECORD_METRIC_VALUE(kCounterExchangeRequestMemoryDeferrals);
+    deferRequest(maxBytes, maxWait);
+    return future;
+  }
+  doRequest(
+      dataRequestRetryState_.nextDelayMs() +
+          (maxBytes > 0 ? rackDispatchDelayMs() : 0),
+      maxBytes,
+      maxWait,
+      /*hedged=*/false);
 
   return future;
 }
 
+int64_t PrestoExchangeSource::rackDispatchDelayMs() {
+  if (remoteRackDispatchDelayMs_ == 0) {
+    return 0;
+  }
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    if (queue_->totalBytes() == 0) {
+      // Nothing buffered to work on; fetch at full priority so a
+      // remote-only exchange is not slowed down.
+      return 0;
+    }
+  }
+  RECORD_METRIC_VALUE(kCounterExchangeRemoteRackDelayedRequests);
+  remoteRackDelayedRequests_.addValue(1);
+  return remoteRackDispatchDelayMs_;
+}
+
+bool PrestoExchangeSource::tryAdmitRequestMemory(uint64_t bytes) {
+  // maybeReserve() grows the pool's reservation (triggering memory
+  // arbitration if needed) and returns false instead of throwing when the
+  // query limit cannot accommodate it.
+  if (!pool_->maybeReserve(bytes)) {
+    return false;
+  }
+  admittedBytes_ = bytes;
+  return true;
+}
+
+void PrestoExchangeSource::deferRequest(
+    uint32_t maxBytes,
+    std::chrono::microseconds maxWait) {
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    admissionDeferred_ = true;
+    deferredMaxBytes_ = maxBytes;
+    deferredMaxWait_ = maxWait;
+  }
+  auto self = getSelfPtr();
+  deferredSources().wlock()->push_back(self);
+  folly::futures::sleep(std::chrono::milliseconds(kAdmissionRetryDelayMs))
+      .via(driverExecutor_)
+      .thenValue([self = std::move(self)](folly::Unit) {
+        self->maybeResumeDeferredRequest();
+      });
+}
+
+void PrestoExchangeSource::maybeResumeDeferredRequest() {
+  uint32_t maxBytes;
+  std::chrono::microseconds maxWait;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    if (!admissionDeferred_) {
+      return;
+    }
+    admissionDeferred_ = false;
+    maxBytes = deferredMaxBytes_;
+    maxWait = deferredMaxWait_;
+  }
+  if (closed_.load()) {
+    // close() has already completed the promise; nothing left to issue.
+    return;
+  }
+  if (!tryAdmitRequestMemory(maxBytes)) {
+    // Still no headroom; go back to waiting.
+    deferRequest(maxBytes, maxWait);
+    return;
+  }
+  doRequest(/*delayMs=*/0, maxBytes, maxWait, /*hedged=*/false);
+}
+
+void PrestoExchangeSource::releaseRequestMemory() {
+  if (admittedBytes_.exchange(0) == 0) {
+    return;
+  }
+  // Trim the unused part of the reservation. The bytes actually allocated
+  // for the received page remain charged until the page is destroyed. Other
+  // sources sharing this pool whose unused reservation gets trimmed as well
+  // simply re-reserve on demand.
+  pool_->release();
+
+  // Wake the longest-waiting parked source, skipping entries whose source is
+  // gone or has already been resumed by the poll backstop.
+  std::shared_ptr<PrestoExchangeSource> parked;
+  {
+    auto deferred = deferredSources().wlock();
+    while (!deferred->empty() && parked == nullptr) {
+      parked = deferred->front().lock();
+      deferred->pop_front();
+    }
+  }
+  if (parked != nullptr) {
+    parked->maybeResumeDeferredRequest();
+  }
+}
+
 void PrestoExchangeSource::doRequest(
     int64_t delayMs,
     uint32_t maxBytes,
-    std::chrono::microseconds maxWait) {
+    std::chrono::microseconds maxWait,
+    bool hedged) {
   if (closed_.load()) {
     queue_->setError("PrestoExchangeSource closed");
     return;
   }
 
-  auto path = fmt::format("{}/{}", basePath_, sequence_);
+  uint64_t fetchEpoch;
+  std::string path;
+  int64_t resumeOffset{0};
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    fetchEpoch = fetchEpoch_;
+    path = fmt::format("{}/{}", basePath_, sequence_);
+    if (partialPageResumeEnabled_ && !hedged && maxBytes > 0 &&
+        resumePrefix_ != nullptr && resumeSequence_ == sequence_) {
+      resumeOffset = resumePrefixBytes_;
+    }
+  }
+  const bool traceRequest = ExchangeTracer::instance()->shouldSample(
+      path, SystemConfig::instance()->exchangeTraceSampleEveryN());
+  const int64_t requestIssuedMs = traceRequest ? getCurrentTimeMs() : 0;
+  // Acquired once and moved into the response callback below; the enclosing
+  // caller keeps 'this' alive until the request is issued.
   auto self = getSelfPtr();
   proxygen::HTTPMethod method;
   if (maxBytes == 0) {
@@ -189,6 +512,28 @@ void PrestoExchangeSource::doRequest(
 
   velox::common::testutil::TestValue::adjust(
       "facebook::presto::PrestoExchangeSource::doRequest", this);
+  // Advertise the dictionary we already hold so the producer does not
+  // re-ship the blob with every compressed response.
+  if (const auto dictionaryId = zstdDecompressor_.dictionaryId();
+      dictionaryId >= 0) {
+    requestBuilder.header(
+        http::kPrestoPageZstdDictionaryId, std::to_string(dictionaryId));
+  }
+  // Ask the producer to null out the exchange columns this fragment does not
+  // use before the pages travel the wire.
+  if (!columnMask_.empty() && maxBytes > 0) {
+    requestBuilder.header(http::kPrestoExchangeColumns, columnMask_);
+  }
+  if (partialPageResumeEnabled_ && !hedged && maxBytes > 0) {
+    // Keep the body prefix of a failed transfer so the retry can resume it.
+    requestBuilder.deliverTruncatedBody(true);
+    if (resumeOffset > 0) {
+      // Resume the broken transfer: ask the producer to skip the prefix of
+      // this token that we already hold.
+      requestBuilder.header(
+          http::kPrestoPageResumeOffset, std::to_string(resumeOffset));
+    }
+  }
   requestBuilder
       .header(
           protocol::PRESTO_MAX_SIZE_HTTP_HEADER,
@@ -201,22 +546,74 @@ void PrestoExchangeSource::doRequest(
       .send(httpClient_.get(), "", delayMs)
       .via(driverExecutor_)
       .thenTry(
-          [this, path, maxBytes, maxWait, self = getSelfPtr()](
+          [this,
+           path,
+           maxBytes,
+           maxWait,
+           traceRequest,
+           requestIssuedMs,
+           fetchEpoch,
+           hedged,
+           self = std::move(self)](
               folly::Try<std::unique_ptr<http::HttpResponse>> responseTry) {
+            if (traceRequest) {
+              int64_t bytes{-1};
+              if (responseTry.hasValue() && responseTry.value() != nullptr) {
+                bytes = folly::tryTo<int64_t>(
+                            responseTry.value()
+                                ->headers()
+                                ->getHeaders()
+                                .getSingleOrEmpty(
+                                    proxygen::HTTP_HEADER_CONTENT_LENGTH))
+                            .value_or(-1);
+              }
+              ExchangeTracer::instance()->record(
+                  {path,
+                   /*producer=*/false,
+                   requestIssuedMs,
+                   getCurrentTimeMs(),
+                   bytes,
+                   /*bufferWaitMs=*/0});
+            }
             // self needs to be held for keeping 'this' source alive during
             // processing
-            handleDataResponse(std::move(responseTry), maxWait, maxBytes, path);
+            handleDataResponse(
+                std::move(responseTry),
+                maxWait,
+                maxBytes,
+                path,
+                fetchEpoch,
+                hedged);
           });
+
+  if (!hedged) {
+    maybeScheduleHedgedRequest(fetchEpoch, maxBytes, maxWait);
+  }
 };
 
 void PrestoExchangeSource::handleDataResponse(
     folly::Try<std::unique_ptr<http::HttpResponse>> responseTry,
     std::chrono::microseconds maxWait,
     uint32_t maxBytes,
-    const std::string& httpRequestPath) {
+    const std::string& httpRequestPath,
+    uint64_t fetchEpoch,
+    bool hedged) {
   velox::common::testutil::TestValue::adjust(
       "facebook::presto::PrestoExchangeSource::handleDataResponse", this);
+  const auto fetchServed = [&]() {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    return fetchEpoch != fetchEpoch_ || fetchResponseHandled_;
+  };
   if (responseTry.hasException()) {
+    // Failures of hedged requests are never retried: the primary request
+    // path still owns retries. A primary failure arriving after the fetch
+    // has been served by the hedged response is likewise dropped.
+    if (hedged || fetchServed()) {
+      VLOG(1) << "Dropping failed " << (hedged ? "hedged" : "superseded")
+              << " request for " << httpRequestPath << ": "
+              << responseTry.exception().what();
+      return;
+    }
     processDataError(
         httpRequestPath,
         maxBytes,
@@ -228,6 +625,14 @@ void PrestoExchangeSource::handleDataResponse(
       auto* headers = response->headers();
       if (headers->getStatusCode() != http::kHttpOk &&
           headers->getStatusCode() != http::kHttpNoContent) {
+        if (hedged || fetchServed()) {
+          VLOG(1) << "Dropping HTTP " << headers->getStatusCode()
+                  << " response of "
+                  << (hedged ? "hedged" : "superseded") << " request for "
+                  << httpRequestPath;
+          response->freeBuffers();
+          return;
+        }
         // Ideally, not all errors are retryable - especially internal
         // server errors - which usually point to a query failure on another
         // machine. But we retry all such errors and rely on the coordinator
@@ -243,9 +648,64 @@ void PrestoExchangeSource::handleDataResponse(
                 bodyAsString(
                     *response,
                     immediateBufferTransfer_ ? pool_.get() : nullptr)));
+      } else if (response->truncated()) {
+        // The transfer died mid-body. Salvage the received prefix so the
+        // retry can resume from it, then go through the regular retry path.
+        if (hedged || fetchServed()) {
+          VLOG(1) << "Dropping truncated response of "
+                  << (hedged ? "hedged" : "superseded") << " request for "
+                  << httpRequestPath << ": " << response->truncatedError();
+          response->freeBuffers();
+          return;
+        }
+        if (maxBytes > 0) {
+          maybeSalvagePartialResponse(*response);
+        }
+        response->freeBuffers();
+        processDataError(
+            httpRequestPath, maxBytes, maxWait, response->truncatedError());
       } else if (response->hasError()) {
+        if (hedged || fetchServed()) {
+          VLOG(1) << "Dropping errored response of "
+                  << (hedged ? "hedged" : "superseded") << " request for "
+                  << httpRequestPath << ": " << response->error();
+          return;
+        }
         processDataError(httpRequestPath, maxBytes, maxWait, response->error());
       } else {
+        // Claim the fetch for this response. With hedging, two requests may
+        // be in flight for the same token; only the first response to get
+        // here is processed, the loser is discarded without touching the
+        // queue or the sequence.
+        {
+          std::lock_guard<std::mutex> l(queue_->mutex());
+          if (fetchEpoch != fetchEpoch_ || fetchResponseHandled_) {
+            response->freeBuffers();
+            return;
+          }
+          fetchResponseHandled_ = true;
+        }
+        if (partialPageResumeEnabled_ && !hedged && maxBytes > 0 &&
+            prepareResumedFetch(*response) == ResumeAction::kReject) {
+          // The resumed splice cannot be trusted. Give the claim back and
+          // refetch the token from the start; the salvage is gone, so the
+          // retry carries no resume offset.
+          {
+            std::lock_guard<std::mutex> l(queue_->mutex());
+            fetchResponseHandled_ = false;
+          }
+          RECORD_METRIC_VALUE(kCounterExchangeResumeRejectedCount);
+          response->freeBuffers();
+          processDataError(
+              httpRequestPath,
+              maxBytes,
+              maxWait,
+              "Resumed exchange fetch failed splice validation");
+          return;
+        }
+        if (hedged) {
+          RECORD_METRIC_VALUE(kCounterExchangeHedgedRequestWinCount);
+        }
         const bool isGetDataSizeRequest = (maxBytes == 0);
         processDataResponse(std::move(response), isGetDataSizeRequest);
       }
@@ -258,6 +718,8 @@ void PrestoExchangeSource::handleDataResponse(
 void PrestoExchangeSource::processDataResponse(
     std::unique_ptr<http::HttpResponse> response,
     bool isGetDataSizeRequest) {
+  ScopedAllocationTag allocationTag{AllocationTag::kExchange};
+  lastResponseMs_ = getCurrentTimeMs();
   if (isGetDataSizeRequest) {
     int64_t waitTimeMs = 0;
     auto waitTimeMsString = response->headers()->getHeaders().getSingleOrEmpty(
@@ -274,6 +736,11 @@ void PrestoExchangeSource::processDataResponse(
         kCounterExchangeGetDataSizeNumTries, dataRequestRetryState_.numTries());
   } else {
     getDataNs_.addValue(dataRequestRetryState_.durationMs() * 1'000'000);
+    if (hedgedRequestEnabled_) {
+      HedgeLatencyTracker::instance()->record(
+          fmt::format("{}:{}", host_, port_),
+          dataRequestRetryState_.durationMs());
+    }
     RECORD_HISTOGRAM_METRIC_VALUE(
         kCounterExchangeRequestDuration, dataRequestRetryState_.durationMs());
     RECORD_HISTOGRAM_METRIC_VALUE(
@@ -283,7 +750,18 @@ void PrestoExchangeSource::processDataResponse(
     // If PrestoExchangeSource is already closed, just free all buffers
     // allocated without doing any processing. This can happen when a super slow
     // response comes back after its owning 'Task' gets destroyed.
+    {
+      // A splice staged for this response is dropped with it; close() may
+      // have run before the prefix was staged.
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      if (spliceChain_ != nullptr) {
+        spliceChain_.reset();
+        PrestoExchangeSource::updateMemoryUsage(-spliceBytes_);
+        spliceBytes_ = 0;
+      }
+    }
     response->freeBuffers();
+    releaseRequestMemory();
     return;
   }
   auto* headers = response->headers();
@@ -332,25 +810,77 @@ void PrestoExchangeSource::processDataResponse(
         contentLength, 0, "next token is not set in non-empty data response");
   }
 
-  std::unique_ptr<exec::SerializedPageBase> page;
+  // A non-empty dictionary id marks the body as zstd-compressed against the
+  // producer's trained dictionary; the dictionary itself rides along once,
+  // base64-encoded, on the first compressed response (or whenever our
+  // request did not advertise the current id).
+  const auto zstdDictionaryIdStr = headers->getHeaders().getSingleOrEmpty(
+      http::kPrestoPageZstdDictionaryId);
+  if (!zstdDictionaryIdStr.empty()) {
+    const auto& dictionaryBase64 = headers->getHeaders().getSingleOrEmpty(
+        http::kPrestoPageZstdDictionary);
+    if (!dictionaryBase64.empty()) {
+      zstdDecompressor_.setDictionary(
+          encoding::Base64::decode(dictionaryBase64));
+    }
+  }
+
+  // The body is not wrapped into a serialized page right away: the iobuf
+  // chain and the closure settling its memory accounting are kept separate
+  // so that, with page coalescing enabled, several response bodies can be
+  // combined into one page under the queue's mutex below.
+  std::unique_ptr<folly::IOBuf> bodyChain;
+  int64_t bodyBytes{0};
+  folly::Function<void()> bodyRelease;
   const bool empty = response->empty();
   if (!empty) {
     std::vector<std::unique_ptr<folly::IOBuf>> iobufs;
     if (immediateBufferTransfer_ || !enableBufferCopy_) {
       iobufs = response->consumeBody();
     } else {
-      iobufs.emplace_back(response->consumeBody(pool_.get()));
+      iobufs = response->consumeBody(pool_.get());
     }
     int64_t iobufBytes{0};
     std::unique_ptr<folly::IOBuf> singleChain;
+    // Pool-backed buffers are freed by address rather than by walking the
+    // iobuf chain on page destruction, since the chain may end up linked
+    // into a coalesced page together with buffers that are not pool-backed.
+    std::vector<std::pair<void*, uint64_t>> pooledBuffers;
     for (auto& buf : iobufs) {
       iobufBytes += buf->capacity();
+      if (enableBufferCopy_) {
+        pooledBuffers.emplace_back(buf->writableData(), buf->capacity());
+      }
       if (!singleChain) {
         singleChain = std::move(buf);
       } else {
         singleChain->prev()->appendChain(std::move(buf));
       }
     }
+    {
+      // A validated resume splice: the salvaged prefix rejoins the payload
+      // ahead of the resent tail, and its bytes move from the salvage
+      // accounting into this body's release closure. The prefix is a plain
+      // heap buffer; linking it into a chain with pool-backed buffers is
+      // fine since those are freed by recorded address rather than by
+      // walking the chain.
+      std::unique_ptr<folly::IOBuf> splice;
+      int64_t spliceBytes{0};
+      {
+        std::lock_guard<std::mutex> l(queue_->mutex());
+        splice = std::move(spliceChain_);
+        spliceBytes = spliceBytes_;
+        spliceBytes_ = 0;
+      }
+      if (splice != nullptr) {
+        if (singleChain != nullptr) {
+          splice->prev()->appendChain(std::move(singleChain));
+        }
+        singleChain = std::move(splice);
+        iobufBytes += spliceBytes;
+        PrestoExchangeSource::updateMemoryUsage(-spliceBytes);
+      }
+    }
     PrestoExchangeSource::updateMemoryUsage(iobufBytes);
 
     // Record IOBuf size counter when not a get-data-size request
@@ -358,41 +888,88 @@ void PrestoExchangeSource::processDataResponse(
       iobufBytes_.addValue(iobufBytes);
       RECORD_HISTOGRAM_METRIC_VALUE(
           kCounterExchangeRequestPageSize, iobufBytes);
+      updateAdaptiveRequestSize(
+          iobufBytes,
+          dataRequestRetryState_.durationMs(),
+          std::accumulate(
+              remainingBytes.begin(), remainingBytes.end(), int64_t{0}));
     }
 
-    if (enableBufferCopy_) {
-      page = std::make_unique<exec::PrestoSerializedPage>(
-          std::move(singleChain), [pool = pool_](folly::IOBuf& iobuf) {
-            int64_t freedBytes{0};
-            // Free the backed memory from MemoryAllocator on page dtor
-            folly::IOBuf* start = &iobuf;
-            auto curr = start;
-            do {
-              freedBytes += curr->capacity();
-              pool->free(curr->writableData(), curr->capacity());
-              curr = curr->next();
-            } while (curr != start);
-            PrestoExchangeSource::updateMemoryUsage(-freedBytes);
-          });
+    if (!zstdDictionaryIdStr.empty()) {
+      // Decompress into a plain buffer and release the compressed body right
+      // away; only the decompressed copy is enqueued, so the pooled paths
+      // below do not apply to it.
+      auto decompressed = zstdDecompressor_.decompress(
+          *singleChain, folly::to<int64_t>(zstdDictionaryIdStr));
+      const int64_t decompressedBytes = decompressed->capacity();
+      if (enableBufferCopy_) {
+        for (const auto& [data, capacity] : pooledBuffers) {
+          HugePageArena::freeTo(pool_.get(), data, capacity);
+        }
+      }
+      singleChain.reset();
+      PrestoExchangeSource::updateMemoryUsage(decompressedBytes - iobufBytes);
+      bodyChain = std::move(decompressed);
+      bodyBytes = decompressedBytes;
+      bodyRelease = [decompressedBytes]() {
+        PrestoExchangeSource::updateMemoryUsage(-decompressedBytes);
+      };
+    } else if (enableBufferCopy_) {
+      bodyChain = std::move(singleChain);
+      bodyBytes = iobufBytes;
+      bodyRelease = [pool = pool_,
+                     pooledBuffers = std::move(pooledBuffers),
+                     iobufBytes]() {
+        // Free the backed memory from MemoryAllocator on page dtor
+        for (const auto& [data, capacity] : pooledBuffers) {
+          HugePageArena::freeTo(pool.get(), data, capacity);
+        }
+        PrestoExchangeSource::updateMemoryUsage(-iobufBytes);
+      };
     } else {
-      page = std::make_unique<exec::PrestoSerializedPage>(
-          std::move(singleChain), [iobufBytes](folly::IOBuf& iobuf) {
-            PrestoExchangeSource::updateMemoryUsage(-iobufBytes);
-          });
+      bodyChain = std::move(singleChain);
+      bodyBytes = iobufBytes;
+      bodyRelease = [iobufBytes]() {
+        PrestoExchangeSource::updateMemoryUsage(-iobufBytes);
+      };
+    }
+
+    if (!isGetDataSizeRequest) {
+      responseBytesEwma_ = responseBytesEwma_ == 0
+          ? bodyBytes
+          : responseBytesEwma_ * 0.75 + bodyBytes * 0.25;
     }
   }
 
-  const int64_t pageSize = empty ? 0 : page->size();
+  const int64_t pageSize = empty
+      ? 0
+      : static_cast<int64_t>(bodyChain->computeChainDataLength());
   VeloxPromise<Response> requestPromise{VeloxPromise<Response>::makeEmpty()};
   std::vector<ContinuePromise> queuePromises;
+  bool pipelinedResponse{false};
   {
     std::lock_guard<std::mutex> l(queue_->mutex());
-    if (page) {
-      VLOG(1) << "Enqueuing page for " << basePath_ << "/" << sequence_ << ": "
-              << pageSize << " bytes";
+    pipelinedResponse = pipelinedRequest_;
+    pipelinedRequest_ = false;
+    if (bodyChain) {
       ++numPages_;
       pageSize_ += pageSize;
-      queue_->enqueueLocked(std::move(page), queuePromises);
+      appendCoalescedLocked(
+          std::move(bodyChain), bodyBytes, std::move(bodyRelease));
+    }
+    // Small responses are held back until the coalesce target is reached. A
+    // complete or empty response means the producer has nothing more ready,
+    // so waiting for more data to batch would only add latency.
+    const bool hold = pageCoalescingEnabled_ && !complete && !empty &&
+        coalesceBytes_ < coalesceTargetBytes();
+    if (closed_.load()) {
+      // close() ran after this response passed the closed check above; drop
+      // the data instead of enqueueing or holding it.
+      dropCoalescedLocked();
+    } else if (coalesceChain_ != nullptr && !hold) {
+      VLOG(1) << "Enqueuing page for " << basePath_ << "/" << sequence_
+              << ": " << coalesceBytes_ << " bytes";
+      queue_->enqueueLocked(takeCoalescedPageLocked(), queuePromises);
     }
     if (complete) {
       VLOG(1) << "Enqueuing empty page for " << basePath_ << "/" << sequence_;
@@ -403,6 +980,11 @@ void PrestoExchangeSource::processDataResponse(
     if (ackSequenceOpt.has_value()) {
       sequence_ = ackSequenceOpt.value();
     }
+    if (resumeSequence_ != -1 && resumeSequence_ != sequence_) {
+      // The token was served by another response (a hedged winner); the
+      // salvaged prefix is obsolete.
+      dropResumePrefixLocked();
+    }
     requestPending_ = false;
     requestPromise = std::move(promise_);
   }
@@ -414,12 +996,307 @@ void PrestoExchangeSource::processDataResponse(
     requestPromise.setValue(
         Response{pageSize, complete, std::move(remainingBytes)});
   } else {
-    // The source must have been closed.
-    VELOX_CHECK(closed_.load());
+    // The source must have been closed, or this response was fetched ahead by
+    // a pipelined request that has no promise to fulfill.
+    VELOX_CHECK(closed_.load() || pipelinedResponse);
   }
 
+  // The response has been consumed; drop the admission reservation and let a
+  // parked source proceed. Pipelined fetches below are issued without going
+  // back through admission: the budget was just proven available and holding
+  // the reservation across the fetch window would starve parked sources.
+  releaseRequestMemory();
+
   if (complete) {
     abortResults();
+  } else {
+    maybePipelineNextRequest(empty);
+  }
+}
+
+void PrestoExchangeSource::maybeSalvagePartialResponse(
+    http::HttpResponse& response) {
+  auto* headers = response.headers();
+  if (headers->getStatusCode() != http::kHttpOk || response.empty()) {
+    return;
+  }
+  // A dictionary-compressed body cannot be resumed: the producer does not
+  // guarantee byte-identical compressed output across attempts.
+  if (!headers->getHeaders()
+           .getSingleOrEmpty(http::kPrestoPageZstdDictionaryId)
+           .empty()) {
+    return;
+  }
+
+  // Copy the received bytes into one plain heap buffer so the salvage pins
+  // neither the response nor its pooled buffers.
+  size_t bodyBytes{0};
+  response.visitBody([&bodyBytes](const uint8_t* /*data*/, size_t length) {
+    bodyBytes += length;
+  });
+  if (bodyBytes == 0) {
+    return;
+  }
+  auto salvaged = folly::IOBuf::create(bodyBytes);
+  response.visitBody([&salvaged](const uint8_t* data, size_t length) {
+    std::memcpy(salvaged->writableTail(), data, length);
+    salvaged->append(length);
+  });
+
+  const auto echoedOffsetStr =
+      headers->getHeaders().getSingleOrEmpty(http::kPrestoPageResumeOffset);
+  std::lock_guard<std::mutex> l(queue_->mutex());
+  if (resumePrefix_ != nullptr && !echoedOffsetStr.empty() &&
+      folly::tryTo<int64_t>(echoedOffsetStr).value_or(-1) ==
+          resumePrefixBytes_ &&
+      resumeSequence_ == sequence_) {
+    // The retry of an earlier salvage died as well; the new bytes continue
+    // the held prefix.
+    resumePrefixCrc_ =
+        folly::crc32c(salvaged->data(), bodyBytes, resumePrefixCrc_);
+    resumePrefix_->prev()->appendChain(std::move(salvaged));
+    resumePrefixBytes_ += bodyBytes;
+  } else {
+    dropResumePrefixLocked();
+    resumePrefixCrc_ = folly::crc32c(salvaged->data(), bodyBytes);
+    resumePrefix_ = std::move(salvaged);
+    resumePrefixBytes_ = bodyBytes;
+    resumeSequence_ = sequence_;
+  }
+  PrestoExchangeSource::updateMemoryUsage(bodyBytes);
+}
+
+PrestoExchangeSource::ResumeAction PrestoExchangeSource::prepareResumedFetch(
+    http::HttpResponse& response) {
+  const auto echoedOffsetStr = response.headers()->getHeaders().getSingleOrEmpty(
+      http::kPrestoPageResumeOffset);
+  std::unique_ptr<folly::IOBuf> prefix;
+  int64_t prefixBytes{0};
+  uint32_t crc{0};
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    if (resumePrefix_ == nullptr) {
+      // An echoed offset without a salvaged prefix cannot be spliced.
+      return echoedOffsetStr.empty() ? ResumeAction::kNone
+                                     : ResumeAction::kReject;
+    }
+    if (echoedOffsetStr.empty()) {
+      // The producer served the full token (it does not support resuming,
+      // or the offset fell outside the payload); the salvaged prefix is
+      // superseded.
+      dropResumePrefixLocked();
+      return ResumeAction::kNone;
+    }
+    if (resumeSequence_ != sequence_ ||
+        folly::tryTo<int64_t>(echoedOffsetStr).value_or(-1) !=
+            resumePrefixBytes_) {
+      dropResumePrefixLocked();
+      return ResumeAction::kReject;
+    }
+    prefix = std::move(resumePrefix_);
+    prefixBytes = resumePrefixBytes_;
+    crc = resumePrefixCrc_;
+    resumePrefixBytes_ = 0;
+    resumeSequence_ = -1;
+  }
+
+  // Continue the crc over the resent tail and compare it with the checksum
+  // the producer computed over the whole payload.
+  response.visitBody([&crc](const uint8_t* data, size_t length) {
+    crc = folly::crc32c(data, length, crc);
+  });
+  const auto checksumStr = response.headers()->getHeaders().getSingleOrEmpty(
+      http::kPrestoPageChecksum);
+  if (folly::tryTo<uint32_t>(checksumStr).value_or(crc + 1) != crc) {
+    PrestoExchangeSource::updateMemoryUsage(-prefixBytes);
+    return ResumeAction::kReject;
+  }
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    spliceChain_ = std::move(prefix);
+    spliceBytes_ = prefixBytes;
+  }
+  RECORD_METRIC_VALUE(kCounterExchangeResumedFetchCount);
+  return ResumeAction::kSplice;
+}
+
+void PrestoExchangeSource::dropResumePrefixLocked() {
+  if (resumePrefix_ == nullptr) {
+    return;
+  }
+  resumePrefix_.reset();
+  PrestoExchangeSource::updateMemoryUsage(-resumePrefixBytes_);
+  resumePrefixBytes_ = 0;
+  resumeSequence_ = -1;
+}
+
+void PrestoExchangeSource::appendCoalescedLocked(
+    std::unique_ptr<folly::IOBuf> chain,
+    int64_t chainBytes,
+    folly::Function<void()> release) {
+  if (!coalesceChain_) {
+    coalesceChain_ = std::move(chain);
+  } else {
+    coalesceChain_->prev()->appendChain(std::move(chain));
+  }
+  coalesceBytes_ += chainBytes;
+  coalesceReleases_.push_back(std::move(release));
+}
+
+std::unique_ptr<exec::SerializedPageBase>
+PrestoExchangeSource::takeCoalescedPageLocked() {
+  VELOX_CHECK_NOT_NULL(coalesceChain_);
+  if (coalesceReleases_.size() > 1) {
+    coalescedPageBytes_.addValue(coalesceBytes_);
+  }
+  // The page destruction callback must be copyable; the move-only release
+  // closures are shared rather than moved into it.
+  auto releases = std::make_shared<std::vector<folly::Function<void()>>>(
+      std::move(coalesceReleases_));
+  coalesceReleases_.clear();
+  coalesceBytes_ = 0;
+  return std::make_unique<exec::PrestoSerializedPage>(
+      std::move(coalesceChain_), [releases](folly::IOBuf& /*iobuf*/) {
+        for (auto& release : *releases) {
+          release();
+        }
+      });
+}
+
+void PrestoExchangeSource::dropCoalescedLocked() {
+  if (coalesceChain_ == nullptr) {
+    return;
+  }
+  coalesceChain_.reset();
+  coalesceBytes_ = 0;
+  for (auto& release : coalesceReleases_) {
+    release();
+  }
+  coalesceReleases_.clear();
+}
+
+int64_t PrestoExchangeSource::coalesceTargetBytes() const {
+  return std::max(
+      kMinCoalesceTargetBytes,
+      std::min(
+          kMaxCoalesceTargetBytes,
+          static_cast<int64_t>(responseBytesEwma_) * kCoalesceTargetResponses));
+}
+
+void PrestoExchangeSource::maybePipelineNextRequest(bool empty) {
+  if (pipelinedFetchWindow_ == 0 || empty || closed_.load()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    // Data size requests (maxBytes == 0) are not pipelined. If the exchange
+    // client got in first with an explicit request, let it drive.
+    if (lastMaxBytes_ == 0 || requestPending_ ||
+        numPipelinedFetches_ >= pipelinedFetchWindow_) {
+      return;
+    }
+    ++numPipelinedFetches_;
+    requestPending_ = true;
+    pipelinedRequest_ = true;
+    ++fetchEpoch_;
+    fetchResponseHandled_ = false;
+    hedgedRequestIssued_ = false;
+  }
+  // The advanced sequence on this request acknowledges the data received
+  // above; no separate acknowledge round trip is needed.
+  dataRequestRetryState_ = RetryState(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          SystemConfig::instance()->exchangeMaxErrorDuration())
+          .count());
+  doRequest(
+      dataRequestRetryState_.nextDelayMs() + rackDispatchDelayMs(),
+      lastMaxBytes_,
+      lastMaxWait_,
+      /*hedged=*/false);
+}
+
+void PrestoExchangeSource::maybeScheduleHedgedRequest(
+    uint64_t fetchEpoch,
+    uint32_t maxBytes,
+    std::chrono::microseconds maxWait) {
+  if (!hedgedRequestEnabled_ || maxBytes == 0) {
+    return;
+  }
+  const auto delayMs = HedgeLatencyTracker::instance()->delayMs(
+      fmt::format("{}:{}", host_, port_), hedgedRequestDelayMs_);
+  folly::futures::sleep(std::chrono::milliseconds(delayMs))
+      .via(driverExecutor_)
+      .thenValue([this, fetchEpoch, maxBytes, maxWait, self = getSelfPtr()](
+                     folly::Unit) {
+        if (closed_.load()) {
+          return;
+        }
+        {
+          std::lock_guard<std::mutex> l(queue_->mutex());
+          if (fetchEpoch != fetchEpoch_ || fetchResponseHandled_ ||
+              hedgedRequestIssued_) {
+            return;
+          }
+          hedgedRequestIssued_ = true;
+        }
+        VLOG(1) << "Hedging slow request to " << host_ << ":" << port_
+                << " for " << basePath_ << "/" << sequence_;
+        RECORD_METRIC_VALUE(kCounterExchangeHedgedRequestCount);
+        doRequest(/*delayMs=*/0, maxBytes, maxWait, /*hedged=*/true);
+      });
+}
+
+uint32_t PrestoExchangeSource::adjustRequestSize(uint32_t maxBytes) {
+  if (!adaptiveRequestSizeEnabled_ || maxBytes == 0) {
+    return maxBytes;
+  }
+  clientMaxBytes_ = maxBytes;
+  if (adaptiveMaxBytes_ == 0) {
+    adaptiveMaxBytes_ = maxBytes;
+  }
+  adaptiveMaxBytes_ = std::max(
+      std::min(adaptiveMaxBytes_, maxBytes),
+      std::min(kMinAdaptiveRequestBytes, maxBytes));
+  adaptiveRequestBytes_.addValue(adaptiveMaxBytes_);
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      kCounterExchangeAdaptiveRequestSize, adaptiveMaxBytes_);
+  return adaptiveMaxBytes_;
+}
+
+void PrestoExchangeSource::updateAdaptiveRequestSize(
+    int64_t responseBytes,
+    int64_t durationMs,
+    int64_t upstreamBacklogBytes) {
+  if (!adaptiveRequestSizeEnabled_ || adaptiveMaxBytes_ == 0) {
+    return;
+  }
+  if (durationMs > kAdaptiveSlowResponseMs) {
+    // The response took too long: halve the budget so a slow link holds less
+    // in-flight data (and less queued memory) per round trip.
+    adaptiveMaxBytes_ = std::max(
+        adaptiveMaxBytes_ / 2,
+        std::min(kMinAdaptiveRequestBytes, clientMaxBytes_));
+    return;
+  }
+  if (upstreamBacklogBytes == 0 &&
+      responseBytes < kAdaptiveFullResponseRatio * adaptiveMaxBytes_) {
+    // The upstream buffer drained without filling the budget: the producer is
+    // the bottleneck, so a large budget only makes it hold more data per
+    // round trip. Decay the budget toward the minimum.
+    adaptiveMaxBytes_ = std::max<uint64_t>(
+        adaptiveMaxBytes_ -
+            std::min<uint64_t>(kAdaptiveRequestStepBytes, adaptiveMaxBytes_),
+        std::min(kMinAdaptiveRequestBytes, clientMaxBytes_));
+    return;
+  }
+  if (responseBytes >= kAdaptiveFullResponseRatio * adaptiveMaxBytes_ ||
+      upstreamBacklogBytes >= adaptiveMaxBytes_) {
+    // The upstream worker filled the budget quickly or reports a backlog at
+    // least one budget deep, so this source is the bottleneck: grow the
+    // budget additively up to the client's cap.
+    adaptiveMaxBytes_ = std::min<uint64_t>(
+        static_cast<uint64_t>(adaptiveMaxBytes_) + kAdaptiveRequestStepBytes,
+        clientMaxBytes_);
   }
 }
 
@@ -434,7 +1311,19 @@ void PrestoExchangeSource::processDataError(
             << path << ", duration: " << dataRequestRetryState_.durationMs()
             << "ms - Retrying: " << error;
 
-    doRequest(dataRequestRetryState_.nextDelayMs(), maxBytes, maxWait);
+    doRequest(
+        dataRequestRetryState_.nextDelayMs(),
+        maxBytes,
+        maxWait,
+        /*hedged=*/false);
+    return;
+  }
+
+  if (maybeFailoverToMaterialized()) {
+    LOG(WARNING) << "Failed to fetch data from " << host_ << ":" << port_
+                 << " " << path << " after " << failedAttempts_
+                 << " retries; served the remaining pages from the "
+                 << "materialized exchange copy";
     return;
   }
 
@@ -449,10 +1338,103 @@ void PrestoExchangeSource::processDataError(
           error),
       queue_);
 
+  releaseRequestMemory();
+
+  bool pipelinedResponse{false};
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    pipelinedResponse = pipelinedRequest_;
+    pipelinedRequest_ = false;
+  }
   if (!checkSetRequestPromise()) {
-    // The source must have been closed.
-    VELOX_CHECK(closed_.load());
+    // The source must have been closed, or the failed request was a pipelined
+    // fetch with no promise to fulfill. The queue error set above fails the
+    // task either way.
+    VELOX_CHECK(closed_.load() || pipelinedResponse);
+  }
+}
+
+bool PrestoExchangeSource::maybeFailoverToMaterialized() {
+  const auto* systemConfig = SystemConfig::instance();
+  if (!systemConfig->exchangeMaterializationEnabled() || closed_.load()) {
+    return false;
+  }
+  const auto basePath = systemConfig->exchangeMaterializationBasePath();
+  if (basePath.empty()) {
+    return false;
+  }
+  const auto filePath =
+      ExchangeMaterializer::filePath(basePath, taskId_, destination_);
+  int64_t totalBytes = 0;
+  std::vector<std::unique_ptr<exec::SerializedPageBase>> pages;
+  try {
+    auto fileSystem = filesystems::getFileSystem(filePath, nullptr);
+    if (!fileSystem->exists(filePath)) {
+      // The producer never sealed a copy of this buffer.
+      return false;
+    }
+    auto fileInfo = std::make_unique<operators::BroadcastFileInfo>();
+    fileInfo->filePath_ = filePath;
+    operators::BroadcastFileReader reader(fileInfo, fileSystem, pool_);
+
+    // Pages up to 'sequence_' were received and acknowledged over HTTP
+    // before the producer was lost; only the rest is served from the file.
+    int64_t skip = sequence_;
+    while (reader.hasNext()) {
+      auto buffer = reader.next();
+      VELOX_CHECK_NOT_NULL(buffer);
+      if (skip > 0) {
+        --skip;
+        continue;
+      }
+      auto ioBuf = folly::IOBuf::wrapBuffer(buffer->as<char>(), buffer->size());
+      pages.push_back(
+          std::make_unique<exec::PrestoSerializedPage>(
+              std::move(ioBuf), [buffer](auto& /*unused*/) {}));
+      totalBytes += buffer->size();
+    }
+    if (skip > 0) {
+      // A sealed file always covers every sequence; a shorter one is not
+      // the output of this buffer.
+      LOG(WARNING) << "Materialized exchange copy " << filePath << " ends "
+                   << skip << " sequences before token " << sequence_
+                   << "; ignoring it";
+      return false;
+    }
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Materialized exchange failover failed for " << filePath
+                 << ": " << e.what();
+    return false;
+  }
+
+  VeloxPromise<Response> requestPromise{VeloxPromise<Response>::makeEmpty()};
+  std::vector<ContinuePromise> queuePromises;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    // Pages held back for coalescing were already acknowledged; deliver them
+    // ahead of the pages read from the file.
+    if (coalesceChain_ != nullptr) {
+      queue_->enqueueLocked(takeCoalescedPageLocked(), queuePromises);
+    }
+    dropResumePrefixLocked();
+    for (auto& page : pages) {
+      queue_->enqueueLocked(std::move(page), queuePromises);
+    }
+    atEnd_ = true;
+    queue_->enqueueLocked(nullptr, queuePromises);
+    requestPending_ = false;
+    pipelinedRequest_ = false;
+    requestPromise = std::move(promise_);
+  }
+  for (auto& promise : queuePromises) {
+    promise.setValue();
+  }
+  if (requestPromise.valid() && !requestPromise.isFulfilled()) {
+    requestPromise.setValue(Response{totalBytes, true});
   }
+  releaseRequestMemory();
+  RECORD_METRIC_VALUE(kCounterExchangeMaterializedFailovers);
+  return true;
 }
 
 void PrestoExchangeSource::pause() {
@@ -560,7 +1542,10 @@ bool PrestoExchangeSource::checkSetRequestPromise() {
 }
 
 std::shared_ptr<PrestoExchangeSource> PrestoExchangeSource::getSelfPtr() {
-  return std::dynamic_pointer_cast<PrestoExchangeSource>(shared_from_this());
+  // The static cast is safe: shared_from_this() on a PrestoExchangeSource
+  // always yields one, and this runs on every response callback, so the
+  // RTTI lookup of a dynamic cast would be paid at request rate.
+  return std::static_pointer_cast<PrestoExchangeSource>(shared_from_this());
 }
 
 // static
@@ -13,10 +13,12 @@
  */
 #pragma once
 
+#include <folly/Function.h>
 #include <folly/Uri.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/futures/Retrying.h>
 
+#include "presto_cpp/main/ExchangePageCompression.h"
 #include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/http/HttpClient.h"
 #include "velox/common/memory/Memory.h"
@@ -151,6 +153,17 @@ class PrestoExchangeSource : public velox::exec::ExchangeSource {
     if (iobufBytes_.count > 0) {
       result["prestoExchangeSource.iobufBytes"] = iobufBytes_;
     }
+    if (adaptiveRequestBytes_.count > 0) {
+      result["prestoExchangeSource.adaptiveRequestBytes"] =
+          adaptiveRequestBytes_;
+    }
+    if (remoteRackDelayedRequests_.count > 0) {
+      result["prestoExchangeSource.remoteRackDelayedRequests"] =
+          remoteRackDelayedRequests_;
+    }
+    if (coalescedPageBytes_.count > 0) {
+      result["prestoExchangeSource.coalescedPageBytes"] = coalescedPageBytes_;
+    }
 
     return result;
   }
@@ -168,6 +181,14 @@ class PrestoExchangeSource : public velox::exec::ExchangeSource {
     obj["closed"] = std::to_string(closed_);
     obj["abortResultsIssued"] = std::to_string(abortResultsIssued_);
     obj["atEnd"] = atEnd_;
+    obj["dataRequestNumTries"] = dataRequestRetryState_.numTries();
+    obj["dataRequestDurationMs"] = dataRequestRetryState_.durationMs();
+    obj["failedAttempts"] = failedAttempts_;
+    obj["lastResponseMs"] = lastResponseMs_.load();
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      obj["queuedBytes"] = queue_->totalBytes();
+    }
     return obj;
   }
 
@@ -187,13 +208,21 @@ class PrestoExchangeSource : public velox::exec::ExchangeSource {
   static void resetPeakMemoryUsage();
 
  private:
+  // Issues a getData request after 'delayMs'. 'hedged' marks a duplicate
+  // request issued by maybeScheduleHedgedRequest() for the same token as the
+  // outstanding primary request; failures of hedged requests are dropped
+  // rather than retried since the primary path still owns retries.
   void doRequest(
       int64_t delayMs,
       uint32_t maxBytes,
-      std::chrono::microseconds maxWait);
+      std::chrono::microseconds maxWait,
+      bool hedged);
 
   // Handles returned http response from the get result request. It dispatches
-  // the data handling to corresponding data processing methods.
+  // the data handling to corresponding data processing methods. 'fetchEpoch'
+  // identifies the logical fetch the request belonged to; responses arriving
+  // after that fetch has already been served by another request (the hedging
+  // loser, or a slow duplicate) are discarded without processing.
   //
   // NOTE: This method is normally called within callbacks. Caller should make
   // sure 'this' lives during the entire duration of this method call.
@@ -201,7 +230,9 @@ class PrestoExchangeSource : public velox::exec::ExchangeSource {
       folly::Try<std::unique_ptr<http::HttpResponse>> responseTry,
       std::chrono::microseconds maxWait,
       uint32_t maxBytes,
-      const std::string& httpRequestPath);
+      const std::string& httpRequestPath,
+      uint64_t fetchEpoch,
+      bool hedged);
 
   // Handles successful, possibly empty, response. Adds received data to the
   // queue. If received an end marker, notifies the queue by adding null page.
@@ -226,6 +257,137 @@ class PrestoExchangeSource : public velox::exec::ExchangeSource {
       std::chrono::microseconds maxWait,
       const std::string& error);
 
+  // Last resort after the data request retries are exhausted: when exchange
+  // materialization is configured and the producer sealed a materialized
+  // copy of this buffer, serves the not-yet-received pages from that file
+  // and completes the source, so losing the producer costs a failover read
+  // instead of the query. Returns false when no usable copy exists and the
+  // failure should surface as usual.
+  bool maybeFailoverToMaterialized();
+
+  // Outcome of matching a data response against a salvaged partial-page
+  // prefix; see prepareResumedFetch().
+  enum class ResumeAction {
+    // Ordinary full response; any stale salvage has been dropped.
+    kNone,
+    // The producer honored the resume offset and the checksum over prefix
+    // plus tail matched; the prefix is staged for processDataResponse().
+    kSplice,
+    // The splice cannot be trusted; the salvage has been dropped and the
+    // caller must refetch the token from the start.
+    kReject,
+  };
+
+  // Salvages the body prefix of a truncated data response so the retry can
+  // resume the fetch from the last received byte instead of refetching the
+  // whole token. The prefix is copied into a plain heap buffer, so the
+  // salvage does not pin the response's pooled buffers. When the retry of
+  // an earlier salvage dies as well, its bytes extend the held prefix.
+  // No-op when the response is compressed against a zstd dictionary (its
+  // bytes are not guaranteed stable across attempts) or has no body.
+  void maybeSalvagePartialResponse(http::HttpResponse& response);
+
+  // Validates 'response' against the salvaged prefix after the fetch has
+  // been claimed: continues the crc32c over the resent tail and compares it
+  // with the checksum the producer computed over the whole payload.
+  ResumeAction prepareResumedFetch(http::HttpResponse& response);
+
+  // Drops any salvaged prefix and settles its memory accounting. The caller
+  // must hold the queue's mutex.
+  void dropResumePrefixLocked();
+
+  // Issues the next getData request right after a successful data response
+  // when pipelined fetching is enabled, without waiting for the exchange
+  // client to call request() again. The advanced token on the pipelined
+  // request doubles as the acknowledgement for the data just received, so no
+  // separate acknowledge round trip is issued. At most
+  // 'exchange.http-client.pipelined-fetch-window' responses are fetched ahead
+  // of the explicit request() calls.
+  void maybePipelineNextRequest(bool empty);
+
+  // Schedules a hedged duplicate of the outstanding getData request when
+  // hedging is enabled. If no response for 'fetchEpoch' has arrived once the
+  // peer's tracked p99 response latency has elapsed, a second request is
+  // issued for the same token (getData is idempotent per token) and the
+  // first response to arrive wins. At most one hedged request is issued per
+  // logical fetch. Data size requests ('maxBytes' == 0) are never hedged.
+  void maybeScheduleHedgedRequest(
+      uint64_t fetchEpoch,
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait);
+
+  // Tries to reserve 'bytes' from the query memory pool for the next getData
+  // request, so the response buffers are admitted against the query limit
+  // before the data is requested rather than after it arrives.
+  bool tryAdmitRequestMemory(uint64_t bytes);
+
+  // Parks the current request until a memory reservation can be obtained.
+  // The request is re-attempted when another source releases its reservation
+  // and by a periodic poll as a backstop for capacity released outside this
+  // admission path (operators freeing memory, arbitration shrinking other
+  // queries).
+  void deferRequest(uint32_t maxBytes, std::chrono::microseconds maxWait);
+
+  // Re-attempts admission for a parked request and issues it on success;
+  // parks it again otherwise. No-op when no request is parked.
+  void maybeResumeDeferredRequest();
+
+  // Releases the memory reservation held for the outstanding getData request
+  // and wakes the longest-waiting parked source, if any.
+  void releaseRequestMemory();
+
+  // Returns the dispatch delay in millis to apply to the next getData
+  // request based on the source's topology distance: a source outside the
+  // local rack is delayed by 'remoteRackDispatchDelayMs_' while the exchange
+  // queue already holds buffered data, so rack-local sources drain first
+  // and cross-rack fetches trickle at lower priority. Returns 0 for
+  // rack-local sources, when rack prioritization is disabled and when the
+  // queue is empty (a remote-only exchange runs at full priority).
+  int64_t rackDispatchDelayMs();
+
+  // Returns the byte budget to send on the next getData request. When
+  // adaptive request sizing is enabled, caps the exchange client's 'maxBytes'
+  // by the current per-source budget and records the value in
+  // 'adaptiveRequestBytes_'. Returns 'maxBytes' unchanged otherwise.
+  uint32_t adjustRequestSize(uint32_t maxBytes);
+
+  // Updates the adaptive byte budget from an observed data response of
+  // 'responseBytes' bytes that took 'durationMs' to fetch, with
+  // 'upstreamBacklogBytes' still buffered for this destination upstream (from
+  // the remaining-bytes response header): grows the budget additively while
+  // the upstream worker fills it quickly or reports a backlog at least one
+  // budget deep, halves it on a slow response, and decays it when the
+  // upstream buffer drained, so each source keeps its in-flight data
+  // proportional to what the producer can deliver in one round trip.
+  void updateAdaptiveRequestSize(
+      int64_t responseBytes,
+      int64_t durationMs,
+      int64_t upstreamBacklogBytes);
+
+  // Appends a response body to the per-source coalesce buffer together with
+  // the closure that settles its memory accounting once the combined page is
+  // destroyed. The caller must hold the queue's mutex.
+  void appendCoalescedLocked(
+      std::unique_ptr<folly::IOBuf> chain,
+      int64_t chainBytes,
+      folly::Function<void()> release);
+
+  // Wraps everything accumulated in the coalesce buffer into one serialized
+  // page and resets the buffer. The caller must hold the queue's mutex and
+  // must have checked that the buffer is not empty.
+  std::unique_ptr<velox::exec::SerializedPageBase> takeCoalescedPageLocked();
+
+  // Runs the release closures of any data still held in the coalesce buffer
+  // without enqueueing it. Used when the source is closed while data is held
+  // back. The caller must hold the queue's mutex.
+  void dropCoalescedLocked();
+
+  // Returns the number of coalesced bytes at which the buffer is flushed to
+  // the queue: a few times this source's observed typical response size,
+  // clamped so tiny pages still flush in reasonably small batches and large
+  // responses are never withheld.
+  int64_t coalesceTargetBytes() const;
+
   void acknowledgeResults(int64_t ackSequence);
 
   // Handles returned http response from acknowledge result request.
@@ -285,6 +447,41 @@ class PrestoExchangeSource : public velox::exec::ExchangeSource {
   const bool immediateBufferTransfer_;
 
   folly::CPUThreadPoolExecutor* const driverExecutor_;
+  // Maximum number of responses to fetch ahead of the explicit request()
+  // calls. Zero disables pipelined fetching.
+  const uint32_t pipelinedFetchWindow_;
+  // If true, the byte budget sent on getData requests is adapted per source
+  // (additive increase, multiplicative decrease) instead of always using the
+  // exchange client's fixed maximum.
+  const bool adaptiveRequestSizeEnabled_;
+  // If true, consecutive small data responses are coalesced into one larger
+  // serialized page before being enqueued, so the consuming driver
+  // deserializes fewer, larger batches.
+  const bool pageCoalescingEnabled_;
+  // If true, a slow getData response triggers a hedged duplicate request for
+  // the same token and the first response to arrive wins.
+  const bool hedgedRequestEnabled_;
+  // Hedge delay used for a peer until its latency distribution has been
+  // sampled.
+  const int64_t hedgedRequestDelayMs_;
+  // If true, each getData request reserves its byte budget from the query
+  // memory pool before being issued and is parked when the reservation
+  // fails, so a burst of large responses from many sources turns into
+  // backpressure instead of a query OOM.
+  const bool memoryAdmissionEnabled_;
+  // Dispatch delay applied to getData requests to this source when it is
+  // outside the local rack and rack-local data is already buffered. 0 when
+  // rack prioritization is disabled or the source is rack-local.
+  const int64_t remoteRackDispatchDelayMs_;
+  // If true, the body prefix of a truncated getData response is salvaged
+  // and the retry resumes the token's payload from the last received byte
+  // instead of refetching it from the start.
+  const bool partialPageResumeEnabled_;
+  // Comma-separated exchange output column mask this fragment registered for
+  // the producing stage; sent with each getData request so the producer can
+  // null out the unused columns. Empty when selective column serving is off
+  // or no mask was registered. See ExchangeProjectionRegistry.
+  std::string columnMask_;
 
   std::shared_ptr<http::HttpClient> httpClient_;
   RetryState dataRequestRetryState_;
@@ -293,15 +490,89 @@ class PrestoExchangeSource : public velox::exec::ExchangeSource {
   // The number of pages received from this presto exchange source.
   uint64_t numPages_{0};
   uint64_t pageSize_{0};
+  // Wall time in milliseconds when the last data response from this source
+  // was processed; 0 until the first response. Exposed via toJson() for the
+  // task debug endpoint to spot sources that have gone quiet.
+  std::atomic<int64_t> lastResponseMs_{0};
   std::atomic_bool closed_{false};
   // A boolean indicating whether abortResults() call was issued
   std::atomic_bool abortResultsIssued_{false};
   velox::VeloxPromise<Response> promise_{
       velox::VeloxPromise<Response>::makeEmpty()};
+  // Parameters of the most recent data request, reused by pipelined fetches.
+  // Protected by queue's mutex.
+  uint32_t lastMaxBytes_{0};
+  std::chrono::microseconds lastMaxWait_{0};
+  // Number of responses fetched ahead since the last request() call.
+  // Protected by queue's mutex.
+  uint32_t numPipelinedFetches_{0};
+  // True if the outstanding data request was issued by
+  // maybePipelineNextRequest() and thus has no promise to fulfill. Protected
+  // by queue's mutex.
+  bool pipelinedRequest_{false};
+  // Identifies the current logical fetch. Incremented when a new fetch
+  // starts so that late responses from a previous fetch (hedging losers) are
+  // recognized and discarded. Protected by queue's mutex.
+  uint64_t fetchEpoch_{0};
+  // True once a response for the current logical fetch has been accepted;
+  // any further response for the same fetch is a duplicate and is dropped.
+  // Protected by queue's mutex.
+  bool fetchResponseHandled_{true};
+  // True once a hedged request has been issued for the current logical
+  // fetch; bounds hedging to one duplicate per fetch even across retries.
+  // Protected by queue's mutex.
+  bool hedgedRequestIssued_{false};
+  // Bytes reserved from the query memory pool for the outstanding getData
+  // request; 0 when no reservation is held.
+  std::atomic<int64_t> admittedBytes_{0};
+  // True while the current request is parked waiting for a memory
+  // reservation. Protected by queue's mutex.
+  bool admissionDeferred_{false};
+  // Parameters of the parked request. Protected by queue's mutex.
+  uint32_t deferredMaxBytes_{0};
+  std::chrono::microseconds deferredMaxWait_{0};
+  // Current adaptive byte budget; 0 until seeded by the first data request.
+  // Only accessed on the request/response path, which is serialized by
+  // 'requestPending_'.
+  uint32_t adaptiveMaxBytes_{0};
+  // Upper bound for the adaptive budget: the most recent maxBytes passed by
+  // the exchange client.
+  uint32_t clientMaxBytes_{0};
+  // Response bodies held back for coalescing, chained into a single iobuf,
+  // and the closures settling their memory accounting when the combined page
+  // is destroyed. Protected by queue's mutex.
+  std::unique_ptr<folly::IOBuf> coalesceChain_;
+  int64_t coalesceBytes_{0};
+  std::vector<folly::Function<void()>> coalesceReleases_;
+  // Prefix of a token's payload salvaged from a truncated getData response:
+  // the raw wire bytes, the crc32c state over them and the sequence they
+  // belong to. The retry for the same sequence asks the producer to resend
+  // only the remainder. Protected by queue's mutex.
+  std::unique_ptr<folly::IOBuf> resumePrefix_;
+  int64_t resumePrefixBytes_{0};
+  uint32_t resumePrefixCrc_{0};
+  int64_t resumeSequence_{-1};
+  // Validated prefix staged by prepareResumedFetch() for the response being
+  // processed; processDataResponse() links it ahead of the resent tail.
+  // Protected by queue's mutex.
+  std::unique_ptr<folly::IOBuf> spliceChain_;
+  int64_t spliceBytes_{0};
+  // Exponential moving average of this source's data response sizes; drives
+  // the adaptive coalescing target. Only accessed on the response path,
+  // which is serialized by 'requestPending_'.
+  double responseBytesEwma_{0};
+
+  // Holds the zstd dictionary shipped by the producer of this source's
+  // output buffer; decompresses response bodies tagged with its id.
+  ExchangePageDecompressor zstdDecompressor_;
 
   velox::RuntimeMetric getDataNs_{velox::RuntimeCounter::Unit::kNanos};
   velox::RuntimeMetric getDataSizeNs_{velox::RuntimeCounter::Unit::kNanos};
   velox::RuntimeMetric iobufBytes_{velox::RuntimeCounter::Unit::kBytes};
+  velox::RuntimeMetric adaptiveRequestBytes_{
+      velox::RuntimeCounter::Unit::kBytes};
+  velox::RuntimeMetric remoteRackDelayedRequests_;
+  velox::RuntimeMetric coalescedPageBytes_{velox::RuntimeCounter::Unit::kBytes};
 
   friend class test::PrestoExchangeSourceTestHelper;
 };
@@ -18,20 +18,26 @@
 #include <folly/system/HardwareConcurrency.h>
 #include <glog/logging.h>
 #include <proxygen/lib/http/HTTPHeaders.h>
+#include <unistd.h>
 #include "presto_cpp/main/Announcer.h"
 #include "presto_cpp/main/CoordinatorDiscoverer.h"
 #include "presto_cpp/main/PeriodicMemoryChecker.h"
 #include "presto_cpp/main/PeriodicTaskManager.h"
 #include "presto_cpp/main/SessionProperties.h"
+#include "presto_cpp/main/CrashHandoff.h"
 #include "presto_cpp/main/SignalHandler.h"
 #include "presto_cpp/main/TaskResource.h"
 #include "presto_cpp/main/common/ConfigReader.h"
 #include "presto_cpp/main/common/Counters.h"
+#include "presto_cpp/main/common/HugePageArena.h"
+#include "presto_cpp/main/common/NumaTopology.h"
+#include "presto_cpp/main/common/RequestPoolCache.h"
 #include "presto_cpp/main/common/Utils.h"
 #include "presto_cpp/main/connectors/Registration.h"
 #include "presto_cpp/main/connectors/SystemConnector.h"
 #include "presto_cpp/main/connectors/hive/functions/HiveFunctionRegistration.h"
 #include "presto_cpp/main/functions/FunctionMetadata.h"
+#include "presto_cpp/main/http/HttpClient.h"
 #include "presto_cpp/main/http/HttpConstants.h"
 #include "presto_cpp/main/http/filters/AccessLogFilter.h"
 #include "presto_cpp/main/http/filters/HttpEndpointLatencyFilter.h"
@@ -41,10 +47,14 @@
 #include "presto_cpp/main/operators/BroadcastWrite.h"
 #include "presto_cpp/main/operators/LocalShuffle.h"
 #include "presto_cpp/main/operators/PartitionAndSerialize.h"
+#ifdef PRESTO_ENABLE_RDMA_SHUFFLE
+#include "presto_cpp/main/operators/RdmaShuffle.h"
+#endif
 #include "presto_cpp/main/operators/ShuffleExchangeSource.h"
 #include "presto_cpp/main/operators/ShuffleRead.h"
 #include "presto_cpp/main/operators/ShuffleWrite.h"
 #include "presto_cpp/main/types/ExpressionOptimizer.h"
+#include "presto_cpp/main/types/PrestoTaskId.h"
 #include "presto_cpp/main/types/PrestoToVeloxQueryPlan.h"
 #include "presto_cpp/main/types/VeloxPlanConversion.h"
 #include "velox/common/base/Counters.h"
@@ -106,6 +116,15 @@ constexpr char const* kMacOSSharedLibExt = ".dylib";
 constexpr char const* kOptimized = "OPTIMIZED";
 constexpr char const* kEvaluated = "EVALUATED";
 
+// Capabilities advertised in the announcement. Task execution is ready when
+// the server starts announcing; remote functions become ready when their
+// signatures finish registering, which may be after announcements began.
+constexpr char const* kCapabilityTaskExecution = "task-execution";
+constexpr char const* kCapabilityRemoteFunctions = "remote-functions";
+// Advertised when cuDF registered successfully, i.e. the worker has a usable
+// CUDA device and executes eligible operators on the GPU.
+constexpr char const* kCapabilityGpuAcceleration = "gpu-acceleration";
+
 protocol::NodeState convertNodeState(presto::NodeState nodeState) {
   switch (nodeState) {
     case presto::NodeState::kActive:
@@ -137,6 +156,37 @@ std::string logConnectorConfigPropertyKeys(
   return out.str();
 }
 
+// Reports locally failed tasks so their query's failure can be fanned out to
+// sibling workers. Registered only when task.query-failure-gossip-enabled is
+// set. Aborts triggered by received gossip complete as ABORTED, not FAILED,
+// so they do not re-publish.
+class QueryFailureGossipListener : public velox::exec::TaskListener {
+ public:
+  explicit QueryFailureGossipListener(
+      std::function<void(const std::string& queryId)> onQueryFailure)
+      : onQueryFailure_{std::move(onQueryFailure)} {}
+
+  void onTaskCompletion(
+      const std::string& /*taskUuid*/,
+      const std::string& taskId,
+      velox::exec::TaskState state,
+      std::exception_ptr /*error*/,
+      velox::exec::TaskStats /*stats*/) override {
+    if (state != velox::exec::TaskState::kFailed) {
+      return;
+    }
+    try {
+      onQueryFailure_(PrestoTaskId(taskId).queryId());
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to publish failure of task " << taskId << ": "
+                   << e.what();
+    }
+  }
+
+ private:
+  const std::function<void(const std::string& queryId)> onQueryFailure_;
+};
+
 bool isCacheTtlEnabled() {
   const auto* systemConfig = SystemConfig::instance();
   if (systemConfig->cacheVeloxTtlEnabled()) {
@@ -166,7 +216,8 @@ bool isSharedLibrary(const fs::path& path) {
   return pathExt == kLinuxSharedLibExt || pathExt == kMacOSSharedLibExt;
 }
 
-void registerVeloxCudf() {
+// Returns true when cuDF registered and GPU execution is available.
+bool registerVeloxCudf() {
 #ifdef PRESTO_ENABLE_CUDF
   // Disable by default.
   velox::cudf_velox::CudfConfig::getInstance().enabled = false;
@@ -178,11 +229,23 @@ void registerVeloxCudf() {
     velox::cudf_velox::CudfConfig::getInstance().initialize(
         systemConfig->values());
     if (velox::cudf_velox::CudfConfig::getInstance().enabled) {
-      velox::cudf_velox::registerCudf();
+      try {
+        velox::cudf_velox::registerCudf();
+      } catch (const std::exception& e) {
+        // A cuDF-enabled worker without a usable CUDA device falls back to
+        // CPU execution and does not advertise the GPU capability.
+        velox::cudf_velox::CudfConfig::getInstance().enabled = false;
+        LOG(WARNING) << "cuDF registration failed, falling back to CPU "
+                        "execution: "
+                     << e.what();
+        return false;
+      }
       PRESTO_STARTUP_LOG(INFO) << "cuDF is registered.";
+      return true;
     }
   }
 #endif
+  return false;
 }
 
 void unregisterVeloxCudf() {
@@ -197,6 +260,16 @@ void unregisterVeloxCudf() {
 #endif
 }
 
+// Total bytes of a request body; used as the size hint when leasing a
+// request-scoped memory pool.
+uint64_t bodyBytes(const std::vector<std::unique_ptr<folly::IOBuf>>& body) {
+  uint64_t bytes = 0;
+  for (const auto& buf : body) {
+    bytes += buf->computeChainDataLength();
+  }
+  return bytes;
+}
+
 json::array_t getOptimizedExpressions(
     const proxygen::HTTPHeaders& httpHeaders,
     const std::vector<std::unique_ptr<folly::IOBuf>>& body,
@@ -314,7 +387,8 @@ void PrestoServer::run() {
       sslContext_ = util::createSSLContext(
           optionalClientCertPath.value(),
           ciphers,
-          systemConfig->httpClientHttp2Enabled());
+          systemConfig->httpClientHttp2Enabled(),
+          systemConfig->httpsKtlsEnabled());
     }
 
     if (systemConfig->internalCommunicationJwtEnabled()) {
@@ -338,21 +412,57 @@ void PrestoServer::run() {
     nodeLocation_ = nodeConfig->nodeLocation();
     nodePoolType_ = systemConfig->poolType();
     prestoBuiltinFunctionPrefix_ = systemConfig->prestoDefaultNamespacePrefix();
+
+    if (systemConfig->crashHandoffEnabled()) {
+      // Installed after util::installSignalHandler() in main so the hook
+      // runs first and chains to the stack trace handler.
+      CrashHandoff::instance()->start(
+          systemConfig->crashHandoffFilePath(),
+          systemConfig->crashHandoffNotifyAddress(),
+          nodeId_);
+    }
   } catch (const velox::VeloxUserError& e) {
     PRESTO_STARTUP_LOG(ERROR) << "Failed to start server due to " << e.what();
     exit(EXIT_FAILURE);
   }
 
-  registerFileSystems();
-  registerFileSinks();
-  registerFileReadersAndWriters();
+  // Independent registration phases populate distinct global registries, so
+  // they can overlap with each other and with memory and thread pool
+  // initialization below. A phase that consults another phase's
+  // registrations joins its future first.
+  const bool parallelStartup =
+      systemConfig->startupParallelRegistrationEnabled();
+  folly::SemiFuture<folly::Unit> fileRegistrationFuture =
+      folly::makeSemiFuture();
+  folly::SemiFuture<folly::Unit> serdeRegistrationFuture =
+      folly::makeSemiFuture();
+  if (parallelStartup) {
+    startupExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        2, std::make_shared<folly::NamedThreadFactory>("Startup"));
+    fileRegistrationFuture = folly::via(startupExecutor_.get(), [this]() {
+                               registerFileSystems();
+                               registerFileSinks();
+                               registerFileReadersAndWriters();
+                             }).semi();
+    serdeRegistrationFuture = folly::via(startupExecutor_.get(), [this]() {
+                                registerVectorSerdes();
+                                registerPrestoPlanNodeSerDe();
+                                registerTraceNodeFactories();
+                              }).semi();
+  } else {
+    registerFileSystems();
+    registerFileSinks();
+    registerFileReadersAndWriters();
+  }
   registerMemoryArbitrators();
   registerShuffleInterfaceFactories();
   registerCustomOperators();
 
   // We need to register cuDF before the connectors so that the cuDF connector
   // factories can be used.
-  registerVeloxCudf();
+  if (registerVeloxCudf()) {
+    addCapability(kCapabilityGpuAcceleration);
+  }
 
   // Register Presto connector factories and connectors
   registerConnectors();
@@ -360,6 +470,9 @@ void PrestoServer::run() {
   initializeVeloxMemory();
   initializeThreadPools();
 
+  // Connector initialization may consult the filesystem and file format
+  // registries, so the file registration phase must have landed.
+  std::move(fileRegistrationFuture).get();
   auto catalogNames = registerVeloxConnectors(fs::path(configDirectoryPath_));
 
   const bool bindToNodeInternalAddressOnly =
@@ -405,8 +518,31 @@ void PrestoServer::run() {
         clientCaFile);
   }
 
+  std::unique_ptr<http::HttpConfig> httpUdsConfig;
+  const auto udsPath = systemConfig->httpServerUnixDomainSocketPath();
+  if (!udsPath.empty()) {
+    // Remove the socket file a previous run may have left behind; bind()
+    // fails on an existing path.
+    ::unlink(udsPath.c_str());
+    folly::SocketAddress udsAddress;
+    udsAddress.setFromPath(udsPath);
+    httpUdsConfig = std::make_unique<http::HttpConfig>(udsAddress);
+    PRESTO_STARTUP_LOG(INFO)
+        << "Listening on unix domain socket " << udsPath
+        << " for same-host internal traffic";
+  }
+
   httpServer_ = std::make_unique<http::HttpServer>(
-      httpSrvIoExecutor_, std::move(httpConfig), std::move(httpsConfig));
+      httpSrvIoExecutor_,
+      std::move(httpConfig),
+      std::move(httpsConfig),
+      std::move(httpUdsConfig));
+  // Data fetch traffic is shed before status and task update endpoints when
+  // the worker falls behind, so a getResults storm cannot make the
+  // coordinator mark the worker dead.
+  httpServer_->setMaxConcurrentRequests(
+      http::EndpointPriority::kData,
+      systemConfig->httpServerMaxConcurrentDataRequests());
 
   httpServer_->registerPost(
       "/v1/memory",
@@ -415,7 +551,8 @@ void PrestoServer::run() {
           const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
           proxygen::ResponseHandler* downstream) {
         server->reportMemoryInfo(downstream);
-      });
+      },
+      http::EndpointPriority::kCritical);
   httpServer_->registerGet(
       "/v1/info",
       [server = this](
@@ -423,7 +560,8 @@ void PrestoServer::run() {
           const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
           proxygen::ResponseHandler* downstream) {
         server->reportServerInfo(downstream);
-      });
+      },
+      http::EndpointPriority::kCritical);
   httpServer_->registerGet(
       "/v1/info/state",
       [server = this](
@@ -432,7 +570,8 @@ void PrestoServer::run() {
           proxygen::ResponseHandler* downstream) {
         json infoStateJson = convertNodeState(server->nodeState());
         http::sendOkResponse(downstream, infoStateJson);
-      });
+      },
+      http::EndpointPriority::kCritical);
   httpServer_->registerGet(
       "/v1/info/stats",
       [server = this](
@@ -440,7 +579,8 @@ void PrestoServer::run() {
           const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
           proxygen::ResponseHandler* downstream) {
         server->reportNodeStats(downstream);
-      });
+      },
+      http::EndpointPriority::kCritical);
   httpServer_->registerPut(
       "/v1/info/state",
       [server = this](
@@ -448,7 +588,8 @@ void PrestoServer::run() {
           const std::vector<std::unique_ptr<folly::IOBuf>>& body,
           proxygen::ResponseHandler* downstream) {
         server->handleGracefulShutdown(body, downstream);
-      });
+      },
+      http::EndpointPriority::kCritical);
   httpServer_->registerGet(
       "/v1/status",
       [server = this](
@@ -456,7 +597,8 @@ void PrestoServer::run() {
           const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
           proxygen::ResponseHandler* downstream) {
         server->reportNodeStatus(downstream);
-      });
+      },
+      http::EndpointPriority::kCritical);
   httpServer_->registerHead(
       "/v1/status",
       [](proxygen::HTTPMessage* /*message*/,
@@ -468,7 +610,8 @@ void PrestoServer::run() {
                 proxygen::HTTP_HEADER_CONTENT_TYPE,
                 http::kMimeTypeApplicationJson)
             .sendWithEOM();
-      });
+      },
+      http::EndpointPriority::kCritical);
 
   if (systemConfig->enableRuntimeMetricsCollection()) {
     enableWorkerStatsReporting();
@@ -496,11 +639,41 @@ void PrestoServer::run() {
     }
   }
   registerFunctions();
-  registerRemoteFunctions();
-  registerVectorSerdes();
-  registerPrestoPlanNodeSerDe();
-  registerTraceNodeFactories();
+  if (parallelStartup) {
+    std::move(serdeRegistrationFuture).get();
+  } else {
+    registerVectorSerdes();
+    registerPrestoPlanNodeSerDe();
+    registerTraceNodeFactories();
+  }
   registerDynamicFunctions();
+  capabilities_.wlock()->push_back(kCapabilityTaskExecution);
+
+  // Remote function registration fetches and parses signature files, which
+  // can dominate cold start. With parallel startup it runs detached so the
+  // worker can announce and accept queries that don't need remote functions
+  // while signatures load; the capability is advertised when they are ready.
+#ifdef PRESTO_ENABLE_REMOTE_FUNCTIONS
+  const bool hasRemoteFunctions =
+      systemConfig->remoteFunctionServerSignatureFilesDirectoryPath()
+          .has_value();
+#else
+  const bool hasRemoteFunctions = false;
+#endif
+  if (hasRemoteFunctions) {
+    if (parallelStartup) {
+      folly::via(startupExecutor_.get(), [this]() {
+        registerRemoteFunctions();
+        addCapability(kCapabilityRemoteFunctions);
+      }).thenError(
+          folly::tag_t<std::exception>{}, [](const std::exception& e) {
+            LOG(ERROR) << "Remote function registration failed: " << e.what();
+          });
+    } else {
+      registerRemoteFunctions();
+      addCapability(kCapabilityRemoteFunctions);
+    }
+  }
 
   facebook::velox::exec::ExchangeSource::registerFactory(
       [this](
@@ -540,6 +713,59 @@ void PrestoServer::run() {
   taskManager_->setNodeId(nodeId_);
   taskManager_->setOldTaskCleanUpMs(systemConfig->oldTaskCleanUpMs());
 
+  const uint32_t exchangeWarmupConnections =
+      systemConfig->exchangeConnectionPoolWarmupPerPeer();
+  if (exchangeSourceConnectionPool_ != nullptr &&
+      exchangeWarmupConnections > 0) {
+    const auto exchangeConnectTimeout =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            systemConfig->exchangeConnectTimeoutMs());
+    taskManager_->setRemoteSourceWarmupCallback(
+        [this, exchangeWarmupConnections, exchangeConnectTimeout](
+            const std::string& location) {
+          try {
+            folly::Uri uri(location);
+            const bool useHttps = (uri.scheme() == "https");
+            if (useHttps && sslContext_ == nullptr) {
+              return;
+            }
+            folly::SocketAddress address;
+            if (folly::IPAddress::validate(uri.host())) {
+              address =
+                  folly::SocketAddress(folly::IPAddress(uri.host()), uri.port());
+            } else {
+              address = folly::SocketAddress(uri.host(), uri.port(), true);
+            }
+            exchangeSourceConnectionPool_->warmUp(
+                proxygen::Endpoint(uri.host(), uri.port(), useHttps),
+                address,
+                useHttps ? sslContext_ : nullptr,
+                exchangeConnectTimeout,
+                exchangeWarmupConnections,
+                exchangeHttpIoExecutor_.get());
+          } catch (const std::exception& e) {
+            LOG(WARNING) << "Failed to warm up exchange connections to "
+                         << location << ": " << e.what();
+          }
+        });
+  }
+
+  if (systemConfig->taskQueryFailureGossipEnabled()) {
+    taskManager_->setQueryFailureGossipCallback(
+        [this](
+            const std::string& queryId,
+            const std::vector<std::string>& remoteSourceLocations) {
+          for (const auto& location : remoteSourceLocations) {
+            sendQueryFailureNotification(queryId, location);
+          }
+        });
+    velox::exec::registerTaskListener(
+        std::make_shared<QueryFailureGossipListener>(
+            [this](const std::string& queryId) {
+              taskManager_->publishQueryFailure(queryId);
+            }));
+  }
+
   auto baseSpillDirectory = getBaseSpillDirectory();
   if (!baseSpillDirectory.empty()) {
     taskManager_->setBaseSpillDirectory(baseSpillDirectory);
@@ -551,6 +777,7 @@ void PrestoServer::run() {
   taskResource_ = std::make_unique<TaskResource>(
       pool_.get(),
       httpSrvCpuExecutor_.get(),
+      httpSrvSerializationExecutor_.get(),
       getVeloxPlanValidator(),
       *taskManager_);
   taskResource_->registerUris(*httpServer_);
@@ -587,9 +814,16 @@ void PrestoServer::run() {
         prestoServerOperations_->runOperation(message, downstream);
       });
 
-  PRESTO_STARTUP_LOG(INFO) << "Driver CPU executor '"
-                           << driverCpuExecutor_->getName() << "' has "
-                           << driverCpuExecutor_->numThreads() << " threads.";
+  if (driverCpuExecutor_ != nullptr) {
+    PRESTO_STARTUP_LOG(INFO)
+        << "Driver CPU executor '" << driverCpuExecutor_->getName() << "' has "
+        << driverCpuExecutor_->numThreads() << " threads.";
+  } else {
+    PRESTO_STARTUP_LOG(INFO)
+        << "Driver soft-affinity executor '"
+        << driverSoftAffinityExecutor_->getName() << "' has "
+        << driverSoftAffinityExecutor_->numThreads() << " threads.";
+  }
   if (httpServer_->getExecutor()) {
     PRESTO_STARTUP_LOG(INFO)
         << "HTTP Server IO executor '" << httpServer_->getExecutor()->getName()
@@ -663,9 +897,15 @@ void PrestoServer::run() {
           nodePoolType_,
           systemConfig->prestoNativeSidecar(),
           catalogNames,
+          systemConfig->announcementDeltaEnabled(),
           systemConfig->announcementMaxFrequencyMs(),
           sslContext_);
       updateAnnouncerDetails();
+      // Under the capabilities lock so a startup phase finishing right now
+      // cannot race the initial capability push.
+      capabilities_.withRLock([&](const auto& capabilities) {
+        announcer_->setCapabilities(capabilities);
+      });
       announcer_->start();
 
       uint64_t heartbeatFrequencyMs = systemConfig->heartbeatFrequencyMs();
@@ -676,6 +916,8 @@ void PrestoServer::run() {
             coordinatorDiscoverer_,
             sslContext_,
             [server = this]() { return server->fetchNodeStatus(); },
+            systemConfig->heartbeatStatsDeltaEnabled(),
+            systemConfig->heartbeatStatsMaxAgeMs(),
             heartbeatFrequencyMs);
         heartbeatManager_->start();
       }
@@ -734,6 +976,14 @@ void PrestoServer::run() {
   periodicTaskManager_->stop();
   stopAdditionalPeriodicTasks();
 
+  if (startupExecutor_ != nullptr) {
+    // Joins any still-running detached startup phase (e.g. remote function
+    // registration against an unreachable server).
+    PRESTO_SHUTDOWN_LOG(INFO) << "Joining startup executor";
+    startupExecutor_->join();
+    startupExecutor_.reset();
+  }
+
   // Destroy entities here to ensure we won't get any messages after Server
   // object is gone and to have nice log in case shutdown gets stuck.
   PRESTO_SHUTDOWN_LOG(INFO) << "Destroying Task Resource";
@@ -748,11 +998,21 @@ void PrestoServer::run() {
   unregisterConnectors();
   unregisterVeloxCudf();
 
-  PRESTO_SHUTDOWN_LOG(INFO)
-      << "Joining Driver CPU Executor '" << driverCpuExecutor_->getName()
-      << "': threads: " << driverCpuExecutor_->numActiveThreads() << "/"
-      << driverCpuExecutor_->numThreads()
-      << ", task queue: " << driverCpuExecutor_->getTaskQueueSize();
+  if (driverCpuExecutor_ != nullptr) {
+    PRESTO_SHUTDOWN_LOG(INFO)
+        << "Joining Driver CPU Executor '" << driverCpuExecutor_->getName()
+        << "': threads: " << driverCpuExecutor_->numActiveThreads() << "/"
+        << driverCpuExecutor_->numThreads()
+        << ", task queue: " << driverCpuExecutor_->getTaskQueueSize();
+  } else {
+    PRESTO_SHUTDOWN_LOG(INFO)
+        << "Joining Driver Soft-Affinity Executor '"
+        << driverSoftAffinityExecutor_->getName()
+        << "': threads: " << driverSoftAffinityExecutor_->numActiveThreads()
+        << "/" << driverSoftAffinityExecutor_->numThreads()
+        << ", task queue: " << driverSoftAffinityExecutor_->getTaskQueueSize()
+        << ", migrations: " << driverSoftAffinityExecutor_->numMigrations();
+  }
   // Schedule release of SessionPools held by HttpClients before the exchange
   // HTTP IO executor threads are joined.
   driverExecutor_.reset();
@@ -783,6 +1043,15 @@ void PrestoServer::run() {
         << ", task queue: " << httpSrvCpuExecutor_->getTaskQueueSize();
     httpSrvCpuExecutor_->join();
   }
+  if (httpSrvSerializationExecutor_ != nullptr) {
+    PRESTO_SHUTDOWN_LOG(INFO)
+        << "Joining HTTP Server Serialization Executor '"
+        << httpSrvSerializationExecutor_->getName()
+        << "': threads: " << httpSrvSerializationExecutor_->numActiveThreads()
+        << "/" << httpSrvSerializationExecutor_->numThreads() << ", task queue: "
+        << httpSrvSerializationExecutor_->getTaskQueueSize();
+    httpSrvSerializationExecutor_->join();
+  }
   if (httpSrvIoExecutor_ != nullptr) {
     PRESTO_SHUTDOWN_LOG(INFO)
         << "Joining HTTP Server IO Executor '" << httpSrvIoExecutor_->getName()
@@ -848,7 +1117,9 @@ void PrestoServer::yieldTasks() {
     return;
   }
   static std::atomic<int32_t> numYields = 0;
-  const auto numQueued = driverCpuExecutor_->getTaskQueueSize();
+  const auto numQueued = driverCpuExecutor_ != nullptr
+      ? driverCpuExecutor_->getTaskQueueSize()
+      : driverSoftAffinityExecutor_->getTaskQueueSize();
   if (numQueued > 0) {
     numYields += taskManager_->yieldTasks(numQueued, timeslice);
   }
@@ -858,6 +1129,62 @@ void PrestoServer::yieldTasks() {
   }
 }
 
+void PrestoServer::sendQueryFailureNotification(
+    const std::string& queryId,
+    const std::string& location) {
+  try {
+    folly::Uri uri(location);
+    const bool useHttps = (uri.scheme() == "https");
+    if (useHttps && sslContext_ == nullptr) {
+      return;
+    }
+    folly::SocketAddress address;
+    if (folly::IPAddress::validate(uri.host())) {
+      address = folly::SocketAddress(folly::IPAddress(uri.host()), uri.port());
+    } else {
+      address = folly::SocketAddress(uri.host(), uri.port(), true);
+    }
+    auto* eventBase = exchangeHttpIoExecutor_->getEventBase();
+    auto client = std::make_shared<http::HttpClient>(
+        eventBase,
+        exchangeSourceConnectionPool_.get(),
+        proxygen::Endpoint(uri.host(), uri.port(), useHttps),
+        address,
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            SystemConfig::instance()->exchangeRequestTimeoutMs()),
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            SystemConfig::instance()->exchangeConnectTimeoutMs()),
+        nullptr,
+        useHttps ? sslContext_ : nullptr);
+
+    proxygen::HTTPMessage request;
+    request.setMethod(proxygen::HTTPMethod::POST);
+    request.setURL(fmt::format("/v1/queryFailure/{}", queryId));
+    request.getHeaders().set(
+        proxygen::HTTPHeaderCode::HTTP_HEADER_HOST,
+        fmt::format("{}:{}", uri.host(), uri.port()));
+    request.getHeaders().set(
+        proxygen::HTTPHeaderCode::HTTP_HEADER_CONTENT_LENGTH, "0");
+
+    // Capture 'client' in the continuation so it is destroyed on its event
+    // base thread. Delivery is best effort: the coordinator's deletes remain
+    // the authoritative cleanup path.
+    client->sendRequest(request)
+        .via(eventBase)
+        .thenTry([client, queryId, location](
+                     folly::Try<std::unique_ptr<http::HttpResponse>> response) {
+          if (response.hasException()) {
+            LOG(WARNING) << "Failed to notify " << location
+                         << " of failure of query " << queryId << ": "
+                         << response.exception().what();
+          }
+        });
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to notify " << location << " of failure of query "
+                 << queryId << ": " << e.what();
+  }
+}
+
 #ifdef __linux__
 class BatchThreadFactory : public folly::NamedThreadFactory {
  public:
@@ -877,6 +1204,36 @@ class BatchThreadFactory : public folly::NamedThreadFactory {
     });
   }
 };
+
+// Wraps another thread factory and binds each thread it creates to a NUMA
+// node. Threads rotate through 'nodes', so passing all nodes partitions a
+// CPU pool across the sockets while a single node pins the whole pool.
+class NumaBindingThreadFactory : public folly::ThreadFactory {
+ public:
+  NumaBindingThreadFactory(
+      std::shared_ptr<folly::ThreadFactory> delegate,
+      std::vector<NumaNode> nodes)
+      : delegate_{std::move(delegate)}, nodes_{std::move(nodes)} {
+    VELOX_CHECK(!nodes_.empty());
+  }
+
+  std::thread newThread(folly::Func&& func) override {
+    const auto& node = nodes_[nextNode_++ % nodes_.size()];
+    return delegate_->newThread([node, _func = std::move(func)]() mutable {
+      bindCurrentThreadToNumaNode(node);
+      _func();
+    });
+  }
+
+  const std::string& getNamePrefix() const override {
+    return delegate_->getNamePrefix();
+  }
+
+ private:
+  const std::shared_ptr<folly::ThreadFactory> delegate_;
+  const std::vector<NumaNode> nodes_;
+  std::atomic<uint32_t> nextNode_{0};
+};
 #endif
 
 void PrestoServer::initializeThreadPools() {
@@ -897,21 +1254,98 @@ void PrestoServer::initializeThreadPools() {
     threadFactory = std::make_shared<folly::NamedThreadFactory>("Driver");
   }
 
-  driverExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
-      numDriverCpuThreads, threadFactory);
-  driverCpuExecutor_ = velox::checkedPointerCast<folly::CPUThreadPoolExecutor>(
-      driverExecutor_.get());
+  std::shared_ptr<folly::ThreadFactory> driverThreadFactory = threadFactory;
+#ifdef __linux__
+  if (systemConfig->driverNumaBindingEnabled()) {
+    auto nodes = numaNodes();
+    if (nodes.size() > 1) {
+      PRESTO_STARTUP_LOG(INFO)
+          << "Partitioning " << numDriverCpuThreads
+          << " driver threads across " << nodes.size() << " NUMA nodes.";
+      driverThreadFactory = std::make_shared<NumaBindingThreadFactory>(
+          driverThreadFactory, std::move(nodes));
+    } else {
+      PRESTO_STARTUP_LOG(INFO)
+          << "Driver NUMA binding is enabled but the host does not expose "
+          << "multiple NUMA nodes; leaving driver threads unbound.";
+    }
+  }
+#endif
+
+  if (systemConfig->driverSoftAffinityEnabled()) {
+    VELOX_CHECK(
+        !systemConfig->driverElasticScalingEnabled(),
+        "Driver soft affinity and driver elastic scaling are mutually "
+        "exclusive");
+    auto softAffinityExecutor = std::make_unique<SoftAffinityExecutor>(
+        numDriverCpuThreads, driverThreadFactory, "Driver");
+    driverSoftAffinityExecutor_ = softAffinityExecutor.get();
+    driverExecutor_ = std::move(softAffinityExecutor);
+    driverCpuExecutor_ = nullptr;
+  } else {
+    driverExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        numDriverCpuThreads, driverThreadFactory);
+    driverCpuExecutor_ =
+        velox::checkedPointerCast<folly::CPUThreadPoolExecutor>(
+            driverExecutor_.get());
+  }
+
+  // IO threads move network payloads; when a binding interface is configured
+  // they are pinned to the NIC's NUMA node so receive buffers stay local.
+  std::vector<NumaNode> nicNodes;
+#ifdef __linux__
+  const auto bindingInterface = systemConfig->numaBindingInterface();
+  if (!bindingInterface.empty()) {
+    const auto nicNodeId = numaNodeOfNetworkInterface(bindingInterface);
+    for (auto& node : numaNodes()) {
+      if (node.id == nicNodeId) {
+        nicNodes.push_back(std::move(node));
+      }
+    }
+    if (nicNodes.empty()) {
+      PRESTO_STARTUP_LOG(WARNING)
+          << "Could not determine the NUMA node of interface '"
+          << bindingInterface << "'; leaving IO threads unbound.";
+    } else {
+      PRESTO_STARTUP_LOG(INFO)
+          << "Pinning HTTP and exchange IO threads to NUMA node "
+          << nicNodes.front().id << " local to interface '" << bindingInterface
+          << "'.";
+    }
+  }
+#endif
+  const auto makeIoThreadFactory = [&nicNodes](const std::string& name)
+      -> std::shared_ptr<folly::ThreadFactory> {
+    auto factory = std::make_shared<folly::NamedThreadFactory>(name);
+#ifdef __linux__
+    if (!nicNodes.empty()) {
+      return std::make_shared<NumaBindingThreadFactory>(
+          std::move(factory), nicNodes);
+    }
+#endif
+    return factory;
+  };
 
   const auto numIoThreads = std::max<size_t>(
       systemConfig->httpServerNumIoThreadsHwMultiplier() * hwConcurrency, 1);
   httpSrvIoExecutor_ = std::make_shared<folly::IOThreadPoolExecutor>(
-      numIoThreads, std::make_shared<folly::NamedThreadFactory>("HTTPSrvIO"));
+      numIoThreads, makeIoThreadFactory("HTTPSrvIO"));
 
   const auto numCpuThreads = std::max<size_t>(
       systemConfig->httpServerNumCpuThreadsHwMultiplier() * hwConcurrency, 1);
   httpSrvCpuExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
       numCpuThreads, std::make_shared<folly::NamedThreadFactory>("HTTPSrvCpu"));
 
+  const auto numSerializationThreads = static_cast<size_t>(
+      systemConfig->httpServerNumSerializationThreadsHwMultiplier() *
+      hwConcurrency);
+  if (numSerializationThreads > 0) {
+    httpSrvSerializationExecutor_ =
+        std::make_unique<folly::CPUThreadPoolExecutor>(
+            numSerializationThreads,
+            std::make_shared<folly::NamedThreadFactory>("HTTPSrvSer"));
+  }
+
   const auto numSpillerCpuThreads = std::max<size_t>(
       systemConfig->spillerNumCpuThreadsHwMultiplier() * hwConcurrency, 0);
   if (numSpillerCpuThreads > 0) {
@@ -921,14 +1355,18 @@ void PrestoServer::initializeThreadPools() {
     spillerCpuExecutor_ =
         velox::checkedPointerCast<folly::CPUThreadPoolExecutor>(
             spillerExecutor_.get());
+    // The spiller executor also runs background local shuffle file
+    // compaction; the shuffle factory is registered before the thread pools
+    // exist, so the executor is handed over here.
+    operators::LocalPersistentShuffleFactory::setCompactionExecutor(
+        spillerExecutor_.get());
   }
   const auto numExchangeHttpClientIoThreads = std::max<size_t>(
       systemConfig->exchangeHttpClientNumIoThreadsHwMultiplier() *
           folly::hardware_concurrency(),
       1);
   exchangeHttpIoExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
-      numExchangeHttpClientIoThreads,
-      std::make_shared<folly::NamedThreadFactory>("ExchangeIO"));
+      numExchangeHttpClientIoThreads, makeIoThreadFactory("ExchangeIO"));
 
   PRESTO_STARTUP_LOG(INFO) << "Exchange Http IO executor '"
                            << exchangeHttpIoExecutor_->getName() << "' has "
@@ -961,6 +1399,23 @@ void PrestoServer::initializeThreadPools() {
     exchangeSourceConnectionPool_ =
         std::make_unique<http::HttpClientConnectionPool>();
   }
+
+  // Fault in the exchange huge page arena at startup so mapping failures
+  // surface in the startup log rather than on the first exchange request.
+  if (systemConfig->exchangeHugePageArenaBytes() > 0) {
+    if (auto* arena = HugePageArena::instance(); arena != nullptr) {
+      PRESTO_STARTUP_LOG(INFO)
+          << "Exchange huge page arena of " << arena->stats().capacityBytes
+          << " bytes backed by "
+          << (arena->backedByHugePages()
+                  ? "explicit 2MB pages"
+                  : "a transparent-hugepage-advised mapping");
+    } else {
+      PRESTO_STARTUP_LOG(WARNING)
+          << "Exchange huge page arena could not be mapped; exchange "
+             "buffers fall back to the memory pool";
+    }
+  }
 }
 
 std::unique_ptr<velox::cache::SsdCache> PrestoServer::setupSsdCache() {
@@ -1143,7 +1598,9 @@ size_t PrestoServer::numDriverThreads() const {
   VELOX_CHECK(
       driverExecutor_ != nullptr,
       "Driver executor is expected to be not null, but it is null!");
-  return driverCpuExecutor_->numThreads();
+  return driverCpuExecutor_ != nullptr
+      ? driverCpuExecutor_->numThreads()
+      : driverSoftAffinityExecutor_->numThreads();
 }
 
 void PrestoServer::detachWorker() {
@@ -1189,6 +1646,15 @@ void PrestoServer::updateAnnouncerDetails() {
   }
 }
 
+void PrestoServer::addCapability(const std::string& capability) {
+  capabilities_.withWLock([&](auto& capabilities) {
+    capabilities.push_back(capability);
+    if (announcer_ != nullptr) {
+      announcer_->setCapabilities(capabilities);
+    }
+  });
+}
+
 void PrestoServer::addServerPeriodicTasks() {
   periodicTaskManager_->addTask(
       [server = this]() { server->populateMemAndCPUInfo(); },
@@ -1417,6 +1883,11 @@ void PrestoServer::registerShuffleInterfaceFactories() {
   operators::ShuffleInterfaceFactory::registerFactory(
       operators::LocalPersistentShuffleFactory::kShuffleName.toString(),
       std::make_unique<operators::LocalPersistentShuffleFactory>());
+#ifdef PRESTO_ENABLE_RDMA_SHUFFLE
+  operators::ShuffleInterfaceFactory::registerFactory(
+      operators::RdmaShuffleFactory::kShuffleName.toString(),
+      std::make_unique<operators::RdmaShuffleFactory>());
+#endif
 }
 
 void PrestoServer::registerCustomOperators() {
@@ -1767,6 +2238,25 @@ void PrestoServer::handleGracefulShutdown(
   }
 }
 
+namespace {
+// Serves a /v1/functions response from the metadata cache, answering
+// conditional requests with 304 Not Modified when the client's cached copy
+// is still current.
+void sendFunctionsMetadataResponse(
+    proxygen::HTTPMessage* message,
+    const std::optional<std::string>& catalog,
+    proxygen::ResponseHandler* downstream) {
+  const auto response = getFunctionsMetadataCached(catalog);
+  const auto ifNoneMatch = message->getHeaders().getSingleOrEmpty(
+      proxygen::HTTP_HEADER_IF_NONE_MATCH);
+  if (!ifNoneMatch.empty() && ifNoneMatch == response.etag) {
+    http::sendNotModifiedResponse(downstream, response.etag);
+    return;
+  }
+  http::sendOkResponse(downstream, response.body, "ETag", response.etag);
+}
+} // namespace
+
 void PrestoServer::registerSidecarEndpoints() {
   VELOX_CHECK(httpServer_);
   httpServer_->registerGet(
@@ -1780,10 +2270,10 @@ void PrestoServer::registerSidecarEndpoints() {
       });
   httpServer_->registerGet(
       "/v1/functions",
-      [](proxygen::HTTPMessage* /*message*/,
+      [](proxygen::HTTPMessage* message,
          const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
          proxygen::ResponseHandler* downstream) {
-        http::sendOkResponse(downstream, getFunctionsMetadata());
+        sendFunctionsMetadataResponse(message, std::nullopt, downstream);
       });
   httpServer_->registerGet(
       R"(/v1/functions/([^/]+))",
@@ -1791,10 +2281,10 @@ void PrestoServer::registerSidecarEndpoints() {
          const std::vector<std::string>& pathMatch) {
         return new http::CallbackRequestHandler(
             [catalog = pathMatch[1]](
-                proxygen::HTTPMessage* /*message*/,
+                proxygen::HTTPMessage* message,
                 std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
                 proxygen::ResponseHandler* downstream) {
-              http::sendOkResponse(downstream, getFunctionsMetadata(catalog));
+              sendFunctionsMetadataResponse(message, catalog, downstream);
             });
       });
   httpServer_->registerPost(
@@ -1804,8 +2294,13 @@ void PrestoServer::registerSidecarEndpoints() {
           const std::vector<std::unique_ptr<folly::IOBuf>>& body,
           proxygen::ResponseHandler* downstream) {
         const auto& httpHeaders = message->getHeaders();
+        // Scratch vectors made while optimizing live only for this request;
+        // they come from a leased request pool that is recycled whole rather
+        // than from the shared worker pool.
+        const auto poolLease =
+            RequestPoolCache::instance()->lease(bodyBytes(body));
         const auto result = getOptimizedExpressions(
-            httpHeaders, body, driverExecutor_.get(), nativeWorkerPool_.get());
+            httpHeaders, body, driverExecutor_.get(), poolLease.pool());
         http::sendOkResponse(downstream, result);
       });
 
@@ -1816,9 +2311,11 @@ void PrestoServer::registerSidecarEndpoints() {
           const std::vector<std::unique_ptr<folly::IOBuf>>& body,
           proxygen::ResponseHandler* downstream) {
         std::string planFragmentJson = util::extractMessageBody(body);
+        const auto poolLease =
+            RequestPoolCache::instance()->lease(planFragmentJson.size());
         protocol::PlanConversionResponse response = prestoToVeloxPlanConversion(
             planFragmentJson,
-            server->nativeWorkerPool_.get(),
+            poolLease.pool(),
             server->getVeloxPlanValidator());
         if (response.failures.empty()) {
           http::sendOkResponse(downstream, json(response));
@@ -1866,22 +2363,53 @@ void PrestoServer::registerDynamicFunctions() {
     pluginDir = systemConfig->pluginDir();
   }
   // If it is a valid directory, traverse and call dynamic function loader.
-  if (fs::is_directory(pluginDir, ec)) {
-    PRESTO_STARTUP_LOG(INFO)
-        << "Loading dynamic libraries from directory path: " << pluginDir;
-    for (const auto& dirEntry :
-         std::filesystem::directory_iterator(pluginDir)) {
-      if (isSharedLibrary(dirEntry.path())) {
-        PRESTO_STARTUP_LOG(INFO)
-            << "Loading dynamic libraries from: " << dirEntry.path().string();
-        velox::loadDynamicLibrary(dirEntry.path().c_str());
-      }
-    }
-  } else {
+  if (!fs::is_directory(pluginDir, ec)) {
     PRESTO_STARTUP_LOG(INFO)
         << "Plugin directory path: " << pluginDir << " is invalid.";
     return;
   }
+
+  PRESTO_STARTUP_LOG(INFO)
+      << "Loading dynamic libraries from directory path: " << pluginDir;
+  std::vector<fs::path> libraries;
+  for (const auto& dirEntry : std::filesystem::directory_iterator(pluginDir)) {
+    if (isSharedLibrary(dirEntry.path())) {
+      libraries.push_back(dirEntry.path());
+    }
+  }
+
+  const auto parallelism = std::min<size_t>(
+      std::max<int32_t>(1, systemConfig->pluginLoadParallelism()),
+      libraries.size());
+  if (parallelism <= 1) {
+    for (const auto& library : libraries) {
+      PRESTO_STARTUP_LOG(INFO)
+          << "Loading dynamic libraries from: " << library.string();
+      velox::loadDynamicLibrary(library.c_str());
+    }
+    return;
+  }
+
+  // Load libraries concurrently on a startup-only pool; each library's
+  // functions register from the thread that loaded it. The velox function
+  // registries are thread safe, so this is safe for libraries that only
+  // register functions from their entry point.
+  folly::CPUThreadPoolExecutor loadExecutor(
+      parallelism, std::make_shared<folly::NamedThreadFactory>("PluginLoad"));
+  std::vector<folly::Future<folly::Unit>> loadFutures;
+  loadFutures.reserve(libraries.size());
+  for (const auto& library : libraries) {
+    loadFutures.push_back(folly::via(&loadExecutor, [library]() {
+      PRESTO_STARTUP_LOG(INFO)
+          << "Loading dynamic libraries from: " << library.string();
+      velox::loadDynamicLibrary(library.c_str());
+    }));
+  }
+  auto loadResults = folly::collectAll(std::move(loadFutures)).get();
+  for (auto& result : loadResults) {
+    // Surface the first load failure the same way the serial path would.
+    result.throwUnlessValue();
+  }
 }
 
 void PrestoServer::createTaskManager() {
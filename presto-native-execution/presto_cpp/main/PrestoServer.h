@@ -25,6 +25,7 @@
 #include "presto_cpp/main/PeriodicHeartbeatManager.h"
 #include "presto_cpp/main/PrestoExchangeSource.h"
 #include "presto_cpp/main/PrestoServerOperations.h"
+#include "presto_cpp/main/common/SoftAffinityExecutor.h"
 #include "presto_cpp/main/types/VeloxPlanValidator.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/MemoryAllocator.h"
@@ -202,6 +203,11 @@ class PrestoServer {
 
   void updateAnnouncerDetails();
 
+  /// Appends 'capability' to the advertised capability list and pushes the
+  /// updated list to the announcer once it exists. Invoked from startup
+  /// phases that finish after announcements began.
+  void addCapability(const std::string& capability);
+
   void addServerPeriodicTasks();
 
   void reportMemoryInfo(proxygen::ResponseHandler* downstream);
@@ -223,6 +229,13 @@ class PrestoServer {
   // Periodically yield tasks if there are tasks queued.
   void yieldTasks();
 
+  // Posts a best-effort query failure notification to the sibling worker at
+  // 'location' so it can abort the query's tasks ahead of the coordinator's
+  // deletes. Only used when 'task.query-failure-gossip-enabled' is set.
+  void sendQueryFailureNotification(
+      const std::string& queryId,
+      const std::string& location);
+
   void registerSystemConnector();
 
   void registerSidecarEndpoints();
@@ -257,6 +270,9 @@ class PrestoServer {
 
   // Executor for HTTP request processing after dispatching
   std::unique_ptr<folly::CPUThreadPoolExecutor> httpSrvCpuExecutor_;
+  // Optional executor for JSON encoding of large task responses; see
+  // 'http-server.num-serialization-threads-hw-multiplier'.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> httpSrvSerializationExecutor_;
 
   // Executor for query engine driver executions. The underlying thread pool
   // executor is a folly::CPUThreadPoolExecutor. The executor is stored as
@@ -265,8 +281,13 @@ class PrestoServer {
   // 'driverCpuExecutor()' method.
   std::unique_ptr<folly::Executor> driverExecutor_;
   // Raw pointer pointing to the underlying folly::CPUThreadPoolExecutor of
-  // 'driverExecutor_'.
+  // 'driverExecutor_'. Null when 'driver.soft-affinity-enabled' is set; in
+  // that case 'driverSoftAffinityExecutor_' points to the underlying
+  // executor instead.
   folly::CPUThreadPoolExecutor* driverCpuExecutor_;
+  // Raw pointer pointing to the underlying SoftAffinityExecutor of
+  // 'driverExecutor_' when 'driver.soft-affinity-enabled' is set, else null.
+  SoftAffinityExecutor* driverSoftAffinityExecutor_{nullptr};
 
   // Executor for spilling. The underlying thread pool executor is a
   // folly::CPUThreadPoolExecutor. The executor is stored as abstract type to
@@ -287,6 +308,15 @@ class PrestoServer {
   std::unique_ptr<http::HttpServer> httpServer_;
   std::unique_ptr<SignalHandler> signalHandler_;
   std::unique_ptr<Announcer> announcer_;
+
+  // Subsystems advertised as ready in the announcement. Also guards the
+  // capability push into 'announcer_' so a startup phase finishing while the
+  // announcer is being created cannot lose its capability.
+  folly::Synchronized<std::vector<std::string>> capabilities_;
+
+  // Overlaps independent startup registration phases. Only created when
+  // 'startup.parallel-registration-enabled' is set; joined on shutdown.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> startupExecutor_;
   std::unique_ptr<PeriodicHeartbeatManager> heartbeatManager_;
   std::shared_ptr<velox::memory::MemoryPool> pool_;
   std::shared_ptr<velox::memory::MemoryPool> nativeWorkerPool_;
@@ -12,13 +12,21 @@
  * limitations under the License.
  */
 #include "presto_cpp/main/PrestoServerOperations.h"
+#include <folly/memory/Malloc.h>
 #include <velox/common/base/Exceptions.h>
 #include <velox/common/base/VeloxException.h>
 #include <velox/common/caching/AsyncDataCache.h>
 #include <velox/common/caching/SsdCache.h>
+#include <velox/common/memory/Memory.h>
 #include <velox/common/process/TraceContext.h>
+#include <velox/common/time/Timer.h>
+#include "presto_cpp/main/ExchangeTracer.h"
+#include "presto_cpp/main/common/CpuProfiler.h"
+#include "presto_cpp/main/PrestoExchangeSource.h"
 #include "presto_cpp/main/PrestoServer.h"
 #include "presto_cpp/main/ServerOperation.h"
+#include "presto_cpp/main/http/HttpServer.h"
+#include "presto_cpp/main/http/filters/HttpEndpointLatencyFilter.h"
 #include "velox/connectors/hive/HiveConnector.h"
 
 namespace facebook::presto {
@@ -76,6 +84,17 @@ std::string prettyJson(folly::dynamic const& dyn) {
   return folly::json::serialize(dyn, opts);
 }
 
+uint32_t parseLimitParam(proxygen::HTTPMessage* message) {
+  const auto& limitStr = message->getQueryParam("limit");
+  try {
+    return limitStr == proxygen::empty_string
+        ? std::numeric_limits<uint32_t>::max()
+        : stoi(limitStr);
+  } catch (const std::exception& /* unused */) {
+    VELOX_USER_FAIL("Invalid limit provided '{}'.", limitStr);
+  }
+}
+
 } // namespace
 
 void PrestoServerOperations::runOperation(
@@ -95,7 +114,13 @@ void PrestoServerOperations::runOperation(
             downstream, veloxQueryConfigOperation(op, message));
         break;
       case ServerOperation::Target::kTask:
-        http::sendOkResponse(downstream, taskOperation(op, message));
+        // The full task listing is unbounded; stream it instead of building
+        // the whole dump in memory.
+        if (op.action == ServerOperation::Action::kListAll) {
+          streamTaskListing(message, downstream);
+        } else {
+          http::sendOkResponse(downstream, taskOperation(op, message));
+        }
         break;
       case ServerOperation::Target::kServer:
         http::sendOkResponse(downstream, serverOperation(op, message));
@@ -155,6 +180,9 @@ std::string PrestoServerOperations::systemConfigOperation(
           fmt::format("Could not find property '{}'\n", name));
       return fmt::format("{}\n", valueOpt.value());
     }
+    case ServerOperation::Action::kReloadProperties:
+      return SystemConfig::instance()->reloadDynamicProperties(
+          SystemConfig::dynamicProperties());
     default:
       break;
   }
@@ -216,15 +244,7 @@ std::string PrestoServerOperations::taskOperation(
       return prettyJson(task->second->toJson());
     }
     case ServerOperation::Action::kListAll: {
-      uint32_t limit;
-      const auto& limitStr = message->getQueryParam("limit");
-      try {
-        limit = limitStr == proxygen::empty_string
-            ? std::numeric_limits<uint32_t>::max()
-            : stoi(limitStr);
-      } catch (const std::exception& /* unused */) {
-        VELOX_USER_FAIL("Invalid limit provided '{}'.", limitStr);
-      }
+      const uint32_t limit = parseLimitParam(message);
       std::stringstream oss;
       if (limit < taskMap.size()) {
         oss << "Showing " << limit << "/" << taskMap.size() << " tasks:\n";
@@ -244,12 +264,71 @@ std::string PrestoServerOperations::taskOperation(
       oss << prettyJson(arrayObj);
       return oss.str();
     }
+    case ServerOperation::Action::kGetQueryCpu: {
+      const uint32_t limit = parseLimitParam(message);
+      folly::dynamic arrayObj = folly::dynamic::array;
+      for (const auto& [queryId, usage] : taskManager_->topCpuQueries(limit)) {
+        folly::dynamic obj = folly::dynamic::object;
+        obj["queryId"] = queryId;
+        obj["cpuTimeNanos"] = usage.cpuTimeNanos;
+        obj["windowCpuTimeNanos"] = usage.windowCpuTimeNanos;
+        arrayObj.push_back(std::move(obj));
+      }
+      return prettyJson(arrayObj);
+    }
+    case ServerOperation::Action::kGetQueryQueueTime: {
+      const uint32_t limit = parseLimitParam(message);
+      folly::dynamic arrayObj = folly::dynamic::array;
+      for (const auto& [queryId, queueTime] :
+           taskManager_->topQueuedQueries(limit)) {
+        folly::dynamic obj = folly::dynamic::object;
+        obj["queryId"] = queryId;
+        obj["queuedDriverMs"] = queueTime.queuedDriverMs;
+        obj["windowQueuedDriverMs"] = queueTime.windowQueuedDriverMs;
+        arrayObj.push_back(std::move(obj));
+      }
+      return prettyJson(arrayObj);
+    }
     default:
       break;
   }
   return unsupportedAction(op);
 }
 
+void PrestoServerOperations::streamTaskListing(
+    proxygen::HTTPMessage* message,
+    proxygen::ResponseHandler* downstream) {
+  if (taskManager_ == nullptr) {
+    http::sendOkResponse(downstream, std::string("Task Manager not found"));
+    return;
+  }
+  const auto taskMap = taskManager_->tasks();
+  // Parse the limit before the first chunk goes out; once headers are sent
+  // an error can no longer be reported as an error response.
+  const uint32_t limit = parseLimitParam(message);
+
+  http::ChunkedResponseWriter writer(downstream);
+  if (limit < taskMap.size()) {
+    writer.write(
+        fmt::format("Showing {}/{} tasks:\n", limit, taskMap.size()));
+  }
+  writer.write("[");
+  uint32_t index = 0;
+  for (auto taskItr = taskMap.begin(); taskItr != taskMap.end(); ++taskItr) {
+    const auto& veloxTask = taskItr->second->task;
+    const bool atLimit = ++index >= limit;
+    const folly::dynamic entry =
+        (veloxTask == nullptr ? "null" : veloxTask->toShortJson());
+    writer.write(
+        fmt::format("{}{}", index == 1 ? "\n" : ",\n", prettyJson(entry)));
+    if (atLimit) {
+      break;
+    }
+  }
+  writer.write(index == 0 ? "]" : "\n]");
+  writer.sendEom();
+}
+
 std::string PrestoServerOperations::serverOperation(
     const ServerOperation& op,
     proxygen::HTTPMessage* message) {
@@ -264,6 +343,16 @@ std::string PrestoServerOperations::serverOperation(
       return serverOperationClearCache(message);
     case ServerOperation::Action::kWriteSSD:
       return serverOperationWriteSsd(message);
+    case ServerOperation::Action::kGetAllocatorStats:
+      return serverOperationAllocatorStats();
+    case ServerOperation::Action::kGetExchangeTrace:
+      return serverOperationExchangeTrace(message);
+    case ServerOperation::Action::kGetPeerLatency:
+      return serverOperationPeerLatency(message);
+    case ServerOperation::Action::kDrain:
+      return serverOperationDrain(message);
+    case ServerOperation::Action::kProfile:
+      return serverOperationProfile(message);
     default:
       break;
   }
@@ -356,6 +445,196 @@ std::string PrestoServerOperations::serverOperationClearCache(
   return "Cleared ssd cache";
 }
 
+std::string PrestoServerOperations::serverOperationAllocatorStats() {
+  folly::dynamic obj = folly::dynamic::object;
+
+  folly::dynamic jemallocObj = folly::dynamic::object;
+  jemallocObj["enabled"] = folly::usingJEMalloc();
+  if (folly::usingJEMalloc()) {
+    // Advance the jemalloc epoch so the merged stats below reflect the
+    // current heap instead of the last refresh.
+    uint64_t epoch = 1;
+    size_t epochSize = sizeof(epoch);
+    mallctl("epoch", &epoch, &epochSize, &epoch, epochSize);
+
+    static const char* kStatNames[] = {
+        "stats.allocated",
+        "stats.active",
+        "stats.metadata",
+        "stats.resident",
+        "stats.mapped",
+        "stats.retained",
+    };
+    for (const char* statName : kStatNames) {
+      size_t value = 0;
+      size_t valueSize = sizeof(value);
+      if (mallctl(statName, &value, &valueSize, nullptr, 0) == 0) {
+        jemallocObj[statName] = value;
+      }
+    }
+    unsigned narenas = 0;
+    size_t narenasSize = sizeof(narenas);
+    if (mallctl("arenas.narenas", &narenas, &narenasSize, nullptr, 0) == 0) {
+      jemallocObj["arenas.narenas"] = narenas;
+    }
+  }
+  obj["jemalloc"] = jemallocObj;
+
+  // Totals the worker accounts for itself. Whatever 'stats.resident' exceeds
+  // their sum by is allocator usage from untracked subsystems (protocol
+  // parsing, proxygen buffers, Thrift and friends).
+  folly::dynamic trackedObj = folly::dynamic::object;
+  trackedObj["veloxMemoryManagerBytes"] =
+      velox::memory::memoryManager()->getTotalBytes();
+  if (auto* cache = velox::cache::AsyncDataCache::getInstance()) {
+    const auto cacheStats = cache->refreshStats();
+    trackedObj["asyncDataCacheBytes"] = cacheStats.tinySize +
+        cacheStats.largeSize + cacheStats.tinyPadding + cacheStats.largePadding;
+  }
+  int64_t exchangeCurrentBytes{0};
+  int64_t exchangePeakBytes{0};
+  PrestoExchangeSource::getMemoryUsage(exchangeCurrentBytes, exchangePeakBytes);
+  trackedObj["exchangeQueuedBytes"] = exchangeCurrentBytes;
+  trackedObj["exchangePeakQueuedBytes"] = exchangePeakBytes;
+  obj["tracked"] = trackedObj;
+
+  return prettyJson(obj);
+}
+
+std::string PrestoServerOperations::serverOperationExchangeTrace(
+    proxygen::HTTPMessage* message) {
+  if (message->getQueryParam("clear") == "true") {
+    ExchangeTracer::instance()->clear();
+    return "Exchange trace cleared";
+  }
+  return ExchangeTracer::instance()->toJsonString();
+}
+
+std::string PrestoServerOperations::serverOperationPeerLatency(
+    proxygen::HTTPMessage* message) {
+  if (message->getQueryParam("clear") == "true") {
+    http::filters::HttpEndpointLatencyFilter::retrievePeerMetrics(
+        /*clear=*/true);
+    return "Http exchange peer latency cleared";
+  }
+  folly::dynamic arrayObj = folly::dynamic::array;
+  for (const auto& metrics :
+       http::filters::HttpEndpointLatencyFilter::retrievePeerMetrics()) {
+    folly::dynamic obj = folly::dynamic::object;
+    obj["peer"] = metrics.peer;
+    obj["count"] = metrics.count;
+    obj["errorCount"] = metrics.errorCount;
+    obj["maxLatencyUs"] = metrics.maxLatencyUs;
+    obj["p50LatencyUs"] =
+        static_cast<int64_t>(metrics.latencyUs.estimateQuantile(0.5));
+    obj["p90LatencyUs"] =
+        static_cast<int64_t>(metrics.latencyUs.estimateQuantile(0.9));
+    obj["p99LatencyUs"] =
+        static_cast<int64_t>(metrics.latencyUs.estimateQuantile(0.99));
+    arrayObj.push_back(std::move(obj));
+  }
+  return prettyJson(arrayObj);
+}
+
+std::string PrestoServerOperations::serverOperationProfile(
+    proxygen::HTTPMessage* message) {
+  auto* profiler = CpuProfiler::instance();
+  const auto command = message->getQueryParam("command");
+  if (command == "start") {
+    const auto parseParam = [&](const std::string& name, uint32_t defaultValue) {
+      const auto& valueStr = message->getQueryParam(name);
+      if (valueStr == proxygen::empty_string) {
+        return defaultValue;
+      }
+      try {
+        return static_cast<uint32_t>(stoul(valueStr));
+      } catch (const std::exception& /* unused */) {
+        VELOX_USER_FAIL("Invalid '{}' provided '{}'.", name, valueStr);
+      }
+    };
+    const auto queryId = message->getQueryParam("queryId");
+    profiler->start(
+        queryId,
+        parseParam("freqHz", 99),
+        parseParam("maxSeconds", 30),
+        parseParam("maxSamples", 1 << 16));
+    return fmt::format(
+        "CPU profile started{}\n",
+        queryId.empty() ? std::string()
+                        : fmt::format(" for query {}", queryId));
+  }
+  if (command == "stop") {
+    return profiler->stop();
+  }
+  if (command == proxygen::empty_string || command == "status") {
+    return profiler->status() + "\n";
+  }
+  VELOX_USER_FAIL(
+      "Unknown profile command '{}': expected start, stop or status", command);
+}
+
+std::string PrestoServerOperations::serverOperationDrain(
+    proxygen::HTTPMessage* /* message */) {
+  if (server_ == nullptr || taskManager_ == nullptr) {
+    return "No PrestoServer to drain (it is nullptr).";
+  }
+  const auto prevState = server_->nodeState();
+  if (prevState == NodeState::kActive) {
+    LOG(INFO) << "Drain requested: setting node state to "
+              << nodeState2String(NodeState::kInActive)
+              << " so no new tasks are scheduled here.";
+    server_->setNodeState(NodeState::kInActive);
+  }
+
+  const uint64_t nowMs = velox::getCurrentTimeMs();
+  folly::dynamic remainingTasks = folly::dynamic::array;
+  int64_t totalBufferedOutputBytes{0};
+  size_t numRemainingTasks{0};
+  for (const auto& [taskId, prestoTask] : taskManager_->tasks()) {
+    const auto& veloxTask = prestoTask->task;
+    if (veloxTask == nullptr || !veloxTask->isRunning()) {
+      continue;
+    }
+    ++numRemainingTasks;
+    const auto taskStats = veloxTask->taskStats();
+    folly::dynamic taskObj = folly::dynamic::object;
+    taskObj["taskId"] = taskId;
+    taskObj["state"] = velox::exec::taskStateString(veloxTask->state());
+    taskObj["totalDrivers"] = taskStats.numTotalDrivers;
+    taskObj["completedDrivers"] = taskStats.numCompletedDrivers;
+    taskObj["runningDrivers"] = taskStats.numRunningDrivers;
+    // Driver completion is a coarse progress proxy, but good enough for the
+    // coordinator to tell nearly-done tasks from ones worth restarting
+    // elsewhere. The ETA scales elapsed time by the incomplete fraction and
+    // is -1 when no progress has been made yet.
+    const double progress = taskStats.numTotalDrivers > 0
+        ? static_cast<double>(taskStats.numCompletedDrivers) /
+            taskStats.numTotalDrivers
+        : 0.0;
+    taskObj["progress"] = progress;
+    const int64_t elapsedMs = taskStats.executionStartTimeMs == 0
+        ? 0
+        : static_cast<int64_t>(nowMs - taskStats.executionStartTimeMs);
+    taskObj["elapsedMs"] = elapsedMs;
+    taskObj["estimatedRemainingMs"] = (progress > 0.0 && elapsedMs > 0)
+        ? static_cast<int64_t>(elapsedMs * (1.0 - progress) / progress)
+        : -1;
+    const int64_t bufferedOutputBytes = taskStats.outputBufferStats.has_value()
+        ? taskStats.outputBufferStats->bufferedBytes
+        : 0;
+    taskObj["bufferedOutputBytes"] = bufferedOutputBytes;
+    totalBufferedOutputBytes += bufferedOutputBytes;
+    remainingTasks.push_back(std::move(taskObj));
+  }
+
+  folly::dynamic obj = folly::dynamic::object;
+  obj["nodeState"] = nodeState2String(server_->nodeState());
+  obj["numRemainingTasks"] = numRemainingTasks;
+  obj["totalBufferedOutputBytes"] = totalBufferedOutputBytes;
+  obj["remainingTasks"] = std::move(remainingTasks);
+  return prettyJson(obj);
+}
+
 std::string PrestoServerOperations::serverOperationWriteSsd(
     proxygen::HTTPMessage* message) {
   auto* cache = velox::cache::AsyncDataCache::getInstance();
@@ -57,6 +57,13 @@ class PrestoServerOperations {
       proxygen::HTTPMessage* message);
 
  private:
+  // Streams the task listing to 'downstream' one task at a time instead of
+  // accumulating the whole listing in one string; with tens of thousands of
+  // tasks the full dump is large enough to matter under memory pressure.
+  void streamTaskListing(
+      proxygen::HTTPMessage* message,
+      proxygen::ResponseHandler* downstream);
+
   std::string serverOperationTrace();
 
   std::string serverOperationSetState(proxygen::HTTPMessage* message);
@@ -69,6 +76,28 @@ class PrestoServerOperations {
   // Writes the in-memory cache into SSD and makes checkpoints.
   std::string serverOperationWriteSsd(proxygen::HTTPMessage* message);
 
+  // Returns jemalloc stats plus the memory totals the worker tracks itself
+  // (velox pools, data cache, exchange queues); the remainder against
+  // 'stats.resident' is untracked allocator usage (protocol parsing, proxygen
+  // buffers and the like).
+  std::string serverOperationAllocatorStats();
+
+  // Returns (or clears) the sampled exchange request timing trace.
+  std::string serverOperationExchangeTrace(proxygen::HTTPMessage* message);
+
+  // Returns (or clears) the per-peer latency/error breakdown of the exchange
+  // endpoints.
+  std::string serverOperationPeerLatency(proxygen::HTTPMessage* message);
+
+  // Starts, stops or reports on an on-demand CPU sampling profile; a stop
+  // returns the collapsed-stack profile. See CpuProfiler.
+  std::string serverOperationProfile(proxygen::HTTPMessage* message);
+
+  // Marks the node inactive so no new tasks are scheduled here and returns a
+  // machine-readable status of the remaining tasks (driver progress, ETA,
+  // buffered output bytes). Idempotent; callers poll it while draining.
+  std::string serverOperationDrain(proxygen::HTTPMessage* message);
+
   TaskManager* const taskManager_;
   PrestoServer* const server_;
 };
@@ -13,11 +13,21 @@
  */
 
 #include "presto_cpp/main/PrestoTask.h"
+#include <folly/String.h>
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <algorithm>
+#include <folly/hash/Hash.h>
 #include <sys/resource.h>
+#include "presto_cpp/main/SessionProperties.h"
 #include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
 #include "presto_cpp/main/common/Exception.h"
 #include "presto_cpp/main/common/Utils.h"
+#include "presto_cpp/main/operators/BroadcastWrite.h"
+#include "presto_cpp/main/thrift/ProtocolToThrift.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/time/Timer.h"
 
 using namespace facebook::velox;
@@ -45,6 +55,10 @@ std::string prestoTaskStateString(PrestoTaskState state) {
 
 namespace {
 
+// Upper bound on the retained time-sliced stats windows per operator; with a
+// 10-second window this keeps close to three hours of history.
+constexpr size_t kMaxOperatorTimeSlices{1024};
+
 #define TASK_STATS_SUM(taskStats, statsName, taskStatusSum)      \
   do {                                                           \
     for (int i = 0; i < taskStats.pipelineStats.size(); ++i) {   \
@@ -224,6 +238,63 @@ std::string generateRuntimeStatName(
       statName);
 }
 
+// Returns true when 'composed' equals "operatorType.planNodeId.statName"
+// without composing the candidate.
+bool matchesRuntimeStatName(
+    const std::string& composed,
+    const exec::OperatorStats& veloxOperatorStats,
+    const std::string& statName) {
+  const auto& type = veloxOperatorStats.operatorType;
+  const auto& node = veloxOperatorStats.planNodeId;
+  if (composed.size() != type.size() + node.size() + statName.size() + 2) {
+    return false;
+  }
+  return composed.compare(0, type.size(), type) == 0 &&
+      composed[type.size()] == '.' &&
+      composed.compare(type.size() + 1, node.size(), node) == 0 &&
+      composed[type.size() + 1 + node.size()] == '.' &&
+      composed.compare(
+          type.size() + node.size() + 2, statName.size(), statName) == 0;
+}
+
+// Same as generateRuntimeStatName() but interns the composed names in a
+// process-wide table. Every stats rebuild of a stats-heavy task composes
+// hundreds of these names, and the same operator type / plan node id / stat
+// name triples recur across operators, rebuilds and queries, so each name is
+// formatted once and copied out of the table afterwards. The table is keyed
+// by the triple's hash and entries are verified against the parts, so a hash
+// collision only costs the fallback to fresh composition; the table stops
+// growing at its cap, since plan node ids and stat names draw from small
+// sets in practice.
+std::string internRuntimeStatName(
+    const exec::OperatorStats& veloxOperatorStats,
+    const std::string& statName) {
+  static constexpr size_t kMaxInternedStatNames{65536};
+  using NameTable = folly::F14FastMap<uint64_t, std::string>;
+  static folly::Synchronized<NameTable> nameTable;
+
+  const auto hash = folly::hash::hash_combine(
+      veloxOperatorStats.operatorType,
+      veloxOperatorStats.planNodeId,
+      statName);
+  {
+    auto locked = nameTable.rlock();
+    auto it = locked->find(hash);
+    if (it != locked->end()) {
+      if (matchesRuntimeStatName(it->second, veloxOperatorStats, statName)) {
+        return it->second;
+      }
+      return generateRuntimeStatName(veloxOperatorStats, statName);
+    }
+  }
+  auto name = generateRuntimeStatName(veloxOperatorStats, statName);
+  auto locked = nameTable.wlock();
+  if (locked->size() < kMaxInternedStatNames) {
+    locked->emplace(hash, name);
+  }
+  return name;
+}
+
 // Helper to convert Velox-specific generic operator stats into Presto runtime
 // stats.
 struct OperatorStatsCollector {
@@ -245,7 +316,7 @@ struct OperatorStatsCollector {
       const std::string& name,
       int64_t value,
       protocol::RuntimeUnit unit = protocol::RuntimeUnit::NONE) {
-    const std::string statName = generateRuntimeStatName(veloxStats, name);
+    const std::string statName = internRuntimeStatName(veloxStats, name);
     auto prestoMetric = createProtocolRuntimeMetric(statName, value, unit);
     prestoStats.emplace(statName, prestoMetric);
   }
@@ -316,6 +387,102 @@ void updateTaskRuntimeStats(
   }
 }
 
+// Computes a cheap signature over the velox task stats fields that move when
+// task execution makes progress. updateInfoLocked() skips rebuilding the
+// protocol::TaskInfo stats tree when the signature has not changed since the
+// last rebuild; this scan is far cheaper than the full conversion.
+size_t taskStatsSignature(
+    const exec::TaskStats& veloxTaskStats,
+    protocol::TaskState state) {
+  size_t hash = folly::hash::hash_combine(
+      static_cast<int>(state),
+      veloxTaskStats.numTotalSplits,
+      veloxTaskStats.numQueuedSplits,
+      veloxTaskStats.numRunningSplits,
+      veloxTaskStats.numFinishedSplits,
+      veloxTaskStats.numTotalDrivers,
+      veloxTaskStats.numQueuedDrivers,
+      veloxTaskStats.numRunningDrivers,
+      veloxTaskStats.numCompletedDrivers,
+      veloxTaskStats.numTerminatedDrivers,
+      veloxTaskStats.executionStartTimeMs,
+      veloxTaskStats.executionEndTimeMs,
+      veloxTaskStats.endTimeMs,
+      veloxTaskStats.longestRunningOpCallMs,
+      veloxTaskStats.memoryReclaimCount);
+  for (const auto& pipeline : veloxTaskStats.pipelineStats) {
+    for (const auto& op : pipeline.operatorStats) {
+      hash = folly::hash::hash_combine(
+          hash,
+          op.numSplits,
+          op.inputPositions,
+          op.rawInputPositions,
+          op.outputPositions,
+          op.spilledBytes,
+          op.blockedWallNanos,
+          op.addInputTiming.cpuNanos + op.getOutputTiming.cpuNanos +
+              op.isBlockedTiming.cpuNanos + op.finishTiming.cpuNanos,
+          op.addInputTiming.wallNanos + op.getOutputTiming.wallNanos +
+              op.isBlockedTiming.wallNanos + op.finishTiming.wallNanos,
+          op.memoryStats.userMemoryReservation);
+    }
+  }
+  return hash;
+}
+
+// Computes a signature over the velox stats of a single pipeline, covering
+// every field that feeds the converted protocol::PipelineStats entry.
+// updateExecutionInfoLocked() reuses the cached entry for a pipeline whose
+// signature has not moved instead of rebuilding it, so each info request
+// only pays the conversion cost for pipelines that made progress. 'seed'
+// folds in the task-level times copied into each pipeline entry.
+size_t pipelineStatsSignature(
+    const exec::PipelineStats& veloxPipeline,
+    size_t seed) {
+  size_t hash = seed;
+  for (const auto& op : veloxPipeline.operatorStats) {
+    hash = folly::hash::hash_combine(
+        hash,
+        op.numSplits,
+        op.numDrivers,
+        op.numNullKeys,
+        op.inputPositions,
+        op.inputBytes,
+        op.rawInputPositions,
+        op.rawInputBytes,
+        op.outputPositions,
+        op.outputBytes,
+        op.spilledBytes,
+        op.blockedWallNanos,
+        op.addInputTiming.cpuNanos + op.getOutputTiming.cpuNanos +
+            op.isBlockedTiming.cpuNanos + op.finishTiming.cpuNanos +
+            op.backgroundTiming.cpuNanos,
+        op.addInputTiming.wallNanos + op.getOutputTiming.wallNanos +
+            op.isBlockedTiming.wallNanos + op.finishTiming.wallNanos +
+            op.backgroundTiming.wallNanos,
+        op.memoryStats.userMemoryReservation,
+        op.memoryStats.revocableMemoryReservation,
+        op.memoryStats.systemMemoryReservation,
+        op.memoryStats.peakUserMemoryReservation,
+        op.memoryStats.peakSystemMemoryReservation,
+        op.memoryStats.peakTotalMemoryReservation,
+        op.dynamicFilterStats.producerNodeIds.size());
+    // Runtime stats are accumulated commutatively since the map iteration
+    // order is not stable across task stats snapshots.
+    size_t runtimeStatsHash = 0;
+    for (const auto& [name, value] : op.runtimeStats) {
+      runtimeStatsHash += folly::hash::hash_combine(
+          std::hash<std::string>{}(name),
+          value.count,
+          value.sum,
+          value.min,
+          value.max);
+    }
+    hash = folly::hash::hash_combine(hash, runtimeStatsHash);
+  }
+  return hash;
+}
+
 presto::protocol::DynamicFilterStats toPrestoDynamicFilterStats(
     const velox::exec::OperatorStats& veloxOpStats) {
   presto::protocol::DynamicFilterStats dynamicFilterStats;
@@ -348,6 +515,7 @@ void updatePipelineStats(
     const int pipelineId,
     const exec::PipelineStats& veloxPipelineStats,
     const protocol::TaskStats& prestoTaskStats,
+    bool includeOperatorRuntimeStats,
     protocol::PipelineStats& prestoPipelineStats) {
   prestoPipelineStats.inputPipeline = veloxPipelineStats.inputPipeline;
   prestoPipelineStats.outputPipeline = veloxPipelineStats.outputPipeline;
@@ -471,13 +639,17 @@ void updatePipelineStats(
       prestoOp.dynamicFilterStats = toPrestoDynamicFilterStats(veloxOp);
     }
 
-    for (const auto& stat : veloxOp.runtimeStats) {
-      auto statName = generateRuntimeStatName(veloxOp, stat.first);
-      prestoOp.runtimeStats[statName] = toRuntimeMetric(statName, stat.second);
+    if (includeOperatorRuntimeStats) {
+      for (const auto& stat : veloxOp.runtimeStats) {
+        auto statName = internRuntimeStatName(veloxOp, stat.first);
+        prestoOp.runtimeStats[statName] =
+            toRuntimeMetric(statName, stat.second);
+      }
+      updateOperatorRuntimeStats(veloxOp, prestoOp.runtimeStats);
+    } else {
+      prestoOp.runtimeStats.clear();
     }
 
-    updateOperatorRuntimeStats(veloxOp, prestoOp.runtimeStats);
-
     auto wallNanos = veloxOp.isBlockedTiming.wallNanos +
         veloxOp.addInputTiming.wallNanos + veloxOp.getOutputTiming.wallNanos +
         veloxOp.finishTiming.wallNanos;
@@ -499,6 +671,84 @@ void updatePipelineStats(
 
 } // namespace
 
+bool SplitSequenceGuard::mayContain(uint64_t hash) const {
+  const auto numBits = bloom_.size() * 64;
+  const auto bit1 = hash % numBits;
+  const auto bit2 = (hash >> 32) % numBits;
+  return ((bloom_[bit1 / 64] >> (bit1 % 64)) & 1) != 0 &&
+      ((bloom_[bit2 / 64] >> (bit2 % 64)) & 1) != 0;
+}
+
+void SplitSequenceGuard::addToBloom(uint64_t hash) {
+  const auto numBits = bloom_.size() * 64;
+  const auto bit1 = hash % numBits;
+  const auto bit2 = (hash >> 32) % numBits;
+  bloom_[bit1 / 64] |= 1ULL << (bit1 % 64);
+  bloom_[bit2 / 64] |= 1ULL << (bit2 % 64);
+}
+
+bool SplitSequenceGuard::testAndRecord(
+    const velox::core::PlanNodeId& planNodeId,
+    int64_t sequenceId) {
+  // Pack a small per-node index with the sequence id so the exact keys are
+  // collision-free. Sequence ids are batch offsets and comfortably fit.
+  VELOX_CHECK_GE(sequenceId, 0);
+  VELOX_CHECK_LT(sequenceId, 1LL << 48);
+  const auto [nodeIt, _] =
+      nodeIndices_.try_emplace(planNodeId, nodeIndices_.size());
+  const auto key = (static_cast<uint64_t>(nodeIt->second) << 48) |
+      static_cast<uint64_t>(sequenceId);
+  const auto hash = folly::hasher<uint64_t>()(key);
+
+  if (bloom_.empty()) {
+    bloom_.resize(kInitialBloomBits / 64, 0);
+  } else if (mayContain(hash)) {
+    // Bloom hit: the exact set decides whether this is a re-sent split or a
+    // false positive.
+    if (!seen_.insert(key).second) {
+      return false;
+    }
+    addToBloom(hash);
+    return true;
+  }
+
+  seen_.insert(key);
+  addToBloom(hash);
+  if (seen_.size() * kBloomBitsPerSplit > bloom_.size() * 64) {
+    // The filter outgrew its bits; double it and rebuild from the exact set
+    // so the false-positive rate stays low as the task scales.
+    bloom_.assign(bloom_.size() * 2, 0);
+    for (const auto recordedKey : seen_) {
+      addToBloom(folly::hasher<uint64_t>()(recordedKey));
+    }
+  }
+  return true;
+}
+
+// static
+TaskInfoFieldMask TaskInfoFieldMask::fromFieldsParam(
+    const std::string& fields) {
+  TaskInfoFieldMask mask;
+  mask.pipelines = false;
+  mask.operatorRuntimeStats = false;
+  mask.taskRuntimeStats = false;
+  std::vector<folly::StringPiece> groups;
+  folly::split(',', fields, groups, /*ignoreEmpty=*/true);
+  for (const auto& group : groups) {
+    if (group == "pipelines") {
+      mask.pipelines = true;
+    } else if (group == "pipelines/operators/runtimeStats") {
+      mask.pipelines = true;
+      mask.operatorRuntimeStats = true;
+    } else if (group == "runtimeStats") {
+      mask.taskRuntimeStats = true;
+    } else {
+      VELOX_USER_FAIL("Unknown task info field group '{}'", group);
+    }
+  }
+  return mask;
+}
+
 PrestoTask::PrestoTask(
     const std::string& taskId,
     const std::string& nodeId,
@@ -541,6 +791,128 @@ void PrestoTask::updateCoordinatorHeartbeatLocked() {
   lastCoordinatorHeartbeatMs = velox::getCurrentTimeMs();
 }
 
+void PrestoTask::recordResultFetch(long bufferId) {
+  const uint64_t nowMs = velox::getCurrentTimeMs();
+  std::lock_guard<std::mutex> l(mutex);
+  auto& pacing = resultFetchPacing[bufferId];
+  if (pacing.numFetches > 0) {
+    const double gapMs =
+        nowMs > pacing.lastFetchMs ? nowMs - pacing.lastFetchMs : 0;
+    pacing.fetchGapEwmaMs = pacing.numFetches == 1
+        ? gapMs
+        : pacing.fetchGapEwmaMs * 0.75 + gapMs * 0.25;
+  }
+  pacing.lastFetchMs = nowMs;
+  ++pacing.numFetches;
+}
+
+void PrestoTask::recordResultFetchBytes(long bufferId, int64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex);
+  resultFetchPacing[bufferId].totalBytes += bytes;
+}
+
+double PrestoTask::resultFetchGapMsLocked(long bufferId) const {
+  auto it = resultFetchPacing.find(bufferId);
+  return it == resultFetchPacing.end() ? 0 : it->second.fetchGapEwmaMs;
+}
+
+ResultFetchPacingSummary PrestoTask::resultFetchPacingSummary() const {
+  ResultFetchPacingSummary summary;
+  std::lock_guard<std::mutex> l(mutex);
+  summary.numConsumers = resultFetchPacing.size();
+  for (const auto& [bufferId, pacing] : resultFetchPacing) {
+    summary.numFetches += pacing.numFetches;
+    summary.totalBytes += pacing.totalBytes;
+    summary.maxFetchGapMs = std::max<int64_t>(
+        summary.maxFetchGapMs, static_cast<int64_t>(pacing.fetchGapEwmaMs));
+  }
+  return summary;
+}
+
+void PrestoTask::recordTimeSlicedStats(uint64_t windowMs) {
+  std::lock_guard<std::mutex> l(mutex);
+  if (task == nullptr || windowMs == 0) {
+    return;
+  }
+  const uint64_t nowMs = getCurrentTimeMs();
+  const uint64_t windowStartMs = nowMs - nowMs % windowMs;
+  const auto veloxTaskStats = task->taskStats();
+  for (const auto& pipelineStats : veloxTaskStats.pipelineStats) {
+    for (const auto& opStats : pipelineStats.operatorStats) {
+      auto& history = timeSlicedStats_[fmt::format(
+          "{}.{}.{}",
+          opStats.pipelineId,
+          opStats.operatorId,
+          opStats.operatorType)];
+      const uint64_t wallNanos = opStats.addInputTiming.wallNanos +
+          opStats.getOutputTiming.wallNanos + opStats.finishTiming.wallNanos +
+          opStats.isBlockedTiming.wallNanos;
+      const uint64_t cpuNanos = opStats.addInputTiming.cpuNanos +
+          opStats.getOutputTiming.cpuNanos + opStats.finishTiming.cpuNanos +
+          opStats.isBlockedTiming.cpuNanos;
+      const uint64_t inputRows = opStats.inputPositions;
+      // The counters are cumulative; charge their growth since the last
+      // sweep to the window containing 'now'.
+      const uint64_t wallDelta = wallNanos - history.lastWallNanos;
+      const uint64_t cpuDelta = cpuNanos - history.lastCpuNanos;
+      const uint64_t rowsDelta = inputRows - history.lastInputRows;
+      history.lastWallNanos = wallNanos;
+      history.lastCpuNanos = cpuNanos;
+      history.lastInputRows = inputRows;
+      if (wallDelta == 0 && cpuDelta == 0 && rowsDelta == 0) {
+        continue;
+      }
+      if (history.slices.empty() ||
+          history.slices.back().windowStartMs != windowStartMs) {
+        if (history.slices.size() >= kMaxOperatorTimeSlices) {
+          history.slices.pop_front();
+        }
+        history.slices.push_back(OperatorTimeSlice{windowStartMs});
+      }
+      auto& slice = history.slices.back();
+      slice.wallNanos += wallDelta;
+      slice.cpuNanos += cpuDelta;
+      slice.inputRows += rowsDelta;
+    }
+  }
+}
+
+folly::dynamic PrestoTask::timeSlicedStatsJson() const {
+  std::lock_guard<std::mutex> l(mutex);
+  folly::dynamic events = folly::dynamic::array;
+  int64_t tid{0};
+  for (const auto& [operatorKey, history] : timeSlicedStats_) {
+    if (history.slices.empty()) {
+      continue;
+    }
+    // Name the per-operator track so trace viewers label the rows.
+    folly::dynamic threadName = folly::dynamic::object;
+    threadName["name"] = "thread_name";
+    threadName["ph"] = "M";
+    threadName["pid"] = 0;
+    threadName["tid"] = tid;
+    threadName["args"] = folly::dynamic::object("name", operatorKey);
+    events.push_back(std::move(threadName));
+    for (const auto& slice : history.slices) {
+      folly::dynamic event = folly::dynamic::object;
+      event["name"] = operatorKey;
+      event["ph"] = "X";
+      event["pid"] = 0;
+      event["tid"] = tid;
+      event["ts"] = slice.windowStartMs * 1'000;
+      event["dur"] = slice.wallNanos / 1'000;
+      event["args"] = folly::dynamic::object("cpuNanos", slice.cpuNanos)(
+          "inputRows", slice.inputRows);
+      events.push_back(std::move(event));
+    }
+    ++tid;
+  }
+  folly::dynamic obj = folly::dynamic::object;
+  obj["traceEvents"] = std::move(events);
+  obj["displayTimeUnit"] = "ms";
+  return obj;
+}
+
 uint64_t PrestoTask::timeSinceLastHeartbeatMs() const {
   std::lock_guard<std::mutex> l(mutex);
   if (lastHeartbeatMs == 0UL) {
@@ -566,6 +938,16 @@ void PrestoTask::recordProcessCpuTime() {
 }
 
 protocol::TaskStatus PrestoTask::updateStatusLocked() {
+  refreshStatusLocked();
+  return info.taskStatus;
+}
+
+void PrestoTask::updateStatusThriftLocked(thrift::TaskStatus& thriftStatus) {
+  refreshStatusLocked();
+  thrift::toThrift(info.taskStatus, thriftStatus);
+}
+
+void PrestoTask::refreshStatusLocked() {
   // Error occurs when creating task or even before task is created. Set error
   // and return immediately
   if (error != nullptr) {
@@ -574,13 +956,13 @@ protocol::TaskStatus PrestoTask::updateStatusLocked() {
     }
     info.taskStatus.state = protocol::TaskState::FAILED;
     recordProcessCpuTime();
-    return info.taskStatus;
+    return;
   }
 
   // We can be here before the fragment plan is received and exec task created.
   if (task == nullptr) {
     VELOX_CHECK(!taskStarted);
-    return info.taskStatus;
+    return;
   }
 
   const auto veloxTaskStats = task->taskStats();
@@ -634,7 +1016,6 @@ protocol::TaskStatus PrestoTask::updateStatusLocked() {
   if (isFinalState(info.taskStatus.state)) {
     recordProcessCpuTime();
   }
-  return info.taskStatus;
 }
 
 void PrestoTask::updateOutputBufferInfoLocked(
@@ -662,7 +1043,34 @@ void PrestoTask::updateOutputBufferInfoLocked(
       outputBufferStats.numTopBuffers);
 }
 
-protocol::TaskInfo PrestoTask::updateInfoLocked(bool summarize) {
+#ifdef PRESTO_ENABLE_CUDF
+// Splits the cumulative operator execution time of a finished task between
+// GPU and CPU operators. The cuDF driver adapter replaces eligible operators
+// with "Cudf"-prefixed variants, so the operator type tells which side of the
+// offload did the work.
+void recordGpuOperatorTime(const exec::TaskStats& veloxTaskStats) {
+  int64_t gpuNanos{0};
+  int64_t cpuNanos{0};
+  for (const auto& pipeline : veloxTaskStats.pipelineStats) {
+    for (const auto& op : pipeline.operatorStats) {
+      const auto opNanos = op.isBlockedTiming.cpuNanos +
+          op.addInputTiming.cpuNanos + op.getOutputTiming.cpuNanos +
+          op.finishTiming.cpuNanos;
+      if (op.operatorType.compare(0, 4, "Cudf") == 0) {
+        gpuNanos += opNanos;
+      } else {
+        cpuNanos += opNanos;
+      }
+    }
+  }
+  RECORD_METRIC_VALUE(kCounterTaskGpuOperatorTimeMs, gpuNanos / 1'000'000);
+  RECORD_METRIC_VALUE(kCounterTaskCpuOperatorTimeMs, cpuNanos / 1'000'000);
+}
+#endif
+
+protocol::TaskInfo PrestoTask::updateInfoLocked(
+    bool summarize,
+    const TaskInfoFieldMask& fieldMask) {
   const protocol::TaskStatus prestoTaskStatus = updateStatusLocked();
 
   // Return limited info if there is no exec task.
@@ -670,7 +1078,48 @@ protocol::TaskInfo PrestoTask::updateInfoLocked(bool summarize) {
     return info;
   }
   const velox::exec::TaskStats veloxTaskStats = task->taskStats();
+
+#ifdef PRESTO_ENABLE_CUDF
+  if (isFinalState(prestoTaskStatus.state) && !gpuOperatorTimeRecorded_) {
+    recordGpuOperatorTime(veloxTaskStats);
+    gpuOperatorTimeRecorded_ = true;
+  }
+#endif
+
+  // Serve the cached info when neither an external task mutation nor the
+  // velox task stats moved since the last rebuild. The status and heartbeat
+  // fields are kept fresh above independently of the stats tree.
+  const uint64_t mutationCount =
+      infoMutationCount_.load(std::memory_order_relaxed);
+  const size_t statsSignature =
+      taskStatsSignature(veloxTaskStats, prestoTaskStatus.state);
+
   const uint64_t currentTimeMs = velox::getCurrentTimeMs();
+
+  // Tiered stats: a query that opted in gets state, row counts and task
+  // level totals only while it is young, and escalates to full per-operator
+  // stats once its runtime passes the threshold. Final states always report
+  // full stats, so sub-threshold queries pay the conversion exactly once.
+  bool minimalStats = false;
+  if (!isFinalState(prestoTaskStatus.state)) {
+    const auto& queryConfig = task->queryCtx()->queryConfig();
+    if (queryConfig.get<bool>(
+            SessionProperties::kTaskMinimalStatsEnabled, false)) {
+      const auto thresholdMs = queryConfig.get<int64_t>(
+          SessionProperties::kTaskFullStatsThresholdMs, 1'000);
+      const uint64_t sinceMs = veloxTaskStats.executionStartTimeMs != 0
+          ? veloxTaskStats.executionStartTimeMs
+          : createTimeMs;
+      minimalStats = currentTimeMs < sinceMs + thresholdMs;
+    }
+  }
+
+  if (infoCacheValid_ && mutationCount == lastInfoMutationCount_ &&
+      statsSignature == lastInfoStatsSignature_ &&
+      summarize == lastInfoSummarize_ && fieldMask == lastInfoFieldMask_ &&
+      minimalStats == lastInfoMinimalStats_) {
+    return info;
+  }
   // Set 'lastTaskStatsUpdateMs' to execution start time if it is 0.
   if (lastTaskStatsUpdateMs == 0) {
     lastTaskStatsUpdateMs = veloxTaskStats.executionStartTimeMs;
@@ -695,7 +1144,10 @@ protocol::TaskInfo PrestoTask::updateInfoLocked(bool summarize) {
       veloxTaskStats,
       prestoTaskStatus,
       taskRuntimeStats,
-      isFinalState(prestoTaskStatus.state) || !summarize);
+      fieldMask.pipelines && !minimalStats &&
+          (isFinalState(prestoTaskStatus.state) || !summarize),
+      minimalStats,
+      fieldMask);
 
   // Task runtime metrics we want while the Task is not finalized.
   hasStuckOperator = false;
@@ -727,15 +1179,42 @@ protocol::TaskInfo PrestoTask::updateInfoLocked(bool summarize) {
           "stuck_op." + veloxTaskStats.longestRunningOpCall,
           veloxTaskStats.numCompletedDrivers);
     }
+    // Surface broadcast materialization progress in the task-level runtime
+    // stats of running tasks. These are never skipped, so the coordinator
+    // sees a broadcast growing far beyond the planner's estimate while the
+    // stage still runs and can revoke the broadcast strategy, instead of
+    // finding out from the final stats.
+    uint64_t broadcastWriteBytes{0};
+    for (const auto& pipelineStats : veloxTaskStats.pipelines) {
+      for (const auto& opStats : pipelineStats.operatorStats) {
+        if (opStats.operatorType == "BroadcastWrite") {
+          const auto it =
+              opStats.runtimeStats.find(operators::kBroadcastWriteBytes);
+          if (it != opStats.runtimeStats.end()) {
+            broadcastWriteBytes += it->second.sum;
+          }
+        }
+      }
+    }
+    addRuntimeMetricIfNotZero(
+        taskRuntimeStats, operators::kBroadcastWriteBytes, broadcastWriteBytes);
     // These metrics we need when we are running, so do not try to skipp them.
-    updateTaskRuntimeStats(
-        prestoTaskStatus.state,
-        taskRuntimeStats,
-        /*tryToSkipIfRunning=*/false,
-        prestoTaskStats);
+    if (fieldMask.taskRuntimeStats) {
+      updateTaskRuntimeStats(
+          prestoTaskStatus.state,
+          taskRuntimeStats,
+          /*tryToSkipIfRunning=*/false,
+          prestoTaskStats);
+    }
   }
 
   lastTaskStatsUpdateMs = currentTimeMs;
+  lastInfoMutationCount_ = mutationCount;
+  lastInfoStatsSignature_ = statsSignature;
+  lastInfoSummarize_ = summarize;
+  lastInfoFieldMask_ = fieldMask;
+  lastInfoMinimalStats_ = minimalStats;
+  infoCacheValid_ = true;
   return info;
 }
 
@@ -825,7 +1304,9 @@ void PrestoTask::updateExecutionInfoLocked(
     const velox::exec::TaskStats& veloxTaskStats,
     const protocol::TaskStatus& prestoTaskStatus,
     std::unordered_map<std::string, velox::RuntimeMetric>& taskRuntimeStats,
-    bool includePipelineStats) {
+    bool includePipelineStats,
+    bool minimalStats,
+    const TaskInfoFieldMask& fieldMask) {
   protocol::TaskStats& prestoTaskStats = info.stats;
 
   prestoTaskStats.rawInputPositions = 0;
@@ -868,6 +1349,15 @@ void PrestoTask::updateExecutionInfoLocked(
   } else {
     prestoTaskStats.pipelines = {};
   }
+  // The task-level times are copied into each converted pipeline entry, so a
+  // cached entry can only be reused while they are unchanged.
+  const size_t pipelineSignatureSeed = folly::hash::hash_combine(
+      prestoTaskStats.createTimeInMillis, prestoTaskStats.endTimeInMillis);
+  const bool canReusePipelines = includePipelineStats &&
+      lastInfoIncludedPipelines_ &&
+      fieldMask.operatorRuntimeStats == lastInfoPipelineOpRuntimeStats_ &&
+      pipelineStatsSignatures_.size() == veloxTaskStats.pipelineStats.size();
+  pipelineStatsSignatures_.resize(veloxTaskStats.pipelineStats.size());
   for (int i = 0; i < veloxTaskStats.pipelineStats.size(); ++i) {
     auto& veloxPipeline = veloxTaskStats.pipelineStats[i];
 
@@ -904,32 +1394,51 @@ void PrestoTask::updateExecutionInfoLocked(
         prestoTaskStats.totalCpuTimeInNanos += cpuNanos;
         prestoTaskStats.totalBlockedTimeInNanos += veloxOp.blockedWallNanos;
 
-        for (const auto& stat : veloxOp.runtimeStats) {
-          auto statName = generateRuntimeStatName(veloxOp, stat.first);
-          addRuntimeMetric(taskRuntimeStats, statName, stat.second);
+        if (!minimalStats && fieldMask.taskRuntimeStats) {
+          for (const auto& stat : veloxOp.runtimeStats) {
+            auto statName = internRuntimeStatName(veloxOp, stat.first);
+            addRuntimeMetric(taskRuntimeStats, statName, stat.second);
+          }
+          updateOperatorRuntimeStats(veloxOp, prestoTaskStats.runtimeStats);
         }
-        updateOperatorRuntimeStats(veloxOp, prestoTaskStats.runtimeStats);
       }
     }
 
-    for (const auto& driverStat : veloxPipeline.driverStats) {
-      for (const auto& [name, value] : driverStat.runtimeStats) {
-        addRuntimeMetric(taskRuntimeStats, name, value);
+    if (!minimalStats && fieldMask.taskRuntimeStats) {
+      for (const auto& driverStat : veloxPipeline.driverStats) {
+        for (const auto& [name, value] : driverStat.runtimeStats) {
+          addRuntimeMetric(taskRuntimeStats, name, value);
+        }
       }
     }
 
     if (includePipelineStats) {
-      updatePipelineStats(
-          id, i, veloxPipeline, prestoTaskStats, prestoTaskStats.pipelines[i]);
+      const size_t pipelineSignature =
+          pipelineStatsSignature(veloxPipeline, pipelineSignatureSeed);
+      if (!canReusePipelines ||
+          pipelineSignature != pipelineStatsSignatures_[i]) {
+        updatePipelineStats(
+            id,
+            i,
+            veloxPipeline,
+            prestoTaskStats,
+            fieldMask.operatorRuntimeStats,
+            prestoTaskStats.pipelines[i]);
+      }
+      pipelineStatsSignatures_[i] = pipelineSignature;
     }
   } // velox task's pipelines loop
+  lastInfoIncludedPipelines_ = includePipelineStats;
+  lastInfoPipelineOpRuntimeStats_ = fieldMask.operatorRuntimeStats;
 
   updateOperatorRuntimeStats(prestoTaskStatus.state, prestoTaskStats);
-  updateTaskRuntimeStats(
-      prestoTaskStatus.state,
-      taskRuntimeStats,
-      /*tryToSkipIfRunning=*/true,
-      prestoTaskStats);
+  if (fieldMask.taskRuntimeStats) {
+    updateTaskRuntimeStats(
+        prestoTaskStatus.state,
+        taskRuntimeStats,
+        /*tryToSkipIfRunning=*/true,
+        prestoTaskStats);
+  }
 }
 
 /*static*/ std::string PrestoTask::taskStatesToString(
@@ -13,8 +13,12 @@
  */
 #pragma once
 
+#include <deque>
+#include <map>
 #include <memory>
 #include <unordered_set>
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
 #include "presto_cpp/main/http/HttpServer.h"
 #include "presto_cpp/main/types/PrestoTaskId.h"
 #include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
@@ -24,8 +28,15 @@ namespace facebook::velox {
 struct RuntimeMetric;
 }
 
+namespace facebook::presto::thrift {
+class TaskStatus;
+}
+
 namespace facebook::presto {
 
+struct FragmentResultCacheEntry;
+class FragmentResultCapture;
+
 /// Velox Task does not have Planned state, so we add this enum to have this
 /// state.
 enum class PrestoTaskState : int {
@@ -97,6 +108,133 @@ struct ResultRequest {
         maxSize(_maxSize) {}
 };
 
+/// Selects which parts of the TaskInfo stats tree an info response carries.
+/// Parsed from the 'fields' query parameter of the task info endpoint; a
+/// request without the parameter gets everything, so the 'summarize' flag
+/// alone keeps deciding as before. Groups not named by the request are left
+/// empty in the returned TaskInfo and their conversion work is skipped.
+struct TaskInfoFieldMask {
+  /// Include the per-pipeline / per-operator stats tree.
+  bool pipelines{true};
+
+  /// Include the per-operator runtimeStats maps inside the pipeline entries.
+  /// Only meaningful when 'pipelines' is set.
+  bool operatorRuntimeStats{true};
+
+  /// Include the task-level runtimeStats map.
+  bool taskRuntimeStats{true};
+
+  bool operator==(const TaskInfoFieldMask& other) const {
+    return pipelines == other.pipelines &&
+        operatorRuntimeStats == other.operatorRuntimeStats &&
+        taskRuntimeStats == other.taskRuntimeStats;
+  }
+
+  /// Parses the comma-separated 'fields' query parameter value. Supported
+  /// groups are 'pipelines', 'pipelines/operators/runtimeStats' (implies
+  /// 'pipelines') and 'runtimeStats'; groups not named are omitted. Throws a
+  /// user error on an unknown group.
+  static TaskInfoFieldMask fromFieldsParam(const std::string& fields);
+};
+
+/// Server-side prefetch state of one output buffer. While a getResults
+/// response streams out, the next page sequence is speculatively dequeued
+/// from the output buffer so a back-to-back getResults request is served
+/// without waiting on a dequeue. Protected by the presto task's 'mutex'.
+struct ResultsPrefetchState {
+  /// Sequence a speculative dequeue is in flight for, or -1 if none.
+  int64_t prefetchSequence{-1};
+
+  /// Completed speculative dequeue waiting for its getResults request.
+  std::unique_ptr<Result> nextResult;
+
+  /// Copy of the most recently served result. The speculative dequeue of
+  /// the next sequence acknowledges the served pages in the output buffer,
+  /// so a retry after a failed transfer is answered from this copy.
+  std::unique_ptr<Result> lastResult;
+
+  /// Request that arrived for 'prefetchSequence' while the speculative
+  /// dequeue was still in flight; fulfilled directly when it completes.
+  PromiseHolderWeakPtr<std::unique_ptr<Result>> pendingPromise;
+};
+
+/// Pacing statistics of one output buffer consumer. Each downstream task
+/// fetches results through its own buffer ID, so per-buffer numbers describe
+/// one consumer. Protected by the presto task's 'mutex'.
+struct ResultFetchPacing {
+  /// Number of getResults requests observed, including long polls that
+  /// returned no data.
+  int64_t numFetches{0};
+
+  /// Total bytes served to this consumer.
+  int64_t totalBytes{0};
+
+  /// Time point (ms) when the last getResults request arrived.
+  uint64_t lastFetchMs{0};
+
+  /// Exponential moving average of the gap (ms) between consecutive
+  /// getResults requests. A gap well above the data wait time means the
+  /// consumer, not this task, is the bottleneck.
+  double fetchGapEwmaMs{0};
+};
+
+/// Roll-up of ResultFetchPacing over all consumers of a task, served to the
+/// runtime.tasks system table.
+struct ResultFetchPacingSummary {
+  int64_t numConsumers{0};
+  int64_t numFetches{0};
+  int64_t totalBytes{0};
+
+  /// Largest per-consumer fetch gap EWMA (ms). Back-pressure on the output
+  /// buffer is governed by the slowest consumer.
+  int64_t maxFetchGapMs{0};
+};
+
+/// One closed sampling window of an operator's time-sliced execution stats.
+/// Values are the amounts accumulated during the window, not running totals.
+struct OperatorTimeSlice {
+  /// Start of the window (ms, wall clock), aligned to the window width.
+  uint64_t windowStartMs{0};
+  uint64_t wallNanos{0};
+  uint64_t cpuNanos{0};
+  uint64_t inputRows{0};
+};
+
+/// Two-tier guard against re-sent splits. The coordinator re-sends split
+/// batches on retries, and for the largest scans each re-sent split would
+/// otherwise cost a set lookup in the velox task's sequence tracking. A
+/// bloom filter front-ends an exact set keyed on (plan node, sequence id):
+/// the common not-a-duplicate case is two bit probes, and the exact set is
+/// consulted only on bloom hits. The filter doubles and is rebuilt from the
+/// exact set when it outgrows its bits, so it stays accurate for 500k-split
+/// tasks without being sized for them up front. Protected by the presto
+/// task's 'mutex' like the rest of the split ingestion state.
+class SplitSequenceGuard {
+ public:
+  /// Records the (planNodeId, sequenceId) pair and returns true when it was
+  /// not seen before; false for a re-sent split, which the caller drops
+  /// without handing it to the velox task.
+  bool testAndRecord(
+      const velox::core::PlanNodeId& planNodeId,
+      int64_t sequenceId);
+
+ private:
+  // 1 KB to start with; most tasks see a few thousand splits at most.
+  static constexpr size_t kInitialBloomBits = 8192;
+  // The filter is rebuilt once it holds fewer bits per recorded split,
+  // keeping the false-positive rate in the low percent.
+  static constexpr size_t kBloomBitsPerSplit = 16;
+
+  bool mayContain(uint64_t hash) const;
+  void addToBloom(uint64_t hash);
+
+  // Sequence ids are packed with a small per-node index into the exact keys,
+  // so lookups are collision-free.
+  folly::F14FastMap<velox::core::PlanNodeId, uint32_t> nodeIndices_;
+  std::vector<uint64_t> bloom_;
+  folly::F14FastSet<uint64_t> seen_;
+};
+
 struct PrestoTask {
   const PrestoTaskId id;
   const long startProcessCpuTime;
@@ -131,6 +269,21 @@ struct PrestoTask {
   uint64_t startTimeMs{0};
   uint64_t firstSplitStartTimeMs{0};
   uint64_t lastEndTimeMs{0};
+  /// Absolute wall deadline (ms since epoch) of the query, carried in the
+  /// 'native_query_deadline_ms' session property. Task updates received past
+  /// it are refused and the periodic sweep cancels the task, so an expired
+  /// query releases its resources without waiting for the coordinator's
+  /// deletes. 0 means no deadline.
+  std::atomic<uint64_t> queryDeadlineMs{0};
+
+  /// Set once by the auto-trace sweep when the completed task's runtime and
+  /// peak memory have been fed into the outlier sample window.
+  std::atomic_bool autoTraceSampled{false};
+
+  /// Set once by the auto-trace sweep when the running task has been flagged
+  /// as an outlier, so a long-running task is not re-flagged every sweep.
+  std::atomic_bool autoTraceFlagged{false};
+
   mutable std::mutex mutex;
 
   /// Error before task is created or when task is being created.
@@ -144,9 +297,28 @@ struct PrestoTask {
   /// shared_ptr to define lifetime.
   std::unordered_map<int64_t, std::shared_ptr<ResultRequest>> resultRequests;
 
+  /// Results prefetch state keyed on buffer ID. Only populated when
+  /// 'task.results-prefetch-enabled' is set. Protected by 'mutex'.
+  std::unordered_map<int64_t, ResultsPrefetchState> resultsPrefetch;
+
+  /// Per-consumer result fetch pacing statistics keyed on buffer ID. Updated
+  /// on every getResults request. Protected by 'mutex'.
+  std::unordered_map<int64_t, ResultFetchPacing> resultFetchPacing;
+
+  /// Serialized JSON of the status last reported through the batch status
+  /// endpoint, with a content-hash ETag so unchanged entries are answered
+  /// without a body. Once the status is final it can never change and the
+  /// cached serialization is reused as is. Protected by 'mutex'.
+  std::string batchStatusJson;
+  std::string batchStatusEtag;
+  bool batchStatusFinal{false};
+
   /// Pending status request. May arrive before there is a Task.
   PromiseHolderWeakPtr<std::unique_ptr<protocol::TaskStatus>> statusRequest;
 
+  /// Pending Thrift status request. May arrive before there is a Task.
+  PromiseHolderWeakPtr<std::unique_ptr<thrift::TaskStatus>> thriftStatusRequest;
+
   /// Info request. May arrive before there is a Task.
   PromiseHolderWeakPtr<std::unique_ptr<protocol::TaskInfo>> infoRequest;
 
@@ -154,6 +326,26 @@ struct PrestoTask {
   /// had 'no more splits' message to process them after the task starts.
   std::unordered_set<velox::core::PlanNodeId> delayedNoMoreSplitsPlanNodes_;
 
+  /// Drops splits the coordinator re-sent before they reach the velox task.
+  /// Protected by 'mutex'.
+  SplitSequenceGuard splitSequenceGuard;
+
+  /// Final output pages served straight from the fragment result cache. Set
+  /// instead of creating a velox task when an identical deterministic
+  /// fragment ran before; 'task' stays null for such tasks. Protected by
+  /// 'mutex'.
+  std::shared_ptr<const FragmentResultCacheEntry> cachedResult;
+
+  /// Captures the task's output pages for the fragment result cache. Set
+  /// when a cacheable task misses the cache. Protected by 'mutex'.
+  std::shared_ptr<FragmentResultCapture> resultCapture;
+
+  /// True while this task waits for an identical fragment already running on
+  /// this worker to publish its captured output instead of starting its own
+  /// execution; see 'fragment-result-cache.scan-share-enabled'. Cleared when
+  /// the leader's outcome arrives. Protected by 'mutex'.
+  bool scanShareWaiting{false};
+
   /// @param taskId Task ID.
   /// @param nodeId Node ID.
   /// @param startCpuTime CPU time in nanoseconds recorded when request to
@@ -175,6 +367,42 @@ struct PrestoTask {
   void updateCoordinatorHeartbeat();
   void updateCoordinatorHeartbeatLocked();
 
+  /// Invoked on externally visible task mutations (task update messages, task
+  /// deletion) to force the next updateInfo() call to rebuild the cached
+  /// TaskInfo even if the velox task stats have not moved.
+  void bumpInfoMutation() {
+    infoMutationCount_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Records the arrival of a getResults request for 'bufferId': bumps the
+  /// consumer's fetch count and folds the gap since its previous request into
+  /// the fetch gap EWMA.
+  void recordResultFetch(long bufferId);
+
+  /// Adds 'bytes' served to 'bufferId' to its pacing statistics.
+  void recordResultFetchBytes(long bufferId, int64_t bytes);
+
+  /// Returns the consumer's fetch gap EWMA (ms), or 0 if the consumer has
+  /// made fewer than two requests. Caller must hold 'mutex'.
+  double resultFetchGapMsLocked(long bufferId) const;
+
+  /// Roll-up of the per-consumer result fetch pacing statistics.
+  ResultFetchPacingSummary resultFetchPacingSummary() const;
+
+  /// Folds the wall time, CPU time and input rows each operator accumulated
+  /// since the previous call into the current 'windowMs' wide time slice,
+  /// keeping a bounded per-operator ring of closed slices. Invoked by the
+  /// periodic task stats sweep when 'task.time-sliced-stats-window-ms' is
+  /// positive. Windows in which an operator made no progress are not
+  /// recorded, so long idle stretches cost no memory.
+  void recordTimeSlicedStats(uint64_t windowMs);
+
+  /// Returns the recorded time slices as a Chrome trace ("flame chart")
+  /// JSON object: one complete event per operator per window, with the
+  /// window's wall time as the event duration and the CPU time and input
+  /// rows in the event args. Loadable as is in trace viewers.
+  folly::dynamic timeSlicedStatsJson() const;
+
   /// Returns time (ms) since the task was touched last time (last heartbeat).
   /// Returns zero, if never (shouldn't happen).
   uint64_t timeSinceLastHeartbeatMs() const;
@@ -190,9 +418,20 @@ struct PrestoTask {
     return updateStatusLocked();
   }
 
-  protocol::TaskInfo updateInfo(bool summarize) {
+  /// Thrift variant of updateStatus() for the high-frequency Thrift status
+  /// polling path. Refreshes the task status from the velox task state and
+  /// populates 'thriftStatus' directly, without making a copy of the protocol
+  /// status struct.
+  void updateStatusThrift(thrift::TaskStatus& thriftStatus) {
     std::lock_guard<std::mutex> l(mutex);
-    return updateInfoLocked(summarize);
+    updateStatusThriftLocked(thriftStatus);
+  }
+
+  protocol::TaskInfo updateInfo(
+      bool summarize,
+      const TaskInfoFieldMask& fieldMask = {}) {
+    std::lock_guard<std::mutex> l(mutex);
+    return updateInfoLocked(summarize, fieldMask);
   }
 
   /// Turns the task numbers (per state) into a string.
@@ -201,7 +440,14 @@ struct PrestoTask {
 
   /// Invoked to update presto task status from the updated velox task stats.
   protocol::TaskStatus updateStatusLocked();
-  protocol::TaskInfo updateInfoLocked(bool summarize);
+  void updateStatusThriftLocked(thrift::TaskStatus& thriftStatus);
+  protocol::TaskInfo updateInfoLocked(
+      bool summarize,
+      const TaskInfoFieldMask& fieldMask = {});
+
+  /// Refreshes 'info.taskStatus' in place from the velox task state without
+  /// making a copy. Must be called with 'mutex' held.
+  void refreshStatusLocked();
 
   folly::dynamic toJson() const;
 
@@ -217,11 +463,16 @@ struct PrestoTask {
       uint64_t currentTimeMs,
       std::unordered_map<std::string, velox::RuntimeMetric>& taskRuntimeStats);
 
+  /// 'minimalStats' skips the per-operator and per-driver runtime metric
+  /// conversion and keeps only state, row counts and the task-level time
+  /// totals. Used for short-running queries that opted into tiered stats.
   void updateExecutionInfoLocked(
       const velox::exec::TaskStats& veloxTaskStats,
       const protocol::TaskStatus& prestoTaskStatus,
       std::unordered_map<std::string, velox::RuntimeMetric>& taskRuntimeStats,
-      bool includePipelineStats);
+      bool includePipelineStats,
+      bool minimalStats,
+      const TaskInfoFieldMask& fieldMask);
 
   void updateMemoryInfoLocked(
       const velox::exec::TaskStats& veloxTaskStats,
@@ -229,6 +480,48 @@ struct PrestoTask {
       std::unordered_map<std::string, velox::RuntimeMetric>& taskRuntimeStats);
 
   long processCpuTime_{0};
+
+  // Version of the cached 'info': the mutation count and velox task stats
+  // signature observed at the last full rebuild. updateInfoLocked() serves
+  // 'info' as is while both are unchanged to avoid rebuilding the stats tree
+  // on every coordinator poll.
+  std::atomic<uint64_t> infoMutationCount_{0};
+  uint64_t lastInfoMutationCount_{0};
+  size_t lastInfoStatsSignature_{0};
+  bool lastInfoSummarize_{false};
+  TaskInfoFieldMask lastInfoFieldMask_;
+  // True when the cached 'info' was built in minimal stats mode; a rebuild is
+  // forced when the task crosses the full-stats runtime threshold.
+  bool lastInfoMinimalStats_{false};
+  bool infoCacheValid_{false};
+
+  // Per-pipeline signatures from the last info rebuild that included the
+  // pipeline stats tree. updateExecutionInfoLocked() keeps the converted
+  // protocol entry of a pipeline whose signature has not moved instead of
+  // rebuilding it, so a rebuild only pays for pipelines that made progress.
+  std::vector<size_t> pipelineStatsSignatures_;
+  bool lastInfoIncludedPipelines_{false};
+  // True when the cached pipeline entries carry per-operator runtime stats;
+  // entries built under a different field mask cannot be reused.
+  bool lastInfoPipelineOpRuntimeStats_{true};
+
+  // True once the GPU/CPU operator time split of a finished task has been
+  // recorded; the final stats are cumulative, so the split is reported once.
+  bool gpuOperatorTimeRecorded_{false};
+
+  // Time-sliced stats history of one operator plus the cumulative counters
+  // observed at the last sweep, from which the next window's deltas are
+  // computed.
+  struct OperatorSliceHistory {
+    uint64_t lastWallNanos{0};
+    uint64_t lastCpuNanos{0};
+    uint64_t lastInputRows{0};
+    std::deque<OperatorTimeSlice> slices;
+  };
+
+  // Keyed by "<pipelineId>.<operatorId>.<operatorType>"; ordered so the
+  // exported events follow the plan layout. Protected by 'mutex'.
+  std::map<std::string, OperatorSliceHistory> timeSlicedStats_;
 };
 
 using TaskMap =
@@ -13,6 +13,7 @@
  */
 
 #include "presto_cpp/main/PrestoToVeloxQueryConfig.h"
+#include <folly/Synchronized.h>
 #include "presto_cpp/main/SessionProperties.h"
 #include "presto_cpp/main/common/Configs.h"
 #include "velox/common/compression/Compression.h"
@@ -65,10 +66,11 @@ void updateFromSessionConfigs(
           velox::common::stringToCompressionKind(compression);
       queryConfigs[velox::core::QueryConfig::kShuffleCompressionKind] =
           velox::common::compressionKindToString(compressionKind);
-    } else if (!sessionProperties->hasVeloxConfig(it.first)) {
-      sessionProperties->updateSessionPropertyValue(it.first, it.second);
+    } else if (
+        const auto* veloxConfig = sessionProperties->veloxConfigName(it.first)) {
+      queryConfigs[*veloxConfig] = it.second;
     } else {
-      queryConfigs[sessionProperties->toVeloxConfig(it.first)] = it.second;
+      sessionProperties->updateSessionPropertyValue(it.first, it.second);
     }
   }
 
@@ -212,15 +214,36 @@ void updateFromSystemConfigs(
        .veloxConfig = velox::core::QueryConfig::kExchangeLazyFetchingEnabled},
   };
 
-  for (const auto& configMapping : veloxToPrestoConfigMapping) {
-    const auto& veloxConfigName = configMapping.veloxConfig;
-    const auto& systemConfigName = configMapping.prestoSystemConfig;
-    const auto propertyOpt = systemConfig->optionalProperty(systemConfigName);
-    if (propertyOpt.has_value()) {
-      queryConfigs[veloxConfigName] =
-          configMapping.toVeloxPropertyValueConverter(propertyOpt.value());
+  // The system-config portion of the query config is identical for every
+  // query, so it is frozen once and rebuilt only when the config generation
+  // changes (a setProperty or reloadProperties server operation). Building a
+  // query config then copies the frozen block instead of re-reading and
+  // re-converting every property.
+  struct FrozenBlock {
+    uint64_t generation;
+    std::unordered_map<std::string, std::string> configs;
+  };
+  static folly::Synchronized<std::shared_ptr<const FrozenBlock>> frozenBlock;
+
+  const auto generation = systemConfig->generation();
+  auto block = frozenBlock.copy();
+  if (block == nullptr || block->generation != generation) {
+    auto rebuilt = std::make_shared<FrozenBlock>();
+    rebuilt->generation = generation;
+    for (const auto& configMapping : veloxToPrestoConfigMapping) {
+      const auto& veloxConfigName = configMapping.veloxConfig;
+      const auto& systemConfigName = configMapping.prestoSystemConfig;
+      const auto propertyOpt = systemConfig->optionalProperty(systemConfigName);
+      if (propertyOpt.has_value()) {
+        rebuilt->configs[veloxConfigName] =
+            configMapping.toVeloxPropertyValueConverter(propertyOpt.value());
+      }
     }
+    *frozenBlock.wlock() = rebuilt;
+    block = std::move(rebuilt);
   }
+
+  queryConfigs.insert(block->configs.begin(), block->configs.end());
 }
 } // namespace
 
@@ -242,21 +265,41 @@ std::unordered_map<std::string, std::string> toVeloxConfigs(
 velox::core::QueryConfig toVeloxConfigs(
     const protocol::SessionRepresentation& session,
     const std::map<std::string, std::string>& extraCredentials) {
+  return velox::core::QueryConfig(toVeloxConfigsMap(session, extraCredentials));
+}
+
+std::unordered_map<std::string, std::string> toVeloxConfigsMap(
+    const protocol::SessionRepresentation& session,
+    const std::map<std::string, std::string>& extraCredentials) {
   // Start with the session-based configuration
   auto configs = toVeloxConfigs(session);
 
-  // If there are any extra credentials, add them all to the config
+  // If there are any extra credentials, add them all to the config so they
+  // can be consumed by UDFs and connectors.
   if (!extraCredentials.empty()) {
-    // Create new config map with all extra credentials added
     configs.insert(extraCredentials.begin(), extraCredentials.end());
   }
-  return velox::core::QueryConfig(configs);
+  return configs;
 }
 
 std::unordered_map<std::string, std::shared_ptr<velox::config::ConfigBase>>
 toConnectorConfigs(const protocol::TaskUpdateRequest& taskUpdateRequest) {
   std::unordered_map<std::string, std::shared_ptr<velox::config::ConfigBase>>
       connectorConfigs;
+  for (auto& entry : toConnectorConfigsMap(taskUpdateRequest)) {
+    connectorConfigs.insert(
+        {entry.first,
+         std::make_shared<velox::config::ConfigBase>(
+             std::move(entry.second))});
+  }
+
+  return connectorConfigs;
+}
+
+std::unordered_map<std::string, std::unordered_map<std::string, std::string>>
+toConnectorConfigsMap(const protocol::TaskUpdateRequest& taskUpdateRequest) {
+  std::unordered_map<std::string, std::unordered_map<std::string, std::string>>
+      connectorConfigs;
   for (const auto& entry : taskUpdateRequest.session.catalogProperties) {
     std::unordered_map<std::string, std::string> connectorConfig;
     // remove native prefix from native connector session property names
@@ -276,10 +319,7 @@ toConnectorConfigs(const protocol::TaskUpdateRequest& taskUpdateRequest) {
     if (taskUpdateRequest.session.schema) {
       connectorConfig.insert({"schema", *taskUpdateRequest.session.schema});
     }
-    connectorConfigs.insert(
-        {entry.first,
-         std::make_shared<velox::config::ConfigBase>(
-             std::move(connectorConfig))});
+    connectorConfigs.insert({entry.first, std::move(connectorConfig)});
   }
 
   return connectorConfigs;
@@ -40,7 +40,18 @@ velox::core::QueryConfig toVeloxConfigs(
     const protocol::SessionRepresentation& session,
     const std::map<std::string, std::string>& extraCredentials);
 
+/// Raw config map variant of the QueryConfig overload above, for callers
+/// that cache or inspect the map before wrapping it in a QueryConfig.
+std::unordered_map<std::string, std::string> toVeloxConfigsMap(
+    const protocol::SessionRepresentation& session,
+    const std::map<std::string, std::string>& extraCredentials);
+
 std::unordered_map<std::string, std::shared_ptr<velox::config::ConfigBase>>
 toConnectorConfigs(const protocol::TaskUpdateRequest& taskUpdateRequest);
 
+/// Raw per-catalog config map variant of toConnectorConfigs(), for callers
+/// that cache or inspect the maps before wrapping them in ConfigBase.
+std::unordered_map<std::string, std::unordered_map<std::string, std::string>>
+toConnectorConfigsMap(const protocol::TaskUpdateRequest& taskUpdateRequest);
+
 } // namespace facebook::presto
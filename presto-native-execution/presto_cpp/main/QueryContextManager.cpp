@@ -14,9 +14,14 @@
 
 #include "presto_cpp/main/QueryContextManager.h"
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/hash/Hash.h>
+#include "presto_cpp/main/AutoTraceRegistry.h"
 #include "presto_cpp/main/PrestoToVeloxQueryConfig.h"
 #include "presto_cpp/main/SessionProperties.h"
 #include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/core/QueryConfig.h"
 
@@ -47,6 +52,7 @@ std::shared_ptr<velox::core::QueryCtx> QueryContextCache::get(
     // Move the queryId to front, if queryCtx is still alive.
     queryIds_.push_front(queryId);
     iter->second.idListIterator = queryIds_.begin();
+    RECORD_METRIC_VALUE(kCounterQueryContextCacheHits);
     return queryCtx;
   }
   queryCtxs_.erase(iter);
@@ -59,6 +65,7 @@ std::shared_ptr<velox::core::QueryCtx> QueryContextCache::insert(
   if (queryCtxs_.size() >= capacity_) {
     evict();
   }
+  RECORD_METRIC_VALUE(kCounterQueryContextCacheMisses);
   queryIds_.push_front(queryId);
   queryCtxs_[queryId] = {
       folly::to_weak_ptr(queryCtx), queryIds_.begin(), false};
@@ -81,6 +88,158 @@ void QueryContextCache::setTasksStarted(const protocol::QueryId& queryId) {
   }
 }
 
+// static
+std::string PlanFragmentCache::makeKey(
+    const protocol::QueryId& queryId,
+    const std::string& serializedFragment,
+    const std::shared_ptr<protocol::TableWriteInfo>& tableWriteInfo) {
+  size_t hash = std::hash<std::string>{}(serializedFragment);
+  if (tableWriteInfo != nullptr) {
+    const protocol::json tableWriteInfoJson = *tableWriteInfo;
+    hash = folly::hash::hash_combine(
+        hash, std::hash<std::string>{}(tableWriteInfoJson.dump()));
+  }
+  return fmt::format("{}:{}", queryId, hash);
+}
+
+std::optional<velox::core::PlanFragment> PlanFragmentCache::get(
+    const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = fragments_.find(key);
+  if (it == fragments_.end()) {
+    return std::nullopt;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+  return it->second.fragment;
+}
+
+void PlanFragmentCache::put(
+    const std::string& key,
+    const velox::core::PlanFragment& fragment) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fragments_.contains(key)) {
+    // Another task of the same stage raced us; keep the existing entry.
+    return;
+  }
+  if (fragments_.size() >= kCapacity) {
+    fragments_.erase(lru_.back());
+    lru_.pop_back();
+  }
+  lru_.push_front(key);
+  fragments_.emplace(key, CachedFragment{fragment, lru_.begin()});
+}
+
+// static
+std::string InternedFragmentCache::digestFor(const std::string& fragment) {
+  return fmt::format("{:016x}", std::hash<std::string>{}(fragment));
+}
+
+std::optional<InternedFragmentCache::Interned> InternedFragmentCache::get(
+    const std::string& digest,
+    uint64_t ttlMs) {
+  const auto nowMs = velox::getCurrentTimeMs();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(digest);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  if (nowMs - it->second.insertMs >= ttlMs) {
+    lru_.erase(it->second.lruPosition);
+    entries_.erase(it);
+    return std::nullopt;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+  return it->second.interned;
+}
+
+void InternedFragmentCache::put(
+    const std::string& digest,
+    std::shared_ptr<std::string> fragment,
+    std::shared_ptr<protocol::json> parsed) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entries_.contains(digest)) {
+    // Another task of the same stage raced us; keep the existing entry.
+    return;
+  }
+  if (entries_.size() >= kCapacity) {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+  lru_.push_front(digest);
+  entries_.emplace(
+      digest,
+      Entry{
+          Interned{std::move(fragment), std::move(parsed)},
+          velox::getCurrentTimeMs(),
+          lru_.begin()});
+}
+
+// static
+std::string SessionConfigCache::digestFor(
+    const protocol::SessionRepresentation& session,
+    const std::map<std::string, std::string>& extraCredentials) {
+  // Canonical rendering of every session field the config conversion reads,
+  // except the per-query start time. Protocol maps are ordered, so equal
+  // sessions render identically.
+  std::string canonical;
+  canonical.reserve(256);
+  const auto append = [&canonical](const std::string& part) {
+    canonical.append(part);
+    canonical.push_back('\0');
+  };
+  append(session.user);
+  append(session.source ? *session.source : "");
+  append(session.schema ? *session.schema : "");
+  for (const auto& tag : session.clientTags) {
+    append(tag);
+  }
+  append(std::to_string(session.timeZoneKey));
+  for (const auto& property : session.systemProperties) {
+    append(property.first);
+    append(property.second);
+  }
+  for (const auto& catalog : session.catalogProperties) {
+    append(catalog.first);
+    for (const auto& property : catalog.second) {
+      append(property.first);
+      append(property.second);
+    }
+  }
+  for (const auto& credential : extraCredentials) {
+    append(credential.first);
+    append(credential.second);
+  }
+  // System config properties feed the conversion too; the generation counter
+  // is bumped on every runtime property update.
+  append(std::to_string(SystemConfig::instance()->generation()));
+  return fmt::format("{:016x}", std::hash<std::string>{}(canonical));
+}
+
+std::optional<SessionConfigCache::CachedConfigs> SessionConfigCache::get(
+    const std::string& digest) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(digest);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+  return it->second.configs;
+}
+
+void SessionConfigCache::put(const std::string& digest, CachedConfigs configs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entries_.contains(digest)) {
+    // Another query with the same session raced us; keep the existing entry.
+    return;
+  }
+  if (entries_.size() >= kCapacity) {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+  lru_.push_front(digest);
+  entries_.emplace(digest, Entry{std::move(configs), lru_.begin()});
+}
+
 void QueryContextCache::evict() {
   // Evict least recently used queryCtx if it is not referenced elsewhere.
   for (auto victim = queryIds_.end(); victim != queryIds_.begin();) {
@@ -88,6 +247,7 @@ void QueryContextCache::evict() {
     if (!queryCtxs_[*victim].queryCtx.lock()) {
       queryCtxs_.erase(*victim);
       queryIds_.erase(victim);
+      RECORD_METRIC_VALUE(kCounterQueryContextCacheEvictions);
       return;
     }
   }
@@ -99,18 +259,55 @@ void QueryContextCache::evict() {
 QueryContextManager::QueryContextManager(
     folly::Executor* driverExecutor,
     folly::Executor* spillerExecutor)
-    : driverExecutor_(driverExecutor), spillerExecutor_(spillerExecutor) {}
+    : driverExecutor_(driverExecutor), spillerExecutor_(spillerExecutor) {
+  const auto* systemConfig = SystemConfig::instance();
+  if (spillerExecutor_ != nullptr &&
+      systemConfig->spillerFairSchedulingEnabled()) {
+    // The scheduler needs the pool size: it releases exactly that many tasks
+    // at a time, so held-back work waits in its fair per-query queues
+    // instead of the pool's FIFO.
+    if (auto* pool =
+            dynamic_cast<folly::CPUThreadPoolExecutor*>(spillerExecutor_)) {
+      const uint32_t numThreads = pool->numThreads();
+      auto maxInFlightPerQuery =
+          systemConfig->spillerFairSchedulingMaxInFlightPerQuery();
+      if (maxInFlightPerQuery == 0) {
+        maxInFlightPerQuery = std::max<uint32_t>(1, numThreads / 2);
+      }
+      spillScheduler_ = std::make_shared<SpillExecutorScheduler>(
+          spillerExecutor_, numThreads, maxInFlightPerQuery);
+    }
+  }
+}
 
 std::shared_ptr<velox::core::QueryCtx>
 QueryContextManager::findOrCreateQueryCtx(
     const protocol::TaskId& taskId,
     const protocol::TaskUpdateRequest& taskUpdateRequest) {
+  const QueryId queryId{queryIdFromTaskId(taskId)};
+  {
+    std::lock_guard<std::mutex> lock(queryContextCacheMutex_);
+    if (auto queryCtx = queryContextCache_.get(queryId)) {
+      return queryCtx;
+    }
+  }
+
+  // Build the context components without holding the cache mutex, so the
+  // first tasks of concurrent queries do not convoy behind each other's
+  // config conversion and memory pool setup.
+  auto components = buildQueryCtxComponents(queryId, taskUpdateRequest);
+
   std::lock_guard<std::mutex> lock(queryContextCacheMutex_);
-  return findOrCreateQueryCtxLocked(
-      taskId,
-      toVeloxConfigs(
-          taskUpdateRequest.session, taskUpdateRequest.extraCredentials),
-      toConnectorConfigs(taskUpdateRequest));
+  if (auto queryCtx = queryContextCache_.get(queryId)) {
+    // Another task of the same query created the context first; drop our
+    // components. The uniquely named root pool is simply released.
+    return queryCtx;
+  }
+  return createAndCacheQueryCtxLocked(
+      queryId,
+      std::move(components.queryConfig),
+      std::move(components.connectorConfigs),
+      std::move(components.pool));
 }
 
 std::shared_ptr<velox::core::QueryCtx>
@@ -118,11 +315,7 @@ QueryContextManager::findOrCreateBatchQueryCtx(
     const protocol::TaskId& taskId,
     const protocol::TaskUpdateRequest& taskUpdateRequest) {
   std::lock_guard<std::mutex> lock(queryContextCacheMutex_);
-  auto queryCtx = findOrCreateQueryCtxLocked(
-      taskId,
-      toVeloxConfigs(
-          taskUpdateRequest.session, taskUpdateRequest.extraCredentials),
-      toConnectorConfigs(taskUpdateRequest));
+  auto queryCtx = findOrCreateQueryCtxLocked(taskId, taskUpdateRequest);
   if (queryCtx->pool()->aborted()) {
     // In Batch mode, only one query is running at a time. When tasks fail
     // during memory arbitration, the query memory pool will be set
@@ -134,11 +327,7 @@ QueryContextManager::findOrCreateBatchQueryCtx(
     // continue execution.
     VELOX_CHECK_EQ(queryContextCache_.size(), 1);
     queryContextCache_.clear();
-    queryCtx = findOrCreateQueryCtxLocked(
-        taskId,
-        toVeloxConfigs(
-            taskUpdateRequest.session, taskUpdateRequest.extraCredentials),
-        toConnectorConfigs(taskUpdateRequest));
+    queryCtx = findOrCreateQueryCtxLocked(taskId, taskUpdateRequest);
   }
   return queryCtx;
 }
@@ -162,26 +351,108 @@ QueryContextManager::createAndCacheQueryCtxLocked(
     std::unordered_map<std::string, std::shared_ptr<config::ConfigBase>>&&
         connectorConfigs,
     std::shared_ptr<memory::MemoryPool>&& pool) {
+  folly::Executor* spillExecutor = spillerExecutor_;
+  if (spillScheduler_ != nullptr) {
+    spillExecutor = spillScheduler_->queryExecutor(queryId);
+  }
   auto queryCtx = core::QueryCtx::create(
       driverExecutor_,
       std::move(queryConfig),
       std::move(connectorConfigs),
       cache::AsyncDataCache::getInstance(),
       std::move(pool),
-      spillerExecutor_,
+      spillExecutor,
       queryId);
+  if (spillScheduler_ != nullptr) {
+    // The facade must outlive the context that holds it; the context's
+    // expiry lets the scheduler reclaim the query's state.
+    spillScheduler_->bindQuery(queryId, queryCtx);
+  }
   return queryContextCache_.insert(queryId, std::move(queryCtx));
 }
 
-std::shared_ptr<core::QueryCtx> QueryContextManager::findOrCreateQueryCtxLocked(
-    const TaskId& taskId,
-    velox::core::QueryConfig&& queryConfig,
-    std::unordered_map<std::string, std::shared_ptr<config::ConfigBase>>&&
-        connectorConfigs) {
-  const QueryId queryId{queryIdFromTaskId(taskId)};
+QueryContextManager::QueryCtxComponents
+QueryContextManager::buildQueryCtxComponents(
+    const QueryId& queryId,
+    const protocol::TaskUpdateRequest& taskUpdateRequest) {
+  const auto startTimeMs = getCurrentTimeMs();
+  const auto& session = taskUpdateRequest.session;
 
-  if (auto queryCtx = queryContextCache_.get(queryId)) {
-    return queryCtx;
+  // Convert the session into velox query and connector configs only on a
+  // cache miss. Every task of a query carries the same session, so tasks
+  // after the first reuse the cached context without rebuilding the full
+  // config maps. With the session config cache enabled, queries issued with
+  // identical sessions additionally share the conversion output across
+  // queries and only overlay their per-query session start time.
+  std::string sessionDigest;
+  std::optional<SessionConfigCache::CachedConfigs> cachedConfigs;
+  if (SystemConfig::instance()->querySessionConfigCacheEnabled()) {
+    sessionDigest = SessionConfigCache::digestFor(
+        session, taskUpdateRequest.extraCredentials);
+    cachedConfigs = sessionConfigCache_.get(sessionDigest);
+    if (cachedConfigs.has_value()) {
+      RECORD_METRIC_VALUE(kCounterSessionConfigCacheHits);
+    } else {
+      RECORD_METRIC_VALUE(kCounterSessionConfigCacheMisses);
+    }
+  }
+
+  std::unordered_map<std::string, std::string> queryConfigsMap;
+  std::unordered_map<std::string, std::unordered_map<std::string, std::string>>
+      connectorConfigsMap;
+  if (cachedConfigs.has_value()) {
+    queryConfigsMap = std::move(cachedConfigs->queryConfigs);
+    connectorConfigsMap = std::move(cachedConfigs->connectorConfigs);
+    // The session start time is the one per-query entry; overlay it on the
+    // shared block.
+    if (session.startTime) {
+      queryConfigsMap[core::QueryConfig::kSessionStartTime] =
+          std::to_string(session.startTime);
+    }
+  } else {
+    queryConfigsMap =
+        toVeloxConfigsMap(session, taskUpdateRequest.extraCredentials);
+    connectorConfigsMap = toConnectorConfigsMap(taskUpdateRequest);
+    if (!sessionDigest.empty()) {
+      SessionConfigCache::CachedConfigs toCache;
+      toCache.queryConfigs = queryConfigsMap;
+      toCache.queryConfigs.erase(core::QueryConfig::kSessionStartTime);
+      toCache.connectorConfigs = connectorConfigsMap;
+      sessionConfigCache_.put(sessionDigest, std::move(toCache));
+    }
+  }
+
+  // A session source promoted by the slow-task sweep runs its next queries
+  // with operator input tracing, so the recurrence of an incident leaves
+  // replayable artifacts. Applied after the session config cache, so the
+  // time-bounded promotion never leaks into cached config blocks, and only
+  // when the session did not ask for tracing itself.
+  const auto* systemConfig = SystemConfig::instance();
+  if (systemConfig->taskAutoTraceEnabled() && session.source &&
+      queryConfigsMap.count(core::QueryConfig::kQueryTraceEnabled) == 0 &&
+      AutoTraceRegistry::instance()->isPromoted(
+          *session.source, getCurrentTimeMs())) {
+    const auto traceDir = systemConfig->taskAutoTraceDir();
+    if (!traceDir.empty()) {
+      queryConfigsMap[core::QueryConfig::kQueryTraceEnabled] = "true";
+      queryConfigsMap[core::QueryConfig::kQueryTraceDir] =
+          fmt::format("{}/{}", traceDir, queryId);
+      queryConfigsMap[core::QueryConfig::kQueryTraceMaxBytes] =
+          std::to_string(systemConfig->taskAutoTraceMaxBytesPerQuery());
+      queryConfigsMap[core::QueryConfig::kQueryTraceTaskRegExp] = ".*";
+      LOG(INFO) << "Auto-trace enabled for query " << queryId
+                << " of promoted source '" << *session.source << "'.";
+    }
+  }
+
+  core::QueryConfig queryConfig{std::move(queryConfigsMap)};
+  std::unordered_map<std::string, std::shared_ptr<config::ConfigBase>>
+      connectorConfigs;
+  connectorConfigs.reserve(connectorConfigsMap.size());
+  for (auto& entry : connectorConfigsMap) {
+    connectorConfigs.emplace(
+        entry.first,
+        std::make_shared<config::ConfigBase>(std::move(entry.second)));
   }
 
   // NOTE: the monotonically increasing 'poolId' is appended to 'queryId' to
@@ -205,11 +476,27 @@ std::shared_ptr<core::QueryCtx> QueryContextManager::findOrCreateQueryCtxLocked(
       nullptr,
       poolDbgOpts);
 
+  RECORD_METRIC_VALUE(
+      kCounterQueryContextCreationTimeMs, getCurrentTimeMs() - startTimeMs);
+  return QueryCtxComponents{
+      std::move(queryConfig), std::move(connectorConfigs), std::move(pool)};
+}
+
+std::shared_ptr<core::QueryCtx> QueryContextManager::findOrCreateQueryCtxLocked(
+    const TaskId& taskId,
+    const protocol::TaskUpdateRequest& taskUpdateRequest) {
+  const QueryId queryId{queryIdFromTaskId(taskId)};
+
+  if (auto queryCtx = queryContextCache_.get(queryId)) {
+    return queryCtx;
+  }
+
+  auto components = buildQueryCtxComponents(queryId, taskUpdateRequest);
   return createAndCacheQueryCtxLocked(
       queryId,
-      std::move(queryConfig),
-      std::move(connectorConfigs),
-      std::move(pool));
+      std::move(components.queryConfig),
+      std::move(components.connectorConfigs),
+      std::move(components.pool));
 }
 
 void QueryContextManager::visitAllContexts(
@@ -16,11 +16,15 @@
 #include <folly/Synchronized.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
 
+#include "presto_cpp/main/SpillExecutorScheduler.h"
 #include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
+#include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 
 namespace facebook::presto {
@@ -72,6 +76,148 @@ class QueryContextCache {
   QueryIdList queryIds_;
 };
 
+/// LRU cache of velox plan fragments converted from Presto plan fragments.
+/// Tasks of the same stage all carry an identical serialized fragment, so the
+/// conversion result can be shared across them instead of re-running the
+/// converter per task. Entries are keyed by query id plus a hash of the
+/// serialized fragment and table write info, so a fragment is only reused
+/// under the query context it was converted with. Callers must not cache
+/// fragments whose conversion depends on the task id (AssignUniqueId).
+class PlanFragmentCache {
+ public:
+  /// Builds the cache key for converting 'serializedFragment' under
+  /// 'queryId'. 'tableWriteInfo' may be nullptr.
+  static std::string makeKey(
+      const protocol::QueryId& queryId,
+      const std::string& serializedFragment,
+      const std::shared_ptr<protocol::TableWriteInfo>& tableWriteInfo);
+
+  /// Returns the cached fragment for 'key' and marks it most recently used.
+  std::optional<velox::core::PlanFragment> get(const std::string& key);
+
+  /// Inserts 'fragment' under 'key', evicting the least recently used entry
+  /// when the cache is full. Keeps the existing entry when another task
+  /// raced the insert.
+  void put(const std::string& key, const velox::core::PlanFragment& fragment);
+
+ private:
+  static constexpr size_t kCapacity = 128;
+
+  struct CachedFragment {
+    velox::core::PlanFragment fragment;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  std::mutex mutex_;
+  // Most recently used key at the front.
+  std::list<std::string> lru_;
+  std::unordered_map<std::string, CachedFragment> fragments_;
+};
+
+/// TTL-bounded LRU cache of parsed plan fragments keyed by a content digest.
+/// Tasks of the same stage carry byte-identical serialized fragments, so the
+/// JSON parse of a multi-megabyte fragment only has to run once per stage;
+/// later tasks reuse the parsed form. Entries keep the fragment as sent on
+/// the wire, so an update that references a known digest without a body can
+/// proceed as if the fragment had been resent. Digests are opaque: a
+/// coordinator-supplied digest is trusted as-is and a worker-computed one is
+/// derived from the wire bytes, so the two never mix for one fragment.
+/// Expired entries are dropped on access; capacity bounds the memory held
+/// between accesses.
+class InternedFragmentCache {
+ public:
+  /// A fragment interned under some digest: the serialized form as it
+  /// appeared in the update request and its parsed JSON.
+  struct Interned {
+    std::shared_ptr<std::string> fragment;
+    std::shared_ptr<protocol::json> parsed;
+  };
+
+  /// Computes the worker-local digest of 'fragment' wire bytes, used when
+  /// the request did not supply one.
+  static std::string digestFor(const std::string& fragment);
+
+  /// Returns the fragment interned under 'digest' if it is younger than
+  /// 'ttlMs' and marks it most recently used. Erases it if it expired.
+  std::optional<Interned> get(const std::string& digest, uint64_t ttlMs);
+
+  /// Interns 'fragment' and its parse under 'digest', evicting the least
+  /// recently used entry when the cache is full. Keeps the existing entry
+  /// when another task raced the insert.
+  void put(
+      const std::string& digest,
+      std::shared_ptr<std::string> fragment,
+      std::shared_ptr<protocol::json> parsed);
+
+ private:
+  // Parsed fragments can run to tens of megabytes each, so the capacity is
+  // far smaller than the plan conversion cache's; the TTL is the primary
+  // bound.
+  static constexpr size_t kCapacity = 16;
+
+  struct Entry {
+    Interned interned;
+    uint64_t insertMs;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  std::mutex mutex_;
+  // Most recently used digest at the front.
+  std::list<std::string> lru_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+/// LRU cache of session-to-velox config conversions keyed by a digest of
+/// the config-relevant session content. Queries issued with identical
+/// sessions - dashboards, retries, templated workloads - produce identical
+/// config maps, so the conversion only runs for the first of them; later
+/// queries copy the cached maps and overlay their per-query session start
+/// time. The per-query fields (query id, start time) are excluded from both
+/// the digest and the cached maps, and entries hold plain string maps so
+/// every query builds its own config objects; nothing mutable is shared
+/// between queries.
+class SessionConfigCache {
+ public:
+  /// The conversion output for one session: the velox query config map
+  /// without the per-query session start time and the raw per-catalog
+  /// connector config maps.
+  struct CachedConfigs {
+    std::unordered_map<std::string, std::string> queryConfigs;
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>>
+        connectorConfigs;
+  };
+
+  /// Computes the digest of the config-relevant content of 'session' and
+  /// 'extraCredentials'. Covers every session field the config conversion
+  /// reads except the per-query start time, plus the system config
+  /// generation so runtime property updates invalidate cached conversions.
+  static std::string digestFor(
+      const protocol::SessionRepresentation& session,
+      const std::map<std::string, std::string>& extraCredentials);
+
+  /// Returns the conversion cached under 'digest' and marks it most
+  /// recently used.
+  std::optional<CachedConfigs> get(const std::string& digest);
+
+  /// Caches 'configs' under 'digest', evicting the least recently used
+  /// entry when the cache is full. Keeps the existing entry when another
+  /// query raced the insert.
+  void put(const std::string& digest, CachedConfigs configs);
+
+ private:
+  static constexpr size_t kCapacity = 128;
+
+  struct Entry {
+    CachedConfigs configs;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  std::mutex mutex_;
+  // Most recently used digest at the front.
+  std::list<std::string> lru_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
 class QueryContextManager {
  public:
   QueryContextManager(
@@ -80,6 +226,10 @@ class QueryContextManager {
 
   virtual ~QueryContextManager() = default;
 
+  /// Returns the cached query context for the task's query, or builds one
+  /// from the session. Session-to-config conversion and root memory pool
+  /// setup run outside the cache mutex so that the first tasks of concurrent
+  /// queries do not serialize behind each other's context construction.
   std::shared_ptr<velox::core::QueryCtx> findOrCreateQueryCtx(
       const protocol::TaskId& taskId,
       const protocol::TaskUpdateRequest& taskUpdateRequest);
@@ -103,12 +253,45 @@ class QueryContextManager {
   /// Test method to clear the query context cache.
   void clearCache();
 
+  /// Cache of converted plan fragments shared by the tasks of a stage; see
+  /// 'task.plan-conversion-cache-enabled'.
+  PlanFragmentCache& planFragmentCache() {
+    return planFragmentCache_;
+  }
+
+  /// Cache of parsed plan fragments interned by content digest; see
+  /// 'task.fragment-interning-enabled'.
+  InternedFragmentCache& internedFragmentCache() {
+    return internedFragmentCache_;
+  }
+
+  /// Cache of session-to-velox config conversions shared by queries with
+  /// identical sessions; see 'query.session-config-cache-enabled'.
+  SessionConfigCache& sessionConfigCache() {
+    return sessionConfigCache_;
+  }
+
  protected:
   folly::Executor* const driverExecutor_{nullptr};
   folly::Executor* const spillerExecutor_{nullptr};
   QueryContextCache queryContextCache_;
 
  private:
+  // Session-derived pieces of a new query context: velox query config,
+  // connector configs and the query's root memory pool. Building them does
+  // not touch the context cache, so it can run without holding
+  // 'queryContextCacheMutex_'.
+  struct QueryCtxComponents {
+    velox::core::QueryConfig queryConfig;
+    std::unordered_map<std::string, std::shared_ptr<velox::config::ConfigBase>>
+        connectorConfigs;
+    std::shared_ptr<velox::memory::MemoryPool> pool;
+  };
+
+  QueryCtxComponents buildQueryCtxComponents(
+      const protocol::QueryId& queryId,
+      const protocol::TaskUpdateRequest& taskUpdateRequest);
+
   virtual std::shared_ptr<velox::core::QueryCtx> createAndCacheQueryCtxLocked(
       const protocol::QueryId& queryId,
       velox::core::QueryConfig&& queryConfig,
@@ -117,14 +300,25 @@ class QueryContextManager {
           std::shared_ptr<velox::config::ConfigBase>>&& connectorConfigs,
       std::shared_ptr<velox::memory::MemoryPool>&& pool);
 
+  // Returns the cached query context for the task's query if one is alive.
+  // Converts the session into velox query and connector configs and creates a
+  // new context otherwise.
   std::shared_ptr<velox::core::QueryCtx> findOrCreateQueryCtxLocked(
       const protocol::TaskId& taskId,
-      velox::core::QueryConfig&& queryConfig,
-      std::unordered_map<
-          std::string,
-          std::shared_ptr<velox::config::ConfigBase>>&& connectorConfigStrings);
+      const protocol::TaskUpdateRequest& taskUpdateRequest);
 
   mutable std::mutex queryContextCacheMutex_;
+
+  PlanFragmentCache planFragmentCache_;
+
+  InternedFragmentCache internedFragmentCache_;
+
+  SessionConfigCache sessionConfigCache_;
+
+  // Fair per-query front-end for the spiller executor; null unless
+  // 'spiller.fair-scheduling-enabled' is set and spilling is on. Query
+  // contexts receive their per-query facade instead of the shared pool.
+  std::shared_ptr<SpillExecutorScheduler> spillScheduler_;
 };
 
 } // namespace facebook::presto
@@ -16,33 +16,49 @@
 
 namespace facebook::presto {
 
-const folly::F14FastMap<std::string, ServerOperation::Action>
+const folly::F14FastMap<std::string_view, ServerOperation::Action>
     ServerOperation::kActionLookup{
         {"clearCache", ServerOperation::Action::kClearCache},
         {"getCacheStats", ServerOperation::Action::kGetCacheStats},
         {"writeSsd", ServerOperation::Action::kWriteSSD},
         {"setProperty", ServerOperation::Action::kSetProperty},
         {"getProperty", ServerOperation::Action::kGetProperty},
+        {"reloadProperties", ServerOperation::Action::kReloadProperties},
         {"getDetail", ServerOperation::Action::kGetDetail},
         {"listAll", ServerOperation::Action::kListAll},
+        {"getQueryCpu", ServerOperation::Action::kGetQueryCpu},
+        {"getQueryQueueTime", ServerOperation::Action::kGetQueryQueueTime},
         {"trace", ServerOperation::Action::kTrace},
         {"setState", ServerOperation::Action::kSetState},
-        {"announcer", ServerOperation::Action::kAnnouncer}};
+        {"announcer", ServerOperation::Action::kAnnouncer},
+        {"getAllocatorStats", ServerOperation::Action::kGetAllocatorStats},
+        {"getExchangeTrace", ServerOperation::Action::kGetExchangeTrace},
+        {"getPeerLatency", ServerOperation::Action::kGetPeerLatency},
+        {"drain", ServerOperation::Action::kDrain},
+        {"profile", ServerOperation::Action::kProfile}};
 
-const folly::F14FastMap<ServerOperation::Action, std::string>
+const folly::F14FastMap<ServerOperation::Action, std::string_view>
     ServerOperation::kReverseActionLookup{
         {ServerOperation::Action::kClearCache, "clearCache"},
         {ServerOperation::Action::kGetCacheStats, "getCacheStats"},
         {ServerOperation::Action::kWriteSSD, "writeSsd"},
         {ServerOperation::Action::kSetProperty, "setProperty"},
         {ServerOperation::Action::kGetProperty, "getProperty"},
+        {ServerOperation::Action::kReloadProperties, "reloadProperties"},
         {ServerOperation::Action::kGetDetail, "getDetail"},
         {ServerOperation::Action::kListAll, "listAll"},
+        {ServerOperation::Action::kGetQueryCpu, "getQueryCpu"},
+        {ServerOperation::Action::kGetQueryQueueTime, "getQueryQueueTime"},
         {ServerOperation::Action::kTrace, "trace"},
         {ServerOperation::Action::kSetState, "setState"},
-        {ServerOperation::Action::kAnnouncer, "announcer"}};
+        {ServerOperation::Action::kAnnouncer, "announcer"},
+        {ServerOperation::Action::kGetAllocatorStats, "getAllocatorStats"},
+        {ServerOperation::Action::kGetExchangeTrace, "getExchangeTrace"},
+        {ServerOperation::Action::kGetPeerLatency, "getPeerLatency"},
+        {ServerOperation::Action::kDrain, "drain"},
+        {ServerOperation::Action::kProfile, "profile"}};
 
-const folly::F14FastMap<std::string, ServerOperation::Target>
+const folly::F14FastMap<std::string_view, ServerOperation::Target>
     ServerOperation::kTargetLookup{
         {"connector", ServerOperation::Target::kConnector},
         {"systemConfig", ServerOperation::Target::kSystemConfig},
@@ -50,7 +66,7 @@ const folly::F14FastMap<std::string, ServerOperation::Target>
         {"task", ServerOperation::Target::kTask},
         {"server", ServerOperation::Target::kServer}};
 
-const folly::F14FastMap<ServerOperation::Target, std::string>
+const folly::F14FastMap<ServerOperation::Target, std::string_view>
     ServerOperation::kReverseTargetLookup{
         {ServerOperation::Target::kConnector, "connector"},
         {ServerOperation::Target::kSystemConfig, "systemConfig"},
@@ -59,7 +75,7 @@ const folly::F14FastMap<ServerOperation::Target, std::string>
         {ServerOperation::Target::kServer, "server"}};
 
 ServerOperation::Target ServerOperation::targetFromString(
-    const std::string& str) {
+    std::string_view str) {
   auto it = kTargetLookup.find(str);
   if (it == kTargetLookup.end()) {
     VELOX_USER_FAIL("Unsupported server operation target '{}'", str);
@@ -67,7 +83,7 @@ ServerOperation::Target ServerOperation::targetFromString(
   return it->second;
 }
 
-std::string ServerOperation::targetString(ServerOperation::Target target) {
+std::string_view ServerOperation::targetString(ServerOperation::Target target) {
   auto it = kReverseTargetLookup.find(target);
   if (it == kReverseTargetLookup.end()) {
     VELOX_FAIL();
@@ -76,7 +92,7 @@ std::string ServerOperation::targetString(ServerOperation::Target target) {
 }
 
 ServerOperation::Action ServerOperation::actionFromString(
-    const std::string& str) {
+    std::string_view str) {
   auto it = kActionLookup.find(str);
   if (it == kActionLookup.end()) {
     VELOX_USER_FAIL("Unsupported server operation action '{}'", str);
@@ -84,7 +100,7 @@ ServerOperation::Action ServerOperation::actionFromString(
   return it->second;
 }
 
-std::string ServerOperation::actionString(Action action) {
+std::string_view ServerOperation::actionString(Action action) {
   auto it = kReverseActionLookup.find(action);
   if (it == kReverseActionLookup.end()) {
     VELOX_FAIL();
@@ -92,12 +108,14 @@ std::string ServerOperation::actionString(Action action) {
   return it->second;
 }
 
-ServerOperation buildServerOpFromHttpMsgPath(const std::string& httpMsgPath) {
-  static const auto targetPos = std::string("/v1/operation/").length();
+ServerOperation buildServerOpFromHttpMsgPath(std::string_view httpMsgPath) {
+  static constexpr auto targetPos = std::string_view("/v1/operation/").length();
   auto actionPos = httpMsgPath.find('/', targetPos);
-  VELOX_USER_CHECK_NE(actionPos, std::string::npos);
+  VELOX_USER_CHECK_NE(actionPos, std::string_view::npos);
   // Go beyond '/' to point to the first letter of action
   actionPos += 1;
+  // string_view substrings alias the request path; no temporary strings are
+  // made on the dispatch path.
   auto target = httpMsgPath.substr(targetPos, actionPos - 1 - targetPos);
   auto action = httpMsgPath.substr(actionPos);
 
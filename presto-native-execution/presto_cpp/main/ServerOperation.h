@@ -14,7 +14,7 @@
 #pragma once
 
 #include <folly/container/F14Map.h>
-#include <string>
+#include <string_view>
 
 namespace facebook::presto {
 
@@ -44,10 +44,20 @@ struct ServerOperation {
     /// Applicable to kSystemConfig & kVeloxQueryConfig. Returns the value of a
     /// single property.
     kGetProperty,
+    /// Applicable to kSystemConfig. Re-reads the config file and applies
+    /// changed values of the runtime-tunable properties; startup-frozen
+    /// properties are reported and left untouched.
+    kReloadProperties,
     /// Applicable to kTask. Returns detailed info on one Task.
     kGetDetail,
     /// Applicable to kTask. Returns brief info on all Tasks.
     kListAll,
+    /// Applicable to kTask. Returns per-query CPU usage rolled up from task
+    /// stats, heaviest recent consumer first.
+    kGetQueryCpu,
+    /// Applicable to kTask. Returns per-query driver executor queued-driver
+    /// time, heaviest recent queuer first.
+    kGetQueryQueueTime,
     /// Applicable to kServer. Returns data on all TraceContext objets.
     kTrace,
     /// Applicable to kServer. Change state of the worker node.
@@ -56,23 +66,48 @@ struct ServerOperation {
     kAnnouncer,
     /// Applicable to kServer. Write in-memory cache data to SSD.
     kWriteSSD,
+    /// Applicable to kServer. Returns allocator (jemalloc) stats alongside the
+    /// totals the worker tracks itself, to attribute the gap between tracked
+    /// memory and RSS.
+    kGetAllocatorStats,
+    /// Applicable to kServer. Returns (or clears with 'clear=true') the
+    /// sampled exchange request timing trace; see
+    /// 'exchange.trace-sample-every-n'.
+    kGetExchangeTrace,
+    /// Applicable to kServer. Returns (or clears with 'clear=true') the
+    /// per-peer latency/error breakdown of the exchange endpoints.
+    kGetPeerLatency,
+    /// Applicable to kServer. Starts (or, when already draining, reports on) a
+    /// graceful drain: the node is marked inactive so the coordinator stops
+    /// scheduling new tasks here, and the response lists the remaining tasks
+    /// with driver progress, an ETA and the output bytes still buffered, so
+    /// the caller can decide to wait or restart them elsewhere.
+    kDrain,
+    /// Applicable to kServer. On-demand CPU sampling: 'command=start' begins
+    /// a profile (optionally scoped with 'queryId', at 'freqHz', cut off
+    /// after 'maxSeconds' or 'maxSamples'), 'command=stop' returns the
+    /// collapsed-stack profile and 'command=status' (the default) reports
+    /// progress.
+    kProfile,
   };
 
-  static const folly::F14FastMap<std::string, Target> kTargetLookup;
-  static const folly::F14FastMap<Target, std::string> kReverseTargetLookup;
-  static const folly::F14FastMap<std::string, Action> kActionLookup;
-  static const folly::F14FastMap<Action, std::string> kReverseActionLookup;
+  /// The lookups key on string_view so parsing a request path does not copy
+  /// the target and action names; the views point at string literals.
+  static const folly::F14FastMap<std::string_view, Target> kTargetLookup;
+  static const folly::F14FastMap<Target, std::string_view> kReverseTargetLookup;
+  static const folly::F14FastMap<std::string_view, Action> kActionLookup;
+  static const folly::F14FastMap<Action, std::string_view> kReverseActionLookup;
 
-  static Target targetFromString(const std::string& str);
-  static std::string targetString(Target target);
-  static Action actionFromString(const std::string& str);
-  static std::string actionString(Action action);
+  static Target targetFromString(std::string_view str);
+  static std::string_view targetString(Target target);
+  static Action actionFromString(std::string_view str);
+  static std::string_view actionString(Action action);
 
   Target target;
   Action action;
 };
 
 /// Builds a server operation from an HTTP request. Throws upon build failure.
-ServerOperation buildServerOpFromHttpMsgPath(const std::string& httpMsgPath);
+ServerOperation buildServerOpFromHttpMsgPath(std::string_view httpMsgPath);
 
 } // namespace facebook::presto
@@ -12,6 +12,7 @@
  * limitations under the License.
  */
 #include "presto_cpp/main/SessionProperties.h"
+#include "presto_cpp/main/operators/ShuffleWrite.h"
 #include "velox/core/QueryConfig.h"
 
 using namespace facebook::velox;
@@ -39,6 +40,9 @@ void SessionProperties::addSessionProperty(
     const std::string& defaultValue) {
   sessionProperties_[name] = std::make_shared<SessionProperty>(
       name, description, type->toString(), isHidden, veloxConfig, defaultValue);
+  if (veloxConfig.has_value()) {
+    veloxConfigNames_[name] = veloxConfig.value();
+  }
 }
 
 // List of native session properties is kept as the source of truth here.
@@ -425,6 +429,27 @@ SessionProperties::SessionProperties() {
       QueryConfig::kPrefixSortMinRows,
       std::to_string(c.prefixSortMinRows()));
 
+  addSessionProperty(
+      kShuffleWriteCombineThresholdBytes,
+      "Native Execution only. The minimum number of bytes staged per shuffle "
+      "destination before the ShuffleWrite operator hands the rows to the "
+      "shuffle in one batch. Zero disables write combining and writes each "
+      "row as it arrives.",
+      BIGINT(),
+      false,
+      operators::kShuffleWriteCombineThresholdBytes,
+      std::to_string(0));
+
+  addSessionProperty(
+      kShuffleWriteCombineMaxAgeMs,
+      "Native Execution only. The maximum time in milliseconds rows may wait "
+      "in ShuffleWrite write-combining staging before they are flushed "
+      "regardless of size.",
+      BIGINT(),
+      false,
+      operators::kShuffleWriteCombineMaxAgeMs,
+      std::to_string(operators::kShuffleWriteCombineMaxAgeMsDefault));
+
   addSessionProperty(
       kScaleWriterRebalanceMaxMemoryUsageRatio,
       "The max ratio of a query used memory to its max capacity, "
@@ -596,6 +621,66 @@ SessionProperties::SessionProperties() {
       std::nullopt,
       "true");
 
+  addSessionProperty(
+      kSplitIngestionSplitsPerSecond,
+      "Caps the rate, in splits per second, at which the query's splits are "
+      "ingested on workers with the fair split ingestion scheduler enabled. "
+      "Zero means no cap; split batches are still interleaved fairly with "
+      "those of other queries.",
+      BIGINT(),
+      false,
+      // Passes through to the velox query config under its own name; the
+      // worker's TaskManager reads it from there.
+      std::string(kSplitIngestionSplitsPerSecond),
+      "0");
+
+  addSessionProperty(
+      kTaskMinimalStatsEnabled,
+      "If this is true, task info updates on the worker report only state, "
+      "row counts and task-level time totals while the task runs, skipping "
+      "the per-operator runtime metric conversion. Full stats resume once "
+      "the task runtime passes native_task_full_stats_threshold_ms and are "
+      "always reported in final states.",
+      BOOLEAN(),
+      false,
+      // Passes through to the velox query config under its own name; the
+      // worker's PrestoTask reads it from there.
+      std::string(kTaskMinimalStatsEnabled),
+      "false");
+
+  addSessionProperty(
+      kTaskFullStatsThresholdMs,
+      "Task runtime, in milliseconds, after which a query that enabled "
+      "native_task_minimal_stats_enabled escalates to full per-operator "
+      "stats.",
+      BIGINT(),
+      false,
+      std::string(kTaskFullStatsThresholdMs),
+      "1000");
+
+  addSessionProperty(
+      kBroadcastJoinTableCachingEnabled,
+      "If this is true, hash tables built for broadcast joins are cached on "
+      "the worker and reused instead of every task rebuilding the same table. "
+      "Defaults to the broadcast-join-table-caching-enabled system config.",
+      BOOLEAN(),
+      false,
+      std::nullopt,
+      boolToString(c.broadcastJoinTableCachingEnabled()));
+
+  addSessionProperty(
+      kScanFilterFusionEnabled,
+      "If this is true, a filter directly on top of a table scan is folded "
+      "into the scan's remaining filter during plan conversion, removing the "
+      "standalone filter operator. Only applies to scans whose connector "
+      "table handle supports filter pushdown.",
+      BOOLEAN(),
+      false,
+      // Passes through to the velox query config under its own name; the
+      // plan converter reads it from there.
+      std::string(kScanFilterFusionEnabled),
+      "false");
+
   addSessionProperty(
       kAggregationCompactionBytesThreshold,
       "Memory threshold in bytes for triggering string compaction during global "
@@ -648,4 +733,12 @@ bool SessionProperties::useVeloxGeospatialJoin() const {
   VELOX_UNREACHABLE();
 }
 
+bool SessionProperties::broadcastJoinTableCachingEnabled() const {
+  auto it = sessionProperties_.find(kBroadcastJoinTableCachingEnabled);
+  if (it != sessionProperties_.end()) {
+    return it->second->getValue() == "true";
+  }
+  VELOX_UNREACHABLE();
+}
+
 } // namespace facebook::presto
@@ -303,6 +303,19 @@ class SessionProperties {
   static constexpr const char* kShuffleCompressionCodec =
       "exchange_compression_codec";
 
+  /// The minimum number of bytes staged per shuffle destination before the
+  /// ShuffleWrite operator hands the rows to the shuffle in one batch.
+  /// Raises the median shuffle write size when the partition count is
+  /// large. Zero disables write combining and writes each row as it
+  /// arrives.
+  static constexpr const char* kShuffleWriteCombineThresholdBytes =
+      "native_shuffle_write_combine_threshold_bytes";
+
+  /// The maximum time in milliseconds rows may wait in ShuffleWrite
+  /// write-combining staging before they are flushed regardless of size.
+  static constexpr const char* kShuffleWriteCombineMaxAgeMs =
+      "native_shuffle_write_combine_max_age_ms";
+
   /// If set to true, enables scaled processing for table scans.
   static constexpr const char* kTableScanScaledProcessingEnabled =
       "native_table_scan_scaled_processing_enabled";
@@ -383,6 +396,42 @@ class SessionProperties {
   static constexpr const char* kUseVeloxGeospatialJoin =
       "native_use_velox_geospatial_join";
 
+  /// If this is true, hash tables built for broadcast joins are cached on the
+  /// worker and reused instead of every task rebuilding the same table.
+  /// Defaults to the broadcast-join-table-caching-enabled system config, so
+  /// workloads that repeatedly broadcast the same dimension tables can opt in
+  /// per query.
+  static constexpr const char* kBroadcastJoinTableCachingEnabled =
+      "native_broadcast_join_table_caching_enabled";
+
+  /// Caps the rate, in splits per second, at which the query's splits are
+  /// ingested on workers with the fair split ingestion scheduler enabled.
+  /// Zero (the default) means no cap; the query's split batches are still
+  /// interleaved fairly with those of other queries.
+  static constexpr const char* kSplitIngestionSplitsPerSecond =
+      "native_split_ingestion_splits_per_second";
+
+  /// If this is true, task info updates report only state, row counts and
+  /// task-level time totals while the task runs, skipping the per-operator
+  /// runtime metric conversion. Full stats resume once the task's runtime
+  /// passes native_task_full_stats_threshold_ms and are always reported in
+  /// final states. Meant for high-QPS tiers of short-running queries.
+  static constexpr const char* kTaskMinimalStatsEnabled =
+      "native_task_minimal_stats_enabled";
+
+  /// Task runtime, in milliseconds, after which a query that enabled
+  /// native_task_minimal_stats_enabled escalates to full per-operator stats.
+  static constexpr const char* kTaskFullStatsThresholdMs =
+      "native_task_full_stats_threshold_ms";
+
+  /// If this is true, a filter that sits directly on top of a table scan is
+  /// folded into the scan's remaining filter during plan conversion, removing
+  /// the standalone filter operator and the intermediate vectors between the
+  /// two. Only applies to scans whose connector table handle supports filter
+  /// pushdown.
+  static constexpr const char* kScanFilterFusionEnabled =
+      "native_scan_filter_fusion_enabled";
+
   /// Memory threshold in bytes for triggering string compaction during global
   /// aggregation. When total string storage exceeds this limit with high unused
   /// memory ratio, compaction is triggered to reclaim dead strings. Disabled by
@@ -427,10 +476,27 @@ class SessionProperties {
   /// Velox. Returns 'name' as is if there is no mapping.
   const std::string toVeloxConfig(const std::string& name) const;
 
+  /// Single-lookup, zero-allocation variant of the translation used on the
+  /// per-task session conversion path. Returns the velox config name for
+  /// 'name', 'name' itself if the property is unknown to the registry (such
+  /// properties pass through unchanged), or nullptr if the property is a
+  /// native session property with no velox config equivalent.
+  inline const std::string* veloxConfigName(const std::string& name) const {
+    auto it = veloxConfigNames_.find(name);
+    if (it != veloxConfigNames_.end()) {
+      return &it->second;
+    }
+    // Rare path: distinguish unknown properties from registered properties
+    // that have no velox config equivalent.
+    return sessionProperties_.count(name) == 0 ? &name : nullptr;
+  }
+
   json serialize() const;
 
   bool useVeloxGeospatialJoin() const;
 
+  bool broadcastJoinTableCachingEnabled() const;
+
  private:
   void addSessionProperty(
       const std::string& name,
@@ -442,6 +508,11 @@ class SessionProperties {
 
   std::unordered_map<std::string, std::shared_ptr<SessionProperty>>
       sessionProperties_;
+
+  // Presto property name to velox config name for properties that have a
+  // velox equivalent. Built at registration time so translating a session
+  // property costs one lookup with no string construction.
+  std::unordered_map<std::string, std::string> veloxConfigNames_;
 };
 
 } // namespace facebook::presto
@@ -0,0 +1,160 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/SpillExecutorScheduler.h"
+
+#include <folly/ScopeGuard.h>
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::presto {
+
+SpillExecutorScheduler::SpillExecutorScheduler(
+    folly::Executor* executor,
+    uint32_t maxInFlight,
+    uint32_t maxInFlightPerQuery)
+    : executor_(executor),
+      maxInFlight_(std::max<uint32_t>(1, maxInFlight)),
+      maxInFlightPerQuery_(std::max<uint32_t>(1, maxInFlightPerQuery)) {}
+
+folly::Executor* SpillExecutorScheduler::queryExecutor(
+    const std::string& queryId) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& state = queries_[queryId];
+  if (state.executor == nullptr) {
+    state.executor = std::make_unique<QueryExecutor>(this, queryId);
+  }
+  return state.executor.get();
+}
+
+void SpillExecutorScheduler::bindQuery(
+    const std::string& queryId,
+    std::weak_ptr<const void> owner) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = queries_.find(queryId);
+  if (it != queries_.end()) {
+    it->second.owner = std::move(owner);
+    it->second.bound = true;
+  }
+  // A new query arriving is the natural point to reclaim finished ones.
+  sweepLocked();
+}
+
+void SpillExecutorScheduler::shutdown() {
+  std::lock_guard<std::mutex> l(mutex_);
+  shutdown_ = true;
+  // Keep the facades: a query context may still hold its executor pointer
+  // during teardown. Only the queued work is dropped.
+  for (auto& [_, state] : queries_) {
+    state.tasks.clear();
+  }
+}
+
+size_t SpillExecutorScheduler::numQueuedTasks() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  size_t numTasks{0};
+  for (const auto& [_, state] : queries_) {
+    numTasks += state.tasks.size();
+  }
+  return numTasks;
+}
+
+size_t SpillExecutorScheduler::numQueries() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return queries_.size();
+}
+
+void SpillExecutorScheduler::enqueue(
+    const std::string& queryId,
+    folly::Func func) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (shutdown_) {
+    return;
+  }
+  auto it = queries_.find(queryId);
+  // The facade that forwarded here lives in the state, so it must exist.
+  if (it == queries_.end()) {
+    return;
+  }
+  it->second.tasks.push_back({std::move(func), velox::getCurrentTimeMs()});
+  dispatchLocked();
+}
+
+void SpillExecutorScheduler::dispatchLocked() {
+  while (totalInFlight_ < maxInFlight_) {
+    Task task;
+    std::string queryId;
+    bool found{false};
+    auto it = queries_.lower_bound(dispatchCursor_);
+    for (size_t scanned = 0; scanned < queries_.size(); ++scanned) {
+      if (it == queries_.end()) {
+        it = queries_.begin();
+      }
+      auto& state = it->second;
+      if (!state.tasks.empty() && state.inFlight < maxInFlightPerQuery_) {
+        task = std::move(state.tasks.front());
+        state.tasks.pop_front();
+        ++state.inFlight;
+        queryId = it->first;
+        found = true;
+        ++it;
+        dispatchCursor_ = it == queries_.end() ? std::string() : it->first;
+        break;
+      }
+      ++it;
+    }
+    if (!found) {
+      return;
+    }
+    ++totalInFlight_;
+    auto self = shared_from_this();
+    executor_->add([self,
+                    queryId = std::move(queryId),
+                    func = std::move(task.func),
+                    enqueueTimeMs = task.enqueueTimeMs]() mutable {
+      RECORD_HISTOGRAM_METRIC_VALUE(
+          kCounterSpillerFairQueueWaitMs,
+          velox::getCurrentTimeMs() - enqueueTimeMs);
+      // The slot is freed even when the task throws, matching what the pool
+      // would do with a directly submitted task.
+      auto guard =
+          folly::makeGuard([&]() { self->onTaskFinished(queryId); });
+      func();
+    });
+  }
+}
+
+void SpillExecutorScheduler::onTaskFinished(const std::string& queryId) {
+  std::lock_guard<std::mutex> l(mutex_);
+  --totalInFlight_;
+  auto it = queries_.find(queryId);
+  if (it != queries_.end()) {
+    --it->second.inFlight;
+  }
+  dispatchLocked();
+}
+
+void SpillExecutorScheduler::sweepLocked() {
+  for (auto it = queries_.begin(); it != queries_.end();) {
+    const auto& state = it->second;
+    if (state.bound && state.owner.expired() && state.tasks.empty() &&
+        state.inFlight == 0) {
+      it = queries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+} // namespace facebook::presto
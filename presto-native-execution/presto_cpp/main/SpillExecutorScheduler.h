@@ -0,0 +1,124 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Executor.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace facebook::presto {
+
+/// Fair front-end for the shared spiller executor. Each query gets its own
+/// facade executor whose tasks are queued per query and released to the
+/// underlying pool round-robin, holding at most a few of each query's tasks
+/// in flight, so one massive spill cannot occupy every spill thread while
+/// other queries' arbitration-triggered spills starve behind it. Tasks of
+/// the same query run in submission order of release, like they would on the
+/// shared pool's FIFO queue.
+class SpillExecutorScheduler
+    : public std::enable_shared_from_this<SpillExecutorScheduler> {
+ public:
+  /// 'maxInFlight' bounds the tasks released to 'executor' across all
+  /// queries and should match its thread count: releasing more would rebuild
+  /// the unfair FIFO inside the pool, releasing fewer would idle spill
+  /// threads. 'maxInFlightPerQuery' caps one query's share of the pool while
+  /// other queries have work pending or arriving.
+  SpillExecutorScheduler(
+      folly::Executor* executor,
+      uint32_t maxInFlight,
+      uint32_t maxInFlightPerQuery);
+
+  /// Returns the facade executor funneling 'queryId''s spill work through
+  /// the scheduler, creating it on first use. The pointer stays valid until
+  /// the owner bound with bindQuery() expires and the query's work drains.
+  folly::Executor* queryExecutor(const std::string& queryId);
+
+  /// Ties the lifetime of 'queryId''s scheduler state, including its facade
+  /// executor, to 'owner': once it expires and the query has no queued or
+  /// in-flight work, the state is reclaimed by a later sweep.
+  void bindQuery(const std::string& queryId, std::weak_ptr<const void> owner);
+
+  /// Drops all queued tasks and makes further submissions no-ops. Tasks
+  /// already released to the pool still run.
+  void shutdown();
+
+  /// Number of tasks queued across all queries, excluding in-flight ones.
+  /// Used by tests.
+  size_t numQueuedTasks() const;
+
+  /// Number of queries holding scheduler state. Used by tests.
+  size_t numQueries() const;
+
+ private:
+  // Facade handed to a query context as its spill executor; forwards into
+  // the owning scheduler's per-query queue.
+  class QueryExecutor : public folly::Executor {
+   public:
+    QueryExecutor(SpillExecutorScheduler* scheduler, std::string queryId)
+        : scheduler_(scheduler), queryId_(std::move(queryId)) {}
+
+    void add(folly::Func func) override {
+      scheduler_->enqueue(queryId_, std::move(func));
+    }
+
+   private:
+    SpillExecutorScheduler* const scheduler_;
+    const std::string queryId_;
+  };
+
+  struct Task {
+    folly::Func func;
+    uint64_t enqueueTimeMs;
+  };
+
+  struct QueryState {
+    std::unique_ptr<QueryExecutor> executor;
+    std::deque<Task> tasks;
+    uint32_t inFlight{0};
+    // Expired means the query context is gone and the state can be swept
+    // once idle. Treated as alive until bindQuery() runs.
+    std::weak_ptr<const void> owner;
+    bool bound{false};
+  };
+
+  void enqueue(const std::string& queryId, folly::Func func);
+
+  // Releases queued tasks to the pool round-robin until the in-flight caps
+  // are reached.
+  void dispatchLocked();
+
+  // Called on the pool when a released task finishes; frees its in-flight
+  // slot and releases more work.
+  void onTaskFinished(const std::string& queryId);
+
+  // Erases states of expired queries with no queued or in-flight work.
+  void sweepLocked();
+
+  folly::Executor* const executor_;
+  const uint32_t maxInFlight_;
+  const uint32_t maxInFlightPerQuery_;
+
+  mutable std::mutex mutex_;
+  // Ordered so the round-robin cursor survives queries coming and going.
+  std::map<std::string, QueryState> queries_;
+  std::string dispatchCursor_;
+  uint32_t totalInFlight_{0};
+  bool shutdown_{false};
+};
+
+} // namespace facebook::presto
@@ -0,0 +1,75 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/SplitAffinityTracker.h"
+
+#include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::presto {
+
+SplitAffinityTracker::SplitAffinityTracker(uint64_t maxSplits)
+    : maxSplits_(maxSplits) {}
+
+// static
+SplitAffinityTracker* SplitAffinityTracker::instance() {
+  static SplitAffinityTracker tracker(
+      SystemConfig::instance()->taskSplitAffinityTrackingMaxSplits());
+  return &tracker;
+}
+
+bool SplitAffinityTracker::recordSplit(uint64_t hash) {
+  if (maxSplits_ == 0) {
+    return false;
+  }
+  bool hit;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = splits_.find(hash);
+    hit = it != splits_.end();
+    if (hit) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+    } else {
+      if (splits_.size() >= maxSplits_) {
+        splits_.erase(lru_.back());
+        lru_.pop_back();
+      }
+      lru_.push_front(hash);
+      splits_.emplace(hash, lru_.begin());
+    }
+  }
+  if (hit) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    RECORD_METRIC_VALUE(kCounterSplitAffinityHits);
+  } else {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    RECORD_METRIC_VALUE(kCounterSplitAffinityMisses);
+  }
+  return hit;
+}
+
+double SplitAffinityTracker::hitRate() const {
+  const auto hits = hits_.load(std::memory_order_relaxed);
+  const auto misses = misses_.load(std::memory_order_relaxed);
+  const auto total = hits + misses;
+  return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+}
+
+// static
+uint64_t SplitAffinityTracker::splitHash(
+    const velox::connector::ConnectorSplit& split) {
+  return std::hash<std::string>{}(split.toString());
+}
+
+} // namespace facebook::presto
@@ -0,0 +1,72 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/connectors/Connector.h"
+
+namespace facebook::presto {
+
+/// Worker-local record of recently processed split identities, the
+/// bookkeeping side of soft-affinity scheduling: a split seen here before
+/// likely has its data in this worker's local caches, so the coordinator
+/// routing repeat splits back to the same worker turns them into cache hits.
+/// Tracks fixed-size identity hashes in an LRU set bounded by
+/// task.split-affinity-tracking-max-splits (0 disables tracking) and exports
+/// hit/miss counters for the observed repeat rate.
+class SplitAffinityTracker {
+ public:
+  /// Constructs a tracker holding at most 'maxSplits' identities. Exposed for
+  /// testing; production code uses instance().
+  explicit SplitAffinityTracker(uint64_t maxSplits);
+
+  /// Process-wide tracker sized from the system config.
+  static SplitAffinityTracker* instance();
+
+  /// True when tracking is configured on; recordSplit() is a no-op otherwise.
+  bool enabled() const {
+    return maxSplits_ > 0;
+  }
+
+  /// Records the split identified by 'hash', evicting the least recently
+  /// seen identity when full. Returns true when the split was already
+  /// tracked, i.e. a repeat whose data is likely cached locally.
+  bool recordSplit(uint64_t hash);
+
+  /// Fraction of recorded splits that were repeats, in [0, 1]. Zero before
+  /// any split has been recorded.
+  double hitRate() const;
+
+  /// Identity hash of a data split, derived from the connector split
+  /// description (file path and offsets for file based connectors).
+  static uint64_t splitHash(const velox::connector::ConnectorSplit& split);
+
+ private:
+  const uint64_t maxSplits_;
+
+  mutable std::mutex mutex_;
+  // Most recently seen split hash at the front.
+  std::list<uint64_t> lru_;
+  folly::F14FastMap<uint64_t, std::list<uint64_t>::iterator> splits_;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+};
+
+} // namespace facebook::presto
@@ -0,0 +1,165 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/SplitIngestionScheduler.h"
+
+#include <folly/futures/Future.h>
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::presto {
+
+SplitIngestionScheduler::SplitIngestionScheduler(folly::Executor* executor)
+    : executor_(executor) {}
+
+void SplitIngestionScheduler::enqueue(
+    const std::string& queryId,
+    uint64_t numSplits,
+    double splitsPerSecond,
+    IngestFn ingest) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (shutdown_) {
+    return;
+  }
+  auto& state = queries_[queryId];
+  // The latest task update's session value wins.
+  state.splitsPerSecond = splitsPerSecond;
+  state.items.push_back(
+      {numSplits, velox::getCurrentTimeMs(), std::move(ingest)});
+  maybeScheduleDrainLocked();
+}
+
+void SplitIngestionScheduler::shutdown() {
+  std::lock_guard<std::mutex> l(mutex_);
+  shutdown_ = true;
+  // A drain in flight may hold a reference into a queue; it observes
+  // 'shutdown_' on its next turn and clears the queues itself.
+  if (!drainScheduled_) {
+    queries_.clear();
+  }
+}
+
+uint64_t SplitIngestionScheduler::numQueuedSplits() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  uint64_t numSplits{0};
+  for (const auto& [_, state] : queries_) {
+    for (const auto& item : state.items) {
+      numSplits += item.pendingSplits;
+    }
+  }
+  return numSplits;
+}
+
+void SplitIngestionScheduler::maybeScheduleDrainLocked(uint32_t delayMs) {
+  if (drainScheduled_ || shutdown_ || queries_.empty()) {
+    return;
+  }
+  drainScheduled_ = true;
+  auto self = shared_from_this();
+  if (delayMs == 0) {
+    executor_->add([self]() { self->drain(); });
+    return;
+  }
+  folly::futures::sleep(std::chrono::milliseconds(delayMs))
+      .via(executor_)
+      .thenValue([self](folly::Unit) { self->drain(); });
+}
+
+void SplitIngestionScheduler::drain() {
+  for (uint32_t turn = 0; turn < kMaxChunksPerDrain; ++turn) {
+    Item* item{nullptr};
+    uint64_t budget{0};
+    std::string queryId;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (shutdown_) {
+        queries_.clear();
+        drainScheduled_ = false;
+        return;
+      }
+      bool throttledWorkPending{false};
+      auto it = queries_.lower_bound(drainCursor_);
+      for (size_t scanned = 0; scanned < queries_.size() && item == nullptr;
+           ++scanned) {
+        if (it == queries_.end()) {
+          it = queries_.begin();
+        }
+        auto& state = it->second;
+        auto& front = state.items.front();
+        uint64_t allowed =
+            std::min<uint64_t>(kChunkSplits, front.pendingSplits);
+        if (state.splitsPerSecond > 0) {
+          allowed = static_cast<uint64_t>(state.bucket.consumeOrDrain(
+              allowed,
+              state.splitsPerSecond,
+              std::max<double>(state.splitsPerSecond, kChunkSplits)));
+          if (allowed == 0) {
+            throttledWorkPending = true;
+            ++it;
+            continue;
+          }
+        }
+        item = &front;
+        budget = allowed;
+        queryId = it->first;
+        ++it;
+        drainCursor_ = it == queries_.end() ? std::string() : it->first;
+      }
+      if (item == nullptr) {
+        drainScheduled_ = false;
+        if (throttledWorkPending) {
+          maybeScheduleDrainLocked(kThrottledRetryMs);
+        }
+        return;
+      }
+    }
+    // Runs the item outside the lock. The reference stays valid: only the
+    // single drain loop pops items and deque growth does not move elements.
+    uint64_t remaining{0};
+    try {
+      remaining = item->ingest(budget);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Dropping split ingestion item for query " << queryId
+                 << ": " << e.what();
+    }
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (shutdown_) {
+        queries_.clear();
+        drainScheduled_ = false;
+        return;
+      }
+      auto it = queries_.find(queryId);
+      if (it != queries_.end() && !it->second.items.empty()) {
+        auto& front = it->second.items.front();
+        front.pendingSplits = remaining;
+        if (remaining == 0) {
+          RECORD_HISTOGRAM_METRIC_VALUE(
+              kCounterSplitIngestionQueueDelayMs,
+              velox::getCurrentTimeMs() - front.enqueueTimeMs);
+          it->second.items.pop_front();
+          if (it->second.items.empty()) {
+            queries_.erase(it);
+          }
+        }
+      }
+    }
+  }
+  // Yield the executor thread and repost while work remains.
+  std::lock_guard<std::mutex> l(mutex_);
+  drainScheduled_ = false;
+  maybeScheduleDrainLocked();
+}
+
+} // namespace facebook::presto
@@ -0,0 +1,97 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/TokenBucket.h>
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace facebook::presto {
+
+/// Fair, rate-limited scheduler for split ingestion. Each query gets a FIFO
+/// of pending ingestion items and a token bucket; a single drain loop on the
+/// given executor serves the queries round-robin, a bounded chunk of splits
+/// per turn, so one query adding hundreds of thousands of splits cannot
+/// delay split delivery to every other query. Items of the same query are
+/// always ingested in enqueue order.
+class SplitIngestionScheduler
+    : public std::enable_shared_from_this<SplitIngestionScheduler> {
+ public:
+  /// Ingests up to the given number of splits and returns the number of
+  /// splits still pending in the item; the item is retired once it returns
+  /// zero. Invoked from the scheduler's executor, never concurrently.
+  using IngestFn = std::function<uint64_t(uint64_t maxSplits)>;
+
+  explicit SplitIngestionScheduler(folly::Executor* executor);
+
+  /// Queues an item holding 'numSplits' splits for 'queryId'.
+  /// 'splitsPerSecond' caps the query's ingestion rate; zero means no cap,
+  /// leaving the query subject to round-robin interleaving only.
+  void enqueue(
+      const std::string& queryId,
+      uint64_t numSplits,
+      double splitsPerSecond,
+      IngestFn ingest);
+
+  /// Stops the drain loop and drops any queued items.
+  void shutdown();
+
+  /// Number of splits queued across all queries. Used by tests.
+  uint64_t numQueuedSplits() const;
+
+ private:
+  // Splits ingested per round-robin turn; bounds how long one query can
+  // occupy the drain loop before others get served.
+  static constexpr uint64_t kChunkSplits = 1'024;
+  // Turns taken before the drain loop reposts itself to the executor so
+  // ingestion does not monopolize an executor thread.
+  static constexpr uint32_t kMaxChunksPerDrain = 16;
+  // Repost delay when every pending query is out of tokens.
+  static constexpr uint32_t kThrottledRetryMs = 10;
+
+  struct Item {
+    uint64_t pendingSplits;
+    uint64_t enqueueTimeMs;
+    IngestFn ingest;
+  };
+
+  struct QueryState {
+    std::deque<Item> items;
+    folly::DynamicTokenBucket bucket;
+    double splitsPerSecond{0};
+  };
+
+  // Posts the drain loop to the executor if it is not already scheduled.
+  // 'delayMs' defers the post when all pending queries are throttled.
+  void maybeScheduleDrainLocked(uint32_t delayMs = 0);
+
+  void drain();
+
+  folly::Executor* const executor_;
+
+  mutable std::mutex mutex_;
+  // Ordered so the round-robin cursor survives queries coming and going.
+  std::map<std::string, QueryState> queries_;
+  std::string drainCursor_;
+  bool drainScheduled_{false};
+  bool shutdown_{false};
+};
+
+} // namespace facebook::presto
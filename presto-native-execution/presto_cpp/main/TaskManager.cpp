@@ -14,19 +14,35 @@
 
 #include "presto_cpp/main/TaskManager.h"
 
+#include <algorithm>
+#include <numeric>
+#include <thread>
 #include <utility>
 
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
-#include <folly/container/F14Set.h>
+#include <folly/container/F14Map.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/hash/Hash.h>
+#include <folly/json.h>
 #include <velox/core/PlanNode.h>
+#include "presto_cpp/main/ExchangeMaterializer.h"
+#include "presto_cpp/main/SessionProperties.h"
+#include "presto_cpp/main/SplitAffinityTracker.h"
 #include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/common/Counters.h"
 #include "presto_cpp/main/common/Utils.h"
+#include "presto_cpp/main/thrift/ProtocolToThrift.h"
+#include "presto_cpp/presto_protocol/core/TaskStatusSerde.h"
 #include "presto_cpp/main/types/PrestoToVeloxSplit.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/ByteStream.h"
+#include "velox/common/memory/Memory.h"
 #include "velox/common/time/Timer.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
 
 using namespace facebook::velox;
 
@@ -40,13 +56,26 @@ constexpr uint32_t kMaxConcurrentLifespans{16};
 
 namespace {
 
+// Speculative result dequeues are skipped for consumers whose average gap
+// between getResults requests exceeds this. Prefetched pages would only pin
+// memory while waiting for such a consumer to come back.
+constexpr double kSlowConsumerPrefetchGapMs = 1'000;
+
 // We request cancellation for tasks which haven't been accessed by coordinator
-// for a considerable time.
+// for a considerable time, and for tasks whose query deadline elapsed; the
+// latter releases an expired query's resources without waiting for the
+// coordinator's deletes to arrive.
 void cancelAbandonedTasksInternal(const TaskMap& taskMap, int32_t abandonedMs) {
   for (const auto& [id, prestoTask] : taskMap) {
     if (prestoTask->task != nullptr) {
       if (prestoTask->task->isRunning()) {
-        if (prestoTask->timeSinceLastCoordinatorHeartbeatMs() >= abandonedMs) {
+        const auto deadlineMs = prestoTask->queryDeadlineMs.load();
+        if (deadlineMs != 0 && getCurrentTimeMs() > deadlineMs) {
+          LOG(INFO) << "Cancelling task '" << id
+                    << "' past its query deadline.";
+          prestoTask->task->requestCancel();
+        } else if (
+            prestoTask->timeSinceLastCoordinatorHeartbeatMs() >= abandonedMs) {
           LOG(INFO) << "Cancelling abandoned task '" << id << "'.";
           prestoTask->task->requestCancel();
         }
@@ -55,6 +84,27 @@ void cancelAbandonedTasksInternal(const TaskMap& taskMap, int32_t abandonedMs) {
   }
 }
 
+// Session property carrying the query's absolute wall deadline in
+// milliseconds since epoch; see PrestoTask::queryDeadlineMs.
+constexpr folly::StringPiece kQueryDeadlineMs{"native_query_deadline_ms"};
+
+// Session property carrying a comma-separated list of upstream task location
+// URIs the coordinator announces with an early, fragment-only task create, so
+// exchange connections are warmed before the remote splits arrive.
+constexpr folly::StringPiece kPrestartUpstreamLocations{
+    "native_prestart_upstream_locations"};
+
+// Returns the deadline set in 'session', or 0 when the property is absent or
+// does not parse.
+uint64_t sessionQueryDeadlineMs(
+    const protocol::SessionRepresentation& session) {
+  auto it = session.systemProperties.find(kQueryDeadlineMs.str());
+  if (it == session.systemProperties.end()) {
+    return 0;
+  }
+  return folly::tryTo<uint64_t>(it->second).value_or(0);
+}
+
 // If spilling is enabled and the task plan fragment can spill, then this helper
 // generates the disk spilling options for the task.
 std::optional<common::SpillDiskOptions> getTaskSpillOptions(
@@ -138,6 +188,168 @@ std::unique_ptr<Result> createCompleteResult(long token) {
   return result;
 }
 
+// Builds the response for fetching 'token' from a task that is served from
+// the fragment result cache.
+std::unique_ptr<Result> createCachedResult(
+    const FragmentResultCacheEntry& entry,
+    long token) {
+  if (token >= static_cast<long>(entry.pages.size())) {
+    return createCompleteResult(token);
+  }
+  auto result = std::make_unique<Result>();
+  result->sequence = token;
+  result->nextSequence = token + 1;
+  result->complete = token + 1 == static_cast<long>(entry.pages.size());
+  result->data = entry.pages[token]->clone();
+  result->waitTimeMs = 0;
+  return result;
+}
+
+// Chains 'pages' into a Result for the fetch of 'sequence'. A null page
+// marks the end of the buffered data.
+std::unique_ptr<Result> toResult(
+    int64_t sequence,
+    std::vector<std::unique_ptr<folly::IOBuf>> pages,
+    std::vector<int64_t> remainingBytes,
+    int64_t waitTimeMs) {
+  bool complete = false;
+  int64_t nextSequence = sequence;
+  std::unique_ptr<folly::IOBuf> iobuf;
+  for (auto& page : pages) {
+    if (page) {
+      VELOX_CHECK(!complete, "Received data after end marker");
+      if (!iobuf) {
+        iobuf = std::move(page);
+      } else {
+        iobuf->prev()->appendChain(std::move(page));
+      }
+      ++nextSequence;
+    } else {
+      complete = true;
+    }
+  }
+
+  auto result = std::make_unique<Result>();
+  result->sequence = sequence;
+  result->nextSequence = nextSequence;
+  result->complete = complete;
+  result->data = std::move(iobuf);
+  result->remainingBytes = std::move(remainingBytes);
+  result->waitTimeMs = waitTimeMs;
+  return result;
+}
+
+// Copies 'result'. The page data is cloned, which shares the underlying
+// buffers rather than copying the bytes.
+std::unique_ptr<Result> copyResult(const Result& result) {
+  auto copy = std::make_unique<Result>();
+  copy->sequence = result.sequence;
+  copy->nextSequence = result.nextSequence;
+  copy->complete = result.complete;
+  copy->data = result.data == nullptr ? nullptr : result.data->clone();
+  copy->remainingBytes = result.remainingBytes;
+  copy->waitTimeMs = result.waitTimeMs;
+  return copy;
+}
+
+// Rewrites the payload of 'result' keeping only the exchange output columns
+// listed in 'columnMask', replacing the rest with null constants so the page
+// layout the consumer deserializes is unchanged. Only applies to PrestoPage
+// data produced by a PartitionedOutput root; a malformed mask, a payload
+// that cannot be rebuilt (e.g. compressed pages) or a rewrite that does not
+// shrink the payload leaves the original data in place, since the mask is
+// advisory.
+void maybeNarrowResultColumns(
+    const std::shared_ptr<PrestoTask>& prestoTask,
+    const std::string& columnMask,
+    Result& result) {
+  if (result.data == nullptr || result.data->computeChainDataLength() == 0) {
+    return;
+  }
+  std::vector<int32_t> columns;
+  {
+    std::vector<folly::StringPiece> pieces;
+    folly::split(',', columnMask, pieces);
+    columns.reserve(pieces.size());
+    int32_t last = -1;
+    for (const auto& piece : pieces) {
+      const auto index = folly::tryTo<int32_t>(piece);
+      if (!index.hasValue() || index.value() <= last) {
+        return;
+      }
+      last = index.value();
+      columns.push_back(index.value());
+    }
+  }
+  if (columns.empty()) {
+    return;
+  }
+
+  const auto veloxTask = prestoTask->task;
+  if (veloxTask == nullptr) {
+    return;
+  }
+  const auto root = veloxTask->planFragment().planNode;
+  const auto* outputNode =
+      dynamic_cast<const core::PartitionedOutputNode*>(root.get());
+  if (outputNode == nullptr ||
+      outputNode->serdeKind() != VectorSerde::Kind::kPresto) {
+    return;
+  }
+  const auto& rowType = outputNode->outputType();
+  if (columns.back() >= static_cast<int32_t>(rowType->size()) ||
+      columns.size() >= rowType->size()) {
+    return;
+  }
+
+  try {
+    auto* pool = veloxTask->pool();
+    auto* serde = getNamedVectorSerde(VectorSerde::Kind::kPresto);
+    std::vector<ByteRange> ranges;
+    for (const auto& range : *result.data) {
+      ranges.push_back(
+          ByteRange{
+              const_cast<uint8_t*>(range.data()),
+              static_cast<int32_t>(range.size()),
+              0});
+    }
+    BufferInputStream input(std::move(ranges));
+    IOBufOutputStream output(*pool);
+    while (!input.atEnd()) {
+      RowVectorPtr vector;
+      VectorStreamGroup::read(&input, pool, rowType, serde, &vector, nullptr);
+      auto children = vector->children();
+      size_t next = 0;
+      for (int32_t i = 0; i < static_cast<int32_t>(children.size()); ++i) {
+        if (next < columns.size() && columns[next] == i) {
+          ++next;
+          continue;
+        }
+        children[i] = BaseVector::createNullConstant(
+            rowType->childAt(i), vector->size(), pool);
+      }
+      const auto narrowed = std::make_shared<RowVector>(
+          pool, rowType, nullptr, vector->size(), std::move(children));
+      VectorStreamGroup group(pool, serde);
+      group.createStreamTree(rowType, narrowed->size());
+      group.append(narrowed);
+      group.flush(&output);
+    }
+    auto narrowedData = output.getIOBuf();
+    const auto originalBytes = result.data->computeChainDataLength();
+    const auto narrowedBytes = narrowedData->computeChainDataLength();
+    if (narrowedBytes < originalBytes) {
+      result.data = std::move(narrowedData);
+      RECORD_METRIC_VALUE(
+          kCounterExchangeSelectiveColumnsSavedBytes,
+          originalBytes - narrowedBytes);
+    }
+  } catch (const std::exception& e) {
+    VLOG(1) << "Failed to narrow result columns for task "
+            << prestoTask->info.taskId << ": " << e.what();
+  }
+}
+
 void getData(
     PromiseHolderPtr<std::unique_ptr<Result>> promiseHolder,
     std::weak_ptr<http::CallbackRequestHandlerState> stateHolder,
@@ -145,7 +357,9 @@ void getData(
     long destination,
     long token,
     protocol::DataSize maxSize,
-    exec::OutputBufferManager& bufferManager) {
+    exec::OutputBufferManager& bufferManager,
+    std::shared_ptr<FragmentResultCapture> resultCapture = nullptr,
+    bool materialize = false) {
   if (promiseHolder == nullptr) {
     // promise/future is expired.
     return;
@@ -157,47 +371,39 @@ void getData(
       destination,
       maxSize.getValue(protocol::DataUnit::BYTE),
       token,
-      [taskId = taskId, bufferId = destination, promiseHolder, startMs](
+      [taskId = taskId,
+       bufferId = destination,
+       promiseHolder,
+       startMs,
+       resultCapture,
+       materialize](
           std::vector<std::unique_ptr<folly::IOBuf>> pages,
           int64_t sequence,
           std::vector<int64_t> remainingBytes) mutable {
-        bool complete = false;
-        int64_t nextSequence = sequence;
-        std::unique_ptr<folly::IOBuf> iobuf;
-        int64_t bytes = 0;
-        for (auto& page : pages) {
-          if (page) {
-            VELOX_CHECK(!complete, "Received data after end marker");
-            if (!iobuf) {
-              iobuf = std::move(page);
-              bytes = iobuf->length();
-            } else {
-              auto next = std::move(page);
-              bytes += next->length();
-              iobuf->prev()->appendChain(std::move(next));
-            }
-            ++nextSequence;
-          } else {
-            complete = true;
-          }
+        if (resultCapture != nullptr) {
+          resultCapture->append(sequence, pages);
         }
+        if (materialize) {
+          ExchangeMaterializer::instance()->append(
+              taskId, bufferId, sequence, pages);
+        }
+        const auto numPages = pages.size();
+        auto result = toResult(
+            sequence,
+            std::move(pages),
+            std::move(remainingBytes),
+            getCurrentTimeMs() - startMs);
 
-        int64_t waitTimeMs = getCurrentTimeMs() - startMs;
-        VLOG(1) << "Task " << taskId << " waited " << waitTimeMs
+        VLOG(1) << "Task " << taskId << " waited " << result->waitTimeMs
                 << "ms for data: "
                 << "buffer " << bufferId << ", sequence " << sequence
-                << " Results size: " << bytes
-                << ", page count: " << pages.size()
-                << ", remaining: " << folly::join(',', remainingBytes)
-                << ", complete: " << std::boolalpha << complete;
-
-        auto result = std::make_unique<Result>();
-        result->sequence = sequence;
-        result->nextSequence = nextSequence;
-        result->complete = complete;
-        result->data = std::move(iobuf);
-        result->remainingBytes = std::move(remainingBytes);
-        result->waitTimeMs = waitTimeMs;
+                << " Results size: "
+                << (result->data == nullptr
+                        ? 0
+                        : result->data->computeChainDataLength())
+                << ", page count: " << numPages
+                << ", remaining: " << folly::join(',', result->remainingBytes)
+                << ", complete: " << std::boolalpha << result->complete;
 
         promiseHolder->promise.setValue(std::move(result));
 
@@ -252,6 +458,41 @@ void checkSplitsForBatchTask(
       folly::join(", ", splitNodeIds));
 }
 
+// Returns true if 'updateRequest' describes a self-contained task whose
+// result the fragment result cache can serve or capture: the update carries
+// all splits and the no-more-splits flag for every split-requiring plan
+// node, writes nothing, and sends its output to a single destination.
+bool isFragmentResultCacheEligible(
+    const velox::core::PlanFragment& planFragment,
+    const protocol::TaskUpdateRequest& updateRequest) {
+  if (updateRequest.outputIds.type == protocol::BufferType::PARTITIONED ||
+      updateRequest.outputIds.buffers.size() != 1 ||
+      !updateRequest.outputIds.noMoreBufferIds) {
+    return false;
+  }
+  if (updateRequest.tableWriteInfo != nullptr &&
+      (updateRequest.tableWriteInfo->writerTarget != nullptr ||
+       updateRequest.tableWriteInfo->analyzeTableHandle != nullptr)) {
+    return false;
+  }
+
+  std::unordered_set<velox::core::PlanNodeId> splitNodeIds;
+  velox::core::PlanNode::findFirstNode(
+      planFragment.planNode.get(), [&](const velox::core::PlanNode* node) {
+        if (node->requiresSplits()) {
+          splitNodeIds.insert(node->id());
+        }
+        return false;
+      });
+  for (const auto& source : updateRequest.sources) {
+    if (!source.noMoreSplits) {
+      return false;
+    }
+    splitNodeIds.erase(source.planNodeId);
+  }
+  return splitNodeIds.empty();
+}
+
 struct ZombieTaskStats {
   const std::string info;
   const long numExtraReferences;
@@ -328,6 +569,39 @@ struct ZombieTaskStatsSet {
   }
 };
 
+// Reorders a batch of splits so the heaviest run first
+// (longest-processing-time order). The coordinator's split weight estimates
+// the split's cost and is carried on the velox connector split; velox drivers
+// dequeue splits in the order they were added, so ordering the batch at
+// ingestion is what the worker controls. Splits of equal weight, including
+// exchange splits which carry none, keep their arrival order. 'source.splits'
+// is permuted alongside so the sequence ids and the converted splits stay
+// paired.
+void orderSplitsByWeightDesc(
+    protocol::TaskSource& source,
+    std::vector<velox::exec::Split>& splits) {
+  const auto weightOf = [&](size_t i) {
+    return splits[i].hasConnectorSplit() ? splits[i].connectorSplit->splitWeight
+                                         : int64_t{0};
+  };
+  std::vector<size_t> order(splits.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return weightOf(a) > weightOf(b);
+  });
+
+  std::vector<velox::exec::Split> orderedSplits;
+  orderedSplits.reserve(splits.size());
+  protocol::List<protocol::ScheduledSplit> orderedProtocolSplits;
+  orderedProtocolSplits.reserve(source.splits.size());
+  for (const auto i : order) {
+    orderedSplits.push_back(std::move(splits[i]));
+    orderedProtocolSplits.push_back(std::move(source.splits[i]));
+  }
+  splits = std::move(orderedSplits);
+  source.splits = std::move(orderedProtocolSplits);
+}
+
 // Add task to the task queue.
 void enqueueTask(
     TaskQueue& taskQueue,
@@ -355,6 +629,75 @@ void enqueueTask(
 }
 } // namespace
 
+std::shared_ptr<PrestoTask> ShardedTaskMap::find(
+    const protocol::TaskId& taskId) const {
+  const TaskIdKey key(taskId);
+  return shard(key).withRLock(
+      [&](const auto& taskMap) -> std::shared_ptr<PrestoTask> {
+        auto it = taskMap.find(key);
+        return it != taskMap.end() ? it->second : nullptr;
+      });
+}
+
+std::shared_ptr<PrestoTask> ShardedTaskMap::insertIfAbsent(
+    const protocol::TaskId& taskId,
+    std::shared_ptr<PrestoTask> task) {
+  const TaskIdKey key(taskId);
+  return shard(key).withWLock([&](auto& taskMap) {
+    auto [it, inserted] = taskMap.try_emplace(key, std::move(task));
+    if (inserted) {
+      version_.fetch_add(1, std::memory_order_release);
+    }
+    return it->second;
+  });
+}
+
+std::shared_ptr<PrestoTask> ShardedTaskMap::eraseTask(
+    const protocol::TaskId& taskId) {
+  const TaskIdKey key(taskId);
+  return shard(key).withWLock(
+      [&](auto& taskMap) -> std::shared_ptr<PrestoTask> {
+        auto it = taskMap.find(key);
+        if (it == taskMap.end()) {
+          return nullptr;
+        }
+        auto task = std::move(it->second);
+        taskMap.erase(it);
+        version_.fetch_add(1, std::memory_order_release);
+        return task;
+      });
+}
+
+size_t ShardedTaskMap::size() const {
+  size_t numTasks = 0;
+  for (const auto& shard : shards_) {
+    numTasks += shard.rlock()->size();
+  }
+  return numTasks;
+}
+
+TaskMap ShardedTaskMap::copy() const {
+  TaskMap taskMapCopy;
+  for (const auto& shard : shards_) {
+    shard.withRLock([&](const auto& taskMap) {
+      for (const auto& [key, prestoTask] : taskMap) {
+        taskMapCopy.emplace(prestoTask->info.taskId, prestoTask);
+      }
+    });
+  }
+  return taskMapCopy;
+}
+
+folly::Synchronized<ShardedTaskMap::ShardMap>& ShardedTaskMap::shard(
+    const TaskIdKey& key) {
+  return shards_[TaskIdKey::Hash{}(key) % kNumShards];
+}
+
+const folly::Synchronized<ShardedTaskMap::ShardMap>& ShardedTaskMap::shard(
+    const TaskIdKey& key) const {
+  return shards_[TaskIdKey::Hash{}(key) % kNumShards];
+}
+
 TaskManager::TaskManager(
     folly::Executor* driverExecutor,
     folly::Executor* httpSrvCpuExecutor,
@@ -364,9 +707,31 @@ TaskManager::TaskManager(
               driverExecutor,
               spillerExecutor)),
       bufferManager_(velox::exec::OutputBufferManager::getInstanceRef()),
+      driverExecutor_(driverExecutor),
       httpSrvCpuExecutor_(httpSrvCpuExecutor),
+      taskCleanupExecutor_(std::make_unique<folly::CPUThreadPoolExecutor>(
+          1,
+          std::make_shared<folly::NamedThreadFactory>("TaskCleanup"))),
+      queryFailureGossipEnabled_(
+          SystemConfig::instance()->taskQueryFailureGossipEnabled()),
+      exchangeMaterializationEnabled_(
+          SystemConfig::instance()->exchangeMaterializationEnabled() &&
+          !SystemConfig::instance()->exchangeMaterializationBasePath().empty()),
       lastNotOverloadedTimeInSecs_(velox::getCurrentTimeSec()) {
   VELOX_CHECK_NOT_NULL(bufferManager_, "invalid OutputBufferManager");
+  if (SystemConfig::instance()->taskSplitIngestionFairnessEnabled()) {
+    splitIngestionScheduler_ =
+        std::make_shared<SplitIngestionScheduler>(driverExecutor_);
+  }
+  if (const auto* systemConfig = SystemConfig::instance();
+      systemConfig->fragmentResultCacheEnabled()) {
+    fragmentResultCache_ = std::make_unique<FragmentResultCache>(
+        systemConfig->fragmentResultCacheMaxBytes(),
+        systemConfig->fragmentResultCacheMaxEntryBytes(),
+        systemConfig->fragmentResultCacheTtlMs(),
+        systemConfig->fragmentResultCacheBaseDirectory(),
+        systemConfig->fragmentResultCacheMaxDiskBytes());
+  }
 }
 
 void TaskManager::setBaseUri(const std::string& baseUri) {
@@ -398,8 +763,136 @@ void TaskManager::setOldTaskCleanUpMs(int32_t oldTaskCleanUpMs) {
   oldTaskCleanUpMs_ = oldTaskCleanUpMs;
 }
 
+void TaskManager::setRemoteSourceWarmupCallback(
+    std::function<void(const std::string& remoteSourceLocation)> callback) {
+  remoteSourceWarmupCallback_ = std::move(callback);
+}
+
+void TaskManager::warmupAnnouncedUpstreamLocations(
+    const protocol::SessionRepresentation& session) {
+  if (remoteSourceWarmupCallback_ == nullptr) {
+    return;
+  }
+  auto it = session.systemProperties.find(kPrestartUpstreamLocations.str());
+  if (it == session.systemProperties.end() || it->second.empty()) {
+    return;
+  }
+  std::vector<std::string> locations;
+  folly::split(',', it->second, locations, /*ignoreEmpty=*/true);
+  std::sort(locations.begin(), locations.end());
+  locations.erase(
+      std::unique(locations.begin(), locations.end()), locations.end());
+  for (const auto& location : locations) {
+    remoteSourceWarmupCallback_(location);
+  }
+}
+
+void TaskManager::setQueryFailureGossipCallback(
+    std::function<void(
+        const std::string& queryId,
+        const std::vector<std::string>& remoteSourceLocations)> callback) {
+  queryFailureGossipCallback_ = std::move(callback);
+}
+
+void TaskManager::publishQueryFailure(const std::string& queryId) {
+  if (!queryFailureGossipEnabled_ || queryFailureGossipCallback_ == nullptr) {
+    return;
+  }
+  std::vector<std::string> locations;
+  queryRemoteSources_.withWLock([&](auto& remoteSources) {
+    auto it = remoteSources.find(queryId);
+    if (it == remoteSources.end()) {
+      return;
+    }
+    locations.assign(it->second.locations.begin(), it->second.locations.end());
+    // Publish each query failure at most once.
+    remoteSources.erase(it);
+  });
+  if (locations.empty()) {
+    return;
+  }
+  LOG(INFO) << "Publishing failure of query " << queryId << " to "
+            << locations.size() << " upstream worker(s).";
+  queryFailureGossipCallback_(queryId, locations);
+}
+
+size_t TaskManager::fastFailQueryTasks(const std::string& queryId) {
+  std::vector<protocol::TaskId> taskIds;
+  const std::string prefix = queryId + ".";
+  taskMap_.forEachTask(
+      [&](const auto& id, const std::shared_ptr<PrestoTask>& prestoTask) {
+        if (id.compare(0, prefix.size(), prefix) == 0 &&
+            prestoTask->task != nullptr && prestoTask->task->isRunning()) {
+          taskIds.push_back(id);
+        }
+      });
+  for (const auto& taskId : taskIds) {
+    deleteTask(taskId, /*abort=*/true, /*summarize=*/true);
+  }
+  if (!taskIds.empty()) {
+    LOG(INFO) << "Aborted " << taskIds.size() << " task(s) of query "
+              << queryId << " on a sibling worker's failure report.";
+    RECORD_METRIC_VALUE(
+        kCounterQueryFailureGossipAbortedTasks, taskIds.size());
+  }
+  return taskIds.size();
+}
+
 TaskMap TaskManager::tasks() const {
-  return taskMap_.withRLock([](const auto& tasks) { return tasks; });
+  return taskMap_.copy();
+}
+
+std::shared_ptr<const TaskManager::TaskListSnapshot>
+TaskManager::buildTaskListSnapshot() const {
+  nlohmann::json taskList = nlohmann::json::array();
+  taskMap_.forEachTask(
+      [&](const auto& /*taskId*/, const std::shared_ptr<PrestoTask>& task) {
+        taskList.push_back(task->updateInfo(/*summarize=*/true));
+      });
+
+  auto snapshot = std::make_shared<TaskListSnapshot>();
+  try {
+    snapshot->body = taskList.dump();
+  } catch (const std::exception&) {
+    snapshot->body = taskList.dump(
+        -1, ' ', false, nlohmann::detail::error_handler_t::replace);
+    LOG(WARNING) << "Failed to serialize task list json to string. "
+                    "Retried with 'replace' option.";
+  }
+  snapshot->buildTimeMs = velox::getCurrentTimeMs();
+  return snapshot;
+}
+
+void TaskManager::rebuildTaskListSnapshot() {
+  *taskListSnapshot_.wlock() = buildTaskListSnapshot();
+}
+
+std::shared_ptr<const TaskManager::TaskListSnapshot>
+TaskManager::taskListSnapshot() const {
+  return *taskListSnapshot_.rlock();
+}
+
+std::shared_ptr<const TaskManager::TaskSetSnapshot>
+TaskManager::taskSetSnapshot() const {
+  const auto version = taskMap_.version();
+  {
+    auto published = *taskSetSnapshot_.rlock();
+    if (published != nullptr && published->version == version) {
+      return published;
+    }
+  }
+  auto rebuilt = std::make_shared<TaskSetSnapshot>();
+  // Record the version read before the walk: a registration or removal that
+  // races the walk leaves the published version behind the map's, so the
+  // next call rebuilds again.
+  rebuilt->version = version;
+  rebuilt->tasks.reserve(taskMap_.size());
+  taskMap_.forEachTask(
+      [&](const auto& /*taskId*/, const std::shared_ptr<PrestoTask>& task) {
+        rebuilt->tasks.push_back(task);
+      });
+  *taskSetSnapshot_.wlock() = rebuilt;
+  return rebuilt;
 }
 
 const QueryContextManager* TaskManager::getQueryContextManager() const {
@@ -485,7 +978,8 @@ void TaskManager::setServerOverloaded(bool serverOverloaded) {
 
 void TaskManager::getDataForResultRequests(
     const std::unordered_map<int64_t, std::shared_ptr<ResultRequest>>&
-        resultRequests) {
+        resultRequests,
+    std::shared_ptr<FragmentResultCapture> resultCapture) {
   for (const auto& entry : resultRequests) {
     auto resultRequest = entry.second.get();
 
@@ -499,7 +993,9 @@ void TaskManager::getDataForResultRequests(
         resultRequest->bufferId,
         resultRequest->token,
         resultRequest->maxSize,
-        *bufferManager_);
+        *bufferManager_,
+        resultCapture,
+        exchangeMaterializationEnabled_);
   }
 }
 
@@ -510,6 +1006,18 @@ std::unique_ptr<protocol::TaskInfo> TaskManager::createOrUpdateTask(
     bool summarize,
     std::shared_ptr<velox::core::QueryCtx> queryCtx,
     long startProcessCpuTime) {
+  if (planFragment.planNode != nullptr) {
+    warmupAnnouncedUpstreamLocations(updateRequest.session);
+  }
+
+  // Compute the result cache key only for self-contained updates of cacheable
+  // fragments. A key is the signal for createOrUpdateTaskImpl() to consult the
+  // cache before creating a velox task.
+  std::optional<std::string> fragmentResultCacheKey;
+  if (fragmentResultCache_ != nullptr && planFragment.planNode != nullptr &&
+      isFragmentResultCacheEligible(planFragment, updateRequest)) {
+    fragmentResultCacheKey = FragmentResultCache::makeKey(updateRequest);
+  }
   return createOrUpdateTaskImpl(
       taskId,
       planFragment,
@@ -517,7 +1025,9 @@ std::unique_ptr<protocol::TaskInfo> TaskManager::createOrUpdateTask(
       updateRequest.outputIds,
       summarize,
       std::move(queryCtx),
-      startProcessCpuTime);
+      startProcessCpuTime,
+      sessionQueryDeadlineMs(updateRequest.session),
+      fragmentResultCacheKey);
 }
 
 std::unique_ptr<protocol::TaskInfo> TaskManager::createOrUpdateBatchTask(
@@ -531,6 +1041,10 @@ std::unique_ptr<protocol::TaskInfo> TaskManager::createOrUpdateBatchTask(
 
   checkSplitsForBatchTask(planFragment.planNode, updateRequest.sources);
 
+  if (planFragment.planNode != nullptr) {
+    warmupAnnouncedUpstreamLocations(updateRequest.session);
+  }
+
   return createOrUpdateTaskImpl(
       taskId,
       planFragment,
@@ -538,7 +1052,9 @@ std::unique_ptr<protocol::TaskInfo> TaskManager::createOrUpdateBatchTask(
       updateRequest.outputIds,
       summarize,
       std::move(queryCtx),
-      startProcessCpuTime);
+      startProcessCpuTime,
+      sessionQueryDeadlineMs(updateRequest.session),
+      std::nullopt);
 }
 
 std::unique_ptr<TaskInfo> TaskManager::createOrUpdateTaskImpl(
@@ -548,14 +1064,31 @@ std::unique_ptr<TaskInfo> TaskManager::createOrUpdateTaskImpl(
     const protocol::OutputBuffers& outputBuffers,
     bool summarize,
     std::shared_ptr<velox::core::QueryCtx> queryCtx,
-    long startProcessCpuTime) {
+    long startProcessCpuTime,
+    uint64_t queryDeadlineMs,
+    const std::optional<std::string>& fragmentResultCacheKey) {
   auto receiveTaskUpdateMs = getCurrentTimeMs();
   std::shared_ptr<exec::Task> execTask;
   bool startTask = false;
+  std::shared_ptr<FragmentResultCapture> scanShareCapture;
   auto prestoTask = findOrCreateTask(taskId, startProcessCpuTime);
   if (prestoTask->firstTimeReceiveTaskUpdateMs == 0) {
     prestoTask->firstTimeReceiveTaskUpdateMs = receiveTaskUpdateMs;
   }
+  if (queryDeadlineMs != 0) {
+    prestoTask->queryDeadlineMs = queryDeadlineMs;
+  }
+  // Refuse updates past the query deadline before creating a velox task or
+  // adding splits; the caller turns the failure into an error task, so the
+  // coordinator learns the query expired instead of feeding a dead task.
+  if (const auto deadlineMs = prestoTask->queryDeadlineMs.load();
+      deadlineMs != 0 &&
+      static_cast<uint64_t>(receiveTaskUpdateMs) > deadlineMs) {
+    VELOX_USER_FAIL(
+        "Update for task {} arrived after the query deadline of {} ms elapsed.",
+        taskId,
+        deadlineMs);
+  }
   {
     std::lock_guard<std::mutex> l(prestoTask->mutex);
     prestoTask->updateCoordinatorHeartbeatLocked();
@@ -567,6 +1100,33 @@ std::unique_ptr<TaskInfo> TaskManager::createOrUpdateTaskImpl(
             prestoTask->updateInfoLocked(summarize));
       }
 
+      // A task already served from the fragment result cache is FINISHED; a
+      // duplicate update must not create a velox task for it.
+      if (prestoTask->cachedResult != nullptr) {
+        return std::make_unique<TaskInfo>(
+            prestoTask->updateInfoLocked(summarize));
+      }
+
+      if (fragmentResultCacheKey.has_value()) {
+        if (auto cached =
+                fragmentResultCache_->get(fragmentResultCacheKey.value())) {
+          RECORD_METRIC_VALUE(kCounterFragmentResultCacheHits);
+          return serveFromFragmentResultCacheLocked(
+              prestoTask, std::move(cached), summarize);
+        }
+        RECORD_METRIC_VALUE(kCounterFragmentResultCacheMisses);
+        if (SystemConfig::instance()->fragmentResultCacheScanShareEnabled()) {
+          // An identical fragment may already be running and capturing its
+          // output; if so, wait for it instead of executing a second time.
+          scanShareCapture =
+              fragmentResultCache_->findCapture(fragmentResultCacheKey.value());
+        }
+        if (scanShareCapture == nullptr) {
+          prestoTask->resultCapture = fragmentResultCache_->startCapture(
+              fragmentResultCacheKey.value());
+        }
+      }
+
       const auto baseSpillDir = *(baseSpillDir_.rlock());
       auto spillDiskOpts =
           getTaskSpillOptions(taskId, planFragment, queryCtx, baseSpillDir);
@@ -589,7 +1149,17 @@ std::unique_ptr<TaskInfo> TaskManager::createOrUpdateTaskImpl(
 
       prestoTask->task = std::move(newExecTask);
       prestoTask->info.needsPlan = false;
-      startTask = true;
+      if (scanShareCapture != nullptr) {
+        LOG(INFO) << "Task " << taskId
+                  << " waits for an identical running fragment instead of "
+                  << "starting its own execution";
+        // Leave the task created but not started, like a queued task: splits
+        // are still added below, 'no more splits' and result requests park
+        // until the leader's outcome arrives in onScanShareLeaderDone().
+        prestoTask->scanShareWaiting = true;
+      } else {
+        startTask = true;
+      }
       prestoTask->createFinishTimeMs = getCurrentTimeMs();
     }
     execTask = prestoTask->task;
@@ -602,9 +1172,11 @@ std::unique_ptr<TaskInfo> TaskManager::createOrUpdateTaskImpl(
       taskId);
   std::unordered_map<int64_t, std::shared_ptr<ResultRequest>> resultRequests;
   PromiseHolderWeakPtr<std::unique_ptr<protocol::TaskStatus>> statusRequest;
+  PromiseHolderWeakPtr<std::unique_ptr<thrift::TaskStatus>> thriftStatusRequest;
   PromiseHolderWeakPtr<std::unique_ptr<protocol::TaskInfo>> infoRequest;
 
   bool startNextQueuedTask = false;
+  std::vector<std::string> remoteSourceLocations;
   std::unique_ptr<TaskInfo> ret;
   {
     // Create or update task can be called concurrently for the same task.
@@ -617,10 +1189,11 @@ std::unique_ptr<TaskInfo> TaskManager::createOrUpdateTaskImpl(
 
       resultRequests = std::move(prestoTask->resultRequests);
       statusRequest = prestoTask->statusRequest;
+      thriftStatusRequest = prestoTask->thriftStatusRequest;
       infoRequest = prestoTask->infoRequest;
     }
 
-    getDataForResultRequests(resultRequests);
+    getDataForResultRequests(resultRequests, prestoTask->resultCapture);
 
     if (outputBuffers.type != protocol::BufferType::PARTITIONED &&
         !execTask->updateOutputBuffers(
@@ -654,19 +1227,71 @@ std::unique_ptr<TaskInfo> TaskManager::createOrUpdateTaskImpl(
       merged.noMoreSplits = merged.noMoreSplits || source.noMoreSplits;
     }
 
-    for (const auto& [_, source] : sourcesMap) {
+    for (auto& [_, source] : sourcesMap) {
       // Add all splits from the source to the task.
       VLOG(1) << "Adding " << source.splits.size() << " splits to " << taskId
               << " for node " << source.planNodeId;
+      // Convert the whole batch up front, in parallel on the driver executor
+      // for large assignments, then add the splits in arrival order.
+      auto splits = toVeloxSplits(source.splits, driverExecutor_);
+      if (SystemConfig::instance()->taskLptSplitOrderingEnabled()) {
+        orderSplitsByWeightDesc(source, splits);
+      }
+      if (auto* affinityTracker = SplitAffinityTracker::instance();
+          affinityTracker->enabled()) {
+        // Record data split identities for soft-affinity bookkeeping before
+        // the splits are handed off. Exchange splits carry no cacheable data
+        // and are skipped.
+        for (size_t i = 0; i < source.splits.size(); ++i) {
+          if (splits[i].hasConnectorSplit() &&
+              std::dynamic_pointer_cast<const protocol::RemoteSplit>(
+                  source.splits[i].split.connectorSplit) == nullptr) {
+            affinityTracker->recordSplit(
+                SplitAffinityTracker::splitHash(*splits[i].connectorSplit));
+          }
+        }
+      }
+      if (splitIngestionScheduler_ != nullptr) {
+        // The warm-up locations are still collected inline so upstream
+        // connections are established before the splits are ingested.
+        if (remoteSourceWarmupCallback_ != nullptr ||
+            queryFailureGossipEnabled_) {
+          for (const auto& protocolSplit : source.splits) {
+            if (auto remoteSplit =
+                    std::dynamic_pointer_cast<const protocol::RemoteSplit>(
+                        protocolSplit.split.connectorSplit)) {
+              remoteSourceLocations.push_back(remoteSplit->location.location);
+            }
+          }
+        }
+        scheduleSplitIngestion(prestoTask, execTask, source, std::move(splits));
+        continue;
+      }
       // Keep track of the max sequence for this batch of splits.
       int64_t maxSplitSequenceId{-1};
-      for (const auto& protocolSplit : source.splits) {
-        auto split = toVeloxSplit(protocolSplit);
-        if (split.hasConnectorSplit()) {
+      for (size_t i = 0; i < source.splits.size(); ++i) {
+        const auto& protocolSplit = source.splits[i];
+        if (remoteSourceWarmupCallback_ != nullptr ||
+            queryFailureGossipEnabled_) {
+          if (auto remoteSplit =
+                  std::dynamic_pointer_cast<const protocol::RemoteSplit>(
+                      protocolSplit.split.connectorSplit)) {
+            remoteSourceLocations.push_back(remoteSplit->location.location);
+          }
+        }
+        if (splits[i].hasConnectorSplit()) {
           maxSplitSequenceId =
               std::max(maxSplitSequenceId, protocolSplit.sequenceId);
-          execTask->addSplitWithSequence(
-              source.planNodeId, std::move(split), protocolSplit.sequenceId);
+          // Coordinator retries re-send whole split batches; drop the
+          // duplicates here instead of paying the task's per-split sequence
+          // lookup for each of them.
+          if (prestoTask->splitSequenceGuard.testAndRecord(
+                  source.planNodeId, protocolSplit.sequenceId)) {
+            execTask->addSplitWithSequence(
+                source.planNodeId,
+                std::move(splits[i]),
+                protocolSplit.sequenceId);
+          }
         }
       }
       // Update task's max split sequence id after all splits have been added.
@@ -695,6 +1320,7 @@ std::unique_ptr<TaskInfo> TaskManager::createOrUpdateTaskImpl(
 
     // 'prestoTask' will exist by virtue of shared_ptr but may for example have
     // been aborted.
+    prestoTask->bumpInfoMutation();
     auto info =
         prestoTask->updateInfoLocked(summarize); // Presto task is locked above.
     if (auto promiseHolder = infoRequest.lock()) {
@@ -705,9 +1331,54 @@ std::unique_ptr<TaskInfo> TaskManager::createOrUpdateTaskImpl(
       promiseHolder->promise.setValue(
           std::make_unique<protocol::TaskStatus>(info.taskStatus));
     }
+    if (auto promiseHolder = thriftStatusRequest.lock()) {
+      auto thriftStatus = std::make_unique<thrift::TaskStatus>();
+      thrift::toThrift(info.taskStatus, *thriftStatus);
+      promiseHolder->promise.setValue(std::move(thriftStatus));
+    }
     ret = std::make_unique<TaskInfo>(info);
   }
 
+  if (!remoteSourceLocations.empty()) {
+    // Hand each distinct upstream location to the warm-up callback, outside
+    // the task lock since the callback may do name resolution.
+    std::sort(remoteSourceLocations.begin(), remoteSourceLocations.end());
+    remoteSourceLocations.erase(
+        std::unique(remoteSourceLocations.begin(), remoteSourceLocations.end()),
+        remoteSourceLocations.end());
+    if (queryFailureGossipEnabled_) {
+      // Remember the upstream workers of this query so a local failure can
+      // be fanned out to them.
+      const auto& queryId = prestoTask->id.queryId();
+      queryRemoteSources_.withWLock([&](auto& remoteSources) {
+        auto& entry = remoteSources[queryId];
+        entry.locations.insert(
+            remoteSourceLocations.begin(), remoteSourceLocations.end());
+        entry.lastUpdateMs = getCurrentTimeMs();
+      });
+    }
+    if (remoteSourceWarmupCallback_ != nullptr) {
+      for (const auto& location : remoteSourceLocations) {
+        remoteSourceWarmupCallback_(location);
+      }
+    }
+  }
+
+  if (scanShareCapture != nullptr) {
+    // Subscribe outside the task lock: the leader may publish on another
+    // thread at any point, and the callback takes the task lock itself.
+    const auto key = fragmentResultCacheKey.value();
+    if (!scanShareCapture->subscribe(
+            [this, prestoTask, key](
+                std::shared_ptr<const FragmentResultCacheEntry> entry) {
+              onScanShareLeaderDone(prestoTask, key, std::move(entry));
+            })) {
+      // The leader already finished; its entry, if it published one, is in
+      // the cache by now.
+      onScanShareLeaderDone(prestoTask, key, fragmentResultCache_->get(key));
+    }
+  }
+
   if (startNextQueuedTask) {
     maybeStartNextQueuedTask();
   }
@@ -715,6 +1386,182 @@ std::unique_ptr<TaskInfo> TaskManager::createOrUpdateTaskImpl(
   return ret;
 }
 
+std::unique_ptr<protocol::TaskInfo>
+TaskManager::serveFromFragmentResultCacheLocked(
+    std::shared_ptr<PrestoTask>& prestoTask,
+    std::shared_ptr<const FragmentResultCacheEntry> cachedResult,
+    bool summarize) {
+  LOG(INFO) << "Serving task " << prestoTask->info.taskId
+            << " from the fragment result cache: " << cachedResult->totalBytes
+            << " bytes in " << cachedResult->pages.size() << " pages";
+  prestoTask->cachedResult = std::move(cachedResult);
+  prestoTask->info.needsPlan = false;
+  prestoTask->info.taskStatus.state = protocol::TaskState::FINISHED;
+  prestoTask->info.outputBuffers.canAddBuffers = false;
+  prestoTask->info.outputBuffers.canAddPages = false;
+  prestoTask->info.outputBuffers.totalPagesSent =
+      prestoTask->cachedResult->pages.size();
+  prestoTask->info.stats.endTimeInMillis = velox::getCurrentTimeMs();
+
+  // Answer result requests that arrived before this update straight from the
+  // cached pages.
+  for (const auto& entry : prestoTask->resultRequests) {
+    auto* resultRequest = entry.second.get();
+    if (auto promiseHolder = resultRequest->promise.lock()) {
+      promiseHolder->promise.setValue(
+          createCachedResult(*prestoTask->cachedResult, resultRequest->token));
+    }
+  }
+  prestoTask->resultRequests.clear();
+
+  prestoTask->bumpInfoMutation();
+  auto info = prestoTask->updateInfoLocked(summarize);
+  if (auto promiseHolder = prestoTask->infoRequest.lock()) {
+    promiseHolder->promise.setValue(std::make_unique<protocol::TaskInfo>(info));
+  }
+  if (auto promiseHolder = prestoTask->statusRequest.lock()) {
+    promiseHolder->promise.setValue(
+        std::make_unique<protocol::TaskStatus>(info.taskStatus));
+  }
+  if (auto promiseHolder = prestoTask->thriftStatusRequest.lock()) {
+    auto thriftStatus = std::make_unique<thrift::TaskStatus>();
+    thrift::toThrift(info.taskStatus, *thriftStatus);
+    promiseHolder->promise.setValue(std::move(thriftStatus));
+  }
+  return std::make_unique<TaskInfo>(info);
+}
+
+void TaskManager::onScanShareLeaderDone(
+    std::shared_ptr<PrestoTask> prestoTask,
+    const std::string& fragmentResultCacheKey,
+    std::shared_ptr<const FragmentResultCacheEntry> entry) {
+  std::shared_ptr<exec::Task> unstartedTask;
+  {
+    std::lock_guard<std::mutex> l(prestoTask->mutex);
+    if (!prestoTask->scanShareWaiting) {
+      return;
+    }
+    prestoTask->scanShareWaiting = false;
+    if (prestoTask->task == nullptr ||
+        prestoTask->info.taskStatus.state == protocol::TaskState::ABORTED) {
+      return;
+    }
+
+    if (entry == nullptr) {
+      // The leader never published: it failed or its output exceeded the
+      // capture limit. Run the fragment ourselves, capturing for the cache,
+      // and release everything that parked while we waited.
+      LOG(INFO) << "Task " << prestoTask->info.taskId
+                << " falls back to its own execution: the identical running "
+                << "fragment it waited for produced no cached result";
+      RECORD_METRIC_VALUE(kCounterScanShareFallbacks);
+      prestoTask->resultCapture =
+          fragmentResultCache_->startCapture(fragmentResultCacheKey);
+      startTaskLocked(prestoTask);
+      for (const auto& planNodeId :
+           prestoTask->delayedNoMoreSplitsPlanNodes_) {
+        prestoTask->task->noMoreSplits(planNodeId);
+      }
+      prestoTask->delayedNoMoreSplitsPlanNodes_.clear();
+      const auto resultRequests = std::move(prestoTask->resultRequests);
+      getDataForResultRequests(resultRequests, prestoTask->resultCapture);
+      return;
+    }
+
+    RECORD_METRIC_VALUE(kCounterScanShareHits);
+    // Detach the never-started velox task so the presto task looks exactly
+    // like a fragment result cache hit, then serve the leader's output.
+    unstartedTask = std::move(prestoTask->task);
+    serveFromFragmentResultCacheLocked(
+        prestoTask, std::move(entry), /*summarize=*/false);
+  }
+  // Outside the task lock: tear down the task that never ran.
+  unstartedTask->requestAbort();
+}
+
+void TaskManager::scheduleSplitIngestion(
+    std::shared_ptr<PrestoTask> prestoTask,
+    std::shared_ptr<exec::Task> execTask,
+    protocol::TaskSource source,
+    std::vector<exec::Split> splits) {
+  const auto numSplits = splits.size();
+  const double splitsPerSecond =
+      execTask->queryCtx()->queryConfig().get<int64_t>(
+          SessionProperties::kSplitIngestionSplitsPerSecond, 0);
+  const auto queryId = prestoTask->id.queryId();
+  VLOG(1) << "Queueing " << numSplits << " splits of "
+          << prestoTask->info.taskId << " for node " << source.planNodeId
+          << " for fair ingestion";
+
+  // Shared because the scheduler invokes the item repeatedly until the whole
+  // batch has been ingested.
+  struct IngestionState {
+    protocol::TaskSource source;
+    std::vector<exec::Split> splits;
+    size_t nextSplit{0};
+    int64_t maxSplitSequenceId{-1};
+  };
+  auto state = std::make_shared<IngestionState>(
+      IngestionState{std::move(source), std::move(splits)});
+
+  splitIngestionScheduler_->enqueue(
+      queryId,
+      numSplits,
+      splitsPerSecond,
+      [prestoTask, execTask, state](uint64_t maxSplits) -> uint64_t {
+        std::lock_guard<std::mutex> l(prestoTask->mutex);
+        if (prestoTask->info.taskStatus.state == protocol::TaskState::ABORTED) {
+          // Drop what is left of the batch; the task will not run.
+          return 0;
+        }
+        uint64_t added{0};
+        while (state->nextSplit < state->splits.size() && added < maxSplits) {
+          const auto i = state->nextSplit++;
+          const auto& protocolSplit = state->source.splits[i];
+          if (state->splits[i].hasConnectorSplit()) {
+            state->maxSplitSequenceId =
+                std::max(state->maxSplitSequenceId, protocolSplit.sequenceId);
+            if (prestoTask->splitSequenceGuard.testAndRecord(
+                    state->source.planNodeId, protocolSplit.sequenceId)) {
+              execTask->addSplitWithSequence(
+                  state->source.planNodeId,
+                  std::move(state->splits[i]),
+                  protocolSplit.sequenceId);
+            }
+          }
+          ++added;
+        }
+        if (state->nextSplit < state->splits.size()) {
+          return state->splits.size() - state->nextSplit;
+        }
+
+        // The batch is fully ingested; run the same trailer as the inline
+        // path.
+        execTask->setMaxSplitSequenceId(
+            state->source.planNodeId, state->maxSplitSequenceId);
+        for (const auto& lifespan : state->source.noMoreSplitsForLifespan) {
+          if (lifespan.isgroup) {
+            LOG(INFO) << "No more splits for group " << lifespan.groupid
+                      << " for " << prestoTask->info.taskId << " for node "
+                      << state->source.planNodeId;
+            execTask->noMoreSplitsForGroup(
+                state->source.planNodeId, lifespan.groupid);
+          }
+        }
+        if (state->source.noMoreSplits) {
+          LOG(INFO) << "No more splits for " << prestoTask->info.taskId
+                    << " for node " << state->source.planNodeId;
+          if (prestoTask->taskStarted) {
+            execTask->noMoreSplits(state->source.planNodeId);
+          } else {
+            prestoTask->delayedNoMoreSplitsPlanNodes_.emplace(
+                state->source.planNodeId);
+          }
+        }
+        return 0;
+      });
+}
+
 void TaskManager::maybeStartTaskLocked(
     std::shared_ptr<PrestoTask>& prestoTask,
     bool& startNextQueuedTask) {
@@ -800,19 +1647,43 @@ void TaskManager::maybeStartNextQueuedTask() {
     return;
   }
 
-  // We will start all queued tasks from a single query.
+  const auto* systemConfig = SystemConfig::instance();
+
+  // We will start all queued tasks from a single query. When drain-to-idle is
+  // enabled, we keep starting tasks from further queued queries while the
+  // worker still has idle driver threads, so queued splits of sibling queries
+  // get picked up by idle threads instead of waiting for the next trigger.
+  int64_t idleDriverBudget{0};
+  if (systemConfig->workerOverloadedTaskQueueDrainToIdleEnabled()) {
+    const uint32_t numDriverThreads = std::max<uint32_t>(
+        1,
+        systemConfig->driverNumCpuThreadsHwMultiplier() *
+            std::thread::hardware_concurrency());
+    const auto driverCounts = getDriverCounts();
+    idleDriverBudget = static_cast<int64_t>(numDriverThreads) -
+        driverCounts.numOnThreadDrivers - driverCounts.numQueuedDrivers;
+  }
+
   std::vector<std::shared_ptr<PrestoTask>> tasksToStart;
 
   // We run the loop here because some tasks might have failed or were aborted
   // or cancelled. Despite that we want to start at least one task.
   {
     auto lockedTaskQueue = taskQueue_.wlock();
+    bool startedQuery{false};
     while (!lockedTaskQueue->empty()) {
+      // Stop after the first good query unless we still have idle driver
+      // threads left to fill.
+      if (startedQuery && idleDriverBudget <= 0) {
+        break;
+      }
+
       // Get the next entry.
       auto queuedTasks = std::move(lockedTaskQueue->front());
       lockedTaskQueue->pop_front();
 
       // Get all the still valid tasks from the entry.
+      std::vector<std::shared_ptr<PrestoTask>> queryTasksToStart;
       bool queryTasksAreGoodToStart{true};
       for (auto& queuedTask : queuedTasks) {
         auto taskToStart = queuedTask.lock();
@@ -840,13 +1711,23 @@ void TaskManager::maybeStartNextQueuedTask() {
           break;
         }
 
-        tasksToStart.emplace_back(taskToStart);
+        queryTasksToStart.emplace_back(taskToStart);
       }
 
-      if (queryTasksAreGoodToStart) {
-        break;
+      if (!queryTasksAreGoodToStart) {
+        continue;
+      }
+
+      for (auto& taskToStart : queryTasksToStart) {
+        // Assume each started task will occupy up to its configured maximum
+        // number of drivers.
+        idleDriverBudget -=
+            taskToStart->task->queryCtx()->queryConfig().get<int32_t>(
+                kMaxDriversPerTask.data(),
+                systemConfig->maxDriversPerTask());
+        tasksToStart.emplace_back(std::move(taskToStart));
       }
-      tasksToStart.clear();
+      startedQuery = true;
     }
   }
 
@@ -872,18 +1753,49 @@ void TaskManager::maybeStartNextQueuedTask() {
   }
 }
 
+void TaskManager::forecastTaskMemory(
+    const TaskId& taskId,
+    const std::string& serializedFragment) {
+  const auto fragmentHash =
+      TaskMemoryForecaster::fragmentShapeHash(serializedFragment);
+  memoryForecaster_.registerTask(taskId, fragmentHash);
+
+  const auto forecastBytes = memoryForecaster_.forecastPeakBytes(fragmentHash);
+  if (forecastBytes < 0) {
+    return;
+  }
+  auto* arbitrator = memory::memoryManager()->arbitrator();
+  if (arbitrator == nullptr || arbitrator->kind() == "NOOP") {
+    return;
+  }
+  const auto freeBytes =
+      static_cast<int64_t>(arbitrator->stats().freeCapacityBytes);
+  if (forecastBytes <= freeBytes) {
+    return;
+  }
+  RECORD_METRIC_VALUE(kCounterTaskMemoryForecastArbitrationCount);
+  LOG(WARNING) << "Task " << taskId << " forecasted to peak at "
+               << velox::succinctBytes(forecastBytes)
+               << " with only " << velox::succinctBytes(freeBytes)
+               << " of free query memory; triggering memory arbitration "
+               << "before admission";
+  try {
+    // Spill-only shrink, mirroring the graduated step of the periodic
+    // memory checker: admission waits for headroom instead of the task
+    // starting and being pushed back mid-execution.
+    memory::memoryManager()->shrinkPools(
+        forecastBytes - freeBytes, /*allowSpill=*/true, /*allowAbort=*/false);
+  } catch (const VeloxException& ex) {
+    LOG(ERROR) << ex.what();
+  }
+}
+
 std::unique_ptr<TaskInfo>
 TaskManager::deleteTask(const TaskId& taskId, bool /*abort*/, bool summarize) {
   LOG(INFO) << "Deleting task " << taskId;
   // Fast. non-blocking delete and cancel serialized on 'taskMap'.
-  std::shared_ptr<facebook::presto::PrestoTask> prestoTask;
-
-  taskMap_.withRLock([&](const auto& taskMap) {
-    auto it = taskMap.find(taskId);
-    if (it != taskMap.cend()) {
-      prestoTask = it->second;
-    }
-  });
+  std::shared_ptr<facebook::presto::PrestoTask> prestoTask =
+      taskMap_.find(taskId);
 
   if (prestoTask == nullptr) {
     VLOG(1) << "Task not found for delete: " << taskId;
@@ -900,7 +1812,18 @@ TaskManager::deleteTask(const TaskId& taskId, bool /*abort*/, bool summarize) {
       execTask->requestAbort();
     }
     prestoTask->info.stats.endTimeInMillis = velox::getCurrentTimeMs();
+    prestoTask->bumpInfoMutation();
     prestoTask->updateInfoLocked(summarize);
+    if (state == exec::TaskState::kFinished) {
+      memoryForecaster_.recordCompletion(taskId, execTask->pool()->peakBytes());
+    } else {
+      memoryForecaster_.unregisterTask(taskId);
+    }
+  } else if (prestoTask->cachedResult != nullptr) {
+    // A task served from the fragment result cache finished without a velox
+    // task. Keep the FINISHED state instead of flipping to ABORTED.
+    prestoTask->info.stats.endTimeInMillis = velox::getCurrentTimeMs();
+    return std::make_unique<TaskInfo>(prestoTask->info);
   } else {
     // If task is not found than we observe DELETE message coming before
     // CREATE. In that case we create the task with ABORTED state, so we know
@@ -921,92 +1844,146 @@ TaskManager::deleteTask(const TaskId& taskId, bool /*abort*/, bool summarize) {
 }
 
 size_t TaskManager::cleanOldTasks() {
+  // Bounds the number of tasks erased and handed off for destruction per
+  // sweep. Tasks over the budget stay in the map and qualify again on the
+  // next sweep.
+  static constexpr size_t kMaxTasksCleanedPerSweep{512};
+
   const auto startTimeMs = getCurrentTimeMs();
 
-  folly::F14FastSet<protocol::TaskId> taskIdsToClean;
+  std::vector<protocol::TaskId> taskIdsToClean;
+  bool sweepBudgetExhausted{false};
 
   ZombieTaskStatsSet zombieVeloxTaskCounts;
   ZombieTaskStatsSet zombiePrestoTaskCounts;
   uint32_t numTasksWithStuckOperator{0};
-  {
-    // We copy task map locally to avoid locking task map for a potentially long
-    // time. We also lock for 'read'.
-    const TaskMap taskMap = *(taskMap_.rlock());
 
-    for (const auto& [id, prestoTask] : taskMap) {
-      if (prestoTask->hasStuckOperator) {
-        ++numTasksWithStuckOperator;
-      }
+  // Scan the map in place, one shard read lock at a time, instead of copying
+  // it: with many registered tasks the copy alone showed up as a latency
+  // spike on concurrent task lookups.
+  taskMap_.forEachTask([&](const auto& id,
+                           const std::shared_ptr<PrestoTask>& prestoTask) {
+    if (prestoTask->hasStuckOperator) {
+      ++numTasksWithStuckOperator;
+    }
 
-      bool eraseTask{false};
-      if (prestoTask->task != nullptr) {
-        if (prestoTask->task->state() != exec::TaskState::kRunning) {
-          // Since the state is not running, we know the task has been
-          // terminated. We use termination time instead of end time as the
-          // former does not include time waiting for results to be consumed.
-          if (prestoTask->task->timeSinceTerminationMs() >= oldTaskCleanUpMs_) {
-            // Not running and old.
-            eraseTask = true;
-          }
+    bool eraseTask{false};
+    if (prestoTask->task != nullptr) {
+      if (prestoTask->task->state() != exec::TaskState::kRunning) {
+        // Since the state is not running, we know the task has been
+        // terminated. We use termination time instead of end time as the
+        // former does not include time waiting for results to be consumed.
+        if (prestoTask->task->timeSinceTerminationMs() >= oldTaskCleanUpMs_) {
+          // Not running and old.
+          eraseTask = true;
         }
       } else {
-        // Use heartbeat to determine the task's age.
-        if (prestoTask->timeSinceLastHeartbeatMs() >= oldTaskCleanUpMs_) {
-          eraseTask = true;
+        const auto deadlineMs = prestoTask->queryDeadlineMs.load();
+        if (deadlineMs != 0 && getCurrentTimeMs() > deadlineMs) {
+          LOG(INFO) << "Cancelling task '" << id
+                    << "' past its query deadline.";
+          prestoTask->task->requestCancel();
+        } else if (
+            prestoTask->timeSinceLastCoordinatorHeartbeatMs() >=
+            oldTaskCleanUpMs_) {
+          LOG(INFO) << "Cancelling abandoned task '" << id << "'.";
+          prestoTask->task->requestCancel();
         }
       }
-
-      // We assume 'not erase' is the 'most common' case.
-      if (!eraseTask) {
-        continue;
+    } else {
+      // Use heartbeat to determine the task's age.
+      if (prestoTask->timeSinceLastHeartbeatMs() >= oldTaskCleanUpMs_) {
+        eraseTask = true;
       }
+    }
 
-      const auto prestoTaskRefCount = prestoTask.use_count();
-      const auto taskRefCount = prestoTask->task.use_count();
-
-      // Do not remove 'zombie' tasks (with outstanding references) from the
-      // map. We use it to track the number of tasks. Note, since we copied the
-      // task map, presto tasks should have an extra reference (2 from two
-      // maps).
-      if (prestoTaskRefCount > 2 || taskRefCount > 1) {
-        auto& task = prestoTask->task;
-        if (prestoTaskRefCount > 2) {
-          ++zombiePrestoTaskCounts.numTotal;
-          if (task != nullptr) {
-            zombiePrestoTaskCounts.updateCounts(task, prestoTaskRefCount - 2);
-          }
-        }
-        if (taskRefCount > 1) {
-          ++zombieVeloxTaskCounts.numTotal;
-          zombieVeloxTaskCounts.updateCounts(task, taskRefCount - 1);
+    // We assume 'not erase' is the 'most common' case.
+    if (!eraseTask) {
+      return;
+    }
+
+    const auto prestoTaskRefCount = prestoTask.use_count();
+    const auto taskRefCount = prestoTask->task.use_count();
+
+    // Do not remove 'zombie' tasks (with outstanding references) from the
+    // map. We use it to track the number of tasks. The map itself holds one
+    // reference to each presto task and velox task.
+    if (prestoTaskRefCount > 1 || taskRefCount > 1) {
+      auto& task = prestoTask->task;
+      if (prestoTaskRefCount > 1) {
+        ++zombiePrestoTaskCounts.numTotal;
+        if (task != nullptr) {
+          zombiePrestoTaskCounts.updateCounts(task, prestoTaskRefCount - 1);
         }
-      } else {
-        taskIdsToClean.emplace(id);
       }
+      if (taskRefCount > 1) {
+        ++zombieVeloxTaskCounts.numTotal;
+        zombieVeloxTaskCounts.updateCounts(task, taskRefCount - 1);
+      }
+    } else if (taskIdsToClean.size() < kMaxTasksCleanedPerSweep) {
+      taskIdsToClean.emplace_back(id);
+    } else {
+      sweepBudgetExhausted = true;
     }
+  });
 
-    cancelAbandonedTasksInternal(taskMap, oldTaskCleanUpMs_);
-  }
+  // The per-entry checks above run under the shard locks, so the scan time
+  // approximates the total lock hold time; the erase loop below adds its
+  // brief write-lock holds.
+  uint64_t lockHoldMs = getCurrentTimeMs() - startTimeMs;
 
-  const auto elapsedMs = (getCurrentTimeMs() - startTimeMs);
   if (not taskIdsToClean.empty()) {
     std::vector<std::shared_ptr<PrestoTask>> tasksToDelete;
     tasksToDelete.reserve(taskIdsToClean.size());
-    {
-      // Remove tasks from the task map. We briefly lock for write here.
-      auto writableTaskMap = taskMap_.wlock();
-      for (const auto& taskId : taskIdsToClean) {
-        tasksToDelete.push_back(std::move(writableTaskMap->at(taskId)));
-        writableTaskMap->erase(taskId);
+    // Remove tasks from the task map. Each removal briefly locks only the
+    // task's shard for write.
+    const auto eraseStartMs = getCurrentTimeMs();
+    for (const auto& taskId : taskIdsToClean) {
+      tasksToDelete.push_back(taskMap_.eraseTask(taskId));
+      // Tasks swept without a coordinator delete never reported their peak
+      // memory; drop any leftover forecaster registration.
+      memoryForecaster_.unregisterTask(taskId);
+      if (exchangeMaterializationEnabled_) {
+        // Drop any materialization that never saw its last page; the partial
+        // file is useless to a failing-over consumer.
+        ExchangeMaterializer::instance()->abortTask(taskId);
       }
     }
+    lockHoldMs += getCurrentTimeMs() - eraseStartMs;
+
+    // Destroying a velox task can be expensive (operator state, memory
+    // pools); hand the batch to the cleanup thread instead of destroying
+    // inline on the periodic thread.
+    taskCleanupExecutor_->add(
+        [tasks = std::move(tasksToDelete)]() mutable { tasks.clear(); });
+
+    const auto elapsedMs = (getCurrentTimeMs() - startTimeMs);
     LOG(INFO) << "cleanOldTasks: Cleaned " << taskIdsToClean.size()
-              << " old task(s) in " << elapsedMs << " ms";
-  } else if (elapsedMs > 1000) {
+              << " old task(s) in " << elapsedMs << " ms"
+              << (sweepBudgetExhausted
+                      ? "; more old tasks remain for the next sweep"
+                      : "");
+  } else if (const auto elapsedMs = (getCurrentTimeMs() - startTimeMs);
+             elapsedMs > 1000) {
     // If we took more than 1 second to run this, something might be wrong.
     LOG(INFO) << "cleanOldTasks: Didn't clean any old task(s). Took "
               << elapsedMs << "ms";
   }
+  RECORD_METRIC_VALUE(kCounterOldTaskCleanupLockHoldMs, lockHoldMs);
+
+  if (queryFailureGossipEnabled_) {
+    // Expire gossip bookkeeping for queries that stopped updating tasks.
+    const auto nowMs = getCurrentTimeMs();
+    queryRemoteSources_.withWLock([&](auto& remoteSources) {
+      for (auto it = remoteSources.begin(); it != remoteSources.end();) {
+        if (nowMs - it->second.lastUpdateMs >= oldTaskCleanUpMs_) {
+          it = remoteSources.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    });
+  }
 
   if (zombieVeloxTaskCounts.numTotal > 0) {
     zombieVeloxTaskCounts.logZombieTaskStatus("Task");
@@ -1025,8 +2002,8 @@ size_t TaskManager::cleanOldTasks() {
 
 void TaskManager::cancelAbandonedTasks() {
   // We copy task map locally to avoid locking task map for a potentially long
-  // time. We also lock for 'read'.
-  const TaskMap taskMap = *(taskMap_.rlock());
+  // time. The copy holds each shard's read lock only briefly.
+  const TaskMap taskMap = taskMap_.copy();
   cancelAbandonedTasksInternal(taskMap, oldTaskCleanUpMs_);
 }
 
@@ -1035,7 +2012,8 @@ folly::Future<std::unique_ptr<protocol::TaskInfo>> TaskManager::getTaskInfo(
     bool summarize,
     std::optional<protocol::TaskState> currentState,
     std::optional<protocol::Duration> maxWait,
-    std::shared_ptr<http::CallbackRequestHandlerState> state) {
+    std::shared_ptr<http::CallbackRequestHandlerState> state,
+    const TaskInfoFieldMask& fieldMask) {
   auto [promise, future] =
       folly::makePromiseContract<std::unique_ptr<protocol::TaskInfo>>();
   auto prestoTask = findOrCreateTask(taskId);
@@ -1043,7 +2021,7 @@ folly::Future<std::unique_ptr<protocol::TaskInfo>> TaskManager::getTaskInfo(
     // Return current TaskInfo without waiting.
     promise.setValue(
         std::make_unique<protocol::TaskInfo>(
-            prestoTask->updateInfo(summarize)));
+            prestoTask->updateInfo(summarize, fieldMask)));
     prestoTask->updateCoordinatorHeartbeat();
     return std::move(future).via(httpSrvCpuExecutor_);
   }
@@ -1056,6 +2034,13 @@ folly::Future<std::unique_ptr<protocol::TaskInfo>> TaskManager::getTaskInfo(
     prestoTask->updateHeartbeatLocked();
     prestoTask->updateCoordinatorHeartbeatLocked();
     if (!prestoTask->task) {
+      // A task in a final state without a velox task (e.g. served from the
+      // fragment result cache) will never change again; answer right away.
+      if (isFinalState(prestoTask->info.taskStatus.state)) {
+        promise.setValue(std::make_unique<protocol::TaskInfo>(
+            prestoTask->updateInfoLocked(summarize, fieldMask)));
+        return std::move(future).via(httpSrvCpuExecutor_);
+      }
       auto promiseHolder =
           std::make_shared<PromiseHolder<std::unique_ptr<protocol::TaskInfo>>>(
               std::move(promise));
@@ -1066,12 +2051,12 @@ folly::Future<std::unique_ptr<protocol::TaskInfo>> TaskManager::getTaskInfo(
           .via(httpSrvCpuExecutor_)
           .onTimeout(
               std::chrono::microseconds(maxWaitMicros),
-              [prestoTask, summarize]() {
+              [prestoTask, summarize, fieldMask]() {
                 return std::make_unique<protocol::TaskInfo>(
-                    prestoTask->updateInfo(summarize));
+                    prestoTask->updateInfo(summarize, fieldMask));
               });
     }
-    info = prestoTask->updateInfoLocked(summarize);
+    info = prestoTask->updateInfoLocked(summarize, fieldMask);
   }
   if (currentState.value() != info.taskStatus.state ||
       isFinalState(info.taskStatus.state)) {
@@ -1085,18 +2070,20 @@ folly::Future<std::unique_ptr<protocol::TaskInfo>> TaskManager::getTaskInfo(
 
   prestoTask->task->stateChangeFuture(maxWaitMicros)
       .via(httpSrvCpuExecutor_)
-      .thenValue([promiseHolder, prestoTask, summarize](auto&& /*done*/) {
-        promiseHolder->promise.setValue(
-            std::make_unique<protocol::TaskInfo>(
-                prestoTask->updateInfo(summarize)));
-      })
+      .thenValue(
+          [promiseHolder, prestoTask, summarize, fieldMask](auto&& /*done*/) {
+            promiseHolder->promise.setValue(
+                std::make_unique<protocol::TaskInfo>(
+                    prestoTask->updateInfo(summarize, fieldMask)));
+          })
       .thenError(
           folly::tag_t<std::exception>{},
-          [promiseHolder, prestoTask, summarize](const std::exception& /*e*/) {
+          [promiseHolder, prestoTask, summarize, fieldMask](
+              const std::exception& /*e*/) {
             // We come here in the case of maxWait elapsed.
             promiseHolder->promise.setValue(
                 std::make_unique<protocol::TaskInfo>(
-                    prestoTask->updateInfo(summarize)));
+                    prestoTask->updateInfo(summarize, fieldMask)));
           });
   return std::move(future).via(httpSrvCpuExecutor_);
 }
@@ -1107,7 +2094,8 @@ folly::Future<std::unique_ptr<Result>> TaskManager::getResults(
     long token,
     protocol::DataSize maxSize,
     protocol::Duration maxWait,
-    std::shared_ptr<http::CallbackRequestHandlerState> state) {
+    std::shared_ptr<http::CallbackRequestHandlerState> state,
+    const std::string& exchangeColumns) {
   uint64_t maxWaitMicros =
       std::max(1.0, maxWait.getValue(protocol::TimeUnit::MICROSECONDS));
   VLOG(1) << "TaskManager::getResults task:" << taskId
@@ -1131,9 +2119,30 @@ folly::Future<std::unique_ptr<Result>> TaskManager::getResults(
           .thenValue([token](auto&&) { return createEmptyResult(token); });
     }
 
+    prestoTask->recordResultFetch(destination);
+
     auto [promise, future] =
         folly::makePromiseContract<std::unique_ptr<Result>>();
 
+    // Narrow the payload to the consumer's column mask, then fold the bytes
+    // actually served into the consumer's pacing statistics, whichever path
+    // below fulfills the promise.
+    std::weak_ptr<PrestoTask> taskHolder = prestoTask;
+    future = std::move(future).deferValue(
+        [taskHolder, destination, exchangeColumns](
+            std::unique_ptr<Result> result) {
+          if (result->data != nullptr) {
+            if (auto task = taskHolder.lock()) {
+              if (!exchangeColumns.empty()) {
+                maybeNarrowResultColumns(task, exchangeColumns, *result);
+              }
+              task->recordResultFetchBytes(
+                  destination, result->data->computeChainDataLength());
+            }
+          }
+          return result;
+        });
+
     auto promiseHolder =
         std::make_shared<PromiseHolder<std::unique_ptr<Result>>>(
             std::move(promise));
@@ -1147,8 +2156,6 @@ folly::Future<std::unique_ptr<Result>> TaskManager::getResults(
           p.setValue(createEmptyResult(token));
         });
 
-    auto timeoutFn = [token]() { return createEmptyResult(token); };
-
     for (;;) {
       if (prestoTask->taskStarted) {
         // If the task has finished, then send completion result.
@@ -1159,21 +2166,86 @@ folly::Future<std::unique_ptr<Result>> TaskManager::getResults(
         // If task is not running let the request timeout. The task may have
         // failed at creation time and the coordinator hasn't yet caught up.
         if (prestoTask->task->state() == exec::TaskState::kRunning) {
-          getData(
+          if (SystemConfig::instance()->taskResultsPrefetchEnabled()) {
+            std::unique_ptr<Result> prefetched;
+            bool parked = false;
+            {
+              std::lock_guard<std::mutex> l(prestoTask->mutex);
+              auto it = prestoTask->resultsPrefetch.find(destination);
+              if (it != prestoTask->resultsPrefetch.end()) {
+                auto& prefetch = it->second;
+                if (prefetch.nextResult != nullptr &&
+                    prefetch.nextResult->sequence == token) {
+                  prefetched = std::move(prefetch.nextResult);
+                  // The dequeue already acknowledged these pages; retain a
+                  // copy for a retry even if no further dequeue follows.
+                  prefetch.lastResult = copyResult(*prefetched);
+                } else if (
+                    prefetch.lastResult != nullptr &&
+                    prefetch.lastResult->sequence == token) {
+                  // Retry after a failed transfer. The speculative dequeue
+                  // of the next sequence already acknowledged these pages in
+                  // the buffer, so serve the retained copy.
+                  prefetched = copyResult(*prefetch.lastResult);
+                } else if (prefetch.prefetchSequence == token) {
+                  // The speculative dequeue for this token is still in
+                  // flight; park the request for its completion.
+                  keepPromiseAlive(promiseHolder, state);
+                  prefetch.pendingPromise = folly::to_weak_ptr(promiseHolder);
+                  parked = true;
+                }
+              }
+            }
+            if (prefetched != nullptr) {
+              RECORD_METRIC_VALUE(kCounterTaskResultsPrefetchHits);
+              maybeStartResultsPrefetch(
+                  prestoTask, destination, maxSize, *prefetched);
+              promiseHolder->promise.setValue(std::move(prefetched));
+              return std::move(future).via(httpSrvCpuExecutor_);
+            }
+            if (parked) {
+              return armResultTimeout(std::move(future), token, maxWaitMicros);
+            }
+            RECORD_METRIC_VALUE(kCounterTaskResultsPrefetchMisses);
+            dispatchResultData(
+                prestoTask,
+                promiseHolder,
+                folly::to_weak_ptr(state),
+                destination,
+                token,
+                maxSize);
+            return armResultTimeout(
+                std::move(future).deferValue(
+                    [this, prestoTask, destination, maxSize](
+                        std::unique_ptr<Result> result) {
+                      // Dequeue the next sequence while this response streams
+                      // out.
+                      maybeStartResultsPrefetch(
+                          prestoTask, destination, maxSize, *result);
+                      return result;
+                    }),
+                token,
+                maxWaitMicros);
+          }
+          dispatchResultData(
+              prestoTask,
               promiseHolder,
               folly::to_weak_ptr(state),
-              taskId,
               destination,
               token,
-              maxSize,
-              *bufferManager_);
+              maxSize);
         }
-        return std::move(future)
-            .via(httpSrvCpuExecutor_)
-            .onTimeout(std::chrono::microseconds(maxWaitMicros), timeoutFn);
+        return armResultTimeout(std::move(future), token, maxWaitMicros);
       }
 
       std::lock_guard<std::mutex> l(prestoTask->mutex);
+      // A task served from the fragment result cache has no velox task; the
+      // cached pages answer result requests directly.
+      if (prestoTask->cachedResult != nullptr) {
+        promiseHolder->promise.setValue(
+            createCachedResult(*prestoTask->cachedResult, token));
+        return std::move(future).via(httpSrvCpuExecutor_);
+      }
       if (prestoTask->taskStarted) {
         continue;
       }
@@ -1191,9 +2263,7 @@ folly::Future<std::unique_ptr<Result>> TaskManager::getResults(
           token,
           maxSize);
       prestoTask->resultRequests.insert({destination, std::move(request)});
-      return std::move(future)
-          .via(httpSrvCpuExecutor_)
-          .onTimeout(std::chrono::microseconds(maxWaitMicros), timeoutFn);
+      return armResultTimeout(std::move(future), token, maxWaitMicros);
     }
   } catch (const velox::VeloxException& e) {
     return folly::makeSemiFuture<std::unique_ptr<Result>>(e).via(
@@ -1204,6 +2274,130 @@ folly::Future<std::unique_ptr<Result>> TaskManager::getResults(
   }
 }
 
+void TaskManager::maybeStartResultsPrefetch(
+    const std::shared_ptr<PrestoTask>& prestoTask,
+    long destination,
+    protocol::DataSize maxSize,
+    const Result& served) {
+  if (served.complete || served.nextSequence == served.sequence) {
+    // The buffer is drained or the fetch made no progress; there is nothing
+    // further to dequeue yet.
+    return;
+  }
+  const int64_t nextToken = served.nextSequence;
+  std::shared_ptr<FragmentResultCapture> resultCapture;
+  {
+    std::lock_guard<std::mutex> l(prestoTask->mutex);
+    // A consumer that polls only rarely gains nothing from a speculative
+    // dequeue; skip prefetching for it.
+    if (prestoTask->resultFetchGapMsLocked(destination) >
+        kSlowConsumerPrefetchGapMs) {
+      return;
+    }
+    auto& prefetch = prestoTask->resultsPrefetch[destination];
+    if (prefetch.prefetchSequence >= 0 ||
+        (prefetch.nextResult != nullptr &&
+         prefetch.nextResult->sequence >= nextToken)) {
+      return;
+    }
+    prefetch.prefetchSequence = nextToken;
+    // The dequeue below acknowledges the served pages in the buffer; keep a
+    // copy to answer a retry after a failed transfer.
+    prefetch.lastResult = copyResult(served);
+    resultCapture = prestoTask->resultCapture;
+  }
+
+  std::weak_ptr<PrestoTask> taskHolder = prestoTask;
+  auto bufferFound = bufferManager_->getData(
+      prestoTask->info.taskId,
+      destination,
+      maxSize.getValue(protocol::DataUnit::BYTE),
+      nextToken,
+      [this,
+       taskHolder,
+       taskId = prestoTask->info.taskId,
+       destination,
+       maxSize,
+       resultCapture](
+          std::vector<std::unique_ptr<folly::IOBuf>> pages,
+          int64_t sequence,
+          std::vector<int64_t> remainingBytes) mutable {
+        if (resultCapture != nullptr) {
+          resultCapture->append(sequence, pages);
+        }
+        if (exchangeMaterializationEnabled_) {
+          ExchangeMaterializer::instance()->append(
+              taskId, destination, sequence, pages);
+        }
+        auto result =
+            toResult(sequence, std::move(pages), std::move(remainingBytes), 0);
+        RECORD_METRIC_VALUE(
+            kCounterTaskResultsPrefetchedBytes,
+            result->data == nullptr ? 0
+                                    : result->data->computeChainDataLength());
+
+        auto prestoTask = taskHolder.lock();
+        if (prestoTask == nullptr) {
+          return;
+        }
+        PromiseHolderPtr<std::unique_ptr<Result>> waiter;
+        {
+          std::lock_guard<std::mutex> l(prestoTask->mutex);
+          auto& prefetch = prestoTask->resultsPrefetch[destination];
+          prefetch.prefetchSequence = -1;
+          waiter = prefetch.pendingPromise.lock();
+          prefetch.pendingPromise.reset();
+          if (waiter == nullptr) {
+            prefetch.nextResult = std::move(result);
+            return;
+          }
+          // Served to the parked request; retain a copy for a retry even if
+          // no further dequeue follows.
+          prefetch.lastResult = copyResult(*result);
+        }
+        // A request raced the dequeue and parked; answer it and keep the
+        // pipeline going.
+        maybeStartResultsPrefetch(prestoTask, destination, maxSize, *result);
+        waiter->promise.setValue(std::move(result));
+      },
+      [taskHolder]() { return !taskHolder.expired(); });
+
+  if (!bufferFound) {
+    std::lock_guard<std::mutex> l(prestoTask->mutex);
+    prestoTask->resultsPrefetch[destination].prefetchSequence = -1;
+  }
+}
+
+void TaskManager::dispatchResultData(
+    const std::shared_ptr<PrestoTask>& prestoTask,
+    const PromiseHolderPtr<std::unique_ptr<Result>>& promiseHolder,
+    const std::weak_ptr<http::CallbackRequestHandlerState>& state,
+    long destination,
+    long token,
+    protocol::DataSize maxSize) {
+  getData(
+      promiseHolder,
+      state,
+      prestoTask->info.taskId,
+      destination,
+      token,
+      maxSize,
+      *bufferManager_,
+      prestoTask->resultCapture,
+      exchangeMaterializationEnabled_);
+}
+
+folly::Future<std::unique_ptr<Result>> TaskManager::armResultTimeout(
+    folly::SemiFuture<std::unique_ptr<Result>> future,
+    long token,
+    uint64_t maxWaitMicros) {
+  return std::move(future)
+      .via(httpSrvCpuExecutor_)
+      .onTimeout(std::chrono::microseconds(maxWaitMicros), [token]() {
+        return createEmptyResult(token);
+      });
+}
+
 folly::Future<std::unique_ptr<protocol::TaskStatus>> TaskManager::getTaskStatus(
     const TaskId& taskId,
     std::optional<protocol::TaskState> currentState,
@@ -1228,6 +2422,13 @@ folly::Future<std::unique_ptr<protocol::TaskStatus>> TaskManager::getTaskStatus(
     std::lock_guard<std::mutex> l(prestoTask->mutex);
     prestoTask->updateCoordinatorHeartbeatLocked();
     if (!prestoTask->task) {
+      // A task in a final state without a velox task (e.g. served from the
+      // fragment result cache) will never change again; answer right away.
+      if (isFinalState(prestoTask->info.taskStatus.state)) {
+        promise.setValue(std::make_unique<protocol::TaskStatus>(
+            prestoTask->updateStatusLocked()));
+        return std::move(future).via(httpSrvCpuExecutor_);
+      }
       auto promiseHolder = std::make_shared<
           PromiseHolder<std::unique_ptr<protocol::TaskStatus>>>(
           std::move(promise));
@@ -1271,6 +2472,168 @@ folly::Future<std::unique_ptr<protocol::TaskStatus>> TaskManager::getTaskStatus(
   return std::move(future).via(httpSrvCpuExecutor_);
 }
 
+folly::Future<std::unique_ptr<thrift::TaskStatus>>
+TaskManager::getTaskStatusThrift(
+    const TaskId& taskId,
+    std::optional<protocol::TaskState> currentState,
+    std::optional<protocol::Duration> maxWait,
+    std::shared_ptr<http::CallbackRequestHandlerState> state) {
+  auto [promise, future] =
+      folly::makePromiseContract<std::unique_ptr<thrift::TaskStatus>>();
+
+  auto prestoTask = findOrCreateTask(taskId);
+
+  if (!currentState || !maxWait) {
+    // Return task's status immediately without waiting.
+    prestoTask->updateCoordinatorHeartbeat();
+    auto thriftStatus = std::make_unique<thrift::TaskStatus>();
+    prestoTask->updateStatusThrift(*thriftStatus);
+    return std::move(thriftStatus);
+  }
+
+  uint64_t maxWaitMicros =
+      std::max(1.0, maxWait.value().getValue(protocol::TimeUnit::MICROSECONDS));
+
+  {
+    std::lock_guard<std::mutex> l(prestoTask->mutex);
+    prestoTask->updateCoordinatorHeartbeatLocked();
+    if (!prestoTask->task) {
+      // A task in a final state without a velox task (e.g. served from the
+      // fragment result cache) will never change again; answer right away.
+      if (isFinalState(prestoTask->info.taskStatus.state)) {
+        auto thriftStatus = std::make_unique<thrift::TaskStatus>();
+        prestoTask->updateStatusThriftLocked(*thriftStatus);
+        promise.setValue(std::move(thriftStatus));
+        return std::move(future).via(httpSrvCpuExecutor_);
+      }
+      auto promiseHolder =
+          std::make_shared<PromiseHolder<std::unique_ptr<thrift::TaskStatus>>>(
+              std::move(promise));
+
+      keepPromiseAlive(promiseHolder, state);
+      prestoTask->thriftStatusRequest = folly::to_weak_ptr(promiseHolder);
+      return std::move(future)
+          .via(httpSrvCpuExecutor_)
+          .onTimeout(std::chrono::microseconds(maxWaitMicros), [prestoTask]() {
+            auto thriftStatus = std::make_unique<thrift::TaskStatus>();
+            prestoTask->updateStatusThrift(*thriftStatus);
+            return thriftStatus;
+          });
+    }
+
+    prestoTask->refreshStatusLocked();
+    const auto taskState = prestoTask->info.taskStatus.state;
+    if (currentState.value() != taskState || isFinalState(taskState)) {
+      auto thriftStatus = std::make_unique<thrift::TaskStatus>();
+      thrift::toThrift(prestoTask->info.taskStatus, *thriftStatus);
+      promise.setValue(std::move(thriftStatus));
+      return std::move(future).via(httpSrvCpuExecutor_);
+    }
+  }
+
+  auto promiseHolder =
+      std::make_shared<PromiseHolder<std::unique_ptr<thrift::TaskStatus>>>(
+          std::move(promise));
+
+  prestoTask->task->stateChangeFuture(maxWaitMicros)
+      .via(httpSrvCpuExecutor_)
+      .thenValue([promiseHolder, prestoTask](auto&& /*done*/) {
+        auto thriftStatus = std::make_unique<thrift::TaskStatus>();
+        prestoTask->updateStatusThrift(*thriftStatus);
+        promiseHolder->promise.setValue(std::move(thriftStatus));
+      })
+      .thenError(
+          folly::tag_t<std::exception>{},
+          [promiseHolder, prestoTask](std::exception const& /*e*/) {
+            // We come here in the case of maxWait elapsed.
+            auto thriftStatus = std::make_unique<thrift::TaskStatus>();
+            prestoTask->updateStatusThrift(*thriftStatus);
+            promiseHolder->promise.setValue(std::move(thriftStatus));
+          });
+  return std::move(future).via(httpSrvCpuExecutor_);
+}
+
+std::string TaskManager::getTaskStatusBatchJson(
+    const std::string& requestBody) {
+  const auto request = nlohmann::json::parse(requestBody);
+  VELOX_USER_CHECK(
+      request.is_array(), "Task status batch request must be a JSON array");
+
+  // Hand-assembled so each entry splices in the task's cached serialized
+  // status without reparsing it.
+  std::string response;
+  response.reserve(128 * (request.size() + 1));
+  response.append("[");
+  bool first = true;
+  for (const auto& entry : request) {
+    protocol::TaskId taskId;
+    std::string knownEtag;
+    if (entry.is_string()) {
+      taskId = entry.get<std::string>();
+    } else {
+      taskId = entry.at("taskId").get<std::string>();
+      knownEtag = entry.value("etag", "");
+    }
+    if (!first) {
+      response.append(",");
+    }
+    first = false;
+    const auto taskIdJson = nlohmann::json(taskId).dump();
+
+    auto prestoTask = taskMap_.find(taskId);
+    if (prestoTask == nullptr) {
+      response.append(
+          fmt::format("{{\"taskId\":{},\"unknown\":true}}", taskIdJson));
+      continue;
+    }
+
+    std::string etag;
+    std::string statusJson;
+    {
+      std::lock_guard<std::mutex> l(prestoTask->mutex);
+      prestoTask->updateCoordinatorHeartbeatLocked();
+      // A final status can never change, so its cached serialization is
+      // reused without refreshing or rehashing.
+      if (!prestoTask->batchStatusFinal) {
+        const auto status = prestoTask->updateStatusLocked();
+        std::string serialized;
+        if (SystemConfig::instance()->taskStatusDirectSerdeEnabled()) {
+          serialized = protocol::serializeTaskStatusJson(status);
+        } else {
+          nlohmann::json statusObj = status;
+          serialized = statusObj.dump();
+        }
+        if (serialized != prestoTask->batchStatusJson) {
+          prestoTask->batchStatusEtag =
+              fmt::format("{:016x}", folly::hash::fnv64(serialized));
+          prestoTask->batchStatusJson = std::move(serialized);
+        }
+        prestoTask->batchStatusFinal = isFinalState(status.state);
+      }
+      etag = prestoTask->batchStatusEtag;
+      if (knownEtag.empty() || knownEtag != etag) {
+        statusJson = prestoTask->batchStatusJson;
+      }
+    }
+    if (statusJson.empty()) {
+      response.append(
+          fmt::format(
+              "{{\"taskId\":{},\"etag\":\"{}\",\"notModified\":true}}",
+              taskIdJson,
+              etag));
+    } else {
+      response.append(
+          fmt::format(
+              "{{\"taskId\":{},\"etag\":\"{}\",\"status\":{}}}",
+              taskIdJson,
+              etag,
+              statusJson));
+    }
+  }
+  response.append("]");
+  return response;
+}
+
 void TaskManager::removeRemoteSource(
     const TaskId& taskId,
     const TaskId& remoteSourceTaskId) {
@@ -1280,13 +2643,7 @@ void TaskManager::removeRemoteSource(
 std::shared_ptr<PrestoTask> TaskManager::findOrCreateTask(
     const TaskId& taskId,
     long startProcessCpuTime) {
-  std::shared_ptr<PrestoTask> prestoTask;
-  taskMap_.withRLock([&](const auto& taskMap) {
-    auto it = taskMap.find(taskId);
-    if (it != taskMap.end()) {
-      prestoTask = it->second;
-    }
-  });
+  std::shared_ptr<PrestoTask> prestoTask = taskMap_.find(taskId);
 
   if (prestoTask != nullptr) {
     std::lock_guard<std::mutex> l(prestoTask->mutex);
@@ -1322,33 +2679,27 @@ std::shared_ptr<PrestoTask> TaskManager::findOrCreateTask(
   prestoTask->updateHeartbeatLocked();
   ++prestoTask->info.taskStatus.version;
 
-  taskMap_.withWLock([&](auto& taskMap) {
-    if (taskMap.count(taskId) == 0) {
-      taskMap[taskId] = prestoTask;
-    } else {
-      prestoTask = taskMap[taskId];
-    }
-  });
-  return prestoTask;
+  // Another thread may have registered the task since the lookup above; adopt
+  // its task in that case.
+  return taskMap_.insertIfAbsent(taskId, std::move(prestoTask));
 }
 
 std::string TaskManager::toString() const {
   std::stringstream out;
-  auto taskMap = taskMap_.rlock();
-  for (const auto& pair : *taskMap) {
-    if (pair.second->task) {
-      out << pair.second->task->toString() << std::endl;
+  taskMap_.forEachTask([&](const auto& taskId, const auto& prestoTask) {
+    if (prestoTask->task) {
+      out << prestoTask->task->toString() << std::endl;
     } else {
-      out << exec::Task::shortId(pair.first) << " no task (" << pair.first
-          << ")" << std::endl;
+      out << exec::Task::shortId(taskId) << " no task (" << taskId << ")"
+          << std::endl;
     }
-  }
+  });
   out << bufferManager_->toString();
   return out.str();
 }
 
 velox::exec::Task::DriverCounts TaskManager::getDriverCounts() {
-  const auto taskMap = *taskMap_.rlock();
+  const auto taskMap = taskMap_.copy();
   velox::exec::Task::DriverCounts ret;
   for (const auto& pair : taskMap) {
     if (pair.second->task != nullptr) {
@@ -1377,77 +2728,254 @@ bool TaskManager::getStuckOpCalls(
   stuckOpCalls.clear();
 
   const std::chrono::milliseconds lockTimeoutMs(thresholdDurationMs);
-  auto taskMap = taskMap_.rlock(lockTimeoutMs);
-  if (!taskMap) {
-    return false;
-  }
-
-  for (const auto& [id, prestoTask] : *taskMap) {
-    if (prestoTask->task != nullptr) {
-      const auto numPrevStuckOps = stuckOpCalls.size();
-      if (!prestoTask->task->getLongRunningOpCalls(
-              lockTimeoutMs, thresholdDurationMs, stuckOpCalls)) {
-        deadlockTasks.push_back(id);
-        continue;
-      }
-      // See if we need to cancel the Task - it should be running, the cancel
-      // threshold should be valid and it should have at least one stuck driver
-      // that was stuck for enough time.
-      if (numPrevStuckOps < stuckOpCalls.size() && thresholdCancelMs != 0 &&
-          prestoTask->task->isRunning()) {
-        for (auto it = stuckOpCalls.begin() + numPrevStuckOps;
-             it != stuckOpCalls.end();
-             ++it) {
-          if (it->durationMs >= thresholdCancelMs) {
-            std::stringstream ss;
-            ss << "Task " << id
-               << " cancelled due to stuck operator: tid=" << it->tid
-               << " opCall=" << it->opCall
-               << " duration= " << velox::succinctMillis(it->durationMs);
-            const std::string msg = ss.str();
-            LOG(ERROR) << msg;
-            prestoTask->task->setError(msg);
-            RECORD_METRIC_VALUE(kCounterNumCancelledTasksByStuckDriver, 1);
-            break;
+  return taskMap_.forEachTaskWithLockTimeout(
+      lockTimeoutMs, [&](const auto& id, const auto& prestoTask) {
+        if (prestoTask->task == nullptr) {
+          return;
+        }
+        const auto numPrevStuckOps = stuckOpCalls.size();
+        if (!prestoTask->task->getLongRunningOpCalls(
+                lockTimeoutMs, thresholdDurationMs, stuckOpCalls)) {
+          deadlockTasks.push_back(id);
+          return;
+        }
+        // See if we need to cancel the Task - it should be running, the cancel
+        // threshold should be valid and it should have at least one stuck
+        // driver that was stuck for enough time.
+        if (numPrevStuckOps < stuckOpCalls.size() && thresholdCancelMs != 0 &&
+            prestoTask->task->isRunning()) {
+          for (auto it = stuckOpCalls.begin() + numPrevStuckOps;
+               it != stuckOpCalls.end();
+               ++it) {
+            if (it->durationMs >= thresholdCancelMs) {
+              std::stringstream ss;
+              ss << "Task " << id
+                 << " cancelled due to stuck operator: tid=" << it->tid
+                 << " opCall=" << it->opCall
+                 << " duration= " << velox::succinctMillis(it->durationMs);
+              const std::string msg = ss.str();
+              LOG(ERROR) << msg;
+              prestoTask->task->setError(msg);
+              RECORD_METRIC_VALUE(kCounterNumCancelledTasksByStuckDriver, 1);
+              break;
+            }
           }
         }
-      }
-    }
-  }
-  return true;
+      });
 }
 
 int32_t TaskManager::yieldTasks(
     int32_t numTargetThreadsToYield,
     int32_t timeSliceMicros) {
-  const auto taskMap = taskMap_.rlock();
   int32_t numYields = 0;
   uint64_t now = getCurrentTimeMicro();
-  for (const auto& pair : *taskMap) {
-    if (pair.second->task != nullptr) {
-      numYields += pair.second->task->yieldIfDue(now - timeSliceMicros);
-      if (numYields >= numTargetThreadsToYield) {
-        return numYields;
+  const auto throttledQueries = cpuThrottledQueries_.copy();
+  // Yield tasks of queries exceeding their CPU share first, so the queued
+  // drivers they displace come from the noisiest neighbor.
+  if (!throttledQueries.empty()) {
+    taskMap_.forEachTask([&](const auto& /*taskId*/, const auto& prestoTask) {
+      if (numYields >= numTargetThreadsToYield ||
+          prestoTask->task == nullptr) {
+        return;
       }
-    }
+      if (throttledQueries.count(prestoTask->id.queryId()) != 0) {
+        numYields += prestoTask->task->yieldIfDue(now - timeSliceMicros);
+      }
+    });
   }
+  taskMap_.forEachTask([&](const auto& /*taskId*/, const auto& prestoTask) {
+    if (numYields >= numTargetThreadsToYield || prestoTask->task == nullptr) {
+      return;
+    }
+    if (throttledQueries.count(prestoTask->id.queryId()) != 0) {
+      // Already visited in the first pass.
+      return;
+    }
+    numYields += prestoTask->task->yieldIfDue(now - timeSliceMicros);
+  });
   return numYields;
 }
 
+void TaskManager::updateQueryCpuUsage() {
+  // Roll the CPU time of all live tasks up to query level.
+  std::unordered_map<std::string, int64_t> cpuNanosByQuery;
+  taskMap_.forEachTask([&](const auto& /*taskId*/, const auto& prestoTask) {
+    const auto veloxTask = prestoTask->task;
+    if (veloxTask == nullptr) {
+      return;
+    }
+    int64_t cpuNanos{0};
+    for (const auto& pipeline : veloxTask->taskStats().pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        cpuNanos += op.isBlockedTiming.cpuNanos + op.addInputTiming.cpuNanos +
+            op.getOutputTiming.cpuNanos + op.finishTiming.cpuNanos;
+      }
+    }
+    cpuNanosByQuery[prestoTask->id.queryId()] += cpuNanos;
+  });
+
+  std::unordered_map<std::string, QueryCpuUsage> usage;
+  usage.reserve(cpuNanosByQuery.size());
+  int64_t totalWindowCpuNanos{0};
+  {
+    // Queries with no registered tasks left drop out of the map here.
+    auto lockedUsage = queryCpuUsage_.wlock();
+    for (const auto& [queryId, cpuTimeNanos] : cpuNanosByQuery) {
+      auto& entry = usage[queryId];
+      entry.cpuTimeNanos = cpuTimeNanos;
+      const auto it = lockedUsage->find(queryId);
+      entry.windowCpuTimeNanos = it == lockedUsage->end()
+          ? cpuTimeNanos
+          : std::max<int64_t>(cpuTimeNanos - it->second.cpuTimeNanos, 0);
+      totalWindowCpuNanos += entry.windowCpuTimeNanos;
+    }
+    *lockedUsage = usage;
+  }
+
+  const double maxCpuShare = SystemConfig::instance()->taskMaxQueryCpuShare();
+  std::unordered_set<std::string> throttledQueries;
+  if (maxCpuShare > 0 && totalWindowCpuNanos > 0 && usage.size() > 1) {
+    for (const auto& [queryId, entry] : usage) {
+      if (entry.windowCpuTimeNanos > maxCpuShare * totalWindowCpuNanos) {
+        throttledQueries.insert(queryId);
+      }
+    }
+  }
+  *cpuThrottledQueries_.wlock() = std::move(throttledQueries);
+}
+
+std::vector<std::pair<std::string, TaskManager::QueryCpuUsage>>
+TaskManager::topCpuQueries(size_t limit) const {
+  std::vector<std::pair<std::string, QueryCpuUsage>> result;
+  queryCpuUsage_.withRLock([&](const auto& usage) {
+    result.assign(usage.begin(), usage.end());
+  });
+  std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+    if (a.second.windowCpuTimeNanos != b.second.windowCpuTimeNanos) {
+      return a.second.windowCpuTimeNanos > b.second.windowCpuTimeNanos;
+    }
+    return a.second.cpuTimeNanos > b.second.cpuTimeNanos;
+  });
+  if (result.size() > limit) {
+    result.resize(limit);
+  }
+  return result;
+}
+
+void TaskManager::updateTimeSlicedStats() {
+  const auto windowMs =
+      SystemConfig::instance()->taskTimeSlicedStatsWindowMs();
+  if (windowMs == 0) {
+    return;
+  }
+  taskMap_.forEachTask([&](const auto& /*taskId*/, const auto& prestoTask) {
+    prestoTask->recordTimeSlicedStats(windowMs);
+  });
+}
+
+std::string TaskManager::getTimeSlicedStatsJson(
+    const protocol::TaskId& taskId) const {
+  auto prestoTask = taskMap_.find(taskId);
+  VELOX_USER_CHECK_NOT_NULL(
+      prestoTask, "Time-sliced stats requested for unknown task {}", taskId);
+  return folly::toJson(prestoTask->timeSlicedStatsJson());
+}
+
+std::string TaskManager::getTaskDebugJson(
+    const protocol::TaskId& taskId) const {
+  auto prestoTask = taskMap_.find(taskId);
+  VELOX_USER_CHECK_NOT_NULL(
+      prestoTask, "Debug state requested for unknown task {}", taskId);
+  return folly::toPrettyJson(prestoTask->toJson());
+}
+
+void TaskManager::updateQueryQueuedDriverTime() {
+  const auto nowMs = getCurrentTimeMs();
+  const auto elapsedMs = lastQueuedDriverSampleMs_ == 0
+      ? 0
+      : nowMs - lastQueuedDriverSampleMs_;
+  lastQueuedDriverSampleMs_ = nowMs;
+
+  // Sample the number of drivers of each query waiting in the driver executor
+  // queue right now. Each sample contributes queuedDrivers * elapsed time to
+  // the query's queued-driver time, so the accumulated value approximates the
+  // integral of the query's queue occupancy.
+  std::unordered_map<std::string, int64_t> queuedDriversByQuery;
+  taskMap_.forEachTask([&](const auto& /*taskId*/, const auto& prestoTask) {
+    const auto veloxTask = prestoTask->task;
+    if (veloxTask == nullptr) {
+      return;
+    }
+    queuedDriversByQuery[prestoTask->id.queryId()] +=
+        veloxTask->taskStats().numQueuedDrivers;
+  });
+
+  // Queries with no registered tasks left drop out of the map here.
+  auto lockedTimes = queryQueueTime_.wlock();
+  std::unordered_map<std::string, QueryQueueTime> times;
+  times.reserve(queuedDriversByQuery.size());
+  for (const auto& [queryId, numQueuedDrivers] : queuedDriversByQuery) {
+    auto& entry = times[queryId];
+    entry.windowQueuedDriverMs = numQueuedDrivers * elapsedMs;
+    const auto it = lockedTimes->find(queryId);
+    entry.queuedDriverMs = entry.windowQueuedDriverMs +
+        (it == lockedTimes->end() ? 0 : it->second.queuedDriverMs);
+  }
+  *lockedTimes = std::move(times);
+}
+
+std::vector<std::pair<std::string, TaskManager::QueryQueueTime>>
+TaskManager::topQueuedQueries(size_t limit) const {
+  std::vector<std::pair<std::string, QueryQueueTime>> result;
+  queryQueueTime_.withRLock([&](const auto& times) {
+    result.assign(times.begin(), times.end());
+  });
+  std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+    if (a.second.windowQueuedDriverMs != b.second.windowQueuedDriverMs) {
+      return a.second.windowQueuedDriverMs > b.second.windowQueuedDriverMs;
+    }
+    return a.second.queuedDriverMs > b.second.queuedDriverMs;
+  });
+  if (result.size() > limit) {
+    result.resize(limit);
+  }
+  return result;
+}
+
 std::array<size_t, 6> TaskManager::getTaskNumbers(size_t& numTasks) const {
   std::array<size_t, 6> res{0};
-  auto taskMap = taskMap_.rlock();
   numTasks = 0;
-  for (const auto& pair : *taskMap) {
-    if (pair.second->task != nullptr) {
-      const auto prestoTaskState = pair.second->taskState();
+  taskMap_.forEachTask([&](const auto& /*taskId*/, const auto& prestoTask) {
+    if (prestoTask->task != nullptr) {
+      const auto prestoTaskState = prestoTask->taskState();
       ++res[static_cast<int>(prestoTaskState)];
       ++numTasks;
     }
-  }
+  });
   return res;
 }
 
+std::string TaskManager::buildCrashHandoffSnapshot() const {
+  std::string snapshot;
+  taskMap_.forEachTask([&](const auto& taskId, const auto& prestoTask) {
+    std::lock_guard<std::mutex> l(prestoTask->mutex);
+    if (prestoTask->task == nullptr) {
+      return;
+    }
+    const auto state = prestoTask->taskState();
+    if (state != PrestoTaskState::kRunning) {
+      return;
+    }
+    snapshot += fmt::format("task {} {}", taskId, prestoTaskStateString(state));
+    for (const auto& buffer : prestoTask->info.outputBuffers.buffers) {
+      snapshot +=
+          fmt::format(" {}:{}", buffer.bufferId, buffer.pagesSent);
+    }
+    snapshot += '\n';
+  });
+  return snapshot;
+}
+
 size_t TaskManager::numQueuedTasks() const {
   size_t num = 0;
   auto lockedTaskQueue = taskQueue_.rlock();
@@ -1458,15 +2986,33 @@ size_t TaskManager::numQueuedTasks() const {
 }
 
 int64_t TaskManager::getBytesProcessed() const {
-  const auto taskMap = *taskMap_.rlock();
   int64_t totalCount = 0;
-  for (const auto& pair : taskMap) {
-    totalCount += pair.second->info.stats.processedInputDataSizeInBytes;
-  }
+  taskMap_.forEachTask([&](const auto& /*taskId*/, const auto& prestoTask) {
+    totalCount += prestoTask->info.stats.processedInputDataSizeInBytes;
+  });
   return totalCount;
 }
 
+int64_t TaskManager::getTotalSpilledBytes() const {
+  int64_t totalBytes = 0;
+  taskMap_.forEachTask([&](const auto& /*taskId*/, const auto& prestoTask) {
+    const auto veloxTask = prestoTask->task;
+    if (veloxTask == nullptr) {
+      return;
+    }
+    for (const auto& pipeline : veloxTask->taskStats().pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        totalBytes += op.spilledBytes;
+      }
+    }
+  });
+  return totalBytes;
+}
+
 void TaskManager::shutdown() {
+  if (splitIngestionScheduler_ != nullptr) {
+    splitIngestionScheduler_->shutdown();
+  }
   size_t numTasks;
   auto taskNumbers = getTaskNumbers(numTasks);
   size_t seconds = 0;
@@ -1481,22 +3027,24 @@ void TaskManager::shutdown() {
     ++seconds;
   }
 
-  taskMap_.withRLock([&](const TaskMap& taskMap) {
-    for (auto it = taskMap.begin(); it != taskMap.end(); ++it) {
-      const auto veloxTaskRefCount = it->second->task.use_count();
-      if (veloxTaskRefCount > 1) {
-        VELOX_CHECK_NOT_NULL(it->second->task);
-        PRESTO_SHUTDOWN_LOG(WARNING)
-            << "Velox task has pending reference on destruction: "
-            << it->second->task->taskId();
-        continue;
-      }
-      const auto prestoTaskRefCount = it->second.use_count();
-      if (prestoTaskRefCount > 1) {
-        PRESTO_SHUTDOWN_LOG(WARNING)
-            << "Presto task has pending reference on destruction: "
-            << it->second->id.toString();
-      }
+  // Finish any deferred task destructions before checking for leaked
+  // references below.
+  taskCleanupExecutor_->join();
+
+  taskMap_.forEachTask([](const auto& /*taskId*/, const auto& prestoTask) {
+    const auto veloxTaskRefCount = prestoTask->task.use_count();
+    if (veloxTaskRefCount > 1) {
+      VELOX_CHECK_NOT_NULL(prestoTask->task);
+      PRESTO_SHUTDOWN_LOG(WARNING)
+          << "Velox task has pending reference on destruction: "
+          << prestoTask->task->taskId();
+      return;
+    }
+    const auto prestoTaskRefCount = prestoTask.use_count();
+    if (prestoTaskRefCount > 1) {
+      PRESTO_SHUTDOWN_LOG(WARNING)
+          << "Presto task has pending reference on destruction: "
+          << prestoTask->id.toString();
     }
   });
 }
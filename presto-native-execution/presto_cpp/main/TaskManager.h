@@ -14,10 +14,21 @@
 #pragma once
 
 #include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <deque>
 #include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include "presto_cpp/main/FragmentResultCache.h"
 #include "presto_cpp/main/PrestoTask.h"
 #include "presto_cpp/main/QueryContextManager.h"
+#include "presto_cpp/main/SplitIngestionScheduler.h"
+#include "presto_cpp/main/TaskMemoryForecaster.h"
 #include "presto_cpp/main/http/HttpServer.h"
 #include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
 #include "velox/exec/OutputBufferManager.h"
@@ -27,6 +38,91 @@ namespace facebook::presto {
 // One entry can hold multiple queued tasks for the same query.
 using TaskQueue = std::deque<std::vector<std::weak_ptr<PrestoTask>>>;
 
+/// Task map sharded by taskId hash. Every status poll, result fetch and split
+/// update looks up its task here, and the PeriodicTaskManager sweep iterates
+/// over all tasks, so a single lock becomes a contention point with many
+/// concurrent tasks. Per-shard locks let lookups of different tasks proceed in
+/// parallel and iteration hold only one shard lock at a time. Shards are
+/// keyed by the fixed-size binary TaskIdKey rather than the task id string,
+/// so each lookup parses the id once and compares integers instead of ~60
+/// byte strings.
+class ShardedTaskMap {
+ public:
+  /// Returns the task registered under 'taskId', or nullptr if there is none.
+  std::shared_ptr<PrestoTask> find(const protocol::TaskId& taskId) const;
+
+  /// Registers 'task' under 'taskId' if no task is registered yet and returns
+  /// it. Returns the already registered task otherwise.
+  std::shared_ptr<PrestoTask> insertIfAbsent(
+      const protocol::TaskId& taskId,
+      std::shared_ptr<PrestoTask> task);
+
+  /// Removes the task registered under 'taskId' and returns it, or nullptr if
+  /// there is none.
+  std::shared_ptr<PrestoTask> eraseTask(const protocol::TaskId& taskId);
+
+  /// Returns the membership version, incremented whenever a task is
+  /// registered or removed. Lets callers that materialize the task set
+  /// check whether a cached snapshot is still current without taking any
+  /// shard lock.
+  uint64_t version() const {
+    return version_.load(std::memory_order_acquire);
+  }
+
+  size_t size() const;
+
+  /// Returns a copy of all shards merged into a single map. Note the copy
+  /// holds an extra reference to each task.
+  TaskMap copy() const;
+
+  /// Invokes 'func(taskId, task)' for each registered task, holding one shard
+  /// read lock at a time.
+  template <typename F>
+  void forEachTask(F func) const {
+    for (const auto& shard : shards_) {
+      shard.withRLock([&](const auto& taskMap) {
+        for (const auto& [key, prestoTask] : taskMap) {
+          func(prestoTask->info.taskId, prestoTask);
+        }
+      });
+    }
+  }
+
+  /// Same as forEachTask() but gives up and returns false if any shard read
+  /// lock cannot be taken within 'lockTimeout'. Shards visited before the
+  /// timeout have already been passed to 'func'.
+  template <typename F>
+  bool forEachTaskWithLockTimeout(
+      std::chrono::milliseconds lockTimeout,
+      F func) const {
+    for (const auto& shard : shards_) {
+      auto taskMap = shard.rlock(lockTimeout);
+      if (!taskMap) {
+        return false;
+      }
+      for (const auto& [key, prestoTask] : *taskMap) {
+        func(prestoTask->info.taskId, prestoTask);
+      }
+    }
+    return true;
+  }
+
+ private:
+  static constexpr size_t kNumShards{64};
+
+  // The shards hold tasks under the parsed binary key; the task's own
+  // 'info.taskId' keeps the string form for callers that need it.
+  using ShardMap = folly::
+      F14FastMap<TaskIdKey, std::shared_ptr<PrestoTask>, TaskIdKey::Hash>;
+
+  folly::Synchronized<ShardMap>& shard(const TaskIdKey& key);
+  const folly::Synchronized<ShardMap>& shard(const TaskIdKey& key) const;
+
+  std::array<folly::Synchronized<ShardMap>, kNumShards> shards_;
+  // Bumped on every registration and removal; see version().
+  std::atomic<uint64_t> version_{1};
+};
+
 class TaskManager {
  public:
   TaskManager(
@@ -54,8 +150,74 @@ class TaskManager {
   /// its completion.
   void setOldTaskCleanUpMs(int32_t oldTaskCleanUpMs);
 
+  /// Registers a callback invoked with each distinct remote source location
+  /// seen in a task update, outside the task lock. Used to warm up exchange
+  /// connections to upstream workers ahead of the first getData request.
+  void setRemoteSourceWarmupCallback(
+      std::function<void(const std::string& remoteSourceLocation)> callback);
+
+  /// Registers the callback that fans a local query failure out to the
+  /// upstream workers this worker has exchange connections to. Only invoked
+  /// when task.query-failure-gossip-enabled is set.
+  void setQueryFailureGossipCallback(
+      std::function<void(
+          const std::string& queryId,
+          const std::vector<std::string>& remoteSourceLocations)> callback);
+
+  /// Invoked when a task of 'queryId' fails on this worker. Hands the
+  /// upstream worker locations recorded for the query to the gossip callback,
+  /// at most once per query.
+  void publishQueryFailure(const std::string& queryId);
+
+  /// Aborts the running tasks of 'queryId' in response to a query failure
+  /// reported by a sibling worker. Returns the number of aborted tasks.
+  size_t fastFailQueryTasks(const std::string& queryId);
+
   TaskMap tasks() const;
 
+  /// Snapshot of the serialized task listing served by the /v1/tasks
+  /// endpoint.
+  struct TaskListSnapshot {
+    /// JSON array of summarized TaskInfos.
+    std::string body;
+    /// Wall time the snapshot was built at, in milliseconds since epoch.
+    /// Used to report the snapshot age to callers.
+    uint64_t buildTimeMs{0};
+  };
+
+  /// Builds and returns a fresh task listing snapshot without publishing it.
+  std::shared_ptr<const TaskListSnapshot> buildTaskListSnapshot() const;
+
+  /// Builds a new task listing snapshot and publishes it for
+  /// taskListSnapshot(). Invoked by PeriodicTaskManager at most every
+  /// 'task.list-snapshot-refresh-ms' so listing requests from cluster UIs on
+  /// busy workers are served from the snapshot instead of serializing every
+  /// task fresh.
+  void rebuildTaskListSnapshot();
+
+  /// Returns the latest published task listing snapshot, or nullptr when
+  /// bounded-staleness serving is disabled and no snapshot is being rebuilt.
+  std::shared_ptr<const TaskListSnapshot> taskListSnapshot() const;
+
+  /// Materialized view of the registered task set, served to the system
+  /// table scans. Holds shared pointers to the live tasks, so state and
+  /// stats read through it are always current; only membership is captured
+  /// at build time.
+  struct TaskSetSnapshot {
+    /// Task map membership version the snapshot was built from.
+    uint64_t version{0};
+    std::vector<std::shared_ptr<PrestoTask>> tasks;
+  };
+
+  /// Returns the current task set snapshot, rebuilding and republishing it
+  /// only when tasks were registered or removed since the published one was
+  /// built. A scan over an unchanged task set costs one version load and a
+  /// shared_ptr copy instead of a walk over all shard locks, keeping
+  /// continuous system-table polling off the data path's locks. A snapshot
+  /// built concurrently with a membership change may miss it; the next call
+  /// observes the newer version and rebuilds.
+  std::shared_ptr<const TaskSetSnapshot> taskSetSnapshot() const;
+
   void abortResults(const protocol::TaskId& taskId, long bufferId);
 
   void
@@ -89,33 +251,56 @@ class TaskManager {
   // buffer manager. This method uses the getData() global call to fetch
   // data for each resultRequest bufferManager. If the output buffer for task
   // is not found, prepares the Result object with completed flags set to false
-  // and notifies the future.
+  // and notifies the future. If 'resultCapture' is set, the fetched pages are
+  // also recorded for the fragment result cache.
   // Note: This method is made public for unit testing purpose only.
   void getDataForResultRequests(
       const std::unordered_map<int64_t, std::shared_ptr<ResultRequest>>&
-          resultRequests);
+          resultRequests,
+      std::shared_ptr<FragmentResultCapture> resultCapture = nullptr);
 
   std::unique_ptr<protocol::TaskInfo>
   deleteTask(const protocol::TaskId& taskId, bool abort, bool summarize);
 
+  /// Forecasts the peak memory of a task about to be created from
+  /// 'serializedFragment' and triggers memory arbitration when the forecast
+  /// exceeds the arbitrator's free capacity, so tasks of shapes that
+  /// historically ran the worker out of memory queue briefly on admission
+  /// instead of being pushed back mid-execution. Also registers the task
+  /// with the forecaster so its peak memory is folded back in on
+  /// completion. See 'task.memory-forecast-enabled'.
+  void forecastTaskMemory(
+      const protocol::TaskId& taskId,
+      const std::string& serializedFragment);
+
   /// Remove old Finished, Cancelled, Failed and Aborted tasks.
-  /// Old is being defined by the lifetime of the task.
+  /// Old is being defined by the lifetime of the task. Removes at most a
+  /// bounded number of tasks per call and destroys them on a dedicated
+  /// cleanup thread; the remainder is picked up by subsequent calls.
   size_t cleanOldTasks();
 
+  /// 'fieldMask' selects the stat groups the returned TaskInfo carries; the
+  /// default mask keeps everything the 'summarize' flag allows.
   folly::Future<std::unique_ptr<protocol::TaskInfo>> getTaskInfo(
       const protocol::TaskId& taskId,
       bool summarize,
       std::optional<protocol::TaskState> currentState,
       std::optional<protocol::Duration> maxWait,
-      std::shared_ptr<http::CallbackRequestHandlerState> state);
+      std::shared_ptr<http::CallbackRequestHandlerState> state,
+      const TaskInfoFieldMask& fieldMask = {});
 
+  /// 'exchangeColumns' optionally carries the consumer's exchange column
+  /// mask (comma-separated ascending column indices); when set, the unused
+  /// columns of the served pages are replaced with null constants before the
+  /// response travels the wire. See 'exchange.selective-columns-enabled'.
   folly::Future<std::unique_ptr<Result>> getResults(
       const protocol::TaskId& taskId,
       long destination,
       long token,
       protocol::DataSize maxSize,
       protocol::Duration maxWait,
-      std::shared_ptr<http::CallbackRequestHandlerState> state);
+      std::shared_ptr<http::CallbackRequestHandlerState> state,
+      const std::string& exchangeColumns = {});
 
   folly::Future<std::unique_ptr<protocol::TaskStatus>> getTaskStatus(
       const protocol::TaskId& taskId,
@@ -123,6 +308,24 @@ class TaskManager {
       std::optional<protocol::Duration> maxWait,
       std::shared_ptr<http::CallbackRequestHandlerState> state);
 
+  /// Thrift variant of getTaskStatus(). Populates the Thrift task status
+  /// directly from the task state so the high-frequency status polling path
+  /// does not copy the protocol status struct before serialization.
+  folly::Future<std::unique_ptr<thrift::TaskStatus>> getTaskStatusThrift(
+      const protocol::TaskId& taskId,
+      std::optional<protocol::TaskState> currentState,
+      std::optional<protocol::Duration> maxWait,
+      std::shared_ptr<http::CallbackRequestHandlerState> state);
+
+  /// Returns the statuses of several tasks as one JSON array, so a poller
+  /// fetches a worker's tasks in a single request. 'requestBody' is a JSON
+  /// array of task ids or {"taskId", "etag"} objects; entries whose ETag
+  /// still matches the current status are answered with "notModified"
+  /// instead of a status body, and tasks unknown to this worker are marked
+  /// "unknown". Serialized statuses are cached per task under a content-hash
+  /// ETag, so polling a finished task reuses the cached bytes.
+  std::string getTaskStatusBatchJson(const std::string& requestBody);
+
   void removeRemoteSource(
       const protocol::TaskId& taskId,
       const protocol::TaskId& remoteSourceTaskId);
@@ -135,18 +338,77 @@ class TaskManager {
 
   /// Make upto target task threads to yield. Task candidate must have been on
   /// thread for at least sliceMicros to be yieldable. Return the number of
-  /// threads in tasks that were requested to yield.
+  /// threads in tasks that were requested to yield. Tasks of queries marked
+  /// CPU-throttled by updateQueryCpuUsage() are yielded first.
   int32_t yieldTasks(int32_t numTargetThreadsToYield, int32_t timeSliceMicros);
 
+  /// Per-query CPU usage rolled up from task stats by updateQueryCpuUsage().
+  struct QueryCpuUsage {
+    /// Total CPU time consumed by the query's tasks on this worker.
+    int64_t cpuTimeNanos{0};
+    /// CPU time consumed between the last two updateQueryCpuUsage() calls.
+    int64_t windowCpuTimeNanos{0};
+  };
+
+  /// Rolls the CPU time of all registered tasks up to query level. Invoked
+  /// periodically by the PeriodicTaskManager. If
+  /// SystemConfig::taskMaxQueryCpuShare() is positive, queries whose share of
+  /// the driver CPU consumed since the previous call exceeds it are marked
+  /// for preferential yielding in yieldTasks().
+  void updateQueryCpuUsage();
+
+  /// Returns up to 'limit' queries ordered by the CPU time consumed in the
+  /// last update interval, largest first.
+  std::vector<std::pair<std::string, QueryCpuUsage>> topCpuQueries(
+      size_t limit) const;
+
+  /// Per-query queued-driver time sampled by updateQueryQueuedDriverTime().
+  struct QueryQueueTime {
+    /// Cumulative queued-driver milliseconds: the integral over time of the
+    /// number of the query's drivers waiting in the driver executor queue.
+    int64_t queuedDriverMs{0};
+    /// Portion accumulated between the last two samples.
+    int64_t windowQueuedDriverMs{0};
+  };
+
+  /// Samples how many drivers of each live query are waiting in the driver
+  /// executor queue and accumulates that into per-query queued-driver time,
+  /// attributing executor queueing delay to the queries causing it. Invoked
+  /// periodically by the PeriodicTaskManager.
+  void updateQueryQueuedDriverTime();
+
+  /// Returns up to 'limit' queries ordered by the queued-driver time
+  /// accumulated in the last sample interval, largest first.
+  std::vector<std::pair<std::string, QueryQueueTime>> topQueuedQueries(
+      size_t limit) const;
+
+  /// Folds the operator stats growth of every live task into its time-sliced
+  /// stats history. Invoked periodically by the PeriodicTaskManager; a no-op
+  /// unless 'task.time-sliced-stats-window-ms' is positive.
+  void updateTimeSlicedStats();
+
+  /// Returns the time-sliced stats history of 'taskId' as a flame-chart JSON
+  /// string. Throws if the task is not known to this worker.
+  std::string getTimeSlicedStatsJson(const protocol::TaskId& taskId) const;
+
+  /// Returns a JSON dump of the task's internal state, including each
+  /// exchange source's queue depth, retry state and last-response timing.
+  /// Throws if the task is not known to this worker.
+  std::string getTaskDebugJson(const protocol::TaskId& taskId) const;
+
   const QueryContextManager* getQueryContextManager() const;
 
   inline size_t getNumTasks() const {
-    return taskMap_.rlock()->size();
+    return taskMap_.size();
   }
 
   /// Returns the processed input data size in bytes for tasks.
   int64_t getBytesProcessed() const;
 
+  /// Returns the total bytes spilled by all live tasks, summed from their
+  /// velox operator stats.
+  int64_t getTotalSpilledBytes() const;
+
   /// Stores the number of drivers in various states of execution.
   velox::exec::Task::DriverCounts getDriverCounts();
 
@@ -157,6 +419,12 @@ class TaskManager {
   /// Returns number of tasks in the task queue.
   size_t numQueuedTasks() const;
 
+  /// Returns one line per live task for the crash handoff snapshot: the task
+  /// id, its state and the pages sent to each output buffer consumer, so a
+  /// coordinator reading a crash dump knows what was in flight; see
+  /// 'crash-handoff.enabled'.
+  std::string buildCrashHandoffSnapshot() const;
+
   /// Invoked to check the stuck operation calls in the system.  If the function
   /// fails to get the stuck call information from a task due to the lock
   /// timeout, it adds the task to 'blockedTasks'.  Otherwise, it adds all stuck
@@ -217,6 +485,20 @@ class TaskManager {
   // coordinator for a considerable time.
   void cancelAbandonedTasks();
 
+  // Warms exchange connections to the upstream locations the coordinator
+  // announced in the 'native_prestart_upstream_locations' session property,
+  // sent with early fragment-only task creates so a pre-started task's
+  // connections are open before its remote splits arrive. No-op when the
+  // property is absent or no warm-up callback is registered.
+  void warmupAnnouncedUpstreamLocations(
+      const protocol::SessionRepresentation& session);
+
+  // 'fragmentResultCacheKey' is set when the update is eligible for the
+  // fragment result cache; task creation then either serves the cached
+  // result or starts capturing the task's output under that key.
+  // 'queryDeadlineMs' is the query's absolute wall deadline carried in the
+  // session properties, or 0 when none is set; updates arriving past it are
+  // refused. See PrestoTask::queryDeadlineMs.
   std::unique_ptr<protocol::TaskInfo> createOrUpdateTaskImpl(
       const protocol::TaskId& taskId,
       const velox::core::PlanFragment& planFragment,
@@ -224,7 +506,73 @@ class TaskManager {
       const protocol::OutputBuffers& outputBuffers,
       bool summarize,
       std::shared_ptr<velox::core::QueryCtx> queryCtx,
-      long startProcessCpuTime);
+      long startProcessCpuTime,
+      uint64_t queryDeadlineMs,
+      const std::optional<std::string>& fragmentResultCacheKey);
+
+  // Completes a task straight from a fragment result cache entry without
+  // creating a velox task: marks the task FINISHED, answers any parked result
+  // and status requests and returns the synthesized TaskInfo. Must be called
+  // with the presto task's mutex held.
+  std::unique_ptr<protocol::TaskInfo> serveFromFragmentResultCacheLocked(
+      std::shared_ptr<PrestoTask>& prestoTask,
+      std::shared_ptr<const FragmentResultCacheEntry> cachedResult,
+      bool summarize);
+
+  // Resolves a scan-share waiter once the identical fragment it subscribed
+  // to has finished: serves the waiter from the leader's published 'entry'
+  // and aborts its never-started velox task, or, when 'entry' is null
+  // because the leader never published, starts the waiter's own execution
+  // with a fresh capture under 'fragmentResultCacheKey'.
+  void onScanShareLeaderDone(
+      std::shared_ptr<PrestoTask> prestoTask,
+      const std::string& fragmentResultCacheKey,
+      std::shared_ptr<const FragmentResultCacheEntry> entry);
+
+  // Speculatively dequeues the page sequence following 'served' from the
+  // task's output buffer while the response for 'served' streams out, so a
+  // back-to-back getResults request is answered without waiting on a
+  // dequeue. Retains a copy of 'served' to answer a retried transfer, since
+  // the speculative dequeue acknowledges the served pages in the buffer.
+  // No-op if 'served' is complete, made no progress, or a dequeue for the
+  // destination is already in flight.
+  void maybeStartResultsPrefetch(
+      const std::shared_ptr<PrestoTask>& prestoTask,
+      long destination,
+      protocol::DataSize maxSize,
+      const Result& served);
+
+  // Hands one result long poll's promise to the task's output buffer, which
+  // fulfills it when pages or the end marker arrive for 'token'. All dequeue
+  // sites of the getResults() poll dispatch through here so they agree on
+  // the capture and materialization plumbing.
+  void dispatchResultData(
+      const std::shared_ptr<PrestoTask>& prestoTask,
+      const PromiseHolderPtr<std::unique_ptr<Result>>& promiseHolder,
+      const std::weak_ptr<http::CallbackRequestHandlerState>& state,
+      long destination,
+      long token,
+      protocol::DataSize maxSize);
+
+  // Binds a result long poll's future to the http executor and arms the
+  // poll's timeout, which answers with an empty result carrying 'token' when
+  // neither data nor the end marker arrives in time. Every getResults() path
+  // that waits on the buffer returns through here, keeping the
+  // wait/timeout/data-arrival sequencing in one place.
+  folly::Future<std::unique_ptr<Result>> armResultTimeout(
+      folly::SemiFuture<std::unique_ptr<Result>> future,
+      long token,
+      uint64_t maxWaitMicros);
+
+  // Hands one source's split batch to the fair split ingestion scheduler
+  // instead of adding the splits inline. The queued item adds the splits in
+  // arrival order and runs the source's no-more-splits handling once the
+  // batch is fully ingested.
+  void scheduleSplitIngestion(
+      std::shared_ptr<PrestoTask> prestoTask,
+      std::shared_ptr<velox::exec::Task> execTask,
+      protocol::TaskSource source,
+      std::vector<velox::exec::Split> splits);
 
   std::shared_ptr<PrestoTask> findOrCreateTask(
       const protocol::TaskId& taskId,
@@ -233,17 +581,68 @@ class TaskManager {
   // Starting the task with task mutex already locked.
   void startTaskLocked(std::shared_ptr<PrestoTask>& prestoTask);
 
+  // Upstream worker locations seen in task updates of one query, kept for
+  // failure gossip. 'lastUpdateMs' drives expiry in cleanOldTasks().
+  struct QueryRemoteSources {
+    std::unordered_set<std::string> locations;
+    int64_t lastUpdateMs{0};
+  };
+
   std::string baseUri_;
   std::string nodeId_;
+  std::function<void(const std::string&)> remoteSourceWarmupCallback_;
+  std::function<void(
+      const std::string& queryId,
+      const std::vector<std::string>& remoteSourceLocations)>
+      queryFailureGossipCallback_;
   folly::Synchronized<std::string> baseSpillDir_;
   int32_t oldTaskCleanUpMs_;
   std::shared_ptr<velox::exec::OutputBufferManager> bufferManager_;
-  folly::Synchronized<TaskMap> taskMap_;
+  ShardedTaskMap taskMap_;
+  // Latest published task listing snapshot; nullptr until the first periodic
+  // rebuild.
+  folly::Synchronized<std::shared_ptr<const TaskListSnapshot>>
+      taskListSnapshot_;
+  // Latest published task set snapshot; rebuilt lazily by taskSetSnapshot()
+  // when the task map membership version moved past it.
+  mutable folly::Synchronized<std::shared_ptr<const TaskSetSnapshot>>
+      taskSetSnapshot_;
   folly::Synchronized<TaskQueue> taskQueue_;
+  folly::Executor* driverExecutor_;
   folly::Executor* httpSrvCpuExecutor_;
+  // Destroys swept PrestoTask/velox Task objects off the periodic cleanup
+  // thread; destroying a task with large operator state is expensive and used
+  // to run inline in cleanOldTasks().
+  std::unique_ptr<folly::CPUThreadPoolExecutor> taskCleanupExecutor_;
+  // Fair split ingestion across queries; nullptr when
+  // task.split-ingestion-fairness-enabled is off and splits are added inline.
+  std::shared_ptr<SplitIngestionScheduler> splitIngestionScheduler_;
+  // Cache of final fragment output for identical deterministic re-executions;
+  // nullptr when fragment-result-cache.enabled is off.
+  std::unique_ptr<FragmentResultCache> fragmentResultCache_;
+  // Peak-memory history per plan fragment shape, consulted on task admission;
+  // see 'task.memory-forecast-enabled'.
+  TaskMemoryForecaster memoryForecaster_;
+  // True when task.query-failure-gossip-enabled is set; gates the upstream
+  // location bookkeeping below.
+  const bool queryFailureGossipEnabled_;
+  // True when served output pages are teed to durable storage for exchange
+  // failover; see 'exchange.materialization-enabled'.
+  const bool exchangeMaterializationEnabled_;
+  // Keyed by query id; entries expire with the old-task cleanup.
+  folly::Synchronized<std::unordered_map<std::string, QueryRemoteSources>>
+      queryRemoteSources_;
   std::atomic_bool serverOverloaded_{false};
   std::atomic_uint64_t lastNotOverloadedTimeInSecs_;
   std::atomic_uint32_t numQueuedDrivers_{0};
+  folly::Synchronized<std::unordered_map<std::string, QueryCpuUsage>>
+      queryCpuUsage_;
+  folly::Synchronized<std::unordered_set<std::string>> cpuThrottledQueries_;
+  folly::Synchronized<std::unordered_map<std::string, QueryQueueTime>>
+      queryQueueTime_;
+  // Time of the last updateQueryQueuedDriverTime() sample. Only accessed from
+  // the periodic stats thread.
+  int64_t lastQueuedDriverSampleMs_{0};
 };
 
 } // namespace facebook::presto
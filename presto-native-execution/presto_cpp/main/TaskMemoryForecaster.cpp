@@ -0,0 +1,74 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/TaskMemoryForecaster.h"
+
+namespace facebook::presto {
+
+// static
+uint64_t TaskMemoryForecaster::fragmentShapeHash(
+    const std::string& serializedFragment) {
+  return std::hash<std::string>{}(serializedFragment);
+}
+
+void TaskMemoryForecaster::registerTask(
+    const std::string& taskId,
+    uint64_t fragmentHash) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  taskShapes_.emplace(taskId, fragmentHash);
+}
+
+void TaskMemoryForecaster::recordCompletion(
+    const std::string& taskId,
+    int64_t peakBytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto taskIt = taskShapes_.find(taskId);
+  if (taskIt == taskShapes_.end()) {
+    return;
+  }
+  const auto fragmentHash = taskIt->second;
+  taskShapes_.erase(taskIt);
+
+  auto shapeIt = shapes_.find(fragmentHash);
+  if (shapeIt == shapes_.end()) {
+    if (shapes_.size() >= kCapacity) {
+      shapes_.erase(lru_.back());
+      lru_.pop_back();
+    }
+    lru_.push_front(fragmentHash);
+    shapes_.emplace(
+        fragmentHash,
+        ShapeStats{static_cast<double>(peakBytes), lru_.begin()});
+    return;
+  }
+  auto& stats = shapeIt->second;
+  stats.ewmaPeakBytes =
+      kAlpha * peakBytes + (1.0 - kAlpha) * stats.ewmaPeakBytes;
+  lru_.splice(lru_.begin(), lru_, stats.lruPosition);
+}
+
+void TaskMemoryForecaster::unregisterTask(const std::string& taskId) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  taskShapes_.erase(taskId);
+}
+
+int64_t TaskMemoryForecaster::forecastPeakBytes(uint64_t fragmentHash) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = shapes_.find(fragmentHash);
+  if (it == shapes_.end()) {
+    return -1;
+  }
+  return static_cast<int64_t>(it->second.ewmaPeakBytes);
+}
+
+} // namespace facebook::presto
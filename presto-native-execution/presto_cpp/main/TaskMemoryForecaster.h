@@ -0,0 +1,75 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace facebook::presto {
+
+/// Forecasts the peak memory of incoming tasks from the history of finished
+/// ones. Tasks are bucketed by the hash of their serialized plan fragment
+/// (the same hash the plan conversion cache keys on), so tasks of a stage
+/// and the recurring stages of periodic queries share one bucket, and each
+/// bucket keeps an exponentially weighted moving average of observed
+/// task-level peak memory. Task admission consults the forecast to trigger
+/// memory arbitration before accepting a task whose shape historically ran
+/// the worker into its memory limit, trading a brief admission delay for
+/// the reactive pushback path; see 'task.memory-forecast-enabled'. Buckets
+/// are bounded and evicted least recently used.
+class TaskMemoryForecaster {
+ public:
+  /// Buckets tracked before least recently used eviction.
+  static constexpr size_t kCapacity = 1024;
+
+  /// Returns the fragment-shape bucket of 'serializedFragment'.
+  static uint64_t fragmentShapeHash(const std::string& serializedFragment);
+
+  /// Associates a newly admitted task with its fragment-shape bucket so its
+  /// peak memory can be attributed on completion. Re-registering the same
+  /// task (repeated task updates carrying the fragment) is a no-op.
+  void registerTask(const std::string& taskId, uint64_t fragmentHash);
+
+  /// Folds the observed peak memory of a finished registered task into its
+  /// bucket's moving average and drops the registration. Unregistered tasks
+  /// are ignored.
+  void recordCompletion(const std::string& taskId, int64_t peakBytes);
+
+  /// Drops the registration of a task that did not finish (aborted, failed
+  /// or swept); its peak memory is not representative of the shape.
+  void unregisterTask(const std::string& taskId);
+
+  /// Returns the forecasted peak memory in bytes for 'fragmentHash', or -1
+  /// when the shape has no history yet.
+  int64_t forecastPeakBytes(uint64_t fragmentHash) const;
+
+ private:
+  // Weight of the newest observation in the moving average.
+  static constexpr double kAlpha = 0.25;
+
+  struct ShapeStats {
+    double ewmaPeakBytes{0};
+    std::list<uint64_t>::iterator lruPosition;
+  };
+
+  mutable std::mutex mutex_;
+  // Fragment-shape buckets in LRU order, most recently used first.
+  std::list<uint64_t> lru_;
+  std::unordered_map<uint64_t, ShapeStats> shapes_;
+  std::unordered_map<std::string, uint64_t> taskShapes_;
+};
+
+} // namespace facebook::presto
@@ -12,19 +12,93 @@
  * limitations under the License.
  */
 #include "presto_cpp/main/TaskResource.h"
+#include <openssl/crypto.h>
+#include <openssl/hmac.h>
+#include <condition_variable>
+#include <deque>
+#include <folly/String.h>
+#include <folly/hash/Checksum.h>
+#include <folly/hash/SpookyHashV2.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBufQueue.h>
+#include <folly/synchronization/Baton.h>
+#include <istream>
 #include <presto_cpp/main/common/Exception.h>
+#include "presto_cpp/main/ExchangeTracer.h"
+#include "presto_cpp/main/common/AllocationTracker.h"
 #include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
 #include "presto_cpp/main/common/Utils.h"
 #include "presto_cpp/main/thrift/ProtocolToThrift.h"
+#include "presto_cpp/main/thrift/TaskStatusDelta.h"
 #include "presto_cpp/main/thrift/ThriftIO.h"
 #include "presto_cpp/main/thrift/gen-cpp2/PrestoThrift.h"
 #include "presto_cpp/main/types/PrestoToVeloxQueryPlan.h"
+#include "presto_cpp/presto_protocol/Base64Util.h"
+#include "presto_cpp/presto_protocol/core/SimdJsonParser.h"
+#include "presto_cpp/presto_protocol/core/TaskStatusSerde.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/encode/Base64.h"
+#include "velox/common/time/Timer.h"
 #include "velox/core/PlanConsistencyChecker.h"
 
 namespace facebook::presto {
 
 namespace {
 
+// Force a full TaskStatus snapshot after this many consecutive delta
+// responses so a poller that dropped a delta converges.
+constexpr uint32_t kTaskStatusFullSnapshotEvery = 16;
+
+// How many applied update responses are remembered per task for retry
+// deduplication. Only the last few updates can still be retried within the
+// TTL, so the ring stays small.
+constexpr size_t kMaxAppliedUpdateResponsesPerTask = 4;
+
+// Digest of a task update request body used to recognize retried duplicate
+// deliveries. Hashes the logical byte stream, so network re-chunking does
+// not change the digest; the flags that shape the response are folded into
+// the seed since a duplicate must receive a response of the same form.
+uint64_t taskUpdateBodyDigest(
+    const std::vector<std::unique_ptr<folly::IOBuf>>& body,
+    bool summarize,
+    bool sendThrift,
+    bool receiveThrift) {
+  folly::hash::SpookyHashV2 hasher;
+  hasher.Init(
+      (summarize ? 1ULL : 0ULL) | (sendThrift ? 2ULL : 0ULL) |
+          (receiveThrift ? 4ULL : 0ULL),
+      0);
+  for (const auto& buf : body) {
+    for (const auto range : *buf) {
+      hasher.Update(range.data(), range.size());
+    }
+  }
+  uint64_t h1;
+  uint64_t h2;
+  hasher.Final(&h1, &h2);
+  return h1;
+}
+
+// Response header carrying the age, in milliseconds, of the task listing
+// snapshot served by the /v1/tasks endpoint.
+constexpr const char* kTaskListAgeMsHeader = "X-Presto-Task-List-Age-Ms";
+
+// Request header carrying the content digest of the serialized plan
+// fragment. A coordinator that sends it may omit the fragment from later
+// task creates of the same stage once the worker has interned the digest;
+// see 'task.fragment-interning-enabled'.
+constexpr const char* kFragmentDigestHeader = "X-Presto-Fragment-Digest";
+
+// Request header carrying the coordinator's HMAC-SHA256 signature, in hex,
+// of the plan fragment digest. A verified signature lets the worker skip the
+// per-task structural plan validation; see 'task.trusted-plan-enabled'.
+constexpr const char* kPlanSignatureHeader = "X-Presto-Plan-Signature";
+
+// Bound on the verified plan signature cache; see
+// 'verifiedPlanSignatures_'.
+constexpr size_t kMaxVerifiedPlanSignatures = 4096;
+
 void sendTaskNotFound(
     proxygen::ResponseHandler* downstream,
     const protocol::TaskId& taskId) {
@@ -55,6 +129,274 @@ std::optional<protocol::Duration> getMaxWait(proxygen::HTTPMessage* message) {
   return protocol::Duration(
       headers.getSingleOrEmpty(protocol::PRESTO_MAX_WAIT_HTTP_HEADER));
 }
+
+// Returns the crc32c of the iobuf chain 'data'. Sent on resumed getResults
+// responses so the consumer can validate the splice of its salvaged prefix
+// with the resent tail; see 'exchange.partial-page-resume-enabled'.
+uint32_t pageChecksum(const folly::IOBuf& data) {
+  uint32_t checksum = ~0U;
+  const folly::IOBuf* current = &data;
+  do {
+    if (current->length() > 0) {
+      checksum = folly::crc32c(current->data(), current->length(), checksum);
+    }
+    current = current->next();
+  } while (current != &data);
+  return checksum;
+}
+
+// Returns true if the converted plan embeds task-specific state and must not
+// be shared across the tasks of a stage through the plan conversion cache.
+// AssignUniqueId bakes a task-unique id into the node.
+bool hasTaskIdDependentNode(const velox::core::PlanNodePtr& node) {
+  if (std::dynamic_pointer_cast<const velox::core::AssignUniqueIdNode>(node) !=
+      nullptr) {
+    return true;
+  }
+  for (const auto& source : node->sources()) {
+    if (hasTaskIdDependentNode(source)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Minimum number of operator summaries in a TaskInfo before its JSON
+// encoding is offloaded to the serialization executor; small bodies are
+// cheaper to encode in place than to bounce between threads.
+constexpr size_t kSerializationOffloadMinOperators = 32;
+
+size_t taskInfoNumOperators(const protocol::TaskInfo& taskInfo) {
+  size_t numOperators = 0;
+  for (const auto& pipeline : taskInfo.stats.pipelines) {
+    numOperators += pipeline.operatorSummaries.size();
+  }
+  return numOperators;
+}
+
+// Encodes 'taskInfo' to a JSON string with the same invalid-UTF-8 fallback
+// as http::sendResponse().
+std::string taskInfoToJsonString(const protocol::TaskInfo& taskInfo) {
+  ScopedAllocationTag allocationTag{AllocationTag::kProtocolSerde};
+  const json body = taskInfo;
+  try {
+    return body.dump();
+  } catch (const std::exception&) {
+    auto messageBody =
+        body.dump(-1, ' ', false, nlohmann::detail::error_handler_t::replace);
+    LOG(WARNING) << "Failed to serialize TaskInfo json to string. "
+                    "Retried with 'replace' option.";
+    return messageBody;
+  }
+}
+
+// Parses a task update request body (or an embedded plan fragment) with the
+// configured JSON engine. simdjson parsing is opt-in via
+// 'task.update-request-simdjson-enabled'.
+json parseTaskUpdateJson(const std::string& body) {
+  ScopedAllocationTag allocationTag{AllocationTag::kProtocolSerde};
+  if (SystemConfig::instance()->taskUpdateRequestSimdJsonEnabled()) {
+    return protocol::parseJson(body);
+  }
+  return json::parse(body);
+}
+
+// Moves the 'splits' array out of every source in the parsed task update
+// request, leaving empty arrays behind. The returned arrays are decoded in
+// batches after the task has been created. Returns one entry per source, in
+// source order.
+// Bridges the IO thread receiving a request body and a parser thread
+// consuming it through std::istream. underflow() blocks until the next chunk
+// arrives, so a parse that runs while the body is still being received
+// finishes shortly after the last byte lands.
+class BodyChunkStreamBuf : public std::streambuf {
+ public:
+  // Queues 'chunk' for the consumer; nullptr marks the end of the body.
+  // Called on the IO thread.
+  void append(std::unique_ptr<folly::IOBuf> chunk) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (chunk == nullptr) {
+      ended_ = true;
+    } else {
+      // Flatten the chain so underflow() serves one buffer at a time.
+      while (chunk != nullptr) {
+        auto rest = chunk->pop();
+        if (chunk->length() > 0) {
+          chunks_.push_back(std::move(chunk));
+        }
+        chunk = std::move(rest);
+      }
+    }
+    cv_.notify_one();
+  }
+
+ protected:
+  int_type underflow() override {
+    std::unique_lock<std::mutex> l(mutex_);
+    cv_.wait(l, [&]() { return !chunks_.empty() || ended_; });
+    if (chunks_.empty()) {
+      return traits_type::eof();
+    }
+    current_ = std::move(chunks_.front());
+    chunks_.pop_front();
+    auto* data =
+        reinterpret_cast<char*>(const_cast<uint8_t*>(current_->data()));
+    setg(data, data, data + current_->length());
+    return traits_type::to_int_type(*data);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<folly::IOBuf>> chunks_;
+  // Buffer currently exposed through the get area.
+  std::unique_ptr<folly::IOBuf> current_;
+  bool ended_{false};
+};
+
+// Parse of a task update request body that overlaps with receiving it.
+struct StreamingBodyParse {
+  BodyChunkStreamBuf stream;
+  // Completes with the parsed body; empty until the first chunk arrives.
+  folly::Future<json> parsed{folly::Future<json>::makeEmpty()};
+};
+
+// State of one coordinator-push split stream; see
+// TaskResource::streamTaskSplits(). Body chunks land on the IO thread and
+// complete frames are chained onto 'applied', so frames run on the CPU
+// executor one at a time, in stream order.
+struct SplitStreamState {
+  // Bytes of the frame under assembly, carried across body chunks.
+  std::string pending;
+  // Tail of the chain of frame applications; the response completes after
+  // it. A frame failure skips the remaining frames and fails the response.
+  folly::Future<folly::Unit> applied = folly::makeFuture();
+};
+
+std::vector<json> extractSourceSplits(json& updateRequestJson) {
+  std::vector<json> sourceSplits;
+  auto sources = updateRequestJson.find("sources");
+  if (sources == updateRequestJson.end()) {
+    return sourceSplits;
+  }
+  for (auto& source : *sources) {
+    auto splits = source.find("splits");
+    if (splits != source.end()) {
+      sourceSplits.push_back(std::move(*splits));
+      *splits = json::array();
+    } else {
+      sourceSplits.push_back(json::array());
+    }
+  }
+  return sourceSplits;
+}
+
+// Coordination state of a parallel split decode, shared between the request
+// thread and the executor tasks it spawned. Shards are claimed through
+// 'nextShard', so each is decoded exactly once no matter which thread gets
+// to it; 'done' is posted by whichever thread completes the last shard.
+// Executor tasks that find no shard left exit without touching the split
+// data, which lets the request thread move on as soon as 'done' fires even
+// if some spawned tasks are still queued.
+struct SplitDecodeState {
+  explicit SplitDecodeState(size_t numShards) : numShards(numShards) {}
+
+  const size_t numShards;
+  std::atomic<size_t> nextShard{0};
+  std::atomic<size_t> completedShards{0};
+  folly::Baton<> done;
+  folly::Synchronized<std::exception_ptr> firstError;
+};
+
+// Decodes the split arrays extracted from a batch task update request into
+// 'sources', sharding the work across 'executor'. The request thread decodes
+// shards too, so the decode makes progress even when every executor thread
+// is busy. Throws the first decode error after all shards have settled.
+// 'concurrentWork', when set, runs on the request thread after the shard
+// tasks have been spawned and before it joins them, so independent decode
+// work (e.g. the plan fragment parse) overlaps with the split decode.
+void decodeSourceSplits(
+    std::vector<json>& sourceSplits,
+    std::vector<protocol::TaskSource>& sources,
+    folly::Executor* executor,
+    folly::Function<void()> concurrentWork = nullptr) {
+  static constexpr size_t kSplitsPerShard = 512;
+  VELOX_CHECK_EQ(sourceSplits.size(), sources.size());
+
+  // One entry per shard: the source it belongs to and the split range.
+  struct Shard {
+    size_t sourceIndex;
+    size_t offset;
+    size_t limit;
+  };
+  std::vector<Shard> shards;
+  for (size_t i = 0; i < sourceSplits.size(); ++i) {
+    sources[i].splits.resize(sourceSplits[i].size());
+    for (size_t offset = 0; offset < sourceSplits[i].size();
+         offset += kSplitsPerShard) {
+      shards.push_back(
+          {i,
+           offset,
+           std::min(offset + kSplitsPerShard, sourceSplits[i].size())});
+    }
+  }
+  if (shards.empty()) {
+    if (concurrentWork) {
+      concurrentWork();
+    }
+    return;
+  }
+
+  auto state = std::make_shared<SplitDecodeState>(shards.size());
+  auto decodeShards = [state, &sourceSplits, &sources, &shards]() {
+    while (true) {
+      const auto shardIndex = state->nextShard++;
+      if (shardIndex >= state->numShards) {
+        return;
+      }
+      const auto& shard = shards[shardIndex];
+      try {
+        const auto& splitsJson = sourceSplits[shard.sourceIndex];
+        auto& splits = sources[shard.sourceIndex].splits;
+        for (size_t i = shard.offset; i < shard.limit; ++i) {
+          splits[i] = splitsJson[i].get<protocol::ScheduledSplit>();
+        }
+      } catch (...) {
+        auto error = state->firstError.wlock();
+        if (*error == nullptr) {
+          *error = std::current_exception();
+        }
+      }
+      if (++state->completedShards == state->numShards) {
+        state->done.post();
+      }
+    }
+  };
+
+  // Spawn one task per shard beyond the one this thread decodes; surplus
+  // tasks find nothing to claim and return.
+  for (size_t i = 1; i < shards.size(); ++i) {
+    executor->add([decodeShards]() { decodeShards(); });
+  }
+  // A failure in 'concurrentWork' must not propagate before the shards have
+  // settled: the spawned tasks reference the caller's split data.
+  std::exception_ptr workError;
+  if (concurrentWork) {
+    try {
+      concurrentWork();
+    } catch (...) {
+      workError = std::current_exception();
+    }
+  }
+  decodeShards();
+  state->done.wait();
+  if (workError != nullptr) {
+    std::rethrow_exception(workError);
+  }
+  if (const auto error = *state->firstError.rlock()) {
+    std::rethrow_exception(error);
+  }
+}
 } // namespace
 
 void TaskResource::registerUris(http::HttpServer& server) {
@@ -72,6 +414,15 @@ void TaskResource::registerUris(http::HttpServer& server) {
         return acknowledgeResults(message, pathMatch);
       });
 
+  // Fixed path, so it must precede both task/(.+)/batch and /v1/task/(.+)
+  // which would otherwise match it.
+  server.registerPost(
+      R"(/v1/task/status/batch)",
+      [&](proxygen::HTTPMessage* message,
+          const std::vector<std::string>& pathMatch) {
+        return getTaskStatusBatch(message, pathMatch);
+      });
+
   // task/(.+)/batch must come before the /v1/task/(.+) as it's more specific
   // otherwise all requests will be matched with /v1/task/(.+)
   server.registerPost(
@@ -81,6 +432,16 @@ void TaskResource::registerUris(http::HttpServer& server) {
         return createOrUpdateBatchTask(message, pathMatch);
       });
 
+  if (SystemConfig::instance()->taskSplitStreamEnabled()) {
+    // Also more specific than /v1/task/(.+), so it must precede it too.
+    server.registerPost(
+        R"(/v1/task/(.+)/splits/stream)",
+        [&](proxygen::HTTPMessage* message,
+            const std::vector<std::string>& pathMatch) {
+          return streamTaskSplits(message, pathMatch);
+        });
+  }
+
   server.registerPost(
       R"(/v1/task/(.+))",
       [&](proxygen::HTTPMessage* message,
@@ -88,6 +449,15 @@ void TaskResource::registerUris(http::HttpServer& server) {
         return createOrUpdateTask(message, pathMatch);
       });
 
+  if (SystemConfig::instance()->taskQueryFailureGossipEnabled()) {
+    server.registerPost(
+        R"(/v1/queryFailure/(.+))",
+        [&](proxygen::HTTPMessage* message,
+            const std::vector<std::string>& pathMatch) {
+          return notifyQueryFailure(message, pathMatch);
+        });
+  }
+
   server.registerDelete(
       R"(/v1/task/(.+)/remote-source/(.+))",
       [&](proxygen::HTTPMessage* message,
@@ -109,19 +479,35 @@ void TaskResource::registerUris(http::HttpServer& server) {
         return getTaskStatus(message, pathMatch);
       });
 
+  server.registerGet(
+      R"(/v1/task/(.+)/timeSlicedStats)",
+      [&](proxygen::HTTPMessage* message,
+          const std::vector<std::string>& pathMatch) {
+        return getTimeSlicedStats(message, pathMatch);
+      });
+
+  server.registerGet(
+      R"(/v1/task/(.+)/debug)",
+      [&](proxygen::HTTPMessage* message,
+          const std::vector<std::string>& pathMatch) {
+        return getTaskDebug(message, pathMatch);
+      });
+
   server.registerHead(
       R"(/v1/task/(.+)/results/([0-9]+)/([0-9]+))",
       [&](proxygen::HTTPMessage* message,
           const std::vector<std::string>& pathMatch) {
         return getResults(message, pathMatch, true);
-      });
+      },
+      http::EndpointPriority::kData);
 
   server.registerGet(
       R"(/v1/task/(.+)/results/([0-9]+)/([0-9]+))",
       [&](proxygen::HTTPMessage* message,
           const std::vector<std::string>& pathMatch) {
         return getResults(message, pathMatch, false);
-      });
+      },
+      http::EndpointPriority::kData);
 
   server.registerGet(
       R"(/v1/task/(.+))",
@@ -129,6 +515,13 @@ void TaskResource::registerUris(http::HttpServer& server) {
           const std::vector<std::string>& pathMatch) {
         return getTaskInfo(message, pathMatch);
       });
+
+  server.registerGet(
+      R"(/v1/tasks)",
+      [&](proxygen::HTTPMessage* message,
+          const std::vector<std::string>& /*pathMatch*/) {
+        return getTaskListing(message);
+      });
 }
 
 proxygen::RequestHandler* TaskResource::abortResults(
@@ -146,6 +539,26 @@ proxygen::RequestHandler* TaskResource::abortResults(
             httpSrvCpuExecutor_,
             [this, taskId, destination, handlerState]() {
               taskManager_.abortResults(taskId, destination);
+              {
+                auto responses = emptyResultResponses_.wlock();
+                auto taskIt = responses->find(taskId);
+                if (taskIt != responses->end()) {
+                  taskIt->second.erase(destination);
+                  if (taskIt->second.empty()) {
+                    responses->erase(taskIt);
+                  }
+                }
+              }
+              {
+                auto compressors = pageCompressors_.wlock();
+                auto taskIt = compressors->find(taskId);
+                if (taskIt != compressors->end()) {
+                  taskIt->second.erase(destination);
+                  if (taskIt->second.empty()) {
+                    compressors->erase(taskIt);
+                  }
+                }
+              }
               return true;
             })
             .via(
@@ -209,6 +622,7 @@ proxygen::RequestHandler* TaskResource::createOrUpdateTaskImpl(
     const std::function<std::unique_ptr<protocol::TaskInfo>(
         const protocol::TaskId& taskId,
         const std::string& requestBody,
+        json* preparsedBody,
         const bool summarize,
         long startProcessCpuTime,
         bool receiveThrift)>& createOrUpdateFunc) {
@@ -228,6 +642,51 @@ proxygen::RequestHandler* TaskResource::createOrUpdateTaskImpl(
   const auto isCompressed =
       !contentEncoding.empty() && contentEncoding != "identity";
 
+  // For large uncompressed JSON updates, overlap receive and parse: body
+  // chunks are fed to a parser running on the CPU executor as they land on
+  // the IO thread, so the parse completes nearly when the last byte arrives
+  // instead of only starting then. The simdjson engine needs the whole body
+  // in one buffer and keeps the accumulate-then-parse path.
+  const auto* systemConfig = SystemConfig::instance();
+  const auto contentLength = folly::tryTo<uint64_t>(
+      headers.getSingleOrEmpty(proxygen::HTTP_HEADER_CONTENT_LENGTH));
+
+  // Small (status-only) updates are applied right on the IO thread: at this
+  // size the parse costs less than a CPU-executor hop, and handling them
+  // inline keeps cheap control updates from queueing behind multi-megabyte
+  // split deliveries on the executor. Compressed bodies are always offloaded
+  // since they can expand.
+  const auto inlineMaxBytes = systemConfig->taskUpdateInlineMaxBytes();
+  const bool processInline = inlineMaxBytes > 0 && !isCompressed &&
+      contentLength.hasValue() && contentLength.value() <= inlineMaxBytes;
+
+  std::shared_ptr<StreamingBodyParse> streamingParse;
+  if (!processInline && !receiveThrift && !isCompressed &&
+      systemConfig->taskUpdateStreamingParseEnabled() &&
+      !systemConfig->taskUpdateRequestSimdJsonEnabled()) {
+    if (contentLength.hasValue() &&
+        contentLength.value() >=
+            systemConfig->taskUpdateStreamingParseMinBytes()) {
+      streamingParse = std::make_shared<StreamingBodyParse>();
+    }
+  }
+
+  http::BodyChunkCallback onBodyChunk;
+  if (streamingParse != nullptr) {
+    onBodyChunk = [this, streamingParse](std::unique_ptr<folly::IOBuf> chunk) {
+      if (chunk != nullptr && !streamingParse->parsed.valid()) {
+        // Start the parse on the first chunk; it consumes the stream and
+        // blocks whenever it catches up with the network.
+        streamingParse->parsed =
+            folly::via(httpSrvCpuExecutor_, [streamingParse]() {
+              std::istream input(&streamingParse->stream);
+              return json::parse(input);
+            });
+      }
+      streamingParse->stream.append(std::move(chunk));
+    };
+  }
+
   return new http::CallbackRequestHandler(
       [this,
        taskId,
@@ -236,70 +695,187 @@ proxygen::RequestHandler* TaskResource::createOrUpdateTaskImpl(
        sendThrift,
        receiveThrift,
        contentEncoding,
-       isCompressed](
+       isCompressed,
+       processInline,
+       streamingParse](
           proxygen::HTTPMessage* /*message*/,
           const std::vector<std::unique_ptr<folly::IOBuf>>& body,
           proxygen::ResponseHandler* downstream,
           std::shared_ptr<http::CallbackRequestHandlerState> handlerState) {
+        // A coordinator that retries an update after a timeout resends a
+        // byte-identical body. With dedup enabled, a body whose digest
+        // matches a recently applied update of this task is answered from
+        // the remembered response before any parse or re-apply.
+        const auto dedupTtlMs = SystemConfig::instance()->taskUpdateDedupTtlMs();
+        uint64_t updateDigest{0};
+        if (dedupTtlMs > 0) {
+          updateDigest = taskUpdateBodyDigest(
+              body, summarize, sendThrift, receiveThrift);
+          if (auto remembered = findAppliedUpdateResponse(
+                  taskId, updateDigest, dedupTtlMs)) {
+            RECORD_METRIC_VALUE(kCounterTaskUpdateDedupHits);
+            if (!handlerState->requestExpired()) {
+              if (remembered->thrift) {
+                http::sendOkThriftResponse(downstream, remembered->body);
+              } else {
+                http::sendOkResponse(downstream, remembered->body);
+              }
+            }
+            // A streaming parse may already be running for this body; its
+            // result is simply dropped.
+            return;
+          }
+        }
+
+        auto process = [this, taskId, summarize, createOrUpdateFunc,
+                        receiveThrift](
+                           const std::string& requestBody,
+                           json* preparsedBody) {
+          const auto startProcessCpuTimeNs = util::getProcessCpuTimeNs();
+
+          std::unique_ptr<protocol::TaskInfo> taskInfo;
+          try {
+            taskInfo = createOrUpdateFunc(
+                taskId,
+                requestBody,
+                preparsedBody,
+                summarize,
+                startProcessCpuTimeNs,
+                receiveThrift);
+          } catch (const velox::VeloxException&) {
+            // Creating an empty task, putting errors inside so that next
+            // status fetch from coordinator will catch the error and well
+            // categorize it.
+            try {
+              taskInfo = taskManager_.createOrUpdateErrorTask(
+                  taskId,
+                  std::current_exception(),
+                  summarize,
+                  startProcessCpuTimeNs);
+            } catch (const velox::VeloxUserError&) {
+              throw;
+            }
+          }
+          return taskInfo;
+        };
+
+        auto sendResponse = [this,
+                             downstream,
+                             handlerState,
+                             sendThrift,
+                             taskId,
+                             dedupTtlMs,
+                             updateDigest](
+                                std::unique_ptr<protocol::TaskInfo> taskInfo) {
+          // With dedup enabled the response is serialized and remembered
+          // even when the peer already timed out and went away: the retry
+          // that follows is exactly the delivery the remembered response
+          // answers.
+          if (dedupTtlMs == 0 && handlerState->requestExpired()) {
+            return;
+          }
+          if (sendThrift) {
+            thrift::TaskInfo thriftTaskInfo;
+            toThrift(*taskInfo, thriftTaskInfo);
+            auto responseBody = thriftWrite(thriftTaskInfo);
+            if (dedupTtlMs > 0) {
+              rememberAppliedUpdateResponse(
+                  taskId, updateDigest, responseBody, true);
+            }
+            if (!handlerState->requestExpired()) {
+              http::sendOkThriftResponse(downstream, responseBody);
+            }
+          } else if (dedupTtlMs > 0) {
+            const json taskInfoJson(*taskInfo);
+            std::string responseBody;
+            try {
+              responseBody = taskInfoJson.dump();
+            } catch (const std::exception&) {
+              // Match sendOkResponse's handling of invalid UTF-8 sequences.
+              responseBody = taskInfoJson.dump(
+                  -1, ' ', false, nlohmann::detail::error_handler_t::replace);
+            }
+            rememberAppliedUpdateResponse(
+                taskId, updateDigest, responseBody, false);
+            if (!handlerState->requestExpired()) {
+              http::sendOkResponse(downstream, responseBody);
+            }
+          } else {
+            http::sendOkResponse(downstream, json(*taskInfo));
+          }
+        };
+
+        auto sendError = [downstream, handlerState](const std::exception& e) {
+          if (!handlerState->requestExpired()) {
+            http::sendErrorResponse(downstream, e.what());
+          }
+        };
+
+        const auto receivedMs = velox::getCurrentTimeMs();
+        if (processInline) {
+          // Reused per IO thread so each small update does not allocate a
+          // fresh body buffer.
+          thread_local std::string inlineBody;
+          inlineBody.clear();
+          for (const auto& buf : body) {
+            folly::io::Cursor cursor(buf.get());
+            const size_t chainLength = buf->computeChainDataLength();
+            const size_t offset = inlineBody.size();
+            inlineBody.resize(offset + chainLength);
+            cursor.pull(inlineBody.data() + offset, chainLength);
+          }
+          try {
+            auto taskInfo = process(inlineBody, nullptr);
+            RECORD_HISTOGRAM_METRIC_VALUE(
+                kCounterTaskUpdateInlineLatencyMs,
+                velox::getCurrentTimeMs() - receivedMs);
+            sendResponse(std::move(taskInfo));
+          } catch (const std::exception& e) {
+            sendError(e);
+          }
+          return;
+        }
+
+        if (streamingParse != nullptr && streamingParse->parsed.valid()) {
+          // The parse has been running since the first body chunk arrived;
+          // apply the update as soon as it completes.
+          std::move(streamingParse->parsed)
+              .thenValue([process = std::move(process), receivedMs,
+                          streamingParse](json parsedBody) {
+                auto taskInfo = process("", &parsedBody);
+                RECORD_HISTOGRAM_METRIC_VALUE(
+                    kCounterTaskUpdateOffloadedLatencyMs,
+                    velox::getCurrentTimeMs() - receivedMs);
+                return taskInfo;
+              })
+              .via(
+                  folly::getKeepAliveToken(
+                      folly::EventBaseManager::get()->getEventBase()))
+              .thenValue(std::move(sendResponse))
+              .thenError(folly::tag_t<std::exception>{}, std::move(sendError));
+          return;
+        }
+
         folly::via(
             httpSrvCpuExecutor_,
-            [this,
+            [process = std::move(process),
+             receivedMs,
              requestBody = isCompressed
                  ? util::decompressMessageBody(body, contentEncoding)
-                 : util::extractMessageBody(body),
-             taskId,
-             summarize,
-             createOrUpdateFunc,
-             receiveThrift]() {
-              const auto startProcessCpuTimeNs = util::getProcessCpuTimeNs();
-
-              std::unique_ptr<protocol::TaskInfo> taskInfo;
-              try {
-                taskInfo = createOrUpdateFunc(
-                    taskId,
-                    requestBody,
-                    summarize,
-                    startProcessCpuTimeNs,
-                    receiveThrift);
-              } catch (const velox::VeloxException&) {
-                // Creating an empty task, putting errors inside so that next
-                // status fetch from coordinator will catch the error and well
-                // categorize it.
-                try {
-                  taskInfo = taskManager_.createOrUpdateErrorTask(
-                      taskId,
-                      std::current_exception(),
-                      summarize,
-                      startProcessCpuTimeNs);
-                } catch (const velox::VeloxUserError&) {
-                  throw;
-                }
-              }
+                 : util::extractMessageBody(body)]() {
+              auto taskInfo = process(requestBody, nullptr);
+              RECORD_HISTOGRAM_METRIC_VALUE(
+                  kCounterTaskUpdateOffloadedLatencyMs,
+                  velox::getCurrentTimeMs() - receivedMs);
               return taskInfo;
             })
             .via(
                 folly::getKeepAliveToken(
                     folly::EventBaseManager::get()->getEventBase()))
-            .thenValue([downstream, handlerState, sendThrift](auto taskInfo) {
-              if (!handlerState->requestExpired()) {
-                if (sendThrift) {
-                  thrift::TaskInfo thriftTaskInfo;
-                  toThrift(*taskInfo, thriftTaskInfo);
-                  http::sendOkThriftResponse(
-                      downstream, thriftWrite(thriftTaskInfo));
-                } else {
-                  http::sendOkResponse(downstream, json(*taskInfo));
-                }
-              }
-            })
-            .thenError(
-                folly::tag_t<std::exception>{},
-                [downstream, handlerState](auto&& e) {
-                  if (!handlerState->requestExpired()) {
-                    http::sendErrorResponse(downstream, e.what());
-                  }
-                });
-      });
+            .thenValue(std::move(sendResponse))
+            .thenError(folly::tag_t<std::exception>{}, std::move(sendError));
+      },
+      std::move(onBodyChunk));
 }
 
 proxygen::RequestHandler* TaskResource::createOrUpdateBatchTask(
@@ -310,17 +886,49 @@ proxygen::RequestHandler* TaskResource::createOrUpdateBatchTask(
       pathMatch,
       [&](const protocol::TaskId& taskId,
           const std::string& requestBody,
+          json* preparsedBody,
           const bool summarize,
           long startProcessCpuTime,
           bool /*receiveThrift*/) {
-        protocol::BatchTaskUpdateRequest batchUpdateRequest =
-            json::parse(requestBody);
+        protocol::ScopedProtocolArena arenaScope(
+            SystemConfig::instance()->taskProtocolArenaEnabled());
+        json updateRequestJson = preparsedBody != nullptr
+            ? std::move(*preparsedBody)
+            : parseTaskUpdateJson(requestBody);
+        bool parallelDecode =
+            SystemConfig::instance()->batchTaskUpdateParallelDecodeEnabled();
+        std::vector<json> extractedSplits;
+        if (parallelDecode) {
+          // Pull the split arrays out of the embedded task update request so
+          // the protocol decode below does not deserialize them serially;
+          // they are decoded in shards across the executor instead. Spark
+          // batch updates carry thousands of splits, and their decode
+          // dominates batch task activation.
+          auto embedded = updateRequestJson.find("taskUpdateRequest");
+          if (embedded != updateRequestJson.end()) {
+            extractedSplits = extractSourceSplits(*embedded);
+          } else {
+            parallelDecode = false;
+          }
+        }
+        protocol::BatchTaskUpdateRequest batchUpdateRequest = updateRequestJson;
         auto updateRequest = batchUpdateRequest.taskUpdateRequest;
         VELOX_USER_CHECK_NOT_NULL(updateRequest.fragment);
 
-        auto fragment =
-            velox::encoding::Base64::decode(*updateRequest.fragment);
-        protocol::PlanFragment prestoPlan = json::parse(fragment);
+        protocol::PlanFragment prestoPlan;
+        if (parallelDecode) {
+          decodeSourceSplits(
+              extractedSplits,
+              updateRequest.sources,
+              httpSrvCpuExecutor_,
+              [&]() {
+                prestoPlan = parseTaskUpdateJson(
+                    protocol::decodeBase64(*updateRequest.fragment));
+              });
+        } else {
+          auto fragment = protocol::decodeBase64(*updateRequest.fragment);
+          prestoPlan = parseTaskUpdateJson(fragment);
+        }
 
         auto serializedShuffleWriteInfo = batchUpdateRequest.shuffleWriteInfo;
         auto broadcastBasePath = batchUpdateRequest.broadcastBasePath;
@@ -342,8 +950,15 @@ proxygen::RequestHandler* TaskResource::createOrUpdateBatchTask(
             std::move(broadcastBasePath),
             queryCtx.get(),
             pool_);
-        auto planFragment = converter.toVeloxQueryPlan(
-            prestoPlan, updateRequest.tableWriteInfo, taskId);
+        velox::core::PlanFragment planFragment;
+        uint64_t conversionTimeUs{0};
+        {
+          velox::MicrosecondTimer timer(&conversionTimeUs);
+          planFragment = converter.toVeloxQueryPlan(
+              prestoPlan, updateRequest.tableWriteInfo, taskId);
+        }
+        RECORD_HISTOGRAM_METRIC_VALUE(
+            kCounterTaskPlanConversionTimeMs, conversionTimeUs / 1'000);
         if (SystemConfig::instance()->planConsistencyCheckEnabled()) {
           velox::core::PlanConsistencyChecker::check(planFragment.planNode);
         }
@@ -361,54 +976,416 @@ proxygen::RequestHandler* TaskResource::createOrUpdateBatchTask(
 proxygen::RequestHandler* TaskResource::createOrUpdateTask(
     proxygen::HTTPMessage* message,
     const std::vector<std::string>& pathMatch) {
+  const auto fragmentDigest =
+      message->getHeaders().getSingleOrEmpty(kFragmentDigestHeader);
+  const auto planSignature =
+      message->getHeaders().getSingleOrEmpty(kPlanSignatureHeader);
   return createOrUpdateTaskImpl(
       message,
       pathMatch,
-      [&](const protocol::TaskId& taskId,
+      [this, fragmentDigest, planSignature](const protocol::TaskId& taskId,
           const std::string& requestBody,
+          json* preparsedBody,
           const bool summarize,
           long startProcessCpuTime,
           bool receiveThrift) {
+        // Allocate the decoded protocol object graph from a per-request
+        // arena released wholesale once the update is applied.
+        protocol::ScopedProtocolArena arenaScope(
+            SystemConfig::instance()->taskProtocolArenaEnabled());
         protocol::TaskUpdateRequest updateRequest;
+        std::vector<json> streamedSplits;
+        std::vector<protocol::TaskSource> deferredSources;
+        const bool streamSplits = !receiveThrift &&
+            SystemConfig::instance()->streamingSplitIngestionEnabled();
         if (receiveThrift) {
           auto thriftTaskUpdateRequest =
               std::make_shared<thrift::TaskUpdateRequest>();
           thriftRead(requestBody, thriftTaskUpdateRequest);
           fromThrift(*thriftTaskUpdateRequest, updateRequest);
         } else {
-          updateRequest = json::parse(requestBody);
+          json updateRequestJson = preparsedBody != nullptr
+              ? std::move(*preparsedBody)
+              : parseTaskUpdateJson(requestBody);
+          if (streamSplits) {
+            streamedSplits = extractSourceSplits(updateRequestJson);
+            updateRequest = updateRequestJson;
+            // Defer the no-more-splits signals until the last batch of
+            // streamed splits has been queued, otherwise the task would treat
+            // its sources as exhausted while batches are still decoding.
+            for (auto& source : updateRequest.sources) {
+              protocol::TaskSource deferred;
+              deferred.planNodeId = source.planNodeId;
+              deferred.noMoreSplits = source.noMoreSplits;
+              deferred.noMoreSplitsForLifespan =
+                  std::move(source.noMoreSplitsForLifespan);
+              deferredSources.push_back(std::move(deferred));
+              source.noMoreSplits = false;
+              source.noMoreSplitsForLifespan.clear();
+            }
+          } else {
+            updateRequest = updateRequestJson;
+          }
         }
         velox::core::PlanFragment planFragment;
         std::shared_ptr<velox::core::QueryCtx> queryCtx;
-        if (updateRequest.fragment) {
-          protocol::PlanFragment prestoPlan = json::parse(
-              receiveThrift
-                  ? *updateRequest.fragment
-                  : velox::encoding::Base64::decode(*updateRequest.fragment));
+        const bool interningEnabled =
+            SystemConfig::instance()->taskFragmentInterningEnabled();
+        if (updateRequest.fragment ||
+            (interningEnabled && !fragmentDigest.empty())) {
+          auto& internedFragments =
+              taskManager_.getQueryContextManager()->internedFragmentCache();
+          std::shared_ptr<json> parsedFragment;
+          std::string digest;
+          if (interningEnabled) {
+            // Reuse the fragment parsed by an earlier task of the same
+            // stage. An update that sent only the digest recovers the wire
+            // fragment from the cache too, so the rest of the flow is
+            // identical to a full update.
+            digest = !fragmentDigest.empty()
+                ? fragmentDigest
+                : InternedFragmentCache::digestFor(*updateRequest.fragment);
+            if (auto interned = internedFragments.get(
+                    digest,
+                    SystemConfig::instance()->taskFragmentInterningTtlMs())) {
+              updateRequest.fragment = interned->fragment;
+              parsedFragment = interned->parsed;
+              RECORD_METRIC_VALUE(kCounterTaskFragmentInterningHits);
+            }
+          }
+          VELOX_USER_CHECK_NOT_NULL(
+              updateRequest.fragment,
+              "Unknown plan fragment digest '{}'; resend the serialized "
+              "fragment",
+              fragmentDigest);
+          if (parsedFragment == nullptr) {
+            parsedFragment = std::make_shared<json>(parseTaskUpdateJson(
+                receiveThrift
+                    ? *updateRequest.fragment
+                    : protocol::decodeBase64(*updateRequest.fragment)));
+            if (interningEnabled) {
+              // Intern a copy of the wire fragment: the decoded one may be
+              // arena-backed and would pin the request's whole arena for the
+              // cache TTL.
+              internedFragments.put(
+                  digest,
+                  std::make_shared<std::string>(*updateRequest.fragment),
+                  parsedFragment);
+              RECORD_METRIC_VALUE(kCounterTaskFragmentInterningMisses);
+            }
+          }
+          protocol::PlanFragment prestoPlan = *parsedFragment;
 
           queryCtx =
               taskManager_.getQueryContextManager()->findOrCreateQueryCtx(
                   taskId, updateRequest);
 
-          VeloxInteractiveQueryPlanConverter converter(queryCtx.get(), pool_);
-          planFragment = converter.toVeloxQueryPlan(
-              prestoPlan, updateRequest.tableWriteInfo, taskId);
-          if (SystemConfig::instance()->planConsistencyCheckEnabled()) {
-            velox::core::PlanConsistencyChecker::check(planFragment.planNode);
+          if (SystemConfig::instance()->taskMemoryForecastEnabled()) {
+            taskManager_.forecastTaskMemory(taskId, *updateRequest.fragment);
+          }
+
+          auto& planCache =
+              taskManager_.getQueryContextManager()->planFragmentCache();
+          const bool planCacheEnabled =
+              SystemConfig::instance()->planConversionCacheEnabled();
+          std::string planCacheKey;
+          bool planCacheHit = false;
+          if (planCacheEnabled) {
+            planCacheKey = PlanFragmentCache::makeKey(
+                taskId.substr(0, taskId.find('.')),
+                *updateRequest.fragment,
+                updateRequest.tableWriteInfo);
+            if (auto cached = planCache.get(planCacheKey)) {
+              // Another task of the same stage already converted and
+              // validated this fragment.
+              planFragment = std::move(*cached);
+              planCacheHit = true;
+              RECORD_METRIC_VALUE(kCounterTaskPlanConversionCacheHits);
+            }
+          }
+          if (!planCacheHit) {
+            uint64_t conversionTimeUs{0};
+            {
+              velox::MicrosecondTimer timer(&conversionTimeUs);
+              VeloxInteractiveQueryPlanConverter converter(
+                  queryCtx.get(), pool_);
+              planFragment = converter.toVeloxQueryPlan(
+                  prestoPlan, updateRequest.tableWriteInfo, taskId);
+            }
+            RECORD_HISTOGRAM_METRIC_VALUE(
+                kCounterTaskPlanConversionTimeMs, conversionTimeUs / 1'000);
+            RECORD_METRIC_VALUE(kCounterTaskPlanConversionCacheMisses);
+            bool planTrusted = false;
+            if (!planSignature.empty() &&
+                SystemConfig::instance()->taskTrustedPlanEnabled()) {
+              const auto signedDigest = !digest.empty()
+                  ? digest
+                  : InternedFragmentCache::digestFor(*updateRequest.fragment);
+              VELOX_USER_CHECK(
+                  verifyTrustedPlanSignature(signedDigest, planSignature),
+                  "Plan signature verification failed for fragment digest "
+                  "'{}'",
+                  signedDigest);
+              planTrusted = true;
+            }
+            if (planTrusted) {
+              // The coordinator validated the plan and vouched for it; skip
+              // the per-task structural re-checks.
+              RECORD_METRIC_VALUE(kCounterTaskTrustedPlanValidationSkipped);
+            } else {
+              if (SystemConfig::instance()->planConsistencyCheckEnabled()) {
+                velox::core::PlanConsistencyChecker::check(
+                    planFragment.planNode);
+              }
+              planValidator_->validatePlanFragment(planFragment);
+            }
+            if (planCacheEnabled &&
+                !hasTaskIdDependentNode(planFragment.planNode)) {
+              planCache.put(planCacheKey, planFragment);
+            }
           }
-          planValidator_->validatePlanFragment(planFragment);
         }
 
-        return taskManager_.createOrUpdateTask(
+        auto taskInfo = taskManager_.createOrUpdateTask(
             taskId,
             updateRequest,
             planFragment,
             summarize,
             std::move(queryCtx),
             startProcessCpuTime);
+        if (streamSplits) {
+          taskInfo = streamSplitsIntoTask(
+              taskId,
+              updateRequest,
+              std::move(streamedSplits),
+              std::move(deferredSources),
+              summarize,
+              startProcessCpuTime);
+        }
+        return taskInfo;
       });
 }
 
+std::unique_ptr<protocol::TaskInfo> TaskResource::streamSplitsIntoTask(
+    const protocol::TaskId& taskId,
+    const protocol::TaskUpdateRequest& updateRequest,
+    std::vector<json> sourceSplits,
+    std::vector<protocol::TaskSource> deferredSources,
+    bool summarize,
+    long startProcessCpuTime) {
+  const auto batchSize = std::max<int32_t>(
+      1, SystemConfig::instance()->streamingSplitIngestionBatchSize());
+
+  std::unique_ptr<protocol::TaskInfo> taskInfo;
+  auto applyUpdate = [&](std::vector<protocol::TaskSource> sources) {
+    protocol::TaskUpdateRequest batchUpdate;
+    // Resending the output buffer state is idempotent and keeps the batch
+    // updates identical to the incremental updates the coordinator sends.
+    batchUpdate.outputIds = updateRequest.outputIds;
+    batchUpdate.sources = std::move(sources);
+    taskInfo = taskManager_.createOrUpdateTask(
+        taskId, batchUpdate, {}, summarize, nullptr, startProcessCpuTime);
+  };
+
+  for (size_t i = 0; i < sourceSplits.size(); ++i) {
+    auto& splitsJson = sourceSplits[i];
+    const auto& planNodeId = updateRequest.sources[i].planNodeId;
+    for (size_t offset = 0; offset < splitsJson.size(); offset += batchSize) {
+      protocol::TaskSource batch;
+      batch.planNodeId = planNodeId;
+      const auto limit =
+          std::min<size_t>(offset + batchSize, splitsJson.size());
+      batch.splits.reserve(limit - offset);
+      for (auto splitIndex = offset; splitIndex < limit; ++splitIndex) {
+        batch.splits.emplace_back(
+            splitsJson[splitIndex].get<protocol::ScheduledSplit>());
+        // Release the raw JSON as we go to keep peak memory bounded by the
+        // batch size.
+        splitsJson[splitIndex] = json();
+      }
+      applyUpdate({std::move(batch)});
+    }
+    splitsJson = json();
+  }
+
+  // Deliver the deferred no-more-splits signals after all batches.
+  std::vector<protocol::TaskSource> finalSources;
+  for (auto& deferred : deferredSources) {
+    if (deferred.noMoreSplits || !deferred.noMoreSplitsForLifespan.empty()) {
+      finalSources.push_back(std::move(deferred));
+    }
+  }
+  if (taskInfo == nullptr || !finalSources.empty()) {
+    applyUpdate(std::move(finalSources));
+  }
+  return taskInfo;
+}
+
+proxygen::RequestHandler* TaskResource::streamTaskSplits(
+    proxygen::HTTPMessage* /*message*/,
+    const std::vector<std::string>& pathMatch) {
+  protocol::TaskId taskId = pathMatch[1];
+  auto state = std::make_shared<SplitStreamState>();
+
+  // Decodes one frame and queues its splits into the task as a sources-only
+  // update, the same shape streamSplitsIntoTask() uses. Runs on the CPU
+  // executor, one frame at a time.
+  auto applyFrame = [this, taskId](const std::string& frame) {
+    protocol::ScopedProtocolArena arenaScope(
+        SystemConfig::instance()->taskProtocolArenaEnabled());
+    protocol::TaskSource source = parseTaskUpdateJson(frame);
+    protocol::TaskUpdateRequest update;
+    update.sources.push_back(std::move(source));
+    taskManager_.createOrUpdateTask(
+        taskId,
+        update,
+        {},
+        /*summarize=*/false,
+        nullptr,
+        util::getProcessCpuTimeNs());
+  };
+
+  auto onBodyChunk = [this, state, applyFrame = std::move(applyFrame)](
+                         std::unique_ptr<folly::IOBuf> chunk) {
+    auto queueFrame = [&](std::string frame) {
+      state->applied =
+          std::move(state->applied)
+              .via(httpSrvCpuExecutor_)
+              .thenValue([applyFrame, frame = std::move(frame)](
+                             folly::Unit) { applyFrame(frame); });
+    };
+    if (chunk == nullptr) {
+      // End of the stream. An unterminated trailing frame is still applied.
+      if (!state->pending.empty()) {
+        queueFrame(std::move(state->pending));
+      }
+      return;
+    }
+    folly::io::Cursor cursor(chunk.get());
+    const size_t chainLength = chunk->computeChainDataLength();
+    const size_t offset = state->pending.size();
+    state->pending.resize(offset + chainLength);
+    cursor.pull(state->pending.data() + offset, chainLength);
+    size_t start = 0;
+    size_t newline;
+    while ((newline = state->pending.find('\n', start)) != std::string::npos) {
+      if (newline > start) {
+        queueFrame(state->pending.substr(start, newline - start));
+      }
+      start = newline + 1;
+    }
+    state->pending.erase(0, start);
+  };
+
+  return new http::CallbackRequestHandler(
+      [state](
+          proxygen::HTTPMessage* /*message*/,
+          const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
+          proxygen::ResponseHandler* downstream,
+          std::shared_ptr<http::CallbackRequestHandlerState> handlerState) {
+        // All frames have been queued by now: the end-of-chunks marker is
+        // delivered before this callback. Respond once the last one applied.
+        std::move(state->applied)
+            .via(
+                folly::getKeepAliveToken(
+                    folly::EventBaseManager::get()->getEventBase()))
+            .thenValue([downstream, handlerState](folly::Unit) {
+              if (!handlerState->requestExpired()) {
+                http::sendOkResponse(downstream);
+              }
+            })
+            .thenError(
+                folly::tag_t<std::exception>{},
+                [downstream, handlerState](auto&& e) {
+                  if (!handlerState->requestExpired()) {
+                    http::sendErrorResponse(downstream, e.what());
+                  }
+                });
+      },
+      std::move(onBodyChunk));
+}
+
+bool TaskResource::verifyTrustedPlanSignature(
+    const std::string& digest,
+    const std::string& signature) {
+  {
+    auto verified = verifiedPlanSignatures_.rlock();
+    auto it = verified->find(digest);
+    if (it != verified->end() && it->second == signature) {
+      return true;
+    }
+  }
+  const auto secret =
+      SystemConfig::instance()->internalCommunicationSharedSecret();
+  VELOX_USER_CHECK(
+      !secret.empty(),
+      "'{}' requires '{}' to be set",
+      SystemConfig::kTaskTrustedPlanEnabled,
+      SystemConfig::kInternalCommunicationSharedSecret);
+  unsigned char mac[EVP_MAX_MD_SIZE];
+  unsigned int macLen{0};
+  HMAC(
+      EVP_sha256(),
+      secret.data(),
+      secret.size(),
+      reinterpret_cast<const unsigned char*>(digest.data()),
+      digest.size(),
+      mac,
+      &macLen);
+  const auto expected = folly::hexlify(folly::ByteRange(mac, macLen));
+  if (signature.size() != expected.size() ||
+      CRYPTO_memcmp(signature.data(), expected.data(), expected.size()) != 0) {
+    return false;
+  }
+  auto verified = verifiedPlanSignatures_.wlock();
+  if (verified->size() >= kMaxVerifiedPlanSignatures) {
+    verified->clear();
+  }
+  (*verified)[digest] = signature;
+  return true;
+}
+
+std::optional<TaskResource::AppliedUpdateResponse>
+TaskResource::findAppliedUpdateResponse(
+    const protocol::TaskId& taskId,
+    uint64_t digest,
+    uint64_t ttlMs) {
+  const auto nowMs = velox::getCurrentTimeMs();
+  auto responses = appliedUpdateResponses_.rlock();
+  auto taskIt = responses->find(taskId);
+  if (taskIt == responses->end()) {
+    return std::nullopt;
+  }
+  auto it = taskIt->second.find(digest);
+  if (it == taskIt->second.end() || nowMs - it->second.appliedMs >= ttlMs) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void TaskResource::rememberAppliedUpdateResponse(
+    const protocol::TaskId& taskId,
+    uint64_t digest,
+    const std::string& responseBody,
+    bool thrift) {
+  const auto nowMs = velox::getCurrentTimeMs();
+  auto responses = appliedUpdateResponses_.wlock();
+  auto& taskResponses = (*responses)[taskId];
+  if (taskResponses.size() >= kMaxAppliedUpdateResponsesPerTask &&
+      !taskResponses.contains(digest)) {
+    // Drop the oldest remembered response; retries only chase the last few
+    // updates.
+    auto oldest = taskResponses.begin();
+    for (auto it = std::next(oldest); it != taskResponses.end(); ++it) {
+      if (it->second.appliedMs < oldest->second.appliedMs) {
+        oldest = it;
+      }
+    }
+    taskResponses.erase(oldest);
+  }
+  taskResponses[digest] = AppliedUpdateResponse{responseBody, thrift, nowMs};
+}
+
 proxygen::RequestHandler* TaskResource::deleteTask(
     proxygen::HTTPMessage* message,
     const std::vector<std::string>& pathMatch) {
@@ -436,6 +1413,10 @@ proxygen::RequestHandler* TaskResource::deleteTask(
             [this, taskId, abort, downstream, summarize]() {
               std::unique_ptr<protocol::TaskInfo> taskInfo;
               taskInfo = taskManager_.deleteTask(taskId, abort, summarize);
+              emptyResultResponses_.wlock()->erase(taskId);
+              pageCompressors_.wlock()->erase(taskId);
+              lastSentTaskStatus_.wlock()->erase(taskId);
+              appliedUpdateResponses_.wlock()->erase(taskId);
               return std::move(taskInfo);
             })
             .via(
@@ -468,6 +1449,59 @@ proxygen::RequestHandler* TaskResource::deleteTask(
       });
 }
 
+std::shared_ptr<const proxygen::HTTPMessage>
+TaskResource::emptyResultResponseTemplate(
+    const protocol::TaskId& taskId,
+    long bufferId) {
+  {
+    auto responses = emptyResultResponses_.rlock();
+    auto taskIt = responses->find(taskId);
+    if (taskIt != responses->end()) {
+      auto bufferIt = taskIt->second.find(bufferId);
+      if (bufferIt != taskIt->second.end()) {
+        return bufferIt->second;
+      }
+    }
+  }
+
+  auto response = std::make_shared<proxygen::HTTPMessage>();
+  response->setHTTPVersion(1, 1);
+  response->setStatusCode(http::kHttpNoContent);
+  response->setStatusMessage("");
+  auto& responseHeaders = response->getHeaders();
+  responseHeaders.add(
+      proxygen::HTTP_HEADER_CONTENT_TYPE, protocol::PRESTO_PAGES_MIME_TYPE);
+  responseHeaders.add(protocol::PRESTO_TASK_INSTANCE_ID_HEADER, taskId);
+  responseHeaders.add(protocol::PRESTO_BUFFER_COMPLETE_HEADER, "false");
+
+  auto responses = emptyResultResponses_.wlock();
+  return (*responses)[taskId].emplace(bufferId, std::move(response))
+      .first->second;
+}
+
+std::shared_ptr<ExchangePageCompressor> TaskResource::pageCompressor(
+    const protocol::TaskId& taskId,
+    long bufferId) {
+  {
+    auto compressors = pageCompressors_.rlock();
+    auto taskIt = compressors->find(taskId);
+    if (taskIt != compressors->end()) {
+      auto bufferIt = taskIt->second.find(bufferId);
+      if (bufferIt != taskIt->second.end()) {
+        return bufferIt->second;
+      }
+    }
+  }
+
+  auto compressors = pageCompressors_.wlock();
+  auto& compressor = (*compressors)[taskId][bufferId];
+  if (compressor == nullptr) {
+    compressor = std::make_shared<ExchangePageCompressor>(
+        SystemConfig::instance()->exchangeZstdDictionaryTrainingPages());
+  }
+  return compressor;
+}
+
 proxygen::RequestHandler* TaskResource::getResults(
     proxygen::HTTPMessage* message,
     const std::vector<std::string>& pathMatch,
@@ -489,12 +1523,73 @@ proxygen::RequestHandler* TaskResource::getResults(
             : protocol::PRESTO_MAX_SIZE_DEFAULT);
   }
 
+  // With dictionary compression on, the consumer advertises the dictionary
+  // id it already holds so the blob is only shipped when the consumer lacks
+  // it (first compressed response, or a consumer restart).
+  const bool zstdDictionaryEnabled = !getDataSize &&
+      SystemConfig::instance()->exchangeZstdDictionaryCompressionEnabled();
+  int64_t consumerDictionaryId{-1};
+  if (zstdDictionaryEnabled) {
+    const auto& dictionaryIdStr =
+        headers.getSingleOrEmpty(http::kPrestoPageZstdDictionaryId);
+    if (!dictionaryIdStr.empty()) {
+      consumerDictionaryId =
+          folly::tryTo<int64_t>(dictionaryIdStr).value_or(-1);
+    }
+  }
+
+  // With selective column serving on, the consumer names the exchange
+  // output columns it actually uses; the rest are nulled out before the
+  // pages travel the wire.
+  std::string exchangeColumns;
+  if (!getDataSize &&
+      SystemConfig::instance()->exchangeSelectiveColumnsEnabled()) {
+    exchangeColumns = headers.getSingleOrEmpty(http::kPrestoExchangeColumns);
+  }
+
+  // A consumer resuming a broken transfer asks for the token's payload from
+  // this byte offset; see 'exchange.partial-page-resume-enabled'. The offset
+  // is only honored below when it falls inside the payload.
+  int64_t resumeOffset{0};
+  if (!getDataSize) {
+    const auto& resumeOffsetStr =
+        headers.getSingleOrEmpty(http::kPrestoPageResumeOffset);
+    if (!resumeOffsetStr.empty()) {
+      resumeOffset = folly::tryTo<int64_t>(resumeOffsetStr).value_or(0);
+    }
+  }
+
+  // When sampled, stamp the request from arrival to reply; the consuming
+  // worker samples the same path, so the two records join by path.
+  std::string tracePath;
+  if (const auto sampleEveryN =
+          SystemConfig::instance()->exchangeTraceSampleEveryN();
+      sampleEveryN > 0) {
+    auto path =
+        fmt::format("/v1/task/{}/results/{}/{}", taskId, bufferId, token);
+    if (ExchangeTracer::instance()->shouldSample(path, sampleEveryN)) {
+      tracePath = std::move(path);
+    }
+  }
+
   return new http::CallbackRequestHandler(
-      [this, taskId, bufferId, token, maxSize, maxWait](
+      [this,
+       taskId,
+       bufferId,
+       token,
+       maxSize,
+       maxWait,
+       tracePath,
+       zstdDictionaryEnabled,
+       consumerDictionaryId,
+       resumeOffset,
+       exchangeColumns](
           proxygen::HTTPMessage* /*message*/,
           const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
           proxygen::ResponseHandler* downstream,
           std::shared_ptr<http::CallbackRequestHandlerState> handlerState) {
+        const int64_t requestReceivedMs =
+            tracePath.empty() ? 0 : velox::getCurrentTimeMs();
         folly::via(
             httpSrvCpuExecutor_,
             [this,
@@ -506,20 +1601,108 @@ proxygen::RequestHandler* TaskResource::getResults(
              maxSize,
              maxWait,
              downstream,
+             tracePath,
+             requestReceivedMs,
+             zstdDictionaryEnabled,
+             consumerDictionaryId,
+             resumeOffset,
+             exchangeColumns,
              handlerState]() {
               taskManager_
                   .getResults(
-                      taskId, bufferId, token, maxSize, maxWait, handlerState)
+                      taskId,
+                      bufferId,
+                      token,
+                      maxSize,
+                      maxWait,
+                      handlerState,
+                      exchangeColumns)
                   .via(evb)
-                  .thenValue([downstream, taskId, handlerState](
-                                 std::unique_ptr<Result> result) {
+                  .thenValue([this,
+                              downstream,
+                              taskId,
+                              bufferId,
+                              tracePath,
+                              requestReceivedMs,
+                              zstdDictionaryEnabled,
+                              consumerDictionaryId,
+                              resumeOffset,
+                              handlerState](std::unique_ptr<Result> result) {
                     if (handlerState->requestExpired()) {
                       return;
                     }
+                    if (!tracePath.empty()) {
+                      ExchangeTracer::instance()->record(
+                          {tracePath,
+                           /*producer=*/true,
+                           requestReceivedMs,
+                           velox::getCurrentTimeMs(),
+                           result->data
+                               ? static_cast<int64_t>(result->data->length())
+                               : -1,
+                           result->waitTimeMs});
+                    }
+                    // Fast path for the no-data poll. Serve it from a cached
+                    // per-buffer header template, patching only the page
+                    // tokens, instead of rebuilding every header on each
+                    // poll. Empty results carry the same sequence and next
+                    // sequence, so one conversion covers both token headers.
+                    if (result->data && result->data->length() == 0 &&
+                        !result->complete && result->remainingBytes.empty() &&
+                        result->sequence == result->nextSequence) {
+                      auto response =
+                          *emptyResultResponseTemplate(taskId, bufferId);
+                      auto& responseHeaders = response.getHeaders();
+                      const auto token = std::to_string(result->sequence);
+                      responseHeaders.set(
+                          protocol::PRESTO_PAGE_TOKEN_HEADER, token);
+                      responseHeaders.set(
+                          protocol::PRESTO_PAGE_NEXT_TOKEN_HEADER, token);
+                      if (result->waitTimeMs > 0) {
+                        responseHeaders.set(
+                            protocol::PRESTO_BUFFER_WAIT_TIME_MS_HEADER,
+                            std::to_string(result->waitTimeMs));
+                      }
+                      downstream->sendHeaders(response);
+                      downstream->sendEOM();
+                      return;
+                    }
                     auto status = result->data && result->data->length() == 0
                         ? http::kHttpNoContent
                         : http::kHttpOk;
 
+                    // A resumed fetch gets the tail of the token's payload
+                    // plus a checksum over the whole payload so the consumer
+                    // can validate the splice. The body goes out uncompressed
+                    // since the prefix the consumer holds is uncompressed
+                    // wire bytes. An offset outside the payload is ignored,
+                    // turning the response into a plain full fetch.
+                    bool resumed = false;
+                    uint32_t resumeChecksum = 0;
+                    if (resumeOffset > 0 && result->data != nullptr &&
+                        static_cast<uint64_t>(resumeOffset) <
+                            result->data->computeChainDataLength()) {
+                      resumeChecksum = pageChecksum(*result->data);
+                      folly::IOBufQueue bodyQueue;
+                      bodyQueue.append(std::move(result->data));
+                      bodyQueue.trimStart(resumeOffset);
+                      result->data = bodyQueue.move();
+                      resumed = true;
+                    }
+
+                    // Compress the body against the destination's trained
+                    // dictionary. Bodies seen before the dictionary is ready
+                    // double as training samples and go out uncompressed.
+                    bool zstdCompressed = false;
+                    std::shared_ptr<ExchangePageCompressor> compressor;
+                    if (!resumed && zstdDictionaryEnabled &&
+                        result->data != nullptr &&
+                        result->data->length() > 0) {
+                      compressor = pageCompressor(taskId, bufferId);
+                      result->data = compressor->compress(
+                          std::move(result->data), zstdCompressed);
+                    }
+
                     proxygen::ResponseBuilder builder(downstream);
                     builder.status(status, "")
                         .header(
@@ -536,6 +1719,28 @@ proxygen::RequestHandler* TaskResource::getResults(
                         .header(
                             protocol::PRESTO_BUFFER_COMPLETE_HEADER,
                             result->complete ? "true" : "false");
+                    if (zstdCompressed) {
+                      const auto dictionaryId = compressor->dictionaryId();
+                      builder.header(
+                          http::kPrestoPageZstdDictionaryId,
+                          std::to_string(dictionaryId));
+                      if (consumerDictionaryId != dictionaryId) {
+                        const auto dictionary = compressor->dictionary();
+                        builder.header(
+                            http::kPrestoPageZstdDictionary,
+                            velox::encoding::Base64::encode(
+                                dictionary.data(), dictionary.size()));
+                      }
+                    }
+                    if (resumed) {
+                      builder
+                          .header(
+                              http::kPrestoPageResumeOffset,
+                              std::to_string(resumeOffset))
+                          .header(
+                              http::kPrestoPageChecksum,
+                              std::to_string(resumeChecksum));
+                    }
                     if (!result->remainingBytes.empty()) {
                       builder.header(
                           protocol::PRESTO_BUFFER_REMAINING_BYTES_HEADER,
@@ -572,8 +1777,19 @@ proxygen::RequestHandler* TaskResource::getTaskStatus(
   const auto sendThrift =
       acceptHeader.find(http::kMimeTypeApplicationThrift) != std::string::npos;
 
+  // A poller that reports the status version it already holds opts into
+  // changed-fields-only delta responses.
+  int64_t baseVersion{-1};
+  if (sendThrift && SystemConfig::instance()->taskStatusDeltaSerdeEnabled()) {
+    const auto& baseVersionHeader =
+        headers.getSingleOrEmpty(http::kPrestoTaskStatusBaseVersion);
+    if (!baseVersionHeader.empty()) {
+      baseVersion = folly::tryTo<int64_t>(baseVersionHeader).value_or(-1);
+    }
+  }
+
   return new http::CallbackRequestHandler(
-      [this, sendThrift, taskId, currentState, maxWait](
+      [this, sendThrift, baseVersion, taskId, currentState, maxWait](
           proxygen::HTTPMessage* /*message*/,
           const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
           proxygen::ResponseHandler* downstream,
@@ -584,23 +1800,62 @@ proxygen::RequestHandler* TaskResource::getTaskStatus(
              evb = folly::getKeepAliveToken(
                  folly::EventBaseManager::get()->getEventBase()),
              sendThrift,
+             baseVersion,
              taskId,
              currentState,
              maxWait,
              handlerState,
              downstream]() {
+              if (sendThrift) {
+                // Thrift-only fast path: the Thrift status is populated
+                // directly from the task state without copying the protocol
+                // status struct.
+                taskManager_
+                    .getTaskStatusThrift(
+                        taskId, currentState, maxWait, handlerState)
+                    .via(evb)
+                    .thenValue(
+                        [this, downstream, handlerState, taskId, baseVersion](
+                            std::unique_ptr<thrift::TaskStatus> taskStatus) {
+                          if (!handlerState->requestExpired()) {
+                            if (baseVersion >= 0) {
+                              auto deltaFrame = maybeMakeTaskStatusDelta(
+                                  taskId, baseVersion, *taskStatus);
+                              if (!deltaFrame.empty()) {
+                                http::sendOkThriftResponse(
+                                    downstream,
+                                    deltaFrame,
+                                    http::kPrestoTaskStatusDelta,
+                                    std::to_string(baseVersion));
+                                return;
+                              }
+                            }
+                            http::sendOkThriftResponse(
+                                downstream, thriftWrite(*taskStatus));
+                          }
+                        })
+                    .thenError(
+                        folly::tag_t<std::exception>{},
+                        [downstream, handlerState](const std::exception& e) {
+                          if (!handlerState->requestExpired()) {
+                            http::sendErrorResponse(downstream, e.what());
+                          }
+                        });
+                return;
+              }
               taskManager_
                   .getTaskStatus(taskId, currentState, maxWait, handlerState)
                   .via(evb)
                   .thenValue(
-                      [sendThrift, downstream, taskId, handlerState](
+                      [downstream, taskId, handlerState](
                           std::unique_ptr<protocol::TaskStatus> taskStatus) {
                         if (!handlerState->requestExpired()) {
-                          if (sendThrift) {
-                            thrift::TaskStatus thriftTaskStatus;
-                            toThrift(*taskStatus, thriftTaskStatus);
-                            http::sendOkThriftResponse(
-                                downstream, thriftWrite(thriftTaskStatus));
+                          if (SystemConfig::instance()
+                                  ->taskStatusDirectSerdeEnabled()) {
+                            http::sendOkResponse(
+                                downstream,
+                                protocol::serializeTaskStatusJson(
+                                    *taskStatus));
                           } else {
                             json taskStatusJson = *taskStatus;
                             http::sendOkResponse(downstream, taskStatusJson);
@@ -622,6 +1877,26 @@ proxygen::RequestHandler* TaskResource::getTaskStatus(
       });
 }
 
+std::string TaskResource::maybeMakeTaskStatusDelta(
+    const protocol::TaskId& taskId,
+    int64_t baseVersion,
+    const thrift::TaskStatus& current) {
+  std::string frame;
+  auto cache = lastSentTaskStatus_.wlock();
+  auto& entry = (*cache)[taskId];
+  thrift::TaskStatusDelta delta;
+  if (entry.status != nullptr && *entry.status->version_ref() == baseVersion &&
+      entry.deltasSinceFull < kTaskStatusFullSnapshotEvery &&
+      thrift::makeTaskStatusDelta(*entry.status, current, delta)) {
+    frame = thriftWrite(delta);
+    ++entry.deltasSinceFull;
+  } else {
+    entry.deltasSinceFull = 0;
+  }
+  entry.status = std::make_shared<thrift::TaskStatus>(current);
+  return frame;
+}
+
 proxygen::RequestHandler* TaskResource::getTaskInfo(
     proxygen::HTTPMessage* message,
     const std::vector<std::string>& pathMatch) {
@@ -629,6 +1904,11 @@ proxygen::RequestHandler* TaskResource::getTaskInfo(
   auto currentState = getCurrentState(message);
   auto maxWait = getMaxWait(message);
   bool summarize = message->hasQueryParam("summarize");
+  TaskInfoFieldMask fieldMask;
+  if (message->hasQueryParam("fields")) {
+    fieldMask =
+        TaskInfoFieldMask::fromFieldsParam(message->getQueryParam("fields"));
+  }
 
   const auto& headers = message->getHeaders();
   const auto& acceptHeader =
@@ -637,7 +1917,7 @@ proxygen::RequestHandler* TaskResource::getTaskInfo(
       acceptHeader.find(http::kMimeTypeApplicationThrift) != std::string::npos;
 
   return new http::CallbackRequestHandler(
-      [this, taskId, currentState, maxWait, summarize, sendThrift](
+      [this, taskId, currentState, maxWait, summarize, fieldMask, sendThrift](
           proxygen::HTTPMessage* /*message*/,
           const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
           proxygen::ResponseHandler* downstream,
@@ -651,25 +1931,64 @@ proxygen::RequestHandler* TaskResource::getTaskInfo(
              currentState,
              maxWait,
              summarize,
+             fieldMask,
              handlerState,
              downstream,
              sendThrift]() {
               taskManager_
                   .getTaskInfo(
-                      taskId, summarize, currentState, maxWait, handlerState)
+                      taskId,
+                      summarize,
+                      currentState,
+                      maxWait,
+                      handlerState,
+                      fieldMask)
                   .via(evb)
-                  .thenValue([downstream, taskId, handlerState, sendThrift](
+                  .thenValue([this, downstream, taskId, handlerState, sendThrift, evb](
                                  std::unique_ptr<protocol::TaskInfo> taskInfo) {
-                    if (!handlerState->requestExpired()) {
-                      if (sendThrift) {
-                        thrift::TaskInfo thriftTaskInfo;
-                        toThrift(*taskInfo, thriftTaskInfo);
-                        http::sendOkThriftResponse(
-                            downstream, thriftWrite(thriftTaskInfo));
-                      } else {
-                        http::sendOkResponse(downstream, json(*taskInfo));
-                      }
+                    if (handlerState->requestExpired()) {
+                      return;
+                    }
+                    if (sendThrift) {
+                      thrift::TaskInfo thriftTaskInfo;
+                      toThrift(*taskInfo, thriftTaskInfo);
+                      http::sendOkThriftResponse(
+                          downstream, thriftWrite(thriftTaskInfo));
+                      return;
+                    }
+                    if (httpSrvSerializationExecutor_ != nullptr &&
+                        taskInfoNumOperators(*taskInfo) >=
+                            kSerializationOffloadMinOperators) {
+                      // Encode large TaskInfo bodies off the HTTP executor so
+                      // a few tasks with big stats trees cannot starve status
+                      // polls for every other task.
+                      auto sharedTaskInfo =
+                          std::shared_ptr<protocol::TaskInfo>(
+                              std::move(taskInfo));
+                      folly::via(
+                          httpSrvSerializationExecutor_,
+                          [sharedTaskInfo]() {
+                            return taskInfoToJsonString(*sharedTaskInfo);
+                          })
+                          .via(evb)
+                          .thenValue(
+                              [downstream, handlerState](std::string&& body) {
+                                if (!handlerState->requestExpired()) {
+                                  http::sendOkResponse(downstream, body);
+                                }
+                              })
+                          .thenError(
+                              folly::tag_t<std::exception>{},
+                              [downstream, handlerState](
+                                  const std::exception& e) {
+                                if (!handlerState->requestExpired()) {
+                                  http::sendErrorResponse(
+                                      downstream, e.what());
+                                }
+                              });
+                      return;
                     }
+                    http::sendOkResponse(downstream, json(*taskInfo));
                   })
                   .thenError(
                       folly::tag_t<std::exception>{},
@@ -685,6 +2004,147 @@ proxygen::RequestHandler* TaskResource::getTaskInfo(
       });
 }
 
+proxygen::RequestHandler* TaskResource::getTimeSlicedStats(
+    proxygen::HTTPMessage* /*message*/,
+    const std::vector<std::string>& pathMatch) {
+  protocol::TaskId taskId = pathMatch[1];
+
+  return new http::CallbackRequestHandler(
+      [this, taskId](
+          proxygen::HTTPMessage* /*message*/,
+          const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
+          proxygen::ResponseHandler* downstream,
+          std::shared_ptr<http::CallbackRequestHandlerState> handlerState) {
+        folly::via(
+            httpSrvCpuExecutor_,
+            [this, taskId]() {
+              return taskManager_.getTimeSlicedStatsJson(taskId);
+            })
+            .via(
+                folly::getKeepAliveToken(
+                    folly::EventBaseManager::get()->getEventBase()))
+            .thenValue([downstream, handlerState](std::string&& statsJson) {
+              if (!handlerState->requestExpired()) {
+                http::sendOkResponse(downstream, statsJson);
+              }
+            })
+            .thenError(
+                folly::tag_t<std::exception>{},
+                [downstream, handlerState](const std::exception& e) {
+                  if (!handlerState->requestExpired()) {
+                    http::sendErrorResponse(downstream, e.what());
+                  }
+                });
+      });
+}
+
+proxygen::RequestHandler* TaskResource::getTaskStatusBatch(
+    proxygen::HTTPMessage* /*message*/,
+    const std::vector<std::string>& /*pathMatch*/) {
+  return new http::CallbackRequestHandler(
+      [this](
+          proxygen::HTTPMessage* /*message*/,
+          const std::vector<std::unique_ptr<folly::IOBuf>>& body,
+          proxygen::ResponseHandler* downstream,
+          std::shared_ptr<http::CallbackRequestHandlerState> handlerState) {
+        folly::via(
+            httpSrvCpuExecutor_,
+            [this, requestBody = util::extractMessageBody(body)]() {
+              return taskManager_.getTaskStatusBatchJson(requestBody);
+            })
+            .via(
+                folly::getKeepAliveToken(
+                    folly::EventBaseManager::get()->getEventBase()))
+            .thenValue([downstream, handlerState](std::string&& responseJson) {
+              if (!handlerState->requestExpired()) {
+                http::sendOkResponse(downstream, responseJson);
+              }
+            })
+            .thenError(
+                folly::tag_t<std::exception>{},
+                [downstream, handlerState](const std::exception& e) {
+                  if (!handlerState->requestExpired()) {
+                    http::sendErrorResponse(downstream, e.what());
+                  }
+                });
+      });
+}
+
+proxygen::RequestHandler* TaskResource::getTaskDebug(
+    proxygen::HTTPMessage* /*message*/,
+    const std::vector<std::string>& pathMatch) {
+  protocol::TaskId taskId = pathMatch[1];
+
+  return new http::CallbackRequestHandler(
+      [this, taskId](
+          proxygen::HTTPMessage* /*message*/,
+          const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
+          proxygen::ResponseHandler* downstream,
+          std::shared_ptr<http::CallbackRequestHandlerState> handlerState) {
+        folly::via(
+            httpSrvCpuExecutor_,
+            [this, taskId]() { return taskManager_.getTaskDebugJson(taskId); })
+            .via(
+                folly::getKeepAliveToken(
+                    folly::EventBaseManager::get()->getEventBase()))
+            .thenValue([downstream, handlerState](std::string&& debugJson) {
+              if (!handlerState->requestExpired()) {
+                http::sendOkResponse(downstream, debugJson);
+              }
+            })
+            .thenError(
+                folly::tag_t<std::exception>{},
+                [downstream, handlerState](const std::exception& e) {
+                  if (!handlerState->requestExpired()) {
+                    http::sendErrorResponse(downstream, e.what());
+                  }
+                });
+      });
+}
+
+proxygen::RequestHandler* TaskResource::getTaskListing(
+    proxygen::HTTPMessage* /*message*/) {
+  return new http::CallbackRequestHandler(
+      [this](
+          proxygen::HTTPMessage* /*message*/,
+          const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
+          proxygen::ResponseHandler* downstream,
+          std::shared_ptr<http::CallbackRequestHandlerState> handlerState) {
+        if (auto snapshot = taskManager_.taskListSnapshot()) {
+          // Bounded staleness: serve the background snapshot and report its
+          // age so callers know how stale the listing is. This keeps the
+          // request cost independent of the number of tasks.
+          http::sendOkResponse(
+              downstream,
+              snapshot->body,
+              kTaskListAgeMsHeader,
+              std::to_string(velox::getCurrentTimeMs() - snapshot->buildTimeMs));
+          return;
+        }
+        // Snapshot serving is disabled; build the listing fresh off the IO
+        // thread.
+        folly::via(
+            httpSrvCpuExecutor_,
+            [this]() { return taskManager_.buildTaskListSnapshot(); })
+            .via(
+                folly::getKeepAliveToken(
+                    folly::EventBaseManager::get()->getEventBase()))
+            .thenValue([downstream, handlerState](auto&& snapshot) {
+              if (!handlerState->requestExpired()) {
+                http::sendOkResponse(
+                    downstream, snapshot->body, kTaskListAgeMsHeader, "0");
+              }
+            })
+            .thenError(
+                folly::tag_t<std::exception>{},
+                [downstream, handlerState](const std::exception& e) {
+                  if (!handlerState->requestExpired()) {
+                    http::sendErrorResponse(downstream, e.what());
+                  }
+                });
+      });
+}
+
 proxygen::RequestHandler* TaskResource::removeRemoteSource(
     proxygen::HTTPMessage* /*message*/,
     const std::vector<std::string>& pathMatch) {
@@ -719,4 +2179,36 @@ proxygen::RequestHandler* TaskResource::removeRemoteSource(
                 });
       });
 }
+
+proxygen::RequestHandler* TaskResource::notifyQueryFailure(
+    proxygen::HTTPMessage* /*message*/,
+    const std::vector<std::string>& pathMatch) {
+  const auto queryId = pathMatch[1];
+
+  return new http::CallbackRequestHandler(
+      [this, queryId](
+          proxygen::HTTPMessage* /*message*/,
+          const std::vector<std::unique_ptr<folly::IOBuf>>& /*body*/,
+          proxygen::ResponseHandler* downstream,
+          std::shared_ptr<http::CallbackRequestHandlerState> handlerState) {
+        folly::via(
+            httpSrvCpuExecutor_,
+            [this, queryId]() { taskManager_.fastFailQueryTasks(queryId); })
+            .via(
+                folly::getKeepAliveToken(
+                    folly::EventBaseManager::get()->getEventBase()))
+            .thenValue([downstream, handlerState](auto&& /* unused */) {
+              if (!handlerState->requestExpired()) {
+                http::sendOkResponse(downstream);
+              }
+            })
+            .thenError(
+                folly::tag_t<std::exception>{},
+                [downstream, handlerState](const std::exception& e) {
+                  if (!handlerState->requestExpired()) {
+                    http::sendErrorResponse(downstream, e.what());
+                  }
+                });
+      });
+}
 } // namespace facebook::presto
@@ -13,6 +13,7 @@
  */
 #pragma once
 
+#include "presto_cpp/main/ExchangePageCompression.h"
 #include "presto_cpp/main/TaskManager.h"
 #include "presto_cpp/main/http/HttpServer.h"
 #include "presto_cpp/main/types/VeloxPlanValidator.h"
@@ -25,9 +26,11 @@ class TaskResource {
   explicit TaskResource(
       velox::memory::MemoryPool* pool,
       folly::Executor* httpSrvCpuExecutor,
+      folly::Executor* httpSrvSerializationExecutor,
       VeloxPlanValidator* planValidator,
       TaskManager& taskManager)
       : httpSrvCpuExecutor_(httpSrvCpuExecutor),
+        httpSrvSerializationExecutor_(httpSrvSerializationExecutor),
         pool_{pool},
         planValidator_(planValidator),
         taskManager_(taskManager) {}
@@ -69,12 +72,16 @@ class TaskResource {
       proxygen::HTTPMessage* message,
       const std::vector<std::string>& pathMatch);
 
+  /// 'createOrUpdateFunc' receives either the raw request body or, when the
+  /// body was parsed while being received ('task.update-request-streaming-
+  /// parse-enabled'), the already parsed JSON in place of it.
   proxygen::RequestHandler* createOrUpdateTaskImpl(
       proxygen::HTTPMessage* message,
       const std::vector<std::string>& pathMatch,
       const std::function<std::unique_ptr<protocol::TaskInfo>(
           const protocol::TaskId&,
           const std::string&,
+          nlohmann::json*,
           const bool,
           long,
           const bool)>& createOrUpdateFunc);
@@ -88,23 +95,184 @@ class TaskResource {
       const std::vector<std::string>& pathMatch,
       bool getDataSize);
 
+  /// Returns the cached header template for the no-data getResults response
+  /// of the given output buffer, building and caching it on first use. The
+  /// no-data response is by far the most common one under periodic polling,
+  /// and all of its headers except the page tokens are fixed for the lifetime
+  /// of the buffer.
+  std::shared_ptr<const proxygen::HTTPMessage> emptyResultResponseTemplate(
+      const protocol::TaskId& taskId,
+      long bufferId);
+
+  /// Returns the dictionary compressor of the given output buffer, creating
+  /// it on first use. Only called when
+  /// 'exchange.zstd-dictionary-compression-enabled' is set.
+  std::shared_ptr<ExchangePageCompressor> pageCompressor(
+      const protocol::TaskId& taskId,
+      long bufferId);
+
   proxygen::RequestHandler* getTaskStatus(
       proxygen::HTTPMessage* message,
       const std::vector<std::string>& pathMatch);
 
+  /// Returns the statuses of a posted list of task ids as one response, with
+  /// per-entry ETags so unchanged statuses are answered without a body.
+  proxygen::RequestHandler* getTaskStatusBatch(
+      proxygen::HTTPMessage* message,
+      const std::vector<std::string>& pathMatch);
+
+  /// Returns the serialized TaskStatusDelta frame for a status poller that
+  /// already holds version 'baseVersion' of the task's status, or an empty
+  /// string when the change cannot be expressed as a delta and the full
+  /// snapshot must be sent. Remembers 'current' as the last status sent to
+  /// the poller either way; a full snapshot is forced after every
+  /// kTaskStatusFullSnapshotEvery consecutive deltas to bound drift.
+  std::string maybeMakeTaskStatusDelta(
+      const protocol::TaskId& taskId,
+      int64_t baseVersion,
+      const thrift::TaskStatus& current);
+
   proxygen::RequestHandler* getTaskInfo(
       proxygen::HTTPMessage* message,
       const std::vector<std::string>& pathMatch);
 
+  /// Returns the task's time-sliced per-operator stats history as a
+  /// flame-chart JSON. Empty unless 'task.time-sliced-stats-window-ms' is
+  /// positive.
+  proxygen::RequestHandler* getTimeSlicedStats(
+      proxygen::HTTPMessage* message,
+      const std::vector<std::string>& pathMatch);
+
+  /// Returns a JSON dump of the task's internal state, including each
+  /// exchange source's queue depth, retry state and last-response timing.
+  proxygen::RequestHandler* getTaskDebug(
+      proxygen::HTTPMessage* message,
+      const std::vector<std::string>& pathMatch);
+
+  /// Returns the serialized listing of all tasks on this worker. When the
+  /// periodic task list snapshot is enabled ('task.list-snapshot-refresh-ms'
+  /// above zero), the listing is served from the snapshot together with its
+  /// age in the X-Presto-Task-List-Age-Ms header; otherwise it is built fresh
+  /// per request.
+  proxygen::RequestHandler* getTaskListing(proxygen::HTTPMessage* message);
+
   proxygen::RequestHandler* removeRemoteSource(
       proxygen::HTTPMessage* message,
       const std::vector<std::string>& pathMatch);
 
+  /// Handles a query failure reported by a sibling worker: aborts the running
+  /// tasks of the query ahead of the coordinator's deletes. Only registered
+  /// when 'task.query-failure-gossip-enabled' is set.
+  proxygen::RequestHandler* notifyQueryFailure(
+      proxygen::HTTPMessage* message,
+      const std::vector<std::string>& pathMatch);
+
+  /// Decodes the split arrays extracted from a streaming task update request
+  /// and queues them into the already created task in batches of
+  /// 'task.streaming-split-ingestion-batch-size' splits. 'deferredSources'
+  /// carries the no-more-splits signals that must be delivered only after the
+  /// last batch. Returns the task info produced by the final update.
+  std::unique_ptr<protocol::TaskInfo> streamSplitsIntoTask(
+      const protocol::TaskId& taskId,
+      const protocol::TaskUpdateRequest& updateRequest,
+      std::vector<nlohmann::json> sourceSplits,
+      std::vector<protocol::TaskSource> deferredSources,
+      bool summarize,
+      long startProcessCpuTime);
+
+  /// Handles a coordinator-push split stream: one long-lived chunked POST
+  /// per task whose body is a sequence of newline-delimited JSON TaskSource
+  /// frames, each queued into the task when it arrives instead of when the
+  /// request ends. The coordinator must have delivered the task's plan
+  /// before opening the stream. Only registered when
+  /// 'task.split-stream-enabled' is set.
+  proxygen::RequestHandler* streamTaskSplits(
+      proxygen::HTTPMessage* message,
+      const std::vector<std::string>& pathMatch);
+
+  /// Returns true when 'signature' is a valid HMAC-SHA256 of 'digest' keyed
+  /// by 'internal-communication.shared-secret'. Successful verifications are
+  /// cached per digest, so a stage's 400 tasks verify its fragment once.
+  /// Only called when 'task.trusted-plan-enabled' is set.
+  bool verifyTrustedPlanSignature(
+      const std::string& digest,
+      const std::string& signature);
+
+  // The serialized response sent for an applied task update, remembered to
+  // answer retried deliveries of the same update body.
+  struct AppliedUpdateResponse {
+    std::string body;
+    bool thrift{false};
+    uint64_t appliedMs{0};
+  };
+
+  /// Returns the response remembered for an applied update of 'taskId'
+  /// whose request body digest is 'digest', if it is younger than 'ttlMs'.
+  /// Only called when 'task.update-request-dedup-ttl-ms' is positive.
+  std::optional<AppliedUpdateResponse> findAppliedUpdateResponse(
+      const protocol::TaskId& taskId,
+      uint64_t digest,
+      uint64_t ttlMs);
+
+  /// Remembers 'responseBody' as the response sent for the applied update
+  /// of 'taskId' with request body digest 'digest', keeping only the few
+  /// most recently applied updates per task.
+  void rememberAppliedUpdateResponse(
+      const protocol::TaskId& taskId,
+      uint64_t digest,
+      const std::string& responseBody,
+      bool thrift);
+
   folly::Executor* const httpSrvCpuExecutor_;
+  // Optional executor for JSON encoding of large TaskInfo responses; nullptr
+  // when serialization offload is disabled.
+  folly::Executor* const httpSrvSerializationExecutor_;
   velox::memory::MemoryPool* const pool_;
   VeloxPlanValidator* const planValidator_;
 
   TaskManager& taskManager_;
+
+  // Cached no-data getResults response templates keyed by task id and output
+  // buffer id. Entries are dropped when the buffer is aborted or the task is
+  // deleted.
+  folly::Synchronized<std::unordered_map<
+      protocol::TaskId,
+      std::unordered_map<long, std::shared_ptr<const proxygen::HTTPMessage>>>>
+      emptyResultResponses_;
+
+  // Dictionary compressors keyed by task id and output buffer id, tracking
+  // the training samples and trained zstd dictionary of each destination.
+  // Entries are dropped when the buffer is aborted or the task is deleted.
+  folly::Synchronized<std::unordered_map<
+      protocol::TaskId,
+      std::unordered_map<long, std::shared_ptr<ExchangePageCompressor>>>>
+      pageCompressors_;
+
+  // Last task status sent to a delta-capable status poller along with the
+  // number of consecutive delta responses served from it.
+  struct TaskStatusSnapshot {
+    std::shared_ptr<thrift::TaskStatus> status;
+    uint32_t deltasSinceFull{0};
+  };
+
+  // Snapshots backing the TaskStatusDelta responses, keyed by task id.
+  // Entries are dropped when the task is deleted.
+  folly::Synchronized<std::unordered_map<protocol::TaskId, TaskStatusSnapshot>>
+      lastSentTaskStatus_;
+
+  // Fragment digests whose plan signature already verified, mapped to that
+  // signature. Digests are small, so the map is cleared rather than evicted
+  // when it grows past its bound; re-verification is cheap.
+  folly::Synchronized<std::unordered_map<std::string, std::string>>
+      verifiedPlanSignatures_;
+
+  // Responses of recently applied task updates keyed by task id and request
+  // body digest; see 'task.update-request-dedup-ttl-ms'. Entries expire by
+  // TTL on lookup and are dropped when the task is deleted.
+  folly::Synchronized<std::unordered_map<
+      protocol::TaskId,
+      std::unordered_map<uint64_t, AppliedUpdateResponse>>>
+      appliedUpdateResponses_;
 };
 
 } // namespace facebook::presto
@@ -0,0 +1,90 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/base64.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/encode/Base64.h"
+
+namespace facebook::presto {
+namespace {
+
+// Compares the scalar velox base64 decoder with folly's SIMD-accelerated one
+// on payload sizes representative of split extra info and serialized
+// fragments. protocol::decodeBase64() uses the folly decoder.
+
+std::string makeEncodedPayload(size_t numBytes) {
+  std::string data(numBytes, '\0');
+  folly::Random::DefaultGenerator rng(42);
+  for (auto& c : data) {
+    c = static_cast<char>(folly::Random::rand32(rng));
+  }
+  return folly::base64Encode(data);
+}
+
+void veloxDecode(size_t iterations, size_t numBytes) {
+  folly::BenchmarkSuspender suspender;
+  const auto encoded = makeEncodedPayload(numBytes);
+  suspender.dismiss();
+
+  for (size_t i = 0; i < iterations; ++i) {
+    auto decoded = velox::encoding::Base64::decode(encoded);
+    folly::doNotOptimizeAway(decoded);
+  }
+}
+
+void follyDecode(size_t iterations, size_t numBytes) {
+  folly::BenchmarkSuspender suspender;
+  const auto encoded = makeEncodedPayload(numBytes);
+  suspender.dismiss();
+
+  for (size_t i = 0; i < iterations; ++i) {
+    auto decoded = folly::base64Decode(encoded);
+    folly::doNotOptimizeAway(decoded);
+  }
+}
+
+BENCHMARK(veloxDecode256B, n) {
+  veloxDecode(n, 256);
+}
+
+BENCHMARK_RELATIVE(follyDecode256B, n) {
+  follyDecode(n, 256);
+}
+
+BENCHMARK(veloxDecode4KB, n) {
+  veloxDecode(n, 4 << 10);
+}
+
+BENCHMARK_RELATIVE(follyDecode4KB, n) {
+  follyDecode(n, 4 << 10);
+}
+
+BENCHMARK(veloxDecode1MB, n) {
+  veloxDecode(n, 1 << 20);
+}
+
+BENCHMARK_RELATIVE(follyDecode1MB, n) {
+  follyDecode(n, 1 << 20);
+}
+
+} // namespace
+} // namespace facebook::presto
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <algorithm>
+
+#include "presto_cpp/main/PrestoToVeloxQueryConfig.h"
+#include "presto_cpp/main/SessionProperties.h"
+
+namespace facebook::presto {
+namespace {
+
+// Measures the session-to-velox config translation that runs on every
+// createOrUpdateTask that misses the query context cache.
+
+protocol::SessionRepresentation makeSession(size_t numSystemProperties) {
+  protocol::SessionRepresentation session;
+  session.user = "benchmark";
+  session.timeZoneKey = 0;
+
+  // Use real registered properties so the benchmark exercises the
+  // registry translation rather than the unknown-property passthrough.
+  std::vector<std::string> propertyNames;
+  for (const auto& property : SessionProperties::instance()->serialize()) {
+    const auto name = property["name"].get<std::string>();
+    // Skip the properties whose values are interpreted during translation;
+    // the placeholder value below is not valid for them.
+    if (name == SessionProperties::kQueryTraceFragmentId ||
+        name == SessionProperties::kQueryTraceShardId ||
+        name == SessionProperties::kShuffleCompressionCodec) {
+      continue;
+    }
+    propertyNames.push_back(name);
+  }
+  std::sort(propertyNames.begin(), propertyNames.end());
+  for (size_t i = 0; i < numSystemProperties && i < propertyNames.size(); ++i) {
+    session.systemProperties[propertyNames[i]] = "1";
+  }
+  return session;
+}
+
+void runToVeloxConfigs(size_t iterations, size_t numSystemProperties) {
+  folly::BenchmarkSuspender suspender;
+  const auto session = makeSession(numSystemProperties);
+  const std::map<std::string, std::string> emptyCredentials;
+  suspender.dismiss();
+
+  for (size_t i = 0; i < iterations; ++i) {
+    auto config = toVeloxConfigs(session, emptyCredentials);
+    folly::doNotOptimizeAway(config);
+  }
+}
+
+BENCHMARK(toVeloxConfigs5Properties, n) {
+  runToVeloxConfigs(n, 5);
+}
+
+BENCHMARK(toVeloxConfigs20Properties, n) {
+  runToVeloxConfigs(n, 20);
+}
+
+BENCHMARK(toVeloxConfigs50Properties, n) {
+  runToVeloxConfigs(n, 50);
+}
+
+} // namespace
+} // namespace facebook::presto
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/common/AllocationTracker.h"
+
+#ifdef PRESTO_ENABLE_ALLOCATION_TRACKING
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+
+namespace {
+
+using facebook::presto::AllocationTag;
+using facebook::presto::AllocationTracker;
+using facebook::presto::kNumAllocationTags;
+
+thread_local AllocationTag currentTag = AllocationTag::kNone;
+// Per-thread countdown to the next sampled allocation, so the sampling
+// itself costs one decrement on the untracked path.
+thread_local uint32_t sampleCountdown = AllocationTracker::kSampleEvery;
+
+// Sampled (unscaled) totals per tag.
+std::atomic<uint64_t> sampledAllocations[kNumAllocationTags];
+std::atomic<uint64_t> sampledBytes[kNumAllocationTags];
+
+// Totals already published by recordMetrics(), so each call reports deltas.
+uint64_t reportedAllocations[kNumAllocationTags];
+uint64_t reportedBytes[kNumAllocationTags];
+
+inline void trackAllocation(std::size_t size) {
+  if (currentTag == AllocationTag::kNone) {
+    return;
+  }
+  if (--sampleCountdown != 0) {
+    return;
+  }
+  sampleCountdown = AllocationTracker::kSampleEvery;
+  const auto index = static_cast<int32_t>(currentTag);
+  sampledAllocations[index].fetch_add(1, std::memory_order_relaxed);
+  sampledBytes[index].fetch_add(size, std::memory_order_relaxed);
+}
+
+// malloc with the standard new-handler loop; paired with the operator
+// delete replacements below, which free().
+void* allocate(std::size_t size) {
+  trackAllocation(size);
+  while (true) {
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+      return ptr;
+    }
+    if (auto handler = std::get_new_handler()) {
+      handler();
+    } else {
+      throw std::bad_alloc{};
+    }
+  }
+}
+} // namespace
+
+namespace facebook::presto {
+
+ScopedAllocationTag::ScopedAllocationTag(AllocationTag tag)
+    : previous_{currentTag} {
+  currentTag = tag;
+}
+
+ScopedAllocationTag::~ScopedAllocationTag() {
+  currentTag = previous_;
+}
+
+// static
+AllocationTracker::TagCounters AllocationTracker::counters(AllocationTag tag) {
+  const auto index = static_cast<int32_t>(tag);
+  return {
+      sampledAllocations[index].load(std::memory_order_relaxed) * kSampleEvery,
+      sampledBytes[index].load(std::memory_order_relaxed) * kSampleEvery};
+}
+
+// static
+void AllocationTracker::recordMetrics() {
+  static const struct {
+    AllocationTag tag;
+    std::string_view countCounter;
+    std::string_view bytesCounter;
+  } kTagCounters[] = {
+      {AllocationTag::kProtocolSerde,
+       kCounterProtocolSerdeEstimatedAllocCount,
+       kCounterProtocolSerdeEstimatedAllocBytes},
+      {AllocationTag::kExchange,
+       kCounterExchangeEstimatedAllocCount,
+       kCounterExchangeEstimatedAllocBytes},
+  };
+  for (const auto& entry : kTagCounters) {
+    const auto index = static_cast<int32_t>(entry.tag);
+    const auto totals = counters(entry.tag);
+    RECORD_METRIC_VALUE(
+        entry.countCounter, totals.allocations - reportedAllocations[index]);
+    RECORD_METRIC_VALUE(
+        entry.bytesCounter, totals.bytes - reportedBytes[index]);
+    reportedAllocations[index] = totals.allocations;
+    reportedBytes[index] = totals.bytes;
+  }
+}
+
+} // namespace facebook::presto
+
+// Global replacements. Linking this translation unit routes every heap
+// allocation of the process through the sampling hook above; the unaligned
+// forms below pair malloc with free, and the aligned forms fall through to
+// the default implementations, which pair with each other.
+void* operator new(std::size_t size) {
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+  return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+#endif // PRESTO_ENABLE_ALLOCATION_TRACKING
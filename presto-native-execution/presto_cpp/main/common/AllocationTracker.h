@@ -0,0 +1,81 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace facebook::presto {
+
+/// Sampled allocation instrumentation for the worker's hottest subsystems.
+/// When the worker is built with PRESTO_ENABLE_ALLOCATION_TRACKING (cmake
+/// option of the same name), the global operator new is replaced with one
+/// that attributes every kSampleEvery-th heap allocation made under a
+/// ScopedAllocationTag to that tag. The per-tag totals, extrapolated from
+/// the sampling rate, are published as counters by the periodic task
+/// manager, so allocator regressions in these paths show up on dashboards
+/// without attaching a profiler. When the option is off, the scope guards
+/// compile to nothing and operator new is left alone.
+enum class AllocationTag {
+  /// Allocation made outside any tagged scope; not tracked.
+  kNone = 0,
+  /// Protocol JSON serde: task update parsing and TaskInfo serialization.
+  kProtocolSerde = 1,
+  /// Exchange data response processing.
+  kExchange = 2,
+};
+
+constexpr int32_t kNumAllocationTags = 3;
+
+class AllocationTracker {
+ public:
+  /// One in this many allocations under a tagged scope is recorded; the
+  /// published totals are scaled back up by the same factor.
+  static constexpr uint32_t kSampleEvery = 100;
+
+#ifdef PRESTO_ENABLE_ALLOCATION_TRACKING
+  /// Extrapolated allocation totals of one tag since process start.
+  struct TagCounters {
+    uint64_t allocations{0};
+    uint64_t bytes{0};
+  };
+
+  /// Returns the extrapolated totals accumulated under 'tag'.
+  static TagCounters counters(AllocationTag tag);
+
+  /// Publishes the totals accumulated since the previous call as counter
+  /// deltas. Invoked periodically by the periodic task manager.
+  static void recordMetrics();
+#endif
+};
+
+#ifdef PRESTO_ENABLE_ALLOCATION_TRACKING
+/// Attributes heap allocations made on this thread to 'tag' for the
+/// lifetime of the scope. Scopes nest; the enclosing tag is restored on
+/// destruction.
+class ScopedAllocationTag {
+ public:
+  explicit ScopedAllocationTag(AllocationTag tag);
+  ~ScopedAllocationTag();
+
+ private:
+  const AllocationTag previous_;
+};
+#else
+class ScopedAllocationTag {
+ public:
+  explicit ScopedAllocationTag(AllocationTag /*tag*/) {}
+};
+#endif
+
+} // namespace facebook::presto
@@ -0,0 +1,235 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/common/CompressionBackend.h"
+
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::presto {
+namespace {
+
+// The always-available backend over the folly software codecs. It is the
+// baseline the rank scale is anchored to: hardware engines advertise ranks
+// below 100 on the axis they improve.
+class SoftwareCompressionBackend : public CompressionBackend {
+ public:
+  std::string_view name() const override {
+    return "software";
+  }
+
+  bool available() const override {
+    return true;
+  }
+
+  bool supports(folly::compression::CodecType type) const override {
+    return folly::compression::hasCodec(type);
+  }
+
+  int32_t latencyRank() const override {
+    return 100;
+  }
+
+  int32_t ratioRank() const override {
+    return 100;
+  }
+
+  std::string compress(
+      folly::compression::CodecType type,
+      folly::StringPiece data) override {
+    return folly::compression::getCodec(type)->compress(data);
+  }
+
+  std::string uncompress(
+      folly::compression::CodecType type,
+      folly::StringPiece data) override {
+    return folly::compression::getCodec(type)->uncompress(data);
+  }
+
+  std::unique_ptr<folly::IOBuf> uncompress(
+      folly::compression::CodecType type,
+      const folly::IOBuf* data) override {
+    return folly::compression::getCodec(type)->uncompress(data);
+  }
+};
+
+void recordCompress(
+    CompressionBackendRegistry::BackendStats& stats,
+    uint64_t inputBytes,
+    uint64_t outputBytes,
+    uint64_t micros) {
+  stats.compressInputBytes += inputBytes;
+  stats.compressOutputBytes += outputBytes;
+  stats.compressMicros += micros;
+  RECORD_METRIC_VALUE(kCounterCompressionBackendCompressInputBytes, inputBytes);
+  RECORD_METRIC_VALUE(
+      kCounterCompressionBackendCompressOutputBytes, outputBytes);
+  // bytes/us == MB/s.
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      kCounterCompressionBackendCompressThroughputMbPerSec,
+      inputBytes / std::max<uint64_t>(micros, 1));
+}
+
+void recordUncompress(
+    CompressionBackendRegistry::BackendStats& stats,
+    uint64_t inputBytes,
+    uint64_t outputBytes,
+    uint64_t micros) {
+  stats.uncompressInputBytes += inputBytes;
+  stats.uncompressOutputBytes += outputBytes;
+  stats.uncompressMicros += micros;
+  RECORD_METRIC_VALUE(
+      kCounterCompressionBackendUncompressInputBytes, inputBytes);
+}
+} // namespace
+
+CompressionBackendRegistry::CompressionBackendRegistry() {
+  registerBackend(std::make_unique<SoftwareCompressionBackend>());
+}
+
+// static
+CompressionBackendRegistry* CompressionBackendRegistry::instance() {
+  static auto* registry = new CompressionBackendRegistry();
+  return registry;
+}
+
+bool CompressionBackendRegistry::registerBackend(
+    std::unique_ptr<CompressionBackend> backend) {
+  if (!backend->available()) {
+    LOG(INFO) << "Compression backend '" << backend->name()
+              << "' is not available on this host; not registering";
+    return false;
+  }
+  LOG(INFO) << "Registered compression backend '" << backend->name()
+            << "' (latency rank " << backend->latencyRank() << ", ratio rank "
+            << backend->ratioRank() << ")";
+  std::lock_guard<std::mutex> l(mutex_);
+  Entry entry;
+  entry.stats.name = std::string(backend->name());
+  entry.backend = std::move(backend);
+  entries_.push_back(std::move(entry));
+  return true;
+}
+
+CompressionBackend* CompressionBackendRegistry::selectLocked(
+    CompressionUse use,
+    folly::compression::CodecType type) const {
+  const CompressionBackend* best = nullptr;
+  for (const auto& entry : entries_) {
+    if (!entry.backend->supports(type)) {
+      continue;
+    }
+    auto rank = [use](const CompressionBackend& backend) {
+      return use == CompressionUse::kExchange ? backend.latencyRank()
+                                              : backend.ratioRank();
+    };
+    // Strict comparison keeps registration order as the tie-breaker.
+    if (best == nullptr || rank(*entry.backend) < rank(*best)) {
+      best = entry.backend.get();
+    }
+  }
+  VELOX_CHECK_NOT_NULL(
+      best,
+      "No compression backend supports codec type {}",
+      static_cast<int>(type));
+  return const_cast<CompressionBackend*>(best);
+}
+
+CompressionBackend* CompressionBackendRegistry::getBackend(
+    CompressionUse use,
+    folly::compression::CodecType type) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return selectLocked(use, type);
+}
+
+std::string CompressionBackendRegistry::compress(
+    CompressionUse use,
+    folly::compression::CodecType type,
+    folly::StringPiece data) {
+  auto* backend = getBackend(use, type);
+  uint64_t micros{0};
+  std::string compressed;
+  {
+    velox::MicrosecondTimer timer(&micros);
+    compressed = backend->compress(type, data);
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& entry : entries_) {
+    if (entry.backend.get() == backend) {
+      recordCompress(entry.stats, data.size(), compressed.size(), micros);
+      break;
+    }
+  }
+  return compressed;
+}
+
+std::string CompressionBackendRegistry::uncompress(
+    CompressionUse use,
+    folly::compression::CodecType type,
+    folly::StringPiece data) {
+  auto* backend = getBackend(use, type);
+  uint64_t micros{0};
+  std::string uncompressed;
+  {
+    velox::MicrosecondTimer timer(&micros);
+    uncompressed = backend->uncompress(type, data);
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& entry : entries_) {
+    if (entry.backend.get() == backend) {
+      recordUncompress(entry.stats, data.size(), uncompressed.size(), micros);
+      break;
+    }
+  }
+  return uncompressed;
+}
+
+std::unique_ptr<folly::IOBuf> CompressionBackendRegistry::uncompress(
+    CompressionUse use,
+    folly::compression::CodecType type,
+    const folly::IOBuf* data) {
+  auto* backend = getBackend(use, type);
+  uint64_t micros{0};
+  std::unique_ptr<folly::IOBuf> uncompressed;
+  {
+    velox::MicrosecondTimer timer(&micros);
+    uncompressed = backend->uncompress(type, data);
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& entry : entries_) {
+    if (entry.backend.get() == backend) {
+      recordUncompress(
+          entry.stats,
+          data->computeChainDataLength(),
+          uncompressed->computeChainDataLength(),
+          micros);
+      break;
+    }
+  }
+  return uncompressed;
+}
+
+std::vector<CompressionBackendRegistry::BackendStats>
+CompressionBackendRegistry::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::vector<BackendStats> ret;
+  ret.reserve(entries_.size());
+  for (const auto& entry : entries_) {
+    ret.push_back(entry.stats);
+  }
+  return ret;
+}
+
+} // namespace facebook::presto
@@ -0,0 +1,147 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/compression/Compression.h>
+#include <folly/io/IOBuf.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace facebook::presto {
+
+/// Which worker path a compression request comes from. The paths weight the
+/// speed/ratio trade-off differently: exchange (de)compression sits on the
+/// query's latency path, while spill-style writes such as shuffle files trade
+/// CPU for a smaller disk footprint.
+enum class CompressionUse {
+  kExchange = 0,
+  kSpill = 1,
+};
+
+/// One implementation of the standard compression formats: the built-in
+/// software codecs, or a hardware engine (QAT, ISA-L) registered by a build
+/// that links the vendor library. Backends implement standard formats, so the
+/// bytes any backend produces are readable by every other backend; selection
+/// only decides who does the work, never what the wire or disk format is.
+class CompressionBackend {
+ public:
+  virtual ~CompressionBackend() = default;
+
+  /// Short stable identifier, e.g. "software" or "qat".
+  virtual std::string_view name() const = 0;
+
+  /// Probes whether the backend is usable on this host (device nodes, driver,
+  /// engine initialization). Called once at registration; an unavailable
+  /// backend is never selected.
+  virtual bool available() const = 0;
+
+  /// Whether the backend implements 'type'.
+  virtual bool supports(folly::compression::CodecType type) const = 0;
+
+  /// Relative cost ranks used by the per-path selection policy; lower is
+  /// better. The software backend ranks 100 on both axes, so hardware engines
+  /// advertise smaller values on the axis they improve.
+  virtual int32_t latencyRank() const = 0;
+  virtual int32_t ratioRank() const = 0;
+
+  virtual std::string compress(
+      folly::compression::CodecType type,
+      folly::StringPiece data) = 0;
+
+  virtual std::string uncompress(
+      folly::compression::CodecType type,
+      folly::StringPiece data) = 0;
+
+  virtual std::unique_ptr<folly::IOBuf> uncompress(
+      folly::compression::CodecType type,
+      const folly::IOBuf* data) = 0;
+};
+
+/// Worker-wide registry of compression backends. The software backend over
+/// the folly codecs is always present; hardware-enabled builds register their
+/// engines at startup via registerBackend() and the registry keeps only the
+/// ones whose availability probe passes. getBackend() applies the per-path
+/// policy: among the backends supporting the requested format, the exchange
+/// path takes the lowest latency rank and the spill path the lowest ratio
+/// rank. The compress()/uncompress() wrappers fold the observed bytes and
+/// time into per-backend stats and worker counters so an engine that
+/// underperforms its advertised rank is visible.
+class CompressionBackendRegistry {
+ public:
+  /// A fresh registry holding only the software backend. Production code
+  /// uses instance(); tests construct their own to register fakes.
+  CompressionBackendRegistry();
+
+  static CompressionBackendRegistry* instance();
+
+  /// Registers 'backend' if its availability probe passes; returns whether it
+  /// was kept. Registration order breaks rank ties.
+  bool registerBackend(std::unique_ptr<CompressionBackend> backend);
+
+  /// Returns the backend the policy picks for 'use' and 'type'. At least the
+  /// software backend always matches for the formats folly ships.
+  CompressionBackend* getBackend(
+      CompressionUse use,
+      folly::compression::CodecType type) const;
+
+  /// Policy-selecting wrappers that also account the work against the chosen
+  /// backend's stats and the worker counters.
+  std::string compress(
+      CompressionUse use,
+      folly::compression::CodecType type,
+      folly::StringPiece data);
+
+  std::string uncompress(
+      CompressionUse use,
+      folly::compression::CodecType type,
+      folly::StringPiece data);
+
+  std::unique_ptr<folly::IOBuf> uncompress(
+      CompressionUse use,
+      folly::compression::CodecType type,
+      const folly::IOBuf* data);
+
+  /// Throughput totals for one backend.
+  struct BackendStats {
+    std::string name;
+    uint64_t compressInputBytes{0};
+    uint64_t compressOutputBytes{0};
+    uint64_t compressMicros{0};
+    uint64_t uncompressInputBytes{0};
+    uint64_t uncompressOutputBytes{0};
+    uint64_t uncompressMicros{0};
+  };
+
+  /// Returns per-backend totals, in registration order.
+  std::vector<BackendStats> stats() const;
+
+ private:
+  struct Entry {
+    std::unique_ptr<CompressionBackend> backend;
+    BackendStats stats;
+  };
+
+  CompressionBackend* selectLocked(
+      CompressionUse use,
+      folly::compression::CodecType type) const;
+
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+};
+
+} // namespace facebook::presto
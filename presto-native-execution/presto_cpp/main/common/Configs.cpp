@@ -75,6 +75,8 @@ void ConfigBase::initialize(const std::string& filePath, bool optionalConfig) {
 
   config_ = std::make_unique<velox::config::ConfigBase>(
       std::move(values), mutableConfig);
+  // Invalidate any DynamicProperty caches from a previous initialization.
+  generation_.fetch_add(1, std::memory_order_release);
 }
 
 bool ConfigBase::registerProperty(
@@ -102,12 +104,42 @@ folly::Optional<std::string> ConfigBase::setValue(
       propertyName);
   auto oldValue = config_->get<std::string>(propertyName);
   config_->set(propertyName, value);
+  // Invalidate the DynamicProperty caches after the new value is visible.
+  generation_.fetch_add(1, std::memory_order_release);
   if (oldValue.has_value()) {
     return oldValue.value();
   }
   return registeredProps_[propertyName];
 }
 
+std::string ConfigBase::reloadDynamicProperties(
+    const std::unordered_set<std::string>& dynamicProperties) {
+  VELOX_USER_CHECK(
+      !filePath_.empty(), "Config was not initialized from a file.");
+  const auto values = util::readConfig(fs::path(filePath_));
+
+  std::stringstream out;
+  size_t numApplied{0};
+  for (const auto& [name, value] : values) {
+    const auto oldValue = optionalProperty(name);
+    if (oldValue.has_value() && oldValue.value() == value) {
+      continue;
+    }
+    if (dynamicProperties.count(name) == 0) {
+      out << "Skipped '" << name
+          << "': property is frozen at startup, restart to apply.\n";
+      continue;
+    }
+    setValue(name, value);
+    out << "Applied '" << name << "' = '" << value << "' (was '"
+        << oldValue.value_or("<default>") << "').\n";
+    ++numApplied;
+  }
+  out << "Reloaded '" << filePath_ << "': " << numApplied
+      << " dynamic properties applied.\n";
+  return out.str();
+}
+
 void ConfigBase::checkRegisteredProperties(
     const std::unordered_map<std::string, std::string>& values) {
   std::stringstream supported;
@@ -138,6 +170,7 @@ SystemConfig::SystemConfig() {
           NONE_PROP(kHttpServerHttpPort),
           BOOL_PROP(kHttpServerReusePort, false),
           BOOL_PROP(kHttpServerBindToNodeInternalAddressOnlyEnabled, false),
+          STR_PROP(kHttpServerUnixDomainSocketPath, ""),
           NONE_PROP(kDiscoveryUri),
           NUM_PROP(kMaxDriversPerTask, hardwareConcurrency()),
           NONE_PROP(kTaskWriterCount),
@@ -148,9 +181,11 @@ SystemConfig::SystemConfig() {
           NUM_PROP(kDriverMaxSplitPreload, 2),
           NUM_PROP(kHttpServerNumIoThreadsHwMultiplier, 1.0),
           NUM_PROP(kHttpServerNumCpuThreadsHwMultiplier, 1.0),
+          NUM_PROP(kHttpServerNumSerializationThreadsHwMultiplier, 0.0),
           NONE_PROP(kHttpServerHttpsPort),
           BOOL_PROP(kHttpServerHttpsEnabled, false),
           BOOL_PROP(kHttpServerHttp2Enabled, true),
+          NUM_PROP(kHttpServerMaxConcurrentDataRequests, 0),
           NUM_PROP(kHttpServerIdleTimeoutMs, 60'000),
           NUM_PROP(kHttpServerHttp2InitialReceiveWindow, 1 << 20),
           NUM_PROP(kHttpServerHttp2ReceiveStreamWindowSize, 1 << 20),
@@ -169,12 +204,22 @@ SystemConfig::SystemConfig() {
           NONE_PROP(kHttpsKeyPath),
           NONE_PROP(kHttpsClientCertAndKeyPath),
           NONE_PROP(kHttpsClientCaFile),
+          BOOL_PROP(kHttpsKtlsEnabled, false),
           NUM_PROP(kExchangeHttpClientNumIoThreadsHwMultiplier, 1.0),
           NUM_PROP(kExchangeHttpClientNumCpuThreadsHwMultiplier, 1.0),
           NUM_PROP(kConnectorNumCpuThreadsHwMultiplier, 0.0),
           NUM_PROP(kConnectorNumIoThreadsHwMultiplier, 1.0),
           NUM_PROP(kDriverNumCpuThreadsHwMultiplier, 4.0),
+          BOOL_PROP(kDriverElasticScalingEnabled, false),
+          NUM_PROP(kDriverElasticScalingMaxThreadsHwMultiplier, 8.0),
+          NUM_PROP(kDriverElasticScalingLatencyThresholdMs, 50),
           BOOL_PROP(kDriverThreadsBatchSchedulingEnabled, false),
+          BOOL_PROP(kDriverNumaBindingEnabled, false),
+          BOOL_PROP(kDriverSoftAffinityEnabled, false),
+          STR_PROP(kNumaBindingInterface, ""),
+          BOOL_PROP(kCrashHandoffEnabled, false),
+          STR_PROP(kCrashHandoffFilePath, ""),
+          STR_PROP(kCrashHandoffNotifyAddress, ""),
           NUM_PROP(kDriverStuckOperatorThresholdMs, 30 * 60 * 1000),
           NUM_PROP(
               kDriverCancelTasksWithStuckOperatorsThresholdMs, 40 * 60 * 1000),
@@ -182,6 +227,8 @@ SystemConfig::SystemConfig() {
               kDriverNumStuckOperatorsToDetachWorker,
               std::round(0.5 * hardwareConcurrency())),
           NUM_PROP(kSpillerNumCpuThreadsHwMultiplier, 1.0),
+          BOOL_PROP(kSpillerFairSchedulingEnabled, false),
+          NUM_PROP(kSpillerFairSchedulingMaxInFlightPerQuery, 0),
           STR_PROP(kSpillerFileCreateConfig, ""),
           STR_PROP(kSpillerDirectoryCreateConfig, ""),
           NONE_PROP(kSpillerSpillPath),
@@ -192,12 +239,14 @@ SystemConfig::SystemConfig() {
           NUM_PROP(kSystemMemShrinkGb, 8),
           BOOL_PROP(kMallocMemHeapDumpEnabled, false),
           BOOL_PROP(kSystemMemPushbackAbortEnabled, false),
+          NUM_PROP(kSystemMemPushbackArbitrationRatio, 0.0),
           NUM_PROP(kWorkerOverloadedThresholdMemGb, 0),
           NUM_PROP(kWorkerOverloadedThresholdCpuPct, 0),
           NUM_PROP(kWorkerOverloadedThresholdNumQueuedDriversHwMultiplier, 0.0),
           NUM_PROP(kWorkerOverloadedCooldownPeriodSec, 5),
           NUM_PROP(kWorkerOverloadedSecondsToDetachWorker, 0),
           BOOL_PROP(kWorkerOverloadedTaskQueuingEnabled, false),
+          BOOL_PROP(kWorkerOverloadedTaskQueueDrainToIdleEnabled, false),
           NUM_PROP(kMallocHeapDumpThresholdGb, 20),
           NUM_PROP(kMallocMemMinHeapDumpInterval, 10),
           NUM_PROP(kMallocMemMaxHeapDumpFiles, 5),
@@ -229,10 +278,35 @@ SystemConfig::SystemConfig() {
           BOOL_PROP(kEnableVeloxTaskLogging, false),
           BOOL_PROP(kEnableVeloxExprSetLogging, false),
           NUM_PROP(kLocalShuffleMaxPartitionBytes, 268435456),
+          NUM_PROP(kLocalShuffleMemoryTransportMaxBytes, 0),
+          NUM_PROP(kLocalShuffleReadPrefetchDepth, 0),
+          BOOL_PROP(kLocalShuffleFileCompressionEnabled, false),
+          BOOL_PROP(kLocalShuffleFileChecksumEnabled, true),
+          NUM_PROP(kLocalShuffleCompactionMinFileBytes, 0),
+          BOOL_PROP(kLocalShuffleBlockHeaderEnabled, false),
+          NUM_PROP(kLocalShuffleDedupMaxBytes, 0),
+          BOOL_PROP(kShuffleStreamingAggregationEnabled, false),
+          NUM_PROP(kLocalDiskIoMaxBandwidthBytesPerSecond, 0),
+          NUM_PROP(kBroadcastFileReaderPrefetchDepth, 0),
+          NUM_PROP(kBroadcastFileCacheMaxBytes, 0),
+          BOOL_PROP(kBroadcastFileReaderMmapEnabled, false),
+          NUM_PROP(kBroadcastFileWriterMaxBufferedBytes, 0),
+          NUM_PROP(kHiveFileMetadataCacheMaxBytes, 0),
+          NUM_PROP(kIcebergDeleteFileCacheMaxBytes, 0),
+          BOOL_PROP(kFragmentResultCacheEnabled, false),
+          NUM_PROP(kFragmentResultCacheMaxBytes, 128UL << 20),
+          NUM_PROP(kFragmentResultCacheMaxEntryBytes, 16UL << 20),
+          NUM_PROP(kFragmentResultCacheTtlMs, 600'000),
+          STR_PROP(kFragmentResultCacheBaseDirectory, ""),
+          NUM_PROP(kFragmentResultCacheMaxDiskBytes, 1UL << 30),
+          BOOL_PROP(kFragmentResultCacheScanShareEnabled, false),
           STR_PROP(kShuffleName, ""),
           STR_PROP(kRemoteFunctionServerCatalogName, ""),
           STR_PROP(kRemoteFunctionServerSerde, "presto_page"),
+          NUM_PROP(kRemoteFunctionServerRestNumConnections, 4),
+          NUM_PROP(kRemoteFunctionServerRestMemoCacheMaxBytes, 0UL),
           BOOL_PROP(kHttpEnableAccessLog, false),
+          NUM_PROP(kHttpAccessLogSampleRate, 1),
           BOOL_PROP(kHttpEnableStatsFilter, false),
           BOOL_PROP(kHttpEnableEndpointLatencyFilter, false),
           NUM_PROP(kHttpMaxAllocateBytes, 65536),
@@ -243,21 +317,47 @@ SystemConfig::SystemConfig() {
           BOOL_PROP(kLogZombieTaskInfo, false),
           NUM_PROP(kLogNumZombieTasks, 20),
           NUM_PROP(kAnnouncementMaxFrequencyMs, 30'000), // 30s
+          BOOL_PROP(kAnnouncementDeltaEnabled, false),
+          BOOL_PROP(kStartupParallelRegistrationEnabled, false),
           NUM_PROP(kHeartbeatFrequencyMs, 0),
+          BOOL_PROP(kHeartbeatStatsDeltaEnabled, false),
+          NUM_PROP(kHeartbeatStatsMaxAgeMs, 30'000), // 30s
           BOOL_PROP(kHttpClientHttp2Enabled, false),
           NUM_PROP(kHttpClientHttp2MaxStreamsPerConnection, 8),
-          NUM_PROP(kHttpClientHttp2InitialStreamWindow, 1 << 23 /*8MB*/),
-          NUM_PROP(kHttpClientHttp2StreamWindow, 1 << 23 /*8MB*/),
-          NUM_PROP(kHttpClientHttp2SessionWindow, 1 << 26 /*64MB*/),
+          // Stream windows cover a full exchange page (up to 32MB) so a
+          // single getData response never stalls on stream flow control.
+          NUM_PROP(kHttpClientHttp2InitialStreamWindow, 1 << 25 /*32MB*/),
+          NUM_PROP(kHttpClientHttp2StreamWindow, 1 << 25 /*32MB*/),
+          NUM_PROP(kHttpClientHttp2SessionWindow, 1 << 27 /*128MB*/),
           BOOL_PROP(kHttpClientConnectionReuseCounterEnabled, true),
           STR_PROP(kExchangeMaxErrorDuration, "3m"),
+          NUM_PROP(kExchangeTraceSampleEveryN, 0),
+          BOOL_PROP(kExchangeZstdDictionaryCompressionEnabled, false),
+          NUM_PROP(kExchangeZstdDictionaryTrainingPages, 64),
           STR_PROP(kExchangeRequestTimeout, "20s"),
           STR_PROP(kExchangeConnectTimeout, "20s"),
           BOOL_PROP(kExchangeEnableConnectionPool, true),
+          NUM_PROP(kExchangeConnectionPoolWarmupPerPeer, 0),
           BOOL_PROP(kExchangeEnableBufferCopy, true),
           BOOL_PROP(kExchangeImmediateBufferTransfer, true),
           STR_PROP(kExchangeMaxBufferSize, "32MB"),
+          STR_PROP(kExchangeHugePageArenaSize, "0B"),
+          NUM_PROP(kExchangeHttpClientPipelinedFetchWindow, 0),
+          BOOL_PROP(kExchangeAdaptiveRequestSizeEnabled, false),
+          BOOL_PROP(kExchangePageCoalescingEnabled, false),
+          BOOL_PROP(kExchangeHedgedRequestEnabled, false),
+          NUM_PROP(kExchangeHedgedRequestDelayMs, 1'000),
+          BOOL_PROP(kExchangeMemoryAdmissionEnabled, false),
+          BOOL_PROP(kExchangeRackLocalPrioritizationEnabled, false),
+          NUM_PROP(kExchangeRackIpv4PrefixBits, 24),
+          NUM_PROP(kExchangeRemoteRackDispatchDelayMs, 20),
+          BOOL_PROP(kExchangePartialPageResumeEnabled, false),
+          BOOL_PROP(kExchangeSelectiveColumnsEnabled, false),
+          NUM_PROP(kExchangeWideRowDecodePrefetchMinColumns, 0),
+          BOOL_PROP(kExchangeMaterializationEnabled, false),
+          STR_PROP(kExchangeMaterializationBasePath, ""),
           NUM_PROP(kTaskRunTimeSliceMicros, 50'000),
+          NUM_PROP(kTaskMaxQueryCpuShare, 0.0),
           BOOL_PROP(kIncludeNodeInSpillPath, false),
           NUM_PROP(kOldTaskCleanUpMs, 60'000),
           BOOL_PROP(kEnableOldTaskCleanUp, true),
@@ -283,6 +383,7 @@ SystemConfig::SystemConfig() {
           BOOL_PROP(kExchangeLazyFetchingEnabled, false),
           NUM_PROP(kRequestDataSizesMaxWaitSec, 10),
           STR_PROP(kPluginDir, ""),
+          NUM_PROP(kPluginLoadParallelism, 1),
           NUM_PROP(kExchangeIoEvbViolationThresholdMs, 1000),
           NUM_PROP(kHttpSrvIoEvbViolationThresholdMs, 1000),
           NUM_PROP(kMaxLocalExchangeBufferSize, 32UL << 20), // 32MB
@@ -294,6 +395,38 @@ SystemConfig::SystemConfig() {
           BOOL_PROP(kCharNToVarcharImplicitCast, false),
           BOOL_PROP(kEnumTypesEnabled, true),
           BOOL_PROP(kPlanConsistencyCheckEnabled, false),
+          BOOL_PROP(kPlanConversionCacheEnabled, false),
+          BOOL_PROP(kTaskFragmentInterningEnabled, false),
+          NUM_PROP(kTaskFragmentInterningTtlMs, 60'000UL),
+          BOOL_PROP(kTaskTrustedPlanEnabled, false),
+          NUM_PROP(kTaskTimeSlicedStatsWindowMs, 0UL),
+          BOOL_PROP(kQuerySessionConfigCacheEnabled, false),
+          BOOL_PROP(kTaskMemoryForecastEnabled, false),
+          BOOL_PROP(kTaskUpdateRequestSimdJsonEnabled, false),
+          BOOL_PROP(kTaskUpdateStreamingParseEnabled, false),
+          NUM_PROP(kTaskUpdateStreamingParseMinBytes, 8UL << 20),
+          NUM_PROP(kTaskUpdateInlineMaxBytes, 0UL),
+          NUM_PROP(kTaskUpdateDedupTtlMs, 0UL),
+          BOOL_PROP(kTaskThriftDirectSplitConversionEnabled, false),
+          BOOL_PROP(kTaskLptSplitOrderingEnabled, false),
+          BOOL_PROP(kBatchTaskUpdateParallelDecodeEnabled, false),
+          BOOL_PROP(kTaskResultsPrefetchEnabled, false),
+          BOOL_PROP(kTaskQueryFailureGossipEnabled, false),
+          BOOL_PROP(kTaskStatusDirectSerdeEnabled, false),
+          BOOL_PROP(kTaskStatusDeltaSerdeEnabled, true),
+          BOOL_PROP(kTaskSplitIngestionFairnessEnabled, false),
+          NUM_PROP(kTaskSplitAffinityTrackingMaxSplits, 0),
+          NUM_PROP(kTaskListSnapshotRefreshMs, 0),
+          BOOL_PROP(kTaskStreamingSplitIngestionEnabled, false),
+          NUM_PROP(kTaskStreamingSplitIngestionBatchSize, 1'000),
+          BOOL_PROP(kTaskSplitStreamEnabled, false),
+          BOOL_PROP(kTaskProtocolArenaEnabled, false),
+          BOOL_PROP(kTaskAutoTraceEnabled, false),
+          STR_PROP(kTaskAutoTraceDir, ""),
+          NUM_PROP(kTaskAutoTracePercentile, 99),
+          NUM_PROP(kTaskAutoTraceMaxPromotedSources, 4),
+          NUM_PROP(kTaskAutoTracePromotionTtlMs, 600'000),
+          NUM_PROP(kTaskAutoTraceMaxBytesPerQuery, 268'435'456),
       };
 }
 
@@ -316,6 +449,10 @@ bool SystemConfig::httpServerBindToNodeInternalAddressOnlyEnabled() const {
       .value_or(false);
 }
 
+std::string SystemConfig::httpServerUnixDomainSocketPath() const {
+  return optionalProperty(kHttpServerUnixDomainSocketPath).value();
+}
+
 int SystemConfig::httpServerHttpsPort() const {
   return requiredProperty<int>(kHttpServerHttpsPort);
 }
@@ -328,6 +465,11 @@ bool SystemConfig::httpServerHttp2Enabled() const {
   return optionalProperty<bool>(kHttpServerHttp2Enabled).value();
 }
 
+uint32_t SystemConfig::httpServerMaxConcurrentDataRequests() const {
+  return optionalProperty<uint32_t>(kHttpServerMaxConcurrentDataRequests)
+      .value();
+}
+
 uint32_t SystemConfig::httpServerIdleTimeoutMs() const {
   return optionalProperty<uint32_t>(kHttpServerIdleTimeoutMs).value();
 }
@@ -398,6 +540,10 @@ folly::Optional<std::string> SystemConfig::httpsClientCaFile() const {
   return optionalProperty(kHttpsClientCaFile);
 }
 
+bool SystemConfig::httpsKtlsEnabled() const {
+  return optionalProperty<bool>(kHttpsKtlsEnabled).value();
+}
+
 std::string SystemConfig::prestoVersion() const {
   return requiredProperty(std::string(kPrestoVersion));
 }
@@ -503,6 +649,16 @@ std::string SystemConfig::remoteFunctionServerRestURL() const {
   return optionalProperty(kRemoteFunctionServerRestURL).value();
 }
 
+uint32_t SystemConfig::remoteFunctionServerRestNumConnections() const {
+  return optionalProperty<uint32_t>(kRemoteFunctionServerRestNumConnections)
+      .value();
+}
+
+uint64_t SystemConfig::remoteFunctionServerRestMemoCacheMaxBytes() const {
+  return optionalProperty<uint64_t>(kRemoteFunctionServerRestMemoCacheMaxBytes)
+      .value();
+}
+
 int32_t SystemConfig::maxDriversPerTask() const {
   return optionalProperty<int32_t>(kMaxDriversPerTask).value();
 }
@@ -535,6 +691,11 @@ double SystemConfig::httpServerNumCpuThreadsHwMultiplier() const {
   return optionalProperty<double>(kHttpServerNumCpuThreadsHwMultiplier).value();
 }
 
+double SystemConfig::httpServerNumSerializationThreadsHwMultiplier() const {
+  return optionalProperty<double>(kHttpServerNumSerializationThreadsHwMultiplier)
+      .value();
+}
+
 double SystemConfig::exchangeHttpClientNumIoThreadsHwMultiplier() const {
   return optionalProperty<double>(kExchangeHttpClientNumIoThreadsHwMultiplier)
       .value();
@@ -557,10 +718,48 @@ double SystemConfig::driverNumCpuThreadsHwMultiplier() const {
   return optionalProperty<double>(kDriverNumCpuThreadsHwMultiplier).value();
 }
 
+bool SystemConfig::driverElasticScalingEnabled() const {
+  return optionalProperty<bool>(kDriverElasticScalingEnabled).value();
+}
+
+double SystemConfig::driverElasticScalingMaxThreadsHwMultiplier() const {
+  return optionalProperty<double>(kDriverElasticScalingMaxThreadsHwMultiplier)
+      .value();
+}
+
+size_t SystemConfig::driverElasticScalingLatencyThresholdMs() const {
+  return optionalProperty<size_t>(kDriverElasticScalingLatencyThresholdMs)
+      .value();
+}
+
 bool SystemConfig::driverThreadsBatchSchedulingEnabled() const {
   return optionalProperty<bool>(kDriverThreadsBatchSchedulingEnabled).value();
 }
 
+bool SystemConfig::driverNumaBindingEnabled() const {
+  return optionalProperty<bool>(kDriverNumaBindingEnabled).value();
+}
+
+bool SystemConfig::driverSoftAffinityEnabled() const {
+  return optionalProperty<bool>(kDriverSoftAffinityEnabled).value();
+}
+
+bool SystemConfig::crashHandoffEnabled() const {
+  return optionalProperty<bool>(kCrashHandoffEnabled).value();
+}
+
+std::string SystemConfig::crashHandoffFilePath() const {
+  return optionalProperty(kCrashHandoffFilePath).value();
+}
+
+std::string SystemConfig::crashHandoffNotifyAddress() const {
+  return optionalProperty(kCrashHandoffNotifyAddress).value();
+}
+
+std::string SystemConfig::numaBindingInterface() const {
+  return optionalProperty(kNumaBindingInterface).value();
+}
+
 size_t SystemConfig::driverStuckOperatorThresholdMs() const {
   return optionalProperty<size_t>(kDriverStuckOperatorThresholdMs).value();
 }
@@ -580,6 +779,15 @@ double SystemConfig::spillerNumCpuThreadsHwMultiplier() const {
   return optionalProperty<double>(kSpillerNumCpuThreadsHwMultiplier).value();
 }
 
+bool SystemConfig::spillerFairSchedulingEnabled() const {
+  return optionalProperty<bool>(kSpillerFairSchedulingEnabled).value();
+}
+
+uint32_t SystemConfig::spillerFairSchedulingMaxInFlightPerQuery() const {
+  return optionalProperty<uint32_t>(kSpillerFairSchedulingMaxInFlightPerQuery)
+      .value();
+}
+
 std::string SystemConfig::spillerFileCreateConfig() const {
   return optionalProperty<std::string>(kSpillerFileCreateConfig).value();
 }
@@ -620,6 +828,10 @@ bool SystemConfig::systemMemPushBackAbortEnabled() const {
   return optionalProperty<bool>(kSystemMemPushbackAbortEnabled).value();
 }
 
+double SystemConfig::systemMemPushbackArbitrationRatio() const {
+  return optionalProperty<double>(kSystemMemPushbackArbitrationRatio).value();
+}
+
 uint64_t SystemConfig::workerOverloadedThresholdMemGb() const {
   return optionalProperty<uint64_t>(kWorkerOverloadedThresholdMemGb).value();
 }
@@ -648,6 +860,11 @@ bool SystemConfig::workerOverloadedTaskQueuingEnabled() const {
   return optionalProperty<bool>(kWorkerOverloadedTaskQueuingEnabled).value();
 }
 
+bool SystemConfig::workerOverloadedTaskQueueDrainToIdleEnabled() const {
+  return optionalProperty<bool>(kWorkerOverloadedTaskQueueDrainToIdleEnabled)
+      .value();
+}
+
 bool SystemConfig::mallocMemHeapDumpEnabled() const {
   return optionalProperty<bool>(kMallocMemHeapDumpEnabled).value();
 }
@@ -680,6 +897,98 @@ uint64_t SystemConfig::localShuffleMaxPartitionBytes() const {
   return optionalProperty<uint32_t>(kLocalShuffleMaxPartitionBytes).value();
 }
 
+uint64_t SystemConfig::localShuffleMemoryTransportMaxBytes() const {
+  return optionalProperty<uint64_t>(kLocalShuffleMemoryTransportMaxBytes)
+      .value();
+}
+
+uint32_t SystemConfig::localShuffleReadPrefetchDepth() const {
+  return optionalProperty<uint32_t>(kLocalShuffleReadPrefetchDepth).value();
+}
+
+bool SystemConfig::localShuffleFileCompressionEnabled() const {
+  return optionalProperty<bool>(kLocalShuffleFileCompressionEnabled).value();
+}
+
+bool SystemConfig::localShuffleFileChecksumEnabled() const {
+  return optionalProperty<bool>(kLocalShuffleFileChecksumEnabled).value();
+}
+
+uint64_t SystemConfig::localShuffleCompactionMinFileBytes() const {
+  return optionalProperty<uint64_t>(kLocalShuffleCompactionMinFileBytes)
+      .value();
+}
+
+bool SystemConfig::localShuffleBlockHeaderEnabled() const {
+  return optionalProperty<bool>(kLocalShuffleBlockHeaderEnabled).value();
+}
+
+uint64_t SystemConfig::localShuffleDedupMaxBytes() const {
+  return optionalProperty<uint64_t>(kLocalShuffleDedupMaxBytes).value();
+}
+
+bool SystemConfig::shuffleStreamingAggregationEnabled() const {
+  return optionalProperty<bool>(kShuffleStreamingAggregationEnabled).value();
+}
+
+uint64_t SystemConfig::localDiskIoMaxBandwidthBytesPerSecond() const {
+  return optionalProperty<uint64_t>(kLocalDiskIoMaxBandwidthBytesPerSecond)
+      .value();
+}
+
+uint32_t SystemConfig::broadcastFileReaderPrefetchDepth() const {
+  return optionalProperty<uint32_t>(kBroadcastFileReaderPrefetchDepth).value();
+}
+
+uint64_t SystemConfig::broadcastFileCacheMaxBytes() const {
+  return optionalProperty<uint64_t>(kBroadcastFileCacheMaxBytes).value();
+}
+
+bool SystemConfig::broadcastFileReaderMmapEnabled() const {
+  return optionalProperty<bool>(kBroadcastFileReaderMmapEnabled).value();
+}
+
+uint64_t SystemConfig::broadcastFileWriterMaxBufferedBytes() const {
+  return optionalProperty<uint64_t>(kBroadcastFileWriterMaxBufferedBytes)
+      .value();
+}
+
+uint64_t SystemConfig::hiveFileMetadataCacheMaxBytes() const {
+  return optionalProperty<uint64_t>(kHiveFileMetadataCacheMaxBytes).value();
+}
+
+uint64_t SystemConfig::icebergDeleteFileCacheMaxBytes() const {
+  return optionalProperty<uint64_t>(kIcebergDeleteFileCacheMaxBytes).value();
+}
+
+bool SystemConfig::fragmentResultCacheEnabled() const {
+  return optionalProperty<bool>(kFragmentResultCacheEnabled).value();
+}
+
+uint64_t SystemConfig::fragmentResultCacheMaxBytes() const {
+  return optionalProperty<uint64_t>(kFragmentResultCacheMaxBytes).value();
+}
+
+uint64_t SystemConfig::fragmentResultCacheMaxEntryBytes() const {
+  return optionalProperty<uint64_t>(kFragmentResultCacheMaxEntryBytes).value();
+}
+
+uint64_t SystemConfig::fragmentResultCacheTtlMs() const {
+  return optionalProperty<uint64_t>(kFragmentResultCacheTtlMs).value();
+}
+
+std::string SystemConfig::fragmentResultCacheBaseDirectory() const {
+  return optionalProperty(kFragmentResultCacheBaseDirectory).value();
+}
+
+uint64_t SystemConfig::fragmentResultCacheMaxDiskBytes() const {
+  return optionalProperty<uint64_t>(kFragmentResultCacheMaxDiskBytes).value();
+}
+
+bool SystemConfig::fragmentResultCacheScanShareEnabled() const {
+  return optionalProperty<bool>(kFragmentResultCacheScanShareEnabled).value();
+}
+
 std::string SystemConfig::asyncCacheSsdPath() const {
   return optionalProperty(kAsyncCacheSsdPath).value();
 }
@@ -889,6 +1198,10 @@ bool SystemConfig::enableHttpAccessLog() const {
   return optionalProperty<bool>(kHttpEnableAccessLog).value();
 }
 
+uint32_t SystemConfig::httpAccessLogSampleRate() const {
+  return optionalProperty<uint32_t>(kHttpAccessLogSampleRate).value();
+}
+
 bool SystemConfig::enableHttpStatsFilter() const {
   return optionalProperty<bool>(kHttpEnableStatsFilter).value();
 }
@@ -932,10 +1245,26 @@ uint64_t SystemConfig::announcementMaxFrequencyMs() const {
   return optionalProperty<uint64_t>(kAnnouncementMaxFrequencyMs).value();
 }
 
+bool SystemConfig::announcementDeltaEnabled() const {
+  return optionalProperty<bool>(kAnnouncementDeltaEnabled).value();
+}
+
+bool SystemConfig::startupParallelRegistrationEnabled() const {
+  return optionalProperty<bool>(kStartupParallelRegistrationEnabled).value();
+}
+
 uint64_t SystemConfig::heartbeatFrequencyMs() const {
   return optionalProperty<uint64_t>(kHeartbeatFrequencyMs).value();
 }
 
+bool SystemConfig::heartbeatStatsDeltaEnabled() const {
+  return optionalProperty<bool>(kHeartbeatStatsDeltaEnabled).value();
+}
+
+uint64_t SystemConfig::heartbeatStatsMaxAgeMs() const {
+  return optionalProperty<uint64_t>(kHeartbeatStatsMaxAgeMs).value();
+}
+
 bool SystemConfig::httpClientHttp2Enabled() const {
   return optionalProperty<bool>(kHttpClientHttp2Enabled).value();
 }
@@ -968,6 +1297,20 @@ std::chrono::duration<double> SystemConfig::exchangeMaxErrorDuration() const {
       optionalProperty(kExchangeMaxErrorDuration).value());
 }
 
+uint64_t SystemConfig::exchangeTraceSampleEveryN() const {
+  return optionalProperty<uint64_t>(kExchangeTraceSampleEveryN).value();
+}
+
+bool SystemConfig::exchangeZstdDictionaryCompressionEnabled() const {
+  return optionalProperty<bool>(kExchangeZstdDictionaryCompressionEnabled)
+      .value();
+}
+
+uint32_t SystemConfig::exchangeZstdDictionaryTrainingPages() const {
+  return optionalProperty<uint32_t>(kExchangeZstdDictionaryTrainingPages)
+      .value();
+}
+
 std::chrono::duration<double> SystemConfig::exchangeRequestTimeoutMs() const {
   return velox::config::toDuration(
       optionalProperty(kExchangeRequestTimeout).value());
@@ -982,6 +1325,11 @@ bool SystemConfig::exchangeEnableConnectionPool() const {
   return optionalProperty<bool>(kExchangeEnableConnectionPool).value();
 }
 
+uint32_t SystemConfig::exchangeConnectionPoolWarmupPerPeer() const {
+  return optionalProperty<uint32_t>(kExchangeConnectionPoolWarmupPerPeer)
+      .value();
+}
+
 bool SystemConfig::exchangeEnableBufferCopy() const {
   return optionalProperty<bool>(kExchangeEnableBufferCopy).value();
 }
@@ -996,10 +1344,86 @@ uint64_t SystemConfig::exchangeMaxBufferSize() const {
       velox::config::CapacityUnit::BYTE);
 }
 
+uint64_t SystemConfig::exchangeHugePageArenaBytes() const {
+  return velox::config::toCapacity(
+      optionalProperty(kExchangeHugePageArenaSize).value(),
+      velox::config::CapacityUnit::BYTE);
+}
+
+uint32_t SystemConfig::exchangeHttpClientPipelinedFetchWindow() const {
+  return exchangePipelinedFetchWindowCache_.get(
+      *this, kExchangeHttpClientPipelinedFetchWindow);
+}
+
+bool SystemConfig::exchangeAdaptiveRequestSizeEnabled() const {
+  return exchangeAdaptiveRequestSizeEnabledCache_.get(
+      *this, kExchangeAdaptiveRequestSizeEnabled);
+}
+
+bool SystemConfig::exchangePageCoalescingEnabled() const {
+  return exchangePageCoalescingEnabledCache_.get(
+      *this, kExchangePageCoalescingEnabled);
+}
+
+bool SystemConfig::exchangeHedgedRequestEnabled() const {
+  return exchangeHedgedRequestEnabledCache_.get(
+      *this, kExchangeHedgedRequestEnabled);
+}
+
+int64_t SystemConfig::exchangeHedgedRequestDelayMs() const {
+  return exchangeHedgedRequestDelayMsCache_.get(
+      *this, kExchangeHedgedRequestDelayMs);
+}
+
+bool SystemConfig::exchangeMemoryAdmissionEnabled() const {
+  return exchangeMemoryAdmissionEnabledCache_.get(
+      *this, kExchangeMemoryAdmissionEnabled);
+}
+
+bool SystemConfig::exchangeRackLocalPrioritizationEnabled() const {
+  return exchangeRackLocalPrioritizationEnabledCache_.get(
+      *this, kExchangeRackLocalPrioritizationEnabled);
+}
+
+uint32_t SystemConfig::exchangeRackIpv4PrefixBits() const {
+  return exchangeRackIpv4PrefixBitsCache_.get(
+      *this, kExchangeRackIpv4PrefixBits);
+}
+
+int64_t SystemConfig::exchangeRemoteRackDispatchDelayMs() const {
+  return exchangeRemoteRackDispatchDelayMsCache_.get(
+      *this, kExchangeRemoteRackDispatchDelayMs);
+}
+
+bool SystemConfig::exchangePartialPageResumeEnabled() const {
+  return optionalProperty<bool>(kExchangePartialPageResumeEnabled).value();
+}
+
+bool SystemConfig::exchangeSelectiveColumnsEnabled() const {
+  return optionalProperty<bool>(kExchangeSelectiveColumnsEnabled).value();
+}
+
+uint32_t SystemConfig::exchangeWideRowDecodePrefetchMinColumns() const {
+  return optionalProperty<uint32_t>(kExchangeWideRowDecodePrefetchMinColumns)
+      .value();
+}
+
+bool SystemConfig::exchangeMaterializationEnabled() const {
+  return optionalProperty<bool>(kExchangeMaterializationEnabled).value();
+}
+
+std::string SystemConfig::exchangeMaterializationBasePath() const {
+  return optionalProperty(kExchangeMaterializationBasePath).value();
+}
+
 int32_t SystemConfig::taskRunTimeSliceMicros() const {
   return optionalProperty<int32_t>(kTaskRunTimeSliceMicros).value();
 }
 
+double SystemConfig::taskMaxQueryCpuShare() const {
+  return optionalProperty<double>(kTaskMaxQueryCpuShare).value();
+}
+
 bool SystemConfig::includeNodeInSpillPath() const {
   return optionalProperty<bool>(kIncludeNodeInSpillPath).value();
 }
@@ -1061,6 +1485,10 @@ std::string SystemConfig::pluginDir() const {
   return optionalProperty(kPluginDir).value();
 }
 
+int32_t SystemConfig::pluginLoadParallelism() const {
+  return optionalProperty<int32_t>(kPluginLoadParallelism).value();
+}
+
 int32_t SystemConfig::exchangeIoEvbViolationThresholdMs() const {
   return optionalProperty<int32_t>(kExchangeIoEvbViolationThresholdMs).value();
 }
@@ -1107,6 +1535,165 @@ bool SystemConfig::planConsistencyCheckEnabled() const {
   return optionalProperty<bool>(kPlanConsistencyCheckEnabled).value();
 }
 
+bool SystemConfig::planConversionCacheEnabled() const {
+  return optionalProperty<bool>(kPlanConversionCacheEnabled).value();
+}
+
+bool SystemConfig::taskFragmentInterningEnabled() const {
+  return optionalProperty<bool>(kTaskFragmentInterningEnabled).value();
+}
+
+uint64_t SystemConfig::taskFragmentInterningTtlMs() const {
+  return optionalProperty<uint64_t>(kTaskFragmentInterningTtlMs).value();
+}
+
+bool SystemConfig::taskTrustedPlanEnabled() const {
+  return optionalProperty<bool>(kTaskTrustedPlanEnabled).value();
+}
+
+uint64_t SystemConfig::taskTimeSlicedStatsWindowMs() const {
+  return optionalProperty<uint64_t>(kTaskTimeSlicedStatsWindowMs).value();
+}
+
+bool SystemConfig::querySessionConfigCacheEnabled() const {
+  return optionalProperty<bool>(kQuerySessionConfigCacheEnabled).value();
+}
+
+bool SystemConfig::taskMemoryForecastEnabled() const {
+  return optionalProperty<bool>(kTaskMemoryForecastEnabled).value();
+}
+
+bool SystemConfig::taskUpdateRequestSimdJsonEnabled() const {
+  return optionalProperty<bool>(kTaskUpdateRequestSimdJsonEnabled).value();
+}
+
+bool SystemConfig::taskUpdateStreamingParseEnabled() const {
+  return taskUpdateStreamingParseEnabledCache_.get(
+      *this, kTaskUpdateStreamingParseEnabled);
+}
+
+uint64_t SystemConfig::taskUpdateStreamingParseMinBytes() const {
+  return taskUpdateStreamingParseMinBytesCache_.get(
+      *this, kTaskUpdateStreamingParseMinBytes);
+}
+
+uint64_t SystemConfig::taskUpdateInlineMaxBytes() const {
+  return taskUpdateInlineMaxBytesCache_.get(*this, kTaskUpdateInlineMaxBytes);
+}
+
+uint64_t SystemConfig::taskUpdateDedupTtlMs() const {
+  return optionalProperty<uint64_t>(kTaskUpdateDedupTtlMs).value();
+}
+
+bool SystemConfig::taskThriftDirectSplitConversionEnabled() const {
+  return optionalProperty<bool>(kTaskThriftDirectSplitConversionEnabled)
+      .value();
+}
+
+bool SystemConfig::taskLptSplitOrderingEnabled() const {
+  return optionalProperty<bool>(kTaskLptSplitOrderingEnabled).value();
+}
+
+bool SystemConfig::batchTaskUpdateParallelDecodeEnabled() const {
+  return optionalProperty<bool>(kBatchTaskUpdateParallelDecodeEnabled).value();
+}
+
+bool SystemConfig::taskResultsPrefetchEnabled() const {
+  return taskResultsPrefetchEnabledCache_.get(
+      *this, kTaskResultsPrefetchEnabled);
+}
+
+bool SystemConfig::taskQueryFailureGossipEnabled() const {
+  return optionalProperty<bool>(kTaskQueryFailureGossipEnabled).value();
+}
+
+bool SystemConfig::taskStatusDirectSerdeEnabled() const {
+  return optionalProperty<bool>(kTaskStatusDirectSerdeEnabled).value();
+}
+
+bool SystemConfig::taskStatusDeltaSerdeEnabled() const {
+  return optionalProperty<bool>(kTaskStatusDeltaSerdeEnabled).value();
+}
+
+bool SystemConfig::taskSplitIngestionFairnessEnabled() const {
+  return optionalProperty<bool>(kTaskSplitIngestionFairnessEnabled).value();
+}
+
+uint64_t SystemConfig::taskSplitAffinityTrackingMaxSplits() const {
+  return optionalProperty<uint64_t>(kTaskSplitAffinityTrackingMaxSplits)
+      .value();
+}
+
+uint32_t SystemConfig::taskListSnapshotRefreshMs() const {
+  return optionalProperty<uint32_t>(kTaskListSnapshotRefreshMs).value();
+}
+
+bool SystemConfig::streamingSplitIngestionEnabled() const {
+  return optionalProperty<bool>(kTaskStreamingSplitIngestionEnabled).value();
+}
+
+int32_t SystemConfig::streamingSplitIngestionBatchSize() const {
+  return optionalProperty<int32_t>(kTaskStreamingSplitIngestionBatchSize)
+      .value();
+}
+
+bool SystemConfig::taskSplitStreamEnabled() const {
+  return optionalProperty<bool>(kTaskSplitStreamEnabled).value();
+}
+
+bool SystemConfig::taskProtocolArenaEnabled() const {
+  return optionalProperty<bool>(kTaskProtocolArenaEnabled).value();
+}
+
+bool SystemConfig::taskAutoTraceEnabled() const {
+  return optionalProperty<bool>(kTaskAutoTraceEnabled).value();
+}
+
+std::string SystemConfig::taskAutoTraceDir() const {
+  return optionalProperty(kTaskAutoTraceDir).value();
+}
+
+int32_t SystemConfig::taskAutoTracePercentile() const {
+  return optionalProperty<int32_t>(kTaskAutoTracePercentile).value();
+}
+
+int32_t SystemConfig::taskAutoTraceMaxPromotedSources() const {
+  return optionalProperty<int32_t>(kTaskAutoTraceMaxPromotedSources).value();
+}
+
+uint64_t SystemConfig::taskAutoTracePromotionTtlMs() const {
+  return optionalProperty<uint64_t>(kTaskAutoTracePromotionTtlMs).value();
+}
+
+uint64_t SystemConfig::taskAutoTraceMaxBytesPerQuery() const {
+  return optionalProperty<uint64_t>(kTaskAutoTraceMaxBytesPerQuery).value();
+}
+
+// static
+const std::unordered_set<std::string>& SystemConfig::dynamicProperties() {
+  static const std::unordered_set<std::string> kDynamicProperties{
+      std::string(kExchangeHttpClientPipelinedFetchWindow),
+      std::string(kExchangeAdaptiveRequestSizeEnabled),
+      std::string(kExchangePageCoalescingEnabled),
+      std::string(kExchangeHedgedRequestEnabled),
+      std::string(kExchangeHedgedRequestDelayMs),
+      std::string(kExchangeMemoryAdmissionEnabled),
+      std::string(kExchangeRackLocalPrioritizationEnabled),
+      std::string(kExchangeRackIpv4PrefixBits),
+      std::string(kExchangeRemoteRackDispatchDelayMs),
+      std::string(kExchangeMaxErrorDuration),
+      std::string(kTaskResultsPrefetchEnabled),
+      std::string(kTaskUpdateStreamingParseEnabled),
+      std::string(kTaskUpdateStreamingParseMinBytes),
+      std::string(kTaskUpdateInlineMaxBytes),
+      std::string(kSystemMemLimitGb),
+      std::string(kSystemMemShrinkGb),
+      std::string(kWorkerOverloadedThresholdMemGb),
+      std::string(kWorkerOverloadedThresholdCpuPct),
+  };
+  return kDynamicProperties;
+}
+
 NodeConfig::NodeConfig() {
   registeredProps_ =
       std::unordered_map<std::string, folly::Optional<std::string>>{
@@ -1115,7 +1702,6 @@ NodeConfig::NodeConfig() {
           NONE_PROP(kNodeIp),
           NONE_PROP(kNodeInternalAddress),
           NONE_PROP(kNodeLocation),
-          NONE_PROP(kNodePrometheusExecutorThreads),
       };
 }
 
@@ -1128,15 +1714,6 @@ std::string NodeConfig::nodeEnvironment() const {
   return requiredProperty(kNodeEnvironment);
 }
 
-int NodeConfig::prometheusExecutorThreads() const {
-  static constexpr int kNodePrometheusExecutorThreadsDefault = 2;
-  auto resultOpt = optionalProperty<int>(kNodePrometheusExecutorThreads);
-  if (resultOpt.has_value()) {
-    return resultOpt.value();
-  }
-  return kNodePrometheusExecutorThreadsDefault;
-}
-
 std::string NodeConfig::nodeId() const {
   auto resultOpt = optionalProperty(kNodeId);
   if (resultOpt.has_value()) {
@@ -14,13 +14,50 @@
 #pragma once
 
 #include <folly/SocketAddress.h>
+#include <atomic>
+#include <limits>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include "velox/common/config/Config.h"
 
 namespace facebook::presto {
 
+/// Caches the parsed value of a runtime-tunable ("dynamic") config property
+/// and re-parses it only when the owning config's generation changes, i.e.
+/// after a setProperty or reloadProperties server operation. Steady-state
+/// reads are two atomic loads - no lock and no string parsing - so hot
+/// paths can consult a tunable on every request. 'T' must fit in a
+/// lock-free std::atomic.
+template <typename T>
+class DynamicProperty {
+ public:
+  template <typename Config>
+  T get(const Config& config, std::string_view propertyName) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto generation = config.generation();
+    if (generation_.load(std::memory_order_acquire) == generation) {
+      return value_.load(std::memory_order_relaxed);
+    }
+    // A concurrent update between the generation load and the parse at most
+    // stamps the newer value with the older generation; the next read
+    // re-parses.
+    const T value =
+        config.template optionalProperty<T>(propertyName).value();
+    value_.store(value, std::memory_order_relaxed);
+    generation_.store(generation, std::memory_order_release);
+    return value;
+  }
+
+ private:
+  // Generation the cached value was parsed at. Starts above any reachable
+  // generation so the first read parses.
+  std::atomic<uint64_t> generation_{std::numeric_limits<uint64_t>::max()};
+  std::atomic<T> value_{};
+};
+
 class ConfigBase {
  public:
   /// Setting this to 'true' makes configs modifiable via server operations.
@@ -40,6 +77,8 @@ class ConfigBase {
   /// Uses a config object already materialized.
   void initialize(std::unique_ptr<velox::config::ConfigBase>&& config) {
     config_ = std::move(config);
+    // Invalidate any DynamicProperty caches from a previous initialization.
+    generation_.fetch_add(1, std::memory_order_release);
   }
 
   /// DO NOT DELETE THIS METHOD!
@@ -57,6 +96,21 @@ class ConfigBase {
       const std::string& propertyName,
       const std::string& value);
 
+  /// Re-reads the config file this config was initialized from and applies
+  /// changed values of the properties in 'dynamicProperties'; all other
+  /// (startup-frozen) properties are left untouched and changes to them are
+  /// reported as skipped. Requires 'mutable-config' to be set. Returns a
+  /// human-readable summary of what was applied.
+  std::string reloadDynamicProperties(
+      const std::unordered_set<std::string>& dynamicProperties);
+
+  /// Generation counter bumped on every runtime property update. Consulted
+  /// by DynamicProperty caches to decide whether their parsed value is
+  /// still current.
+  uint64_t generation() const {
+    return generation_.load(std::memory_order_acquire);
+  }
+
   /// Returns a required value of the requested type. Fails if no value found.
   template <typename T>
   T requiredProperty(const std::string& propertyName) const {
@@ -150,6 +204,8 @@ class ConfigBase {
 
   std::unique_ptr<velox::config::ConfigBase> config_;
   std::string filePath_;
+  // Bumped on every runtime property update; see generation().
+  std::atomic<uint64_t> generation_{0};
   // Map of registered properties with their default values.
   std::unordered_map<std::string, folly::Optional<std::string>>
       registeredProps_;
@@ -174,6 +230,15 @@ class SystemConfig : public ConfigBase {
   static constexpr std::string_view
       kHttpServerBindToNodeInternalAddressOnlyEnabled{
           "http-server.bind-to-node-internal-address-only-enabled"};
+  /// Filesystem path of an additional unix domain socket the HTTP server
+  /// listens on. Empty (default) disables the listener. Only same-host
+  /// processes that can reach the socket file can connect, so internal
+  /// authentication skips per-request token verification for requests
+  /// arriving on it and same-host exchange fetches prefer it over the
+  /// loopback TCP path; the path should live in a directory only the Presto
+  /// user can access.
+  static constexpr std::string_view kHttpServerUnixDomainSocketPath{
+      "http-server.unix-domain-socket-path"};
   static constexpr std::string_view kDiscoveryUri{"discovery.uri"};
   static constexpr std::string_view kMaxDriversPerTask{
       "task.max-drivers-per-task"};
@@ -203,12 +268,28 @@ class SystemConfig : public ConfigBase {
   static constexpr std::string_view kHttpServerNumCpuThreadsHwMultiplier{
       "http-server.num-cpu-threads-hw-multiplier"};
 
+  /// Floating point number used in calculating how many threads we would use
+  /// for the HTTP response serialization executor: hw_concurrency x
+  /// multiplier. When greater than zero, JSON encoding of large TaskInfo
+  /// responses is offloaded to this executor so a few tasks with big stats
+  /// trees cannot starve status polls on the HTTP CPU executor. 0.0
+  /// (default) disables the executor and responses are encoded in place.
+  static constexpr std::string_view
+      kHttpServerNumSerializationThreadsHwMultiplier{
+          "http-server.num-serialization-threads-hw-multiplier"};
+
   static constexpr std::string_view kHttpServerHttpsPort{
       "http-server.https.port"};
   static constexpr std::string_view kHttpServerHttpsEnabled{
       "http-server.https.enabled"};
   static constexpr std::string_view kHttpServerHttp2Enabled{
       "http-server.http2.enabled"};
+  /// The maximum number of concurrently served data fetch (getResults)
+  /// requests. Requests over the limit are rejected with 503 so that a
+  /// getResults storm cannot starve task updates or health checks. 0 (the
+  /// default) disables the limit.
+  static constexpr std::string_view kHttpServerMaxConcurrentDataRequests{
+      "http-server.max-concurrent-data-requests"};
   /// HTTP/2 server idle timeout in milliseconds (default 60000ms).
   static constexpr std::string_view kHttpServerIdleTimeoutMs{
       "http-server.http2.idle-timeout-ms"};
@@ -255,6 +336,11 @@ class SystemConfig : public ConfigBase {
       "https-client-cert-key-path"};
   /// Path to client CA file for SSL client certificate verification.
   static constexpr std::string_view kHttpsClientCaFile{"https-client-ca-file"};
+  /// If true, requests kernel TLS offload for internal TLS connections so
+  /// record encryption runs in-kernel after the handshake. Requires an
+  /// OpenSSL build with kTLS support and the kernel tls module; silently
+  /// falls back to userspace TLS when either is missing.
+  static constexpr std::string_view kHttpsKtlsEnabled{"https-ktls-enabled"};
 
   /// Floating point number used in calculating how many threads we would use
   /// for CPU executor for connectors mainly for async operators:
@@ -282,11 +368,76 @@ class SystemConfig : public ConfigBase {
   static constexpr std::string_view kDriverNumCpuThreadsHwMultiplier{
       "driver.num-cpu-threads-hw-multiplier"};
 
+  /// Periodically resize the driver CPU executor based on its queueing
+  /// latency. The thread count configured by
+  /// 'driver.num-cpu-threads-hw-multiplier' is the lower bound; the executor
+  /// grows toward 'driver.elastic-scaling-max-threads-hw-multiplier' while
+  /// tasks queue longer than the latency threshold and shrinks back when the
+  /// queue drains. Useful for workloads that alternate between CPU-saturated
+  /// and IO-blocked phases, where a fixed thread count is wrong for both.
+  static constexpr std::string_view kDriverElasticScalingEnabled{
+      "driver.elastic-scaling-enabled"};
+
+  /// Floating point number used in calculating the upper bound of driver
+  /// threads when elastic scaling is enabled: hw_concurrency x multiplier.
+  /// 8.0 is default.
+  static constexpr std::string_view kDriverElasticScalingMaxThreadsHwMultiplier{
+      "driver.elastic-scaling-max-threads-hw-multiplier"};
+
+  /// Driver executor queueing latency above which elastic scaling grows the
+  /// executor. Scaling down requires the latency to drop well below this
+  /// threshold, so the two decisions do not flip-flop around one boundary.
+  /// 50ms is default.
+  static constexpr std::string_view kDriverElasticScalingLatencyThresholdMs{
+      "driver.elastic-scaling-latency-threshold-ms"};
+
   /// Run driver threads with the SCHED_BATCH scheduling policy. Linux only.
   /// https://man7.org/linux/man-pages/man7/sched.7.html
   static constexpr std::string_view kDriverThreadsBatchSchedulingEnabled{
       "driver.threads-batch-scheduling-enabled"};
 
+  /// Partition driver threads across the NUMA nodes of the host: each thread
+  /// is restricted to one node's CPUs and prefers allocating memory from that
+  /// node, which avoids cross-node memory traffic on multi-socket workers.
+  /// Linux only; no effect on single-node hosts.
+  static constexpr std::string_view kDriverNumaBindingEnabled{
+      "driver.numa-binding-enabled"};
+
+  /// Run drivers on a sharded executor with soft thread affinity: work is
+  /// hashed to a preferred driver thread by submitter and spills over to the
+  /// least loaded thread only when the preferred one is saturated, so a
+  /// driver's stats lines tend to stay in one core's cache instead of
+  /// bouncing. Mutually exclusive with driver elastic scaling, which needs
+  /// the single shared-queue executor it can resize.
+  static constexpr std::string_view kDriverSoftAffinityEnabled{
+      "driver.soft-affinity-enabled"};
+
+  /// Network interface whose NUMA node the HTTP and exchange IO threads are
+  /// pinned to, e.g. "eth0". Empty (the default) leaves IO threads unpinned.
+  /// Linux only; ignored when the interface's node cannot be determined.
+  static constexpr std::string_view kNumaBindingInterface{
+      "numa-binding-interface"};
+
+  /// If true, fatal signals (segfault, abort) additionally dump the live
+  /// task ids and output buffer tokens to 'crash-handoff.file-path' and send
+  /// a best-effort UDP death notice to 'crash-handoff.notify-address', so
+  /// the coordinator learns of the death immediately instead of through
+  /// polling timeouts. The dump and notice are built from a periodically
+  /// refreshed snapshot; the signal handler itself only performs
+  /// async-signal-safe work.
+  static constexpr std::string_view kCrashHandoffEnabled{
+      "crash-handoff.enabled"};
+
+  /// Local file the crash handler writes the task snapshot to. Empty (the
+  /// default) skips the dump.
+  static constexpr std::string_view kCrashHandoffFilePath{
+      "crash-handoff.file-path"};
+
+  /// "host:port" UDP destination of the crash death notice, typically the
+  /// coordinator. Empty (the default) skips the notice.
+  static constexpr std::string_view kCrashHandoffNotifyAddress{
+      "crash-handoff.notify-address"};
+
   /// Time duration threshold used to detect if an operator call in driver is
   /// stuck or not.  If any of the driver thread is detected as stuck by this
   /// standard, we take the worker offline and further investigation on the
@@ -314,6 +465,19 @@ class SystemConfig : public ConfigBase {
   /// 1.0 is default.
   static constexpr std::string_view kSpillerNumCpuThreadsHwMultiplier{
       "spiller.num-cpu-threads-hw-multiplier"};
+
+  /// If true, spill work reaches the shared spiller executor through a fair
+  /// per-query scheduler: queued spill tasks are released to the pool
+  /// round-robin across queries with a per-query in-flight cap, so one
+  /// massive spill cannot occupy every spill thread while other queries'
+  /// arbitration-triggered spills starve behind it.
+  static constexpr std::string_view kSpillerFairSchedulingEnabled{
+      "spiller.fair-scheduling-enabled"};
+
+  /// Most spill tasks of one query allowed on the spiller executor at once
+  /// under fair scheduling. 0 picks half of the spill threads, at least one.
+  static constexpr std::string_view kSpillerFairSchedulingMaxInFlightPerQuery{
+      "spiller.fair-scheduling-max-in-flight-per-query"};
   /// Config used to create spill files. This config is provided to underlying
   /// file system and the config is free form. The form should be defined by the
   /// underlying file system.
@@ -352,6 +516,13 @@ class SystemConfig : public ConfigBase {
   /// 'system-mem-pushback-enabled' is set.
   static constexpr std::string_view kSystemMemPushbackAbortEnabled{
       "system-mem-pushback-abort-enabled"};
+  /// Fraction of 'system-mem-limit-gb' above which the periodic memory
+  /// checker triggers velox memory arbitration (spill enabled, aborts
+  /// disabled) to reclaim memory gradually before the hard limit pushback. A
+  /// value of zero disables the early arbitration step. This only applies if
+  /// 'system-mem-pushback-enabled' is true.
+  static constexpr std::string_view kSystemMemPushbackArbitrationRatio{
+      "system-mem-pushback-arbitration-ratio"};
 
   /// Memory threshold in GB above which the worker is considered overloaded.
   /// Ignored if zero. Default is zero.
@@ -381,6 +552,12 @@ class SystemConfig : public ConfigBase {
   /// starts them gradually when it stops being overloaded.
   static constexpr std::string_view kWorkerOverloadedTaskQueuingEnabled{
       "worker-overloaded-task-queuing-enabled"};
+  /// If true, when the worker stops being overloaded, queued tasks from
+  /// multiple queries are started at once, up to the number of idle driver
+  /// threads, instead of one query at a time. Only applies if
+  /// 'worker-overloaded-task-queuing-enabled' is true.
+  static constexpr std::string_view kWorkerOverloadedTaskQueueDrainToIdleEnabled{
+      "worker-overloaded-task-queue-drain-to-idle-enabled"};
 
   /// If true, memory allocated via malloc is periodically checked and a heap
   /// profile is dumped if usage exceeds 'malloc-heap-dump-gb-threshold'.
@@ -640,9 +817,188 @@ class SystemConfig : public ConfigBase {
       "enable_velox_expression_logging"};
   static constexpr std::string_view kLocalShuffleMaxPartitionBytes{
       "shuffle.local.max-partition-bytes"};
+
+  /// Byte budget for staging completed local shuffle blocks in process memory
+  /// so co-located reader tasks can consume them without the write-to-disk and
+  /// read-back round trip. Blocks that do not fit in the budget are written to
+  /// shuffle files as usual. Zero disables the in-memory transport.
+  static constexpr std::string_view kLocalShuffleMemoryTransportMaxBytes{
+      "shuffle.local.memory-transport-max-bytes"};
+
+  /// Number of local shuffle files the reader loads ahead of the consumer on
+  /// the prefetch executor so file reads overlap with compute instead of
+  /// blocking driver threads. Zero reads synchronously on the caller thread.
+  /// For sorted shuffle this is instead the number of chunk reads each merged
+  /// file stream keeps in flight ahead of the k-way merge.
+  static constexpr std::string_view kLocalShuffleReadPrefetchDepth{
+      "shuffle.local.read-prefetch-depth"};
+
+  /// If true, local shuffle blocks are LZ4-compressed before they are written
+  /// to shuffle files and decompressed transparently on read, trading a little
+  /// CPU for disk bytes and bandwidth on shuffle-heavy stages. Only applies to
+  /// unsorted shuffle; sorted shuffle files are streamed by the merge reader
+  /// and stay uncompressed.
+  static constexpr std::string_view kLocalShuffleFileCompressionEnabled{
+      "shuffle.local.file-compression-enabled"};
+
+  /// If true, the local shuffle writer appends a CRC32C checksum to each
+  /// unsorted shuffle file and readers verify it before decoding, so silent
+  /// on-disk corruption fails the read instead of surfacing as decode errors
+  /// downstream. CRC32C uses the hardware CRC instruction where available,
+  /// which keeps verification cheap enough to leave on. Only applies to
+  /// unsorted shuffle; sorted shuffle files are streamed row by row by the
+  /// merge reader and are not checksummed.
+  static constexpr std::string_view kLocalShuffleFileChecksumEnabled{
+      "shuffle.local.file-checksum-enabled"};
+
+  /// Local shuffle files smaller than this are merged in the background into
+  /// larger sequential files while the writer keeps producing, so readers
+  /// open a few large files instead of hundreds of small ones. Small files
+  /// pile up when memory pressure flushes partition buffers early. Merge jobs
+  /// run on the spiller executor and their I/O goes through the
+  /// LocalDiskIoScheduler. Zero (the default) disables compaction; compressed
+  /// shuffle files are never compacted.
+  static constexpr std::string_view kLocalShuffleCompactionMinFileBytes{
+      "shuffle.local.compaction-min-file-bytes"};
+
+  /// If true, every block the local shuffle writer stores in a file is
+  /// preceded by a self-describing header carrying the block's row count,
+  /// payload size and, for sorted shuffle, the minimum and maximum partition
+  /// sort key in the block. Readers use the headers to serve large merged
+  /// files block by block instead of whole-file, and to skip sorted blocks
+  /// whose key range cannot match a reader-side key range filter. Framing is
+  /// dropped when whole-file compression is on, since compression hides the
+  /// block boundaries.
+  static constexpr std::string_view kLocalShuffleBlockHeaderEnabled{
+      "shuffle.local.block-header-enabled"};
+
+  /// Byte budget for the worker-local chunk store that deduplicates unsorted
+  /// local shuffle file contents. Blocks are split into content-defined
+  /// chunks; a chunk whose bytes the store already holds for the same query
+  /// is written as an 8-byte reference instead of its payload, so repetitive
+  /// blocks store once. Readers resolve references from the store, so this
+  /// only applies when writer and reader tasks share the process, like the
+  /// in-memory transport. Chunks that do not fit in the budget are written
+  /// inline, so dedup degrades to plain files under pressure. Zero disables
+  /// dedup; compressed shuffle files are never deduplicated since their
+  /// bytes do not repeat.
+  static constexpr std::string_view kLocalShuffleDedupMaxBytes{
+      "shuffle.local.dedup-max-bytes"};
+
+  /// If true, a batch query aggregation planned directly above a shuffle
+  /// read whose remote source carries an ordering scheme covering all the
+  /// grouping keys treats those keys as pre-grouped. Sorted shuffle merges
+  /// producer runs on read, so each partition arrives as one ordered run and
+  /// groups are contiguous; velox then streams finished groups out as the
+  /// key changes instead of building a hash table over the whole input.
+  static constexpr std::string_view kShuffleStreamingAggregationEnabled{
+      "shuffle.streaming-aggregation-enabled"};
+
+  /// Aggregate local disk bandwidth in bytes per second that the
+  /// LocalDiskIoScheduler divides between spill, shuffle and broadcast I/O by
+  /// class weight, so concurrent spill and shuffle traffic do not thrash the
+  /// same drives. Zero disables throttling; per-class byte counters are
+  /// reported either way.
+  static constexpr std::string_view kLocalDiskIoMaxBandwidthBytesPerSecond{
+      "local-disk.io-max-bandwidth-bytes-per-second"};
+
+  /// Number of broadcast file pages the reader loads ahead of the consumer on
+  /// the prefetch executor. Zero reads synchronously on the caller thread.
+  static constexpr std::string_view kBroadcastFileReaderPrefetchDepth{
+      "broadcast.file-reader-prefetch-depth"};
+
+  /// Byte budget for the worker-level broadcast page cache that lets the many
+  /// consumer tasks of a broadcast join share one read of each broadcast file
+  /// instead of re-reading it per task. Least recently used files are evicted
+  /// when the budget is exceeded. Zero disables the cache.
+  static constexpr std::string_view kBroadcastFileCacheMaxBytes{
+      "broadcast.file-cache-max-bytes"};
+
+  /// When enabled, broadcast files on the local filesystem are memory mapped
+  /// read-only and pages are served as views over the mapping instead of
+  /// being copied into per-reader buffers, so all consumer tasks of a
+  /// broadcast file share the single OS page cache copy. Readers fall back to
+  /// buffered reads for files that cannot be mapped.
+  static constexpr std::string_view kBroadcastFileReaderMmapEnabled{
+      "broadcast.file-reader-mmap-enabled"};
+
+  /// Byte budget of input batches a broadcast write operator may hold in its
+  /// background write pipeline. When non-zero, serialization, compression and
+  /// file writes run on a background thread, overlapping with the driver
+  /// producing the next batch; the driver blocks while more than this many
+  /// bytes are in flight. Zero writes synchronously on the driver thread.
+  static constexpr std::string_view kBroadcastFileWriterMaxBufferedBytes{
+      "broadcast.file-writer-max-buffered-bytes"};
+
+  /// Byte budget for the worker-level Hive file metadata cache that shares
+  /// each file's decoded metadata across the splits of concurrent tasks
+  /// instead of decoding it per split. Entries are keyed by file path and
+  /// validated against the file's modification time; least recently used
+  /// entries are evicted when the budget is exceeded. Zero disables the
+  /// cache.
+  static constexpr std::string_view kHiveFileMetadataCacheMaxBytes{
+      "hive.file-metadata-cache-max-bytes"};
+
+  /// Byte budget for the worker-level cache of converted Iceberg delete file
+  /// descriptors. On merge-on-read tables many data splits reference the
+  /// same positional/equality delete files, and each split used to rebuild
+  /// the same descriptor from the protocol structs. Entries are keyed by
+  /// delete file path and validated against the file's record count and
+  /// size, so a rewritten file is converted afresh; least recently used
+  /// entries are evicted when the budget is exceeded. Zero disables the
+  /// cache.
+  static constexpr std::string_view kIcebergDeleteFileCacheMaxBytes{
+      "iceberg.delete-file-cache-max-bytes"};
+
+  /// If true, the worker caches the final output pages of self-contained,
+  /// single-destination plan fragments and serves byte-identical re-executions
+  /// (same fragment, same splits, same result-relevant session settings)
+  /// straight from the cache without running the fragment again. Meant for
+  /// dashboard tiers that re-issue the same deterministic subqueries every
+  /// refresh interval; the cache cannot detect nondeterminism or data
+  /// changes beyond the TTL, so it must only be enabled for such workloads.
+  static constexpr std::string_view kFragmentResultCacheEnabled{
+      "fragment-result-cache.enabled"};
+  /// Byte budget of the fragment result cache's in-memory tier. Least
+  /// recently used entries are evicted when the budget is exceeded.
+  static constexpr std::string_view kFragmentResultCacheMaxBytes{
+      "fragment-result-cache.max-bytes"};
+  /// Per-entry byte limit of the fragment result cache. Fragments whose
+  /// output exceeds it are not captured.
+  static constexpr std::string_view kFragmentResultCacheMaxEntryBytes{
+      "fragment-result-cache.max-entry-bytes"};
+  /// Time-to-live of fragment result cache entries in milliseconds; expired
+  /// entries are dropped on lookup. Zero keeps entries until evicted.
+  static constexpr std::string_view kFragmentResultCacheTtlMs{
+      "fragment-result-cache.ttl-ms"};
+  /// Directory for the fragment result cache's disk tier. Entries evicted
+  /// from the memory tier spill here and survive worker restarts. Empty (the
+  /// default) disables the disk tier.
+  static constexpr std::string_view kFragmentResultCacheBaseDirectory{
+      "fragment-result-cache.base-directory"};
+  /// Byte budget of the fragment result cache's disk tier; oldest entries
+  /// are dropped when it is exceeded.
+  static constexpr std::string_view kFragmentResultCacheMaxDiskBytes{
+      "fragment-result-cache.max-disk-bytes"};
+  /// If true, a cacheable task whose fragment result cache probe misses but
+  /// whose identical fragment is already running on this worker does not
+  /// start its own execution: it waits for the running task's captured
+  /// output and serves it as its own, so N concurrent identical scans
+  /// execute once. If the running task never publishes (it failed or its
+  /// output exceeded the capture limit), the waiter starts normally.
+  /// Requires 'fragment-result-cache.enabled' and shares its determinism
+  /// caveats.
+  static constexpr std::string_view kFragmentResultCacheScanShareEnabled{
+      "fragment-result-cache.scan-share-enabled"};
+
   static constexpr std::string_view kShuffleName{"shuffle.name"};
   static constexpr std::string_view kHttpEnableAccessLog{
       "http-server.enable-access-log"};
+  /// Logs every Nth successfully completed request per endpoint class in the
+  /// access log. Error responses and aborted requests are always logged.
+  /// 1 (the default) logs every request.
+  static constexpr std::string_view kHttpAccessLogSampleRate{
+      "http-server.access-log-sample-rate"};
   static constexpr std::string_view kHttpEnableStatsFilter{
       "http-server.enable-stats-filter"};
   static constexpr std::string_view kHttpEnableEndpointLatencyFilter{
@@ -684,11 +1040,41 @@ class SystemConfig : public ConfigBase {
   static constexpr std::string_view kAnnouncementMaxFrequencyMs{
       "announcement-max-frequency-ms"};
 
+  /// If true, after the first successful announcement the worker sends a small
+  /// refresh payload that carries only the announcement identity instead of
+  /// re-sending the full service descriptor with all connector properties on
+  /// every heartbeat. Any announcement failure falls back to the full payload.
+  /// Requires a discovery service that understands delta announcements.
+  static constexpr std::string_view kAnnouncementDeltaEnabled{
+      "announcement-delta-enabled"};
+
+  /// If true, independent registration phases of server startup (filesystem
+  /// and file format registration, serde registration, remote function
+  /// registration) overlap on a short-lived startup executor instead of
+  /// running strictly sequentially, shortening worker cold start. Phases with
+  /// ordering dependencies still wait for each other.
+  static constexpr std::string_view kStartupParallelRegistrationEnabled{
+      "startup.parallel-registration-enabled"};
+
   /// Time (ms) after which we periodically send heartbeats to discovery
   /// endpoint.
   static constexpr std::string_view kHeartbeatFrequencyMs{
       "heartbeat-frequency-ms"};
 
+  /// If true, a heartbeat re-sends the previously serialized node status as a
+  /// cheap liveness signal and only collects and serializes fresh stats when
+  /// cpu load or memory usage moved beyond significance thresholds, or when
+  /// 'heartbeat-stats-max-age-ms' elapsed since the last fresh payload. Any
+  /// heartbeat failure also forces a fresh payload.
+  static constexpr std::string_view kHeartbeatStatsDeltaEnabled{
+      "heartbeat-stats-delta-enabled"};
+
+  /// Upper bound (ms) on how long heartbeats may keep re-sending cached node
+  /// stats while deltas stay below the significance thresholds. Only takes
+  /// effect when 'heartbeat-stats-delta-enabled' is true.
+  static constexpr std::string_view kHeartbeatStatsMaxAgeMs{
+      "heartbeat-stats-max-age-ms"};
+
   /// Whether HTTP/2 is enabled for HTTP client connections.
   static constexpr std::string_view kHttpClientHttp2Enabled{
       "http-client.http2-enabled"};
@@ -717,6 +1103,32 @@ class SystemConfig : public ConfigBase {
   static constexpr std::string_view kExchangeMaxErrorDuration{
       "exchange.max-error-duration"};
 
+  /// Trace timing for 1 in every N exchange requests, selected by request
+  /// path hash so the producing and consuming workers stamp the same pages.
+  /// 0 (the default) disables exchange tracing. The trace is read through the
+  /// server/getExchangeTrace operation.
+  static constexpr std::string_view kExchangeTraceSampleEveryN{
+      "exchange.trace-sample-every-n"};
+
+  /// Compress exchange result bodies with zstd against a dictionary trained
+  /// per output buffer. The producer trains the dictionary on the first
+  /// 'exchange.zstd-dictionary-training-pages' bodies of each buffer, ships
+  /// it once to the consumer through a response header and compresses every
+  /// later body against it. Effective for repetitive exchange payloads where
+  /// per-page compression finds little redundancy. All workers of the
+  /// cluster must run a build that understands the dictionary headers before
+  /// this is enabled.
+  static constexpr std::string_view kExchangeZstdDictionaryCompressionEnabled{
+      "exchange.zstd-dictionary-compression-enabled"};
+
+  /// Number of result bodies of an output buffer collected as training
+  /// samples before its zstd dictionary is trained. Only applies if
+  /// 'exchange.zstd-dictionary-compression-enabled' is true. Training needs
+  /// a reasonable number of samples to succeed; destinations whose training
+  /// fails are sent uncompressed.
+  static constexpr std::string_view kExchangeZstdDictionaryTrainingPages{
+      "exchange.zstd-dictionary-training-pages"};
+
   /// If true, copy proxygen iobufs to velox memory pool, otherwise not. The
   /// presto exchange source builds the serialized presto page from proxygen
   /// iobufs directly.
@@ -745,6 +1157,15 @@ class SystemConfig : public ConfigBase {
   static constexpr std::string_view kExchangeEnableConnectionPool{
       "exchange.http-client.enable-connection-pool"};
 
+  /// Number of exchange connections to establish to each upstream worker as
+  /// soon as its remote source location is seen in a task update, ahead of
+  /// the first getData request. This spreads TCP (and TLS) connection setup
+  /// across the exchange IO threads instead of paying it serially on the
+  /// first request to each peer. Zero (default) disables pre-warming. Only
+  /// applies if 'exchange.http-client.enable-connection-pool' is true.
+  static constexpr std::string_view kExchangeConnectionPoolWarmupPerPeer{
+      "exchange.http-client.connection-warmup-per-peer"};
+
   /// Floating point number used in calculating how many threads we would use
   /// for Exchange HTTP client IO executor: hw_concurrency x multiplier.
   /// 1.0 is default.
@@ -763,10 +1184,158 @@ class SystemConfig : public ConfigBase {
   static constexpr std::string_view kExchangeMaxBufferSize{
       "exchange.max-buffer-size"};
 
+  /// Size of the 2MB-page backed arena exchange response buffers are
+  /// allocated from, backed by explicit huge pages when the system has them
+  /// reserved and by a transparent-hugepage-advised mapping otherwise. The
+  /// arena is mapped up front and is not tracked by the velox memory pools;
+  /// allocations that do not fit fall back to the regular pool path. Zero
+  /// (default) disables the arena.
+  static constexpr std::string_view kExchangeHugePageArenaSize{
+      "exchange.hugepage-arena-size"};
+
+  /// Number of getData responses an exchange source may fetch ahead of the
+  /// explicit request() calls issued by the exchange client. When greater
+  /// than zero, the next getData request is sent as soon as a data response
+  /// has been processed; its advanced token doubles as the acknowledgement
+  /// for the data just received, removing the acknowledge round trip from
+  /// the fetch loop. Zero (default) keeps the strict request-response
+  /// behavior.
+  static constexpr std::string_view kExchangeHttpClientPipelinedFetchWindow{
+      "exchange.http-client.pipelined-fetch-window"};
+
+  /// If true, the byte budget requested on each exchange getData call is
+  /// adapted per source from the observed response sizes and fetch
+  /// latencies (additive increase, multiplicative decrease), instead of
+  /// always using the exchange client's fixed maximum. Sources on fast
+  /// links grow toward the client's cap while slow links back off, keeping
+  /// the per-source in-flight data proportional to what the link can
+  /// absorb in one round trip.
+  static constexpr std::string_view kExchangeAdaptiveRequestSizeEnabled{
+      "exchange.http-client.adaptive-request-size-enabled"};
+
+  /// If true, consecutive small data responses from the same exchange
+  /// source are coalesced into one larger serialized page before being
+  /// enqueued, so the consuming driver pays the fixed per-page
+  /// deserialization cost once per batch instead of once per response. The
+  /// coalescing target adapts to the observed response sizes of each
+  /// source; responses already larger than the target pass through
+  /// unbuffered, and held data is flushed as soon as the producer reports
+  /// its buffer empty or complete. Mainly helps wide fan-in stages where
+  /// the median page is tens of kilobytes.
+  static constexpr std::string_view kExchangePageCoalescingEnabled{
+      "exchange.page-coalescing-enabled"};
+
+  /// If true, a getData request whose response is slow relative to the
+  /// upstream worker's own recent latency distribution is hedged: a second
+  /// identical request is issued for the same token (getData is idempotent
+  /// per token) and the first response to arrive wins, the loser is
+  /// discarded. This bounds the stage's tail latency by the healthy
+  /// distribution of each peer instead of the slowest outlier response.
+  static constexpr std::string_view kExchangeHedgedRequestEnabled{
+      "exchange.http-client.hedged-request-enabled"};
+
+  /// Delay in milliseconds before hedging a getData request to a peer whose
+  /// recent latency distribution has not been sampled yet. Once enough
+  /// responses have been observed, the tracked p99 of that peer's response
+  /// durations is used instead. Only takes effect when
+  /// 'exchange.http-client.hedged-request-enabled' is true.
+  static constexpr std::string_view kExchangeHedgedRequestDelayMs{
+      "exchange.http-client.hedged-request-delay-ms"};
+
+  /// If true, each exchange getData request reserves its byte budget from
+  /// the query memory pool before being issued and is parked when the
+  /// reservation cannot be met, resuming when another source releases its
+  /// reservation. A burst of responses from a wide fan-in then turns into
+  /// backpressure on the requests instead of overshooting the query limit
+  /// once the data has already arrived.
+  static constexpr std::string_view kExchangeMemoryAdmissionEnabled{
+      "exchange.http-client.memory-admission-enabled"};
+
+  /// If true, exchange getData dispatch is weighted by topology distance:
+  /// requests to sources outside the local rack are delayed by
+  /// 'exchange.remote-rack-dispatch-delay-ms' while rack-local data is
+  /// already buffered in the exchange queue, so rack-local sources drain
+  /// first and cross-rack traffic trickles at lower priority. Rack
+  /// membership is inferred from the source host's IPv4 address; sources
+  /// whose distance cannot be determined are treated as rack-local and
+  /// never delayed.
+  static constexpr std::string_view kExchangeRackLocalPrioritizationEnabled{
+      "exchange.rack-local-prioritization-enabled"};
+
+  /// Number of leading IPv4 address bits two hosts must share to be
+  /// considered rack-local by
+  /// 'exchange.rack-local-prioritization-enabled'. The default of 24
+  /// matches the common one-subnet-per-rack layout.
+  static constexpr std::string_view kExchangeRackIpv4PrefixBits{
+      "exchange.rack-ipv4-prefix-bits"};
+
+  /// Dispatch delay in milliseconds applied to getData requests to sources
+  /// outside the local rack when rack-local data is already buffered. Only
+  /// takes effect when 'exchange.rack-local-prioritization-enabled' is
+  /// true.
+  static constexpr std::string_view kExchangeRemoteRackDispatchDelayMs{
+      "exchange.remote-rack-dispatch-delay-ms"};
+
+  /// If true, a getData transfer that fails after part of the body has
+  /// arrived is resumed instead of refetched: the received prefix is kept
+  /// and the retry carries the 'X-Presto-Page-Resume-Offset' header so the
+  /// producer only resends the remainder of the token, validated end to
+  /// end with a crc32c checksum over the whole payload. Responses
+  /// compressed against a trained zstd dictionary are never resumed, since
+  /// their bytes are not guaranteed stable across attempts; those fall
+  /// back to a full refetch.
+  static constexpr std::string_view kExchangePartialPageResumeEnabled{
+      "exchange.partial-page-resume-enabled"};
+
+  /// If true, the plan conversion records which columns of an exchange a
+  /// fragment actually uses when it immediately projects part of the
+  /// exchange away, the exchange client sends that column mask with each
+  /// results fetch ('X-Presto-Exchange-Columns'), and the producing worker
+  /// nulls out the unused columns before the pages travel the wire. The mask
+  /// is advisory; producers that cannot apply it serve the full pages.
+  static constexpr std::string_view kExchangeSelectiveColumnsEnabled{
+      "exchange.selective-columns-enabled"};
+
+  /// Column count at and above which the shuffle read operator issues
+  /// software prefetches over the serialized rows before handing them to the
+  /// compact-row deserializer. Wide-row decode revisits each row once per
+  /// column, which stalls on scattered loads; pulling the row bytes into
+  /// cache ahead of the column walk hides them. Narrow schemas stream well
+  /// already and are skipped. 0 disables decode prefetch.
+  static constexpr std::string_view kExchangeWideRowDecodePrefetchMinColumns{
+      "exchange.wide-row-decode-prefetch-min-columns"};
+
+  /// If true and 'exchange.materialization-base-path' is set, workers tee
+  /// every task's output pages to durable storage as the output buffer
+  /// serves them, sealing one file per output buffer once the last page has
+  /// been served, and the exchange client falls back to reading that file
+  /// when the producing worker can no longer be reached. This turns the
+  /// loss of a worker whose tasks had finished into a stage retry instead
+  /// of a query retry. A producer lost before serving its last page leaves
+  /// no file and fails the query as before.
+  static constexpr std::string_view kExchangeMaterializationEnabled{
+      "exchange.materialization-enabled"};
+
+  /// Base directory for materialized exchange files; must be on storage all
+  /// workers can read, on any filesystem registered with velox. Empty
+  /// disables materialization. Sealed files are not cleaned up by the
+  /// worker; the deployment removes them with the query's staging data.
+  static constexpr std::string_view kExchangeMaterializationBasePath{
+      "exchange.materialization-base-path"};
+
   /// The maximum timeslice for a task on thread if there are threads queued.
   static constexpr std::string_view kTaskRunTimeSliceMicros{
       "task-run-timeslice-micros"};
 
+  /// The maximum share of the driver CPU time a single query may consume
+  /// between two consecutive task stats updates before its drivers are
+  /// yielded preferentially when other drivers are queued. Expressed as a
+  /// fraction in (0, 1]; 0 disables the per-query CPU throttle. Only takes
+  /// effect when 'task-run-timeslice-micros' is positive, since the throttle
+  /// works through the same yield mechanism.
+  static constexpr std::string_view kTaskMaxQueryCpuShare{
+      "task-max-query-cpu-share"};
+
   static constexpr std::string_view kIncludeNodeInSpillPath{
       "include-node-in-spill-path"};
 
@@ -789,6 +1358,23 @@ class SystemConfig : public ConfigBase {
   static constexpr std::string_view kRemoteFunctionServerRestURL{
       "remote-function-server.rest.url"};
 
+  /// Number of parallel connections each worker keeps to a remote function
+  /// rest server. Requests from concurrent driver threads are round-robined
+  /// over them so remote calls overlap instead of queueing behind a single
+  /// connection.
+  static constexpr std::string_view kRemoteFunctionServerRestNumConnections{
+      "remote-function-server.rest.num-connections"};
+
+  /// Byte budget of the memo cache for deterministic remote rest functions.
+  /// When positive, results are remembered keyed by function location and
+  /// serialized input row, so repeated inputs are answered locally instead
+  /// of re-invoking the function server. The cache is shared by all remote
+  /// functions of the process and evicts least recently used entries when
+  /// over budget. Zero, the default, disables memoization. Functions whose
+  /// metadata declares them non-deterministic are never memoized.
+  static constexpr std::string_view kRemoteFunctionServerRestMemoCacheMaxBytes{
+      "remote-function-server.rest.memo-cache-max-bytes"};
+
   /// Path where json files containing signatures for remote functions can be
   /// found.
   static constexpr std::string_view
@@ -817,6 +1403,13 @@ class SystemConfig : public ConfigBase {
   /// Optional string containing the path to the plugin directory
   static constexpr std::string_view kPluginDir{"plugin.dir"};
 
+  /// Number of threads loading plugin libraries concurrently at startup.
+  /// Each library's functions register from the thread that loaded it, so
+  /// libraries whose initialization is not thread safe require the default
+  /// of 1 (serial loading).
+  static constexpr std::string_view kPluginLoadParallelism{
+      "plugin.load-parallelism"};
+
   /// Uses legacy version of array_agg which ignores nulls.
   static constexpr std::string_view kUseLegacyArrayAgg{
       "deprecated.legacy-array-agg"};
@@ -896,6 +1489,263 @@ class SystemConfig : public ConfigBase {
   static constexpr std::string_view kPlanConsistencyCheckEnabled{
       "plan-consistency-check-enabled"};
 
+  /// If true, velox plan fragments converted from interactive task update
+  /// requests are cached per query and reused by the other tasks of the same
+  /// stage, which all carry identical serialized fragments, instead of
+  /// re-running the conversion per task. Fragments whose conversion depends
+  /// on the task id are never cached.
+  static constexpr std::string_view kPlanConversionCacheEnabled{
+      "task.plan-conversion-cache-enabled"};
+
+  /// If true, serialized plan fragments embedded in task update requests are
+  /// interned by content digest: the first task of a stage parses the
+  /// fragment JSON and the other tasks, which carry a byte-identical
+  /// fragment, reuse the parsed form instead of re-parsing the multi-megabyte
+  /// text per task. A coordinator that sends the digest in the
+  /// 'X-Presto-Fragment-Digest' request header may omit the fragment body
+  /// once the worker has interned it; an unknown digest without a body fails
+  /// the update so the coordinator resends the full fragment.
+  static constexpr std::string_view kTaskFragmentInterningEnabled{
+      "task.fragment-interning-enabled"};
+
+  /// How long an interned plan fragment stays reusable. Stage task creates
+  /// arrive within seconds of each other, so a short TTL bounds the memory
+  /// held by parsed fragments without losing hits.
+  static constexpr std::string_view kTaskFragmentInterningTtlMs{
+      "task.fragment-interning-ttl-ms"};
+
+  /// If true, a task update whose 'X-Presto-Plan-Signature' request header
+  /// carries a valid HMAC-SHA256 of the plan fragment digest, keyed by
+  /// 'internal-communication.shared-secret', skips the per-task structural
+  /// plan validation: the coordinator already validated the plan, and all
+  /// tasks of a stage share it. The signature is verified once per fragment
+  /// digest; a present but invalid signature fails the update. Updates
+  /// without the header are validated as usual.
+  static constexpr std::string_view kTaskTrustedPlanEnabled{
+      "task.trusted-plan-enabled"};
+
+  /// Width (ms) of the per-operator time-sliced stats windows. When
+  /// positive, the periodic task stats sweep folds the wall time, CPU time
+  /// and input rows each operator accumulated since the previous sweep into
+  /// a bounded per-task history of windows this wide, served as flame-chart
+  /// JSON by GET /v1/task/{taskId}/timeSlicedStats. Turns "this task was
+  /// slow" into "this operator degraded at minute 47". Values below the
+  /// sweep period (two seconds) are effectively clamped to it. Zero, the
+  /// default, disables the history.
+  static constexpr std::string_view kTaskTimeSlicedStatsWindowMs{
+      "task.time-sliced-stats-window-ms"};
+
+  /// If true, the session-to-velox config conversion that runs when a new
+  /// query context is built is cached by a digest of the config-relevant
+  /// session content (system and catalog properties, credentials, user,
+  /// source, schema, client tags and time zone). Queries issued with
+  /// identical sessions - dashboards, retries, templated workloads - reuse
+  /// the cached config maps and only overlay their per-query session start
+  /// time instead of re-running the full conversion.
+  static constexpr std::string_view kQuerySessionConfigCacheEnabled{
+      "query.session-config-cache-enabled"};
+
+  /// If true, task admission forecasts the peak memory of an incoming task
+  /// from the moving average observed for tasks with the same plan fragment
+  /// shape and triggers memory arbitration before accepting a task whose
+  /// forecast exceeds the arbitrator's free capacity. Converts mid-execution
+  /// memory pushback of recurring heavy shapes into a brief admission delay.
+  /// Has no effect when memory arbitration is off.
+  static constexpr std::string_view kTaskMemoryForecastEnabled{
+      "task.memory-forecast-enabled"};
+
+  /// If true, JSON task update requests (and the plan fragments embedded in
+  /// them) are parsed with simdjson instead of nlohmann's recursive descent
+  /// parser. The decoded protocol structs are identical; only the parsing
+  /// engine differs.
+  static constexpr std::string_view kTaskUpdateRequestSimdJsonEnabled{
+      "task.update-request-simdjson-enabled"};
+
+  /// If true, large JSON task update request bodies are parsed while they
+  /// are still being received: body chunks are handed to the parser as they
+  /// land on the IO thread instead of being accumulated into one buffer
+  /// first and parsed only after the last byte. Applies to uncompressed
+  /// JSON updates of at least
+  /// 'task.update-request-streaming-parse-min-bytes' parsed with the
+  /// nlohmann engine.
+  static constexpr std::string_view kTaskUpdateStreamingParseEnabled{
+      "task.update-request-streaming-parse-enabled"};
+
+  /// Minimum Content-Length of a task update request body for streaming
+  /// parse. Smaller bodies parse quickly enough that overlapping receive
+  /// and parse is not worth occupying an executor thread.
+  static constexpr std::string_view kTaskUpdateStreamingParseMinBytes{
+      "task.update-request-streaming-parse-min-bytes"};
+
+  /// Maximum Content-Length of a task update request that is applied inline
+  /// on the IO thread instead of being offloaded to the HTTP CPU executor.
+  /// Bodies this small are status-only control updates whose parse costs
+  /// less than an executor hop, and applying them inline keeps them from
+  /// queueing behind multi-megabyte split deliveries on the executor.
+  /// Compressed bodies are always offloaded since they can expand. Zero
+  /// (default) disables the inline path.
+  static constexpr std::string_view kTaskUpdateInlineMaxBytes{
+      "task.update-request-inline-max-bytes"};
+
+  /// How long (ms) the serialized response of an applied task update is
+  /// remembered, keyed by a digest of the raw request body. A coordinator
+  /// that retries an update after a timeout resends byte-identical bytes;
+  /// within this window the retry is answered from the remembered response
+  /// before any body parse or re-apply, so retry storms during coordinator
+  /// GC pauses do not double the task-update CPU. Zero (default) disables
+  /// deduplication.
+  static constexpr std::string_view kTaskUpdateDedupTtlMs{
+      "task.update-request-dedup-ttl-ms"};
+
+  /// If true, hive and iceberg split payloads received over the Thrift
+  /// transport are converted straight to velox connector splits, skipping
+  /// the intermediate protocol struct tree that is otherwise materialized
+  /// per split. With hundreds of thousands of splits per task update the
+  /// intermediate tree is pure transient allocation. Fragment result cache
+  /// keys hash the raw split payload instead of its JSON rendering under
+  /// this mode, so cached entries are not shared between the Thrift and
+  /// JSON transports.
+  static constexpr std::string_view kTaskThriftDirectSplitConversionEnabled{
+      "task.thrift-direct-split-conversion-enabled"};
+
+  /// If true, each batch of splits added to a task is reordered so the
+  /// heaviest splits run first, by the coordinator's split weight estimate
+  /// carried on the connector split. Longest-processing-time order shortens
+  /// the stage tail when split costs vary widely, since no driver is left
+  /// finishing a huge split after the rest of the queue has drained. Splits
+  /// of equal weight, including exchange splits which carry no weight, keep
+  /// their arrival order.
+  static constexpr std::string_view kTaskLptSplitOrderingEnabled{
+      "task.lpt-split-ordering-enabled"};
+
+  /// If true, the split arrays embedded in a batch (Presto-on-Spark) task
+  /// update request are deserialized in shards across the HTTP CPU executor,
+  /// concurrently with the plan fragment parse, instead of on one thread.
+  /// Spark executors send batch updates with thousands of serialized splits
+  /// whose decode otherwise delays batch stage start.
+  static constexpr std::string_view kBatchTaskUpdateParallelDecodeEnabled{
+      "task.batch-update-request-parallel-decode-enabled"};
+
+  /// If true, serving a getResults request also speculatively dequeues the
+  /// next page sequence from the output buffer while the response streams
+  /// out, so a back-to-back getResults request is answered without waiting
+  /// on a dequeue. The most recently served pages are retained until the
+  /// next sequence is requested, so a retried transfer is still answerable
+  /// after the speculative dequeue acknowledged its pages.
+  static constexpr std::string_view kTaskResultsPrefetchEnabled{
+      "task.results-prefetch-enabled"};
+
+  /// If true, a worker whose task fails notifies the upstream workers it has
+  /// exchange connections to, and a worker receiving such a notification
+  /// aborts the running tasks of that query immediately instead of waiting
+  /// for the coordinator to issue deletes.
+  static constexpr std::string_view kTaskQueryFailureGossipEnabled{
+      "task.query-failure-gossip-enabled"};
+
+  /// If true, JSON task status responses are written with the hand-rolled
+  /// direct serializer instead of building a nlohmann DOM and dumping it.
+  /// The wire format is unchanged; only the serialization engine differs.
+  static constexpr std::string_view kTaskStatusDirectSerdeEnabled{
+      "task.status-direct-serde-enabled"};
+
+  /// If true, a Thrift task status poll that carries the
+  /// X-Presto-Task-Status-Base-Version header receives a changed-fields-only
+  /// TaskStatusDelta frame when only counters moved since that version,
+  /// with a full snapshot sent periodically and whenever the change cannot
+  /// be expressed as a delta. Pollers that do not send the header always
+  /// get the full struct.
+  static constexpr std::string_view kTaskStatusDeltaSerdeEnabled{
+      "task.status-delta-serde-enabled"};
+
+  /// If true, splits from task updates are ingested through a fair scheduler
+  /// that interleaves the pending split batches of different queries instead
+  /// of adding each update's splits inline. This keeps one query with a very
+  /// large split assignment from delaying split delivery to everyone else.
+  /// The per-query rate is capped by the
+  /// native_split_ingestion_splits_per_second session property.
+  static constexpr std::string_view kTaskSplitIngestionFairnessEnabled{
+      "task.split-ingestion-fairness-enabled"};
+
+  /// Maximum number of recently processed split identities the worker tracks
+  /// for soft-affinity scheduling. A repeat split likely has its data in the
+  /// worker's local caches, so the tracked history and its hit counters tell
+  /// the coordinator whether routing repeat splits back to this worker pays
+  /// off. Zero disables tracking.
+  static constexpr std::string_view kTaskSplitAffinityTrackingMaxSplits{
+      "task.split-affinity-tracking-max-splits"};
+
+  /// How often, in milliseconds, the serialized task listing snapshot served
+  /// by the /v1/tasks endpoint is rebuilt in the background. Listing requests
+  /// are then answered from the snapshot with a staleness header, making
+  /// their cost independent of the number of tasks. Zero (the default)
+  /// disables the snapshot and the endpoint serializes the listing fresh per
+  /// request.
+  static constexpr std::string_view kTaskListSnapshotRefreshMs{
+      "task.list-snapshot-refresh-ms"};
+
+  /// If true, splits carried by a JSON task update request are decoded in
+  /// batches and queued into the already created task instead of being
+  /// materialized together with the rest of the request. This bounds the peak
+  /// memory of task updates carrying a large number of splits and lets
+  /// execution start before split decoding finishes.
+  static constexpr std::string_view kTaskStreamingSplitIngestionEnabled{
+      "task.streaming-split-ingestion-enabled"};
+
+  /// Number of splits decoded and queued per batch when
+  /// 'task.streaming-split-ingestion-enabled' is set.
+  static constexpr std::string_view kTaskStreamingSplitIngestionBatchSize{
+      "task.streaming-split-ingestion-batch-size"};
+
+  /// If true, registers the /v1/task/<id>/splits/stream endpoint through
+  /// which the coordinator pushes split batches over a single long-lived
+  /// chunked POST as it discovers them, instead of bundling them into its
+  /// periodic task update requests. Each newline-delimited JSON TaskSource
+  /// frame in the body is applied to the task as soon as it arrives, so
+  /// split delivery latency no longer depends on the coordinator's
+  /// task-update cadence.
+  static constexpr std::string_view kTaskSplitStreamEnabled{
+      "task.split-stream-enabled"};
+
+  /// If true, the shared_ptr-wrapped protocol objects decoded from a task
+  /// update request are allocated from a per-request bump arena and released
+  /// wholesale instead of being allocated and freed individually.
+  static constexpr std::string_view kTaskProtocolArenaEnabled{
+      "task.protocol-arena-enabled"};
+
+  /// If true, a periodic sweep flags running tasks whose runtime or peak
+  /// memory is at or above the 'task.auto-trace-percentile' of the tasks this
+  /// worker has completed, and promotes the flagged task's session source:
+  /// queries subsequently arriving with that source run with velox operator
+  /// input tracing enabled, leaving replayable artifacts under
+  /// 'task.auto-trace-dir' without anyone having to turn tracing on by hand.
+  static constexpr std::string_view kTaskAutoTraceEnabled{
+      "task.auto-trace-enabled"};
+
+  /// Base directory for auto-trace artifacts; each promoted query traces
+  /// into '<dir>/<queryId>'. Auto-trace promotion is skipped when empty.
+  static constexpr std::string_view kTaskAutoTraceDir{"task.auto-trace-dir"};
+
+  /// Percentile of the completed-task runtime and peak-memory distributions
+  /// at or above which a running task is flagged as an outlier.
+  static constexpr std::string_view kTaskAutoTracePercentile{
+      "task.auto-trace-percentile"};
+
+  /// Maximum number of session sources promoted for tracing at a time. Along
+  /// with 'task.auto-trace-max-bytes-per-query' this bounds the disk the
+  /// feature can consume.
+  static constexpr std::string_view kTaskAutoTraceMaxPromotedSources{
+      "task.auto-trace-max-promoted-sources"};
+
+  /// How long, in milliseconds, a promoted session source keeps tracing the
+  /// queries that arrive with it before the promotion expires.
+  static constexpr std::string_view kTaskAutoTracePromotionTtlMs{
+      "task.auto-trace-promotion-ttl-ms"};
+
+  /// Trace byte budget handed to velox per promoted query; tracing stops for
+  /// the query once it is exhausted.
+  static constexpr std::string_view kTaskAutoTraceMaxBytesPerQuery{
+      "task.auto-trace-max-bytes-per-query"};
+
   SystemConfig();
 
   virtual ~SystemConfig() = default;
@@ -908,12 +1758,16 @@ class SystemConfig : public ConfigBase {
 
   bool httpServerBindToNodeInternalAddressOnlyEnabled() const;
 
+  std::string httpServerUnixDomainSocketPath() const;
+
   bool httpServerHttpsEnabled() const;
 
   int httpServerHttpsPort() const;
 
   bool httpServerHttp2Enabled() const;
 
+  uint32_t httpServerMaxConcurrentDataRequests() const;
+
   uint32_t httpServerIdleTimeoutMs() const;
 
   uint32_t httpServerHttp2InitialReceiveWindow() const;
@@ -963,6 +1817,8 @@ class SystemConfig : public ConfigBase {
   /// Path to client CA file for SSL client certificate verification.
   folly::Optional<std::string> httpsClientCaFile() const;
 
+  bool httpsKtlsEnabled() const;
+
   bool mutableConfig() const;
 
   std::string prestoVersion() const;
@@ -980,6 +1836,10 @@ class SystemConfig : public ConfigBase {
 
   std::string remoteFunctionServerRestURL() const;
 
+  uint32_t remoteFunctionServerRestNumConnections() const;
+
+  uint64_t remoteFunctionServerRestMemoCacheMaxBytes() const;
+
   int32_t maxDriversPerTask() const;
 
   int32_t driverMaxSplitPreload() const;
@@ -996,6 +1856,8 @@ class SystemConfig : public ConfigBase {
 
   double httpServerNumCpuThreadsHwMultiplier() const;
 
+  double httpServerNumSerializationThreadsHwMultiplier() const;
+
   double exchangeHttpClientNumIoThreadsHwMultiplier() const;
 
   double exchangeHttpClientNumCpuThreadsHwMultiplier() const;
@@ -1006,8 +1868,26 @@ class SystemConfig : public ConfigBase {
 
   double driverNumCpuThreadsHwMultiplier() const;
 
+  bool driverElasticScalingEnabled() const;
+
+  double driverElasticScalingMaxThreadsHwMultiplier() const;
+
+  size_t driverElasticScalingLatencyThresholdMs() const;
+
   bool driverThreadsBatchSchedulingEnabled() const;
 
+  bool driverNumaBindingEnabled() const;
+
+  bool driverSoftAffinityEnabled() const;
+
+  bool crashHandoffEnabled() const;
+
+  std::string crashHandoffFilePath() const;
+
+  std::string crashHandoffNotifyAddress() const;
+
+  std::string numaBindingInterface() const;
+
   size_t driverStuckOperatorThresholdMs() const;
 
   size_t driverCancelTasksWithStuckOperatorsThresholdMs() const;
@@ -1016,6 +1896,10 @@ class SystemConfig : public ConfigBase {
 
   double spillerNumCpuThreadsHwMultiplier() const;
 
+  bool spillerFairSchedulingEnabled() const;
+
+  uint32_t spillerFairSchedulingMaxInFlightPerQuery() const;
+
   std::string spillerFileCreateConfig() const;
 
   std::string spillerDirectoryCreateConfig() const;
@@ -1034,6 +1918,8 @@ class SystemConfig : public ConfigBase {
 
   bool systemMemPushBackAbortEnabled() const;
 
+  double systemMemPushbackArbitrationRatio() const;
+
   uint64_t workerOverloadedThresholdMemGb() const;
 
   uint32_t workerOverloadedThresholdCpuPct() const;
@@ -1046,6 +1932,8 @@ class SystemConfig : public ConfigBase {
 
   bool workerOverloadedTaskQueuingEnabled() const;
 
+  bool workerOverloadedTaskQueueDrainToIdleEnabled() const;
+
   bool mallocMemHeapDumpEnabled() const;
 
   uint32_t mallocHeapDumpThresholdGb() const;
@@ -1064,6 +1952,50 @@ class SystemConfig : public ConfigBase {
 
   uint64_t localShuffleMaxPartitionBytes() const;
 
+  uint64_t localShuffleMemoryTransportMaxBytes() const;
+
+  uint32_t localShuffleReadPrefetchDepth() const;
+
+  bool localShuffleFileCompressionEnabled() const;
+
+  bool localShuffleFileChecksumEnabled() const;
+
+  uint64_t localShuffleCompactionMinFileBytes() const;
+
+  bool localShuffleBlockHeaderEnabled() const;
+
+  uint64_t localShuffleDedupMaxBytes() const;
+
+  bool shuffleStreamingAggregationEnabled() const;
+
+  uint64_t localDiskIoMaxBandwidthBytesPerSecond() const;
+
+  uint32_t broadcastFileReaderPrefetchDepth() const;
+
+  uint64_t broadcastFileCacheMaxBytes() const;
+
+  bool broadcastFileReaderMmapEnabled() const;
+
+  uint64_t broadcastFileWriterMaxBufferedBytes() const;
+
+  uint64_t hiveFileMetadataCacheMaxBytes() const;
+
+  uint64_t icebergDeleteFileCacheMaxBytes() const;
+
+  bool fragmentResultCacheEnabled() const;
+
+  uint64_t fragmentResultCacheMaxBytes() const;
+
+  uint64_t fragmentResultCacheMaxEntryBytes() const;
+
+  uint64_t fragmentResultCacheTtlMs() const;
+
+  std::string fragmentResultCacheBaseDirectory() const;
+
+  uint64_t fragmentResultCacheMaxDiskBytes() const;
+
+  bool fragmentResultCacheScanShareEnabled() const;
+
   std::string asyncCacheSsdPath() const;
 
   double asyncCacheMaxSsdWriteRatio() const;
@@ -1132,6 +2064,8 @@ class SystemConfig : public ConfigBase {
 
   bool enableHttpAccessLog() const;
 
+  uint32_t httpAccessLogSampleRate() const;
+
   bool enableHttpStatsFilter() const;
 
   bool enableHttpEndpointLatencyFilter() const;
@@ -1154,8 +2088,16 @@ class SystemConfig : public ConfigBase {
 
   uint64_t announcementMaxFrequencyMs() const;
 
+  bool announcementDeltaEnabled() const;
+
+  bool startupParallelRegistrationEnabled() const;
+
   uint64_t heartbeatFrequencyMs() const;
 
+  bool heartbeatStatsDeltaEnabled() const;
+
+  uint64_t heartbeatStatsMaxAgeMs() const;
+
   bool httpClientHttp2Enabled() const;
 
   uint32_t httpClientHttp2MaxStreamsPerConnection() const;
@@ -1170,20 +2112,60 @@ class SystemConfig : public ConfigBase {
 
   std::chrono::duration<double> exchangeMaxErrorDuration() const;
 
+  uint64_t exchangeTraceSampleEveryN() const;
+
+  bool exchangeZstdDictionaryCompressionEnabled() const;
+
+  uint32_t exchangeZstdDictionaryTrainingPages() const;
+
   std::chrono::duration<double> exchangeRequestTimeoutMs() const;
 
   std::chrono::duration<double> exchangeConnectTimeoutMs() const;
 
   bool exchangeEnableConnectionPool() const;
 
+  uint32_t exchangeConnectionPoolWarmupPerPeer() const;
+
   bool exchangeEnableBufferCopy() const;
 
   bool exchangeImmediateBufferTransfer() const;
 
   uint64_t exchangeMaxBufferSize() const;
 
+  uint64_t exchangeHugePageArenaBytes() const;
+
+  uint32_t exchangeHttpClientPipelinedFetchWindow() const;
+
+  bool exchangeAdaptiveRequestSizeEnabled() const;
+
+  bool exchangePageCoalescingEnabled() const;
+
+  bool exchangeHedgedRequestEnabled() const;
+
+  int64_t exchangeHedgedRequestDelayMs() const;
+
+  bool exchangeMemoryAdmissionEnabled() const;
+
+  bool exchangeRackLocalPrioritizationEnabled() const;
+
+  uint32_t exchangeRackIpv4PrefixBits() const;
+
+  int64_t exchangeRemoteRackDispatchDelayMs() const;
+
+  bool exchangePartialPageResumeEnabled() const;
+
+  bool exchangeSelectiveColumnsEnabled() const;
+
+  uint32_t exchangeWideRowDecodePrefetchMinColumns() const;
+
+  bool exchangeMaterializationEnabled() const;
+
+  std::string exchangeMaterializationBasePath() const;
+
   int32_t taskRunTimeSliceMicros() const;
 
+  double taskMaxQueryCpuShare() const;
+
   bool includeNodeInSpillPath() const;
 
   int32_t oldTaskCleanUpMs() const;
@@ -1232,6 +2214,8 @@ class SystemConfig : public ConfigBase {
 
   std::string pluginDir() const;
 
+  int32_t pluginLoadParallelism() const;
+
   int32_t exchangeIoEvbViolationThresholdMs() const;
 
   int32_t httpSrvIoEvbViolationThresholdMs() const;
@@ -1253,6 +2237,94 @@ class SystemConfig : public ConfigBase {
   bool enumTypesEnabled() const;
 
   bool planConsistencyCheckEnabled() const;
+
+  bool planConversionCacheEnabled() const;
+
+  bool taskFragmentInterningEnabled() const;
+
+  uint64_t taskFragmentInterningTtlMs() const;
+
+  bool taskTrustedPlanEnabled() const;
+
+  uint64_t taskTimeSlicedStatsWindowMs() const;
+
+  bool querySessionConfigCacheEnabled() const;
+
+  bool taskMemoryForecastEnabled() const;
+
+  bool taskUpdateRequestSimdJsonEnabled() const;
+
+  bool taskUpdateStreamingParseEnabled() const;
+
+  uint64_t taskUpdateStreamingParseMinBytes() const;
+
+  uint64_t taskUpdateInlineMaxBytes() const;
+
+  uint64_t taskUpdateDedupTtlMs() const;
+
+  bool taskThriftDirectSplitConversionEnabled() const;
+
+  bool taskLptSplitOrderingEnabled() const;
+
+  bool batchTaskUpdateParallelDecodeEnabled() const;
+
+  bool taskResultsPrefetchEnabled() const;
+
+  bool taskQueryFailureGossipEnabled() const;
+
+  bool taskStatusDirectSerdeEnabled() const;
+
+  bool taskStatusDeltaSerdeEnabled() const;
+
+  bool taskSplitIngestionFairnessEnabled() const;
+
+  uint64_t taskSplitAffinityTrackingMaxSplits() const;
+
+  uint32_t taskListSnapshotRefreshMs() const;
+
+  bool streamingSplitIngestionEnabled() const;
+
+  int32_t streamingSplitIngestionBatchSize() const;
+
+  bool taskSplitStreamEnabled() const;
+
+  bool taskProtocolArenaEnabled() const;
+
+  bool taskAutoTraceEnabled() const;
+
+  std::string taskAutoTraceDir() const;
+
+  int32_t taskAutoTracePercentile() const;
+
+  int32_t taskAutoTraceMaxPromotedSources() const;
+
+  uint64_t taskAutoTracePromotionTtlMs() const;
+
+  uint64_t taskAutoTraceMaxBytesPerQuery() const;
+
+  /// Names of the runtime-tunable ("dynamic") properties: the exchange and
+  /// task tuning knobs plus the memory pushback thresholds. The
+  /// reloadProperties server operation applies changes to these only; all
+  /// other properties are frozen at startup.
+  static const std::unordered_set<std::string>& dynamicProperties();
+
+ private:
+  // Parsed-value caches for the dynamic properties read on hot paths; see
+  // DynamicProperty. Keyed to generation(), so a setProperty or
+  // reloadProperties operation takes effect on the next read.
+  mutable DynamicProperty<uint32_t> exchangePipelinedFetchWindowCache_;
+  mutable DynamicProperty<bool> exchangeAdaptiveRequestSizeEnabledCache_;
+  mutable DynamicProperty<bool> exchangePageCoalescingEnabledCache_;
+  mutable DynamicProperty<bool> exchangeHedgedRequestEnabledCache_;
+  mutable DynamicProperty<int64_t> exchangeHedgedRequestDelayMsCache_;
+  mutable DynamicProperty<bool> exchangeMemoryAdmissionEnabledCache_;
+  mutable DynamicProperty<bool> exchangeRackLocalPrioritizationEnabledCache_;
+  mutable DynamicProperty<uint32_t> exchangeRackIpv4PrefixBitsCache_;
+  mutable DynamicProperty<int64_t> exchangeRemoteRackDispatchDelayMsCache_;
+  mutable DynamicProperty<bool> taskResultsPrefetchEnabledCache_;
+  mutable DynamicProperty<bool> taskUpdateStreamingParseEnabledCache_;
+  mutable DynamicProperty<uint64_t> taskUpdateStreamingParseMinBytesCache_;
+  mutable DynamicProperty<uint64_t> taskUpdateInlineMaxBytesCache_;
 };
 
 /// Provides access to node properties defined in node.properties file.
@@ -1265,8 +2337,6 @@ class NodeConfig : public ConfigBase {
   static constexpr std::string_view kNodeInternalAddress{
       "node.internal-address"};
   static constexpr std::string_view kNodeLocation{"node.location"};
-  static constexpr std::string_view kNodePrometheusExecutorThreads{
-      "node.prometheus.num-executor-threads"};
 
   NodeConfig();
 
@@ -1276,8 +2346,6 @@ class NodeConfig : public ConfigBase {
 
   std::string nodeEnvironment() const;
 
-  int prometheusExecutorThreads() const;
-
   std::string nodeId() const;
 
   std::string nodeInternalAddress(
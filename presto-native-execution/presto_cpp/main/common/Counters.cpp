@@ -39,6 +39,43 @@ void registerPrestoMetrics() {
       90,
       99,
       100);
+  DEFINE_METRIC(
+      kCounterHTTPAccessLogDroppedEntries, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterHttpServerNumCriticalRequests, facebook::velox::StatType::AVG);
+  DEFINE_METRIC(
+      kCounterHttpServerNumControlRequests, facebook::velox::StatType::AVG);
+  DEFINE_METRIC(
+      kCounterHttpServerNumDataRequests, facebook::velox::StatType::AVG);
+  DEFINE_METRIC(
+      kCounterHttpServerNumShedRequests, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterLocalDiskIoSpillBytes, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterLocalDiskIoShuffleWriteBytes, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterLocalDiskIoShuffleReadBytes, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterLocalDiskIoBroadcastBytes, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterLocalDiskIoThrottledTimeMs, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterLocalShuffleChecksumFailures, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterLocalShuffleBlocksSkipped, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterLocalShuffleDedupSavedBytes, facebook::velox::StatType::SUM);
+  // Tracks broadcast file sizes in range of [0, 8GB] with 64MB buckets and
+  // reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kCounterBroadcastWriteFileBytes,
+      64L << 20, // 64MB bucket size
+      0,
+      8L << 30, // 8GB max
+      50,
+      90,
+      99,
+      100);
   DEFINE_METRIC(
       kCounterHttpClientNumConnectionsCreated, facebook::velox::StatType::SUM);
   DEFINE_METRIC(
@@ -57,6 +94,18 @@ void registerPrestoMetrics() {
       99,
       100);
   DEFINE_METRIC(kCounterNumQueryContexts, facebook::velox::StatType::AVG);
+  DEFINE_METRIC(
+      kCounterQueryContextCacheHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterQueryContextCacheMisses, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterQueryContextCacheEvictions, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterQueryContextCreationTimeMs, facebook::velox::StatType::AVG);
+  DEFINE_METRIC(
+      kCounterSessionConfigCacheHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterSessionConfigCacheMisses, facebook::velox::StatType::COUNT);
   DEFINE_METRIC(
       kCounterMemoryManagerTotalBytes, facebook::velox::StatType::AVG);
   DEFINE_METRIC(kCounterNumTasks, facebook::velox::StatType::AVG);
@@ -77,6 +126,34 @@ void registerPrestoMetrics() {
   DEFINE_METRIC(kCounterNumTasksDeadlock, facebook::velox::StatType::AVG);
   DEFINE_METRIC(
       kCounterNumTaskManagerLockTimeOut, facebook::velox::StatType::AVG);
+  DEFINE_METRIC(
+      kCounterOldTaskCleanupLockHoldMs, facebook::velox::StatType::AVG);
+  DEFINE_METRIC(
+      kCounterQueryFailureGossipAbortedTasks, facebook::velox::StatType::COUNT);
+  // Tracks the split ingestion queueing delay in range of [0, 30s] with
+  // 300 buckets and reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kCounterSplitIngestionQueueDelayMs,
+      100, // 100ms bucket size
+      0,
+      30'000, // 30s max
+      50,
+      90,
+      99,
+      100);
+  // Same range as the split ingestion delay: spill tasks held back by the
+  // fair scheduler wait for other queries' in-flight spills to finish.
+  DEFINE_HISTOGRAM_METRIC(
+      kCounterSpillerFairQueueWaitMs,
+      100, // 100ms bucket size
+      0,
+      30'000, // 30s max
+      50,
+      90,
+      99,
+      100);
+  DEFINE_METRIC(kCounterSplitAffinityHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(kCounterSplitAffinityMisses, facebook::velox::StatType::COUNT);
   DEFINE_METRIC(kCounterNumQueuedDrivers, facebook::velox::StatType::AVG);
   DEFINE_METRIC(kCounterNumOnThreadDrivers, facebook::velox::StatType::AVG);
   DEFINE_METRIC(kCounterNumSuspendedDrivers, facebook::velox::StatType::AVG);
@@ -106,12 +183,79 @@ void registerPrestoMetrics() {
   DEFINE_METRIC(kCounterOverloaded, facebook::velox::StatType::AVG);
   DEFINE_METRIC(kCounterNumStuckDrivers, facebook::velox::StatType::AVG);
   DEFINE_METRIC(kCounterTaskPlannedTimeMs, facebook::velox::StatType::AVG);
+  // Tracks plan fragment conversion time in range of [0, 10s] with 100
+  // buckets and reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kCounterTaskPlanConversionTimeMs, 100, 0, 10'000, 50, 90, 99, 100);
+  // Inline updates apply on the IO thread and should stay in the low
+  // milliseconds; offloaded updates include executor queueing, so the range
+  // matches plan conversion.
+  DEFINE_HISTOGRAM_METRIC(
+      kCounterTaskUpdateInlineLatencyMs, 100, 0, 1'000, 50, 90, 99, 100);
+  DEFINE_HISTOGRAM_METRIC(
+      kCounterTaskUpdateOffloadedLatencyMs, 100, 0, 10'000, 50, 90, 99, 100);
+  DEFINE_METRIC(kCounterTaskUpdateDedupHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterTaskPlanConversionCacheHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterTaskPlanConversionCacheMisses, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterTaskFragmentInterningHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterTaskFragmentInterningMisses, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterTaskMemoryForecastArbitrationCount,
+      facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(kCounterTaskGpuOperatorTimeMs, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(kCounterTaskCpuOperatorTimeMs, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(kCounterTypeParserCacheHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterTypeParserCacheMisses, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterExpressionOptimizerCacheHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterExpressionOptimizerCacheMisses,
+      facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterExpressionOptimizerBatchDedupCount,
+      facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterSidecarRequestPoolsReused, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterSidecarRequestPoolsCreated, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterHiveFileMetadataCacheHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterHiveFileMetadataCacheMisses, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterHiveFileMetadataCacheEvictions, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterIcebergDeleteFileCacheHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterIcebergDeleteFileCacheMisses, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterIcebergDeleteFileCacheEvictions,
+      facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterFragmentResultCacheHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterFragmentResultCacheMisses, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(kCounterScanShareHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(kCounterScanShareFallbacks, facebook::velox::StatType::COUNT);
   DEFINE_METRIC(kCounterOverloadedDurationSec, facebook::velox::StatType::AVG);
   DEFINE_METRIC(
       kCounterTotalPartitionedOutputBuffer, facebook::velox::StatType::AVG);
   DEFINE_METRIC(
       kCounterPartitionedOutputBufferGetDataLatencyMs,
       facebook::velox::StatType::AVG);
+  DEFINE_METRIC(
+      kCounterTaskResultsPrefetchedBytes, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterTaskResultsPrefetchHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterTaskResultsPrefetchMisses, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterPassthroughExchangeStageTasks, facebook::velox::StatType::COUNT);
   DEFINE_METRIC(
       kCounterWorkerRuntimeUptimeSecs, facebook::velox::StatType::AVG);
   DEFINE_METRIC(kCounterOsUserCpuTimeMicros, facebook::velox::StatType::AVG);
@@ -132,6 +276,23 @@ void registerPrestoMetrics() {
       95,
       99,
       100);
+  DEFINE_METRIC(
+      kCounterExchangeHugePageArenaUsedBytes, facebook::velox::StatType::AVG);
+  DEFINE_METRIC(
+      kCounterExchangeHugePageArenaFragmentationPct,
+      facebook::velox::StatType::AVG);
+  DEFINE_METRIC(
+      kCounterExchangeHugePageArenaFallbackCount,
+      facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterExchangeSelectiveColumnsSavedBytes,
+      facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterExchangeMaterializedBytes, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterExchangeMaterializedBuffers, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterExchangeMaterializedFailovers, facebook::velox::StatType::COUNT);
 
   // Tracks exchange request duration in range of [0, 10s] with
   // 500 buckets and reports P50, P90, P99, and P100.
@@ -159,6 +320,31 @@ void registerPrestoMetrics() {
       90,
       99,
       100);
+  // Tracks the adaptive getData byte budget in range of [0, 64MB] with
+  // 1K buckets and reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kCounterExchangeAdaptiveRequestSize,
+      64 * 1024, // 64KB bucket size
+      0,
+      64 * 1024 * 1024, // 64MB max
+      50,
+      90,
+      99,
+      100);
+
+  DEFINE_METRIC(
+      kCounterExchangeHedgedRequestCount, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterExchangeHedgedRequestWinCount, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterExchangeResumedFetchCount, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterExchangeResumeRejectedCount, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterExchangeRequestMemoryDeferrals, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterExchangeRemoteRackDelayedRequests,
+      facebook::velox::StatType::COUNT);
 
   // Tracks exchange get-data-size request duration in range of [0, 300s] with
   // 300 buckets and reports P50, P90, P99, and P100.
@@ -170,6 +356,9 @@ void registerPrestoMetrics() {
       kCounterExchangeGetDataSizeNumTries, 1, 0, 20, 50, 90, 99, 100);
 
   DEFINE_METRIC(kCounterMemoryPushbackCount, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterMemoryPushbackArbitrationCount,
+      facebook::velox::StatType::COUNT);
   DEFINE_HISTOGRAM_METRIC(
       kCounterMemoryPushbackLatencyMs, 10'000, 0, 100'000, 50, 90, 99, 100);
   DEFINE_HISTOGRAM_METRIC(
@@ -190,6 +379,48 @@ void registerPrestoMetrics() {
       90,
       99,
       100);
+  DEFINE_METRIC(
+      kCounterMemoryPressureEventCount, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterMemoryPressureReclaimedBytes, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterProtocolSerdeEstimatedAllocCount,
+      facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterProtocolSerdeEstimatedAllocBytes,
+      facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterExchangeEstimatedAllocCount, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterExchangeEstimatedAllocBytes, facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterCompressionBackendCompressInputBytes,
+      facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterCompressionBackendCompressOutputBytes,
+      facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterCompressionBackendUncompressInputBytes,
+      facebook::velox::StatType::SUM);
+  DEFINE_METRIC(
+      kCounterTaskTrustedPlanValidationSkipped,
+      facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterDriverSoftAffinityMigrations, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterAutoTracePromotedSources, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterRemoteFunctionMemoCacheHits, facebook::velox::StatType::COUNT);
+  DEFINE_METRIC(
+      kCounterRemoteFunctionMemoCacheMisses, facebook::velox::StatType::COUNT);
+  DEFINE_HISTOGRAM_METRIC(
+      kCounterCompressionBackendCompressThroughputMbPerSec,
+      100, // 100 MB/s
+      0,
+      10'000, // 10 GB/s
+      50,
+      90,
+      99);
 
   DEFINE_METRIC(
       kCounterExchangeIoEvbViolation, facebook::velox::StatType::COUNT);
@@ -40,6 +40,55 @@ constexpr std::string_view kCounterHTTPRequestLatencyMs{
     "presto_cpp.http_request_latency_ms"};
 constexpr std::string_view kCounterHTTPRequestSizeBytes{
     "presto_cpp.http_request_size_bytes"};
+/// Number of access log entries dropped because the access log writer queue
+/// was full.
+constexpr std::string_view kCounterHTTPAccessLogDroppedEntries{
+    "presto_cpp.http_access_log_dropped_entries"};
+
+/// Number of in-flight HTTP server requests per endpoint priority lane.
+constexpr std::string_view kCounterHttpServerNumCriticalRequests{
+    "presto_cpp.http_server_num_critical_requests"};
+constexpr std::string_view kCounterHttpServerNumControlRequests{
+    "presto_cpp.http_server_num_control_requests"};
+constexpr std::string_view kCounterHttpServerNumDataRequests{
+    "presto_cpp.http_server_num_data_requests"};
+/// Number of HTTP server requests rejected with 503 because their priority
+/// lane was at its concurrency limit.
+constexpr std::string_view kCounterHttpServerNumShedRequests{
+    "presto_cpp.http_server_num_shed_requests"};
+
+/// Bytes of local disk traffic accounted per LocalDiskIoScheduler I/O class.
+constexpr std::string_view kCounterLocalDiskIoSpillBytes{
+    "presto_cpp.local_disk_io_spill_bytes"};
+constexpr std::string_view kCounterLocalDiskIoShuffleWriteBytes{
+    "presto_cpp.local_disk_io_shuffle_write_bytes"};
+constexpr std::string_view kCounterLocalDiskIoShuffleReadBytes{
+    "presto_cpp.local_disk_io_shuffle_read_bytes"};
+constexpr std::string_view kCounterLocalDiskIoBroadcastBytes{
+    "presto_cpp.local_disk_io_broadcast_bytes"};
+/// Time callers spent waiting for their local disk bandwidth share.
+constexpr std::string_view kCounterLocalDiskIoThrottledTimeMs{
+    "presto_cpp.local_disk_io_throttled_time_ms"};
+
+/// Number of local shuffle files that failed CRC32C verification on read,
+/// indicating silent on-disk corruption.
+constexpr std::string_view kCounterLocalShuffleChecksumFailures{
+    "presto_cpp.local_shuffle_checksum_failure_count"};
+
+/// Number of framed local shuffle blocks skipped on read because their
+/// min/max sort key range could not match the reader's key range filter.
+constexpr std::string_view kCounterLocalShuffleBlocksSkipped{
+    "presto_cpp.local_shuffle_blocks_skipped"};
+
+/// Chunk payload bytes not written to local shuffle files because the chunk
+/// store accepted the content and an 8-byte reference was written instead.
+constexpr std::string_view kCounterLocalShuffleDedupSavedBytes{
+    "presto_cpp.local_shuffle_dedup_saved_bytes"};
+
+/// Serialized size of finished broadcast files. Broadcasts far above the
+/// planner's small-table estimate show up in the upper percentiles.
+constexpr std::string_view kCounterBroadcastWriteFileBytes{
+    "presto_cpp.broadcast_write_file_bytes"};
 
 constexpr std::string_view kCounterHttpClientNumConnectionsCreated{
     "presto_cpp.http.client.num_connections_created"};
@@ -55,6 +104,37 @@ constexpr std::string_view kCounterHTTPClientTransactionCreateDelay{
 /// Peak number of bytes queued in PrestoExchangeSource waiting for consume.
 constexpr std::string_view kCounterExchangeSourcePeakQueuedBytes{
     "presto_cpp.exchange_source_peak_queued_bytes"};
+/// Bytes in use in the huge page arena exchange response buffers are
+/// allocated from.
+constexpr std::string_view kCounterExchangeHugePageArenaUsedBytes{
+    "presto_cpp.exchange_hugepage_arena_used_bytes"};
+/// Fragmentation of the huge page arena's free space: 100 minus the share
+/// of the free bytes covered by the largest free run.
+constexpr std::string_view kCounterExchangeHugePageArenaFragmentationPct{
+    "presto_cpp.exchange_hugepage_arena_fragmentation_pct"};
+/// Arena allocations that did not fit in any free run and fell back to the
+/// velox memory pool.
+constexpr std::string_view kCounterExchangeHugePageArenaFallbackCount{
+    "presto_cpp.exchange_hugepage_arena_fallback_count"};
+
+/// Bytes that selective column serving kept off the wire: the difference
+/// between the original and the narrowed getResults payloads. Only moves
+/// when 'exchange.selective-columns-enabled' is true.
+constexpr std::string_view kCounterExchangeSelectiveColumnsSavedBytes{
+    "presto_cpp.exchange_selective_columns_saved_bytes"};
+
+/// Bytes of served output pages teed to the materialized exchange files.
+constexpr std::string_view kCounterExchangeMaterializedBytes{
+    "presto_cpp.exchange_materialized_bytes"};
+/// Number of output buffers whose materialized exchange file was sealed
+/// complete.
+constexpr std::string_view kCounterExchangeMaterializedBuffers{
+    "presto_cpp.exchange_materialized_buffers"};
+/// Number of exchange sources that exhausted their retries against the
+/// producing worker and served the rest of the buffer from its materialized
+/// exchange file instead of failing the query.
+constexpr std::string_view kCounterExchangeMaterializedFailovers{
+    "presto_cpp.exchange_materialized_failovers"};
 
 constexpr std::string_view kCounterExchangeRequestDuration{
     "presto_cpp.exchange.request.duration"};
@@ -62,6 +142,34 @@ constexpr std::string_view kCounterExchangeRequestNumTries{
     "presto_cpp.exchange.request.num_tries"};
 constexpr std::string_view kCounterExchangeRequestPageSize{
     "presto_cpp.exchange.request.page_size"};
+/// Byte budget sent on getData requests when adaptive request sizing is
+/// enabled; shows how the per-source budgets converge.
+constexpr std::string_view kCounterExchangeAdaptiveRequestSize{
+    "presto_cpp.exchange.request.adaptive_request_size"};
+/// Number of hedged getData requests issued because the primary response
+/// exceeded the peer's tracked latency.
+constexpr std::string_view kCounterExchangeHedgedRequestCount{
+    "presto_cpp.exchange.request.hedged_request_count"};
+/// Number of hedged getData requests whose response arrived before the
+/// primary's.
+constexpr std::string_view kCounterExchangeHedgedRequestWinCount{
+    "presto_cpp.exchange.request.hedged_request_win_count"};
+/// Number of getData fetches resumed from a salvaged partial response
+/// instead of refetching the token from the start.
+constexpr std::string_view kCounterExchangeResumedFetchCount{
+    "presto_cpp.exchange.request.resumed_fetch_count"};
+/// Number of resumed getData fetches whose splice was rejected (offset not
+/// honored or checksum mismatch) and fell back to a full refetch.
+constexpr std::string_view kCounterExchangeResumeRejectedCount{
+    "presto_cpp.exchange.request.resume_rejected_count"};
+/// Number of getData requests parked because their byte budget could not be
+/// reserved from the query memory pool.
+constexpr std::string_view kCounterExchangeRequestMemoryDeferrals{
+    "presto_cpp.exchange.request.memory_deferrals"};
+/// Number of getData requests to sources outside the local rack whose
+/// dispatch was delayed in favor of rack-local sources.
+constexpr std::string_view kCounterExchangeRemoteRackDelayedRequests{
+    "presto_cpp.exchange.request.remote_rack_delayed_requests"};
 
 constexpr std::string_view kCounterExchangeGetDataSizeDuration{
     "presto_cpp.exchange.get_data_size.duration"};
@@ -70,9 +178,50 @@ constexpr std::string_view kCounterExchangeGetDataSizeNumTries{
 
 constexpr std::string_view kCounterNumQueryContexts{
     "presto_cpp.num_query_contexts"};
+/// Number of times a task found a live query context in the query context
+/// cache.
+constexpr std::string_view kCounterQueryContextCacheHits{
+    "presto_cpp.query_context_cache_hits"};
+/// Number of times a task had to create a new query context because none was
+/// cached or the cached one had expired.
+constexpr std::string_view kCounterQueryContextCacheMisses{
+    "presto_cpp.query_context_cache_misses"};
+/// Number of unreferenced query contexts evicted from the query context cache
+/// to make room for new queries.
+constexpr std::string_view kCounterQueryContextCacheEvictions{
+    "presto_cpp.query_context_cache_evictions"};
+/// Time (ms) spent building a new query context (session config conversion
+/// and root memory pool setup), paid by the first task of a query.
+constexpr std::string_view kCounterQueryContextCreationTimeMs{
+    "presto_cpp.query_context_creation_time_ms"};
+/// Number of new query contexts that reused the cached session-to-velox
+/// config conversion of an earlier query with an identical session; see
+/// 'query.session-config-cache-enabled'.
+constexpr std::string_view kCounterSessionConfigCacheHits{
+    "presto_cpp.session_config_cache_hits"};
+/// Number of new query contexts whose session had not been seen before and
+/// ran the full session-to-velox config conversion.
+constexpr std::string_view kCounterSessionConfigCacheMisses{
+    "presto_cpp.session_config_cache_misses"};
 /// Export total bytes used by memory manager (in queries' memory pools).
 constexpr std::string_view kCounterMemoryManagerTotalBytes{
     "presto_cpp.memory_manager_total_bytes"};
+/// Time in ms a split ingestion item spent queued in the fair split
+/// ingestion scheduler before all of its splits were added to the task.
+constexpr std::string_view kCounterSplitIngestionQueueDelayMs{
+    "presto_cpp.split_ingestion_queue_delay_ms"};
+/// Time in ms a spill task spent queued in the fair spill scheduler before
+/// it was released to the spiller executor.
+constexpr std::string_view kCounterSpillerFairQueueWaitMs{
+    "presto_cpp.spiller_fair_queue_wait_ms"};
+/// Number of data splits whose identity was already in the worker's split
+/// affinity history, i.e. repeat splits the local caches likely cover.
+constexpr std::string_view kCounterSplitAffinityHits{
+    "presto_cpp.split_affinity_hits"};
+/// Number of data splits seen for the first time by the worker's split
+/// affinity history.
+constexpr std::string_view kCounterSplitAffinityMisses{
+    "presto_cpp.split_affinity_misses"};
 
 constexpr std::string_view kCounterNumTasks{"presto_cpp.num_tasks"};
 constexpr std::string_view kCounterNumTasksBytesProcessed{
@@ -106,6 +255,14 @@ constexpr std::string_view kCounterNumTasksDeadlock{
     "presto_cpp.num_tasks_deadlock"};
 constexpr std::string_view kCounterNumTaskManagerLockTimeOut{
     "presto_cpp.num_tasks_manager_lock_timeout"};
+/// Time in milliseconds the old-task cleanup sweep spent holding task map
+/// shard locks. Lookups of tasks in the locked shard stall for this long.
+constexpr std::string_view kCounterOldTaskCleanupLockHoldMs{
+    "presto_cpp.old_task_cleanup_lock_hold_ms"};
+/// Number of running tasks aborted because a sibling worker reported the
+/// failure of their query ahead of the coordinator's delete.
+constexpr std::string_view kCounterQueryFailureGossipAbortedTasks{
+    "presto_cpp.query_failure_gossip_aborted_tasks"};
 
 constexpr std::string_view kCounterNumQueuedDrivers{
     "presto_cpp.num_queued_drivers"};
@@ -144,6 +301,119 @@ constexpr std::string_view kCounterOverloaded{"presto_cpp.overloaded"};
 /// planned) in milliseconds.
 constexpr std::string_view kCounterTaskPlannedTimeMs{
     "presto_cpp.task_planned_time_ms"};
+/// Histogram of wall time in milliseconds spent converting a Presto plan
+/// fragment to a velox plan in a task update request.
+constexpr std::string_view kCounterTaskPlanConversionTimeMs{
+    "presto_cpp.task_plan_conversion_time_ms"};
+/// Histogram of wall time in milliseconds from receiving a small task update
+/// request to applying it inline on the IO thread; see
+/// 'task.update-request-inline-max-bytes'.
+constexpr std::string_view kCounterTaskUpdateInlineLatencyMs{
+    "presto_cpp.task_update_inline_latency_ms"};
+/// Histogram of wall time in milliseconds from receiving a task update
+/// request to applying it on the HTTP CPU executor, including the time spent
+/// queued behind other executor work.
+constexpr std::string_view kCounterTaskUpdateOffloadedLatencyMs{
+    "presto_cpp.task_update_offloaded_latency_ms"};
+/// Number of retried task update deliveries answered from the remembered
+/// response of the original delivery without re-parsing or re-applying the
+/// update; see 'task.update-request-dedup-ttl-ms'.
+constexpr std::string_view kCounterTaskUpdateDedupHits{
+    "presto_cpp.task_update_dedup_hits"};
+/// Number of plan fragment conversions served from the plan conversion cache.
+constexpr std::string_view kCounterTaskPlanConversionCacheHits{
+    "presto_cpp.task_plan_conversion_cache_hits"};
+/// Number of plan fragment conversions that ran the converter.
+constexpr std::string_view kCounterTaskPlanConversionCacheMisses{
+    "presto_cpp.task_plan_conversion_cache_misses"};
+/// Number of task updates whose plan fragment parse was served from the
+/// interned fragment cache.
+constexpr std::string_view kCounterTaskFragmentInterningHits{
+    "presto_cpp.task_fragment_interning_hits"};
+/// Number of task updates that parsed and interned their plan fragment.
+constexpr std::string_view kCounterTaskFragmentInterningMisses{
+    "presto_cpp.task_fragment_interning_misses"};
+/// Number of task admissions whose forecasted peak memory exceeded the
+/// arbitrator's free capacity and triggered memory arbitration up front.
+constexpr std::string_view kCounterTaskMemoryForecastArbitrationCount{
+    "presto_cpp.task_memory_forecast_arbitration_count"};
+/// Cumulative operator execution time of GPU (cuDF) operators in finished
+/// tasks, in milliseconds. Only reported by workers built with cuDF support.
+constexpr std::string_view kCounterTaskGpuOperatorTimeMs{
+    "presto_cpp.task_gpu_operator_time_ms"};
+/// Cumulative operator execution time of CPU operators in finished tasks, in
+/// milliseconds. Only reported by workers built with cuDF support; together
+/// with the GPU counter it shows how much work the offload absorbs.
+constexpr std::string_view kCounterTaskCpuOperatorTimeMs{
+    "presto_cpp.task_cpu_operator_time_ms"};
+/// Number of type signature parses served from the process-wide type
+/// signature cache instead of re-running the type parser.
+constexpr std::string_view kCounterTypeParserCacheHits{
+    "presto_cpp.type_parser_cache_hits"};
+/// Number of type signatures that had to be parsed because they were not in
+/// the process-wide type signature cache.
+constexpr std::string_view kCounterTypeParserCacheMisses{
+    "presto_cpp.type_parser_cache_misses"};
+/// Number of sidecar expression optimization calls served from the
+/// process-wide optimized expression cache.
+constexpr std::string_view kCounterExpressionOptimizerCacheHits{
+    "presto_cpp.expression_optimizer_cache_hits"};
+/// Number of sidecar expression optimization calls that ran the optimizer.
+constexpr std::string_view kCounterExpressionOptimizerCacheMisses{
+    "presto_cpp.expression_optimizer_cache_misses"};
+/// Number of subexpressions within one sidecar optimization batch that reused
+/// the optimized form of an identical subexpression from the same batch.
+constexpr std::string_view kCounterExpressionOptimizerBatchDedupCount{
+    "presto_cpp.expression_optimizer_batch_dedup_count"};
+/// Number of sidecar endpoint requests served with a memory pool reused from
+/// the request pool cache.
+constexpr std::string_view kCounterSidecarRequestPoolsReused{
+    "presto_cpp.sidecar_request_pools_reused"};
+/// Number of sidecar endpoint requests for which a new memory pool had to be
+/// created because no cached pool was idle.
+constexpr std::string_view kCounterSidecarRequestPoolsCreated{
+    "presto_cpp.sidecar_request_pools_created"};
+/// Number of Hive split conversions that found the file's decoded metadata in
+/// the worker-level file metadata cache.
+constexpr std::string_view kCounterHiveFileMetadataCacheHits{
+    "presto_cpp.hive_file_metadata_cache_hits"};
+/// Number of Hive split conversions that had to decode the file metadata
+/// because it was missing from the cache or stale.
+constexpr std::string_view kCounterHiveFileMetadataCacheMisses{
+    "presto_cpp.hive_file_metadata_cache_misses"};
+/// Number of entries evicted from the Hive file metadata cache to stay within
+/// its byte budget.
+constexpr std::string_view kCounterHiveFileMetadataCacheEvictions{
+    "presto_cpp.hive_file_metadata_cache_evictions"};
+/// Number of Iceberg split conversions that found a referenced delete file's
+/// converted descriptor in the worker-level delete file cache.
+constexpr std::string_view kCounterIcebergDeleteFileCacheHits{
+    "presto_cpp.iceberg_delete_file_cache_hits"};
+/// Number of Iceberg delete file references that had to be converted because
+/// the descriptor was missing from the cache or stale.
+constexpr std::string_view kCounterIcebergDeleteFileCacheMisses{
+    "presto_cpp.iceberg_delete_file_cache_misses"};
+/// Number of entries evicted from the Iceberg delete file cache to stay
+/// within its byte budget.
+constexpr std::string_view kCounterIcebergDeleteFileCacheEvictions{
+    "presto_cpp.iceberg_delete_file_cache_evictions"};
+/// Number of task creations served straight from the fragment result cache
+/// without running the fragment.
+constexpr std::string_view kCounterFragmentResultCacheHits{
+    "presto_cpp.fragment_result_cache_hits"};
+/// Number of cacheable task creations that missed the fragment result cache
+/// and started capturing their output.
+constexpr std::string_view kCounterFragmentResultCacheMisses{
+    "presto_cpp.fragment_result_cache_misses"};
+/// Number of tasks served from the captured output of an identical fragment
+/// that was already running on this worker when the task arrived; see
+/// 'fragment-result-cache.scan-share-enabled'.
+constexpr std::string_view kCounterScanShareHits{
+    "presto_cpp.scan_share_hits"};
+/// Number of scan-share waiters whose leader never published (failed or
+/// exceeded the capture limit) and that started their own execution.
+constexpr std::string_view kCounterScanShareFallbacks{
+    "presto_cpp.scan_share_fallbacks"};
 /// Exports the current overloaded duration in seconds or 0 if not currently
 /// overloaded.
 constexpr std::string_view kCounterOverloadedDurationSec{
@@ -157,6 +427,23 @@ constexpr std::string_view kCounterTotalPartitionedOutputBuffer{
 /// OutputBufferManager.
 constexpr std::string_view kCounterPartitionedOutputBufferGetDataLatencyMs{
     "presto_cpp.partitioned_output_buffer_get_data_latency_ms"};
+/// Bytes speculatively dequeued from output buffers ahead of the next
+/// getResults request. Used to tune the results prefetch window.
+constexpr std::string_view kCounterTaskResultsPrefetchedBytes{
+    "presto_cpp.task_results_prefetched_bytes"};
+/// Number of getResults requests served from a speculatively dequeued page
+/// sequence without touching the output buffer.
+constexpr std::string_view kCounterTaskResultsPrefetchHits{
+    "presto_cpp.task_results_prefetch_hits"};
+/// Number of getResults requests that had no usable speculatively dequeued
+/// page sequence and went to the output buffer.
+constexpr std::string_view kCounterTaskResultsPrefetchMisses{
+    "presto_cpp.task_results_prefetch_misses"};
+/// Number of tasks whose plan fragment repartitions a remote exchange without
+/// any transformation. Such tasks deserialize every page only to re-serialize
+/// it unchanged; this counter sizes the wasted serde work.
+constexpr std::string_view kCounterPassthroughExchangeStageTasks{
+    "presto_cpp.passthrough_exchange_stage_tasks"};
 /// Worker runtime uptime in seconds after the worker process started.
 constexpr std::string_view kCounterWorkerRuntimeUptimeSecs{
     "presto_cpp.worker_runtime_uptime_secs"};
@@ -219,6 +506,16 @@ constexpr std::string_view kCounterThreadPoolNumTotalTasksFormat{
 constexpr std::string_view kCounterThreadPoolMaxIdleTimeNsFormat{
     "presto_cpp.{}.max_idle_time_ns"};
 
+/// ================== Http Exchange Peer Counters =============
+
+/// Exported only for the top-k peers by p99 latency, to keep the series
+/// cardinality bounded; '{}' is the peer address with dots and colons
+/// replaced by underscores.
+constexpr std::string_view kCounterHttpExchangePeerLatencyP99UsFormat{
+    "presto_cpp.http.exchange_peer.{}.latency_p99_us"};
+constexpr std::string_view kCounterHttpExchangePeerNumRequestErrorsFormat{
+    "presto_cpp.http.exchange_peer.{}.num_request_errors"};
+
 /// ================== EVB Counters ====================
 constexpr std::string_view kCounterExchangeIoEvbViolation{
     "presto_cpp.exchange_io_evb_violation_count"};
@@ -230,6 +527,10 @@ constexpr std::string_view kCounterHttpServerIoEvbViolation{
 /// Number of times memory pushback mechanism is triggered.
 constexpr std::string_view kCounterMemoryPushbackCount{
     "presto_cpp.memory_pushback_count"};
+/// Number of times the graduated memory arbitration step is triggered by the
+/// periodic checker before the hard limit pushback.
+constexpr std::string_view kCounterMemoryPushbackArbitrationCount{
+    "presto_cpp.memory_pushback_arbitration_count"};
 /// Latency distribution of each memory pushback run in range of [0, 100s] and
 /// reports P50, P90, P99, and P100.
 constexpr std::string_view kCounterMemoryPushbackLatencyMs{
@@ -246,4 +547,72 @@ constexpr std::string_view kCounterMemoryPushbackReductionBytes{
 /// meantime.
 constexpr std::string_view kCounterMemoryPushbackExpectedReductionBytes{
     "presto_cpp.memory_pushback_expected_reduction_bytes"};
+/// Number of memory pressure events published on the memory pressure bus.
+constexpr std::string_view kCounterMemoryPressureEventCount{
+    "presto_cpp.memory_pressure_event_count"};
+/// Total bytes reclaimed by memory pressure bus subscribers.
+constexpr std::string_view kCounterMemoryPressureReclaimedBytes{
+    "presto_cpp.memory_pressure_reclaimed_bytes"};
+/// Estimated number of heap allocations made under the protocol serde
+/// allocation tag (task update parsing, TaskInfo serialization),
+/// extrapolated from sampling. Only populated when the worker is built
+/// with PRESTO_ENABLE_ALLOCATION_TRACKING.
+constexpr std::string_view kCounterProtocolSerdeEstimatedAllocCount{
+    "presto_cpp.protocol_serde_estimated_alloc_count"};
+/// Estimated bytes heap-allocated under the protocol serde allocation tag,
+/// extrapolated from sampling. Only populated when the worker is built
+/// with PRESTO_ENABLE_ALLOCATION_TRACKING.
+constexpr std::string_view kCounterProtocolSerdeEstimatedAllocBytes{
+    "presto_cpp.protocol_serde_estimated_alloc_bytes"};
+/// Estimated number of heap allocations made under the exchange allocation
+/// tag (data response processing), extrapolated from sampling. Only
+/// populated when the worker is built with
+/// PRESTO_ENABLE_ALLOCATION_TRACKING.
+constexpr std::string_view kCounterExchangeEstimatedAllocCount{
+    "presto_cpp.exchange_estimated_alloc_count"};
+/// Estimated bytes heap-allocated under the exchange allocation tag,
+/// extrapolated from sampling. Only populated when the worker is built
+/// with PRESTO_ENABLE_ALLOCATION_TRACKING.
+constexpr std::string_view kCounterExchangeEstimatedAllocBytes{
+    "presto_cpp.exchange_estimated_alloc_bytes"};
+/// Uncompressed bytes fed into the compression backend registry's compress
+/// wrappers, across all backends and paths.
+constexpr std::string_view kCounterCompressionBackendCompressInputBytes{
+    "presto_cpp.compression_backend_compress_input_bytes"};
+/// Compressed bytes produced by the compression backend registry's compress
+/// wrappers, across all backends and paths.
+constexpr std::string_view kCounterCompressionBackendCompressOutputBytes{
+    "presto_cpp.compression_backend_compress_output_bytes"};
+/// Compressed bytes fed into the compression backend registry's uncompress
+/// wrappers, across all backends and paths.
+constexpr std::string_view kCounterCompressionBackendUncompressInputBytes{
+    "presto_cpp.compression_backend_uncompress_input_bytes"};
+/// Number of plan fragment conversions that skipped the per-task structural
+/// validation because the update carried a verified coordinator plan
+/// signature; see 'task.trusted-plan-enabled'.
+constexpr std::string_view kCounterTaskTrustedPlanValidationSkipped{
+    "presto_cpp.task_trusted_plan_validation_skipped"};
+/// Number of driver work items that spilled away from their preferred
+/// soft-affinity thread because its queue was saturated. Only populated
+/// when 'driver.soft-affinity-enabled' is set.
+constexpr std::string_view kCounterDriverSoftAffinityMigrations{
+    "presto_cpp.driver_soft_affinity_migrations"};
+/// Number of session sources the slow-task sweep promoted for automatic
+/// query tracing; see 'task.auto-trace-enabled'.
+constexpr std::string_view kCounterAutoTracePromotedSources{
+    "presto_cpp.num_auto_trace_promoted_sources"};
+/// Input rows of deterministic remote rest function calls answered from the
+/// local memo cache instead of the function server; see
+/// 'remote-function-server.rest.memo-cache-max-bytes'.
+constexpr std::string_view kCounterRemoteFunctionMemoCacheHits{
+    "presto_cpp.remote_function_memo_cache_hits"};
+/// Input rows of deterministic remote rest function calls that missed the
+/// local memo cache and were sent to the function server.
+constexpr std::string_view kCounterRemoteFunctionMemoCacheMisses{
+    "presto_cpp.remote_function_memo_cache_misses"};
+/// Distribution of per-call compress throughput through the compression
+/// backend registry, in MB/s of uncompressed input. A hardware engine that
+/// underperforms the software backend shows up here.
+constexpr std::string_view kCounterCompressionBackendCompressThroughputMbPerSec{
+    "presto_cpp.compression_backend_compress_throughput_mb_per_sec"};
 } // namespace facebook::presto
@@ -0,0 +1,227 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/common/CpuProfiler.h"
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <unordered_map>
+
+#include <folly/Demangle.h>
+#include <folly/json.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/process/ThreadDebugInfo.h"
+
+namespace facebook::presto {
+namespace {
+
+int64_t monotonicNowNs() {
+  struct timespec ts;
+  ::clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1'000'000'000LL + ts.tv_nsec;
+}
+
+// Leaf frames belonging to the profiler's own capture path (recordSample,
+// the handler trampoline and the kernel signal frame); dropped from the
+// output so stacks start at the interrupted code.
+constexpr int32_t kSkipLeafFrames = 3;
+
+std::string symbolizeFrame(void* address) {
+  Dl_info info;
+  if (::dladdr(address, &info) != 0 && info.dli_sname != nullptr) {
+    return folly::demangle(info.dli_sname).toStdString();
+  }
+  return fmt::format("{}", address);
+}
+
+} // namespace
+
+// static
+CpuProfiler* CpuProfiler::instance() {
+  static auto* profiler = new CpuProfiler();
+  return profiler;
+}
+
+// static
+void CpuProfiler::onSignal(int /*signal*/) {
+  instance()->recordSample();
+}
+
+// static
+void CpuProfiler::disarmTimer() {
+  struct itimerval timer {};
+  ::setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+void CpuProfiler::start(
+    const std::string& queryId,
+    uint32_t frequencyHz,
+    uint32_t maxSeconds,
+    uint32_t maxSamples) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  VELOX_USER_CHECK(!running_.load(), "A CPU profile is already running");
+  VELOX_USER_CHECK_GT(frequencyHz, 0, "Sampling frequency must be positive");
+
+  frequencyHz_ = std::min(frequencyHz, kMaxFrequencyHz);
+  maxSamples_ = std::min(std::max<uint32_t>(maxSamples, 1), kMaxSamples);
+  const auto durationSeconds =
+      std::min(std::max<uint32_t>(maxSeconds, 1), kMaxDurationSeconds);
+  queryIdFilter_ = queryId;
+  samples_.assign(maxSamples_, Sample{});
+  sampleCount_.store(0);
+  filteredSamples_.store(0);
+  deadlineNs_.store(monotonicNowNs() + durationSeconds * 1'000'000'000LL);
+
+  // The first backtrace() call lazily initializes libgcc's unwinder, which
+  // may allocate; take that hit here instead of inside the signal handler.
+  Sample warmup;
+  warmup.numFrames = ::backtrace(warmup.frames, kMaxFrames);
+
+  struct sigaction action {};
+  action.sa_handler = &CpuProfiler::onSignal;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  VELOX_CHECK_EQ(
+      ::sigaction(SIGPROF, &action, nullptr),
+      0,
+      "Failed to install the SIGPROF handler");
+
+  started_ = true;
+  running_.store(true);
+
+  // ITIMER_PROF counts process CPU time and delivers SIGPROF on the thread
+  // that is running when it expires, so samples land on hot threads in
+  // proportion to their CPU use.
+  struct itimerval timer {};
+  timer.it_interval.tv_usec =
+      std::max<long>(1'000'000L / frequencyHz_, 1'000L);
+  timer.it_value = timer.it_interval;
+  if (::setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    running_.store(false);
+    started_ = false;
+    VELOX_FAIL("Failed to arm the profiling timer");
+  }
+}
+
+void CpuProfiler::recordSample() {
+  if (!running_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (monotonicNowNs() >= deadlineNs_.load(std::memory_order_relaxed)) {
+    // Automatic cutoff. setitimer is async-signal-safe, so the handler can
+    // disarm its own timer; stop() later collects what was sampled.
+    running_.store(false, std::memory_order_release);
+    disarmTimer();
+    return;
+  }
+  if (!queryIdFilter_.empty()) {
+    const auto* info = velox::process::GetThreadDebugInfo();
+    if (info == nullptr || info->queryId_ != queryIdFilter_) {
+      filteredSamples_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+  const auto index = sampleCount_.fetch_add(1, std::memory_order_relaxed);
+  if (index >= maxSamples_) {
+    // Sample budget exhausted; see the deadline cutoff above.
+    running_.store(false, std::memory_order_release);
+    disarmTimer();
+    return;
+  }
+  auto& sample = samples_[index];
+  sample.numFrames = ::backtrace(sample.frames, kMaxFrames);
+}
+
+std::string CpuProfiler::stop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  VELOX_USER_CHECK(started_, "No CPU profile was started");
+  running_.store(false);
+  disarmTimer();
+  started_ = false;
+  // A handler interrupted mid-capture on another thread may still be writing
+  // its slot; give it a beat before the slots are read.
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+  // Fold identical stacks before symbolizing, so each distinct stack and
+  // each distinct frame is resolved once.
+  const auto numSamples = std::min(sampleCount_.load(), maxSamples_);
+  std::map<std::vector<void*>, uint64_t> folded;
+  for (uint32_t i = 0; i < numSamples; ++i) {
+    const auto& sample = samples_[i];
+    if (sample.numFrames <= kSkipLeafFrames) {
+      continue;
+    }
+    std::vector<void*> stack(
+        sample.frames + kSkipLeafFrames, sample.frames + sample.numFrames);
+    ++folded[std::move(stack)];
+  }
+
+  std::unordered_map<void*, std::string> symbolCache;
+  const auto symbolOf = [&symbolCache](void* address) -> const std::string& {
+    auto it = symbolCache.find(address);
+    if (it == symbolCache.end()) {
+      it = symbolCache.emplace(address, symbolizeFrame(address)).first;
+    }
+    return it->second;
+  };
+
+  std::vector<std::pair<uint64_t, std::string>> lines;
+  lines.reserve(folded.size());
+  for (const auto& [stack, count] : folded) {
+    // backtrace() records the leaf first; the collapsed format wants the
+    // root first.
+    std::string line;
+    for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+      if (!line.empty()) {
+        line += ';';
+      }
+      line += symbolOf(*it);
+    }
+    lines.emplace_back(count, std::move(line));
+  }
+  std::sort(lines.begin(), lines.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first > rhs.first;
+  });
+
+  std::string out;
+  for (const auto& [count, line] : lines) {
+    out += fmt::format("{} {}\n", line, count);
+  }
+  // Release the sample buffer; the next start() allocates a fresh one.
+  samples_ = {};
+  return out;
+}
+
+std::string CpuProfiler::status() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  folly::dynamic obj = folly::dynamic::object;
+  obj["running"] = running_.load();
+  obj["started"] = started_;
+  obj["queryId"] = queryIdFilter_;
+  obj["frequencyHz"] = frequencyHz_;
+  obj["samples"] = std::min(sampleCount_.load(), maxSamples_);
+  obj["filteredSamples"] = filteredSamples_.load();
+  obj["maxSamples"] = maxSamples_;
+  return folly::toJson(obj);
+}
+
+} // namespace facebook::presto
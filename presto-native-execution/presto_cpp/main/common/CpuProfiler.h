@@ -0,0 +1,121 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::presto {
+
+/// On-demand CPU sampling profiler, driven over HTTP through the
+/// /v1/operation/server/profile endpoint so a slow worker can be profiled
+/// without host access. Sampling uses the POSIX profiling timer: SIGPROF
+/// fires on whichever thread is consuming CPU when the timer expires, so
+/// samples land on hot threads in proportion to their CPU use and idle
+/// threads cost nothing. The handler captures the thread's stack into a
+/// preallocated slot; stop() symbolizes and folds the stacks into the
+/// collapsed format flame graph tooling consumes.
+///
+/// A profile can be scoped to one query: Velox publishes the query id of the
+/// task a driver thread is running in its per-thread debug info, and the
+/// handler drops samples from threads whose debug info does not match.
+/// Threads doing work for the query outside a driver (exchange, HTTP) carry
+/// no debug info and are not attributed.
+///
+/// Built for production use: only one profile runs at a time, frequency and
+/// duration are clamped to hard caps, the sample buffer is bounded and
+/// preallocated up front, and sampling disarms itself from the handler when
+/// the deadline or the sample budget is reached, so an abandoned profile
+/// costs nothing beyond its buffer until the next start() reclaims it.
+class CpuProfiler {
+ public:
+  /// Hard caps protecting production hosts; start() clamps its arguments to
+  /// these regardless of what the caller asks for.
+  static constexpr uint32_t kMaxFrequencyHz = 1000;
+  static constexpr uint32_t kMaxDurationSeconds = 300;
+  static constexpr uint32_t kMaxSamples = 1 << 18;
+
+  /// Frames captured per sample; deeper stacks are truncated at the leaf end.
+  static constexpr int32_t kMaxFrames = 64;
+
+  /// Returns the process-wide instance.
+  static CpuProfiler* instance();
+
+  /// Starts sampling at 'frequencyHz'. 'queryId' restricts samples to driver
+  /// threads currently running that query; empty profiles the whole process.
+  /// Sampling stops by itself after 'maxSeconds' or 'maxSamples' samples,
+  /// whichever comes first. Throws when a profile is already running.
+  void start(
+      const std::string& queryId,
+      uint32_t frequencyHz,
+      uint32_t maxSeconds,
+      uint32_t maxSamples);
+
+  /// Stops sampling, or collects the result of a profile that hit an
+  /// automatic cutoff, and returns the profile in collapsed stack format:
+  /// one "frame;frame;frame count" line per distinct stack, root first,
+  /// heaviest stack first. Throws when no profile was started.
+  std::string stop();
+
+  /// Returns a JSON status line: whether sampling is running, the query
+  /// filter, the sampling frequency and the samples collected so far.
+  std::string status() const;
+
+ private:
+  CpuProfiler() = default;
+
+  // Signal handler trampoline and the per-sample capture it delegates to.
+  static void onSignal(int signal);
+  void recordSample();
+
+  // Disarms the profiling timer. Only async-signal-safe calls, so the
+  // handler can invoke it when a cutoff is reached.
+  static void disarmTimer();
+
+  struct Sample {
+    int32_t numFrames{0};
+    void* frames[kMaxFrames];
+  };
+
+  // Serializes start()/stop()/status() against each other; never taken by
+  // the signal handler.
+  mutable std::mutex mutex_;
+
+  // True while the handler records samples; cleared by the handler itself on
+  // an automatic cutoff.
+  std::atomic<bool> running_{false};
+
+  // Next free slot in 'samples_'; may briefly exceed 'maxSamples_' when the
+  // buffer is full.
+  std::atomic<uint32_t> sampleCount_{0};
+
+  // Samples dropped because the thread did not match the query filter.
+  std::atomic<uint32_t> filteredSamples_{0};
+
+  // CLOCK_MONOTONIC deadline after which the handler disarms the timer.
+  std::atomic<int64_t> deadlineNs_{0};
+
+  // Set between start() and stop(). 'samples_' slots are written by the
+  // handler only while 'running_' is set.
+  bool started_{false};
+  std::string queryIdFilter_;
+  uint32_t frequencyHz_{0};
+  uint32_t maxSamples_{0};
+  std::vector<Sample> samples_;
+};
+
+} // namespace facebook::presto
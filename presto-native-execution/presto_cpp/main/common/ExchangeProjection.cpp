@@ -0,0 +1,95 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/common/ExchangeProjection.h"
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include <algorithm>
+
+namespace facebook::presto {
+namespace {
+
+// Returns the 'queryId.stageId' prefix of a task id, or an empty string when
+// the task id does not have the expected dotted form.
+std::string stageKey(const std::string& taskId) {
+  const auto firstDot = taskId.find('.');
+  if (firstDot == std::string::npos) {
+    return "";
+  }
+  const auto secondDot = taskId.find('.', firstDot + 1);
+  if (secondDot == std::string::npos) {
+    return "";
+  }
+  return taskId.substr(0, secondDot);
+}
+
+} // namespace
+
+// static
+ExchangeProjectionRegistry* ExchangeProjectionRegistry::instance() {
+  static auto* registry = new ExchangeProjectionRegistry();
+  return registry;
+}
+
+void ExchangeProjectionRegistry::registerMask(
+    const std::string& queryId,
+    const std::string& fragmentId,
+    const std::vector<int32_t>& columns) {
+  if (columns.empty()) {
+    return;
+  }
+  auto key = fmt::format("{}.{}", queryId, fragmentId);
+  masks_.withWLock([&](auto& masks) {
+    auto it = masks.find(key);
+    if (it == masks.end()) {
+      if (masks.size() >= kMaxMasks) {
+        masks.clear();
+      }
+      masks.emplace(std::move(key), columns);
+      return;
+    }
+    // Widen to the union so every registered consumer keeps the columns it
+    // needs.
+    std::vector<int32_t> merged;
+    merged.reserve(it->second.size() + columns.size());
+    std::set_union(
+        it->second.begin(),
+        it->second.end(),
+        columns.begin(),
+        columns.end(),
+        std::back_inserter(merged));
+    it->second = std::move(merged);
+  });
+}
+
+std::string ExchangeProjectionRegistry::maskFor(
+    const std::string& taskId) const {
+  const auto key = stageKey(taskId);
+  if (key.empty()) {
+    return "";
+  }
+  return masks_.withRLock([&](const auto& masks) -> std::string {
+    auto it = masks.find(key);
+    if (it == masks.end()) {
+      return "";
+    }
+    return folly::join(',', it->second);
+  });
+}
+
+void ExchangeProjectionRegistry::testingClear() {
+  masks_.wlock()->clear();
+}
+
+} // namespace facebook::presto
@@ -0,0 +1,65 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook::presto {
+
+/// Process-wide registry of cross-stage exchange column masks, gated by
+/// 'exchange.selective-columns-enabled'.
+///
+/// When a fragment reads an exchange and immediately projects away part of
+/// it, every column of the upstream output still travels the wire. The
+/// consumer-side plan conversion records here, per producing fragment, which
+/// columns of the exchange row the consumer actually references. The exchange
+/// client looks the mask up by the producing task id and sends it with each
+/// results fetch, and the producing worker nulls out the unused columns
+/// before serving the pages (see TaskManager). The mask is advisory: a
+/// producer that cannot apply it serves the full pages and the consumer
+/// simply ignores the columns as before.
+class ExchangeProjectionRegistry {
+ public:
+  static ExchangeProjectionRegistry* instance();
+
+  /// Records the zero-based, ascending column indices of the exchange output
+  /// that the consumer references. 'queryId' and 'fragmentId' identify the
+  /// producing stage. Re-registration merges with the previously recorded
+  /// mask, so concurrent consumers of the same stage widen it to the union.
+  void registerMask(
+      const std::string& queryId,
+      const std::string& fragmentId,
+      const std::vector<int32_t>& columns);
+
+  /// Returns the comma-separated mask registered for the stage producing
+  /// 'taskId' ('queryId.stageId.…'), or an empty string when none is known.
+  std::string maskFor(const std::string& taskId) const;
+
+  /// Testing only.
+  void testingClear();
+
+ private:
+  // Bounds the registry; reaching the cap clears it, which only costs the
+  // affected queries their masks, not correctness.
+  static constexpr size_t kMaxMasks = 4096;
+
+  // Keyed by 'queryId.fragmentId' of the producing stage.
+  folly::Synchronized<std::unordered_map<std::string, std::vector<int32_t>>>
+      masks_;
+};
+
+} // namespace facebook::presto
@@ -0,0 +1,191 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/common/HugePageArena.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::presto {
+
+// static
+HugePageArena* HugePageArena::instance() {
+  static const std::unique_ptr<HugePageArena> arena =
+      []() -> std::unique_ptr<HugePageArena> {
+    const uint64_t capacity =
+        SystemConfig::instance()->exchangeHugePageArenaBytes();
+    if (capacity == 0) {
+      return nullptr;
+    }
+    auto created = std::make_unique<HugePageArena>(capacity);
+    if (created->start_ == nullptr) {
+      return nullptr;
+    }
+    return created;
+  }();
+  return arena.get();
+}
+
+HugePageArena::HugePageArena(uint64_t capacityBytes) {
+  capacityBytes = velox::bits::roundUp(capacityBytes, kHugePageBytes);
+#ifdef __linux__
+  // Explicit 2MB pages first: MAP_POPULATE makes the mapping fail up front
+  // when the system has not reserved enough huge pages, instead of taking a
+  // SIGBUS on first touch.
+  void* mapped = ::mmap(
+      nullptr,
+      capacityBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE,
+      -1,
+      0);
+  if (mapped != MAP_FAILED) {
+    start_ = reinterpret_cast<uint8_t*>(mapped);
+    capacity_ = capacityBytes;
+    hugePagesBacked_ = true;
+  } else {
+    // Fall back to a plain anonymous mapping aligned to the huge page size
+    // and advised for transparent huge pages. Over-map by one huge page and
+    // trim so the region starts on a 2MB boundary.
+    const uint64_t mapBytes = capacityBytes + kHugePageBytes;
+    void* raw = ::mmap(
+        nullptr,
+        mapBytes,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+    if (raw == MAP_FAILED) {
+      LOG(WARNING) << "Failed to map " << mapBytes
+                   << " bytes for the exchange huge page arena, arena disabled";
+      return;
+    }
+    const auto rawAddr = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t alignedAddr =
+        velox::bits::roundUp(rawAddr, kHugePageBytes);
+    if (alignedAddr > rawAddr) {
+      ::munmap(raw, alignedAddr - rawAddr);
+    }
+    const uintptr_t rawEnd = rawAddr + mapBytes;
+    const uintptr_t alignedEnd = alignedAddr + capacityBytes;
+    if (rawEnd > alignedEnd) {
+      ::munmap(reinterpret_cast<void*>(alignedEnd), rawEnd - alignedEnd);
+    }
+    start_ = reinterpret_cast<uint8_t*>(alignedAddr);
+    capacity_ = capacityBytes;
+#ifdef MADV_HUGEPAGE
+    if (::madvise(start_, capacity_, MADV_HUGEPAGE) != 0) {
+      // Still usable on 4KB pages, just without the TLB benefit.
+      LOG(WARNING)
+          << "madvise(MADV_HUGEPAGE) failed for the exchange huge page arena";
+    }
+#endif
+  }
+  freeRuns_.emplace(0, capacity_);
+#else
+  LOG(WARNING)
+      << "Huge page backed exchange buffers are only supported on Linux";
+#endif
+}
+
+HugePageArena::~HugePageArena() {
+#ifdef __linux__
+  if (start_ != nullptr) {
+    ::munmap(start_, capacity_);
+  }
+#endif
+}
+
+void* HugePageArena::allocate(uint64_t bytes) {
+  const uint64_t runBytes = velox::bits::roundUp(bytes, kGranuleBytes);
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    // First fit: free runs are kept in offset order and coalesced on free,
+    // so the scan also packs allocations toward the start of the region.
+    for (auto it = freeRuns_.begin(); it != freeRuns_.end(); ++it) {
+      if (it->second >= runBytes) {
+        const uint64_t offset = it->first;
+        const uint64_t remainingBytes = it->second - runBytes;
+        freeRuns_.erase(it);
+        if (remainingBytes > 0) {
+          freeRuns_.emplace(offset + runBytes, remainingBytes);
+        }
+        usedBytes_ += runBytes;
+        ++numAllocations_;
+        return start_ + offset;
+      }
+    }
+    ++numFallbacks_;
+  }
+  RECORD_METRIC_VALUE(kCounterExchangeHugePageArenaFallbackCount);
+  return nullptr;
+}
+
+void HugePageArena::free(void* data, uint64_t bytes) {
+  const uint64_t runBytes = velox::bits::roundUp(bytes, kGranuleBytes);
+  VELOX_CHECK(contains(data), "Freed buffer is not from the huge page arena");
+  const uint64_t offset = reinterpret_cast<uint8_t*>(data) - start_;
+  VELOX_CHECK_LE(offset + runBytes, capacity_);
+
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = freeRuns_.emplace(offset, runBytes).first;
+  auto next = std::next(it);
+  if (next != freeRuns_.end() && it->first + it->second == next->first) {
+    it->second += next->second;
+    freeRuns_.erase(next);
+  }
+  if (it != freeRuns_.begin()) {
+    auto prev = std::prev(it);
+    if (prev->first + prev->second == it->first) {
+      prev->second += it->second;
+      freeRuns_.erase(it);
+    }
+  }
+  usedBytes_ -= runBytes;
+}
+
+HugePageArena::Stats HugePageArena::stats() const {
+  Stats stats;
+  stats.capacityBytes = capacity_;
+  std::lock_guard<std::mutex> l(mutex_);
+  stats.usedBytes = usedBytes_;
+  stats.numAllocations = numAllocations_;
+  stats.numFallbacks = numFallbacks_;
+  stats.numFreeRuns = freeRuns_.size();
+  for (const auto& [offset, runBytes] : freeRuns_) {
+    stats.largestFreeRunBytes = std::max(stats.largestFreeRunBytes, runBytes);
+  }
+  return stats;
+}
+
+// static
+void HugePageArena::freeTo(
+    velox::memory::MemoryPool* pool,
+    void* data,
+    uint64_t bytes) {
+  auto* arena = instance();
+  if (arena != nullptr && arena->contains(data)) {
+    arena->free(data, bytes);
+    return;
+  }
+  pool->free(data, bytes);
+}
+
+} // namespace facebook::presto
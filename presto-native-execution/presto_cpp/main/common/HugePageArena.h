@@ -0,0 +1,111 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+#include "velox/common/memory/MemoryPool.h"
+
+namespace facebook::presto {
+
+/// A 2MB-page backed arena for exchange response buffers. Exchange traffic
+/// cycles through large, short-lived buffers at a high rate; backing them
+/// with regular 4KB pages makes deserialization TLB-miss bound on busy
+/// workers. The arena maps one contiguous region at startup, backed by
+/// explicit 2MB pages when the system has them reserved and otherwise by a
+/// transparent-hugepage-advised anonymous mapping, and hands out buffers
+/// from it in 64KB granules. When the region cannot be mapped, or a request
+/// does not fit in any free run, callers fall back to their regular velox
+/// memory pool allocation, so the arena is strictly an optimization.
+///
+/// Arena memory is reserved up front and bounded by
+/// 'exchange.hugepage-arena-size'; it is not tracked by the velox memory
+/// pools, which is the same position proxygen-owned response buffers are in
+/// when buffer copy is disabled. Usage and fragmentation are exported
+/// through the periodic stats sweep.
+class HugePageArena {
+ public:
+  /// Point-in-time usage and fragmentation of the arena.
+  struct Stats {
+    uint64_t capacityBytes{0};
+    uint64_t usedBytes{0};
+    /// Total buffers handed out since startup.
+    uint64_t numAllocations{0};
+    /// Allocations that did not fit in any free run and fell back to the
+    /// caller's memory pool.
+    uint64_t numFallbacks{0};
+    /// Number of discontiguous free runs; grows with fragmentation.
+    uint64_t numFreeRuns{0};
+    uint64_t largestFreeRunBytes{0};
+  };
+
+  /// Returns the process-wide arena, created from SystemConfig on first
+  /// use. Returns nullptr when 'exchange.hugepage-arena-size' is zero or
+  /// the backing region could not be mapped.
+  static HugePageArena* instance();
+
+  /// 'capacityBytes' is rounded up to a multiple of the 2MB page size.
+  /// Production code uses instance(); the constructor is exposed for tests.
+  explicit HugePageArena(uint64_t capacityBytes);
+
+  ~HugePageArena();
+
+  /// Returns a buffer of at least 'bytes' bytes, rounded up to the 64KB
+  /// allocation granule, or nullptr when no free run fits. The caller is
+  /// expected to fall back to its regular allocation path on nullptr.
+  void* allocate(uint64_t bytes);
+
+  /// Returns a buffer obtained from allocate() with the same 'bytes'.
+  void free(void* data, uint64_t bytes);
+
+  /// Returns true if 'data' points into the arena region.
+  bool contains(const void* data) const {
+    return data >= start_ &&
+        data < start_ + capacity_;
+  }
+
+  /// True if the region is backed by explicit 2MB pages rather than a
+  /// transparent-hugepage-advised plain mapping.
+  bool backedByHugePages() const {
+    return hugePagesBacked_;
+  }
+
+  Stats stats() const;
+
+  /// Frees 'data' of 'bytes' bytes to the arena if it owns it and to 'pool'
+  /// otherwise. Exchange buffer consumers free through this so they need
+  /// not track whether an allocation came from the arena or from the pool
+  /// fallback.
+  static void freeTo(velox::memory::MemoryPool* pool, void* data, uint64_t bytes);
+
+ private:
+  static constexpr uint64_t kHugePageBytes = uint64_t{2} << 20;
+  static constexpr uint64_t kGranuleBytes = uint64_t{64} << 10;
+
+  // Region start; nullptr when mapping failed.
+  uint8_t* start_{nullptr};
+  uint64_t capacity_{0};
+  bool hugePagesBacked_{false};
+
+  mutable std::mutex mutex_;
+  // Free runs by region offset, coalesced on free. Protected by 'mutex_'.
+  std::map<uint64_t, uint64_t> freeRuns_;
+  uint64_t usedBytes_{0};
+  uint64_t numAllocations_{0};
+  uint64_t numFallbacks_{0};
+};
+
+} // namespace facebook::presto
@@ -0,0 +1,135 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/common/LocalDiskIoScheduler.h"
+
+#include <chrono>
+#include <thread>
+
+#include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::presto {
+namespace {
+
+// Classes with no traffic for this long stop taking part in the bandwidth
+// split, handing their share to the remaining active classes.
+constexpr uint64_t kActiveWindowMicros{5'000'000};
+
+// A class may burst up to one second worth of its rate before it is paced.
+constexpr double kBurstSeconds{1.0};
+
+// Upper bound on a single acquire() sleep so an oversized transfer cannot
+// stall its caller indefinitely; the remaining debt paces later transfers.
+constexpr uint64_t kMaxWaitMicros{1'000'000};
+
+std::string_view counterForIoClass(LocalDiskIoScheduler::IoClass ioClass) {
+  switch (ioClass) {
+    case LocalDiskIoScheduler::IoClass::kSpill:
+      return kCounterLocalDiskIoSpillBytes;
+    case LocalDiskIoScheduler::IoClass::kShuffleWrite:
+      return kCounterLocalDiskIoShuffleWriteBytes;
+    case LocalDiskIoScheduler::IoClass::kShuffleRead:
+      return kCounterLocalDiskIoShuffleReadBytes;
+    case LocalDiskIoScheduler::IoClass::kBroadcast:
+      return kCounterLocalDiskIoBroadcastBytes;
+  }
+  VELOX_UNREACHABLE();
+}
+} // namespace
+
+LocalDiskIoScheduler::LocalDiskIoScheduler(uint64_t maxBandwidthBytesPerSec)
+    : maxBandwidthBytesPerSec_(maxBandwidthBytesPerSec) {}
+
+// static
+LocalDiskIoScheduler* LocalDiskIoScheduler::instance() {
+  static LocalDiskIoScheduler scheduler(
+      SystemConfig::instance()->localDiskIoMaxBandwidthBytesPerSecond());
+  return &scheduler;
+}
+
+double LocalDiskIoScheduler::classRate(IoClass ioClass, uint64_t nowMicros)
+    const {
+  uint32_t activeWeights{0};
+  for (size_t i = 0; i < kNumIoClasses; ++i) {
+    if (classes_[i].lastActiveMicros + kActiveWindowMicros >= nowMicros) {
+      activeWeights += kClassWeights[i];
+    }
+  }
+  // The caller is always active, so 'activeWeights' is never zero.
+  return static_cast<double>(maxBandwidthBytesPerSec_) *
+      kClassWeights[static_cast<size_t>(ioClass)] / activeWeights;
+}
+
+void LocalDiskIoScheduler::acquire(IoClass ioClass, uint64_t bytes) {
+  RECORD_METRIC_VALUE(counterForIoClass(ioClass), bytes);
+  if (maxBandwidthBytesPerSec_ == 0 || bytes == 0) {
+    return;
+  }
+  const auto waitMicros =
+      acquireAt(ioClass, bytes, velox::getCurrentTimeMicro());
+  if (waitMicros > 0) {
+    RECORD_METRIC_VALUE(
+        kCounterLocalDiskIoThrottledTimeMs, waitMicros / 1'000);
+    std::this_thread::sleep_for(std::chrono::microseconds(waitMicros));
+  }
+}
+
+uint64_t LocalDiskIoScheduler::acquireAt(
+    IoClass ioClass,
+    uint64_t bytes,
+    uint64_t nowMicros) {
+  if (maxBandwidthBytesPerSec_ == 0 || bytes == 0) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& state = classes_[static_cast<size_t>(ioClass)];
+  state.lastActiveMicros = nowMicros;
+  const auto rate = classRate(ioClass, nowMicros);
+  const auto elapsedSeconds =
+      (nowMicros - std::min(state.lastRefillMicros, nowMicros)) / 1e6;
+  state.lastRefillMicros = nowMicros;
+  state.credit =
+      std::min(state.credit + elapsedSeconds * rate, rate * kBurstSeconds);
+  state.credit -= bytes;
+  if (state.credit >= 0) {
+    return 0;
+  }
+  return std::min<uint64_t>(
+      static_cast<uint64_t>(-state.credit / rate * 1e6), kMaxWaitMicros);
+}
+
+void LocalDiskIoScheduler::recordExternal(IoClass ioClass, uint64_t bytes) {
+  if (bytes == 0) {
+    return;
+  }
+  RECORD_METRIC_VALUE(counterForIoClass(ioClass), bytes);
+  if (maxBandwidthBytesPerSec_ == 0) {
+    return;
+  }
+  const auto nowMicros = velox::getCurrentTimeMicro();
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& state = classes_[static_cast<size_t>(ioClass)];
+  state.lastActiveMicros = nowMicros;
+  // Charge the bytes but cap the debt at one burst: external traffic is
+  // reported in coarse batches and should shift the bandwidth split, not
+  // starve the class once the batch has long passed.
+  const auto rate = classRate(ioClass, nowMicros);
+  state.credit =
+      std::max(state.credit - bytes, -rate * kBurstSeconds);
+  state.lastRefillMicros = nowMicros;
+}
+
+} // namespace facebook::presto
@@ -0,0 +1,101 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+namespace facebook::presto {
+
+/// Worker-wide scheduler for local disk I/O. Spill, shuffle and broadcast
+/// traffic all land on the same local drives; when a large sort spills in the
+/// middle of a shuffle-heavy stage the two paths thrash the disk and tail
+/// latencies spike. The scheduler divides the aggregate bandwidth configured
+/// via 'local-disk.io-max-bandwidth-bytes-per-second' between I/O classes in
+/// proportion to their weights, counting only classes that saw traffic
+/// recently so an idle class does not strand bandwidth. Callers account each
+/// transfer through acquire(), which sleeps just long enough to keep the
+/// class within its share. Without a bandwidth cap acquire() only records the
+/// per-class byte counters.
+///
+/// Spill I/O is issued inside Velox and cannot be routed through acquire();
+/// the periodic task stats sweep feeds observed spill bytes into the spill
+/// class via recordExternal() instead, so active spilling shrinks the shuffle
+/// and broadcast shares without delaying the spiller itself.
+class LocalDiskIoScheduler {
+ public:
+  enum class IoClass {
+    kSpill = 0,
+    kShuffleWrite = 1,
+    kShuffleRead = 2,
+    kBroadcast = 3,
+  };
+  static constexpr size_t kNumIoClasses{4};
+
+  /// Relative bandwidth shares of the I/O classes, indexed by IoClass. Spill
+  /// and shuffle write carry the data that must reach disk for queries to
+  /// make progress, so they weigh twice as much as the read-side classes.
+  static constexpr std::array<uint32_t, kNumIoClasses> kClassWeights{
+      2,
+      2,
+      1,
+      1};
+
+  /// 'maxBandwidthBytesPerSec' caps the aggregate local disk throughput; 0
+  /// disables throttling and keeps only the byte accounting.
+  explicit LocalDiskIoScheduler(uint64_t maxBandwidthBytesPerSec);
+
+  /// Returns the process-wide instance, configured from SystemConfig on
+  /// first use.
+  static LocalDiskIoScheduler* instance();
+
+  /// Accounts 'bytes' of traffic for 'ioClass' and sleeps until the class's
+  /// weighted bandwidth share admits the transfer. Called around the actual
+  /// filesystem read or write.
+  void acquire(IoClass ioClass, uint64_t bytes);
+
+  /// Accounts traffic performed outside the scheduler, e.g. spill writes
+  /// issued by Velox. Never sleeps: the bytes are charged against the class
+  /// so the other classes back off, but the caller is not delayed.
+  void recordExternal(IoClass ioClass, uint64_t bytes);
+
+  /// Testing variant of acquire() taking an explicit clock and returning the
+  /// microseconds the caller should wait instead of sleeping.
+  uint64_t acquireAt(IoClass ioClass, uint64_t bytes, uint64_t nowMicros);
+
+ private:
+  struct ClassState {
+    // Bandwidth credit in bytes. Goes negative when a transfer overdraws the
+    // class's share, delaying its subsequent transfers until refills pay the
+    // debt back.
+    double credit{0};
+    // Last time credit was refilled for this class.
+    uint64_t lastRefillMicros{0};
+    // Last time this class saw traffic. Only recently active classes take
+    // part in the bandwidth split.
+    uint64_t lastActiveMicros{0};
+  };
+
+  // Bytes per second the given class is entitled to, given which classes are
+  // active at 'nowMicros'. Called with 'mutex_' held.
+  double classRate(IoClass ioClass, uint64_t nowMicros) const;
+
+  const uint64_t maxBandwidthBytesPerSec_;
+
+  mutable std::mutex mutex_;
+  std::array<ClassState, kNumIoClasses> classes_;
+};
+
+} // namespace facebook::presto
@@ -0,0 +1,145 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/common/MemoryPressureBus.h"
+
+#include <algorithm>
+
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::presto {
+
+// static
+std::string_view MemoryPressureBus::levelName(Level level) {
+  switch (level) {
+    case Level::kWarn:
+      return "WARN";
+    case Level::kCritical:
+      return "CRITICAL";
+    case Level::kEmergency:
+      return "EMERGENCY";
+  }
+  return "UNKNOWN";
+}
+
+// static
+MemoryPressureBus* MemoryPressureBus::instance() {
+  static auto instance = std::make_unique<MemoryPressureBus>();
+  return instance.get();
+}
+
+void MemoryPressureBus::subscribe(
+    const std::string& name,
+    int32_t priority,
+    ReclaimCallback callback) {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& subscriber : subscribers_) {
+    if (subscriber.name == name) {
+      subscriber.priority = priority;
+      subscriber.callback = std::move(callback);
+      std::stable_sort(
+          subscribers_.begin(),
+          subscribers_.end(),
+          [](const auto& left, const auto& right) {
+            return left.priority < right.priority;
+          });
+      return;
+    }
+  }
+  Subscriber subscriber{name, priority, std::move(callback)};
+  auto it = std::find_if(
+      subscribers_.begin(), subscribers_.end(), [&](const auto& existing) {
+        return existing.priority > priority;
+      });
+  subscribers_.insert(it, std::move(subscriber));
+}
+
+void MemoryPressureBus::unsubscribe(const std::string& name) {
+  std::lock_guard<std::mutex> l(mutex_);
+  subscribers_.erase(
+      std::remove_if(
+          subscribers_.begin(),
+          subscribers_.end(),
+          [&](const auto& subscriber) { return subscriber.name == name; }),
+      subscribers_.end());
+}
+
+uint64_t MemoryPressureBus::publish(Level level, uint64_t targetBytes) {
+  // Snapshot the callbacks so subscribers run outside the bus lock and may
+  // themselves subscribe or unsubscribe without deadlocking.
+  std::vector<std::pair<std::string, ReclaimCallback>> callbacks;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    callbacks.reserve(subscribers_.size());
+    for (const auto& subscriber : subscribers_) {
+      callbacks.emplace_back(subscriber.name, subscriber.callback);
+    }
+  }
+
+  uint64_t totalReclaimed{0};
+  for (const auto& [name, callback] : callbacks) {
+    if (totalReclaimed >= targetBytes) {
+      break;
+    }
+    uint64_t reclaimed{0};
+    try {
+      reclaimed = callback(level, targetBytes - totalReclaimed);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Memory pressure subscriber '" << name
+                 << "' failed: " << e.what();
+    }
+    totalReclaimed += reclaimed;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      for (auto& subscriber : subscribers_) {
+        if (subscriber.name == name) {
+          ++subscriber.invocations;
+          subscriber.reclaimedBytes += reclaimed;
+          break;
+        }
+      }
+    }
+  }
+
+  RECORD_METRIC_VALUE(kCounterMemoryPressureEventCount);
+  RECORD_METRIC_VALUE(kCounterMemoryPressureReclaimedBytes, totalReclaimed);
+  LOG(INFO) << "Memory pressure event (" << levelName(level) << "): reclaimed "
+            << velox::succinctBytes(totalReclaimed) << " of "
+            << velox::succinctBytes(targetBytes) << " target across "
+            << callbacks.size() << " subscribers";
+  return totalReclaimed;
+}
+
+std::vector<MemoryPressureBus::SubscriberStats> MemoryPressureBus::stats()
+    const {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::vector<SubscriberStats> stats;
+  stats.reserve(subscribers_.size());
+  for (const auto& subscriber : subscribers_) {
+    stats.push_back(
+        {subscriber.name,
+         subscriber.priority,
+         subscriber.invocations,
+         subscriber.reclaimedBytes});
+  }
+  return stats;
+}
+
+void MemoryPressureBus::testingClear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  subscribers_.clear();
+}
+
+} // namespace facebook::presto
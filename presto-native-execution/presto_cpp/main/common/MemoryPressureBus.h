@@ -0,0 +1,103 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace facebook::presto {
+
+/// Worker-wide bus connecting the periodic memory checker to subsystems that
+/// can shed memory on demand (caches, pooled buffers). The checker publishes
+/// a leveled pressure event with a reclaim target; subscribers registered
+/// with a priority are invoked in ascending priority order until the target
+/// is met, so the response is ordered (cheap cache evictions before
+/// disruptive reactions) instead of each subsystem reacting on its own.
+/// Per-subscriber reclaimed bytes are tracked to keep the pressure response
+/// observable.
+class MemoryPressureBus {
+ public:
+  /// Severity of a pressure event. kWarn is published at the graduated
+  /// arbitration watermark, kCritical when the hard system memory limit is
+  /// exceeded, and kEmergency as the last call before queries are aborted.
+  enum class Level {
+    kWarn = 0,
+    kCritical = 1,
+    kEmergency = 2,
+  };
+
+  static std::string_view levelName(Level level);
+
+  /// Invoked with the published level and the bytes still wanted when the
+  /// subscriber runs. Returns the number of bytes the subscriber released.
+  using ReclaimCallback =
+      std::function<uint64_t(Level level, uint64_t targetBytes)>;
+
+  static MemoryPressureBus* instance();
+
+  /// Registers 'callback' under 'name'. Subscribers run in ascending
+  /// 'priority' order, ties in registration order, so cheap evictions should
+  /// use lower priorities than reactions that slow queries down.
+  /// Re-registering an existing name replaces its callback and priority but
+  /// keeps its accumulated stats.
+  void subscribe(
+      const std::string& name,
+      int32_t priority,
+      ReclaimCallback callback);
+
+  /// Removes the subscriber registered under 'name', if any. A subsystem
+  /// with a shorter lifetime than the process must unsubscribe before the
+  /// state its callback captures is destroyed.
+  void unsubscribe(const std::string& name);
+
+  /// Publishes a pressure event asking subscribers to release 'targetBytes'.
+  /// Subscribers run outside the bus lock, each seeing the bytes still
+  /// outstanding, and the walk stops once the running total reaches the
+  /// target. A subscriber that throws is logged and counted as releasing
+  /// nothing. Returns the total bytes reclaimed.
+  uint64_t publish(Level level, uint64_t targetBytes);
+
+  /// Reclaim totals for one subscriber.
+  struct SubscriberStats {
+    std::string name;
+    int32_t priority;
+    uint64_t invocations{0};
+    uint64_t reclaimedBytes{0};
+  };
+
+  /// Returns per-subscriber totals, in the order subscribers run.
+  std::vector<SubscriberStats> stats() const;
+
+  /// Testing only. Drops all subscribers and their stats.
+  void testingClear();
+
+ private:
+  struct Subscriber {
+    std::string name;
+    int32_t priority;
+    ReclaimCallback callback;
+    uint64_t invocations{0};
+    uint64_t reclaimedBytes{0};
+  };
+
+  mutable std::mutex mutex_;
+  // Kept sorted by ascending priority, ties in registration order.
+  std::vector<Subscriber> subscribers_;
+};
+
+} // namespace facebook::presto
@@ -0,0 +1,135 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/common/NumaTopology.h"
+
+#include <fmt/format.h>
+#include <folly/Conv.h>
+#include <folly/String.h>
+#include <glog/logging.h>
+
+#include <fstream>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::presto {
+namespace {
+
+bool readSysFile(const std::string& path, std::string& out) {
+  std::ifstream in(path);
+  if (!in.is_open()) {
+    return false;
+  }
+  std::getline(in, out);
+  return !in.fail();
+}
+
+} // namespace
+
+std::vector<int32_t> parseCpuList(const std::string& cpuList) {
+  std::vector<int32_t> cpus;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(cpuList), ranges, true);
+  for (const auto& range : ranges) {
+    const auto dash = range.find('-');
+    if (dash == std::string::npos) {
+      auto cpu = folly::tryTo<int32_t>(range);
+      if (cpu.hasValue()) {
+        cpus.push_back(cpu.value());
+      }
+      continue;
+    }
+    auto first = folly::tryTo<int32_t>(range.subpiece(0, dash));
+    auto last = folly::tryTo<int32_t>(range.subpiece(dash + 1));
+    if (!first.hasValue() || !last.hasValue()) {
+      continue;
+    }
+    for (auto cpu = first.value(); cpu <= last.value(); ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::vector<NumaNode> numaNodes() {
+  std::vector<NumaNode> nodes;
+#ifdef __linux__
+  std::string onlineList;
+  if (!readSysFile("/sys/devices/system/node/online", onlineList)) {
+    return nodes;
+  }
+  for (auto nodeId : parseCpuList(onlineList)) {
+    std::string cpuList;
+    if (!readSysFile(
+            fmt::format("/sys/devices/system/node/node{}/cpulist", nodeId),
+            cpuList)) {
+      continue;
+    }
+    auto cpus = parseCpuList(cpuList);
+    if (cpus.empty()) {
+      // CPU-less (memory-only) nodes cannot host threads.
+      continue;
+    }
+    nodes.push_back({nodeId, std::move(cpus)});
+  }
+#endif
+  return nodes;
+}
+
+int32_t numaNodeOfNetworkInterface(const std::string& interfaceName) {
+#ifdef __linux__
+  std::string node;
+  if (!readSysFile(
+          fmt::format("/sys/class/net/{}/device/numa_node", interfaceName),
+          node)) {
+    return -1;
+  }
+  return folly::tryTo<int32_t>(folly::trimWhitespace(node)).value_or(-1);
+#else
+  return -1;
+#endif
+}
+
+bool bindCurrentThreadToNumaNode(const NumaNode& node) {
+#ifdef __linux__
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (auto cpu : node.cpus) {
+    CPU_SET(cpu, &cpuSet);
+  }
+  if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+    PLOG(WARNING) << "Failed to set CPU affinity for NUMA node " << node.id;
+    return false;
+  }
+  // MPOL_PREFERRED steers this thread's page allocations to the local node
+  // while still allowing spill to remote nodes under memory pressure. Issued
+  // via syscall to avoid a libnuma dependency.
+  constexpr int kMpolPreferred = 1;
+  const uint64_t nodeMask = 1ULL << node.id;
+  if (syscall(
+          SYS_set_mempolicy, kMpolPreferred, &nodeMask, sizeof(nodeMask) * 8) !=
+      0) {
+    PLOG(WARNING) << "Failed to set memory policy for NUMA node " << node.id;
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace facebook::presto
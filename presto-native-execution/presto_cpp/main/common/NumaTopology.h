@@ -0,0 +1,46 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace facebook::presto {
+
+/// One NUMA node as reported by /sys/devices/system/node.
+struct NumaNode {
+  int32_t id;
+  /// Online CPUs local to this node.
+  std::vector<int32_t> cpus;
+};
+
+/// Returns the NUMA nodes of this host with their local CPUs. Returns an
+/// empty vector on non-Linux systems or when the topology cannot be read.
+std::vector<NumaNode> numaNodes();
+
+/// Returns the NUMA node the given network interface is attached to, or -1
+/// when unknown (non-Linux, virtual interface, or single-node system).
+int32_t numaNodeOfNetworkInterface(const std::string& interfaceName);
+
+/// Restricts the calling thread to the CPUs of 'node' and sets its memory
+/// policy to prefer allocating from that node. Returns false if either step
+/// fails; affinity and memory policy are best effort.
+bool bindCurrentThreadToNumaNode(const NumaNode& node);
+
+/// Parses a kernel cpulist string such as "0-15,32-47" into CPU ids.
+/// Exposed for testing.
+std::vector<int32_t> parseCpuList(const std::string& cpuList);
+
+} // namespace facebook::presto
@@ -0,0 +1,93 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/common/RequestPoolCache.h"
+
+#include <algorithm>
+
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::presto {
+
+// static
+RequestPoolCache* RequestPoolCache::instance() {
+  static auto* cache = new RequestPoolCache();
+  return cache;
+}
+
+// static
+size_t RequestPoolCache::sizeClass(uint64_t bytes) {
+  size_t sizeClass = 0;
+  for (uint64_t classBytes = kMinClassBytes;
+       sizeClass < kNumClasses - 1 && bytes > classBytes;
+       classBytes <<= 1) {
+    ++sizeClass;
+  }
+  return sizeClass;
+}
+
+RequestPoolCache::Lease RequestPoolCache::lease(uint64_t expectedBytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  // Drop quarantined pools whose stray references have since been released.
+  quarantined_.erase(
+      std::remove_if(
+          quarantined_.begin(),
+          quarantined_.end(),
+          [](const auto& pool) { return pool->usedBytes() == 0; }),
+      quarantined_.end());
+
+  // Prefer the hinted size class, then the next larger ones: a pool that has
+  // already peaked at the request's footprint will not need to grow. Smaller
+  // classes come last; reusing a small pool still beats creating one.
+  const auto preferred = sizeClass(expectedBytes);
+  std::vector<size_t> order;
+  order.reserve(kNumClasses);
+  for (auto candidate = preferred; candidate < kNumClasses; ++candidate) {
+    order.push_back(candidate);
+  }
+  for (auto candidate = preferred; candidate-- > 0;) {
+    order.push_back(candidate);
+  }
+  for (const auto candidate : order) {
+    auto& pools = freePools_[candidate];
+    if (!pools.empty()) {
+      auto pool = std::move(pools.back());
+      pools.pop_back();
+      RECORD_METRIC_VALUE(kCounterSidecarRequestPoolsReused);
+      return Lease(this, std::move(pool));
+    }
+  }
+
+  auto pool = velox::memory::MemoryManager::getInstance()->addLeafPool(
+      fmt::format("sidecar_request_{}", nextPoolId_++));
+  RECORD_METRIC_VALUE(kCounterSidecarRequestPoolsCreated);
+  return Lease(this, std::move(pool));
+}
+
+void RequestPoolCache::release(std::shared_ptr<velox::memory::MemoryPool> pool) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (pool->usedBytes() != 0) {
+    // Something allocated from this pool outlived the request; the pool must
+    // outlive it too. Park it and let lease() drop it once it drains.
+    quarantined_.push_back(std::move(pool));
+    return;
+  }
+  auto& pools = freePools_[sizeClass(pool->stats().peakBytes)];
+  if (pools.size() < kMaxPoolsPerClass) {
+    pools.push_back(std::move(pool));
+  }
+}
+
+} // namespace facebook::presto
@@ -0,0 +1,107 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include "velox/common/memory/MemoryPool.h"
+
+namespace facebook::presto {
+
+/// A cache of leaf memory pools for request-scoped scratch allocations on the
+/// sidecar endpoints (expression optimization, plan conversion). These
+/// endpoints previously shared one long-lived worker pool, so every request
+/// paid individual allocation and free bookkeeping against a pool that also
+/// served unrelated traffic. A lease hands each request a pool of its own;
+/// when the lease is dropped the request's scratch vectors are gone and the
+/// pool goes back to the cache whole, to be reused by a later request.
+///
+/// Pools are bucketed by the peak usage they have seen, and a lease with a
+/// size hint is served from the matching bucket. Steering similar-sized
+/// requests to the same pools keeps the allocator's size-class caches warm
+/// for the buffer sizes those requests cycle through, and keeps the one-off
+/// large request from inflating the pool every small request reuses.
+class RequestPoolCache {
+ public:
+  /// Holds a pool for the duration of one request. Movable, not copyable;
+  /// dropping the lease returns the pool to the cache.
+  class Lease {
+   public:
+    Lease(RequestPoolCache* cache, std::shared_ptr<velox::memory::MemoryPool> pool)
+        : cache_(cache), pool_(std::move(pool)) {}
+
+    Lease(Lease&& other) noexcept
+        : cache_(other.cache_), pool_(std::move(other.pool_)) {
+      other.cache_ = nullptr;
+    }
+
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    Lease& operator=(Lease&&) = delete;
+
+    ~Lease() {
+      if (cache_ != nullptr) {
+        cache_->release(std::move(pool_));
+      }
+    }
+
+    velox::memory::MemoryPool* pool() const {
+      return pool_.get();
+    }
+
+   private:
+    RequestPoolCache* cache_;
+    std::shared_ptr<velox::memory::MemoryPool> pool_;
+  };
+
+  /// Returns the process-wide cache. Production code uses instance(); the
+  /// constructor is exposed for tests.
+  static RequestPoolCache* instance();
+
+  RequestPoolCache() = default;
+
+  /// Returns a pool for one request. 'expectedBytes' is a cheap proxy for the
+  /// request's scratch footprint (the endpoints pass the request body size)
+  /// and only steers which cached pool is picked; the pool grows past it
+  /// freely.
+  Lease lease(uint64_t expectedBytes = 0);
+
+ private:
+  friend class Lease;
+
+  // Smallest size class; peaks below this all land in class 0.
+  static constexpr uint64_t kMinClassBytes = uint64_t{1} << 20;
+  static constexpr size_t kNumClasses = 8;
+  static constexpr size_t kMaxPoolsPerClass = 4;
+
+  // Size class of a pool whose peak usage is 'bytes': doubling buckets from
+  // kMinClassBytes, with everything larger in the top class.
+  static size_t sizeClass(uint64_t bytes);
+
+  void release(std::shared_ptr<velox::memory::MemoryPool> pool);
+
+  std::mutex mutex_;
+  // Idle pools by size class of their peak usage. Protected by 'mutex_'.
+  std::array<std::vector<std::shared_ptr<velox::memory::MemoryPool>>, kNumClasses>
+      freePools_;
+  // Pools that still had live allocations when their lease was dropped (a
+  // result that outlived its request). Parked here so the memory stays valid
+  // and dropped once they drain; never reused.
+  std::vector<std::shared_ptr<velox::memory::MemoryPool>> quarantined_;
+  uint64_t nextPoolId_{0};
+};
+
+} // namespace facebook::presto
@@ -0,0 +1,96 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/common/SoftAffinityExecutor.h"
+
+#include <limits>
+#include <thread>
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::presto {
+
+SoftAffinityExecutor::SoftAffinityExecutor(
+    size_t numThreads,
+    std::shared_ptr<folly::ThreadFactory> threadFactory,
+    const std::string& name,
+    size_t spilloverQueueDepth)
+    : name_(name), spilloverQueueDepth_(spilloverQueueDepth) {
+  VELOX_CHECK_GT(numThreads, 0);
+  shards_.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i) {
+    // The shards share the thread factory so per-thread setup (naming, NUMA
+    // binding, scheduling policy) applies to every worker.
+    shards_.push_back(
+        std::make_unique<folly::CPUThreadPoolExecutor>(1, threadFactory));
+  }
+}
+
+SoftAffinityExecutor::~SoftAffinityExecutor() {
+  join();
+}
+
+void SoftAffinityExecutor::add(folly::Func func) {
+  // Hash by submitter: work resumed by the same thread keeps its preferred
+  // shard across submissions, which is what makes the affinity sticky.
+  const auto preferred =
+      std::hash<std::thread::id>{}(std::this_thread::get_id()) %
+      shards_.size();
+  if (shards_[preferred]->getTaskQueueSize() <= spilloverQueueDepth_) {
+    shards_[preferred]->add(std::move(func));
+    return;
+  }
+
+  // Preferred thread is saturated; migrate to the least loaded shard. The
+  // queue sizes are racy but only steer load balancing, so a stale read is
+  // harmless.
+  size_t best = preferred;
+  size_t bestDepth = std::numeric_limits<size_t>::max();
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    const auto depth = shards_[i]->getTaskQueueSize();
+    if (depth < bestDepth) {
+      best = i;
+      bestDepth = depth;
+    }
+  }
+  if (best != preferred) {
+    numMigrations_.fetch_add(1, std::memory_order_relaxed);
+    RECORD_METRIC_VALUE(kCounterDriverSoftAffinityMigrations, 1);
+  }
+  shards_[best]->add(std::move(func));
+}
+
+size_t SoftAffinityExecutor::numActiveThreads() const {
+  size_t active{0};
+  for (const auto& shard : shards_) {
+    active += shard->numActiveThreads();
+  }
+  return active;
+}
+
+size_t SoftAffinityExecutor::getTaskQueueSize() const {
+  size_t queued{0};
+  for (const auto& shard : shards_) {
+    queued += shard->getTaskQueueSize();
+  }
+  return queued;
+}
+
+void SoftAffinityExecutor::join() {
+  for (const auto& shard : shards_) {
+    shard->join();
+  }
+}
+
+} // namespace facebook::presto
@@ -18,6 +18,7 @@
 #include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
 #include <sys/resource.h>
+#include "presto_cpp/main/common/CompressionBackend.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 
@@ -35,7 +36,8 @@ DateTime toISOTimestamp(uint64_t timeMilli) {
 std::shared_ptr<folly::SSLContext> createSSLContext(
     const std::string& clientCertAndKeyPath,
     const std::string& ciphers,
-    bool http2Enabled) {
+    bool http2Enabled,
+    bool ktlsEnabled) {
   try {
     auto sslContext = std::make_shared<folly::SSLContext>();
     sslContext->loadCertKeyPairFromFiles(
@@ -46,6 +48,19 @@ std::shared_ptr<folly::SSLContext> createSSLContext(
     } else {
       sslContext->setAdvertisedNextProtocols({"http/1.1"});
     }
+    // Cache client-side sessions so connections to the same peer resume the
+    // TLS session instead of running a full handshake.
+    SSL_CTX_set_session_cache_mode(
+        sslContext->getSSLCtx(), SSL_SESS_CACHE_CLIENT);
+    if (ktlsEnabled) {
+#ifdef SSL_OP_ENABLE_KTLS
+      SSL_CTX_set_options(sslContext->getSSLCtx(), SSL_OP_ENABLE_KTLS);
+#else
+      LOG(WARNING)
+          << "Kernel TLS offload requested but not supported by this "
+             "OpenSSL build; continuing with userspace TLS";
+#endif
+    }
     return sslContext;
   } catch (const std::exception& ex) {
     LOG(FATAL) << fmt::format(
@@ -115,10 +130,10 @@ std::string decompressMessageBody(
       VELOX_USER_FAIL("Unsupported Content-Encoding: {}", contentEncoding);
     }
 
-    // Decompress the data
-    auto codec = folly::compression::getCodec(
-        codecType); // getCodec never return nullptr
-    auto decompressed = codec->uncompress(combined.get());
+    // Decompress the data. This is an exchange-path payload, so the
+    // latency-favoring backend policy applies.
+    auto decompressed = CompressionBackendRegistry::instance()->uncompress(
+        CompressionUse::kExchange, codecType, combined.get());
 
     size_t decompressedSize = decompressed->computeChainDataLength();
 
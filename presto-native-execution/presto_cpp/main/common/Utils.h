@@ -28,10 +28,16 @@ namespace facebook::presto::util {
 using DateTime = std::string;
 DateTime toISOTimestamp(uint64_t timeMilli);
 
+/// Creates the client SSL context used for internal TLS communication.
+/// Client-side session caching is enabled so TLS sessions can be resumed
+/// across pooled connections to the same peer. When 'ktlsEnabled' is set and
+/// the OpenSSL build supports it, kernel TLS offload is requested so record
+/// encryption runs in-kernel after the handshake.
 std::shared_ptr<folly::SSLContext> createSSLContext(
     const std::string& clientCertAndKeyPath,
     const std::string& ciphers,
-    bool http2Enabled);
+    bool http2Enabled,
+    bool ktlsEnabled = false);
 
 /// Returns current process-wide CPU time in nanoseconds.
 long getProcessCpuTimeNs();
@@ -11,10 +11,28 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/String.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/json.h>
+#include <folly/synchronization/Baton.h>
 #include <gtest/gtest.h>
+#include <chrono>
+#include <set>
+#include <thread>
+#include "presto_cpp/main/common/AllocationTracker.h"
+#include "presto_cpp/main/common/CompressionBackend.h"
+#include "presto_cpp/main/common/CpuProfiler.h"
 #include "presto_cpp/main/common/Exception.h"
+#include "presto_cpp/main/common/HugePageArena.h"
+#include "presto_cpp/main/common/LocalDiskIoScheduler.h"
+#include "presto_cpp/main/common/MemoryPressureBus.h"
+#include "presto_cpp/main/common/NumaTopology.h"
+#include "presto_cpp/main/common/RequestPoolCache.h"
+#include "presto_cpp/main/common/SoftAffinityExecutor.h"
 #include "presto_cpp/main/common/Utils.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/memory/Memory.h"
 
 using namespace facebook;
 using namespace facebook::velox;
@@ -257,6 +275,405 @@ TEST(UtilsTest, getFunctionNameParts) {
   EXPECT_THROW(util::getFunctionNameParts(".."), VeloxException);
 }
 
+TEST(LocalDiskIoSchedulerTest, weightedShares) {
+  using IoClass = LocalDiskIoScheduler::IoClass;
+  constexpr uint64_t kBandwidth = 1'000'000; // 1MB/s.
+  constexpr uint64_t kT0 = 10'000'000;
+  LocalDiskIoScheduler scheduler(kBandwidth);
+
+  // A lone class gets the full bandwidth and one second of burst.
+  EXPECT_EQ(scheduler.acquireAt(IoClass::kShuffleWrite, kBandwidth, kT0), 0);
+  // The burst is spent; an equally sized transfer waits for a full refill,
+  // capped at one second.
+  EXPECT_EQ(
+      scheduler.acquireAt(IoClass::kShuffleWrite, kBandwidth, kT0),
+      1'000'000);
+
+  // Two idle seconds pay the debt back and rebuild the burst.
+  EXPECT_EQ(
+      scheduler.acquireAt(
+          IoClass::kShuffleWrite, kBandwidth / 2, kT0 + 2'000'000),
+      0);
+
+  // A read wakes up: weights 2:1 now split the bandwidth, so shuffle write
+  // is entitled to 2/3 of it and 200KB of overdraft takes 300ms to pay off.
+  EXPECT_EQ(
+      scheduler.acquireAt(IoClass::kShuffleRead, 1, kT0 + 2'000'000), 0);
+  EXPECT_NEAR(
+      scheduler.acquireAt(
+          IoClass::kShuffleWrite, 700'000, kT0 + 2'000'000),
+      300'000,
+      10);
+
+  // No bandwidth cap disables throttling entirely.
+  LocalDiskIoScheduler unthrottled(0);
+  EXPECT_EQ(
+      unthrottled.acquireAt(IoClass::kSpill, 100 * kBandwidth, kT0), 0);
+}
+
+TEST(HugePageArenaTest, allocateFreeCoalesce) {
+  constexpr uint64_t kGranule = 64 << 10;
+  HugePageArena arena(4 << 20);
+  auto stats = arena.stats();
+  if (stats.capacityBytes == 0) {
+    GTEST_SKIP() << "Arena mapping is unavailable on this platform";
+  }
+  ASSERT_EQ(stats.capacityBytes, 4 << 20);
+  EXPECT_EQ(stats.usedBytes, 0);
+  EXPECT_EQ(stats.numFreeRuns, 1);
+  EXPECT_EQ(stats.largestFreeRunBytes, 4 << 20);
+
+  // Sub-granule requests round up to one granule.
+  void* a = arena.allocate(100);
+  void* b = arena.allocate(kGranule);
+  void* c = arena.allocate(2 * kGranule);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  ASSERT_NE(c, nullptr);
+  EXPECT_TRUE(arena.contains(a));
+  ::memset(c, 0xab, 2 * kGranule);
+  stats = arena.stats();
+  EXPECT_EQ(stats.usedBytes, 4 * kGranule);
+  EXPECT_EQ(stats.numAllocations, 3);
+
+  // Freeing the middle buffer leaves a hole; freeing its neighbors
+  // coalesces the whole region back into one run.
+  arena.free(b, kGranule);
+  EXPECT_EQ(arena.stats().numFreeRuns, 2);
+  arena.free(a, 100);
+  arena.free(c, 2 * kGranule);
+  stats = arena.stats();
+  EXPECT_EQ(stats.usedBytes, 0);
+  EXPECT_EQ(stats.numFreeRuns, 1);
+  EXPECT_EQ(stats.largestFreeRunBytes, 4 << 20);
+
+  // An oversized request falls back to the caller's allocation path.
+  EXPECT_EQ(arena.allocate(8 << 20), nullptr);
+  EXPECT_EQ(arena.stats().numFallbacks, 1);
+}
+
+TEST(MemoryPressureBusTest, orderedReclaim) {
+  MemoryPressureBus bus;
+  std::vector<std::string> callOrder;
+
+  // Lower priorities run first regardless of registration order.
+  bus.subscribe("tasks", 20, [&](auto /*level*/, uint64_t /*target*/) {
+    callOrder.push_back("tasks");
+    return uint64_t{0};
+  });
+  bus.subscribe("cache", 10, [&](auto /*level*/, uint64_t target) {
+    callOrder.push_back("cache");
+    return std::min<uint64_t>(target, 100);
+  });
+
+  EXPECT_EQ(bus.publish(MemoryPressureBus::Level::kWarn, 300), 100);
+  EXPECT_EQ(callOrder, (std::vector<std::string>{"cache", "tasks"}));
+
+  // The walk stops once the target is met, so 'tasks' is not invoked.
+  callOrder.clear();
+  EXPECT_EQ(bus.publish(MemoryPressureBus::Level::kCritical, 50), 50);
+  EXPECT_EQ(callOrder, (std::vector<std::string>{"cache"}));
+
+  // Per-subscriber totals are tracked in run order.
+  const auto stats = bus.stats();
+  ASSERT_EQ(stats.size(), 2);
+  EXPECT_EQ(stats[0].name, "cache");
+  EXPECT_EQ(stats[0].invocations, 2);
+  EXPECT_EQ(stats[0].reclaimedBytes, 150);
+  EXPECT_EQ(stats[1].name, "tasks");
+  EXPECT_EQ(stats[1].invocations, 1);
+  EXPECT_EQ(stats[1].reclaimedBytes, 0);
+}
+
+TEST(MemoryPressureBusTest, failingAndRemovedSubscribers) {
+  MemoryPressureBus bus;
+  bus.subscribe("broken", 1, [](auto /*level*/, uint64_t /*target*/) {
+    throw std::runtime_error("eviction failed");
+    return uint64_t{0};
+  });
+  int64_t seenTarget{-1};
+  bus.subscribe("healthy", 2, [&](auto /*level*/, uint64_t target) {
+    seenTarget = target;
+    return uint64_t{10};
+  });
+
+  // A throwing subscriber is counted as releasing nothing and does not stop
+  // the walk; the next subscriber still sees the full outstanding target.
+  EXPECT_EQ(bus.publish(MemoryPressureBus::Level::kEmergency, 40), 10);
+  EXPECT_EQ(seenTarget, 40);
+
+  bus.unsubscribe("broken");
+  EXPECT_EQ(bus.publish(MemoryPressureBus::Level::kEmergency, 5), 5);
+  const auto stats = bus.stats();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats[0].name, "healthy");
+}
+
+#ifdef PRESTO_ENABLE_ALLOCATION_TRACKING
+TEST(AllocationTrackerTest, taggedScope) {
+  const auto before = AllocationTracker::counters(AllocationTag::kExchange);
+  {
+    // Enough allocations that the sampling (1 in kSampleEvery) must hit.
+    std::vector<std::unique_ptr<char[]>> allocations;
+    allocations.reserve(10'000);
+    ScopedAllocationTag tag{AllocationTag::kExchange};
+    for (int i = 0; i < 10'000; ++i) {
+      allocations.push_back(std::make_unique<char[]>(64));
+    }
+  }
+  const auto after = AllocationTracker::counters(AllocationTag::kExchange);
+  EXPECT_GT(after.allocations, before.allocations);
+  EXPECT_GT(after.bytes, before.bytes);
+
+  // Untagged allocations are not attributed.
+  const auto outside = AllocationTracker::counters(AllocationTag::kExchange);
+  std::vector<std::unique_ptr<char[]>> untracked;
+  untracked.reserve(10'000);
+  for (int i = 0; i < 10'000; ++i) {
+    untracked.push_back(std::make_unique<char[]>(64));
+  }
+  EXPECT_EQ(
+      AllocationTracker::counters(AllocationTag::kExchange).allocations,
+      outside.allocations);
+}
+#endif
+
+namespace {
+// Delegates the work to the software codecs but advertises hardware-like
+// ranks, so tests can observe the selection policy without a real engine.
+class FakeHardwareBackend : public CompressionBackend {
+ public:
+  FakeHardwareBackend(int32_t latencyRank, int32_t ratioRank)
+      : latencyRank_(latencyRank), ratioRank_(ratioRank) {}
+
+  std::string_view name() const override {
+    return "fake-hardware";
+  }
+
+  bool available() const override {
+    return true;
+  }
+
+  bool supports(folly::compression::CodecType type) const override {
+    return type == folly::compression::CodecType::ZSTD;
+  }
+
+  int32_t latencyRank() const override {
+    return latencyRank_;
+  }
+
+  int32_t ratioRank() const override {
+    return ratioRank_;
+  }
+
+  std::string compress(
+      folly::compression::CodecType type,
+      folly::StringPiece data) override {
+    return folly::compression::getCodec(type)->compress(data);
+  }
+
+  std::string uncompress(
+      folly::compression::CodecType type,
+      folly::StringPiece data) override {
+    return folly::compression::getCodec(type)->uncompress(data);
+  }
+
+  std::unique_ptr<folly::IOBuf> uncompress(
+      folly::compression::CodecType type,
+      const folly::IOBuf* data) override {
+    return folly::compression::getCodec(type)->uncompress(data);
+  }
+
+ private:
+  const int32_t latencyRank_;
+  const int32_t ratioRank_;
+};
+} // namespace
+
+TEST(CompressionBackendTest, policySelection) {
+  using folly::compression::CodecType;
+  CompressionBackendRegistry registry;
+
+  // Only the software backend is registered, so it serves both paths.
+  EXPECT_EQ(
+      registry.getBackend(CompressionUse::kExchange, CodecType::ZSTD)->name(),
+      "software");
+  EXPECT_EQ(
+      registry.getBackend(CompressionUse::kSpill, CodecType::ZSTD)->name(),
+      "software");
+
+  // A faster-but-worse-ratio engine takes over the exchange path only, and
+  // only for the format it supports.
+  ASSERT_TRUE(registry.registerBackend(
+      std::make_unique<FakeHardwareBackend>(/*latencyRank=*/10,
+                                            /*ratioRank=*/200)));
+  EXPECT_EQ(
+      registry.getBackend(CompressionUse::kExchange, CodecType::ZSTD)->name(),
+      "fake-hardware");
+  EXPECT_EQ(
+      registry.getBackend(CompressionUse::kSpill, CodecType::ZSTD)->name(),
+      "software");
+  EXPECT_EQ(
+      registry.getBackend(CompressionUse::kExchange, CodecType::LZ4)->name(),
+      "software");
+}
+
+TEST(CompressionBackendTest, roundTripAndStats) {
+  using folly::compression::CodecType;
+  CompressionBackendRegistry registry;
+
+  const std::string data(8192, 'x');
+  const auto compressed =
+      registry.compress(CompressionUse::kSpill, CodecType::LZ4, data);
+  EXPECT_LT(compressed.size(), data.size());
+  EXPECT_EQ(
+      registry.uncompress(CompressionUse::kSpill, CodecType::LZ4, compressed),
+      data);
+
+  const auto stats = registry.stats();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats[0].name, "software");
+  EXPECT_EQ(stats[0].compressInputBytes, data.size());
+  EXPECT_EQ(stats[0].compressOutputBytes, compressed.size());
+  EXPECT_EQ(stats[0].uncompressInputBytes, compressed.size());
+  EXPECT_EQ(stats[0].uncompressOutputBytes, data.size());
+}
+
+TEST(SoftAffinityExecutorTest, stickyThenSpillover) {
+  SoftAffinityExecutor executor(
+      4, std::make_shared<folly::NamedThreadFactory>("TestDriver"), "test");
+
+  // Work submitted one at a time from the same thread keeps landing on the
+  // same preferred worker.
+  std::set<std::thread::id> threads;
+  for (int i = 0; i < 20; ++i) {
+    folly::Baton<> done;
+    executor.add([&]() {
+      threads.insert(std::this_thread::get_id());
+      done.post();
+    });
+    done.wait();
+  }
+  EXPECT_EQ(threads.size(), 1);
+  EXPECT_EQ(executor.numMigrations(), 0);
+
+  // Saturate the preferred worker: while it is blocked and its queue is past
+  // the spillover depth, further work migrates to idle workers and still
+  // runs.
+  folly::Baton<> release;
+  executor.add([&]() { release.wait(); });
+  std::atomic<int32_t> numRun{0};
+  constexpr int32_t kNumTasks = 10;
+  for (int i = 0; i < kNumTasks; ++i) {
+    executor.add([&]() { ++numRun; });
+  }
+  EXPECT_GT(executor.numMigrations(), 0);
+  release.post();
+  executor.join();
+  EXPECT_EQ(numRun, kNumTasks);
+}
+
+TEST(CpuProfilerTest, processWideProfile) {
+  auto* profiler = CpuProfiler::instance();
+  VELOX_ASSERT_THROW(profiler->stop(), "No CPU profile was started");
+
+  profiler->start("", /*frequencyHz=*/500, /*maxSeconds=*/5, /*maxSamples=*/1000);
+  VELOX_ASSERT_THROW(
+      profiler->start("", 500, 5, 1000), "A CPU profile is already running");
+
+  // Burn CPU so the profiling timer fires.
+  volatile uint64_t sink = 0;
+  const auto until =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+  while (std::chrono::steady_clock::now() < until) {
+    for (int i = 0; i < 10'000; ++i) {
+      sink += i * i;
+    }
+  }
+
+  const auto profile = profiler->stop();
+  EXPECT_FALSE(profile.empty());
+  // Collapsed stack format: every line ends in a sample count.
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', profile, lines, /*ignoreEmpty=*/true);
+  for (const auto& line : lines) {
+    const auto space = line.rfind(' ');
+    ASSERT_NE(space, std::string::npos) << line;
+    EXPECT_GT(folly::to<uint64_t>(line.subpiece(space + 1)), 0) << line;
+  }
+}
+
+TEST(CpuProfilerTest, queryFilterDropsUnattributedThreads) {
+  auto* profiler = CpuProfiler::instance();
+  // No thread carries driver debug info for this query id, so every sample
+  // is filtered out.
+  profiler->start("no_such_query", 500, 5, 1000);
+  volatile uint64_t sink = 0;
+  const auto until =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+  while (std::chrono::steady_clock::now() < until) {
+    for (int i = 0; i < 10'000; ++i) {
+      sink += i * i;
+    }
+  }
+  const auto status = folly::parseJson(profiler->status());
+  EXPECT_EQ(status["samples"].asInt(), 0);
+  EXPECT_EQ(profiler->stop(), "");
+}
+
+class RequestPoolCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+};
+
+TEST_F(RequestPoolCacheTest, reuseAcrossRequests) {
+  RequestPoolCache cache;
+  velox::memory::MemoryPool* firstPool;
+  {
+    const auto lease = cache.lease(1024);
+    firstPool = lease.pool();
+    void* data = firstPool->allocate(1024);
+    firstPool->free(data, 1024);
+  }
+  // The pool came back empty, so the next request of similar size gets the
+  // same pool instead of a new one.
+  {
+    const auto lease = cache.lease(1024);
+    EXPECT_EQ(lease.pool(), firstPool);
+  }
+}
+
+TEST_F(RequestPoolCacheTest, nonEmptyPoolIsNotReused) {
+  RequestPoolCache cache;
+  void* leaked;
+  velox::memory::MemoryPool* firstPool;
+  {
+    const auto lease = cache.lease();
+    firstPool = lease.pool();
+    leaked = firstPool->allocate(1024);
+  }
+  // The first pool still has a live allocation when its lease is dropped; it
+  // is quarantined rather than handed to the next request.
+  {
+    const auto lease = cache.lease();
+    EXPECT_NE(lease.pool(), firstPool);
+    firstPool->free(leaked, 1024);
+  }
+}
+
+TEST(NumaTopologyTest, parseCpuList) {
+  EXPECT_EQ(parseCpuList("0"), std::vector<int32_t>{0});
+  EXPECT_EQ(parseCpuList("0-3"), (std::vector<int32_t>{0, 1, 2, 3}));
+  // Hyperthread siblings show up as disjoint ranges.
+  EXPECT_EQ(
+      parseCpuList("0-2,8-10\n"),
+      (std::vector<int32_t>{0, 1, 2, 8, 9, 10}));
+  EXPECT_TRUE(parseCpuList("").empty());
+  EXPECT_TRUE(parseCpuList("garbage").empty());
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   folly::SingletonVault::singleton()->registrationComplete();
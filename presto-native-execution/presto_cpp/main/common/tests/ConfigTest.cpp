@@ -170,6 +170,40 @@ TEST_F(ConfigTest, mutableSystemConfig) {
       systemConfig->setValue("unregisteredProp1", "x"), VeloxException);
 }
 
+TEST_F(ConfigTest, reloadDynamicProperties) {
+  writeConfigFile(fmt::format(
+      "{}={}\n{}=true\n{}=8\n",
+      SystemConfig::kPrestoVersion,
+      kPrestoVersion_,
+      ConfigBase::kMutableConfig,
+      SystemConfig::kExchangeHttpClientPipelinedFetchWindow));
+  SystemConfig config;
+  config.initialize(configFilePath_);
+  ASSERT_EQ(8, config.exchangeHttpClientPipelinedFetchWindow());
+
+  // Updates made through setValue() must be visible through the cached getter.
+  config.setValue(
+      std::string(SystemConfig::kExchangeHttpClientPipelinedFetchWindow), "16");
+  ASSERT_EQ(16, config.exchangeHttpClientPipelinedFetchWindow());
+
+  // Rewrite the file changing both a dynamic and a startup-frozen property.
+  filesystems::getFileSystem(configFilePath_, nullptr)->remove(configFilePath_);
+  writeConfigFile(fmt::format(
+      "{}={}\n{}=true\n{}=32\n",
+      SystemConfig::kPrestoVersion,
+      kPrestoVersion2_,
+      ConfigBase::kMutableConfig,
+      SystemConfig::kExchangeHttpClientPipelinedFetchWindow));
+
+  const auto summary =
+      config.reloadDynamicProperties(SystemConfig::dynamicProperties());
+  ASSERT_EQ(32, config.exchangeHttpClientPipelinedFetchWindow());
+  ASSERT_EQ(kPrestoVersion_, config.prestoVersion());
+  ASSERT_NE(
+      summary.find(fmt::format("Skipped '{}'", SystemConfig::kPrestoVersion)),
+      std::string::npos);
+}
+
 TEST_F(ConfigTest, requiredSystemConfigs) {
   SystemConfig config;
   init(config, {});
@@ -216,10 +250,6 @@ TEST_F(ConfigTest, optionalNodeConfigs) {
   init(config, {{std::string(NodeConfig::kNodeIp), "127.0.0.1"}});
   ASSERT_EQ(
       config.nodeInternalAddress([]() { return "0.0.0.0"; }), "127.0.0.1");
-
-  init(
-      config, {{std::string(NodeConfig::kNodePrometheusExecutorThreads), "4"}});
-  ASSERT_EQ(config.prometheusExecutorThreads(), 4);
 }
 
 TEST_F(ConfigTest, optionalSystemConfigsWithDefault) {
@@ -0,0 +1,90 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/connectors/HiveFileMetadataCache.h"
+#include "presto_cpp/main/common/Counters.h"
+#include "presto_cpp/presto_protocol/Base64Util.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::presto {
+
+// static
+HiveFileMetadataCache* HiveFileMetadataCache::instance() {
+  static HiveFileMetadataCache cache;
+  return &cache;
+}
+
+std::shared_ptr<std::string> HiveFileMetadataCache::getOrDecode(
+    const std::string& filePath,
+    int64_t modificationTime,
+    int64_t fileSize,
+    const std::string& encodedExtraFileInfo,
+    uint64_t maxBytes) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = files_.find(filePath);
+    if (it != files_.end() &&
+        it->second.modificationTime == modificationTime &&
+        it->second.fileSize == fileSize) {
+      lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+      RECORD_METRIC_VALUE(kCounterHiveFileMetadataCacheHits);
+      return it->second.metadata;
+    }
+  }
+  RECORD_METRIC_VALUE(kCounterHiveFileMetadataCacheMisses);
+
+  // Decode outside the lock; concurrent misses on the same file decode twice
+  // and the slower one adopts the winner's blob below.
+  auto metadata = std::make_shared<std::string>(
+      protocol::decodeBase64(encodedExtraFileInfo));
+  const auto metadataBytes = static_cast<uint64_t>(metadata->size());
+  if (metadataBytes > maxBytes) {
+    return metadata;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = files_.find(filePath);
+  if (it != files_.end()) {
+    if (it->second.modificationTime == modificationTime &&
+        it->second.fileSize == fileSize) {
+      // Another split of the same file raced us; share its blob.
+      return it->second.metadata;
+    }
+    // The file was rewritten; drop the stale entry.
+    cachedBytes_ -= it->second.metadata->size();
+    lru_.erase(it->second.lruPosition);
+    files_.erase(it);
+  }
+  while (cachedBytes_ + metadataBytes > maxBytes) {
+    VELOX_CHECK(!lru_.empty());
+    auto evictIt = files_.find(lru_.back());
+    VELOX_CHECK(evictIt != files_.end());
+    cachedBytes_ -= evictIt->second.metadata->size();
+    files_.erase(evictIt);
+    lru_.pop_back();
+    RECORD_METRIC_VALUE(kCounterHiveFileMetadataCacheEvictions);
+  }
+  lru_.push_front(filePath);
+  cachedBytes_ += metadataBytes;
+  files_[filePath] =
+      CachedFile{metadata, modificationTime, fileSize, lru_.begin()};
+  return metadata;
+}
+
+uint64_t HiveFileMetadataCache::cachedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cachedBytes_;
+}
+
+} // namespace facebook::presto
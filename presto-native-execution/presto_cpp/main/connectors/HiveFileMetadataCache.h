@@ -0,0 +1,68 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace facebook::presto {
+
+/// Worker-level cache of per-file Hive split metadata. Concurrent queries
+/// over hot partitions produce many splits against the same ORC/Parquet
+/// files, and every split used to base64-decode the same extraFileInfo blob
+/// into its own copy. Entries are keyed by file path and validated against
+/// the file's modification time and size, so a rewritten file is decoded
+/// afresh; splits that hit the cache share one immutable blob. Eviction is
+/// LRU against a byte budget.
+class HiveFileMetadataCache {
+ public:
+  static HiveFileMetadataCache* instance();
+
+  /// Returns the decoded metadata blob for the file, serving it from the
+  /// cache when an entry for 'filePath' with matching 'modificationTime' and
+  /// 'fileSize' exists, and otherwise decoding 'encodedExtraFileInfo' and
+  /// caching the result. Evicts least recently used entries until the cache
+  /// fits in 'maxBytes'; blobs larger than 'maxBytes' are returned without
+  /// being cached.
+  std::shared_ptr<std::string> getOrDecode(
+      const std::string& filePath,
+      int64_t modificationTime,
+      int64_t fileSize,
+      const std::string& encodedExtraFileInfo,
+      uint64_t maxBytes);
+
+  /// Bytes currently held across cached blobs. Used by tests.
+  uint64_t cachedBytes() const;
+
+ private:
+  HiveFileMetadataCache() = default;
+
+  struct CachedFile {
+    std::shared_ptr<std::string> metadata;
+    int64_t modificationTime;
+    int64_t fileSize;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  mutable std::mutex mutex_;
+  // Most recently used file path at the front.
+  std::list<std::string> lru_;
+  folly::F14FastMap<std::string, CachedFile> files_;
+  uint64_t cachedBytes_{0};
+};
+
+} // namespace facebook::presto
@@ -14,9 +14,12 @@
 
 #include "presto_cpp/main/connectors/HivePrestoToVeloxConnector.h"
 
+#include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/connectors/HiveFileMetadataCache.h"
 #include "presto_cpp/main/connectors/PrestoToVeloxConnectorUtils.h"
 #include "presto_cpp/main/types/PrestoToVeloxExpr.h"
 #include "presto_cpp/main/types/TypeParser.h"
+#include "presto_cpp/presto_protocol/Base64Util.h"
 #include "presto_cpp/presto_protocol/connector/hive/HiveConnectorProtocol.h"
 
 #include <velox/type/fbhive/HiveTypeParser.h>
@@ -228,34 +231,8 @@ velox::connector::hive::HiveBucketConversion toVeloxBucketConversion(
 
 dwio::common::FileFormat toVeloxFileFormat(
     const presto::protocol::hive::StorageFormat& format) {
-  if (format.inputFormat == "com.facebook.hive.orc.OrcInputFormat") {
-    return dwio::common::FileFormat::DWRF;
-  } else if (
-      format.inputFormat == "org.apache.hadoop.hive.ql.io.orc.OrcInputFormat") {
-    return dwio::common::FileFormat::ORC;
-  } else if (
-      format.inputFormat ==
-      "org.apache.hadoop.hive.ql.io.parquet.MapredParquetInputFormat") {
-    return dwio::common::FileFormat::PARQUET;
-  } else if (format.inputFormat == "org.apache.hadoop.mapred.TextInputFormat") {
-    if (format.serDe == "org.apache.hadoop.hive.serde2.lazy.LazySimpleSerDe") {
-      return dwio::common::FileFormat::TEXT;
-    } else if (format.serDe == "org.apache.hive.hcatalog.data.JsonSerDe") {
-      return dwio::common::FileFormat::JSON;
-    }
-  } else if (
-      format.inputFormat ==
-      "org.apache.hadoop.hive.ql.io.SymlinkTextInputFormat") {
-    if (format.serDe ==
-        "org.apache.hadoop.hive.ql.io.parquet.serde.ParquetHiveSerDe") {
-      return dwio::common::FileFormat::PARQUET;
-    }
-  } else if (format.inputFormat == "com.facebook.alpha.AlphaInputFormat") {
-    // ALPHA has been renamed in Velox to NIMBLE.
-    return dwio::common::FileFormat::NIMBLE;
-  }
-  VELOX_UNSUPPORTED(
-      "Unsupported file format: {} {}", format.inputFormat, format.serDe);
+  return facebook::presto::toVeloxFileFormat(
+      format.inputFormat, format.serDe);
 }
 
 } // namespace
@@ -282,8 +259,22 @@ HivePrestoToVeloxConnector::toVeloxSplit(
   }
   std::shared_ptr<std::string> extraFileInfo;
   if (hiveSplit->fileSplit.extraFileInfo) {
-    extraFileInfo = std::make_shared<std::string>(
-        velox::encoding::Base64::decode(*hiveSplit->fileSplit.extraFileInfo));
+    // Splits of concurrent tasks frequently target the same files; share one
+    // decoded metadata blob per file through the worker-level cache instead
+    // of decoding a private copy per split.
+    const auto metadataCacheMaxBytes =
+        SystemConfig::instance()->hiveFileMetadataCacheMaxBytes();
+    if (metadataCacheMaxBytes > 0) {
+      extraFileInfo = HiveFileMetadataCache::instance()->getOrDecode(
+          hiveSplit->fileSplit.path,
+          hiveSplit->fileSplit.fileModifiedTime,
+          hiveSplit->fileSplit.fileSize,
+          *hiveSplit->fileSplit.extraFileInfo,
+          metadataCacheMaxBytes);
+    } else {
+      extraFileInfo = std::make_shared<std::string>(
+          protocol::decodeBase64(*hiveSplit->fileSplit.extraFileInfo));
+    }
   }
   std::unordered_map<std::string, std::string> serdeParameters;
   serdeParameters.reserve(hiveSplit->storage.serdeParameters.size());
@@ -316,6 +307,11 @@ HivePrestoToVeloxConnector::toVeloxSplit(
           hiveSplit->splitWeight,
           splitContext->cacheable,
           infoColumns);
+  // Pre-populate the file size and modification time the coordinator already
+  // knows, so the reader's file handle and footer caches can validate their
+  // entries without an extra filesystem metadata call.
+  veloxSplit->properties = velox::connector::hive::FileProperties{
+      hiveSplit->fileSplit.fileSize, hiveSplit->fileSplit.fileModifiedTime};
   if (hiveSplit->bucketConversion) {
     VELOX_CHECK_NOT_NULL(hiveSplit->tableBucketNumber);
     veloxSplit->bucketConversion =
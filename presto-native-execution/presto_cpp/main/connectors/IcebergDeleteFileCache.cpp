@@ -0,0 +1,109 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/connectors/IcebergDeleteFileCache.h"
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::presto {
+namespace {
+
+// Approximate heap footprint of a cached descriptor, used for the byte
+// budget accounting.
+uint64_t estimateBytes(
+    const velox::connector::hive::iceberg::IcebergDeleteFile& deleteFile) {
+  uint64_t bytes = sizeof(deleteFile) + deleteFile.filePath.size() +
+      deleteFile.equalityFieldIds.size() * sizeof(int32_t);
+  for (const auto& [id, bound] : deleteFile.lowerBounds) {
+    bytes += sizeof(id) + bound.size();
+  }
+  for (const auto& [id, bound] : deleteFile.upperBounds) {
+    bytes += sizeof(id) + bound.size();
+  }
+  return bytes;
+}
+
+} // namespace
+
+// static
+IcebergDeleteFileCache* IcebergDeleteFileCache::instance() {
+  static IcebergDeleteFileCache cache;
+  return &cache;
+}
+
+std::shared_ptr<const velox::connector::hive::iceberg::IcebergDeleteFile>
+IcebergDeleteFileCache::getOrConvert(
+    const std::string& path,
+    int64_t recordCount,
+    int64_t fileSizeInBytes,
+    const std::function<velox::connector::hive::iceberg::IcebergDeleteFile()>&
+        convert,
+    uint64_t maxBytes) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = files_.find(path);
+    if (it != files_.end() && it->second.recordCount == recordCount &&
+        it->second.fileSizeInBytes == fileSizeInBytes) {
+      lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+      RECORD_METRIC_VALUE(kCounterIcebergDeleteFileCacheHits);
+      return it->second.deleteFile;
+    }
+  }
+  RECORD_METRIC_VALUE(kCounterIcebergDeleteFileCacheMisses);
+
+  // Convert outside the lock; concurrent misses on the same file convert
+  // twice and the slower one adopts the winner's descriptor below.
+  auto deleteFile = std::make_shared<
+      const velox::connector::hive::iceberg::IcebergDeleteFile>(convert());
+  const auto deleteFileBytes = estimateBytes(*deleteFile);
+  if (deleteFileBytes > maxBytes) {
+    return deleteFile;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = files_.find(path);
+  if (it != files_.end()) {
+    if (it->second.recordCount == recordCount &&
+        it->second.fileSizeInBytes == fileSizeInBytes) {
+      // Another split referencing the same file raced us; share its
+      // descriptor.
+      return it->second.deleteFile;
+    }
+    // The file was rewritten; drop the stale entry.
+    cachedBytes_ -= it->second.bytes;
+    lru_.erase(it->second.lruPosition);
+    files_.erase(it);
+  }
+  while (cachedBytes_ + deleteFileBytes > maxBytes) {
+    VELOX_CHECK(!lru_.empty());
+    auto evictIt = files_.find(lru_.back());
+    VELOX_CHECK(evictIt != files_.end());
+    cachedBytes_ -= evictIt->second.bytes;
+    files_.erase(evictIt);
+    lru_.pop_back();
+    RECORD_METRIC_VALUE(kCounterIcebergDeleteFileCacheEvictions);
+  }
+  lru_.push_front(path);
+  cachedBytes_ += deleteFileBytes;
+  files_[path] = CachedDeleteFile{
+      deleteFile, recordCount, fileSizeInBytes, deleteFileBytes, lru_.begin()};
+  return deleteFile;
+}
+
+uint64_t IcebergDeleteFileCache::cachedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cachedBytes_;
+}
+
+} // namespace facebook::presto
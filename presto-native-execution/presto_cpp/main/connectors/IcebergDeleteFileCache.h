@@ -0,0 +1,77 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/connectors/hive/iceberg/IcebergSplit.h"
+
+namespace facebook::presto {
+
+/// Worker-level cache of converted Iceberg delete file descriptors. On
+/// merge-on-read tables every data split of a task (and of concurrent tasks
+/// over the same snapshot) carries the same positional/equality delete
+/// files, and every split used to rebuild the same descriptor - bounds maps
+/// and all - from the protocol structs. Entries are keyed by delete file
+/// path and validated against the file's record count and size, so a file
+/// rewritten under the same path is converted afresh; splits that hit the
+/// cache copy one immutable descriptor instead. Eviction is LRU against a
+/// byte budget.
+class IcebergDeleteFileCache {
+ public:
+  static IcebergDeleteFileCache* instance();
+
+  /// Returns the converted descriptor for the delete file, serving it from
+  /// the cache when an entry for 'path' with matching 'recordCount' and
+  /// 'fileSizeInBytes' exists, and otherwise converting it through 'convert'
+  /// and caching the result. Evicts least recently used entries until the
+  /// cache fits in 'maxBytes'.
+  std::shared_ptr<const velox::connector::hive::iceberg::IcebergDeleteFile>
+  getOrConvert(
+      const std::string& path,
+      int64_t recordCount,
+      int64_t fileSizeInBytes,
+      const std::function<
+          velox::connector::hive::iceberg::IcebergDeleteFile()>& convert,
+      uint64_t maxBytes);
+
+  /// Approximate bytes currently held across cached descriptors. Used by
+  /// tests.
+  uint64_t cachedBytes() const;
+
+ private:
+  IcebergDeleteFileCache() = default;
+
+  struct CachedDeleteFile {
+    std::shared_ptr<const velox::connector::hive::iceberg::IcebergDeleteFile>
+        deleteFile;
+    int64_t recordCount;
+    int64_t fileSizeInBytes;
+    uint64_t bytes;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  mutable std::mutex mutex_;
+  // Most recently used delete file path at the front.
+  std::list<std::string> lru_;
+  folly::F14FastMap<std::string, CachedDeleteFile> files_;
+  uint64_t cachedBytes_{0};
+};
+
+} // namespace facebook::presto
@@ -13,6 +13,8 @@
  */
 
 #include "presto_cpp/main/connectors/IcebergPrestoToVeloxConnector.h"
+#include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/connectors/IcebergDeleteFileCache.h"
 #include "presto_cpp/main/connectors/PrestoToVeloxConnectorUtils.h"
 
 #include "presto_cpp/presto_protocol/connector/iceberg/IcebergConnectorProtocol.h"
@@ -150,6 +152,25 @@ toVeloxIcebergPartitionSpec(
       spec.specId, fields);
 }
 
+velox::connector::hive::iceberg::IcebergDeleteFile toVeloxDeleteFile(
+    const protocol::iceberg::DeleteFile& deleteFile) {
+  std::unordered_map<int32_t, std::string> lowerBounds(
+      deleteFile.lowerBounds.begin(), deleteFile.lowerBounds.end());
+
+  std::unordered_map<int32_t, std::string> upperBounds(
+      deleteFile.upperBounds.begin(), deleteFile.upperBounds.end());
+
+  return velox::connector::hive::iceberg::IcebergDeleteFile(
+      toVeloxFileContent(deleteFile.content),
+      deleteFile.path,
+      toVeloxFileFormat(deleteFile.format),
+      deleteFile.recordCount,
+      deleteFile.fileSizeInBytes,
+      std::vector(deleteFile.equalityFieldIds),
+      lowerBounds,
+      upperBounds);
+}
+
 velox::parquet::ParquetFieldId toParquetField(
     const protocol::iceberg::ColumnIdentity& column) {
   std::vector<velox::parquet::ParquetFieldId> children;
@@ -192,24 +213,22 @@ IcebergPrestoToVeloxConnector::toVeloxSplit(
 
   std::vector<velox::connector::hive::iceberg::IcebergDeleteFile> deletes;
   deletes.reserve(icebergSplit->deletes.size());
+  // On merge-on-read tables many data splits reference the same delete
+  // files; share one converted descriptor per file through the worker-level
+  // cache instead of rebuilding it per split.
+  const auto deleteFileCacheMaxBytes =
+      SystemConfig::instance()->icebergDeleteFileCacheMaxBytes();
   for (const auto& deleteFile : icebergSplit->deletes) {
-    std::unordered_map<int32_t, std::string> lowerBounds(
-        deleteFile.lowerBounds.begin(), deleteFile.lowerBounds.end());
-
-    std::unordered_map<int32_t, std::string> upperBounds(
-        deleteFile.upperBounds.begin(), deleteFile.upperBounds.end());
-
-    velox::connector::hive::iceberg::IcebergDeleteFile icebergDeleteFile(
-        toVeloxFileContent(deleteFile.content),
-        deleteFile.path,
-        toVeloxFileFormat(deleteFile.format),
-        deleteFile.recordCount,
-        deleteFile.fileSizeInBytes,
-        std::vector(deleteFile.equalityFieldIds),
-        lowerBounds,
-        upperBounds);
-
-    deletes.emplace_back(icebergDeleteFile);
+    if (deleteFileCacheMaxBytes > 0) {
+      deletes.emplace_back(*IcebergDeleteFileCache::instance()->getOrConvert(
+          deleteFile.path,
+          deleteFile.recordCount,
+          deleteFile.fileSizeInBytes,
+          [&]() { return toVeloxDeleteFile(deleteFile); },
+          deleteFileCacheMaxBytes));
+    } else {
+      deletes.emplace_back(toVeloxDeleteFile(deleteFile));
+    }
   }
 
   std::unordered_map<std::string, std::string> infoColumns = {
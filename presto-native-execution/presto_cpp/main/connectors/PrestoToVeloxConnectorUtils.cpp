@@ -728,6 +728,37 @@ velox::common::CompressionKind toFileCompressionKind(
   }
 }
 
+dwio::common::FileFormat toVeloxFileFormat(
+    const std::string& inputFormat,
+    const std::string& serDe) {
+  if (inputFormat == "com.facebook.hive.orc.OrcInputFormat") {
+    return dwio::common::FileFormat::DWRF;
+  } else if (
+      inputFormat == "org.apache.hadoop.hive.ql.io.orc.OrcInputFormat") {
+    return dwio::common::FileFormat::ORC;
+  } else if (
+      inputFormat ==
+      "org.apache.hadoop.hive.ql.io.parquet.MapredParquetInputFormat") {
+    return dwio::common::FileFormat::PARQUET;
+  } else if (inputFormat == "org.apache.hadoop.mapred.TextInputFormat") {
+    if (serDe == "org.apache.hadoop.hive.serde2.lazy.LazySimpleSerDe") {
+      return dwio::common::FileFormat::TEXT;
+    } else if (serDe == "org.apache.hive.hcatalog.data.JsonSerDe") {
+      return dwio::common::FileFormat::JSON;
+    }
+  } else if (
+      inputFormat == "org.apache.hadoop.hive.ql.io.SymlinkTextInputFormat") {
+    if (serDe ==
+        "org.apache.hadoop.hive.ql.io.parquet.serde.ParquetHiveSerDe") {
+      return dwio::common::FileFormat::PARQUET;
+    }
+  } else if (inputFormat == "com.facebook.alpha.AlphaInputFormat") {
+    // ALPHA has been renamed in Velox to NIMBLE.
+    return dwio::common::FileFormat::NIMBLE;
+  }
+  VELOX_UNSUPPORTED("Unsupported file format: {} {}", inputFormat, serDe);
+}
+
 connector::hive::HiveColumnHandle::ColumnType toHiveColumnType(
     protocol::hive::ColumnType type) {
   switch (type) {
@@ -50,6 +50,13 @@ velox::common::CompressionKind toFileCompressionKind(
 velox::connector::hive::HiveColumnHandle::ColumnType toHiveColumnType(
     protocol::hive::ColumnType type);
 
+/// Maps a Hive storage format's input format and serde class names to the
+/// velox file format. Shared by the protocol and Thrift split conversion
+/// paths.
+velox::dwio::common::FileFormat toVeloxFileFormat(
+    const std::string& inputFormat,
+    const std::string& serDe);
+
 std::unique_ptr<velox::connector::ConnectorTableHandle> toHiveTableHandle(
     const protocol::TupleDomain<protocol::Subfield>& domainPredicate,
     const std::shared_ptr<protocol::RowExpression>& remainingPredicate,
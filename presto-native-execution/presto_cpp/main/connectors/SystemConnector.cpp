@@ -14,6 +14,7 @@
 #include "presto_cpp/main/connectors/SystemConnector.h"
 #include "presto_cpp/main/PrestoTask.h"
 #include "presto_cpp/main/TaskManager.h"
+#include "presto_cpp/main/connectors/PrestoToVeloxConnectorUtils.h"
 
 #include "velox/type/Timestamp.h"
 
@@ -26,6 +27,15 @@ namespace {
 static const std::string kRuntimeSchema = "runtime";
 static const std::string kTasksTable = "tasks";
 
+static const std::string kTaskIdColumn = "task_id";
+static const std::string kQueryIdColumn = "query_id";
+static const std::string kStateColumn = "state";
+
+// Pushed-down filters are optional; a null filter passes everything.
+bool testFilter(const common::Filter* filter, const std::string& value) {
+  return filter == nullptr || filter->testBytes(value.data(), value.size());
+}
+
 } // namespace
 
 const velox::RowTypePtr SystemTableHandle::taskSchema() const {
@@ -53,7 +63,11 @@ const velox::RowTypePtr SystemTableHandle::taskSchema() const {
       "created",
       "start",
       "last_heartbeat",
-      "end"};
+      "end",
+      "result_consumers",
+      "result_fetches",
+      "result_fetch_bytes",
+      "result_fetch_gap_ms"};
 
   static std::vector<velox::TypePtr> kTaskColumnTypes = {
       velox::VARCHAR(),   velox::VARCHAR(),   velox::VARCHAR(),
@@ -63,7 +77,9 @@ const velox::RowTypePtr SystemTableHandle::taskSchema() const {
       velox::BIGINT(),    velox::BIGINT(),    velox::BIGINT(),
       velox::BIGINT(),    velox::BIGINT(),    velox::BIGINT(),
       velox::BIGINT(),    velox::BIGINT(),    velox::TIMESTAMP(),
-      velox::TIMESTAMP(), velox::TIMESTAMP(), velox::TIMESTAMP()};
+      velox::TIMESTAMP(), velox::TIMESTAMP(), velox::TIMESTAMP(),
+      velox::BIGINT(),    velox::BIGINT(),    velox::BIGINT(),
+      velox::BIGINT()};
   static const RowTypePtr kTaskSchema =
       ROW(std::move(kTaskColumnNames), std::move(kTaskColumnTypes));
   return kTaskSchema;
@@ -72,11 +88,14 @@ const velox::RowTypePtr SystemTableHandle::taskSchema() const {
 SystemTableHandle::SystemTableHandle(
     std::string connectorId,
     std::string schemaName,
-    std::string tableName)
+    std::string tableName,
+    std::unordered_map<std::string, std::unique_ptr<velox::common::Filter>>
+        columnFilters)
     : ConnectorTableHandle(std::move(connectorId)),
       name_(fmt::format("{}.{}", schemaName, tableName)),
       schemaName_(std::move(schemaName)),
-      tableName_(std::move(tableName)) {
+      tableName_(std::move(tableName)),
+      columnFilters_(std::move(columnFilters)) {
   VELOX_USER_CHECK_EQ(
       schemaName_,
       kRuntimeSchema,
@@ -129,6 +148,36 @@ SystemDataSource::SystemDataSource(
   }
 
   outputType_ = outputType;
+  tableHandle_ = systemTableHandle;
+
+  for (const auto columnIndex : outputColumnMappings_) {
+    auto taskEnum = TaskColumnEnum(columnIndex);
+    // Only node_id and the split/stats columns are served from TaskInfo; the
+    // identity and timestamp columns come straight from PrestoTask members.
+    if (taskEnum == TaskColumnEnum::kNodeId ||
+        (taskEnum >= TaskColumnEnum::kSplits &&
+         taskEnum <= TaskColumnEnum::kPhysicalWrittenBytes)) {
+      needsTaskInfo_ = true;
+    }
+    if (taskEnum == TaskColumnEnum::kState) {
+      needsState_ = true;
+    }
+    if (taskEnum >= TaskColumnEnum::kResultConsumers) {
+      needsPacing_ = true;
+    }
+  }
+
+  for (const auto& [columnName, filter] : tableHandle_->columnFilters()) {
+    if (columnName == kTaskIdColumn) {
+      taskIdFilter_ = filter.get();
+    } else if (columnName == kQueryIdColumn) {
+      queryIdFilter_ = filter.get();
+    } else if (columnName == kStateColumn) {
+      stateFilter_ = filter.get();
+    }
+    // Filters on other columns are ignored; the engine re-applies the full
+    // predicate above the scan.
+  }
 }
 
 void SystemDataSource::addSplit(
@@ -140,34 +189,66 @@ void SystemDataSource::addSplit(
   VELOX_CHECK(currentSplit_, "Wrong type of split for SystemDataSource.");
 }
 
-#define SET_TASK_COLUMN(value)            \
-  int j = 0;                              \
-  for (const auto& taskEntry : taskMap) { \
-    auto task = taskEntry.second;         \
-    auto taskInfo = taskInfos[j];         \
-    flat->set(j, value);                  \
-    j++;                                  \
+#define SET_TASK_COLUMN(value)                 \
+  for (vector_size_t j = 0; j < numRows; j++) { \
+    const auto& row = taskRows_[start + j];    \
+    const auto& task = row.task;               \
+    const auto& taskInfo = taskInfos[j];       \
+    flat->set(j, value);                       \
   }
 
-#define SET_TASK_FMT_COLUMN(value)        \
-  int j = 0;                              \
-  std::string temp;                       \
-  for (const auto& taskEntry : taskMap) { \
-    auto task = taskEntry.second;         \
-    auto taskInfo = taskInfos[j];         \
-    temp = fmt::format("{}", value);      \
-    flat->set(j, StringView(temp));       \
-    j++;                                  \
+#define SET_TASK_FMT_COLUMN(value)             \
+  std::string temp;                            \
+  for (vector_size_t j = 0; j < numRows; j++) { \
+    const auto& row = taskRows_[start + j];    \
+    const auto& task = row.task;               \
+    temp = fmt::format("{}", value);           \
+    flat->set(j, StringView(temp));            \
   }
 
-RowVectorPtr SystemDataSource::getTaskResults() {
-  auto taskMap = taskManager_->tasks();
-  auto numRows = taskMap.size();
+void SystemDataSource::collectTaskRows() {
+  taskRows_.clear();
+  nextTaskRow_ = 0;
+  // The snapshot is only rebuilt when tasks were added or removed, so a
+  // continuously polled unchanged task set is scanned without touching the
+  // task map's shard locks. Task state and stats are read from the live
+  // tasks the snapshot points to.
+  const auto snapshot = taskManager_->taskSetSnapshot();
+  for (const auto& task : snapshot->tasks) {
+    const auto& taskId = task->info.taskId;
+    if (!testFilter(taskIdFilter_, taskId) ||
+        !testFilter(queryIdFilter_, task->id.queryId())) {
+      continue;
+    }
+    std::string state;
+    if (stateFilter_ != nullptr || needsState_) {
+      // Matches the value produced for the state column below.
+      state = json(task->updateStatus().state).dump();
+      if (!testFilter(stateFilter_, state)) {
+        continue;
+      }
+    }
+    taskRows_.push_back({taskId, task, std::move(state)});
+  }
+}
 
-  std::vector<protocol::TaskInfo> taskInfos;
-  taskInfos.reserve(numRows);
-  for (const auto& taskEntry : taskMap) {
-    taskInfos.push_back(taskEntry.second->updateInfo(true));
+RowVectorPtr SystemDataSource::getTaskResults(
+    size_t start,
+    vector_size_t numRows) {
+  // TaskInfo with the full stats tree is only built when a stats column is
+  // projected; a query over the identity columns skips updateInfo() entirely.
+  std::vector<protocol::TaskInfo> taskInfos(numRows);
+  if (needsTaskInfo_) {
+    for (vector_size_t j = 0; j < numRows; j++) {
+      taskInfos[j] = taskRows_[start + j].task->updateInfo(true);
+    }
+  }
+
+  std::vector<ResultFetchPacingSummary> pacing(numRows);
+  if (needsPacing_) {
+    for (vector_size_t j = 0; j < numRows; j++) {
+      pacing[j] = taskRows_[start + j].task->resultFetchPacingSummary();
+    }
   }
 
   auto result = std::dynamic_pointer_cast<RowVector>(
@@ -190,7 +271,7 @@ RowVectorPtr SystemDataSource::getTaskResults() {
 
       case TaskColumnEnum::kTaskId: {
         auto flat = result->childAt(i)->as<FlatVector<StringView>>();
-        SET_TASK_COLUMN(StringView(taskInfo.taskId));
+        SET_TASK_COLUMN(StringView(row.taskId));
         break;
       }
 
@@ -214,7 +295,7 @@ RowVectorPtr SystemDataSource::getTaskResults() {
 
       case TaskColumnEnum::kState: {
         auto flat = result->childAt(i)->as<FlatVector<StringView>>();
-        SET_TASK_FMT_COLUMN(json(taskInfo.taskStatus.state).dump());
+        SET_TASK_COLUMN(StringView(row.state));
         break;
       }
 
@@ -326,6 +407,30 @@ RowVectorPtr SystemDataSource::getTaskResults() {
         SET_TASK_COLUMN(velox::Timestamp::fromMillis(task->lastEndTimeMs));
         break;
       }
+
+      case TaskColumnEnum::kResultConsumers: {
+        auto flat = result->childAt(i)->as<FlatVector<int64_t>>();
+        SET_TASK_COLUMN(pacing[j].numConsumers);
+        break;
+      }
+
+      case TaskColumnEnum::kResultFetches: {
+        auto flat = result->childAt(i)->as<FlatVector<int64_t>>();
+        SET_TASK_COLUMN(pacing[j].numFetches);
+        break;
+      }
+
+      case TaskColumnEnum::kResultFetchBytes: {
+        auto flat = result->childAt(i)->as<FlatVector<int64_t>>();
+        SET_TASK_COLUMN(pacing[j].totalBytes);
+        break;
+      }
+
+      case TaskColumnEnum::kResultFetchGapMs: {
+        auto flat = result->childAt(i)->as<FlatVector<int64_t>>();
+        SET_TASK_COLUMN(pacing[j].maxFetchGapMs);
+        break;
+      }
     }
   }
   return result;
@@ -338,11 +443,22 @@ std::optional<RowVectorPtr> SystemDataSource::next(
     return nullptr;
   }
 
-  auto result = getTaskResults();
+  if (!taskRowsCollected_) {
+    collectTaskRows();
+    taskRowsCollected_ = true;
+  }
+
+  const auto numRows = std::min<uint64_t>(size, taskRows_.size() - nextTaskRow_);
+  auto result = getTaskResults(nextTaskRow_, numRows);
+  nextTaskRow_ += numRows;
   completedRows_ += result->size();
   completedBytes_ += result->estimateFlatSize();
 
-  currentSplit_ = nullptr;
+  if (nextTaskRow_ == taskRows_.size()) {
+    currentSplit_ = nullptr;
+    taskRows_.clear();
+    taskRowsCollected_ = false;
+  }
 
   return result;
 }
@@ -382,10 +498,31 @@ SystemPrestoToVeloxConnector::toVeloxTableHandle(
           tableHandle.connectorTableLayout);
   VELOX_CHECK_NOT_NULL(
       systemLayout, "Unexpected table handle type {}", tableHandle.connectorId);
+
+  std::unordered_map<std::string, std::unique_ptr<velox::common::Filter>>
+      columnFilters;
+  if (systemLayout->constraint.domains != nullptr) {
+    for (const auto& [column, domain] : *systemLayout->constraint.domains) {
+      auto systemColumn =
+          std::dynamic_pointer_cast<protocol::SystemColumnHandle>(column);
+      if (systemColumn == nullptr) {
+        continue;
+      }
+      // The constraint is advisory: the engine re-applies the full predicate
+      // above the scan, so skip domains that have no Velox filter conversion.
+      try {
+        columnFilters[systemColumn->columnName] =
+            toFilter(domain, exprConverter, typeParser);
+      } catch (const velox::VeloxException&) {
+      }
+    }
+  }
+
   return std::make_unique<SystemTableHandle>(
       tableHandle.connectorId,
       systemLayout->table.schemaName,
-      systemLayout->table.tableName);
+      systemLayout->table.tableName,
+      std::move(columnFilters));
 }
 
 std::unique_ptr<protocol::ConnectorProtocol>
@@ -17,9 +17,11 @@
 #include "presto_cpp/main/connectors/SystemSplit.h"
 
 #include "velox/connectors/Connector.h"
+#include "velox/type/Filter.h"
 
 namespace facebook::presto {
 class TaskManager;
+struct PrestoTask;
 
 class SystemColumnHandle : public velox::connector::ColumnHandle {
  public:
@@ -35,10 +37,16 @@ class SystemColumnHandle : public velox::connector::ColumnHandle {
 
 class SystemTableHandle : public velox::connector::ConnectorTableHandle {
  public:
+  /// 'columnFilters' are the constraint domains the coordinator pushed into
+  /// the table layout, converted to Velox filters and keyed by column name.
+  /// They are advisory: the engine re-applies the full predicate above the
+  /// scan, so the data source may evaluate any subset of them.
   explicit SystemTableHandle(
       std::string connectorId,
       std::string schemaName,
-      std::string tableName);
+      std::string tableName,
+      std::unordered_map<std::string, std::unique_ptr<velox::common::Filter>>
+          columnFilters = {});
 
   std::string toString() const override;
 
@@ -56,10 +64,17 @@ class SystemTableHandle : public velox::connector::ConnectorTableHandle {
 
   const velox::RowTypePtr taskSchema() const;
 
+  const std::unordered_map<std::string, std::unique_ptr<velox::common::Filter>>&
+  columnFilters() const {
+    return columnFilters_;
+  }
+
  private:
   const std::string name_;
   const std::string schemaName_;
   const std::string tableName_;
+  const std::unordered_map<std::string, std::unique_ptr<velox::common::Filter>>
+      columnFilters_;
 };
 
 class SystemDataSource : public velox::connector::DataSource {
@@ -124,9 +139,29 @@ class SystemDataSource : public velox::connector::DataSource {
     kStart,
     kLastHeartBeat,
     kEnd,
+    kResultConsumers,
+    kResultFetches,
+    kResultFetchBytes,
+    kResultFetchGapMs,
+  };
+
+  // A task that passed the pushed-down filters, captured while iterating the
+  // TaskMap. 'state' is only populated when the state column is projected or
+  // filtered on.
+  struct TaskRow {
+    std::string taskId;
+    std::shared_ptr<PrestoTask> task;
+    std::string state;
   };
 
-  velox::RowVectorPtr getTaskResults();
+  // Walks the TaskMap shard-by-shard, applies the task_id/query_id/state
+  // filters and collects the matching tasks into 'taskRows_'.
+  void collectTaskRows();
+
+  // Builds the output columns for 'numRows' rows of 'taskRows_' starting at
+  // 'start'. TaskInfo (with full stats) is only materialized when a stats
+  // column is projected.
+  velox::RowVectorPtr getTaskResults(size_t start, velox::vector_size_t numRows);
 
   // Mapping between output columns and their indices (column_index_t)
   // corresponding to the taskInfo fields for them.
@@ -136,8 +171,29 @@ class SystemDataSource : public velox::connector::DataSource {
   const TaskManager* taskManager_;
   velox::memory::MemoryPool* pool_;
 
+  // Keeps the pushed-down filters referenced below alive.
+  std::shared_ptr<const SystemTableHandle> tableHandle_;
+  const velox::common::Filter* taskIdFilter_{nullptr};
+  const velox::common::Filter* queryIdFilter_{nullptr};
+  const velox::common::Filter* stateFilter_{nullptr};
+
+  // True when an output column is served from the task's TaskInfo stats;
+  // otherwise updateInfo() is skipped entirely.
+  bool needsTaskInfo_{false};
+  // True when the state column is projected.
+  bool needsState_{false};
+  // True when a result fetch pacing column is projected.
+  bool needsPacing_{false};
+
   std::shared_ptr<SystemSplit> currentSplit_;
 
+  // Tasks matching the filters for 'currentSplit_' and the cursor of the next
+  // row to return; filled on the first next() call and returned in batches of
+  // the requested size.
+  std::vector<TaskRow> taskRows_;
+  size_t nextTaskRow_{0};
+  bool taskRowsCollected_{false};
+
   size_t completedRows_{0};
   size_t completedBytes_{0};
 };
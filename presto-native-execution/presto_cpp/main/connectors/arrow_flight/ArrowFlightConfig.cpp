@@ -53,4 +53,8 @@ std::optional<std::string> ArrowFlightConfig::clientSslKey() const {
       config_->get<std::string>(kClientSslKey));
 }
 
+uint32_t ArrowFlightConfig::prefetchQueueDepth() const {
+  return config_->get<uint32_t>(kPrefetchQueueDepth, 0);
+}
+
 } // namespace facebook::presto
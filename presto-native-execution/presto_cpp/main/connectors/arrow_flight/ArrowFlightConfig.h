@@ -43,6 +43,13 @@ class ArrowFlightConfig {
 
   static constexpr const char* kClientSslKey = "arrow-flight.client-ssl-key";
 
+  /// Number of decoded record batches a data source prefetches from its
+  /// Flight stream on the connector IO executor, so network latency overlaps
+  /// with compute instead of being paid on every next() call. Zero reads
+  /// synchronously on the operator thread.
+  static constexpr const char* kPrefetchQueueDepth =
+      "arrow-flight.prefetch-queue-depth";
+
   std::string authenticatorName() const;
 
   std::optional<std::string> defaultServerHostname() const;
@@ -59,6 +66,8 @@ class ArrowFlightConfig {
 
   std::optional<std::string> clientSslKey() const;
 
+  uint32_t prefetchQueueDepth() const;
+
  private:
   const std::shared_ptr<const velox::config::ConfigBase> config_;
 };
@@ -16,9 +16,11 @@
 #include <arrow/c/bridge.h>
 #include <arrow/flight/api.h>
 #include <folly/base64.h>
+#include <atomic>
 #include <utility>
 #include "presto_cpp/main/common/ConfigReader.h"
 #include "presto_cpp/main/connectors/arrow_flight/Macros.h"
+#include "velox/common/time/Timer.h"
 #include "velox/vector/arrow/Bridge.h"
 
 using namespace facebook::velox::connector;
@@ -104,13 +106,16 @@ ArrowFlightDataSource::ArrowFlightDataSource(
     std::shared_ptr<Authenticator> authenticator,
     const ConnectorQueryCtx* connectorQueryCtx,
     const std::shared_ptr<ArrowFlightConfig>& flightConfig,
-    const std::shared_ptr<arrow::flight::FlightClientOptions>& clientOpts)
+    const std::shared_ptr<arrow::flight::FlightClientOptions>& clientOpts,
+    folly::Executor* ioExecutor)
     : outputType_{outputType},
       authenticator_{std::move(authenticator)},
       connectorQueryCtx_{connectorQueryCtx},
       flightConfig_{flightConfig},
       clientOpts_{clientOpts},
-      defaultLocation_(getDefaultLocation(flightConfig_)) {
+      defaultLocation_(getDefaultLocation(flightConfig_)),
+      ioExecutor_(ioExecutor),
+      prefetchQueueDepth_(flightConfig_->prefetchQueueDepth()) {
   VELOX_CHECK_NOT_NULL(clientOpts_, "FlightClientOptions is not initialized");
 
   // columnMapping_ contains the real column names in the expected order.
@@ -151,7 +156,12 @@ void ArrowFlightDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
 
   arrow::flight::Location loc;
   if (!flightEndpoint.locations.empty()) {
-    loc = flightEndpoint.locations[0];
+    // An endpoint lists one location per server able to serve this ticket.
+    // Spread the streams of concurrently running splits across them instead
+    // of saturating the first location while the others sit idle.
+    static std::atomic<size_t> nextLocation{0};
+    loc = flightEndpoint.locations
+        [nextLocation.fetch_add(1) % flightEndpoint.locations.size()];
   } else {
     VELOX_CHECK_NOT_NULL(
         defaultLocation_,
@@ -168,6 +178,91 @@ void ArrowFlightDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
 
   auto readerResult = client->DoGet(callOptsAddHeaders, flightEndpoint.ticket);
   AFC_ASSIGN_OR_RAISE(currentReader_, readerResult);
+  // The new stream may carry a different schema; re-resolve column indices
+  // from its first record batch.
+  columnIndices_.clear();
+
+  if (prefetchEnabled()) {
+    {
+      std::lock_guard<std::mutex> l(prefetchMutex_);
+      streamDone_ = false;
+      streamError_.clear();
+      abortPrefetch_ = false;
+      prefetchRunning_ = true;
+    }
+    ioExecutor_->add([this]() { prefetchLoop(); });
+  }
+}
+
+ArrowFlightDataSource::~ArrowFlightDataSource() {
+  stopPrefetch();
+}
+
+void ArrowFlightDataSource::prefetchLoop() {
+  for (;;) {
+    // Read from the stream without holding the lock so the operator thread
+    // can drain the queue while the network read is in flight.
+    auto result = currentReader_->Next();
+
+    std::unique_lock<std::mutex> l(prefetchMutex_);
+    if (abortPrefetch_) {
+      break;
+    }
+    if (!result.ok()) {
+      streamError_ = result.status().ToString();
+      streamDone_ = true;
+      break;
+    }
+    auto chunk = std::move(result).ValueUnsafe();
+    // A null record batch indicates that the Flight stream is complete.
+    if (!chunk.data) {
+      streamDone_ = true;
+      break;
+    }
+    prefetchCv_.wait(l, [&]() {
+      return prefetchQueue_.size() < prefetchQueueDepth_ || abortPrefetch_;
+    });
+    if (abortPrefetch_) {
+      break;
+    }
+    prefetchQueue_.push_back(std::move(chunk.data));
+    prefetchCv_.notify_all();
+  }
+
+  std::lock_guard<std::mutex> l(prefetchMutex_);
+  prefetchRunning_ = false;
+  prefetchCv_.notify_all();
+}
+
+std::shared_ptr<arrow::RecordBatch>
+ArrowFlightDataSource::nextPrefetchedBatch() {
+  std::unique_lock<std::mutex> l(prefetchMutex_);
+  prefetchObservedDepth_ += prefetchQueue_.size();
+  ++prefetchObservations_;
+  if (prefetchQueue_.empty() && !streamDone_) {
+    velox::MicrosecondTimer timer(&prefetchWaitUs_);
+    prefetchCv_.wait(l, [&]() { return !prefetchQueue_.empty() || streamDone_; });
+  }
+  if (!prefetchQueue_.empty()) {
+    auto batch = std::move(prefetchQueue_.front());
+    prefetchQueue_.pop_front();
+    prefetchCv_.notify_all();
+    return batch;
+  }
+  VELOX_CHECK(
+      streamError_.empty(), "Flight stream failed: {}", streamError_);
+  return nullptr;
+}
+
+void ArrowFlightDataSource::stopPrefetch() {
+  std::unique_lock<std::mutex> l(prefetchMutex_);
+  abortPrefetch_ = true;
+  if (prefetchRunning_ && currentReader_ != nullptr) {
+    // Unblock a prefetcher waiting on the network read.
+    currentReader_->Cancel();
+  }
+  prefetchCv_.notify_all();
+  prefetchCv_.wait(l, [&]() { return !prefetchRunning_; });
 }
 
 std::optional<velox::RowVectorPtr> ArrowFlightDataSource::next(
@@ -175,32 +270,69 @@ std::optional<velox::RowVectorPtr> ArrowFlightDataSource::next(
     velox::ContinueFuture& /* unused */) {
   VELOX_CHECK_NOT_NULL(currentReader_, "Missing split, call addSplit() first");
 
-  AFC_ASSIGN_OR_RAISE(auto chunk, currentReader_->Next());
+  std::shared_ptr<arrow::RecordBatch> batch;
+  if (prefetchEnabled()) {
+    batch = nextPrefetchedBatch();
+  } else {
+    AFC_ASSIGN_OR_RAISE(auto chunk, currentReader_->Next());
+    batch = std::move(chunk.data);
+  }
 
-  // Null values in the chunk indicates that the Flight stream is complete.
-  if (!chunk.data) {
+  // A null record batch indicates that the Flight stream is complete.
+  if (!batch) {
     currentReader_ = nullptr;
     return nullptr;
   }
 
   // Extract only required columns from the record batch as a velox RowVector.
-  auto output = projectOutputColumns(chunk.data);
+  auto output = projectOutputColumns(batch);
 
   completedRows_ += output->size();
   completedBytes_ += output->estimateFlatSize();
   return output;
 }
 
+std::unordered_map<std::string, velox::RuntimeMetric>
+ArrowFlightDataSource::getRuntimeStats() {
+  if (!prefetchEnabled()) {
+    return {};
+  }
+  std::lock_guard<std::mutex> l(prefetchMutex_);
+  return {
+      {"flightPrefetchWaitNanos",
+       velox::RuntimeMetric(
+           prefetchWaitUs_ * 1'000, velox::RuntimeCounter::Unit::kNanos)},
+      {"flightPrefetchQueuedBatches",
+       velox::RuntimeMetric(prefetchObservedDepth_)},
+      {"flightPrefetchPolls", velox::RuntimeMetric(prefetchObservations_)},
+  };
+}
+
 velox::RowVectorPtr ArrowFlightDataSource::projectOutputColumns(
     const std::shared_ptr<arrow::RecordBatch>& input) {
   velox::memory::MemoryPool* pool = connectorQueryCtx_->memoryPool();
+
+  // Resolve the column name lookups once per stream; the schema is the same
+  // for every record batch of a stream, so subsequent batches index the
+  // columns directly.
+  if (columnIndices_.empty()) {
+    columnIndices_.reserve(columnMapping_.size());
+    const auto& schema = input->schema();
+    for (const auto& name : columnMapping_) {
+      const auto index = schema->GetFieldIndex(name);
+      VELOX_CHECK_GE(index, 0, "column with name '{}' not found", name);
+      columnIndices_.push_back(index);
+    }
+  }
+
   std::vector<velox::VectorPtr> children;
-  children.reserve(columnMapping_.size());
+  children.reserve(columnIndices_.size());
 
-  // Extract and convert desired columns in the correct order.
-  for (const auto& name : columnMapping_) {
-    auto column = input->GetColumnByName(name);
-    VELOX_CHECK_NOT_NULL(column, "column with name '{}' not found", name);
+  // Wrap the desired columns in the correct order. The import wraps the
+  // Arrow buffers as velox buffer views without copying; the Arrow column
+  // stays alive through the release callback.
+  for (const auto index : columnIndices_) {
+    const auto& column = input->column(index);
     ArrowArray array;
     ArrowSchema schema;
     AFC_RAISE_NOT_OK(arrow::ExportArray(*column, &array, &schema));
@@ -227,7 +359,8 @@ ArrowFlightConnector::createDataSource(
       authenticator_,
       connectorQueryCtx,
       flightConfig_,
-      clientOpts_);
+      clientOpts_,
+      ioExecutor_);
 }
 
 } // namespace facebook::presto
@@ -13,6 +13,10 @@
  */
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 #include "presto_cpp/main/connectors/arrow_flight/ArrowFlightConfig.h"
 #include "presto_cpp/main/connectors/arrow_flight/auth/Authenticator.h"
 #include "velox/connectors/Connector.h"
@@ -68,13 +72,19 @@ class ArrowFlightColumnHandle : public velox::connector::ColumnHandle {
 
 class ArrowFlightDataSource : public velox::connector::DataSource {
  public:
+  /// 'ioExecutor' runs the record batch prefetcher when
+  /// 'arrow-flight.prefetch-queue-depth' is positive; prefetching is disabled
+  /// when it is null.
   ArrowFlightDataSource(
       const velox::RowTypePtr& outputType,
       const velox::connector::ColumnHandleMap& columnHandles,
       std::shared_ptr<Authenticator> authenticator,
       const velox::connector::ConnectorQueryCtx* connectorQueryCtx,
       const std::shared_ptr<ArrowFlightConfig>& flightConfig,
-      const std::shared_ptr<arrow::flight::FlightClientOptions>& clientOpts);
+      const std::shared_ptr<arrow::flight::FlightClientOptions>& clientOpts,
+      folly::Executor* ioExecutor);
+
+  ~ArrowFlightDataSource() override;
 
   void addSplit(
       std::shared_ptr<velox::connector::ConnectorSplit> split) override;
@@ -98,9 +108,7 @@ class ArrowFlightDataSource : public velox::connector::DataSource {
   }
 
   std::unordered_map<std::string, velox::RuntimeMetric> getRuntimeStats()
-      override {
-    return {};
-  }
+      override;
 
  private:
   /// Convert an Arrow record batch to Velox RowVector.
@@ -108,8 +116,28 @@ class ArrowFlightDataSource : public velox::connector::DataSource {
   velox::RowVectorPtr projectOutputColumns(
       const std::shared_ptr<arrow::RecordBatch>& input);
 
+  // True when record batches are fetched ahead on 'ioExecutor_'.
+  bool prefetchEnabled() const {
+    return prefetchQueueDepth_ > 0 && ioExecutor_ != nullptr;
+  }
+
+  // Runs on 'ioExecutor_': reads the Flight stream and fills 'prefetchQueue_'
+  // up to 'prefetchQueueDepth_' batches, blocking while the queue is full.
+  void prefetchLoop();
+
+  // Pops the next prefetched batch, waiting for the prefetcher when the queue
+  // is empty. Returns nullptr once the stream is exhausted; rethrows a failed
+  // stream read on the operator thread.
+  std::shared_ptr<arrow::RecordBatch> nextPrefetchedBatch();
+
+  // Stops the prefetcher, if any, and waits for it to exit.
+  void stopPrefetch();
+
   velox::RowTypePtr outputType_;
   std::vector<std::string> columnMapping_;
+  // Indices of 'columnMapping_' columns in the current stream's schema,
+  // resolved from the first record batch of each split.
+  std::vector<int> columnIndices_;
   std::unique_ptr<arrow::flight::FlightStreamReader> currentReader_;
   uint64_t completedRows_ = 0;
   uint64_t completedBytes_ = 0;
@@ -118,6 +146,28 @@ class ArrowFlightDataSource : public velox::connector::DataSource {
   const std::shared_ptr<ArrowFlightConfig> flightConfig_;
   const std::shared_ptr<arrow::flight::FlightClientOptions> clientOpts_;
   const std::shared_ptr<arrow::flight::Location> defaultLocation_;
+
+  folly::Executor* const ioExecutor_;
+  const uint32_t prefetchQueueDepth_;
+
+  // State shared with the prefetcher, guarded by 'prefetchMutex_'.
+  std::mutex prefetchMutex_;
+  std::condition_variable prefetchCv_;
+  std::deque<std::shared_ptr<arrow::RecordBatch>> prefetchQueue_;
+  // Set when the stream is exhausted or failed; no more batches will arrive.
+  bool streamDone_{false};
+  // Failure message from the prefetcher, rethrown on the operator thread.
+  std::string streamError_;
+  // Tells the prefetcher to exit without draining the stream.
+  bool abortPrefetch_{false};
+  // True while the prefetch loop is running on 'ioExecutor_'.
+  bool prefetchRunning_{false};
+
+  // Time next() spent waiting on an empty prefetch queue, and the queue depth
+  // observed at each next() call, reported through getRuntimeStats().
+  uint64_t prefetchWaitUs_{0};
+  uint64_t prefetchObservedDepth_{0};
+  uint64_t prefetchObservations_{0};
 };
 
 class ArrowFlightConnector : public velox::connector::Connector {
@@ -125,7 +175,8 @@ class ArrowFlightConnector : public velox::connector::Connector {
   explicit ArrowFlightConnector(
       const std::string& id,
       std::shared_ptr<const velox::config::ConfigBase> config,
-      const char* authenticatorName = nullptr)
+      const char* authenticatorName = nullptr,
+      folly::Executor* ioExecutor = nullptr)
       : Connector(id),
         flightConfig_(std::make_shared<ArrowFlightConfig>(config)),
         clientOpts_(initClientOpts(flightConfig_)),
@@ -133,7 +184,8 @@ class ArrowFlightConnector : public velox::connector::Connector {
                            authenticatorName
                                ? authenticatorName
                                : flightConfig_->authenticatorName())
-                           ->newAuthenticator(config)) {}
+                           ->newAuthenticator(config)),
+        ioExecutor_(ioExecutor) {}
 
   std::unique_ptr<velox::connector::DataSource> createDataSource(
       const velox::RowTypePtr& outputType,
@@ -157,6 +209,8 @@ class ArrowFlightConnector : public velox::connector::Connector {
   const std::shared_ptr<ArrowFlightConfig> flightConfig_;
   const std::shared_ptr<arrow::flight::FlightClientOptions> clientOpts_;
   const std::shared_ptr<Authenticator> authenticator_;
+  // Runs record batch prefetchers of the data sources; may be null.
+  folly::Executor* const ioExecutor_;
 };
 
 class ArrowFlightConnectorFactory : public velox::connector::ConnectorFactory {
@@ -176,7 +230,7 @@ class ArrowFlightConnectorFactory : public velox::connector::ConnectorFactory {
       folly::Executor* ioExecutor = nullptr,
       folly::Executor* cpuExecutor = nullptr) override {
     return std::make_shared<ArrowFlightConnector>(
-        id, config, authenticatorName_);
+        id, config, authenticatorName_, ioExecutor);
   }
 
  private:
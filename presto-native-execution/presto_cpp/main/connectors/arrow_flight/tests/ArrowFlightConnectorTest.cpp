@@ -230,6 +230,48 @@ TEST_F(ArrowFlightConnectorTest, multipleSplits) {
       .assertResults(makeRowVector({intVec, varcharVec, doubleVec}));
 }
 
+class ArrowFlightConnectorPrefetchTest : public ArrowFlightConnectorTestBase {
+ public:
+  ArrowFlightConnectorPrefetchTest()
+      : ArrowFlightConnectorTestBase(
+            std::make_shared<velox::config::ConfigBase>(
+                std::unordered_map<std::string, std::string>{
+                    {ArrowFlightConfig::kPrefetchQueueDepth, "4"}})) {}
+};
+
+TEST_F(ArrowFlightConnectorPrefetchTest, multipleBatches) {
+  // Small batches force the stream through many prefetch queue round trips.
+  vector_size_t numValues = 1000;
+  int64_t batchSize = 7;
+  std::vector<int64_t> idData(numValues);
+  std::vector<double> doubleData(numValues);
+
+  for (vector_size_t i = 0; i < numValues; i++) {
+    idData[i] = i;
+    doubleData[i] = i * 1.1;
+  }
+
+  updateTable(
+      "sample-data",
+      makeArrowTable(
+          {"id", "double_col"},
+          {makeNumericArray<arrow::Int64Type>(idData),
+           makeNumericArray<arrow::DoubleType>(doubleData)}));
+  setBatchSize(batchSize);
+
+  auto plan = ArrowFlightPlanBuilder()
+                  .flightTableScan(
+                      velox::ROW(
+                          {"id", "double_col"},
+                          {velox::BIGINT(), velox::DOUBLE()}))
+                  .planNode();
+
+  AssertQueryBuilder(plan)
+      .splits(makeSplits({"sample-data"}))
+      .assertResults(makeRowVector(
+          {makeFlatVector(idData), makeFlatVector(doubleData)}));
+}
+
 class ArrowFlightConnectorTestDefaultServer
     : public ArrowFlightConnectorTestBase {
  public:
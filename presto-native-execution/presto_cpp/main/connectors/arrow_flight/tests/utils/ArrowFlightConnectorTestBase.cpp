@@ -26,8 +26,9 @@ namespace facebook::presto::test {
 void ArrowFlightConnectorTestBase::SetUp() {
   OperatorTestBase::SetUp();
   presto::ArrowFlightConnectorFactory factory;
-  velox::connector::registerConnector(
-      factory.newConnector(kFlightConnectorId, config_));
+  connectorIoExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(2);
+  velox::connector::registerConnector(factory.newConnector(
+      kFlightConnectorId, config_, connectorIoExecutor_.get()));
 
   ArrowFlightConfig config(config_);
   if (config.defaultServerPort().has_value()) {
@@ -50,6 +51,7 @@ void ArrowFlightConnectorTestBase::SetUp() {
 void ArrowFlightConnectorTestBase::TearDown() {
   ASSERT_OK(server_->Shutdown());
   velox::connector::unregisterConnector(kFlightConnectorId);
+  connectorIoExecutor_.reset();
   OperatorTestBase::TearDown();
 }
 
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <arrow/flight/api.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
 #include "presto_cpp/main/connectors/arrow_flight/tests/utils/TestingArrowFlightServer.h"
 #include "velox/common/config/Config.h"
 #include "velox/connectors/Connector.h"
@@ -74,6 +75,9 @@ class ArrowFlightConnectorTestBase
   uint32_t port_;
   std::unique_ptr<TestingArrowFlightServer> server_;
   std::shared_ptr<velox::config::ConfigBase> config_;
+  // Runs the record batch prefetcher of data sources when
+  // 'arrow-flight.prefetch-queue-depth' is set in 'config_'.
+  std::unique_ptr<folly::IOThreadPoolExecutor> connectorIoExecutor_;
 };
 
 } // namespace facebook::presto::test
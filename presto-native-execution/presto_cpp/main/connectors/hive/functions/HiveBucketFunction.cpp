@@ -0,0 +1,162 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/connectors/hive/functions/HiveBucketFunction.h"
+
+#include "velox/expression/DecodedArgs.h"
+#include "velox/vector/FlatVector.h"
+
+using namespace facebook::velox;
+
+namespace facebook::presto::hive::functions {
+namespace {
+
+// Folds one key column into the per-row combined hashes with Hive's
+// hash * 31 + columnHash rule. 'hashOne' hashes a single non-null value; a
+// null key contributes a zero hash, as in Hive. The null check is hoisted
+// out of the row loop for columns without nulls.
+template <typename TValue, typename THashOne>
+void hashTypedColumn(
+    const DecodedVector& decoded,
+    const SelectivityVector& rows,
+    THashOne hashOne,
+    uint32_t* hashes) {
+  if (!decoded.mayHaveNulls()) {
+    rows.applyToSelected([&](vector_size_t row) {
+      hashes[row] = hashes[row] * 31 + hashOne(decoded.valueAt<TValue>(row));
+    });
+    return;
+  }
+  rows.applyToSelected([&](vector_size_t row) {
+    const uint32_t hash =
+        decoded.isNullAt(row) ? 0 : hashOne(decoded.valueAt<TValue>(row));
+    hashes[row] = hashes[row] * 31 + hash;
+  });
+}
+
+void hashColumn(
+    const DecodedVector& decoded,
+    const SelectivityVector& rows,
+    uint32_t* hashes) {
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::BOOLEAN:
+      hashTypedColumn<bool>(
+          decoded,
+          rows,
+          [](bool value) { return murmur3::hashInt32(value ? 1 : 0); },
+          hashes);
+      break;
+    case TypeKind::TINYINT:
+      hashTypedColumn<int8_t>(
+          decoded,
+          rows,
+          [](int8_t value) { return murmur3::hashInt32(value); },
+          hashes);
+      break;
+    case TypeKind::SMALLINT:
+      hashTypedColumn<int16_t>(
+          decoded,
+          rows,
+          [](int16_t value) { return murmur3::hashInt32(value); },
+          hashes);
+      break;
+    case TypeKind::INTEGER:
+      // Also covers date, which is stored as days in an integer.
+      hashTypedColumn<int32_t>(
+          decoded,
+          rows,
+          [](int32_t value) { return murmur3::hashInt32(value); },
+          hashes);
+      break;
+    case TypeKind::BIGINT:
+      hashTypedColumn<int64_t>(
+          decoded,
+          rows,
+          [](int64_t value) { return murmur3::hashInt64(value); },
+          hashes);
+      break;
+    case TypeKind::REAL:
+      hashTypedColumn<float>(
+          decoded,
+          rows,
+          [](float value) { return murmur3::hashFloat(value); },
+          hashes);
+      break;
+    case TypeKind::DOUBLE:
+      hashTypedColumn<double>(
+          decoded,
+          rows,
+          [](double value) { return murmur3::hashDouble(value); },
+          hashes);
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      hashTypedColumn<StringView>(
+          decoded,
+          rows,
+          [](StringView value) {
+            return murmur3::hashBytes(value.data(), value.size());
+          },
+          hashes);
+      break;
+    default:
+      VELOX_USER_FAIL(
+          "Unsupported Hive bucket key type {}",
+          decoded.base()->type()->toString());
+  }
+}
+
+} // namespace
+
+void HiveBucketFunction::apply(
+    const SelectivityVector& rows,
+    std::vector<VectorPtr>& args,
+    const TypePtr& /*outputType*/,
+    exec::EvalCtx& context,
+    VectorPtr& result) const {
+  VELOX_USER_CHECK_GE(
+      args.size(), 2, "bucket requires a bucket count and at least one key");
+  exec::DecodedArgs decodedArgs(rows, args, context);
+
+  // Combined hashes are built one key column at a time, so the type dispatch
+  // runs once per column rather than once per value.
+  std::vector<uint32_t> hashes(rows.end(), 0);
+  for (size_t i = 1; i < args.size(); ++i) {
+    hashColumn(*decodedArgs.at(i), rows, hashes.data());
+  }
+
+  context.ensureWritable(rows, INTEGER(), result);
+  auto* flatResult = result->asUnchecked<FlatVector<int32_t>>();
+  const auto* bucketCount = decodedArgs.at(0);
+  rows.applyToSelected([&](vector_size_t row) {
+    const auto numBuckets = bucketCount->valueAt<int32_t>(row);
+    VELOX_USER_CHECK_GT(
+        numBuckets, 0, "bucket count must be positive, got {}", numBuckets);
+    flatResult->set(
+        row,
+        static_cast<int32_t>(
+            (hashes[row] & 0x7fffffff) % static_cast<uint32_t>(numBuckets)));
+  });
+}
+
+// static
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+HiveBucketFunction::signatures() {
+  return {exec::FunctionSignatureBuilder()
+              .returnType("integer")
+              .argumentType("integer")
+              .variableArity("any")
+              .build()};
+}
+
+} // namespace facebook::presto::hive::functions
@@ -0,0 +1,176 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Portability.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "velox/expression/VectorFunction.h"
+#include "velox/functions/Macros.h"
+
+namespace facebook::presto::hive::functions {
+
+/// Hive's Murmur3 32-bit hash (org.apache.hive.common.util.Murmur3) with its
+/// default seed, used by Hive bucketing v2. Kept inline so the column-wise
+/// bucket kernel and its benchmark compile down to the same tight loops.
+namespace murmur3 {
+
+constexpr uint32_t kDefaultSeed = 104729;
+
+FOLLY_ALWAYS_INLINE uint32_t rotl32(uint32_t x, int8_t r) {
+  return (x << r) | (x >> (32 - r));
+}
+
+FOLLY_ALWAYS_INLINE uint32_t mixK1(uint32_t k1) {
+  k1 *= 0xcc9e2d51;
+  k1 = rotl32(k1, 15);
+  return k1 * 0x1b873593;
+}
+
+FOLLY_ALWAYS_INLINE uint32_t mixH1(uint32_t h1, uint32_t k1) {
+  h1 ^= k1;
+  h1 = rotl32(h1, 13);
+  return h1 * 5 + 0xe6546b64;
+}
+
+FOLLY_ALWAYS_INLINE uint32_t fmix(uint32_t h1, uint32_t length) {
+  h1 ^= length;
+  h1 ^= h1 >> 16;
+  h1 *= 0x85ebca6b;
+  h1 ^= h1 >> 13;
+  h1 *= 0xc2b2ae35;
+  h1 ^= h1 >> 16;
+  return h1;
+}
+
+FOLLY_ALWAYS_INLINE uint32_t hashInt32(int32_t value) {
+  return fmix(mixH1(kDefaultSeed, mixK1(static_cast<uint32_t>(value))), 4);
+}
+
+FOLLY_ALWAYS_INLINE uint32_t hashInt64(int64_t value) {
+  const auto bits = static_cast<uint64_t>(value);
+  uint32_t h1 = mixH1(kDefaultSeed, mixK1(static_cast<uint32_t>(bits)));
+  h1 = mixH1(h1, mixK1(static_cast<uint32_t>(bits >> 32)));
+  return fmix(h1, 8);
+}
+
+FOLLY_ALWAYS_INLINE uint32_t hashFloat(float value) {
+  // Java's Float.floatToIntBits collapses every NaN to the canonical one.
+  int32_t bits;
+  if (FOLLY_UNLIKELY(std::isnan(value))) {
+    bits = 0x7fc00000;
+  } else {
+    std::memcpy(&bits, &value, sizeof(bits));
+  }
+  return hashInt32(bits);
+}
+
+FOLLY_ALWAYS_INLINE uint32_t hashDouble(double value) {
+  int64_t bits;
+  if (FOLLY_UNLIKELY(std::isnan(value))) {
+    bits = 0x7ff8000000000000LL;
+  } else {
+    std::memcpy(&bits, &value, sizeof(bits));
+  }
+  return hashInt64(bits);
+}
+
+FOLLY_ALWAYS_INLINE uint32_t hashBytes(const char* data, uint32_t size) {
+  uint32_t h1 = kDefaultSeed;
+  const uint32_t numBlocks = size / 4;
+  for (uint32_t i = 0; i < numBlocks; ++i) {
+    uint32_t k1;
+    std::memcpy(&k1, data + i * 4, sizeof(k1));
+    h1 = mixH1(h1, mixK1(k1));
+  }
+  uint32_t k1 = 0;
+  for (uint32_t i = numBlocks * 4; i < size; ++i) {
+    k1 ^= static_cast<uint32_t>(static_cast<uint8_t>(data[i])) << ((i & 3) * 8);
+  }
+  h1 ^= mixK1(k1);
+  return fmix(h1, size);
+}
+
+} // namespace murmur3
+
+/// Vectorized Hive bucketing-v2 hash: "bucket(numBuckets, key...)" returns
+/// the bucket a row belongs to in a Hive-bucketed table. Each bucket key
+/// column is hashed with murmur3 in a column-wise loop (one type dispatch
+/// per column instead of one per value), the per-column hashes are combined
+/// with Hive's hash * 31 + columnHash rule and the combined hash is reduced
+/// modulo the bucket count. Null keys contribute a zero hash, as in Hive.
+///
+/// Supported key types: boolean, tinyint, smallint, integer (including
+/// date), bigint, real, double, varchar and varbinary.
+class HiveBucketFunction : public velox::exec::VectorFunction {
+ public:
+  void apply(
+      const velox::SelectivityVector& rows,
+      std::vector<velox::VectorPtr>& args,
+      const velox::TypePtr& outputType,
+      velox::exec::EvalCtx& context,
+      velox::VectorPtr& result) const override;
+
+  static std::vector<std::shared_ptr<velox::exec::FunctionSignature>>
+  signatures();
+};
+
+/// Extracts the bucket number from the file name of a Hive-bucketed table
+/// file for path-derived metadata: handles the classic "000042_0" layout as
+/// well as the "bucket-00042"/"bucket_00042" naming. Returns null when the
+/// file name does not start with a bucket number.
+template <typename T>
+struct BucketNumberFromPathFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  static constexpr bool is_default_ascii_behavior = true;
+
+  FOLLY_ALWAYS_INLINE bool call(
+      out_type<int32_t>& result,
+      const arg_type<velox::Varchar>& path) {
+    const char* data = path.data();
+    size_t size = path.size();
+    size_t pos = 0;
+    for (size_t i = size; i > 0; --i) {
+      if (data[i - 1] == '/') {
+        pos = i;
+        break;
+      }
+    }
+    static constexpr size_t kPrefixSize = 7; // "bucket-" / "bucket_".
+    if (size - pos > kPrefixSize && std::memcmp(data + pos, "bucket", 6) == 0 &&
+        (data[pos + 6] == '-' || data[pos + 6] == '_')) {
+      pos += kPrefixSize;
+    }
+    int64_t bucket = 0;
+    bool sawDigit = false;
+    while (pos < size && data[pos] >= '0' && data[pos] <= '9') {
+      bucket = bucket * 10 + (data[pos] - '0');
+      if (bucket > std::numeric_limits<int32_t>::max()) {
+        return false;
+      }
+      sawDigit = true;
+      ++pos;
+    }
+    if (!sawDigit) {
+      return false;
+    }
+    result = static_cast<int32_t>(bucket);
+    return true;
+  }
+};
+
+} // namespace facebook::presto::hive::functions
@@ -14,6 +14,7 @@
 
 #include "presto_cpp/main/connectors/hive/functions/HiveFunctionRegistration.h"
 
+#include "presto_cpp/main/connectors/hive/functions/HiveBucketFunction.h"
 #include "presto_cpp/main/connectors/hive/functions/InitcapFunction.h"
 #include "presto_cpp/main/functions/dynamic_registry/DynamicFunctionRegistrar.h"
 
@@ -25,6 +26,13 @@ void registerHiveFunctions() {
   // Register functions under the 'hive.default' namespace.
   facebook::presto::registerPrestoFunction<InitCapFunction, Varchar, Varchar>(
       "initcap", "hive.default");
+  facebook::presto::
+      registerPrestoFunction<BucketNumberFromPathFunction, int32_t, Varchar>(
+          "bucket_number_from_path", "hive.default");
+  exec::registerVectorFunction(
+      "hive.default.bucket",
+      HiveBucketFunction::signatures(),
+      std::make_unique<HiveBucketFunction>());
 }
 } // namespace
 
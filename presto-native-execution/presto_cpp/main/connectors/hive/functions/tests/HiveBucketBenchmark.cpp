@@ -0,0 +1,133 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <folly/lang/Assume.h>
+
+#include "presto_cpp/main/connectors/hive/functions/HiveBucketFunction.h"
+
+namespace facebook::presto::hive::functions {
+namespace {
+
+// Compares row-at-a-time bucket hashing (one type dispatch per value, the
+// shape of the previous scalar implementation) with the column-wise kernels
+// used by HiveBucketFunction on a typical bucketed-write key set: two bigint
+// keys and one short varchar key.
+
+constexpr int32_t kNumRows = 10'000;
+constexpr int32_t kNumBuckets = 512;
+
+struct BucketKeys {
+  std::vector<int64_t> longKeys1;
+  std::vector<int64_t> longKeys2;
+  std::vector<std::string> stringKeys;
+};
+
+enum class KeyKind { kLong1, kLong2, kString };
+
+BucketKeys makeKeys() {
+  BucketKeys keys;
+  folly::Random::DefaultGenerator rng(42);
+  keys.longKeys1.resize(kNumRows);
+  keys.longKeys2.resize(kNumRows);
+  keys.stringKeys.resize(kNumRows);
+  for (auto row = 0; row < kNumRows; ++row) {
+    keys.longKeys1[row] = folly::Random::rand64(rng);
+    keys.longKeys2[row] = folly::Random::rand64(rng);
+    keys.stringKeys[row] =
+        fmt::format("order-{}", folly::Random::rand32(rng) % 100'000);
+  }
+  return keys;
+}
+
+FOLLY_NOINLINE uint32_t
+hashOneKey(const BucketKeys& keys, KeyKind kind, int32_t row) {
+  // The per-value switch models the per-row type dispatch of a
+  // row-at-a-time implementation.
+  switch (kind) {
+    case KeyKind::kLong1:
+      return murmur3::hashInt64(keys.longKeys1[row]);
+    case KeyKind::kLong2:
+      return murmur3::hashInt64(keys.longKeys2[row]);
+    case KeyKind::kString: {
+      const auto& value = keys.stringKeys[row];
+      return murmur3::hashBytes(value.data(), value.size());
+    }
+  }
+  folly::assume_unreachable();
+}
+
+void rowAtATime(size_t iterations) {
+  folly::BenchmarkSuspender suspender;
+  const auto keys = makeKeys();
+  std::vector<int32_t> buckets(kNumRows);
+  suspender.dismiss();
+
+  for (size_t i = 0; i < iterations; ++i) {
+    for (int32_t row = 0; row < kNumRows; ++row) {
+      uint32_t hash = 0;
+      for (auto kind : {KeyKind::kLong1, KeyKind::kLong2, KeyKind::kString}) {
+        hash = hash * 31 + hashOneKey(keys, kind, row);
+      }
+      buckets[row] = (hash & 0x7fffffff) % kNumBuckets;
+    }
+    folly::doNotOptimizeAway(buckets);
+  }
+}
+
+void columnWise(size_t iterations) {
+  folly::BenchmarkSuspender suspender;
+  const auto keys = makeKeys();
+  std::vector<uint32_t> hashes(kNumRows);
+  std::vector<int32_t> buckets(kNumRows);
+  suspender.dismiss();
+
+  for (size_t i = 0; i < iterations; ++i) {
+    std::fill(hashes.begin(), hashes.end(), 0);
+    for (int32_t row = 0; row < kNumRows; ++row) {
+      hashes[row] = hashes[row] * 31 + murmur3::hashInt64(keys.longKeys1[row]);
+    }
+    for (int32_t row = 0; row < kNumRows; ++row) {
+      hashes[row] = hashes[row] * 31 + murmur3::hashInt64(keys.longKeys2[row]);
+    }
+    for (int32_t row = 0; row < kNumRows; ++row) {
+      const auto& value = keys.stringKeys[row];
+      hashes[row] =
+          hashes[row] * 31 + murmur3::hashBytes(value.data(), value.size());
+    }
+    for (int32_t row = 0; row < kNumRows; ++row) {
+      buckets[row] = (hashes[row] & 0x7fffffff) % kNumBuckets;
+    }
+    folly::doNotOptimizeAway(buckets);
+  }
+}
+
+BENCHMARK(bucketRowAtATime10k, n) {
+  rowAtATime(n);
+}
+
+BENCHMARK_RELATIVE(bucketColumnWise10k, n) {
+  columnWise(n);
+}
+
+} // namespace
+} // namespace facebook::presto::hive::functions
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
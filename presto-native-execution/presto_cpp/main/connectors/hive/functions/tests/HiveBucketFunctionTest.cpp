@@ -0,0 +1,135 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include "presto_cpp/main/connectors/hive/functions/HiveFunctionRegistration.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+namespace facebook::presto::functions::test {
+namespace {
+
+class HiveBucketFunctionTest
+    : public velox::functions::test::FunctionBaseTest {
+ protected:
+  static void SetUpTestCase() {
+    velox::functions::test::FunctionBaseTest::SetUpTestCase();
+    facebook::presto::hive::functions::registerHiveNativeFunctions();
+  }
+};
+
+// Expected buckets come from a reference implementation of Hive's Murmur3
+// (seed 104729) and bucketing-v2 semantics: per-column murmur hash, columns
+// combined with hash * 31 + columnHash, bucket = (hash & MAX_INT) % count.
+TEST_F(HiveBucketFunctionTest, singleKey) {
+  const auto bucketOfInt = [&](std::optional<int32_t> value, int32_t count) {
+    return evaluateOnce<int32_t>(
+        "\"hive.default.bucket\"(c1, c0)",
+        value,
+        std::optional<int32_t>(count));
+  };
+  EXPECT_EQ(bucketOfInt(0, 8), 1);
+  EXPECT_EQ(bucketOfInt(1, 8), 1);
+  EXPECT_EQ(bucketOfInt(42, 8), 6);
+  EXPECT_EQ(bucketOfInt(-1, 32), 13);
+  // A null key hashes to 0.
+  EXPECT_EQ(bucketOfInt(std::nullopt, 8), 0);
+
+  const auto bucketOfLong = [&](std::optional<int64_t> value, int32_t count) {
+    return evaluateOnce<int32_t>(
+        "\"hive.default.bucket\"(c1, c0)",
+        value,
+        std::optional<int32_t>(count));
+  };
+  EXPECT_EQ(bucketOfLong(1234, 8), 6);
+  EXPECT_EQ(bucketOfLong(-987654321, 32), 23);
+
+  const auto bucketOfString = [&](std::optional<std::string> value,
+                                  int32_t count) {
+    return evaluateOnce<int32_t>(
+        "\"hive.default.bucket\"(c1, c0)",
+        value,
+        std::optional<int32_t>(count));
+  };
+  EXPECT_EQ(bucketOfString("presto", 8), 1);
+  EXPECT_EQ(bucketOfString("", 32), 22);
+  EXPECT_EQ(bucketOfString("hive bucketing v2", 32), 21);
+}
+
+TEST_F(HiveBucketFunctionTest, multipleKeys) {
+  const auto bucket = [&](std::optional<int64_t> key1,
+                          std::optional<std::string> key2,
+                          int32_t count) {
+    return evaluateOnce<int32_t>(
+        "\"hive.default.bucket\"(c2, c0, c1)",
+        key1,
+        key2,
+        std::optional<int32_t>(count));
+  };
+  EXPECT_EQ(bucket(1234, "presto", 32), 27);
+  // The null key contributes a zero hash to the combination.
+  EXPECT_EQ(bucket(std::nullopt, "presto", 32), 9);
+}
+
+TEST_F(HiveBucketFunctionTest, columnWiseMatchesEncodings) {
+  // The column-wise kernel must produce the same buckets regardless of the
+  // input encoding.
+  auto flatKeys = makeFlatVector<int64_t>(100, [](auto row) {
+    return row * 1'000'000'007;
+  });
+  auto counts = makeConstant<int32_t>(32, 100);
+  auto flatResult = evaluate(
+      "\"hive.default.bucket\"(c0, c1)", makeRowVector({counts, flatKeys}));
+
+  auto indices = makeIndices(100, [](auto row) { return 99 - row; });
+  auto dictKeys = wrapInDictionary(indices, 100, flatKeys);
+  auto dictResult = evaluate(
+      "\"hive.default.bucket\"(c0, c1)", makeRowVector({counts, dictKeys}));
+
+  for (auto row = 0; row < 100; ++row) {
+    EXPECT_EQ(
+        dictResult->asFlatVector<int32_t>()->valueAt(row),
+        flatResult->asFlatVector<int32_t>()->valueAt(99 - row))
+        << "at " << row;
+    const auto bucket = flatResult->asFlatVector<int32_t>()->valueAt(row);
+    EXPECT_GE(bucket, 0);
+    EXPECT_LT(bucket, 32);
+  }
+}
+
+TEST_F(HiveBucketFunctionTest, errors) {
+  VELOX_ASSERT_THROW(
+      evaluateOnce<int32_t>(
+          "\"hive.default.bucket\"(c1, c0)",
+          std::optional<int64_t>(1),
+          std::optional<int32_t>(0)),
+      "bucket count must be positive");
+}
+
+TEST_F(HiveBucketFunctionTest, bucketNumberFromPath) {
+  const auto bucketNumber = [&](const std::optional<std::string>& path) {
+    return evaluateOnce<int32_t>(
+        "\"hive.default.bucket_number_from_path\"(c0)", path);
+  };
+  EXPECT_EQ(bucketNumber("/warehouse/t/ds=2020-01-02/000042_0"), 42);
+  EXPECT_EQ(bucketNumber("/warehouse/t/000007_0_20200102_123456"), 7);
+  EXPECT_EQ(bucketNumber("bucket-00012"), 12);
+  EXPECT_EQ(bucketNumber("/warehouse/t/bucket_00012-attempt_1"), 12);
+  EXPECT_EQ(bucketNumber("/warehouse/t/part-00000"), std::nullopt);
+  EXPECT_EQ(bucketNumber(""), std::nullopt);
+  EXPECT_EQ(bucketNumber(std::nullopt), std::nullopt);
+}
+
+} // namespace
+} // namespace facebook::presto::functions::test
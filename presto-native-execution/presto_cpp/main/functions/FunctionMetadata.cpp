@@ -11,6 +11,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <atomic>
+#include <mutex>
+
 #include "presto_cpp/main/functions/FunctionMetadata.h"
 #include "presto_cpp/main/common/Utils.h"
 #include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
@@ -320,4 +323,50 @@ json getFunctionsMetadata(const std::optional<std::string>& catalog) {
   return j;
 }
 
+namespace {
+
+// Generation of the function registry; advanced on runtime registrations to
+// invalidate the cached responses below.
+std::atomic<uint64_t> registryGeneration{1};
+
+struct CachedMetadataResponse {
+  uint64_t generation{0};
+  FunctionMetadataResponse response;
+};
+
+// Serialized responses keyed by catalog ('' for all catalogs), valid while
+// the registry generation is unchanged.
+std::mutex metadataCacheMutex;
+std::unordered_map<std::string, CachedMetadataResponse> metadataCache;
+
+} // namespace
+
+FunctionMetadataResponse getFunctionsMetadataCached(
+    const std::optional<std::string>& catalog) {
+  const auto generation = registryGeneration.load(std::memory_order_relaxed);
+  const std::string key = catalog.value_or("");
+  {
+    std::lock_guard<std::mutex> l(metadataCacheMutex);
+    auto it = metadataCache.find(key);
+    if (it != metadataCache.end() && it->second.generation == generation) {
+      return it->second.response;
+    }
+  }
+
+  FunctionMetadataResponse response;
+  response.body = getFunctionsMetadata(catalog).dump();
+  // Content-derived strong ETag, so it stays comparable across worker
+  // restarts.
+  response.etag =
+      fmt::format("\"{:x}\"", std::hash<std::string>{}(response.body));
+
+  std::lock_guard<std::mutex> l(metadataCacheMutex);
+  metadataCache[key] = CachedMetadataResponse{generation, response};
+  return response;
+}
+
+void bumpFunctionRegistryGeneration() {
+  registryGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
 } // namespace facebook::presto
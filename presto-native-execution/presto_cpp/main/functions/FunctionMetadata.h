@@ -23,4 +23,22 @@ namespace facebook::presto {
 nlohmann::json getFunctionsMetadata(
     const std::optional<std::string>& catalog = std::nullopt);
 
+/// Serialized function metadata response plus a strong ETag derived from its
+/// content, served by the /v1/functions endpoints.
+struct FunctionMetadataResponse {
+  std::string body;
+  std::string etag;
+};
+
+/// Returns the serialized metadata for registered functions. Responses are
+/// cached per catalog and rebuilt only after the function registry generation
+/// moves, so the repeated multi-megabyte discovery requests of coordinator
+/// and sidecar serve the cached bytes.
+FunctionMetadataResponse getFunctionsMetadataCached(
+    const std::optional<std::string>& catalog = std::nullopt);
+
+/// Advances the function registry generation, invalidating the cached
+/// metadata responses. Must be called after registering functions at runtime.
+void bumpFunctionRegistryGeneration();
+
 } // namespace facebook::presto
@@ -19,6 +19,7 @@
 
 #include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/common/Utils.h"
+#include "presto_cpp/main/functions/FunctionMetadata.h"
 #include "presto_cpp/main/functions/remote/RestRemoteFunction.h"
 #include "presto_cpp/main/functions/remote/client/RestRemoteClient.h"
 
@@ -162,5 +163,9 @@ void PrestoRestFunctionRegistration::registerFunction(
     std::lock_guard<std::mutex> lock(registrationMutex_);
     registeredFunctionHandles_[functionId] = serializedFunctionHandle;
   }
+
+  // The registered function set changed; invalidate the cached metadata
+  // responses served by the /v1/functions endpoints.
+  bumpFunctionRegistryGeneration();
 }
 } // namespace facebook::presto::functions::remote::rest
@@ -13,8 +13,14 @@
  */
 
 #include "presto_cpp/main/functions/remote/RestRemoteFunction.h"
+#include <cstring>
+#include <optional>
+#include "presto_cpp/main/common/Counters.h"
+#include "presto_cpp/main/functions/remote/client/RemoteFunctionMemoCache.h"
 #include "presto_cpp/main/functions/remote/client/RestRemoteClient.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/functions/remote/client/RemoteVectorFunction.h"
+#include "velox/row/CompactRow.h"
 
 using namespace facebook::velox;
 namespace facebook::presto::functions::remote::rest {
@@ -30,7 +36,23 @@ class RestRemoteFunction : public velox::functions::RemoteVectorFunction {
       : RemoteVectorFunction(functionName, inputArgs, metadata),
         location_(metadata.location),
         serdeFormat_(metadata.serdeFormat),
-        restClient_(std::move(restClient)) {}
+        restClient_(std::move(restClient)),
+        memoCache_(
+            metadata.deterministic ? RemoteFunctionMemoCache::instance()
+                                   : nullptr) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    if (memoCache_ == nullptr) {
+      RemoteVectorFunction::apply(rows, args, outputType, context, result);
+      return;
+    }
+    applyWithMemoCache(rows, args, outputType, context, result);
+  }
 
  protected:
   std::unique_ptr<velox::functions::remote::RemoteFunctionResponse>
@@ -63,9 +85,103 @@ class RestRemoteFunction : public velox::functions::RemoteVectorFunction {
   }
 
  private:
+  // Splits the batch into rows answered from the memo cache and rows that
+  // must go to the function server, invokes the server for the misses only
+  // and scatters the cached results into place. Keys are the function
+  // location plus the CompactRow serialization of the input row, so equal
+  // inputs hit regardless of their position or batch.
+  void applyWithMemoCache(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const {
+    auto* pool = context.pool();
+    std::vector<TypePtr> argTypes;
+    argTypes.reserve(args.size());
+    for (const auto& arg : args) {
+      argTypes.push_back(arg->type());
+    }
+    auto inputRow = std::make_shared<RowVector>(
+        pool, ROW(std::move(argTypes)), nullptr, rows.end(), args);
+    row::CompactRow compactInput(inputRow);
+
+    std::vector<std::optional<std::string>> cached(rows.end());
+    std::vector<std::string> missKeys(rows.end());
+    exec::LocalSelectivityVector missHolder(context, rows.end());
+    auto* missRows = missHolder.get();
+    missRows->clearAll();
+    int64_t numHits{0};
+    int64_t numMisses{0};
+    rows.applyToSelected([&](vector_size_t row) {
+      std::string key;
+      key.resize(location_.size() + 1 + compactInput.rowSize(row));
+      std::memcpy(key.data(), location_.data(), location_.size());
+      key[location_.size()] = '\0';
+      compactInput.serialize(row, key.data() + location_.size() + 1);
+      cached[row] = memoCache_->get(key);
+      if (cached[row].has_value()) {
+        ++numHits;
+      } else {
+        ++numMisses;
+        missKeys[row] = std::move(key);
+        missRows->setValid(row, true);
+      }
+    });
+    missRows->updateBounds();
+    RECORD_METRIC_VALUE(kCounterRemoteFunctionMemoCacheHits, numHits);
+    RECORD_METRIC_VALUE(kCounterRemoteFunctionMemoCacheMisses, numMisses);
+
+    if (missRows->hasSelections()) {
+      RemoteVectorFunction::apply(*missRows, args, outputType, context, result);
+      // Rows that errored carry no usable result; skip caching the batch.
+      if (context.errors() == nullptr) {
+        auto resultRow = std::make_shared<RowVector>(
+            pool,
+            ROW({outputType}),
+            nullptr,
+            rows.end(),
+            std::vector<VectorPtr>{result});
+        row::CompactRow compactResult(resultRow);
+        missRows->applyToSelected([&](vector_size_t row) {
+          std::string value;
+          value.resize(compactResult.rowSize(row));
+          compactResult.serialize(row, value.data());
+          memoCache_->put(std::move(missKeys[row]), std::move(value));
+        });
+      }
+    }
+
+    if (numHits == 0) {
+      return;
+    }
+
+    // Materialize the cached result rows and scatter them into place.
+    std::vector<std::string_view> hitValues;
+    std::vector<vector_size_t> hitRowNumbers;
+    hitValues.reserve(numHits);
+    hitRowNumbers.reserve(numHits);
+    rows.applyToSelected([&](vector_size_t row) {
+      if (cached[row].has_value()) {
+        hitValues.push_back(*cached[row]);
+        hitRowNumbers.push_back(row);
+      }
+    });
+    auto deserialized =
+        row::CompactRow::deserialize(hitValues, ROW({outputType}), pool);
+    const auto& values = deserialized->childAt(0);
+    BaseVector::ensureWritable(rows, outputType, pool, result);
+    for (size_t i = 0; i < hitRowNumbers.size(); ++i) {
+      result->copy(values.get(), hitRowNumbers[i], i, 1);
+    }
+  }
+
   const std::string location_;
   const velox::functions::remote::PageFormat serdeFormat_;
   const RestRemoteClientPtr restClient_;
+  // Process-wide memo cache for deterministic functions; nullptr when the
+  // function is not deterministic or memoization is disabled.
+  RemoteFunctionMemoCache* const memoCache_;
 };
 
 std::shared_ptr<exec::VectorFunction> createRestRemoteFunction(
@@ -0,0 +1,59 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "presto_cpp/main/functions/remote/client/RemoteFunctionMemoCache.h"
+
+#include "presto_cpp/main/common/Configs.h"
+
+namespace facebook::presto::functions::remote::rest {
+
+// static
+RemoteFunctionMemoCache* RemoteFunctionMemoCache::instance() {
+  static const uint64_t maxBytes =
+      SystemConfig::instance()->remoteFunctionServerRestMemoCacheMaxBytes();
+  if (maxBytes == 0) {
+    return nullptr;
+  }
+  static RemoteFunctionMemoCache cache(maxBytes);
+  return &cache;
+}
+
+std::optional<std::string> RemoteFunctionMemoCache::get(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->resultRow;
+}
+
+void RemoteFunctionMemoCache::put(std::string key, std::string resultRow) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (entries_.count(key) != 0) {
+    return;
+  }
+  currentBytes_ += key.size() + resultRow.size();
+  lru_.push_front(Entry{std::move(key), std::move(resultRow)});
+  entries_.emplace(lru_.front().key, lru_.begin());
+  while (currentBytes_ > maxBytes_ && !lru_.empty()) {
+    const auto& victim = lru_.back();
+    currentBytes_ -= victim.key.size() + victim.resultRow.size();
+    entries_.erase(victim.key);
+    lru_.pop_back();
+  }
+}
+
+} // namespace facebook::presto::functions::remote::rest
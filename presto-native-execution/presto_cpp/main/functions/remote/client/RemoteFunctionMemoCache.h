@@ -0,0 +1,70 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace facebook::presto::functions::remote::rest {
+
+/// Memo cache for deterministic remote function results. Keys are the
+/// function's remote location plus the serialized bytes of one input row;
+/// values are the serialized bytes of the corresponding result row, so a
+/// lookup replaces a network round trip to the function server with a local
+/// deserialization. Deterministic results never go stale, so entries are
+/// only dropped by LRU eviction when the configured byte budget is
+/// exceeded. Thread-safe; shared by all remote functions of the process.
+class RemoteFunctionMemoCache {
+ public:
+  explicit RemoteFunctionMemoCache(uint64_t maxBytes) : maxBytes_(maxBytes) {}
+
+  /// Returns the process-wide instance sized by
+  /// 'remote-function-server.rest.memo-cache-max-bytes', or nullptr when the
+  /// budget is zero.
+  static RemoteFunctionMemoCache* instance();
+
+  /// Returns the cached serialized result row for 'key' and marks the entry
+  /// most recently used, or std::nullopt on a miss.
+  std::optional<std::string> get(const std::string& key);
+
+  /// Remembers 'resultRow' as the result for 'key', evicting least recently
+  /// used entries while over budget. A key already present is left as is:
+  /// the function is deterministic, so the stored value is equivalent.
+  void put(std::string key, std::string resultRow);
+
+  uint64_t currentBytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return currentBytes_;
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    std::string resultRow;
+  };
+
+  const uint64_t maxBytes_;
+
+  mutable std::mutex mutex_;
+  // Most recently used entries at the front.
+  std::list<Entry> lru_;
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> entries_;
+  uint64_t currentBytes_{0};
+};
+
+} // namespace facebook::presto::functions::remote::rest
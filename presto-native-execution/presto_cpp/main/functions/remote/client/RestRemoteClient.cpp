@@ -15,6 +15,7 @@
 #include "presto_cpp/main/functions/remote/client/RestRemoteClient.h"
 
 #include <folly/Uri.h>
+#include <folly/executors/GlobalExecutor.h>
 #include <proxygen/lib/http/HTTPMessage.h>
 
 #include "presto_cpp/main/functions/remote/utils/ContentTypes.h"
@@ -38,24 +39,83 @@ RestRemoteClient::RestRemoteClient(const std::string& url) : url_(url) {
   proxygen::Endpoint endpoint(uri.host(), uri.port(), uri.scheme() == "https");
   folly::SocketAddress addr(uri.host().c_str(), uri.port(), true);
 
-  evbThread_ = std::make_unique<folly::ScopedEventBaseThread>("rest-client");
-  httpClient_ = std::make_shared<http::HttpClient>(
-      evbThread_->getEventBase(),
-      nullptr,
-      endpoint,
-      addr,
-      requestTimeoutMs,
-      connectTimeoutMs,
-      memPool_,
-      nullptr);
+  const auto numConnections = std::max<uint32_t>(
+      1, SystemConfig::instance()->remoteFunctionServerRestNumConnections());
+  auto ioExecutor = folly::getGlobalIOExecutor();
+  httpClients_.reserve(numConnections);
+  for (uint32_t i = 0; i < numConnections; ++i) {
+    auto* eventBase = ioExecutor->getEventBase();
+    httpClients_.emplace_back(
+        eventBase,
+        std::make_shared<http::HttpClient>(
+            eventBase,
+            nullptr,
+            endpoint,
+            addr,
+            requestTimeoutMs,
+            connectTimeoutMs,
+            memPool_,
+            nullptr));
+  }
 }
 
 RestRemoteClient::~RestRemoteClient() {
-  if (httpClient_) {
-    evbThread_->getEventBase()->runInEventBaseThreadAndWait(
-        [client = std::move(httpClient_)]() mutable { client.reset(); });
+  // HttpClient owns a proxygen::SessionPool which must be destroyed on its
+  // event base thread.
+  for (auto& [eventBase, client] : httpClients_) {
+    eventBase->runInEventBaseThreadAndWait(
+        [client = std::move(client)]() mutable { client.reset(); });
   }
-  evbThread_.reset();
+}
+
+folly::SemiFuture<std::unique_ptr<folly::IOBuf>>
+RestRemoteClient::invokeFunctionAsync(
+    const std::string& fullUrl,
+    velox::functions::remote::PageFormat serdeFormat,
+    std::unique_ptr<folly::IOBuf> requestPayload) const {
+  folly::Uri uri(fullUrl);
+  const std::string contentType = getContentType(serdeFormat);
+  proxygen::HTTPMessage message;
+  message.setMethod(proxygen::HTTPMethod::POST);
+  message.setURL(uri.path());
+  message.setHTTPVersion(1, 1);
+  message.getHeaders().add("Content-Type", contentType);
+  message.getHeaders().add("Accept", contentType);
+
+  requestPayload->coalesce();
+  std::string requestBody = requestPayload->moveToFbString().toStdString();
+
+  // Round-robin over the connection pool so concurrent in-flight requests
+  // overlap on parallel connections.
+  const auto& client =
+      httpClients_[nextClient_.fetch_add(1, std::memory_order_relaxed) %
+                   httpClients_.size()]
+          .second;
+
+  return client->sendRequest(message, requestBody)
+      .deferValue(
+          [fullUrl, host = uri.host()](std::unique_ptr<http::HttpResponse>
+                                           response)
+              -> std::unique_ptr<folly::IOBuf> {
+            if (!response) {
+              VELOX_FAIL(
+                  "Null response object returned from HTTP request to {}.",
+                  host);
+            }
+            if (response->hasError()) {
+              VELOX_FAIL("HTTP error: {}", response->error());
+            }
+            const int status = response->headers()->getStatusCode();
+            if (status < http::kHttpOk ||
+                status >= http::kHttpMultipleChoices) {
+              VELOX_FAIL(
+                  "Server responded with status {}. Body: '{}'. URL: {}",
+                  status,
+                  response->dumpBodyChain(),
+                  fullUrl);
+            }
+            return folly::IOBuf::copyBuffer(response->dumpBodyChain());
+          });
 }
 
 std::unique_ptr<folly::IOBuf> RestRemoteClient::invokeFunction(
@@ -63,47 +123,10 @@ std::unique_ptr<folly::IOBuf> RestRemoteClient::invokeFunction(
     velox::functions::remote::PageFormat serdeFormat,
     std::unique_ptr<folly::IOBuf> requestPayload) const {
   try {
-    folly::Uri uri(fullUrl);
-    const std::string contentType = getContentType(serdeFormat);
-    auto message = std::make_unique<proxygen::HTTPMessage>();
-    message->setMethod(proxygen::HTTPMethod::POST);
-    message->setURL(uri.path());
-    message->setHTTPVersion(1, 1);
-    message->getHeaders().add("Content-Type", contentType);
-    message->getHeaders().add("Accept", contentType);
-
-    requestPayload->coalesce();
-    std::string requestBody = requestPayload->moveToFbString().toStdString();
-
-    auto sendFuture = httpClient_->sendRequest(*message, requestBody);
-    sendFuture.wait();
-
-    VELOX_CHECK(
-        sendFuture.hasValue(),
-        "Invalid response returned from HTTP request to {}.",
-        uri.host());
-
-    std::unique_ptr<http::HttpResponse> resp = std::move(sendFuture).get();
-
-    if (!resp) {
-      VELOX_FAIL(
-          "Null response object returned from HTTP request to {}.", uri.host());
-    }
-
-    if (resp->hasError()) {
-      VELOX_FAIL("HTTP error: {}", resp->error());
-    }
-
-    int status = resp->headers()->getStatusCode();
-    if (status < http::kHttpOk || status >= http::kHttpMultipleChoices) {
-      VELOX_FAIL(
-          "Server responded with status {}. Body: '{}'. URL: {}",
-          status,
-          resp->dumpBodyChain(),
-          fullUrl);
-    }
-
-    return folly::IOBuf::copyBuffer(resp->dumpBodyChain());
+    return invokeFunctionAsync(fullUrl, serdeFormat, std::move(requestPayload))
+        .get();
+  } catch (const VeloxException&) {
+    throw;
   } catch (const std::exception& ex) {
     VELOX_FAIL("HTTP invocation failed for URL {}: {}", fullUrl, ex.what());
   }
@@ -14,7 +14,7 @@
 
 #pragma once
 
-#include <folly/io/async/ScopedEventBaseThread.h>
+#include <folly/io/async/EventBase.h>
 
 #include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/http/HttpClient.h"
@@ -22,12 +22,27 @@
 
 namespace facebook::presto::functions::remote::rest {
 
+/// HTTP client for one remote function server. Holds a small pool of
+/// connections spread over the event bases of the global IO executor and
+/// round-robins requests across them, so the batches of concurrent driver
+/// threads calling the same server are multiplexed over parallel connections
+/// instead of queueing behind a single one. One instance is shared by all
+/// functions registered against the same server URL.
 class RestRemoteClient {
  public:
-  RestRemoteClient(const std::string& url);
+  explicit RestRemoteClient(const std::string& url);
 
   ~RestRemoteClient();
 
+  /// Sends 'requestPayload' to 'fullUrl' and returns a future fulfilled with
+  /// the response body once it arrives. Callers may keep several requests in
+  /// flight to pipeline batches; they are spread over the connection pool.
+  folly::SemiFuture<std::unique_ptr<folly::IOBuf>> invokeFunctionAsync(
+      const std::string& fullUrl,
+      velox::functions::remote::PageFormat serdeFormat,
+      std::unique_ptr<folly::IOBuf> requestPayload) const;
+
+  /// Blocking variant of invokeFunctionAsync().
   std::unique_ptr<folly::IOBuf> invokeFunction(
       const std::string& fullUrl,
       velox::functions::remote::PageFormat serdeFormat,
@@ -35,10 +50,16 @@ class RestRemoteClient {
 
  private:
   const std::string url_;
-  std::unique_ptr<folly::ScopedEventBaseThread> evbThread_;
-  std::shared_ptr<http::HttpClient> httpClient_;
   std::shared_ptr<velox::memory::MemoryPool> memPool_;
 
+  // One client per event base, each maintaining its own connection to the
+  // server. The event base is kept alongside because HttpClient must be
+  // destroyed on its event base thread.
+  std::vector<std::pair<folly::EventBase*, std::shared_ptr<http::HttpClient>>>
+      httpClients_;
+  // Round-robin cursor over 'httpClients_'.
+  mutable std::atomic<uint32_t> nextClient_{0};
+
   const std::chrono::milliseconds requestTimeoutMs =
       std::chrono::duration_cast<std::chrono::milliseconds>(
           SystemConfig::instance()->exchangeRequestTimeoutMs());
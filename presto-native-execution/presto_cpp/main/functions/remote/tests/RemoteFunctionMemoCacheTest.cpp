@@ -0,0 +1,65 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "presto_cpp/main/functions/remote/client/RemoteFunctionMemoCache.h"
+#include <gtest/gtest.h>
+
+using namespace facebook::presto::functions::remote::rest;
+
+TEST(RemoteFunctionMemoCacheTest, basic) {
+  RemoteFunctionMemoCache cache(1'000);
+  EXPECT_FALSE(cache.get("k1").has_value());
+
+  cache.put("k1", "v1");
+  auto value = cache.get("k1");
+  ASSERT_TRUE(value.has_value());
+  EXPECT_EQ(*value, "v1");
+  EXPECT_EQ(cache.currentBytes(), 4);
+
+  // A key already present is left as is: the function is deterministic, so
+  // the stored value is equivalent.
+  cache.put("k1", "other");
+  EXPECT_EQ(*cache.get("k1"), "v1");
+  EXPECT_EQ(cache.currentBytes(), 4);
+}
+
+TEST(RemoteFunctionMemoCacheTest, lruEviction) {
+  // Each entry is 4 bytes, so at most 3 entries fit.
+  RemoteFunctionMemoCache cache(12);
+  cache.put("k1", "v1");
+  cache.put("k2", "v2");
+  cache.put("k3", "v3");
+  EXPECT_EQ(cache.currentBytes(), 12);
+
+  // Touch k1 so k2 becomes the least recently used entry.
+  EXPECT_TRUE(cache.get("k1").has_value());
+  cache.put("k4", "v4");
+  EXPECT_TRUE(cache.get("k1").has_value());
+  EXPECT_FALSE(cache.get("k2").has_value());
+  EXPECT_TRUE(cache.get("k3").has_value());
+  EXPECT_TRUE(cache.get("k4").has_value());
+  EXPECT_EQ(cache.currentBytes(), 12);
+}
+
+TEST(RemoteFunctionMemoCacheTest, oversizedEntry) {
+  // An entry larger than the whole budget is dropped right away instead of
+  // wedging the cache over budget.
+  RemoteFunctionMemoCache cache(8);
+  cache.put("key", std::string(100, 'x'));
+  EXPECT_FALSE(cache.get("key").has_value());
+  EXPECT_EQ(cache.currentBytes(), 0);
+
+  cache.put("k1", "v1");
+  EXPECT_TRUE(cache.get("k1").has_value());
+}
@@ -174,3 +174,25 @@ TEST_F(FunctionMetadataTest, nonExistentCatalog) {
   // The default json() constructor creates a null value
   ASSERT_TRUE(metadata.is_null() || (metadata.is_object() && metadata.empty()));
 }
+
+TEST_F(FunctionMetadataTest, cachedResponse) {
+  auto first = getFunctionsMetadataCached();
+  ASSERT_FALSE(first.body.empty());
+  ASSERT_FALSE(first.etag.empty());
+
+  // Repeated requests serve the cached response with the same ETag.
+  auto second = getFunctionsMetadataCached();
+  EXPECT_EQ(second.body, first.body);
+  EXPECT_EQ(second.etag, first.etag);
+
+  // The content did not change, so a rebuild after invalidation produces the
+  // same ETag and a client's conditional request still matches.
+  bumpFunctionRegistryGeneration();
+  auto rebuilt = getFunctionsMetadataCached();
+  EXPECT_EQ(rebuilt.body, first.body);
+  EXPECT_EQ(rebuilt.etag, first.etag);
+
+  // Catalog-scoped responses are cached separately.
+  auto catalogScoped = getFunctionsMetadataCached(std::string("presto"));
+  EXPECT_NE(catalogScoped.etag, first.etag);
+}
@@ -16,12 +16,15 @@
 #include <jwt-cpp/jwt.h> // @manual
 #include <jwt-cpp/traits/nlohmann-json/traits.h> //@manual
 #endif // PRESTO_ENABLE_JWT
+#include <folly/io/async/AsyncSSLSocket.h>
 #include <folly/io/async/EventBaseManager.h>
 #include <folly/synchronization/Latch.h>
 #include <proxygen/lib/http/codec/CodecProtocol.h>
+#include <proxygen/lib/http/codec/HTTP2Constants.h>
 #include <velox/common/base/Exceptions.h>
 #include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/common/Counters.h"
+#include "presto_cpp/main/common/HugePageArena.h"
 #include "presto_cpp/main/common/Utils.h"
 #include "presto_cpp/main/http/HttpClient.h"
 #include "velox/common/base/StatsReporter.h"
@@ -102,15 +105,18 @@ void HttpResponse::appendWithCopy(std::unique_ptr<folly::IOBuf>&& iobuf) {
   }
 
   const size_t roundedSize = nextAllocationSize(dataLength);
-  void* newBuf{nullptr};
-  try {
-    newBuf = pool_->allocate(roundedSize);
-  } catch (const velox::VeloxException& ex) {
-    // NOTE: we need to catch exception and process it later in driver execution
-    // context when processing the data response. Otherwise, the presto server
-    // process will die.
-    setError(ex);
-    return;
+  auto* arena = HugePageArena::instance();
+  void* newBuf = arena != nullptr ? arena->allocate(roundedSize) : nullptr;
+  if (newBuf == nullptr) {
+    try {
+      newBuf = pool_->allocate(roundedSize);
+    } catch (const velox::VeloxException& ex) {
+      // NOTE: we need to catch exception and process it later in driver
+      // execution context when processing the data response. Otherwise, the
+      // presto server process will die.
+      setError(ex);
+      return;
+    }
   }
   VELOX_CHECK_NOT_NULL(newBuf);
   bodyChainBytes_ += roundedSize;
@@ -135,32 +141,49 @@ void HttpResponse::append(std::unique_ptr<folly::IOBuf>&& iobuf) {
   }
 }
 
-std::unique_ptr<folly::IOBuf> HttpResponse::consumeBody(
+std::vector<std::unique_ptr<folly::IOBuf>> HttpResponse::consumeBody(
     velox::memory::MemoryPool* pool) {
   VELOX_CHECK_NULL(pool_);
   VELOX_CHECK(!hasError());
-  uint64_t totalBytes{0};
-  for (const auto& iobuf : bodyChain_) {
-    VELOX_CHECK(!iobuf->isChained());
-    totalBytes += iobuf->length();
-  }
-  void* newBuf = pool->allocate(totalBytes);
-  void* curr = newBuf;
-  for (auto& iobuf : bodyChain_) {
-    const auto length = iobuf->length();
-    ::memcpy(curr, iobuf->data(), length);
-    curr = (char*)curr + length;
-    iobuf.reset();
+  // Copies each received chunk into its own buffer allocated from 'pool'
+  // instead of coalescing the whole payload into one contiguous buffer. This
+  // avoids a single large contiguous allocation for big responses; the
+  // downstream consumer chains the buffers without further copies.
+  std::vector<std::unique_ptr<folly::IOBuf>> body;
+  body.reserve(bodyChain_.size());
+  auto* arena = HugePageArena::instance();
+  try {
+    for (auto& iobuf : bodyChain_) {
+      VELOX_CHECK(!iobuf->isChained());
+      const auto length = iobuf->length();
+      if (length == 0) {
+        iobuf.reset();
+        continue;
+      }
+      void* newBuf = arena != nullptr ? arena->allocate(length) : nullptr;
+      if (newBuf == nullptr) {
+        newBuf = pool->allocate(length);
+      }
+      ::memcpy(newBuf, iobuf->data(), length);
+      body.emplace_back(folly::IOBuf::wrapBuffer(newBuf, length));
+      iobuf.reset();
+    }
+  } catch (...) {
+    for (const auto& iobuf : body) {
+      HugePageArena::freeTo(pool, iobuf->writableData(), iobuf->capacity());
+    }
+    throw;
   }
   bodyChain_.clear();
-  return folly::IOBuf::wrapBuffer(newBuf, totalBytes);
+  return body;
 }
 
 void HttpResponse::freeBuffers() {
   if (pool_ != nullptr) {
     for (const auto& iobuf : bodyChain_) {
       if (iobuf != nullptr) {
-        pool_->free(iobuf->writableData(), iobuf->capacity());
+        HugePageArena::freeTo(
+            pool_.get(), iobuf->writableData(), iobuf->capacity());
       }
     }
   }
@@ -185,6 +208,20 @@ std::string HttpResponse::dumpBodyChain() const {
                             : util::extractMessageBody(bodyChain_);
 }
 
+void HttpResponse::visitBody(
+    const std::function<void(const uint8_t* data, size_t length)>& visitor)
+    const {
+  for (const auto& buf : bodyChain_) {
+    const folly::IOBuf* current = buf.get();
+    do {
+      if (current->length() > 0) {
+        visitor(current->data(), current->length());
+      }
+      current = current->next();
+    } while (current != buf.get());
+  }
+}
+
 class ResponseHandler : public proxygen::HTTPTransactionHandler {
  public:
   ResponseHandler(
@@ -192,10 +229,12 @@ class ResponseHandler : public proxygen::HTTPTransactionHandler {
       uint64_t maxResponseAllocBytes,
       const std::string& body,
       std::function<void(int)> reportOnBodyStatsFunc,
+      bool deliverTruncatedBody,
       std::shared_ptr<HttpClient> client)
       : request_(request),
         body_(body),
         reportOnBodyStatsFunc_(std::move(reportOnBodyStatsFunc)),
+        deliverTruncatedBody_(deliverTruncatedBody),
         minResponseAllocBytes_(
             client->memoryPool() == nullptr
                 ? 0
@@ -269,9 +308,19 @@ class ResponseHandler : public proxygen::HTTPTransactionHandler {
   void onUpgrade(proxygen::UpgradeProtocol /* protocol*/) noexcept override {}
 
   void onError(const proxygen::HTTPException& error) noexcept override {
-    if (!promise_.isFulfilled()) {
-      promise_.setException(error);
+    if (promise_.isFulfilled()) {
+      return;
     }
+    if (deliverTruncatedBody_ && response_ != nullptr &&
+        !response_->hasError() && !response_->empty()) {
+      // The headers and part of the body made it over before the transfer
+      // failed; hand the prefix to the caller marked as truncated instead
+      // of discarding it.
+      response_->setTruncated(error.what());
+      promise_.setValue(std::move(response_));
+      return;
+    }
+    promise_.setException(error);
   }
 
   void onEgressPaused() noexcept override {}
@@ -300,6 +349,7 @@ class ResponseHandler : public proxygen::HTTPTransactionHandler {
   const proxygen::HTTPMessage request_;
   const std::string body_;
   const std::function<void(int)> reportOnBodyStatsFunc_;
+  const bool deliverTruncatedBody_;
   const uint64_t minResponseAllocBytes_;
   const uint64_t maxResponseAllocBytes_;
   std::unique_ptr<HttpResponse> response_;
@@ -310,6 +360,24 @@ class ResponseHandler : public proxygen::HTTPTransactionHandler {
   proxygen::HTTPTransaction* txn_{nullptr};
 };
 
+namespace {
+// Refreshes 'cache' with the TLS session of the newly connected 'session' so
+// later connections to the peer resume it instead of running a full
+// handshake. No-op for plaintext connections.
+void cacheTlsSession(
+    TlsSessionCache* cache,
+    proxygen::HTTPUpstreamSession* session) {
+  if (cache == nullptr) {
+    return;
+  }
+  auto* sslSocket = session->getTransport()
+                        ->getUnderlyingTransport<folly::AsyncSSLSocket>();
+  if (sslSocket != nullptr) {
+    cache->put(sslSocket->getSSLSessionV2());
+  }
+}
+} // namespace
+
 // Responsible for making an HTTP request. The request will be made in 2
 // phases:
 // 1. Connection establishment: An RTT(HTTP) or a series of RTTs(HTTPS) that
@@ -339,7 +407,8 @@ class ConnectionHandler : public proxygen::HTTPConnector::Callback {
       uint32_t http2SessionWindow,
       folly::EventBase* eventBase,
       const folly::SocketAddress& address,
-      folly::SSLContextPtr sslContext)
+      folly::SSLContextPtr sslContext,
+      TlsSessionCache* tlsSessionCache)
       : responseHandler_(responseHandler),
         sessionPool_(sessionPool),
         transactionTimer_(std::move(transactionTimeout)),
@@ -351,7 +420,8 @@ class ConnectionHandler : public proxygen::HTTPConnector::Callback {
         http2SessionWindow_(http2SessionWindow),
         eventBase_(eventBase),
         address_(address),
-        sslContext_(std::move(sslContext)) {}
+        sslContext_(std::move(sslContext)),
+        tlsSessionCache_(tlsSessionCache) {}
 
   bool useHttps() const {
     return sslContext_ != nullptr;
@@ -360,15 +430,28 @@ class ConnectionHandler : public proxygen::HTTPConnector::Callback {
   void connect() {
     connector_ =
         std::make_unique<proxygen::HTTPConnector>(this, transactionTimer_);
+    if (http2Enabled_ && !useHttps()) {
+      // Speak prior-knowledge cleartext HTTP/2 (h2c) so concurrent requests
+      // to the same peer multiplex over one connection instead of opening a
+      // connection per in-flight request. The server side always enables h2c.
+      // For HTTPS the protocol is negotiated via ALPN instead.
+      connector_->setPlaintextProtocol(
+          proxygen::http2::kProtocolCleartextString);
+    }
     if (useHttps()) {
       connector_->connectSSL(
-          eventBase_, address_, sslContext_, nullptr, connectTimeout_);
+          eventBase_,
+          address_,
+          sslContext_,
+          tlsSessionCache_ != nullptr ? tlsSessionCache_->get() : nullptr,
+          connectTimeout_);
     } else {
       connector_->connect(eventBase_, address_, connectTimeout_);
     }
   }
 
   void connectSuccess(proxygen::HTTPUpstreamSession* session) override {
+    cacheTlsSession(tlsSessionCache_, session);
     if (http2Enabled_) {
       session->setFlowControl(
           http2InitialStreamWindow_, http2StreamWindow_, http2SessionWindow_);
@@ -402,6 +485,7 @@ class ConnectionHandler : public proxygen::HTTPConnector::Callback {
   folly::EventBase* const eventBase_;
   const folly::SocketAddress address_;
   const folly::SSLContextPtr sslContext_;
+  TlsSessionCache* const tlsSessionCache_;
   std::unique_ptr<proxygen::HTTPConnector> connector_;
 };
 
@@ -409,6 +493,65 @@ namespace {
 // Same value as
 // https://github.com/prestodb/presto/blob/831d5947b909fee0d5c0091a3246ddc5b31b2731/presto-main/src/main/java/com/facebook/presto/server/ServerMainModule.java#L547
 constexpr int kMaxConnectionsPerServer = 250;
+
+// Establishes a single connection ahead of demand and parks it in the
+// session pool, so the first request to the peer finds a ready connection
+// instead of paying TCP (and TLS) setup. Self-deleting like
+// ConnectionHandler. Connect failures are logged and ignored since the
+// request path establishes its own connection on a pool miss.
+class SessionWarmUpHandler : public proxygen::HTTPConnector::Callback {
+ public:
+  SessionWarmUpHandler(
+      proxygen::SessionPool* sessionPool,
+      std::chrono::milliseconds connectTimeout,
+      folly::EventBase* eventBase,
+      const folly::SocketAddress& address,
+      folly::SSLContextPtr sslContext,
+      TlsSessionCache* tlsSessionCache)
+      : sessionPool_(sessionPool),
+        connectTimeout_(connectTimeout),
+        eventBase_(eventBase),
+        address_(address),
+        sslContext_(std::move(sslContext)),
+        tlsSessionCache_(tlsSessionCache) {}
+
+  void connect() {
+    connector_ = std::make_unique<proxygen::HTTPConnector>(
+        this, proxygen::WheelTimerInstance(connectTimeout_, eventBase_));
+    if (sslContext_ != nullptr) {
+      connector_->connectSSL(
+          eventBase_,
+          address_,
+          sslContext_,
+          tlsSessionCache_ != nullptr ? tlsSessionCache_->get() : nullptr,
+          connectTimeout_);
+    } else {
+      connector_->connect(eventBase_, address_, connectTimeout_);
+    }
+  }
+
+  void connectSuccess(proxygen::HTTPUpstreamSession* session) override {
+    VLOG(3) << "Warmed up connection to " << address_.describe();
+    cacheTlsSession(tlsSessionCache_, session);
+    sessionPool_->putSession(session);
+    delete this;
+  }
+
+  void connectError(const folly::AsyncSocketException& ex) override {
+    VLOG(1) << "Connection warm-up to " << address_.describe()
+            << " failed: " << ex.what();
+    delete this;
+  }
+
+ private:
+  proxygen::SessionPool* const sessionPool_;
+  const std::chrono::milliseconds connectTimeout_;
+  folly::EventBase* const eventBase_;
+  const folly::SocketAddress address_;
+  const folly::SSLContextPtr sslContext_;
+  TlsSessionCache* const tlsSessionCache_;
+  std::unique_ptr<proxygen::HTTPConnector> connector_;
+};
 } // namespace
 
 std::pair<proxygen::SessionPool*, proxygen::ServerIdleSessionController*>
@@ -460,6 +603,60 @@ HttpClientConnectionPool::getSessionPool(const proxygen::Endpoint& endpoint) {
   return getSessionPoolImpl(*endpointPools);
 }
 
+TlsSessionCache* HttpClientConnectionPool::getTlsSessionCache(
+    const proxygen::Endpoint& endpoint) {
+  {
+    auto rlock = pools_.rlock();
+    auto it = rlock->find(endpoint);
+    if (it != rlock->end()) {
+      return &it->second->tlsSessionCache;
+    }
+  }
+  auto wlock = pools_.wlock();
+  auto& endpointPools = (*wlock)[endpoint];
+  if (endpointPools == nullptr) {
+    endpointPools = std::make_unique<SessionPools>();
+    endpointPools->idleSessions.setMaxIdleCount(kMaxConnectionsPerServer);
+  }
+  return &endpointPools->tlsSessionCache;
+}
+
+void HttpClientConnectionPool::warmUp(
+    const proxygen::Endpoint& endpoint,
+    const folly::SocketAddress& address,
+    const folly::SSLContextPtr& sslContext,
+    std::chrono::milliseconds connectTimeout,
+    uint32_t numConnections,
+    folly::IOThreadPoolExecutor* ioExecutor) {
+  {
+    // An existing entry means connections to this endpoint have been (or are
+    // being) established, so there is nothing left to warm up. The check is
+    // opportunistic: concurrent warm-ups for a new endpoint may both pass it
+    // and establish a few extra connections, which is harmless.
+    auto rlock = pools_.rlock();
+    if (rlock->count(endpoint) != 0) {
+      return;
+    }
+  }
+  for (uint32_t i = 0; i < numConnections; ++i) {
+    auto* eventBase = ioExecutor->getEventBase();
+    eventBase->runInEventBaseThread(
+        [this, endpoint, address, sslContext, connectTimeout, eventBase]() {
+          auto* sessionPool = getSessionPool(endpoint).first;
+          auto* tlsSessionCache =
+              sslContext != nullptr ? getTlsSessionCache(endpoint) : nullptr;
+          auto* handler = new SessionWarmUpHandler(
+              sessionPool,
+              connectTimeout,
+              eventBase,
+              address,
+              sslContext,
+              tlsSessionCache);
+          handler->connect();
+        });
+  }
+}
+
 void HttpClientConnectionPool::destroy() {
   pools_.withWLock([](auto& pools) {
     for (auto& [_, endpointPools] : pools) {
@@ -488,11 +685,18 @@ void HttpClient::initSessionPool() {
   if (connPool_) {
     std::tie(sessionPool_, idleSessions_) =
         connPool_->getSessionPool(endpoint_);
+    if (sslContext_ != nullptr) {
+      tlsSessionCache_ = connPool_->getTlsSessionCache(endpoint_);
+    }
     return;
   }
   sessionPoolHolder_ = std::make_unique<proxygen::SessionPool>();
   sessionPool_ = sessionPoolHolder_.get();
   idleSessions_ = nullptr;
+  if (sslContext_ != nullptr) {
+    tlsSessionCacheHolder_ = std::make_unique<TlsSessionCache>();
+    tlsSessionCache_ = tlsSessionCacheHolder_.get();
+  }
 }
 
 folly::SemiFuture<proxygen::HTTPTransaction*> HttpClient::createTransaction(
@@ -574,7 +778,8 @@ void HttpClient::sendRequest(std::shared_ptr<ResponseHandler> responseHandler) {
         http2SessionWindow_,
         eventBase_,
         address_,
-        sslContext_);
+        sslContext_,
+        tlsSessionCache_);
     connectionHandler->connect();
   };
   if (txnFuture.isReady()) {
@@ -587,7 +792,8 @@ void HttpClient::sendRequest(std::shared_ptr<ResponseHandler> responseHandler) {
 folly::SemiFuture<std::unique_ptr<HttpResponse>> HttpClient::sendRequest(
     proxygen::HTTPMessage& request,
     const std::string& body,
-    int64_t delayMs) {
+    int64_t delayMs,
+    bool deliverTruncatedBody) {
   request.setDstAddress(this->address_);
   request.ensureHostHeader();
   auto responseHandler = std::make_shared<ResponseHandler>(
@@ -595,6 +801,7 @@ folly::SemiFuture<std::unique_ptr<HttpResponse>> HttpClient::sendRequest(
       maxResponseAllocBytes_,
       body,
       reportOnBodyStatsFunc_,
+      deliverTruncatedBody,
       shared_from_this());
   auto future = responseHandler->initialize(responseHandler);
 
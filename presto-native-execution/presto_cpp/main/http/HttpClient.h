@@ -12,7 +12,9 @@
  * limitations under the License.
  */
 #pragma once
+#include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/futures/Future.h>
+#include <folly/ssl/SSLSession.h>
 #include <proxygen/lib/http/HTTPConnector.h>
 #include <proxygen/lib/http/connpool/ServerIdleSessionController.h>
 #include <proxygen/lib/http/connpool/SessionPool.h>
@@ -58,11 +60,36 @@ class HttpResponse {
     return error_;
   }
 
+  /// Marks this response as truncated: the transfer failed with 'error'
+  /// after the headers and part of the body had arrived. Unlike setError(),
+  /// the body received so far is kept. Only set for requests that opted
+  /// into truncated-body delivery.
+  void setTruncated(const std::string& error) {
+    truncatedError_ = error;
+  }
+
+  /// Indicates if this response carries only a prefix of the body because
+  /// the transfer failed mid-stream.
+  bool truncated() const {
+    return !truncatedError_.empty();
+  }
+
+  /// Returns the transfer error that truncated this response.
+  const std::string& truncatedError() const {
+    return truncatedError_;
+  }
+
   /// Returns true if the body of this HttpResponse is empty.
   bool empty() const {
     return bodyChain_.empty();
   }
 
+  /// Applies 'visitor' to every received body chunk in order without
+  /// consuming the body.
+  void visitBody(
+      const std::function<void(const uint8_t* data, size_t length)>& visitor)
+      const;
+
   /// Consumes the response body. The caller is responsible for freeing the
   /// backed memory of this IOBuf from MappedMemory. Otherwise it could lead to
   /// memory leak.
@@ -71,9 +98,13 @@ class HttpResponse {
     return std::move(bodyChain_);
   }
 
-  /// Consumes the response body. The memory of body will be transferred to the
-  /// memory to be allocated from 'pool'.
-  std::unique_ptr<folly::IOBuf> consumeBody(velox::memory::MemoryPool* pool);
+  /// Consumes the response body. Each body chunk is copied into memory
+  /// allocated from 'pool'; the chunks are returned unchained so the caller
+  /// can chain them without coalescing the payload into a single contiguous
+  /// buffer. The caller is responsible for freeing the returned buffers from
+  /// 'pool'.
+  std::vector<std::unique_ptr<folly::IOBuf>> consumeBody(
+      velox::memory::MemoryPool* pool);
 
   void freeBuffers();
 
@@ -104,10 +135,31 @@ class HttpResponse {
   const uint64_t maxResponseAllocBytes_;
 
   std::string error_{};
+  std::string truncatedError_{};
   std::vector<std::unique_ptr<folly::IOBuf>> bodyChain_;
   size_t bodyChainBytes_{0};
 };
 
+/// Holds the most recent TLS session established to a peer. New connections
+/// offer the cached session to the server so the handshake resumes instead of
+/// running a full key exchange; every successful handshake refreshes the
+/// cache since resumption tickets are single use in TLS 1.3.
+class TlsSessionCache {
+ public:
+  std::shared_ptr<folly::ssl::SSLSession> get() const {
+    return session_.copy();
+  }
+
+  void put(std::shared_ptr<folly::ssl::SSLSession> session) {
+    if (session != nullptr) {
+      session_.swap(session);
+    }
+  }
+
+ private:
+  folly::Synchronized<std::shared_ptr<folly::ssl::SSLSession>> session_;
+};
+
 /// Connection pool shared by all the http clients.  It is held by presto server
 /// and should outlive all the http clients, and destroyed before we join the
 /// threads backing the event bases.
@@ -123,6 +175,23 @@ class HttpClientConnectionPool {
   std::pair<proxygen::SessionPool*, proxygen::ServerIdleSessionController*>
   getSessionPool(const proxygen::Endpoint& endpoint);
 
+  /// Returns the TLS session cache shared by all connections to 'endpoint'.
+  TlsSessionCache* getTlsSessionCache(const proxygen::Endpoint& endpoint);
+
+  /// Establishes up to 'numConnections' connections to 'endpoint' ahead of
+  /// the first request, spread round-robin over the event bases of
+  /// 'ioExecutor', and parks them in the corresponding session pools. A
+  /// no-op if the endpoint already has session pools. Connect failures are
+  /// logged and ignored: the request path establishes its own connection on
+  /// a pool miss, so pre-warming is best effort.
+  void warmUp(
+      const proxygen::Endpoint& endpoint,
+      const folly::SocketAddress& address,
+      const folly::SSLContextPtr& sslContext,
+      std::chrono::milliseconds connectTimeout,
+      uint32_t numConnections,
+      folly::IOThreadPoolExecutor* ioExecutor);
+
   void destroy();
 
  private:
@@ -135,6 +204,9 @@ class HttpClientConnectionPool {
         folly::EventBase*,
         std::unique_ptr<proxygen::SessionPool>>>
         byEventBase;
+    // TLS session shared across connections to the endpoint so new
+    // connections resume instead of running a full handshake.
+    TlsSessionCache tlsSessionCache;
   };
 
   std::pair<proxygen::SessionPool*, proxygen::ServerIdleSessionController*>
@@ -174,7 +246,8 @@ class HttpClient : public std::enable_shared_from_this<HttpClient> {
   folly::SemiFuture<std::unique_ptr<HttpResponse>> sendRequest(
       proxygen::HTTPMessage& request,
       const std::string& body = "",
-      int64_t delayMs = 0);
+      int64_t delayMs = 0,
+      bool deliverTruncatedBody = false);
 
   const std::shared_ptr<velox::memory::MemoryPool>& memoryPool() {
     return pool_;
@@ -212,9 +285,11 @@ class HttpClient : public std::enable_shared_from_this<HttpClient> {
 
   proxygen::SessionPool* sessionPool_ = nullptr;
   proxygen::ServerIdleSessionController* idleSessions_ = nullptr;
+  TlsSessionCache* tlsSessionCache_ = nullptr;
 
   // Create only if connPool_ is null (disabled).
   std::unique_ptr<proxygen::SessionPool> sessionPoolHolder_;
+  std::unique_ptr<TlsSessionCache> tlsSessionCacheHolder_;
 };
 
 class RequestBuilder {
@@ -243,17 +318,27 @@ class RequestBuilder {
     return *this;
   }
 
+  /// Delivers the partial response, marked truncated, instead of an
+  /// exception when the transfer fails after the response headers have
+  /// arrived. Off by default: only callers that can make use of a body
+  /// prefix (resuming a broken exchange transfer) should opt in.
+  RequestBuilder& deliverTruncatedBody(bool value) {
+    deliverTruncatedBody_ = value;
+    return *this;
+  }
+
   folly::SemiFuture<std::unique_ptr<HttpResponse>>
   send(HttpClient* client, const std::string& body = "", int64_t delayMs = 0) {
     addJwtIfConfigured();
     header(proxygen::HTTP_HEADER_CONTENT_LENGTH, std::to_string(body.size()));
-    return client->sendRequest(headers_, body, delayMs);
+    return client->sendRequest(headers_, body, delayMs, deliverTruncatedBody_);
   }
 
  private:
   void addJwtIfConfigured();
 
   proxygen::HTTPMessage headers_;
+  bool deliverTruncatedBody_{false};
 };
 
 } // namespace facebook::presto::http
@@ -22,11 +22,13 @@ constexpr uint16_t kHttpOk = 200;
 constexpr uint16_t kHttpAccepted = 202;
 constexpr uint16_t kHttpNoContent = 204;
 constexpr uint16_t kHttpMultipleChoices = 300;
+constexpr uint16_t kHttpNotModified = 304;
 constexpr uint16_t kHttpBadRequest = 400;
 constexpr uint16_t kHttpUnauthorized = 401;
 constexpr uint16_t kHttpNotFound = 404;
 constexpr uint16_t kHttpUnprocessableContent = 422;
 constexpr uint16_t kHttpInternalServerError = 500;
+constexpr uint16_t kHttpServiceUnavailable = 503;
 
 constexpr char kMimeTypeApplicationJson[] = "application/json";
 constexpr char kMimeTypeApplicationThrift[] = "application/x-thrift+binary";
@@ -34,4 +36,39 @@ constexpr char kMimeTypeTextPlain[] = "text/plain";
 constexpr char kShuttingDown[] = "\"SHUTTING_DOWN\"";
 constexpr char kPrestoInternalBearer[] = "X-Presto-Internal-Bearer";
 
+// Request header carrying the version of the TaskStatus a status poller
+// already holds; opts the poller into delta responses.
+constexpr char kPrestoTaskStatusBaseVersion[] =
+    "X-Presto-Task-Status-Base-Version";
+// Response header marking the body as a TaskStatusDelta frame computed
+// against the named base version rather than a full TaskStatus.
+constexpr char kPrestoTaskStatusDelta[] = "X-Presto-Task-Status-Delta";
+
+// On getResults responses, marks the body as zstd-compressed against the
+// producer's trained dictionary with this id. On getResults requests,
+// advertises the dictionary id the consumer already holds so the producer
+// only ships the dictionary blob when the consumer lacks it.
+constexpr char kPrestoPageZstdDictionaryId[] =
+    "X-Presto-Page-Zstd-Dictionary-Id";
+// Response header carrying the base64-encoded zstd dictionary the body (and
+// all later compressed bodies of the buffer) was compressed against.
+constexpr char kPrestoPageZstdDictionary[] = "X-Presto-Page-Zstd-Dictionary";
+
+// On getResults requests, asks the producer to serve the token's payload
+// starting at this byte offset, so a consumer that lost a transfer mid-body
+// can resume from the bytes it already received. On responses, echoes the
+// offset actually honored; absent when the full payload was served.
+constexpr char kPrestoPageResumeOffset[] = "X-Presto-Page-Resume-Offset";
+// Response header carrying the crc32c of the token's full payload on a
+// resumed getResults response, so the consumer can validate the splice of
+// its salvaged prefix with the resent tail.
+constexpr char kPrestoPageChecksum[] = "X-Presto-Page-Checksum";
+
+// On getResults requests, carries the comma-separated zero-based indices of
+// the exchange output columns the consumer actually uses, so the producer
+// can null out the rest before the pages travel the wire. Advisory: a
+// producer that cannot apply the mask serves the full pages. Only sent when
+// 'exchange.selective-columns-enabled' is true.
+constexpr char kPrestoExchangeColumns[] = "X-Presto-Exchange-Columns";
+
 } // namespace facebook::presto::http
@@ -15,8 +15,10 @@
 #include <algorithm>
 
 #include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
 #include "presto_cpp/main/common/Utils.h"
 #include "presto_cpp/main/http/HttpServer.h"
+#include "velox/common/base/StatsReporter.h"
 
 namespace facebook::presto::http {
 
@@ -39,6 +41,29 @@ void sendOkResponse(
       .sendWithEOM();
 }
 
+void sendOkResponse(
+    proxygen::ResponseHandler* downstream,
+    const std::string& body,
+    const std::string& headerName,
+    const std::string& headerValue) {
+  proxygen::ResponseBuilder(downstream)
+      .status(http::kHttpOk, "")
+      .header(
+          proxygen::HTTP_HEADER_CONTENT_TYPE, http::kMimeTypeApplicationJson)
+      .header(headerName, headerValue)
+      .body(body)
+      .sendWithEOM();
+}
+
+void sendNotModifiedResponse(
+    proxygen::ResponseHandler* downstream,
+    const std::string& etag) {
+  proxygen::ResponseBuilder(downstream)
+      .status(http::kHttpNotModified, "Not Modified")
+      .header(proxygen::HTTP_HEADER_ETAG, etag)
+      .sendWithEOM();
+}
+
 void sendOkTextResponse(
     proxygen::ResponseHandler* downstream,
     const std::string& body) {
@@ -60,6 +85,20 @@ void sendOkThriftResponse(
       .sendWithEOM();
 }
 
+void sendOkThriftResponse(
+    proxygen::ResponseHandler* downstream,
+    const std::string& body,
+    const std::string& headerName,
+    const std::string& headerValue) {
+  proxygen::ResponseBuilder(downstream)
+      .status(http::kHttpOk, "")
+      .header(
+          proxygen::HTTP_HEADER_CONTENT_TYPE, http::kMimeTypeApplicationThrift)
+      .header(headerName, headerValue)
+      .body(body)
+      .sendWithEOM();
+}
+
 void sendErrorResponse(
     proxygen::ResponseHandler* downstream,
     const std::string& error,
@@ -97,6 +136,29 @@ void sendResponse(
       .sendWithEOM();
 }
 
+ChunkedResponseWriter::ChunkedResponseWriter(
+    proxygen::ResponseHandler* downstream)
+    : downstream_(downstream) {}
+
+void ChunkedResponseWriter::write(std::string chunk) {
+  if (!headersSent_) {
+    proxygen::ResponseBuilder(downstream_)
+        .status(http::kHttpOk, "")
+        .header(proxygen::HTTP_HEADER_CONTENT_TYPE, http::kMimeTypeTextPlain)
+        .send();
+    headersSent_ = true;
+  }
+  proxygen::ResponseBuilder(downstream_).body(std::move(chunk)).send();
+}
+
+void ChunkedResponseWriter::sendEom() {
+  if (!headersSent_) {
+    sendOkResponse(downstream_);
+    return;
+  }
+  proxygen::ResponseBuilder(downstream_).sendWithEOM();
+}
+
 HttpConfig::HttpConfig(const folly::SocketAddress& address, bool reusePort)
     : address_(address), reusePort_(reusePort) {}
 
@@ -140,6 +202,12 @@ proxygen::HTTPServer::IPConfig HttpsConfig::ipConfig() const {
       folly::SSLContext::VerifyClientCertificate::DO_NOT_REQUEST;
   sslCfg.setCertificate(certPath_, keyPath_, "");
   sslCfg.sslCiphers = supportedCiphers_;
+  // Let reconnecting pollers resume their TLS sessions instead of running a
+  // full handshake per connection. The http client caches TLS sessions per
+  // endpoint, so this pairs with resumption on the server listener.
+  sslCfg.sessionCacheEnabled = true;
+  sslCfg.sessionTicketEnabled = true;
+  sslCfg.sessionContext = "presto_http";
   if (!clientCaFile_.empty()) {
     sslCfg.clientCAFiles = {clientCaFile_};
     sslCfg.clientVerification =
@@ -163,20 +231,114 @@ proxygen::HTTPServer::IPConfig HttpsConfig::ipConfig() const {
 HttpServer::HttpServer(
     const std::shared_ptr<folly::IOThreadPoolExecutor>& httpIOExecutor,
     std::unique_ptr<HttpConfig> httpConfig,
-    std::unique_ptr<HttpsConfig> httpsConfig)
+    std::unique_ptr<HttpsConfig> httpsConfig,
+    std::unique_ptr<HttpConfig> httpUdsConfig)
     : httpConfig_(std::move(httpConfig)),
       httpsConfig_(std::move(httpsConfig)),
+      httpUdsConfig_(std::move(httpUdsConfig)),
       handlerFactory_(std::make_unique<DispatchingRequestHandlerFactory>()),
       httpIOExecutor_(httpIOExecutor) {
   VELOX_CHECK((httpConfig_ != nullptr) || (httpsConfig_ != nullptr));
   VELOX_CHECK(httpIOExecutor_ != nullptr);
 }
 
+void EndPoint::compile(const std::string& pattern) {
+  std::vector<Segment> segments;
+  size_t numParams = 0;
+  size_t pos = 0;
+  for (;;) {
+    const auto next = pattern.find('/', pos);
+    const auto token = std::string_view(pattern).substr(
+        pos, next == std::string::npos ? std::string::npos : next - pos);
+    Segment segment;
+    if (token == "(.+)" || token == "([^/]+)") {
+      segment.isParam = true;
+    } else if (token == "(.*)") {
+      segment.isParam = true;
+      segment.allowEmpty = true;
+    } else if (token == "([0-9]+)" || token == R"((\d+))") {
+      segment.isParam = true;
+      segment.numeric = true;
+    } else if (
+        token.find_first_of(R"(.*+?()[]{}|^$\)") != std::string_view::npos) {
+      // The segment mixes literals with regex constructs; stay on the regex
+      // path.
+      return;
+    } else {
+      segment.literal = std::string(token);
+    }
+    if (segment.isParam) {
+      ++numParams;
+    }
+    segments.push_back(std::move(segment));
+    if (next == std::string::npos) {
+      break;
+    }
+    pos = next + 1;
+  }
+  if (numParams > kMaxCompiledParams ||
+      numParams != static_cast<size_t>(re_.NumberOfCapturingGroups())) {
+    return;
+  }
+  segments_ = std::move(segments);
+  numParams_ = numParams;
+  compiled_ = true;
+}
+
+bool EndPoint::matchCompiled(
+    const std::string& path,
+    std::vector<std::string>& matches) const {
+  // Walk the path segments by offset; parameter positions are staged on the
+  // stack and only copied out once the whole path has matched.
+  std::pair<size_t, size_t> params[kMaxCompiledParams];
+  size_t numParams = 0;
+  size_t segmentIdx = 0;
+  size_t start = 0;
+  for (;;) {
+    if (segmentIdx >= segments_.size()) {
+      return false;
+    }
+    const auto end = path.find('/', start);
+    const auto token = std::string_view(path).substr(
+        start, end == std::string::npos ? std::string::npos : end - start);
+    const auto& segment = segments_[segmentIdx];
+    if (segment.isParam) {
+      if (token.empty() && !segment.allowEmpty) {
+        return false;
+      }
+      if (segment.numeric &&
+          token.find_first_not_of("0123456789") != std::string_view::npos) {
+        return false;
+      }
+      params[numParams++] = {start, token.size()};
+    } else if (token != segment.literal) {
+      return false;
+    }
+    ++segmentIdx;
+    if (end == std::string::npos) {
+      break;
+    }
+    start = end + 1;
+  }
+  if (segmentIdx != segments_.size()) {
+    return false;
+  }
+  matches.resize(numParams_ + 1);
+  matches[0] = path;
+  for (size_t i = 0; i < numParams_; ++i) {
+    matches[i + 1].assign(path, params[i].first, params[i].second);
+  }
+  return true;
+}
+
 bool EndPoint::check(
     const std::string& path,
     std::vector<std::string>& matches,
     std::vector<RE2::Arg>& args,
     std::vector<RE2::Arg*>& argPtrs) const {
+  if (compiled_) {
+    return matchCompiled(path, matches);
+  }
   auto numArgs = re_.NumberOfCapturingGroups();
   matches.resize(numArgs + 1);
   args.resize(numArgs);
@@ -193,17 +355,25 @@ bool EndPoint::check(
   return false;
 }
 
-proxygen::RequestHandler* EndPoint::checkAndApply(
-    const std::string& path,
+proxygen::RequestHandler* EndPoint::apply(
     proxygen::HTTPMessage* message,
-    std::vector<std::string>& matches,
-    std::vector<RE2::Arg>& args,
-    std::vector<RE2::Arg*>& argPtrs) const {
-  if (check(path, matches, args, argPtrs)) {
-    return factory_(message, matches);
+    const std::vector<std::string>& matches) const {
+  return factory_(message, matches);
+}
+
+namespace {
+std::string_view inflightCounterForPriority(EndpointPriority priority) {
+  switch (priority) {
+    case EndpointPriority::kCritical:
+      return kCounterHttpServerNumCriticalRequests;
+    case EndpointPriority::kControl:
+      return kCounterHttpServerNumControlRequests;
+    case EndpointPriority::kData:
+      return kCounterHttpServerNumDataRequests;
   }
-  return nullptr;
+  VELOX_UNREACHABLE();
 }
+} // namespace
 
 proxygen::RequestHandler* DispatchingRequestHandlerFactory::onRequest(
     proxygen::RequestHandler*,
@@ -226,10 +396,33 @@ proxygen::RequestHandler* DispatchingRequestHandlerFactory::onRequest(
   std::vector<RE2::Arg*> argPtrs(4);
 
   for (const auto& endpoint : it->second) {
-    if (auto handler =
-            endpoint->checkAndApply(path, message, matches, args, argPtrs)) {
-      return handler;
+    if (!endpoint->check(path, matches, args, argPtrs)) {
+      continue;
+    }
+    const auto priority = endpoint->priority();
+    const auto lane = static_cast<size_t>(priority);
+    const auto limit = maxConcurrentRequests_[lane];
+    if (limit != 0 &&
+        numInflightRequests_[lane].load(std::memory_order_relaxed) >= limit) {
+      RECORD_METRIC_VALUE(kCounterHttpServerNumShedRequests);
+      return new ErrorRequestHandler(
+          http::kHttpServiceUnavailable,
+          fmt::format(
+              "Shedding {} {}: too many concurrent requests",
+              message->getMethodString(),
+              message->getURL()));
     }
+    auto* handler = endpoint->apply(message, matches);
+    if (auto* trackedHandler = dynamic_cast<AbstractRequestHandler*>(handler)) {
+      const auto numInflight =
+          numInflightRequests_[lane].fetch_add(1, std::memory_order_relaxed) +
+          1;
+      RECORD_METRIC_VALUE(inflightCounterForPriority(priority), numInflight);
+      trackedHandler->setOnRequestComplete([this, lane]() {
+        numInflightRequests_[lane].fetch_sub(1, std::memory_order_relaxed);
+      });
+    }
+    return handler;
   }
 
   return new ErrorRequestHandler(
@@ -243,16 +436,24 @@ proxygen::RequestHandler* DispatchingRequestHandlerFactory::onRequest(
 void DispatchingRequestHandlerFactory::registerEndPoint(
     proxygen::HTTPMethod method,
     const std::string& pattern,
-    const EndpointRequestHandlerFactory& endpoint) {
+    const EndpointRequestHandlerFactory& endpoint,
+    EndpointPriority priority) {
   auto it = endpoints_.find(method);
   if (it == endpoints_.end()) {
     endpoints_[method].emplace_back(
-        std::make_unique<EndPoint>(pattern, endpoint));
+        std::make_unique<EndPoint>(pattern, endpoint, priority));
   } else {
-    it->second.emplace_back(std::make_unique<EndPoint>(pattern, endpoint));
+    it->second.emplace_back(
+        std::make_unique<EndPoint>(pattern, endpoint, priority));
   }
 }
 
+void DispatchingRequestHandlerFactory::setMaxConcurrentRequests(
+    EndpointPriority priority,
+    uint32_t limit) {
+  maxConcurrentRequests_[static_cast<size_t>(priority)] = limit;
+}
+
 const std::
     unordered_map<proxygen::HTTPMethod, std::vector<std::unique_ptr<EndPoint>>>&
     DispatchingRequestHandlerFactory::endpoints() const {
@@ -271,8 +472,8 @@ HttpServer::endpoints() const {
     copy.emplace(method, std::vector<std::unique_ptr<EndPoint>>());
     auto& endpoints = copy.at(method);
     for (const auto& endpoint : methodPair.second) {
-      endpoints.emplace_back(
-          std::make_unique<EndPoint>(endpoint->pattern(), nullptr));
+      endpoints.emplace_back(std::make_unique<EndPoint>(
+          endpoint->pattern(), nullptr, endpoint->priority()));
     }
   }
   return copy;
@@ -346,6 +547,10 @@ void HttpServer::start(
     ipConfigs.push_back(httpsConfig_->ipConfig());
   }
 
+  if (httpUdsConfig_ != nullptr) {
+    ipConfigs.push_back(httpUdsConfig_->ipConfig());
+  }
+
   server_->bind(ipConfigs);
 
   PRESTO_STARTUP_LOG(INFO) << "proxygen::HTTPServer::start()";
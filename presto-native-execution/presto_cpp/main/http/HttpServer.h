@@ -25,6 +25,21 @@ namespace facebook::presto::http {
 
 using json = nlohmann::json;
 
+/// Relative importance of an endpoint for request admission. Under load the
+/// server sheds lanes independently: data fetch traffic can be rejected
+/// while task updates and health checks keep being served, so a getResults
+/// storm cannot make the coordinator mark the worker dead.
+enum class EndpointPriority {
+  /// Health checks and status/info endpoints. Never shed.
+  kCritical = 0,
+  /// Task create/update/delete and other control endpoints.
+  kControl = 1,
+  /// Data fetch (getResults) endpoints. Shed first.
+  kData = 2,
+};
+
+constexpr size_t kNumEndpointPriorities = 3;
+
 void sendOkResponse(proxygen::ResponseHandler* downstream);
 
 void sendOkResponse(proxygen::ResponseHandler* downstream, const json& body);
@@ -33,6 +48,18 @@ void sendOkResponse(
     proxygen::ResponseHandler* downstream,
     const std::string& body);
 
+/// Variant attaching one extra response header.
+void sendOkResponse(
+    proxygen::ResponseHandler* downstream,
+    const std::string& body,
+    const std::string& headerName,
+    const std::string& headerValue);
+
+/// Sends an empty 304 Not Modified response carrying 'etag'.
+void sendNotModifiedResponse(
+    proxygen::ResponseHandler* downstream,
+    const std::string& etag);
+
 void sendOkTextResponse(
     proxygen::ResponseHandler* downstream,
     const std::string& body);
@@ -41,6 +68,13 @@ void sendOkThriftResponse(
     proxygen::ResponseHandler* downstream,
     const std::string& body);
 
+/// Variant attaching one extra response header.
+void sendOkThriftResponse(
+    proxygen::ResponseHandler* downstream,
+    const std::string& body,
+    const std::string& headerName,
+    const std::string& headerValue);
+
 void sendErrorResponse(
     proxygen::ResponseHandler* downstream,
     const std::string& error = "",
@@ -51,6 +85,24 @@ void sendResponse(
     const json& body,
     uint16_t status);
 
+/// Streams a 200 OK response body in chunks so large diagnostic dumps never
+/// have to be materialized as a single string. Headers go out with the first
+/// chunk, so any validation that may fail must happen before the first
+/// write(); sendEom() must be called once all chunks are written. Writing
+/// nothing and calling sendEom() produces an empty 200 OK response.
+class ChunkedResponseWriter {
+ public:
+  explicit ChunkedResponseWriter(proxygen::ResponseHandler* downstream);
+
+  void write(std::string chunk);
+
+  void sendEom();
+
+ private:
+  proxygen::ResponseHandler* const downstream_;
+  bool headersSent_{false};
+};
+
 class AbstractRequestHandler : public proxygen::RequestHandler {
  public:
   void onRequest(
@@ -66,16 +118,32 @@ class AbstractRequestHandler : public proxygen::RequestHandler {
   void onUpgrade(proxygen::UpgradeProtocol proto) noexcept override {}
 
   void requestComplete() noexcept override {
+    if (onRequestCompleteCallback_) {
+      onRequestCompleteCallback_();
+    }
     delete this;
   }
 
   void onError(proxygen::ProxygenError err) noexcept override {
+    if (onRequestCompleteCallback_) {
+      onRequestCompleteCallback_();
+    }
     delete this;
   }
 
+  /// Registers a callback invoked exactly once when the request completes or
+  /// fails. Used by the dispatching factory to track in-flight requests per
+  /// priority lane.
+  void setOnRequestComplete(std::function<void()> callback) {
+    onRequestCompleteCallback_ = std::move(callback);
+  }
+
  protected:
   std::unique_ptr<proxygen::HTTPMessage> headers_;
   std::vector<std::unique_ptr<folly::IOBuf>> body_;
+
+ private:
+  std::function<void()> onRequestCompleteCallback_;
 };
 
 // Some request handlers delay responses until some asynchronous work
@@ -133,6 +201,11 @@ using AsyncRequestHandlerCallback = std::function<void(
     proxygen::ResponseHandler* downstream,
     std::shared_ptr<CallbackRequestHandlerState> state)>;
 
+/// Invoked on the IO thread for every received body chunk, in arrival order,
+/// and exactly once with nullptr when no more chunks will be delivered -
+/// either because the body is complete or because the request failed.
+using BodyChunkCallback = std::function<void(std::unique_ptr<folly::IOBuf>)>;
+
 class CallbackRequestHandler : public AbstractRequestHandler {
  public:
   explicit CallbackRequestHandler(RequestHandlerCallback callback)
@@ -142,19 +215,51 @@ class CallbackRequestHandler : public AbstractRequestHandler {
       : callback_(std::move(callback)),
         state_{CallbackRequestHandlerState::create()} {}
 
+  /// When 'onBodyChunk' is set, body chunks are streamed into it as they
+  /// arrive instead of being accumulated; the main callback then runs with
+  /// an empty body vector.
+  CallbackRequestHandler(
+      AsyncRequestHandlerCallback callback,
+      BodyChunkCallback onBodyChunk)
+      : callback_(std::move(callback)),
+        state_{CallbackRequestHandlerState::create()},
+        onBodyChunk_(std::move(onBodyChunk)) {}
+
   ~CallbackRequestHandler() override {
+    endBodyChunksIfNeeded();
     if (state_) {
       state_->finalize();
     }
   }
 
+  void onBody(std::unique_ptr<folly::IOBuf> body) noexcept override {
+    if (onBodyChunk_) {
+      onBodyChunk_(std::move(body));
+      return;
+    }
+    AbstractRequestHandler::onBody(std::move(body));
+  }
+
   void onEOM() noexcept override {
+    endBodyChunksIfNeeded();
     callback_(headers_.get(), body_, downstream_, state_);
   }
 
  private:
+  // Delivers the end-of-chunks marker exactly once; also invoked from the
+  // destructor so a consumer blocked on the next chunk of a failed request
+  // wakes up.
+  void endBodyChunksIfNeeded() {
+    if (onBodyChunk_ && !bodyChunksEnded_) {
+      bodyChunksEnded_ = true;
+      onBodyChunk_(nullptr);
+    }
+  }
+
   const AsyncRequestHandlerCallback callback_;
   std::shared_ptr<CallbackRequestHandlerState> state_;
+  const BodyChunkCallback onBodyChunk_;
+  bool bodyChunksEnded_{false};
 
   static AsyncRequestHandlerCallback wrap(RequestHandlerCallback callback) {
     return [callback](
@@ -187,12 +292,21 @@ using EndpointRequestHandlerFactory = std::function<proxygen::RequestHandler*(
     proxygen::HTTPMessage* message,
     const std::vector<std::string>& args)>;
 
+/// A registered route. Patterns made of literal path segments and
+/// whole-segment capture groups ('(.+)', '(.*)', '([0-9]+)', '(\d+)',
+/// '([^/]+)') - which covers every production endpoint - are compiled at
+/// registration into a segment program matched by offset, so routing a
+/// request does not evaluate any regex. Patterns the compiler does not
+/// recognize keep the original RE2 matching.
 class EndPoint {
  public:
   EndPoint(
       const std::string& pattern,
-      const EndpointRequestHandlerFactory& factory)
-      : re_(pattern), factory_(factory) {}
+      const EndpointRequestHandlerFactory& factory,
+      EndpointPriority priority)
+      : re_(pattern), factory_(factory), priority_(priority) {
+    compile(pattern);
+  }
 
   bool check(
       const std::string& path,
@@ -200,20 +314,55 @@ class EndPoint {
       std::vector<RE2::Arg>& args,
       std::vector<RE2::Arg*>& argPtrs) const;
 
-  proxygen::RequestHandler* checkAndApply(
-      const std::string& path,
+  proxygen::RequestHandler* apply(
       proxygen::HTTPMessage* message,
-      std::vector<std::string>& matches,
-      std::vector<RE2::Arg>& args,
-      std::vector<RE2::Arg*>& argPtrs) const;
+      const std::vector<std::string>& matches) const;
 
   const std::string& pattern() const {
     return re_.pattern();
   }
 
+  EndpointPriority priority() const {
+    return priority_;
+  }
+
+  /// True when the pattern was compiled into the segment program and requests
+  /// are routed without regex evaluation. Exposed for tests.
+  bool compiled() const {
+    return compiled_;
+  }
+
  private:
+  // One path segment of a compiled pattern: either a literal compared
+  // byte-wise or a parameter extracted by offset. A parameter matches exactly
+  // one segment, so it never spans a '/'.
+  struct Segment {
+    bool isParam{false};
+    // Parameter may be empty ('(.*)').
+    bool allowEmpty{false};
+    // Parameter must be all digits ('([0-9]+)', '(\d+)').
+    bool numeric{false};
+    std::string literal;
+  };
+
+  // Parameters a compiled pattern may carry; patterns with more fall back to
+  // regex so matchCompiled() can stage offsets on the stack.
+  static constexpr size_t kMaxCompiledParams = 8;
+
+  // Builds the segment program from 'pattern'; leaves the endpoint on the
+  // regex path when the pattern uses constructs the matcher does not model.
+  void compile(const std::string& pattern);
+
+  bool matchCompiled(
+      const std::string& path,
+      std::vector<std::string>& matches) const;
+
   const RE2 re_;
   EndpointRequestHandlerFactory factory_;
+  const EndpointPriority priority_;
+  std::vector<Segment> segments_;
+  size_t numParams_{0};
+  bool compiled_{false};
 };
 
 class DispatchingRequestHandlerFactory
@@ -230,7 +379,13 @@ class DispatchingRequestHandlerFactory
   void registerEndPoint(
       proxygen::HTTPMethod method,
       const std::string& pattern,
-      const EndpointRequestHandlerFactory& endpoint);
+      const EndpointRequestHandlerFactory& endpoint,
+      EndpointPriority priority);
+
+  /// Sets the maximum number of concurrently served requests admitted for
+  /// 'priority'. 0 means unlimited. Requests arriving while the lane is at
+  /// its limit are rejected with 503 Service Unavailable.
+  void setMaxConcurrentRequests(EndpointPriority priority, uint32_t limit);
 
   const std::unordered_map<
       proxygen::HTTPMethod,
@@ -242,6 +397,9 @@ class DispatchingRequestHandlerFactory
       proxygen::HTTPMethod,
       std::vector<std::unique_ptr<EndPoint>>>
       endpoints_;
+  std::array<std::atomic<uint32_t>, kNumEndpointPriorities>
+      numInflightRequests_{};
+  std::array<uint32_t, kNumEndpointPriorities> maxConcurrentRequests_{};
 };
 
 class HttpConfig {
@@ -282,10 +440,14 @@ class HttpsConfig {
 
 class HttpServer {
  public:
+  /// 'httpUdsConfig', when set, adds a plain-HTTP listener on a unix domain
+  /// socket for same-host traffic; its address must be built with
+  /// folly::SocketAddress::setFromPath().
   explicit HttpServer(
       const std::shared_ptr<folly::IOThreadPoolExecutor>& httpIOExecutor,
       std::unique_ptr<HttpConfig> httpConfig,
-      std::unique_ptr<HttpsConfig> httpsConfig = nullptr);
+      std::unique_ptr<HttpsConfig> httpsConfig = nullptr,
+      std::unique_ptr<HttpConfig> httpUdsConfig = nullptr);
 
   void start(
       std::vector<std::unique_ptr<proxygen::RequestHandlerFactory>> filters =
@@ -303,67 +465,83 @@ class HttpServer {
 
   void registerGet(
       const std::string& pattern,
-      const EndpointRequestHandlerFactory& endpoint) {
+      const EndpointRequestHandlerFactory& endpoint,
+      EndpointPriority priority = EndpointPriority::kControl) {
     handlerFactory_->registerEndPoint(
-        proxygen::HTTPMethod::GET, pattern, endpoint);
+        proxygen::HTTPMethod::GET, pattern, endpoint, priority);
   }
 
   void registerGet(
       const std::string& pattern,
-      const RequestHandlerCallback& callback) {
-    registerGet(pattern, endPointWrapper(callback));
+      const RequestHandlerCallback& callback,
+      EndpointPriority priority = EndpointPriority::kControl) {
+    registerGet(pattern, endPointWrapper(callback), priority);
   }
 
   void registerHead(
       const std::string& pattern,
-      const EndpointRequestHandlerFactory& endpoint) {
+      const EndpointRequestHandlerFactory& endpoint,
+      EndpointPriority priority = EndpointPriority::kControl) {
     handlerFactory_->registerEndPoint(
-        proxygen::HTTPMethod::HEAD, pattern, endpoint);
+        proxygen::HTTPMethod::HEAD, pattern, endpoint, priority);
   }
 
   void registerHead(
       const std::string& pattern,
-      const RequestHandlerCallback& callback) {
-    registerHead(pattern, endPointWrapper(callback));
+      const RequestHandlerCallback& callback,
+      EndpointPriority priority = EndpointPriority::kControl) {
+    registerHead(pattern, endPointWrapper(callback), priority);
   }
 
   void registerPost(
       const std::string& pattern,
-      const EndpointRequestHandlerFactory& endpoint) {
+      const EndpointRequestHandlerFactory& endpoint,
+      EndpointPriority priority = EndpointPriority::kControl) {
     handlerFactory_->registerEndPoint(
-        proxygen::HTTPMethod::POST, pattern, endpoint);
+        proxygen::HTTPMethod::POST, pattern, endpoint, priority);
   }
 
   void registerPost(
       const std::string& pattern,
-      const RequestHandlerCallback& callback) {
-    registerPost(pattern, endPointWrapper(callback));
+      const RequestHandlerCallback& callback,
+      EndpointPriority priority = EndpointPriority::kControl) {
+    registerPost(pattern, endPointWrapper(callback), priority);
   }
 
   void registerPut(
       const std::string& pattern,
-      const EndpointRequestHandlerFactory& endpoint) {
+      const EndpointRequestHandlerFactory& endpoint,
+      EndpointPriority priority = EndpointPriority::kControl) {
     handlerFactory_->registerEndPoint(
-        proxygen::HTTPMethod::PUT, pattern, endpoint);
+        proxygen::HTTPMethod::PUT, pattern, endpoint, priority);
   }
 
   void registerPut(
       const std::string& pattern,
-      const RequestHandlerCallback& callback) {
-    registerPut(pattern, endPointWrapper(callback));
+      const RequestHandlerCallback& callback,
+      EndpointPriority priority = EndpointPriority::kControl) {
+    registerPut(pattern, endPointWrapper(callback), priority);
   }
 
   void registerDelete(
       const std::string& pattern,
-      const EndpointRequestHandlerFactory& endpoint) {
+      const EndpointRequestHandlerFactory& endpoint,
+      EndpointPriority priority = EndpointPriority::kControl) {
     handlerFactory_->registerEndPoint(
-        proxygen::HTTPMethod::DELETE, pattern, endpoint);
+        proxygen::HTTPMethod::DELETE, pattern, endpoint, priority);
   }
 
   void registerDelete(
       const std::string& pattern,
-      const RequestHandlerCallback& callback) {
-    registerDelete(pattern, endPointWrapper(callback));
+      const RequestHandlerCallback& callback,
+      EndpointPriority priority = EndpointPriority::kControl) {
+    registerDelete(pattern, endPointWrapper(callback), priority);
+  }
+
+  /// Forwards per-priority concurrency limits to the dispatching factory.
+  /// See DispatchingRequestHandlerFactory::setMaxConcurrentRequests().
+  void setMaxConcurrentRequests(EndpointPriority priority, uint32_t limit) {
+    handlerFactory_->setMaxConcurrentRequests(priority, limit);
   }
 
   std::unordered_map<
@@ -374,6 +552,7 @@ class HttpServer {
  private:
   const std::unique_ptr<HttpConfig> httpConfig_;
   const std::unique_ptr<HttpsConfig> httpsConfig_;
+  const std::unique_ptr<HttpConfig> httpUdsConfig_;
   std::unique_ptr<DispatchingRequestHandlerFactory> handlerFactory_;
   std::unique_ptr<proxygen::HTTPServer> server_;
   std::shared_ptr<folly::IOThreadPoolExecutor> httpIOExecutor_;
@@ -14,8 +14,123 @@
 
 #include "presto_cpp/main/http/filters/AccessLogFilter.h"
 #include <fmt/format.h>
+#include <array>
+#include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
+#include "presto_cpp/main/http/HttpConstants.h"
+#include "velox/common/base/StatsReporter.h"
 
 namespace facebook::presto::http::filters {
+namespace {
+
+// Entries buffered between the request path and the drain thread. At ~100
+// bytes per entry this bounds the buffer to about 1MB.
+constexpr size_t kAccessLogQueueSize = 8192;
+
+// Endpoint classes used for sampling, mirroring the EndpointPriority lanes in
+// HttpServer.h. Each class keeps its own sampling counter so that dominant
+// data fetch traffic cannot swallow the sampling budget of the much rarer
+// task control requests.
+enum class EndpointClass { kOther = 0, kControl = 1, kData = 2 };
+
+constexpr size_t kNumEndpointClasses = 3;
+
+EndpointClass classifyEndpoint(const std::string& url) {
+  if (url.find("/results/") != std::string::npos) {
+    return EndpointClass::kData;
+  }
+  if (url.compare(0, 8, "/v1/task") == 0) {
+    return EndpointClass::kControl;
+  }
+  return EndpointClass::kOther;
+}
+
+// Returns true when a successfully completed request for 'url' should be
+// logged: every sampleRate-th request per endpoint class.
+bool sampleRequest(const std::string& url, uint32_t sampleRate) {
+  if (sampleRate <= 1) {
+    return true;
+  }
+  static std::array<std::atomic_uint64_t, kNumEndpointClasses> counters{};
+  auto& counter = counters[static_cast<size_t>(classifyEndpoint(url))];
+  return counter.fetch_add(1, std::memory_order_relaxed) % sampleRate == 0;
+}
+} // namespace
+
+AccessLogWriter::AccessLogWriter(
+    size_t queueSize,
+    std::function<void(const std::string&)> lineSink)
+    : lineSink_(std::move(lineSink)),
+      entries_(queueSize),
+      drainThread_([this]() { drainLoop(); }) {}
+
+AccessLogWriter::~AccessLogWriter() {
+  stopped_ = true;
+  drainThread_.join();
+}
+
+// static
+AccessLogWriter* AccessLogWriter::instance() {
+  static AccessLogWriter writer(kAccessLogQueueSize);
+  return &writer;
+}
+
+bool AccessLogWriter::enqueue(AccessLogEntry entry) {
+  if (!entries_.write(std::move(entry))) {
+    RECORD_METRIC_VALUE(kCounterHTTPAccessLogDroppedEntries, 1);
+    return false;
+  }
+  return true;
+}
+
+void AccessLogWriter::drainLoop() {
+  const auto writeLine = [this](const AccessLogEntry& entry) {
+    const auto line = formatEntry(entry);
+    if (lineSink_ != nullptr) {
+      lineSink_(line);
+    } else {
+      LOG(INFO) << line;
+    }
+  };
+
+  AccessLogEntry entry;
+  while (true) {
+    if (entries_.tryReadUntil(
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(100),
+            entry)) {
+      writeLine(entry);
+      continue;
+    }
+    if (stopped_) {
+      // Emit whatever arrived before shutdown.
+      while (entries_.read(entry)) {
+        writeLine(entry);
+      }
+      return;
+    }
+  }
+}
+
+// static
+std::string AccessLogWriter::formatEntry(const AccessLogEntry& entry) {
+  struct tm formattedEndTime;
+  localtime_r(&entry.endTime, &formattedEndTime);
+  char timeBuf[64];
+  std::strftime(timeBuf, 64, "%F %T", &formattedEndTime);
+
+  return fmt::format(
+      "{} - - [{}] \"{} {} {}\" {:d} {:d} {} {} {:d}",
+      entry.remoteAddr,
+      timeBuf,
+      entry.method,
+      entry.url,
+      entry.version,
+      entry.statusCode,
+      entry.bytesSent,
+      entry.httpReferer,
+      entry.httpUserAgent,
+      entry.latencyMs);
+}
 
 AccessLogFilter::AccessLogFilter(proxygen::RequestHandler* upstream)
     : Filter(upstream) {}
@@ -36,12 +151,12 @@ void AccessLogFilter::onRequest(
 }
 
 void AccessLogFilter::requestComplete() noexcept {
-  writeLog(generateLog());
+  logRequest(/*aborted=*/false);
   Filter::requestComplete();
 }
 
 void AccessLogFilter::onError(proxygen::ProxygenError err) noexcept {
-  writeLog(generateLog());
+  logRequest(/*aborted=*/true);
   Filter::onError(err);
 }
 
@@ -65,32 +180,27 @@ std::string AccessLogFilter::getVersion(
   }
 }
 
-void AccessLogFilter::writeLog(std::string logLine) const noexcept {
-  LOG(INFO) << logLine;
-}
-
-std::string AccessLogFilter::generateLog() const noexcept {
-  std::time_t requestStartTime = proxygen::toTimeT(proxygen::getCurrentTime());
-  static struct tm formattedStartTime;
-  localtime_r(&requestStartTime, &formattedStartTime);
-  char timeBuf[64];
-  std::strftime(timeBuf, 64, "%F %T", &formattedStartTime);
-  const auto latency = proxygen::millisecondsSince(startTime_);
+void AccessLogFilter::logRequest(bool aborted) noexcept {
+  // Error responses and aborted requests are always logged; only successful
+  // requests are subject to sampling.
+  if (!aborted && statusCode_ < kHttpBadRequest &&
+      !sampleRequest(
+          url_, SystemConfig::instance()->httpAccessLogSampleRate())) {
+    return;
+  }
 
-  std::string logLine = fmt::format(
-      "{} - - [{}] \"{} {} {}\" {:d} {:d} {} {} {:d}",
-      remoteAddr_.c_str(),
-      timeBuf,
-      method_.c_str(),
-      url_.c_str(),
-      version_.c_str(),
-      statusCode_,
-      bytesSent_,
-      httpReferer_.c_str(),
-      httpUserAgent_.c_str(),
-      latency.count());
-
-  return logLine;
+  AccessLogEntry entry;
+  entry.method = std::move(method_);
+  entry.url = std::move(url_);
+  entry.version = std::move(version_);
+  entry.remoteAddr = std::move(remoteAddr_);
+  entry.httpReferer = std::move(httpReferer_);
+  entry.httpUserAgent = std::move(httpUserAgent_);
+  entry.endTime = proxygen::toTimeT(proxygen::getCurrentTime());
+  entry.statusCode = statusCode_;
+  entry.bytesSent = bytesSent_;
+  entry.latencyMs = proxygen::millisecondsSince(startTime_).count();
+  AccessLogWriter::instance()->enqueue(std::move(entry));
 }
 
 } // namespace facebook::presto::http::filters
@@ -14,12 +14,71 @@
 
 #pragma once
 
+#include <folly/MPMCQueue.h>
 #include <proxygen/httpserver/Filters.h>
 #include <proxygen/httpserver/RequestHandlerFactory.h>
+#include <atomic>
+#include <ctime>
+#include <functional>
+#include <thread>
 
 namespace facebook::presto::http::filters {
 
-/// A filter that does access logging in nginx `combined` format
+/// One completed (or failed) request captured on the request path. Only raw
+/// values are recorded here; turning them into a log line happens on the
+/// writer thread.
+struct AccessLogEntry {
+  std::string method;
+  std::string url;
+  std::string version;
+  std::string remoteAddr;
+  std::string httpReferer;
+  std::string httpUserAgent;
+  std::time_t endTime{0};
+  uint16_t statusCode{0};
+  uint64_t bytesSent{0};
+  int64_t latencyMs{0};
+};
+
+/// Writes access log lines on a background thread. Request handlers push
+/// compact entries into a bounded queue and return immediately; the drain
+/// thread does the strftime/fmt formatting and emits the nginx `combined`
+/// line, so no string formatting happens on the request path. When the queue
+/// is full the entry is dropped and counted instead of blocking the request.
+class AccessLogWriter {
+ public:
+  /// 'lineSink' overrides where formatted lines go; nullptr logs via glog.
+  /// Exposed for testing; production code uses instance().
+  explicit AccessLogWriter(
+      size_t queueSize,
+      std::function<void(const std::string&)> lineSink = nullptr);
+
+  ~AccessLogWriter();
+
+  static AccessLogWriter* instance();
+
+  /// Enqueues 'entry' without blocking. Returns false and bumps
+  /// kCounterHTTPAccessLogDroppedEntries when the queue is full.
+  bool enqueue(AccessLogEntry entry);
+
+  /// Formats 'entry' as an nginx `combined` log line. Runs on the drain
+  /// thread; exposed for testing.
+  static std::string formatEntry(const AccessLogEntry& entry);
+
+ private:
+  void drainLoop();
+
+  const std::function<void(const std::string&)> lineSink_;
+  folly::MPMCQueue<AccessLogEntry> entries_;
+  std::atomic_bool stopped_{false};
+  std::thread drainThread_;
+};
+
+/// A filter that does access logging in nginx `combined` format. Successfully
+/// completed requests are sampled 1-in-N per endpoint class (data fetch, task
+/// control, everything else) so chatty getResults traffic can be thinned
+/// without losing task-update lines; error responses and aborted requests are
+/// always logged.
 class AccessLogFilter : public proxygen::Filter {
  public:
   explicit AccessLogFilter(proxygen::RequestHandler* upstream);
@@ -37,9 +96,7 @@ class AccessLogFilter : public proxygen::Filter {
  private:
   std::string getVersion(const proxygen::HTTPMessage& msg) const noexcept;
 
-  virtual void writeLog(std::string logLine) const noexcept;
-
-  std::string generateLog() const noexcept;
+  void logRequest(bool aborted) noexcept;
 
   proxygen::TimePoint startTime_;
   std::string method_;
@@ -58,7 +115,10 @@ class AccessLogFilterFactory : public proxygen::RequestHandlerFactory {
  public:
   explicit AccessLogFilterFactory() {}
 
-  void onServerStart(folly::EventBase* /*evb*/) noexcept override {}
+  void onServerStart(folly::EventBase* /*evb*/) noexcept override {
+    // Start the writer thread before the first request arrives.
+    AccessLogWriter::instance();
+  }
 
   void onServerStop() noexcept override {}
 
@@ -13,10 +13,27 @@
  */
 
 #include "presto_cpp/main/http/filters/HttpEndpointLatencyFilter.h"
+#include "presto_cpp/main/http/HttpConstants.h"
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::presto::http::filters {
 
+namespace {
+// Number of buffered latencies folded into a peer's t-digest at once.
+constexpr size_t kPeerMergeBatch = 64;
+
+// Upper bound on the number of tracked peer addresses, so the map cannot
+// grow without bound when the worker is probed from many transient
+// addresses.
+constexpr size_t kMaxTrackedPeers = 256;
+
+// The exchange endpoints (task results fetch, acknowledge and abort) carry
+// the worker-to-worker data traffic; only they get the per-peer breakdown.
+bool isExchangeEndpoint(const std::string& pattern) {
+  return pattern.find("/results/") != std::string::npos;
+}
+} // namespace
+
 HttpEndpointLatencyFilter::HttpEndpointLatencyFilter(
     proxygen::RequestHandler* upstream,
     const std::shared_ptr<std::unordered_map<
@@ -45,6 +62,67 @@ void HttpEndpointLatencyFilter::updateLatency(
       });
 }
 
+// static
+void HttpEndpointLatencyFilter::updatePeerLatency(
+    const std::string& peer,
+    uint64_t latencyUs,
+    bool error) {
+  peerMetricMap().withWLock(
+      [&](std::unordered_map<std::string, PeerState>& map) {
+        auto itr = map.find(peer);
+        if (itr == map.end()) {
+          if (map.size() >= kMaxTrackedPeers) {
+            return;
+          }
+          itr = map.emplace(peer, PeerState{}).first;
+          itr->second.pendingValues.reserve(kPeerMergeBatch);
+        }
+        auto& state = itr->second;
+        state.maxLatencyUs = std::max(state.maxLatencyUs, latencyUs);
+        ++state.count;
+        if (error) {
+          ++state.errorCount;
+        }
+        state.pendingValues.push_back(latencyUs);
+        if (state.pendingValues.size() >= kPeerMergeBatch) {
+          state.digest = state.digest.merge(folly::Range<const double*>(
+              state.pendingValues.data(), state.pendingValues.size()));
+          state.pendingValues.clear();
+        }
+      });
+}
+
+// static
+std::vector<HttpEndpointLatencyFilter::PeerMetrics>
+HttpEndpointLatencyFilter::retrievePeerMetrics(bool clear) {
+  std::vector<PeerMetrics> result;
+  peerMetricMap().withWLock(
+      [&](std::unordered_map<std::string, PeerState>& map) {
+        result.reserve(map.size());
+        for (auto& [peer, state] : map) {
+          if (!state.pendingValues.empty()) {
+            state.digest = state.digest.merge(folly::Range<const double*>(
+                state.pendingValues.data(), state.pendingValues.size()));
+            state.pendingValues.clear();
+          }
+          result.push_back(PeerMetrics{
+              peer,
+              state.digest,
+              state.maxLatencyUs,
+              state.count,
+              state.errorCount});
+        }
+        if (clear) {
+          map.clear();
+        }
+      });
+  std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.latencyUs.estimateQuantile(0.99) >
+        rhs.latencyUs.estimateQuantile(0.99);
+  });
+  return result;
+}
+
 // static
 std::vector<HttpEndpointLatencyFilter::EndPointMetrics>
 HttpEndpointLatencyFilter::retrieveLatencies() {
@@ -78,6 +156,9 @@ void HttpEndpointLatencyFilter::onRequest(
   for (const auto& endpoint : endpoints) {
     if (endpoint->check(path, matches, args, argPtrs)) {
       requestEndpoint_ = methodToString(method) + " " + endpoint->pattern();
+      if (isExchangeEndpoint(endpoint->pattern())) {
+        peerAddress_ = msg->getClientIP();
+      }
       break;
     }
   }
@@ -91,13 +172,26 @@ void HttpEndpointLatencyFilter::onRequest(
 void HttpEndpointLatencyFilter::requestComplete() noexcept {
   timer_.reset();
   updateLatency(requestEndpoint_, timeUs_);
+  if (!peerAddress_.empty()) {
+    updatePeerLatency(
+        peerAddress_, timeUs_, responseStatus_ >= kHttpBadRequest);
+  }
   proxygen::Filter::requestComplete();
 }
 
 void HttpEndpointLatencyFilter::onError(proxygen::ProxygenError err) noexcept {
   timer_.reset();
   updateLatency(requestEndpoint_, timeUs_);
+  if (!peerAddress_.empty()) {
+    updatePeerLatency(peerAddress_, timeUs_, /*error=*/true);
+  }
   proxygen::Filter::onError(err);
 }
 
+void HttpEndpointLatencyFilter::sendHeaders(
+    proxygen::HTTPMessage& msg) noexcept {
+  responseStatus_ = msg.getStatusCode();
+  proxygen::Filter::sendHeaders(msg);
+}
+
 } // namespace facebook::presto::http::filters
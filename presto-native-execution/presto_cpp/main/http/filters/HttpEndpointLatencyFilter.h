@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <folly/stats/TDigest.h>
 #include <proxygen/httpserver/Filters.h>
 #include <proxygen/httpserver/RequestHandlerFactory.h>
 #include "presto_cpp/main/http/HttpServer.h"
@@ -47,6 +48,41 @@ class HttpEndpointLatencyFilter : public proxygen::Filter {
     }
   };
 
+  /// Latency summary of the exchange (task results) requests issued by a
+  /// single peer. The endpoint metrics above aggregate all callers, so a
+  /// single misbehaving peer is invisible there; this breakdown attributes
+  /// the latency to the remote address the requests came from.
+  struct PeerMetrics {
+    /// The remote address the requests came from.
+    std::string peer;
+
+    /// T-digest sketch of the request latencies in microseconds.
+    folly::TDigest latencyUs;
+
+    /// Maximum latency of the requests from this peer.
+    uint64_t maxLatencyUs;
+
+    /// Number of requests from this peer.
+    uint64_t count;
+
+    /// Number of requests from this peer that failed or were answered with
+    /// an http error status.
+    uint64_t errorCount;
+
+    std::string toString() const {
+      std::stringstream oss;
+      oss << "{'" << peer << "' : "
+          << velox::succinctMicros(
+                 static_cast<uint64_t>(latencyUs.estimateQuantile(0.5)))
+          << "(p50) "
+          << velox::succinctMicros(
+                 static_cast<uint64_t>(latencyUs.estimateQuantile(0.99)))
+          << "(p99) " << velox::succinctMicros(maxLatencyUs) << "(max) "
+          << count << "(count) " << errorCount << "(errors)}";
+      return oss.str();
+    }
+  };
+
   HttpEndpointLatencyFilter(
       proxygen::RequestHandler* upstream,
       const std::shared_ptr<std::unordered_map<
@@ -55,15 +91,38 @@ class HttpEndpointLatencyFilter : public proxygen::Filter {
 
   static std::vector<EndPointMetrics> retrieveLatencies();
 
+  /// Returns the per-peer metrics of the exchange endpoints, highest p99
+  /// latency first. Unlike the endpoint metrics, the sketches keep
+  /// accumulating across retrievals unless 'clear' is true.
+  static std::vector<PeerMetrics> retrievePeerMetrics(bool clear = false);
+
   void onRequest(std::unique_ptr<proxygen::HTTPMessage> msg) noexcept override;
 
   void requestComplete() noexcept override;
 
   void onError(proxygen::ProxygenError err) noexcept override;
 
+  void sendHeaders(proxygen::HTTPMessage& msg) noexcept override;
+
  private:
+  // Accumulation state of one peer. Latencies are buffered in
+  // 'pendingValues' and folded into 'digest' in batches because every
+  // t-digest merge rebuilds the centroids.
+  struct PeerState {
+    folly::TDigest digest;
+    std::vector<double> pendingValues;
+    uint64_t maxLatencyUs{0};
+    uint64_t count{0};
+    uint64_t errorCount{0};
+  };
+
   static void updateLatency(const std::string& endpoint, uint64_t latencyMs);
 
+  static void updatePeerLatency(
+      const std::string& peer,
+      uint64_t latencyUs,
+      bool error);
+
   static folly::Synchronized<std::unordered_map<std::string, EndPointMetrics>>&
   metricMap() {
     static folly::Synchronized<std::unordered_map<std::string, EndPointMetrics>>
@@ -71,6 +130,13 @@ class HttpEndpointLatencyFilter : public proxygen::Filter {
     return metricMap_;
   }
 
+  static folly::Synchronized<std::unordered_map<std::string, PeerState>>&
+  peerMetricMap() {
+    static folly::Synchronized<std::unordered_map<std::string, PeerState>>
+        peerMetricMap_;
+    return peerMetricMap_;
+  }
+
   // The endpoints the server is listening on. This is used to match the current
   // request's endpoint.
   const std::shared_ptr<std::unordered_map<
@@ -81,6 +147,13 @@ class HttpEndpointLatencyFilter : public proxygen::Filter {
   // The http endpoint of this request
   std::string requestEndpoint_;
 
+  // The remote address of this request if it targets an exchange endpoint,
+  // empty otherwise.
+  std::string peerAddress_;
+
+  // The http status code of the response sent downstream.
+  uint16_t responseStatus_{0};
+
   // The timer used for keeping track of the duration of the request.
   std::unique_ptr<velox::MicrosecondTimer> timer_;
 
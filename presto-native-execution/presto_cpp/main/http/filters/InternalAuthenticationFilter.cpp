@@ -18,11 +18,29 @@
 #include <jwt-cpp/jwt.h> //@manual
 #include <jwt-cpp/traits/nlohmann-json/traits.h> //@manual
 #endif // PRESTO_ENABLE_JWT
+#include <sys/socket.h>
+
 #include <proxygen/httpserver/ResponseBuilder.h>
 #include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/http/HttpConstants.h"
 
 namespace facebook::presto::http::filters {
+namespace {
+
+// Returns true if the request arrived over the server's unix domain socket
+// listener. Only same-host processes that can reach the socket file can
+// connect, which gives the same-trust-domain guarantee token verification
+// provides; proxygen does not expose the accepted socket to filters, so the
+// socket file's filesystem permissions stand in for an SO_PEERCRED check.
+bool isUnixSocketPeer(const proxygen::HTTPMessage& msg) {
+  if (SystemConfig::instance()->httpServerUnixDomainSocketPath().empty()) {
+    return false;
+  }
+  const auto& clientAddress = msg.getClientAddress();
+  return !clientAddress.empty() && clientAddress.getFamily() == AF_UNIX;
+}
+
+} // namespace
 
 /// The filter is always enabled by the presto server.
 /// Therefore, it is part of processing every request.
@@ -36,6 +54,13 @@ namespace facebook::presto::http::filters {
 /// for the subsequent stages ends processing in this filter.
 void InternalAuthenticationFilter::onRequest(
     std::unique_ptr<proxygen::HTTPMessage> msg) noexcept {
+  if (isUnixSocketPeer(*msg)) {
+    // Same-host fast path: skip per-request token crypto for requests
+    // arriving on the unix domain socket listener.
+    Filter::onRequest(std::move(msg));
+    return;
+  }
+
   auto token = msg->getHeaders().getSingleOrEmpty(kPrestoInternalBearer);
   if (!token.empty() &&
       !SystemConfig::instance()->internalCommunicationJwtEnabled()) {
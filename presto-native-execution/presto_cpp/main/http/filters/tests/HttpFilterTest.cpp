@@ -15,6 +15,7 @@
 #include <folly/init/Init.h>
 #include <gtest/gtest.h>
 #include "presto_cpp/main/http/HttpServer.h"
+#include "presto_cpp/main/http/filters/AccessLogFilter.h"
 #include "presto_cpp/main/http/filters/HttpEndpointLatencyFilter.h"
 
 using namespace facebook::presto::http::filters;
@@ -57,8 +58,8 @@ buildEndpoints(
     (*result)[method] = std::vector<std::unique_ptr<EndPoint>>();
     auto& endpoints = result->at(method);
     for (uint32_t i = 0; i < size; ++i) {
-      endpoints.emplace_back(
-          std::make_unique<EndPoint>(fmt::format("/v1/ep{}", i), nullptr));
+      endpoints.emplace_back(std::make_unique<EndPoint>(
+          fmt::format("/v1/ep{}", i), nullptr, EndpointPriority::kControl));
     }
   }
   return result;
@@ -66,14 +67,53 @@ buildEndpoints(
 
 std::unique_ptr<proxygen::HTTPMessage> buildRequestMsg(
     const proxygen::HTTPMethod& method,
-    const std::string& path) {
+    const std::string& path,
+    const std::string& clientIp = "") {
   auto msg = std::make_unique<proxygen::HTTPMessage>();
   msg->setMethod(method);
   msg->setURL("127.0.0.1:7777" + path);
+  if (!clientIp.empty()) {
+    msg->setClientAddress(folly::SocketAddress(clientIp, 12345));
+  }
   return msg;
 }
 } // namespace
 
+TEST_F(HttpFilterTest, testAccessLogWriter) {
+  AccessLogEntry entry;
+  entry.method = "GET";
+  entry.url = "/v1/info";
+  entry.version = "HTTP/1.1";
+  entry.remoteAddr = "127.0.0.1";
+  entry.httpReferer = "-";
+  entry.httpUserAgent = "test-agent";
+  entry.statusCode = 200;
+  entry.bytesSent = 42;
+  entry.latencyMs = 7;
+
+  const auto line = AccessLogWriter::formatEntry(entry);
+  ASSERT_NE(line.find("\"GET /v1/info HTTP/1.1\" 200 42"), std::string::npos);
+  ASSERT_NE(line.find("127.0.0.1"), std::string::npos);
+  ASSERT_NE(line.find("test-agent"), std::string::npos);
+
+  std::mutex mutex;
+  std::vector<std::string> lines;
+  {
+    AccessLogWriter writer(100, [&](const std::string& logLine) {
+      std::lock_guard<std::mutex> l(mutex);
+      lines.push_back(logLine);
+    });
+    for (int i = 0; i < 50; ++i) {
+      ASSERT_TRUE(writer.enqueue(entry));
+    }
+    // The writer drains all pending entries before its thread exits.
+  }
+  ASSERT_EQ(lines.size(), 50);
+  for (const auto& drained : lines) {
+    ASSERT_EQ(drained, line);
+  }
+}
+
 TEST_F(HttpFilterTest, testEndpointLatencyFilter) {
   DummyRequestHandler handler;
   std::vector<proxygen::HTTPMethod> methods{
@@ -119,6 +159,68 @@ TEST_F(HttpFilterTest, testEndpointLatencyFilter) {
   }
 }
 
+TEST_F(HttpFilterTest, testExchangePeerLatencyFilter) {
+  // Drop peer state possibly left over from other tests.
+  HttpEndpointLatencyFilter::retrievePeerMetrics(/*clear=*/true);
+
+  DummyRequestHandler handler;
+  const auto endpoints = buildEndpoints({proxygen::HTTPMethod::GET}, 1);
+  endpoints->at(proxygen::HTTPMethod::GET)
+      .emplace_back(std::make_unique<EndPoint>(
+          R"(/v1/task/(.+)/results/([0-9]+)/([0-9]+))",
+          nullptr,
+          EndpointPriority::kData));
+
+  // 10 fetches from the first peer, 10 from the second with half of them
+  // failing, plus a non-exchange request that must not show up in the peer
+  // breakdown.
+  const auto resultsPath = "/v1/task/t1/results/0/0";
+  std::vector<HttpEndpointLatencyFilter*> filters;
+  for (uint32_t i = 0; i < 20; i++) {
+    filters.emplace_back(new HttpEndpointLatencyFilter(&handler, endpoints));
+    filters.back()->onRequest(buildRequestMsg(
+        proxygen::HTTPMethod::GET,
+        resultsPath,
+        i < 10 ? "127.0.0.1" : "127.0.0.2"));
+  }
+  filters.emplace_back(new HttpEndpointLatencyFilter(&handler, endpoints));
+  filters.back()->onRequest(
+      buildRequestMsg(proxygen::HTTPMethod::GET, "/v1/ep0", "127.0.0.3"));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  for (uint32_t i = 0; i < filters.size(); i++) {
+    if (i >= 10 && i < 20 && i % 2 == 0) {
+      filters[i]->onError(proxygen::ProxygenError());
+    } else {
+      filters[i]->requestComplete();
+    }
+  }
+
+  auto peerMetrics = HttpEndpointLatencyFilter::retrievePeerMetrics();
+  ASSERT_EQ(peerMetrics.size(), 2);
+  for (const auto& metrics : peerMetrics) {
+    ASSERT_EQ(metrics.count, 10);
+    ASSERT_GT(metrics.maxLatencyUs, 0);
+    ASSERT_EQ(metrics.latencyUs.count(), 10);
+    ASSERT_LE(metrics.latencyUs.estimateQuantile(0.99), metrics.maxLatencyUs);
+    if (metrics.peer == "127.0.0.1") {
+      ASSERT_EQ(metrics.errorCount, 0);
+    } else {
+      ASSERT_EQ(metrics.peer, "127.0.0.2");
+      ASSERT_EQ(metrics.errorCount, 5);
+    }
+  }
+
+  // Retrieval without 'clear' keeps accumulating; clearing empties the map.
+  ASSERT_EQ(HttpEndpointLatencyFilter::retrievePeerMetrics().size(), 2);
+  HttpEndpointLatencyFilter::retrievePeerMetrics(/*clear=*/true);
+  ASSERT_EQ(HttpEndpointLatencyFilter::retrievePeerMetrics().size(), 0);
+
+  // Drain the endpoint metrics these requests produced so tests stay
+  // independent.
+  HttpEndpointLatencyFilter::retrieveLatencies();
+}
+
 TEST_F(HttpFilterTest, testConcurrentEndpointLatencyFilter) {
   DummyRequestHandler handler;
   std::vector<proxygen::HTTPMethod> methods{
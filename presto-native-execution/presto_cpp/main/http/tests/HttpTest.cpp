@@ -55,6 +55,84 @@ TEST_F(HttpsBasicTest, ssl) {
   EXPECT_TRUE(cb.succeeded());
 }
 
+TEST(EndPointTest, compiledRouting) {
+  auto factory = [](proxygen::HTTPMessage* /*message*/,
+                    const std::vector<std::string>& /*args*/)
+      -> proxygen::RequestHandler* { return nullptr; };
+
+  std::vector<std::string> matches;
+  std::vector<RE2::Arg> args;
+  std::vector<RE2::Arg*> argPtrs;
+
+  http::EndPoint results(
+      R"(/v1/task/(.+)/results/([0-9]+)/([0-9]+))",
+      factory,
+      http::EndpointPriority::kData);
+  ASSERT_TRUE(results.compiled());
+  ASSERT_TRUE(results.check(
+      "/v1/task/20260831_1_2_3.1.0.0.0/results/0/123",
+      matches,
+      args,
+      argPtrs));
+  ASSERT_EQ(matches.size(), 4);
+  EXPECT_EQ(matches[1], "20260831_1_2_3.1.0.0.0");
+  EXPECT_EQ(matches[2], "0");
+  EXPECT_EQ(matches[3], "123");
+  // Numeric parameters reject non-digits, literal segments must match and
+  // missing segments do not route.
+  EXPECT_FALSE(results.check(
+      "/v1/task/t/results/abc/123", matches, args, argPtrs));
+  EXPECT_FALSE(results.check(
+      "/v1/task/t/status/0/123", matches, args, argPtrs));
+  EXPECT_FALSE(results.check("/v1/task/t/results/0", matches, args, argPtrs));
+
+  http::EndPoint taskOnly(
+      R"(/v1/task/(.+))", factory, http::EndpointPriority::kControl);
+  ASSERT_TRUE(taskOnly.compiled());
+  // A compiled parameter never spans a '/'.
+  EXPECT_FALSE(taskOnly.check(
+      "/v1/task/t/results/0/1", matches, args, argPtrs));
+  EXPECT_FALSE(taskOnly.check("/v1/task/", matches, args, argPtrs));
+  EXPECT_TRUE(taskOnly.check("/v1/task/abc", matches, args, argPtrs));
+  EXPECT_EQ(matches[1], "abc");
+
+  // Patterns mixing literals and regex constructs inside one segment keep
+  // regex matching.
+  http::EndPoint echo(
+      R"(/echo.*)", factory, http::EndpointPriority::kControl);
+  ASSERT_FALSE(echo.compiled());
+  EXPECT_TRUE(echo.check("/echo/good-morning", matches, args, argPtrs));
+  EXPECT_TRUE(echo.check("/echo", matches, args, argPtrs));
+  EXPECT_FALSE(echo.check("/ping", matches, args, argPtrs));
+}
+
+TEST(HttpResponseTest, truncatedBody) {
+  auto headers = std::make_unique<proxygen::HTTPMessage>();
+  headers->setStatusCode(http::kHttpOk);
+  http::HttpResponse response(
+      std::move(headers), nullptr, 0, 1 << 20);
+
+  response.append(folly::IOBuf::copyBuffer("hello "));
+  response.append(folly::IOBuf::copyBuffer("world"));
+  EXPECT_FALSE(response.truncated());
+
+  // visitBody sees the received chunks in order without consuming them.
+  std::string visited;
+  response.visitBody([&visited](const uint8_t* data, size_t length) {
+    visited.append(reinterpret_cast<const char*>(data), length);
+  });
+  EXPECT_EQ(visited, "hello world");
+  EXPECT_FALSE(response.empty());
+
+  // Truncation keeps the body, unlike setError(), and does not count as an
+  // error.
+  response.setTruncated("connection reset");
+  EXPECT_TRUE(response.truncated());
+  EXPECT_EQ(response.truncatedError(), "connection reset");
+  EXPECT_FALSE(response.hasError());
+  EXPECT_EQ(response.dumpBodyChain(), "hello world");
+}
+
 class HttpTestSuite : public ::testing::TestWithParam<bool> {
  public:
   void SetUp() override {
@@ -138,6 +216,52 @@ TEST_P(HttpTestSuite, basic) {
   ASSERT_EQ(socketException->getType(), folly::AsyncSocketException::NOT_OPEN);
 }
 
+TEST_P(HttpTestSuite, dataLaneShedding) {
+  auto memoryPool =
+      memory::MemoryManager::getInstance()->addLeafPool("dataLaneShedding");
+
+  const bool useHttps = GetParam();
+  auto server = getServer(useHttps);
+
+  server->registerGet("/ping", ping, http::EndpointPriority::kCritical);
+  server->registerGet(
+      "/data/blackhole", blackhole, http::EndpointPriority::kData);
+  server->setMaxConcurrentRequests(http::EndpointPriority::kData, 1);
+
+  HttpServerWrapper wrapper(std::move(server));
+  auto serverAddress = wrapper.start().get();
+
+  HttpClientFactory clientFactory;
+  auto blockedClient = clientFactory.newClient(
+      serverAddress,
+      std::chrono::milliseconds(2'000),
+      std::chrono::milliseconds(0),
+      useHttps,
+      memoryPool);
+  auto client = clientFactory.newClient(
+      serverAddress,
+      std::chrono::milliseconds(1'000),
+      std::chrono::milliseconds(0),
+      useHttps,
+      memoryPool);
+
+  // Occupy the single data lane slot. The blackhole endpoint never responds,
+  // so the request stays in flight until the client times out.
+  auto pendingResponse = sendGet(blockedClient.get(), "/data/blackhole");
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  // The second data request is shed, while the critical endpoint is served.
+  auto response = sendGet(client.get(), "/data/blackhole").get();
+  ASSERT_EQ(
+      response->headers()->getStatusCode(), http::kHttpServiceUnavailable);
+  response = sendGet(client.get(), "/ping").get();
+  ASSERT_EQ(response->headers()->getStatusCode(), http::kHttpOk);
+
+  auto tryResponse = std::move(pendingResponse).getTry();
+  ASSERT_TRUE(tryResponse.hasException());
+  wrapper.stop();
+}
+
 TEST_P(HttpTestSuite, clientIdleSessions) {
   auto memoryPool =
       memory::MemoryManager::getInstance()->addLeafPool("clientIdleSessions");
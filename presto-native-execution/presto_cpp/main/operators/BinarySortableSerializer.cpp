@@ -78,6 +78,44 @@ writeInteger(T* out, int32_t value, bool isDescending) {
   writeByte(out, static_cast<int8_t>(value), isDescending);
 }
 
+template <typename T>
+FOLLY_ALWAYS_INLINE void writeDouble(T* out, double value, bool isDescending) {
+  int64_t longValue = doubleToLong(value);
+
+  if ((longValue & (1L << 63)) != 0) {
+    // negative number, flip all bits
+    longValue = ~longValue;
+  } else {
+    // positive number, flip the first bit
+    longValue = longValue ^ (1L << 63);
+  }
+  writeByte(out, static_cast<int8_t>(longValue >> 56), isDescending);
+  writeByte(out, static_cast<int8_t>(longValue >> 48), isDescending);
+  writeByte(out, static_cast<int8_t>(longValue >> 40), isDescending);
+  writeByte(out, static_cast<int8_t>(longValue >> 32), isDescending);
+  writeByte(out, static_cast<int8_t>(longValue >> 24), isDescending);
+  writeByte(out, static_cast<int8_t>(longValue >> 16), isDescending);
+  writeByte(out, static_cast<int8_t>(longValue >> 8), isDescending);
+  writeByte(out, static_cast<int8_t>(longValue), isDescending);
+}
+
+template <typename T>
+FOLLY_ALWAYS_INLINE void writeReal(T* out, float value, bool isDescending) {
+  int32_t intValue = floatToInt(value);
+
+  if ((intValue & (1L << 31)) != 0) {
+    // negative number, flip all bits
+    intValue = ~intValue;
+  } else {
+    // positive number, flip the first bit
+    intValue = intValue ^ (1L << 31);
+  }
+  writeByte(out, static_cast<int8_t>(intValue >> 24), isDescending);
+  writeByte(out, static_cast<int8_t>(intValue >> 16), isDescending);
+  writeByte(out, static_cast<int8_t>(intValue >> 8), isDescending);
+  writeByte(out, static_cast<int8_t>(intValue), isDescending);
+}
+
 template <typename T>
 FOLLY_ALWAYS_INLINE void writeBytes(
     T* out,
@@ -170,23 +208,7 @@ void serializeDouble(
             .asUnchecked<velox::SimpleVector<
                 velox::TypeTraits<velox::TypeKind::DOUBLE>::NativeType>>()
             ->valueAt(index);
-    int64_t longValue = doubleToLong(value);
-
-    if ((longValue & (1L << 63)) != 0) {
-      // negative number, flip all bits
-      longValue = ~longValue;
-    } else {
-      // positive number, flip the first bit
-      longValue = longValue ^ (1L << 63);
-    }
-    writeByte(out, static_cast<int8_t>(longValue >> 56), isDescending);
-    writeByte(out, static_cast<int8_t>(longValue >> 48), isDescending);
-    writeByte(out, static_cast<int8_t>(longValue >> 40), isDescending);
-    writeByte(out, static_cast<int8_t>(longValue >> 32), isDescending);
-    writeByte(out, static_cast<int8_t>(longValue >> 24), isDescending);
-    writeByte(out, static_cast<int8_t>(longValue >> 16), isDescending);
-    writeByte(out, static_cast<int8_t>(longValue >> 8), isDescending);
-    writeByte(out, static_cast<int8_t>(longValue), isDescending);
+    writeDouble(out, value, isDescending);
   }
 }
 
@@ -206,19 +228,7 @@ void serializeReal(
             .asUnchecked<velox::SimpleVector<
                 velox::TypeTraits<velox::TypeKind::REAL>::NativeType>>()
             ->valueAt(index);
-    int32_t intValue = floatToInt(value);
-
-    if ((intValue & (1L << 31)) != 0) {
-      // negative number, flip all bits
-      intValue = ~intValue;
-    } else {
-      // positive number, flip the first bit
-      intValue = intValue ^ (1L << 31);
-    }
-    writeByte(out, static_cast<int8_t>(intValue >> 24), isDescending);
-    writeByte(out, static_cast<int8_t>(intValue >> 16), isDescending);
-    writeByte(out, static_cast<int8_t>(intValue >> 8), isDescending);
-    writeByte(out, static_cast<int8_t>(intValue), isDescending);
+    writeReal(out, value, isDescending);
   }
 }
 
@@ -776,6 +786,144 @@ void serializedSizeSwitchBatch(
   }
 }
 
+// Writes the field presence byte and, for non-null values, the value null
+// byte for a flat fast-path column. Returns true if the value is null and
+// fully serialized.
+FOLLY_ALWAYS_INLINE bool writeFlatNull(
+    const FlatSortKeyColumn& column,
+    velox::vector_size_t rowId,
+    velox::StringVectorBuffer* out) {
+  writeBool(out, !column.isNullLast);
+  if (column.rawNulls != nullptr &&
+      velox::bits::isBitNull(column.rawNulls, rowId)) {
+    writeBool(out, column.isNullLast);
+    return true;
+  }
+  writeBool(out, !column.isNullLast);
+  return false;
+}
+
+// Type-specialized encoder for the flat fast path. Reads values directly from
+// the raw flat buffer cached in 'column', avoiding virtual value accessors.
+// Produces byte-identical output to the generic serializeSwitch path.
+template <velox::TypeKind Kind>
+void encodeFlat(
+    const FlatSortKeyColumn& column,
+    velox::vector_size_t rowId,
+    velox::StringVectorBuffer* out) {
+  if (writeFlatNull(column, rowId, out)) {
+    return;
+  }
+  if constexpr (Kind == velox::TypeKind::BOOLEAN) {
+    const bool value = velox::bits::isBitSet(
+        reinterpret_cast<const uint64_t*>(column.rawValues), rowId);
+    writeByte(out, static_cast<int8_t>(value ? 2 : 1), column.isDescending);
+  } else {
+    using T = typename velox::TypeTraits<Kind>::NativeType;
+    const auto& value = reinterpret_cast<const T*>(column.rawValues)[rowId];
+    if constexpr (Kind == velox::TypeKind::BIGINT) {
+      writeLong(out, value, column.isDescending);
+    } else if constexpr (Kind == velox::TypeKind::INTEGER) {
+      writeInteger(out, value, column.isDescending);
+    } else if constexpr (Kind == velox::TypeKind::SMALLINT) {
+      writeByte(
+          out, static_cast<int8_t>((value >> 8) ^ 0x80), column.isDescending);
+      writeByte(out, static_cast<int8_t>(value), column.isDescending);
+    } else if constexpr (Kind == velox::TypeKind::TINYINT) {
+      writeByte(out, static_cast<int8_t>(value ^ 0x80), column.isDescending);
+    } else if constexpr (Kind == velox::TypeKind::DOUBLE) {
+      writeDouble(out, value, column.isDescending);
+    } else if constexpr (Kind == velox::TypeKind::REAL) {
+      writeReal(out, value, column.isDescending);
+    } else if constexpr (Kind == velox::TypeKind::TIMESTAMP) {
+      writeLong(out, value.toNanos(), column.isDescending);
+    } else {
+      static_assert(
+          Kind == velox::TypeKind::VARCHAR ||
+          Kind == velox::TypeKind::VARBINARY);
+      writeBytes(
+          out, value.data(), /*offset=*/0, value.size(), column.isDescending);
+    }
+  }
+}
+
+// Builds the flat fast-path column set for 'sortChannels'. Returns an empty
+// vector when any key column is not a flat primitive vector (constant
+// channels, dictionary/lazy encodings and nested types fall back to the
+// generic path).
+std::vector<FlatSortKeyColumn> tryMakeFlatKeyColumns(
+    const velox::RowVectorPtr& source,
+    const std::vector<velox::core::SortOrder>& sortOrders,
+    const std::vector<std::pair<int32_t, velox::column_index_t>>&
+        sortChannels) {
+  std::vector<FlatSortKeyColumn> columns;
+  columns.reserve(sortChannels.size());
+  for (const auto& [idx, channel] : sortChannels) {
+    if (channel >= source->childrenSize()) {
+      return {};
+    }
+    const auto& child = source->childAt(channel);
+    if (!child || child->encoding() != velox::VectorEncoding::Simple::FLAT ||
+        !child->values()) {
+      return {};
+    }
+
+    FlatSortKeyColumn column;
+    column.rawValues = child->values()->as<char>();
+    column.rawNulls = child->rawNulls();
+    column.isNullLast = !sortOrders[idx].isNullsFirst();
+    column.isDescending = !sortOrders[idx].isAscending();
+
+    switch (child->typeKind()) {
+      case velox::TypeKind::BIGINT:
+        column.fixedValueBytes = sizeof(int64_t);
+        column.encoder = encodeFlat<velox::TypeKind::BIGINT>;
+        break;
+      case velox::TypeKind::INTEGER:
+        // Covers DATE, which shares the INTEGER encoding.
+        column.fixedValueBytes = sizeof(int32_t);
+        column.encoder = encodeFlat<velox::TypeKind::INTEGER>;
+        break;
+      case velox::TypeKind::SMALLINT:
+        column.fixedValueBytes = sizeof(int16_t);
+        column.encoder = encodeFlat<velox::TypeKind::SMALLINT>;
+        break;
+      case velox::TypeKind::TINYINT:
+        column.fixedValueBytes = sizeof(int8_t);
+        column.encoder = encodeFlat<velox::TypeKind::TINYINT>;
+        break;
+      case velox::TypeKind::BOOLEAN:
+        column.fixedValueBytes = 1;
+        column.encoder = encodeFlat<velox::TypeKind::BOOLEAN>;
+        break;
+      case velox::TypeKind::DOUBLE:
+        column.fixedValueBytes = sizeof(int64_t);
+        column.encoder = encodeFlat<velox::TypeKind::DOUBLE>;
+        break;
+      case velox::TypeKind::REAL:
+        column.fixedValueBytes = sizeof(int32_t);
+        column.encoder = encodeFlat<velox::TypeKind::REAL>;
+        break;
+      case velox::TypeKind::TIMESTAMP:
+        column.fixedValueBytes = sizeof(int64_t);
+        column.encoder = encodeFlat<velox::TypeKind::TIMESTAMP>;
+        break;
+      case velox::TypeKind::VARCHAR:
+        column.fixedValueBytes = 0;
+        column.encoder = encodeFlat<velox::TypeKind::VARCHAR>;
+        break;
+      case velox::TypeKind::VARBINARY:
+        column.fixedValueBytes = 0;
+        column.encoder = encodeFlat<velox::TypeKind::VARBINARY>;
+        break;
+      default:
+        return {};
+    }
+    columns.push_back(column);
+  }
+  return columns;
+}
+
 std::vector<std::pair<int32_t, velox::column_index_t>> computeSortChannels(
     const std::vector<velox::core::FieldAccessTypedExprPtr>& sortFields,
     const velox::RowTypePtr& inputRowType) {
@@ -796,13 +944,26 @@ BinarySortableSerializer::BinarySortableSerializer(
     : input_(source),
       sortOrders_(sortOrders),
       sortChannels_(
-          computeSortChannels(sortFields, velox::asRowType(source->type()))) {
+          computeSortChannels(sortFields, velox::asRowType(source->type()))),
+      flatKeyColumns_(tryMakeFlatKeyColumns(input_, sortOrders_, sortChannels_)) {
   VELOX_CHECK_EQ(sortFields.size(), sortOrders_.size());
 }
 
+void BinarySortableSerializer::serializeFlat(
+    velox::vector_size_t rowId,
+    velox::StringVectorBuffer* out) const {
+  for (const auto& column : flatKeyColumns_) {
+    column.encoder(column, rowId, out);
+  }
+}
+
 void BinarySortableSerializer::serialize(
     velox::vector_size_t rowId,
     velox::StringVectorBuffer* out) const {
+  if (!flatKeyColumns_.empty()) {
+    serializeFlat(rowId, out);
+    return;
+  }
   const velox::DecodedVector decoded(*input_, /*loadLazy=*/true);
   const auto* rowBase = decoded.base()->as<velox::RowVector>();
   const auto decodedIndex = decoded.index(rowId);
@@ -830,6 +991,23 @@ void BinarySortableSerializer::serialize(
 
 size_t BinarySortableSerializer::serializedSizeInBytes(
     velox::vector_size_t rowId) const {
+  if (!flatKeyColumns_.empty()) {
+    size_t serializedSize = flatKeyColumns_.size();
+    for (const auto& column : flatKeyColumns_) {
+      if (column.rawNulls != nullptr &&
+          velox::bits::isBitNull(column.rawNulls, rowId)) {
+        serializedSize += kNullByteSize;
+      } else if (column.fixedValueBytes > 0) {
+        serializedSize += kNullByteSize + column.fixedValueBytes;
+      } else {
+        const auto& value =
+            reinterpret_cast<const velox::StringView*>(column.rawValues)[rowId];
+        serializedSize += kNullByteSize +
+            getBytesSerializedSize(value.data(), /*offset=*/0, value.size());
+      }
+    }
+    return serializedSize;
+  }
   const velox::DecodedVector decoded(*input_, /*loadLazy=*/true);
   const auto* rowBase = decoded.base()->as<velox::RowVector>();
   const auto decodedIndex = decoded.index(rowId);
@@ -19,6 +19,29 @@
 #include "velox/vector/StringVectorBuffer.h"
 
 namespace facebook::presto::operators {
+
+/// Precomputed encoder state for a single sort key column backed by a flat
+/// primitive vector. BinarySortableSerializer populates one entry per sort
+/// key when every key column qualifies for the flat fast path, so rows can be
+/// encoded straight off the raw vector buffers without per-row decoding or
+/// virtual value accessors.
+struct FlatSortKeyColumn {
+  /// Raw flat values buffer. For VARCHAR/VARBINARY this points to the
+  /// StringView array; for BOOLEAN to the packed bits.
+  const char* rawValues;
+  /// Raw null bits; nullptr when the column has no nulls.
+  const uint64_t* rawNulls;
+  /// Serialized size of a non-null value, or 0 for variable-width types.
+  int32_t fixedValueBytes;
+  bool isNullLast;
+  bool isDescending;
+  /// Type-specialized encoder selected at construction time.
+  void (*encoder)(
+      const FlatSortKeyColumn& column,
+      velox::vector_size_t rowId,
+      velox::StringVectorBuffer* out);
+};
+
 /// BinarySortableSerializer is responsible for serializing sort keys from a
 /// RowVector source. The key is generated so that a
 /// lexicographical sort of the key will produce the ordering.
@@ -56,8 +79,16 @@ class BinarySortableSerializer {
       velox::Scratch& scratch) const;
 
  private:
+  // Serializes 'rowId' through the type-specialized encoders cached in
+  // 'flatKeyColumns_'.
+  void serializeFlat(velox::vector_size_t rowId, velox::StringVectorBuffer* out)
+      const;
+
   const velox::RowVectorPtr input_;
   const std::vector<velox::core::SortOrder> sortOrders_;
   const std::vector<std::pair<int32_t, velox::column_index_t>> sortChannels_;
+  // Non-empty only when every sort key column is a flat primitive vector, in
+  // which case 'serialize' bypasses the generic per-row decoding path.
+  const std::vector<FlatSortKeyColumn> flatKeyColumns_;
 };
 } // namespace facebook::presto::operators
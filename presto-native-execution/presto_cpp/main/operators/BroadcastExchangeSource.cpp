@@ -13,7 +13,9 @@
  */
 #include <fmt/format.h>
 #include <folly/Uri.h>
+#include <algorithm>
 
+#include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/operators/BroadcastExchangeSource.h"
 
 using namespace facebook::velox;
@@ -102,6 +104,38 @@ BroadcastExchangeSource::requestDataSizes(
   });
 }
 
+// static
+std::string BroadcastExchangeSource::selectReadPath(
+    const BroadcastFileInfo& fileInfo,
+    int destination) {
+  if (fileInfo.replicaFilePaths_.empty()) {
+    return fileInfo.filePath_;
+  }
+  // Spread consumers across the published replicas by destination so a wide
+  // broadcast reads from every copy instead of hammering one location.
+  const auto& replicas = fileInfo.replicaFilePaths_;
+  const auto choice =
+      static_cast<size_t>(std::max(destination, 0)) % (replicas.size() + 1);
+  if (choice == 0) {
+    return fileInfo.filePath_;
+  }
+  const auto& replicaPath = replicas[choice - 1];
+  try {
+    if (velox::filesystems::getFileSystem(replicaPath, nullptr)
+            ->exists(replicaPath)) {
+      return replicaPath;
+    }
+    // A replica that is missing, e.g. because its copy failed after the
+    // info was published, falls back to the primary path.
+    LOG(WARNING) << "Broadcast replica " << replicaPath
+                 << " does not exist, reading the primary copy.";
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to probe broadcast replica " << replicaPath
+                 << ", reading the primary copy: " << e.what();
+  }
+  return fileInfo.filePath_;
+}
+
 // static
 std::shared_ptr<exec::ExchangeSource>
 BroadcastExchangeSource::createExchangeSource(
@@ -129,6 +163,9 @@ BroadcastExchangeSource::createExchangeSource(
     VELOX_USER_FAIL("BroadcastInfo deserialization failed: {}", e.what());
   }
 
+  broadcastFileInfo->filePath_ =
+      selectReadPath(*broadcastFileInfo, destination);
+
   auto fileSystem =
       velox::filesystems::getFileSystem(broadcastFileInfo->filePath_, nullptr);
   return std::make_shared<BroadcastExchangeSource>(
@@ -136,7 +173,12 @@ BroadcastExchangeSource::createExchangeSource(
       destination,
       queue,
       std::make_shared<BroadcastFileReader>(
-          broadcastFileInfo, fileSystem, pool),
+          broadcastFileInfo,
+          fileSystem,
+          pool,
+          SystemConfig::instance()->broadcastFileReaderPrefetchDepth(),
+          SystemConfig::instance()->broadcastFileCacheMaxBytes(),
+          SystemConfig::instance()->broadcastFileReaderMmapEnabled()),
       pool);
 }
 } // namespace facebook::presto::operators
@@ -62,6 +62,14 @@ class BroadcastExchangeSource : public velox::exec::ExchangeSource {
       const std::shared_ptr<velox::exec::ExchangeQueue>& queue,
       velox::memory::MemoryPool* pool);
 
+  /// Returns the path this consumer should read 'fileInfo' from. When the
+  /// info carries replica locations, consumers are spread across the primary
+  /// and the replicas by 'destination'; a replica that cannot be probed or
+  /// does not exist falls back to the primary path.
+  static std::string selectReadPath(
+      const BroadcastFileInfo& fileInfo,
+      int destination);
+
  private:
   const std::shared_ptr<BroadcastFileReader> reader_;
 };
@@ -11,13 +11,23 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <folly/executors/GlobalExecutor.h>
+#include <folly/executors/SerialExecutor.h>
+
 #include "presto_cpp/main/operators/BroadcastFile.h"
 #include "presto_cpp/external/json/nlohmann/json.hpp"
 #include "presto_cpp/main/common/Exception.h"
+#include "presto_cpp/main/common/LocalDiskIoScheduler.h"
 #include "presto_cpp/main/thrift/ThriftIO.h"
 #include "presto_cpp/main/thrift/gen-cpp2/presto_native_types.h"
 #include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
 #include "velox/common/file/File.h"
+#include "velox/common/memory/Memory.h"
 #include "velox/common/time/Timer.h"
 #include "velox/vector/FlatVector.h"
 
@@ -87,6 +97,37 @@ void readFooter(
 }
 } // namespace
 
+/// Read-only memory mapping of a broadcast file. Page buffers handed out by
+/// the reader are views into this region and pin it via shared ownership; the
+/// file is unmapped when the last of them is destroyed.
+struct BroadcastFileMmapRegion {
+  const uint8_t* data{nullptr};
+  size_t size{0};
+
+  ~BroadcastFileMmapRegion() {
+    if (data != nullptr) {
+      ::munmap(const_cast<uint8_t*>(data), size);
+    }
+  }
+};
+
+namespace {
+// Releaser for the page BufferViews that keeps the file mapping alive for as
+// long as any page view references it.
+class MmapPageReleaser {
+ public:
+  explicit MmapPageReleaser(std::shared_ptr<BroadcastFileMmapRegion> region)
+      : region_(std::move(region)) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  const std::shared_ptr<BroadcastFileMmapRegion> region_;
+};
+} // namespace
+
 #define PRESTO_BROADCAST_LIMIT_EXCEEDED(errorMessage)                        \
   _VELOX_THROW(                                                              \
       ::facebook::velox::VeloxRuntimeError,                                  \
@@ -97,12 +138,72 @@ void readFooter(
       "{}",                                                                  \
       errorMessage);
 
+// static
+BroadcastPageCache* BroadcastPageCache::instance() {
+  static BroadcastPageCache cache;
+  return &cache;
+}
+
+BroadcastPageCache::BroadcastPageCache()
+    : pool_(velox::memory::MemoryManager::getInstance()->addLeafPool(
+          "BroadcastPageCache")) {}
+
+velox::memory::MemoryPool* BroadcastPageCache::pool() const {
+  return pool_.get();
+}
+
+std::shared_ptr<const BroadcastPageCache::Entry> BroadcastPageCache::get(
+    const std::string& filePath) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = files_.find(filePath);
+  if (it == files_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+  return it->second.entry;
+}
+
+void BroadcastPageCache::put(
+    const std::string& filePath,
+    std::shared_ptr<const Entry> entry,
+    uint64_t maxBytes) {
+  const auto entryBytes = static_cast<uint64_t>(entry->bytes);
+  if (entryBytes > maxBytes) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (files_.contains(filePath)) {
+    // Another reader of the same file raced us; keep the existing entry.
+    return;
+  }
+  while (cachedBytes_ + entryBytes > maxBytes) {
+    VELOX_CHECK(!lru_.empty());
+    auto evictIt = files_.find(lru_.back());
+    VELOX_CHECK(evictIt != files_.end());
+    cachedBytes_ -= evictIt->second.entry->bytes;
+    files_.erase(evictIt);
+    lru_.pop_back();
+  }
+  lru_.push_front(filePath);
+  cachedBytes_ += entryBytes;
+  files_[filePath] = CachedFile{std::move(entry), lru_.begin()};
+}
+
+uint64_t BroadcastPageCache::cachedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cachedBytes_;
+}
+
 // static
 std::unique_ptr<BroadcastFileInfo> BroadcastFileInfo::deserialize(
     const std::string& info) {
   const auto root = nlohmann::json::parse(info);
   auto broadcastFileInfo = std::make_unique<BroadcastFileInfo>();
   root.at("filePath").get_to(broadcastFileInfo->filePath_);
+  // Optional; producers that do not replicate broadcast files omit it.
+  if (auto it = root.find("replicaFilePaths"); it != root.end()) {
+    it->get_to(broadcastFileInfo->replicaFilePaths_);
+  }
   return broadcastFileInfo;
 }
 
@@ -149,6 +250,10 @@ uint64_t BroadcastFileWriter::flush() {
   const auto pageBytes = serializer::SerializedPageFileWriter::flush();
   if (pageBytes != 0) {
     pageSizes_.push_back(pageBytes);
+    // The page size is only known after the write; charging it here paces
+    // the subsequent flushes.
+    LocalDiskIoScheduler::instance()->acquire(
+        LocalDiskIoScheduler::IoClass::kBroadcast, pageBytes);
   }
   return pageBytes;
 }
@@ -216,16 +321,64 @@ RowVectorPtr BroadcastFileWriter::fileStats() {
 BroadcastFileReader::BroadcastFileReader(
     std::unique_ptr<BroadcastFileInfo>& broadcastFileInfo,
     std::shared_ptr<velox::filesystems::FileSystem> fileSystem,
-    velox::memory::MemoryPool* pool)
+    velox::memory::MemoryPool* pool,
+    uint32_t prefetchDepth,
+    uint64_t cacheMaxBytes,
+    bool mmapEnabled)
     : pool_(pool),
       broadcastFileInfo_(std::move(broadcastFileInfo)),
-      fileSystem_(std::move(fileSystem)) {}
+      fileSystem_(std::move(fileSystem)),
+      prefetchDepth_(prefetchDepth),
+      cacheMaxBytes_(cacheMaxBytes),
+      mmapEnabled_(mmapEnabled) {
+  if (prefetchDepth_ > 0) {
+    prefetchExecutor_ = folly::SerialExecutor::create(
+        folly::getKeepAliveToken(folly::getGlobalIOExecutor().get()));
+  }
+}
+
+BroadcastFileReader::~BroadcastFileReader() {
+  // Wait for in-flight prefetch reads that reference 'this'.
+  for (auto& page : prefetchedPages_) {
+    std::move(page).getTry();
+  }
+}
 
 bool BroadcastFileReader::hasNext() {
   ensureFooterRead();
   return numPagesRead_ < pageSizes_.size();
 }
 
+velox::BufferPtr BroadcastFileReader::readPage(int64_t pageSize) {
+  LocalDiskIoScheduler::instance()->acquire(
+      LocalDiskIoScheduler::IoClass::kBroadcast, pageSize);
+  // When populating the cache, pages are allocated from the cache pool so
+  // they can outlive this reader's task pool.
+  auto* pool =
+      cacheMaxBytes_ > 0 ? BroadcastPageCache::instance()->pool() : pool_;
+  auto pageBuffer = AlignedBuffer::allocate<char>(pageSize, pool, 0);
+  inputStream_->readBytes(
+      reinterpret_cast<uint8_t*>(pageBuffer->asMutable<char>()), pageSize);
+  return pageBuffer;
+}
+
+void BroadcastFileReader::schedulePrefetch() {
+  while (prefetchedPages_.size() < prefetchDepth_ &&
+         numPagesScheduled_ < pageSizes_.size()) {
+    const int64_t pageSize = pageSizes_[numPagesScheduled_];
+    VELOX_CHECK_GT(
+        pageSize,
+        0,
+        "Invalid page size {} for page {} in broadcast file {}",
+        pageSize,
+        numPagesScheduled_,
+        broadcastFileInfo_->filePath_);
+    prefetchedPages_.push_back(folly::via(
+        prefetchExecutor_, [this, pageSize]() { return readPage(pageSize); }));
+    ++numPagesScheduled_;
+  }
+}
+
 velox::BufferPtr BroadcastFileReader::next() {
   ensureFooterRead();
 
@@ -233,32 +386,91 @@ velox::BufferPtr BroadcastFileReader::next() {
     return nullptr;
   }
 
-  int64_t pageSize = pageSizes_[numPagesRead_];
-  VELOX_CHECK_GT(
-      pageSize,
-      0,
-      "Invalid page size {} for page {} in broadcast file {}",
-      pageSize,
-      numPagesRead_,
-      broadcastFileInfo_->filePath_);
+  if (cachedEntry_ != nullptr) {
+    // Serve the shared immutable page straight from the cache.
+    auto pageBuffer = cachedEntry_->pages[numPagesRead_];
+    numBytes_ += pageBuffer->size();
+    cacheHitBytes_ += pageBuffer->size();
+    numPagesRead_++;
+    return pageBuffer;
+  }
 
-  auto pageBuffer = AlignedBuffer::allocate<char>(pageSize, pool_, 0);
+  if (mmapRegion_ != nullptr) {
+    // Serve a refcounted view over the mapped file pages; no copy is made
+    // and concurrent readers of the same file share the OS page cache copy.
+    const int64_t pageSize = pageSizes_[numPagesRead_];
+    auto pageBuffer = BufferView<MmapPageReleaser>::create(
+        mmapRegion_->data + mmapPageOffset_,
+        pageSize,
+        MmapPageReleaser(mmapRegion_));
+    mmapPageOffset_ += pageSize;
+    numBytes_ += pageSize;
+    mmapBytes_ += pageSize;
+    numPagesRead_++;
+    return pageBuffer;
+  }
 
-  {
+  velox::BufferPtr pageBuffer;
+  if (prefetchDepth_ > 0) {
+    schedulePrefetch();
+    {
+      // Only the time the consumer actually waits on the prefetched read
+      // counts as read wall time.
+      velox::MicrosecondTimer timer(&fileReadWallTimeUs_);
+      pageBuffer = std::move(prefetchedPages_.front()).get();
+    }
+    prefetchedPages_.pop_front();
+    schedulePrefetch();
+  } else {
+    const int64_t pageSize = pageSizes_[numPagesRead_];
+    VELOX_CHECK_GT(
+        pageSize,
+        0,
+        "Invalid page size {} for page {} in broadcast file {}",
+        pageSize,
+        numPagesRead_,
+        broadcastFileInfo_->filePath_);
     velox::MicrosecondTimer timer(&fileReadWallTimeUs_);
-    inputStream_->readBytes(
-        reinterpret_cast<uint8_t*>(pageBuffer->asMutable<char>()), pageSize);
+    pageBuffer = readPage(pageSize);
   }
 
-  numBytes_ += pageSize;
+  numBytes_ += pageBuffer->size();
   numPagesRead_++;
 
+  if (cacheMaxBytes_ > 0) {
+    pendingCachePages_.push_back(pageBuffer);
+    if (numPagesRead_ == pageSizes_.size()) {
+      // The whole file has been read; publish it for other consumer tasks.
+      auto entry = std::make_shared<BroadcastPageCache::Entry>();
+      entry->pages = std::move(pendingCachePages_);
+      entry->pageSizes = pageSizes_;
+      entry->bytes = numBytes_;
+      BroadcastPageCache::instance()->put(
+          broadcastFileInfo_->filePath_, std::move(entry), cacheMaxBytes_);
+    }
+  }
+
   return pageBuffer;
 }
 
 void BroadcastFileReader::ensureFooterRead() {
   // Read the footer on first access
-  if (inputStream_ != nullptr) {
+  if (footerRead_) {
+    return;
+  }
+  footerRead_ = true;
+
+  if (cacheMaxBytes_ > 0) {
+    cachedEntry_ =
+        BroadcastPageCache::instance()->get(broadcastFileInfo_->filePath_);
+    if (cachedEntry_ != nullptr) {
+      // Serve everything from the cache without touching the file.
+      pageSizes_ = cachedEntry_->pageSizes;
+      return;
+    }
+  }
+
+  if (mmapEnabled_ && tryMmapFile()) {
     return;
   }
 
@@ -274,6 +486,49 @@ void BroadcastFileReader::ensureFooterRead() {
       std::move(readFile), 8 * 1024 * 1024, pool_); // 8MB buffer
 }
 
+bool BroadcastFileReader::tryMmapFile() {
+  velox::MicrosecondTimer timer(&openFileAndReadFooterTimeUs_);
+  const auto& filePath = broadcastFileInfo_->filePath_;
+  // mmap only applies to files on the local filesystem; open(2) fails for
+  // remote filesystem URIs and the reader stays on the buffered path.
+  const int fd = ::open(filePath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat fileStat;
+  if (::fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  const size_t fileSize = fileStat.st_size;
+  void* addr = ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping keeps the file contents reachable after the descriptor is
+  // closed.
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    PLOG(WARNING) << "mmap failed for broadcast file " << filePath
+                  << ", falling back to buffered reads";
+    return false;
+  }
+
+  auto region = std::make_shared<BroadcastFileMmapRegion>();
+  region->data = static_cast<const uint8_t*>(addr);
+  region->size = fileSize;
+
+  velox::InMemoryReadFile file(std::string_view(
+      reinterpret_cast<const char*>(region->data), region->size));
+  readFooter(&file, filePath, pageSizes_);
+
+  // The mapped reads below are charged as one file read; start kernel
+  // readahead of the whole file so the consumer does not fault page by page.
+  LocalDiskIoScheduler::instance()->acquire(
+      LocalDiskIoScheduler::IoClass::kBroadcast, fileSize);
+  ::madvise(addr, fileSize, MADV_WILLNEED);
+
+  mmapRegion_ = std::move(region);
+  return true;
+}
+
 std::vector<int64_t> BroadcastFileReader::remainingPageSizes() {
   ensureFooterRead();
 
@@ -290,6 +545,8 @@ folly::F14FastMap<std::string, int64_t> BroadcastFileReader::stats() const {
   return {
       {"broadcastExchangeSource.numBytes", numBytes_},
       {"broadcastExchangeSource.numPages", numPagesRead_},
+      {"broadcastExchangeSource.cacheHitBytes", cacheHitBytes_},
+      {"broadcastExchangeSource.mmapBytes", mmapBytes_},
       {"broadcastExchangeSource.openFileAndReadFooterTimeUs",
        openFileAndReadFooterTimeUs_},
       {"broadcastExchangeSource.fileReadWallTimeUs", fileReadWallTimeUs_}};
@@ -301,6 +558,11 @@ BroadcastFileReader::metrics() const {
       {"broadcastExchangeSource.numBytes",
        velox::RuntimeMetric(numBytes_, velox::RuntimeCounter::Unit::kBytes)},
       {"broadcastExchangeSource.numPages", velox::RuntimeMetric(numPagesRead_)},
+      {"broadcastExchangeSource.cacheHitBytes",
+       velox::RuntimeMetric(
+           cacheHitBytes_, velox::RuntimeCounter::Unit::kBytes)},
+      {"broadcastExchangeSource.mmapBytes",
+       velox::RuntimeMetric(mmapBytes_, velox::RuntimeCounter::Unit::kBytes)},
       {"broadcastExchangeSource.openFileAndReadFooterTimeNanos",
        velox::RuntimeMetric(
            openFileAndReadFooterTimeUs_ * 1'000,
@@ -13,6 +13,12 @@
  */
 #pragma once
 
+#include <deque>
+#include <list>
+#include <mutex>
+
+#include <folly/futures/Future.h>
+
 #include "velox/common/file/FileInputStream.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/memory/MemoryPool.h"
@@ -29,6 +35,13 @@ namespace facebook::presto::operators {
 /// in the above Java classes and its corresponding serde functionalities.
 struct BroadcastFileInfo {
   std::string filePath_;
+  // Optional additional locations holding the same content as 'filePath_',
+  // carried in the 'replicaFilePaths' JSON field. Producers that replicate a
+  // broadcast file publish every copy here so consumers can spread their
+  // reads across the replicas instead of all pulling from one location.
+  // Absent from payloads of producers that do not replicate, which leaves
+  // the single-location behavior unchanged.
+  std::vector<std::string> replicaFilePaths_;
   // TODO: Add additional stats including checksum, num rows, size.
 
   static std::unique_ptr<BroadcastFileInfo> deserialize(
@@ -58,6 +71,12 @@ class BroadcastFileWriter : velox::serializer::SerializedPageFileWriter {
   /// Returns nullptr if there were no rows written.
   velox::RowVectorPtr fileStats();
 
+  /// Serialized bytes written to the file so far. Complete once noMoreData()
+  /// returned.
+  uint64_t writtenBytes() const {
+    return writtenBytes_;
+  }
+
  private:
   void updateWriteStats(
       uint64_t writtenBytes,
@@ -84,15 +103,92 @@ class BroadcastFileWriter : velox::serializer::SerializedPageFileWriter {
   velox::RowVectorPtr fileStats_{nullptr};
 };
 
+/// Process-wide cache of fully read broadcast files so the many consumer
+/// tasks of a broadcast join on a worker pay for one file read instead of one
+/// per task. Broadcast files are written once and uniquely named, so the file
+/// path identifies the content. Entries hold immutable, refcounted page
+/// buffers allocated from the cache's own memory pool; readers that hit the
+/// cache share them directly. Eviction is LRU against a byte budget, and
+/// evicted entries stay alive for as long as in-flight readers reference
+/// them.
+class BroadcastPageCache {
+ public:
+  struct Entry {
+    /// Page buffers in file order, allocated from the cache pool.
+    std::vector<velox::BufferPtr> pages;
+    /// Page sizes from the file footer, parallel to 'pages'.
+    std::vector<int64_t> pageSizes;
+    /// Total bytes across 'pages'.
+    int64_t bytes{0};
+  };
+
+  static BroadcastPageCache* instance();
+
+  /// Pool that cached page buffers must be allocated from so they outlive the
+  /// reader task pools.
+  velox::memory::MemoryPool* pool() const;
+
+  /// Returns the cached entry for 'filePath' and marks it most recently used,
+  /// or nullptr on a miss.
+  std::shared_ptr<const Entry> get(const std::string& filePath);
+
+  /// Inserts 'entry' for 'filePath', evicting least recently used entries
+  /// until the cache fits in 'maxBytes'. Keeps the existing entry when
+  /// another reader raced the insert. Entries larger than 'maxBytes' are not
+  /// cached.
+  void put(
+      const std::string& filePath,
+      std::shared_ptr<const Entry> entry,
+      uint64_t maxBytes);
+
+  /// Bytes currently held across cached entries. Used by tests.
+  uint64_t cachedBytes() const;
+
+ private:
+  BroadcastPageCache();
+
+  struct CachedFile {
+    std::shared_ptr<const Entry> entry;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  mutable std::mutex mutex_;
+  const std::shared_ptr<velox::memory::MemoryPool> pool_;
+  // Most recently used file path at the front.
+  std::list<std::string> lru_;
+  folly::F14FastMap<std::string, CachedFile> files_;
+  uint64_t cachedBytes_{0};
+};
+
+// Read-only memory mapping of a broadcast file; defined in the translation
+// unit.
+struct BroadcastFileMmapRegion;
+
 /// Reads broadcast data back from files.
 class BroadcastFileReader {
  public:
+  /// 'prefetchDepth' is the maximum number of pages read ahead of the
+  /// consumer on a prefetch executor so file reads overlap with compute;
+  /// 0 reads synchronously on the caller thread.
+  /// 'cacheMaxBytes' is the byte budget of the worker-level
+  /// BroadcastPageCache; when non-zero the reader serves pages from the cache
+  /// on a hit and populates it after reading the whole file on a miss. 0
+  /// bypasses the cache.
+  /// 'mmapEnabled' maps local broadcast files read-only and serves pages as
+  /// refcounted views over the mapping instead of copying them into pool
+  /// buffers, so all consumer tasks share the single OS page cache copy of
+  /// the file. Mapped files do not populate the BroadcastPageCache since the
+  /// page cache already provides the sharing. Files that cannot be mapped,
+  /// e.g. on remote filesystems, fall back to buffered reads.
   BroadcastFileReader(
       std::unique_ptr<BroadcastFileInfo>& broadcastFileInfo,
       std::shared_ptr<velox::filesystems::FileSystem> fileSystem,
-      velox::memory::MemoryPool* pool);
+      velox::memory::MemoryPool* pool,
+      uint32_t prefetchDepth = 0,
+      uint64_t cacheMaxBytes = 0,
+      bool mmapEnabled = false);
 
-  ~BroadcastFileReader() = default;
+  ~BroadcastFileReader();
 
   /// Return true if more data is available.
   bool hasNext();
@@ -114,15 +210,55 @@ class BroadcastFileReader {
   // Ensure footer is read, lazy initialization on first access
   void ensureFooterRead();
 
+  // Tries to memory map the broadcast file and read the footer from the
+  // mapping. Returns false, leaving the reader on the buffered path, when the
+  // file is not on the local filesystem or cannot be mapped.
+  bool tryMmapFile();
+
+  // Reads the next page from 'inputStream_' into a new buffer. Called on the
+  // caller thread or, when prefetching, on 'prefetchExecutor_'.
+  velox::BufferPtr readPage(int64_t pageSize);
+
+  // Schedules page reads on 'prefetchExecutor_' until 'prefetchedPages_'
+  // holds 'prefetchDepth_' outstanding reads or all pages are scheduled.
+  void schedulePrefetch();
+
   velox::memory::MemoryPool* const pool_;
   const std::unique_ptr<BroadcastFileInfo> broadcastFileInfo_;
   const std::shared_ptr<velox::filesystems::FileSystem> fileSystem_;
+  const uint32_t prefetchDepth_;
+  // Byte budget of the worker-level page cache; 0 bypasses it.
+  const uint64_t cacheMaxBytes_;
+  const bool mmapEnabled_;
 
   std::unique_ptr<velox::common::FileInputStream> inputStream_;
+  bool footerRead_{false};
   int64_t numBytes_{0};
   uint32_t numPagesRead_{0};
   std::vector<int64_t> pageSizes_;
 
+  // Mapping of the whole file when the mmap mode is active. Page views
+  // handed out by next() pin it, so the file stays mapped until the last
+  // consumer drops its page.
+  std::shared_ptr<BroadcastFileMmapRegion> mmapRegion_;
+  // Byte offset of the next unread page within 'mmapRegion_'.
+  uint64_t mmapPageOffset_{0};
+  int64_t mmapBytes_{0};
+
+  // Cache entry served on a hit; pages are shared immutable buffers.
+  std::shared_ptr<const BroadcastPageCache::Entry> cachedEntry_;
+  // Pages accumulated on a miss to populate the cache once the whole file has
+  // been read.
+  std::vector<velox::BufferPtr> pendingCachePages_;
+  int64_t cacheHitBytes_{0};
+
+  // Serializes prefetch reads of 'inputStream_' off the driver thread.
+  folly::Executor::KeepAlive<> prefetchExecutor_;
+  // Outstanding prefetched page reads, in page order.
+  std::deque<folly::Future<velox::BufferPtr>> prefetchedPages_;
+  // Number of pages scheduled for prefetch so far.
+  uint32_t numPagesScheduled_{0};
+
   // Wall time metrics in microseconds
   uint64_t openFileAndReadFooterTimeUs_{0};
   uint64_t fileReadWallTimeUs_{0};
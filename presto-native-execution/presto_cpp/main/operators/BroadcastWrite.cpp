@@ -15,7 +15,14 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <folly/executors/GlobalExecutor.h>
+#include <folly/executors/SerialExecutor.h>
+#include <condition_variable>
+#include <mutex>
+#include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
 #include "presto_cpp/main/operators/BroadcastFile.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/OperatorUtils.h"
 
@@ -50,7 +57,9 @@ class BroadcastWriteOperator : public Operator {
             planNode->inputType(),
             planNode->serdeRowType(),
             planNode->serdeRowType())),
-        maxBroadcastBytes_(planNode->maxBroadcastBytes()) {
+        maxBroadcastBytes_(planNode->maxBroadcastBytes()),
+        maxBufferedBytes_(
+            SystemConfig::instance()->broadcastFileWriterMaxBufferedBytes()) {
     const auto& basePath = planNode->basePath();
     VELOX_CHECK(!basePath.empty(), "Base path for broadcast files is empty!");
     auto fileSystem = velox::filesystems::getFileSystem(basePath, nullptr);
@@ -64,6 +73,13 @@ class BroadcastWriteOperator : public Operator {
                 ctx->queryConfig().shuffleCompressionKind()),
             VectorSerde::Kind::kPresto),
         operatorCtx_->pool());
+    if (maxBufferedBytes_ > 0) {
+      // Batches must reach the file in input order, so the write pipeline is
+      // a serial executor: the driver produces batch N while the background
+      // thread serializes, compresses and writes earlier batches.
+      writeExecutor_ = folly::SerialExecutor::create(
+          folly::getKeepAliveToken(folly::getGlobalCPUExecutor().get()));
+    }
   }
 
   bool needsInput() const override {
@@ -89,14 +105,66 @@ class BroadcastWriteOperator : public Operator {
           outputColumns);
     }
 
+    const uint64_t batchBytes = reorderedInput->estimateFlatSize();
+    {
+      auto lockedStats = stats_.wlock();
+      lockedStats->addOutputVector(batchBytes, reorderedInput->size());
+      // Report materialized bytes as input arrives rather than at finish, so
+      // the coordinator sees the size of an unexpectedly large broadcast in
+      // TaskInfo while the stage is still running and can revoke the
+      // broadcast strategy.
+      lockedStats->addRuntimeStat(
+          kBroadcastWriteBytes,
+          RuntimeCounter(batchBytes, RuntimeCounter::Unit::kBytes));
+    }
+
+    if (writeExecutor_ != nullptr) {
+      maybeRethrowWriteError();
+      {
+        std::lock_guard<std::mutex> l(mutex_);
+        bufferedBytes_ += batchBytes;
+        ++pendingWrites_;
+      }
+      writeExecutor_->add(
+          [this, batch = std::move(reorderedInput), batchBytes]() {
+            try {
+              fileBroadcastWriter_->write(batch);
+            } catch (...) {
+              std::lock_guard<std::mutex> l(mutex_);
+              if (writeError_ == nullptr) {
+                writeError_ = std::current_exception();
+              }
+            }
+            finishBackgroundWrite(batchBytes);
+          });
+      return;
+    }
+
     fileBroadcastWriter_->write(reorderedInput);
-    auto lockedStats = stats_.wlock();
-    lockedStats->addOutputVector(
-        reorderedInput->estimateFlatSize(), reorderedInput->size());
   }
 
   void noMoreInput() override {
     Operator::noMoreInput();
+    if (writeExecutor_ != nullptr) {
+      // The final flush writes the footer; treat it as a zero-byte pending
+      // write so the drain logic in isBlocked() covers it.
+      {
+        std::lock_guard<std::mutex> l(mutex_);
+        ++pendingWrites_;
+      }
+      writeExecutor_->add([this]() {
+        try {
+          fileBroadcastWriter_->noMoreData();
+        } catch (...) {
+          std::lock_guard<std::mutex> l(mutex_);
+          if (writeError_ == nullptr) {
+            writeError_ = std::current_exception();
+          }
+        }
+        finishBackgroundWrite(0);
+      });
+      return;
+    }
     fileBroadcastWriter_->noMoreData();
   }
 
@@ -105,27 +173,108 @@ class BroadcastWriteOperator : public Operator {
       return nullptr;
     }
 
+    maybeRethrowWriteError();
     finished_ = true;
+    // isBlocked() drained the write pipeline before this point, so the
+    // writer's byte count is final.
+    const uint64_t fileBytes = fileBroadcastWriter_->writtenBytes();
+    stats_.wlock()->addRuntimeStat(
+        kBroadcastWriteSerializedBytes,
+        RuntimeCounter(fileBytes, RuntimeCounter::Unit::kBytes));
+    RECORD_HISTOGRAM_METRIC_VALUE(kCounterBroadcastWriteFileBytes, fileBytes);
     return fileBroadcastWriter_->fileStats();
   }
 
   BlockingReason isBlocked(ContinueFuture* future) override {
-    return BlockingReason::kNotBlocked;
+    if (writeExecutor_ == nullptr) {
+      return BlockingReason::kNotBlocked;
+    }
+    maybeRethrowWriteError();
+    std::lock_guard<std::mutex> l(mutex_);
+    // Block while the pipeline is over its byte budget, and after the last
+    // input until all background writes (including the final flush) landed so
+    // getOutput() reads complete file stats.
+    const bool draining = noMoreInput_ && pendingWrites_ > 0;
+    if (!draining && bufferedBytes_ <= maxBufferedBytes_) {
+      return BlockingReason::kNotBlocked;
+    }
+    VELOX_CHECK(!blockedPromise_.valid());
+    blockedPromise_ = ContinuePromise("BroadcastWriteOperator::writePipeline");
+    *future = blockedPromise_.getSemiFuture();
+    return BlockingReason::kWaitForConsumer;
   }
 
   bool isFinished() override {
     return finished_;
   }
 
+  void close() override {
+    // Wait for in-flight background writes that reference 'this' and the
+    // file writer.
+    if (writeExecutor_ != nullptr) {
+      std::unique_lock<std::mutex> l(mutex_);
+      drainCv_.wait(l, [&]() { return pendingWrites_ == 0; });
+    }
+    Operator::close();
+  }
+
  private:
+  // Called on the write executor when a batch write or the final flush
+  // completes; settles the byte budget and wakes a blocked driver.
+  void finishBackgroundWrite(uint64_t batchBytes) {
+    ContinuePromise promise = ContinuePromise::makeEmpty();
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      bufferedBytes_ -= batchBytes;
+      --pendingWrites_;
+      if (blockedPromise_.valid()) {
+        promise = std::move(blockedPromise_);
+        blockedPromise_ = ContinuePromise::makeEmpty();
+      }
+      drainCv_.notify_all();
+    }
+    if (promise.valid()) {
+      promise.setValue();
+    }
+  }
+
+  // Rethrows an error raised on the write executor on the driver thread.
+  void maybeRethrowWriteError() {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (writeError_ != nullptr) {
+      std::rethrow_exception(writeError_);
+    }
+  }
   // May be empty.
   const RowTypePtr serdeRowType_;
   // Empty if column order in the serdeRowType_ is exactly the same as in input
   // or serdeRowType_ has no columns.
   const std::vector<column_index_t> serdeChannels_;
   const uint64_t maxBroadcastBytes_;
+  // Byte budget of the background write pipeline; 0 writes synchronously on
+  // the driver thread.
+  const uint64_t maxBufferedBytes_;
   std::unique_ptr<BroadcastFileWriter> fileBroadcastWriter_;
   bool finished_{false};
+
+  // Runs background batch writes in input order; null when the write
+  // pipeline is disabled.
+  folly::Executor::KeepAlive<> writeExecutor_;
+
+  // Protects the pipeline state below.
+  std::mutex mutex_;
+  // Estimated bytes of batches handed to the pipeline and not yet written.
+  uint64_t bufferedBytes_{0};
+  // Background writes scheduled and not yet completed, including the final
+  // flush.
+  uint32_t pendingWrites_{0};
+  // Fulfilled by finishBackgroundWrite() to wake a driver blocked on the
+  // byte budget or on the final drain.
+  ContinuePromise blockedPromise_{ContinuePromise::makeEmpty()};
+  std::exception_ptr writeError_;
+  // Signaled on every background write completion; close() waits on it for
+  // the pipeline to drain.
+  std::condition_variable drainCv_;
 };
 } // namespace
 
@@ -18,6 +18,17 @@
 
 namespace facebook::presto::operators {
 
+/// Runtime stat names reported by the BroadcastWrite operator.
+/// 'broadcastBytes' accumulates the estimated size of the broadcast table as
+/// input arrives; PrestoTask hoists it into the task-level runtime stats of
+/// running tasks so the coordinator can notice an oversized broadcast while
+/// the stage is still running rather than after it finishes.
+/// 'broadcastSerializedBytes' is the serialized size of the finished
+/// broadcast file.
+inline const std::string kBroadcastWriteBytes{"broadcastBytes"};
+inline const std::string kBroadcastWriteSerializedBytes{
+    "broadcastSerializedBytes"};
+
 /// BroadcastWriteNode represents node which broadcasts using file system.
 class BroadcastWriteNode : public velox::core::PlanNode {
  public:
@@ -13,12 +13,23 @@
  */
 #include "presto_cpp/main/operators/LocalShuffle.h"
 #include "presto_cpp/external/json/nlohmann/json.hpp"
+#include "presto_cpp/main/common/CompressionBackend.h"
 #include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
+#include "presto_cpp/main/common/LocalDiskIoScheduler.h"
 
 #include "velox/common/Casts.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileInputStream.h"
+#include "velox/common/time/Timer.h"
+
+#include <array>
 
 #include <boost/range/algorithm/sort.hpp>
+#include <folly/compression/Compression.h>
+#include <folly/executors/GlobalExecutor.h>
+#include <folly/hash/Checksum.h>
+#include <folly/hash/Hash.h>
 
 namespace facebook::presto::operators {
 
@@ -33,48 +44,103 @@ using TStreamIdx = uint16_t;
 // merge.
 constexpr uint64_t kDefaultInputStreamBufferSize = 8 * 1024 * 1024; // 8MB
 
+// Magic word opening every framed shuffle block ('SBLK').
+constexpr uint32_t kBlockMagic = 0x53424C4B;
+
+// Fixed part of a framed block header: magic, row count, payload bytes and
+// the sizes of the min/max sort keys that follow it. All fields big-endian,
+// like the row framing.
+constexpr size_t kBlockFixedHeaderSize =
+    sizeof(uint32_t) * 2 + sizeof(uint64_t) + sizeof(TRowSize) * 2;
+
+/// Common interface for sorted shuffle merge streams, backed by either a
+/// shuffle file or an in-memory block staged by a co-located writer. Streams
+/// are ordered by the current key for the k-way merge, with the stream index
+/// as tie breaker to keep the merge stable.
+class SortedShuffleStream : public velox::MergeStream {
+ public:
+  ~SortedShuffleStream() override = default;
+
+  /// Advances to the next (key, data) pair. Returns false at end of stream.
+  virtual bool next() = 0;
+
+  virtual std::string_view currentKey() const = 0;
+
+  virtual std::string_view currentValue() const = 0;
+
+  bool operator<(const velox::MergeStream& other) const final {
+    const auto* otherStream = static_cast<const SortedShuffleStream*>(&other);
+    const auto key = currentKey();
+    const auto otherKey = otherStream->currentKey();
+    // Resolve on the first 8 key bytes when possible; only prefix ties pay
+    // for the full byte-wise comparison.
+    const auto prefix = loadKeyPrefix(key);
+    const auto otherPrefix = loadKeyPrefix(otherKey);
+    if (prefix != otherPrefix) {
+      return prefix < otherPrefix;
+    }
+    if (key != otherKey) {
+      return compareKeys(key, otherKey);
+    }
+    return streamIdx_ < otherStream->streamIdx_;
+  }
+
+ protected:
+  explicit SortedShuffleStream(TStreamIdx streamIdx) : streamIdx_(streamIdx) {}
+
+  const TStreamIdx streamIdx_;
+};
+
 /// SortedFileInputStream reads sorted (key, data) pairs from a single
 /// shuffle file with buffered I/O. It extends FileInputStream for efficient
-/// buffered I/O and implements MergeStream interface for k-way merge.
+/// buffered I/O and implements SortedShuffleStream for k-way merge.
 class SortedFileInputStream final : public velox::common::FileInputStream,
-                                    public velox::MergeStream {
+                                    public SortedShuffleStream {
  public:
   SortedFileInputStream(
       const std::string& filePath,
       TStreamIdx streamIdx,
       velox::memory::MemoryPool* pool,
-      size_t bufferSize = kDefaultInputStreamBufferSize)
+      size_t bufferSize = kDefaultInputStreamBufferSize,
+      bool framed = false)
       : velox::common::FileInputStream(
             velox::filesystems::getFileSystem(filePath, nullptr)
                 ->openFileForRead(filePath),
             bufferSize,
             pool),
-        streamIdx_(streamIdx) {
+        SortedShuffleStream(streamIdx),
+        framed_(framed) {
     next();
   }
 
   ~SortedFileInputStream() override = default;
 
-  bool next() {
+  bool next() override {
     if (atEnd()) {
       currentKey_.clear();
       currentValue_.clear();
       return false;
     }
+    if (framed_ && blockRemaining_ == 0) {
+      skipBlockHeader();
+    }
     const TRowSize keySize = folly::Endian::big(read<TRowSize>());
     const TRowSize valueSize = folly::Endian::big(read<TRowSize>());
 
     // TODO: Optimize with zero-copy approach when data is contiguous in buffer.
     readString(currentKey_, keySize);
     readString(currentValue_, valueSize);
+    if (framed_) {
+      blockRemaining_ -= kUint32Size * 2 + keySize + valueSize;
+    }
     return true;
   }
 
-  std::string_view currentKey() const {
+  std::string_view currentKey() const override {
     return currentKey_;
   }
 
-  std::string_view currentValue() const {
+  std::string_view currentValue() const override {
     return currentValue_;
   }
 
@@ -82,14 +148,6 @@ class SortedFileInputStream final : public velox::common::FileInputStream,
     return !currentValue_.empty() || !atEnd();
   }
 
-  bool operator<(const velox::MergeStream& other) const override {
-    const auto* otherReader = static_cast<const SortedFileInputStream*>(&other);
-    if (currentKey_ != otherReader->currentKey_) {
-      return compareKeys(currentKey_, otherReader->currentKey_);
-    }
-    return streamIdx_ < otherReader->streamIdx_;
-  }
-
  private:
   void readString(std::string& target, TRowSize size) {
     if (size > 0) {
@@ -100,24 +158,269 @@ class SortedFileInputStream final : public velox::common::FileInputStream,
     }
   }
 
-  const TStreamIdx streamIdx_;
+  // Consumes the framed block header preceding the next row; the merge only
+  // needs the payload size to know where the following header starts.
+  void skipBlockHeader() {
+    const uint32_t magic = folly::Endian::big(read<uint32_t>());
+    VELOX_CHECK_EQ(
+        magic, kBlockMagic, "Corrupted framed shuffle file: bad block magic");
+    read<uint32_t>(); // Row count, unused by the merge.
+    blockRemaining_ = folly::Endian::big(read<uint64_t>());
+    const TRowSize minKeySize = folly::Endian::big(read<TRowSize>());
+    const TRowSize maxKeySize = folly::Endian::big(read<TRowSize>());
+    std::string scratch;
+    readString(scratch, minKeySize);
+    readString(scratch, maxKeySize);
+  }
+
+  // True when the file carries framed block headers that must be skipped.
+  const bool framed_;
+  // Payload bytes left in the current framed block.
+  uint64_t blockRemaining_{0};
+
+  std::string currentKey_;
+  std::string currentValue_;
+};
+
+/// SortedFilePrefetchStream reads sorted (key, data) pairs from a single
+/// shuffle file in fixed-size chunks, keeping up to 'prefetchDepth' chunk
+/// reads in flight on the IO executor so the k-way merge overlaps with file
+/// reads instead of stalling on each buffer refill. Rows may span chunk
+/// boundaries, so keys and values are copied out of the chunks as they are
+/// consumed.
+class SortedFilePrefetchStream final : public SortedShuffleStream {
+ public:
+  SortedFilePrefetchStream(
+      const std::string& filePath,
+      TStreamIdx streamIdx,
+      velox::memory::MemoryPool* pool,
+      uint32_t prefetchDepth,
+      size_t bufferSize = kDefaultInputStreamBufferSize,
+      bool framed = false)
+      : SortedShuffleStream(streamIdx),
+        file_(velox::filesystems::getFileSystem(filePath, nullptr)
+                  ->openFileForRead(filePath)),
+        fileSize_(file_->size()),
+        bufferSize_(bufferSize),
+        prefetchDepth_(std::max<uint32_t>(prefetchDepth, 1)),
+        framed_(framed),
+        pool_(pool) {
+    scheduleChunks();
+    next();
+  }
+
+  ~SortedFilePrefetchStream() override {
+    // Wait for in-flight chunk reads that reference 'this'.
+    for (auto& chunk : chunks_) {
+      std::move(chunk).getTry();
+    }
+  }
+
+  bool next() override {
+    if (consumedBytes_ >= fileSize_) {
+      currentKey_.clear();
+      currentValue_.clear();
+      return false;
+    }
+    if (framed_ && blockRemaining_ == 0) {
+      skipBlockHeader();
+    }
+    TRowSize sizes[2];
+    readBytes(reinterpret_cast<uint8_t*>(sizes), sizeof(sizes));
+    readString(currentKey_, folly::Endian::big(sizes[0]));
+    readString(currentValue_, folly::Endian::big(sizes[1]));
+    if (framed_) {
+      blockRemaining_ -=
+          sizeof(sizes) + currentKey_.size() + currentValue_.size();
+    }
+    return true;
+  }
+
+  std::string_view currentKey() const override {
+    return currentKey_;
+  }
+
+  std::string_view currentValue() const override {
+    return currentValue_;
+  }
+
+  bool hasData() const override {
+    return !currentValue_.empty() || consumedBytes_ < fileSize_;
+  }
+
+ private:
+  // Schedules chunk reads on the IO executor until 'chunks_' holds
+  // 'prefetchDepth_' outstanding reads or the whole file is scheduled.
+  void scheduleChunks() {
+    while (chunks_.size() < prefetchDepth_ && scheduleOffset_ < fileSize_) {
+      const auto offset = scheduleOffset_;
+      const auto length = std::min<uint64_t>(bufferSize_, fileSize_ - offset);
+      scheduleOffset_ += length;
+      chunks_.push_back(folly::via(
+          folly::getKeepAliveToken(folly::getGlobalIOExecutor().get()),
+          [this, offset, length]() {
+            LocalDiskIoScheduler::instance()->acquire(
+                LocalDiskIoScheduler::IoClass::kShuffleRead, length);
+            auto buffer =
+                velox::AlignedBuffer::allocate<char>(length, pool_, 0);
+            file_->pread(offset, length, buffer->asMutable<void>());
+            return buffer;
+          }));
+    }
+  }
+
+  void readBytes(uint8_t* target, size_t size) {
+    while (size > 0) {
+      if (current_ == nullptr || currentPos_ >= current_->size()) {
+        VELOX_CHECK(!chunks_.empty(), "Read past end of sorted shuffle file");
+        current_ = std::move(chunks_.front()).get();
+        chunks_.pop_front();
+        currentPos_ = 0;
+        scheduleChunks();
+      }
+      const auto copySize =
+          std::min<size_t>(size, current_->size() - currentPos_);
+      memcpy(target, current_->as<char>() + currentPos_, copySize);
+      target += copySize;
+      currentPos_ += copySize;
+      consumedBytes_ += copySize;
+      size -= copySize;
+    }
+  }
+
+  void readString(std::string& target, TRowSize size) {
+    target.resize(size);
+    if (size > 0) {
+      readBytes(reinterpret_cast<uint8_t*>(target.data()), size);
+    }
+  }
+
+  // Consumes the framed block header preceding the next row.
+  void skipBlockHeader() {
+    char fixed[kBlockFixedHeaderSize];
+    readBytes(reinterpret_cast<uint8_t*>(fixed), sizeof(fixed));
+    size_t offset = 0;
+    const auto readWord = [&](auto& word) {
+      std::memcpy(&word, fixed + offset, sizeof(word));
+      word = folly::Endian::big(word);
+      offset += sizeof(word);
+    };
+    uint32_t magic;
+    readWord(magic);
+    VELOX_CHECK_EQ(
+        magic, kBlockMagic, "Corrupted framed shuffle file: bad block magic");
+    uint32_t rowCount;
+    readWord(rowCount);
+    readWord(blockRemaining_);
+    TRowSize minKeySize;
+    TRowSize maxKeySize;
+    readWord(minKeySize);
+    readWord(maxKeySize);
+    std::string scratch;
+    readString(scratch, minKeySize);
+    readString(scratch, maxKeySize);
+  }
+
+  const std::unique_ptr<velox::ReadFile> file_;
+  const uint64_t fileSize_;
+  const size_t bufferSize_;
+  const uint32_t prefetchDepth_;
+  // True when the file carries framed block headers that must be skipped.
+  const bool framed_;
+  velox::memory::MemoryPool* const pool_;
+
+  // Next file offset to schedule a chunk read at.
+  uint64_t scheduleOffset_{0};
+  // Bytes consumed from the file so far.
+  uint64_t consumedBytes_{0};
+  // Outstanding chunk reads, in file order.
+  std::deque<folly::Future<velox::BufferPtr>> chunks_;
+  // Chunk currently being consumed and the read position within it.
+  velox::BufferPtr current_;
+  size_t currentPos_{0};
+  // Payload bytes left in the current framed block.
+  uint64_t blockRemaining_{0};
+
   std::string currentKey_;
   std::string currentValue_;
 };
 
+/// SortedBlockInputStream serves sorted (key, data) pairs from an in-memory
+/// shuffle block staged by a co-located writer. Keys and values are
+/// zero-copy views into the block buffer.
+class SortedBlockInputStream final : public SortedShuffleStream {
+ public:
+  SortedBlockInputStream(
+      LocalShuffleMemoryBroker::Block block,
+      TStreamIdx streamIdx)
+      : SortedShuffleStream(streamIdx), block_(std::move(block)) {
+    next();
+  }
+
+  ~SortedBlockInputStream() override = default;
+
+  bool next() override {
+    if (offset_ + kUint32Size * 2 > block_.size) {
+      currentKey_ = {};
+      currentValue_ = {};
+      return false;
+    }
+    const char* data = block_.buffer->as<char>();
+    const TRowSize keySize = folly::Endian::big(
+        *reinterpret_cast<const TRowSize*>(data + offset_));
+    offset_ += kUint32Size;
+    const TRowSize valueSize = folly::Endian::big(
+        *reinterpret_cast<const TRowSize*>(data + offset_));
+    offset_ += kUint32Size;
+    VELOX_CHECK_LE(
+        offset_ + keySize + valueSize,
+        block_.size,
+        "Corrupted in-memory shuffle block");
+    currentKey_ = {data + offset_, keySize};
+    offset_ += keySize;
+    currentValue_ = {data + offset_, valueSize};
+    offset_ += valueSize;
+    return true;
+  }
+
+  std::string_view currentKey() const override {
+    return currentKey_;
+  }
+
+  std::string_view currentValue() const override {
+    return currentValue_;
+  }
+
+  bool hasData() const override {
+    return !currentValue_.empty() || offset_ < block_.size;
+  }
+
+ private:
+  const LocalShuffleMemoryBroker::Block block_;
+  size_t offset_{0};
+  std::string_view currentKey_;
+  std::string_view currentValue_;
+};
+
 class LocalShuffleSerializedPage : public ShuffleSerializedPage {
  public:
+  /// 'size' overrides the reported page size for pages that cover only a
+  /// slice of 'buffer', e.g. one framed block of a larger file; zero reports
+  /// the whole buffer.
   LocalShuffleSerializedPage(
       const std::vector<std::string_view>& rows,
-      velox::BufferPtr buffer)
-      : rows_{std::move(rows)}, buffer_{std::move(buffer)} {}
+      velox::BufferPtr buffer,
+      uint64_t size = 0)
+      : rows_{std::move(rows)},
+        buffer_{std::move(buffer)},
+        size_{size == 0 ? buffer_->size() : size} {}
 
   const std::vector<std::string_view>& rows() override {
     return rows_;
   }
 
   uint64_t size() const override {
-    return buffer_->size();
+    return size_;
   }
 
   std::optional<int64_t> numRows() const override {
@@ -127,6 +430,7 @@ class LocalShuffleSerializedPage : public ShuffleSerializedPage {
  private:
   const std::vector<std::string_view> rows_;
   const velox::BufferPtr buffer_;
+  const uint64_t size_;
 };
 
 std::vector<RowMetadata>
@@ -159,7 +463,11 @@ extractRowMetadata(const char* buffer, size_t bufferSize, bool sortedShuffle) {
 
       rows.push_back(
           RowMetadata{
-              .rowStart = rowStart, .keySize = keySize, .dataSize = dataSize});
+              .rowStart = rowStart,
+              .keySize = keySize,
+              .dataSize = dataSize,
+              .keyPrefix = loadKeyPrefix(
+                  std::string_view(buffer + offset, keySize))});
 
       offset += keySize + dataSize;
     }
@@ -207,6 +515,12 @@ std::vector<RowMetadata> extractAndSortRowMetadata(
   if (!rows.empty() && sortedShuffle) {
     boost::range::sort(
         rows, [buffer](const RowMetadata& lhs, const RowMetadata& rhs) {
+          // Most comparisons resolve on the precomputed 8-byte prefix without
+          // touching the serialized keys; only prefix ties pay for the full
+          // byte-wise comparison.
+          if (lhs.keyPrefix != rhs.keyPrefix) {
+            return lhs.keyPrefix < rhs.keyPrefix;
+          }
           const char* lhsKey = buffer + lhs.rowStart + (kUint32Size * 2);
           const char* rhsKey = buffer + rhs.rowStart + (kUint32Size * 2);
           return compareKeys(
@@ -217,25 +531,421 @@ std::vector<RowMetadata> extractAndSortRowMetadata(
   return rows;
 }
 
+// Suffix appended to the names of LZ4-compressed shuffle files so readers
+// can detect the block format without any shuffle info changes.
+constexpr std::string_view kCompressedFileSuffix = ".lz4";
+
+// Suffix appended to the names of shuffle files that carry a CRC32C trailer
+// so readers know to verify and strip it before decoding.
+constexpr std::string_view kChecksumFileSuffix = ".crc32c";
+
+// Size of the CRC32C trailer at the end of checksummed shuffle files.
+constexpr size_t kChecksumTrailerSize = sizeof(uint32_t);
+
+// Suffix appended to the names of shuffle files whose blocks carry
+// self-describing headers, so readers detect the framing without any shuffle
+// info changes. Ordered before the checksum suffix, since the trailer covers
+// the stored bytes including the headers.
+constexpr std::string_view kFramedFileSuffix = ".blk";
+
+// Decoded framed block header. Key views point into the decoded buffer.
+struct BlockHeader {
+  uint32_t rowCount;
+  uint64_t payloadBytes;
+  std::string_view minKey;
+  std::string_view maxKey;
+};
+
+std::string encodeBlockHeader(
+    uint32_t rowCount,
+    uint64_t payloadBytes,
+    std::string_view minKey,
+    std::string_view maxKey) {
+  std::string header;
+  header.reserve(kBlockFixedHeaderSize + minKey.size() + maxKey.size());
+  const auto appendWord = [&header](auto word) {
+    const auto value = folly::Endian::big(word);
+    header.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  appendWord(kBlockMagic);
+  appendWord(rowCount);
+  appendWord(payloadBytes);
+  appendWord(static_cast<TRowSize>(minKey.size()));
+  appendWord(static_cast<TRowSize>(maxKey.size()));
+  header.append(minKey);
+  header.append(maxKey);
+  return header;
+}
+
+// Decodes the framed block header at 'offset' of 'buffer' and advances
+// 'offset' past it, to the first row of the block's payload.
+BlockHeader
+decodeBlockHeader(const char* buffer, size_t bufferSize, size_t& offset) {
+  VELOX_CHECK_LE(
+      offset + kBlockFixedHeaderSize,
+      bufferSize,
+      "Corrupted framed shuffle data: truncated block header");
+  const auto readWord = [&](auto& word) {
+    std::memcpy(&word, buffer + offset, sizeof(word));
+    word = folly::Endian::big(word);
+    offset += sizeof(word);
+  };
+  uint32_t magic;
+  readWord(magic);
+  VELOX_CHECK_EQ(
+      magic, kBlockMagic, "Corrupted framed shuffle data: bad block magic");
+  BlockHeader header;
+  readWord(header.rowCount);
+  readWord(header.payloadBytes);
+  TRowSize minKeySize;
+  TRowSize maxKeySize;
+  readWord(minKeySize);
+  readWord(maxKeySize);
+  VELOX_CHECK_LE(
+      offset + minKeySize + maxKeySize + header.payloadBytes,
+      bufferSize,
+      "Corrupted framed shuffle data: block overruns the buffer");
+  header.minKey = {buffer + offset, minKeySize};
+  offset += minKeySize;
+  header.maxKey = {buffer + offset, maxKeySize};
+  offset += maxKeySize;
+  return header;
+}
+
+// Suffix appended to the names of dedup-encoded shuffle files so readers
+// know to resolve chunk records through the LocalShuffleChunkStore.
+constexpr std::string_view kDedupFileSuffix = ".cdc";
+
+// Content-defined chunking parameters. Boundaries are placed where the
+// rolling gear hash masks to zero, so identical byte runs chunk identically
+// regardless of their offset in the block; the min/max sizes bound the
+// per-chunk record overhead and the store granularity.
+constexpr size_t kMinChunkBytes = 4 << 10;
+constexpr size_t kMaxChunkBytes = 128 << 10;
+// Mask for an average chunk of roughly 16KB past the minimum size.
+constexpr uint64_t kChunkBoundaryMask = (1ULL << 14) - 1;
+
+// Chunk record tags in dedup-encoded files. A literal record carries
+// [tag][u32 length][bytes]; a reference record carries [tag][u64 hash] and
+// resolves through the chunk store.
+constexpr char kLiteralChunkTag = 0;
+constexpr char kReferenceChunkTag = 1;
+
+// Byte table driving the gear hash. Filled with splitmix64 so the table, and
+// with it the chunk boundaries, are deterministic across processes.
+const std::array<uint64_t, 256>& gearTable() {
+  static const std::array<uint64_t, 256> table = []() {
+    std::array<uint64_t, 256> t{};
+    uint64_t seed = 0;
+    for (auto& value : t) {
+      seed += 0x9E3779B97F4A7C15ULL;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      value = z ^ (z >> 31);
+    }
+    return t;
+  }();
+  return table;
+}
+
+// Returns the end offset (exclusive) of the chunk starting at 'start': the
+// first position past the minimum size where the gear hash masks to zero,
+// bounded by the maximum chunk size and the buffer end.
+size_t nextChunkEnd(const char* data, size_t size, size_t start) {
+  const auto limit = std::min(size, start + kMaxChunkBytes);
+  auto pos = std::min(limit, start + kMinChunkBytes);
+  const auto& table = gearTable();
+  uint64_t hash = 0;
+  for (; pos < limit; ++pos) {
+    hash = (hash << 1) + table[static_cast<uint8_t>(data[pos])];
+    if ((hash & kChunkBoundaryMask) == 0) {
+      return pos + 1;
+    }
+  }
+  return limit;
+}
+
+// Decodes a dedup-encoded shuffle file into the plain block bytes, resolving
+// reference records through the chunk store.
+velox::BufferPtr dedupDecodeBuffer(
+    const char* data,
+    size_t size,
+    const std::string& queryId,
+    velox::memory::MemoryPool* pool) {
+  const auto readWord = [&](size_t& offset, auto& word) {
+    VELOX_CHECK_LE(
+        offset + sizeof(word),
+        size,
+        "Corrupted dedup shuffle data: truncated record");
+    std::memcpy(&word, data + offset, sizeof(word));
+    word = folly::Endian::big(word);
+    offset += sizeof(word);
+  };
+  size_t offset = 0;
+  uint64_t decodedSize;
+  readWord(offset, decodedSize);
+  auto buffer = velox::AlignedBuffer::allocate<char>(decodedSize, pool, 0);
+  char* writePos = buffer->asMutable<char>();
+  uint64_t written = 0;
+  auto* store = LocalShuffleChunkStore::instance();
+  while (offset < size) {
+    const char tag = data[offset++];
+    if (tag == kLiteralChunkTag) {
+      uint32_t length;
+      readWord(offset, length);
+      VELOX_CHECK_LE(
+          offset + length,
+          size,
+          "Corrupted dedup shuffle data: literal overruns the file");
+      VELOX_CHECK_LE(
+          written + length,
+          decodedSize,
+          "Corrupted dedup shuffle data: decoded size overflow");
+      std::memcpy(writePos + written, data + offset, length);
+      offset += length;
+      written += length;
+    } else if (tag == kReferenceChunkTag) {
+      uint64_t hash;
+      readWord(offset, hash);
+      const auto chunk = store->get(queryId, hash);
+      VELOX_CHECK_NOT_NULL(
+          chunk,
+          "Corrupted dedup shuffle data: unresolved chunk reference {:x}",
+          hash);
+      VELOX_CHECK_LE(
+          written + chunk->size(),
+          decodedSize,
+          "Corrupted dedup shuffle data: decoded size overflow");
+      std::memcpy(writePos + written, chunk->data(), chunk->size());
+      written += chunk->size();
+    } else {
+      VELOX_FAIL(
+          "Corrupted dedup shuffle data: unknown record tag {}",
+          static_cast<int>(tag));
+    }
+  }
+  VELOX_CHECK_EQ(
+      written,
+      decodedSize,
+      "Corrupted dedup shuffle data: decoded size mismatch");
+  buffer->setSize(decodedSize);
+  return buffer;
+}
+
+// True when the shuffle file name carries the framing suffix, ignoring a
+// trailing checksum suffix.
+bool isFramedShuffleFileName(std::string_view filename) {
+  if (filename.ends_with(kChecksumFileSuffix)) {
+    filename.remove_suffix(kChecksumFileSuffix.size());
+  }
+  return filename.ends_with(kFramedFileSuffix);
+}
+
 inline std::string createShuffleFileName(
     const std::string& rootPath,
     const std::string& queryId,
     uint32_t shuffleId,
     int32_t partition,
     int fileIndex,
-    const std::thread::id& id) {
+    const std::thread::id& id,
+    bool compressed,
+    bool checksummed,
+    bool framed,
+    bool deduped) {
   // Follow Spark's shuffle file name format: shuffle_shuffleId_0_reduceId
   return fmt::format(
-      "{}/{}_shuffle_{}_0_{}_{}_{}.bin",
+      "{}/{}_shuffle_{}_0_{}_{}_{}.bin{}{}{}{}",
       rootPath,
       queryId,
       shuffleId,
       partition,
       fileIndex,
-      id);
+      id,
+      compressed ? kCompressedFileSuffix : std::string_view{},
+      deduped ? kDedupFileSuffix : std::string_view{},
+      framed ? kFramedFileSuffix : std::string_view{},
+      checksummed ? kChecksumFileSuffix : std::string_view{});
+}
+// Initial capacity of a partition's in-progress buffer. Buffers double from
+// here as a destination proves it needs the space, up to the per-partition
+// byte limit, so a wide shuffle only pays full-size buffers for the
+// destinations that actually fill them.
+constexpr uint64_t kInitialPartitionBufferBytes = 64 << 10; // 64KB
+
+// A partition whose buffer has sat empty for this long since its last flush
+// has the buffer released back to the pool.
+constexpr uint64_t kPartitionBufferIdleTrimMs = 10'000;
+
+// Number of small files a partition accumulates before they are handed to a
+// background merge job.
+constexpr size_t kCompactionBatchFiles = 8;
+
+// Bytes the sorted-run merge buffers before each append to the merged file,
+// so the output is written in large sequential chunks.
+constexpr uint64_t kCompactionWriteBufferBytes = 4 << 20; // 4MB
+
+inline std::string createMergedShuffleFileName(
+    const std::string& rootPath,
+    const std::string& queryId,
+    uint32_t shuffleId,
+    int32_t partition,
+    uint32_t sequence,
+    const std::thread::id& id,
+    bool checksummed,
+    bool framed) {
+  // Matches the '<queryId>_<partitionId>_' prefix readers list by; the
+  // 'merged' token keeps these names clear of the writer's file index space.
+  return fmt::format(
+      "{}/{}_shuffle_{}_0_{}_merged_{}_{}.bin{}{}",
+      rootPath,
+      queryId,
+      shuffleId,
+      partition,
+      sequence,
+      id,
+      framed ? kFramedFileSuffix : std::string_view{},
+      checksummed ? kChecksumFileSuffix : std::string_view{});
+}
+
+inline std::string brokerKey(
+    const std::string& queryId,
+    const std::string& partitionId) {
+  return fmt::format("{}/{}", queryId, partitionId);
 }
 } // namespace
 
+// static
+LocalShuffleMemoryBroker* LocalShuffleMemoryBroker::instance() {
+  static LocalShuffleMemoryBroker broker;
+  return &broker;
+}
+
+LocalShuffleMemoryBroker::LocalShuffleMemoryBroker()
+    : pool_(velox::memory::MemoryManager::getInstance()->addLeafPool(
+          "LocalShuffleMemoryBroker")) {}
+
+velox::memory::MemoryPool* LocalShuffleMemoryBroker::pool() const {
+  return pool_.get();
+}
+
+bool LocalShuffleMemoryBroker::put(
+    const std::string& queryId,
+    const std::string& partitionId,
+    Block& block,
+    uint64_t maxBytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stagedBytes_ + block.size > maxBytes) {
+    return false;
+  }
+  stagedBytes_ += block.size;
+  blocks_[brokerKey(queryId, partitionId)].push_back(std::move(block));
+  return true;
+}
+
+std::vector<LocalShuffleMemoryBroker::Block> LocalShuffleMemoryBroker::take(
+    const std::string& queryId,
+    const std::string& partitionId) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = blocks_.find(brokerKey(queryId, partitionId));
+  if (it == blocks_.end()) {
+    return {};
+  }
+  auto taken = std::move(it->second);
+  blocks_.erase(it);
+  for (const auto& block : taken) {
+    stagedBytes_ -= block.size;
+  }
+  return taken;
+}
+
+void LocalShuffleMemoryBroker::drop(const std::string& queryId) {
+  const auto prefix = brokerKey(queryId, "");
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = blocks_.begin(); it != blocks_.end();) {
+    if (it->first.starts_with(prefix)) {
+      for (const auto& block : it->second) {
+        stagedBytes_ -= block.size;
+      }
+      it = blocks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+uint64_t LocalShuffleMemoryBroker::stagedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stagedBytes_;
+}
+
+// static
+LocalShuffleChunkStore* LocalShuffleChunkStore::instance() {
+  static LocalShuffleChunkStore store;
+  return &store;
+}
+
+// static
+std::string LocalShuffleChunkStore::chunkKey(
+    const std::string& queryId,
+    uint64_t hash) {
+  // Query-scoped keys, like the broker's, so drop() can prefix-scan and one
+  // query's chunks never serve another's references.
+  return fmt::format("{}/{:x}", queryId, hash);
+}
+
+bool LocalShuffleChunkStore::put(
+    const std::string& queryId,
+    uint64_t hash,
+    std::string_view data,
+    uint64_t maxBytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = chunks_.find(chunkKey(queryId, hash));
+  if (it != chunks_.end()) {
+    // Verify the bytes so a hash collision degrades to an inline chunk
+    // instead of corrupting the reader's view.
+    if (std::string_view(*it->second.data) != data) {
+      return false;
+    }
+    ++it->second.refs;
+    return true;
+  }
+  if (storedBytes_ + data.size() > maxBytes) {
+    return false;
+  }
+  storedBytes_ += data.size();
+  chunks_.emplace(
+      chunkKey(queryId, hash),
+      Entry{std::make_shared<const std::string>(data), 1});
+  return true;
+}
+
+std::shared_ptr<const std::string> LocalShuffleChunkStore::get(
+    const std::string& queryId,
+    uint64_t hash) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = chunks_.find(chunkKey(queryId, hash));
+  return it == chunks_.end() ? nullptr : it->second.data;
+}
+
+void LocalShuffleChunkStore::drop(const std::string& queryId) {
+  const auto prefix = fmt::format("{}/", queryId);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = chunks_.begin(); it != chunks_.end();) {
+    if (it->first.starts_with(prefix)) {
+      storedBytes_ -= it->second.data->size();
+      it = chunks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+uint64_t LocalShuffleChunkStore::storedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return storedBytes_;
+}
+
 std::string LocalShuffleWriteInfo::serialize() const {
   json obj;
   obj["rootPath"] = rootPath;
@@ -285,17 +995,37 @@ LocalShuffleWriter::LocalShuffleWriter(
     uint32_t numPartitions,
     uint64_t maxBytesPerPartition,
     bool sortedShuffle,
-    velox::memory::MemoryPool* pool)
+    velox::memory::MemoryPool* pool,
+    uint64_t memoryTransportMaxBytes,
+    bool fileCompressionEnabled,
+    bool fileChecksumEnabled,
+    uint64_t compactionMinFileBytes,
+    folly::Executor* compactionExecutor,
+    bool blockHeaderEnabled,
+    uint64_t dedupMaxBytes)
     : threadId_(std::this_thread::get_id()),
       pool_(pool),
       numPartitions_(numPartitions),
       maxBytesPerPartition_(maxBytesPerPartition),
+      memoryTransportMaxBytes_(memoryTransportMaxBytes),
       sortedShuffle_(sortedShuffle),
+      fileCompressionEnabled_(fileCompressionEnabled && !sortedShuffle),
+      fileChecksumEnabled_(fileChecksumEnabled && !sortedShuffle),
+      compactionMinFileBytes_(compactionMinFileBytes),
+      blockHeaderEnabled_(
+          blockHeaderEnabled && !fileCompressionEnabled_ &&
+          (dedupMaxBytes == 0 || sortedShuffle)),
+      dedupMaxBytes_(dedupMaxBytes),
+      compactionExecutor_(compactionExecutor),
       rootPath_(rootPath),
       queryId_(queryId),
       shuffleId_(shuffleId) {
   inProgressPartitions_.assign(numPartitions_, nullptr);
   inProgressSizes_.assign(numPartitions_, 0);
+  inProgressRowCounts_.assign(numPartitions_, 0);
+  lastBlockMs_.assign(numPartitions_, 0);
+  nextFileIndex_.assign(numPartitions_, 0);
+  compactionCandidates_.resize(numPartitions_);
   fileSystem_ = velox::filesystems::getFileSystem(rootPath_, nullptr);
 }
 
@@ -306,16 +1036,81 @@ void LocalShuffleWriter::writeBlock(int32_t partition) {
   VELOX_DCHECK_NOT_NULL(buffer, "Buffer should be allocated before writeBlock");
   VELOX_DCHECK_GT(bufferSize, 0, "Buffer size should be positive");
 
-  auto file = getNextOutputFile(partition);
+  if (stageBlockInMemory(partition)) {
+    inProgressSizes_[partition] = 0;
+    inProgressRowCounts_[partition] = 0;
+    const auto nowMs = velox::getCurrentTimeMs();
+    lastBlockMs_[partition] = nowMs;
+    trimIdlePartitionBuffers(nowMs);
+    return;
+  }
+
+  const auto filename = nextAvailablePartitionFileName(rootPath_, partition);
+  auto file = fileSystem_->openFileForWrite(filename);
   const char* data = buffer->as<char>();
+  auto* ioScheduler = LocalDiskIoScheduler::instance();
 
   // For non-sorted shuffle, write buffer directly
   if (!sortedShuffle_) {
-    file->append(std::string_view(data, bufferSize));
+    std::string encoded;
+    std::string_view payload(data, bufferSize);
+    if (fileCompressionEnabled_) {
+      // The LZ4 codec records the uncompressed size, so the reader only needs
+      // the file name suffix to restore the block. The backend registry picks
+      // who produces the LZ4 bytes; shuffle files are a spill-style write, so
+      // the ratio-favoring policy applies.
+      encoded = CompressionBackendRegistry::instance()->compress(
+          CompressionUse::kSpill,
+          folly::compression::CodecType::LZ4,
+          folly::StringPiece(data, bufferSize));
+      payload = encoded;
+    } else if (dedupEnabled()) {
+      // Chunk the block and write references for chunk contents the store
+      // already holds for this query; the reader resolves them back through
+      // the store.
+      encoded = dedupEncodeBlock(data, bufferSize);
+      payload = encoded;
+    } else if (blockHeaderEnabled_) {
+      // Frame the block with its header so readers can serve concatenated
+      // blocks individually. Unsorted rows carry no sort key, so the header's
+      // key range is empty.
+      encoded = encodeBlockHeader(
+          inProgressRowCounts_[partition], bufferSize, {}, {});
+      encoded.append(data, bufferSize);
+      payload = encoded;
+    }
+    ioScheduler->acquire(
+        LocalDiskIoScheduler::IoClass::kShuffleWrite, payload.size());
+    file->append(payload);
+    if (fileChecksumEnabled_) {
+      // The checksum covers the bytes as stored, so readers verify before
+      // decompression.
+      const uint32_t checksum = folly::Endian::big(
+          folly::crc32c(
+              reinterpret_cast<const uint8_t*>(payload.data()),
+              payload.size()));
+      file->append(
+          std::string_view(
+              reinterpret_cast<const char*>(&checksum), kChecksumTrailerSize));
+    }
   } else {
     // For sorted shuffle, parse and sort rows, then write
+    ioScheduler->acquire(
+        LocalDiskIoScheduler::IoClass::kShuffleWrite, bufferSize);
     const auto sortedRows =
         extractAndSortRowMetadata(data, bufferSize, sortedShuffle_);
+    if (blockHeaderEnabled_ && !sortedRows.empty()) {
+      // The sorted rows bracket the block's key range: min is the first key
+      // and max the last.
+      const auto& first = sortedRows.front();
+      const auto& last = sortedRows.back();
+      file->append(
+          encodeBlockHeader(
+              sortedRows.size(),
+              bufferSize,
+              {data + first.rowStart + kUint32Size * 2, first.keySize},
+              {data + last.rowStart + kUint32Size * 2, last.keySize}));
+    }
     for (const auto& row : sortedRows) {
       const size_t rowLen = sortedShuffle_
           ? (kUint32Size * 2) + row.keySize + row.dataSize
@@ -324,34 +1119,339 @@ void LocalShuffleWriter::writeBlock(int32_t partition) {
     }
   }
   file->close();
+  if (compactionEnabled() && bufferSize < compactionMinFileBytes_) {
+    maybeScheduleCompaction(partition, filename);
+  }
   inProgressSizes_[partition] = 0;
+  inProgressRowCounts_[partition] = 0;
+  const auto nowMs = velox::getCurrentTimeMs();
+  lastBlockMs_[partition] = nowMs;
+  trimIdlePartitionBuffers(nowMs);
 }
 
-std::unique_ptr<velox::WriteFile> LocalShuffleWriter::getNextOutputFile(
-    int32_t partition) {
-  auto filename = nextAvailablePartitionFileName(rootPath_, partition);
-  return fileSystem_->openFileForWrite(filename);
+void LocalShuffleWriter::growPartitionBuffer(
+    int32_t partition,
+    uint64_t neededBytes) {
+  auto& buffer = inProgressPartitions_[partition];
+  // Double the capacity so a steadily filling partition pays O(log) copies,
+  // but never grow past the per-partition limit unless a single row needs it.
+  const auto newCapacity = std::min(
+      std::max<uint64_t>(buffer->capacity() * 2, neededBytes),
+      std::max(maxBytesPerPartition_, neededBytes));
+  auto newBuffer = velox::AlignedBuffer::allocate<char>(newCapacity, pool_, 0);
+  ::memcpy(
+      newBuffer->asMutable<char>(),
+      buffer->as<char>(),
+      inProgressSizes_[partition]);
+  buffer = std::move(newBuffer);
+}
+
+void LocalShuffleWriter::trimIdlePartitionBuffers(uint64_t nowMs) {
+  if (nowMs - lastIdleTrimMs_ < kPartitionBufferIdleTrimMs) {
+    return;
+  }
+  lastIdleTrimMs_ = nowMs;
+  for (uint32_t i = 0; i < numPartitions_; ++i) {
+    if (inProgressPartitions_[i] != nullptr && inProgressSizes_[i] == 0 &&
+        nowMs - lastBlockMs_[i] >= kPartitionBufferIdleTrimMs) {
+      inProgressPartitions_[i] = nullptr;
+    }
+  }
+}
+
+std::string LocalShuffleWriter::dedupEncodeBlock(
+    const char* data,
+    size_t size) {
+  std::string encoded;
+  // A block of all-new chunks costs one literal record per chunk on top of
+  // the payload; reserve for that worst case.
+  encoded.reserve(
+      sizeof(uint64_t) + size +
+      (size / kMinChunkBytes + 1) * (1 + sizeof(uint32_t)));
+  const auto appendWord = [&encoded](auto word) {
+    const auto value = folly::Endian::big(word);
+    encoded.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  appendWord(static_cast<uint64_t>(size));
+
+  auto* store = LocalShuffleChunkStore::instance();
+  uint64_t savedBytes = 0;
+  size_t start = 0;
+  while (start < size) {
+    const auto end = nextChunkEnd(data, size, start);
+    const std::string_view chunk(data + start, end - start);
+    const auto hash = folly::hash::fnv64_buf(chunk.data(), chunk.size());
+    if (store->put(queryId_, hash, chunk, dedupMaxBytes_)) {
+      encoded.push_back(kReferenceChunkTag);
+      appendWord(hash);
+      savedBytes += chunk.size();
+    } else {
+      encoded.push_back(kLiteralChunkTag);
+      appendWord(static_cast<uint32_t>(chunk.size()));
+      encoded.append(chunk);
+    }
+    start = end;
+  }
+  if (savedBytes > 0) {
+    RECORD_METRIC_VALUE(kCounterLocalShuffleDedupSavedBytes, savedBytes);
+  }
+  return encoded;
+}
+
+std::string LocalShuffleWriter::partitionId(int32_t partition) const {
+  // Matches the partition id portion of createShuffleFileName, which readers
+  // use as the file name prefix after the query id.
+  return fmt::format("shuffle_{}_0_{}", shuffleId_, partition);
+}
+
+bool LocalShuffleWriter::stageBlockInMemory(int32_t partition) {
+  if (memoryTransportMaxBytes_ == 0) {
+    return false;
+  }
+  const auto& buffer = inProgressPartitions_[partition];
+  const auto bufferSize = inProgressSizes_[partition];
+  const char* data = buffer->as<char>();
+
+  // Copy into a right-sized buffer so the large in-progress buffer stays with
+  // the writer for reuse instead of being pinned by the broker.
+  auto* broker = LocalShuffleMemoryBroker::instance();
+  LocalShuffleMemoryBroker::Block block;
+  block.size = bufferSize;
+  block.buffer =
+      velox::AlignedBuffer::allocate<char>(bufferSize, broker->pool(), 0);
+  char* writePos = block.buffer->asMutable<char>();
+  if (!sortedShuffle_) {
+    memcpy(writePos, data, bufferSize);
+  } else {
+    // Stage rows in sorted order so the block layout matches the files.
+    const auto sortedRows =
+        extractAndSortRowMetadata(data, bufferSize, sortedShuffle_);
+    for (const auto& row : sortedRows) {
+      const size_t rowLen = (kUint32Size * 2) + row.keySize + row.dataSize;
+      memcpy(writePos, data + row.rowStart, rowLen);
+      writePos += rowLen;
+    }
+  }
+
+  return broker->put(
+      queryId_, partitionId(partition), block, memoryTransportMaxBytes_);
 }
 
 std::string LocalShuffleWriter::nextAvailablePartitionFileName(
     const std::string& root,
-    int32_t partition) const {
-  int fileCount = 0;
+    int32_t partition) {
+  // Probing starts from the per-partition index maintained in memory, so
+  // names of files deleted by compaction are never reused; reuse would race
+  // with an in-flight merge job deleting the old file of the same name.
+  int fileCount = nextFileIndex_[partition];
   std::string filename;
-  // TODO: consider to maintain the next to create file count in memory as we
-  // always do cleanup when switch to a new root directory path.
   do {
     filename = createShuffleFileName(
-        root, queryId_, shuffleId_, partition, fileCount, threadId_);
+        root,
+        queryId_,
+        shuffleId_,
+        partition,
+        fileCount,
+        threadId_,
+        fileCompressionEnabled_,
+        fileChecksumEnabled_,
+        blockHeaderEnabled_,
+        dedupEnabled());
     if (!fileSystem_->exists(filename)) {
       break;
     }
     ++fileCount;
   } while (true);
+  nextFileIndex_[partition] = fileCount + 1;
 
   return filename;
 }
 
+bool LocalShuffleWriter::compactionEnabled() const {
+  // Dedup-encoded files carry a decoded-size prologue, so like compressed
+  // files they cannot be concatenated by a merge job.
+  return compactionMinFileBytes_ > 0 && compactionExecutor_ != nullptr &&
+      !fileCompressionEnabled_ && !dedupEnabled();
+}
+
+void LocalShuffleWriter::maybeScheduleCompaction(
+    int32_t partition,
+    const std::string& filename) {
+  auto& candidates = compactionCandidates_[partition];
+  candidates.push_back(filename);
+  if (candidates.size() < kCompactionBatchFiles) {
+    return;
+  }
+  std::vector<std::string> files;
+  files.swap(candidates);
+  compactionFutures_.push_back(
+      folly::via(
+          folly::getKeepAliveToken(compactionExecutor_),
+          [this, partition, files = std::move(files)]() mutable {
+            compactFiles(partition, std::move(files));
+          })
+          .semi());
+}
+
+void LocalShuffleWriter::compactFiles(
+    int32_t partition,
+    std::vector<std::string> files) {
+  const auto mergedName = createMergedShuffleFileName(
+      rootPath_,
+      queryId_,
+      shuffleId_,
+      partition,
+      mergedFileSeq_++,
+      threadId_,
+      fileChecksumEnabled_,
+      blockHeaderEnabled_);
+  auto* ioScheduler = LocalDiskIoScheduler::instance();
+  try {
+    auto mergedFile = fileSystem_->openFileForWrite(mergedName);
+    if (!sortedShuffle_) {
+      // Unsorted row streams are self-delimiting, so the merged file is the
+      // plain concatenation of the source payloads. The sources are below the
+      // compaction threshold, so the batch fits in memory and the checksum
+      // trailer can be recomputed over the whole payload like writeBlock
+      // does. Framed blocks keep their headers across the concatenation, so
+      // the merged file stays readable block by block.
+      std::string payload;
+      for (const auto& filename : files) {
+        auto source = fileSystem_->openFileForRead(filename);
+        const auto fileSize = source->size();
+        ioScheduler->acquire(
+            LocalDiskIoScheduler::IoClass::kShuffleRead, fileSize);
+        std::string contents(fileSize, '\0');
+        source->pread(0, fileSize, contents.data());
+        if (fileChecksumEnabled_) {
+          VELOX_CHECK_GE(
+              fileSize,
+              kChecksumTrailerSize,
+              "Shuffle file {} too small to hold its checksum trailer",
+              filename);
+          contents.resize(fileSize - kChecksumTrailerSize);
+        }
+        payload += contents;
+      }
+      ioScheduler->acquire(
+          LocalDiskIoScheduler::IoClass::kShuffleWrite, payload.size());
+      mergedFile->append(payload);
+      if (fileChecksumEnabled_) {
+        const uint32_t checksum = folly::Endian::big(
+            folly::crc32c(
+                reinterpret_cast<const uint8_t*>(payload.data()),
+                payload.size()));
+        mergedFile->append(
+            std::string_view(
+                reinterpret_cast<const char*>(&checksum),
+                kChecksumTrailerSize));
+      }
+    } else {
+      // Each sorted file is a sorted run; stream them through a k-way merge
+      // so the merged file stays a single run and the reader's merge tree
+      // gets shallower. Write throttling also paces the streamed reads since
+      // the two sides move the same bytes.
+      std::vector<std::unique_ptr<velox::MergeStream>> streams;
+      TStreamIdx streamIdx = 0;
+      for (const auto& filename : files) {
+        auto stream = std::make_unique<SortedFileInputStream>(
+            filename,
+            streamIdx,
+            pool_,
+            kDefaultInputStreamBufferSize,
+            isFramedShuffleFileName(filename));
+        if (stream->hasData()) {
+          streams.push_back(std::move(stream));
+          ++streamIdx;
+        }
+      }
+      if (!streams.empty()) {
+        velox::TreeOfLosers<velox::MergeStream, TStreamIdx> merge(
+            std::move(streams));
+        std::string buffer;
+        uint32_t rowCount = 0;
+        std::string minKey;
+        std::string maxKey;
+        while (auto* stream = merge.next()) {
+          auto* reader = velox::checkedPointerCast<SortedShuffleStream>(stream);
+          const auto key = reader->currentKey();
+          const auto data = reader->currentValue();
+          if (blockHeaderEnabled_) {
+            if (rowCount == 0) {
+              minKey = key;
+            }
+            maxKey = key;
+            ++rowCount;
+          }
+          const TRowSize sizes[2] = {
+              folly::Endian::big(static_cast<TRowSize>(key.size())),
+              folly::Endian::big(static_cast<TRowSize>(data.size()))};
+          buffer.append(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+          buffer.append(key);
+          buffer.append(data);
+          // The merged run becomes one framed block, whose header needs the
+          // run's totals; buffer the whole run in that case. The run is
+          // bounded by a batch of files below the compaction threshold, so
+          // the buffer stays small.
+          if (!blockHeaderEnabled_ &&
+              buffer.size() >= kCompactionWriteBufferBytes) {
+            ioScheduler->acquire(
+                LocalDiskIoScheduler::IoClass::kShuffleWrite, buffer.size());
+            mergedFile->append(buffer);
+            buffer.clear();
+          }
+          reader->next();
+        }
+        if (blockHeaderEnabled_ && rowCount > 0) {
+          const auto header =
+              encodeBlockHeader(rowCount, buffer.size(), minKey, maxKey);
+          ioScheduler->acquire(
+              LocalDiskIoScheduler::IoClass::kShuffleWrite, header.size());
+          mergedFile->append(header);
+        }
+        if (!buffer.empty()) {
+          ioScheduler->acquire(
+              LocalDiskIoScheduler::IoClass::kShuffleWrite, buffer.size());
+          mergedFile->append(buffer);
+        }
+      }
+    }
+    mergedFile->close();
+  } catch (const std::exception& e) {
+    // Compaction is best effort while the sources are intact: keep them and
+    // drop the partial merged file.
+    LOG(WARNING) << "Failed to compact " << files.size()
+                 << " shuffle files of partition " << partition << ": "
+                 << e.what();
+    try {
+      if (fileSystem_->exists(mergedName)) {
+        fileSystem_->remove(mergedName);
+      }
+    } catch (const std::exception&) {
+    }
+    return;
+  }
+  // Once the merged file exists the sources must go, or readers would see the
+  // rows twice; a failed delete propagates and fails the shuffle write.
+  for (const auto& file : files) {
+    fileSystem_->remove(file);
+  }
+}
+
+void LocalShuffleWriter::waitForCompactions(bool rethrow) {
+  std::exception_ptr error;
+  for (auto& future : compactionFutures_) {
+    auto result = std::move(future).getTry();
+    if (result.hasException() && error == nullptr) {
+      error = result.exception().to_exception_ptr();
+    }
+  }
+  compactionFutures_.clear();
+  if (rethrow && error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
 size_t LocalShuffleWriter::rowSize(size_t keySize, size_t dataSize) const {
   return sortedShuffle_ ? (kUint32Size * 2) + keySize + dataSize
                         : kUint32Size + dataSize;
@@ -400,23 +1500,40 @@ void LocalShuffleWriter::collect(
   const auto rowSize = this->rowSize(key.size(), data.size());
   auto& buffer = inProgressPartitions_[partition];
   if (buffer == nullptr) {
+    // Start small; most destinations of a wide shuffle never see enough rows
+    // to justify a full-size buffer.
     buffer = velox::AlignedBuffer::allocate<char>(
-        std::max(static_cast<uint64_t>(rowSize), maxBytesPerPartition_),
+        std::max<uint64_t>(
+            rowSize,
+            std::min(kInitialPartitionBufferBytes, maxBytesPerPartition_)),
         pool_,
         0);
     inProgressSizes_[partition] = 0;
+    lastBlockMs_[partition] = velox::getCurrentTimeMs();
   } else if (inProgressSizes_[partition] + rowSize >= buffer->capacity()) {
-    writeBlock(partition);
+    if (buffer->capacity() < maxBytesPerPartition_) {
+      growPartitionBuffer(partition, inProgressSizes_[partition] + rowSize + 1);
+    } else {
+      writeBlock(partition);
+      if (rowSize >= buffer->capacity()) {
+        // A single row larger than the buffer; grow to fit it.
+        growPartitionBuffer(partition, rowSize + 1);
+      }
+    }
   }
   auto* rawBuffer = buffer->asMutable<char>();
   auto* writePos = rawBuffer + inProgressSizes_[partition];
   appendRow(writePos, key, data);
   inProgressSizes_[partition] += rowSize;
+  ++inProgressRowCounts_[partition];
 }
 
 void LocalShuffleWriter::noMoreData(bool success) {
   // Delete all shuffle files on failure.
   if (!success) {
+    // Settle in-flight compactions first so a lagging merge job cannot
+    // recreate files after the cleanup.
+    waitForCompactions(false);
     cleanup();
   }
   for (auto i = 0; i < numPartitions_; ++i) {
@@ -424,6 +1541,7 @@ void LocalShuffleWriter::noMoreData(bool success) {
       writeBlock(i);
     }
   }
+  waitForCompactions(success);
 }
 
 LocalShuffleReader::LocalShuffleReader(
@@ -431,19 +1549,119 @@ LocalShuffleReader::LocalShuffleReader(
     const std::string& queryId,
     std::vector<std::string> partitionIds,
     bool sortedShuffle,
-    velox::memory::MemoryPool* pool)
+    velox::memory::MemoryPool* pool,
+    uint32_t readPrefetchDepth)
     : rootPath_(rootPath),
       queryId_(queryId),
       partitionIds_(std::move(partitionIds)),
       sortedShuffle_(sortedShuffle),
+      readPrefetchDepth_(readPrefetchDepth),
       pool_(pool) {
   fileSystem_ = velox::filesystems::getFileSystem(rootPath_, nullptr);
 }
 
+LocalShuffleReader::~LocalShuffleReader() {
+  // Wait for in-flight prefetch reads that reference 'this'.
+  drainPrefetchedFiles();
+}
+
+void LocalShuffleReader::drainPrefetchedFiles() {
+  for (auto& file : prefetchedFiles_) {
+    std::move(file).getTry();
+  }
+  prefetchedFiles_.clear();
+}
+
+void LocalShuffleReader::setKeyRangeFilter(
+    std::string lowerKey,
+    std::string upperKey) {
+  VELOX_CHECK(
+      !initialized_, "Key range filter must be set before initialize()");
+  VELOX_CHECK(
+      sortedShuffle_, "Key range filter only applies to sorted shuffle");
+  VELOX_CHECK(
+      !compareKeys(upperKey, lowerKey),
+      "Invalid key range filter: upper bound sorts below lower bound");
+  keyRangeFilter_ = std::make_pair(std::move(lowerKey), std::move(upperKey));
+}
+
+bool LocalShuffleReader::framedBlockMayMatchFilter(
+    const std::string& filename) const {
+  if (!isFramedShuffleFileName(filename)) {
+    return true;
+  }
+  auto file = fileSystem_->openFileForRead(filename);
+  const auto fileSize = file->size();
+  if (fileSize < kBlockFixedHeaderSize) {
+    return true;
+  }
+  char fixed[kBlockFixedHeaderSize];
+  file->pread(0, sizeof(fixed), fixed);
+  size_t offset = 0;
+  const auto readWord = [&](auto& word) {
+    std::memcpy(&word, fixed + offset, sizeof(word));
+    word = folly::Endian::big(word);
+    offset += sizeof(word);
+  };
+  uint32_t magic;
+  readWord(magic);
+  if (magic != kBlockMagic) {
+    return true;
+  }
+  uint32_t rowCount;
+  uint64_t payloadBytes;
+  TRowSize minKeySize;
+  TRowSize maxKeySize;
+  readWord(rowCount);
+  readWord(payloadBytes);
+  readWord(minKeySize);
+  readWord(maxKeySize);
+  // Only a file holding exactly one framed block can be skipped whole; the
+  // sorted writer and compaction both produce single-block files.
+  if (kBlockFixedHeaderSize + minKeySize + maxKeySize + payloadBytes !=
+      fileSize) {
+    return true;
+  }
+  std::string keys(minKeySize + static_cast<size_t>(maxKeySize), '\0');
+  if (!keys.empty()) {
+    file->pread(kBlockFixedHeaderSize, keys.size(), keys.data());
+  }
+  const std::string_view minKey(keys.data(), minKeySize);
+  const std::string_view maxKey(keys.data() + minKeySize, maxKeySize);
+  const auto& [lowerKey, upperKey] = *keyRangeFilter_;
+  // No overlap when the block's max key sorts below the lower bound or its
+  // min key above the upper bound.
+  return !(compareKeys(maxKey, lowerKey) || compareKeys(upperKey, minKey));
+}
+
 void LocalShuffleReader::initialize() {
   VELOX_CHECK(!initialized_, "LocalShuffleReader already initialized");
   readPartitionFiles_ = getReadPartitionFiles();
-  if (sortedShuffle_ && !readPartitionFiles_.empty()) {
+  if (sortedShuffle_ && keyRangeFilter_.has_value()) {
+    // Drop framed files whose block key range cannot intersect the filter
+    // before any payload is read or merged.
+    std::vector<std::string> matchingFiles;
+    matchingFiles.reserve(readPartitionFiles_.size());
+    for (auto& filename : readPartitionFiles_) {
+      if (framedBlockMayMatchFilter(filename)) {
+        matchingFiles.push_back(std::move(filename));
+      } else {
+        RECORD_METRIC_VALUE(kCounterLocalShuffleBlocksSkipped);
+      }
+    }
+    readPartitionFiles_ = std::move(matchingFiles);
+  }
+  // Take any blocks a co-located writer staged in memory for our partitions.
+  auto* broker = LocalShuffleMemoryBroker::instance();
+  for (const auto& partitionId : partitionIds_) {
+    auto blocks = broker->take(queryId_, partitionId);
+    memoryBlocks_.insert(
+        memoryBlocks_.end(),
+        std::make_move_iterator(blocks.begin()),
+        std::make_move_iterator(blocks.end()));
+  }
+  if (sortedShuffle_ &&
+      (!readPartitionFiles_.empty() || !memoryBlocks_.empty())) {
     initSortedShuffleRead();
   }
 
@@ -452,16 +1670,37 @@ void LocalShuffleReader::initialize() {
 
 void LocalShuffleReader::initSortedShuffleRead() {
   std::vector<std::unique_ptr<velox::MergeStream>> streams;
-  streams.reserve(readPartitionFiles_.size());
+  streams.reserve(readPartitionFiles_.size() + memoryBlocks_.size());
   TStreamIdx streamIdx = 0;
+  for (auto& block : memoryBlocks_) {
+    auto stream =
+        std::make_unique<SortedBlockInputStream>(std::move(block), streamIdx);
+    if (stream->hasData()) {
+      streams.push_back(std::move(stream));
+      ++streamIdx;
+    }
+  }
+  memoryBlocks_.clear();
   for (const auto& filename : readPartitionFiles_) {
     VELOX_CHECK(
         !filename.empty(),
         "Invalid empty shuffle file path for query {}, partitions: [{}]",
         queryId_,
         folly::join(", ", partitionIds_));
-    auto reader =
-        std::make_unique<SortedFileInputStream>(filename, streamIdx, pool_);
+    const bool framed = isFramedShuffleFileName(filename);
+    std::unique_ptr<SortedShuffleStream> reader;
+    if (readPrefetchDepth_ > 0) {
+      reader = std::make_unique<SortedFilePrefetchStream>(
+          filename,
+          streamIdx,
+          pool_,
+          readPrefetchDepth_,
+          kDefaultInputStreamBufferSize,
+          framed);
+    } else {
+      reader = std::make_unique<SortedFileInputStream>(
+          filename, streamIdx, pool_, kDefaultInputStreamBufferSize, framed);
+    }
     if (reader->hasData()) {
       streams.push_back(std::move(reader));
       ++streamIdx;
@@ -487,7 +1726,7 @@ LocalShuffleReader::nextSorted(uint64_t maxBytes) {
   uint64_t bufferUsed = 0;
 
   while (auto* stream = merge_->next()) {
-    auto* reader = velox::checkedPointerCast<SortedFileInputStream>(stream);
+    auto* reader = velox::checkedPointerCast<SortedShuffleStream>(stream);
     const auto data = reader->currentValue();
 
     if (bufferUsed + data.size() > maxBytes) {
@@ -520,29 +1759,178 @@ LocalShuffleReader::nextSorted(uint64_t maxBytes) {
   return batches;
 }
 
+velox::BufferPtr LocalShuffleReader::readFile(const std::string& filename) {
+  auto file = fileSystem_->openFileForRead(filename);
+  const auto fileSize = file->size();
+  LocalDiskIoScheduler::instance()->acquire(
+      LocalDiskIoScheduler::IoClass::kShuffleRead, fileSize);
+  auto buffer = velox::AlignedBuffer::allocate<char>(fileSize, pool_, 0);
+  file->pread(0, fileSize, buffer->asMutable<void>());
+
+  std::string_view payloadName = filename;
+  if (payloadName.ends_with(kChecksumFileSuffix)) {
+    // The writer appended a CRC32C trailer; verify the stored bytes and drop
+    // the trailer before decoding.
+    VELOX_CHECK_GE(
+        fileSize,
+        kChecksumTrailerSize,
+        "Shuffle file {} too small to hold its checksum trailer",
+        filename);
+    const auto payloadSize = fileSize - kChecksumTrailerSize;
+    const uint32_t expected = folly::Endian::big(
+        *reinterpret_cast<const uint32_t*>(buffer->as<char>() + payloadSize));
+    const uint32_t actual = folly::crc32c(
+        reinterpret_cast<const uint8_t*>(buffer->as<char>()), payloadSize);
+    if (FOLLY_UNLIKELY(actual != expected)) {
+      RECORD_METRIC_VALUE(kCounterLocalShuffleChecksumFailures);
+      VELOX_FAIL(
+          "Corrupt shuffle file {}: CRC32C mismatch, expected {} but computed "
+          "{} over {} bytes",
+          filename,
+          expected,
+          actual,
+          payloadSize);
+    }
+    buffer->setSize(payloadSize);
+    payloadName.remove_suffix(kChecksumFileSuffix.size());
+  }
+  if (payloadName.ends_with(kDedupFileSuffix)) {
+    // The writer dedup-encoded this block; resolve the chunk records through
+    // the store to restore it.
+    return dedupDecodeBuffer(
+        buffer->as<char>(), buffer->size(), queryId_, pool_);
+  }
+  if (!payloadName.ends_with(kCompressedFileSuffix)) {
+    return buffer;
+  }
+  // The writer LZ4-compressed this block; restore it before handing it out.
+  const auto uncompressed = CompressionBackendRegistry::instance()->uncompress(
+      CompressionUse::kSpill,
+      folly::compression::CodecType::LZ4,
+      folly::StringPiece(buffer->as<char>(), buffer->size()));
+  auto uncompressedBuffer =
+      velox::AlignedBuffer::allocate<char>(uncompressed.size(), pool_, 0);
+  memcpy(
+      uncompressedBuffer->asMutable<char>(),
+      uncompressed.data(),
+      uncompressed.size());
+  return uncompressedBuffer;
+}
+
+void LocalShuffleReader::schedulePrefetch() {
+  while (prefetchedFiles_.size() < readPrefetchDepth_ &&
+         prefetchFileIndex_ < readPartitionFiles_.size()) {
+    auto filename = readPartitionFiles_[prefetchFileIndex_];
+    prefetchedFiles_.push_back(folly::via(
+        folly::getKeepAliveToken(folly::getGlobalIOExecutor().get()),
+        [this, filename = std::move(filename)]() { return readFile(filename); }));
+    ++prefetchFileIndex_;
+  }
+}
+
+velox::BufferPtr LocalShuffleReader::nextFileBuffer() {
+  if (readPrefetchDepth_ == 0) {
+    auto buffer = readFile(readPartitionFiles_[readPartitionFileIndex_]);
+    ++readPartitionFileIndex_;
+    return buffer;
+  }
+  schedulePrefetch();
+  auto buffer = std::move(prefetchedFiles_.front()).get();
+  prefetchedFiles_.pop_front();
+  ++readPartitionFileIndex_;
+  schedulePrefetch();
+  return buffer;
+}
+
 std::vector<std::unique_ptr<ShuffleSerializedPage>>
 LocalShuffleReader::nextUnsorted(uint64_t maxBytes) {
   std::vector<std::unique_ptr<ShuffleSerializedPage>> batches;
   uint64_t totalBytes{0};
 
-  while (readPartitionFileIndex_ < readPartitionFiles_.size()) {
-    const auto filename = readPartitionFiles_[readPartitionFileIndex_];
-    auto file = fileSystem_->openFileForRead(filename);
-    const auto fileSize = file->size();
+  // Serve blocks staged in memory by a co-located writer before touching any
+  // files. Row views point straight into the staged buffers.
+  while (memoryBlockIndex_ < memoryBlocks_.size()) {
+    const auto& block = memoryBlocks_[memoryBlockIndex_];
+    if (!batches.empty() && totalBytes + block.size > maxBytes) {
+      return batches;
+    }
 
-    // TODO: Refactor to use streaming I/O with bounded buffer size instead of
-    // loading entire files into memory at once. A streaming approach would
-    // reduce peak memory consumption and enable processing arbitrarily large
-    // shuffle files while maintaining constant memory usage.
-    if (!batches.empty() && totalBytes + fileSize > maxBytes) {
-      break;
+    const char* data = block.buffer->as<char>();
+    const auto parsedRows =
+        extractRowMetadata(data, block.size, sortedShuffle_);
+    std::vector<std::string_view> rows;
+    rows.reserve(parsedRows.size());
+    for (const auto& row : parsedRows) {
+      rows.push_back(extractRowData(row, data, sortedShuffle_));
     }
 
-    auto buffer = velox::AlignedBuffer::allocate<char>(fileSize, pool_, 0);
-    file->pread(0, fileSize, buffer->asMutable<void>());
-    ++readPartitionFileIndex_;
+    totalBytes += block.size;
+    // The buffer is shared with the block so that a retry after failure can
+    // serve it again.
+    batches.push_back(
+        std::make_unique<LocalShuffleSerializedPage>(
+            std::move(rows), block.buffer));
+    ++memoryBlockIndex_;
+  }
 
+  // TODO: Refactor to use streaming I/O with bounded buffer size instead of
+  // loading entire files into memory at once. A streaming approach would
+  // reduce peak memory consumption and enable processing arbitrarily large
+  // shuffle files while maintaining constant memory usage.
+  while (readPartitionFileIndex_ < readPartitionFiles_.size() ||
+         pendingFileBuffer_ != nullptr) {
+    auto buffer = std::move(pendingFileBuffer_);
+    if (buffer == nullptr) {
+      pendingFileFramed_ = isFramedShuffleFileName(
+          readPartitionFiles_[readPartitionFileIndex_]);
+      pendingBufferOffset_ = 0;
+      buffer = nextFileBuffer();
+    }
+    const auto fileSize = buffer->size();
     const char* data = buffer->as<char>();
+
+    if (pendingFileFramed_) {
+      // Serve the file's framed blocks individually, so large merged files
+      // respect the caller's byte limit and a deferral resumes mid-file.
+      bool deferred = false;
+      while (pendingBufferOffset_ < fileSize) {
+        size_t offset = pendingBufferOffset_;
+        const auto header = decodeBlockHeader(data, fileSize, offset);
+        if (!batches.empty() && totalBytes + header.payloadBytes > maxBytes) {
+          pendingFileBuffer_ = std::move(buffer);
+          deferred = true;
+          break;
+        }
+        const auto parsedRows = extractRowMetadata(
+            data + offset, header.payloadBytes, sortedShuffle_);
+        VELOX_CHECK_EQ(
+            parsedRows.size(),
+            header.rowCount,
+            "Corrupted framed shuffle data: block row count mismatch");
+        std::vector<std::string_view> rows;
+        rows.reserve(parsedRows.size());
+        for (const auto& row : parsedRows) {
+          rows.push_back(extractRowData(row, data + offset, sortedShuffle_));
+        }
+        totalBytes += header.payloadBytes;
+        // Pages of the same file share its buffer.
+        batches.push_back(
+            std::make_unique<LocalShuffleSerializedPage>(
+                std::move(rows), buffer, header.payloadBytes));
+        pendingBufferOffset_ = offset + header.payloadBytes;
+      }
+      if (deferred) {
+        break;
+      }
+      continue;
+    }
+
+    if (!batches.empty() && totalBytes + fileSize > maxBytes) {
+      // Defer the already-read file contents to the next call.
+      pendingFileBuffer_ = std::move(buffer);
+      break;
+    }
+
     const auto parsedRows = extractRowMetadata(data, fileSize, sortedShuffle_);
     std::vector<std::string_view> rows;
     rows.reserve(parsedRows.size());
@@ -572,8 +1960,14 @@ LocalShuffleReader::next(uint64_t maxBytes) {
 }
 
 void LocalShuffleReader::noMoreData(bool success) {
-  // On failure, reset the index of the files to be read.
+  // On failure, reset the index of the blocks and files to be read.
   if (!success) {
+    memoryBlockIndex_ = 0;
+    drainPrefetchedFiles();
+    pendingFileBuffer_ = nullptr;
+    pendingFileFramed_ = false;
+    pendingBufferOffset_ = 0;
+    prefetchFileIndex_ = 0;
     readPartitionFileIndex_ = 0;
   }
 }
@@ -602,6 +1996,8 @@ std::vector<std::string> LocalShuffleReader::getReadPartitionFiles() const {
 }
 
 void LocalShuffleWriter::cleanup() {
+  LocalShuffleMemoryBroker::instance()->drop(queryId_);
+  LocalShuffleChunkStore::instance()->drop(queryId_);
   auto files = fileSystem_->list(rootPath_);
   for (auto& file : files) {
     fileSystem_->remove(file);
@@ -615,21 +2011,46 @@ std::shared_ptr<ShuffleReader> LocalPersistentShuffleFactory::createReader(
   const operators::LocalShuffleReadInfo readInfo =
       operators::LocalShuffleReadInfo::deserialize(serializedStr);
 
+  static const uint32_t readPrefetchDepth =
+      SystemConfig::instance()->localShuffleReadPrefetchDepth();
   auto reader = std::make_shared<LocalShuffleReader>(
       readInfo.rootPath,
       readInfo.queryId,
       readInfo.partitionIds,
       readInfo.sortedShuffle,
-      pool);
+      pool,
+      readPrefetchDepth);
   reader->initialize();
   return reader;
 }
 
+// static
+std::atomic<folly::Executor*>
+    LocalPersistentShuffleFactory::compactionExecutor_{nullptr};
+
+// static
+void LocalPersistentShuffleFactory::setCompactionExecutor(
+    folly::Executor* executor) {
+  compactionExecutor_ = executor;
+}
+
 std::shared_ptr<ShuffleWriter> LocalPersistentShuffleFactory::createWriter(
     const std::string& serializedStr,
     velox::memory::MemoryPool* pool) {
   static const uint64_t maxBytesPerPartition =
       SystemConfig::instance()->localShuffleMaxPartitionBytes();
+  static const uint64_t memoryTransportMaxBytes =
+      SystemConfig::instance()->localShuffleMemoryTransportMaxBytes();
+  static const bool fileCompressionEnabled =
+      SystemConfig::instance()->localShuffleFileCompressionEnabled();
+  static const bool fileChecksumEnabled =
+      SystemConfig::instance()->localShuffleFileChecksumEnabled();
+  static const uint64_t compactionMinFileBytes =
+      SystemConfig::instance()->localShuffleCompactionMinFileBytes();
+  static const bool blockHeaderEnabled =
+      SystemConfig::instance()->localShuffleBlockHeaderEnabled();
+  static const uint64_t dedupMaxBytes =
+      SystemConfig::instance()->localShuffleDedupMaxBytes();
   const operators::LocalShuffleWriteInfo writeInfo =
       operators::LocalShuffleWriteInfo::deserialize(serializedStr);
 
@@ -640,6 +2061,13 @@ std::shared_ptr<ShuffleWriter> LocalPersistentShuffleFactory::createWriter(
       writeInfo.numPartitions,
       maxBytesPerPartition,
       writeInfo.sortedShuffle,
-      pool);
+      pool,
+      memoryTransportMaxBytes,
+      fileCompressionEnabled,
+      fileChecksumEnabled,
+      compactionMinFileBytes,
+      compactionExecutor_.load(),
+      blockHeaderEnabled,
+      dedupMaxBytes);
 }
 } // namespace facebook::presto::operators
@@ -13,11 +13,19 @@
  */
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include <folly/futures/Future.h>
+#include <folly/lang/Bits.h>
+
 #include "velox/common/base/TreeOfLosers.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/Operator.h"
@@ -35,6 +43,9 @@ struct RowMetadata {
   size_t rowStart; // Offset to the start of this row
   uint32_t keySize; // Size of key (0 for non-sorted)
   uint32_t dataSize; // Size of data
+  // First 8 bytes of the key as a big-endian word (0 for non-sorted). Sort
+  // comparisons resolve on this single word unless two keys share the prefix.
+  uint64_t keyPrefix{0};
 };
 
 inline bool compareKeys(std::string_view key1, std::string_view key2) noexcept {
@@ -48,6 +59,20 @@ inline bool compareKeys(std::string_view key1, std::string_view key2) noexcept {
   return key1.size() < key2.size();
 }
 
+/// Loads the first 8 bytes of a binary-sortable key as a big-endian word so
+/// that integer comparison matches memcmp order. Keys shorter than 8 bytes
+/// are zero-padded; since zero is the minimum byte value this can only
+/// produce ties, never an inverted order, and ties fall back to the full
+/// compareKeys().
+inline uint64_t loadKeyPrefix(std::string_view key) noexcept {
+  if (key.empty()) {
+    return 0;
+  }
+  uint64_t prefix = 0;
+  std::memcpy(&prefix, key.data(), std::min(key.size(), sizeof(uint64_t)));
+  return folly::Endian::big(prefix);
+}
+
 // LocalShuffleWriteInfo is used for containing shuffle write information.
 // This struct is a 1:1 strict API mapping to
 // presto-spark-base/src/main/java/com/facebook/presto/spark/execution/PrestoSparkLocalShuffleWriteInfo.java
@@ -86,6 +111,110 @@ struct LocalShuffleReadInfo {
   static LocalShuffleReadInfo deserialize(const std::string& info);
 };
 
+/// Process-wide registry of completed shuffle blocks exchanged directly
+/// between co-located writer and reader tasks. Blocks are keyed by query id
+/// and the same partition id string that appears in the shuffle file names, so
+/// readers discover in-memory blocks the same way they discover files. A
+/// writer stages a block only while the registry stays under the byte budget
+/// configured via 'shuffle.local.memory-transport-max-bytes'; blocks over
+/// budget are written to the regular shuffle files and read back from disk.
+class LocalShuffleMemoryBroker {
+ public:
+  /// A completed block of serialized shuffle rows. For sorted shuffle the
+  /// rows in 'buffer' are already sorted by key, matching the on-file layout.
+  struct Block {
+    velox::BufferPtr buffer;
+    size_t size;
+  };
+
+  static LocalShuffleMemoryBroker* instance();
+
+  /// Attempts to stage 'block' for the given partition of 'queryId'. Returns
+  /// false without consuming 'block' when staging it would exceed 'maxBytes',
+  /// in which case the caller must write the block to a shuffle file.
+  bool put(
+      const std::string& queryId,
+      const std::string& partitionId,
+      Block& block,
+      uint64_t maxBytes);
+
+  /// Returns and removes all blocks staged for the given partition of
+  /// 'queryId', in the order they were staged.
+  std::vector<Block> take(
+      const std::string& queryId,
+      const std::string& partitionId);
+
+  /// Drops all blocks staged for 'queryId'. Called when a write fails.
+  void drop(const std::string& queryId);
+
+  /// Returns the number of bytes currently staged across all queries.
+  uint64_t stagedBytes() const;
+
+  /// Pool that staged blocks are allocated from. Owned by the broker so
+  /// blocks can outlive the writer task's memory pool.
+  velox::memory::MemoryPool* pool() const;
+
+ private:
+  LocalShuffleMemoryBroker();
+
+  const std::shared_ptr<velox::memory::MemoryPool> pool_;
+  mutable std::mutex mutex_;
+  uint64_t stagedBytes_{0};
+  folly::F14FastMap<std::string, std::vector<Block>> blocks_;
+};
+
+/// Process-wide store of content-defined shuffle block chunks, keyed by query
+/// id and chunk hash. A writer that finds a chunk's bytes already stored for
+/// its query writes an 8-byte reference record to the shuffle file instead of
+/// the payload; readers resolve references back to the stored bytes. Like the
+/// memory broker, this only works when writer and reader tasks share the
+/// process, and it is gated by the same kind of byte budget: chunks that do
+/// not fit are written inline, so decoding never depends on eviction. Entries
+/// are reference counted per stored record and dropped wholesale when a
+/// query's shuffle write fails and its files are deleted.
+class LocalShuffleChunkStore {
+ public:
+  static LocalShuffleChunkStore* instance();
+
+  /// Attempts to store 'data' under ('queryId', 'hash'), or to take another
+  /// reference when the same bytes are already stored. Returns true when the
+  /// caller may write a reference record for the chunk; false when the store
+  /// is over 'maxBytes' or, on a hash collision, the stored bytes differ, in
+  /// which case the chunk must be written inline.
+  bool put(
+      const std::string& queryId,
+      uint64_t hash,
+      std::string_view data,
+      uint64_t maxBytes);
+
+  /// Returns the bytes stored under ('queryId', 'hash'), or nullptr if
+  /// absent. Reference records are only written after a successful put(), so
+  /// a miss means corrupt shuffle data.
+  std::shared_ptr<const std::string> get(
+      const std::string& queryId,
+      uint64_t hash) const;
+
+  /// Drops all chunks stored for 'queryId'. Called when a write fails and the
+  /// query's shuffle files, and with them every reference, are deleted.
+  void drop(const std::string& queryId);
+
+  /// Returns the number of chunk payload bytes currently stored.
+  uint64_t storedBytes() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const std::string> data;
+    uint64_t refs{0};
+  };
+
+  static std::string
+  chunkKey(const std::string& queryId, uint64_t hash);
+
+  mutable std::mutex mutex_;
+  uint64_t storedBytes_{0};
+  folly::F14FastMap<std::string, Entry> chunks_;
+};
+
 /// This class is a persistent shuffle server that implements
 /// ShuffleInterface for read and write and also uses generalized Velox
 /// file system to maintain its state and data.
@@ -103,6 +232,29 @@ struct LocalShuffleReadInfo {
 /// this class (pointing to the same root path) to read and write shuffle data.
 class LocalShuffleWriter : public ShuffleWriter {
  public:
+  /// 'fileCompressionEnabled' LZ4-compresses each block before it is written
+  /// to a shuffle file; readers detect the format from the file name, so no
+  /// shuffle info changes are required. Ignored for sorted shuffle, whose
+  /// files are streamed row by row by the merge reader.
+  /// 'fileChecksumEnabled' appends a CRC32C checksum of the stored bytes to
+  /// each shuffle file; readers detect it from the file name and verify the
+  /// contents before decoding. Ignored for sorted shuffle, like compression.
+  /// 'compactionMinFileBytes' turns on background compaction: once a
+  /// partition accumulates a batch of files smaller than this threshold, a
+  /// job on 'compactionExecutor' merges them into one sequential file and
+  /// deletes the sources, so readers open a few large files instead of many
+  /// small ones. Zero, or a null executor, disables compaction.
+  /// 'blockHeaderEnabled' frames every block stored in a shuffle file with a
+  /// self-describing header (row count, payload bytes, min/max sort key for
+  /// sorted shuffle); readers detect framing from the file name. Ignored when
+  /// file compression is on, since whole-file compression hides the block
+  /// boundaries.
+  /// 'dedupMaxBytes' turns on block-level dedup: blocks are split into
+  /// content-defined chunks and chunks whose bytes the LocalShuffleChunkStore
+  /// already holds for this query are written as references instead of
+  /// payload, capped at this store budget. Ignored for sorted shuffle and
+  /// when file compression is on, whose bytes do not repeat; framing is
+  /// dropped when dedup is on since the chunk records frame the file instead.
   LocalShuffleWriter(
       const std::string& rootPath,
       const std::string& queryId,
@@ -110,7 +262,14 @@ class LocalShuffleWriter : public ShuffleWriter {
       uint32_t numPartitions,
       uint64_t maxBytesPerPartition,
       bool sortedShuffle,
-      velox::memory::MemoryPool* pool);
+      velox::memory::MemoryPool* pool,
+      uint64_t memoryTransportMaxBytes = 0,
+      bool fileCompressionEnabled = false,
+      bool fileChecksumEnabled = false,
+      uint64_t compactionMinFileBytes = 0,
+      folly::Executor* compactionExecutor = nullptr,
+      bool blockHeaderEnabled = false,
+      uint64_t dedupMaxBytes = 0);
 
   void collect(int32_t partition, std::string_view key, std::string_view data)
       override;
@@ -127,46 +286,154 @@ class LocalShuffleWriter : public ShuffleWriter {
 
   size_t rowSize(size_t keySize, size_t dataSize) const;
 
-  // Finds and creates the next file for writing the next block of the
-  // given 'partition'.
-  std::unique_ptr<velox::WriteFile> getNextOutputFile(int32_t partition);
-
   // Writes the in-progress block to the given partition.
   void writeBlock(int32_t partition);
 
+  // Replaces the partition's in-progress buffer with one of at least
+  // 'neededBytes' capacity, doubling from the current capacity and capped at
+  // the per-partition byte limit, and copies the pending bytes over.
+  void growPartitionBuffer(int32_t partition, uint64_t neededBytes);
+
+  // Releases the buffers of partitions that have been idle since their last
+  // flush, so a wide shuffle whose destinations go quiet gives the memory
+  // back. Runs at most once per trim interval.
+  void trimIdlePartitionBuffers(uint64_t nowMs);
+
+  // Encodes a block as chunk records: content-defined chunks the store
+  // accepted become 8-byte references, the rest are stored inline.
+  std::string dedupEncodeBlock(const char* data, size_t size);
+
+  // True when unsorted shuffle file blocks are dedup-encoded on write.
+  bool dedupEnabled() const {
+    return dedupMaxBytes_ > 0 && !sortedShuffle_ && !fileCompressionEnabled_;
+  }
+
+  // True when shuffle files below the compaction threshold are merged in the
+  // background. Compressed files are one LZ4 frame each and cannot be
+  // concatenated without re-encoding, so compression turns compaction off.
+  bool compactionEnabled() const;
+
+  // Records 'filename' as a compaction candidate for 'partition' and, once a
+  // full batch of small files has accumulated, hands the batch to a merge job
+  // on 'compactionExecutor_'.
+  void maybeScheduleCompaction(int32_t partition, const std::string& filename);
+
+  // Merges 'files' of 'partition' into one sequential shuffle file and
+  // deletes the sources. Unsorted files are concatenated since their row
+  // streams are self-delimiting; sorted runs go through a streaming k-way
+  // merge so the output stays a single sorted run. Runs on
+  // 'compactionExecutor_' while the writer keeps producing; readers only list
+  // files after noMoreData() has settled all jobs, so they never observe the
+  // intermediate state.
+  void compactFiles(int32_t partition, std::vector<std::string> files);
+
+  // Blocks until all scheduled compaction jobs have finished. When 'rethrow'
+  // is true the first job failure is rethrown, since a job that could not
+  // delete its source files would otherwise leave duplicate rows on disk.
+  void waitForCompactions(bool rethrow);
+
+  // Attempts to hand the in-progress block of 'partition' to the in-memory
+  // broker. Returns false when the transport is disabled or over budget, in
+  // which case the block must be written to a file.
+  bool stageBlockInMemory(int32_t partition);
+
+  // Partition id string for 'partition' as used in shuffle file names and as
+  // the in-memory broker key.
+  std::string partitionId(int32_t partition) const;
+
   // Deletes all the files in the root directory.
   void cleanup();
 
   // find next available partition file name to store shuffle data
   std::string nextAvailablePartitionFileName(
       const std::string& root,
-      int32_t partition) const;
+      int32_t partition);
 
   // Used to make sure files created by this thread have unique names.
   const std::thread::id threadId_;
   velox::memory::MemoryPool* pool_;
   const uint32_t numPartitions_;
   const uint64_t maxBytesPerPartition_;
+  // Byte budget for the in-memory block transport; 0 disables it.
+  const uint64_t memoryTransportMaxBytes_;
   const bool sortedShuffle_;
+  // True when unsorted shuffle file blocks are LZ4-compressed on write.
+  const bool fileCompressionEnabled_;
+  // True when unsorted shuffle files get a CRC32C trailer on write.
+  const bool fileChecksumEnabled_;
+  // Files smaller than this are compaction candidates; 0 disables compaction.
+  const uint64_t compactionMinFileBytes_;
+  // True when every block stored in a shuffle file is preceded by a
+  // self-describing header.
+  const bool blockHeaderEnabled_;
+  // Byte budget for the chunk store dedup of unsorted shuffle file blocks;
+  // 0 disables dedup.
+  const uint64_t dedupMaxBytes_;
+  // Executor the background merge jobs run on; typically the spiller
+  // executor, which is otherwise idle while shuffle data is being produced.
+  folly::Executor* const compactionExecutor_;
   // The top directory of the shuffle files and its file system.
   const std::string rootPath_;
   const std::string queryId_;
   const uint32_t shuffleId_;
 
-  /// The latest written block buffers and sizes.
+  /// The latest written block buffers and sizes. Buffers start small and
+  /// grow geometrically up to 'maxBytesPerPartition_', so a wide shuffle
+  /// only pays full-size buffers for the destinations that actually fill
+  /// them; they are reused across blocks and trimmed once idle.
   std::vector<velox::BufferPtr> inProgressPartitions_;
   std::vector<size_t> inProgressSizes_;
+  // When each partition's buffer was last allocated or flushed; empty
+  // buffers older than the trim interval are released.
+  std::vector<uint64_t> lastBlockMs_;
+  // Last time idle partition buffers were swept.
+  uint64_t lastIdleTrimMs_{0};
+  // Rows collected into the in-progress block per partition, recorded in the
+  // block headers.
+  std::vector<uint32_t> inProgressRowCounts_;
   std::shared_ptr<velox::filesystems::FileSystem> fileSystem_;
+
+  // Next file index to probe per partition. Monotonic so names of compacted
+  // (deleted) files are never reused, which would race with an in-flight
+  // merge job deleting the old file of the same name.
+  std::vector<int> nextFileIndex_;
+
+  // Small files written per partition that have not been batched into a
+  // compaction job yet. Accessed from the writer thread only.
+  std::vector<std::vector<std::string>> compactionCandidates_;
+
+  // Outstanding compaction jobs; settled in noMoreData().
+  std::vector<folly::SemiFuture<folly::Unit>> compactionFutures_;
+
+  // Sequence number for merged file names, shared with the merge jobs.
+  std::atomic_uint32_t mergedFileSeq_{0};
 };
 
 class LocalShuffleReader : public ShuffleReader {
  public:
+  /// 'readPrefetchDepth' is the maximum number of shuffle files loaded ahead
+  /// of the consumer on the IO executor so file reads overlap with compute;
+  /// 0 reads synchronously on the caller thread. For sorted shuffle it is
+  /// instead the maximum number of chunk reads each merged file stream keeps
+  /// in flight ahead of the k-way merge.
   LocalShuffleReader(
       const std::string& rootPath,
       const std::string& queryId,
       std::vector<std::string> partitionIds,
       bool sortedShuffle,
-      velox::memory::MemoryPool* pool);
+      velox::memory::MemoryPool* pool,
+      uint32_t readPrefetchDepth = 0);
+
+  ~LocalShuffleReader() override;
+
+  /// Restricts a sorted shuffle read to rows whose binary-sortable partition
+  /// sort key falls in ['lowerKey', 'upperKey'] (inclusive). Framed shuffle
+  /// files whose block header min/max key range cannot intersect the filter
+  /// are skipped without reading their payload; the filter is advisory at
+  /// block granularity, so rows outside the range in overlapping blocks are
+  /// still returned. Must be called before initialize(). Ignored for unsorted
+  /// shuffle and for unframed files.
+  void setKeyRangeFilter(std::string lowerKey, std::string upperKey);
 
   /// Initializes the reader by discovering shuffle files and setting up merge
   /// infrastructure for sorted shuffle. Must be called before next().
@@ -187,6 +454,26 @@ class LocalShuffleReader : public ShuffleReader {
   // Returns all created shuffle files for 'partition_'.
   std::vector<std::string> getReadPartitionFiles() const;
 
+  // Reads the whole shuffle file at 'filename' into a new buffer. Called on
+  // the caller thread or, when prefetching, on the IO executor.
+  velox::BufferPtr readFile(const std::string& filename);
+
+  // Schedules file reads on the IO executor until 'prefetchedFiles_' holds
+  // 'readPrefetchDepth_' outstanding reads or all files are scheduled.
+  void schedulePrefetch();
+
+  // Returns the contents of the next unread shuffle file, from the prefetch
+  // queue when prefetching is enabled. Advances 'readPartitionFileIndex_'.
+  velox::BufferPtr nextFileBuffer();
+
+  // Waits for outstanding prefetched reads and discards their results.
+  void drainPrefetchedFiles();
+
+  // Returns false when 'filename' is a single framed block whose header
+  // min/max key range cannot intersect 'keyRangeFilter_'; only the header is
+  // read off disk to decide. Returns true for unframed or multi-block files.
+  bool framedBlockMayMatchFilter(const std::string& filename) const;
+
   // Initializes sorted shuffle read by creating input streams and setting up
   // k-way merge infrastructure.
   void initSortedShuffleRead();
@@ -203,6 +490,9 @@ class LocalShuffleReader : public ShuffleReader {
   const std::string queryId_;
   const std::vector<std::string> partitionIds_;
   const bool sortedShuffle_;
+  // Maximum number of shuffle files (unsorted) or per-stream chunks (sorted)
+  // read ahead of the consumer; 0 disables prefetching.
+  const uint32_t readPrefetchDepth_;
   velox::memory::MemoryPool* pool_;
 
   // Latest read block (file) index in 'readPartitionFiles_' for 'partition_'.
@@ -211,6 +501,34 @@ class LocalShuffleReader : public ShuffleReader {
   // List of generated files for 'partition_'.
   std::vector<std::string> readPartitionFiles_;
 
+  // Blocks taken from the in-memory broker for 'partitionIds_'. Served before
+  // any shuffle files for unsorted shuffle; merged with the file streams for
+  // sorted shuffle.
+  std::vector<LocalShuffleMemoryBroker::Block> memoryBlocks_;
+
+  // Next block to serve from 'memoryBlocks_' for unsorted shuffle.
+  size_t memoryBlockIndex_{0};
+
+  // Outstanding prefetched file reads, in file order.
+  std::deque<folly::Future<velox::BufferPtr>> prefetchedFiles_;
+
+  // Next file in 'readPartitionFiles_' to schedule for prefetch.
+  size_t prefetchFileIndex_{0};
+
+  // File contents read but deferred to the next call because serving them
+  // would exceed the caller's byte limit.
+  velox::BufferPtr pendingFileBuffer_;
+
+  // True when 'pendingFileBuffer_' holds framed blocks, and the offset of the
+  // next unserved block in it. Framed files are served block by block, so a
+  // deferral resumes mid-file.
+  bool pendingFileFramed_{false};
+  size_t pendingBufferOffset_{0};
+
+  // Inclusive sort key range sorted reads are restricted to; see
+  // setKeyRangeFilter().
+  std::optional<std::pair<std::string, std::string>> keyRangeFilter_;
+
   // The top directory of the shuffle files and its file system.
   std::shared_ptr<velox::filesystems::FileSystem> fileSystem_;
 
@@ -223,6 +541,13 @@ class LocalShuffleReader : public ShuffleReader {
 class LocalPersistentShuffleFactory : public ShuffleInterfaceFactory {
  public:
   static constexpr folly::StringPiece kShuffleName{"local"};
+
+  /// Sets the executor shuffle writers use for background file compaction.
+  /// Called once at server startup after the thread pools exist; the factory
+  /// is registered earlier, so the executor cannot be a constructor argument.
+  /// Writers created while unset simply do not compact.
+  static void setCompactionExecutor(folly::Executor* executor);
+
   std::shared_ptr<ShuffleReader> createReader(
       const std::string& serializedStr,
       const int32_t partition,
@@ -231,6 +556,9 @@ class LocalPersistentShuffleFactory : public ShuffleInterfaceFactory {
   std::shared_ptr<ShuffleWriter> createWriter(
       const std::string& serializedStr,
       velox::memory::MemoryPool* pool) override;
+
+ private:
+  static std::atomic<folly::Executor*> compactionExecutor_;
 };
 
 } // namespace facebook::presto::operators
@@ -12,8 +12,10 @@
  * limitations under the License.
  */
 #include "presto_cpp/main/operators/PartitionAndSerialize.h"
+#include <folly/hash/Hash.h>
 #include <folly/lang/Bits.h>
 #include "presto_cpp/main/operators/BinarySortableSerializer.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/row/CompactRow.h"
 
@@ -53,6 +55,97 @@ velox::core::PlanNodeId deserializePlanNodeId(const folly::dynamic& obj) {
   return obj["id"].asString();
 }
 
+// Hash of a null partition key. Any fixed value works as long as all workers
+// use the same one.
+constexpr uint64_t kNullKeyHash = 0;
+
+// Reduces a 64-bit hash to [0, 'numPartitions') by taking the high 64 bits of
+// the 128-bit product. This replaces the modulo of the generic path with a
+// multiply and a shift and consumes the hash's high bits, which are better
+// mixed than the low ones.
+inline uint32_t reduceToPartition(uint64_t hash, uint32_t numPartitions) {
+  return static_cast<uint32_t>(
+      (static_cast<unsigned __int128>(hash) * numPartitions) >> 64);
+}
+
+template <TypeKind Kind>
+inline uint64_t hashPartitionKey(
+    const typename TypeTraits<Kind>::NativeType& value) {
+  if constexpr (Kind == TypeKind::VARCHAR) {
+    return folly::hash::fnv64_buf(value.data(), value.size());
+  } else {
+    static_assert(Kind == TypeKind::BIGINT);
+    return folly::hasher<int64_t>()(value);
+  }
+}
+
+// Hashes one partition key column into 'hashes', initializing the entries for
+// the first key ('kMix' false) or mixing into them for the second. Specialized
+// per key kind so the flat no-null case compiles to a tight loop over the raw
+// value buffer.
+template <TypeKind Kind, bool kMix>
+void hashKeyColumn(
+    const DecodedVector& decoded,
+    vector_size_t size,
+    uint64_t* hashes) {
+  using T = typename TypeTraits<Kind>::NativeType;
+
+  auto update = [&](vector_size_t row, uint64_t hash) {
+    if constexpr (kMix) {
+      hashes[row] = folly::hash::hash_128_to_64(hashes[row], hash);
+    } else {
+      hashes[row] = hash;
+    }
+  };
+
+  if (!decoded.mayHaveNulls() && decoded.isIdentityMapping()) {
+    const auto* values = decoded.data<T>();
+    for (vector_size_t row = 0; row < size; ++row) {
+      update(row, hashPartitionKey<Kind>(values[row]));
+    }
+    return;
+  }
+
+  for (vector_size_t row = 0; row < size; ++row) {
+    const uint64_t hash = decoded.isNullAt(row)
+        ? kNullKeyHash
+        : hashPartitionKey<Kind>(decoded.valueAt<T>(row));
+    update(row, hash);
+  }
+}
+
+// Returns true if partition computation can use the specialized hash kernels:
+// hash partitioning (HashPartitionFunctionSpec) on one or two non-constant
+// BIGINT or VARCHAR keys. The decision depends only on the plan, never on
+// runtime encodings, so every task of co-partitioned stages picks the same
+// kernel and the row-to-partition mapping stays consistent across the
+// exchange.
+bool useSpecializedPartitionKernel(
+    const PartitionAndSerializeNode& node,
+    const std::vector<column_index_t>& keyChannels) {
+  if (node.numPartitions() <= 1) {
+    return false;
+  }
+  if (!std::dynamic_pointer_cast<const exec::HashPartitionFunctionSpec>(
+          node.partitionFunctionFactory())) {
+    return false;
+  }
+  if (keyChannels.empty() || keyChannels.size() > 2) {
+    return false;
+  }
+  const auto& inputType = node.sources()[0]->outputType();
+  for (auto channel : keyChannels) {
+    if (channel == kConstantChannel) {
+      return false;
+    }
+    const auto kind = inputType->childAt(channel)->kind();
+    if (kind != TypeKind::BIGINT && kind != TypeKind::VARCHAR) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // The output of this operator has 3 columns:
 // (1) partition number (INTEGER);
 // (2) serialized key (VARBINARY)
@@ -83,7 +176,10 @@ class PartitionAndSerializeOperator : public Operator {
         replicateNullsAndAny_(planNode->isReplicateNullsAndAny()),
         sortingOrders_(planNode->sortingOrders()),
         sortingKeys_(planNode->sortingKeys()),
-        sorted_(sortingOrders_ && sortingKeys_) {
+        sorted_(sortingOrders_ && sortingKeys_),
+        useSpecializedPartitionKernel_(
+            useSpecializedPartitionKernel(*planNode, keyChannels_)),
+        partitionClusteredOutput_(planNode->isPartitionClusteredOutput()) {
     // Ensure that sortingOrders and sortingKeys cannot be set without each
     // other.
     VELOX_CHECK(
@@ -101,6 +197,12 @@ class PartitionAndSerializeOperator : public Operator {
     if (identityMapping) {
       serializedColumnIndices_.clear();
     }
+    if (useSpecializedPartitionKernel_) {
+      const auto& keyInputType = planNode->sources()[0]->outputType();
+      for (auto channel : keyChannels_) {
+        partitionKeyKinds_.push_back(keyInputType->childAt(channel)->kind());
+      }
+    }
   }
 
   bool needsInput() const override {
@@ -130,6 +232,10 @@ class PartitionAndSerializeOperator : public Operator {
       auto* replicateVector = output_->childAt(1)->asFlatVector<bool>();
       populateReplicateFlags(*replicateVector);
     }
+    if (partitionClusteredOutput_) {
+      buildPartitionOrder();
+      clusterOutputByPartition(*partitionVector);
+    }
   }
 
   RowVectorPtr getOutput() override {
@@ -143,24 +249,35 @@ class PartitionAndSerializeOperator : public Operator {
     VELOX_CHECK_LT(nextOutputRow_, endOutputRow);
 
     const auto batchSize = endOutputRow - nextOutputRow_;
-    auto dataVector = BaseVector::create<FlatVector<StringView>>(
-        VARBINARY(), batchSize, pool());
+    // Recycle the serialization vectors and their backing string buffers once
+    // the downstream shuffle write operator has released the previous batch,
+    // instead of allocating fresh buffers for every batch.
+    auto* dataVector = prepareSerializationVector(dataVector_, batchSize);
     serializeRows(
         nextOutputRow_, endOutputRow, valueOutputBufferSize, *dataVector);
 
     // keyVector is initiallized to be an empty vector.
     // If sorted_ is true, write serialized keys into keyVector.
-    auto keyVector = BaseVector::create<FlatVector<StringView>>(
-        VARBINARY(), batchSize, pool());
+    auto* keyVector = prepareSerializationVector(keyVector_, batchSize);
     serializeKeys(
         nextOutputRow_, endOutputRow, keyOutputBufferSize, *keyVector);
 
+    {
+      auto lockedStats = stats_.wlock();
+      lockedStats->addRuntimeStat(
+          "serializationBufferBytes",
+          RuntimeCounter(
+              retainedStringBufferBytes(*dataVector) +
+                  retainedStringBufferBytes(*keyVector),
+              RuntimeCounter::Unit::kBytes));
+    }
+
     // Extract slice from output_ and construct the output vector.
     std::vector<VectorPtr> childrenVectors;
     childrenVectors.push_back(
         output_->childAt(0)->slice(nextOutputRow_, batchSize));
-    childrenVectors.push_back(keyVector);
-    childrenVectors.push_back(dataVector);
+    childrenVectors.push_back(keyVector_);
+    childrenVectors.push_back(dataVector_);
     RowVectorPtr outputBatch;
     // Handle replicateVector based on 'replicateNullsAndAny_' as it
     // is optional.
@@ -198,6 +315,32 @@ class PartitionAndSerializeOperator : public Operator {
   }
 
  private:
+  // Returns 'holder' resized for 'size' rows, reusing its memory when no one
+  // else references it, or a freshly created VARBINARY vector otherwise.
+  FlatVector<StringView>* prepareSerializationVector(
+      VectorPtr& holder,
+      vector_size_t size) {
+    if (holder) {
+      BaseVector::prepareForReuse(holder, size);
+    } else {
+      holder =
+          BaseVector::create<FlatVector<StringView>>(VARBINARY(), size, pool());
+    }
+    return holder->asFlatVector<StringView>();
+  }
+
+  // Returns the capacity of the string buffers held by 'vector'. Reported as
+  // a runtime stat whose max is the high watermark of the recycled
+  // serialization buffers.
+  static int64_t retainedStringBufferBytes(
+      const FlatVector<StringView>& vector) {
+    int64_t bytes = 0;
+    for (const auto& buffer : vector.stringBuffers()) {
+      bytes += buffer->capacity();
+    }
+    return bytes;
+  }
+
   void prepareOutput() {
     const auto size = input_->size();
     // Try to re-use memory for the output vectors that contain partitionVector
@@ -234,9 +377,9 @@ class PartitionAndSerializeOperator : public Operator {
     }
 
     do {
-      valueOutputBufferSize += rowSizes_[endOutputRow];
+      valueOutputBufferSize += rowSizes_[inputRowAt(endOutputRow)];
       if (sorted_) {
-        keyOutputBufferSize += sortKeySizes_[endOutputRow];
+        keyOutputBufferSize += sortKeySizes_[inputRowAt(endOutputRow)];
       }
       ++endOutputRow;
     } while (endOutputRow < input_->size() &&
@@ -245,6 +388,56 @@ class PartitionAndSerializeOperator : public Operator {
              (endOutputRow - nextOutputRow_) < preferredOutputRows);
   }
 
+  // Input row that output position 'row' maps to: identity unless the output
+  // is clustered by partition.
+  vector_size_t inputRowAt(vector_size_t row) const {
+    return partitionClusteredOutput_ ? rowOrder_[row] : row;
+  }
+
+  // Builds the partition-clustered output order with a counting sort over the
+  // precomputed partition ids: rows of the same partition become one
+  // contiguous span of 'rowOrder_', in their input order. This is done once
+  // per input and reused for each batch.
+  void buildPartitionOrder() {
+    const auto numInput = input_->size();
+    partitionStarts_.assign(numPartitions_, 0);
+    for (vector_size_t row = 0; row < numInput; ++row) {
+      ++partitionStarts_[partitions_[row]];
+    }
+    vector_size_t offset = 0;
+    for (auto partition = 0; partition < numPartitions_; ++partition) {
+      const auto count = partitionStarts_[partition];
+      partitionStarts_[partition] = offset;
+      offset += count;
+    }
+    rowOrder_.resize(numInput);
+    for (vector_size_t row = 0; row < numInput; ++row) {
+      rowOrder_[partitionStarts_[partitions_[row]]++] = row;
+    }
+  }
+
+  // Rewrites the partition and replicate output columns in 'rowOrder_' so
+  // they stay aligned with the reordered serialized rows.
+  void clusterOutputByPartition(FlatVector<int32_t>& partitionsVector) {
+    const auto numInput = input_->size();
+    auto* rawPartitions = partitionsVector.mutableRawValues();
+    for (vector_size_t i = 0; i < numInput; ++i) {
+      rawPartitions[i] = partitions_[rowOrder_[i]];
+    }
+    if (replicateNullsAndAny_) {
+      auto* replicateVector = output_->childAt(1)->asFlatVector<bool>();
+      auto* rawReplicate = replicateVector->mutableRawValues<uint64_t>();
+      replicateScratch_.assign(
+          rawReplicate, rawReplicate + bits::nwords(numInput));
+      for (vector_size_t i = 0; i < numInput; ++i) {
+        bits::setBit(
+            rawReplicate,
+            i,
+            bits::isBitSet(replicateScratch_.data(), rowOrder_[i]));
+      }
+    }
+  }
+
   // Calculates the size of each row. This is done once per input and reused for
   // each batch.
   void calculateRowSize() {
@@ -300,6 +493,8 @@ class PartitionAndSerializeOperator : public Operator {
 
     if (numPartitions_ == 1) {
       std::fill(partitions_.begin(), partitions_.end(), 0);
+    } else if (useSpecializedPartitionKernel_) {
+      computePartitionsFast();
     } else {
       partitionFunction_->partition(*input_, partitions_);
     }
@@ -309,6 +504,44 @@ class PartitionAndSerializeOperator : public Operator {
     ::memcpy(rawPartitions, partitions_.data(), sizeof(int32_t) * numInput);
   }
 
+  // Specialized partition computation for hash partitioning on one or two
+  // BIGINT/VARCHAR keys: hashes each key column with a compile-time
+  // specialized kernel and maps the combined hash to a partition with a
+  // multiply-shift reduction instead of the generic per-row virtual
+  // PartitionFunction call.
+  void computePartitionsFast() {
+    const auto numInput = input_->size();
+    partitionHashes_.resize(numInput);
+    keyDecodedVectors_.resize(keyChannels_.size());
+
+    for (auto i = 0; i < keyChannels_.size(); ++i) {
+      auto& decoded = keyDecodedVectors_[i];
+      decoded.decode(*input_->childAt(keyChannels_[i]));
+      if (partitionKeyKinds_[i] == TypeKind::BIGINT) {
+        if (i == 0) {
+          hashKeyColumn<TypeKind::BIGINT, false>(
+              decoded, numInput, partitionHashes_.data());
+        } else {
+          hashKeyColumn<TypeKind::BIGINT, true>(
+              decoded, numInput, partitionHashes_.data());
+        }
+      } else {
+        if (i == 0) {
+          hashKeyColumn<TypeKind::VARCHAR, false>(
+              decoded, numInput, partitionHashes_.data());
+        } else {
+          hashKeyColumn<TypeKind::VARCHAR, true>(
+              decoded, numInput, partitionHashes_.data());
+        }
+      }
+    }
+
+    for (vector_size_t row = 0; row < numInput; ++row) {
+      partitions_[row] =
+          reduceToPartition(partitionHashes_[row], numPartitions_);
+    }
+  }
+
   RowVectorPtr reorderInputsIfNeeded() {
     if (serializedColumnIndices_.empty()) {
       return input_;
@@ -349,16 +582,29 @@ class PartitionAndSerializeOperator : public Operator {
     buffer->setSize(buffer->size() + outputBufferSize);
     memset(rawBuffer, 0, outputBufferSize);
 
-    // Serialize rows.
+    // Fill all row offsets in a single pass over the precomputed sizes, then
+    // serialize the whole range at once. The batched CompactRow::serialize
+    // walks each column's vector once (column-major) instead of revisiting
+    // every column for each row, which is significantly faster for wide rows.
+    rowOffsets_.resize(batchSize);
     size_t offset = 0;
     for (auto i = 0; i < batchSize; ++i) {
-      // Write row data.
-      auto size = compactRow_->serialize(from + i, rawBuffer + offset);
-      VELOX_DCHECK_EQ(size, rowSizes_[from + i]);
-
-      dataVector.setNoCopy(
-          i, StringView(rawBuffer + offset, rowSizes_[from + i]));
-      offset += size;
+      const auto row = inputRowAt(from + i);
+      rowOffsets_[i] = offset;
+      dataVector.setNoCopy(i, StringView(rawBuffer + offset, rowSizes_[row]));
+      offset += rowSizes_[row];
+    }
+    if (partitionClusteredOutput_) {
+      // Rows are permuted into partition order, so the contiguous batched
+      // serialize does not apply; fill the buffer sequentially one row at a
+      // time. Each partition's rows land in one contiguous span of the
+      // buffer.
+      for (auto i = 0; i < batchSize; ++i) {
+        compactRow_->serialize(
+            inputRowAt(from + i), rawBuffer + rowOffsets_[i]);
+      }
+    } else {
+      compactRow_->serialize(from, batchSize, rowOffsets_.data(), rawBuffer);
     }
 
     {
@@ -405,9 +651,10 @@ class PartitionAndSerializeOperator : public Operator {
         /*initialCapacity=*/keyBufferSize,
         /*maxCapacity=*/keyBufferSize);
     for (size_t row = 0; row < batchSize; ++row) {
-      binarySortableSerializer_->serialize(from + row, keyVectorBuffer.get());
+      const auto inputRow = inputRowAt(from + row);
+      binarySortableSerializer_->serialize(inputRow, keyVectorBuffer.get());
       keyVectorBuffer->flushRow(row);
-      VELOX_CHECK_EQ(keyVector.valueAt(row).size(), sortKeySizes_[from + row]);
+      VELOX_CHECK_EQ(keyVector.valueAt(row).size(), sortKeySizes_[inputRow]);
     }
   }
 
@@ -420,19 +667,45 @@ class PartitionAndSerializeOperator : public Operator {
   const std::optional<std::vector<velox::core::FieldAccessTypedExprPtr>>
       sortingKeys_;
   const bool sorted_;
+  // True if partitions are computed by the specialized hash kernels instead
+  // of the generic PartitionFunction virtual interface.
+  const bool useSpecializedPartitionKernel_;
+  // True if output rows are emitted clustered by partition number.
+  const bool partitionClusteredOutput_;
+  // Key type kinds for the specialized kernels, aligned with 'keyChannels_'.
+  std::vector<TypeKind> partitionKeyKinds_;
   bool replicatedAny_{false};
   std::vector<column_index_t> serializedColumnIndices_;
   // Holder for partitionVector and replicateVector.
   RowVectorPtr output_;
+  // Reusable holders for the serialized data and key vectors handed to the
+  // shuffle write operator.
+  VectorPtr dataVector_;
+  VectorPtr keyVector_;
 
   std::unique_ptr<velox::row::CompactRow> compactRow_;
   std::unique_ptr<BinarySortableSerializer> binarySortableSerializer_;
   // Decoded 'keyChannels_' columns.
   std::vector<velox::DecodedVector> decodedVectors_;
+  // Reusable decoded key columns for the specialized partition kernels.
+  std::vector<velox::DecodedVector> keyDecodedVectors_;
+  // Reusable per-row key hashes for the specialized partition kernels.
+  std::vector<uint64_t> partitionHashes_;
   // Reusable vector for storing partition id for each input row.
   std::vector<uint32_t> partitions_;
+  // Reusable output-position-to-input-row mapping for partition-clustered
+  // output.
+  std::vector<vector_size_t> rowOrder_;
+  // Reusable per-partition offsets for the counting sort.
+  std::vector<vector_size_t> partitionStarts_;
+  // Reusable copy of the input-order replicate bits while they are gathered
+  // into 'rowOrder_' order.
+  std::vector<uint64_t> replicateScratch_;
   // Reusable vector for storing serialised row size for each input row.
   std::vector<uint32_t> rowSizes_;
+  // Reusable vector for storing the output buffer offset of each row in the
+  // current batch.
+  std::vector<size_t> rowOffsets_;
   // Reusable vector for storing sort key buffer size for each input row.
   std::vector<size_t> sortKeySizes_;
   vector_size_t nextOutputRow_{0};
@@ -471,6 +744,9 @@ void PartitionAndSerializeNode::addDetails(std::stringstream& stream) const {
   }
   stream << ") " << numPartitions_ << " " << partitionFunctionSpec_->toString()
          << " " << serializedRowType_->toString();
+  if (partitionClusteredOutput_) {
+    stream << " clustered";
+  }
 }
 
 folly::dynamic PartitionAndSerializeNode::serialize() const {
@@ -481,6 +757,7 @@ folly::dynamic PartitionAndSerializeNode::serialize() const {
   obj["sources"] = ISerializable::serialize(sources_);
   obj["replicateNullsAndAny"] = replicateNullsAndAny_;
   obj["partitionFunctionSpec"] = partitionFunctionSpec_->serialize();
+  obj["partitionClusteredOutput"] = partitionClusteredOutput_;
   if (sortingOrders_) {
     obj["sortingOrders"] = serializeSortingOrders(sortingOrders_.value());
   }
@@ -503,6 +780,9 @@ velox::core::PlanNodePtr PartitionAndSerializeNode::create(
   if (obj.count("sortingKeys")) {
     sortingKeys = deserializeFields(obj["sortingKeys"], context);
   }
+  const bool partitionClusteredOutput = obj.count("partitionClusteredOutput")
+      ? obj["partitionClusteredOutput"].asBool()
+      : false;
   return std::make_shared<PartitionAndSerializeNode>(
       deserializePlanNodeId(obj),
       ISerializable::deserialize<std::vector<velox::core::ITypedExpr>>(
@@ -515,6 +795,7 @@ velox::core::PlanNodePtr PartitionAndSerializeNode::create(
       ISerializable::deserialize<velox::core::PartitionFunctionSpec>(
           obj["partitionFunctionSpec"], context),
       sortingOrders,
-      sortingKeys);
+      sortingKeys,
+      partitionClusteredOutput);
 }
 } // namespace facebook::presto::operators
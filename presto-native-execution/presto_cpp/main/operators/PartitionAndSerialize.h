@@ -23,7 +23,8 @@ namespace facebook::presto::operators {
 /// number (INTEGER) serialized key (VARBINARY), and serialized row (VARBINARY).
 /// If 'replicateNullsAndAny' is true, the output includes a third boolean
 /// column which indicates whether a row needs to be replicated to all
-/// partitions.
+/// partitions. If 'partitionClusteredOutput' is true, output rows are emitted
+/// clustered by partition number instead of in input order.
 class PartitionAndSerializeNode : public velox::core::PlanNode {
  public:
   PartitionAndSerializeNode(
@@ -37,7 +38,8 @@ class PartitionAndSerializeNode : public velox::core::PlanNode {
       std::optional<std::vector<velox::core::SortOrder>> sortingOrders =
           std::nullopt,
       std::optional<std::vector<velox::core::FieldAccessTypedExprPtr>>
-          sortingKeys = std::nullopt)
+          sortingKeys = std::nullopt,
+      bool partitionClusteredOutput = false)
       : velox::core::PlanNode(id),
         keys_(std::move(keys)),
         numPartitions_(numPartitions),
@@ -46,7 +48,8 @@ class PartitionAndSerializeNode : public velox::core::PlanNode {
         replicateNullsAndAny_(replicateNullsAndAny && numPartitions > 1),
         partitionFunctionSpec_(std::move(partitionFunctionFactory)),
         sortingOrders_(std::move(sortingOrders)),
-        sortingKeys_(std::move(sortingKeys)) {
+        sortingKeys_(std::move(sortingKeys)),
+        partitionClusteredOutput_(partitionClusteredOutput && numPartitions > 1) {
     VELOX_USER_CHECK_NOT_NULL(
         partitionFunctionSpec_, "Partition function factory cannot be null.");
   }
@@ -65,6 +68,7 @@ class PartitionAndSerializeNode : public velox::core::PlanNode {
       partitionFunctionFactory_ = other.partitionFunctionFactory();
       sortingOrders_ = other.sortingOrders();
       sortingKeys_ = other.sortingKeys();
+      partitionClusteredOutput_ = other.isPartitionClusteredOutput();
     }
 
     Builder& id(velox::core::PlanNodeId id) {
@@ -116,6 +120,11 @@ class PartitionAndSerializeNode : public velox::core::PlanNode {
       return *this;
     }
 
+    Builder& partitionClusteredOutput(bool partitionClusteredOutput) {
+      partitionClusteredOutput_ = partitionClusteredOutput;
+      return *this;
+    }
+
     std::shared_ptr<PartitionAndSerializeNode> build() const {
       VELOX_USER_CHECK(
           id_.has_value(), "PartitionAndSerializeNode id is not set");
@@ -145,7 +154,8 @@ class PartitionAndSerializeNode : public velox::core::PlanNode {
           replicateNullsAndAny_.value(),
           partitionFunctionFactory_.value(),
           sortingOrders_,
-          sortingKeys_);
+          sortingKeys_,
+          partitionClusteredOutput_);
     }
 
    private:
@@ -160,6 +170,7 @@ class PartitionAndSerializeNode : public velox::core::PlanNode {
     std::optional<std::vector<velox::core::SortOrder>> sortingOrders_;
     std::optional<std::vector<velox::core::FieldAccessTypedExprPtr>>
         sortingKeys_;
+    bool partitionClusteredOutput_{false};
   };
 
   folly::dynamic serialize() const override;
@@ -213,6 +224,14 @@ class PartitionAndSerializeNode : public velox::core::PlanNode {
     return partitionFunctionSpec_;
   }
 
+  /// Returns true if output rows are emitted clustered by partition number:
+  /// rows of the same partition occupy one contiguous span of each output
+  /// batch, so the downstream shuffle write operator can hand each span to
+  /// the shuffle as a whole slice instead of routing rows one at a time.
+  bool isPartitionClusteredOutput() const {
+    return partitionClusteredOutput_;
+  }
+
   std::string_view name() const override {
     return "PartitionAndSerialize";
   }
@@ -239,6 +258,7 @@ class PartitionAndSerializeNode : public velox::core::PlanNode {
   const std::optional<std::vector<velox::core::SortOrder>> sortingOrders_;
   const std::optional<std::vector<velox::core::FieldAccessTypedExprPtr>>
       sortingKeys_;
+  const bool partitionClusteredOutput_;
 };
 
 class PartitionAndSerializeTranslator
@@ -0,0 +1,746 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/operators/RdmaShuffle.h"
+
+#include <infiniband/verbs.h>
+#include <poll.h>
+#include <rdma/rdma_cma.h>
+#include <rdma/rdma_verbs.h>
+
+#include <folly/String.h>
+#include <folly/lang/Bits.h>
+#include "presto_cpp/external/json/nlohmann/json.hpp"
+#include "velox/common/base/Exceptions.h"
+
+using namespace facebook::velox;
+
+namespace facebook::presto::operators {
+namespace {
+
+using json = nlohmann::json;
+
+// Size of a writer block and of each reader ring slot. Large enough to
+// amortize per-transfer overheads, small enough that a partition's ring
+// stays well under the NIC's registered memory budget.
+constexpr uint64_t kBlockBytes = 4 << 20; // 4MB
+
+// Slots in the reader's receive ring; also the writer's credit window, so
+// this many blocks can be in flight per partition.
+constexpr uint32_t kRingSlots = 8;
+
+// Receive-ring descriptor the reader passes in the private data of its
+// connection request. Kept under the 56-byte private data limit of RoCE.
+struct RingDescriptor {
+  uint64_t addr;
+  uint32_t rkey;
+  uint32_t slotBytes;
+  uint32_t numSlots;
+  uint32_t partition;
+};
+
+// Connection state stashed on the cm id between the connect request and the
+// established event.
+struct PendingConnection {
+  RingDescriptor ring;
+};
+
+void fillQpAttr(ibv_qp_init_attr& attr) {
+  std::memset(&attr, 0, sizeof(attr));
+  attr.cap.max_send_wr = kRingSlots + 1;
+  attr.cap.max_recv_wr = kRingSlots + 1;
+  attr.cap.max_send_sge = 1;
+  attr.cap.max_recv_sge = 1;
+  attr.qp_type = IBV_QPT_RC;
+  // Generate a completion for every work request; the push and receive
+  // loops consume them one by one.
+  attr.sq_sig_all = 1;
+}
+
+// Posts a zero-length receive; a completion for it consumes the immediate
+// of one incoming RDMA write.
+void postImmReceive(rdma_cm_id* id) {
+  ibv_recv_wr wr;
+  std::memset(&wr, 0, sizeof(wr));
+  ibv_recv_wr* bad = nullptr;
+  VELOX_CHECK_EQ(
+      ibv_post_recv(id->qp, &wr, &bad),
+      0,
+      "ibv_post_recv failed: {}",
+      folly::errnoStr(errno));
+}
+
+// Posts a zero-length send, used as the reader's credit message.
+void postCreditSend(rdma_cm_id* id) {
+  ibv_send_wr wr;
+  std::memset(&wr, 0, sizeof(wr));
+  wr.opcode = IBV_WR_SEND;
+  wr.send_flags = IBV_SEND_SIGNALED;
+  ibv_send_wr* bad = nullptr;
+  VELOX_CHECK_EQ(
+      ibv_post_send(id->qp, &wr, &bad),
+      0,
+      "ibv_post_send failed: {}",
+      folly::errnoStr(errno));
+  ibv_wc wc;
+  VELOX_CHECK_GE(
+      rdma_get_send_comp(id, &wc),
+      0,
+      "rdma_get_send_comp failed: {}",
+      folly::errnoStr(errno));
+  VELOX_CHECK_EQ(wc.status, IBV_WC_SUCCESS, "credit send failed");
+}
+
+// RDMA-writes ['addr', 'addr' + 'length') into the remote ring slot, with
+// 'imm' carried as the immediate, and waits for the completion.
+void postBlockWrite(
+    rdma_cm_id* id,
+    const void* addr,
+    uint32_t length,
+    uint32_t lkey,
+    uint64_t remoteAddr,
+    uint32_t rkey,
+    uint32_t imm) {
+  ibv_sge sge;
+  std::memset(&sge, 0, sizeof(sge));
+  sge.addr = reinterpret_cast<uint64_t>(addr);
+  sge.length = length;
+  sge.lkey = lkey;
+
+  ibv_send_wr wr;
+  std::memset(&wr, 0, sizeof(wr));
+  wr.opcode = IBV_WR_RDMA_WRITE_WITH_IMM;
+  wr.send_flags = IBV_SEND_SIGNALED;
+  wr.sg_list = length > 0 ? &sge : nullptr;
+  wr.num_sge = length > 0 ? 1 : 0;
+  wr.imm_data = folly::Endian::big(imm);
+  wr.wr.rdma.remote_addr = remoteAddr;
+  wr.wr.rdma.rkey = rkey;
+
+  ibv_send_wr* bad = nullptr;
+  VELOX_CHECK_EQ(
+      ibv_post_send(id->qp, &wr, &bad),
+      0,
+      "ibv_post_send failed: {}",
+      folly::errnoStr(errno));
+  ibv_wc wc;
+  VELOX_CHECK_GE(
+      rdma_get_send_comp(id, &wc),
+      0,
+      "rdma_get_send_comp failed: {}",
+      folly::errnoStr(errno));
+  VELOX_CHECK_EQ(
+      wc.status,
+      IBV_WC_SUCCESS,
+      "RDMA write failed: {}",
+      ibv_wc_status_str(wc.status));
+}
+
+rdma_addrinfo* resolveEndpoint(
+    const std::string& host,
+    uint16_t port,
+    bool passive) {
+  rdma_addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_port_space = RDMA_PS_TCP;
+  if (passive) {
+    hints.ai_flags = RAI_PASSIVE;
+  }
+  rdma_addrinfo* info = nullptr;
+  const auto ret = rdma_getaddrinfo(
+      host.c_str(), std::to_string(port).c_str(), &hints, &info);
+  VELOX_CHECK_EQ(
+      ret, 0, "rdma_getaddrinfo failed for {}:{}", host, port);
+  return info;
+}
+
+class RdmaShuffleSerializedPage : public ShuffleSerializedPage {
+ public:
+  RdmaShuffleSerializedPage(
+      std::vector<std::string_view> rows,
+      velox::BufferPtr buffer)
+      : rows_{std::move(rows)}, buffer_{std::move(buffer)} {}
+
+  const std::vector<std::string_view>& rows() override {
+    return rows_;
+  }
+
+  uint64_t size() const override {
+    return buffer_->size();
+  }
+
+  std::optional<int64_t> numRows() const override {
+    return rows_.size();
+  }
+
+ private:
+  const std::vector<std::string_view> rows_;
+  const velox::BufferPtr buffer_;
+};
+
+// Splits an unsorted shuffle block into row views over 'buffer', using the
+// same 'dataSize | data' framing as the local shuffle files.
+std::vector<std::string_view> extractRows(const char* buffer, size_t size) {
+  std::vector<std::string_view> rows;
+  size_t offset = 0;
+  while (offset + kUint32Size <= size) {
+    const TRowSize dataSize =
+        folly::Endian::big(*reinterpret_cast<const TRowSize*>(buffer + offset));
+    offset += kUint32Size;
+    VELOX_CHECK_LE(
+        offset + dataSize, size, "Corrupted RDMA shuffle block");
+    rows.emplace_back(buffer + offset, dataSize);
+    offset += dataSize;
+  }
+  return rows;
+}
+} // namespace
+
+std::string RdmaShuffleWriteInfo::serialize() const {
+  json obj;
+  obj["host"] = host;
+  obj["port"] = port;
+  obj["queryId"] = queryId;
+  obj["numPartitions"] = numPartitions;
+  obj["shuffleId"] = shuffleId;
+  return obj.dump();
+}
+
+RdmaShuffleWriteInfo RdmaShuffleWriteInfo::deserialize(
+    const std::string& info) {
+  const auto jsonInfo = json::parse(info);
+  RdmaShuffleWriteInfo shuffleInfo;
+  jsonInfo.at("host").get_to(shuffleInfo.host);
+  jsonInfo.at("port").get_to(shuffleInfo.port);
+  jsonInfo.at("queryId").get_to(shuffleInfo.queryId);
+  jsonInfo.at("numPartitions").get_to(shuffleInfo.numPartitions);
+  jsonInfo.at("shuffleId").get_to(shuffleInfo.shuffleId);
+  return shuffleInfo;
+}
+
+std::string RdmaShuffleReadInfo::serialize() const {
+  json obj;
+  obj["endpoints"] = endpoints;
+  obj["queryId"] = queryId;
+  return obj.dump();
+}
+
+RdmaShuffleReadInfo RdmaShuffleReadInfo::deserialize(const std::string& info) {
+  const auto jsonInfo = json::parse(info);
+  RdmaShuffleReadInfo shuffleInfo;
+  jsonInfo.at("endpoints").get_to(shuffleInfo.endpoints);
+  jsonInfo.at("queryId").get_to(shuffleInfo.queryId);
+  return shuffleInfo;
+}
+
+RdmaSlabPool::~RdmaSlabPool() {
+  for (auto& slab : freeSlabs_) {
+    ibv_dereg_mr(slab.mr);
+  }
+}
+
+RdmaSlabPool::Slab RdmaSlabPool::acquire() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!freeSlabs_.empty()) {
+      auto slab = std::move(freeSlabs_.back());
+      freeSlabs_.pop_back();
+      return slab;
+    }
+  }
+  Slab slab;
+  slab.buffer = velox::AlignedBuffer::allocate<char>(slabBytes_, pool_, 0);
+  slab.mr = ibv_reg_mr(
+      pd_,
+      slab.buffer->asMutable<char>(),
+      slabBytes_,
+      IBV_ACCESS_LOCAL_WRITE);
+  VELOX_CHECK_NOT_NULL(
+      slab.mr, "ibv_reg_mr failed: {}", folly::errnoStr(errno));
+  return slab;
+}
+
+void RdmaSlabPool::release(Slab slab) {
+  std::lock_guard<std::mutex> l(mutex_);
+  freeSlabs_.push_back(std::move(slab));
+}
+
+RdmaShuffleWriter::RdmaShuffleWriter(
+    const std::string& host,
+    uint16_t port,
+    uint32_t numPartitions,
+    uint64_t blockBytes,
+    velox::memory::MemoryPool* pool)
+    : numPartitions_(numPartitions),
+      blockBytes_(blockBytes),
+      pool_(pool),
+      inProgressSlabs_(numPartitions),
+      inProgressSizes_(numPartitions, 0) {
+  partitionQueues_.reserve(numPartitions_);
+  for (uint32_t i = 0; i < numPartitions_; ++i) {
+    partitionQueues_.push_back(std::make_unique<PartitionQueue>());
+  }
+
+  eventChannel_ = rdma_create_event_channel();
+  VELOX_CHECK_NOT_NULL(
+      eventChannel_,
+      "rdma_create_event_channel failed: {}",
+      folly::errnoStr(errno));
+  VELOX_CHECK_EQ(
+      rdma_create_id(eventChannel_, &listener_, nullptr, RDMA_PS_TCP),
+      0,
+      "rdma_create_id failed: {}",
+      folly::errnoStr(errno));
+
+  auto* addrInfo = resolveEndpoint(host, port, /*passive=*/true);
+  const auto bindRet = rdma_bind_addr(listener_, addrInfo->ai_src_addr);
+  rdma_freeaddrinfo(addrInfo);
+  VELOX_CHECK_EQ(
+      bindRet,
+      0,
+      "rdma_bind_addr failed for {}:{}: {}",
+      host,
+      port,
+      folly::errnoStr(errno));
+  VELOX_CHECK_EQ(
+      rdma_listen(listener_, numPartitions_),
+      0,
+      "rdma_listen failed: {}",
+      folly::errnoStr(errno));
+
+  pd_ = ibv_alloc_pd(listener_->verbs);
+  VELOX_CHECK_NOT_NULL(
+      pd_, "ibv_alloc_pd failed: {}", folly::errnoStr(errno));
+  slabPool_ = std::make_unique<RdmaSlabPool>(pd_, blockBytes_, pool_);
+
+  acceptThread_ = std::thread([this]() { acceptLoop(); });
+}
+
+RdmaShuffleWriter::~RdmaShuffleWriter() {
+  closed_ = true;
+  for (auto& queue : partitionQueues_) {
+    std::lock_guard<std::mutex> l(queue->mutex);
+    queue->hasWork.notify_all();
+  }
+  if (acceptThread_.joinable()) {
+    acceptThread_.join();
+  }
+  for (auto& thread : pushThreads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  // Return undelivered blocks to the pool so their registrations are
+  // released with it.
+  for (auto& queue : partitionQueues_) {
+    for (auto& block : queue->blocks) {
+      slabPool_->release(std::move(block.slab));
+    }
+    queue->blocks.clear();
+  }
+  for (auto& slab : inProgressSlabs_) {
+    if (slab.buffer != nullptr) {
+      slabPool_->release(std::move(slab));
+    }
+  }
+  slabPool_.reset();
+  if (listener_ != nullptr) {
+    rdma_destroy_id(listener_);
+  }
+  if (pd_ != nullptr) {
+    ibv_dealloc_pd(pd_);
+  }
+  if (eventChannel_ != nullptr) {
+    rdma_destroy_event_channel(eventChannel_);
+  }
+}
+
+void RdmaShuffleWriter::collect(
+    int32_t partition,
+    std::string_view key,
+    std::string_view data) {
+  VELOX_CHECK_LT(partition, numPartitions_);
+  VELOX_CHECK(
+      key.empty(), "RDMA shuffle does not support sorted shuffle keys");
+
+  const auto rowBytes = kUint32Size + data.size();
+  VELOX_CHECK_LE(
+      rowBytes, blockBytes_, "Shuffle row larger than an RDMA block");
+  auto& slab = inProgressSlabs_[partition];
+  if (slab.buffer == nullptr) {
+    slab = slabPool_->acquire();
+    inProgressSizes_[partition] = 0;
+  } else if (inProgressSizes_[partition] + rowBytes > blockBytes_) {
+    sealBlock(partition);
+    slab = slabPool_->acquire();
+    inProgressSizes_[partition] = 0;
+  }
+
+  auto* writePos =
+      inProgressSlabs_[partition].buffer->asMutable<char>() +
+      inProgressSizes_[partition];
+  *reinterpret_cast<TRowSize*>(writePos) =
+      folly::Endian::big(static_cast<TRowSize>(data.size()));
+  if (!data.empty()) {
+    std::memcpy(writePos + kUint32Size, data.data(), data.size());
+  }
+  inProgressSizes_[partition] += rowBytes;
+}
+
+void RdmaShuffleWriter::sealBlock(int32_t partition) {
+  auto& queue = *partitionQueues_[partition];
+  std::lock_guard<std::mutex> l(queue.mutex);
+  queue.blocks.push_back(
+      Block{
+          std::move(inProgressSlabs_[partition]),
+          inProgressSizes_[partition]});
+  inProgressSizes_[partition] = 0;
+  queue.hasWork.notify_all();
+}
+
+void RdmaShuffleWriter::noMoreData(bool success) {
+  for (uint32_t i = 0; i < numPartitions_; ++i) {
+    if (success && inProgressSizes_[i] > 0) {
+      sealBlock(i);
+    }
+    auto& queue = *partitionQueues_[i];
+    std::lock_guard<std::mutex> l(queue.mutex);
+    if (!success) {
+      for (auto& block : queue.blocks) {
+        slabPool_->release(std::move(block.slab));
+      }
+      queue.blocks.clear();
+      queue.aborted = true;
+    }
+    queue.finished = true;
+    queue.hasWork.notify_all();
+  }
+}
+
+folly::F14FastMap<std::string, int64_t> RdmaShuffleWriter::stats() const {
+  return {
+      {"rdma.write.blocks", blocksPushed_.load()},
+      {"rdma.write.bytes", bytesPushed_.load()}};
+}
+
+void RdmaShuffleWriter::acceptLoop() {
+  folly::F14FastMap<rdma_cm_id*, PendingConnection> pending;
+  while (!closed_) {
+    pollfd pfd{eventChannel_->fd, POLLIN, 0};
+    const auto ready = ::poll(&pfd, 1, /*timeout=*/100);
+    if (ready <= 0) {
+      continue;
+    }
+    rdma_cm_event* event = nullptr;
+    if (rdma_get_cm_event(eventChannel_, &event) != 0) {
+      continue;
+    }
+    switch (event->event) {
+      case RDMA_CM_EVENT_CONNECT_REQUEST: {
+        auto* id = event->id;
+        PendingConnection connection;
+        VELOX_CHECK_GE(
+            event->param.conn.private_data_len, sizeof(RingDescriptor));
+        std::memcpy(
+            &connection.ring,
+            event->param.conn.private_data,
+            sizeof(RingDescriptor));
+        ibv_qp_init_attr qpAttr;
+        fillQpAttr(qpAttr);
+        if (rdma_create_qp(id, pd_, &qpAttr) == 0) {
+          rdma_conn_param param;
+          std::memset(&param, 0, sizeof(param));
+          if (rdma_accept(id, &param) == 0) {
+            pending.emplace(id, connection);
+          } else {
+            rdma_destroy_qp(id);
+            rdma_destroy_id(id);
+          }
+        } else {
+          rdma_destroy_id(id);
+        }
+        break;
+      }
+      case RDMA_CM_EVENT_ESTABLISHED: {
+        auto* id = event->id;
+        const auto it = pending.find(id);
+        if (it != pending.end()) {
+          const auto ring = it->second.ring;
+          pending.erase(it);
+          pushThreads_.emplace_back([this, id, ring]() {
+            pushPartition(id, ring.partition);
+          });
+          // The descriptor travels with the thread; stash it on the id for
+          // pushPartition to read.
+          id->context = new RingDescriptor(ring);
+        }
+        break;
+      }
+      default:
+        pending.erase(event->id);
+        break;
+    }
+    rdma_ack_cm_event(event);
+  }
+}
+
+void RdmaShuffleWriter::pushPartition(rdma_cm_id* id, int32_t partition) {
+  const std::unique_ptr<RingDescriptor> ring(
+      static_cast<RingDescriptor*>(id->context));
+  VELOX_CHECK_LT(partition, numPartitions_);
+  VELOX_CHECK_LE(blockBytes_, ring->slotBytes);
+  auto& queue = *partitionQueues_[partition];
+
+  uint32_t credits = ring->numSlots;
+  // One posted receive per credit the reader can return.
+  for (uint32_t i = 0; i < ring->numSlots; ++i) {
+    postImmReceive(id);
+  }
+
+  uint64_t sequence = 0;
+  bool aborted = false;
+  while (true) {
+    Block block;
+    {
+      std::unique_lock<std::mutex> l(queue.mutex);
+      queue.hasWork.wait(l, [&]() {
+        return !queue.blocks.empty() || queue.finished || closed_;
+      });
+      if (queue.blocks.empty()) {
+        aborted = queue.aborted || (closed_ && !queue.finished);
+        break;
+      }
+      block = std::move(queue.blocks.front());
+      queue.blocks.pop_front();
+    }
+
+    if (credits == 0) {
+      ibv_wc wc;
+      if (rdma_get_recv_comp(id, &wc) <= 0 || wc.status != IBV_WC_SUCCESS) {
+        // The reader went away; drop the rest of the partition.
+        slabPool_->release(std::move(block.slab));
+        aborted = true;
+        break;
+      }
+      ++credits;
+      postImmReceive(id);
+    }
+
+    const auto slot = sequence % ring->numSlots;
+    postBlockWrite(
+        id,
+        block.slab.buffer->as<char>(),
+        block.size,
+        block.slab.mr->lkey,
+        ring->addr + slot * ring->slotBytes,
+        ring->rkey,
+        static_cast<uint32_t>(block.size));
+    --credits;
+    ++sequence;
+    blocksPushed_ += 1;
+    bytesPushed_ += block.size;
+    slabPool_->release(std::move(block.slab));
+  }
+
+  if (!aborted) {
+    if (credits == 0) {
+      ibv_wc wc;
+      rdma_get_recv_comp(id, &wc);
+    }
+    const auto slot = sequence % ring->numSlots;
+    postBlockWrite(
+        id,
+        nullptr,
+        0,
+        0,
+        ring->addr + slot * ring->slotBytes,
+        ring->rkey,
+        kEndOfStream);
+  }
+  rdma_disconnect(id);
+  rdma_destroy_qp(id);
+  rdma_destroy_id(id);
+}
+
+RdmaShuffleReader::RdmaShuffleReader(
+    std::vector<std::string> endpoints,
+    int32_t partition,
+    velox::memory::MemoryPool* pool)
+    : endpoints_(std::move(endpoints)), partition_(partition), pool_(pool) {
+  ring_ = velox::AlignedBuffer::allocate<char>(
+      static_cast<size_t>(kBlockBytes) * kRingSlots, pool_, 0);
+}
+
+RdmaShuffleReader::~RdmaShuffleReader() {
+  disconnect();
+}
+
+bool RdmaShuffleReader::connectNextEndpoint() {
+  while (endpointIndex_ < endpoints_.size()) {
+    const auto& endpoint = endpoints_[endpointIndex_++];
+    std::string host;
+    uint16_t port{0};
+    folly::split(':', endpoint, host, port);
+
+    auto* addrInfo = resolveEndpoint(host, port, /*passive=*/false);
+    ibv_qp_init_attr qpAttr;
+    fillQpAttr(qpAttr);
+    const auto createRet = rdma_create_ep(&id_, addrInfo, nullptr, &qpAttr);
+    rdma_freeaddrinfo(addrInfo);
+    VELOX_CHECK_EQ(
+        createRet,
+        0,
+        "rdma_create_ep failed for {}: {}",
+        endpoint,
+        folly::errnoStr(errno));
+
+    ringMr_ = ibv_reg_mr(
+        id_->pd,
+        ring_->asMutable<char>(),
+        ring_->capacity(),
+        IBV_ACCESS_LOCAL_WRITE | IBV_ACCESS_REMOTE_WRITE);
+    VELOX_CHECK_NOT_NULL(
+        ringMr_, "ibv_reg_mr failed: {}", folly::errnoStr(errno));
+
+    for (uint32_t i = 0; i < kRingSlots; ++i) {
+      postImmReceive(id_);
+    }
+
+    RingDescriptor descriptor;
+    descriptor.addr = reinterpret_cast<uint64_t>(ring_->as<char>());
+    descriptor.rkey = ringMr_->rkey;
+    descriptor.slotBytes = kBlockBytes;
+    descriptor.numSlots = kRingSlots;
+    descriptor.partition = partition_;
+
+    rdma_conn_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.private_data = &descriptor;
+    param.private_data_len = sizeof(descriptor);
+    VELOX_CHECK_EQ(
+        rdma_connect(id_, &param),
+        0,
+        "rdma_connect failed for {}: {}",
+        endpoint,
+        folly::errnoStr(errno));
+    nextSequence_ = 0;
+    return true;
+  }
+  return false;
+}
+
+void RdmaShuffleReader::disconnect() {
+  if (id_ != nullptr) {
+    rdma_disconnect(id_);
+    if (ringMr_ != nullptr) {
+      ibv_dereg_mr(ringMr_);
+      ringMr_ = nullptr;
+    }
+    rdma_destroy_ep(id_);
+    id_ = nullptr;
+  }
+}
+
+bool RdmaShuffleReader::receiveBlock(velox::BufferPtr& buffer) {
+  ibv_wc wc;
+  VELOX_CHECK_GE(
+      rdma_get_recv_comp(id_, &wc),
+      0,
+      "rdma_get_recv_comp failed: {}",
+      folly::errnoStr(errno));
+  VELOX_CHECK_EQ(
+      wc.status,
+      IBV_WC_SUCCESS,
+      "RDMA receive failed: {}",
+      ibv_wc_status_str(wc.status));
+  const auto imm = folly::Endian::big(wc.imm_data);
+  if (imm == RdmaShuffleWriter::kEndOfStream) {
+    return false;
+  }
+
+  const auto slot = nextSequence_++ % kRingSlots;
+  const char* slotData = ring_->as<char>() + slot * kBlockBytes;
+  buffer = velox::AlignedBuffer::allocate<char>(imm, pool_, 0);
+  std::memcpy(buffer->asMutable<char>(), slotData, imm);
+  buffer->setSize(imm);
+  blocksReceived_ += 1;
+  bytesReceived_ += imm;
+
+  // The slot has been copied out: replenish the immediate receive and
+  // return the slot's credit to the writer.
+  postImmReceive(id_);
+  postCreditSend(id_);
+  return true;
+}
+
+folly::SemiFuture<std::vector<std::unique_ptr<ShuffleSerializedPage>>>
+RdmaShuffleReader::next(uint64_t maxBytes) {
+  std::vector<std::unique_ptr<ShuffleSerializedPage>> batches;
+  uint64_t batchBytes = 0;
+  while (!atEnd_ && batchBytes < maxBytes) {
+    if (id_ == nullptr) {
+      if (!connectNextEndpoint()) {
+        atEnd_ = true;
+        break;
+      }
+    }
+    velox::BufferPtr buffer;
+    if (!receiveBlock(buffer)) {
+      // Current writer's partition stream is drained; move to the next
+      // endpoint.
+      disconnect();
+      continue;
+    }
+    batchBytes += buffer->size();
+    auto rows = extractRows(buffer->as<char>(), buffer->size());
+    batches.push_back(
+        std::make_unique<RdmaShuffleSerializedPage>(
+            std::move(rows), std::move(buffer)));
+  }
+  return folly::makeSemiFuture(std::move(batches));
+}
+
+void RdmaShuffleReader::noMoreData(bool /*success*/) {
+  disconnect();
+  atEnd_ = true;
+}
+
+folly::F14FastMap<std::string, int64_t> RdmaShuffleReader::stats() const {
+  return {
+      {"rdma.read.blocks", blocksReceived_.load()},
+      {"rdma.read.bytes", bytesReceived_.load()}};
+}
+
+std::shared_ptr<ShuffleReader> RdmaShuffleFactory::createReader(
+    const std::string& serializedStr,
+    int32_t partition,
+    velox::memory::MemoryPool* pool) {
+  const auto readInfo = RdmaShuffleReadInfo::deserialize(serializedStr);
+  return std::make_shared<RdmaShuffleReader>(
+      readInfo.endpoints, partition, pool);
+}
+
+std::shared_ptr<ShuffleWriter> RdmaShuffleFactory::createWriter(
+    const std::string& serializedStr,
+    velox::memory::MemoryPool* pool) {
+  const auto writeInfo = RdmaShuffleWriteInfo::deserialize(serializedStr);
+  VELOX_CHECK_GT(writeInfo.numPartitions, 0);
+  return std::make_shared<RdmaShuffleWriter>(
+      writeInfo.host,
+      writeInfo.port,
+      writeInfo.numPartitions,
+      kBlockBytes,
+      pool);
+}
+
+} // namespace facebook::presto::operators
@@ -0,0 +1,249 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "presto_cpp/main/operators/LocalShuffle.h"
+#include "presto_cpp/main/operators/ShuffleInterface.h"
+
+struct ibv_mr;
+struct ibv_pd;
+struct rdma_cm_id;
+struct rdma_event_channel;
+
+namespace facebook::presto::operators {
+
+/// Reference shuffle implementation that moves partition data between
+/// workers over RDMA verbs, bypassing kernel networking. Only compiled when
+/// the build enables PRESTO_ENABLE_RDMA_SHUFFLE (requires libibverbs and
+/// librdmacm, and RoCE or InfiniBand capable NICs at runtime).
+///
+/// The writer collects rows into blocks allocated from a slab pool whose
+/// slabs are registered with the NIC once and recycled, so no memory is
+/// registered on the data path. Completed blocks stay in registered memory
+/// and are pushed to the reader write-based: the reader connects through
+/// librdmacm with the partition number and a descriptor of its registered
+/// receive ring in the connection's private data, and the writer
+/// RDMA-writes one block per ring slot with the block length carried in the
+/// immediate, gated by credits the reader returns as it consumes slots. A
+/// zero-length write with immediate kEndOfStream terminates the partition.
+///
+/// Reference simplifications: only unsorted shuffle is supported, a reader
+/// drains its writer endpoints sequentially, and received blocks are copied
+/// out of the receive ring into pool memory before being handed to the
+/// operator. Rows use the same framing as the local shuffle files, so the
+/// surrounding operators are unchanged.
+
+/// Shuffle write information for the RDMA shuffle, encoded in JSON by the
+/// coordination layer. 'host' and 'port' name the RDMA endpoint this
+/// writer's block server listens on.
+struct RdmaShuffleWriteInfo {
+  std::string host;
+  uint16_t port;
+  std::string queryId;
+  uint32_t numPartitions;
+  uint32_t shuffleId;
+
+  std::string serialize() const;
+
+  static RdmaShuffleWriteInfo deserialize(const std::string& info);
+};
+
+/// Shuffle read information for the RDMA shuffle. 'endpoints' lists the
+/// 'host:port' block servers of all writers of the shuffle; the reader
+/// drains its partition from each of them.
+struct RdmaShuffleReadInfo {
+  std::vector<std::string> endpoints;
+  std::string queryId;
+
+  std::string serialize() const;
+
+  static RdmaShuffleReadInfo deserialize(const std::string& info);
+};
+
+/// Pool of NIC-registered slabs the writer builds its blocks in. Slabs are
+/// allocated from the velox memory pool, registered once with the
+/// protection domain and recycled through a free list, so the per-block
+/// cost of ibv_reg_mr is paid only while the pool grows.
+class RdmaSlabPool {
+ public:
+  struct Slab {
+    velox::BufferPtr buffer;
+    ibv_mr* mr{nullptr};
+  };
+
+  RdmaSlabPool(ibv_pd* pd, uint64_t slabBytes, velox::memory::MemoryPool* pool)
+      : pd_(pd), slabBytes_(slabBytes), pool_(pool) {}
+
+  ~RdmaSlabPool();
+
+  /// Returns a registered slab of 'slabBytes', reusing a released one when
+  /// available.
+  Slab acquire();
+
+  /// Returns 'slab' to the free list for reuse.
+  void release(Slab slab);
+
+  uint64_t slabBytes() const {
+    return slabBytes_;
+  }
+
+ private:
+  ibv_pd* const pd_;
+  const uint64_t slabBytes_;
+  velox::memory::MemoryPool* const pool_;
+
+  std::mutex mutex_;
+  std::vector<Slab> freeSlabs_;
+};
+
+class RdmaShuffleWriter : public ShuffleWriter {
+ public:
+  /// Immediate value of the zero-length write that terminates a partition
+  /// stream.
+  static constexpr uint32_t kEndOfStream = 0xffffffff;
+
+  RdmaShuffleWriter(
+      const std::string& host,
+      uint16_t port,
+      uint32_t numPartitions,
+      uint64_t blockBytes,
+      velox::memory::MemoryPool* pool);
+
+  ~RdmaShuffleWriter() override;
+
+  void collect(int32_t partition, std::string_view key, std::string_view data)
+      override;
+
+  /// Seals the in-progress blocks. The block server keeps serving until
+  /// every partition has been drained by its reader (or the writer is
+  /// destroyed); on '!success' the staged blocks are dropped instead.
+  void noMoreData(bool success) override;
+
+  folly::F14FastMap<std::string, int64_t> stats() const override;
+
+ private:
+  // A sealed block awaiting transfer, held in a registered slab.
+  struct Block {
+    RdmaSlabPool::Slab slab;
+    size_t size;
+  };
+
+  // Per-partition queue of sealed blocks, handed to the connection thread
+  // serving the partition's reader.
+  struct PartitionQueue {
+    std::mutex mutex;
+    std::condition_variable hasWork;
+    std::deque<Block> blocks;
+    bool finished{false};
+    bool aborted{false};
+  };
+
+  // Seals the in-progress block of 'partition' into its queue.
+  void sealBlock(int32_t partition);
+
+  // Accepts reader connections and spawns one push thread per accepted
+  // partition until the writer is destroyed.
+  void acceptLoop();
+
+  // Pushes the blocks of 'partition' into the connected reader's receive
+  // ring; runs on a per-connection thread.
+  void pushPartition(rdma_cm_id* id, int32_t partition);
+
+  const uint32_t numPartitions_;
+  const uint64_t blockBytes_;
+  velox::memory::MemoryPool* const pool_;
+
+  // Connection manager state of the block server.
+  rdma_event_channel* eventChannel_{nullptr};
+  rdma_cm_id* listener_{nullptr};
+  ibv_pd* pd_{nullptr};
+
+  std::unique_ptr<RdmaSlabPool> slabPool_;
+  std::vector<std::unique_ptr<PartitionQueue>> partitionQueues_;
+  std::vector<RdmaSlabPool::Slab> inProgressSlabs_;
+  std::vector<size_t> inProgressSizes_;
+
+  std::thread acceptThread_;
+  std::vector<std::thread> pushThreads_;
+  std::atomic<bool> closed_{false};
+
+  std::atomic<int64_t> blocksPushed_{0};
+  std::atomic<int64_t> bytesPushed_{0};
+};
+
+class RdmaShuffleReader : public ShuffleReader {
+ public:
+  RdmaShuffleReader(
+      std::vector<std::string> endpoints,
+      int32_t partition,
+      velox::memory::MemoryPool* pool);
+
+  ~RdmaShuffleReader() override;
+
+  folly::SemiFuture<std::vector<std::unique_ptr<ShuffleSerializedPage>>> next(
+      uint64_t maxBytes) override;
+
+  void noMoreData(bool success) override;
+
+  folly::F14FastMap<std::string, int64_t> stats() const override;
+
+ private:
+  // Connects to the next writer endpoint and advertises the receive ring.
+  // Returns false when all endpoints are drained.
+  bool connectNextEndpoint();
+
+  // Tears down the current connection and its ring registration.
+  void disconnect();
+
+  // Receives the next block from the current connection into 'buffer'.
+  // Returns false on end of the connection's partition stream.
+  bool receiveBlock(velox::BufferPtr& buffer);
+
+  const std::vector<std::string> endpoints_;
+  const int32_t partition_;
+  velox::memory::MemoryPool* const pool_;
+
+  size_t endpointIndex_{0};
+  rdma_cm_id* id_{nullptr};
+  // Receive ring: 'numSlots' contiguous slots of 'slabBytes' registered for
+  // remote write. The writer fills slot (sequence % numSlots).
+  velox::BufferPtr ring_;
+  ibv_mr* ringMr_{nullptr};
+  uint64_t nextSequence_{0};
+  bool atEnd_{false};
+
+  std::atomic<int64_t> blocksReceived_{0};
+  std::atomic<int64_t> bytesReceived_{0};
+};
+
+class RdmaShuffleFactory : public ShuffleInterfaceFactory {
+ public:
+  static constexpr folly::StringPiece kShuffleName{"rdma"};
+
+  std::shared_ptr<ShuffleReader> createReader(
+      const std::string& serializedStr,
+      int32_t partition,
+      velox::memory::MemoryPool* pool) override;
+
+  std::shared_ptr<ShuffleWriter> createWriter(
+      const std::string& serializedStr,
+      velox::memory::MemoryPool* pool) override;
+};
+
+} // namespace facebook::presto::operators
@@ -31,6 +31,21 @@ class ShuffleWriter {
   virtual void
   collect(int32_t partition, std::string_view key, std::string_view data) = 0;
 
+  /// Writes several rows of one partition at once. 'keys' and 'data' are
+  /// parallel vectors. Equivalent to calling collect() for each row in
+  /// order; shuffle implementations that pay a fixed cost per call
+  /// (locking, RPC framing) may override this to pay that cost once per
+  /// batch.
+  virtual void collectBatch(
+      int32_t partition,
+      const std::vector<std::string_view>& keys,
+      const std::vector<std::string_view>& data) {
+    VELOX_CHECK_EQ(keys.size(), data.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      collect(partition, keys[i], data[i]);
+    }
+  }
+
   /// Tell the shuffle system the writer is done.
   /// @param success set to false to indicate aborted client.
   virtual void noMoreData(bool success) = 0;
@@ -12,6 +12,7 @@
  * limitations under the License.
  */
 #include "presto_cpp/main/operators/ShuffleRead.h"
+#include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/operators/ShuffleExchangeSource.h"
 #include "velox/common/Casts.h"
 #include "velox/row/CompactRow.h"
@@ -37,10 +38,24 @@ ShuffleRead::ShuffleRead(
               shuffleReadNode->outputType(),
               VectorSerde::Kind::kCompactRow),
           exchangeClient,
-          "ShuffleRead") {
+          "ShuffleRead"),
+      prefetchMinColumns_(
+          SystemConfig::instance()->exchangeWideRowDecodePrefetchMinColumns()) {
   initStats();
 }
 
+void ShuffleRead::prefetchRowsForDecode(size_t beginRow, size_t endRow) const {
+  static constexpr size_t kCacheLineBytes = 64;
+  for (auto i = beginRow; i < endRow; ++i) {
+    const auto& row = rows_[i];
+    for (size_t offset = 0; offset < row.size(); offset += kCacheLineBytes) {
+      // Read prefetch with low temporal locality: each line is consumed once
+      // per column pass and must not evict the hotter decode state.
+      __builtin_prefetch(row.data() + offset, 0, 1);
+    }
+  }
+}
+
 void ShuffleRead::initStats() {
   VELOX_CHECK(runtimeStats_.empty());
   runtimeStats_.insert(
@@ -109,6 +124,10 @@ RowVectorPtr ShuffleRead::getOutput() {
   }
   numOutputRows = std::min<uint64_t>(numOutputRows, rows_.size() - nextRow_);
 
+  if (prefetchMinColumns_ > 0 && outputType_->size() >= prefetchMinColumns_) {
+    prefetchRowsForDecode(nextRow_, nextRow_ + numOutputRows);
+  }
+
   uint64_t decodeTimeNs{0};
   {
     velox::NanosecondTimer timer(&decodeTimeNs);
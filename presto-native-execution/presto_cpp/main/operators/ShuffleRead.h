@@ -118,6 +118,16 @@ class ShuffleRead : public velox::exec::Exchange {
 
   void resetOutputState();
 
+  // Issues software prefetches over the serialized rows about to be handed
+  // to the compact-row deserializer. Wide schemas revisit each row once per
+  // column, so pulling the row bytes into cache ahead of the column walk
+  // hides the scattered loads; narrow schemas stream well already and skip
+  // this (see 'exchange.wide-row-decode-prefetch-min-columns').
+  void prefetchRowsForDecode(size_t beginRow, size_t endRow) const;
+
+  // Column count at and above which decode prefetch kicks in; 0 disables it.
+  const uint32_t prefetchMinColumns_;
+
   int64_t numInputBatches_{0};
   std::unordered_map<std::string, velox::RuntimeMetric> runtimeStats_;
 
@@ -12,6 +12,7 @@
  * limitations under the License.
  */
 #include "presto_cpp/main/operators/ShuffleWrite.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/ExchangeClient.h"
 
 using namespace facebook::velox::exec;
@@ -45,7 +46,13 @@ class ShuffleWrite : public Operator {
             planNode->id(),
             "ShuffleWrite"),
         numPartitions_{planNode->numPartitions()},
-        serializedShuffleWriteInfo_{planNode->serializedShuffleWriteInfo()} {
+        serializedShuffleWriteInfo_{planNode->serializedShuffleWriteInfo()},
+        combineThresholdBytes_{ctx->queryConfig().get<uint64_t>(
+            kShuffleWriteCombineThresholdBytes,
+            0)},
+        combineMaxAgeMs_{ctx->queryConfig().get<uint64_t>(
+            kShuffleWriteCombineMaxAgeMs,
+            kShuffleWriteCombineMaxAgeMsDefault)} {
     const auto& shuffleName = planNode->shuffleName();
     shuffleFactory_ = ShuffleInterfaceFactory::factory(shuffleName);
     VELOX_CHECK_NOT_NULL(
@@ -53,6 +60,9 @@ class ShuffleWrite : public Operator {
         "Failed to create shuffle write interface: Shuffle factory "
         "with name '{}' is not registered.",
         shuffleName);
+    if (combineThresholdBytes_ > 0) {
+      stagedPartitions_.resize(numPartitions_);
+    }
   }
 
   bool needsInput() const override {
@@ -83,27 +93,65 @@ class ShuffleWrite : public Operator {
           input->childAt(kReplicateNullsAndAny)->as<SimpleVector<bool>>();
     }
 
-    for (auto i = 0; i < input->size(); ++i) {
+    for (vector_size_t i = 0; i < input->size();) {
       auto data = serializedData->valueAt(i);
       auto key = serializedKeys->valueAt(i);
       if (replicate && replicate->valueAt(i)) {
         for (auto partition = 0; partition < numPartitions_; ++partition) {
-          CALL_SHUFFLE(
-              shuffle_->collect(
-                  partition,
-                  std::string_view(key.data(), key.size()),
-                  std::string_view(data.data(), data.size())),
-              "collect");
+          writeRow(
+              partition,
+              std::string_view(key.data(), key.size()),
+              std::string_view(data.data(), data.size()));
         }
+        ++i;
+        continue;
+      }
+      const auto partition = partitions->valueAt(i);
+      if (!stagedPartitions_.empty()) {
+        // Write combining batches per destination on its own; no need to
+        // look for runs.
+        writeRow(
+            partition,
+            std::string_view(key.data(), key.size()),
+            std::string_view(data.data(), data.size()));
+        ++i;
+        continue;
+      }
+      // Partition-clustered input arrives as runs of rows for the same
+      // destination; hand each run to the shuffle as one batch. Unclustered
+      // input degrades to runs of length one and is written row by row as
+      // before.
+      vector_size_t runEnd = i + 1;
+      while (runEnd < input->size() &&
+             !(replicate && replicate->valueAt(runEnd)) &&
+             partitions->valueAt(runEnd) == partition) {
+        ++runEnd;
+      }
+      if (runEnd - i == 1) {
+        writeRow(
+            partition,
+            std::string_view(key.data(), key.size()),
+            std::string_view(data.data(), data.size()));
       } else {
-        auto partition = partitions->valueAt(i);
+        flushKeys_.clear();
+        flushData_.clear();
+        flushKeys_.reserve(runEnd - i);
+        flushData_.reserve(runEnd - i);
+        for (auto row = i; row < runEnd; ++row) {
+          const auto runKey = serializedKeys->valueAt(row);
+          const auto runData = serializedData->valueAt(row);
+          flushKeys_.emplace_back(runKey.data(), runKey.size());
+          flushData_.emplace_back(runData.data(), runData.size());
+        }
         CALL_SHUFFLE(
-            shuffle_->collect(
-                partition,
-                std::string_view(key.data(), key.size()),
-                std::string_view(data.data(), data.size())),
-            "collect");
+            shuffle_->collectBatch(partition, flushKeys_, flushData_),
+            "collectBatch");
+        clusteredRunRows_.addValue(runEnd - i);
       }
+      i = runEnd;
+    }
+    if (!stagedPartitions_.empty()) {
+      flushAgedPartitions();
     }
     auto lockedStats = stats_.wlock();
     lockedStats->addOutputVector(input->estimateFlatSize(), input->size());
@@ -113,6 +161,11 @@ class ShuffleWrite : public Operator {
     Operator::noMoreInput();
 
     checkCreateShuffleWriter();
+    if (!stagedPartitions_.empty()) {
+      for (auto partition = 0; partition < numPartitions_; ++partition) {
+        flushPartition(partition, /*agedOut=*/false);
+      }
+    }
     CALL_SHUFFLE(shuffle_->noMoreData(true), "noMoreData");
 
     recordShuffleWriteClientStats();
@@ -151,6 +204,17 @@ class ShuffleWrite : public Operator {
       lockedStats->backgroundTiming.clear();
       lockedStats->backgroundTiming.add(backgroundTiming);
     }
+
+    if (combinedBatchBytes_.count > 0) {
+      lockedStats->runtimeStats["shuffleWriteCombinedBatchBytes"] =
+          combinedBatchBytes_;
+      lockedStats->runtimeStats["shuffleWriteCombineAgedBatches"] =
+          agedBatches_;
+    }
+    if (clusteredRunRows_.count > 0) {
+      lockedStats->runtimeStats["shuffleWriteClusteredRunRows"] =
+          clusteredRunRows_;
+    }
   }
 
   RowVectorPtr getOutput() override {
@@ -166,6 +230,17 @@ class ShuffleWrite : public Operator {
   }
 
  private:
+  // Rows staged for one destination while write combining is enabled. Key
+  // and data bytes are appended back to back into 'bytes' so a staged
+  // partition owns a single allocation regardless of row count.
+  struct Staging {
+    std::string bytes;
+    // (key size, data size) per staged row, in arrival order.
+    std::vector<std::pair<uint32_t, uint32_t>> rowSizes;
+    // When the oldest staged row arrived, for the age-based flush.
+    uint64_t oldestRowMs{0};
+  };
+
   void checkCreateShuffleWriter() {
     if (shuffle_ == nullptr) {
       shuffle_ = shuffleFactory_->createWriter(
@@ -173,10 +248,89 @@ class ShuffleWrite : public Operator {
     }
   }
 
+  // Routes one row to 'partition': staged for a combined collectBatch()
+  // call when write combining is enabled, written through otherwise.
+  void writeRow(int32_t partition, std::string_view key, std::string_view data) {
+    if (stagedPartitions_.empty()) {
+      CALL_SHUFFLE(shuffle_->collect(partition, key, data), "collect");
+      return;
+    }
+    auto& staging = stagedPartitions_[partition];
+    if (staging.rowSizes.empty()) {
+      staging.oldestRowMs = getCurrentTimeMs();
+    }
+    staging.bytes.append(key);
+    staging.bytes.append(data);
+    staging.rowSizes.emplace_back(key.size(), data.size());
+    if (staging.bytes.size() >= combineThresholdBytes_) {
+      flushPartition(partition, /*agedOut=*/false);
+    }
+  }
+
+  // Hands the rows staged for 'partition' to the shuffle writer as one
+  // batch and resets the staging slot, keeping its capacity for reuse.
+  void flushPartition(int32_t partition, bool agedOut) {
+    auto& staging = stagedPartitions_[partition];
+    if (staging.rowSizes.empty()) {
+      return;
+    }
+    flushKeys_.clear();
+    flushData_.clear();
+    flushKeys_.reserve(staging.rowSizes.size());
+    flushData_.reserve(staging.rowSizes.size());
+    const char* pos = staging.bytes.data();
+    for (const auto& [keySize, dataSize] : staging.rowSizes) {
+      flushKeys_.emplace_back(pos, keySize);
+      pos += keySize;
+      flushData_.emplace_back(pos, dataSize);
+      pos += dataSize;
+    }
+    CALL_SHUFFLE(
+        shuffle_->collectBatch(partition, flushKeys_, flushData_),
+        "collectBatch");
+    combinedBatchBytes_.addValue(staging.bytes.size());
+    if (agedOut) {
+      agedBatches_.addValue(1);
+    }
+    staging.bytes.clear();
+    staging.rowSizes.clear();
+  }
+
+  // Flushes partitions whose oldest staged row has waited longer than
+  // 'combineMaxAgeMs_', bounding how long a slow destination can hold rows
+  // back from the shuffle.
+  void flushAgedPartitions() {
+    const auto nowMs = getCurrentTimeMs();
+    for (auto partition = 0; partition < numPartitions_; ++partition) {
+      const auto& staging = stagedPartitions_[partition];
+      if (!staging.rowSizes.empty() &&
+          nowMs - staging.oldestRowMs >= combineMaxAgeMs_) {
+        flushPartition(partition, /*agedOut=*/true);
+      }
+    }
+  }
+
   const uint32_t numPartitions_;
   const std::string serializedShuffleWriteInfo_;
+  // Per-destination bytes staged before rows are handed to the shuffle in
+  // one batch; 0 writes rows through as they arrive.
+  const uint64_t combineThresholdBytes_;
+  // Maximum milliseconds staged rows may wait before an age-based flush.
+  const uint64_t combineMaxAgeMs_;
   ShuffleInterfaceFactory* shuffleFactory_;
   std::shared_ptr<ShuffleWriter> shuffle_;
+  // One staging slot per destination partition; empty when write combining
+  // is disabled.
+  std::vector<Staging> stagedPartitions_;
+  // Scratch row views rebuilt for each collectBatch() call.
+  std::vector<std::string_view> flushKeys_;
+  std::vector<std::string_view> flushData_;
+  // Bytes per combined batch handed to the shuffle writer.
+  RuntimeMetric combinedBatchBytes_{RuntimeCounter::Unit::kBytes};
+  // Number of batches flushed by the age bound rather than the threshold.
+  RuntimeMetric agedBatches_;
+  // Rows per partition run handed to the shuffle as one batch.
+  RuntimeMetric clusteredRunRows_;
 };
 
 #undef CALL_SHUFFLE
@@ -19,6 +19,26 @@
 
 namespace facebook::presto::operators {
 
+/// Query config key controlling write combining in the ShuffleWrite
+/// operator, exposed to coordinators as a session property by
+/// SessionProperties. When non-zero, rows are staged per destination
+/// partition and handed to the shuffle writer in one collectBatch() call
+/// once the staged bytes reach this threshold, so many-partition shuffles
+/// produce fewer, larger writes. Zero disables staging and writes each row
+/// as it arrives.
+constexpr const char* kShuffleWriteCombineThresholdBytes =
+    "shuffle_write_combine_threshold_bytes";
+
+/// Maximum milliseconds rows may wait in write-combining staging before
+/// they are flushed regardless of the threshold. Ages are checked after
+/// each input batch, so the bound is only as tight as the operator's input
+/// cadence.
+constexpr const char* kShuffleWriteCombineMaxAgeMs =
+    "shuffle_write_combine_max_age_ms";
+
+/// Default for kShuffleWriteCombineMaxAgeMs.
+constexpr uint64_t kShuffleWriteCombineMaxAgeMsDefault = 100;
+
 class ShuffleWriteNode : public velox::core::PlanNode {
  public:
   ShuffleWriteNode(
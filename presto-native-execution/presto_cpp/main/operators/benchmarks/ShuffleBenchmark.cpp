@@ -0,0 +1,334 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <random>
+
+#include "presto_cpp/main/operators/LocalShuffle.h"
+#include "presto_cpp/main/operators/PartitionAndSerialize.h"
+#include "presto_cpp/main/operators/ShuffleExchangeSource.h"
+#include "presto_cpp/main/operators/ShuffleRead.h"
+#include "presto_cpp/main/operators/ShuffleWrite.h"
+#include "presto_cpp/main/operators/tests/PlanBuilder.h"
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Exchange.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+using namespace facebook::velox;
+
+namespace facebook::presto::operators {
+namespace {
+
+/// End-to-end shuffle benchmark: PartitionAndSerialize -> ShuffleWrite ->
+/// local persistent shuffle -> ShuffleRead, over generated data sweeping
+/// row width, key cardinality, key skew and partition counts. Each
+/// benchmark reports per-stage throughput as counters:
+///   write_krows_per_sec / write_mb_per_sec  - map side, input rows and
+///     serialized shuffle bytes over the write stage wall time.
+///   read_krows_per_sec / read_mb_per_sec    - reduce side, over the
+///     combined wall time of the per-partition read tasks.
+
+// Shape of the generated data. Keys are drawn from 'keyCardinality'
+// distinct values, uniformly when 'zipfExponent' is zero and with a zipf
+// distribution otherwise (larger exponent = heavier skew towards few hot
+// keys). Every row carries a 'payloadWidth'-byte varchar payload.
+struct DataSpec {
+  vector_size_t rowsPerBatch{10'000};
+  int32_t numBatches{20};
+  int32_t payloadWidth{64};
+  int32_t keyCardinality{100'000};
+  double zipfExponent{0};
+};
+
+std::string localShuffleWriteInfo(
+    const std::string& rootPath,
+    uint32_t numPartitions) {
+  return LocalShuffleWriteInfo{
+      .rootPath = rootPath,
+      .queryId = "query_id",
+      .numPartitions = numPartitions,
+      .shuffleId = 0,
+      .sortedShuffle = false}
+      .serialize();
+}
+
+std::string localShuffleReadInfo(
+    const std::string& rootPath,
+    uint32_t partition) {
+  return LocalShuffleReadInfo{
+      .rootPath = rootPath,
+      .queryId = "query_id",
+      .partitionIds = {fmt::format("shuffle_0_0_{}", partition)},
+      .sortedShuffle = false}
+      .serialize();
+}
+
+class ShuffleBenchmark {
+ public:
+  ShuffleBenchmark(const DataSpec& spec, uint32_t numPartitions)
+      : numPartitions_{numPartitions} {
+    folly::BenchmarkSuspender suspender;
+    makeData(spec);
+  }
+
+  // Runs one write + read round trip and folds the per-stage rates into
+  // 'counters'.
+  void run(folly::UserCounters& counters) {
+    folly::BenchmarkSuspender suspender;
+    auto tempDir = exec::test::TempDirectoryPath::create();
+    const auto& rootPath = tempDir->getPath();
+    suspender.dismiss();
+
+    uint64_t writeMicros{0};
+    {
+      MicrosecondTimer timer(&writeMicros);
+      runWriteStage(rootPath);
+    }
+    const auto shuffleBytes = listShuffleBytes(rootPath);
+
+    uint64_t readMicros{0};
+    uint64_t readRows{0};
+    {
+      MicrosecondTimer timer(&readMicros);
+      readRows = runReadStage(rootPath);
+    }
+    VELOX_CHECK_EQ(readRows, numRows_);
+
+    counters["write_krows_per_sec"] =
+        numRows_ * 1'000 / std::max<uint64_t>(writeMicros, 1);
+    counters["write_mb_per_sec"] =
+        shuffleBytes / std::max<uint64_t>(writeMicros, 1);
+    counters["read_krows_per_sec"] =
+        readRows * 1'000 / std::max<uint64_t>(readMicros, 1);
+    counters["read_mb_per_sec"] =
+        shuffleBytes / std::max<uint64_t>(readMicros, 1);
+
+    suspender.rehire();
+    cleanupDirectory(rootPath);
+  }
+
+ private:
+  static constexpr std::string_view kShuffleName =
+      LocalPersistentShuffleFactory::kShuffleName;
+
+  void makeData(const DataSpec& spec) {
+    // Fixed seed for run-to-run comparability.
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32_t> uniformKeys(
+        0, spec.keyCardinality - 1);
+    // Unnormalized zipf weights over the key domain; discrete_distribution
+    // normalizes them.
+    std::discrete_distribution<int32_t> zipfKeys;
+    if (spec.zipfExponent > 0) {
+      std::vector<double> weights(spec.keyCardinality);
+      for (int32_t i = 0; i < spec.keyCardinality; ++i) {
+        weights[i] = 1.0 / std::pow(i + 1, spec.zipfExponent);
+      }
+      zipfKeys = std::discrete_distribution<int32_t>(
+          weights.begin(), weights.end());
+    }
+    std::uniform_int_distribution<int32_t> payloadChars('a', 'z');
+
+    auto rowType = ROW({"c0", "c1"}, {INTEGER(), VARCHAR()});
+    std::string payload(spec.payloadWidth, 'x');
+    for (auto batch = 0; batch < spec.numBatches; ++batch) {
+      auto keys = BaseVector::create<FlatVector<int32_t>>(
+          INTEGER(), spec.rowsPerBatch, pool_.get());
+      auto payloads = BaseVector::create<FlatVector<StringView>>(
+          VARCHAR(), spec.rowsPerBatch, pool_.get());
+      for (vector_size_t row = 0; row < spec.rowsPerBatch; ++row) {
+        keys->set(
+            row,
+            spec.zipfExponent > 0 ? zipfKeys(rng) : uniformKeys(rng));
+        for (auto& c : payload) {
+          c = static_cast<char>(payloadChars(rng));
+        }
+        payloads->set(row, StringView(payload));
+      }
+      data_.push_back(std::make_shared<RowVector>(
+          pool_.get(),
+          rowType,
+          BufferPtr(nullptr),
+          spec.rowsPerBatch,
+          std::vector<VectorPtr>{std::move(keys), std::move(payloads)}));
+    }
+    numRows_ = static_cast<uint64_t>(spec.rowsPerBatch) * spec.numBatches;
+  }
+
+  void runWriteStage(const std::string& rootPath) {
+    auto writerPlan =
+        exec::test::PlanBuilder()
+            .values(data_)
+            .addNode(addPartitionAndSerializeNode(
+                numPartitions_, /*replicateNullsAndAny=*/false))
+            .localPartition(std::vector<std::string>{})
+            .addNode(addShuffleWriteNode(
+                numPartitions_,
+                std::string(kShuffleName),
+                localShuffleWriteInfo(rootPath, numPartitions_)))
+            .planNode();
+    exec::CursorParameters params;
+    params.planNode = writerPlan;
+    exec::test::readCursor(params);
+  }
+
+  uint64_t runReadStage(const std::string& rootPath) {
+    const auto dataType = asRowType(data_[0]->type());
+    uint64_t numRows = 0;
+    for (uint32_t partition = 0; partition < numPartitions_; ++partition) {
+      auto plan = exec::test::PlanBuilder()
+                      .addNode(addShuffleReadNode(dataType))
+                      .project(dataType->names())
+                      .planNode();
+      exec::CursorParameters params;
+      params.planNode = plan;
+      params.destination = partition;
+
+      const auto readInfo = localShuffleReadInfo(rootPath, partition);
+      auto [taskCursor, results] =
+          exec::test::readCursor(params, [&](exec::TaskCursor* taskCursor) {
+            if (taskCursor->noMoreSplits()) {
+              return;
+            }
+            auto remoteSplit = std::make_shared<exec::RemoteConnectorSplit>(
+                fmt::format("batch://read-0?shuffleInfo={}", readInfo));
+            taskCursor->task()->addSplit("0", exec::Split{remoteSplit});
+            taskCursor->task()->noMoreSplits("0");
+            taskCursor->setNoMoreSplits();
+          });
+      for (const auto& result : results) {
+        numRows += result->size();
+      }
+    }
+    return numRows;
+  }
+
+  // Sums the sizes of the shuffle files, i.e. the serialized bytes that
+  // crossed the shuffle.
+  uint64_t listShuffleBytes(const std::string& rootPath) const {
+    auto fileSystem = filesystems::getFileSystem(rootPath, nullptr);
+    uint64_t bytes = 0;
+    for (const auto& file : fileSystem->list(rootPath)) {
+      bytes += fileSystem->openFileForRead(file)->size();
+    }
+    return bytes;
+  }
+
+  void cleanupDirectory(const std::string& rootPath) const {
+    auto fileSystem = filesystems::getFileSystem(rootPath, nullptr);
+    for (const auto& file : fileSystem->list(rootPath)) {
+      fileSystem->remove(file);
+    }
+  }
+
+  const uint32_t numPartitions_;
+  std::shared_ptr<memory::MemoryPool> rootPool_{
+      memory::memoryManager()->addRootPool()};
+  std::shared_ptr<memory::MemoryPool> pool_{
+      rootPool_->addLeafChild("benchmark")};
+  std::vector<RowVectorPtr> data_;
+  uint64_t numRows_{0};
+};
+
+BENCHMARK_DRAW_TEXT("=============Uniform keys=============");
+
+BENCHMARK_COUNTERS(uniformNarrowRows, counters) {
+  ShuffleBenchmark benchmark({.payloadWidth = 16}, 8);
+  benchmark.run(counters);
+}
+
+BENCHMARK_COUNTERS(uniformWideRows, counters) {
+  ShuffleBenchmark benchmark({.payloadWidth = 512}, 8);
+  benchmark.run(counters);
+}
+
+BENCHMARK_COUNTERS(uniformLowCardinality, counters) {
+  ShuffleBenchmark benchmark({.keyCardinality = 16}, 8);
+  benchmark.run(counters);
+}
+
+BENCHMARK_DRAW_TEXT("=============Skewed keys=============");
+
+BENCHMARK_COUNTERS(zipfModerateSkew, counters) {
+  ShuffleBenchmark benchmark({.zipfExponent = 1.0}, 8);
+  benchmark.run(counters);
+}
+
+BENCHMARK_COUNTERS(zipfHeavySkew, counters) {
+  ShuffleBenchmark benchmark({.zipfExponent = 1.5}, 8);
+  benchmark.run(counters);
+}
+
+BENCHMARK_DRAW_TEXT("=============Partition counts=============");
+
+BENCHMARK_COUNTERS(partitions2, counters) {
+  ShuffleBenchmark benchmark({}, 2);
+  benchmark.run(counters);
+}
+
+BENCHMARK_COUNTERS(partitions32, counters) {
+  ShuffleBenchmark benchmark({}, 32);
+  benchmark.run(counters);
+}
+
+BENCHMARK_COUNTERS(partitions128, counters) {
+  ShuffleBenchmark benchmark({}, 128);
+  benchmark.run(counters);
+}
+
+} // namespace
+
+void registerShuffleBenchmarkComponents() {
+  filesystems::registerLocalFileSystem();
+  exec::Operator::registerOperator(
+      std::make_unique<PartitionAndSerializeTranslator>());
+  exec::Operator::registerOperator(std::make_unique<ShuffleWriteTranslator>());
+  exec::Operator::registerOperator(std::make_unique<ShuffleReadTranslator>());
+  const std::string shuffleName{LocalPersistentShuffleFactory::kShuffleName};
+  ShuffleInterfaceFactory::registerFactory(
+      shuffleName, std::make_unique<LocalPersistentShuffleFactory>());
+  exec::ExchangeSource::registerFactory(
+      [shuffleName](
+          const std::string& taskId,
+          int destination,
+          const std::shared_ptr<exec::ExchangeQueue>& queue,
+          memory::MemoryPool* pool) -> std::shared_ptr<exec::ExchangeSource> {
+        if (!taskId.starts_with("batch://")) {
+          return nullptr;
+        }
+        const auto readInfo = taskId.substr(taskId.find("shuffleInfo=") + 12);
+        return std::make_shared<ShuffleExchangeSource>(
+            taskId,
+            destination,
+            queue,
+            ShuffleInterfaceFactory::factory(shuffleName)
+                ->createReader(readInfo, destination, pool),
+            pool);
+      });
+}
+
+} // namespace facebook::presto::operators
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  facebook::velox::memory::MemoryManager::initialize(
+      facebook::velox::memory::MemoryManager::Options{});
+  facebook::presto::operators::registerShuffleBenchmarkComponents();
+  folly::runBenchmarks();
+  return 0;
+}
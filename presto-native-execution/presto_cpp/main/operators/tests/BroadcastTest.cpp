@@ -12,8 +12,11 @@
  * limitations under the License.
  */
 #include <boost/algorithm/string/join.hpp>
+#include <folly/ScopeGuard.h>
 #include <folly/Uri.h>
+#include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/common/Exception.h"
+#include "presto_cpp/main/common/tests/MutableConfigs.h"
 #include "presto_cpp/main/operators/BroadcastExchangeSource.h"
 #include "presto_cpp/main/operators/BroadcastFile.h"
 #include "presto_cpp/main/operators/BroadcastWrite.h"
@@ -311,6 +314,74 @@ TEST_P(BroadcastTest, endToEndWithMultipleWriteNodes) {
   velox::exec::test::assertEqualResults(dataVector, broadcastReadResults);
 }
 
+TEST_P(BroadcastTest, pipelinedWrite) {
+  // A tiny byte budget forces the driver to block on the write pipeline
+  // between batches, exercising the budget and drain paths.
+  facebook::presto::test::setupMutableSystemConfig();
+  SystemConfig::instance()->setValue(
+      std::string(SystemConfig::kBroadcastFileWriterMaxBufferedBytes), "1024");
+  SCOPE_EXIT {
+    SystemConfig::instance()->setValue(
+        std::string(SystemConfig::kBroadcastFileWriterMaxBufferedBytes), "0");
+  };
+
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 16; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [i](auto row) { return i * 1'000 + row; }),
+        makeFlatVector<std::string>(
+            1'000,
+            [](auto row) { return fmt::format("row-{}", row); }),
+    }));
+  }
+  runBroadcastTest(data);
+}
+
+TEST_P(BroadcastTest, writeRuntimeStats) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>({1, 2, 3, 4, 5, 6}),
+      makeFlatVector<int64_t>({10, 20, 30, 40, 50, 60}),
+  });
+  auto tempDirectoryPath = exec::test::TempDirectoryPath::create();
+  auto writerPlan = exec::test::PlanBuilder()
+                        .values({data}, true)
+                        .addNode(addBroadcastWriteNode(
+                            tempDirectoryPath->getPath(),
+                            std::numeric_limits<uint64_t>::max(),
+                            std::nullopt))
+                        .planNode();
+  exec::CursorParameters params;
+  params.planNode = writerPlan;
+  std::unordered_map<std::string, std::string> configs;
+  configs[core::QueryConfig::kShuffleCompressionKind] =
+      common::compressionKindToString(GetParam().compressionKind);
+  params.queryCtx = core::QueryCtx::create(
+      executor_.get(), core::QueryConfig(std::move(configs)));
+
+  auto [taskCursor, results] = exec::test::readCursor(params);
+
+  const auto taskStats = taskCursor->task()->taskStats();
+  const exec::OperatorStats* broadcastWriteStats = nullptr;
+  for (const auto& pipelineStats : taskStats.pipelines) {
+    for (const auto& opStats : pipelineStats.operatorStats) {
+      if (opStats.operatorType == "BroadcastWrite") {
+        broadcastWriteStats = &opStats;
+      }
+    }
+  }
+  ASSERT_NE(broadcastWriteStats, nullptr);
+
+  const auto& runtimeStats = broadcastWriteStats->runtimeStats;
+  ASSERT_EQ(runtimeStats.count(kBroadcastWriteBytes), 1);
+  EXPECT_GT(runtimeStats.at(kBroadcastWriteBytes).sum, 0);
+  EXPECT_EQ(
+      runtimeStats.at(kBroadcastWriteBytes).unit,
+      RuntimeCounter::Unit::kBytes);
+  ASSERT_EQ(runtimeStats.count(kBroadcastWriteSerializedBytes), 1);
+  EXPECT_GT(runtimeStats.at(kBroadcastWriteSerializedBytes).sum, 0);
+}
+
 TEST_P(BroadcastTest, invalidFileSystem) {
   auto data = makeRowVector({
       makeFlatVector<int32_t>({1, 2, 3, 4, 5, 6}),
@@ -379,6 +450,47 @@ TEST_P(BroadcastTest, malformedBroadcastInfoJson) {
       "BroadcastInfo deserialization failed");
 }
 
+TEST_P(BroadcastTest, replicaReadPathSelection) {
+  auto tempDirectoryPath = exec::test::TempDirectoryPath::create();
+  auto fileSystem =
+      velox::filesystems::getFileSystem(tempDirectoryPath->getPath(), nullptr);
+
+  const auto primaryPath = tempDirectoryPath->getPath() + "/primary.bin";
+  const auto replicaPath = tempDirectoryPath->getPath() + "/replica.bin";
+  for (const auto& path : {primaryPath, replicaPath}) {
+    auto file = fileSystem->openFileForWrite(path);
+    file->append("broadcast");
+    file->close();
+  }
+
+  // Without replicas every consumer reads the primary path.
+  auto info = BroadcastFileInfo::deserialize(
+      fmt::format("{{\"filePath\": \"{}\"}}", primaryPath));
+  ASSERT_TRUE(info->replicaFilePaths_.empty());
+  ASSERT_EQ(BroadcastExchangeSource::selectReadPath(*info, 0), primaryPath);
+  ASSERT_EQ(BroadcastExchangeSource::selectReadPath(*info, 1), primaryPath);
+
+  // With one replica, consumers alternate between the two copies.
+  info = BroadcastFileInfo::deserialize(
+      fmt::format(
+          "{{\"filePath\": \"{}\", \"replicaFilePaths\": [\"{}\"]}}",
+          primaryPath,
+          replicaPath));
+  ASSERT_EQ(info->replicaFilePaths_.size(), 1);
+  ASSERT_EQ(BroadcastExchangeSource::selectReadPath(*info, 0), primaryPath);
+  ASSERT_EQ(BroadcastExchangeSource::selectReadPath(*info, 1), replicaPath);
+  ASSERT_EQ(BroadcastExchangeSource::selectReadPath(*info, 2), primaryPath);
+  ASSERT_EQ(BroadcastExchangeSource::selectReadPath(*info, 3), replicaPath);
+
+  // A missing replica falls back to the primary path.
+  info = BroadcastFileInfo::deserialize(
+      fmt::format(
+          "{{\"filePath\": \"{}\", \"replicaFilePaths\": [\"{}\"]}}",
+          primaryPath,
+          tempDirectoryPath->getPath() + "/missing.bin"));
+  ASSERT_EQ(BroadcastExchangeSource::selectReadPath(*info, 1), primaryPath);
+}
+
 TEST_P(BroadcastTest, broadcastFileWriter) {
   auto tempDirectoryPath = exec::test::TempDirectoryPath::create();
   auto fileSystem =
@@ -651,6 +763,73 @@ TEST_P(BroadcastTest, endToEndWithDifferentWriterPageSizes) {
   }
 }
 
+TEST_P(BroadcastTest, mmapReader) {
+  auto tempDirectoryPath = exec::test::TempDirectoryPath::create();
+  auto fileSystem =
+      velox::filesystems::getFileSystem(tempDirectoryPath->getPath(), nullptr);
+  fileSystem->mkdir(tempDirectoryPath->getPath());
+
+  auto filePath =
+      fmt::format("{}/broadcast_mmap_test", tempDirectoryPath->getPath());
+
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          1'000,
+          [](auto row) { return fmt::format("mmap_test_string_{}", row); }),
+  });
+
+  auto writer = std::make_unique<BroadcastFileWriter>(
+      filePath,
+      std::numeric_limits<uint64_t>::max(),
+      4 << 10,
+      getVectorSerdeOptions(GetParam().compressionKind),
+      pool());
+  writer->write(data);
+  writer->noMoreData();
+  auto fileStats = writer->fileStats();
+  ASSERT_NE(fileStats, nullptr);
+  auto createdFilePath =
+      fileStats->childAt(0)->as<SimpleVector<StringView>>()->valueAt(0).str();
+
+  // Read the file with the buffered reader as the reference.
+  auto bufferedFileInfo = std::make_unique<BroadcastFileInfo>();
+  bufferedFileInfo->filePath_ = createdFilePath;
+  auto bufferedReader = std::make_shared<BroadcastFileReader>(
+      bufferedFileInfo, fileSystem, pool());
+  std::vector<std::string> expectedPages;
+  while (bufferedReader->hasNext()) {
+    auto page = bufferedReader->next();
+    expectedPages.emplace_back(page->as<char>(), page->size());
+  }
+  ASSERT_FALSE(expectedPages.empty());
+
+  // The mmap reader must serve the same pages as views over the mapping.
+  auto mmapFileInfo = std::make_unique<BroadcastFileInfo>();
+  mmapFileInfo->filePath_ = createdFilePath;
+  auto mmapReader = std::make_shared<BroadcastFileReader>(
+      mmapFileInfo,
+      fileSystem,
+      pool(),
+      /*prefetchDepth=*/0,
+      /*cacheMaxBytes=*/0,
+      /*mmapEnabled=*/true);
+  std::vector<BufferPtr> mmapPages;
+  while (mmapReader->hasNext()) {
+    mmapPages.push_back(mmapReader->next());
+  }
+  ASSERT_EQ(mmapPages.size(), expectedPages.size());
+  ASSERT_GT(mmapReader->stats().at("broadcastExchangeSource.mmapBytes"), 0);
+
+  // The page views must pin the mapping past the reader's lifetime.
+  mmapReader.reset();
+  for (size_t i = 0; i < mmapPages.size(); ++i) {
+    ASSERT_EQ(
+        std::string_view(mmapPages[i]->as<char>(), mmapPages[i]->size()),
+        expectedPages[i]);
+  }
+}
+
 TEST_P(BroadcastTest, exceedBroadcastFileWriterLimit) {
   auto tempDirectoryPath = exec::test::TempDirectoryPath::create();
   auto fileSystem =
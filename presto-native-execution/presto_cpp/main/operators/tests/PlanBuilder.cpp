@@ -30,12 +30,14 @@ addPartitionAndSerializeNode(
     const std::vector<std::string>& serializedColumns,
     const std::optional<std::vector<velox::core::SortOrder>>& sortOrders,
     const std::optional<std::vector<velox::core::FieldAccessTypedExprPtr>>&
-        fields) {
+        fields,
+    bool partitionClusteredOutput) {
   return [numPartitions,
           &serializedColumns,
           replicateNullsAndAny,
           &sortOrders,
-          &fields](
+          &fields,
+          partitionClusteredOutput](
              core::PlanNodeId nodeId,
              core::PlanNodePtr source) -> core::PlanNodePtr {
     std::vector<core::TypedExprPtr> keys{
@@ -62,7 +64,8 @@ addPartitionAndSerializeNode(
         std::make_shared<exec::HashPartitionFunctionSpec>(
             inputType, exec::toChannels(inputType, keys)),
         sortOrders,
-        fields);
+        fields,
+        partitionClusteredOutput);
   };
 }
 
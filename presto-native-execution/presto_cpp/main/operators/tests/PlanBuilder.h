@@ -29,7 +29,8 @@ addPartitionAndSerializeNode(
     const std::optional<std::vector<velox::core::SortOrder>>& sortOrders =
         std::nullopt,
     const std::optional<std::vector<velox::core::FieldAccessTypedExprPtr>>&
-        fields = std::nullopt);
+        fields = std::nullopt,
+    bool partitionClusteredOutput = false);
 
 std::function<
     velox::core::PlanNodePtr(std::string nodeId, velox::core::PlanNodePtr)>
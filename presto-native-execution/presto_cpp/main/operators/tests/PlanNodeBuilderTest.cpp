@@ -67,6 +67,7 @@ TEST(PlanNodeBuilderTest, testPartitionAndSerialize) {
   const std::vector<core::SortOrder> sortingOrders{core::kAscNullsFirst};
   const std::vector<core::FieldAccessTypedExprPtr> sortingKeys{
       std::make_shared<core::FieldAccessTypedExpr>(INTEGER(), "col1")};
+  const bool partitionClusteredOutput = true;
 
   const auto verify =
       [&](const std::shared_ptr<const PartitionAndSerializeNode>& node) {
@@ -78,6 +79,7 @@ TEST(PlanNodeBuilderTest, testPartitionAndSerialize) {
         EXPECT_EQ(node->partitionFunctionFactory(), partitionFunctionFactory);
         EXPECT_EQ(node->sortingOrders(), sortingOrders);
         EXPECT_EQ(node->sortingKeys(), sortingKeys);
+        EXPECT_EQ(node->isPartitionClusteredOutput(), partitionClusteredOutput);
         EXPECT_EQ(
             node->sources(), std::vector<core::PlanNodePtr>{kShuffleRead});
       };
@@ -91,6 +93,7 @@ TEST(PlanNodeBuilderTest, testPartitionAndSerialize) {
                         .partitionFunctionFactory(partitionFunctionFactory)
                         .sortingOrders(sortingOrders)
                         .sortingKeys(sortingKeys)
+                        .partitionClusteredOutput(partitionClusteredOutput)
                         .source(kShuffleRead)
                         .build();
   verify(node);
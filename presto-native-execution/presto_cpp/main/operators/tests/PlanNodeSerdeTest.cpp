@@ -78,6 +78,19 @@ TEST_F(PlanNodeSerdeTest, partitionAndSerializeNode) {
                   .localPartition(std::vector<std::string>{})
                   .planNode();
   testSerde(plan);
+
+  plan = exec::test::PlanBuilder()
+             .values(data_, true)
+             .addNode(addPartitionAndSerializeNode(
+                 4,
+                 false,
+                 {},
+                 std::nullopt,
+                 std::nullopt,
+                 /*partitionClusteredOutput=*/true))
+             .localPartition(std::vector<std::string>{})
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, shuffleReadNode) {
@@ -30,6 +30,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Exchange.h"
 #include "velox/exec/ExchangeClient.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -278,6 +279,61 @@ class ShuffleTest : public exec::test::OperatorTestBase {
     testPartitionAndSerialize(plan, expected, params);
   }
 
+  void testPartitionClusteredOutput(
+      const RowVectorPtr& data,
+      int32_t numPartitions,
+      bool replicateNullsAndAny) {
+    auto plan = exec::test::PlanBuilder()
+                    .values({data})
+                    .addNode(addPartitionAndSerializeNode(
+                        numPartitions,
+                        replicateNullsAndAny,
+                        {},
+                        std::nullopt,
+                        std::nullopt,
+                        /*partitionClusteredOutput=*/true))
+                    .planNode();
+
+    exec::CursorParameters params;
+    params.planNode = plan;
+    auto [taskCursor, results] = exec::test::readCursor(params);
+
+    auto combined = BaseVector::create<RowVector>(data->type(), 0, pool());
+    for (const auto& result : results) {
+      // Rows of each output batch are clustered: the partition column never
+      // decreases.
+      auto* partitions = result->childAt(0)->as<SimpleVector<int32_t>>();
+      for (auto i = 0; i < result->size(); ++i) {
+        ASSERT_GE(partitions->valueAt(i), 0);
+        ASSERT_LT(partitions->valueAt(i), numPartitions);
+        if (i > 0) {
+          ASSERT_LE(partitions->valueAt(i - 1), partitions->valueAt(i));
+        }
+      }
+
+      auto deserialized = deserializeResult(result, asRowType(data->type()));
+      if (deserialized == nullptr) {
+        continue;
+      }
+      if (replicateNullsAndAny) {
+        // The replicate flag must stay aligned with its row through the
+        // reordering: rows with null keys are the flagged ones.
+        auto* replicate = result->childAt(3)->as<SimpleVector<bool>>();
+        auto* keys = deserialized->childAt(0)->as<SimpleVector<int32_t>>();
+        for (auto i = 0; i < result->size(); ++i) {
+          if (keys->isNullAt(i)) {
+            ASSERT_TRUE(replicate->valueAt(i));
+          }
+        }
+      }
+      combined->append(deserialized.get());
+    }
+
+    // Clustering permutes rows, so compare contents without requiring input
+    // order.
+    velox::exec::test::assertEqualResults({data}, {combined});
+  }
+
   std::pair<std::unique_ptr<exec::TaskCursor>, std::vector<RowVectorPtr>>
   runShuffleReadTask(
       const exec::CursorParameters& params,
@@ -902,6 +958,48 @@ TEST_F(ShuffleTest, operators) {
   EXPECT_EQ(results->size(), 0);
 }
 
+TEST_F(ShuffleTest, writeCombining) {
+  const std::string shuffleRootPath = tempDir_->getPath();
+  cleanupDirectory(shuffleRootPath);
+
+  std::vector<RowVectorPtr> data;
+  for (auto batch = 0; batch < 3; ++batch) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            100, [&](auto row) { return batch * 100 + row; }),
+        makeFlatVector<int64_t>(100, [](auto row) { return row * 10; }),
+    }));
+  }
+
+  const size_t numPartitions = 4;
+  const std::string shuffleInfo =
+      localShuffleWriteInfo(shuffleRootPath, numPartitions);
+
+  // A small threshold so several combined batches form per partition, and a
+  // zero age bound so leftovers flush after every input, exercising both
+  // flush paths. The read-back results must match the uncombined shuffle.
+  core::QueryConfig queryConfig{std::unordered_map<std::string, std::string>{
+      {kShuffleWriteCombineThresholdBytes, "512"},
+      {kShuffleWriteCombineMaxAgeMs, "0"}}};
+
+  runShuffleTest(
+      std::string(shuffleName_),
+      shuffleInfo,
+      [&](auto partition) {
+        return localShuffleReadInfo(shuffleRootPath, partition);
+      },
+      false,
+      numPartitions,
+      2,
+      data,
+      0,
+      std::nullopt,
+      std::nullopt,
+      {},
+      std::move(queryConfig));
+  cleanupDirectory(shuffleRootPath);
+}
+
 DEBUG_ONLY_TEST_F(ShuffleTest, shuffleWriterExceptions) {
   auto data = makeRowVector({
       makeFlatVector<int32_t>({1, 2, 3, 4}),
@@ -1035,6 +1133,37 @@ TEST_F(ShuffleTest, shuffleDeserialization) {
       nlohmann::detail::type_error);
 }
 
+TEST_F(ShuffleTest, keyPrefixOrdering) {
+  // The 8-byte key prefix must never invert the full byte-wise key order: a
+  // differing prefix decides the comparison, an equal prefix may only be a
+  // tie settled by compareKeys().
+  const std::vector<std::string> keys = {
+      std::string(""),
+      std::string("a"),
+      std::string("ab"),
+      std::string("ab\0", 3),
+      std::string("ab\0x", 4),
+      std::string("abcdefgh"),
+      std::string("abcdefghi"),
+      std::string("abcdefgj"),
+      std::string("\0\0\0\0\0\0\0\0", 8),
+      std::string("\0\0\0\0\0\0\0\0a", 9),
+      std::string("zzzzzzzzzzzz"),
+  };
+  for (const auto& key1 : keys) {
+    for (const auto& key2 : keys) {
+      const auto prefix1 = loadKeyPrefix(key1);
+      const auto prefix2 = loadKeyPrefix(key2);
+      if (prefix1 < prefix2) {
+        ASSERT_TRUE(compareKeys(key1, key2)) << key1 << " vs " << key2;
+      } else if (prefix1 > prefix2) {
+        ASSERT_FALSE(compareKeys(key1, key2)) << key1 << " vs " << key2;
+      }
+      // Equal prefixes carry no ordering claim; compareKeys() decides.
+    }
+  }
+}
+
 TEST_F(ShuffleTest, replicateNullsAndAny) {
   // No nulls. Expect to replicate first row.
   auto data = makeRowVector({
@@ -1099,6 +1228,27 @@ TEST_F(ShuffleTest, partitionAndSerializeOperator) {
   testPartitionAndSerialize(plan, data);
 }
 
+TEST_F(ShuffleTest, partitionAndSerializeClusteredOutput) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row * 10; }),
+  });
+
+  testPartitionClusteredOutput(data, 4, false);
+}
+
+TEST_F(ShuffleTest, partitionAndSerializeClusteredOutputWithReplicate) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(
+          100,
+          [](auto row) { return row; },
+          [](auto row) { return row % 7 == 0; }),
+      makeFlatVector<int64_t>(100, [](auto row) { return row * 10; }),
+  });
+
+  testPartitionClusteredOutput(data, 4, true);
+}
+
 TEST_F(ShuffleTest, partitionAndSerializeWithLargeInput) {
   auto data = makeRowVector(
       {makeFlatVector<int32_t>(20'000, [](auto row) { return row; })});
@@ -1150,6 +1300,81 @@ TEST_F(ShuffleTest, partitionAndSerializeWithDifferentColumnOrder) {
   testPartitionAndSerialize(plan, expected);
 }
 
+TEST_F(ShuffleTest, partitionAndSerializeSpecializedKernel) {
+  // Hash partitioning on BIGINT and VARCHAR keys takes the specialized
+  // kernel path. Verify that the computed partitions are in range,
+  // deterministic per key value and independent of the input encoding.
+  constexpr vector_size_t kSize = 1'000;
+  constexpr int32_t kNumKeys = 37;
+  constexpr uint32_t kNumPartitions = 7;
+
+  std::vector<std::string> distinctStrings;
+  for (auto i = 0; i < kNumKeys; ++i) {
+    distinctStrings.push_back(fmt::format("partition-key-{}", i));
+  }
+
+  auto makePlan = [&](const RowVectorPtr& data) {
+    return exec::test::PlanBuilder()
+        .values({data}, false)
+        .addNode([&](const core::PlanNodeId& nodeId,
+                     core::PlanNodePtr source) -> core::PlanNodePtr {
+          std::vector<core::TypedExprPtr> keys{
+              std::make_shared<core::FieldAccessTypedExpr>(BIGINT(), "c0"),
+              std::make_shared<core::FieldAccessTypedExpr>(VARCHAR(), "c1")};
+          return std::make_shared<PartitionAndSerializeNode>(
+              nodeId,
+              keys,
+              kNumPartitions,
+              asRowType(source->outputType()),
+              std::move(source),
+              false,
+              std::make_shared<exec::HashPartitionFunctionSpec>(
+                  asRowType(data->type()),
+                  std::vector<column_index_t>{0, 1}));
+        })
+        .planNode();
+  };
+
+  auto collectPartitions = [&](const RowVectorPtr& data) {
+    auto results =
+        exec::test::AssertQueryBuilder(makePlan(data)).copyResults(pool());
+    EXPECT_EQ(results->size(), kSize);
+    auto* partitions = results->childAt(0)->as<SimpleVector<int32_t>>();
+    std::vector<int32_t> keyPartitions(kNumKeys, -1);
+    for (auto row = 0; row < results->size(); ++row) {
+      const auto partition = partitions->valueAt(row);
+      EXPECT_GE(partition, 0);
+      EXPECT_LT(partition, kNumPartitions);
+      // Rows with the same key values must land on the same partition.
+      auto& keyPartition = keyPartitions[row % kNumKeys];
+      if (keyPartition == -1) {
+        keyPartition = partition;
+      } else {
+        EXPECT_EQ(keyPartition, partition);
+      }
+    }
+    return keyPartitions;
+  };
+
+  auto flatData = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % kNumKeys; }),
+      makeFlatVector<std::string>(
+          kSize, [&](auto row) { return distinctStrings[row % kNumKeys]; }),
+  });
+
+  // Same key values through dictionary-encoded key columns.
+  auto indices = makeIndices(kSize, [](auto row) { return row % kNumKeys; });
+  auto dictionaryData = makeRowVector({
+      wrapInDictionary(
+          indices,
+          kSize,
+          makeFlatVector<int64_t>(kNumKeys, [](auto row) { return row; })),
+      wrapInDictionary(indices, kSize, makeFlatVector(distinctStrings)),
+  });
+
+  ASSERT_EQ(collectPartitions(flatData), collectPartitions(dictionaryData));
+}
+
 TEST_F(ShuffleTest, partitionAndSerializeOperatorWhenSinglePartition) {
   auto data = makeRowVector({
       makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
@@ -1469,16 +1694,18 @@ TEST_F(ShuffleTest, shuffleWriterReader) {
     uint64_t readMaxBytes;
     size_t minDataSize;
     size_t maxDataSize;
+    uint32_t readPrefetchDepth = 0;
     std::optional<int> expectedOutputCalls;
     std::string debugString() const {
       return fmt::format(
-          "sorted:{}, maxBytesPerPartition:{}, rows:{}, readMax:{}, dataSize:{}-{}, expectedCalls:{}",
+          "sorted:{}, maxBytesPerPartition:{}, rows:{}, readMax:{}, dataSize:{}-{}, prefetchDepth:{}, expectedCalls:{}",
           sortedShuffle,
           maxBytesPerPartition,
           numRows,
           readMaxBytes,
           minDataSize,
           maxDataSize,
+          readPrefetchDepth,
           expectedOutputCalls.has_value() ? std::to_string(*expectedOutputCalls)
                                           : "None");
     }
@@ -1514,6 +1741,22 @@ TEST_F(ShuffleTest, shuffleWriterReader) {
        .readMaxBytes = 1024 * 1024,
        .minDataSize = 200,
        .maxDataSize = 1000},
+      // Sorted shuffle with chunk prefetch: many small files merged through
+      // prefetching streams must produce the same sorted order.
+      {.sortedShuffle = true,
+       .maxBytesPerPartition = 500,
+       .numRows = 20,
+       .readMaxBytes = 1024 * 1024,
+       .minDataSize = 50,
+       .maxDataSize = 150,
+       .readPrefetchDepth = 2},
+      {.sortedShuffle = true,
+       .maxBytesPerPartition = 2048,
+       .numRows = 100,
+       .readMaxBytes = 8192,
+       .minDataSize = 200,
+       .maxDataSize = 1000,
+       .readPrefetchDepth = 3},
       // Sorted shuffle batching tests: verify correct number of output batches
       {.sortedShuffle = true,
        .maxBytesPerPartition = 1,
@@ -1626,7 +1869,8 @@ TEST_F(ShuffleTest, shuffleWriterReader) {
         readInfo.queryId,
         readInfo.partitionIds,
         config.sortedShuffle,
-        pool());
+        pool(),
+        config.readPrefetchDepth);
     reader->initialize();
 
     size_t totalRows = 0;
@@ -1688,6 +1932,890 @@ TEST_F(ShuffleTest, shuffleWriterReader) {
   }
 }
 
+TEST_F(ShuffleTest, memoryTransportRoundTrip) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+  const uint64_t memoryTransportMaxBytes = 1 << 20;
+
+  for (const bool sortedShuffle : {false, true}) {
+    SCOPED_TRACE(fmt::format("sortedShuffle: {}", sortedShuffle));
+
+    auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+    const auto testRootPath = tempRootDir->getPath();
+
+    LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+        localShuffleWriteInfo(testRootPath, numPartitions, sortedShuffle));
+
+    auto writer = std::make_shared<LocalShuffleWriter>(
+        writeInfo.rootPath,
+        writeInfo.queryId,
+        writeInfo.shuffleId,
+        writeInfo.numPartitions,
+        /*maxBytesPerPartition=*/1, // Flush a block per collected row.
+        sortedShuffle,
+        pool(),
+        memoryTransportMaxBytes);
+
+    const std::vector<std::string> dataValues = {"abc", "de", "fghi"};
+    // Keys in descending order so the sorted read must reorder rows.
+    const std::vector<int32_t> keys = {3, 2, 1};
+    for (size_t i = 0; i < dataValues.size(); ++i) {
+      if (sortedShuffle) {
+        int32_t keyBigEndian = folly::Endian::big(keys[i]);
+        writer->collect(
+            partition,
+            std::string_view(
+                reinterpret_cast<const char*>(&keyBigEndian), kUint32Size),
+            dataValues[i]);
+      } else {
+        writer->collect(partition, std::string_view{}, dataValues[i]);
+      }
+    }
+    writer->noMoreData(true);
+
+    // All blocks fit in the budget, so nothing is written to disk.
+    auto fileSystem = filesystems::getFileSystem(testRootPath, nullptr);
+    EXPECT_TRUE(fileSystem->list(testRootPath).empty());
+    EXPECT_GT(LocalShuffleMemoryBroker::instance()->stagedBytes(), 0);
+
+    LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+        localShuffleReadInfo(testRootPath, partition, sortedShuffle));
+
+    auto reader = std::make_shared<LocalShuffleReader>(
+        readInfo.rootPath,
+        readInfo.queryId,
+        readInfo.partitionIds,
+        sortedShuffle,
+        pool());
+    reader->initialize();
+
+    // The reader drains the broker on initialization.
+    EXPECT_EQ(LocalShuffleMemoryBroker::instance()->stagedBytes(), 0);
+
+    std::vector<std::string> readDataValues;
+    while (true) {
+      auto batches =
+          reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+      if (batches.empty()) {
+        break;
+      }
+      for (const auto& batch : batches) {
+        for (const auto& row : batch->rows()) {
+          readDataValues.emplace_back(row.data(), row.size());
+        }
+      }
+    }
+    reader->noMoreData(true);
+
+    if (sortedShuffle) {
+      EXPECT_EQ(
+          readDataValues, std::vector<std::string>({"fghi", "de", "abc"}));
+    } else {
+      EXPECT_EQ(readDataValues, dataValues);
+    }
+  }
+}
+
+TEST_F(ShuffleTest, memoryTransportSpillsOverBudget) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+
+  auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+  const auto testRootPath = tempRootDir->getPath();
+
+  LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+      localShuffleWriteInfo(testRootPath, numPartitions));
+
+  // Budget only fits the first block; the rest must go to files.
+  auto writer = std::make_shared<LocalShuffleWriter>(
+      writeInfo.rootPath,
+      writeInfo.queryId,
+      writeInfo.shuffleId,
+      writeInfo.numPartitions,
+      /*maxBytesPerPartition=*/1,
+      /*sortedShuffle=*/false,
+      pool(),
+      /*memoryTransportMaxBytes=*/kUint32Size + 3);
+
+  writer->collect(partition, std::string_view{}, "abc");
+  writer->collect(partition, std::string_view{}, "def");
+  writer->collect(partition, std::string_view{}, "ghi");
+  writer->noMoreData(true);
+
+  // Blocks over budget spilled to shuffle files.
+  auto fileSystem = filesystems::getFileSystem(testRootPath, nullptr);
+  EXPECT_FALSE(fileSystem->list(testRootPath).empty());
+
+  LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+      localShuffleReadInfo(testRootPath, partition));
+
+  auto reader = std::make_shared<LocalShuffleReader>(
+      readInfo.rootPath,
+      readInfo.queryId,
+      readInfo.partitionIds,
+      /*sortedShuffle=*/false,
+      pool());
+  reader->initialize();
+
+  std::vector<std::string> readDataValues;
+  while (true) {
+    auto batches =
+        reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+    if (batches.empty()) {
+      break;
+    }
+    for (const auto& batch : batches) {
+      for (const auto& row : batch->rows()) {
+        readDataValues.emplace_back(row.data(), row.size());
+      }
+    }
+  }
+  reader->noMoreData(true);
+
+  // File listing order is not deterministic; compare as a set of rows.
+  boost::range::sort(readDataValues);
+  EXPECT_EQ(readDataValues, std::vector<std::string>({"abc", "def", "ghi"}));
+}
+
+TEST_F(ShuffleTest, prefetchedFileRead) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+
+  auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+  const auto testRootPath = tempRootDir->getPath();
+
+  LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+      localShuffleWriteInfo(testRootPath, numPartitions));
+
+  // One row per file so the reader has several files to prefetch.
+  auto writer = std::make_shared<LocalShuffleWriter>(
+      writeInfo.rootPath,
+      writeInfo.queryId,
+      writeInfo.shuffleId,
+      writeInfo.numPartitions,
+      /*maxBytesPerPartition=*/1,
+      /*sortedShuffle=*/false,
+      pool());
+
+  const std::vector<std::string> dataValues = {"abc", "de", "fghi", "j"};
+  for (const auto& data : dataValues) {
+    writer->collect(partition, std::string_view{}, data);
+  }
+  writer->noMoreData(true);
+
+  LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+      localShuffleReadInfo(testRootPath, partition));
+
+  auto reader = std::make_shared<LocalShuffleReader>(
+      readInfo.rootPath,
+      readInfo.queryId,
+      readInfo.partitionIds,
+      /*sortedShuffle=*/false,
+      pool(),
+      /*readPrefetchDepth=*/2);
+  reader->initialize();
+
+  std::vector<std::string> readDataValues;
+  while (true) {
+    auto batches =
+        reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+    if (batches.empty()) {
+      break;
+    }
+    for (const auto& batch : batches) {
+      for (const auto& row : batch->rows()) {
+        readDataValues.emplace_back(row.data(), row.size());
+      }
+    }
+  }
+  reader->noMoreData(true);
+
+  boost::range::sort(readDataValues);
+  EXPECT_EQ(
+      readDataValues,
+      std::vector<std::string>({"abc", "de", "fghi", "j"}));
+}
+
+TEST_F(ShuffleTest, compressedFileRoundTrip) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+
+  auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+  const auto testRootPath = tempRootDir->getPath();
+
+  LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+      localShuffleWriteInfo(testRootPath, numPartitions));
+
+  // One row per file so several compressed files get written.
+  auto writer = std::make_shared<LocalShuffleWriter>(
+      writeInfo.rootPath,
+      writeInfo.queryId,
+      writeInfo.shuffleId,
+      writeInfo.numPartitions,
+      /*maxBytesPerPartition=*/1,
+      /*sortedShuffle=*/false,
+      pool(),
+      /*memoryTransportMaxBytes=*/0,
+      /*fileCompressionEnabled=*/true);
+
+  const std::vector<std::string> dataValues = {"abc", "de", "fghi", "j"};
+  for (const auto& data : dataValues) {
+    writer->collect(partition, std::string_view{}, data);
+  }
+  writer->noMoreData(true);
+
+  // All shuffle files should carry the compressed suffix.
+  auto fileSystem = velox::filesystems::getFileSystem(testRootPath, nullptr);
+  size_t numShuffleFiles = 0;
+  for (const auto& file : fileSystem->list(testRootPath)) {
+    EXPECT_TRUE(file.ends_with(".lz4")) << file;
+    ++numShuffleFiles;
+  }
+  EXPECT_EQ(numShuffleFiles, dataValues.size());
+
+  LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+      localShuffleReadInfo(testRootPath, partition));
+
+  auto reader = std::make_shared<LocalShuffleReader>(
+      readInfo.rootPath,
+      readInfo.queryId,
+      readInfo.partitionIds,
+      /*sortedShuffle=*/false,
+      pool());
+  reader->initialize();
+
+  std::vector<std::string> readDataValues;
+  while (true) {
+    auto batches =
+        reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+    if (batches.empty()) {
+      break;
+    }
+    for (const auto& batch : batches) {
+      for (const auto& row : batch->rows()) {
+        readDataValues.emplace_back(row.data(), row.size());
+      }
+    }
+  }
+  reader->noMoreData(true);
+
+  boost::range::sort(readDataValues);
+  EXPECT_EQ(
+      readDataValues,
+      std::vector<std::string>({"abc", "de", "fghi", "j"}));
+}
+
+TEST_F(ShuffleTest, checksummedFileRoundTrip) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+
+  auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+  const auto testRootPath = tempRootDir->getPath();
+
+  LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+      localShuffleWriteInfo(testRootPath, numPartitions));
+
+  // One row per file so several checksummed files get written.
+  auto writer = std::make_shared<LocalShuffleWriter>(
+      writeInfo.rootPath,
+      writeInfo.queryId,
+      writeInfo.shuffleId,
+      writeInfo.numPartitions,
+      /*maxBytesPerPartition=*/1,
+      /*sortedShuffle=*/false,
+      pool(),
+      /*memoryTransportMaxBytes=*/0,
+      /*fileCompressionEnabled=*/false,
+      /*fileChecksumEnabled=*/true);
+
+  const std::vector<std::string> dataValues = {"abc", "de", "fghi", "j"};
+  for (const auto& data : dataValues) {
+    writer->collect(partition, std::string_view{}, data);
+  }
+  writer->noMoreData(true);
+
+  // All shuffle files should carry the checksum suffix.
+  auto fileSystem = velox::filesystems::getFileSystem(testRootPath, nullptr);
+  std::vector<std::string> shuffleFiles;
+  for (const auto& file : fileSystem->list(testRootPath)) {
+    EXPECT_TRUE(file.ends_with(".crc32c")) << file;
+    shuffleFiles.push_back(file);
+  }
+  EXPECT_EQ(shuffleFiles.size(), dataValues.size());
+
+  LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+      localShuffleReadInfo(testRootPath, partition));
+
+  auto makeReader = [&]() {
+    auto reader = std::make_shared<LocalShuffleReader>(
+        readInfo.rootPath,
+        readInfo.queryId,
+        readInfo.partitionIds,
+        /*sortedShuffle=*/false,
+        pool());
+    reader->initialize();
+    return reader;
+  };
+
+  auto reader = makeReader();
+  std::vector<std::string> readDataValues;
+  while (true) {
+    auto batches =
+        reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+    if (batches.empty()) {
+      break;
+    }
+    for (const auto& batch : batches) {
+      for (const auto& row : batch->rows()) {
+        readDataValues.emplace_back(row.data(), row.size());
+      }
+    }
+  }
+  reader->noMoreData(true);
+
+  boost::range::sort(readDataValues);
+  EXPECT_EQ(
+      readDataValues, std::vector<std::string>({"abc", "de", "fghi", "j"}));
+
+  // Flip a payload byte in one of the files; the read must fail verification
+  // instead of decoding corrupt rows.
+  {
+    auto file = fileSystem->openFileForRead(shuffleFiles[0]);
+    std::string contents(file->size(), '\0');
+    file->pread(0, contents.size(), contents.data());
+    contents[kUint32Size] ^= 0x1;
+    fileSystem->remove(shuffleFiles[0]);
+    auto corrupted = fileSystem->openFileForWrite(shuffleFiles[0]);
+    corrupted->append(contents);
+    corrupted->close();
+  }
+
+  auto corruptReader = makeReader();
+  VELOX_ASSERT_THROW(
+      corruptReader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get(),
+      "CRC32C mismatch");
+}
+
+TEST_F(ShuffleTest, dedupFileRoundTrip) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+
+  auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+  const auto testRootPath = tempRootDir->getPath();
+
+  LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+      localShuffleWriteInfo(testRootPath, numPartitions));
+  // The store is process-wide and the test query id is shared, so start from
+  // a clean slate.
+  LocalShuffleChunkStore::instance()->drop(writeInfo.queryId);
+
+  // One row per file; the repeated rows produce identical blocks that the
+  // chunk store should collapse into references.
+  auto writer = std::make_shared<LocalShuffleWriter>(
+      writeInfo.rootPath,
+      writeInfo.queryId,
+      writeInfo.shuffleId,
+      writeInfo.numPartitions,
+      /*maxBytesPerPartition=*/1,
+      /*sortedShuffle=*/false,
+      pool(),
+      /*memoryTransportMaxBytes=*/0,
+      /*fileCompressionEnabled=*/false,
+      /*fileChecksumEnabled=*/false,
+      /*compactionMinFileBytes=*/0,
+      /*compactionExecutor=*/nullptr,
+      /*blockHeaderEnabled=*/false,
+      /*dedupMaxBytes=*/1 << 20);
+
+  const std::vector<std::string> dataValues = {"abc", "de", "abc", "de"};
+  for (const auto& data : dataValues) {
+    writer->collect(partition, std::string_view{}, data);
+  }
+  writer->noMoreData(true);
+
+  // All shuffle files should carry the dedup suffix, and the repeated blocks
+  // should have landed in the chunk store.
+  auto fileSystem = velox::filesystems::getFileSystem(testRootPath, nullptr);
+  size_t numShuffleFiles = 0;
+  for (const auto& file : fileSystem->list(testRootPath)) {
+    EXPECT_TRUE(file.ends_with(".cdc")) << file;
+    ++numShuffleFiles;
+  }
+  EXPECT_EQ(numShuffleFiles, dataValues.size());
+  EXPECT_GT(LocalShuffleChunkStore::instance()->storedBytes(), 0);
+
+  LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+      localShuffleReadInfo(testRootPath, partition));
+
+  auto reader = std::make_shared<LocalShuffleReader>(
+      readInfo.rootPath,
+      readInfo.queryId,
+      readInfo.partitionIds,
+      /*sortedShuffle=*/false,
+      pool());
+  reader->initialize();
+
+  std::vector<std::string> readDataValues;
+  while (true) {
+    auto batches =
+        reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+    if (batches.empty()) {
+      break;
+    }
+    for (const auto& batch : batches) {
+      for (const auto& row : batch->rows()) {
+        readDataValues.emplace_back(row.data(), row.size());
+      }
+    }
+  }
+  reader->noMoreData(true);
+
+  boost::range::sort(readDataValues);
+  EXPECT_EQ(
+      readDataValues, std::vector<std::string>({"abc", "abc", "de", "de"}));
+}
+
+TEST_F(ShuffleTest, dedupOverBudgetFallsBackToLiterals) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+
+  auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+  const auto testRootPath = tempRootDir->getPath();
+
+  LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+      localShuffleWriteInfo(testRootPath, numPartitions));
+  // Clear chunks a previous test may have stored for the shared query id, so
+  // no block can dedup against them.
+  LocalShuffleChunkStore::instance()->drop(writeInfo.queryId);
+
+  // A one-byte budget rejects every chunk, so blocks are written as inline
+  // literals and the read never touches the store.
+  auto writer = std::make_shared<LocalShuffleWriter>(
+      writeInfo.rootPath,
+      writeInfo.queryId,
+      writeInfo.shuffleId,
+      writeInfo.numPartitions,
+      /*maxBytesPerPartition=*/1,
+      /*sortedShuffle=*/false,
+      pool(),
+      /*memoryTransportMaxBytes=*/0,
+      /*fileCompressionEnabled=*/false,
+      /*fileChecksumEnabled=*/false,
+      /*compactionMinFileBytes=*/0,
+      /*compactionExecutor=*/nullptr,
+      /*blockHeaderEnabled=*/false,
+      /*dedupMaxBytes=*/1);
+
+  const std::vector<std::string> dataValues = {"abc", "de", "abc", "de"};
+  for (const auto& data : dataValues) {
+    writer->collect(partition, std::string_view{}, data);
+  }
+  writer->noMoreData(true);
+
+  LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+      localShuffleReadInfo(testRootPath, partition));
+
+  auto reader = std::make_shared<LocalShuffleReader>(
+      readInfo.rootPath,
+      readInfo.queryId,
+      readInfo.partitionIds,
+      /*sortedShuffle=*/false,
+      pool());
+  reader->initialize();
+
+  std::vector<std::string> readDataValues;
+  while (true) {
+    auto batches =
+        reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+    if (batches.empty()) {
+      break;
+    }
+    for (const auto& batch : batches) {
+      for (const auto& row : batch->rows()) {
+        readDataValues.emplace_back(row.data(), row.size());
+      }
+    }
+  }
+  reader->noMoreData(true);
+
+  boost::range::sort(readDataValues);
+  EXPECT_EQ(
+      readDataValues, std::vector<std::string>({"abc", "abc", "de", "de"}));
+}
+
+TEST_F(ShuffleTest, partitionBufferGrowth) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+
+  auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+  const auto testRootPath = tempRootDir->getPath();
+
+  LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+      localShuffleWriteInfo(testRootPath, numPartitions));
+
+  // The per-partition limit far exceeds the initial buffer size, and the
+  // rows overflow the initial buffer without reaching the limit, so the
+  // partition buffer must grow in place rather than flush.
+  auto writer = std::make_shared<LocalShuffleWriter>(
+      writeInfo.rootPath,
+      writeInfo.queryId,
+      writeInfo.shuffleId,
+      writeInfo.numPartitions,
+      /*maxBytesPerPartition=*/1 << 20,
+      /*sortedShuffle=*/false,
+      pool());
+
+  std::vector<std::string> dataValues;
+  for (auto i = 0; i < 300; ++i) {
+    dataValues.push_back(fmt::format("{:0>512}", i));
+  }
+  for (const auto& data : dataValues) {
+    writer->collect(partition, std::string_view{}, data);
+  }
+  writer->noMoreData(true);
+
+  // Everything fit in the grown buffer, so a single block was written.
+  auto fileSystem = velox::filesystems::getFileSystem(testRootPath, nullptr);
+  EXPECT_EQ(fileSystem->list(testRootPath).size(), 1);
+
+  LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+      localShuffleReadInfo(testRootPath, partition));
+
+  auto reader = std::make_shared<LocalShuffleReader>(
+      readInfo.rootPath,
+      readInfo.queryId,
+      readInfo.partitionIds,
+      /*sortedShuffle=*/false,
+      pool());
+  reader->initialize();
+
+  std::vector<std::string> readDataValues;
+  while (true) {
+    auto batches =
+        reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+    if (batches.empty()) {
+      break;
+    }
+    for (const auto& batch : batches) {
+      for (const auto& row : batch->rows()) {
+        readDataValues.emplace_back(row.data(), row.size());
+      }
+    }
+  }
+  reader->noMoreData(true);
+
+  boost::range::sort(readDataValues);
+  EXPECT_EQ(readDataValues, dataValues);
+}
+
+TEST_F(ShuffleTest, framedFileRoundTrip) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+
+  auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+  const auto testRootPath = tempRootDir->getPath();
+
+  LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+      localShuffleWriteInfo(testRootPath, numPartitions));
+
+  // One row per file so several framed files get written.
+  auto writer = std::make_shared<LocalShuffleWriter>(
+      writeInfo.rootPath,
+      writeInfo.queryId,
+      writeInfo.shuffleId,
+      writeInfo.numPartitions,
+      /*maxBytesPerPartition=*/1,
+      /*sortedShuffle=*/false,
+      pool(),
+      /*memoryTransportMaxBytes=*/0,
+      /*fileCompressionEnabled=*/false,
+      /*fileChecksumEnabled=*/false,
+      /*compactionMinFileBytes=*/0,
+      /*compactionExecutor=*/nullptr,
+      /*blockHeaderEnabled=*/true);
+
+  const std::vector<std::string> dataValues = {"abc", "de", "fghi", "j"};
+  for (const auto& data : dataValues) {
+    writer->collect(partition, std::string_view{}, data);
+  }
+  writer->noMoreData(true);
+
+  // All shuffle files should carry the framing suffix.
+  auto fileSystem = velox::filesystems::getFileSystem(testRootPath, nullptr);
+  size_t numShuffleFiles = 0;
+  for (const auto& file : fileSystem->list(testRootPath)) {
+    EXPECT_TRUE(file.ends_with(".blk")) << file;
+    ++numShuffleFiles;
+  }
+  EXPECT_EQ(numShuffleFiles, dataValues.size());
+
+  LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+      localShuffleReadInfo(testRootPath, partition));
+
+  auto reader = std::make_shared<LocalShuffleReader>(
+      readInfo.rootPath,
+      readInfo.queryId,
+      readInfo.partitionIds,
+      /*sortedShuffle=*/false,
+      pool());
+  reader->initialize();
+
+  std::vector<std::string> readDataValues;
+  while (true) {
+    auto batches =
+        reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+    if (batches.empty()) {
+      break;
+    }
+    for (const auto& batch : batches) {
+      for (const auto& row : batch->rows()) {
+        readDataValues.emplace_back(row.data(), row.size());
+      }
+    }
+  }
+  reader->noMoreData(true);
+
+  boost::range::sort(readDataValues);
+  EXPECT_EQ(
+      readDataValues, std::vector<std::string>({"abc", "de", "fghi", "j"}));
+}
+
+TEST_F(ShuffleTest, framedSortedKeyRangeSkip) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+
+  auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+  const auto testRootPath = tempRootDir->getPath();
+
+  LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+      localShuffleWriteInfo(testRootPath, numPartitions, true));
+
+  // One row per file, so every framed block covers a single key.
+  auto writer = std::make_shared<LocalShuffleWriter>(
+      writeInfo.rootPath,
+      writeInfo.queryId,
+      writeInfo.shuffleId,
+      writeInfo.numPartitions,
+      /*maxBytesPerPartition=*/1,
+      /*sortedShuffle=*/true,
+      pool(),
+      /*memoryTransportMaxBytes=*/0,
+      /*fileCompressionEnabled=*/false,
+      /*fileChecksumEnabled=*/false,
+      /*compactionMinFileBytes=*/0,
+      /*compactionExecutor=*/nullptr,
+      /*blockHeaderEnabled=*/true);
+
+  const std::vector<std::pair<std::string, std::string>> rows = {
+      {"a", "value-a"},
+      {"b", "value-b"},
+      {"c", "value-c"},
+      {"d", "value-d"},
+      {"e", "value-e"}};
+  for (const auto& [key, data] : rows) {
+    writer->collect(partition, key, data);
+  }
+  writer->noMoreData(true);
+
+  LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+      localShuffleReadInfo(testRootPath, partition, true));
+
+  auto readWithFilter = [&](const std::optional<
+                            std::pair<std::string, std::string>>& filter) {
+    auto reader = std::make_shared<LocalShuffleReader>(
+        readInfo.rootPath,
+        readInfo.queryId,
+        readInfo.partitionIds,
+        /*sortedShuffle=*/true,
+        pool());
+    if (filter.has_value()) {
+      reader->setKeyRangeFilter(filter->first, filter->second);
+    }
+    reader->initialize();
+    std::vector<std::string> values;
+    while (true) {
+      auto batches =
+          reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+      if (batches.empty()) {
+        break;
+      }
+      for (const auto& batch : batches) {
+        for (const auto& row : batch->rows()) {
+          values.emplace_back(row.data(), row.size());
+        }
+      }
+    }
+    reader->noMoreData(true);
+    return values;
+  };
+
+  // Without a filter all rows come back, in key order.
+  EXPECT_EQ(
+      readWithFilter(std::nullopt),
+      std::vector<std::string>(
+          {"value-a", "value-b", "value-c", "value-d", "value-e"}));
+
+  // Blocks whose key range cannot intersect the filter are skipped without
+  // being merged.
+  EXPECT_EQ(
+      readWithFilter(std::make_pair("b", "d")),
+      std::vector<std::string>({"value-b", "value-c", "value-d"}));
+
+  // A filter below all keys skips every block.
+  EXPECT_TRUE(readWithFilter(std::make_pair("A", "B")).empty());
+}
+
+TEST_F(ShuffleTest, compactedFileRoundTrip) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+
+  auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+  const auto testRootPath = tempRootDir->getPath();
+
+  LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+      localShuffleWriteInfo(testRootPath, numPartitions));
+
+  // One row per file so a full batch of small files accumulates and gets
+  // merged in the background.
+  auto writer = std::make_shared<LocalShuffleWriter>(
+      writeInfo.rootPath,
+      writeInfo.queryId,
+      writeInfo.shuffleId,
+      writeInfo.numPartitions,
+      /*maxBytesPerPartition=*/1,
+      /*sortedShuffle=*/false,
+      pool(),
+      /*memoryTransportMaxBytes=*/0,
+      /*fileCompressionEnabled=*/false,
+      /*fileChecksumEnabled=*/true,
+      /*compactionMinFileBytes=*/1024,
+      folly::getGlobalCPUExecutor().get());
+
+  std::vector<std::string> dataValues;
+  for (auto i = 0; i < 9; ++i) {
+    dataValues.push_back(fmt::format("row_{}", i));
+    writer->collect(partition, std::string_view{}, dataValues.back());
+  }
+  writer->noMoreData(true);
+
+  // The first batch of 8 files must have been merged into one checksummed
+  // file; only the final flush stays unmerged.
+  auto fileSystem = velox::filesystems::getFileSystem(testRootPath, nullptr);
+  size_t numMergedFiles = 0;
+  size_t numShuffleFiles = 0;
+  for (const auto& file : fileSystem->list(testRootPath)) {
+    EXPECT_TRUE(file.ends_with(".crc32c")) << file;
+    numMergedFiles += file.find("_merged_") != std::string::npos;
+    ++numShuffleFiles;
+  }
+  EXPECT_EQ(numMergedFiles, 1);
+  EXPECT_EQ(numShuffleFiles, 2);
+
+  LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+      localShuffleReadInfo(testRootPath, partition));
+
+  auto reader = std::make_shared<LocalShuffleReader>(
+      readInfo.rootPath,
+      readInfo.queryId,
+      readInfo.partitionIds,
+      /*sortedShuffle=*/false,
+      pool());
+  reader->initialize();
+
+  std::vector<std::string> readDataValues;
+  while (true) {
+    auto batches =
+        reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+    if (batches.empty()) {
+      break;
+    }
+    for (const auto& batch : batches) {
+      for (const auto& row : batch->rows()) {
+        readDataValues.emplace_back(row.data(), row.size());
+      }
+    }
+  }
+  reader->noMoreData(true);
+
+  boost::range::sort(readDataValues);
+  EXPECT_EQ(readDataValues, dataValues);
+}
+
+TEST_F(ShuffleTest, sortedCompactedFileRoundTrip) {
+  const uint32_t numPartitions = 1;
+  const uint32_t partition = 0;
+
+  auto tempRootDir = velox::exec::test::TempDirectoryPath::create();
+  const auto testRootPath = tempRootDir->getPath();
+
+  LocalShuffleWriteInfo writeInfo = LocalShuffleWriteInfo::deserialize(
+      localShuffleWriteInfo(testRootPath, numPartitions, true));
+
+  // One row per file; the background job merges the sorted runs with a
+  // streaming k-way merge so the merged file stays a single sorted run.
+  auto writer = std::make_shared<LocalShuffleWriter>(
+      writeInfo.rootPath,
+      writeInfo.queryId,
+      writeInfo.shuffleId,
+      writeInfo.numPartitions,
+      /*maxBytesPerPartition=*/1,
+      /*sortedShuffle=*/true,
+      pool(),
+      /*memoryTransportMaxBytes=*/0,
+      /*fileCompressionEnabled=*/false,
+      /*fileChecksumEnabled=*/false,
+      /*compactionMinFileBytes=*/1024,
+      folly::getGlobalCPUExecutor().get());
+
+  const std::vector<std::string> keys = {
+      "k7", "k2", "k8", "k0", "k5", "k3", "k6", "k1", "k4"};
+  for (const auto& key : keys) {
+    writer->collect(partition, key, fmt::format("data_{}", key));
+  }
+  writer->noMoreData(true);
+
+  auto fileSystem = velox::filesystems::getFileSystem(testRootPath, nullptr);
+  size_t numMergedFiles = 0;
+  for (const auto& file : fileSystem->list(testRootPath)) {
+    numMergedFiles += file.find("_merged_") != std::string::npos;
+  }
+  EXPECT_EQ(numMergedFiles, 1);
+
+  LocalShuffleReadInfo readInfo = LocalShuffleReadInfo::deserialize(
+      localShuffleReadInfo(testRootPath, partition, true));
+
+  auto reader = std::make_shared<LocalShuffleReader>(
+      readInfo.rootPath,
+      readInfo.queryId,
+      readInfo.partitionIds,
+      /*sortedShuffle=*/true,
+      pool());
+  reader->initialize();
+
+  std::vector<std::string> readDataValues;
+  while (true) {
+    auto batches =
+        reader->next(1 << 20).via(folly::getGlobalCPUExecutor()).get();
+    if (batches.empty()) {
+      break;
+    }
+    for (const auto& batch : batches) {
+      for (const auto& row : batch->rows()) {
+        readDataValues.emplace_back(row.data(), row.size());
+      }
+    }
+  }
+  reader->noMoreData(true);
+
+  // The k-way merge over the merged run and the final flush must produce the
+  // rows in key order.
+  std::vector<std::string> expected;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    expected.push_back(fmt::format("data_k{}", i));
+  }
+  EXPECT_EQ(readDataValues, expected);
+}
+
 TEST_F(ShuffleTest, shuffleFuzzTest) {
   fuzzerTest(false, 1);
   fuzzerTest(false, 3);
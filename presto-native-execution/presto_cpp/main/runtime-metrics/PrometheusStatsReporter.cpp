@@ -17,11 +17,12 @@
 #include <prometheus/collectable.h>
 #include <prometheus/counter.h>
 #include <prometheus/gauge.h>
-#include <prometheus/histogram.h>
 #include <prometheus/registry.h>
 #include <prometheus/summary.h>
 #include <prometheus/text_serializer.h>
 
+#include "presto_cpp/main/runtime-metrics/WindowedHistogram.h"
+
 namespace facebook::presto::prometheus {
 
 // Initialize singleton for the reporter
@@ -44,23 +45,30 @@ struct PrometheusStatsReporter::PrometheusImpl {
 
   ::prometheus::Labels labels;
   std::shared_ptr<::prometheus::Registry> registry;
+  // Histograms are kept outside the registry because they are exported over
+  // a sliding window; fetchMetrics() collects them separately.
+  std::vector<std::unique_ptr<WindowedHistogram>> windowedHistograms;
 };
 
 PrometheusStatsReporter::PrometheusStatsReporter(
-    const std::map<std::string, std::string>& labels,
-    int numThreads)
-    : executor_(std::make_shared<folly::CPUThreadPoolExecutor>(numThreads)),
-      impl_(std::make_shared<PrometheusImpl>(labels)) {}
+    const std::map<std::string, std::string>& labels)
+    : impl_(std::make_shared<PrometheusImpl>(labels)) {}
 
 void PrometheusStatsReporter::registerMetricExportType(
     const char* key,
     facebook::velox::StatType statType) const {
+  registerMetricExportType(folly::StringPiece(key), statType);
+}
+
+void PrometheusStatsReporter::registerMetricExportType(
+    folly::StringPiece key,
+    facebook::velox::StatType statType) const {
   if (registeredMetricsMap_.find(key) != registeredMetricsMap_.end()) {
     VLOG(1) << "Trying to register already registered metric " << key;
     return;
   }
   // '.' is replaced with '_'.
-  std::string sanitizedMetricKey = std::string(key);
+  std::string sanitizedMetricKey = key.str();
   std::replace(sanitizedMetricKey.begin(), sanitizedMetricKey.end(), '.', '_');
   switch (statType) {
     case facebook::velox::StatType::COUNT: {
@@ -69,7 +77,13 @@ void PrometheusStatsReporter::registerMetricExportType(
                                 .Name(sanitizedMetricKey)
                                 .Register(*impl_->registry);
       auto& counter = counterFamily.Add(impl_->labels);
-      registeredMetricsMap_.insert({key, StatsInfo{statType, &counter}});
+      auto result = registeredMetricsMap_.insert(
+          key.str(),
+          StatsInfo{
+              statType, &counter, std::make_shared<std::atomic<int64_t>>(0)});
+      if (result.second) {
+        orderedStats_.wlock()->push_back(&result.first->second);
+      }
     } break;
     case facebook::velox::StatType::SUM:
     case facebook::velox::StatType::AVG:
@@ -78,8 +92,13 @@ void PrometheusStatsReporter::registerMetricExportType(
                               .Name(sanitizedMetricKey)
                               .Register(*impl_->registry);
       auto& gauge = gaugeFamily.Add(impl_->labels);
-      registeredMetricsMap_.insert(
-          std::string(key), StatsInfo{statType, &gauge});
+      auto result = registeredMetricsMap_.insert(
+          key.str(),
+          StatsInfo{
+              statType, &gauge, std::make_shared<std::atomic<int64_t>>(0)});
+      if (result.second) {
+        orderedStats_.wlock()->push_back(&result.first->second);
+      }
     } break;
     default:
       VELOX_UNSUPPORTED(
@@ -87,14 +106,18 @@ void PrometheusStatsReporter::registerMetricExportType(
   }
 }
 
-void PrometheusStatsReporter::registerMetricExportType(
-    folly::StringPiece key,
-    facebook::velox::StatType statType) const {
-  registerMetricExportType(key.toString().c_str(), statType);
+void PrometheusStatsReporter::registerHistogramMetricExportType(
+    const char* key,
+    int64_t bucketWidth,
+    int64_t min,
+    int64_t max,
+    const std::vector<int32_t>& pcts) const {
+  registerHistogramMetricExportType(
+      folly::StringPiece(key), bucketWidth, min, max, pcts);
 }
 
 void PrometheusStatsReporter::registerHistogramMetricExportType(
-    const char* key,
+    folly::StringPiece key,
     int64_t bucketWidth,
     int64_t min,
     int64_t max,
@@ -106,26 +129,27 @@ void PrometheusStatsReporter::registerHistogramMetricExportType(
   }
   auto numBuckets = (max - min) / bucketWidth;
   auto bound = min + bucketWidth;
-  std::string sanitizedMetricKey = std::string(key);
+  std::string sanitizedMetricKey = key.str();
   // '.' is replaced with '_'.
   std::replace(sanitizedMetricKey.begin(), sanitizedMetricKey.end(), '.', '_');
 
-  auto& histogramFamily = ::prometheus::BuildHistogram()
-                              .Name(sanitizedMetricKey)
-                              .Register(*impl_->registry);
-
-  ::prometheus::Histogram::BucketBoundaries bucketBoundaries;
+  std::vector<double> bucketBoundaries;
   while (numBuckets > 0) {
     bucketBoundaries.push_back(bound);
     bound += bucketWidth;
     numBuckets--;
   }
   VELOX_CHECK_GE(bucketBoundaries.size(), 1);
-  auto& histogramMetric = histogramFamily.Add(impl_->labels, bucketBoundaries);
+  // Histograms are exported over a sliding window so the scraped bucket
+  // counts (and percentiles derived from them) reflect recent observations
+  // rather than the whole process lifetime.
+  auto histogramMetric = std::make_unique<WindowedHistogram>(
+      sanitizedMetricKey, impl_->labels, std::move(bucketBoundaries));
 
-  registeredMetricsMap_.insert(
-      key, StatsInfo{velox::StatType::HISTOGRAM, &histogramMetric});
-  // If percentiles are provided, create a Summary type metric and register.
+  // If percentiles are provided, create a Summary type metric alongside. The
+  // summary is resolved here and remembered in the histogram's StatsInfo so
+  // recording an observation does not rebuild the summary key.
+  ::prometheus::Summary* summaryMetric = nullptr;
   if (pcts.size() > 0) {
     auto summaryMetricKey = sanitizedMetricKey + std::string(kSummarySuffix);
     auto& summaryFamily = ::prometheus::BuildSummary()
@@ -137,119 +161,152 @@ void PrometheusStatsReporter::registerHistogramMetricExportType(
           ::prometheus::detail::CKMSQuantiles::Quantile(
               pct / static_cast<double>(100), 0));
     }
-    auto& summaryMetric = summaryFamily.Add({impl_->labels}, quantiles);
-    registeredMetricsMap_.insert(
-        std::string(key).append(kSummarySuffix),
-        StatsInfo{velox::StatType::HISTOGRAM, &summaryMetric});
+    summaryMetric = &summaryFamily.Add({impl_->labels}, quantiles);
   }
-}
 
-void PrometheusStatsReporter::registerHistogramMetricExportType(
-    folly::StringPiece key,
-    int64_t bucketWidth,
-    int64_t min,
-    int64_t max,
-    const std::vector<int32_t>& pcts) const {
-  registerHistogramMetricExportType(
-      key.toString().c_str(), bucketWidth, min, max, pcts);
+  auto result = registeredMetricsMap_.insert(
+      key.str(),
+      StatsInfo{
+          velox::StatType::HISTOGRAM,
+          histogramMetric.get(),
+          nullptr,
+          summaryMetric});
+  if (result.second) {
+    orderedStats_.wlock()->push_back(&result.first->second);
+  }
+  impl_->windowedHistograms.push_back(std::move(histogramMetric));
 }
 
 void PrometheusStatsReporter::addMetricValue(
     const std::string& key,
     size_t value) const {
-  addMetricValue(key.c_str(), value);
+  addMetricValue(folly::StringPiece(key), value);
 }
 
 void PrometheusStatsReporter::addMetricValue(const char* key, size_t value)
     const {
-  executor_->add([this, key = std::string(key), value]() {
-    auto metricIterator = registeredMetricsMap_.find(key);
-    if (metricIterator == registeredMetricsMap_.end()) {
-      VLOG(1) << "addMetricValue called for unregistered metric " << key;
-      return;
-    }
-    auto statsInfo = metricIterator->second;
-    switch (statsInfo.statType) {
-      case velox::StatType::COUNT: {
-        auto* counter =
-            reinterpret_cast<::prometheus::Counter*>(statsInfo.metricPtr);
-        counter->Increment(static_cast<double>(value));
-        break;
-      }
-      case velox::StatType::SUM: {
-        auto* gauge =
-            reinterpret_cast<::prometheus::Gauge*>(statsInfo.metricPtr);
-        gauge->Increment(static_cast<double>(value));
-        break;
-      }
-      case velox::StatType::AVG:
-      case velox::StatType::RATE: {
-        // Overrides the existing state.
-        auto* gauge =
-            reinterpret_cast<::prometheus::Gauge*>(statsInfo.metricPtr);
-        gauge->Set(static_cast<double>(value));
-        break;
-      }
-      default:
-        VELOX_UNSUPPORTED(
-            "Unsupported metric type {}",
-            velox::statTypeString(statsInfo.statType));
-    };
-  });
+  addMetricValue(folly::StringPiece(key), value);
 }
 
 void PrometheusStatsReporter::addMetricValue(
     folly::StringPiece key,
     size_t value) const {
-  addMetricValue(key.toString().c_str(), value);
+  auto metricIterator = registeredMetricsMap_.find(key);
+  if (metricIterator == registeredMetricsMap_.end()) {
+    VLOG(1) << "addMetricValue called for unregistered metric " << key;
+    return;
+  }
+  // Only touch the pending value here; the prometheus metric itself is
+  // updated at scrape time in fetchMetrics(). This keeps metric recording on
+  // hot paths down to a lock-free map lookup and a relaxed atomic operation.
+  const auto& statsInfo = metricIterator->second;
+  switch (statsInfo.statType) {
+    case velox::StatType::COUNT:
+    case velox::StatType::SUM:
+      statsInfo.pendingValue->fetch_add(
+          static_cast<int64_t>(value), std::memory_order_relaxed);
+      break;
+    case velox::StatType::AVG:
+    case velox::StatType::RATE:
+      // Overrides the existing state.
+      statsInfo.pendingValue->store(
+          static_cast<int64_t>(value), std::memory_order_relaxed);
+      break;
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported metric type {}",
+          velox::statTypeString(statsInfo.statType));
+  };
 }
 
 void PrometheusStatsReporter::addHistogramMetricValue(
     const std::string& key,
     size_t value) const {
-  addHistogramMetricValue(key.c_str(), value);
+  addHistogramMetricValue(folly::StringPiece(key), value);
 }
 
 void PrometheusStatsReporter::addHistogramMetricValue(
     const char* key,
     size_t value) const {
-  executor_->add([this, key = std::string(key), value]() {
-    auto metricIterator = registeredMetricsMap_.find(key);
-    if (metricIterator == registeredMetricsMap_.end()) {
-      VLOG(1) << "addMetricValue for unregistered metric " << key;
-      return;
-    }
-    auto histogram = reinterpret_cast<::prometheus::Histogram*>(
-        metricIterator->second.metricPtr);
-    histogram->Observe(value);
-
-    std::string summaryKey = std::string(key).append(kSummarySuffix);
-    metricIterator = registeredMetricsMap_.find(summaryKey);
-    if (metricIterator != registeredMetricsMap_.end()) {
-      auto summary = reinterpret_cast<::prometheus::Summary*>(
-          metricIterator->second.metricPtr);
-      summary->Observe(value);
-    }
-  });
+  addHistogramMetricValue(folly::StringPiece(key), value);
 }
 
 void PrometheusStatsReporter::addHistogramMetricValue(
     folly::StringPiece key,
     size_t value) const {
-  addHistogramMetricValue(key.toString().c_str(), value);
+  auto metricIterator = registeredMetricsMap_.find(key);
+  if (metricIterator == registeredMetricsMap_.end()) {
+    VLOG(1) << "addMetricValue for unregistered metric " << key;
+    return;
+  }
+  // Histogram and summary objects synchronize internally per metric, so
+  // observations are applied directly instead of going through a pending
+  // value. The companion summary was resolved at registration.
+  const auto& statsInfo = metricIterator->second;
+  auto histogram = reinterpret_cast<WindowedHistogram*>(statsInfo.metricPtr);
+  histogram->observe(value);
+
+  if (statsInfo.summaryPtr != nullptr) {
+    reinterpret_cast<::prometheus::Summary*>(statsInfo.summaryPtr)
+        ->Observe(value);
+  }
 }
 
 std::string PrometheusStatsReporter::fetchMetrics() {
   if (registeredMetricsMap_.empty()) {
     return "";
   }
-  ::prometheus::TextSerializer serializer;
+  // Fold the values accumulated by addMetricValue() since the last scrape
+  // into the prometheus metrics. Walks the dense registration-order array
+  // rather than iterating the concurrent map.
+  {
+    const auto orderedStats = orderedStats_.rlock();
+    for (const auto* statsInfoPtr : *orderedStats) {
+      const auto& statsInfo = *statsInfoPtr;
+      switch (statsInfo.statType) {
+        case velox::StatType::COUNT: {
+          const auto delta =
+              statsInfo.pendingValue->exchange(0, std::memory_order_relaxed);
+          if (delta != 0) {
+            reinterpret_cast<::prometheus::Counter*>(statsInfo.metricPtr)
+                ->Increment(static_cast<double>(delta));
+          }
+          break;
+        }
+        case velox::StatType::SUM: {
+          const auto delta =
+              statsInfo.pendingValue->exchange(0, std::memory_order_relaxed);
+          if (delta != 0) {
+            reinterpret_cast<::prometheus::Gauge*>(statsInfo.metricPtr)
+                ->Increment(static_cast<double>(delta));
+          }
+          break;
+        }
+        case velox::StatType::AVG:
+        case velox::StatType::RATE:
+          reinterpret_cast<::prometheus::Gauge*>(statsInfo.metricPtr)
+              ->Set(static_cast<double>(
+                  statsInfo.pendingValue->load(std::memory_order_relaxed)));
+          break;
+        default:
+          // Histograms and summaries are applied directly on record.
+          break;
+      }
+    }
+  }
+  std::vector<::prometheus::MetricFamily> families;
+  families.reserve(impl_->windowedHistograms.size());
+  for (const auto& histogram : impl_->windowedHistograms) {
+    families.push_back(histogram->collect());
+  }
   // Registry::Collect() acquires lock on a mutex.
-  return serializer.Serialize(impl_->registry->Collect());
-}
-
-void PrometheusStatsReporter::waitForCompletion() const {
-  executor_->join();
+  auto registryFamilies = impl_->registry->Collect();
+  families.insert(
+      families.end(),
+      std::make_move_iterator(registryFamilies.begin()),
+      std::make_move_iterator(registryFamilies.end()));
+  ::prometheus::TextSerializer serializer;
+  return serializer.Serialize(families);
 }
 
 } // namespace facebook::presto::prometheus
@@ -12,8 +12,12 @@
  * limitations under the License.
  */
 
+#include <folly/Range.h>
+#include <folly/Synchronized.h>
 #include <folly/concurrency/ConcurrentHashMap.h>
-#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/hash/Hash.h>
+#include <atomic>
+#include <memory>
 #include "presto_cpp/main/common/Configs.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/GTestMacros.h"
@@ -24,6 +28,14 @@ namespace facebook::presto::prometheus {
 struct StatsInfo {
   velox::StatType statType;
   void* metricPtr;
+  /// Value accumulated by addMetricValue() with relaxed atomic operations
+  /// and folded into the prometheus metric at scrape time. Null for
+  /// histograms, which are applied directly on record.
+  std::shared_ptr<std::atomic<int64_t>> pendingValue;
+  /// For histograms registered with percentiles, the companion summary
+  /// metric. Resolved once at registration so recording an observation does
+  /// not rebuild the summary key string.
+  void* summaryPtr{nullptr};
 };
 
 /// Prometheus CPP library exposes following classes:
@@ -41,8 +53,7 @@ class PrometheusStatsReporter : public facebook::velox::BaseStatsReporter {
 
  public:
   explicit PrometheusStatsReporter(
-      const std::map<std::string, std::string>& labels,
-      int numThreads);
+      const std::map<std::string, std::string>& labels);
 
   void registerMetricExportType(const char* key, velox::StatType)
       const override;
@@ -128,12 +139,6 @@ class PrometheusStatsReporter : public facebook::velox::BaseStatsReporter {
 
   std::string fetchMetrics() override;
 
-  /**
-   * Waits for all pending metric updates to complete.
-   * This is only used in tests to ensure correct timing.
-   */
-  void waitForCompletion() const;
-
   static std::unique_ptr<velox::BaseStatsReporter> createPrometheusReporter() {
     auto nodeConfig = NodeConfig::instance();
     const std::string cluster = nodeConfig->nodeEnvironment();
@@ -141,17 +146,26 @@ class PrometheusStatsReporter : public facebook::velox::BaseStatsReporter {
     const std::string worker = !hostName ? "" : hostName;
     std::map<std::string, std::string> labels{
         {"cluster", cluster}, {"worker", worker}};
-    return std::make_unique<PrometheusStatsReporter>(
-        labels, nodeConfig->prometheusExecutorThreads());
+    return std::make_unique<PrometheusStatsReporter>(labels);
   }
 
  private:
-  std::shared_ptr<folly::CPUThreadPoolExecutor> executor_;
+  // Keyed by the velox metric name with transparent hashing so the per-report
+  // lookup works off a StringPiece without materializing a std::string.
+  using MetricsMap = folly::ConcurrentHashMap<
+      std::string,
+      StatsInfo,
+      folly::transparent<folly::hasher<folly::StringPiece>>,
+      folly::transparent<std::equal_to<folly::StringPiece>>>;
+
   std::shared_ptr<PrometheusImpl> impl_;
   // A map of labels assigned to each metric which helps in filtering at client
   // end.
-  mutable folly::ConcurrentHashMap<std::string, StatsInfo>
-      registeredMetricsMap_;
+  mutable MetricsMap registeredMetricsMap_;
+  // Registration-order pointers into 'registeredMetricsMap_' nodes. Entries
+  // are never erased, so the addresses are stable; fetchMetrics() walks this
+  // dense array instead of iterating the concurrent map.
+  mutable folly::Synchronized<std::vector<const StatsInfo*>> orderedStats_;
   VELOX_FRIEND_TEST(PrometheusReporterTest, testCountAndGauge);
   VELOX_FRIEND_TEST(PrometheusReporterTest, testHistogramSummary);
   VELOX_FRIEND_TEST(PrometheusReporterTest, testConcurrentReporting);
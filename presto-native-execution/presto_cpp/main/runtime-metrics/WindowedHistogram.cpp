@@ -0,0 +1,110 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "presto_cpp/main/runtime-metrics/WindowedHistogram.h"
+
+#include <prometheus/metric_type.h>
+#include <algorithm>
+#include <chrono>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::presto::prometheus {
+
+WindowedHistogram::WindowedHistogram(
+    std::string name,
+    ::prometheus::Labels labels,
+    std::vector<double> bucketBoundaries,
+    int windowMinutes)
+    : name_(std::move(name)),
+      labels_(std::move(labels)),
+      bucketBoundaries_(std::move(bucketBoundaries)),
+      windowMinutes_(windowMinutes),
+      slots_(windowMinutes_) {
+  VELOX_CHECK_GE(bucketBoundaries_.size(), 1);
+  VELOX_CHECK_GE(windowMinutes_, 1);
+  for (auto& slot : slots_) {
+    slot.bucketCounts.resize(bucketBoundaries_.size() + 1, 0);
+  }
+}
+
+// static
+int64_t WindowedHistogram::nowEpochMinute() {
+  return std::chrono::duration_cast<std::chrono::minutes>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+void WindowedHistogram::observe(double value) {
+  observeAt(nowEpochMinute(), value);
+}
+
+void WindowedHistogram::observeAt(int64_t epochMinute, double value) {
+  const auto bucketIndex = std::distance(
+      bucketBoundaries_.begin(),
+      std::lower_bound(
+          bucketBoundaries_.begin(), bucketBoundaries_.end(), value));
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& slot = slots_[epochMinute % slots_.size()];
+  if (slot.epochMinute != epochMinute) {
+    slot.epochMinute = epochMinute;
+    slot.sum = 0;
+    slot.count = 0;
+    std::fill(slot.bucketCounts.begin(), slot.bucketCounts.end(), 0);
+  }
+  slot.sum += value;
+  ++slot.count;
+  ++slot.bucketCounts[bucketIndex];
+}
+
+::prometheus::MetricFamily WindowedHistogram::collect() const {
+  return collectAt(nowEpochMinute());
+}
+
+::prometheus::MetricFamily WindowedHistogram::collectAt(
+    int64_t epochMinute) const {
+  ::prometheus::ClientMetric metric;
+  for (const auto& label : labels_) {
+    metric.label.push_back({label.first, label.second});
+  }
+  std::vector<uint64_t> bucketCounts(bucketBoundaries_.size() + 1, 0);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& slot : slots_) {
+      // Skip slots that have aged out of the window or were never written.
+      if (slot.epochMinute <= epochMinute - windowMinutes_ ||
+          slot.epochMinute > epochMinute) {
+        continue;
+      }
+      metric.histogram.sample_sum += slot.sum;
+      metric.histogram.sample_count += slot.count;
+      for (size_t i = 0; i < bucketCounts.size(); ++i) {
+        bucketCounts[i] += slot.bucketCounts[i];
+      }
+    }
+  }
+  uint64_t cumulativeCount = 0;
+  for (size_t i = 0; i < bucketBoundaries_.size(); ++i) {
+    cumulativeCount += bucketCounts[i];
+    metric.histogram.bucket.push_back({cumulativeCount, bucketBoundaries_[i]});
+  }
+
+  ::prometheus::MetricFamily family;
+  family.name = name_;
+  family.type = ::prometheus::MetricType::Histogram;
+  family.metric.push_back(std::move(metric));
+  return family;
+}
+
+} // namespace facebook::presto::prometheus
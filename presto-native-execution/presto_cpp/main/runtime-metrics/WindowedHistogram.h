@@ -0,0 +1,78 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <prometheus/client_metric.h>
+#include <prometheus/labels.h>
+#include <prometheus/metric_family.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::presto::prometheus {
+
+/// Histogram that only reports observations made within the last
+/// 'windowMinutes' minutes. Observations are recorded into a ring of
+/// per-minute slots; collect() merges the slots that are still inside the
+/// window into one cumulative histogram. Unlike a process-lifetime
+/// histogram, the reported bucket counts (and hence any percentile derived
+/// from them) track recent behavior and recover once a latency spike has
+/// aged out of the window.
+class WindowedHistogram {
+ public:
+  static constexpr int kDefaultWindowMinutes{5};
+
+  WindowedHistogram(
+      std::string name,
+      ::prometheus::Labels labels,
+      std::vector<double> bucketBoundaries,
+      int windowMinutes = kDefaultWindowMinutes);
+
+  void observe(double value);
+
+  /// Returns the observations of the last 'windowMinutes' minutes merged
+  /// into a single scrapeable metric family.
+  ::prometheus::MetricFamily collect() const;
+
+  /// Variants of observe() and collect() taking an explicit epoch minute.
+  /// Used in tests to verify that old slots age out of the window.
+  void observeAt(int64_t epochMinute, double value);
+
+  ::prometheus::MetricFamily collectAt(int64_t epochMinute) const;
+
+ private:
+  /// One minute worth of observations.
+  struct Slot {
+    /// Epoch minute the slot holds data for, or -1 if never used. A slot is
+    /// reset when a new minute hashes onto it.
+    int64_t epochMinute{-1};
+    double sum{0};
+    uint64_t count{0};
+    /// Per-bucket (non-cumulative) observation counts; the last entry is the
+    /// overflow (+Inf) bucket.
+    std::vector<uint64_t> bucketCounts;
+  };
+
+  static int64_t nowEpochMinute();
+
+  const std::string name_;
+  const ::prometheus::Labels labels_;
+  const std::vector<double> bucketBoundaries_;
+  const int windowMinutes_;
+
+  mutable std::mutex mutex_;
+  std::vector<Slot> slots_;
+};
+
+} // namespace facebook::presto::prometheus
@@ -15,14 +15,15 @@
 #include "presto_cpp/main/runtime-metrics/PrometheusStatsReporter.h"
 
 #include <gtest/gtest.h>
+#include <thread>
+
+#include "presto_cpp/main/runtime-metrics/WindowedHistogram.h"
 
 namespace facebook::presto::prometheus {
 class PrometheusReporterTest : public testing::Test {
  public:
   void SetUp() override {
-    reporter = std::make_shared<PrometheusStatsReporter>(testLabels, 1);
-    multiThreadedReporter =
-        std::make_shared<PrometheusStatsReporter>(testLabels, 2);
+    reporter = std::make_shared<PrometheusStatsReporter>(testLabels);
   }
 
   void verifySerializedResult(
@@ -42,43 +43,46 @@ class PrometheusReporterTest : public testing::Test {
   const std::string labelsSerialized =
       R"(cluster="test_cluster",worker="test_worker_pod")";
   std::shared_ptr<PrometheusStatsReporter> reporter;
-  std::shared_ptr<PrometheusStatsReporter> multiThreadedReporter;
 };
 
 TEST_F(PrometheusReporterTest, testConcurrentReporting) {
-  multiThreadedReporter->registerMetricExportType(
+  reporter->registerMetricExportType(
       "test.key1", facebook::velox::StatType::COUNT);
-  multiThreadedReporter->registerMetricExportType(
+  reporter->registerMetricExportType(
       "test.key3", facebook::velox::StatType::SUM);
   EXPECT_EQ(
       facebook::velox::StatType::COUNT,
-      multiThreadedReporter->registeredMetricsMap_.find("test.key1")
-          ->second.statType);
+      reporter->registeredMetricsMap_.find("test.key1")->second.statType);
   EXPECT_EQ(
       facebook::velox::StatType::SUM,
-      multiThreadedReporter->registeredMetricsMap_.find("test.key3")
-          ->second.statType);
+      reporter->registeredMetricsMap_.find("test.key3")->second.statType);
 
-  std::vector<size_t> testData = {10, 12, 14};
-  for (auto i : testData) {
-    multiThreadedReporter->addMetricValue("test.key1", i);
-    multiThreadedReporter->addMetricValue("test.key3", i + 2000);
+  constexpr int kNumThreads = 4;
+  const std::vector<size_t> testData = {10, 12, 14};
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (auto value : testData) {
+        reporter->addMetricValue("test.key1", value);
+        reporter->addMetricValue("test.key3", value + 2000);
+      }
+      // Uses default value of 1 for second parameter.
+      reporter->addMetricValue("test.key1");
+      reporter->addMetricValue("test.key3");
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
   }
 
-  // Uses default value of 1 for second parameter.
-  multiThreadedReporter->addMetricValue("test.key1");
-  multiThreadedReporter->addMetricValue("test.key3");
-
-  // Wait for all async updates to finish before validation
-  multiThreadedReporter->waitForCompletion();
-
-  auto fullSerializedResult = multiThreadedReporter->fetchMetrics();
+  auto fullSerializedResult = reporter->fetchMetrics();
 
   std::vector<std::string> expected = {
       "# TYPE test_key1 counter",
-      "test_key1{" + labelsSerialized + "} 37",
+      "test_key1{" + labelsSerialized + "} 148",
       "# TYPE test_key3 gauge",
-      "test_key3{" + labelsSerialized + "} 6037"};
+      "test_key3{" + labelsSerialized + "} 24148"};
 
   verifySerializedResult(fullSerializedResult, expected);
 };
@@ -116,7 +120,6 @@ TEST_F(PrometheusReporterTest, testCountAndGauge) {
   // Uses default value of 1 for second parameter.
   reporter->addMetricValue("test.key1");
   reporter->addMetricValue("test.key3");
-  reporter->waitForCompletion();
 
   auto fullSerializedResult = reporter->fetchMetrics();
 
@@ -156,7 +159,6 @@ TEST_F(PrometheusReporterTest, testHistogramSummary) {
     }
   }
   reporter->addHistogramMetricValue(histogramKey, 10);
-  reporter->waitForCompletion();
   auto fullSerializedResult = reporter->fetchMetrics();
   std::replace(histSummaryKey.begin(), histSummaryKey.end(), '.', '_');
   std::replace(histogramKey.begin(), histogramKey.end(), '.', '_');
@@ -201,4 +203,38 @@ TEST_F(PrometheusReporterTest, testHistogramSummary) {
       histSummaryKey + "_summary{" + labelsSerialized + ",quantile=\"1\"} 85"};
   verifySerializedResult(fullSerializedResult, histogramMetricsFormatted);
 }
+
+TEST_F(PrometheusReporterTest, windowedHistogramExpiry) {
+  WindowedHistogram histogram(
+      "test_windowed", {{"cluster", "test_cluster"}}, {10, 20, 30});
+  const int64_t minute = 1'000'000;
+  histogram.observeAt(minute, 15);
+  histogram.observeAt(minute, 25);
+
+  auto family = histogram.collectAt(minute);
+  ASSERT_EQ(1, family.metric.size());
+  EXPECT_EQ(2, family.metric[0].histogram.sample_count);
+  EXPECT_EQ(40, family.metric[0].histogram.sample_sum);
+  // Cumulative bucket counts: le=10 -> 0, le=20 -> 1, le=30 -> 2.
+  EXPECT_EQ(0, family.metric[0].histogram.bucket[0].cumulative_count);
+  EXPECT_EQ(1, family.metric[0].histogram.bucket[1].cumulative_count);
+  EXPECT_EQ(2, family.metric[0].histogram.bucket[2].cumulative_count);
+
+  // Observations from different minutes inside the window are merged.
+  histogram.observeAt(minute + 2, 5);
+  family = histogram.collectAt(minute + 2);
+  EXPECT_EQ(3, family.metric[0].histogram.sample_count);
+  EXPECT_EQ(45, family.metric[0].histogram.sample_sum);
+
+  // Once the first minute ages out, only the later observation remains.
+  family =
+      histogram.collectAt(minute + WindowedHistogram::kDefaultWindowMinutes);
+  EXPECT_EQ(1, family.metric[0].histogram.sample_count);
+  EXPECT_EQ(5, family.metric[0].histogram.sample_sum);
+
+  // Eventually everything ages out and the histogram reads empty.
+  family = histogram.collectAt(minute + 100);
+  EXPECT_EQ(0, family.metric[0].histogram.sample_count);
+  EXPECT_EQ(0, family.metric[0].histogram.sample_sum);
+}
 } // namespace facebook::presto::prometheus
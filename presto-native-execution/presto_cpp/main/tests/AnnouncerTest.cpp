@@ -14,7 +14,10 @@
 #include "presto_cpp/main/Announcer.h"
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
+#include <folly/Synchronized.h>
 #include <gtest/gtest.h>
+#include <thread>
+#include "presto_cpp/external/json/nlohmann/json.hpp"
 #include "presto_cpp/main/common/Utils.h"
 #include "presto_cpp/main/tests/HttpServerWrapper.h"
 
@@ -176,6 +179,7 @@ TEST_P(AnnouncerTestSuite, basic) {
       "DEFAULT",
       true,
       {"hive", "tpch"},
+      false /*deltaAnnouncementEnabled*/,
       500 /*milliseconds*/,
       useHttps ? sslContext_ : nullptr);
 
@@ -189,3 +193,165 @@ INSTANTIATE_TEST_CASE_P(
     AnnouncerTest,
     AnnouncerTestSuite,
     ::testing::Values(true, false));
+
+namespace {
+
+class StaticCoordinatorDiscoverer : public CoordinatorDiscoverer {
+ public:
+  explicit StaticCoordinatorDiscoverer(folly::SocketAddress address)
+      : address_(std::move(address)) {}
+
+  folly::SocketAddress updateAddress() override {
+    return address_;
+  }
+
+ private:
+  const folly::SocketAddress address_;
+};
+
+} // namespace
+
+TEST(AnnouncerTest, deltaAnnouncement) {
+  folly::Synchronized<std::vector<std::string>> bodies;
+  auto [promise, future] = folly::makePromiseContract<bool>();
+  auto promiseHolder =
+      std::make_shared<PromiseHolder<bool>>(std::move(promise));
+
+  auto httpServer = createHttpServer(false);
+  httpServer->registerPut(
+      R"(/v1/announcement/(.+))",
+      [&bodies, promiseHolder](
+          proxygen::HTTPMessage* /*message*/,
+          const std::vector<std::unique_ptr<folly::IOBuf>>& body,
+          proxygen::ResponseHandler* downstream) {
+        auto lockedBodies = bodies.wlock();
+        lockedBodies->push_back(util::extractMessageBody(body));
+        if (lockedBodies->size() == 4) {
+          promiseHolder->get().setValue(true);
+        }
+        proxygen::ResponseBuilder(downstream)
+            .status(http::kHttpAccepted, "Accepted")
+            .sendWithEOM();
+      });
+  auto discoveryServer =
+      std::make_unique<facebook::presto::test::HttpServerWrapper>(
+          std::move(httpServer));
+  const auto serverAddress = discoveryServer->start().get();
+
+  Announcer announcer(
+      "127.0.0.1",
+      false,
+      1234,
+      std::make_shared<StaticCoordinatorDiscoverer>(serverAddress),
+      "testversion",
+      "testing",
+      "test-node",
+      "test-node-location",
+      "DEFAULT",
+      true,
+      {"hive", "tpch"},
+      true /*deltaAnnouncementEnabled*/,
+      100 /*milliseconds*/,
+      nullptr);
+
+  announcer.start();
+  ASSERT_TRUE(std::move(future).getTry().hasValue());
+  announcer.stop();
+
+  const auto receivedBodies = bodies.copy();
+  ASSERT_GE(receivedBodies.size(), 4);
+
+  // The first announcement carries the full service descriptor; steady-state
+  // refreshes carry only the announcement identity.
+  const auto fullBody = nlohmann::json::parse(receivedBodies[0]);
+  ASSERT_NE(receivedBodies[0].find("connectorIds"), std::string::npos);
+  for (size_t i = 1; i < 4; ++i) {
+    const auto deltaBody = nlohmann::json::parse(receivedBodies[i]);
+    EXPECT_EQ(receivedBodies[i].find("connectorIds"), std::string::npos);
+    EXPECT_LT(receivedBodies[i].size(), receivedBodies[0].size());
+    EXPECT_EQ(
+        deltaBody["services"][0]["id"], fullBody["services"][0]["id"]);
+    EXPECT_EQ(deltaBody["environment"], fullBody["environment"]);
+  }
+}
+
+TEST(AnnouncerTest, capabilitiesUpdate) {
+  folly::Synchronized<std::vector<std::string>> bodies;
+  auto [promise, future] = folly::makePromiseContract<bool>();
+  auto promiseHolder =
+      std::make_shared<PromiseHolder<bool>>(std::move(promise));
+
+  auto httpServer = createHttpServer(false);
+  httpServer->registerPut(
+      R"(/v1/announcement/(.+))",
+      [&bodies, promiseHolder](
+          proxygen::HTTPMessage* /*message*/,
+          const std::vector<std::unique_ptr<folly::IOBuf>>& body,
+          proxygen::ResponseHandler* downstream) {
+        auto lockedBodies = bodies.wlock();
+        lockedBodies->push_back(util::extractMessageBody(body));
+        if (lockedBodies->size() == 6) {
+          promiseHolder->get().setValue(true);
+        }
+        proxygen::ResponseBuilder(downstream)
+            .status(http::kHttpAccepted, "Accepted")
+            .sendWithEOM();
+      });
+  auto discoveryServer =
+      std::make_unique<facebook::presto::test::HttpServerWrapper>(
+          std::move(httpServer));
+  const auto serverAddress = discoveryServer->start().get();
+
+  Announcer announcer(
+      "127.0.0.1",
+      false,
+      1234,
+      std::make_shared<StaticCoordinatorDiscoverer>(serverAddress),
+      "testversion",
+      "testing",
+      "test-node",
+      "test-node-location",
+      "DEFAULT",
+      true,
+      {"hive", "tpch"},
+      true /*deltaAnnouncementEnabled*/,
+      100 /*milliseconds*/,
+      nullptr);
+
+  announcer.setCapabilities({"task-execution"});
+  announcer.start();
+  // Let a couple of announcements go out before the capability change.
+  while (bodies.rlock()->size() < 2) {
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  announcer.setCapabilities({"task-execution", "remote-functions"});
+  ASSERT_TRUE(std::move(future).getTry().hasValue());
+  announcer.stop();
+
+  const auto receivedBodies = bodies.copy();
+  ASSERT_GE(receivedBodies.size(), 6);
+
+  // The initial full announcement advertises only the starting capability.
+  const auto fullBody = nlohmann::json::parse(receivedBodies[0]);
+  EXPECT_EQ(
+      fullBody["services"][0]["properties"]["capabilities"], "task-execution");
+
+  // The capability change forces a full re-announcement carrying the updated
+  // list; afterwards steady-state refreshes are deltas again.
+  bool sawUpdatedFullBody = false;
+  bool sawDeltaAfterUpdate = false;
+  for (size_t i = 1; i < receivedBodies.size(); ++i) {
+    if (receivedBodies[i].find("capabilities") == std::string::npos) {
+      sawDeltaAfterUpdate |= sawUpdatedFullBody;
+      continue;
+    }
+    const auto body = nlohmann::json::parse(receivedBodies[i]);
+    EXPECT_EQ(
+        body["services"][0]["properties"]["capabilities"],
+        "task-execution,remote-functions");
+    sawUpdatedFullBody = true;
+  }
+  EXPECT_TRUE(sawUpdatedFullBody);
+  EXPECT_TRUE(sawDeltaAfterUpdate);
+}
@@ -0,0 +1,73 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/AutoTraceRegistry.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::presto {
+
+class AutoTraceRegistryTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    AutoTraceRegistry::instance()->testingClear();
+  }
+
+  void TearDown() override {
+    AutoTraceRegistry::instance()->testingClear();
+  }
+};
+
+TEST_F(AutoTraceRegistryTest, outlierDetection) {
+  auto* registry = AutoTraceRegistry::instance();
+
+  // No decisions before the sample window fills to its minimum; even an
+  // extreme task is not flagged.
+  EXPECT_FALSE(registry->isOutlier(1'000'000, 1'000'000'000, 99));
+
+  // 1000 completed tasks: runtimes 1..1000 ms, peak memory 1..1000 bytes.
+  for (uint64_t i = 1; i <= 1'000; ++i) {
+    registry->addCompletedTask(i, i);
+  }
+
+  // Clearly below the 99th percentile on both dimensions.
+  EXPECT_FALSE(registry->isOutlier(500, 500, 99));
+  // At the tail on runtime only.
+  EXPECT_TRUE(registry->isOutlier(2'000, 1, 99));
+  // At the tail on peak memory only.
+  EXPECT_TRUE(registry->isOutlier(1, 2'000, 99));
+}
+
+TEST_F(AutoTraceRegistryTest, promotionCapAndTtl) {
+  auto* registry = AutoTraceRegistry::instance();
+  const uint64_t nowMs = 1'000'000;
+  const uint64_t ttlMs = 60'000;
+
+  EXPECT_TRUE(registry->tryPromote("etl-pipeline", 2, ttlMs, nowMs));
+  // Re-promotion of an active source is a no-op.
+  EXPECT_FALSE(registry->tryPromote("etl-pipeline", 2, ttlMs, nowMs));
+  EXPECT_TRUE(registry->tryPromote("dashboard", 2, ttlMs, nowMs));
+  // The cap on concurrently promoted sources holds.
+  EXPECT_FALSE(registry->tryPromote("adhoc", 2, ttlMs, nowMs));
+
+  EXPECT_TRUE(registry->isPromoted("etl-pipeline", nowMs));
+  EXPECT_FALSE(registry->isPromoted("adhoc", nowMs));
+
+  // Past the TTL the promotions expire and free their slots.
+  const uint64_t laterMs = nowMs + ttlMs;
+  EXPECT_FALSE(registry->isPromoted("etl-pipeline", laterMs));
+  EXPECT_TRUE(registry->tryPromote("adhoc", 2, ttlMs, laterMs));
+  EXPECT_TRUE(registry->isPromoted("adhoc", laterMs));
+}
+
+} // namespace facebook::presto
@@ -0,0 +1,92 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/CrashHandoff.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+namespace facebook::presto {
+namespace {
+
+// Binds a UDP socket on the loopback and returns it with its port.
+int bindLoopbackUdpSocket(uint16_t& port) {
+  const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  EXPECT_GE(fd, 0);
+  sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  EXPECT_EQ(
+      ::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), 0);
+  socklen_t addrLen = sizeof(addr);
+  EXPECT_EQ(::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addrLen), 0);
+  port = ntohs(addr.sin_port);
+  return fd;
+}
+
+std::string receiveDatagram(int fd) {
+  pollfd pfd{fd, POLLIN, 0};
+  EXPECT_GT(::poll(&pfd, 1, 5'000), 0);
+  char buffer[2048];
+  const auto size = ::recv(fd, buffer, sizeof(buffer), 0);
+  EXPECT_GT(size, 0);
+  return std::string(buffer, size);
+}
+
+TEST(CrashHandoffTest, dumpAndNotice) {
+  const auto tempDir = velox::exec::test::TempDirectoryPath::create();
+  const auto dumpPath = tempDir->getPath() + "/crash_handoff";
+  uint16_t port{0};
+  const int receiver = bindLoopbackUdpSocket(port);
+
+  auto* handoff = CrashHandoff::instance();
+  handoff->start(dumpPath, fmt::format("127.0.0.1:{}", port), "test-node");
+  handoff->updateSnapshot(
+      "task 20250831_q1.1.0.0.0 RUNNING 0:12 1:7\n"
+      "task 20250831_q1.2.0.0.0 RUNNING 0:3\n");
+
+  handoff->onFatalSignal(SIGSEGV);
+
+  std::ifstream dump(dumpPath);
+  std::string contents(
+      (std::istreambuf_iterator<char>(dump)), std::istreambuf_iterator<char>());
+  EXPECT_NE(contents.find("presto_worker_crash"), std::string::npos);
+  EXPECT_NE(contents.find("node test-node"), std::string::npos);
+  EXPECT_NE(
+      contents.find(fmt::format("signal {}", SIGSEGV)), std::string::npos);
+  EXPECT_NE(contents.find("task 20250831_q1.2.0.0.0"), std::string::npos);
+
+  const auto notice = receiveDatagram(receiver);
+  EXPECT_NE(notice.find("node test-node"), std::string::npos);
+  EXPECT_NE(notice.find("task 20250831_q1.1.0.0.0"), std::string::npos);
+
+  // The handoff fires at most once per crash; a second signal is a no-op.
+  handoff->onFatalSignal(SIGABRT);
+  pollfd pfd{receiver, POLLIN, 0};
+  EXPECT_EQ(::poll(&pfd, 1, 100), 0);
+
+  handoff->testingReset();
+  ::close(receiver);
+}
+
+} // namespace
+} // namespace facebook::presto
@@ -0,0 +1,116 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/ExchangeMaterializer.h"
+
+#include <gtest/gtest.h>
+
+#include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/operators/BroadcastFile.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+namespace facebook::presto {
+namespace {
+
+class ExchangeMaterializerTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    velox::filesystems::registerLocalFileSystem();
+    velox::memory::MemoryManager::testingSetInstance(
+        velox::memory::MemoryManager::Options{});
+  }
+
+  void SetUp() override {
+    tempDir_ = velox::exec::test::TempDirectoryPath::create();
+    SystemConfig::instance()->setValue(
+        std::string(SystemConfig::kExchangeMaterializationBasePath),
+        tempDir_->getPath());
+    pool_ = velox::memory::MemoryManager::getInstance()->addLeafPool(
+        "ExchangeMaterializerTest");
+  }
+
+  static std::vector<std::unique_ptr<folly::IOBuf>> makePages(
+      const std::vector<std::string>& pages) {
+    std::vector<std::unique_ptr<folly::IOBuf>> batch;
+    for (const auto& page : pages) {
+      batch.push_back(folly::IOBuf::copyBuffer(page));
+    }
+    return batch;
+  }
+
+  std::vector<std::string> readSealedFile(const std::string& filePath) {
+    auto fileInfo = std::make_unique<operators::BroadcastFileInfo>();
+    fileInfo->filePath_ = filePath;
+    auto fileSystem = velox::filesystems::getFileSystem(filePath, nullptr);
+    operators::BroadcastFileReader reader(fileInfo, fileSystem, pool_.get());
+    std::vector<std::string> pages;
+    while (reader.hasNext()) {
+      auto buffer = reader.next();
+      pages.push_back(std::string(buffer->as<char>(), buffer->size()));
+    }
+    return pages;
+  }
+
+  std::shared_ptr<velox::exec::test::TempDirectoryPath> tempDir_;
+  std::shared_ptr<velox::memory::MemoryPool> pool_;
+};
+
+TEST_F(ExchangeMaterializerTest, sealsAfterGapsFill) {
+  const std::string taskId = "task-materialize-1";
+  auto* materializer = ExchangeMaterializer::instance();
+  const auto filePath =
+      ExchangeMaterializer::filePath(tempDir_->getPath(), taskId, 0);
+  auto fileSystem = velox::filesystems::getFileSystem(filePath, nullptr);
+
+  materializer->append(taskId, 0, 0, makePages({"page-0", "page-1"}));
+  // Fetched ahead of the gap at sequence 2; the end marker follows page-3.
+  auto tail = makePages({"page-3"});
+  tail.push_back(nullptr);
+  materializer->append(taskId, 0, 3, tail);
+  EXPECT_FALSE(fileSystem->exists(filePath));
+
+  // A repeated fetch of an already-written sequence is ignored.
+  materializer->append(taskId, 0, 1, makePages({"page-1"}));
+
+  materializer->append(taskId, 0, 2, makePages({"page-2"}));
+  ASSERT_TRUE(fileSystem->exists(filePath));
+  EXPECT_EQ(
+      readSealedFile(filePath),
+      std::vector<std::string>({"page-0", "page-1", "page-2", "page-3"}));
+}
+
+TEST_F(ExchangeMaterializerTest, abortRemovesPartialFile) {
+  const std::string taskId = "task-materialize-2";
+  auto* materializer = ExchangeMaterializer::instance();
+  const auto filePath =
+      ExchangeMaterializer::filePath(tempDir_->getPath(), taskId, 0);
+  auto fileSystem = velox::filesystems::getFileSystem(filePath, nullptr);
+
+  // No end marker ever arrives for this buffer.
+  materializer->append(taskId, 0, 0, makePages({"page-0"}));
+  materializer->abortTask(taskId);
+  EXPECT_FALSE(fileSystem->exists(filePath));
+  EXPECT_FALSE(fileSystem->exists(filePath + ".tmp"));
+
+  // Appends after the abort start a fresh materialization.
+  auto batch = makePages({"page-0"});
+  batch.push_back(nullptr);
+  materializer->append(taskId, 0, 0, batch);
+  ASSERT_TRUE(fileSystem->exists(filePath));
+  EXPECT_EQ(readSealedFile(filePath), std::vector<std::string>({"page-0"}));
+}
+
+} // namespace
+} // namespace facebook::presto
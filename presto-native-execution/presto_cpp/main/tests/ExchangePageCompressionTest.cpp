@@ -0,0 +1,155 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/ExchangePageCompression.h"
+
+#include <folly/Random.h>
+#include <gtest/gtest.h>
+#include "velox/common/base/VeloxException.h"
+
+namespace facebook::presto {
+namespace {
+
+// Builds a body that mimics a dictionary-encoded exchange page: the same
+// small vocabulary of column values repeated with varying row data.
+std::unique_ptr<folly::IOBuf> makeRepetitiveBody(uint32_t seed) {
+  static const std::vector<std::string> kVocabulary = {
+      "nation_key", "region_key", "market_segment", "order_priority",
+      "ship_mode",  "AIR",        "TRUCK",          "RAIL",
+  };
+  std::string body;
+  folly::Random::DefaultGenerator rng(seed);
+  for (int i = 0; i < 400; ++i) {
+    body += kVocabulary[folly::Random::rand32(kVocabulary.size(), rng)];
+    body += std::to_string(folly::Random::rand32(rng));
+  }
+  return folly::IOBuf::copyBuffer(body);
+}
+
+std::string toString(const folly::IOBuf& body) {
+  std::string out;
+  for (const auto range : body) {
+    out.append(reinterpret_cast<const char*>(range.data()), range.size());
+  }
+  return out;
+}
+
+TEST(ExchangePageCompressionTest, roundTrip) {
+  constexpr uint32_t kTrainingPages = 64;
+  ExchangePageCompressor compressor(kTrainingPages);
+  EXPECT_EQ(compressor.dictionaryId(), -1);
+  EXPECT_TRUE(compressor.dictionary().empty());
+
+  // The training bodies pass through unchanged.
+  bool compressed;
+  for (uint32_t i = 0; i < kTrainingPages; ++i) {
+    const auto original = toString(*makeRepetitiveBody(i));
+    auto out = compressor.compress(makeRepetitiveBody(i), compressed);
+    EXPECT_FALSE(compressed);
+    EXPECT_EQ(toString(*out), original);
+  }
+  ASSERT_GE(compressor.dictionaryId(), 0);
+  ASSERT_FALSE(compressor.dictionary().empty());
+
+  // Later bodies are compressed and round-trip through the decompressor.
+  ExchangePageDecompressor decompressor;
+  EXPECT_EQ(decompressor.dictionaryId(), -1);
+  decompressor.setDictionary(compressor.dictionary());
+  EXPECT_EQ(decompressor.dictionaryId(), compressor.dictionaryId());
+
+  for (uint32_t i = kTrainingPages; i < kTrainingPages + 10; ++i) {
+    const auto original = toString(*makeRepetitiveBody(i));
+    auto out = compressor.compress(makeRepetitiveBody(i), compressed);
+    ASSERT_TRUE(compressed);
+    EXPECT_LT(out->computeChainDataLength(), original.size());
+    auto decompressed =
+        decompressor.decompress(*out, compressor.dictionaryId());
+    EXPECT_EQ(toString(*decompressed), original);
+  }
+}
+
+TEST(ExchangePageCompressionTest, chainedBody) {
+  constexpr uint32_t kTrainingPages = 64;
+  ExchangePageCompressor compressor(kTrainingPages);
+  bool compressed;
+  for (uint32_t i = 0; i < kTrainingPages; ++i) {
+    compressor.compress(makeRepetitiveBody(i), compressed);
+  }
+  ASSERT_GE(compressor.dictionaryId(), 0);
+
+  // Both sides accept chained iobufs, as produced by the buffer manager and
+  // the http client respectively.
+  auto chained = makeRepetitiveBody(100);
+  chained->prependChain(makeRepetitiveBody(101));
+  const auto original = toString(*chained);
+  auto out = compressor.compress(std::move(chained), compressed);
+  ASSERT_TRUE(compressed);
+
+  // Re-chain the compressed payload by splitting it in two.
+  const auto compressedFlat = toString(*out);
+  const auto half = compressedFlat.size() / 2;
+  auto compressedChain =
+      folly::IOBuf::copyBuffer(compressedFlat.data(), half);
+  compressedChain->prependChain(folly::IOBuf::copyBuffer(
+      compressedFlat.data() + half, compressedFlat.size() - half));
+
+  ExchangePageDecompressor decompressor;
+  decompressor.setDictionary(compressor.dictionary());
+  auto decompressed =
+      decompressor.decompress(*compressedChain, compressor.dictionaryId());
+  EXPECT_EQ(toString(*decompressed), original);
+  // The compressed chain is left intact for the caller to free.
+  EXPECT_EQ(toString(*compressedChain), compressedFlat);
+}
+
+TEST(ExchangePageCompressionTest, incompressibleBody) {
+  constexpr uint32_t kTrainingPages = 64;
+  ExchangePageCompressor compressor(kTrainingPages);
+  bool compressed;
+  for (uint32_t i = 0; i < kTrainingPages; ++i) {
+    compressor.compress(makeRepetitiveBody(i), compressed);
+  }
+  ASSERT_GE(compressor.dictionaryId(), 0);
+
+  // Random bytes do not shrink and are passed through uncompressed even
+  // with a dictionary available.
+  std::string random(8192, '\0');
+  for (auto& c : random) {
+    c = folly::Random::rand32(256);
+  }
+  auto out =
+      compressor.compress(folly::IOBuf::copyBuffer(random), compressed);
+  EXPECT_FALSE(compressed);
+  EXPECT_EQ(toString(*out), random);
+}
+
+TEST(ExchangePageCompressionTest, dictionaryIdMismatch) {
+  constexpr uint32_t kTrainingPages = 64;
+  ExchangePageCompressor compressor(kTrainingPages);
+  bool compressed;
+  for (uint32_t i = 0; i < kTrainingPages; ++i) {
+    compressor.compress(makeRepetitiveBody(i), compressed);
+  }
+  ASSERT_GE(compressor.dictionaryId(), 0);
+  auto out = compressor.compress(makeRepetitiveBody(100), compressed);
+  ASSERT_TRUE(compressed);
+
+  ExchangePageDecompressor decompressor;
+  decompressor.setDictionary(compressor.dictionary());
+  EXPECT_THROW(
+      decompressor.decompress(*out, compressor.dictionaryId() + 1),
+      velox::VeloxException);
+}
+
+} // namespace
+} // namespace facebook::presto
@@ -0,0 +1,65 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/ExchangeTracer.h"
+
+#include <folly/json.h>
+#include <gtest/gtest.h>
+
+namespace facebook::presto {
+namespace {
+
+TEST(ExchangeTracerTest, sampling) {
+  auto* tracer = ExchangeTracer::instance();
+  const std::string path = "/v1/task/20260831_q1.1.0.0/results/0/7";
+  EXPECT_FALSE(tracer->shouldSample(path, 0));
+  EXPECT_TRUE(tracer->shouldSample(path, 1));
+  // The decision is a pure function of the path, so the producing and the
+  // consuming worker always agree on whether a page is traced.
+  EXPECT_EQ(tracer->shouldSample(path, 16), tracer->shouldSample(path, 16));
+}
+
+TEST(ExchangeTracerTest, recordAndDump) {
+  auto* tracer = ExchangeTracer::instance();
+  tracer->clear();
+  tracer->record(
+      {"/v1/task/q.1.0.0/results/0/1",
+       /*producer=*/false,
+       10,
+       25,
+       100,
+       /*bufferWaitMs=*/0});
+  tracer->record(
+      {"/v1/task/q.1.0.0/results/0/1",
+       /*producer=*/true,
+       12,
+       20,
+       100,
+       /*bufferWaitMs=*/5});
+
+  const auto entries = folly::parseJson(tracer->toJsonString());
+  ASSERT_EQ(entries.size(), 2);
+  EXPECT_EQ(entries[0]["side"].asString(), "consumer");
+  EXPECT_EQ(entries[0]["startMs"].asInt(), 10);
+  EXPECT_EQ(entries[0]["endMs"].asInt(), 25);
+  // Buffer wait is a producer-side measurement only.
+  EXPECT_EQ(entries[0].count("bufferWaitMs"), 0);
+  EXPECT_EQ(entries[1]["side"].asString(), "producer");
+  EXPECT_EQ(entries[1]["bufferWaitMs"].asInt(), 5);
+
+  tracer->clear();
+  EXPECT_EQ(folly::parseJson(tracer->toJsonString()).size(), 0);
+}
+
+} // namespace
+} // namespace facebook::presto
@@ -0,0 +1,269 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/FragmentResultCache.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+namespace facebook::presto {
+namespace {
+
+std::shared_ptr<FragmentResultCacheEntry> makeEntry(
+    const std::vector<std::string>& pages) {
+  auto entry = std::make_shared<FragmentResultCacheEntry>();
+  for (const auto& page : pages) {
+    entry->pages.push_back(folly::IOBuf::copyBuffer(page));
+    entry->totalBytes += page.size();
+  }
+  entry->createTimeMs = velox::getCurrentTimeMs();
+  return entry;
+}
+
+std::vector<std::string> toStrings(const FragmentResultCacheEntry& entry) {
+  std::vector<std::string> pages;
+  for (const auto& page : entry.pages) {
+    auto copy = page->clone();
+    pages.push_back(copy->coalesce().str());
+  }
+  return pages;
+}
+
+protocol::ScheduledSplit makeRemoteSplit(
+    const std::string& location,
+    int64_t sequenceId) {
+  auto remoteSplit = std::make_shared<protocol::RemoteSplit>();
+  remoteSplit->location.location = location;
+  protocol::ScheduledSplit scheduledSplit;
+  scheduledSplit.sequenceId = sequenceId;
+  scheduledSplit.planNodeId = "0";
+  scheduledSplit.split.connectorSplit = remoteSplit;
+  return scheduledSplit;
+}
+
+protocol::TaskUpdateRequest makeUpdateRequest(
+    const std::string& fragment,
+    const std::vector<std::string>& splitLocations) {
+  protocol::TaskUpdateRequest updateRequest;
+  updateRequest.fragment = std::make_shared<protocol::String>(fragment);
+  updateRequest.session.queryId = "20260831_000000_00000_abcde";
+  updateRequest.session.user = "test";
+  updateRequest.session.timeZoneKey = 0;
+  updateRequest.session.locale = "en-US";
+  protocol::TaskSource source;
+  source.planNodeId = "0";
+  source.noMoreSplits = true;
+  int64_t sequenceId = 0;
+  for (const auto& location : splitLocations) {
+    source.splits.push_back(makeRemoteSplit(location, sequenceId++));
+  }
+  updateRequest.sources.push_back(source);
+  return updateRequest;
+}
+
+TEST(FragmentResultCacheTest, makeKey) {
+  const auto request = makeUpdateRequest("fragment-1", {"loc-1", "loc-2"});
+  const auto key = FragmentResultCache::makeKey(request);
+  ASSERT_TRUE(key.has_value());
+
+  // Identical refreshes produce identical keys even when per-execution
+  // fields and the split enumeration order differ.
+  auto refresh = makeUpdateRequest("fragment-1", {"loc-2", "loc-1"});
+  refresh.session.queryId = "20260831_000001_00001_fghij";
+  refresh.session.traceToken =
+      std::make_shared<protocol::String>("trace-token");
+  for (size_t i = 0; i < refresh.sources[0].splits.size(); ++i) {
+    refresh.sources[0].splits[i].sequenceId = 100 + i;
+  }
+  EXPECT_EQ(key, FragmentResultCache::makeKey(refresh));
+
+  // The plan fragment, the split set and the result-relevant session fields
+  // all contribute to the key.
+  EXPECT_NE(
+      key, FragmentResultCache::makeKey(makeUpdateRequest("fragment-2", {})));
+  EXPECT_NE(
+      key,
+      FragmentResultCache::makeKey(makeUpdateRequest("fragment-1", {"loc-1"})));
+  auto otherSession = makeUpdateRequest("fragment-1", {"loc-1", "loc-2"});
+  otherSession.session.systemProperties["query_max_memory"] = "1GB";
+  EXPECT_NE(key, FragmentResultCache::makeKey(otherSession));
+
+  // No fragment, no key.
+  protocol::TaskUpdateRequest noFragment;
+  EXPECT_FALSE(FragmentResultCache::makeKey(noFragment).has_value());
+}
+
+TEST(FragmentResultCacheTest, putAndGet) {
+  FragmentResultCache cache(
+      1 << 20, 1 << 20, /*ttlMs=*/0, /*baseDirectory=*/"", 1 << 20);
+  EXPECT_EQ(cache.get("k1"), nullptr);
+
+  cache.put("k1", makeEntry({"page-0", "page-1"}));
+  auto entry = cache.get("k1");
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(toStrings(*entry), std::vector<std::string>({"page-0", "page-1"}));
+  EXPECT_EQ(entry->totalBytes, 12);
+
+  // Entries over the per-entry limit are ignored.
+  FragmentResultCache smallCache(1 << 20, 4, /*ttlMs=*/0, "", 1 << 20);
+  smallCache.put("k1", makeEntry({"page-0"}));
+  EXPECT_EQ(smallCache.get("k1"), nullptr);
+}
+
+TEST(FragmentResultCacheTest, lruEviction) {
+  // Each entry is 6 bytes; the budget fits two.
+  FragmentResultCache cache(12, 1 << 20, /*ttlMs=*/0, "", 1 << 20);
+  cache.put("k1", makeEntry({"page-1"}));
+  cache.put("k2", makeEntry({"page-2"}));
+  // Touch 'k1' so 'k2' is the least recently used entry.
+  EXPECT_NE(cache.get("k1"), nullptr);
+  cache.put("k3", makeEntry({"page-3"}));
+  EXPECT_EQ(cache.numMemoryEntries(), 2);
+  EXPECT_NE(cache.get("k1"), nullptr);
+  EXPECT_EQ(cache.get("k2"), nullptr);
+  EXPECT_NE(cache.get("k3"), nullptr);
+}
+
+TEST(FragmentResultCacheTest, ttlExpiry) {
+  FragmentResultCache cache(1 << 20, 1 << 20, /*ttlMs=*/1, "", 1 << 20);
+  cache.put("k1", makeEntry({"page-0"}));
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(cache.get("k1"), nullptr);
+  EXPECT_EQ(cache.numMemoryEntries(), 0);
+}
+
+TEST(FragmentResultCacheTest, diskTier) {
+  velox::filesystems::registerLocalFileSystem();
+  auto tempDirectory = velox::exec::test::TempDirectoryPath::create();
+  const auto baseDirectory = tempDirectory->getPath();
+
+  // A 14-byte memory budget holds the 12-byte 'k1' or the 6-byte 'k2', but
+  // not both; the evicted entry spills to disk.
+  FragmentResultCache cache(14, 1 << 20, /*ttlMs=*/0, baseDirectory, 1 << 20);
+  cache.put("k1", makeEntry({"page-0", "page-1"}));
+  cache.put("k2", makeEntry({"page-2"}));
+  EXPECT_EQ(cache.numMemoryEntries(), 1);
+  EXPECT_EQ(cache.numDiskEntries(), 1);
+
+  // A disk hit round-trips the pages and promotes the entry back to memory,
+  // pushing 'k2' out to disk in turn.
+  auto entry = cache.get("k1");
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(toStrings(*entry), std::vector<std::string>({"page-0", "page-1"}));
+  EXPECT_EQ(cache.numMemoryEntries(), 1);
+  EXPECT_EQ(cache.numDiskEntries(), 1);
+
+  // The disk tier survives a restart.
+  FragmentResultCache restarted(
+      14, 1 << 20, /*ttlMs=*/0, baseDirectory, 1 << 20);
+  EXPECT_EQ(restarted.numDiskEntries(), 1);
+  auto restartedEntry = restarted.get("k2");
+  ASSERT_NE(restartedEntry, nullptr);
+  EXPECT_EQ(toStrings(*restartedEntry), std::vector<std::string>({"page-2"}));
+}
+
+TEST(FragmentResultCacheTest, capture) {
+  FragmentResultCache cache(1 << 20, 1 << 20, /*ttlMs=*/0, "", 1 << 20);
+  auto capture = cache.startCapture("k1");
+
+  std::vector<std::unique_ptr<folly::IOBuf>> batch;
+  batch.push_back(folly::IOBuf::copyBuffer(std::string("page-1")));
+  capture->append(1, batch);
+  EXPECT_EQ(cache.get("k1"), nullptr);
+
+  // The entry is published once the end marker and every token are seen,
+  // regardless of the fetch order. Repeated fetches are deduplicated.
+  batch.clear();
+  batch.push_back(folly::IOBuf::copyBuffer(std::string("page-1")));
+  batch.push_back(nullptr);
+  capture->append(1, batch);
+  EXPECT_EQ(cache.get("k1"), nullptr);
+
+  batch.clear();
+  batch.push_back(folly::IOBuf::copyBuffer(std::string("page-0")));
+  capture->append(0, batch);
+  auto entry = cache.get("k1");
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(toStrings(*entry), std::vector<std::string>({"page-0", "page-1"}));
+}
+
+TEST(FragmentResultCacheTest, captureSubscription) {
+  FragmentResultCache cache(1 << 20, 1 << 20, /*ttlMs=*/0, "", 1 << 20);
+  auto capture = cache.startCapture("k1");
+
+  // A running capture is discoverable under its key; dropping it is not.
+  EXPECT_EQ(cache.findCapture("k1"), capture);
+  EXPECT_EQ(cache.findCapture("k2"), nullptr);
+
+  std::shared_ptr<const FragmentResultCacheEntry> notified;
+  int notifications = 0;
+  ASSERT_TRUE(capture->subscribe([&](auto entry) {
+    notified = std::move(entry);
+    ++notifications;
+  }));
+
+  std::vector<std::unique_ptr<folly::IOBuf>> batch;
+  batch.push_back(folly::IOBuf::copyBuffer(std::string("page-0")));
+  batch.push_back(nullptr);
+  capture->append(0, batch);
+  EXPECT_EQ(notifications, 1);
+  ASSERT_NE(notified, nullptr);
+  EXPECT_EQ(toStrings(*notified), std::vector<std::string>({"page-0"}));
+
+  // Once the outcome is known, subscribe declines and the subscriber is not
+  // notified again, not even on destruction.
+  EXPECT_FALSE(capture->subscribe([&](auto) { ++notifications; }));
+  capture.reset();
+  EXPECT_EQ(notifications, 1);
+  EXPECT_EQ(cache.findCapture("k1"), nullptr);
+
+  // An abandoned capture notifies with a null entry.
+  FragmentResultCache smallCache(1 << 20, /*maxEntryBytes=*/4, 0, "", 0);
+  auto abandoned = smallCache.startCapture("k1");
+  bool abandonedNotified = false;
+  ASSERT_TRUE(abandoned->subscribe([&](auto entry) {
+    EXPECT_EQ(entry, nullptr);
+    abandonedNotified = true;
+  }));
+  batch.clear();
+  batch.push_back(folly::IOBuf::copyBuffer(std::string("0123456789")));
+  abandoned->append(0, batch);
+  EXPECT_TRUE(abandonedNotified);
+
+  // A capture destroyed unpublished notifies with a null entry too.
+  auto dropped = cache.startCapture("k2");
+  bool droppedNotified = false;
+  ASSERT_TRUE(dropped->subscribe([&](auto entry) {
+    EXPECT_EQ(entry, nullptr);
+    droppedNotified = true;
+  }));
+  dropped.reset();
+  EXPECT_TRUE(droppedNotified);
+}
+
+TEST(FragmentResultCacheTest, captureAbandonsOversizedOutput) {
+  FragmentResultCache cache(1 << 20, /*maxEntryBytes=*/8, /*ttlMs=*/0, "", 0);
+  auto capture = cache.startCapture("k1");
+
+  std::vector<std::unique_ptr<folly::IOBuf>> batch;
+  batch.push_back(folly::IOBuf::copyBuffer(std::string("0123456789")));
+  batch.push_back(nullptr);
+  capture->append(0, batch);
+  EXPECT_EQ(cache.get("k1"), nullptr);
+}
+
+} // namespace
+} // namespace facebook::presto
@@ -0,0 +1,77 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/connectors/HiveFileMetadataCache.h"
+#include <folly/base64.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::presto;
+
+namespace {
+
+std::string encode(const std::string& value) {
+  return folly::base64Encode(value);
+}
+
+} // namespace
+
+TEST(HiveFileMetadataCacheTest, sharesDecodedBlobAcrossSplits) {
+  auto* cache = HiveFileMetadataCache::instance();
+  const auto encoded = encode("footer-metadata");
+
+  auto first = cache->getOrDecode("/data/file1.orc", 100, 1000, encoded, 1024);
+  ASSERT_EQ(*first, "footer-metadata");
+
+  // A second split of the same file shares the same blob.
+  auto second = cache->getOrDecode("/data/file1.orc", 100, 1000, encoded, 1024);
+  EXPECT_EQ(first.get(), second.get());
+
+  // A rewritten file (new mtime) is decoded afresh.
+  auto rewritten = encode("new-footer-metadata");
+  auto third =
+      cache->getOrDecode("/data/file1.orc", 200, 1100, rewritten, 1024);
+  EXPECT_NE(first.get(), third.get());
+  EXPECT_EQ(*third, "new-footer-metadata");
+
+  // The stale blob was replaced, not accumulated.
+  EXPECT_EQ(cache->cachedBytes(), third->size());
+}
+
+TEST(HiveFileMetadataCacheTest, evictsLeastRecentlyUsed) {
+  auto* cache = HiveFileMetadataCache::instance();
+  const std::string blob(100, 'x');
+  const auto encoded = encode(blob);
+  const uint64_t maxBytes = 250;
+
+  auto a = cache->getOrDecode("/evict/a.orc", 1, 100, encoded, maxBytes);
+  auto b = cache->getOrDecode("/evict/b.orc", 1, 100, encoded, maxBytes);
+  // Touch 'a' so 'b' is the eviction candidate.
+  cache->getOrDecode("/evict/a.orc", 1, 100, encoded, maxBytes);
+
+  // Inserting a third file must evict until the budget fits.
+  auto c = cache->getOrDecode("/evict/c.orc", 1, 100, encoded, maxBytes);
+  EXPECT_LE(cache->cachedBytes(), maxBytes);
+
+  // 'a' is still served from the cache; 'b' was evicted and is re-decoded.
+  auto a2 = cache->getOrDecode("/evict/a.orc", 1, 100, encoded, maxBytes);
+  EXPECT_EQ(a.get(), a2.get());
+  auto b2 = cache->getOrDecode("/evict/b.orc", 1, 100, encoded, maxBytes);
+  EXPECT_NE(b.get(), b2.get());
+
+  // Blobs larger than the budget are returned but not cached.
+  const auto bytesBefore = cache->cachedBytes();
+  auto large = cache->getOrDecode(
+      "/evict/large.orc", 1, 100, encode(std::string(500, 'y')), maxBytes);
+  EXPECT_EQ(large->size(), 500);
+  EXPECT_EQ(cache->cachedBytes(), bytesBefore);
+}
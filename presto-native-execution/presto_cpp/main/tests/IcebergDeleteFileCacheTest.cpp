@@ -0,0 +1,129 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/connectors/IcebergDeleteFileCache.h"
+#include <gtest/gtest.h>
+
+using namespace facebook::presto;
+using facebook::velox::connector::hive::iceberg::FileContent;
+using facebook::velox::connector::hive::iceberg::IcebergDeleteFile;
+using facebook::velox::dwio::common::FileFormat;
+
+namespace {
+
+IcebergDeleteFile makeDeleteFile(
+    const std::string& path,
+    int64_t recordCount,
+    const std::string& bound = "b") {
+  return IcebergDeleteFile(
+      FileContent::kPositionalDeletes,
+      path,
+      FileFormat::PARQUET,
+      recordCount,
+      1000,
+      {1},
+      {{1, bound}},
+      {{1, bound}});
+}
+
+} // namespace
+
+TEST(IcebergDeleteFileCacheTest, sharesDescriptorAcrossSplits) {
+  auto* cache = IcebergDeleteFileCache::instance();
+  int32_t conversions = 0;
+  auto convert = [&]() {
+    ++conversions;
+    return makeDeleteFile("/data/delete1.parquet", 100);
+  };
+
+  auto first = cache->getOrConvert(
+      "/data/delete1.parquet", 100, 1000, convert, 4096);
+  ASSERT_EQ(first->recordCount, 100);
+  EXPECT_EQ(conversions, 1);
+
+  // A second split referencing the same delete file shares the descriptor.
+  auto second = cache->getOrConvert(
+      "/data/delete1.parquet", 100, 1000, convert, 4096);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(conversions, 1);
+
+  // A rewritten file (new record count) is converted afresh.
+  auto rewritten = cache->getOrConvert(
+      "/data/delete1.parquet",
+      200,
+      1000,
+      [&]() {
+        ++conversions;
+        return makeDeleteFile("/data/delete1.parquet", 200);
+      },
+      4096);
+  EXPECT_NE(first.get(), rewritten.get());
+  EXPECT_EQ(rewritten->recordCount, 200);
+  EXPECT_EQ(conversions, 2);
+}
+
+TEST(IcebergDeleteFileCacheTest, evictsLeastRecentlyUsed) {
+  auto* cache = IcebergDeleteFileCache::instance();
+  const auto entryBytes = [&](const std::string& path) {
+    const auto before = cache->cachedBytes();
+    cache->getOrConvert(
+        path, 1, 1000, [&]() { return makeDeleteFile(path, 1); }, 1 << 20);
+    return cache->cachedBytes() - before;
+  };
+  // Size the budget so two entries fit but not three.
+  const auto maxBytes = entryBytes("/evict/probe.parquet") * 5 / 2;
+
+  int32_t conversions = 0;
+  const auto get = [&](const std::string& path) {
+    return cache->getOrConvert(
+        path,
+        1,
+        1000,
+        [&]() {
+          ++conversions;
+          return makeDeleteFile(path, 1);
+        },
+        maxBytes);
+  };
+
+  auto a = get("/evict/a.parquet");
+  auto b = get("/evict/b.parquet");
+  // Touch 'a' so 'b' is the eviction candidate.
+  get("/evict/a.parquet");
+
+  // Inserting a third file must evict until the budget fits.
+  get("/evict/c.parquet");
+  EXPECT_LE(cache->cachedBytes(), maxBytes);
+
+  // 'a' is still served from the cache; 'b' was evicted and is re-converted.
+  conversions = 0;
+  auto a2 = get("/evict/a.parquet");
+  EXPECT_EQ(a.get(), a2.get());
+  auto b2 = get("/evict/b.parquet");
+  EXPECT_NE(b.get(), b2.get());
+  EXPECT_EQ(conversions, 1);
+
+  // Descriptors larger than the budget are returned but not cached.
+  const auto bytesBefore = cache->cachedBytes();
+  auto large = cache->getOrConvert(
+      "/evict/large.parquet",
+      1,
+      1000,
+      [&]() {
+        return makeDeleteFile(
+            "/evict/large.parquet", 1, std::string(10000, 'y'));
+      },
+      maxBytes);
+  EXPECT_EQ(large->recordCount, 1);
+  EXPECT_EQ(cache->cachedBytes(), bytesBefore);
+}
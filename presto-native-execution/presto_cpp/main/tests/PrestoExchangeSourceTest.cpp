@@ -61,6 +61,18 @@ class PrestoExchangeSourceTestHelper {
     return exchangeSource_->atEnd_;
   }
 
+  uint32_t adjustRequestSize(uint32_t maxBytes) {
+    return exchangeSource_->adjustRequestSize(maxBytes);
+  }
+
+  void updateAdaptiveRequestSize(
+      int64_t responseBytes,
+      int64_t durationMs,
+      int64_t upstreamBacklogBytes = 0) {
+    exchangeSource_->updateAdaptiveRequestSize(
+        responseBytes, durationMs, upstreamBacklogBytes);
+  }
+
  private:
   PrestoExchangeSource* const exchangeSource_;
 };
@@ -750,6 +762,135 @@ TEST_P(PrestoExchangeSourceTest, invalidDataResponseWithoutTokenSet) {
   serverWrapper.stop();
 }
 
+TEST_P(PrestoExchangeSourceTest, adaptiveRequestSize) {
+  SystemConfig::instance()->setValue(
+      std::string(SystemConfig::kExchangeAdaptiveRequestSizeEnabled), "true");
+  const auto useHttps = GetParam().useHttps;
+  const folly::SocketAddress producerAddress("127.0.0.1", 8080);
+  auto queue = makeSingleSourceQueue();
+  auto exchangeSource = makeExchangeSource(producerAddress, useHttps, 3, queue);
+  test::PrestoExchangeSourceTestHelper sourceHelper(exchangeSource.get());
+
+  const uint32_t clientMaxBytes = 8 << 20;
+  // The first data request seeds the budget with the client's cap.
+  ASSERT_EQ(sourceHelper.adjustRequestSize(clientMaxBytes), clientMaxBytes);
+  // Data size requests pass through unchanged.
+  ASSERT_EQ(sourceHelper.adjustRequestSize(0), 0);
+
+  // A slow response halves the budget.
+  sourceHelper.updateAdaptiveRequestSize(clientMaxBytes, 2'000);
+  ASSERT_EQ(sourceHelper.adjustRequestSize(clientMaxBytes), clientMaxBytes / 2);
+
+  // The budget never drops below 1MB.
+  for (int i = 0; i < 10; ++i) {
+    sourceHelper.updateAdaptiveRequestSize(clientMaxBytes, 2'000);
+  }
+  ASSERT_EQ(sourceHelper.adjustRequestSize(clientMaxBytes), 1 << 20);
+
+  // A fast response that fills the budget grows it additively.
+  sourceHelper.updateAdaptiveRequestSize(1 << 20, 10);
+  ASSERT_EQ(sourceHelper.adjustRequestSize(clientMaxBytes), 2 << 20);
+
+  // Repeated full fast responses converge back to the client's cap but never
+  // exceed it.
+  for (int i = 0; i < 10; ++i) {
+    sourceHelper.updateAdaptiveRequestSize(clientMaxBytes, 10);
+  }
+  ASSERT_EQ(sourceHelper.adjustRequestSize(clientMaxBytes), clientMaxBytes);
+
+  // A small fast response with a deep upstream backlog grows the budget: the
+  // producer has more than a full budget buffered, so this source is the
+  // bottleneck. The budget is already at the cap here, so it stays there.
+  sourceHelper.updateAdaptiveRequestSize(1024, 10, 2 * clientMaxBytes);
+  ASSERT_EQ(sourceHelper.adjustRequestSize(clientMaxBytes), clientMaxBytes);
+
+  // A small fast response that drained the upstream buffer decays the budget
+  // so a slow producer is not asked to hold large batches.
+  sourceHelper.updateAdaptiveRequestSize(1024, 10, 0);
+  ASSERT_EQ(
+      sourceHelper.adjustRequestSize(clientMaxBytes),
+      clientMaxBytes - (1 << 20));
+
+  // The decay also never drops the budget below 1MB.
+  for (int i = 0; i < 10; ++i) {
+    sourceHelper.updateAdaptiveRequestSize(1024, 10, 0);
+  }
+  ASSERT_EQ(sourceHelper.adjustRequestSize(clientMaxBytes), 1 << 20);
+}
+
+TEST_P(PrestoExchangeSourceTest, pageCoalescing) {
+  SystemConfig::instance()->setValue(
+      std::string(SystemConfig::kExchangePageCoalescingEnabled), "true");
+  const std::vector<std::string> pages = {"page1 - xx", "page2 - xxxxx"};
+  const auto useHttps = GetParam().useHttps;
+  auto producer = std::make_unique<Producer>();
+
+  for (const auto& page : pages) {
+    producer->enqueue(page);
+  }
+  producer->noMoreData();
+
+  auto producerServer = createHttpServer(useHttps);
+  producer->registerEndpoints(producerServer.get());
+
+  test::HttpServerWrapper serverWrapper(std::move(producerServer));
+  auto producerAddress = serverWrapper.start().get();
+
+  auto queue = makeSingleSourceQueue();
+  auto exchangeSource = makeExchangeSource(producerAddress, useHttps, 3, queue);
+
+  // Held-back responses only reach the queue once enough data has
+  // accumulated, so drive the requests off the response futures the way the
+  // exchange client does instead of waiting on the queue.
+  auto fetch = [&]() {
+    {
+      std::lock_guard<std::mutex> l(queue->mutex());
+      VELOX_CHECK(exchangeSource->shouldRequestLocked());
+    }
+    return exchangeSource->request(1 << 20, std::chrono::seconds(2)).get();
+  };
+
+  // Both pages are far below the coalescing target and are held back.
+  auto response = fetch();
+  ASSERT_EQ(response.bytes, 4 + pages[0].size());
+  ASSERT_EQ(queue->totalBytes(), 0);
+  response = fetch();
+  ASSERT_EQ(response.bytes, 4 + pages[1].size());
+  ASSERT_EQ(queue->totalBytes(), 0);
+
+  // The buffer-complete response flushes the held data as one page.
+  response = fetch();
+  ASSERT_EQ(response.bytes, 0);
+  ASSERT_TRUE(response.atEnd);
+
+  auto page = waitForNextPage(queue);
+  auto input = page->prepareStreamForDeserialize();
+  std::vector<std::string> decoded;
+  while (!input->atEnd()) {
+    const auto numBytes = input->read<int32_t>();
+    std::string data(numBytes, '\0');
+    input->readBytes(data.data(), numBytes);
+    decoded.push_back(std::move(data));
+  }
+  ASSERT_EQ(decoded, pages);
+  waitForEndMarker(queue);
+
+  producer->waitForDeleteResults();
+  exchangeCpuExecutor_->stop();
+  serverWrapper.stop();
+  EXPECT_EQ(pool_->usedBytes(), 0);
+
+  const auto stats = exchangeSource->metrics();
+  ASSERT_EQ(stats.at("prestoExchangeSource.numPages").sum, pages.size());
+  ASSERT_EQ(stats.at("prestoExchangeSource.pageSize").sum, totalBytes(pages));
+  ASSERT_EQ(stats.at("prestoExchangeSource.coalescedPageBytes").count, 1);
+  // Like 'iobufBytes', the coalesced bytes count buffer capacities, which
+  // may exceed the serialized data size.
+  ASSERT_GE(
+      stats.at("prestoExchangeSource.coalescedPageBytes").sum,
+      totalBytes(pages));
+}
+
 TEST_P(PrestoExchangeSourceTest, retryState) {
   PrestoExchangeSource::RetryState state(1000);
   ASSERT_FALSE(state.isExhausted());
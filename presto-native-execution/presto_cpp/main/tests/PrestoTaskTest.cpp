@@ -83,6 +83,26 @@ TEST_F(PrestoTaskTest, malformedTaskId) {
   VELOX_ASSERT_THROW(PrestoTaskId("q.1.2"), "Malformed task ID: q.1.2");
 }
 
+TEST_F(PrestoTaskTest, taskIdKey) {
+  const std::string taskIdStr("20201107_130540_00011_wrpkw.1.2.3.4");
+  const TaskIdKey key(taskIdStr);
+  ASSERT_EQ(key.stageId, 1);
+  ASSERT_EQ(key.stageExecutionId, 2);
+  ASSERT_EQ(key.id, 3);
+  ASSERT_EQ(key.attemptNumber, 4);
+
+  // Keys built from the same id string are equal and hash alike; any
+  // differing component breaks equality.
+  ASSERT_TRUE(key == TaskIdKey(taskIdStr));
+  ASSERT_EQ(TaskIdKey::Hash{}(key), TaskIdKey::Hash{}(TaskIdKey(taskIdStr)));
+  ASSERT_FALSE(key == TaskIdKey("20201107_130540_00011_wrpkw.1.2.3.5"));
+  ASSERT_FALSE(key == TaskIdKey("20201107_130540_00012_wrpkw.1.2.3.4"));
+
+  // Malformed ids do not throw; distinct ones stay distinct keys.
+  ASSERT_FALSE(TaskIdKey("not-a-task-id") == TaskIdKey("also-not-one"));
+  ASSERT_TRUE(TaskIdKey("not-a-task-id") == TaskIdKey("not-a-task-id"));
+}
+
 TEST_F(PrestoTaskTest, runtimeMetricConversion) {
   RuntimeMetric veloxMetric;
   veloxMetric.unit = RuntimeCounter::Unit::kBytes;
@@ -112,6 +132,45 @@ TEST_F(PrestoTaskTest, basic) {
   EXPECT_GE(task.timeSinceLastCoordinatorHeartbeatMs(), 100);
 }
 
+TEST_F(PrestoTaskTest, resultFetchPacing) {
+  PrestoTask task{"20201107_130540_00011_wrpkw.1.2.3.4", "node2", 0};
+
+  auto summary = task.resultFetchPacingSummary();
+  EXPECT_EQ(summary.numConsumers, 0);
+  EXPECT_EQ(summary.numFetches, 0);
+  EXPECT_EQ(summary.totalBytes, 0);
+  EXPECT_EQ(summary.maxFetchGapMs, 0);
+
+  // A single fetch has no gap yet.
+  task.recordResultFetch(0);
+  task.recordResultFetchBytes(0, 1'000);
+  {
+    std::lock_guard<std::mutex> l(task.mutex);
+    EXPECT_EQ(task.resultFetchGapMsLocked(0), 0);
+  }
+
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  task.recordResultFetch(0);
+  task.recordResultFetchBytes(0, 2'000);
+  {
+    std::lock_guard<std::mutex> l(task.mutex);
+    EXPECT_GE(task.resultFetchGapMsLocked(0), 100);
+    // A buffer that never fetched reports no gap.
+    EXPECT_EQ(task.resultFetchGapMsLocked(7), 0);
+  }
+
+  // A second consumer on its own buffer.
+  task.recordResultFetch(1);
+  task.recordResultFetchBytes(1, 500);
+
+  summary = task.resultFetchPacingSummary();
+  EXPECT_EQ(summary.numConsumers, 2);
+  EXPECT_EQ(summary.numFetches, 3);
+  EXPECT_EQ(summary.totalBytes, 3'500);
+  EXPECT_GE(summary.maxFetchGapMs, 100);
+}
+
 TEST_F(PrestoTaskTest, updateStatus) {
   memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
   const std::string taskId{"20201107_130540_00011_wrpkw.1.2.3.4"};
@@ -175,3 +234,45 @@ TEST_F(PrestoTaskTest, updateStatus) {
   EXPECT_EQ(status.queuedPartitionedDrivers, 0);
   EXPECT_EQ(status.runningPartitionedDrivers, 0);
 }
+
+TEST_F(PrestoTaskTest, timeSlicedStats) {
+  memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  const std::string taskId{"20201107_130540_00011_wrpkw.1.2.3.4"};
+  PrestoTask prestoTask{taskId, "node1", 0};
+
+  // Without a velox task the sweep is a no-op and the export is empty.
+  prestoTask.recordTimeSlicedStats(1'000);
+  auto statsJson = prestoTask.timeSlicedStatsJson();
+  EXPECT_EQ(statsJson["displayTimeUnit"], "ms");
+  EXPECT_EQ(statsJson["traceEvents"].size(), 0);
+
+  // A zero window width keeps the sweep disabled; an exec task that made no
+  // progress records no slices either.
+  prestoTask.task = createExecTask(taskId, prestoTask);
+  prestoTask.recordTimeSlicedStats(0);
+  prestoTask.recordTimeSlicedStats(1'000);
+  statsJson = prestoTask.timeSlicedStatsJson();
+  EXPECT_EQ(statsJson["traceEvents"].size(), 0);
+}
+
+TEST_F(PrestoTaskTest, splitSequenceGuard) {
+  SplitSequenceGuard guard;
+
+  // First sighting of each (node, sequence) pair is new; re-sent pairs are
+  // duplicates. The same sequence id under another node is distinct.
+  EXPECT_TRUE(guard.testAndRecord("0", 1));
+  EXPECT_TRUE(guard.testAndRecord("0", 2));
+  EXPECT_FALSE(guard.testAndRecord("0", 1));
+  EXPECT_TRUE(guard.testAndRecord("1", 1));
+  EXPECT_FALSE(guard.testAndRecord("1", 1));
+
+  // Push the guard through several bloom filter rebuilds and verify it stays
+  // exact: every id is new once and a duplicate on the re-sent batch.
+  constexpr int64_t kNumSplits = 100'000;
+  for (int64_t sequenceId = 10; sequenceId < kNumSplits; ++sequenceId) {
+    EXPECT_TRUE(guard.testAndRecord("2", sequenceId));
+  }
+  for (int64_t sequenceId = 10; sequenceId < kNumSplits; ++sequenceId) {
+    EXPECT_FALSE(guard.testAndRecord("2", sequenceId));
+  }
+}
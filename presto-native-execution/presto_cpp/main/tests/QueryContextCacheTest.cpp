@@ -166,4 +166,74 @@ TEST_F(QueryContextCacheTest, eviction) {
   verifyQueryCtxCache(queryContextCache, queryCtxs, 0, 20);
   EXPECT_EQ(queryContextCache.size(), 0);
 }
+
+TEST_F(QueryContextCacheTest, internedFragments) {
+  constexpr uint64_t kTtlMs = 60'000;
+  InternedFragmentCache cache;
+
+  auto fragment = std::make_shared<std::string>(R"({"id":"plan"})");
+  auto parsed =
+      std::make_shared<protocol::json>(protocol::json::parse(*fragment));
+  const auto digest = InternedFragmentCache::digestFor(*fragment);
+  EXPECT_EQ(digest, InternedFragmentCache::digestFor(*fragment));
+
+  // Unknown digest misses.
+  EXPECT_FALSE(cache.get(digest, kTtlMs).has_value());
+
+  cache.put(digest, fragment, parsed);
+  auto interned = cache.get(digest, kTtlMs);
+  ASSERT_TRUE(interned.has_value());
+  EXPECT_EQ(interned->fragment.get(), fragment.get());
+  EXPECT_EQ(interned->parsed.get(), parsed.get());
+
+  // A racing insert keeps the existing entry.
+  cache.put(digest, std::make_shared<std::string>(*fragment), parsed);
+  EXPECT_EQ(cache.get(digest, kTtlMs)->fragment.get(), fragment.get());
+
+  // An expired entry misses and is erased; re-interning works afterwards.
+  EXPECT_FALSE(cache.get(digest, 0).has_value());
+  EXPECT_FALSE(cache.get(digest, kTtlMs).has_value());
+  cache.put(digest, fragment, parsed);
+  EXPECT_TRUE(cache.get(digest, kTtlMs).has_value());
+}
+
+TEST_F(QueryContextCacheTest, sessionConfigs) {
+  protocol::SessionRepresentation session;
+  session.user = "test";
+  session.systemProperties = {{"query_max_memory_per_node", "2GB"}};
+  const std::map<std::string, std::string> credentials{{"token", "abc"}};
+
+  const auto digest = SessionConfigCache::digestFor(session, credentials);
+  EXPECT_EQ(digest, SessionConfigCache::digestFor(session, credentials));
+
+  // Per-query fields do not affect the digest.
+  auto perQuery = session;
+  perQuery.queryId = "20260831_000000_00000_abcde";
+  perQuery.startTime = 123;
+  EXPECT_EQ(digest, SessionConfigCache::digestFor(perQuery, credentials));
+
+  // Config-relevant fields do.
+  auto changed = session;
+  changed.systemProperties["query_max_memory_per_node"] = "4GB";
+  EXPECT_NE(digest, SessionConfigCache::digestFor(changed, credentials));
+  EXPECT_NE(digest, SessionConfigCache::digestFor(session, {}));
+
+  SessionConfigCache cache;
+  EXPECT_FALSE(cache.get(digest).has_value());
+
+  SessionConfigCache::CachedConfigs configs;
+  configs.queryConfigs = {{"max_spill_bytes", "0"}};
+  configs.connectorConfigs = {{"hive", {{"user", "test"}}}};
+  cache.put(digest, configs);
+  auto cached = cache.get(digest);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->queryConfigs, configs.queryConfigs);
+  EXPECT_EQ(cached->connectorConfigs, configs.connectorConfigs);
+
+  // A racing insert keeps the existing entry.
+  SessionConfigCache::CachedConfigs other;
+  other.queryConfigs = {{"max_spill_bytes", "1"}};
+  cache.put(digest, std::move(other));
+  EXPECT_EQ(cache.get(digest)->queryConfigs.at("max_spill_bytes"), "0");
+}
 } // namespace facebook::presto
@@ -134,6 +134,10 @@ TEST_F(ServerOperationTest, buildServerOp) {
   EXPECT_EQ(ServerOperation::Target::kServer, op.target);
   EXPECT_EQ(ServerOperation::Action::kTrace, op.action);
 
+  op = buildServerOpFromHttpMsgPath("/v1/operation/server/getAllocatorStats");
+  EXPECT_EQ(ServerOperation::Target::kServer, op.target);
+  EXPECT_EQ(ServerOperation::Action::kGetAllocatorStats, op.action);
+
   EXPECT_THROW(
       op = buildServerOpFromHttpMsgPath("/v1/operation/whatzit/setProperty"),
       velox::VeloxUserError);
@@ -208,6 +212,46 @@ TEST_F(ServerOperationTest, taskEndpoint) {
           &httpMessage),
       "Invalid limit provided 'abc'.");
 
+  // Each dummy task belongs to a different query; after a CPU usage roll-up
+  // getQueryCpu reports one entry per query.
+  taskManager->updateQueryCpuUsage();
+  proxygen::HTTPMessage queryCpuMessage;
+  auto queryCpuResponse = serverOperation.taskOperation(
+      {.target = ServerOperation::Target::kTask,
+       .action = ServerOperation::Action::kGetQueryCpu},
+      &queryCpuMessage);
+  j = nlohmann::json::parse(queryCpuResponse);
+  EXPECT_EQ(2, j.size());
+  for (const auto& entry : j) {
+    EXPECT_TRUE(
+        entry["queryId"] == "task_0" || entry["queryId"] == "task_1");
+    EXPECT_GE(entry["cpuTimeNanos"].get<int64_t>(), 0);
+  }
+
+  queryCpuMessage.setQueryParam("limit", "1");
+  queryCpuResponse = serverOperation.taskOperation(
+      {.target = ServerOperation::Target::kTask,
+       .action = ServerOperation::Action::kGetQueryCpu},
+      &queryCpuMessage);
+  j = nlohmann::json::parse(queryCpuResponse);
+  EXPECT_EQ(1, j.size());
+
+  // After a queued-driver sample getQueryQueueTime also reports one entry per
+  // query; with idle tasks the accumulated queue time stays zero.
+  taskManager->updateQueryQueuedDriverTime();
+  taskManager->updateQueryQueuedDriverTime();
+  proxygen::HTTPMessage queueTimeMessage;
+  auto queueTimeResponse = serverOperation.taskOperation(
+      {.target = ServerOperation::Target::kTask,
+       .action = ServerOperation::Action::kGetQueryQueueTime},
+      &queueTimeMessage);
+  j = nlohmann::json::parse(queueTimeResponse);
+  EXPECT_EQ(2, j.size());
+  for (const auto& entry : j) {
+    EXPECT_TRUE(entry["queryId"] == "task_0" || entry["queryId"] == "task_1");
+    EXPECT_GE(entry["queuedDriverMs"].get<int64_t>(), 0);
+  }
+
   // Cleanup and shutdown
   for (const auto& taskId : taskIds) {
     taskManager->deleteTask(taskId, true, true);
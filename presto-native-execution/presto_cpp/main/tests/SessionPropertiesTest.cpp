@@ -14,6 +14,7 @@
 #include <gtest/gtest.h>
 
 #include "presto_cpp/main/SessionProperties.h"
+#include "presto_cpp/main/operators/ShuffleWrite.h"
 #include "velox/core/QueryConfig.h"
 
 using namespace facebook::presto;
@@ -88,6 +89,10 @@ TEST_F(SessionPropertiesTest, validateMapping) {
        core::QueryConfig::kMaxPartitionedOutputBufferSize},
       {SessionProperties::kPartitionedOutputEagerFlush,
        core::QueryConfig::kPartitionedOutputEagerFlush},
+      {SessionProperties::kShuffleWriteCombineThresholdBytes,
+       operators::kShuffleWriteCombineThresholdBytes},
+      {SessionProperties::kShuffleWriteCombineMaxAgeMs,
+       operators::kShuffleWriteCombineMaxAgeMs},
       {SessionProperties::kLegacyTimestamp,
        core::QueryConfig::kAdjustTimestampToTimezone},
       {SessionProperties::kDriverCpuTimeSliceLimitMs,
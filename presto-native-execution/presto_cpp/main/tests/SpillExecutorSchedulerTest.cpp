@@ -0,0 +1,113 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/SpillExecutorScheduler.h"
+
+#include <folly/executors/ManualExecutor.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::presto;
+
+namespace {
+
+// Returns a spill task that appends 'tag' to 'runOrder' when it runs.
+folly::Func makeTask(std::vector<std::string>& runOrder, std::string tag) {
+  return [&runOrder, tag = std::move(tag)]() { runOrder.push_back(tag); };
+}
+
+} // namespace
+
+TEST(SpillExecutorSchedulerTest, interleavesQueries) {
+  folly::ManualExecutor executor;
+  auto scheduler =
+      std::make_shared<SpillExecutorScheduler>(&executor, 1, 1);
+  std::vector<std::string> runOrder;
+
+  auto* q1 = scheduler->queryExecutor("q1");
+  auto* q2 = scheduler->queryExecutor("q2");
+  // One query floods the scheduler before the other submits anything; the
+  // other query's single task must not wait behind the whole flood.
+  q1->add(makeTask(runOrder, "q1"));
+  q1->add(makeTask(runOrder, "q1"));
+  q1->add(makeTask(runOrder, "q1"));
+  q2->add(makeTask(runOrder, "q2"));
+
+  executor.drain();
+  EXPECT_EQ(
+      runOrder, (std::vector<std::string>{"q1", "q2", "q1", "q1"}));
+  EXPECT_EQ(scheduler->numQueuedTasks(), 0);
+}
+
+TEST(SpillExecutorSchedulerTest, perQueryInFlightCap) {
+  folly::ManualExecutor executor;
+  // Four slots on the pool but at most one in flight per query: a lone
+  // query must leave the other slots free for late arrivals.
+  auto scheduler =
+      std::make_shared<SpillExecutorScheduler>(&executor, 4, 1);
+  std::vector<std::string> runOrder;
+
+  auto* q1 = scheduler->queryExecutor("q1");
+  q1->add(makeTask(runOrder, "q1"));
+  q1->add(makeTask(runOrder, "q1"));
+  q1->add(makeTask(runOrder, "q1"));
+  EXPECT_EQ(scheduler->numQueuedTasks(), 2);
+
+  executor.drain();
+  EXPECT_EQ(runOrder.size(), 3);
+  EXPECT_EQ(scheduler->numQueuedTasks(), 0);
+}
+
+TEST(SpillExecutorSchedulerTest, sweepsExpiredQueries) {
+  folly::ManualExecutor executor;
+  auto scheduler =
+      std::make_shared<SpillExecutorScheduler>(&executor, 1, 1);
+  std::vector<std::string> runOrder;
+
+  auto* q1 = scheduler->queryExecutor("q1");
+  auto owner1 = std::make_shared<int>(0);
+  scheduler->bindQuery("q1", owner1);
+  q1->add(makeTask(runOrder, "q1"));
+  executor.drain();
+  EXPECT_EQ(scheduler->numQueries(), 1);
+
+  // The query context goes away; the next query's arrival reclaims q1.
+  owner1.reset();
+  scheduler->queryExecutor("q2");
+  auto owner2 = std::make_shared<int>(0);
+  scheduler->bindQuery("q2", owner2);
+  EXPECT_EQ(scheduler->numQueries(), 1);
+
+  // A still-live query survives the sweep.
+  scheduler->bindQuery("q2", owner2);
+  EXPECT_EQ(scheduler->numQueries(), 1);
+}
+
+TEST(SpillExecutorSchedulerTest, shutdownDropsQueuedWork) {
+  folly::ManualExecutor executor;
+  auto scheduler =
+      std::make_shared<SpillExecutorScheduler>(&executor, 1, 1);
+  std::vector<std::string> runOrder;
+
+  auto* q1 = scheduler->queryExecutor("q1");
+  q1->add(makeTask(runOrder, "first"));
+  q1->add(makeTask(runOrder, "second"));
+  scheduler->shutdown();
+
+  // The task already released to the pool still runs; the queued one is
+  // dropped and submissions after shutdown are no-ops.
+  executor.drain();
+  q1->add(makeTask(runOrder, "late"));
+  executor.drain();
+  EXPECT_EQ(runOrder, (std::vector<std::string>{"first"}));
+  EXPECT_EQ(scheduler->numQueuedTasks(), 0);
+}
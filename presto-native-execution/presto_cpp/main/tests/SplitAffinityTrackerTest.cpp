@@ -0,0 +1,53 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/SplitAffinityTracker.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::presto {
+
+TEST(SplitAffinityTrackerTest, repeatDetection) {
+  SplitAffinityTracker tracker(16);
+  ASSERT_TRUE(tracker.enabled());
+
+  EXPECT_FALSE(tracker.recordSplit(1));
+  EXPECT_FALSE(tracker.recordSplit(2));
+  EXPECT_TRUE(tracker.recordSplit(1));
+  EXPECT_TRUE(tracker.recordSplit(2));
+  EXPECT_DOUBLE_EQ(tracker.hitRate(), 0.5);
+}
+
+TEST(SplitAffinityTrackerTest, lruEviction) {
+  SplitAffinityTracker tracker(2);
+
+  EXPECT_FALSE(tracker.recordSplit(1));
+  EXPECT_FALSE(tracker.recordSplit(2));
+  // Touch 1 so 2 becomes the least recently seen identity.
+  EXPECT_TRUE(tracker.recordSplit(1));
+  // Inserting a third identity evicts 2.
+  EXPECT_FALSE(tracker.recordSplit(3));
+  EXPECT_FALSE(tracker.recordSplit(2));
+  EXPECT_TRUE(tracker.recordSplit(3));
+}
+
+TEST(SplitAffinityTrackerTest, disabled) {
+  SplitAffinityTracker tracker(0);
+  ASSERT_FALSE(tracker.enabled());
+
+  EXPECT_FALSE(tracker.recordSplit(1));
+  EXPECT_FALSE(tracker.recordSplit(1));
+  EXPECT_DOUBLE_EQ(tracker.hitRate(), 0.0);
+}
+
+} // namespace facebook::presto
@@ -0,0 +1,90 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/SplitIngestionScheduler.h"
+
+#include <folly/executors/ManualExecutor.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::presto;
+
+namespace {
+
+// Returns an ingestion item of 'numSplits' splits that appends 'tag' to
+// 'serviceOrder' every time the scheduler serves it.
+SplitIngestionScheduler::IngestFn makeItem(
+    std::vector<std::string>& serviceOrder,
+    const std::string& tag,
+    uint64_t numSplits) {
+  auto remaining = std::make_shared<uint64_t>(numSplits);
+  return [&serviceOrder, tag, remaining](uint64_t maxSplits) -> uint64_t {
+    serviceOrder.push_back(tag);
+    const auto taken = std::min<uint64_t>(maxSplits, *remaining);
+    *remaining -= taken;
+    return *remaining;
+  };
+}
+
+} // namespace
+
+TEST(SplitIngestionSchedulerTest, interleavesQueries) {
+  folly::ManualExecutor executor;
+  auto scheduler = std::make_shared<SplitIngestionScheduler>(&executor);
+  std::vector<std::string> serviceOrder;
+
+  // One large and one small batch: the small query must be served after the
+  // large query's first chunk, not after its last.
+  scheduler->enqueue("q1", 3'000, 0, makeItem(serviceOrder, "q1", 3'000));
+  scheduler->enqueue("q2", 1'000, 0, makeItem(serviceOrder, "q2", 1'000));
+  EXPECT_EQ(scheduler->numQueuedSplits(), 4'000);
+
+  executor.drain();
+  EXPECT_EQ(scheduler->numQueuedSplits(), 0);
+  EXPECT_EQ(
+      serviceOrder,
+      (std::vector<std::string>{"q1", "q2", "q1", "q1"}));
+}
+
+TEST(SplitIngestionSchedulerTest, fifoWithinQuery) {
+  folly::ManualExecutor executor;
+  auto scheduler = std::make_shared<SplitIngestionScheduler>(&executor);
+  std::vector<std::string> serviceOrder;
+
+  scheduler->enqueue("q1", 2'048, 0, makeItem(serviceOrder, "first", 2'048));
+  scheduler->enqueue("q1", 100, 0, makeItem(serviceOrder, "second", 100));
+
+  executor.drain();
+  // The first item is fully ingested before the second starts, preserving
+  // split arrival order.
+  EXPECT_EQ(
+      serviceOrder,
+      (std::vector<std::string>{"first", "first", "second"}));
+}
+
+TEST(SplitIngestionSchedulerTest, shutdownDropsQueuedWork) {
+  folly::ManualExecutor executor;
+  auto scheduler = std::make_shared<SplitIngestionScheduler>(&executor);
+  std::vector<std::string> serviceOrder;
+
+  scheduler->enqueue("q1", 500, 0, makeItem(serviceOrder, "q1", 500));
+  scheduler->shutdown();
+
+  executor.drain();
+  EXPECT_TRUE(serviceOrder.empty());
+  EXPECT_EQ(scheduler->numQueuedSplits(), 0);
+
+  // Enqueue after shutdown is a no-op.
+  scheduler->enqueue("q2", 10, 0, makeItem(serviceOrder, "q2", 10));
+  executor.drain();
+  EXPECT_TRUE(serviceOrder.empty());
+}
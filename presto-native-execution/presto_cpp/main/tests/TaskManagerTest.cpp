@@ -113,12 +113,14 @@ class Cursor {
       const protocol::TaskId& taskId,
       const RowTypePtr& rowType,
       velox::VectorSerde::Kind serdeKind,
-      memory::MemoryPool* pool)
+      memory::MemoryPool* pool,
+      const std::string& exchangeColumns = {})
       : pool_(pool),
         taskManager_(taskManager),
         taskId_(taskId),
         rowType_(rowType),
-        serdeKind_(serdeKind) {}
+        serdeKind_(serdeKind),
+        exchangeColumns_(exchangeColumns) {}
 
   std::optional<std::vector<RowVectorPtr>> next() {
     if (atEnd_) {
@@ -132,7 +134,13 @@ class Cursor {
     auto results =
         taskManager_
             ->getResults(
-                taskId_, 0, sequence_, maxSize, maxWait, resultRequestState)
+                taskId_,
+                0,
+                sequence_,
+                maxSize,
+                maxWait,
+                resultRequestState,
+                exchangeColumns_)
             .getVia(folly::EventBaseManager::get()->getEventBase());
 
     std::vector<RowVectorPtr> vectors;
@@ -179,6 +187,7 @@ class Cursor {
   const protocol::TaskId taskId_;
   const RowTypePtr rowType_;
   const velox::VectorSerde::Kind serdeKind_;
+  const std::string exchangeColumns_;
   bool atEnd_{false};
   uint64_t sequence_{0};
 };
@@ -253,6 +262,7 @@ class TaskManagerTest : public exec::test::OperatorTestBase,
     taskResource_ = std::make_unique<TaskResource>(
         pool_.get(),
         httpSrvCpuExecutor_.get(),
+        nullptr,
         validator.get(),
         *taskManager_.get());
 
@@ -719,6 +729,68 @@ TEST_P(TaskManagerTest, tableScanAllSplitsAtOnce) {
   assertResults(taskId, rowType_, "SELECT * FROM tmp WHERE c0 % 5 = 0");
 }
 
+TEST_P(TaskManagerTest, selectiveExchangeColumns) {
+  const auto tableDir = exec::test::TempDirectoryPath::create();
+  auto filePaths = makeFilePaths(tableDir, 5);
+  auto vectors = makeVectors(filePaths.size(), 1'000);
+  for (int i = 0; i < filePaths.size(); i++) {
+    writeToFile(filePaths[i], vectors[i]);
+  }
+  duckDbQueryRunner_.createTable("tmp", vectors);
+
+  auto planFragment = exec::test::PlanBuilder()
+                          .tableScan(rowType_)
+                          .filter("c0 % 5 = 0")
+                          .partitionedOutput({}, 1, {"c0", "c1"}, GetParam())
+                          .planFragment();
+
+  long splitSequenceId{0};
+
+  protocol::TaskId taskId = "scan.0.0.1.0";
+
+  protocol::TaskUpdateRequest updateRequest;
+  updateRequest.sources.push_back(
+      makeSource("0", filePaths, true, splitSequenceId));
+  createOrUpdateTask(taskId, updateRequest, planFragment);
+
+  // Ask for column 0 only. Narrowing is best effort and only implemented for
+  // the Presto serde; for other serdes the mask is ignored and the results
+  // come back intact.
+  Cursor cursor(
+      taskManager_.get(), taskId, rowType_, GetParam(), pool_.get(), "0");
+  std::vector<RowVectorPtr> results;
+  for (;;) {
+    auto moreVectors = cursor.next();
+    if (!moreVectors.has_value()) {
+      break;
+    }
+    results.insert(
+        results.end(), moreVectors.value().begin(), moreVectors.value().end());
+  }
+
+  if (GetParam() == velox::VectorSerde::Kind::kPresto) {
+    // The schema is unchanged, the masked-out column is all nulls and the
+    // requested column still matches the full query.
+    for (const auto& result : results) {
+      auto* masked = result->childAt(1)->loadedVector();
+      for (auto row = 0; row < result->size(); ++row) {
+        ASSERT_TRUE(masked->isNullAt(row));
+      }
+    }
+    exec::test::assertResults(
+        results,
+        rowType_,
+        "SELECT c0, CAST(NULL AS VARCHAR) FROM tmp WHERE c0 % 5 = 0",
+        duckDbQueryRunner_);
+  } else {
+    exec::test::assertResults(
+        results,
+        rowType_,
+        "SELECT * FROM tmp WHERE c0 % 5 = 0",
+        duckDbQueryRunner_);
+  }
+}
+
 TEST_P(TaskManagerTest, addSplitsWithSameSourceNode) {
   const auto tableDir = exec::test::TempDirectoryPath::create();
   auto filePaths = makeFilePaths(tableDir, 5);
@@ -1011,6 +1083,116 @@ TEST_P(TaskManagerTest, tableScanOneSplitAtATime) {
   assertResults(taskId, rowType_, "SELECT * FROM tmp WHERE c0 % 5 = 1");
 }
 
+TEST_P(TaskManagerTest, taskListSnapshot) {
+  // No snapshot is published until the first rebuild.
+  ASSERT_EQ(taskManager_->taskListSnapshot(), nullptr);
+
+  taskManager_->rebuildTaskListSnapshot();
+  auto snapshot = taskManager_->taskListSnapshot();
+  ASSERT_NE(snapshot, nullptr);
+  ASSERT_EQ(nlohmann::json::parse(snapshot->body).size(), 0);
+  ASSERT_GT(snapshot->buildTimeMs, 0);
+
+  auto planFragment = exec::test::PlanBuilder()
+                          .tableScan(rowType_)
+                          .partitionedOutput({}, 1, {"c0", "c1"}, GetParam())
+                          .planFragment();
+  protocol::TaskId taskId = "scan.0.0.1.0";
+  createOrUpdateTask(taskId, {}, planFragment);
+
+  // The published snapshot is stale until the next rebuild.
+  ASSERT_EQ(
+      nlohmann::json::parse(taskManager_->taskListSnapshot()->body).size(), 0);
+
+  taskManager_->rebuildTaskListSnapshot();
+  auto taskList = nlohmann::json::parse(taskManager_->taskListSnapshot()->body);
+  ASSERT_EQ(taskList.size(), 1);
+  ASSERT_EQ(taskList[0]["taskId"], taskId);
+}
+
+TEST_P(TaskManagerTest, taskSetSnapshot) {
+  auto empty = taskManager_->taskSetSnapshot();
+  ASSERT_NE(empty, nullptr);
+  ASSERT_EQ(empty->tasks.size(), 0);
+  // An unchanged task set is answered with the published snapshot.
+  ASSERT_EQ(taskManager_->taskSetSnapshot(), empty);
+
+  auto planFragment = exec::test::PlanBuilder()
+                          .tableScan(rowType_)
+                          .partitionedOutput({}, 1, {"c0", "c1"}, GetParam())
+                          .planFragment();
+  protocol::TaskId taskId = "scan.0.0.1.0";
+  createOrUpdateTask(taskId, {}, planFragment);
+
+  // Registering a task moves the membership version, so the next request
+  // rebuilds; the rebuilt snapshot is then served until the set changes
+  // again.
+  auto snapshot = taskManager_->taskSetSnapshot();
+  ASSERT_NE(snapshot, empty);
+  ASSERT_EQ(snapshot->tasks.size(), 1);
+  ASSERT_EQ(snapshot->tasks[0]->info.taskId, taskId);
+  ASSERT_EQ(taskManager_->taskSetSnapshot(), snapshot);
+}
+
+TEST_P(TaskManagerTest, queryDeadlineExpired) {
+  auto planFragment = exec::test::PlanBuilder()
+                          .tableScan(rowType_)
+                          .partitionedOutput({}, 1, {"c0", "c1"}, GetParam())
+                          .planFragment();
+  protocol::TaskId taskId = "scan.0.0.1.0";
+  protocol::TaskUpdateRequest updateRequest;
+  // A deadline in the past refuses the update instead of creating the task.
+  updateRequest.session.systemProperties["native_query_deadline_ms"] = "1";
+  VELOX_ASSERT_THROW(
+      createOrUpdateTask(taskId, updateRequest, planFragment),
+      "arrived after the query deadline");
+}
+
+TEST_P(TaskManagerTest, queryDeadlineSweepCancelsRunningTask) {
+  auto planFragment = exec::test::PlanBuilder()
+                          .tableScan(rowType_)
+                          .partitionedOutput({}, 1, {"c0", "c1"}, GetParam())
+                          .planFragment();
+  // No splits and no no-more-splits signal, so the task stays running.
+  protocol::TaskId taskId = "scan.0.0.1.0";
+  createOrUpdateTask(taskId, {}, planFragment);
+
+  auto prestoTask = taskManager_->tasks().at(taskId);
+  ASSERT_TRUE(prestoTask->task->isRunning());
+
+  // A sweep with no deadline set leaves the task running.
+  taskManager_->cleanOldTasks();
+  ASSERT_TRUE(prestoTask->task->isRunning());
+
+  // Expire the deadline; the next sweep requests cancellation.
+  prestoTask->queryDeadlineMs = velox::getCurrentTimeMs() - 1;
+  taskManager_->cleanOldTasks();
+  ASSERT_TRUE(waitForTaskStateChange(
+      prestoTask->task.get(), TaskState::kCanceled, 3'000'000));
+}
+
+TEST_P(TaskManagerTest, prestartUpstreamWarmup) {
+  std::vector<std::string> warmed;
+  taskManager_->setRemoteSourceWarmupCallback(
+      [&warmed](const std::string& location) { warmed.push_back(location); });
+
+  auto planFragment = exec::test::PlanBuilder()
+                          .tableScan(rowType_)
+                          .partitionedOutput({}, 1, {"c0", "c1"}, GetParam())
+                          .planFragment();
+  protocol::TaskUpdateRequest updateRequest;
+  // A fragment-only create announcing two upstream locations, one twice;
+  // each distinct location is warmed once.
+  updateRequest.session
+      .systemProperties["native_prestart_upstream_locations"] =
+      "http://w1:8080/v1/task/t1,http://w2:8080/v1/task/t2,"
+      "http://w1:8080/v1/task/t1";
+  createOrUpdateTask("scan.0.0.1.0", updateRequest, planFragment);
+  ASSERT_EQ(warmed.size(), 2);
+
+  taskManager_->setRemoteSourceWarmupCallback(nullptr);
+}
+
 // Runs 2-stage tableScan: (1) multiple table scan tasks; (2) single output task
 TEST_P(TaskManagerTest, tableScanMultipleTasks) {
   const auto tableDir = exec::test::TempDirectoryPath::create();
@@ -1256,6 +1438,57 @@ TEST_P(TaskManagerTest, getBaseSpillDirectory) {
   EXPECT_EQ("dummy", taskManager_->getBaseSpillDirectory());
 }
 
+TEST_P(TaskManagerTest, taskStatusBatch) {
+  auto vectors = makeVectors(2, 100);
+  duckDbQueryRunner_.createTable("tmp", vectors);
+
+  auto planFragment = exec::test::PlanBuilder()
+                          .values(vectors)
+                          .partitionedOutput({}, 1, {"c0", "c1"}, GetParam())
+                          .planFragment();
+  protocol::TaskId taskId = "test.0.0.1.0";
+  createOrUpdateTask(taskId, {}, planFragment);
+  assertResults(taskId, rowType_, "SELECT * FROM tmp");
+
+  const auto requestFor = [&](const std::string& etag) {
+    nlohmann::json request = nlohmann::json::array();
+    if (etag.empty()) {
+      request.push_back(taskId);
+    } else {
+      request.push_back({{"taskId", taskId}, {"etag", etag}});
+    }
+    request.push_back("unknown.0.0.1.0");
+    return request.dump();
+  };
+
+  // Poll until the task reaches its final state; from then on the serialized
+  // status is cached and its ETag stable.
+  nlohmann::json entry;
+  for (auto attempt = 0; attempt < 100; ++attempt) {
+    const auto response = nlohmann::json::parse(
+        taskManager_->getTaskStatusBatchJson(requestFor("")));
+    ASSERT_EQ(response.size(), 2);
+    entry = response[0];
+    ASSERT_EQ(entry.at("taskId"), taskId);
+    ASSERT_TRUE(response[1].value("unknown", false));
+    if (entry.at("status").at("state") == "FINISHED") {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  ASSERT_EQ(entry.at("status").at("state"), "FINISHED");
+
+  // A conditional poll with the current ETag is answered without a status
+  // body.
+  const auto etag = entry.at("etag").get<std::string>();
+  const auto response = nlohmann::json::parse(
+      taskManager_->getTaskStatusBatchJson(requestFor(etag)));
+  const auto& conditional = response[0];
+  EXPECT_EQ(conditional.at("etag"), etag);
+  EXPECT_TRUE(conditional.value("notModified", false));
+  EXPECT_FALSE(conditional.contains("status"));
+}
+
 TEST_P(TaskManagerTest, aggregationSpill) {
   // NOTE: we need to write more than one batches to each file (source split) to
   // trigger spill.
@@ -1728,6 +1961,110 @@ TEST_P(TaskManagerTest, summarize) {
   ASSERT_GT(taskInfo->stats.pipelines.size(), 0);
 }
 
+TEST_P(TaskManagerTest, taskInfoFieldMask) {
+  // Parsing of the 'fields' query parameter value.
+  auto mask = TaskInfoFieldMask::fromFieldsParam("pipelines");
+  ASSERT_TRUE(mask.pipelines);
+  ASSERT_FALSE(mask.operatorRuntimeStats);
+  ASSERT_FALSE(mask.taskRuntimeStats);
+  mask = TaskInfoFieldMask::fromFieldsParam(
+      "pipelines/operators/runtimeStats,runtimeStats");
+  ASSERT_TRUE(mask.pipelines);
+  ASSERT_TRUE(mask.operatorRuntimeStats);
+  ASSERT_TRUE(mask.taskRuntimeStats);
+  ASSERT_THROW(
+      TaskInfoFieldMask::fromFieldsParam("bogus"), velox::VeloxUserError);
+
+  const auto tableDir = exec::test::TempDirectoryPath::create();
+  auto filePaths = makeFilePaths(tableDir, 5);
+  auto vectors = makeVectors(filePaths.size(), 1'000);
+  for (int i = 0; i < filePaths.size(); i++) {
+    writeToFile(filePaths[i], vectors[i]);
+  }
+  duckDbQueryRunner_.createTable("tmp", vectors);
+
+  auto planFragment = exec::test::PlanBuilder()
+                          .tableScan(rowType_)
+                          .filter("c0 % 5 = 1")
+                          .partitionedOutput({}, 1, {"c0", "c1"}, GetParam())
+                          .planFragment();
+
+  protocol::TaskId taskId = "scan.0.0.1.0";
+  auto taskInfo = createOrUpdateTask(taskId, {}, planFragment, false);
+
+  long splitSequenceId{0};
+  protocol::TaskUpdateRequest updateRequest;
+  for (auto& filePath : filePaths) {
+    updateRequest.sources.push_back(
+        makeSource("0", {filePath}, false, splitSequenceId));
+  }
+  updateRequest.sources.push_back(makeSource("0", {}, true, splitSequenceId));
+  taskInfo = taskManager_->createOrUpdateTask(
+      taskId, updateRequest, {}, false, nullptr, 0);
+
+  assertResults(taskId, rowType_, "SELECT * FROM tmp WHERE c0 % 5 = 1");
+
+  auto callback = std::make_shared<http::CallbackRequestHandlerState>();
+  // The default mask keeps the full stats tree.
+  taskInfo =
+      taskManager_
+          ->getTaskInfo(taskId, false, std::nullopt, std::nullopt, callback)
+          .get();
+  ASSERT_GT(taskInfo->stats.pipelines.size(), 0);
+  ASSERT_GT(taskInfo->stats.runtimeStats.size(), 0);
+  ASSERT_GT(taskInfo->stats.pipelines[0].operatorSummaries.size(), 0);
+
+  // A mask without any groups strips pipelines and runtime stats but keeps
+  // the task-level counters.
+  taskInfo = taskManager_
+                 ->getTaskInfo(
+                     taskId,
+                     false,
+                     std::nullopt,
+                     std::nullopt,
+                     callback,
+                     TaskInfoFieldMask::fromFieldsParam(""))
+                 .get();
+  ASSERT_EQ(taskInfo->stats.pipelines.size(), 0);
+  ASSERT_EQ(taskInfo->stats.runtimeStats.size(), 0);
+  ASSERT_GT(taskInfo->stats.totalCpuTimeInNanos, 0);
+  ASSERT_GT(taskInfo->stats.processedInputPositions, 0);
+
+  // Pipelines without their per-operator runtime stats maps.
+  taskInfo = taskManager_
+                 ->getTaskInfo(
+                     taskId,
+                     false,
+                     std::nullopt,
+                     std::nullopt,
+                     callback,
+                     TaskInfoFieldMask::fromFieldsParam("pipelines"))
+                 .get();
+  ASSERT_GT(taskInfo->stats.pipelines.size(), 0);
+  for (const auto& pipeline : taskInfo->stats.pipelines) {
+    for (const auto& opStats : pipeline.operatorSummaries) {
+      ASSERT_EQ(opStats.runtimeStats.size(), 0);
+    }
+  }
+
+  // The full tree is back when the next request asks for everything.
+  taskInfo = taskManager_
+                 ->getTaskInfo(
+                     taskId,
+                     false,
+                     std::nullopt,
+                     std::nullopt,
+                     callback,
+                     TaskInfoFieldMask::fromFieldsParam(
+                         "pipelines,pipelines/operators/runtimeStats,"
+                         "runtimeStats"))
+                 .get();
+  ASSERT_GT(taskInfo->stats.pipelines.size(), 0);
+  ASSERT_GT(taskInfo->stats.runtimeStats.size(), 0);
+
+  taskManager_->deleteTask(taskId, true, true);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     TaskManagerTest,
     TaskManagerTest,
@@ -0,0 +1,81 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/TaskMemoryForecaster.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+namespace facebook::presto {
+namespace {
+
+TEST(TaskMemoryForecasterTest, forecast) {
+  TaskMemoryForecaster forecaster;
+  const auto hash = TaskMemoryForecaster::fragmentShapeHash("fragment-1");
+  EXPECT_EQ(forecaster.forecastPeakBytes(hash), -1);
+
+  // The first observation seeds the average; later ones blend in.
+  forecaster.registerTask("task-1", hash);
+  forecaster.recordCompletion("task-1", 1'000);
+  EXPECT_EQ(forecaster.forecastPeakBytes(hash), 1'000);
+
+  forecaster.registerTask("task-2", hash);
+  forecaster.recordCompletion("task-2", 2'000);
+  const auto blended = forecaster.forecastPeakBytes(hash);
+  EXPECT_GT(blended, 1'000);
+  EXPECT_LT(blended, 2'000);
+
+  // Different fragment shapes keep independent histories.
+  const auto otherHash =
+      TaskMemoryForecaster::fragmentShapeHash("fragment-2");
+  EXPECT_NE(hash, otherHash);
+  EXPECT_EQ(forecaster.forecastPeakBytes(otherHash), -1);
+}
+
+TEST(TaskMemoryForecasterTest, unregisteredTasksIgnored) {
+  TaskMemoryForecaster forecaster;
+  const auto hash = TaskMemoryForecaster::fragmentShapeHash("fragment-1");
+
+  // Completions without a registration (e.g. forecasting turned on while
+  // tasks were already running) do not pollute any bucket.
+  forecaster.recordCompletion("task-1", 1'000);
+  EXPECT_EQ(forecaster.forecastPeakBytes(hash), -1);
+
+  // An unregistered (aborted/swept) task does not report either.
+  forecaster.registerTask("task-2", hash);
+  forecaster.unregisterTask("task-2");
+  forecaster.recordCompletion("task-2", 1'000);
+  EXPECT_EQ(forecaster.forecastPeakBytes(hash), -1);
+}
+
+TEST(TaskMemoryForecasterTest, eviction) {
+  TaskMemoryForecaster forecaster;
+  const auto firstHash = TaskMemoryForecaster::fragmentShapeHash("shape-0");
+  for (size_t i = 0; i <= TaskMemoryForecaster::kCapacity; ++i) {
+    const auto taskId = fmt::format("task-{}", i);
+    forecaster.registerTask(
+        taskId,
+        TaskMemoryForecaster::fragmentShapeHash(fmt::format("shape-{}", i)));
+    forecaster.recordCompletion(taskId, 1'000);
+  }
+  // The oldest shape was evicted to keep the history bounded; the newest
+  // is retained.
+  EXPECT_EQ(forecaster.forecastPeakBytes(firstHash), -1);
+  EXPECT_EQ(
+      forecaster.forecastPeakBytes(TaskMemoryForecaster::fragmentShapeHash(
+          fmt::format("shape-{}", TaskMemoryForecaster::kCapacity))),
+      1'000);
+}
+
+} // namespace
+} // namespace facebook::presto
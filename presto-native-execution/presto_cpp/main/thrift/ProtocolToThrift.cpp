@@ -15,8 +15,13 @@
 
 // This file is generated DO NOT EDIT @generated
 
+#include <folly/hash/Hash.h>
+
+#include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/thrift/ProtocolToThrift.h"
 #include "presto_cpp/main/thrift/ThriftIO.h"
+#include "presto_cpp/main/thrift/ThriftSplitToVelox.h"
+#include "presto_cpp/main/types/DirectVeloxSplit.h"
 #include "presto_cpp/presto_protocol/core/ConnectorProtocol.h"
 
 namespace facebook::presto::thrift {
@@ -347,6 +352,62 @@ void fromThrift(
       proto = protoRemoteSplit;
       return;
     }
+    const bool directConversion =
+        facebook::presto::SystemConfig::instance()
+            ->taskThriftDirectSplitConversionEnabled();
+    if (thrift.connectorId() == "hive") {
+      auto thriftHiveSplit = std::make_shared<HiveSplit>();
+      thriftRead(thrift.customSerializedValue().value(), thriftHiveSplit);
+      if (directConversion) {
+        // Defer the velox split construction to toVeloxSplit(), which knows
+        // the catalog id and split context of the enclosing split; no
+        // intermediate protocol struct tree is materialized.
+        auto directSplit =
+            std::make_shared<facebook::presto::DirectVeloxSplit>();
+        directSplit->payloadHash =
+            folly::hash::fnv64(thrift.customSerializedValue().value());
+        directSplit->toVelox =
+            [thriftHiveSplit](
+                const facebook::presto::protocol::ConnectorId& catalogId,
+                const facebook::presto::protocol::SplitContext& splitContext) {
+              return facebook::presto::thrift::toVeloxHiveSplit(
+                  *thriftHiveSplit, catalogId, splitContext);
+            };
+        proto = directSplit;
+        return;
+      }
+      auto protoHiveSplit =
+          std::make_shared<facebook::presto::protocol::hive::HiveSplit>();
+      facebook::presto::thrift::fromThrift(thriftHiveSplit, protoHiveSplit);
+      proto = protoHiveSplit;
+      return;
+    }
+    if (thrift.connectorId() == "iceberg" ||
+        thrift.connectorId() == "hive-iceberg") {
+      auto thriftIcebergSplit = std::make_shared<IcebergSplit>();
+      thriftRead(thrift.customSerializedValue().value(), thriftIcebergSplit);
+      if (directConversion) {
+        auto directSplit =
+            std::make_shared<facebook::presto::DirectVeloxSplit>();
+        directSplit->payloadHash =
+            folly::hash::fnv64(thrift.customSerializedValue().value());
+        directSplit->toVelox =
+            [thriftIcebergSplit](
+                const facebook::presto::protocol::ConnectorId& catalogId,
+                const facebook::presto::protocol::SplitContext& splitContext) {
+              return facebook::presto::thrift::toVeloxIcebergSplit(
+                  *thriftIcebergSplit, catalogId, splitContext);
+            };
+        proto = directSplit;
+        return;
+      }
+      auto protoIcebergSplit =
+          std::make_shared<facebook::presto::protocol::iceberg::IcebergSplit>();
+      facebook::presto::thrift::fromThrift(
+          thriftIcebergSplit, protoIcebergSplit);
+      proto = protoIcebergSplit;
+      return;
+    }
     facebook::presto::protocol::getConnectorProtocol(
         thrift.connectorId().value())
         .deserialize(thrift.customSerializedValue().value(), proto);
@@ -378,6 +439,20 @@ void fromThrift(
       proto = protoRemoteTransactionHandle;
       return;
     }
+    if (thrift.connectorId() == "hive" || thrift.connectorId() == "iceberg" ||
+        thrift.connectorId() == "hive-iceberg") {
+      // The iceberg connector reuses the hive transaction handle.
+      auto protoHiveTransactionHandle = std::make_shared<
+          facebook::presto::protocol::hive::HiveTransactionHandle>();
+      auto thriftHiveTransactionHandle =
+          std::make_shared<HiveTransactionHandle>();
+      thriftRead(
+          thrift.customSerializedValue().value(), thriftHiveTransactionHandle);
+      facebook::presto::thrift::fromThrift(
+          thriftHiveTransactionHandle, protoHiveTransactionHandle);
+      proto = protoHiveTransactionHandle;
+      return;
+    }
     facebook::presto::protocol::getConnectorProtocol(
         thrift.connectorId().value())
         .deserialize(thrift.customSerializedValue().value(), proto);
@@ -2050,4 +2125,509 @@ void fromThrift(
   fromThrift(thrift.tableWriteInfo_ref(), proto.tableWriteInfo);
 }
 
+void toThrift(
+    const facebook::presto::protocol::NodeSelectionStrategy& proto,
+    NodeSelectionStrategy& thrift) {
+  thrift = (NodeSelectionStrategy)(static_cast<int>(proto));
+}
+void fromThrift(
+    const NodeSelectionStrategy& thrift,
+    facebook::presto::protocol::NodeSelectionStrategy& proto) {
+  proto = (facebook::presto::protocol::NodeSelectionStrategy)(
+      static_cast<int>(thrift));
+}
+
+void toThrift(
+    const facebook::presto::protocol::CacheQuotaScope& proto,
+    CacheQuotaScope& thrift) {
+  thrift = (CacheQuotaScope)(static_cast<int>(proto));
+}
+void fromThrift(
+    const CacheQuotaScope& thrift,
+    facebook::presto::protocol::CacheQuotaScope& proto) {
+  proto =
+      (facebook::presto::protocol::CacheQuotaScope)(static_cast<int>(thrift));
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::ColumnType& proto,
+    HiveColumnType& thrift) {
+  thrift = (HiveColumnType)(static_cast<int>(proto));
+}
+void fromThrift(
+    const HiveColumnType& thrift,
+    facebook::presto::protocol::hive::ColumnType& proto) {
+  proto =
+      (facebook::presto::protocol::hive::ColumnType)(static_cast<int>(thrift));
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::BucketFunctionType& proto,
+    BucketFunctionType& thrift) {
+  thrift = (BucketFunctionType)(static_cast<int>(proto));
+}
+void fromThrift(
+    const BucketFunctionType& thrift,
+    facebook::presto::protocol::hive::BucketFunctionType& proto) {
+  proto = (facebook::presto::protocol::hive::BucketFunctionType)(
+      static_cast<int>(thrift));
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::Order& proto,
+    Order& thrift) {
+  thrift = (Order)(static_cast<int>(proto));
+}
+void fromThrift(
+    const Order& thrift,
+    facebook::presto::protocol::hive::Order& proto) {
+  proto = (facebook::presto::protocol::hive::Order)(static_cast<int>(thrift));
+}
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::ChangelogOperation& proto,
+    ChangelogOperation& thrift) {
+  thrift = (ChangelogOperation)(static_cast<int>(proto));
+}
+void fromThrift(
+    const ChangelogOperation& thrift,
+    facebook::presto::protocol::iceberg::ChangelogOperation& proto) {
+  proto = (facebook::presto::protocol::iceberg::ChangelogOperation)(
+      static_cast<int>(thrift));
+}
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::TypeCategory& proto,
+    TypeCategory& thrift) {
+  thrift = (TypeCategory)(static_cast<int>(proto));
+}
+void fromThrift(
+    const TypeCategory& thrift,
+    facebook::presto::protocol::iceberg::TypeCategory& proto) {
+  proto = (facebook::presto::protocol::iceberg::TypeCategory)(
+      static_cast<int>(thrift));
+}
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::FileContent& proto,
+    IcebergFileContent& thrift) {
+  thrift = (IcebergFileContent)(static_cast<int>(proto));
+}
+void fromThrift(
+    const IcebergFileContent& thrift,
+    facebook::presto::protocol::iceberg::FileContent& proto) {
+  proto = (facebook::presto::protocol::iceberg::FileContent)(
+      static_cast<int>(thrift));
+}
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::FileFormat& proto,
+    IcebergFileFormat& thrift) {
+  thrift = (IcebergFileFormat)(static_cast<int>(proto));
+}
+void fromThrift(
+    const IcebergFileFormat& thrift,
+    facebook::presto::protocol::iceberg::FileFormat& proto) {
+  proto = (facebook::presto::protocol::iceberg::FileFormat)(
+      static_cast<int>(thrift));
+}
+
+void toThrift(const facebook::presto::protocol::Column& proto, Column& thrift) {
+  toThrift(proto.name, *thrift.name_ref());
+  toThrift(proto.type, *thrift.type_ref());
+}
+void fromThrift(
+    const Column& thrift,
+    facebook::presto::protocol::Column& proto) {
+  fromThrift(*thrift.name_ref(), proto.name);
+  fromThrift(*thrift.type_ref(), proto.type);
+}
+
+void toThrift(
+    const facebook::presto::protocol::CacheQuotaRequirement& proto,
+    CacheQuotaRequirement& thrift) {
+  toThrift(proto.cacheQuotaScope, *thrift.cacheQuotaScope_ref());
+  toThrift(proto.quota, thrift.quota_ref());
+}
+void fromThrift(
+    const CacheQuotaRequirement& thrift,
+    facebook::presto::protocol::CacheQuotaRequirement& proto) {
+  fromThrift(*thrift.cacheQuotaScope_ref(), proto.cacheQuotaScope);
+  fromThrift(thrift.quota_ref(), proto.quota);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::StorageFormat& proto,
+    StorageFormat& thrift) {
+  toThrift(proto.serDe, *thrift.serDe_ref());
+  toThrift(proto.inputFormat, *thrift.inputFormat_ref());
+  toThrift(proto.outputFormat, *thrift.outputFormat_ref());
+}
+void fromThrift(
+    const StorageFormat& thrift,
+    facebook::presto::protocol::hive::StorageFormat& proto) {
+  fromThrift(*thrift.serDe_ref(), proto.serDe);
+  fromThrift(*thrift.inputFormat_ref(), proto.inputFormat);
+  fromThrift(*thrift.outputFormat_ref(), proto.outputFormat);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::SortingColumn& proto,
+    SortingColumn& thrift) {
+  toThrift(proto.columnName, *thrift.columnName_ref());
+  toThrift(proto.order, *thrift.order_ref());
+}
+void fromThrift(
+    const SortingColumn& thrift,
+    facebook::presto::protocol::hive::SortingColumn& proto) {
+  fromThrift(*thrift.columnName_ref(), proto.columnName);
+  fromThrift(*thrift.order_ref(), proto.order);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::HiveBucketProperty& proto,
+    HiveBucketProperty& thrift) {
+  toThrift(proto.bucketedBy, *thrift.bucketedBy_ref());
+  toThrift(proto.bucketCount, *thrift.bucketCount_ref());
+  toThrift(proto.sortedBy, *thrift.sortedBy_ref());
+  toThrift(proto.bucketFunctionType, *thrift.bucketFunctionType_ref());
+  toThrift(proto.types, thrift.types_ref());
+}
+void fromThrift(
+    const HiveBucketProperty& thrift,
+    facebook::presto::protocol::hive::HiveBucketProperty& proto) {
+  fromThrift(*thrift.bucketedBy_ref(), proto.bucketedBy);
+  fromThrift(*thrift.bucketCount_ref(), proto.bucketCount);
+  fromThrift(*thrift.sortedBy_ref(), proto.sortedBy);
+  fromThrift(*thrift.bucketFunctionType_ref(), proto.bucketFunctionType);
+  fromThrift(thrift.types_ref(), proto.types);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::Storage& proto,
+    Storage& thrift) {
+  toThrift(proto.storageFormat, *thrift.storageFormat_ref());
+  toThrift(proto.location, *thrift.location_ref());
+  toThrift(proto.bucketProperty, thrift.bucketProperty_ref());
+  toThrift(proto.skewed, *thrift.skewed_ref());
+  toThrift(proto.serdeParameters, *thrift.serdeParameters_ref());
+  toThrift(proto.parameters, *thrift.parameters_ref());
+}
+void fromThrift(
+    const Storage& thrift,
+    facebook::presto::protocol::hive::Storage& proto) {
+  fromThrift(*thrift.storageFormat_ref(), proto.storageFormat);
+  fromThrift(*thrift.location_ref(), proto.location);
+  fromThrift(thrift.bucketProperty_ref(), proto.bucketProperty);
+  fromThrift(*thrift.skewed_ref(), proto.skewed);
+  fromThrift(*thrift.serdeParameters_ref(), proto.serdeParameters);
+  fromThrift(*thrift.parameters_ref(), proto.parameters);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::HiveFileSplit& proto,
+    HiveFileSplit& thrift) {
+  toThrift(proto.path, *thrift.path_ref());
+  toThrift(proto.start, *thrift.start_ref());
+  toThrift(proto.length, *thrift.length_ref());
+  toThrift(proto.fileSize, *thrift.fileSize_ref());
+  toThrift(proto.fileModifiedTime, *thrift.fileModifiedTime_ref());
+  toThrift(proto.extraFileInfo, thrift.extraFileInfo_ref());
+  toThrift(proto.customSplitInfo, *thrift.customSplitInfo_ref());
+  toThrift(
+      proto.affinitySchedulingFileSectionIndex,
+      *thrift.affinitySchedulingFileSectionIndex_ref());
+}
+void fromThrift(
+    const HiveFileSplit& thrift,
+    facebook::presto::protocol::hive::HiveFileSplit& proto) {
+  fromThrift(*thrift.path_ref(), proto.path);
+  fromThrift(*thrift.start_ref(), proto.start);
+  fromThrift(*thrift.length_ref(), proto.length);
+  fromThrift(*thrift.fileSize_ref(), proto.fileSize);
+  fromThrift(*thrift.fileModifiedTime_ref(), proto.fileModifiedTime);
+  fromThrift(thrift.extraFileInfo_ref(), proto.extraFileInfo);
+  fromThrift(*thrift.customSplitInfo_ref(), proto.customSplitInfo);
+  fromThrift(
+      *thrift.affinitySchedulingFileSectionIndex_ref(),
+      proto.affinitySchedulingFileSectionIndex);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::HivePartitionKey& proto,
+    HivePartitionKey& thrift) {
+  toThrift(proto.name, *thrift.name_ref());
+  toThrift(proto.value, thrift.value_ref());
+}
+void fromThrift(
+    const HivePartitionKey& thrift,
+    facebook::presto::protocol::hive::HivePartitionKey& proto) {
+  fromThrift(*thrift.name_ref(), proto.name);
+  fromThrift(thrift.value_ref(), proto.value);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::TableToPartitionMapping& proto,
+    TableToPartitionMapping& thrift) {
+  toThrift(proto.tableToPartitionColumns, thrift.tableToPartitionColumns_ref());
+  toThrift(
+      proto.partitionSchemaDifference, *thrift.partitionSchemaDifference_ref());
+}
+void fromThrift(
+    const TableToPartitionMapping& thrift,
+    facebook::presto::protocol::hive::TableToPartitionMapping& proto) {
+  fromThrift(
+      thrift.tableToPartitionColumns_ref(), proto.tableToPartitionColumns);
+  fromThrift(
+      *thrift.partitionSchemaDifference_ref(), proto.partitionSchemaDifference);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::DwrfEncryptionMetadata& proto,
+    DwrfEncryptionMetadata& thrift) {
+  toThrift(proto.fieldToKeyData, *thrift.fieldToKeyData_ref());
+  toThrift(proto.extraMetadata, *thrift.extraMetadata_ref());
+  toThrift(proto.encryptionAlgorithm, *thrift.encryptionAlgorithm_ref());
+  toThrift(proto.encryptionProvider, *thrift.encryptionProvider_ref());
+}
+void fromThrift(
+    const DwrfEncryptionMetadata& thrift,
+    facebook::presto::protocol::hive::DwrfEncryptionMetadata& proto) {
+  fromThrift(*thrift.fieldToKeyData_ref(), proto.fieldToKeyData);
+  fromThrift(*thrift.extraMetadata_ref(), proto.extraMetadata);
+  fromThrift(*thrift.encryptionAlgorithm_ref(), proto.encryptionAlgorithm);
+  fromThrift(*thrift.encryptionProvider_ref(), proto.encryptionProvider);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::EncryptionInformation& proto,
+    EncryptionInformation& thrift) {
+  toThrift(proto.dwrfEncryptionMetadata, thrift.dwrfEncryptionMetadata_ref());
+}
+void fromThrift(
+    const EncryptionInformation& thrift,
+    facebook::presto::protocol::hive::EncryptionInformation& proto) {
+  fromThrift(thrift.dwrfEncryptionMetadata_ref(), proto.dwrfEncryptionMetadata);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::HiveColumnHandle& proto,
+    HiveColumnHandle& thrift) {
+  toThrift(proto.name, *thrift.name_ref());
+  toThrift(proto.hiveType, *thrift.hiveType_ref());
+  toThrift(proto.typeSignature, *thrift.typeSignature_ref());
+  toThrift(proto.hiveColumnIndex, *thrift.hiveColumnIndex_ref());
+  toThrift(proto.columnType, *thrift.columnType_ref());
+  toThrift(proto.comment, thrift.comment_ref());
+  toThrift(proto.requiredSubfields, *thrift.requiredSubfields_ref());
+}
+void fromThrift(
+    const HiveColumnHandle& thrift,
+    facebook::presto::protocol::hive::HiveColumnHandle& proto) {
+  fromThrift(*thrift.name_ref(), proto.name);
+  fromThrift(*thrift.hiveType_ref(), proto.hiveType);
+  fromThrift(*thrift.typeSignature_ref(), proto.typeSignature);
+  fromThrift(*thrift.hiveColumnIndex_ref(), proto.hiveColumnIndex);
+  fromThrift(*thrift.columnType_ref(), proto.columnType);
+  fromThrift(thrift.comment_ref(), proto.comment);
+  fromThrift(*thrift.requiredSubfields_ref(), proto.requiredSubfields);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::BucketConversion& proto,
+    BucketConversion& thrift) {
+  toThrift(proto.tableBucketCount, *thrift.tableBucketCount_ref());
+  toThrift(proto.partitionBucketCount, *thrift.partitionBucketCount_ref());
+  toThrift(proto.bucketColumnHandles, *thrift.bucketColumnHandles_ref());
+}
+void fromThrift(
+    const BucketConversion& thrift,
+    facebook::presto::protocol::hive::BucketConversion& proto) {
+  fromThrift(*thrift.tableBucketCount_ref(), proto.tableBucketCount);
+  fromThrift(*thrift.partitionBucketCount_ref(), proto.partitionBucketCount);
+  fromThrift(*thrift.bucketColumnHandles_ref(), proto.bucketColumnHandles);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::HiveSplit& proto,
+    HiveSplit& thrift) {
+  toThrift(proto.fileSplit, *thrift.fileSplit_ref());
+  toThrift(proto.database, *thrift.database_ref());
+  toThrift(proto.table, *thrift.table_ref());
+  toThrift(proto.partitionName, *thrift.partitionName_ref());
+  toThrift(proto.storage, *thrift.storage_ref());
+  toThrift(proto.partitionKeys, *thrift.partitionKeys_ref());
+  toThrift(proto.addresses, *thrift.addresses_ref());
+  toThrift(proto.readBucketNumber, thrift.readBucketNumber_ref());
+  toThrift(proto.tableBucketNumber, thrift.tableBucketNumber_ref());
+  toThrift(proto.nodeSelectionStrategy, *thrift.nodeSelectionStrategy_ref());
+  toThrift(
+      proto.partitionDataColumnCount, *thrift.partitionDataColumnCount_ref());
+  toThrift(
+      proto.tableToPartitionMapping, *thrift.tableToPartitionMapping_ref());
+  toThrift(proto.bucketConversion, thrift.bucketConversion_ref());
+  toThrift(
+      proto.s3SelectPushdownEnabled, *thrift.s3SelectPushdownEnabled_ref());
+  toThrift(proto.cacheQuota, *thrift.cacheQuota_ref());
+  toThrift(proto.encryptionMetadata, thrift.encryptionMetadata_ref());
+  toThrift(proto.splitWeight, *thrift.splitWeight_ref());
+  toThrift(proto.rowIdPartitionComponent, thrift.rowIdPartitionComponent_ref());
+}
+void fromThrift(
+    const HiveSplit& thrift,
+    facebook::presto::protocol::hive::HiveSplit& proto) {
+  fromThrift(*thrift.fileSplit_ref(), proto.fileSplit);
+  fromThrift(*thrift.database_ref(), proto.database);
+  fromThrift(*thrift.table_ref(), proto.table);
+  fromThrift(*thrift.partitionName_ref(), proto.partitionName);
+  fromThrift(*thrift.storage_ref(), proto.storage);
+  fromThrift(*thrift.partitionKeys_ref(), proto.partitionKeys);
+  fromThrift(*thrift.addresses_ref(), proto.addresses);
+  fromThrift(thrift.readBucketNumber_ref(), proto.readBucketNumber);
+  fromThrift(thrift.tableBucketNumber_ref(), proto.tableBucketNumber);
+  fromThrift(*thrift.nodeSelectionStrategy_ref(), proto.nodeSelectionStrategy);
+  fromThrift(
+      *thrift.partitionDataColumnCount_ref(), proto.partitionDataColumnCount);
+  fromThrift(
+      *thrift.tableToPartitionMapping_ref(), proto.tableToPartitionMapping);
+  fromThrift(thrift.bucketConversion_ref(), proto.bucketConversion);
+  fromThrift(
+      *thrift.s3SelectPushdownEnabled_ref(), proto.s3SelectPushdownEnabled);
+  fromThrift(*thrift.cacheQuota_ref(), proto.cacheQuota);
+  fromThrift(thrift.encryptionMetadata_ref(), proto.encryptionMetadata);
+  fromThrift(*thrift.splitWeight_ref(), proto.splitWeight);
+  fromThrift(
+      thrift.rowIdPartitionComponent_ref(), proto.rowIdPartitionComponent);
+}
+
+void toThrift(
+    const facebook::presto::protocol::hive::HiveTransactionHandle& proto,
+    HiveTransactionHandle& thrift) {
+  toThrift(proto.uuid, *thrift.uuid_ref());
+}
+void fromThrift(
+    const HiveTransactionHandle& thrift,
+    facebook::presto::protocol::hive::HiveTransactionHandle& proto) {
+  fromThrift(*thrift.uuid_ref(), proto.uuid);
+}
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::ColumnIdentity& proto,
+    ColumnIdentity& thrift) {
+  toThrift(proto.id, *thrift.id_ref());
+  toThrift(proto.name, *thrift.name_ref());
+  toThrift(proto.typeCategory, *thrift.typeCategory_ref());
+  toThrift(proto.children, *thrift.children_ref());
+}
+void fromThrift(
+    const ColumnIdentity& thrift,
+    facebook::presto::protocol::iceberg::ColumnIdentity& proto) {
+  fromThrift(*thrift.id_ref(), proto.id);
+  fromThrift(*thrift.name_ref(), proto.name);
+  fromThrift(*thrift.typeCategory_ref(), proto.typeCategory);
+  fromThrift(*thrift.children_ref(), proto.children);
+}
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::IcebergColumnHandle& proto,
+    IcebergColumnHandle& thrift) {
+  toThrift(proto.columnIdentity, *thrift.columnIdentity_ref());
+  toThrift(proto.type, *thrift.type_ref());
+  toThrift(proto.comment, thrift.comment_ref());
+  toThrift(proto.columnType, *thrift.columnType_ref());
+  toThrift(proto.requiredSubfields, *thrift.requiredSubfields_ref());
+}
+void fromThrift(
+    const IcebergColumnHandle& thrift,
+    facebook::presto::protocol::iceberg::IcebergColumnHandle& proto) {
+  fromThrift(*thrift.columnIdentity_ref(), proto.columnIdentity);
+  fromThrift(*thrift.type_ref(), proto.type);
+  fromThrift(thrift.comment_ref(), proto.comment);
+  fromThrift(*thrift.columnType_ref(), proto.columnType);
+  fromThrift(*thrift.requiredSubfields_ref(), proto.requiredSubfields);
+}
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::ChangelogSplitInfo& proto,
+    ChangelogSplitInfo& thrift) {
+  toThrift(proto.operation, *thrift.operation_ref());
+  toThrift(proto.ordinal, *thrift.ordinal_ref());
+  toThrift(proto.snapshotId, *thrift.snapshotId_ref());
+  toThrift(proto.icebergColumns, *thrift.icebergColumns_ref());
+}
+void fromThrift(
+    const ChangelogSplitInfo& thrift,
+    facebook::presto::protocol::iceberg::ChangelogSplitInfo& proto) {
+  fromThrift(*thrift.operation_ref(), proto.operation);
+  fromThrift(*thrift.ordinal_ref(), proto.ordinal);
+  fromThrift(*thrift.snapshotId_ref(), proto.snapshotId);
+  fromThrift(*thrift.icebergColumns_ref(), proto.icebergColumns);
+}
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::DeleteFile& proto,
+    DeleteFile& thrift) {
+  toThrift(proto.content, *thrift.content_ref());
+  toThrift(proto.path, *thrift.path_ref());
+  toThrift(proto.format, *thrift.format_ref());
+  toThrift(proto.recordCount, *thrift.recordCount_ref());
+  toThrift(proto.fileSizeInBytes, *thrift.fileSizeInBytes_ref());
+  toThrift(proto.equalityFieldIds, *thrift.equalityFieldIds_ref());
+  toThrift(proto.lowerBounds, *thrift.lowerBounds_ref());
+  toThrift(proto.upperBounds, *thrift.upperBounds_ref());
+}
+void fromThrift(
+    const DeleteFile& thrift,
+    facebook::presto::protocol::iceberg::DeleteFile& proto) {
+  fromThrift(*thrift.content_ref(), proto.content);
+  fromThrift(*thrift.path_ref(), proto.path);
+  fromThrift(*thrift.format_ref(), proto.format);
+  fromThrift(*thrift.recordCount_ref(), proto.recordCount);
+  fromThrift(*thrift.fileSizeInBytes_ref(), proto.fileSizeInBytes);
+  fromThrift(*thrift.equalityFieldIds_ref(), proto.equalityFieldIds);
+  fromThrift(*thrift.lowerBounds_ref(), proto.lowerBounds);
+  fromThrift(*thrift.upperBounds_ref(), proto.upperBounds);
+}
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::IcebergSplit& proto,
+    IcebergSplit& thrift) {
+  toThrift(proto.path, *thrift.path_ref());
+  toThrift(proto.start, *thrift.start_ref());
+  toThrift(proto.length, *thrift.length_ref());
+  toThrift(proto.fileFormat, *thrift.fileFormat_ref());
+  toThrift(proto.addresses, *thrift.addresses_ref());
+  toThrift(proto.partitionKeys, *thrift.partitionKeys_ref());
+  toThrift(proto.partitionSpecAsJson, *thrift.partitionSpecAsJson_ref());
+  toThrift(proto.partitionDataJson, thrift.partitionDataJson_ref());
+  toThrift(proto.nodeSelectionStrategy, *thrift.nodeSelectionStrategy_ref());
+  toThrift(proto.splitWeight, *thrift.splitWeight_ref());
+  toThrift(proto.deletes, *thrift.deletes_ref());
+  toThrift(proto.changelogSplitInfo, thrift.changelogSplitInfo_ref());
+  toThrift(proto.dataSequenceNumber, *thrift.dataSequenceNumber_ref());
+  toThrift(
+      proto.affinitySchedulingSectionSize,
+      *thrift.affinitySchedulingSectionSize_ref());
+}
+void fromThrift(
+    const IcebergSplit& thrift,
+    facebook::presto::protocol::iceberg::IcebergSplit& proto) {
+  fromThrift(*thrift.path_ref(), proto.path);
+  fromThrift(*thrift.start_ref(), proto.start);
+  fromThrift(*thrift.length_ref(), proto.length);
+  fromThrift(*thrift.fileFormat_ref(), proto.fileFormat);
+  fromThrift(*thrift.addresses_ref(), proto.addresses);
+  fromThrift(*thrift.partitionKeys_ref(), proto.partitionKeys);
+  fromThrift(*thrift.partitionSpecAsJson_ref(), proto.partitionSpecAsJson);
+  fromThrift(thrift.partitionDataJson_ref(), proto.partitionDataJson);
+  fromThrift(*thrift.nodeSelectionStrategy_ref(), proto.nodeSelectionStrategy);
+  fromThrift(*thrift.splitWeight_ref(), proto.splitWeight);
+  fromThrift(*thrift.deletes_ref(), proto.deletes);
+  fromThrift(thrift.changelogSplitInfo_ref(), proto.changelogSplitInfo);
+  fromThrift(*thrift.dataSequenceNumber_ref(), proto.dataSequenceNumber);
+  fromThrift(
+      *thrift.affinitySchedulingSectionSize_ref(),
+      proto.affinitySchedulingSectionSize);
+}
+
 } // namespace facebook::presto::thrift
@@ -17,6 +17,8 @@
 // This file is generated DO NOT EDIT @generated
 
 #include "presto_cpp/main/thrift/gen-cpp2/presto_thrift_types.h"
+#include "presto_cpp/presto_protocol/connector/hive/presto_protocol_hive.h"
+#include "presto_cpp/presto_protocol/connector/iceberg/presto_protocol_iceberg.h"
 #include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
 
 namespace facebook::presto::thrift {
@@ -595,4 +597,205 @@ void fromThrift(
     const TaskUpdateRequest& thrift,
     facebook::presto::protocol::TaskUpdateRequest& proto);
 
+void toThrift(
+    const facebook::presto::protocol::NodeSelectionStrategy& proto,
+    NodeSelectionStrategy& thrift);
+void fromThrift(
+    const NodeSelectionStrategy& thrift,
+    facebook::presto::protocol::NodeSelectionStrategy& proto);
+
+void toThrift(
+    const facebook::presto::protocol::CacheQuotaScope& proto,
+    CacheQuotaScope& thrift);
+void fromThrift(
+    const CacheQuotaScope& thrift,
+    facebook::presto::protocol::CacheQuotaScope& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::ColumnType& proto,
+    HiveColumnType& thrift);
+void fromThrift(
+    const HiveColumnType& thrift,
+    facebook::presto::protocol::hive::ColumnType& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::BucketFunctionType& proto,
+    BucketFunctionType& thrift);
+void fromThrift(
+    const BucketFunctionType& thrift,
+    facebook::presto::protocol::hive::BucketFunctionType& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::Order& proto,
+    Order& thrift);
+void fromThrift(
+    const Order& thrift,
+    facebook::presto::protocol::hive::Order& proto);
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::ChangelogOperation& proto,
+    ChangelogOperation& thrift);
+void fromThrift(
+    const ChangelogOperation& thrift,
+    facebook::presto::protocol::iceberg::ChangelogOperation& proto);
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::TypeCategory& proto,
+    TypeCategory& thrift);
+void fromThrift(
+    const TypeCategory& thrift,
+    facebook::presto::protocol::iceberg::TypeCategory& proto);
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::FileContent& proto,
+    IcebergFileContent& thrift);
+void fromThrift(
+    const IcebergFileContent& thrift,
+    facebook::presto::protocol::iceberg::FileContent& proto);
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::FileFormat& proto,
+    IcebergFileFormat& thrift);
+void fromThrift(
+    const IcebergFileFormat& thrift,
+    facebook::presto::protocol::iceberg::FileFormat& proto);
+
+void toThrift(const facebook::presto::protocol::Column& proto, Column& thrift);
+void fromThrift(
+    const Column& thrift,
+    facebook::presto::protocol::Column& proto);
+
+void toThrift(
+    const facebook::presto::protocol::CacheQuotaRequirement& proto,
+    CacheQuotaRequirement& thrift);
+void fromThrift(
+    const CacheQuotaRequirement& thrift,
+    facebook::presto::protocol::CacheQuotaRequirement& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::StorageFormat& proto,
+    StorageFormat& thrift);
+void fromThrift(
+    const StorageFormat& thrift,
+    facebook::presto::protocol::hive::StorageFormat& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::SortingColumn& proto,
+    SortingColumn& thrift);
+void fromThrift(
+    const SortingColumn& thrift,
+    facebook::presto::protocol::hive::SortingColumn& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::HiveBucketProperty& proto,
+    HiveBucketProperty& thrift);
+void fromThrift(
+    const HiveBucketProperty& thrift,
+    facebook::presto::protocol::hive::HiveBucketProperty& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::Storage& proto,
+    Storage& thrift);
+void fromThrift(
+    const Storage& thrift,
+    facebook::presto::protocol::hive::Storage& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::HiveFileSplit& proto,
+    HiveFileSplit& thrift);
+void fromThrift(
+    const HiveFileSplit& thrift,
+    facebook::presto::protocol::hive::HiveFileSplit& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::HivePartitionKey& proto,
+    HivePartitionKey& thrift);
+void fromThrift(
+    const HivePartitionKey& thrift,
+    facebook::presto::protocol::hive::HivePartitionKey& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::TableToPartitionMapping& proto,
+    TableToPartitionMapping& thrift);
+void fromThrift(
+    const TableToPartitionMapping& thrift,
+    facebook::presto::protocol::hive::TableToPartitionMapping& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::DwrfEncryptionMetadata& proto,
+    DwrfEncryptionMetadata& thrift);
+void fromThrift(
+    const DwrfEncryptionMetadata& thrift,
+    facebook::presto::protocol::hive::DwrfEncryptionMetadata& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::EncryptionInformation& proto,
+    EncryptionInformation& thrift);
+void fromThrift(
+    const EncryptionInformation& thrift,
+    facebook::presto::protocol::hive::EncryptionInformation& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::HiveColumnHandle& proto,
+    HiveColumnHandle& thrift);
+void fromThrift(
+    const HiveColumnHandle& thrift,
+    facebook::presto::protocol::hive::HiveColumnHandle& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::BucketConversion& proto,
+    BucketConversion& thrift);
+void fromThrift(
+    const BucketConversion& thrift,
+    facebook::presto::protocol::hive::BucketConversion& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::HiveSplit& proto,
+    HiveSplit& thrift);
+void fromThrift(
+    const HiveSplit& thrift,
+    facebook::presto::protocol::hive::HiveSplit& proto);
+
+void toThrift(
+    const facebook::presto::protocol::hive::HiveTransactionHandle& proto,
+    HiveTransactionHandle& thrift);
+void fromThrift(
+    const HiveTransactionHandle& thrift,
+    facebook::presto::protocol::hive::HiveTransactionHandle& proto);
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::ColumnIdentity& proto,
+    ColumnIdentity& thrift);
+void fromThrift(
+    const ColumnIdentity& thrift,
+    facebook::presto::protocol::iceberg::ColumnIdentity& proto);
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::IcebergColumnHandle& proto,
+    IcebergColumnHandle& thrift);
+void fromThrift(
+    const IcebergColumnHandle& thrift,
+    facebook::presto::protocol::iceberg::IcebergColumnHandle& proto);
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::ChangelogSplitInfo& proto,
+    ChangelogSplitInfo& thrift);
+void fromThrift(
+    const ChangelogSplitInfo& thrift,
+    facebook::presto::protocol::iceberg::ChangelogSplitInfo& proto);
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::DeleteFile& proto,
+    DeleteFile& thrift);
+void fromThrift(
+    const DeleteFile& thrift,
+    facebook::presto::protocol::iceberg::DeleteFile& proto);
+
+void toThrift(
+    const facebook::presto::protocol::iceberg::IcebergSplit& proto,
+    IcebergSplit& thrift);
+void fromThrift(
+    const IcebergSplit& thrift,
+    facebook::presto::protocol::iceberg::IcebergSplit& proto);
+
 } // namespace facebook::presto::thrift
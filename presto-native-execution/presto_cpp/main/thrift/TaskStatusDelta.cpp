@@ -0,0 +1,156 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/thrift/TaskStatusDelta.h"
+
+namespace facebook::presto::thrift {
+namespace {
+
+template <typename TBase, typename TCurrent, typename TDelta>
+void setIfChanged(const TBase& base, const TCurrent& current, TDelta delta) {
+  if (*base != *current) {
+    delta = *current;
+  }
+}
+
+template <typename TDelta, typename TField>
+void applyIfSet(const TDelta& delta, TField field) {
+  if (delta.has_value()) {
+    field = *delta;
+  }
+}
+
+} // namespace
+
+bool makeTaskStatusDelta(
+    const TaskStatus& base,
+    const TaskStatus& current,
+    TaskStatusDelta& delta) {
+  if (*current.version_ref() < *base.version_ref()) {
+    return false;
+  }
+  // Failures and completed driver groups are list and set valued; any
+  // change to them is rare and coincides with interesting state changes,
+  // so it is delivered as a full snapshot rather than encoded in a delta.
+  if (!current.failures_ref()->empty() || !base.failures_ref()->empty() ||
+      *current.completedDriverGroups_ref() !=
+          *base.completedDriverGroups_ref()) {
+    return false;
+  }
+
+  delta.version_ref() = *current.version_ref();
+  delta.baseVersion_ref() = *base.version_ref();
+  if (*base.state_ref() != *current.state_ref()) {
+    delta.state_ref() = static_cast<int32_t>(*current.state_ref());
+  }
+  setIfChanged(
+      base.queuedPartitionedDrivers_ref(),
+      current.queuedPartitionedDrivers_ref(),
+      delta.queuedPartitionedDrivers_ref());
+  setIfChanged(
+      base.runningPartitionedDrivers_ref(),
+      current.runningPartitionedDrivers_ref(),
+      delta.runningPartitionedDrivers_ref());
+  setIfChanged(
+      base.outputBufferUtilization_ref(),
+      current.outputBufferUtilization_ref(),
+      delta.outputBufferUtilization_ref());
+  setIfChanged(
+      base.outputBufferOverutilized_ref(),
+      current.outputBufferOverutilized_ref(),
+      delta.outputBufferOverutilized_ref());
+  setIfChanged(
+      base.physicalWrittenDataSizeInBytes_ref(),
+      current.physicalWrittenDataSizeInBytes_ref(),
+      delta.physicalWrittenDataSizeInBytes_ref());
+  setIfChanged(
+      base.memoryReservationInBytes_ref(),
+      current.memoryReservationInBytes_ref(),
+      delta.memoryReservationInBytes_ref());
+  setIfChanged(
+      base.systemMemoryReservationInBytes_ref(),
+      current.systemMemoryReservationInBytes_ref(),
+      delta.systemMemoryReservationInBytes_ref());
+  setIfChanged(
+      base.fullGcCount_ref(),
+      current.fullGcCount_ref(),
+      delta.fullGcCount_ref());
+  setIfChanged(
+      base.fullGcTimeInMillis_ref(),
+      current.fullGcTimeInMillis_ref(),
+      delta.fullGcTimeInMillis_ref());
+  setIfChanged(
+      base.peakNodeTotalMemoryReservationInBytes_ref(),
+      current.peakNodeTotalMemoryReservationInBytes_ref(),
+      delta.peakNodeTotalMemoryReservationInBytes_ref());
+  setIfChanged(
+      base.totalCpuTimeInNanos_ref(),
+      current.totalCpuTimeInNanos_ref(),
+      delta.totalCpuTimeInNanos_ref());
+  setIfChanged(
+      base.taskAgeInMillis_ref(),
+      current.taskAgeInMillis_ref(),
+      delta.taskAgeInMillis_ref());
+  setIfChanged(
+      base.queuedPartitionedSplitsWeight_ref(),
+      current.queuedPartitionedSplitsWeight_ref(),
+      delta.queuedPartitionedSplitsWeight_ref());
+  setIfChanged(
+      base.runningPartitionedSplitsWeight_ref(),
+      current.runningPartitionedSplitsWeight_ref(),
+      delta.runningPartitionedSplitsWeight_ref());
+  return true;
+}
+
+void applyTaskStatusDelta(const TaskStatusDelta& delta, TaskStatus& status) {
+  status.version_ref() = *delta.version_ref();
+  if (delta.state_ref().has_value()) {
+    status.state_ref() = static_cast<TaskState>(*delta.state_ref());
+  }
+  applyIfSet(
+      delta.queuedPartitionedDrivers_ref(),
+      status.queuedPartitionedDrivers_ref());
+  applyIfSet(
+      delta.runningPartitionedDrivers_ref(),
+      status.runningPartitionedDrivers_ref());
+  applyIfSet(
+      delta.outputBufferUtilization_ref(),
+      status.outputBufferUtilization_ref());
+  applyIfSet(
+      delta.outputBufferOverutilized_ref(),
+      status.outputBufferOverutilized_ref());
+  applyIfSet(
+      delta.physicalWrittenDataSizeInBytes_ref(),
+      status.physicalWrittenDataSizeInBytes_ref());
+  applyIfSet(
+      delta.memoryReservationInBytes_ref(),
+      status.memoryReservationInBytes_ref());
+  applyIfSet(
+      delta.systemMemoryReservationInBytes_ref(),
+      status.systemMemoryReservationInBytes_ref());
+  applyIfSet(delta.fullGcCount_ref(), status.fullGcCount_ref());
+  applyIfSet(delta.fullGcTimeInMillis_ref(), status.fullGcTimeInMillis_ref());
+  applyIfSet(
+      delta.peakNodeTotalMemoryReservationInBytes_ref(),
+      status.peakNodeTotalMemoryReservationInBytes_ref());
+  applyIfSet(delta.totalCpuTimeInNanos_ref(), status.totalCpuTimeInNanos_ref());
+  applyIfSet(delta.taskAgeInMillis_ref(), status.taskAgeInMillis_ref());
+  applyIfSet(
+      delta.queuedPartitionedSplitsWeight_ref(),
+      status.queuedPartitionedSplitsWeight_ref());
+  applyIfSet(
+      delta.runningPartitionedSplitsWeight_ref(),
+      status.runningPartitionedSplitsWeight_ref());
+}
+
+} // namespace facebook::presto::thrift
@@ -0,0 +1,36 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "presto_cpp/main/thrift/gen-cpp2/presto_native_types.h"
+#include "presto_cpp/main/thrift/gen-cpp2/presto_thrift_types.h"
+
+namespace facebook::presto::thrift {
+
+/// Fills 'delta' with the fields of 'current' that differ from 'base',
+/// tagged with both versions. An unchanged status produces a delta with no
+/// optional fields set, which is the common result of a long poll timing
+/// out. Returns false when the change cannot be represented as a delta -
+/// the version regressed, or failures or completed driver groups changed -
+/// in which case the caller must send a full snapshot.
+bool makeTaskStatusDelta(
+    const TaskStatus& base,
+    const TaskStatus& current,
+    TaskStatusDelta& delta);
+
+/// Applies 'delta' on top of 'status', which must hold the version the
+/// delta was computed against.
+void applyTaskStatusDelta(const TaskStatusDelta& delta, TaskStatus& status);
+
+} // namespace facebook::presto::thrift
@@ -13,8 +13,27 @@
  */
 #pragma once
 
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+#include <folly/io/IOBufQueue.h>
 #include <thrift/lib/cpp2/protocol/BinaryProtocol.h>
 
+namespace thrift_detail {
+
+// Large enough for a typical TaskStatus; bigger messages chain additional
+// buffers and only the scratch head is kept for reuse.
+constexpr size_t kScratchCapacity = 64 * 1024;
+
+// Per-thread scratch buffer reused across serializations. Thrift-mode status
+// serving serializes thousands of TaskStatus-sized messages per second, and
+// a fresh buffer chain per message makes the allocator the bottleneck.
+inline std::unique_ptr<folly::IOBuf>& scratchBuffer() {
+  thread_local std::unique_ptr<folly::IOBuf> buffer;
+  return buffer;
+}
+
+} // namespace thrift_detail
+
 template <typename T>
 void thriftRead(const std::string& data, std::shared_ptr<T>& buffer) {
   auto inBuf = folly::IOBuf::wrapBuffer(data.data(), data.size());
@@ -34,5 +53,28 @@ std::unique_ptr<folly::IOBuf> thriftWriteIOBuf(T& data) {
 
 template <typename T>
 std::string thriftWrite(T& data) {
-  return thriftWriteIOBuf(data)->moveToFbString().toStdString();
+  // Serialize into the thread's scratch buffer: the common message fits in
+  // its tailroom, so the only allocation left is the returned string itself.
+  auto& scratch = thrift_detail::scratchBuffer();
+  if (scratch == nullptr) {
+    scratch = folly::IOBuf::create(thrift_detail::kScratchCapacity);
+  }
+  scratch->clear();
+  folly::IOBufQueue outQueue;
+  outQueue.append(std::move(scratch));
+  apache::thrift::BinaryProtocolWriter writer;
+  writer.setOutput(&outQueue);
+  data.write(&writer);
+
+  auto chain = outQueue.move();
+  std::string out;
+  out.resize(chain->computeChainDataLength());
+  folly::io::Cursor cursor(chain.get());
+  cursor.pull(out.data(), out.size());
+
+  // Reclaim the scratch head for the next serialization on this thread;
+  // buffers chained behind it by an oversized message are dropped.
+  chain->pop();
+  scratch = std::move(chain);
+  return out;
 }
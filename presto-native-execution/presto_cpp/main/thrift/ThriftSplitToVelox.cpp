@@ -0,0 +1,235 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/thrift/ThriftSplitToVelox.h"
+
+#include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/connectors/HiveFileMetadataCache.h"
+#include "presto_cpp/main/connectors/IcebergDeleteFileCache.h"
+#include "presto_cpp/main/connectors/PrestoToVeloxConnectorUtils.h"
+#include "presto_cpp/main/types/TypeParser.h"
+#include "presto_cpp/presto_protocol/Base64Util.h"
+#include "presto_cpp/presto_protocol/connector/hive/presto_protocol_hive.h"
+
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/IcebergSplit.h"
+#include "velox/type/fbhive/HiveTypeParser.h"
+
+namespace facebook::presto::thrift {
+namespace {
+
+// Thrift enum values follow the declaration order of the corresponding
+// protocol enums, so the mapping is a cast; the generated conversions rely
+// on the same invariant.
+velox::connector::hive::iceberg::FileContent toVeloxFileContent(
+    IcebergFileContent content) {
+  if (content == IcebergFileContent::DATA) {
+    return velox::connector::hive::iceberg::FileContent::kData;
+  } else if (content == IcebergFileContent::POSITION_DELETES) {
+    return velox::connector::hive::iceberg::FileContent::kPositionalDeletes;
+  }
+  VELOX_UNSUPPORTED("Unsupported file content: {}", fmt::underlying(content));
+}
+
+velox::dwio::common::FileFormat toVeloxIcebergFileFormat(
+    IcebergFileFormat format) {
+  if (format == IcebergFileFormat::ORC) {
+    return velox::dwio::common::FileFormat::ORC;
+  } else if (format == IcebergFileFormat::PARQUET) {
+    return velox::dwio::common::FileFormat::PARQUET;
+  }
+  VELOX_UNSUPPORTED("Unsupported file format: {}", fmt::underlying(format));
+}
+
+velox::connector::hive::iceberg::IcebergDeleteFile toVeloxDeleteFile(
+    const DeleteFile& deleteFile) {
+  std::unordered_map<int32_t, std::string> lowerBounds(
+      deleteFile.lowerBounds()->begin(), deleteFile.lowerBounds()->end());
+
+  std::unordered_map<int32_t, std::string> upperBounds(
+      deleteFile.upperBounds()->begin(), deleteFile.upperBounds()->end());
+
+  return velox::connector::hive::iceberg::IcebergDeleteFile(
+      toVeloxFileContent(*deleteFile.content()),
+      *deleteFile.path(),
+      toVeloxIcebergFileFormat(*deleteFile.format()),
+      *deleteFile.recordCount(),
+      *deleteFile.fileSizeInBytes(),
+      std::vector<int32_t>(
+          deleteFile.equalityFieldIds()->begin(),
+          deleteFile.equalityFieldIds()->end()),
+      lowerBounds,
+      upperBounds);
+}
+
+velox::connector::hive::HiveBucketConversion toVeloxBucketConversion(
+    const BucketConversion& bucketConversion) {
+  velox::connector::hive::HiveBucketConversion veloxBucketConversion;
+  veloxBucketConversion.tableBucketCount = *bucketConversion.tableBucketCount();
+  veloxBucketConversion.partitionBucketCount =
+      *bucketConversion.partitionBucketCount();
+  TypeParser typeParser;
+  velox::type::fbhive::HiveTypeParser hiveTypeParser;
+  for (const auto& column : *bucketConversion.bucketColumnHandles()) {
+    std::vector<velox::common::Subfield> requiredSubfields;
+    requiredSubfields.reserve(column.requiredSubfields()->size());
+    for (const auto& subfield : *column.requiredSubfields()) {
+      requiredSubfields.emplace_back(subfield);
+    }
+    veloxBucketConversion.bucketColumnHandles.push_back(
+        std::make_unique<velox::connector::hive::HiveColumnHandle>(
+            *column.name(),
+            toHiveColumnType(static_cast<protocol::hive::ColumnType>(
+                static_cast<int>(*column.columnType()))),
+            stringToType(*column.typeSignature()->signature(), typeParser),
+            hiveTypeParser.parse(*column.hiveType()),
+            std::move(requiredSubfields)));
+  }
+  return veloxBucketConversion;
+}
+
+} // namespace
+
+std::unique_ptr<velox::connector::ConnectorSplit> toVeloxHiveSplit(
+    const HiveSplit& split,
+    const protocol::ConnectorId& catalogId,
+    const protocol::SplitContext& splitContext) {
+  const auto& fileSplit = *split.fileSplit();
+  std::unordered_map<std::string, std::optional<std::string>> partitionKeys;
+  for (const auto& entry : *split.partitionKeys()) {
+    partitionKeys.emplace(
+        *entry.name(),
+        entry.value().has_value()
+            ? std::optional<std::string>{*entry.value()}
+            : std::nullopt);
+  }
+  std::unordered_map<std::string, std::string> customSplitInfo(
+      fileSplit.customSplitInfo()->begin(), fileSplit.customSplitInfo()->end());
+  std::shared_ptr<std::string> extraFileInfo;
+  if (fileSplit.extraFileInfo().has_value()) {
+    // Splits of concurrent tasks frequently target the same files; share one
+    // decoded metadata blob per file through the worker-level cache instead
+    // of decoding a private copy per split.
+    const auto metadataCacheMaxBytes =
+        SystemConfig::instance()->hiveFileMetadataCacheMaxBytes();
+    if (metadataCacheMaxBytes > 0) {
+      extraFileInfo = HiveFileMetadataCache::instance()->getOrDecode(
+          *fileSplit.path(),
+          *fileSplit.fileModifiedTime(),
+          *fileSplit.fileSize(),
+          *fileSplit.extraFileInfo(),
+          metadataCacheMaxBytes);
+    } else {
+      extraFileInfo = std::make_shared<std::string>(
+          protocol::decodeBase64(*fileSplit.extraFileInfo()));
+    }
+  }
+  const auto& storage = *split.storage();
+  std::unordered_map<std::string, std::string> serdeParameters(
+      storage.serdeParameters()->begin(), storage.serdeParameters()->end());
+  std::unordered_map<std::string, std::string> infoColumns = {
+      {"$path", *fileSplit.path()},
+      {"$file_size", std::to_string(*fileSplit.fileSize())},
+      {"$file_modified_time", std::to_string(*fileSplit.fileModifiedTime())},
+  };
+  if (split.tableBucketNumber().has_value()) {
+    infoColumns["$bucket"] = std::to_string(*split.tableBucketNumber());
+  }
+  auto veloxSplit =
+      std::make_unique<velox::connector::hive::HiveConnectorSplit>(
+          catalogId,
+          *fileSplit.path(),
+          toVeloxFileFormat(
+              *storage.storageFormat()->inputFormat(),
+              *storage.storageFormat()->serDe()),
+          *fileSplit.start(),
+          *fileSplit.length(),
+          partitionKeys,
+          split.tableBucketNumber().has_value()
+              ? std::optional<int>(*split.tableBucketNumber())
+              : std::nullopt,
+          customSplitInfo,
+          extraFileInfo,
+          serdeParameters,
+          *split.splitWeight(),
+          splitContext.cacheable,
+          infoColumns);
+  // Pre-populate the file size and modification time the coordinator already
+  // knows, so the reader's file handle and footer caches can validate their
+  // entries without an extra filesystem metadata call.
+  veloxSplit->properties = velox::connector::hive::FileProperties{
+      *fileSplit.fileSize(), *fileSplit.fileModifiedTime()};
+  if (split.bucketConversion().has_value()) {
+    VELOX_CHECK(split.tableBucketNumber().has_value());
+    veloxSplit->bucketConversion =
+        toVeloxBucketConversion(*split.bucketConversion());
+  }
+  return veloxSplit;
+}
+
+std::unique_ptr<velox::connector::ConnectorSplit> toVeloxIcebergSplit(
+    const IcebergSplit& split,
+    const protocol::ConnectorId& catalogId,
+    const protocol::SplitContext& splitContext) {
+  std::unordered_map<std::string, std::optional<std::string>> partitionKeys;
+  for (const auto& entry : *split.partitionKeys()) {
+    partitionKeys.emplace(
+        *entry.second.name(),
+        entry.second.value().has_value()
+            ? std::optional<std::string>{*entry.second.value()}
+            : std::nullopt);
+  }
+
+  std::unordered_map<std::string, std::string> customSplitInfo;
+  customSplitInfo["table_format"] = "hive-iceberg";
+
+  std::vector<velox::connector::hive::iceberg::IcebergDeleteFile> deletes;
+  deletes.reserve(split.deletes()->size());
+  // On merge-on-read tables many data splits reference the same delete
+  // files; share one converted descriptor per file through the worker-level
+  // cache instead of rebuilding it per split.
+  const auto deleteFileCacheMaxBytes =
+      SystemConfig::instance()->icebergDeleteFileCacheMaxBytes();
+  for (const auto& deleteFile : *split.deletes()) {
+    if (deleteFileCacheMaxBytes > 0) {
+      deletes.emplace_back(*IcebergDeleteFileCache::instance()->getOrConvert(
+          *deleteFile.path(),
+          *deleteFile.recordCount(),
+          *deleteFile.fileSizeInBytes(),
+          [&]() { return toVeloxDeleteFile(deleteFile); },
+          deleteFileCacheMaxBytes));
+    } else {
+      deletes.emplace_back(toVeloxDeleteFile(deleteFile));
+    }
+  }
+
+  std::unordered_map<std::string, std::string> infoColumns = {
+      {"$data_sequence_number", std::to_string(*split.dataSequenceNumber())},
+      {"$path", *split.path()}};
+
+  return std::make_unique<velox::connector::hive::iceberg::HiveIcebergSplit>(
+      catalogId,
+      *split.path(),
+      toVeloxIcebergFileFormat(*split.fileFormat()),
+      *split.start(),
+      *split.length(),
+      partitionKeys,
+      std::nullopt,
+      customSplitInfo,
+      nullptr,
+      splitContext.cacheable,
+      deletes,
+      infoColumns);
+}
+
+} // namespace facebook::presto::thrift
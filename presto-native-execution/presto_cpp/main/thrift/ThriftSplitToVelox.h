@@ -0,0 +1,38 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "presto_cpp/main/thrift/gen-cpp2/presto_thrift_types.h"
+#include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
+#include "velox/connectors/Connector.h"
+
+namespace facebook::presto::thrift {
+
+/// Direct Thrift-to-velox split converters, used when
+/// 'task.thrift-direct-split-conversion-enabled' is set. They mirror the
+/// protocol-struct based conversions in HivePrestoToVeloxConnector and
+/// IcebergPrestoToVeloxConnector but read the decoded Thrift payload
+/// directly, so no intermediate protocol struct tree is allocated per
+/// split.
+std::unique_ptr<velox::connector::ConnectorSplit> toVeloxHiveSplit(
+    const HiveSplit& split,
+    const protocol::ConnectorId& catalogId,
+    const protocol::SplitContext& splitContext);
+
+std::unique_ptr<velox::connector::ConnectorSplit> toVeloxIcebergSplit(
+    const IcebergSplit& split,
+    const protocol::ConnectorId& catalogId,
+    const protocol::SplitContext& splitContext);
+
+} // namespace facebook::presto::thrift
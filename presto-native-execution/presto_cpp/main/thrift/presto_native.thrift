@@ -17,3 +17,33 @@ namespace cpp2 facebook.presto.thrift
 struct BroadcastFileFooter {
   1: list<i64> pageSizes;
 }
+
+// Changed-fields-only frame for TaskStatus polls. A consumer that reports
+// the version of the status it already holds receives this instead of the
+// full struct when only counters changed; an optional field is set only
+// when its value differs from the base version. Failures and completed
+// driver groups are never carried in a delta: any change to them forces a
+// full snapshot.
+struct TaskStatusDelta {
+  // Version of the full status reproduced by applying this delta.
+  1: i64 version;
+  // Version of the snapshot the delta was computed against; it must be
+  // applied to exactly this version.
+  2: i64 baseVersion;
+  // TaskState enum value.
+  3: optional i32 state;
+  4: optional i32 queuedPartitionedDrivers;
+  5: optional i32 runningPartitionedDrivers;
+  6: optional double outputBufferUtilization;
+  7: optional bool outputBufferOverutilized;
+  8: optional i64 physicalWrittenDataSizeInBytes;
+  9: optional i64 memoryReservationInBytes;
+  10: optional i64 systemMemoryReservationInBytes;
+  11: optional i64 fullGcCount;
+  12: optional i64 fullGcTimeInMillis;
+  13: optional i64 peakNodeTotalMemoryReservationInBytes;
+  14: optional i64 totalCpuTimeInNanos;
+  15: optional i64 taskAgeInMillis;
+  16: optional i64 queuedPartitionedSplitsWeight;
+  17: optional i64 runningPartitionedSplitsWeight;
+}
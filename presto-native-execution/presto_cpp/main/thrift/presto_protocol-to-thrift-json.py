@@ -35,7 +35,13 @@ def parse_args():
         help="config file",
     )
     parser.add_argument("thrift", help="Thrift spec as JSON")
-    parser.add_argument("protocol", help="Presto protocol spec as JSON")
+    parser.add_argument(
+        "protocol",
+        nargs="+",
+        help="Presto protocol specs as JSON, either 'file' for the core spec "
+        "or 'namespace:file' for a connector spec whose types live in a "
+        "sub-namespace of facebook::presto::protocol (e.g. 'hive:...')",
+    )
 
     return parser.parse_args()
 
@@ -91,12 +97,23 @@ def main():
     args = parse_args()
     config = util.load_yaml(args.config)
     thrift = util.load_yaml(args.thrift)
-    protocol = util.load_yaml(args.protocol)
 
+    # Map protocol class names to their items and to the protocol
+    # sub-namespace they live in. The first spec defining a name wins, so the
+    # core spec should be passed before the connector specs.
     pmap = {}
-    for item in protocol:
-        if "class_name" in item:
-            pmap[item.class_name] = item
+    pns = {}
+    for spec in args.protocol:
+        (namespace, _, filename) = spec.rpartition(":")
+        for item in util.load_yaml(filename):
+            if "class_name" in item and item.class_name not in pmap:
+                pmap[item.class_name] = item
+                pns[item.class_name] = namespace
+
+    def qualified(class_name):
+        if pns.get(class_name):
+            return pns[class_name] + "::" + class_name
+        return class_name
 
     comment = "// This file is generated DO NOT EDIT @" + "generated"
     result = [{"comment": comment}]
@@ -158,14 +175,14 @@ def main():
                 if thrift_item.class_name in pmap
                 else pmap[config.StructMap[thrift_item.class_name].class_name]
             )
-            thrift_item["proto_name"] = protocol_item.class_name
+            thrift_item["proto_name"] = qualified(protocol_item.class_name)
 
             config_item = None
             if "struct" in thrift_item:
                 # For structs that have different field names in cpp and IDL
                 if thrift_item.class_name in config.StructMap:
                     config_item = config.StructMap[thrift_item.class_name]
-                    thrift_item["proto_name"] = config_item.class_name
+                    thrift_item["proto_name"] = qualified(config_item.class_name)
 
                 process_fields(thrift_item, config_item)
 
@@ -705,6 +705,200 @@ struct TaskUpdateRequest {
   6: optional TableWriteInfo tableWriteInfo;
 }
 
+// Connector protocol payloads carried in ConnectorSplit.customSerializedValue
+// and ConnectorTransactionHandle.customSerializedValue for the hive and
+// iceberg connectors. Field ids follow the declaration order of the
+// corresponding presto_protocol structs.
+enum NodeSelectionStrategy {
+  HARD_AFFINITY = 0,
+  SOFT_AFFINITY = 1,
+  NO_PREFERENCE = 2,
+}
+enum CacheQuotaScope {
+  GLOBAL = 0,
+  SCHEMA = 1,
+  TABLE = 2,
+  PARTITION = 3,
+}
+enum HiveColumnType {
+  PARTITION_KEY = 0,
+  REGULAR = 1,
+  SYNTHESIZED = 2,
+  AGGREGATED = 3,
+}
+enum BucketFunctionType {
+  HIVE_COMPATIBLE = 0,
+  PRESTO_NATIVE = 1,
+}
+enum Order {
+  ASCENDING = 0,
+  DESCENDING = 1,
+}
+enum ChangelogOperation {
+  INSERT = 0,
+  DELETE = 1,
+  UPDATE_BEFORE = 2,
+  UPDATE_AFTER = 3,
+}
+enum TypeCategory {
+  PRIMITIVE = 0,
+  STRUCT = 1,
+  ARRAY = 2,
+  MAP = 3,
+}
+enum IcebergFileContent {
+  DATA = 0,
+  POSITION_DELETES = 1,
+  EQUALITY_DELETES = 2,
+}
+enum IcebergFileFormat {
+  ORC = 0,
+  PARQUET = 1,
+  AVRO = 2,
+  METADATA = 3,
+}
+struct Column {
+  1: string name;
+  2: string type;
+}
+struct CacheQuotaRequirement {
+  1: CacheQuotaScope cacheQuotaScope;
+  2: optional double quota;
+}
+struct StorageFormat {
+  1: string serDe;
+  2: string inputFormat;
+  3: string outputFormat;
+}
+struct SortingColumn {
+  1: string columnName;
+  2: Order order;
+}
+struct HiveBucketProperty {
+  1: list<string> bucketedBy;
+  2: i32 bucketCount;
+  3: list<SortingColumn> sortedBy;
+  4: BucketFunctionType bucketFunctionType;
+  5: optional list<string> types;
+}
+struct Storage {
+  1: StorageFormat storageFormat;
+  2: string location;
+  3: optional HiveBucketProperty bucketProperty;
+  4: bool skewed;
+  5: map<string, string> serdeParameters;
+  6: map<string, string> parameters;
+}
+struct HiveFileSplit {
+  1: string path;
+  2: i64 start;
+  3: i64 length;
+  4: i64 fileSize;
+  5: i64 fileModifiedTime;
+  6: optional string extraFileInfo;
+  7: map<string, string> customSplitInfo;
+  8: i64 affinitySchedulingFileSectionIndex;
+}
+struct HivePartitionKey {
+  1: string name;
+  2: optional string value;
+}
+struct TableToPartitionMapping {
+  1: optional map<i32, i32> tableToPartitionColumns;
+  2: map<i32, Column> partitionSchemaDifference;
+}
+struct DwrfEncryptionMetadata {
+  1: map<string, string> fieldToKeyData;
+  2: map<string, string> extraMetadata;
+  3: string encryptionAlgorithm;
+  4: string encryptionProvider;
+}
+struct EncryptionInformation {
+  1: optional DwrfEncryptionMetadata dwrfEncryptionMetadata;
+}
+struct HiveColumnHandle {
+  1: string name;
+  2: string hiveType;
+  3: TypeSignature typeSignature;
+  4: i32 hiveColumnIndex;
+  5: HiveColumnType columnType;
+  6: optional string comment;
+  7: list<string> requiredSubfields;
+}
+struct BucketConversion {
+  1: i32 tableBucketCount;
+  2: i32 partitionBucketCount;
+  3: list<HiveColumnHandle> bucketColumnHandles;
+}
+struct HiveSplit {
+  1: HiveFileSplit fileSplit;
+  2: string database;
+  3: string table;
+  4: string partitionName;
+  5: Storage storage;
+  6: list<HivePartitionKey> partitionKeys;
+  7: list<HostAddress> addresses;
+  8: optional i32 readBucketNumber;
+  9: optional i32 tableBucketNumber;
+  10: NodeSelectionStrategy nodeSelectionStrategy;
+  11: i32 partitionDataColumnCount;
+  12: TableToPartitionMapping tableToPartitionMapping;
+  13: optional BucketConversion bucketConversion;
+  14: bool s3SelectPushdownEnabled;
+  15: CacheQuotaRequirement cacheQuota;
+  16: optional EncryptionInformation encryptionMetadata;
+  17: i64 splitWeight;
+  18: optional string rowIdPartitionComponent;
+}
+struct HiveTransactionHandle {
+  1: string uuid;
+}
+struct ColumnIdentity {
+  1: i32 id;
+  2: string name;
+  3: TypeCategory typeCategory;
+  4: list<ColumnIdentity> children;
+}
+struct IcebergColumnHandle {
+  1: ColumnIdentity columnIdentity;
+  2: string type;
+  3: optional string comment;
+  4: HiveColumnType columnType;
+  5: list<string> requiredSubfields;
+}
+struct ChangelogSplitInfo {
+  1: ChangelogOperation operation;
+  2: i64 ordinal;
+  3: i64 snapshotId;
+  4: list<IcebergColumnHandle> icebergColumns;
+}
+struct DeleteFile {
+  1: IcebergFileContent content;
+  2: string path;
+  3: IcebergFileFormat format;
+  4: i64 recordCount;
+  5: i64 fileSizeInBytes;
+  6: list<i32> equalityFieldIds;
+  7: map<i32, string> lowerBounds;
+  8: map<i32, string> upperBounds;
+}
+struct IcebergSplit {
+  1: string path;
+  2: i64 start;
+  3: i64 length;
+  4: IcebergFileFormat fileFormat;
+  5: list<HostAddress> addresses;
+  6: map<i32, HivePartitionKey> partitionKeys;
+  7: string partitionSpecAsJson;
+  8: optional string partitionDataJson;
+  9: NodeSelectionStrategy nodeSelectionStrategy;
+  10: i64 splitWeight;
+  11: list<DeleteFile> deletes;
+  12: optional ChangelogSplitInfo changelogSplitInfo;
+  13: i64 dataSequenceNumber;
+  14: i64 affinitySchedulingSectionSize;
+}
+
 service PrestoThrift {
   void fake();
 }
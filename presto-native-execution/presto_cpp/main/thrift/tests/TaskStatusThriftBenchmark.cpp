@@ -0,0 +1,85 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "presto_cpp/main/thrift/ProtocolToThrift.h"
+#include "presto_cpp/main/thrift/ThriftIO.h"
+
+namespace facebook::presto {
+namespace {
+
+// Builds a protocol task status representative of a running task polled by
+// the coordinator: no failures, a handful of completed driver groups.
+protocol::TaskStatus makeTaskStatus() {
+  protocol::TaskStatus status;
+  status.taskId = "20260831_123456_00001_abcde.1.0.2.0";
+  status.taskInstanceIdLeastSignificantBits = 123456789;
+  status.taskInstanceIdMostSignificantBits = 987654321;
+  status.version = 42;
+  status.state = protocol::TaskState::RUNNING;
+  status.self = "http://127.0.0.1:7777/v1/task/20260831_123456_00001_abcde.1.0.2.0";
+  for (int i = 0; i < 16; ++i) {
+    status.completedDriverGroups.push_back({true, i});
+  }
+  status.queuedPartitionedDrivers = 10;
+  status.runningPartitionedDrivers = 5;
+  status.queuedPartitionedSplitsWeight = 1000;
+  status.runningPartitionedSplitsWeight = 500;
+  status.outputBufferUtilization = 0.5;
+  status.outputBufferOverutilized = false;
+  status.physicalWrittenDataSizeInBytes = 1'000'000;
+  status.memoryReservationInBytes = 64LL << 20;
+  status.systemMemoryReservationInBytes = 0;
+  status.peakNodeTotalMemoryReservationInBytes = 128LL << 20;
+  return status;
+}
+
+const protocol::TaskStatus& taskStatus() {
+  static const protocol::TaskStatus status = makeTaskStatus();
+  return status;
+}
+
+// The previous getTaskStatus Thrift path: the protocol status is copied out
+// of the task, converted to Thrift and then serialized.
+BENCHMARK(taskStatusViaProtocolCopy, n) {
+  for (unsigned i = 0; i < n; ++i) {
+    auto protocolStatus =
+        std::make_unique<protocol::TaskStatus>(taskStatus());
+    thrift::TaskStatus thriftStatus;
+    thrift::toThrift(*protocolStatus, thriftStatus);
+    auto wire = thriftWrite(thriftStatus);
+    folly::doNotOptimizeAway(wire);
+  }
+}
+
+// The getTaskStatusThrift path: the Thrift status is populated directly from
+// the task's persistent status and serialized, with no protocol copy.
+BENCHMARK_RELATIVE(taskStatusDirectThrift, n) {
+  for (unsigned i = 0; i < n; ++i) {
+    thrift::TaskStatus thriftStatus;
+    thrift::toThrift(taskStatus(), thriftStatus);
+    auto wire = thriftWrite(thriftStatus);
+    folly::doNotOptimizeAway(wire);
+  }
+}
+
+} // namespace
+} // namespace facebook::presto
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 #include <thrift/lib/cpp2/protocol/BinaryProtocol.h>
 #include "presto_cpp/main/thrift/ProtocolToThrift.h"
+#include "presto_cpp/main/thrift/TaskStatusDelta.h"
 #include "presto_cpp/main/thrift/gen-cpp2/presto_native_types.h"
 
 using namespace facebook::presto;
@@ -171,3 +172,87 @@ TEST_F(ThriftIOTest, thriftBroadcastFileFooterRoundTrip) {
   original.pageSizes_ref() = std::vector<int64_t>{0, -1, 100, 0, 50};
   testThriftRoundTrips(original);
 }
+
+TEST_F(ThriftIOTest, scratchBufferReuseAcrossSizes) {
+  // Exceeds the per-thread scratch capacity, so serialization chains extra
+  // buffers; the small message afterwards must still round trip off the
+  // reclaimed scratch head.
+  thrift::PlanNodeId large;
+  large.id_ref() = std::string(128 * 1024, 'y');
+  testThriftRoundTrips(large);
+
+  thrift::PlanNodeId small;
+  small.id_ref() = "small_after_large";
+  testThriftRoundTrips(small);
+}
+
+TEST_F(ThriftIOTest, taskStatusDeltaRoundTrip) {
+  thrift::TaskStatus base;
+  base.version_ref() = 7;
+  base.state_ref() = thrift::TaskState::RUNNING;
+  base.runningPartitionedDrivers_ref() = 4;
+  base.memoryReservationInBytes_ref() = 1 << 20;
+  base.totalCpuTimeInNanos_ref() = 1'000'000;
+
+  thrift::TaskStatus current = base;
+  current.version_ref() = 9;
+  current.runningPartitionedDrivers_ref() = 6;
+  current.memoryReservationInBytes_ref() = 2 << 20;
+  current.taskAgeInMillis_ref() = 1'500;
+
+  thrift::TaskStatusDelta delta;
+  ASSERT_TRUE(thrift::makeTaskStatusDelta(base, current, delta));
+  EXPECT_EQ(*delta.version_ref(), 9);
+  EXPECT_EQ(*delta.baseVersion_ref(), 7);
+  EXPECT_FALSE(delta.state_ref().has_value());
+  EXPECT_FALSE(delta.totalCpuTimeInNanos_ref().has_value());
+  EXPECT_TRUE(delta.runningPartitionedDrivers_ref().has_value());
+  testThriftRoundTrips(delta);
+
+  thrift::TaskStatus applied = base;
+  thrift::applyTaskStatusDelta(delta, applied);
+  EXPECT_EQ(applied, current);
+}
+
+TEST_F(ThriftIOTest, taskStatusDeltaUnchangedStatus) {
+  // A long poll that times out returns the same status; the delta carries
+  // only the version pair.
+  thrift::TaskStatus base;
+  base.version_ref() = 3;
+  base.state_ref() = thrift::TaskState::RUNNING;
+
+  thrift::TaskStatusDelta delta;
+  ASSERT_TRUE(thrift::makeTaskStatusDelta(base, base, delta));
+  EXPECT_EQ(*delta.version_ref(), 3);
+  EXPECT_FALSE(delta.runningPartitionedDrivers_ref().has_value());
+
+  thrift::TaskStatus applied = base;
+  thrift::applyTaskStatusDelta(delta, applied);
+  EXPECT_EQ(applied, base);
+}
+
+TEST_F(ThriftIOTest, taskStatusDeltaForcesFullSnapshot) {
+  thrift::TaskStatus base;
+  base.version_ref() = 5;
+
+  // Version regression cannot be expressed as a delta.
+  thrift::TaskStatus regressed = base;
+  regressed.version_ref() = 4;
+  thrift::TaskStatusDelta delta;
+  EXPECT_FALSE(thrift::makeTaskStatusDelta(base, regressed, delta));
+
+  // Failures are delivered via a full snapshot.
+  thrift::TaskStatus failed = base;
+  failed.version_ref() = 6;
+  failed.failures_ref()->emplace_back();
+  EXPECT_FALSE(thrift::makeTaskStatusDelta(base, failed, delta));
+
+  // So are completed driver group changes.
+  thrift::TaskStatus grouped = base;
+  grouped.version_ref() = 6;
+  thrift::Lifespan lifespan;
+  lifespan.grouped_ref() = true;
+  lifespan.groupId_ref() = 1;
+  grouped.completedDriverGroups_ref()->insert(lifespan);
+  EXPECT_FALSE(thrift::makeTaskStatusDelta(base, grouped, delta));
+}
@@ -0,0 +1,223 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/main/tool/advisor/ConfigAdvisor.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+#include <folly/String.h>
+#include <folly/json.h>
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::presto::tool {
+namespace {
+// Replaces every '{value}' in 'commandTemplate'.
+std::string substituteValue(
+    const std::string& commandTemplate,
+    const std::string& value) {
+  static const std::string kPlaceholder{"{value}"};
+  std::string command = commandTemplate;
+  size_t pos = 0;
+  while ((pos = command.find(kPlaceholder, pos)) != std::string::npos) {
+    command.replace(pos, kPlaceholder.size(), value);
+    pos += value.size();
+  }
+  return command;
+}
+
+double runThroughShell(const std::string& command) {
+  uint64_t wallNs{0};
+  int exitCode;
+  {
+    velox::NanosecondTimer timer(&wallNs);
+    // NOLINTNEXTLINE(cert-env33-c) The advisor exists to run the commands the
+    // sweep spec hands it; the spec is trusted operator input.
+    exitCode = std::system(command.c_str());
+  }
+  VELOX_USER_CHECK_EQ(
+      exitCode, 0, "Sweep command failed with {}: {}", exitCode, command);
+  return static_cast<double>(wallNs) / 1'000'000.0;
+}
+
+double median(std::vector<double>& samples) {
+  VELOX_CHECK(!samples.empty());
+  std::sort(samples.begin(), samples.end());
+  const auto mid = samples.size() / 2;
+  if (samples.size() % 2 == 1) {
+    return samples[mid];
+  }
+  return (samples[mid - 1] + samples[mid]) / 2;
+}
+} // namespace
+
+ConfigAdvisor::ConfigAdvisor(Options options) : options_(std::move(options)) {
+  VELOX_USER_CHECK_GT(options_.runsPerCandidate, 0);
+  VELOX_USER_CHECK_GE(options_.minImprovementPct, 0);
+}
+
+// static
+std::vector<ConfigSweep> ConfigAdvisor::parseSweepSpec(
+    const std::string& spec) {
+  folly::dynamic parsed;
+  try {
+    parsed = folly::parseJson(spec);
+  } catch (const std::exception& e) {
+    VELOX_USER_FAIL("Malformed sweep spec: {}", e.what());
+  }
+  const auto* sweepList = parsed.get_ptr("sweeps");
+  VELOX_USER_CHECK_NOT_NULL(sweepList, "Sweep spec has no 'sweeps' list");
+
+  std::vector<ConfigSweep> sweeps;
+  sweeps.reserve(sweepList->size());
+  for (const auto& entry : *sweepList) {
+    ConfigSweep sweep;
+    sweep.propertyName = entry["property"].asString();
+    sweep.baselineValue = entry["baseline"].asString();
+    sweep.commandTemplate = entry["command"].asString();
+    for (const auto& candidate : entry["candidates"]) {
+      sweep.candidateValues.push_back(candidate.asString());
+    }
+    VELOX_USER_CHECK(
+        !sweep.candidateValues.empty(),
+        "Sweep for '{}' has no candidate values",
+        sweep.propertyName);
+    sweeps.push_back(std::move(sweep));
+  }
+  return sweeps;
+}
+
+// static
+std::unordered_map<std::string, double> ConfigAdvisor::parsePrometheusDump(
+    const std::string& text) {
+  std::unordered_map<std::string, double> metrics;
+  std::istringstream input(text);
+  std::string line;
+  while (std::getline(input, line)) {
+    const auto trimmed =
+        folly::trimWhitespace(folly::StringPiece{line}).str();
+    if (trimmed.empty() || trimmed[0] == '#') {
+      continue;
+    }
+    const auto spacePos = trimmed.find_last_of(" \t");
+    if (spacePos == std::string::npos) {
+      continue;
+    }
+    auto name = trimmed.substr(0, spacePos);
+    const auto value = folly::tryTo<double>(trimmed.substr(spacePos + 1));
+    if (!value.hasValue()) {
+      continue;
+    }
+    // Strip the label set; per-label samples collapse to the last one, which
+    // is enough for the context the report carries.
+    const auto labelPos = name.find('{');
+    if (labelPos != std::string::npos) {
+      name = name.substr(0, labelPos);
+    }
+    metrics[name] = value.value();
+  }
+  return metrics;
+}
+
+double ConfigAdvisor::measure(
+    const std::string& commandTemplate,
+    const std::string& value) const {
+  const auto command = substituteValue(commandTemplate, value);
+  const auto& runner =
+      options_.runner ? options_.runner : std::function(runThroughShell);
+  std::vector<double> samples;
+  samples.reserve(options_.runsPerCandidate);
+  for (auto run = 0; run < options_.runsPerCandidate; ++run) {
+    samples.push_back(runner(command));
+  }
+  return median(samples);
+}
+
+std::vector<ConfigRecommendation> ConfigAdvisor::advise(
+    const std::vector<ConfigSweep>& sweeps) const {
+  std::vector<ConfigRecommendation> recommendations;
+  for (const auto& sweep : sweeps) {
+    const auto baselineWallMs =
+        measure(sweep.commandTemplate, sweep.baselineValue);
+    LOG(INFO) << "Baseline " << sweep.propertyName << "="
+              << sweep.baselineValue << ": " << baselineWallMs << " ms";
+
+    ConfigRecommendation best;
+    best.propertyName = sweep.propertyName;
+    best.baselineValue = sweep.baselineValue;
+    best.baselineWallMs = baselineWallMs;
+    best.recommendedWallMs = baselineWallMs;
+    for (const auto& candidate : sweep.candidateValues) {
+      if (candidate == sweep.baselineValue) {
+        continue;
+      }
+      const auto wallMs = measure(sweep.commandTemplate, candidate);
+      LOG(INFO) << "Candidate " << sweep.propertyName << "=" << candidate
+                << ": " << wallMs << " ms";
+      if (wallMs < best.recommendedWallMs) {
+        best.recommendedValue = candidate;
+        best.recommendedWallMs = wallMs;
+      }
+    }
+    if (best.recommendedValue.empty() || baselineWallMs <= 0) {
+      continue;
+    }
+    best.predictedImprovementPct =
+        (baselineWallMs - best.recommendedWallMs) / baselineWallMs * 100;
+    if (best.predictedImprovementPct < options_.minImprovementPct) {
+      continue;
+    }
+    recommendations.push_back(std::move(best));
+  }
+  return recommendations;
+}
+
+// static
+std::string ConfigAdvisor::toConfigDelta(
+    const std::vector<ConfigRecommendation>& recommendations) {
+  std::ostringstream delta;
+  for (const auto& recommendation : recommendations) {
+    delta << recommendation.propertyName << "="
+          << recommendation.recommendedValue << "\n";
+  }
+  return delta.str();
+}
+
+// static
+folly::dynamic ConfigAdvisor::toReport(
+    const std::vector<ConfigRecommendation>& recommendations,
+    const std::unordered_map<std::string, double>& observedMetrics) {
+  folly::dynamic report = folly::dynamic::object;
+  folly::dynamic entries = folly::dynamic::array;
+  for (const auto& recommendation : recommendations) {
+    folly::dynamic entry = folly::dynamic::object;
+    entry["property"] = recommendation.propertyName;
+    entry["baseline"] = recommendation.baselineValue;
+    entry["recommended"] = recommendation.recommendedValue;
+    entry["baselineWallMs"] = recommendation.baselineWallMs;
+    entry["recommendedWallMs"] = recommendation.recommendedWallMs;
+    entry["predictedImprovementPct"] = recommendation.predictedImprovementPct;
+    entries.push_back(std::move(entry));
+  }
+  report["recommendations"] = std::move(entries);
+
+  folly::dynamic metrics = folly::dynamic::object;
+  for (const auto& [name, value] : observedMetrics) {
+    metrics[name] = value;
+  }
+  report["observedMetrics"] = std::move(metrics);
+  return report;
+}
+} // namespace facebook::presto::tool
@@ -0,0 +1,108 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/dynamic.h>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook::presto::tool {
+
+/// One config knob to sweep. 'commandTemplate' is a shell command, typically
+/// a presto_trace_replayer or benchmark invocation over a captured workload
+/// trace, with every '{value}' occurrence replaced by the candidate value
+/// before the run. 'baselineValue' is the knob's current production setting;
+/// its measurement is the reference the candidates are compared against.
+struct ConfigSweep {
+  std::string propertyName;
+  std::string baselineValue;
+  std::vector<std::string> candidateValues;
+  std::string commandTemplate;
+};
+
+/// A recommended config change for one knob, with the measured baseline and
+/// best candidate wall times the prediction is derived from.
+struct ConfigRecommendation {
+  std::string propertyName;
+  std::string baselineValue;
+  std::string recommendedValue;
+  double baselineWallMs{0};
+  double recommendedWallMs{0};
+  double predictedImprovementPct{0};
+};
+
+/// Offline configuration advisor. Replays a captured workload once per
+/// candidate value of each swept knob, compares the median wall time against
+/// the baseline value's, and emits the knobs whose best candidate beats the
+/// baseline by at least the configured margin as a config delta. The advisor
+/// only orchestrates and measures; what a run exercises is entirely up to the
+/// sweep spec's commands.
+class ConfigAdvisor {
+ public:
+  struct Options {
+    /// Number of runs per candidate value; the median is used, so transient
+    /// noise in a single run does not pick a wrong winner.
+    int32_t runsPerCandidate{3};
+
+    /// Minimum median improvement over the baseline, in percent, for a knob
+    /// to make it into the recommendations. Filters wins within run-to-run
+    /// noise that would churn configs without moving the cluster.
+    double minImprovementPct{5.0};
+
+    /// Runs a command and returns its wall time in milliseconds. Defaults to
+    /// executing through the shell and timing it; injectable for tests.
+    std::function<double(const std::string& command)> runner;
+  };
+
+  explicit ConfigAdvisor(Options options);
+
+  /// Parses a sweep spec JSON document of the form
+  /// {"sweeps": [{"property": ..., "baseline": ..., "candidates": [...],
+  /// "command": ...}]}. Throws a user error on malformed specs.
+  static std::vector<ConfigSweep> parseSweepSpec(const std::string& spec);
+
+  /// Parses a Prometheus text-format metrics dump into metric name to last
+  /// sample value, skipping comments and stripping label sets. The metrics
+  /// are attached verbatim to the report so a recommendation can be read
+  /// next to the workload conditions it was derived under.
+  static std::unordered_map<std::string, double> parsePrometheusDump(
+      const std::string& text);
+
+  /// Measures every sweep and returns the recommendations that clear the
+  /// improvement margin, one per knob at most.
+  std::vector<ConfigRecommendation> advise(
+      const std::vector<ConfigSweep>& sweeps) const;
+
+  /// Formats recommendations as config.properties lines, one per knob, ready
+  /// to append to a cluster config for validation.
+  static std::string toConfigDelta(
+      const std::vector<ConfigRecommendation>& recommendations);
+
+  /// Full machine-readable report: recommendations with their measurements
+  /// plus the observed metrics context.
+  static folly::dynamic toReport(
+      const std::vector<ConfigRecommendation>& recommendations,
+      const std::unordered_map<std::string, double>& observedMetrics);
+
+ private:
+  // Median wall time of 'runsPerCandidate' runs of 'commandTemplate' with
+  // '{value}' substituted.
+  double measure(const std::string& commandTemplate, const std::string& value)
+      const;
+
+  const Options options_;
+};
+} // namespace facebook::presto::tool
@@ -0,0 +1,100 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include "presto_cpp/main/tool/advisor/ConfigAdvisor.h"
+#include "velox/common/base/Exceptions.h"
+
+DEFINE_string(
+    sweep_spec,
+    "",
+    "Path to the sweep spec JSON: {\"sweeps\": [{\"property\": ..., "
+    "\"baseline\": ..., \"candidates\": [...], \"command\": ...}]}. Each "
+    "command is a trace replayer or benchmark invocation over a captured "
+    "workload with '{value}' standing in for the swept value.");
+
+DEFINE_string(
+    metrics_dump,
+    "",
+    "Optional path to a Prometheus text-format metrics dump captured from "
+    "the workload the traces came from; attached to the report as context.");
+
+DEFINE_string(
+    output,
+    "",
+    "Optional path the JSON report is written to; the config delta is "
+    "always printed to stdout.");
+
+DEFINE_int32(
+    runs_per_candidate,
+    3,
+    "Runs per candidate value; the median wall time is compared.");
+
+DEFINE_double(
+    min_improvement_pct,
+    5.0,
+    "Minimum median improvement over the baseline, in percent, for a knob "
+    "to be recommended.");
+
+using namespace facebook::presto::tool;
+
+namespace {
+std::string slurpFile(const std::string& path) {
+  std::ifstream input(path);
+  VELOX_USER_CHECK(input.good(), "Cannot open {}", path);
+  std::stringstream contents;
+  contents << input.rdbuf();
+  return contents.str();
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  VELOX_USER_CHECK(!FLAGS_sweep_spec.empty(), "--sweep_spec is required");
+
+  const auto sweeps =
+      ConfigAdvisor::parseSweepSpec(slurpFile(FLAGS_sweep_spec));
+
+  std::unordered_map<std::string, double> observedMetrics;
+  if (!FLAGS_metrics_dump.empty()) {
+    observedMetrics =
+        ConfigAdvisor::parsePrometheusDump(slurpFile(FLAGS_metrics_dump));
+  }
+
+  ConfigAdvisor::Options options;
+  options.runsPerCandidate = FLAGS_runs_per_candidate;
+  options.minImprovementPct = FLAGS_min_improvement_pct;
+  ConfigAdvisor advisor(std::move(options));
+
+  const auto recommendations = advisor.advise(sweeps);
+  if (!FLAGS_output.empty()) {
+    std::ofstream output(FLAGS_output);
+    VELOX_USER_CHECK(output.good(), "Cannot write {}", FLAGS_output);
+    output << folly::toPrettyJson(
+        ConfigAdvisor::toReport(recommendations, observedMetrics));
+  }
+
+  if (recommendations.empty()) {
+    std::cout << "# No knob cleared the " << FLAGS_min_improvement_pct
+              << "% improvement margin.\n";
+  } else {
+    std::cout << ConfigAdvisor::toConfigDelta(recommendations);
+  }
+  return 0;
+}
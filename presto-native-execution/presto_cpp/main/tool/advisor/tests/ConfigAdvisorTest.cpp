@@ -0,0 +1,129 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include "presto_cpp/main/tool/advisor/ConfigAdvisor.h"
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace facebook::presto::tool;
+
+namespace {
+// Runner whose wall time is encoded in the command itself: the command is
+// the time in milliseconds as text.
+double commandEncodedRunner(const std::string& command) {
+  return std::stod(command);
+}
+} // namespace
+
+TEST(ConfigAdvisorTest, parseSweepSpec) {
+  const auto sweeps = ConfigAdvisor::parseSweepSpec(R"(
+    {
+      "sweeps": [
+        {
+          "property": "shuffle.local.read-prefetch-depth",
+          "baseline": "0",
+          "candidates": ["2", "4"],
+          "command": "replayer --shuffle_read_prefetch_depth={value}"
+        }
+      ]
+    }
+  )");
+  ASSERT_EQ(sweeps.size(), 1);
+  ASSERT_EQ(sweeps[0].propertyName, "shuffle.local.read-prefetch-depth");
+  ASSERT_EQ(sweeps[0].baselineValue, "0");
+  ASSERT_EQ(sweeps[0].candidateValues.size(), 2);
+  ASSERT_EQ(
+      sweeps[0].commandTemplate,
+      "replayer --shuffle_read_prefetch_depth={value}");
+
+  VELOX_ASSERT_THROW(
+      ConfigAdvisor::parseSweepSpec("not json"), "Malformed sweep spec");
+  VELOX_ASSERT_THROW(
+      ConfigAdvisor::parseSweepSpec("{}"), "no 'sweeps' list");
+  VELOX_ASSERT_THROW(
+      ConfigAdvisor::parseSweepSpec(R"(
+        {"sweeps": [{"property": "p", "baseline": "1", "candidates": [],
+                     "command": "c"}]}
+      )"),
+      "no candidate values");
+}
+
+TEST(ConfigAdvisorTest, advise) {
+  ConfigAdvisor::Options options;
+  options.runsPerCandidate = 1;
+  options.minImprovementPct = 5.0;
+  options.runner = commandEncodedRunner;
+  ConfigAdvisor advisor(std::move(options));
+
+  // The '{value}' placeholder is the measured time, so candidate "50" halves
+  // the baseline "100" and candidate "200" regresses it.
+  std::vector<ConfigSweep> sweeps;
+  sweeps.push_back({"knob.a", "100", {"200", "50"}, "{value}"});
+  // All candidates within the noise margin: no recommendation.
+  sweeps.push_back({"knob.b", "100", {"99", "98"}, "{value}"});
+  // Only regressions: no recommendation.
+  sweeps.push_back({"knob.c", "100", {"150"}, "{value}"});
+
+  const auto recommendations = advisor.advise(sweeps);
+  ASSERT_EQ(recommendations.size(), 1);
+  ASSERT_EQ(recommendations[0].propertyName, "knob.a");
+  ASSERT_EQ(recommendations[0].recommendedValue, "50");
+  ASSERT_EQ(recommendations[0].baselineWallMs, 100);
+  ASSERT_EQ(recommendations[0].recommendedWallMs, 50);
+  ASSERT_EQ(recommendations[0].predictedImprovementPct, 50);
+
+  ASSERT_EQ(ConfigAdvisor::toConfigDelta(recommendations), "knob.a=50\n");
+
+  const auto report = ConfigAdvisor::toReport(
+      recommendations, {{"presto_cpp_num_tasks", 42.0}});
+  ASSERT_EQ(report["recommendations"].size(), 1);
+  ASSERT_EQ(
+      report["recommendations"][0]["property"].asString(), "knob.a");
+  ASSERT_EQ(report["observedMetrics"]["presto_cpp_num_tasks"].asDouble(), 42.0);
+}
+
+TEST(ConfigAdvisorTest, medianOverRuns) {
+  // Three runs per candidate; the runner returns a noisy series and the
+  // median decides, so a single outlier run does not pick a wrong winner.
+  int run = 0;
+  ConfigAdvisor::Options options;
+  options.runsPerCandidate = 3;
+  options.minImprovementPct = 5.0;
+  options.runner = [&run](const std::string& command) {
+    // Baseline "100": runs 100, 100, 100. Candidate "90": 90, 500, 90 - the
+    // outlier does not mask the win.
+    const auto base = std::stod(command);
+    return (++run == 5) ? 500.0 : base;
+  };
+  ConfigAdvisor advisor(std::move(options));
+
+  const auto recommendations =
+      advisor.advise({{"knob", "100", {"90"}, "{value}"}});
+  ASSERT_EQ(recommendations.size(), 1);
+  ASSERT_EQ(recommendations[0].recommendedWallMs, 90);
+}
+
+TEST(ConfigAdvisorTest, parsePrometheusDump) {
+  const auto metrics = ConfigAdvisor::parsePrometheusDump(R"(
+# HELP presto_cpp_num_tasks Number of tasks.
+# TYPE presto_cpp_num_tasks gauge
+presto_cpp_num_tasks 17
+presto_cpp_os_user_cpu_time_micros{cluster="test",worker=""} 12345.5
+
+malformed line
+)");
+  ASSERT_EQ(metrics.size(), 2);
+  ASSERT_EQ(metrics.at("presto_cpp_num_tasks"), 17);
+  ASSERT_EQ(metrics.at("presto_cpp_os_user_cpu_time_micros"), 12345.5);
+}
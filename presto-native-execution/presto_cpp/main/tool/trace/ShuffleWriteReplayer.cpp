@@ -0,0 +1,89 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ */
+#include "presto_cpp/main/tool/trace/ShuffleWriteReplayer.h"
+
+#include "presto_cpp/main/operators/LocalShuffle.h"
+#include "presto_cpp/main/operators/ShuffleWrite.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace facebook::velox::tool::trace {
+
+ShuffleWriteReplayer::ShuffleWriteReplayer(
+    const std::string& traceDir,
+    const std::string& queryId,
+    const std::string& taskId,
+    const std::string& nodeId,
+    const std::string& nodeName,
+    const std::string& driverIds,
+    uint64_t queryCapacity,
+    folly::Executor* executor,
+    const std::string& replayOutputDir)
+    : OperatorReplayerBase(
+          traceDir,
+          queryId,
+          taskId,
+          nodeId,
+          nodeName,
+          "",
+          driverIds,
+          queryCapacity,
+          executor),
+      replayQueryId_(queryId),
+      replayOutputDir_(replayOutputDir) {
+  VELOX_CHECK(!replayOutputDir_.empty());
+}
+
+core::PlanNodePtr ShuffleWriteReplayer::createPlanNode(
+    const core::PlanNode* node,
+    const core::PlanNodeId& nodeId,
+    const core::PlanNodePtr& source) const {
+  const auto* shuffleWriteNode =
+      dynamic_cast<const facebook::presto::operators::ShuffleWriteNode*>(node);
+  VELOX_CHECK_NOT_NULL(shuffleWriteNode);
+
+  // Preserve the sorted-shuffle layout when the traced stage already used the
+  // local shuffle; other shuffle implementations replay through the unsorted
+  // write path.
+  bool sortedShuffle = false;
+  if (shuffleWriteNode->shuffleName() ==
+      facebook::presto::operators::LocalPersistentShuffleFactory::
+          kShuffleName) {
+    sortedShuffle = facebook::presto::operators::LocalShuffleWriteInfo::
+                        deserialize(
+                            shuffleWriteNode->serializedShuffleWriteInfo())
+                            .sortedShuffle;
+  }
+
+  facebook::presto::operators::LocalShuffleWriteInfo writeInfo;
+  writeInfo.rootPath = replayOutputDir_;
+  writeInfo.queryId = replayQueryId_;
+  writeInfo.numPartitions = shuffleWriteNode->numPartitions();
+  writeInfo.shuffleId = 0;
+  writeInfo.sortedShuffle = sortedShuffle;
+
+  return std::make_shared<facebook::presto::operators::ShuffleWriteNode>(
+      nodeId,
+      shuffleWriteNode->numPartitions(),
+      facebook::presto::operators::LocalPersistentShuffleFactory::kShuffleName
+          .toString(),
+      writeInfo.serialize(),
+      source);
+}
+
+} // namespace facebook::velox::tool::trace
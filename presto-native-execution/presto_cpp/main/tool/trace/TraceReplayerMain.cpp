@@ -16,9 +16,12 @@
 
 #include <folly/init/Init.h>
 #include "presto_cpp/main/operators/BroadcastWrite.h"
+#include "presto_cpp/main/operators/LocalShuffle.h"
 #include "presto_cpp/main/operators/PartitionAndSerialize.h"
+#include "presto_cpp/main/operators/ShuffleWrite.h"
 #include "presto_cpp/main/tool/trace/BroadcastWriteReplayer.h"
 #include "presto_cpp/main/tool/trace/PartitionAndSerializeReplayer.h"
+#include "presto_cpp/main/tool/trace/ShuffleWriteReplayer.h"
 #include "presto_cpp/main/types/PrestoToVeloxQueryPlan.h"
 
 DEFINE_string(
@@ -26,6 +29,12 @@ DEFINE_string(
     "",
     "Specify output directory of BroadcastWrite.");
 
+DEFINE_string(
+    shuffle_write_output_dir,
+    "",
+    "Specify output directory of ShuffleWrite; replayed shuffle files are "
+    "written there through the local persistent shuffle.");
+
 using namespace facebook::velox;
 using namespace facebook::presto;
 
@@ -44,6 +53,14 @@ class PrestoTraceReplayRunner
     // Register custom Presto operators to execute during replay
     exec::Operator::registerOperator(
         std::make_unique<operators::PartitionAndSerializeTranslator>());
+    exec::Operator::registerOperator(
+        std::make_unique<operators::ShuffleWriteTranslator>());
+
+    // Register the local persistent shuffle that replayed ShuffleWrite
+    // operators write through.
+    operators::ShuffleInterfaceFactory::registerFactory(
+        operators::LocalPersistentShuffleFactory::kShuffleName.toString(),
+        std::make_unique<operators::LocalPersistentShuffleFactory>());
 
     // Call base init to complete initialization
     TraceReplayRunner::init();
@@ -70,6 +87,20 @@ class PrestoTraceReplayRunner
           queryCapacityBytes,
           cpuExecutor_.get(),
           FLAGS_broadcast_write_output_dir);
+    } else if (nodeName == "ShuffleWrite") {
+      VELOX_USER_CHECK(
+          !FLAGS_shuffle_write_output_dir.empty(),
+          "--shuffle_write_output_dir is required");
+      return std::make_unique<tool::trace::ShuffleWriteReplayer>(
+          FLAGS_root_dir,
+          FLAGS_query_id,
+          FLAGS_task_id,
+          FLAGS_node_id,
+          nodeName,
+          FLAGS_driver_ids,
+          queryCapacityBytes,
+          cpuExecutor_.get(),
+          FLAGS_shuffle_write_output_dir);
     } else if (nodeName == "PartitionAndSerialize") {
       return std::make_unique<tool::trace::PartitionAndSerializeReplayer>(
           FLAGS_root_dir,
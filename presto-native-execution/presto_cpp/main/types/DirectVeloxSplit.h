@@ -0,0 +1,46 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <functional>
+
+#include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
+#include "velox/connectors/Connector.h"
+
+namespace facebook::presto {
+
+/// Connector split carried straight from its decoded wire payload to the
+/// velox split, skipping the intermediate protocol struct tree that split
+/// deserialization otherwise materializes. Produced by the Thrift transport
+/// for connectors with a direct converter (see
+/// 'task.thrift-direct-split-conversion-enabled'); toVeloxSplit() invokes
+/// 'toVelox' with the catalog id and split context of the enclosing split.
+struct DirectVeloxSplit : public protocol::ConnectorSplit {
+  DirectVeloxSplit() {
+    _type = "$direct";
+  }
+
+  std::function<std::unique_ptr<velox::connector::ConnectorSplit>(
+      const protocol::ConnectorId& catalogId,
+      const protocol::SplitContext& splitContext)>
+      toVelox;
+
+  /// Hash of the raw serialized split payload. Stands in for the JSON
+  /// rendering of the split in fragment result cache keys, since there is no
+  /// protocol struct left to render; keys therefore differ between the
+  /// Thrift and JSON transports.
+  uint64_t payloadHash{0};
+};
+
+} // namespace facebook::presto
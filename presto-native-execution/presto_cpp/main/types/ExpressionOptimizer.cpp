@@ -12,13 +12,18 @@
  * limitations under the License.
  */
 
+#include <list>
+#include <mutex>
+
 #include "presto_cpp/main/types/ExpressionOptimizer.h"
 #include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
 #include "presto_cpp/main/common/Exception.h"
 #include "presto_cpp/main/types/PrestoToVeloxExpr.h"
 #include "presto_cpp/main/types/TypeParser.h"
 #include "presto_cpp/main/types/VeloxToPrestoExpr.h"
 #include "velox/core/Expressions.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/ExprOptimizer.h"
 
@@ -26,6 +31,62 @@ namespace facebook::presto::expression {
 
 namespace {
 
+// Process-wide cache from serialized input row expression to its optimized
+// form. Dashboards and BI tools re-send the same filter expressions to the
+// sidecar optimization endpoint many times a day, so optimization results are
+// shared across requests. Keyed on the expression JSON plus the session
+// timezone, which can affect constant folding. Bounded LRU, thread safe.
+class OptimizedExpressionCache {
+ public:
+  static OptimizedExpressionCache* instance() {
+    static std::unique_ptr<OptimizedExpressionCache> cache =
+        std::make_unique<OptimizedExpressionCache>();
+    return cache.get();
+  }
+
+  /// Returns the cached optimized expression for 'key' and marks it most
+  /// recently used, or nullptr if not cached.
+  std::shared_ptr<protocol::RowExpression> get(const std::string& key) {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = expressions_.find(key);
+    if (it == expressions_.end()) {
+      return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+    return it->second.expression;
+  }
+
+  /// Inserts 'expression' under 'key', evicting the least recently used
+  /// entry when the cache is full.
+  void put(
+      const std::string& key,
+      const std::shared_ptr<protocol::RowExpression>& expression) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (expressions_.count(key) != 0) {
+      return;
+    }
+    if (expressions_.size() >= kCapacity) {
+      expressions_.erase(lru_.back());
+      lru_.pop_back();
+    }
+    lru_.push_front(key);
+    expressions_.emplace(key, CachedExpression{expression, lru_.begin()});
+  }
+
+ private:
+  static constexpr size_t kCapacity = 1'024;
+
+  struct CachedExpression {
+    std::shared_ptr<protocol::RowExpression> expression;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  std::mutex mutex_;
+  // Most recently used key at the front.
+  std::list<std::string> lru_;
+  std::unordered_map<std::string, CachedExpression> expressions_;
+};
+
 static const velox::expression::MakeFailExpr kMakeFailExpr =
     [](const std::string& error,
        const velox::TypePtr& type) -> velox::core::TypedExprPtr {
@@ -43,6 +104,72 @@ static const velox::expression::MakeFailExpr kMakeFailExpr =
       false);
 };
 
+// Optimizes the expressions of one request with shared state: a subexpression
+// that repeats across the batch is optimized once and its optimized form is
+// reused everywhere else it occurs. The coordinator sends the planning
+// expressions of a query in one batch and they share many predicates and
+// projections, so the memo cuts the optimizer work roughly to the number of
+// distinct subtrees.
+class BatchOptimizer {
+ public:
+  BatchOptimizer(
+      velox::core::QueryCtx* queryCtx,
+      velox::memory::MemoryPool* pool)
+      : queryCtx_(queryCtx), pool_(pool) {}
+
+  velox::core::TypedExprPtr optimize(const velox::core::TypedExprPtr& expr) {
+    const auto key =
+        fmt::format("{}|{}", expr->type()->toString(), expr->toString());
+    auto it = memo_.find(key);
+    if (it != memo_.end()) {
+      RECORD_METRIC_VALUE(kCounterExpressionOptimizerBatchDedupCount);
+      return it->second;
+    }
+    auto optimized = velox::expression::optimize(
+        rewriteInputs(expr), queryCtx_, pool_, kMakeFailExpr);
+    memo_.emplace(key, optimized);
+    return optimized;
+  }
+
+ private:
+  // Replaces the inputs of a call or cast with their memoized optimized
+  // forms bottom-up, so subtrees shared with earlier batch entries are not
+  // optimized again. Other node kinds, including lambdas whose bodies are
+  // scoped to their signature, are optimized as a unit.
+  velox::core::TypedExprPtr rewriteInputs(
+      const velox::core::TypedExprPtr& expr) {
+    using velox::core::ExprKind;
+    if (expr->inputs().empty() ||
+        (expr->kind() != ExprKind::kCall && expr->kind() != ExprKind::kCast)) {
+      return expr;
+    }
+    std::vector<velox::core::TypedExprPtr> inputs;
+    inputs.reserve(expr->inputs().size());
+    bool changed = false;
+    for (const auto& input : expr->inputs()) {
+      auto optimizedInput = optimize(input);
+      changed |= optimizedInput != input;
+      inputs.push_back(std::move(optimizedInput));
+    }
+    if (!changed) {
+      return expr;
+    }
+    if (expr->kind() == ExprKind::kCall) {
+      const auto* call = expr->asUnchecked<velox::core::CallTypedExpr>();
+      return std::make_shared<velox::core::CallTypedExpr>(
+          expr->type(), std::move(inputs), call->name());
+    }
+    const auto* cast = expr->asUnchecked<velox::core::CastTypedExpr>();
+    return std::make_shared<velox::core::CastTypedExpr>(
+        expr->type(), std::move(inputs), cast->isTryCast());
+  }
+
+  velox::core::QueryCtx* const queryCtx_;
+  velox::memory::MemoryPool* const pool_;
+  // Serialized subexpression to its optimized form, for this batch only.
+  std::unordered_map<std::string, velox::core::TypedExprPtr> memo_;
+};
+
 // Tries to evaluate `expr`, irrespective of its determinism, to a constant
 // value.
 velox::VectorPtr tryEvaluateToConstant(
@@ -66,12 +193,12 @@ protocol::RowExpressionOptimizationResult optimizeExpression(
     OptimizerLevel& optimizerLevel,
     const VeloxExprConverter& prestoToVeloxConverter,
     const expression::VeloxToPrestoExprConverter& veloxToPrestoConverter,
+    BatchOptimizer& batchOptimizer,
     velox::core::QueryCtx* queryCtx,
     velox::memory::MemoryPool* pool) {
   protocol::RowExpressionOptimizationResult result;
   const auto expr = prestoToVeloxConverter.toVeloxExpr(input);
-  auto optimized =
-      velox::expression::optimize(expr, queryCtx, pool, kMakeFailExpr);
+  auto optimized = batchOptimizer.optimize(expr);
 
   if (optimizerLevel == OptimizerLevel::kEvaluated) {
     try {
@@ -105,15 +232,38 @@ std::vector<protocol::RowExpressionOptimizationResult> optimizeExpressions(
   TypeParser typeParser;
   const VeloxExprConverter prestoToVeloxConverter(pool, &typeParser);
   const expression::VeloxToPrestoExprConverter veloxToPrestoConverter(pool);
+  BatchOptimizer batchOptimizer(queryCtx, pool);
+  // Results for the evaluated level are not cached: evaluation runs even
+  // non-deterministic expressions, whose results must not be reused.
+  const bool useCache = optimizerLevel == OptimizerLevel::kOptimized;
+  auto* cache = OptimizedExpressionCache::instance();
+  const auto& timezone = queryCtx->queryConfig().sessionTimezone();
+
   std::vector<protocol::RowExpressionOptimizationResult> result;
   for (const auto& expression : input) {
+    std::string key;
+    if (useCache) {
+      key = fmt::format("{}\n{}", protocol::json(expression).dump(), timezone);
+      if (auto optimized = cache->get(key)) {
+        RECORD_METRIC_VALUE(kCounterExpressionOptimizerCacheHits);
+        protocol::RowExpressionOptimizationResult cached;
+        cached.optimizedExpression = std::move(optimized);
+        result.push_back(std::move(cached));
+        continue;
+      }
+      RECORD_METRIC_VALUE(kCounterExpressionOptimizerCacheMisses);
+    }
     result.push_back(optimizeExpression(
         expression,
         optimizerLevel,
         prestoToVeloxConverter,
         veloxToPrestoConverter,
+        batchOptimizer,
         queryCtx,
         pool));
+    if (useCache && result.back().optimizedExpression != nullptr) {
+      cache->put(key, result.back().optimizedExpression);
+    }
   }
   return result;
 }
@@ -13,6 +13,8 @@
  */
 #pragma once
 #include <folly/Conv.h>
+#include <folly/String.h>
+#include <folly/hash/Hash.h>
 #include <string>
 #include "velox/common/base/Exceptions.h"
 
@@ -20,18 +22,20 @@ namespace facebook::presto {
 class PrestoTaskId {
  public:
   explicit PrestoTaskId(const std::string& taskId) {
-    std::vector<std::string> taskIdParts;
-    folly::split('.', taskId, taskIdParts);
-
-    if (taskIdParts.size() != 5) {
+    // Split into string pieces rather than strings so parsing allocates
+    // only the retained query id, not a copy of every component.
+    folly::StringPiece queryId, stageId, stageExecutionId, id, attemptNumber;
+    if (!folly::split(
+            '.', taskId, queryId, stageId, stageExecutionId, id,
+            attemptNumber)) {
       VELOX_USER_FAIL("Malformed task ID: {}", taskId);
     }
 
-    queryId_ = taskIdParts[0];
-    stageId_ = folly::to<int32_t>(taskIdParts[1]);
-    stageExecutionId_ = folly::to<int32_t>(taskIdParts[2]);
-    id_ = folly::to<int32_t>(taskIdParts[3]);
-    attemptNumber_ = folly::to<int32_t>(taskIdParts[4]);
+    queryId_.assign(queryId.data(), queryId.size());
+    stageId_ = folly::to<int32_t>(stageId);
+    stageExecutionId_ = folly::to<int32_t>(stageExecutionId);
+    id_ = folly::to<int32_t>(id);
+    attemptNumber_ = folly::to<int32_t>(attemptNumber);
   }
 
   const std::string& queryId() const {
@@ -73,4 +77,59 @@ class PrestoTaskId {
   int32_t id_{0};
   int32_t attemptNumber_{0};
 };
+
+/// Fixed-size binary form of a task id used as a map key: a 64-bit hash of
+/// the query id plus the four numeric components. Comparing keys is a
+/// handful of integer compares instead of a byte-wise compare of the ~60
+/// character task id string, and building one parses the id exactly once,
+/// so hot per-task lookups (status polls, result fetches, split updates)
+/// pay neither the parse nor the string compare. The string form stays the
+/// protocol I/O representation. An id that does not parse is hashed whole,
+/// so distinct malformed ids still behave like distinct string keys rather
+/// than failing the lookup.
+struct TaskIdKey {
+  uint64_t queryIdHash{0};
+  int32_t stageId{0};
+  int32_t stageExecutionId{0};
+  int32_t id{0};
+  int32_t attemptNumber{0};
+
+  explicit TaskIdKey(const std::string& taskId) {
+    folly::StringPiece queryId, stage, stageExecution, task, attempt;
+    if (folly::split(
+            '.', taskId, queryId, stage, stageExecution, task, attempt)) {
+      const auto stageNum = folly::tryTo<int32_t>(stage);
+      const auto stageExecutionNum = folly::tryTo<int32_t>(stageExecution);
+      const auto taskNum = folly::tryTo<int32_t>(task);
+      const auto attemptNum = folly::tryTo<int32_t>(attempt);
+      if (stageNum.hasValue() && stageExecutionNum.hasValue() &&
+          taskNum.hasValue() && attemptNum.hasValue()) {
+        queryIdHash = folly::hash::fnv64_buf(queryId.data(), queryId.size());
+        stageId = stageNum.value();
+        stageExecutionId = stageExecutionNum.value();
+        id = taskNum.value();
+        attemptNumber = attemptNum.value();
+        return;
+      }
+    }
+    queryIdHash = folly::hash::fnv64_buf(taskId.data(), taskId.size());
+  }
+
+  bool operator==(const TaskIdKey& other) const {
+    return queryIdHash == other.queryIdHash && stageId == other.stageId &&
+        stageExecutionId == other.stageExecutionId && id == other.id &&
+        attemptNumber == other.attemptNumber;
+  }
+
+  struct Hash {
+    size_t operator()(const TaskIdKey& key) const {
+      return folly::hash::hash_combine(
+          key.queryIdHash,
+          key.stageId,
+          key.stageExecutionId,
+          key.id,
+          key.attemptNumber);
+    }
+  };
+};
 } // namespace facebook::presto
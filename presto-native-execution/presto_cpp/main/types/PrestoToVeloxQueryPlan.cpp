@@ -29,6 +29,8 @@
 // clang-format on
 
 #include "presto_cpp/main/SessionProperties.h"
+#include "presto_cpp/main/common/Counters.h"
+#include "presto_cpp/main/common/ExchangeProjection.h"
 #include "presto_cpp/main/common/Utils.h"
 #include "presto_cpp/main/connectors/PrestoToVeloxConnectorUtils.h"
 #include "presto_cpp/main/operators/BroadcastWrite.h"
@@ -36,6 +38,7 @@
 #include "presto_cpp/main/operators/ShuffleRead.h"
 #include "presto_cpp/main/operators/ShuffleWrite.h"
 #include "presto_cpp/main/types/TypeParser.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/exec/TraceUtil.h"
 
 using namespace facebook::velox;
@@ -48,7 +51,10 @@ namespace {
 // Check if this is a broadcast join with cached hash table enabled.
 // Works with both JoinNode and SemiJoinNode.
 bool useCachedHashTable(const protocol::PlanNode& node) {
-  if (!SystemConfig::instance()->broadcastJoinTableCachingEnabled()) {
+  // The session property defaults to the broadcast-join-table-caching-enabled
+  // system config, so this honors both the worker default and a per-query
+  // override.
+  if (!SessionProperties::instance()->broadcastJoinTableCachingEnabled()) {
     return false;
   }
   if (const auto* joinNode = dynamic_cast<const protocol::JoinNode*>(&node)) {
@@ -639,6 +645,123 @@ std::shared_ptr<const protocol::ProjectNode> isIdentityProjection(
 
   return nullptr;
 }
+
+// Collects the names of all variables referenced by 'expression' into
+// 'names'.
+void collectVariableNames(
+    const std::shared_ptr<protocol::RowExpression>& expression,
+    std::unordered_set<std::string>& names) {
+  if (auto variable =
+          std::dynamic_pointer_cast<protocol::VariableReferenceExpression>(
+              expression)) {
+    names.insert(variable->name);
+    return;
+  }
+  if (auto call =
+          std::dynamic_pointer_cast<protocol::CallExpression>(expression)) {
+    for (const auto& argument : call->arguments) {
+      collectVariableNames(argument, names);
+    }
+    return;
+  }
+  if (auto special = std::dynamic_pointer_cast<protocol::SpecialFormExpression>(
+          expression)) {
+    for (const auto& argument : special->arguments) {
+      collectVariableNames(argument, names);
+    }
+    return;
+  }
+  if (auto lambda =
+          std::dynamic_pointer_cast<protocol::LambdaDefinitionExpression>(
+              expression)) {
+    collectVariableNames(lambda->body, names);
+  }
+  // Constants carry no variable references.
+}
+
+// When a projection reads a remote exchange directly and references only
+// part of its output, records the used column indices for the producing
+// fragments so the exchange client can ask the producers to null out the
+// rest (see ExchangeProjectionRegistry). The projection is the exchange's
+// only consumer in the fragment tree, so the unused columns are provably
+// dead on this worker.
+void maybeRegisterExchangeProjection(
+    const std::shared_ptr<const protocol::ProjectNode>& node,
+    const protocol::TaskId& taskId) {
+  const auto remoteSource =
+      std::dynamic_pointer_cast<const protocol::RemoteSourceNode>(node->source);
+  if (remoteSource == nullptr || remoteSource->orderingScheme != nullptr) {
+    return;
+  }
+  std::unordered_set<std::string> used;
+  for (const auto& [variable, expression] : node->assignments.assignments) {
+    collectVariableNames(expression, used);
+  }
+  std::vector<int32_t> columns;
+  for (int32_t i = 0;
+       i < static_cast<int32_t>(remoteSource->outputVariables.size());
+       ++i) {
+    if (used.count(remoteSource->outputVariables[i].name) != 0) {
+      columns.push_back(i);
+    }
+  }
+  if (columns.empty() ||
+      columns.size() == remoteSource->outputVariables.size()) {
+    return;
+  }
+  const auto queryId = PrestoTaskId(taskId).queryId();
+  for (const auto& fragmentId : remoteSource->sourceFragmentIds) {
+    ExchangeProjectionRegistry::instance()->registerMask(
+        queryId, fragmentId, columns);
+  }
+}
+
+// Folds 'predicate' into the scan's hive table handle so the connector
+// evaluates it as part of the scan's remaining filter instead of a standalone
+// FilterNode above the scan. Subfield filters extracted by the coordinator
+// stay as-is; the predicate conjoins the remaining filter, which uses the
+// same variable names as plan expressions since both go through the row
+// expression converter. Returns nullptr when the scan's handle is not a hive
+// one or has filter pushdown disabled.
+core::PlanNodePtr tryFuseFilterIntoTableScan(
+    const core::TypedExprPtr& predicate,
+    const std::shared_ptr<const core::TableScanNode>& scan) {
+  const auto* hiveHandle =
+      dynamic_cast<const connector::hive::HiveTableHandle*>(
+          scan->tableHandle().get());
+  if (hiveHandle == nullptr || !hiveHandle->isFilterPushdownEnabled()) {
+    return nullptr;
+  }
+
+  common::SubfieldFilters subfieldFilters;
+  for (const auto& [subfield, filter] : hiveHandle->subfieldFilters()) {
+    subfieldFilters[subfield.clone()] = filter->clone();
+  }
+
+  auto remainingFilter = predicate;
+  if (hiveHandle->remainingFilter() != nullptr) {
+    remainingFilter = std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(),
+        std::vector<core::TypedExprPtr>{
+            hiveHandle->remainingFilter(), predicate},
+        "and");
+  }
+
+  auto fusedHandle = std::make_shared<connector::hive::HiveTableHandle>(
+      hiveHandle->connectorId(),
+      hiveHandle->tableName(),
+      true,
+      std::move(subfieldFilters),
+      remainingFilter,
+      hiveHandle->dataColumns(),
+      hiveHandle->tableParameters(),
+      hiveHandle->columnHandles());
+  return std::make_shared<core::TableScanNode>(
+      scan->id(),
+      scan->outputType(),
+      std::move(fusedHandle),
+      scan->assignments());
+}
 } // namespace
 
 core::PlanNodePtr VeloxQueryPlanConverterBase::toVeloxQueryPlan(
@@ -720,10 +843,25 @@ core::PlanNodePtr VeloxQueryPlanConverterBase::toVeloxQueryPlan(
         node->id, std::move(names), std::move(projections), hashJoinNode);
   }
 
+  auto source = toVeloxQueryPlan(node->source, tableWriteInfo, taskId);
+
+  // With per-session opt-in, fold a filter that sits directly on a table scan
+  // into the scan's remaining filter: one less operator boundary and no
+  // intermediate vectors between the two for predicate-heavy scans.
+  if (queryCtx_ != nullptr &&
+      queryCtx_->queryConfig().get<bool>(
+          SessionProperties::kScanFilterFusionEnabled, false)) {
+    if (auto scan =
+            std::dynamic_pointer_cast<const core::TableScanNode>(source)) {
+      if (auto fused = tryFuseFilterIntoTableScan(
+              exprConverter_.toVeloxExpr(node->predicate), scan)) {
+        return fused;
+      }
+    }
+  }
+
   return std::make_shared<core::FilterNode>(
-      node->id,
-      exprConverter_.toVeloxExpr(node->predicate),
-      toVeloxQueryPlan(node->source, tableWriteInfo, taskId));
+      node->id, exprConverter_.toVeloxExpr(node->predicate), source);
 }
 
 std::shared_ptr<const core::ProjectNode>
@@ -831,6 +969,10 @@ VeloxQueryPlanConverterBase::toVeloxQueryPlan(
     return limit;
   }
 
+  if (SystemConfig::instance()->exchangeSelectiveColumnsEnabled()) {
+    maybeRegisterExchangeProjection(node, taskId);
+  }
+
   return std::make_shared<core::ProjectNode>(
       node->id,
       getNames(node->assignments),
@@ -1057,6 +1199,34 @@ VeloxQueryPlanConverterBase::toVeloxExprs(
   return fields;
 }
 
+namespace {
+// Returns true when every grouping key appears among the leading
+// 'groupingKeys.size()' columns of 'orderingScheme'. Rows sorted that way
+// have equal grouping keys contiguous, regardless of the keys' relative
+// order within the sort prefix.
+bool orderingCoversGroupingKeys(
+    const protocol::OrderingScheme& orderingScheme,
+    const protocol::List<protocol::VariableReferenceExpression>&
+        groupingKeys) {
+  if (orderingScheme.orderBy.size() < groupingKeys.size()) {
+    return false;
+  }
+  for (const auto& key : groupingKeys) {
+    bool found = false;
+    for (size_t i = 0; i < groupingKeys.size(); ++i) {
+      if (orderingScheme.orderBy[i].variable.name == key.name) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 std::shared_ptr<const core::AggregationNode>
 VeloxQueryPlanConverterBase::toVeloxQueryPlan(
     const std::shared_ptr<const protocol::AggregationNode>& node,
@@ -1094,6 +1264,31 @@ VeloxQueryPlanConverterBase::toVeloxQueryPlan(
       node->groupingSets.groupingSetCount == 1 &&
       node->groupingSets.globalGroupingSets.empty();
 
+  auto preGroupedKeys = streamable
+      ? toVeloxExprs(node->preGroupedVariables)
+      : std::vector<core::FieldAccessTypedExprPtr>{};
+
+  // When the aggregation sits directly on a remote source whose ordering
+  // scheme covers all grouping keys and the exchange delivers each partition
+  // as one ordered run (batch sorted shuffle merges producer runs on read),
+  // groups arrive contiguously; marking the keys pre-grouped lets velox
+  // stream finished groups out of the shuffle read instead of hash-building
+  // over the whole input.
+  if (preGroupedKeys.empty() && remoteSourceDeliversOrderedRun() &&
+      node->groupingSets.groupingSetCount == 1 &&
+      node->groupingSets.globalGroupingSets.empty() &&
+      !node->groupingSets.groupingKeys.empty()) {
+    if (const auto remoteSource =
+            std::dynamic_pointer_cast<const protocol::RemoteSourceNode>(
+                node->source);
+        remoteSource != nullptr && remoteSource->orderingScheme != nullptr &&
+        remoteSource->exchangeType != protocol::ExchangeNodeType::REPLICATE &&
+        orderingCoversGroupingKeys(
+            *remoteSource->orderingScheme, node->groupingSets.groupingKeys)) {
+      preGroupedKeys = toVeloxExprs(node->groupingSets.groupingKeys);
+    }
+  }
+
   // groupIdField and globalGroupingSets are required for producing default
   // output rows for global grouping sets when there are no input rows.
   // Global grouping sets can be present without groupIdField in Final
@@ -1111,8 +1306,7 @@ VeloxQueryPlanConverterBase::toVeloxQueryPlan(
       node->id,
       step,
       toVeloxExprs(node->groupingSets.groupingKeys),
-      streamable ? toVeloxExprs(node->preGroupedVariables)
-                 : std::vector<core::FieldAccessTypedExprPtr>{},
+      std::move(preGroupedKeys),
       aggregateNames,
       aggregates,
       globalGroupingSets,
@@ -2040,6 +2234,28 @@ protocol::PlanNodeId toPartitionedOutputNodeId(const protocol::PlanNodeId& id) {
   return "root." + id;
 }
 
+// Returns true if the fragment only re-buckets a remote exchange: the source
+// is a plain (unordered) exchange whose output layout and serde kind match the
+// partitioned output exactly. Such a stage deserializes every page it receives
+// only to re-serialize the identical rows. Velox's Exchange and
+// PartitionedOutput operators exchange row vectors, not serialized pages, so
+// the serde round trip cannot be elided here; count these tasks to keep the
+// wasted work visible and to size a future byte-level forwarding path.
+bool isPassthroughExchangeStage(
+    const core::PlanNodePtr& sourceNode,
+    const RowTypePtr& outputType,
+    VectorSerde::Kind serdeKind) {
+  const auto exchange =
+      std::dynamic_pointer_cast<const core::ExchangeNode>(sourceNode);
+  if (exchange == nullptr ||
+      std::dynamic_pointer_cast<const core::MergeExchangeNode>(sourceNode) !=
+          nullptr) {
+    return false;
+  }
+  return exchange->serdeKind() == serdeKind &&
+      *exchange->outputType() == *outputType;
+}
+
 } // namespace
 
 core::PlanFragment VeloxQueryPlanConverterBase::toVeloxQueryPlan(
@@ -2102,6 +2318,16 @@ core::PlanFragment VeloxQueryPlanConverterBase::toVeloxQueryPlan(
   const auto partitionedOutputNodeId =
       toPartitionedOutputNodeId(fragment.root->id);
 
+  if (isPassthroughExchangeStage(
+          sourceNode,
+          outputType,
+          toVeloxSerdeKind(partitioningScheme.encoding))) {
+    RECORD_METRIC_VALUE(kCounterPassthroughExchangeStageTasks);
+    VLOG(1) << "Task " << taskId
+            << " repartitions a remote exchange without transformation; pages "
+               "are deserialized and re-serialized unmodified.";
+  }
+
   if (auto systemPartitioningHandle =
           std::dynamic_pointer_cast<protocol::SystemPartitioningHandle>(
               partitioningHandle)) {
@@ -2397,6 +2623,10 @@ connector::CommitStrategy VeloxBatchQueryPlanConverter::getCommitStrategy()
   return connector::CommitStrategy::kTaskCommit;
 }
 
+bool VeloxBatchQueryPlanConverter::remoteSourceDeliversOrderedRun() const {
+  return SystemConfig::instance()->shuffleStreamingAggregationEnabled();
+}
+
 void registerPrestoPlanNodeSerDe() {
   auto& registry = DeserializationWithContextRegistryForSharedPtr();
 
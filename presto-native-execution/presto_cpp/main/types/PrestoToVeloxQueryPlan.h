@@ -55,6 +55,14 @@ class VeloxQueryPlanConverterBase {
 
   virtual velox::connector::CommitStrategy getCommitStrategy() const = 0;
 
+  // Returns true when a remote source carrying an ordering scheme delivers
+  // each partition as a single ordered run, so an aggregation directly above
+  // it may treat grouping keys covered by the ordering as pre-grouped. False
+  // here; interactive ordered exchanges become MergeExchangeNodes instead.
+  virtual bool remoteSourceDeliversOrderedRun() const {
+    return false;
+  }
+
   velox::core::PlanNodePtr toVeloxQueryPlan(
       const std::shared_ptr<const protocol::OutputNode>& node,
       const std::shared_ptr<protocol::TableWriteInfo>& tableWriteInfo,
@@ -284,6 +292,8 @@ class VeloxBatchQueryPlanConverter : public VeloxQueryPlanConverterBase {
 
   velox::connector::CommitStrategy getCommitStrategy() const override;
 
+  bool remoteSourceDeliversOrderedRun() const override;
+
  private:
   const std::string shuffleName_;
   const std::shared_ptr<std::string> serializedShuffleWriteInfo_;
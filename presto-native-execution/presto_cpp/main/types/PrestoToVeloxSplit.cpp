@@ -11,14 +11,25 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <thread>
+
+#include <folly/futures/Future.h>
+
 #include "presto_cpp/main/types/PrestoToVeloxSplit.h"
 #include "presto_cpp/main/connectors/PrestoToVeloxConnector.h"
+#include "presto_cpp/main/types/DirectVeloxSplit.h"
 #include "velox/exec/Exchange.h"
 
 using namespace facebook::velox;
 
 namespace facebook::presto {
 
+namespace {
+// Minimum number of splits each conversion task should get. Below twice this
+// the fan-out overhead outweighs the parallelism.
+constexpr size_t kMinSplitsPerConversionThread = 512;
+} // namespace
+
 velox::exec::Split toVeloxSplit(
     const presto::protocol::ScheduledSplit& scheduledSplit) {
   const auto& connectorSplit = scheduledSplit.split.connectorSplit;
@@ -38,6 +49,17 @@ velox::exec::Split toVeloxSplit(
     return velox::exec::Split(nullptr, splitGroupId);
   }
 
+  if (auto directSplit =
+          std::dynamic_pointer_cast<const DirectVeloxSplit>(connectorSplit)) {
+    // Already decoded from its wire payload; materialize the velox split
+    // without an intermediate protocol struct tree.
+    return velox::exec::Split(
+        std::shared_ptr<velox::connector::ConnectorSplit>(directSplit->toVelox(
+            scheduledSplit.split.connectorId,
+            scheduledSplit.split.splitContext)),
+        splitGroupId);
+  }
+
   auto& connector = getPrestoToVeloxConnector(connectorSplit->_type);
   auto veloxSplit = connector.toVeloxSplit(
       scheduledSplit.split.connectorId,
@@ -46,4 +68,41 @@ velox::exec::Split toVeloxSplit(
   return velox::exec::Split(std::move(veloxSplit), splitGroupId);
 }
 
+std::vector<velox::exec::Split> toVeloxSplits(
+    const std::vector<presto::protocol::ScheduledSplit>& scheduledSplits,
+    folly::Executor* executor) {
+  std::vector<velox::exec::Split> splits(scheduledSplits.size());
+  if (executor == nullptr ||
+      scheduledSplits.size() < 2 * kMinSplitsPerConversionThread) {
+    for (size_t i = 0; i < scheduledSplits.size(); ++i) {
+      splits[i] = toVeloxSplit(scheduledSplits[i]);
+    }
+    return splits;
+  }
+
+  const size_t numChunks = std::min<size_t>(
+      std::thread::hardware_concurrency(),
+      (scheduledSplits.size() + kMinSplitsPerConversionThread - 1) /
+          kMinSplitsPerConversionThread);
+  const size_t chunkSize = (scheduledSplits.size() + numChunks - 1) / numChunks;
+  std::vector<folly::Future<folly::Unit>> futures;
+  futures.reserve(numChunks);
+  for (size_t start = 0; start < scheduledSplits.size(); start += chunkSize) {
+    const size_t end = std::min(start + chunkSize, scheduledSplits.size());
+    // Each chunk writes a disjoint range of 'splits', preserving the order of
+    // 'scheduledSplits'.
+    futures.push_back(
+        folly::via(executor, [&splits, &scheduledSplits, start, end]() {
+          for (size_t i = start; i < end; ++i) {
+            splits[i] = toVeloxSplit(scheduledSplits[i]);
+          }
+        }));
+  }
+  auto results = folly::collectAll(std::move(futures)).get();
+  for (auto& result : results) {
+    result.throwUnlessValue();
+  }
+  return splits;
+}
+
 } // namespace facebook::presto
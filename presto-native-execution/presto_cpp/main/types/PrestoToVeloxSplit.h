@@ -13,6 +13,8 @@
  */
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
 #include "velox/exec/Split.h"
 
@@ -23,4 +25,12 @@ namespace facebook::presto {
 velox::exec::Split toVeloxSplit(
     const presto::protocol::ScheduledSplit& scheduledSplit);
 
+// Converts a batch of protocol splits, in parallel chunks on 'executor' when
+// the batch is large enough to pay for the fan-out. The returned splits are in
+// the same order as 'scheduledSplits' so callers can add them to the task in
+// arrival order. Falls back to serial conversion when 'executor' is null.
+std::vector<velox::exec::Split> toVeloxSplits(
+    const std::vector<presto::protocol::ScheduledSplit>& scheduledSplits,
+    folly::Executor* executor);
+
 } // namespace facebook::presto
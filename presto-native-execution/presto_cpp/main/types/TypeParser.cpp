@@ -13,13 +13,73 @@
  */
 #include <boost/algorithm/string.hpp>
 #include <iostream>
+#include <list>
+#include <mutex>
 
 #include "presto_cpp/main/types/TypeParser.h"
 #include "velox/functions/prestosql/types/parser/TypeParser.h"
 
 #include "presto_cpp/main/common/Configs.h"
+#include "presto_cpp/main/common/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 
 namespace facebook::presto {
+namespace {
+
+// Process-wide interning cache from type signature string to parsed type.
+// Plans reference the same handful of distinct types from thousands of column
+// references, so parse results are shared across tasks and parser instances.
+// Bounded LRU, thread safe.
+class TypeSignatureCache {
+ public:
+  static TypeSignatureCache* instance() {
+    static std::unique_ptr<TypeSignatureCache> cache =
+        std::make_unique<TypeSignatureCache>();
+    return cache.get();
+  }
+
+  /// Returns the cached type for 'text' and marks it most recently used, or
+  /// nullptr if not cached.
+  velox::TypePtr get(const std::string& text) {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = types_.find(text);
+    if (it == types_.end()) {
+      return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+    return it->second.type;
+  }
+
+  /// Inserts 'type' under 'text', evicting the least recently used signature
+  /// when the cache is full.
+  void put(const std::string& text, const velox::TypePtr& type) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (types_.count(text) != 0) {
+      return;
+    }
+    if (types_.size() >= kCapacity) {
+      types_.erase(lru_.back());
+      lru_.pop_back();
+    }
+    lru_.push_front(text);
+    types_.emplace(text, CachedType{type, lru_.begin()});
+  }
+
+ private:
+  static constexpr size_t kCapacity = 4'096;
+
+  struct CachedType {
+    velox::TypePtr type;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  std::mutex mutex_;
+  // Most recently used signature at the front.
+  std::list<std::string> lru_;
+  std::unordered_map<std::string, CachedType> types_;
+};
+
+} // namespace
 
 velox::TypePtr TypeParser::parse(const std::string& text) const {
   if (SystemConfig::instance()->charNToVarcharImplicitCast()) {
@@ -38,7 +98,18 @@ velox::TypePtr TypeParser::parse(const std::string& text) const {
     return it->second;
   }
 
+  // Consult the shared cache before parsing so signatures already parsed by
+  // other tasks or parser instances are interned instead of re-parsed.
+  auto* sharedCache = TypeSignatureCache::instance();
+  if (auto type = sharedCache->get(text)) {
+    RECORD_METRIC_VALUE(kCounterTypeParserCacheHits);
+    cache_.insert({text, type});
+    return type;
+  }
+
   auto result = velox::functions::prestosql::parseType(text);
+  RECORD_METRIC_VALUE(kCounterTypeParserCacheMisses);
+  sharedCache->put(text, result);
   cache_.insert({text, result});
   return result;
 }
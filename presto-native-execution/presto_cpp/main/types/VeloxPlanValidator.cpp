@@ -13,22 +13,30 @@
  */
 
 #include "presto_cpp/main/types/VeloxPlanValidator.h"
+#include <folly/container/F14Set.h>
 #include "presto_cpp/main/common/Configs.h"
 
 namespace facebook::presto {
-bool planHasNestedJoinLoop(const velox::core::PlanNodePtr planNode) {
-  if (auto joinNode =
-          std::dynamic_pointer_cast<const velox::core::NestedLoopJoinNode>(
-              planNode)) {
-    return true;
-  }
-
-  for (auto plan : planNode->sources()) {
-    if (planHasNestedJoinLoop(plan)) {
+bool planHasNestedJoinLoop(const velox::core::PlanNodePtr& planNode) {
+  // Iterative walk with a visited set so subtrees shared between branches of
+  // deep plans (common with federated union plans) are checked once instead
+  // of once per referencing branch. Raw pointers avoid the shared_ptr
+  // refcount churn of the former recursive walk on large fragments.
+  std::vector<const velox::core::PlanNode*> stack{planNode.get()};
+  folly::F14FastSet<const velox::core::PlanNode*> visited;
+  while (!stack.empty()) {
+    const auto* node = stack.back();
+    stack.pop_back();
+    if (!visited.insert(node).second) {
+      continue;
+    }
+    if (dynamic_cast<const velox::core::NestedLoopJoinNode*>(node) != nullptr) {
       return true;
     }
+    for (const auto& source : node->sources()) {
+      stack.push_back(source.get());
+    }
   }
-
   return false;
 }
 
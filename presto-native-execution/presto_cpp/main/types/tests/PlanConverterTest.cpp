@@ -11,10 +11,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
 
+#include "presto_cpp/main/common/Configs.h"
 #include "presto_cpp/main/common/tests/test_json.h"
 #include "presto_cpp/main/connectors/HivePrestoToVeloxConnector.h"
+#include "presto_cpp/main/SessionProperties.h"
 #include "presto_cpp/main/operators/LocalShuffle.h"
 #include "presto_cpp/main/operators/PartitionAndSerialize.h"
 #include "presto_cpp/main/operators/ShuffleRead.h"
@@ -127,6 +130,52 @@ TEST_F(PlanConverterTest, scanAgg) {
   assertToVeloxQueryPlan("ScanAggCustomConnectorId.json");
 }
 
+// A filter directly above a table scan folds into the scan's remaining
+// filter when the query opts in via native_scan_filter_fusion_enabled.
+TEST_F(PlanConverterTest, scanFilterFusion) {
+  const std::string fragment =
+      slurp(test::utils::getDataPath("ScanFilterAgg.json"));
+  protocol::PlanFragment prestoPlan = json::parse(fragment);
+  auto pool = memory::deprecatedAddDefaultLeafMemoryPool();
+
+  auto convert = [&](bool fusionEnabled) {
+    std::unordered_map<std::string, std::string> config;
+    if (fusionEnabled) {
+      config[SessionProperties::kScanFilterFusionEnabled] = "true";
+    }
+    auto queryCtx =
+        core::QueryCtx::create(nullptr, core::QueryConfig(std::move(config)));
+    VeloxInteractiveQueryPlanConverter converter(queryCtx.get(), pool.get());
+    return converter
+        .toVeloxQueryPlan(
+            prestoPlan, nullptr, "20201107_130540_00011_wrpkw.1.2.3")
+        .planNode;
+  };
+
+  // Off by default: the filter stays a standalone node above the scan.
+  auto plan = convert(false);
+  auto filter = std::dynamic_pointer_cast<const core::FilterNode>(
+      plan->sources()[0]->sources()[0]->sources()[0]);
+  ASSERT_TRUE(filter != nullptr);
+  ASSERT_TRUE(
+      std::dynamic_pointer_cast<const core::TableScanNode>(
+          filter->sources()[0]) != nullptr);
+
+  // Opted in: the filter node disappears and its predicate lands in the
+  // scan's remaining filter.
+  plan = convert(true);
+  auto scan = std::dynamic_pointer_cast<const core::TableScanNode>(
+      plan->sources()[0]->sources()[0]->sources()[0]);
+  ASSERT_TRUE(scan != nullptr);
+  auto* handle = dynamic_cast<const connector::hive::HiveTableHandle*>(
+      scan->tableHandle().get());
+  ASSERT_TRUE(handle != nullptr);
+  ASSERT_TRUE(handle->remainingFilter() != nullptr);
+  ASSERT_NE(
+      handle->remainingFilter()->toString().find("regionkey"),
+      std::string::npos);
+}
+
 // Partitioned output with partitioned scheme over const key and a variable.
 TEST_F(PlanConverterTest, partitionedOutput) {
   std::shared_ptr<memory::MemoryPool> poolPtr =
@@ -152,6 +201,73 @@ TEST_F(PlanConverterTest, finalAgg) {
   assertToVeloxQueryPlan("FinalAgg.json");
 }
 
+// An aggregation directly above a shuffle read whose remote source carries an
+// ordering scheme covering the grouping keys becomes a streaming aggregation
+// when 'shuffle.streaming-aggregation-enabled' is set.
+TEST_F(PlanConverterTest, streamingAggregationOverSortedShuffle) {
+  auto makeVariable = [](const std::string& name) {
+    protocol::VariableReferenceExpression variable;
+    variable._type = "variable";
+    variable.name = name;
+    variable.type = "bigint";
+    return variable;
+  };
+
+  auto remoteSource = std::make_shared<protocol::RemoteSourceNode>();
+  remoteSource->id = "1";
+  remoteSource->outputVariables = {makeVariable("k"), makeVariable("v")};
+  remoteSource->exchangeType = protocol::ExchangeNodeType::REPARTITION;
+  remoteSource->orderingScheme = std::make_shared<protocol::OrderingScheme>();
+  protocol::Ordering ordering;
+  ordering.variable = makeVariable("k");
+  ordering.sortOrder = protocol::SortOrder::ASC_NULLS_FIRST;
+  remoteSource->orderingScheme->orderBy = {ordering};
+
+  auto aggregation = std::make_shared<protocol::AggregationNode>();
+  aggregation->id = "2";
+  aggregation->source = remoteSource;
+  aggregation->groupingSets.groupingSetCount = 1;
+  aggregation->groupingSets.groupingKeys = {makeVariable("k")};
+  aggregation->step = protocol::AggregationNodeStep::FINAL;
+
+  auto pool = memory::deprecatedAddDefaultLeafMemoryPool();
+  auto queryCtx = core::QueryCtx::create();
+  VeloxBatchQueryPlanConverter converter(
+      "local", nullptr, nullptr, queryCtx.get(), pool.get());
+
+  // Flag off: the coordinator did not pre-group and the conversion leaves the
+  // aggregation hash-based.
+  auto plan = converter.toVeloxQueryPlan(
+      aggregation, nullptr, "20201107_130540_00011_wrpkw.1.2.3");
+  auto* aggNode = dynamic_cast<const core::AggregationNode*>(plan.get());
+  ASSERT_NE(aggNode, nullptr);
+  ASSERT_TRUE(aggNode->preGroupedKeys().empty());
+
+  SystemConfig::instance()->setValue(
+      std::string(SystemConfig::kShuffleStreamingAggregationEnabled), "true");
+  SCOPE_EXIT {
+    SystemConfig::instance()->setValue(
+        std::string(SystemConfig::kShuffleStreamingAggregationEnabled),
+        "false");
+  };
+
+  plan = converter.toVeloxQueryPlan(
+      aggregation, nullptr, "20201107_130540_00011_wrpkw.1.2.3");
+  aggNode = dynamic_cast<const core::AggregationNode*>(plan.get());
+  ASSERT_NE(aggNode, nullptr);
+  ASSERT_EQ(aggNode->preGroupedKeys().size(), 1);
+  ASSERT_EQ(aggNode->preGroupedKeys()[0]->name(), "k");
+
+  // An ordering that does not cover the grouping keys keeps the hash
+  // aggregation.
+  remoteSource->orderingScheme->orderBy = {};
+  plan = converter.toVeloxQueryPlan(
+      aggregation, nullptr, "20201107_130540_00011_wrpkw.1.2.3");
+  aggNode = dynamic_cast<const core::AggregationNode*>(plan.get());
+  ASSERT_NE(aggNode, nullptr);
+  ASSERT_TRUE(aggNode->preGroupedKeys().empty());
+}
+
 // Last stage (output) plan for select regionkey, sum(1) from nation group by 1
 TEST_F(PlanConverterTest, output) {
   assertToVeloxQueryPlan("Output.json");
@@ -12,6 +12,7 @@
  * limitations under the License.
  */
 #include "presto_cpp/main/types/PrestoToVeloxSplit.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include "presto_cpp/main/connectors/HivePrestoToVeloxConnector.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
@@ -168,3 +169,28 @@ TEST_F(PrestoToVeloxSplitTest, bucketConversion) {
       veloxColumn->columnType(),
       connector::hive::HiveColumnHandle::ColumnType::kRegular);
 }
+
+TEST_F(PrestoToVeloxSplitTest, batchConversionPreservesOrder) {
+  // Large enough to take the parallel path.
+  constexpr size_t kNumSplits = 4096;
+  std::vector<protocol::ScheduledSplit> scheduledSplits;
+  scheduledSplits.reserve(kNumSplits);
+  for (size_t i = 0; i < kNumSplits; ++i) {
+    auto scheduledSplit = makeHiveScheduledSplit();
+    scheduledSplit.sequenceId = i;
+    auto& hiveSplit = static_cast<protocol::hive::HiveSplit&>(
+        *scheduledSplit.split.connectorSplit);
+    hiveSplit.fileSplit.path = fmt::format("/file/path/{}", i);
+    scheduledSplits.push_back(std::move(scheduledSplit));
+  }
+
+  folly::CPUThreadPoolExecutor executor(4);
+  auto veloxSplits = toVeloxSplits(scheduledSplits, &executor);
+  ASSERT_EQ(veloxSplits.size(), kNumSplits);
+  for (size_t i = 0; i < kNumSplits; ++i) {
+    const auto& veloxHiveSplit =
+        static_cast<const connector::hive::HiveConnectorSplit&>(
+            *veloxSplits[i].connectorSplit);
+    ASSERT_EQ(veloxHiveSplit.filePath, fmt::format("/file/path/{}", i));
+  }
+}
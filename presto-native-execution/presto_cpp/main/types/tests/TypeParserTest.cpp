@@ -67,3 +67,15 @@ TEST_F(TypeParserTest, parseEnumTypes) {
           "test.enum.mood:VarcharEnum(test.enum.mood{\"CURIOUS\":\"ONXW2ZKWMFWHKZI=\", \"HAPPY\":\"ONXW2ZJAOZQWY5LF\" , \"SAD\":\"KNHU2RJAKZAUYVKF\"})"),
       "Unsupported type: test.enum.mood:VarcharEnum(test.enum.mood{\"CURIOUS\":\"ONXW2ZKWMFWHKZI=\", \"HAPPY\":\"ONXW2ZJAOZQWY5LF\" , \"SAD\":\"KNHU2RJAKZAUYVKF\"})");
 }
+
+TEST_F(TypeParserTest, sharedSignatureCache) {
+  TypeParser parser1;
+  TypeParser parser2;
+
+  // Parse results are interned in a process-wide cache, so distinct parser
+  // instances return the same type instance for the same signature.
+  auto type1 = parser1.parse("map(varchar,array(bigint))");
+  auto type2 = parser2.parse("map(varchar,array(bigint))");
+  ASSERT_EQ(type1.get(), type2.get());
+  ASSERT_EQ(type1->toString(), "MAP<VARCHAR,ARRAY<BIGINT>>");
+}
@@ -12,7 +12,7 @@
  * limitations under the License.
  */
 #include "presto_cpp/presto_protocol/Base64Util.h"
-#include "velox/common/encode/Base64.h"
+#include <folly/base64.h>
 #include "velox/common/memory/ByteStream.h"
 #include "velox/serializers/PrestoSerializer.h"
 
@@ -28,11 +28,15 @@ std::unique_ptr<ByteInputStream> toByteStream(const std::string& input) {
 }
 } // namespace
 
+std::string decodeBase64(const std::string& encoded) {
+  return folly::base64Decode(encoded);
+}
+
 velox::VectorPtr readBlock(
     const velox::TypePtr& type,
     const std::string& base64Encoded,
     velox::memory::MemoryPool* pool) {
-  const std::string data = velox::encoding::Base64::decode(base64Encoded);
+  const std::string data = decodeBase64(base64Encoded);
 
   auto byteStream = toByteStream(data);
   VectorPtr result;
@@ -0,0 +1,240 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Benchmarks json parse and serialize of the protocol messages that dominate
+// the task-create path: TaskUpdateRequest, TaskSource (SplitAssignment on the
+// Java side) and TaskInfo. Payloads are built in code to mirror production
+// shapes: remote splits with realistic locations and task ids, an opaque plan
+// fragment blob and fully populated per-operator stats.
+//
+// Run with: presto_protocol_serde_benchmark --bm_min_usec=... .
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
+
+namespace facebook::presto::protocol {
+namespace {
+
+const std::string kQueryId = "20260831_120000_00001_abcde";
+
+TaskSource makeTaskSource(int32_t numSplits) {
+  TaskSource source;
+  source.planNodeId = "0";
+  source.splits.reserve(numSplits);
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto remoteSplit = std::make_shared<RemoteSplit>();
+    remoteSplit->location.location = fmt::format(
+        "http://192.168.{}.{}:8080/v1/task/{}.1.0.{}.0/results/0",
+        i / 250 % 250,
+        i % 250 + 1,
+        kQueryId,
+        i);
+    remoteSplit->remoteSourceTaskId = fmt::format("{}.1.0.{}.0", kQueryId, i);
+
+    ScheduledSplit scheduledSplit;
+    scheduledSplit.sequenceId = i;
+    scheduledSplit.planNodeId = "0";
+    scheduledSplit.split.connectorId = "$remote";
+    scheduledSplit.split.transactionHandle =
+        std::make_shared<RemoteTransactionHandle>();
+    scheduledSplit.split.connectorSplit = std::move(remoteSplit);
+    source.splits.push_back(std::move(scheduledSplit));
+  }
+  source.noMoreSplits = true;
+  return source;
+}
+
+TaskUpdateRequest makeTaskUpdateRequest(int32_t numSplits) {
+  TaskUpdateRequest request;
+  request.session.queryId = kQueryId;
+  request.session.user = "benchmark";
+  request.session.timeZoneKey = 2070;
+  request.session.locale = "en-US";
+  request.session.startTime = 1756636800000;
+  request.session.clientTags = {"interactive", "tier1"};
+  request.session.systemProperties = {
+      {"query_max_memory_per_node", "1GB"},
+      {"query_max_total_memory_per_node", "2GB"},
+      {"join_distribution_type", "AUTOMATIC"},
+      {"hash_partition_count", "100"},
+      {"optimize_hash_generation", "true"},
+      {"task_concurrency", "16"},
+      {"exchange_compression", "true"},
+      {"spill_enabled", "true"},
+  };
+  // Stands in for the base64 encoded plan fragment, which rides along as an
+  // opaque string at this layer.
+  request.fragment = std::make_shared<String>(std::string(8192, 'Q'));
+  request.sources.push_back(makeTaskSource(numSplits));
+  return request;
+}
+
+TaskInfo makeTaskInfo(int32_t numPipelines, int32_t numOperatorsPerPipeline) {
+  TaskInfo info;
+  info.taskId = fmt::format("{}.1.0.0.0", kQueryId);
+  info.nodeId = "worker-123";
+  info.taskStatus.state = TaskState::RUNNING;
+  info.taskStatus.self =
+      fmt::format("http://192.168.1.1:8080/v1/task/{}", info.taskId);
+  info.taskStatus.version = 42;
+  info.taskStatus.memoryReservationInBytes = 512LL << 20;
+  info.taskStatus.totalCpuTimeInNanos = 123'456'789'000;
+  info.stats.totalDrivers = numPipelines * 16;
+  info.stats.completedDrivers = numPipelines * 12;
+  info.stats.totalCpuTimeInNanos = 123'456'789'000;
+  info.stats.rawInputPositions = 1'000'000'000;
+  info.stats.rawInputDataSizeInBytes = 64LL << 30;
+  info.stats.pipelines.reserve(numPipelines);
+  for (int32_t pipelineId = 0; pipelineId < numPipelines; ++pipelineId) {
+    PipelineStats pipeline;
+    pipeline.pipelineId = pipelineId;
+    pipeline.inputPipeline = pipelineId == 0;
+    pipeline.outputPipeline = pipelineId == numPipelines - 1;
+    pipeline.totalDrivers = 16;
+    pipeline.completedDrivers = 12;
+    pipeline.operatorSummaries.reserve(numOperatorsPerPipeline);
+    for (int32_t operatorId = 0; operatorId < numOperatorsPerPipeline;
+         ++operatorId) {
+      OperatorStats op;
+      op.pipelineId = pipelineId;
+      op.operatorId = operatorId;
+      op.planNodeId = fmt::format("{}", pipelineId * 100 + operatorId);
+      op.operatorType = operatorId == 0 ? "TableScanOperator" : "FilterProject";
+      op.totalDrivers = 16;
+      op.addInputCalls = 10'000;
+      op.addInputWall = Duration(1.5, TimeUnit::SECONDS);
+      op.addInputCpu = Duration(1.2, TimeUnit::SECONDS);
+      op.getOutputCalls = 10'000;
+      op.getOutputWall = Duration(2.5, TimeUnit::SECONDS);
+      op.getOutputCpu = Duration(2.1, TimeUnit::SECONDS);
+      op.inputPositions = 10'000'000;
+      op.inputDataSizeInBytes = 1LL << 30;
+      op.outputPositions = 9'000'000;
+      op.outputDataSizeInBytes = 900LL << 20;
+      op.userMemoryReservationInBytes = 32LL << 20;
+      op.peakUserMemoryReservationInBytes = 64LL << 20;
+      for (int32_t metric = 0; metric < 10; ++metric) {
+        RuntimeMetric runtimeMetric;
+        runtimeMetric.name = fmt::format("runtimeMetric{}", metric);
+        runtimeMetric.sum = 1'000'000;
+        runtimeMetric.count = 1'000;
+        runtimeMetric.max = 10'000;
+        runtimeMetric.min = 10;
+        op.runtimeStats.emplace(runtimeMetric.name, runtimeMetric);
+      }
+      pipeline.operatorSummaries.push_back(std::move(op));
+    }
+    info.stats.pipelines.push_back(std::move(pipeline));
+  }
+  return info;
+}
+
+template <typename T>
+std::string toJsonString(const T& value) {
+  json j = value;
+  return j.dump();
+}
+
+template <typename T>
+void runParse(unsigned iters, const std::string& payload) {
+  for (unsigned i = 0; i < iters; ++i) {
+    T value = json::parse(payload);
+    folly::doNotOptimizeAway(value);
+  }
+}
+
+template <typename T>
+void runSerialize(unsigned iters, const T& value) {
+  for (unsigned i = 0; i < iters; ++i) {
+    json j = value;
+    auto payload = j.dump();
+    folly::doNotOptimizeAway(payload);
+  }
+}
+
+void parseTaskUpdateRequest(unsigned iters, int32_t numSplits) {
+  folly::BenchmarkSuspender suspender;
+  const auto payload = toJsonString(makeTaskUpdateRequest(numSplits));
+  suspender.dismiss();
+  runParse<TaskUpdateRequest>(iters, payload);
+}
+
+void serializeTaskUpdateRequest(unsigned iters, int32_t numSplits) {
+  folly::BenchmarkSuspender suspender;
+  const auto request = makeTaskUpdateRequest(numSplits);
+  suspender.dismiss();
+  runSerialize(iters, request);
+}
+
+void parseTaskSource(unsigned iters, int32_t numSplits) {
+  folly::BenchmarkSuspender suspender;
+  const auto payload = toJsonString(makeTaskSource(numSplits));
+  suspender.dismiss();
+  runParse<TaskSource>(iters, payload);
+}
+
+void serializeTaskSource(unsigned iters, int32_t numSplits) {
+  folly::BenchmarkSuspender suspender;
+  const auto source = makeTaskSource(numSplits);
+  suspender.dismiss();
+  runSerialize(iters, source);
+}
+
+void parseTaskInfo(unsigned iters, int32_t numPipelines) {
+  folly::BenchmarkSuspender suspender;
+  const auto payload = toJsonString(makeTaskInfo(numPipelines, 8));
+  suspender.dismiss();
+  runParse<TaskInfo>(iters, payload);
+}
+
+void serializeTaskInfo(unsigned iters, int32_t numPipelines) {
+  folly::BenchmarkSuspender suspender;
+  const auto info = makeTaskInfo(numPipelines, 8);
+  suspender.dismiss();
+  runSerialize(iters, info);
+}
+
+BENCHMARK_NAMED_PARAM(parseTaskUpdateRequest, 1kSplits, 1'000)
+BENCHMARK_NAMED_PARAM(parseTaskUpdateRequest, 10kSplits, 10'000)
+BENCHMARK_NAMED_PARAM(parseTaskUpdateRequest, 100kSplits, 100'000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(serializeTaskUpdateRequest, 1kSplits, 1'000)
+BENCHMARK_NAMED_PARAM(serializeTaskUpdateRequest, 10kSplits, 10'000)
+BENCHMARK_NAMED_PARAM(serializeTaskUpdateRequest, 100kSplits, 100'000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(parseTaskSource, 1kSplits, 1'000)
+BENCHMARK_NAMED_PARAM(parseTaskSource, 10kSplits, 10'000)
+BENCHMARK_NAMED_PARAM(parseTaskSource, 100kSplits, 100'000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(serializeTaskSource, 1kSplits, 1'000)
+BENCHMARK_NAMED_PARAM(serializeTaskSource, 10kSplits, 10'000)
+BENCHMARK_NAMED_PARAM(serializeTaskSource, 100kSplits, 100'000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(parseTaskInfo, 4Pipelines, 4)
+BENCHMARK_NAMED_PARAM(parseTaskInfo, 16Pipelines, 16)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(serializeTaskInfo, 4Pipelines, 4)
+BENCHMARK_NAMED_PARAM(serializeTaskInfo, 16Pipelines, 16)
+
+} // namespace
+} // namespace facebook::presto::protocol
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
@@ -18,6 +18,7 @@
 // This file is generated DO NOT EDIT @generated
 
 #include <iostream>
+#include <string_view>
 
 #include "presto_cpp/presto_protocol/connector/arrow_flight/presto_protocol_arrow_flight.h"
 using namespace std::string_literals;
@@ -18,16 +18,19 @@
 // This file is generated DO NOT EDIT @generated
 
 #include <iostream>
+#include <string_view>
 
 #include "presto_cpp/presto_protocol/connector/hive/presto_protocol_hive.h"
 using namespace std::string_literals;
 
 namespace facebook::presto::protocol::hive {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<ColumnType, json> ColumnType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<ColumnType, std::string_view>
+    ColumnType_enum_table[] = {
         {ColumnType::PARTITION_KEY, "PARTITION_KEY"},
         {ColumnType::REGULAR, "REGULAR"},
         {ColumnType::SYNTHESIZED, "SYNTHESIZED"},
@@ -37,7 +40,7 @@ void to_json(json& j, const ColumnType& e) {
   const auto* it = std::find_if(
       std::begin(ColumnType_enum_table),
       std::end(ColumnType_enum_table),
-      [e](const std::pair<ColumnType, json>& ej_pair) -> bool {
+      [e](const std::pair<ColumnType, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(ColumnType_enum_table))
@@ -50,8 +53,9 @@ void from_json(const json& j, ColumnType& e) {
   const auto* it = std::find_if(
       std::begin(ColumnType_enum_table),
       std::end(ColumnType_enum_table),
-      [&j](const std::pair<ColumnType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<ColumnType, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(ColumnType_enum_table))
            ? it
@@ -367,13 +371,14 @@ void from_json(const json& j, HiveBucketHandle& p) {
 } // namespace facebook::presto::protocol::hive
 namespace facebook::presto::protocol::hive {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<BucketFunctionType, json>
-    BucketFunctionType_enum_table[] =
-        { // NOLINT: cert-err58-cpp
-            {BucketFunctionType::HIVE_COMPATIBLE, "HIVE_COMPATIBLE"},
-            {BucketFunctionType::PRESTO_NATIVE, "PRESTO_NATIVE"}};
+static constexpr std::pair<BucketFunctionType, std::string_view>
+    BucketFunctionType_enum_table[] = {
+        {BucketFunctionType::HIVE_COMPATIBLE, "HIVE_COMPATIBLE"},
+        {BucketFunctionType::PRESTO_NATIVE, "PRESTO_NATIVE"}};
 void to_json(json& j, const BucketFunctionType& e) {
   static_assert(
       std::is_enum<BucketFunctionType>::value,
@@ -381,7 +386,8 @@ void to_json(json& j, const BucketFunctionType& e) {
   const auto* it = std::find_if(
       std::begin(BucketFunctionType_enum_table),
       std::end(BucketFunctionType_enum_table),
-      [e](const std::pair<BucketFunctionType, json>& ej_pair) -> bool {
+      [e](const std::pair<BucketFunctionType, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(BucketFunctionType_enum_table))
@@ -396,8 +402,10 @@ void from_json(const json& j, BucketFunctionType& e) {
   const auto* it = std::find_if(
       std::begin(BucketFunctionType_enum_table),
       std::end(BucketFunctionType_enum_table),
-      [&j](const std::pair<BucketFunctionType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<BucketFunctionType, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(BucketFunctionType_enum_table))
            ? it
@@ -407,18 +415,19 @@ void from_json(const json& j, BucketFunctionType& e) {
 } // namespace facebook::presto::protocol::hive
 namespace facebook::presto::protocol::hive {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<Order, json> Order_enum_table[] =
-    { // NOLINT: cert-err58-cpp
-        {Order::ASCENDING, "ASCENDING"},
-        {Order::DESCENDING, "DESCENDING"}};
+static constexpr std::pair<Order, std::string_view> Order_enum_table[] = {
+    {Order::ASCENDING, "ASCENDING"},
+    {Order::DESCENDING, "DESCENDING"}};
 void to_json(json& j, const Order& e) {
   static_assert(std::is_enum<Order>::value, "Order must be an enum!");
   const auto* it = std::find_if(
       std::begin(Order_enum_table),
       std::end(Order_enum_table),
-      [e](const std::pair<Order, json>& ej_pair) -> bool {
+      [e](const std::pair<Order, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(Order_enum_table)) ? it : std::begin(Order_enum_table))
@@ -429,8 +438,9 @@ void from_json(const json& j, Order& e) {
   const auto* it = std::find_if(
       std::begin(Order_enum_table),
       std::end(Order_enum_table),
-      [&j](const std::pair<Order, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<Order, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(Order_enum_table)) ? it : std::begin(Order_enum_table))
           ->first;
@@ -596,16 +606,17 @@ void from_json(const json& j, HiveFileSplit& p) {
 } // namespace facebook::presto::protocol::hive
 namespace facebook::presto::protocol::hive {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<HiveCompressionCodec, json>
-    HiveCompressionCodec_enum_table[] =
-        { // NOLINT: cert-err58-cpp
-            {HiveCompressionCodec::NONE, "NONE"},
-            {HiveCompressionCodec::SNAPPY, "SNAPPY"},
-            {HiveCompressionCodec::GZIP, "GZIP"},
-            {HiveCompressionCodec::LZ4, "LZ4"},
-            {HiveCompressionCodec::ZSTD, "ZSTD"}};
+static constexpr std::pair<HiveCompressionCodec, std::string_view>
+    HiveCompressionCodec_enum_table[] = {
+        {HiveCompressionCodec::NONE, "NONE"},
+        {HiveCompressionCodec::SNAPPY, "SNAPPY"},
+        {HiveCompressionCodec::GZIP, "GZIP"},
+        {HiveCompressionCodec::LZ4, "LZ4"},
+        {HiveCompressionCodec::ZSTD, "ZSTD"}};
 void to_json(json& j, const HiveCompressionCodec& e) {
   static_assert(
       std::is_enum<HiveCompressionCodec>::value,
@@ -613,7 +624,8 @@ void to_json(json& j, const HiveCompressionCodec& e) {
   const auto* it = std::find_if(
       std::begin(HiveCompressionCodec_enum_table),
       std::end(HiveCompressionCodec_enum_table),
-      [e](const std::pair<HiveCompressionCodec, json>& ej_pair) -> bool {
+      [e](const std::pair<HiveCompressionCodec, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(HiveCompressionCodec_enum_table))
@@ -628,8 +640,10 @@ void from_json(const json& j, HiveCompressionCodec& e) {
   const auto* it = std::find_if(
       std::begin(HiveCompressionCodec_enum_table),
       std::end(HiveCompressionCodec_enum_table),
-      [&j](const std::pair<HiveCompressionCodec, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<HiveCompressionCodec, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(HiveCompressionCodec_enum_table))
            ? it
@@ -639,10 +653,12 @@ void from_json(const json& j, HiveCompressionCodec& e) {
 } // namespace facebook::presto::protocol::hive
 namespace facebook::presto::protocol::hive {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<PrestoTableType, json> PrestoTableType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<PrestoTableType, std::string_view>
+    PrestoTableType_enum_table[] = {
         {PrestoTableType::MANAGED_TABLE, "MANAGED_TABLE"},
         {PrestoTableType::EXTERNAL_TABLE, "EXTERNAL_TABLE"},
         {PrestoTableType::VIRTUAL_VIEW, "VIRTUAL_VIEW"},
@@ -655,7 +671,7 @@ void to_json(json& j, const PrestoTableType& e) {
   const auto* it = std::find_if(
       std::begin(PrestoTableType_enum_table),
       std::end(PrestoTableType_enum_table),
-      [e](const std::pair<PrestoTableType, json>& ej_pair) -> bool {
+      [e](const std::pair<PrestoTableType, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(PrestoTableType_enum_table))
@@ -669,8 +685,10 @@ void from_json(const json& j, PrestoTableType& e) {
   const auto* it = std::find_if(
       std::begin(PrestoTableType_enum_table),
       std::end(PrestoTableType_enum_table),
-      [&j](const std::pair<PrestoTableType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<PrestoTableType, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(PrestoTableType_enum_table))
            ? it
@@ -900,8 +918,8 @@ void from_json(const json& j, HivePageSinkMetadata& p) {
 } // namespace facebook::presto::protocol::hive
 namespace facebook::presto::protocol::hive {
 
-static const std::pair<HiveStorageFormat, json> HiveStorageFormat_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<HiveStorageFormat, std::string_view>
+    HiveStorageFormat_enum_table[] = {
         {HiveStorageFormat::ORC, "ORC"},
         {HiveStorageFormat::DWRF, "DWRF"},
         {HiveStorageFormat::ALPHA, "ALPHA"},
@@ -922,7 +940,8 @@ void to_json(json& j, const HiveStorageFormat& p) {
   const auto* it = std::find_if(
       std::begin(HiveStorageFormat_enum_table),
       std::end(HiveStorageFormat_enum_table),
-      [&p](const std::pair<HiveStorageFormat, json>& ej_pair) -> bool {
+      [&p](const std::pair<HiveStorageFormat, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == p;
       });
   j = ((it != std::end(HiveStorageFormat_enum_table))
@@ -938,8 +957,10 @@ void from_json(const json& j, HiveStorageFormat& e) {
   const auto* it = std::find_if(
       std::begin(HiveStorageFormat_enum_table),
       std::end(HiveStorageFormat_enum_table),
-      [&j](const std::pair<HiveStorageFormat, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<HiveStorageFormat, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(HiveStorageFormat_enum_table))
            ? it
@@ -949,10 +970,12 @@ void from_json(const json& j, HiveStorageFormat& e) {
 } // namespace facebook::presto::protocol::hive
 namespace facebook::presto::protocol::hive {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<TableType, json> TableType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<TableType, std::string_view>
+    TableType_enum_table[] = {
         {TableType::NEW, "NEW"},
         {TableType::EXISTING, "EXISTING"},
         {TableType::TEMPORARY, "TEMPORARY"}};
@@ -961,7 +984,7 @@ void to_json(json& j, const TableType& e) {
   const auto* it = std::find_if(
       std::begin(TableType_enum_table),
       std::end(TableType_enum_table),
-      [e](const std::pair<TableType, json>& ej_pair) -> bool {
+      [e](const std::pair<TableType, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(TableType_enum_table))
@@ -974,8 +997,9 @@ void from_json(const json& j, TableType& e) {
   const auto* it = std::find_if(
       std::begin(TableType_enum_table),
       std::end(TableType_enum_table),
-      [&j](const std::pair<TableType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<TableType, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(TableType_enum_table))
            ? it
@@ -985,10 +1009,12 @@ void from_json(const json& j, TableType& e) {
 } // namespace facebook::presto::protocol::hive
 namespace facebook::presto::protocol::hive {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<WriteMode, json> WriteMode_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<WriteMode, std::string_view>
+    WriteMode_enum_table[] = {
         {WriteMode::STAGE_AND_MOVE_TO_TARGET_DIRECTORY,
          "STAGE_AND_MOVE_TO_TARGET_DIRECTORY"},
         {WriteMode::DIRECT_TO_TARGET_NEW_DIRECTORY,
@@ -1000,7 +1026,7 @@ void to_json(json& j, const WriteMode& e) {
   const auto* it = std::find_if(
       std::begin(WriteMode_enum_table),
       std::end(WriteMode_enum_table),
-      [e](const std::pair<WriteMode, json>& ej_pair) -> bool {
+      [e](const std::pair<WriteMode, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(WriteMode_enum_table))
@@ -1013,8 +1039,9 @@ void from_json(const json& j, WriteMode& e) {
   const auto* it = std::find_if(
       std::begin(WriteMode_enum_table),
       std::end(WriteMode_enum_table),
-      [&j](const std::pair<WriteMode, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<WriteMode, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(WriteMode_enum_table))
            ? it
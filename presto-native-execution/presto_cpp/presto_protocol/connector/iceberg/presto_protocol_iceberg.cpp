@@ -17,20 +17,23 @@
 
 // This file is generated DO NOT EDIT @generated
 
+#include <string_view>
+
 #include "presto_cpp/presto_protocol/connector/iceberg/presto_protocol_iceberg.h"
 using namespace std::string_literals;
 
 namespace facebook::presto::protocol::iceberg {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<ChangelogOperation, json>
-    ChangelogOperation_enum_table[] =
-        { // NOLINT: cert-err58-cpp
-            {ChangelogOperation::INSERT, "INSERT"},
-            {ChangelogOperation::DELETE, "DELETE"},
-            {ChangelogOperation::UPDATE_BEFORE, "UPDATE_BEFORE"},
-            {ChangelogOperation::UPDATE_AFTER, "UPDATE_AFTER"}};
+static constexpr std::pair<ChangelogOperation, std::string_view>
+    ChangelogOperation_enum_table[] = {
+        {ChangelogOperation::INSERT, "INSERT"},
+        {ChangelogOperation::DELETE, "DELETE"},
+        {ChangelogOperation::UPDATE_BEFORE, "UPDATE_BEFORE"},
+        {ChangelogOperation::UPDATE_AFTER, "UPDATE_AFTER"}};
 void to_json(json& j, const ChangelogOperation& e) {
   static_assert(
       std::is_enum<ChangelogOperation>::value,
@@ -38,7 +41,8 @@ void to_json(json& j, const ChangelogOperation& e) {
   const auto* it = std::find_if(
       std::begin(ChangelogOperation_enum_table),
       std::end(ChangelogOperation_enum_table),
-      [e](const std::pair<ChangelogOperation, json>& ej_pair) -> bool {
+      [e](const std::pair<ChangelogOperation, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(ChangelogOperation_enum_table))
@@ -53,8 +57,10 @@ void from_json(const json& j, ChangelogOperation& e) {
   const auto* it = std::find_if(
       std::begin(ChangelogOperation_enum_table),
       std::end(ChangelogOperation_enum_table),
-      [&j](const std::pair<ChangelogOperation, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<ChangelogOperation, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(ChangelogOperation_enum_table))
            ? it
@@ -64,10 +70,12 @@ void from_json(const json& j, ChangelogOperation& e) {
 } // namespace facebook::presto::protocol::iceberg
 namespace facebook::presto::protocol::iceberg {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<TypeCategory, json> TypeCategory_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<TypeCategory, std::string_view>
+    TypeCategory_enum_table[] = {
         {TypeCategory::PRIMITIVE, "PRIMITIVE"},
         {TypeCategory::STRUCT, "STRUCT"},
         {TypeCategory::ARRAY, "ARRAY"},
@@ -78,7 +86,7 @@ void to_json(json& j, const TypeCategory& e) {
   const auto* it = std::find_if(
       std::begin(TypeCategory_enum_table),
       std::end(TypeCategory_enum_table),
-      [e](const std::pair<TypeCategory, json>& ej_pair) -> bool {
+      [e](const std::pair<TypeCategory, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(TypeCategory_enum_table))
@@ -92,8 +100,9 @@ void from_json(const json& j, TypeCategory& e) {
   const auto* it = std::find_if(
       std::begin(TypeCategory_enum_table),
       std::end(TypeCategory_enum_table),
-      [&j](const std::pair<TypeCategory, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<TypeCategory, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(TypeCategory_enum_table))
            ? it
@@ -261,10 +270,12 @@ void from_json(const json& j, ChangelogSplitInfo& p) {
 } // namespace facebook::presto::protocol::iceberg
 namespace facebook::presto::protocol::iceberg {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<FileContent, json> FileContent_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<FileContent, std::string_view>
+    FileContent_enum_table[] = {
         {FileContent::DATA, "DATA"},
         {FileContent::POSITION_DELETES, "POSITION_DELETES"},
         {FileContent::EQUALITY_DELETES, "EQUALITY_DELETES"}};
@@ -274,7 +285,7 @@ void to_json(json& j, const FileContent& e) {
   const auto* it = std::find_if(
       std::begin(FileContent_enum_table),
       std::end(FileContent_enum_table),
-      [e](const std::pair<FileContent, json>& ej_pair) -> bool {
+      [e](const std::pair<FileContent, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(FileContent_enum_table))
@@ -288,8 +299,9 @@ void from_json(const json& j, FileContent& e) {
   const auto* it = std::find_if(
       std::begin(FileContent_enum_table),
       std::end(FileContent_enum_table),
-      [&j](const std::pair<FileContent, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<FileContent, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(FileContent_enum_table))
            ? it
@@ -299,10 +311,12 @@ void from_json(const json& j, FileContent& e) {
 } // namespace facebook::presto::protocol::iceberg
 namespace facebook::presto::protocol::iceberg {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<FileFormat, json> FileFormat_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<FileFormat, std::string_view>
+    FileFormat_enum_table[] = {
         {FileFormat::ORC, "ORC"},
         {FileFormat::PARQUET, "PARQUET"},
         {FileFormat::AVRO, "AVRO"},
@@ -312,7 +326,7 @@ void to_json(json& j, const FileFormat& e) {
   const auto* it = std::find_if(
       std::begin(FileFormat_enum_table),
       std::end(FileFormat_enum_table),
-      [e](const std::pair<FileFormat, json>& ej_pair) -> bool {
+      [e](const std::pair<FileFormat, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(FileFormat_enum_table))
@@ -325,8 +339,9 @@ void from_json(const json& j, FileFormat& e) {
   const auto* it = std::find_if(
       std::begin(FileFormat_enum_table),
       std::end(FileFormat_enum_table),
-      [&j](const std::pair<FileFormat, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<FileFormat, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(FileFormat_enum_table))
            ? it
@@ -446,10 +461,12 @@ void from_json(const json& j, std::shared_ptr<ColumnHandle>& p) {
 } // namespace facebook::presto::protocol::iceberg
 namespace facebook::presto::protocol::iceberg {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<IcebergTableType, json> IcebergTableType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<IcebergTableType, std::string_view>
+    IcebergTableType_enum_table[] = {
         {IcebergTableType::DATA, "DATA"},
         {IcebergTableType::HISTORY, "HISTORY"},
         {IcebergTableType::SNAPSHOTS, "SNAPSHOTS"},
@@ -470,7 +487,8 @@ void to_json(json& j, const IcebergTableType& e) {
   const auto* it = std::find_if(
       std::begin(IcebergTableType_enum_table),
       std::end(IcebergTableType_enum_table),
-      [e](const std::pair<IcebergTableType, json>& ej_pair) -> bool {
+      [e](const std::pair<IcebergTableType, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(IcebergTableType_enum_table))
@@ -485,8 +503,10 @@ void from_json(const json& j, IcebergTableType& e) {
   const auto* it = std::find_if(
       std::begin(IcebergTableType_enum_table),
       std::end(IcebergTableType_enum_table),
-      [&j](const std::pair<IcebergTableType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<IcebergTableType, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(IcebergTableType_enum_table))
            ? it
@@ -876,18 +896,19 @@ void from_json(const json& j, IcebergTableLayoutHandle& p) {
 } // namespace facebook::presto::protocol::iceberg
 namespace facebook::presto::protocol::iceberg {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<PartitionTransformType, json>
-    PartitionTransformType_enum_table[] =
-        { // NOLINT: cert-err58-cpp
-            {PartitionTransformType::IDENTITY, "IDENTITY"},
-            {PartitionTransformType::HOUR, "HOUR"},
-            {PartitionTransformType::DAY, "DAY"},
-            {PartitionTransformType::MONTH, "MONTH"},
-            {PartitionTransformType::YEAR, "YEAR"},
-            {PartitionTransformType::BUCKET, "BUCKET"},
-            {PartitionTransformType::TRUNCATE, "TRUNCATE"}};
+static constexpr std::pair<PartitionTransformType, std::string_view>
+    PartitionTransformType_enum_table[] = {
+        {PartitionTransformType::IDENTITY, "IDENTITY"},
+        {PartitionTransformType::HOUR, "HOUR"},
+        {PartitionTransformType::DAY, "DAY"},
+        {PartitionTransformType::MONTH, "MONTH"},
+        {PartitionTransformType::YEAR, "YEAR"},
+        {PartitionTransformType::BUCKET, "BUCKET"},
+        {PartitionTransformType::TRUNCATE, "TRUNCATE"}};
 void to_json(json& j, const PartitionTransformType& e) {
   static_assert(
       std::is_enum<PartitionTransformType>::value,
@@ -895,7 +916,8 @@ void to_json(json& j, const PartitionTransformType& e) {
   const auto* it = std::find_if(
       std::begin(PartitionTransformType_enum_table),
       std::end(PartitionTransformType_enum_table),
-      [e](const std::pair<PartitionTransformType, json>& ej_pair) -> bool {
+      [e](const std::pair<PartitionTransformType, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(PartitionTransformType_enum_table))
@@ -910,8 +932,10 @@ void from_json(const json& j, PartitionTransformType& e) {
   const auto* it = std::find_if(
       std::begin(PartitionTransformType_enum_table),
       std::end(PartitionTransformType_enum_table),
-      [&j](const std::pair<PartitionTransformType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<PartitionTransformType, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(PartitionTransformType_enum_table))
            ? it
@@ -17,6 +17,8 @@
 
 // This file is generated DO NOT EDIT @generated
 
+#include <string_view>
+
 #include "presto_cpp/presto_protocol/connector/tpch/presto_protocol_tpch.h"
 using namespace std::string_literals;
 
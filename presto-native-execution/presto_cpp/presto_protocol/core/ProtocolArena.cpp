@@ -0,0 +1,60 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/presto_protocol/core/ProtocolArena.h"
+
+#include <algorithm>
+
+namespace facebook::presto::protocol {
+
+void* ProtocolArena::allocate(size_t bytes, size_t align) {
+  auto* aligned = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(position_) + align - 1) & ~(align - 1));
+  if (position_ == nullptr || aligned + bytes > end_) {
+    const auto chunkBytes = std::max(bytes + align, kChunkBytes);
+    chunks_.push_back(std::make_unique<char[]>(chunkBytes));
+    position_ = chunks_.back().get();
+    end_ = position_ + chunkBytes;
+    aligned = reinterpret_cast<char*>(
+        (reinterpret_cast<uintptr_t>(position_) + align - 1) & ~(align - 1));
+  }
+  position_ = aligned + bytes;
+  return aligned;
+}
+
+// static
+std::shared_ptr<ProtocolArena>& ProtocolArena::currentSlot() {
+  thread_local std::shared_ptr<ProtocolArena> current;
+  return current;
+}
+
+// static
+const std::shared_ptr<ProtocolArena>& ProtocolArena::current() {
+  return currentSlot();
+}
+
+ScopedProtocolArena::ScopedProtocolArena(bool enabled) : enabled_(enabled) {
+  if (enabled_) {
+    auto& slot = ProtocolArena::currentSlot();
+    previous_ = std::move(slot);
+    slot = std::make_shared<ProtocolArena>();
+  }
+}
+
+ScopedProtocolArena::~ScopedProtocolArena() {
+  if (enabled_) {
+    ProtocolArena::currentSlot() = std::move(previous_);
+  }
+}
+
+} // namespace facebook::presto::protocol
@@ -0,0 +1,117 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace facebook::presto::protocol {
+
+/// Bump allocator backing the shared_ptr-wrapped protocol object graph
+/// decoded from a single request. Allocations are appended to chunked
+/// buffers and individual deallocations are no-ops; all chunks are released
+/// together when the last reference to the arena goes away. This replaces
+/// tens of thousands of malloc/free pairs per task update with a handful of
+/// chunk allocations.
+///
+/// The arena is activated for the current thread with ScopedProtocolArena
+/// and picked up by makeProtocolShared() below. Objects that escape the
+/// scope keep the arena alive through the allocator stored in their control
+/// blocks, so escaping pointers are safe, they just delay the wholesale
+/// release.
+class ProtocolArena {
+ public:
+  static constexpr size_t kChunkBytes = 64 << 10;
+
+  void* allocate(size_t bytes, size_t align);
+
+  /// Returns the arena active for the current thread, or nullptr.
+  static const std::shared_ptr<ProtocolArena>& current();
+
+ private:
+  friend class ScopedProtocolArena;
+
+  static std::shared_ptr<ProtocolArena>& currentSlot();
+
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  char* position_{nullptr};
+  char* end_{nullptr};
+};
+
+/// Activates a ProtocolArena for the current thread for the lifetime of this
+/// guard. Nested scopes restore the previous arena on destruction. When
+/// 'enabled' is false the guard is a no-op, which lets callers gate arena
+/// use on configuration without branching at every call site.
+class ScopedProtocolArena {
+ public:
+  explicit ScopedProtocolArena(bool enabled = true);
+  ~ScopedProtocolArena();
+
+  ScopedProtocolArena(const ScopedProtocolArena&) = delete;
+  ScopedProtocolArena& operator=(const ScopedProtocolArena&) = delete;
+
+ private:
+  std::shared_ptr<ProtocolArena> previous_;
+  const bool enabled_;
+};
+
+/// STL-compatible allocator drawing from a fixed ProtocolArena. Copies of
+/// the allocator (e.g. the one stored in a shared_ptr control block) share
+/// ownership of the arena, so the arena outlives every allocation made from
+/// it. deallocate() is a no-op; memory is reclaimed when the arena is
+/// destroyed.
+template <typename T>
+class ProtocolArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ProtocolArenaAllocator(std::shared_ptr<ProtocolArena> arena)
+      : arena_(std::move(arena)) {}
+
+  template <typename U>
+  /* implicit */ ProtocolArenaAllocator(const ProtocolArenaAllocator<U>& other)
+      : arena_(other.arena_) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* /*ptr*/, size_t /*n*/) noexcept {}
+
+  template <typename U>
+  bool operator==(const ProtocolArenaAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+
+  template <typename U>
+  bool operator!=(const ProtocolArenaAllocator<U>& other) const {
+    return !(*this == other);
+  }
+
+  std::shared_ptr<ProtocolArena> arena_;
+};
+
+/// Allocates a default-constructed T from the arena active on this thread,
+/// falling back to the global allocator when no arena scope is active. Used
+/// by the generated protocol from_json code for all shared_ptr fields.
+template <typename T>
+std::shared_ptr<T> makeProtocolShared() {
+  if (const auto& arena = ProtocolArena::current()) {
+    return std::allocate_shared<T>(ProtocolArenaAllocator<T>(arena));
+  }
+  return std::make_shared<T>();
+}
+
+} // namespace facebook::presto::protocol
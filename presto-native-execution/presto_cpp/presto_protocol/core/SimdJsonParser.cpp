@@ -0,0 +1,70 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/presto_protocol/core/SimdJsonParser.h"
+
+#include <simdjson.h>
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::presto::protocol {
+namespace {
+
+nlohmann::json toNlohmann(const simdjson::dom::element& element) {
+  switch (element.type()) {
+    case simdjson::dom::element_type::ARRAY: {
+      auto out = nlohmann::json::array();
+      for (const auto& child : element.get_array()) {
+        out.push_back(toNlohmann(child));
+      }
+      return out;
+    }
+    case simdjson::dom::element_type::OBJECT: {
+      auto out = nlohmann::json::object();
+      for (const auto& field : element.get_object()) {
+        out.emplace(std::string(field.key), toNlohmann(field.value));
+      }
+      return out;
+    }
+    case simdjson::dom::element_type::INT64:
+      return nlohmann::json(element.get_int64().value());
+    case simdjson::dom::element_type::UINT64:
+      return nlohmann::json(element.get_uint64().value());
+    case simdjson::dom::element_type::DOUBLE:
+      return nlohmann::json(element.get_double().value());
+    case simdjson::dom::element_type::STRING:
+      return nlohmann::json(std::string(element.get_string().value()));
+    case simdjson::dom::element_type::BOOL:
+      return nlohmann::json(element.get_bool().value());
+    case simdjson::dom::element_type::NULL_VALUE:
+    default:
+      return nlohmann::json(nullptr);
+  }
+}
+
+} // namespace
+
+nlohmann::json parseJson(std::string_view input) {
+  // The parser holds the document buffers; reuse it per thread to avoid
+  // re-allocating the internal tape on every request.
+  thread_local simdjson::dom::parser parser;
+  simdjson::dom::element root;
+  const auto error =
+      parser.parse(input.data(), input.size(), /*realloc_if_needed=*/true)
+          .get(root);
+  if (error != simdjson::SUCCESS) {
+    VELOX_USER_FAIL("JSON parse error: {}", simdjson::error_message(error));
+  }
+  return toNlohmann(root);
+}
+
+} // namespace facebook::presto::protocol
@@ -0,0 +1,163 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/presto_protocol/core/TaskStatusSerde.h"
+
+#include <charconv>
+
+#include <fmt/format.h>
+
+namespace facebook::presto::protocol {
+namespace {
+
+// Appends 'value' as a JSON string, escaping quotes, backslashes and control
+// characters. Non-ASCII bytes pass through unescaped, matching nlohmann's
+// default dump() behavior.
+void appendJsonString(std::string& out, const std::string& value) {
+  out += '"';
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\b':
+        out += "\\b";
+        break;
+      case '\f':
+        out += "\\f";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          fmt::format_to(
+              std::back_inserter(out),
+              "\\u{:04x}",
+              static_cast<unsigned char>(c));
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+template <typename T>
+void appendNumber(std::string& out, T value) {
+  char buffer[32];
+  const auto result =
+      std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.append(buffer, result.ptr - buffer);
+}
+
+// Matches TaskState_enum_table in the generated serde, including the fallback
+// to the first entry for unknown values.
+std::string_view taskStateString(TaskState state) {
+  switch (state) {
+    case TaskState::PLANNED:
+      return "PLANNED";
+    case TaskState::RUNNING:
+      return "RUNNING";
+    case TaskState::FINISHED:
+      return "FINISHED";
+    case TaskState::CANCELED:
+      return "CANCELED";
+    case TaskState::ABORTED:
+      return "ABORTED";
+    case TaskState::FAILED:
+      return "FAILED";
+  }
+  return "PLANNED";
+}
+
+template <typename T>
+void appendNumberField(std::string& out, std::string_view key, T value) {
+  out += ",\"";
+  out += key;
+  out += "\":";
+  appendNumber(out, value);
+}
+
+} // namespace
+
+std::string serializeTaskStatusJson(const TaskStatus& taskStatus) {
+  if (!taskStatus.completedDriverGroups.empty() ||
+      !taskStatus.failures.empty()) {
+    // Rare: lifespans and failure infos need the recursive generated serde.
+    const json statusJson = taskStatus;
+    return statusJson.dump();
+  }
+
+  std::string out;
+  out.reserve(768);
+  out += "{\"taskInstanceIdLeastSignificantBits\":";
+  appendNumber(out, taskStatus.taskInstanceIdLeastSignificantBits);
+  appendNumberField(
+      out,
+      "taskInstanceIdMostSignificantBits",
+      taskStatus.taskInstanceIdMostSignificantBits);
+  appendNumberField(out, "version", taskStatus.version);
+  out += ",\"state\":\"";
+  out += taskStateString(taskStatus.state);
+  out += "\",\"self\":";
+  appendJsonString(out, taskStatus.self);
+  out += ",\"completedDriverGroups\":[],\"failures\":[]";
+  appendNumberField(
+      out, "queuedPartitionedDrivers", taskStatus.queuedPartitionedDrivers);
+  appendNumberField(
+      out, "runningPartitionedDrivers", taskStatus.runningPartitionedDrivers);
+  appendNumberField(
+      out, "outputBufferUtilization", taskStatus.outputBufferUtilization);
+  out += ",\"outputBufferOverutilized\":";
+  out += taskStatus.outputBufferOverutilized ? "true" : "false";
+  appendNumberField(
+      out,
+      "physicalWrittenDataSizeInBytes",
+      taskStatus.physicalWrittenDataSizeInBytes);
+  appendNumberField(
+      out, "memoryReservationInBytes", taskStatus.memoryReservationInBytes);
+  appendNumberField(
+      out,
+      "systemMemoryReservationInBytes",
+      taskStatus.systemMemoryReservationInBytes);
+  appendNumberField(
+      out,
+      "peakNodeTotalMemoryReservationInBytes",
+      taskStatus.peakNodeTotalMemoryReservationInBytes);
+  appendNumberField(out, "fullGcCount", taskStatus.fullGcCount);
+  appendNumberField(out, "fullGcTimeInMillis", taskStatus.fullGcTimeInMillis);
+  appendNumberField(out, "totalCpuTimeInNanos", taskStatus.totalCpuTimeInNanos);
+  appendNumberField(out, "taskAgeInMillis", taskStatus.taskAgeInMillis);
+  appendNumberField(
+      out,
+      "queuedPartitionedSplitsWeight",
+      taskStatus.queuedPartitionedSplitsWeight);
+  appendNumberField(
+      out,
+      "runningPartitionedSplitsWeight",
+      taskStatus.runningPartitionedSplitsWeight);
+  out += '}';
+  return out;
+}
+
+} // namespace facebook::presto::protocol
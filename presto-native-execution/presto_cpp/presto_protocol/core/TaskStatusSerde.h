@@ -0,0 +1,33 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+
+#include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
+
+namespace facebook::presto::protocol {
+
+/// Serializes 'taskStatus' straight to a JSON string without building a
+/// nlohmann DOM: fields are written in the same order as the generated
+/// to_json(), keys are emitted as literals and numbers are formatted with
+/// std::to_chars. TaskStatus is the message the worker serializes most often
+/// (once per coordinator status poll per task), so it gets a hand-written
+/// writer alongside the generated serde. Statuses carrying failures or
+/// completed driver groups fall back to the generated nlohmann serde, which
+/// handles the recursive types. The output is wire-compatible with the
+/// generated serde.
+std::string serializeTaskStatusJson(const TaskStatus& taskStatus);
+
+} // namespace facebook::presto::protocol
@@ -19,6 +19,7 @@
 
 #include <folly/Format.h>
 #include <iostream>
+#include <string_view>
 
 #include "presto_cpp/presto_protocol/core/ConnectorProtocol.h"
 #include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
@@ -35,12 +36,11 @@ namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<NodeSelectionStrategy, json>
-    NodeSelectionStrategy_enum_table[] =
-        { // NOLINT: cert-err58-cpp
-            {NodeSelectionStrategy::HARD_AFFINITY, "HARD_AFFINITY"},
-            {NodeSelectionStrategy::SOFT_AFFINITY, "SOFT_AFFINITY"},
-            {NodeSelectionStrategy::NO_PREFERENCE, "NO_PREFERENCE"}};
+static constexpr std::pair<NodeSelectionStrategy, std::string_view>
+    NodeSelectionStrategy_enum_table[] = {
+        {NodeSelectionStrategy::HARD_AFFINITY, "HARD_AFFINITY"},
+        {NodeSelectionStrategy::SOFT_AFFINITY, "SOFT_AFFINITY"},
+        {NodeSelectionStrategy::NO_PREFERENCE, "NO_PREFERENCE"}};
 void to_json(json& j, const NodeSelectionStrategy& e) {
   static_assert(
       std::is_enum<NodeSelectionStrategy>::value,
@@ -48,7 +48,8 @@ void to_json(json& j, const NodeSelectionStrategy& e) {
   const auto* it = std::find_if(
       std::begin(NodeSelectionStrategy_enum_table),
       std::end(NodeSelectionStrategy_enum_table),
-      [e](const std::pair<NodeSelectionStrategy, json>& ej_pair) -> bool {
+      [e](const std::pair<NodeSelectionStrategy, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(NodeSelectionStrategy_enum_table))
@@ -63,8 +64,10 @@ void from_json(const json& j, NodeSelectionStrategy& e) {
   const auto* it = std::find_if(
       std::begin(NodeSelectionStrategy_enum_table),
       std::end(NodeSelectionStrategy_enum_table),
-      [&j](const std::pair<NodeSelectionStrategy, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<NodeSelectionStrategy, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(NodeSelectionStrategy_enum_table))
            ? it
@@ -346,10 +349,12 @@ void from_json(const json& j, CallExpression& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<SortOrder, json> SortOrder_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<SortOrder, std::string_view>
+    SortOrder_enum_table[] = {
         {SortOrder::ASC_NULLS_FIRST, "ASC_NULLS_FIRST"},
         {SortOrder::ASC_NULLS_LAST, "ASC_NULLS_LAST"},
         {SortOrder::DESC_NULLS_FIRST, "DESC_NULLS_FIRST"},
@@ -359,7 +364,7 @@ void to_json(json& j, const SortOrder& e) {
   const auto* it = std::find_if(
       std::begin(SortOrder_enum_table),
       std::end(SortOrder_enum_table),
-      [e](const std::pair<SortOrder, json>& ej_pair) -> bool {
+      [e](const std::pair<SortOrder, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(SortOrder_enum_table))
@@ -372,8 +377,9 @@ void from_json(const json& j, SortOrder& e) {
   const auto* it = std::find_if(
       std::begin(SortOrder_enum_table),
       std::end(SortOrder_enum_table),
-      [&j](const std::pair<SortOrder, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<SortOrder, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(SortOrder_enum_table))
            ? it
@@ -558,15 +564,16 @@ void from_json(const json& j, AggregationFunctionMetadata& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<AggregationNodeStep, json>
-    AggregationNodeStep_enum_table[] =
-        { // NOLINT: cert-err58-cpp
-            {AggregationNodeStep::PARTIAL, "PARTIAL"},
-            {AggregationNodeStep::FINAL, "FINAL"},
-            {AggregationNodeStep::INTERMEDIATE, "INTERMEDIATE"},
-            {AggregationNodeStep::SINGLE, "SINGLE"}};
+static constexpr std::pair<AggregationNodeStep, std::string_view>
+    AggregationNodeStep_enum_table[] = {
+        {AggregationNodeStep::PARTIAL, "PARTIAL"},
+        {AggregationNodeStep::FINAL, "FINAL"},
+        {AggregationNodeStep::INTERMEDIATE, "INTERMEDIATE"},
+        {AggregationNodeStep::SINGLE, "SINGLE"}};
 void to_json(json& j, const AggregationNodeStep& e) {
   static_assert(
       std::is_enum<AggregationNodeStep>::value,
@@ -574,7 +581,8 @@ void to_json(json& j, const AggregationNodeStep& e) {
   const auto* it = std::find_if(
       std::begin(AggregationNodeStep_enum_table),
       std::end(AggregationNodeStep_enum_table),
-      [e](const std::pair<AggregationNodeStep, json>& ej_pair) -> bool {
+      [e](const std::pair<AggregationNodeStep, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(AggregationNodeStep_enum_table))
@@ -589,8 +597,10 @@ void from_json(const json& j, AggregationNodeStep& e) {
   const auto* it = std::find_if(
       std::begin(AggregationNodeStep_enum_table),
       std::end(AggregationNodeStep_enum_table),
-      [&j](const std::pair<AggregationNodeStep, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<AggregationNodeStep, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(AggregationNodeStep_enum_table))
            ? it
@@ -1334,10 +1344,12 @@ void from_json(const json& j, BaseInputDistribution& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<BufferType, json> BufferType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<BufferType, std::string_view>
+    BufferType_enum_table[] = {
         {BufferType::PARTITIONED, "PARTITIONED"},
         {BufferType::BROADCAST, "BROADCAST"},
         {BufferType::ARBITRARY, "ARBITRARY"},
@@ -1348,7 +1360,7 @@ void to_json(json& j, const BufferType& e) {
   const auto* it = std::find_if(
       std::begin(BufferType_enum_table),
       std::end(BufferType_enum_table),
-      [e](const std::pair<BufferType, json>& ej_pair) -> bool {
+      [e](const std::pair<BufferType, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(BufferType_enum_table))
@@ -1361,8 +1373,9 @@ void from_json(const json& j, BufferType& e) {
   const auto* it = std::find_if(
       std::begin(BufferType_enum_table),
       std::end(BufferType_enum_table),
-      [&j](const std::pair<BufferType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<BufferType, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(BufferType_enum_table))
            ? it
@@ -1498,10 +1511,12 @@ void from_json(const json& j, ResourceEstimates& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<SelectedRoleType, json> SelectedRoleType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<SelectedRoleType, std::string_view>
+    SelectedRoleType_enum_table[] = {
         {SelectedRoleType::ROLE, "ROLE"},
         {SelectedRoleType::ALL, "ALL"},
         {SelectedRoleType::NONE, "NONE"}};
@@ -1512,7 +1527,8 @@ void to_json(json& j, const SelectedRoleType& e) {
   const auto* it = std::find_if(
       std::begin(SelectedRoleType_enum_table),
       std::end(SelectedRoleType_enum_table),
-      [e](const std::pair<SelectedRoleType, json>& ej_pair) -> bool {
+      [e](const std::pair<SelectedRoleType, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(SelectedRoleType_enum_table))
@@ -1527,8 +1543,10 @@ void from_json(const json& j, SelectedRoleType& e) {
   const auto* it = std::find_if(
       std::begin(SelectedRoleType_enum_table),
       std::end(SelectedRoleType_enum_table),
-      [&j](const std::pair<SelectedRoleType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<SelectedRoleType, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(SelectedRoleType_enum_table))
            ? it
@@ -1564,20 +1582,21 @@ void from_json(const json& j, Parameter& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<Determinism, json> Determinism_enum_table[] = {
-    // NOLINT: cert-err58-cpp
-    {Determinism::DETERMINISTIC, "DETERMINISTIC"},
-    {Determinism::NOT_DETERMINISTIC, "NOT_DETERMINISTIC"},
-};
+static constexpr std::pair<Determinism, std::string_view>
+    Determinism_enum_table[] = {
+        {Determinism::DETERMINISTIC, "DETERMINISTIC"},
+        {Determinism::NOT_DETERMINISTIC, "NOT_DETERMINISTIC"}};
 void to_json(json& j, const Determinism& e) {
   static_assert(
       std::is_enum<Determinism>::value, "Determinism must be an enum!");
   const auto* it = std::find_if(
       std::begin(Determinism_enum_table),
       std::end(Determinism_enum_table),
-      [e](const std::pair<Determinism, json>& ej_pair) -> bool {
+      [e](const std::pair<Determinism, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(Determinism_enum_table))
@@ -1591,8 +1610,9 @@ void from_json(const json& j, Determinism& e) {
   const auto* it = std::find_if(
       std::begin(Determinism_enum_table),
       std::end(Determinism_enum_table),
-      [&j](const std::pair<Determinism, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<Determinism, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(Determinism_enum_table))
            ? it
@@ -1615,10 +1635,12 @@ void from_json(const json& j, Language& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<NullCallClause, json> NullCallClause_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<NullCallClause, std::string_view>
+    NullCallClause_enum_table[] = {
         {NullCallClause::RETURNS_NULL_ON_NULL_INPUT,
          "RETURNS_NULL_ON_NULL_INPUT"},
         {NullCallClause::CALLED_ON_NULL_INPUT, "CALLED_ON_NULL_INPUT"}};
@@ -1628,7 +1650,7 @@ void to_json(json& j, const NullCallClause& e) {
   const auto* it = std::find_if(
       std::begin(NullCallClause_enum_table),
       std::end(NullCallClause_enum_table),
-      [e](const std::pair<NullCallClause, json>& ej_pair) -> bool {
+      [e](const std::pair<NullCallClause, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(NullCallClause_enum_table))
@@ -1642,8 +1664,9 @@ void from_json(const json& j, NullCallClause& e) {
   const auto* it = std::find_if(
       std::begin(NullCallClause_enum_table),
       std::end(NullCallClause_enum_table),
-      [&j](const std::pair<NullCallClause, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<NullCallClause, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(NullCallClause_enum_table))
            ? it
@@ -1704,10 +1727,12 @@ void from_json(const json& j, RoutineCharacteristics& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<FunctionKind, json> FunctionKind_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<FunctionKind, std::string_view>
+    FunctionKind_enum_table[] = {
         {FunctionKind::SCALAR, "SCALAR"},
         {FunctionKind::AGGREGATE, "AGGREGATE"},
         {FunctionKind::WINDOW, "WINDOW"}};
@@ -1717,7 +1742,7 @@ void to_json(json& j, const FunctionKind& e) {
   const auto* it = std::find_if(
       std::begin(FunctionKind_enum_table),
       std::end(FunctionKind_enum_table),
-      [e](const std::pair<FunctionKind, json>& ej_pair) -> bool {
+      [e](const std::pair<FunctionKind, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(FunctionKind_enum_table))
@@ -1731,8 +1756,9 @@ void from_json(const json& j, FunctionKind& e) {
   const auto* it = std::find_if(
       std::begin(FunctionKind_enum_table),
       std::end(FunctionKind_enum_table),
-      [&j](const std::pair<FunctionKind, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<FunctionKind, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(FunctionKind_enum_table))
            ? it
@@ -2844,14 +2870,15 @@ void from_json(const json& j, BufferInfo& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<BuiltInFunctionKind, json>
-    BuiltInFunctionKind_enum_table[] =
-        { // NOLINT: cert-err58-cpp
-            {BuiltInFunctionKind::ENGINE, "ENGINE"},
-            {BuiltInFunctionKind::PLUGIN, "PLUGIN"},
-            {BuiltInFunctionKind::WORKER, "WORKER"}};
+static constexpr std::pair<BuiltInFunctionKind, std::string_view>
+    BuiltInFunctionKind_enum_table[] = {
+        {BuiltInFunctionKind::ENGINE, "ENGINE"},
+        {BuiltInFunctionKind::PLUGIN, "PLUGIN"},
+        {BuiltInFunctionKind::WORKER, "WORKER"}};
 void to_json(json& j, const BuiltInFunctionKind& e) {
   static_assert(
       std::is_enum<BuiltInFunctionKind>::value,
@@ -2859,7 +2886,8 @@ void to_json(json& j, const BuiltInFunctionKind& e) {
   const auto* it = std::find_if(
       std::begin(BuiltInFunctionKind_enum_table),
       std::end(BuiltInFunctionKind_enum_table),
-      [e](const std::pair<BuiltInFunctionKind, json>& ej_pair) -> bool {
+      [e](const std::pair<BuiltInFunctionKind, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(BuiltInFunctionKind_enum_table))
@@ -2874,8 +2902,10 @@ void from_json(const json& j, BuiltInFunctionKind& e) {
   const auto* it = std::find_if(
       std::begin(BuiltInFunctionKind_enum_table),
       std::end(BuiltInFunctionKind_enum_table),
-      [&j](const std::pair<BuiltInFunctionKind, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<BuiltInFunctionKind, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(BuiltInFunctionKind_enum_table))
            ? it
@@ -2927,10 +2957,12 @@ void from_json(const json& j, BuiltInFunctionHandle& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<CacheQuotaScope, json> CacheQuotaScope_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<CacheQuotaScope, std::string_view>
+    CacheQuotaScope_enum_table[] = {
         {CacheQuotaScope::GLOBAL, "GLOBAL"},
         {CacheQuotaScope::SCHEMA, "SCHEMA"},
         {CacheQuotaScope::TABLE, "TABLE"},
@@ -2941,7 +2973,7 @@ void to_json(json& j, const CacheQuotaScope& e) {
   const auto* it = std::find_if(
       std::begin(CacheQuotaScope_enum_table),
       std::end(CacheQuotaScope_enum_table),
-      [e](const std::pair<CacheQuotaScope, json>& ej_pair) -> bool {
+      [e](const std::pair<CacheQuotaScope, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(CacheQuotaScope_enum_table))
@@ -2955,8 +2987,10 @@ void from_json(const json& j, CacheQuotaScope& e) {
   const auto* it = std::find_if(
       std::begin(CacheQuotaScope_enum_table),
       std::end(CacheQuotaScope_enum_table),
-      [&j](const std::pair<CacheQuotaScope, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<CacheQuotaScope, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(CacheQuotaScope_enum_table))
            ? it
@@ -2993,10 +3027,12 @@ void from_json(const json& j, CacheQuotaRequirement& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<ExchangeEncoding, json> ExchangeEncoding_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<ExchangeEncoding, std::string_view>
+    ExchangeEncoding_enum_table[] = {
         {ExchangeEncoding::COLUMNAR, "COLUMNAR"},
         {ExchangeEncoding::ROW_WISE, "ROW_WISE"}};
 void to_json(json& j, const ExchangeEncoding& e) {
@@ -3006,7 +3042,8 @@ void to_json(json& j, const ExchangeEncoding& e) {
   const auto* it = std::find_if(
       std::begin(ExchangeEncoding_enum_table),
       std::end(ExchangeEncoding_enum_table),
-      [e](const std::pair<ExchangeEncoding, json>& ej_pair) -> bool {
+      [e](const std::pair<ExchangeEncoding, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(ExchangeEncoding_enum_table))
@@ -3021,8 +3058,10 @@ void from_json(const json& j, ExchangeEncoding& e) {
   const auto* it = std::find_if(
       std::begin(ExchangeEncoding_enum_table),
       std::end(ExchangeEncoding_enum_table),
-      [&j](const std::pair<ExchangeEncoding, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<ExchangeEncoding, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(ExchangeEncoding_enum_table))
            ? it
@@ -4037,10 +4076,12 @@ void from_json(const json& j, Domain& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<BlockedReason, json> BlockedReason_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<BlockedReason, std::string_view>
+    BlockedReason_enum_table[] = {
         {BlockedReason::WAITING_FOR_MEMORY, "WAITING_FOR_MEMORY"}};
 void to_json(json& j, const BlockedReason& e) {
   static_assert(
@@ -4048,7 +4089,7 @@ void to_json(json& j, const BlockedReason& e) {
   const auto* it = std::find_if(
       std::begin(BlockedReason_enum_table),
       std::end(BlockedReason_enum_table),
-      [e](const std::pair<BlockedReason, json>& ej_pair) -> bool {
+      [e](const std::pair<BlockedReason, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(BlockedReason_enum_table))
@@ -4062,8 +4103,9 @@ void from_json(const json& j, BlockedReason& e) {
   const auto* it = std::find_if(
       std::begin(BlockedReason_enum_table),
       std::end(BlockedReason_enum_table),
-      [&j](const std::pair<BlockedReason, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<BlockedReason, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(BlockedReason_enum_table))
            ? it
@@ -5163,10 +5205,12 @@ void from_json(const json& j, EquiJoinClause& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<ErrorType, json> ErrorType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<ErrorType, std::string_view>
+    ErrorType_enum_table[] = {
         {ErrorType::USER_ERROR, "USER_ERROR"},
         {ErrorType::INTERNAL_ERROR, "INTERNAL_ERROR"},
         {ErrorType::INSUFFICIENT_RESOURCES, "INSUFFICIENT_RESOURCES"},
@@ -5176,7 +5220,7 @@ void to_json(json& j, const ErrorType& e) {
   const auto* it = std::find_if(
       std::begin(ErrorType_enum_table),
       std::end(ErrorType_enum_table),
-      [e](const std::pair<ErrorType, json>& ej_pair) -> bool {
+      [e](const std::pair<ErrorType, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(ErrorType_enum_table))
@@ -5189,8 +5233,9 @@ void from_json(const json& j, ErrorType& e) {
   const auto* it = std::find_if(
       std::begin(ErrorType_enum_table),
       std::end(ErrorType_enum_table),
-      [&j](const std::pair<ErrorType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<ErrorType, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(ErrorType_enum_table))
            ? it
@@ -5244,10 +5289,12 @@ void from_json(const json& j, ErrorLocation& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<ExchangeNodeScope, json> ExchangeNodeScope_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<ExchangeNodeScope, std::string_view>
+    ExchangeNodeScope_enum_table[] = {
         {ExchangeNodeScope::LOCAL, "LOCAL"},
         {ExchangeNodeScope::REMOTE_STREAMING, "REMOTE_STREAMING"},
         {ExchangeNodeScope::REMOTE_MATERIALIZED, "REMOTE_MATERIALIZED"}};
@@ -5258,7 +5305,8 @@ void to_json(json& j, const ExchangeNodeScope& e) {
   const auto* it = std::find_if(
       std::begin(ExchangeNodeScope_enum_table),
       std::end(ExchangeNodeScope_enum_table),
-      [e](const std::pair<ExchangeNodeScope, json>& ej_pair) -> bool {
+      [e](const std::pair<ExchangeNodeScope, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(ExchangeNodeScope_enum_table))
@@ -5273,8 +5321,10 @@ void from_json(const json& j, ExchangeNodeScope& e) {
   const auto* it = std::find_if(
       std::begin(ExchangeNodeScope_enum_table),
       std::end(ExchangeNodeScope_enum_table),
-      [&j](const std::pair<ExchangeNodeScope, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<ExchangeNodeScope, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(ExchangeNodeScope_enum_table))
            ? it
@@ -5284,14 +5334,15 @@ void from_json(const json& j, ExchangeNodeScope& e) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<ExchangeNodeType, json> ExchangeNodeType_enum_table[] = {
-    // NOLINT: cert-err58-cpp
-    {ExchangeNodeType::GATHER, "GATHER"},
-    {ExchangeNodeType::REPARTITION, "REPARTITION"},
-    {ExchangeNodeType::REPLICATE, "REPLICATE"},
-};
+static constexpr std::pair<ExchangeNodeType, std::string_view>
+    ExchangeNodeType_enum_table[] = {
+        {ExchangeNodeType::GATHER, "GATHER"},
+        {ExchangeNodeType::REPARTITION, "REPARTITION"},
+        {ExchangeNodeType::REPLICATE, "REPLICATE"}};
 void to_json(json& j, const ExchangeNodeType& e) {
   static_assert(
       std::is_enum<ExchangeNodeType>::value,
@@ -5299,7 +5350,8 @@ void to_json(json& j, const ExchangeNodeType& e) {
   const auto* it = std::find_if(
       std::begin(ExchangeNodeType_enum_table),
       std::end(ExchangeNodeType_enum_table),
-      [e](const std::pair<ExchangeNodeType, json>& ej_pair) -> bool {
+      [e](const std::pair<ExchangeNodeType, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(ExchangeNodeType_enum_table))
@@ -5314,8 +5366,10 @@ void from_json(const json& j, ExchangeNodeType& e) {
   const auto* it = std::find_if(
       std::begin(ExchangeNodeType_enum_table),
       std::end(ExchangeNodeType_enum_table),
-      [&j](const std::pair<ExchangeNodeType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<ExchangeNodeType, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(ExchangeNodeType_enum_table))
            ? it
@@ -5473,10 +5527,12 @@ void from_json(const json& j, ExecuteProcedureHandle& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<ErrorCause, json> ErrorCause_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<ErrorCause, std::string_view>
+    ErrorCause_enum_table[] = {
         {ErrorCause::UNKNOWN, "UNKNOWN"},
         {ErrorCause::LOW_PARTITION_COUNT, "LOW_PARTITION_COUNT"},
         {ErrorCause::EXCEEDS_BROADCAST_MEMORY_LIMIT,
@@ -5486,7 +5542,7 @@ void to_json(json& j, const ErrorCause& e) {
   const auto* it = std::find_if(
       std::begin(ErrorCause_enum_table),
       std::end(ErrorCause_enum_table),
-      [e](const std::pair<ErrorCause, json>& ej_pair) -> bool {
+      [e](const std::pair<ErrorCause, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(ErrorCause_enum_table))
@@ -5499,8 +5555,9 @@ void from_json(const json& j, ErrorCause& e) {
   const auto* it = std::find_if(
       std::begin(ErrorCause_enum_table),
       std::end(ErrorCause_enum_table),
-      [&j](const std::pair<ErrorCause, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<ErrorCause, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(ErrorCause_enum_table))
            ? it
@@ -5635,10 +5692,12 @@ void from_json(const json& j, FilterNode& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<BoundType, json> BoundType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<BoundType, std::string_view>
+    BoundType_enum_table[] = {
         {BoundType::UNBOUNDED_PRECEDING, "UNBOUNDED_PRECEDING"},
         {BoundType::PRECEDING, "PRECEDING"},
         {BoundType::CURRENT_ROW, "CURRENT_ROW"},
@@ -5649,7 +5708,7 @@ void to_json(json& j, const BoundType& e) {
   const auto* it = std::find_if(
       std::begin(BoundType_enum_table),
       std::end(BoundType_enum_table),
-      [e](const std::pair<BoundType, json>& ej_pair) -> bool {
+      [e](const std::pair<BoundType, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(BoundType_enum_table))
@@ -5662,8 +5721,9 @@ void from_json(const json& j, BoundType& e) {
   const auto* it = std::find_if(
       std::begin(BoundType_enum_table),
       std::end(BoundType_enum_table),
-      [&j](const std::pair<BoundType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<BoundType, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(BoundType_enum_table))
            ? it
@@ -5673,20 +5733,21 @@ void from_json(const json& j, BoundType& e) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<WindowType, json> WindowType_enum_table[] = {
-    // NOLINT: cert-err58-cpp
-    {WindowType::RANGE, "RANGE"},
-    {WindowType::ROWS, "ROWS"},
-    {WindowType::GROUPS, "GROUPS"},
-};
+static constexpr std::pair<WindowType, std::string_view>
+    WindowType_enum_table[] = {
+        {WindowType::RANGE, "RANGE"},
+        {WindowType::ROWS, "ROWS"},
+        {WindowType::GROUPS, "GROUPS"}};
 void to_json(json& j, const WindowType& e) {
   static_assert(std::is_enum<WindowType>::value, "WindowType must be an enum!");
   const auto* it = std::find_if(
       std::begin(WindowType_enum_table),
       std::end(WindowType_enum_table),
-      [e](const std::pair<WindowType, json>& ej_pair) -> bool {
+      [e](const std::pair<WindowType, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(WindowType_enum_table))
@@ -5699,8 +5760,9 @@ void from_json(const json& j, WindowType& e) {
   const auto* it = std::find_if(
       std::begin(WindowType_enum_table),
       std::end(WindowType_enum_table),
-      [&j](const std::pair<WindowType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<WindowType, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(WindowType_enum_table))
            ? it
@@ -5983,21 +6045,22 @@ void from_json(const json& j, IndexHandle& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<JoinType, json> JoinType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
-        {JoinType::INNER, "INNER"},
-        {JoinType::LEFT, "LEFT"},
-        {JoinType::RIGHT, "RIGHT"},
-        {JoinType::FULL, "FULL"},
-        {JoinType::SOURCE_OUTER, "SOURCE_OUTER"}};
+static constexpr std::pair<JoinType, std::string_view> JoinType_enum_table[] = {
+    {JoinType::INNER, "INNER"},
+    {JoinType::LEFT, "LEFT"},
+    {JoinType::RIGHT, "RIGHT"},
+    {JoinType::FULL, "FULL"},
+    {JoinType::SOURCE_OUTER, "SOURCE_OUTER"}};
 void to_json(json& j, const JoinType& e) {
   static_assert(std::is_enum<JoinType>::value, "JoinType must be an enum!");
   const auto* it = std::find_if(
       std::begin(JoinType_enum_table),
       std::end(JoinType_enum_table),
-      [e](const std::pair<JoinType, json>& ej_pair) -> bool {
+      [e](const std::pair<JoinType, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(JoinType_enum_table)) ? it
@@ -6009,8 +6072,9 @@ void from_json(const json& j, JoinType& e) {
   const auto* it = std::find_if(
       std::begin(JoinType_enum_table),
       std::end(JoinType_enum_table),
-      [&j](const std::pair<JoinType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<JoinType, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(JoinType_enum_table)) ? it
                                              : std::begin(JoinType_enum_table))
@@ -6444,13 +6508,14 @@ void from_json(const json& j, InsertHandle& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<JoinDistributionType, json>
-    JoinDistributionType_enum_table[] =
-        { // NOLINT: cert-err58-cpp
-            {JoinDistributionType::PARTITIONED, "PARTITIONED"},
-            {JoinDistributionType::REPLICATED, "REPLICATED"}};
+static constexpr std::pair<JoinDistributionType, std::string_view>
+    JoinDistributionType_enum_table[] = {
+        {JoinDistributionType::PARTITIONED, "PARTITIONED"},
+        {JoinDistributionType::REPLICATED, "REPLICATED"}};
 void to_json(json& j, const JoinDistributionType& e) {
   static_assert(
       std::is_enum<JoinDistributionType>::value,
@@ -6458,7 +6523,8 @@ void to_json(json& j, const JoinDistributionType& e) {
   const auto* it = std::find_if(
       std::begin(JoinDistributionType_enum_table),
       std::end(JoinDistributionType_enum_table),
-      [e](const std::pair<JoinDistributionType, json>& ej_pair) -> bool {
+      [e](const std::pair<JoinDistributionType, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(JoinDistributionType_enum_table))
@@ -6473,8 +6539,10 @@ void from_json(const json& j, JoinDistributionType& e) {
   const auto* it = std::find_if(
       std::begin(JoinDistributionType_enum_table),
       std::end(JoinDistributionType_enum_table),
-      [&j](const std::pair<JoinDistributionType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<JoinDistributionType, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(JoinDistributionType_enum_table))
            ? it
@@ -6934,10 +7002,12 @@ void from_json(const json& j, LambdaDefinitionExpression& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<LimitNodeStep, json> LimitNodeStep_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<LimitNodeStep, std::string_view>
+    LimitNodeStep_enum_table[] = {
         {LimitNodeStep::PARTIAL, "PARTIAL"},
         {LimitNodeStep::FINAL, "FINAL"}};
 void to_json(json& j, const LimitNodeStep& e) {
@@ -6946,7 +7016,7 @@ void to_json(json& j, const LimitNodeStep& e) {
   const auto* it = std::find_if(
       std::begin(LimitNodeStep_enum_table),
       std::end(LimitNodeStep_enum_table),
-      [e](const std::pair<LimitNodeStep, json>& ej_pair) -> bool {
+      [e](const std::pair<LimitNodeStep, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(LimitNodeStep_enum_table))
@@ -6960,8 +7030,9 @@ void from_json(const json& j, LimitNodeStep& e) {
   const auto* it = std::find_if(
       std::begin(LimitNodeStep_enum_table),
       std::end(LimitNodeStep_enum_table),
-      [&j](const std::pair<LimitNodeStep, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<LimitNodeStep, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(LimitNodeStep_enum_table))
            ? it
@@ -7065,19 +7136,20 @@ void from_json(const json& j, MarkDistinctNode& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<Bound, json> Bound_enum_table[] =
-    { // NOLINT: cert-err58-cpp
-        {Bound::BELOW, "BELOW"},
-        {Bound::EXACTLY, "EXACTLY"},
-        {Bound::ABOVE, "ABOVE"}};
+static constexpr std::pair<Bound, std::string_view> Bound_enum_table[] = {
+    {Bound::BELOW, "BELOW"},
+    {Bound::EXACTLY, "EXACTLY"},
+    {Bound::ABOVE, "ABOVE"}};
 void to_json(json& j, const Bound& e) {
   static_assert(std::is_enum<Bound>::value, "Bound must be an enum!");
   const auto* it = std::find_if(
       std::begin(Bound_enum_table),
       std::end(Bound_enum_table),
-      [e](const std::pair<Bound, json>& ej_pair) -> bool {
+      [e](const std::pair<Bound, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(Bound_enum_table)) ? it : std::begin(Bound_enum_table))
@@ -7088,8 +7160,9 @@ void from_json(const json& j, Bound& e) {
   const auto* it = std::find_if(
       std::begin(Bound_enum_table),
       std::end(Bound_enum_table),
-      [&j](const std::pair<Bound, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<Bound, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(Bound_enum_table)) ? it : std::begin(Bound_enum_table))
           ->first;
@@ -7414,10 +7487,12 @@ void from_json(const json& j, MergeJoinNode& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<RowChangeParadigm, json> RowChangeParadigm_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<RowChangeParadigm, std::string_view>
+    RowChangeParadigm_enum_table[] = {
         {RowChangeParadigm::CHANGE_ONLY_UPDATED_COLUMNS,
          "CHANGE_ONLY_UPDATED_COLUMNS"},
         {RowChangeParadigm::DELETE_ROW_AND_INSERT_ROW,
@@ -7429,7 +7504,8 @@ void to_json(json& j, const RowChangeParadigm& e) {
   const auto* it = std::find_if(
       std::begin(RowChangeParadigm_enum_table),
       std::end(RowChangeParadigm_enum_table),
-      [e](const std::pair<RowChangeParadigm, json>& ej_pair) -> bool {
+      [e](const std::pair<RowChangeParadigm, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(RowChangeParadigm_enum_table))
@@ -7444,8 +7520,10 @@ void from_json(const json& j, RowChangeParadigm& e) {
   const auto* it = std::find_if(
       std::begin(RowChangeParadigm_enum_table),
       std::end(RowChangeParadigm_enum_table),
-      [&j](const std::pair<RowChangeParadigm, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<RowChangeParadigm, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(RowChangeParadigm_enum_table))
            ? it
@@ -7728,10 +7806,12 @@ void from_json(const json& j, NodeLoadMetrics& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<NodeState, json> NodeState_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<NodeState, std::string_view>
+    NodeState_enum_table[] = {
         {NodeState::ACTIVE, "ACTIVE"},
         {NodeState::INACTIVE, "INACTIVE"},
         {NodeState::SHUTTING_DOWN, "SHUTTING_DOWN"}};
@@ -7740,7 +7820,7 @@ void to_json(json& j, const NodeState& e) {
   const auto* it = std::find_if(
       std::begin(NodeState_enum_table),
       std::end(NodeState_enum_table),
-      [e](const std::pair<NodeState, json>& ej_pair) -> bool {
+      [e](const std::pair<NodeState, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(NodeState_enum_table))
@@ -7753,8 +7833,9 @@ void from_json(const json& j, NodeState& e) {
   const auto* it = std::find_if(
       std::begin(NodeState_enum_table),
       std::end(NodeState_enum_table),
-      [&j](const std::pair<NodeState, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<NodeState, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(NodeState_enum_table))
            ? it
@@ -7920,10 +8001,12 @@ void from_json(const json& j, NodeStatus& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<BufferState, json> BufferState_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<BufferState, std::string_view>
+    BufferState_enum_table[] = {
         {BufferState::OPEN, "OPEN"},
         {BufferState::NO_MORE_BUFFERS, "NO_MORE_BUFFERS"},
         {BufferState::NO_MORE_PAGES, "NO_MORE_PAGES"},
@@ -7936,7 +8019,7 @@ void to_json(json& j, const BufferState& e) {
   const auto* it = std::find_if(
       std::begin(BufferState_enum_table),
       std::end(BufferState_enum_table),
-      [e](const std::pair<BufferState, json>& ej_pair) -> bool {
+      [e](const std::pair<BufferState, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(BufferState_enum_table))
@@ -7950,8 +8033,9 @@ void from_json(const json& j, BufferState& e) {
   const auto* it = std::find_if(
       std::begin(BufferState_enum_table),
       std::end(BufferState_enum_table),
-      [&j](const std::pair<BufferState, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<BufferState, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(BufferState_enum_table))
            ? it
@@ -8730,20 +8814,17 @@ void from_json(const json& j, PlanCostEstimate& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<StageExecutionStrategy, json>
-    StageExecutionStrategy_enum_table[] =
-        { // NOLINT: cert-err58-cpp
-            {StageExecutionStrategy::UNGROUPED_EXECUTION,
-             "UNGROUPED_EXECUTION"},
-            {StageExecutionStrategy::FIXED_LIFESPAN_SCHEDULE_GROUPED_EXECUTION,
-             "FIXED_LIFESPAN_SCHEDULE_GROUPED_EXECUTION"},
-            {StageExecutionStrategy::
-                 DYNAMIC_LIFESPAN_SCHEDULE_GROUPED_EXECUTION,
-             "DYNAMIC_LIFESPAN_SCHEDULE_GROUPED_EXECUTION"},
-            {StageExecutionStrategy::RECOVERABLE_GROUPED_EXECUTION,
-             "RECOVERABLE_GROUPED_EXECUTION"}};
+static constexpr std::pair<StageExecutionStrategy, std::string_view>
+    StageExecutionStrategy_enum_table[] = {
+        {StageExecutionStrategy::UNGROUPED_EXECUTION, "UNGROUPED_EXECUTION"},
+        {StageExecutionStrategy::FIXED_LIFESPAN_SCHEDULE_GROUPED_EXECUTION,
+         "FIXED_LIFESPAN_SCHEDULE_GROUPED_EXECUTION"},
+        {StageExecutionStrategy::RECOVERABLE_GROUPED_EXECUTION,
+         "RECOVERABLE_GROUPED_EXECUTION"}};
 void to_json(json& j, const StageExecutionStrategy& e) {
   static_assert(
       std::is_enum<StageExecutionStrategy>::value,
@@ -8751,7 +8832,8 @@ void to_json(json& j, const StageExecutionStrategy& e) {
   const auto* it = std::find_if(
       std::begin(StageExecutionStrategy_enum_table),
       std::end(StageExecutionStrategy_enum_table),
-      [e](const std::pair<StageExecutionStrategy, json>& ej_pair) -> bool {
+      [e](const std::pair<StageExecutionStrategy, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(StageExecutionStrategy_enum_table))
@@ -8766,8 +8848,10 @@ void from_json(const json& j, StageExecutionStrategy& e) {
   const auto* it = std::find_if(
       std::begin(StageExecutionStrategy_enum_table),
       std::end(StageExecutionStrategy_enum_table),
-      [&j](const std::pair<StageExecutionStrategy, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<StageExecutionStrategy, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(StageExecutionStrategy_enum_table))
            ? it
@@ -8828,10 +8912,12 @@ void from_json(const json& j, StageExecutionDescriptor& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<ConfidenceLevel, json> ConfidenceLevel_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<ConfidenceLevel, std::string_view>
+    ConfidenceLevel_enum_table[] = {
         {ConfidenceLevel::LOW, "LOW"},
         {ConfidenceLevel::HIGH, "HIGH"},
         {ConfidenceLevel::FACT, "FACT"}};
@@ -8841,7 +8927,7 @@ void to_json(json& j, const ConfidenceLevel& e) {
   const auto* it = std::find_if(
       std::begin(ConfidenceLevel_enum_table),
       std::end(ConfidenceLevel_enum_table),
-      [e](const std::pair<ConfidenceLevel, json>& ej_pair) -> bool {
+      [e](const std::pair<ConfidenceLevel, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(ConfidenceLevel_enum_table))
@@ -8855,8 +8941,10 @@ void from_json(const json& j, ConfidenceLevel& e) {
   const auto* it = std::find_if(
       std::begin(ConfidenceLevel_enum_table),
       std::end(ConfidenceLevel_enum_table),
-      [&j](const std::pair<ConfidenceLevel, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<ConfidenceLevel, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(ConfidenceLevel_enum_table))
            ? it
@@ -9227,19 +9315,20 @@ void from_json(const json& j, PlanFragment& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<Locality, json> Locality_enum_table[] =
-    { // NOLINT: cert-err58-cpp
-        {Locality::UNKNOWN, "UNKNOWN"},
-        {Locality::LOCAL, "LOCAL"},
-        {Locality::REMOTE, "REMOTE"}};
+static constexpr std::pair<Locality, std::string_view> Locality_enum_table[] = {
+    {Locality::UNKNOWN, "UNKNOWN"},
+    {Locality::LOCAL, "LOCAL"},
+    {Locality::REMOTE, "REMOTE"}};
 void to_json(json& j, const Locality& e) {
   static_assert(std::is_enum<Locality>::value, "Locality must be an enum!");
   const auto* it = std::find_if(
       std::begin(Locality_enum_table),
       std::end(Locality_enum_table),
-      [e](const std::pair<Locality, json>& ej_pair) -> bool {
+      [e](const std::pair<Locality, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(Locality_enum_table)) ? it
@@ -9251,8 +9340,9 @@ void from_json(const json& j, Locality& e) {
   const auto* it = std::find_if(
       std::begin(Locality_enum_table),
       std::end(Locality_enum_table),
-      [&j](const std::pair<Locality, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<Locality, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(Locality_enum_table)) ? it
                                              : std::begin(Locality_enum_table))
@@ -9668,10 +9758,12 @@ void from_json(const json& j, RowNumberNode& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<RuntimeUnit, json> RuntimeUnit_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<RuntimeUnit, std::string_view>
+    RuntimeUnit_enum_table[] = {
         {RuntimeUnit::NONE, "NONE"},
         {RuntimeUnit::NANO, "NANO"},
         {RuntimeUnit::BYTE, "BYTE"}};
@@ -9681,7 +9773,7 @@ void to_json(json& j, const RuntimeUnit& e) {
   const auto* it = std::find_if(
       std::begin(RuntimeUnit_enum_table),
       std::end(RuntimeUnit_enum_table),
-      [e](const std::pair<RuntimeUnit, json>& ej_pair) -> bool {
+      [e](const std::pair<RuntimeUnit, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(RuntimeUnit_enum_table))
@@ -9695,8 +9787,9 @@ void from_json(const json& j, RuntimeUnit& e) {
   const auto* it = std::find_if(
       std::begin(RuntimeUnit_enum_table),
       std::end(RuntimeUnit_enum_table),
-      [&j](const std::pair<RuntimeUnit, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<RuntimeUnit, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(RuntimeUnit_enum_table))
            ? it
@@ -9727,10 +9820,12 @@ void from_json(const json& j, RuntimeMetric& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<SampleNodeType, json> SampleNodeType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<SampleNodeType, std::string_view>
+    SampleNodeType_enum_table[] = {
         {SampleNodeType::BERNOULLI, "BERNOULLI"},
         {SampleNodeType::SYSTEM, "SYSTEM"}};
 void to_json(json& j, const SampleNodeType& e) {
@@ -9739,7 +9834,7 @@ void to_json(json& j, const SampleNodeType& e) {
   const auto* it = std::find_if(
       std::begin(SampleNodeType_enum_table),
       std::end(SampleNodeType_enum_table),
-      [e](const std::pair<SampleNodeType, json>& ej_pair) -> bool {
+      [e](const std::pair<SampleNodeType, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(SampleNodeType_enum_table))
@@ -9753,8 +9848,9 @@ void from_json(const json& j, SampleNodeType& e) {
   const auto* it = std::find_if(
       std::begin(SampleNodeType_enum_table),
       std::end(SampleNodeType_enum_table),
-      [&j](const std::pair<SampleNodeType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<SampleNodeType, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(SampleNodeType_enum_table))
            ? it
@@ -9800,10 +9896,12 @@ void from_json(const json& j, SampleNode& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<DistributionType, json> DistributionType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<DistributionType, std::string_view>
+    DistributionType_enum_table[] = {
         {DistributionType::PARTITIONED, "PARTITIONED"},
         {DistributionType::REPLICATED, "REPLICATED"}};
 void to_json(json& j, const DistributionType& e) {
@@ -9813,7 +9911,8 @@ void to_json(json& j, const DistributionType& e) {
   const auto* it = std::find_if(
       std::begin(DistributionType_enum_table),
       std::end(DistributionType_enum_table),
-      [e](const std::pair<DistributionType, json>& ej_pair) -> bool {
+      [e](const std::pair<DistributionType, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(DistributionType_enum_table))
@@ -9828,8 +9927,10 @@ void from_json(const json& j, DistributionType& e) {
   const auto* it = std::find_if(
       std::begin(DistributionType_enum_table),
       std::end(DistributionType_enum_table),
-      [&j](const std::pair<DistributionType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<DistributionType, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(DistributionType_enum_table))
            ? it
@@ -10128,10 +10229,12 @@ void from_json(const json& j, SortedRangeSet& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<SpatialJoinType, json> SpatialJoinType_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<SpatialJoinType, std::string_view>
+    SpatialJoinType_enum_table[] = {
         {SpatialJoinType::INNER, "INNER"},
         {SpatialJoinType::LEFT, "LEFT"}};
 void to_json(json& j, const SpatialJoinType& e) {
@@ -10140,7 +10243,7 @@ void to_json(json& j, const SpatialJoinType& e) {
   const auto* it = std::find_if(
       std::begin(SpatialJoinType_enum_table),
       std::end(SpatialJoinType_enum_table),
-      [e](const std::pair<SpatialJoinType, json>& ej_pair) -> bool {
+      [e](const std::pair<SpatialJoinType, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(SpatialJoinType_enum_table))
@@ -10154,8 +10257,10 @@ void from_json(const json& j, SpatialJoinType& e) {
   const auto* it = std::find_if(
       std::begin(SpatialJoinType_enum_table),
       std::end(SpatialJoinType_enum_table),
-      [&j](const std::pair<SpatialJoinType, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<SpatialJoinType, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(SpatialJoinType_enum_table))
            ? it
@@ -10279,28 +10384,29 @@ void from_json(const json& j, SpatialJoinNode& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<Form, json> Form_enum_table[] =
-    { // NOLINT: cert-err58-cpp
-        {Form::IF, "IF"},
-        {Form::NULL_IF, "NULL_IF"},
-        {Form::SWITCH, "SWITCH"},
-        {Form::WHEN, "WHEN"},
-        {Form::IS_NULL, "IS_NULL"},
-        {Form::COALESCE, "COALESCE"},
-        {Form::IN, "IN"},
-        {Form::AND, "AND"},
-        {Form::OR, "OR"},
-        {Form::DEREFERENCE, "DEREFERENCE"},
-        {Form::ROW_CONSTRUCTOR, "ROW_CONSTRUCTOR"},
-        {Form::BIND, "BIND"}};
+static constexpr std::pair<Form, std::string_view> Form_enum_table[] = {
+    {Form::IF, "IF"},
+    {Form::NULL_IF, "NULL_IF"},
+    {Form::SWITCH, "SWITCH"},
+    {Form::WHEN, "WHEN"},
+    {Form::IS_NULL, "IS_NULL"},
+    {Form::COALESCE, "COALESCE"},
+    {Form::IN, "IN"},
+    {Form::AND, "AND"},
+    {Form::OR, "OR"},
+    {Form::DEREFERENCE, "DEREFERENCE"},
+    {Form::ROW_CONSTRUCTOR, "ROW_CONSTRUCTOR"},
+    {Form::BIND, "BIND"}};
 void to_json(json& j, const Form& e) {
   static_assert(std::is_enum<Form>::value, "Form must be an enum!");
   const auto* it = std::find_if(
       std::begin(Form_enum_table),
       std::end(Form_enum_table),
-      [e](const std::pair<Form, json>& ej_pair) -> bool {
+      [e](const std::pair<Form, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(Form_enum_table)) ? it : std::begin(Form_enum_table))
@@ -10311,8 +10417,9 @@ void from_json(const json& j, Form& e) {
   const auto* it = std::find_if(
       std::begin(Form_enum_table),
       std::end(Form_enum_table),
-      [&j](const std::pair<Form, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<Form, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(Form_enum_table)) ? it : std::begin(Form_enum_table))
           ->first;
@@ -10503,16 +10610,17 @@ void from_json(const json& j, SystemColumnHandle& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<SystemPartitionFunction, json>
-    SystemPartitionFunction_enum_table[] =
-        { // NOLINT: cert-err58-cpp
-            {SystemPartitionFunction::SINGLE, "SINGLE"},
-            {SystemPartitionFunction::HASH, "HASH"},
-            {SystemPartitionFunction::ROUND_ROBIN, "ROUND_ROBIN"},
-            {SystemPartitionFunction::BROADCAST, "BROADCAST"},
-            {SystemPartitionFunction::UNKNOWN, "UNKNOWN"}};
+static constexpr std::pair<SystemPartitionFunction, std::string_view>
+    SystemPartitionFunction_enum_table[] = {
+        {SystemPartitionFunction::SINGLE, "SINGLE"},
+        {SystemPartitionFunction::HASH, "HASH"},
+        {SystemPartitionFunction::ROUND_ROBIN, "ROUND_ROBIN"},
+        {SystemPartitionFunction::BROADCAST, "BROADCAST"},
+        {SystemPartitionFunction::UNKNOWN, "UNKNOWN"}};
 void to_json(json& j, const SystemPartitionFunction& e) {
   static_assert(
       std::is_enum<SystemPartitionFunction>::value,
@@ -10520,7 +10628,8 @@ void to_json(json& j, const SystemPartitionFunction& e) {
   const auto* it = std::find_if(
       std::begin(SystemPartitionFunction_enum_table),
       std::end(SystemPartitionFunction_enum_table),
-      [e](const std::pair<SystemPartitionFunction, json>& ej_pair) -> bool {
+      [e](const std::pair<SystemPartitionFunction, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(SystemPartitionFunction_enum_table))
@@ -10535,8 +10644,10 @@ void from_json(const json& j, SystemPartitionFunction& e) {
   const auto* it = std::find_if(
       std::begin(SystemPartitionFunction_enum_table),
       std::end(SystemPartitionFunction_enum_table),
-      [&j](const std::pair<SystemPartitionFunction, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<SystemPartitionFunction, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(SystemPartitionFunction_enum_table))
            ? it
@@ -10546,17 +10657,18 @@ void from_json(const json& j, SystemPartitionFunction& e) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<SystemPartitioning, json>
-    SystemPartitioning_enum_table[] =
-        { // NOLINT: cert-err58-cpp
-            {SystemPartitioning::SINGLE, "SINGLE"},
-            {SystemPartitioning::FIXED, "FIXED"},
-            {SystemPartitioning::SOURCE, "SOURCE"},
-            {SystemPartitioning::SCALED, "SCALED"},
-            {SystemPartitioning::COORDINATOR_ONLY, "COORDINATOR_ONLY"},
-            {SystemPartitioning::ARBITRARY, "ARBITRARY"}};
+static constexpr std::pair<SystemPartitioning, std::string_view>
+    SystemPartitioning_enum_table[] = {
+        {SystemPartitioning::SINGLE, "SINGLE"},
+        {SystemPartitioning::FIXED, "FIXED"},
+        {SystemPartitioning::SOURCE, "SOURCE"},
+        {SystemPartitioning::SCALED, "SCALED"},
+        {SystemPartitioning::COORDINATOR_ONLY, "COORDINATOR_ONLY"},
+        {SystemPartitioning::ARBITRARY, "ARBITRARY"}};
 void to_json(json& j, const SystemPartitioning& e) {
   static_assert(
       std::is_enum<SystemPartitioning>::value,
@@ -10564,7 +10676,8 @@ void to_json(json& j, const SystemPartitioning& e) {
   const auto* it = std::find_if(
       std::begin(SystemPartitioning_enum_table),
       std::end(SystemPartitioning_enum_table),
-      [e](const std::pair<SystemPartitioning, json>& ej_pair) -> bool {
+      [e](const std::pair<SystemPartitioning, std::string_view>& ej_pair)
+          -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(SystemPartitioning_enum_table))
@@ -10579,8 +10692,10 @@ void from_json(const json& j, SystemPartitioning& e) {
   const auto* it = std::find_if(
       std::begin(SystemPartitioning_enum_table),
       std::end(SystemPartitioning_enum_table),
-      [&j](const std::pair<SystemPartitioning, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<SystemPartitioning, std::string_view>& ej_pair)
+          -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(SystemPartitioning_enum_table))
            ? it
@@ -11751,10 +11866,12 @@ void from_json(const json& j, TaskStats& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<TaskState, json> TaskState_enum_table[] =
-    { // NOLINT: cert-err58-cpp
+static constexpr std::pair<TaskState, std::string_view>
+    TaskState_enum_table[] = {
         {TaskState::PLANNED, "PLANNED"},
         {TaskState::RUNNING, "RUNNING"},
         {TaskState::FINISHED, "FINISHED"},
@@ -11766,7 +11883,7 @@ void to_json(json& j, const TaskState& e) {
   const auto* it = std::find_if(
       std::begin(TaskState_enum_table),
       std::end(TaskState_enum_table),
-      [e](const std::pair<TaskState, json>& ej_pair) -> bool {
+      [e](const std::pair<TaskState, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(TaskState_enum_table))
@@ -11779,8 +11896,9 @@ void from_json(const json& j, TaskState& e) {
   const auto* it = std::find_if(
       std::begin(TaskState_enum_table),
       std::end(TaskState_enum_table),
-      [&j](const std::pair<TaskState, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<TaskState, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(TaskState_enum_table))
            ? it
@@ -12110,19 +12228,20 @@ void from_json(const json& j, TaskInfo& p) {
 } // namespace facebook::presto::protocol
 namespace facebook::presto::protocol {
 // Loosely copied this here from NLOHMANN_JSON_SERIALIZE_ENUM()
+// The table is constexpr so it lives in .rodata: there is no per-process
+// static initializer to run and the pages are shared by the page cache.
 
 // NOLINTNEXTLINE: cppcoreguidelines-avoid-c-arrays
-static const std::pair<Step, json> Step_enum_table[] =
-    { // NOLINT: cert-err58-cpp
-        {Step::SINGLE, "SINGLE"},
-        {Step::PARTIAL, "PARTIAL"},
-        {Step::FINAL, "FINAL"}};
+static constexpr std::pair<Step, std::string_view> Step_enum_table[] = {
+    {Step::SINGLE, "SINGLE"},
+    {Step::PARTIAL, "PARTIAL"},
+    {Step::FINAL, "FINAL"}};
 void to_json(json& j, const Step& e) {
   static_assert(std::is_enum<Step>::value, "Step must be an enum!");
   const auto* it = std::find_if(
       std::begin(Step_enum_table),
       std::end(Step_enum_table),
-      [e](const std::pair<Step, json>& ej_pair) -> bool {
+      [e](const std::pair<Step, std::string_view>& ej_pair) -> bool {
         return ej_pair.first == e;
       });
   j = ((it != std::end(Step_enum_table)) ? it : std::begin(Step_enum_table))
@@ -12133,8 +12252,9 @@ void from_json(const json& j, Step& e) {
   const auto* it = std::find_if(
       std::begin(Step_enum_table),
       std::end(Step_enum_table),
-      [&j](const std::pair<Step, json>& ej_pair) -> bool {
-        return ej_pair.second == j;
+      [&j](const std::pair<Step, std::string_view>& ej_pair) -> bool {
+        return j.is_string() &&
+            j.get_ref<const std::string&>() == ej_pair.second;
       });
   e = ((it != std::end(Step_enum_table)) ? it : std::begin(Step_enum_table))
           ->first;
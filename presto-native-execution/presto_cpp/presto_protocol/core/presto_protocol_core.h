@@ -31,6 +31,7 @@
 #include "presto_cpp/external/json/nlohmann/json.hpp"
 #include "presto_cpp/presto_protocol/core/DataSize.h"
 #include "presto_cpp/presto_protocol/core/Duration.h"
+#include "presto_cpp/presto_protocol/core/ProtocolArena.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/encode/Base64.h"
 
@@ -222,7 +223,7 @@ void to_json(json& j, const std::shared_ptr<T>& p) {
 }
 template <typename T>
 void from_json(const json& j, std::shared_ptr<T>& p) {
-  p = std::make_shared<T>();
+  p = facebook::presto::protocol::makeProtocolShared<T>();
   j.get_to(*p);
 }
 
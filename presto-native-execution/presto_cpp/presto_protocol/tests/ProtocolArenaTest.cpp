@@ -0,0 +1,80 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/presto_protocol/core/ProtocolArena.h"
+#include <gtest/gtest.h>
+#include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
+
+using namespace facebook::presto;
+
+class ProtocolArenaTest : public ::testing::Test {};
+
+TEST_F(ProtocolArenaTest, inactiveByDefault) {
+  EXPECT_EQ(protocol::ProtocolArena::current(), nullptr);
+  // Falls back to the global allocator without an active scope.
+  auto p = protocol::makeProtocolShared<int>();
+  EXPECT_NE(p, nullptr);
+}
+
+TEST_F(ProtocolArenaTest, scopedActivation) {
+  {
+    protocol::ScopedProtocolArena scope;
+    EXPECT_NE(protocol::ProtocolArena::current(), nullptr);
+    {
+      protocol::ScopedProtocolArena nested;
+      EXPECT_NE(protocol::ProtocolArena::current(), nullptr);
+    }
+    EXPECT_NE(protocol::ProtocolArena::current(), nullptr);
+  }
+  EXPECT_EQ(protocol::ProtocolArena::current(), nullptr);
+
+  protocol::ScopedProtocolArena disabled(false);
+  EXPECT_EQ(protocol::ProtocolArena::current(), nullptr);
+}
+
+TEST_F(ProtocolArenaTest, objectsOutliveScope) {
+  std::shared_ptr<protocol::ScheduledSplit> split;
+  {
+    protocol::ScopedProtocolArena scope;
+    split = json::parse(R"(
+        {
+          "@type": "ScheduledSplit",
+          "sequenceId": 9,
+          "planNodeId": "think",
+          "split": {
+            "connectorId": "test",
+            "lifespan": "TaskWide",
+            "connectorSplit": {
+              "@type": "$remote",
+              "location": {"location": "http://127.0.0.1:56"},
+              "remoteSourceTaskId": "test.1.2.3.4"
+            }
+          }
+        })");
+  }
+  // The arena is kept alive by the control block of the escaped object.
+  EXPECT_EQ(split->sequenceId, 9);
+  EXPECT_EQ(split->planNodeId, "think");
+}
+
+TEST_F(ProtocolArenaTest, largeAllocations) {
+  protocol::ProtocolArena arena;
+  auto* small = arena.allocate(16, 8);
+  EXPECT_NE(small, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(small) % 8, 0);
+  // Larger than a chunk; gets a dedicated chunk.
+  auto* large =
+      arena.allocate(2 * protocol::ProtocolArena::kChunkBytes, 64);
+  EXPECT_NE(large, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(large) % 64, 0);
+}
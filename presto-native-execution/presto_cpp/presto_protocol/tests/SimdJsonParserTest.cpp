@@ -0,0 +1,69 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/presto_protocol/core/SimdJsonParser.h"
+#include <gtest/gtest.h>
+#include "presto_cpp/presto_protocol/core/presto_protocol_core.h"
+#include "velox/common/base/Exceptions.h"
+
+using namespace facebook::presto;
+
+class SimdJsonParserTest : public ::testing::Test {};
+
+TEST_F(SimdJsonParserTest, scalars) {
+  EXPECT_EQ(protocol::parseJson("123"), json::parse("123"));
+  EXPECT_EQ(protocol::parseJson("-123"), json::parse("-123"));
+  EXPECT_EQ(protocol::parseJson("1.5"), json::parse("1.5"));
+  EXPECT_EQ(protocol::parseJson("true"), json::parse("true"));
+  EXPECT_EQ(protocol::parseJson("null"), json::parse("null"));
+  EXPECT_EQ(protocol::parseJson("\"abc\""), json::parse("\"abc\""));
+}
+
+TEST_F(SimdJsonParserTest, nested) {
+  const std::string input = R"(
+      {"taskId": "20201107_130540_00011_wrpkw.1.2.3",
+       "sources": [{"planNodeId": "0", "splits": [], "noMoreSplits": true},
+                   {"planNodeId": "1", "splits": [{"sequenceId": 42}]}],
+       "outputIds": [0, 1, 2],
+       "extraCredentials": {}})";
+  EXPECT_EQ(protocol::parseJson(input), json::parse(input));
+}
+
+TEST_F(SimdJsonParserTest, matchesNlohmannOnProtocolStruct) {
+  const std::string str = R"(
+      {
+        "@type": "ScheduledSplit",
+        "sequenceId": 9,
+        "planNodeId": "think",
+        "split": {
+          "connectorId": "test",
+          "lifespan": "TaskWide",
+          "connectorSplit": {
+            "@type": "$remote",
+            "location": {"location": "http://127.0.0.1:56"},
+            "remoteSourceTaskId": "test.1.2.3.4"
+          }
+        }
+      })";
+  protocol::ScheduledSplit fromSimd = protocol::parseJson(str);
+  protocol::ScheduledSplit fromNlohmann = json::parse(str);
+  EXPECT_EQ(fromSimd.sequenceId, fromNlohmann.sequenceId);
+  EXPECT_EQ(fromSimd.planNodeId, fromNlohmann.planNodeId);
+  EXPECT_EQ(json(fromSimd), json(fromNlohmann));
+}
+
+TEST_F(SimdJsonParserTest, invalidInput) {
+  EXPECT_THROW(
+      protocol::parseJson("{\"unterminated\": "),
+      facebook::velox::VeloxUserError);
+}
@@ -0,0 +1,89 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "presto_cpp/presto_protocol/core/TaskStatusSerde.h"
+#include <gtest/gtest.h>
+
+using namespace facebook::presto::protocol;
+
+namespace {
+
+TaskStatus makeTaskStatus() {
+  TaskStatus taskStatus;
+  taskStatus.taskInstanceIdLeastSignificantBits = 123;
+  taskStatus.taskInstanceIdMostSignificantBits = -456;
+  taskStatus.version = 7;
+  taskStatus.state = TaskState::RUNNING;
+  taskStatus.self = "http://127.0.0.1:8080/v1/task/20250831_abc.1.2.3.4";
+  taskStatus.queuedPartitionedDrivers = 3;
+  taskStatus.runningPartitionedDrivers = 11;
+  taskStatus.outputBufferUtilization = 0.25;
+  taskStatus.outputBufferOverutilized = true;
+  taskStatus.physicalWrittenDataSizeInBytes = 1 << 20;
+  taskStatus.memoryReservationInBytes = 2 << 20;
+  taskStatus.systemMemoryReservationInBytes = 0;
+  taskStatus.peakNodeTotalMemoryReservationInBytes = 3 << 20;
+  taskStatus.fullGcCount = 1;
+  taskStatus.fullGcTimeInMillis = 17;
+  taskStatus.totalCpuTimeInNanos = 987654321;
+  taskStatus.taskAgeInMillis = 4321;
+  taskStatus.queuedPartitionedSplitsWeight = 30;
+  taskStatus.runningPartitionedSplitsWeight = 110;
+  return taskStatus;
+}
+
+} // namespace
+
+TEST(TaskStatusSerdeTest, directWriterMatchesGeneratedSerde) {
+  const auto taskStatus = makeTaskStatus();
+
+  const auto serialized = serializeTaskStatusJson(taskStatus);
+
+  // The direct writer must produce the same JSON document as the generated
+  // nlohmann serde, including field order.
+  const json generated = taskStatus;
+  EXPECT_EQ(json::parse(serialized), generated);
+
+  TaskStatus deserialized = json::parse(serialized);
+  EXPECT_EQ(json(deserialized), generated);
+}
+
+TEST(TaskStatusSerdeTest, stringEscaping) {
+  auto taskStatus = makeTaskStatus();
+  taskStatus.self = "http://host/v1/task/\"quoted\"\\back\n\tslash\x01";
+
+  const auto serialized = serializeTaskStatusJson(taskStatus);
+
+  TaskStatus deserialized = json::parse(serialized);
+  EXPECT_EQ(deserialized.self, taskStatus.self);
+  EXPECT_EQ(json::parse(serialized), json(taskStatus));
+}
+
+TEST(TaskStatusSerdeTest, failuresFallBackToGeneratedSerde) {
+  auto taskStatus = makeTaskStatus();
+  taskStatus.state = TaskState::FAILED;
+  ExecutionFailureInfo failure;
+  failure.type = "com.facebook.presto.spi.PrestoException";
+  failure.message = "something went wrong";
+  failure.errorCode.code = 65536;
+  failure.errorCode.name = "GENERIC_INTERNAL_ERROR";
+  failure.errorCode.type = ErrorType::INTERNAL_ERROR;
+  taskStatus.failures.push_back(failure);
+
+  const auto serialized = serializeTaskStatusJson(taskStatus);
+  EXPECT_EQ(json::parse(serialized), json(taskStatus));
+
+  TaskStatus deserialized = json::parse(serialized);
+  EXPECT_EQ(deserialized.failures.size(), 1);
+  EXPECT_EQ(deserialized.failures.back().message, "something went wrong");
+}